@@ -12,6 +12,12 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/port/logging.h"
@@ -45,6 +51,10 @@ namespace mediapipe {
 //   }
 // }
 //
+// If num_read_ahead_frames is set, the file is decoded on a background thread
+// while the calculator outputs the frames decoded so far, so that decoding
+// overlaps with the downstream processing.
+//
 // TODO: support decoding multiple streams.
 class AudioDecoderCalculator : public CalculatorBase {
  public:
@@ -55,7 +65,28 @@ class AudioDecoderCalculator : public CalculatorBase {
   absl::Status Close(CalculatorContext* cc) override;
 
  private:
+  // Decodes frames into decoded_frames_ until the decoder is exhausted, fails,
+  // or stop_decoding_ is set.
+  void DecodeFrames();
+
+  bool IsFrameReady() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !decoded_frames_.empty() || decoding_done_;
+  }
+  bool CanDecodeFrame() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return stop_decoding_ || decoded_frames_.size() < num_read_ahead_frames_;
+  }
+
   std::unique_ptr<AudioDecoder> decoder_;
+
+  // Read-ahead state, only used if num_read_ahead_frames is positive.
+  int num_read_ahead_frames_ = 0;
+  std::unique_ptr<std::thread> decoding_thread_;
+  absl::Mutex mutex_;
+  std::deque<Packet> decoded_frames_ ABSL_GUARDED_BY(mutex_);
+  // The status which ended decoding, e.g. StatusStop() at the end of the file.
+  absl::Status decoding_status_ ABSL_GUARDED_BY(mutex_);
+  bool decoding_done_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stop_decoding_ ABSL_GUARDED_BY(mutex_) = false;
 };
 
 absl::Status AudioDecoderCalculator::GetContract(CalculatorContract* cc) {
@@ -87,10 +118,32 @@ absl::Status AudioDecoderCalculator::Open(CalculatorContext* cc) {
     cc->Outputs().Tag("AUDIO_HEADER").SetHeader(Adopt(header.release()));
   }
   cc->Outputs().Tag("AUDIO_HEADER").Close();
+
+  num_read_ahead_frames_ = decoder_options.num_read_ahead_frames();
+  if (num_read_ahead_frames_ > 0) {
+    decoding_thread_ =
+        absl::make_unique<std::thread>([this] { DecodeFrames(); });
+  }
   return absl::OkStatus();
 }
 
 absl::Status AudioDecoderCalculator::Process(CalculatorContext* cc) {
+  if (decoding_thread_) {
+    Packet data;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(
+          absl::Condition(this, &AudioDecoderCalculator::IsFrameReady));
+      if (decoded_frames_.empty()) {
+        return decoding_status_;
+      }
+      data = std::move(decoded_frames_.front());
+      decoded_frames_.pop_front();
+    }
+    cc->Outputs().Tag("AUDIO").AddPacket(std::move(data));
+    return absl::OkStatus();
+  }
+
   Packet data;
   int options_index = -1;
   auto status = decoder_->GetData(&options_index, &data);
@@ -101,9 +154,41 @@ absl::Status AudioDecoderCalculator::Process(CalculatorContext* cc) {
 }
 
 absl::Status AudioDecoderCalculator::Close(CalculatorContext* cc) {
+  if (decoding_thread_) {
+    {
+      absl::MutexLock lock(&mutex_);
+      stop_decoding_ = true;
+    }
+    decoding_thread_->join();
+    decoding_thread_.reset();
+  }
   return decoder_->Close();
 }
 
+void AudioDecoderCalculator::DecodeFrames() {
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(
+          absl::Condition(this, &AudioDecoderCalculator::CanDecodeFrame));
+      if (stop_decoding_) {
+        decoding_done_ = true;
+        return;
+      }
+    }
+    Packet data;
+    int options_index = -1;
+    absl::Status status = decoder_->GetData(&options_index, &data);
+    absl::MutexLock lock(&mutex_);
+    if (!status.ok()) {
+      decoding_status_ = status;
+      decoding_done_ = true;
+      return;
+    }
+    decoded_frames_.push_back(std::move(data));
+  }
+}
+
 REGISTER_CALCULATOR(AudioDecoderCalculator);
 
 }  // namespace mediapipe
@@ -15,6 +15,7 @@
 #include "absl/flags/flag.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/time_series_header.pb.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -87,6 +88,47 @@ TEST(AudioDecoderCalculatorTest, Test48KWAV) {
               std::ceil(48000.0 * 2 / 1024));
 }
 
+TEST(AudioDecoderCalculatorTest, Test48KWAVDownmixedAndResampled) {
+  CalculatorGraphConfig::Node node_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+        calculator: "AudioDecoderCalculator"
+        input_side_packet: "INPUT_FILE_PATH:input_file_path"
+        output_stream: "AUDIO:audio"
+        output_stream: "AUDIO_HEADER:audio_header"
+        node_options {
+          [type.googleapis.com/mediapipe.AudioDecoderOptions]: {
+            audio_stream {
+              stream_index: 0
+              downmix_to_mono: true
+              target_sample_rate: 16000
+              reuse_output_buffers: true
+            }
+            num_read_ahead_frames: 4
+          }
+        })pb");
+  CalculatorRunner runner(node_config);
+  runner.MutableSidePackets()->Tag("INPUT_FILE_PATH") = MakePacket<std::string>(
+      file::JoinPath(GetTestDataDir(kTestPackageRoot),
+                     "sine_wave_1k_48000_stereo_2_sec_wav.audio"));
+  MP_ASSERT_OK(runner.Run());
+  const mediapipe::TimeSeriesHeader& header =
+      runner.Outputs()
+          .Tag("AUDIO_HEADER")
+          .header.Get<mediapipe::TimeSeriesHeader>();
+  EXPECT_EQ(16000, header.sample_rate());
+  EXPECT_EQ(1, header.num_channels());
+  int num_samples = 0;
+  Timestamp last_timestamp = Timestamp::Unset();
+  for (const Packet& packet : runner.Outputs().Tag("AUDIO").packets) {
+    const Matrix& audio = packet.Get<Matrix>();
+    EXPECT_EQ(1, audio.rows());
+    EXPECT_GT(packet.Timestamp(), last_timestamp);
+    last_timestamp = packet.Timestamp();
+    num_samples += audio.cols();
+  }
+  EXPECT_NEAR(16000 * 2, num_samples, 100);
+}
+
 TEST(AudioDecoderCalculatorTest, TestMP3) {
   CalculatorGraphConfig::Node node_config =
       ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
@@ -23,6 +23,7 @@
 #include "Eigen/Core"
 #include "absl/strings/str_cat.h"
 #include "audio/dsp/resampler.h"
+#include "audio/dsp/resampler_q.h"
 #include "mediapipe/calculators/audio/rational_factor_resample_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/matrix.h"
@@ -71,14 +72,22 @@ class RationalFactorResampleCalculator : public CalculatorBase {
       const double source_sample_rate, const double target_sample_rate,
       const RationalFactorResampleCalculatorOptions& options);
 
+  // Returns a QResampler that resamples all num_channels channels of a
+  // Matrix in one pass, configured like ResamplerFromOptions(). Returns null
+  // if the options specify an invalid resampler.
+  static std::unique_ptr<audio_dsp::QResampler<float>>
+  MultichannelResamplerFromOptions(
+      const double source_sample_rate, const double target_sample_rate,
+      int num_channels, const RationalFactorResampleCalculatorOptions& options);
+
   // Does Timestamp bookkeeping and resampling common to Process() and
   // Close().  Returns FAIL if the resampler state becomes
   // inconsistent.
   absl::Status ProcessInternal(const Matrix& input_frame, bool should_flush,
                                CalculatorContext* cc);
 
-  // Uses the internal resampler_ objects to actually resample each
-  // row of the input TimeSeries.  Returns false if the resampler
+  // Uses the internal resampler_ object to actually resample all
+  // rows of the input TimeSeries.  Returns false if the resampler
   // state becomes inconsistent.
   bool Resample(const Matrix& input_frame, Matrix* output_frame,
                 bool should_flush);
@@ -90,7 +99,9 @@ class RationalFactorResampleCalculator : public CalculatorBase {
   Timestamp initial_timestamp_;
   bool check_inconsistent_timestamps_;
   int num_channels_;
-  std::vector<std::unique_ptr<ResamplerType>> resampler_;
+  // Resamples all channels at once, with the channels of each sample
+  // contiguous in the column-major Matrix. Null for pass-thru.
+  std::unique_ptr<audio_dsp::QResampler<float>> resampler_;
 };
 
 // Test-only access to RationalFactorResampleCalculator methods.
@@ -393,26 +393,39 @@ absl::Status SpectrogramCalculator::ProcessVectorToOutput(
     CalculatorContext* cc) {
   std::unique_ptr<std::vector<OutputMatrixType>> spectrogram_matrices(
       new std::vector<OutputMatrixType>());
-  std::vector<std::vector<typename OutputMatrixType::Scalar>> output_vectors;
-
-  // Compute a spectrogram for each channel.
-  int num_output_time_frames;
-  for (int channel = 0; channel < input_stream.rows(); ++channel) {
-    output_vectors.clear();
-
-    // Copy one row (channel) of the input matrix into the std::vector.
-    std::vector<float> input_vector(input_stream.cols());
-    Eigen::Map<Matrix>(&input_vector[0], 1, input_vector.size()) =
-        input_stream.row(channel) * input_scale_;
-
-    if (reset_sample_buffer_) {
-      spectrogram_generators_[channel]->ResetSampleBuffer();
-    }
-    if (!spectrogram_generators_[channel]->ComputeSpectrogram(
-            input_vector, &output_vectors)) {
+  const int num_channels = input_stream.rows();
+  std::vector<std::vector<std::vector<typename OutputMatrixType::Scalar>>>
+      channel_output_vectors(num_channels);
+  std::vector<uint8_t> channel_ok(num_channels, 0);
+
+  // Compute a spectrogram for each channel. The channels have independent
+  // Spectrogram objects, so they are spread over the calculator's executor.
+  cc->ParallelFor(
+      0, num_channels, 1,
+      [this, &input_stream, &channel_output_vectors, &channel_ok](
+          int channel_begin, int channel_end) {
+        std::vector<float> input_vector(input_stream.cols());
+        for (int channel = channel_begin; channel < channel_end; ++channel) {
+          // Copy one row (channel) of the input matrix into the std::vector.
+          Eigen::Map<Matrix>(input_vector.data(), 1, input_vector.size()) =
+              input_stream.row(channel) * input_scale_;
+
+          if (reset_sample_buffer_) {
+            spectrogram_generators_[channel]->ResetSampleBuffer();
+          }
+          channel_ok[channel] =
+              spectrogram_generators_[channel]->ComputeSpectrogram(
+                  input_vector, &channel_output_vectors[channel]);
+        }
+      });
+
+  int num_output_time_frames = 0;
+  for (int channel = 0; channel < num_channels; ++channel) {
+    if (!channel_ok[channel]) {
       return absl::Status(absl::StatusCode::kInternal,
                           "Spectrogram returned failure");
     }
+    const auto& output_vectors = channel_output_vectors[channel];
     if (channel == 0) {
       // Record the number of time frames we expect from each channel.
       num_output_time_frames = output_vectors.size();
@@ -427,14 +440,15 @@ absl::Status SpectrogramCalculator::ProcessVectorToOutput(
       OutputMatrixType output_frames(num_output_channels_,
                                      output_vectors.size());
       for (int frame = 0; frame < output_vectors.size(); ++frame) {
-        Eigen::Map<const OutputMatrixType> frame_map(
-            &output_vectors[frame][0], output_vectors[frame].size(), 1);
-        // The underlying dsp object returns squared magnitudes; here
-        // we optionally translate to linear magnitude or dB.
         output_frames.col(frame) =
-            output_scale_ * postprocess_output_fn(frame_map);
+            Eigen::Map<const OutputMatrixType>(output_vectors[frame].data(),
+                                               output_vectors[frame].size(), 1);
       }
-      spectrogram_matrices->push_back(output_frames);
+      // The underlying dsp object returns squared magnitudes; here
+      // we optionally translate to linear magnitude or dB, for all frames
+      // at once.
+      spectrogram_matrices->push_back(output_scale_ *
+                                      postprocess_output_fn(output_frames));
     }
   }
   // If the input is very short, there may not be enough accumulated,
@@ -452,8 +466,8 @@ absl::Status SpectrogramCalculator::ProcessVectorToOutput(
           new OutputMatrixType(spectrogram_matrices->at(0)),
           CurrentOutputTimestamp(cc));
     }
-    cumulative_completed_frames_ += output_vectors.size();
-    last_completed_frames_ = output_vectors.size();
+    cumulative_completed_frames_ += num_output_time_frames;
+    last_completed_frames_ = num_output_time_frames;
     if (!use_local_timestamp_) {
       // In non-local timestamp mode the timestamp of the next packet will be
       // equal to CumulativeOutputTimestamp(). Inform the framework about this
@@ -0,0 +1,173 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Defines TimeSeriesExpressionCalculator.
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "Eigen/Core"
+#include "mediapipe/calculators/audio/time_series_expression_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/time_series_header.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/util/time_series_util.h"
+
+namespace mediapipe {
+namespace {
+
+using Operation = TimeSeriesExpressionCalculatorOptions::Operation;
+
+// Number of values processed at once, small enough for them to stay in the L1
+// cache while all operations are applied.
+constexpr int kBlockSize = 1024;
+
+}  // namespace
+
+// Applies a sequence of elementwise operations, optionally followed by a sum or
+// mean across channels, to each packet of a time series. This replaces chains
+// of e.g. ElementwiseSquareCalculator, StabilizedLogCalculator and
+// SumTimeSeriesAcrossChannelsCalculator by a single node, without their
+// intermediate matrices.
+//
+// The values are processed in blocks of consecutive samples: each block is
+// copied once and all operations are applied to it while it is cached.
+//
+// Example config computing the log energy of the input:
+// node {
+//   calculator: "TimeSeriesExpressionCalculator"
+//   input_stream: "input_time_series"
+//   output_stream: "log_energy_time_series"
+//   options {
+//     [mediapipe.TimeSeriesExpressionCalculatorOptions.ext] {
+//       operation { type: SQUARE }
+//       operation { type: LOG value: 0.00001 }
+//       reduction: SUM_ACROSS_CHANNELS
+//     }
+//   }
+// }
+class TimeSeriesExpressionCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<Matrix>(
+        // Input stream with TimeSeriesHeader.
+    );
+    cc->Outputs().Index(0).Set<Matrix>(
+        // Output stream with TimeSeriesHeader.
+    );
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    const auto& options = cc->Options<TimeSeriesExpressionCalculatorOptions>();
+    operations_.assign(options.operation().begin(), options.operation().end());
+    for (const Operation& operation : operations_) {
+      RET_CHECK(operation.type() != Operation::UNKNOWN)
+          << "Operation type must be set.";
+    }
+    reduction_ = options.reduction();
+
+    // If the input packets have a header, propagate the header to the output.
+    if (!cc->Inputs().Index(0).Header().IsEmpty()) {
+      TimeSeriesHeader input_header;
+      MP_RETURN_IF_ERROR(time_series_util::FillTimeSeriesHeaderIfValid(
+          cc->Inputs().Index(0).Header(), &input_header));
+      auto output_header = absl::make_unique<TimeSeriesHeader>(input_header);
+      if (reduction_ != TimeSeriesExpressionCalculatorOptions::NONE) {
+        output_header->set_num_channels(1);
+      }
+      cc->Outputs().Index(0).SetHeader(Adopt(output_header.release()));
+    }
+    cc->SetOffset(0);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const Matrix& input = cc->Inputs().Index(0).Get<Matrix>();
+    const int num_channels = input.rows();
+    const int num_samples = input.cols();
+    // Whole samples are processed at once so that reductions across channels
+    // only see values that all operations were applied to.
+    const int block_samples =
+        std::max(1, kBlockSize / std::max(1, num_channels));
+
+    std::unique_ptr<Matrix> output;
+    if (reduction_ == TimeSeriesExpressionCalculatorOptions::NONE) {
+      output = absl::make_unique<Matrix>(num_channels, num_samples);
+      for (int start = 0; start < num_samples; start += block_samples) {
+        const int size = std::min(block_samples, num_samples - start);
+        auto block = output->middleCols(start, size).array();
+        block = input.middleCols(start, size).array();
+        ApplyOperations(block);
+      }
+    } else {
+      output = absl::make_unique<Matrix>(1, num_samples);
+      for (int start = 0; start < num_samples; start += block_samples) {
+        const int size = std::min(block_samples, num_samples - start);
+        block_ = input.middleCols(start, size).array();
+        ApplyOperations(block_);
+        if (reduction_ ==
+            TimeSeriesExpressionCalculatorOptions::SUM_ACROSS_CHANNELS) {
+          output->middleCols(start, size) = block_.colwise().sum().matrix();
+        } else {
+          output->middleCols(start, size) = block_.colwise().mean().matrix();
+        }
+      }
+    }
+    cc->Outputs().Index(0).Add(output.release(), cc->InputTimestamp());
+    return absl::OkStatus();
+  }
+
+ private:
+  // Applies operations_ in place.
+  template <typename ArrayType>
+  void ApplyOperations(ArrayType&& values) const {
+    for (const Operation& operation : operations_) {
+      switch (operation.type()) {
+        case Operation::ABS:
+          values = values.abs();
+          break;
+        case Operation::SQUARE:
+          values = values.square();
+          break;
+        case Operation::SQRT:
+          values = values.sqrt();
+          break;
+        case Operation::LOG:
+          values = (values + operation.value()).log();
+          break;
+        case Operation::SCALE:
+          values *= operation.value();
+          break;
+        case Operation::OFFSET:
+          values += operation.value();
+          break;
+        case Operation::UNKNOWN:
+          break;
+      }
+    }
+  }
+
+  std::vector<Operation> operations_;
+  TimeSeriesExpressionCalculatorOptions::Reduction reduction_ =
+      TimeSeriesExpressionCalculatorOptions::NONE;
+  // Scratch block for reductions, reused across blocks and packets.
+  Eigen::ArrayXXf block_;
+};
+REGISTER_CALCULATOR(TimeSeriesExpressionCalculator);
+
+}  // namespace mediapipe
@@ -0,0 +1,125 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "Eigen/Core"
+#include "mediapipe/calculators/audio/time_series_expression_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/time_series_header.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/time_series_test_util.h"
+
+namespace mediapipe {
+
+const float kStabilizer = 0.1;
+const int kNumChannels = 3;
+// Larger than one block of the calculator.
+const int kNumSamples = 1000;
+const int kNumPackets = 3;
+
+using Operation = TimeSeriesExpressionCalculatorOptions::Operation;
+
+class TimeSeriesExpressionCalculatorTest
+    : public TimeSeriesCalculatorTest<TimeSeriesExpressionCalculatorOptions> {
+ protected:
+  void SetUp() override {
+    calculator_name_ = "TimeSeriesExpressionCalculator";
+    input_sample_rate_ = 8000.0;
+    num_input_channels_ = kNumChannels;
+    num_input_samples_ = kNumSamples;
+  }
+
+  void AddOperation(Operation::Type type, float value = 0.0f) {
+    Operation* operation = options_.add_operation();
+    operation->set_type(type);
+    operation->set_value(value);
+  }
+
+  // Appends random input packets and returns their matrices.
+  std::vector<Matrix> AppendRandomInputPackets() {
+    std::vector<Matrix> input_data_matrices;
+    for (int input_packet = 0; input_packet < kNumPackets; ++input_packet) {
+      const int64_t timestamp =
+          input_packet * Timestamp::kTimestampUnitsPerSecond;
+      Matrix input_data_matrix = Matrix::Random(kNumChannels, kNumSamples);
+      input_data_matrices.push_back(input_data_matrix);
+      AppendInputPacket(new Matrix(input_data_matrix), timestamp);
+    }
+    return input_data_matrices;
+  }
+};
+
+TEST_F(TimeSeriesExpressionCalculatorTest, MatchesChainedOperations) {
+  AddOperation(Operation::SQUARE);
+  AddOperation(Operation::SCALE, 2.0f);
+  AddOperation(Operation::LOG, kStabilizer);
+
+  InitializeGraph();
+  FillInputHeader();
+  const std::vector<Matrix> input_data_matrices = AppendRandomInputPackets();
+
+  MP_ASSERT_OK(RunGraph());
+  ExpectOutputHeaderEqualsInputHeader();
+  for (int output_packet = 0; output_packet < kNumPackets; ++output_packet) {
+    ExpectApproximatelyEqual(
+        (2.0f * input_data_matrices[output_packet].array().square() +
+         kStabilizer)
+            .log()
+            .matrix(),
+        runner_->Outputs().Index(0).packets[output_packet].Get<Matrix>());
+  }
+}
+
+TEST_F(TimeSeriesExpressionCalculatorTest, SumsAcrossChannels) {
+  AddOperation(Operation::ABS);
+  AddOperation(Operation::OFFSET, 1.0f);
+  AddOperation(Operation::SQRT);
+  options_.set_reduction(
+      TimeSeriesExpressionCalculatorOptions::SUM_ACROSS_CHANNELS);
+
+  InitializeGraph();
+  FillInputHeader();
+  const std::vector<Matrix> input_data_matrices = AppendRandomInputPackets();
+
+  MP_ASSERT_OK(RunGraph());
+  EXPECT_EQ(1, runner_->Outputs()
+                   .Index(0)
+                   .header.Get<TimeSeriesHeader>()
+                   .num_channels());
+  for (int output_packet = 0; output_packet < kNumPackets; ++output_packet) {
+    ExpectApproximatelyEqual(
+        (input_data_matrices[output_packet].array().abs() + 1.0f)
+            .sqrt()
+            .colwise()
+            .sum()
+            .matrix(),
+        runner_->Outputs().Index(0).packets[output_packet].Get<Matrix>());
+  }
+}
+
+TEST_F(TimeSeriesExpressionCalculatorTest, MissingOperationTypeFails) {
+  options_.add_operation()->set_value(1.0f);
+  InitializeGraph();
+  FillInputHeader();
+  AppendRandomInputPackets();
+  ASSERT_FALSE(RunGraph().ok());
+}
+
+}  // namespace mediapipe
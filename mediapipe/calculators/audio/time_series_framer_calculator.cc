@@ -144,9 +144,10 @@ class TimeSeriesFramerCalculator : public CalculatorBase {
     // Total number of available samples over all blocks.
     int num_samples() const { return num_samples_; }
 
-    // Pushes a new block of samples on the back of the buffer with `timestamp`
-    // being the input timestamp of the packet containing the Matrix.
-    void Push(const Matrix& samples, Timestamp timestamp);
+    // Pushes the Matrix in `samples` as a new block of samples on the back of
+    // the buffer. The buffer keeps a reference to the packet instead of
+    // copying its samples.
+    void Push(const Packet& samples);
     // Copies `count` samples from the front of the buffer. If there are fewer
     // samples than this, the result is zero padded to have `count` samples.
     // The timestamp of the last copied sample is written to *last_timestamp.
@@ -160,17 +161,18 @@ class TimeSeriesFramerCalculator : public CalculatorBase {
 
    private:
     struct Block {
-      // Matrix of num_channels rows by num_samples columns, a block of possibly
-      // multiple samples.
-      Matrix samples;
+      // Packet holding a Matrix of num_channels rows by num_samples columns, a
+      // block of possibly multiple samples.
+      Packet packet;
       // Timestamp of the first sample in the Block. This comes from the input
       // packet's timestamp that contains this Matrix.
       Timestamp timestamp;
 
       Block() : timestamp(Timestamp::Unstarted()) {}
-      Block(const Matrix& samples, Timestamp timestamp)
-          : samples(samples), timestamp(timestamp) {}
-      int num_samples() const { return samples.cols(); }
+      explicit Block(const Packet& packet)
+          : packet(packet), timestamp(packet.Timestamp()) {}
+      const Matrix& samples() const { return packet.Get<Matrix>(); }
+      int num_samples() const { return samples().cols(); }
     };
     std::vector<Block> blocks_;
     // Number of timestamp units per sample. Used to compute timestamps as
@@ -193,10 +195,10 @@ class TimeSeriesFramerCalculator : public CalculatorBase {
 };
 REGISTER_CALCULATOR(TimeSeriesFramerCalculator);
 
-void TimeSeriesFramerCalculator::SampleBlockBuffer::Push(const Matrix& samples,
-                                                         Timestamp timestamp) {
-  num_samples_ += samples.cols();
-  blocks_.emplace_back(samples, timestamp);
+void TimeSeriesFramerCalculator::SampleBlockBuffer::Push(
+    const Packet& samples) {
+  num_samples_ += samples.Get<Matrix>().cols();
+  blocks_.emplace_back(samples);
 }
 
 Matrix TimeSeriesFramerCalculator::SampleBlockBuffer::CopySamples(
@@ -214,7 +216,7 @@ Matrix TimeSeriesFramerCalculator::SampleBlockBuffer::CopySamples(
     for (auto it = blocks_.begin(); it != blocks_.end() && count > 0; ++it) {
       n = std::min(it->num_samples() - offset, count);
       // Copy `n` samples from the next block.
-      copied.middleCols(num_copied, n) = it->samples.middleCols(offset, n);
+      copied.middleCols(num_copied, n) = it->samples().middleCols(offset, n);
       count -= n;
       num_copied += n;
       last_block_ts = it->timestamp;
@@ -276,8 +278,7 @@ absl::Status TimeSeriesFramerCalculator::Process(CalculatorContext* cc) {
   }
 
   // Add input data to the internal buffer.
-  sample_buffer_.Push(cc->Inputs().Index(0).Get<Matrix>(),
-                      cc->InputTimestamp());
+  sample_buffer_.Push(cc->Inputs().Index(0).Value());
 
   // Construct and emit framed output packets.
   while (sample_buffer_.num_samples() >=
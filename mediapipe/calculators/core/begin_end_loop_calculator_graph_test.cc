@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <string>
 #include <utility>
@@ -20,6 +21,8 @@
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "mediapipe/calculators/core/begin_loop_calculator.h"
 #include "mediapipe/calculators/core/end_loop_calculator.h"
@@ -167,6 +170,88 @@ TEST_F(BeginEndLoopCalculatorGraphTest, MultipleVectors) {
                   PacketOfIntsEq(input_timestamp2, std::vector<int>{3, 4})));
 }
 
+// Increments its input after a delay, and records how many invocations of
+// Process overlap.
+class SlowIncrementCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<int>();
+    cc->Outputs().Index(0).Set<int>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    cc->SetOffset(TimestampDiff(0));
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const int running = ++num_running_;
+    int max_running = max_running_.load();
+    while (running > max_running &&
+           !max_running_.compare_exchange_weak(max_running, running)) {
+    }
+    absl::SleepFor(absl::Milliseconds(20));
+    --num_running_;
+    const int& input_int = cc->Inputs().Index(0).Get<int>();
+    cc->Outputs().Index(0).AddPacket(
+        MakePacket<int>(input_int + 1).At(cc->InputTimestamp()));
+    return absl::OkStatus();
+  }
+
+  static std::atomic<int> num_running_;
+  static std::atomic<int> max_running_;
+};
+std::atomic<int> SlowIncrementCalculator::num_running_{0};
+std::atomic<int> SlowIncrementCalculator::max_running_{0};
+REGISTER_CALCULATOR(SlowIncrementCalculator);
+
+TEST(BeginEndLoopCalculatorParallelBodyTest, RunsItemsConcurrentlyInOrder) {
+  auto graph_config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    num_threads: 4
+    input_stream: "ints"
+    node {
+      calculator: "BeginLoopIntegerCalculator"
+      input_stream: "ITERABLE:ints"
+      output_stream: "ITEM:int"
+      output_stream: "BATCH_END:timestamp"
+    }
+    node {
+      calculator: "SlowIncrementCalculator"
+      input_stream: "int"
+      output_stream: "int_plus_one"
+      max_in_flight: 4
+    }
+    node {
+      calculator: "EndLoopIntegersCalculator"
+      input_stream: "ITEM:int_plus_one"
+      input_stream: "BATCH_END:timestamp"
+      output_stream: "ITERABLE:ints_plus_one"
+    }
+  )pb");
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("ints_plus_one", &graph_config, &output_packets);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "ints", MakePacket<std::vector<int>>(std::vector<int>{0, 1, 2, 3, 4, 5})
+                  .At(Timestamp(0))));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "ints", MakePacket<std::vector<int>>(std::vector<int>{6, 7})
+                  .At(Timestamp(1))));
+  MP_ASSERT_OK(graph.CloseAllPacketSources());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  EXPECT_THAT(output_packets,
+              testing::ElementsAre(
+                  PacketOfIntsEq(Timestamp(0),
+                                 std::vector<int>{1, 2, 3, 4, 5, 6}),
+                  PacketOfIntsEq(Timestamp(1), std::vector<int>{7, 8})));
+  EXPECT_GT(SlowIncrementCalculator::max_running_.load(), 1);
+  EXPECT_LE(SlowIncrementCalculator::max_running_.load(), 4);
+}
+
 TEST(BeginEndLoopCalculatorPossibleDataRaceTest,
      EndLoopForIntegersDoesNotRace) {
   auto graph_config = ParseTextProtoOrDie<CalculatorGraphConfig>(
@@ -81,6 +81,19 @@ namespace mediapipe {
 //     unvectorized (see SplitVectorCalculator).
 //   - Iterable packets have to be consumable (have a unique owner) or items
 //     items have to be copyable, which is not the case e.g. for Tensors.
+//
+// By default, each node of the loop body processes one item at a time. A node
+// whose calculator keeps no state across timestamps can process several items
+// concurrently if it sets max_in_flight, or if its calculator declares
+// SetProcessReentrant in GetContract; the EndLoopCalculator still gathers the
+// outputs in item order. Stateful nodes of the loop body must not do either:
+//
+// node {
+//   calculator:    "InputToOutputConverterCalculator"
+//   input_stream:  "INPUT:input_iterator"
+//   output_stream: "OUTPUT:output_iterator"
+//   max_in_flight: 4
+// }
 
 template <typename IterableT>
 class BeginLoopCalculator : public CalculatorBase {
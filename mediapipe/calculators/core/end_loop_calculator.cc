@@ -66,6 +66,10 @@ typedef EndLoopCalculator<std::vector<::mediapipe::Detection>>
     EndLoopDetectionCalculator;
 REGISTER_CALCULATOR(EndLoopDetectionCalculator);
 
+typedef EndLoopCalculator<std::vector<std::vector<::mediapipe::Detection>>>
+    EndLoopDetectionVectorCalculator;
+REGISTER_CALCULATOR(EndLoopDetectionVectorCalculator);
+
 typedef EndLoopCalculator<std::vector<Matrix>> EndLoopMatrixCalculator;
 REGISTER_CALCULATOR(EndLoopMatrixCalculator);
 
@@ -13,11 +13,17 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
+#include "absl/time/time.h"
 #include "mediapipe/calculators/core/flow_limiter_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/deps/monotonic_clock.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/util/header_util.h"
 
@@ -27,6 +33,8 @@ constexpr char kFinishedTag[] = "FINISHED";
 constexpr char kAllowTag[] = "ALLOW";
 constexpr char kMaxInFlightTag[] = "MAX_IN_FLIGHT";
 constexpr char kOptionsTag[] = "OPTIONS";
+constexpr char kStatsTag[] = "STATS";
+constexpr char kClockTag[] = "CLOCK";
 
 // FlowLimiterCalculator is used to limit the number of frames in flight
 // by dropping input frames when necessary.
@@ -69,6 +77,15 @@ constexpr char kOptionsTag[] = "OPTIONS";
 // input streams are treated as auxiliary input streams.  The auxiliary input
 // streams are limited to timestamps allowed by the "ALLOW" stream.
 //
+// With `adaptive_limit`, the number of frames in flight is adjusted to keep
+// the time from releasing a frame to its "FINISHED" signal within
+// `target_latency`: the limit grows slowly while frames finish in time and is
+// cut back when a frame is late. The optional "STATS" output stream reports
+// the current limit and the drop rate as a FlowLimiterStats at each input
+// frame. The optional "CLOCK" input side packet, a
+// std::shared_ptr<mediapipe::Clock>, replaces the monotonic clock used to
+// measure latency.
+//
 class FlowLimiterCalculator : public CalculatorBase {
  public:
   static absl::Status GetContract(CalculatorContract* cc) {
@@ -86,6 +103,11 @@ class FlowLimiterCalculator : public CalculatorBase {
     cc->Inputs().Get("FINISHED", 0).SetAny();
     cc->InputSidePackets().Tag(kMaxInFlightTag).Set<int>().Optional();
     cc->Outputs().Tag(kAllowTag).Set<bool>().Optional();
+    cc->Outputs().Tag(kStatsTag).Set<FlowLimiterStats>().Optional();
+    cc->InputSidePackets()
+        .Tag(kClockTag)
+        .Set<std::shared_ptr<mediapipe::Clock>>()
+        .Optional();
     cc->SetInputStreamHandler("ImmediateInputStreamHandler");
     cc->SetProcessTimestampBounds(true);
     return absl::OkStatus();
@@ -98,6 +120,24 @@ class FlowLimiterCalculator : public CalculatorBase {
       options_.set_max_in_flight(
           cc->InputSidePackets().Tag(kMaxInFlightTag).Get<int>());
     }
+    if (cc->InputSidePackets().HasTag(kClockTag)) {
+      clock_ = cc->InputSidePackets()
+                   .Tag(kClockTag)
+                   .Get<std::shared_ptr<mediapipe::Clock>>();
+    } else {
+      clock_ = std::shared_ptr<mediapipe::Clock>(
+          MonotonicClock::CreateSynchronizedMonotonicClock());
+    }
+    if (options_.has_adaptive_limit()) {
+      const auto& adaptive = options_.adaptive_limit();
+      RET_CHECK_GT(adaptive.target_latency(), 0);
+      RET_CHECK_GE(adaptive.min_limit(), 1);
+      RET_CHECK_GE(adaptive.max_limit(), adaptive.min_limit());
+      RET_CHECK(adaptive.multiplicative_decrease() > 0 &&
+                adaptive.multiplicative_decrease() < 1);
+    }
+    in_flight_limit_ = options_.max_in_flight();
+    ClampInFlightLimit();
     input_queues_.resize(cc->Inputs().NumEntries(""));
     allowed_[Timestamp::Unset()] = true;
     RET_CHECK_OK(CopyInputHeadersToOutputs(cc->Inputs(), &(cc->Outputs())));
@@ -111,8 +151,12 @@ class FlowLimiterCalculator : public CalculatorBase {
     // Process the FINISHED input stream.
     Packet finished_packet = cc->Inputs().Tag(kFinishedTag).Value();
     if (finished_packet.Timestamp() == cc->InputTimestamp()) {
+      const absl::Time now = clock_->TimeNow();
       while (!frames_in_flight_.empty() &&
-             frames_in_flight_.front() <= finished_packet.Timestamp()) {
+             frames_in_flight_.front().timestamp <=
+                 finished_packet.Timestamp()) {
+        FinishFrame(frames_in_flight_.front(),
+                    now - frames_in_flight_.front().release_time);
         frames_in_flight_.pop_front();
       }
     }
@@ -132,7 +176,8 @@ class FlowLimiterCalculator : public CalculatorBase {
     if (timeout > 0 && latest_ts == cc->InputTimestamp() &&
         latest_ts < Timestamp::Max()) {
       while (!frames_in_flight_.empty() &&
-             (latest_ts - frames_in_flight_.front()) > timeout) {
+             (latest_ts - frames_in_flight_.front().timestamp) > timeout) {
+        FinishFrame(frames_in_flight_.front(), absl::InfiniteDuration());
         frames_in_flight_.pop_front();
       }
     }
@@ -144,7 +189,7 @@ class FlowLimiterCalculator : public CalculatorBase {
       input_queue.pop_front();
       cc->Outputs().Get("", 0).AddPacket(packet);
       SendAllow(true, packet.Timestamp(), cc);
-      frames_in_flight_.push_back(packet.Timestamp());
+      frames_in_flight_.push_back({packet.Timestamp(), clock_->TimeNow()});
     }
 
     // Limit the number of queued frames.
@@ -167,6 +212,9 @@ class FlowLimiterCalculator : public CalculatorBase {
       if (cc->Outputs().HasTag(kAllowTag)) {
         SetNextTimestampBound(bound, &cc->Outputs().Tag(kAllowTag));
       }
+      if (cc->Outputs().HasTag(kStatsTag)) {
+        SetNextTimestampBound(bound, &cc->Outputs().Tag(kStatsTag));
+      }
     }
 
     ProcessAuxiliaryInputs(cc);
@@ -187,10 +235,50 @@ class FlowLimiterCalculator : public CalculatorBase {
   }
 
  private:
+  // A frame released for processing.
+  struct FrameInFlight {
+    Timestamp timestamp;
+    absl::Time release_time;
+  };
+
+  // Returns the number of frames that can be in flight at one time.
+  int MaxInFlight() const {
+    if (options_.has_adaptive_limit()) {
+      return static_cast<int>(std::floor(in_flight_limit_));
+    }
+    return options_.max_in_flight();
+  }
+
   // Returns true if an additional frame can be released for processing.
   // The "ALLOW" output stream indicates this condition at each input frame.
-  bool ProcessingAllowed() {
-    return frames_in_flight_.size() < options_.max_in_flight();
+  bool ProcessingAllowed() { return frames_in_flight_.size() < MaxInFlight(); }
+
+  // Records the latency of a frame that finished processing, and adjusts the
+  // adaptive in-flight limit to it.
+  void FinishFrame(const FrameInFlight& frame, absl::Duration latency) {
+    last_latency_ = latency;
+    if (!options_.has_adaptive_limit()) return;
+    const auto& adaptive = options_.adaptive_limit();
+    if (latency <= absl::Microseconds(adaptive.target_latency())) {
+      // Grows by `additive_increase` once the current limit of frames have
+      // finished in time.
+      in_flight_limit_ += adaptive.additive_increase() / in_flight_limit_;
+    } else if (frame.timestamp > last_decrease_timestamp_) {
+      // The frames released before this decrease were admitted under the
+      // previous limit, so their latency does not decrease it again.
+      in_flight_limit_ *= adaptive.multiplicative_decrease();
+      last_decrease_timestamp_ = last_released_timestamp_;
+    }
+    ClampInFlightLimit();
+  }
+
+  // Keeps the adaptive in-flight limit within its configured range.
+  void ClampInFlightLimit() {
+    if (!options_.has_adaptive_limit()) return;
+    const auto& adaptive = options_.adaptive_limit();
+    in_flight_limit_ =
+        std::clamp<double>(in_flight_limit_, adaptive.min_limit(),
+                           adaptive.max_limit());
   }
 
   // Outputs a packet indicating whether a frame was sent or dropped.
@@ -199,6 +287,25 @@ class FlowLimiterCalculator : public CalculatorBase {
       cc->Outputs().Tag(kAllowTag).AddPacket(MakePacket<bool>(allow).At(ts));
     }
     allowed_[ts] = allow;
+    if (allow) {
+      ++frames_released_;
+      last_released_timestamp_ = ts;
+    } else {
+      ++frames_dropped_;
+    }
+    if (cc->Outputs().HasTag(kStatsTag)) {
+      FlowLimiterStats stats;
+      stats.set_max_in_flight(MaxInFlight());
+      if (last_latency_ < absl::InfiniteDuration()) {
+        stats.set_latency(absl::ToInt64Microseconds(last_latency_));
+      }
+      stats.set_frames_released(frames_released_);
+      stats.set_frames_dropped(frames_dropped_);
+      stats.set_drop_rate(static_cast<float>(frames_dropped_) /
+                          (frames_released_ + frames_dropped_));
+      cc->Outputs().Tag(kStatsTag).AddPacket(
+          MakePacket<FlowLimiterStats>(std::move(stats)).At(ts));
+    }
   }
 
   // Returns true if a timestamp falls within a range of allowed timestamps.
@@ -259,8 +366,17 @@ class FlowLimiterCalculator : public CalculatorBase {
  private:
   FlowLimiterCalculatorOptions options_;
   std::vector<std::deque<Packet>> input_queues_;
-  std::deque<Timestamp> frames_in_flight_;
+  std::deque<FrameInFlight> frames_in_flight_;
   std::map<Timestamp, bool> allowed_;
+
+  std::shared_ptr<mediapipe::Clock> clock_;
+  // The adaptive in-flight limit, of which the integer part applies.
+  double in_flight_limit_ = 1;
+  Timestamp last_released_timestamp_ = Timestamp::Unset();
+  Timestamp last_decrease_timestamp_ = Timestamp::Unset();
+  absl::Duration last_latency_ = absl::InfiniteDuration();
+  int64_t frames_released_ = 0;
+  int64_t frames_dropped_ = 0;
 };
 REGISTER_CALCULATOR(FlowLimiterCalculator);
 
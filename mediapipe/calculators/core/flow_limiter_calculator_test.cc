@@ -24,6 +24,7 @@
 #include "mediapipe/calculators/core/flow_limiter_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -980,5 +981,100 @@ TEST_F(FlowLimiterCalculatorTest, AuxiliaryInputs) {
               ElementsAreArray(PacketMatchers<bool>(expected_allow)));
 }
 
+// A clock that advances only when told to.
+class ManualClock : public mediapipe::Clock {
+ public:
+  absl::Time TimeNow() override { return now_; }
+  void Sleep(absl::Duration d) override { now_ += d; }
+  void SleepUntil(absl::Time wakeup_time) override {
+    now_ = std::max(now_, wakeup_time);
+  }
+
+ private:
+  absl::Time now_ = absl::UnixEpoch();
+};
+
+// Shows that the adaptive limit grows while frames finish within the target
+// latency, and shrinks once when the frames in flight are late.
+TEST(FlowLimiterCalculatorAdaptiveTest, AdaptsToLatency) {
+  CalculatorGraphConfig config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: 'in'
+        input_stream: 'finished'
+        node {
+          calculator: 'FlowLimiterCalculator'
+          input_side_packet: 'CLOCK:clock'
+          input_stream: 'in'
+          input_stream: 'FINISHED:finished'
+          output_stream: 'out'
+          output_stream: 'ALLOW:allow'
+          output_stream: 'STATS:stats'
+          options {
+            [mediapipe.FlowLimiterCalculatorOptions.ext] {
+              max_in_flight: 1
+              max_in_queue: 0
+              adaptive_limit {
+                target_latency: 10000
+                min_limit: 1
+                max_limit: 4
+              }
+            }
+          }
+        }
+      )pb");
+  std::vector<Packet> allow_packets;
+  std::vector<Packet> stats_packets;
+  tool::AddVectorSink("allow", &config, &allow_packets);
+  tool::AddVectorSink("stats", &config, &stats_packets);
+  auto clock = std::make_shared<ManualClock>();
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(
+      config, {{"clock", MakePacket<std::shared_ptr<mediapipe::Clock>>(
+                             std::shared_ptr<mediapipe::Clock>(clock))}}));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  auto send = [&](const std::string& stream, int64_t t) {
+    MP_EXPECT_OK(graph.AddPacketToInputStream(
+        stream, MakePacket<int>(0).At(Timestamp(t))));
+    MP_EXPECT_OK(graph.WaitUntilIdle());
+  };
+
+  // Frame 1 finishes in time, which raises the limit from 1 to 2.
+  send("in", 1);
+  clock->Sleep(absl::Milliseconds(5));
+  send("finished", 1);
+  // Frames 2 and 3 are both released, and finish in time.
+  send("in", 2);
+  send("in", 3);
+  clock->Sleep(absl::Milliseconds(5));
+  send("finished", 3);
+  // The limit is now between 2 and 3, so frame 6 is dropped.
+  send("in", 4);
+  send("in", 5);
+  send("in", 6);
+  // Frames 4 and 5 are late, which halves the limit only once.
+  clock->Sleep(absl::Milliseconds(20));
+  send("finished", 5);
+  send("in", 7);
+  send("in", 8);
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  EXPECT_THAT(PacketValues<bool>(allow_packets),
+              testing::ElementsAre(true, true, true, true, true, false, true,
+                                   false));
+  std::vector<int> limits;
+  for (const Packet& packet : stats_packets) {
+    limits.push_back(packet.Get<FlowLimiterStats>().max_in_flight());
+  }
+  EXPECT_THAT(limits, testing::ElementsAre(1, 2, 2, 2, 2, 2, 1, 1));
+  const auto& stats = stats_packets.back().Get<FlowLimiterStats>();
+  EXPECT_EQ(stats.latency(), 20000);
+  EXPECT_EQ(stats.frames_released(), 6);
+  EXPECT_EQ(stats.frames_dropped(), 2);
+  EXPECT_FLOAT_EQ(stats.drop_rate(), 0.25);
+}
+
 }  // anonymous namespace
 }  // namespace mediapipe
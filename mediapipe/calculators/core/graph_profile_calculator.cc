@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <utility>
 
 #include "mediapipe/calculators/core/graph_profile_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
@@ -22,6 +23,7 @@
 #include "mediapipe/framework/calculator_profile.pb.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/profiler/critical_path.h"
 
 namespace mediapipe {
 namespace api2 {
@@ -34,19 +36,31 @@ namespace api2 {
 // canonicalized graph config and, if tracing is enabled, calculator names in
 // graph traces. Subsequent profiles omit this information.
 //
+// If the optional "CRITICAL_PATH" output stream is connected, the calculator
+// also outputs the GraphCriticalPaths computed from each captured GraphTrace,
+// see ComputeCriticalPaths. This requires trace_enabled in the ProfilerConfig
+// (and not trace_log_instant_events).
+//
+// If enable_memory_accounting is set in the ProfilerConfig, the calculator
+// profiles also report the bytes held by the packets queued in each input
+// stream and their high-water marks since the previous output.
+//
 // Example config:
 // node {
 //   calculator: "GraphProfileCalculator"
 //   output_stream: "FRAME:any_frame"
 //   output_stream: "PROFILE:graph_profile"
+//   output_stream: "CRITICAL_PATH:critical_paths"
 // }
 //
 class GraphProfileCalculator : public Node {
  public:
   static constexpr Input<AnyType>::Multiple kFrameIn{"FRAME"};
   static constexpr Output<GraphProfile> kProfileOut{"PROFILE"};
+  static constexpr Output<GraphCriticalPaths>::Optional kCriticalPathOut{
+      "CRITICAL_PATH"};
 
-  MEDIAPIPE_NODE_CONTRACT(kFrameIn, kProfileOut);
+  MEDIAPIPE_NODE_CONTRACT(kFrameIn, kProfileOut, kCriticalPathOut);
 
   static absl::Status UpdateContract(CalculatorContract* cc) {
     return absl::OkStatus();
@@ -63,6 +77,15 @@ class GraphProfileCalculator : public Node {
       MP_RETURN_IF_ERROR(cc->GetProfilingContext()->CaptureProfile(
           &result, first_profile ? PopulateGraphConfig::kFull
                                  : PopulateGraphConfig::kNo));
+      if (kCriticalPathOut(cc).IsConnected()) {
+        GraphCriticalPaths critical_paths;
+        for (const GraphTrace& trace : result.graph_trace()) {
+          GraphCriticalPaths trace_paths;
+          ComputeCriticalPaths(trace, &trace_paths);
+          critical_paths.MergeFrom(trace_paths);
+        }
+        kCriticalPathOut(cc).Send(std::move(critical_paths));
+      }
       kProfileOut(cc).Send(result);
     }
     return absl::OkStatus();
@@ -120,7 +120,7 @@ class GraphProfileCalculatorTest : public ::testing::Test {
 
     // Start running the graph.
     std::shared_ptr<SimulationClockExecutor> executor(
-        new SimulationClockExecutor(3 /*num_threads*/));
+        new SimulationClockExecutor(num_threads_));
     CalculatorGraph graph;
     MP_ASSERT_OK(graph.SetExecutor("", executor));
     graph.profiler()->SetClock(executor->GetClock());
@@ -150,6 +150,8 @@ class GraphProfileCalculatorTest : public ::testing::Test {
   }
 
   CalculatorGraphConfig graph_config_;
+  // The SimulationClockExecutor threads, one more for each added sink node.
+  int num_threads_ = 3;
 };
 
 TEST_F(GraphProfileCalculatorTest, GraphProfile) {
@@ -208,5 +210,47 @@ TEST_F(GraphProfileCalculatorTest, GraphProfile) {
               mediapipe::EqualsProto(expected_profile));
 }
 
+TEST_F(GraphProfileCalculatorTest, CriticalPath) {
+  SetUpProfileGraph();
+  graph_config_.mutable_node(1)->add_output_stream(
+      "CRITICAL_PATH:critical_paths");
+  std::vector<Packet> critical_path_packets;
+  tool::AddVectorSink("critical_paths", &graph_config_,
+                      &critical_path_packets);
+  num_threads_ = 4;
+  auto profiler_config = graph_config_.mutable_profiler_config();
+  profiler_config->set_enable_profiler(true);
+  profiler_config->set_trace_enabled(true);
+  profiler_config->set_trace_log_disabled(true);
+
+  // Run the graph with a series of packet sets.
+  std::vector<std::vector<Packet>> input_sets = {
+      {PacketAt(10000)},  //
+      {PacketAt(20000)},  //
+      {PacketAt(30000)},  //
+      {PacketAt(40000)},
+  };
+  std::vector<Packet> output_packets;
+  RunGraph(input_sets, &output_packets);
+  ASSERT_EQ(output_packets.size(), 2);
+  ASSERT_EQ(critical_path_packets.size(), 2);
+
+  // Each SleepCalculator call is the whole critical path of its timestamp.
+  std::vector<TimestampCriticalPath> sleep_paths;
+  for (const Packet& packet : critical_path_packets) {
+    for (const auto& path :
+         packet.Get<GraphCriticalPaths>().timestamp_path()) {
+      if (path.input_timestamp() == 10000 || path.input_timestamp() == 20000) {
+        sleep_paths.push_back(path);
+      }
+    }
+  }
+  ASSERT_EQ(sleep_paths.size(), 2);
+  for (const TimestampCriticalPath& path : sleep_paths) {
+    EXPECT_EQ(path.latency(), 5000);
+    EXPECT_THAT(path.critical_path_node_id(), ElementsAre(0));
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
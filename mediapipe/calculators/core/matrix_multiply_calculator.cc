@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+
 #include "Eigen/Core"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -23,27 +25,55 @@ namespace api2 {
 // Perform a (left) matrix multiply.  Meaning (output = A * input)
 // where A is the matrix which is provided as an input side packet.
 //
+// If the optional SUBTRAHEND side packet is given, the calculator computes
+// (output = A * input - SUBTRAHEND) in a single output matrix instead of
+// chaining a MatrixSubtractCalculator, which saves one matrix allocation and
+// one pass over the data per packet.
+//
 // Example config:
 // node {
 //   calculator: "MatrixMultiplyCalculator"
 //   input_stream: "samples"
 //   output_stream: "multiplied_samples"
 //   input_side_packet: "multiplication_matrix"
+//   input_side_packet: "SUBTRAHEND:offsets"
 // }
 class MatrixMultiplyCalculator : public Node {
  public:
   static constexpr Input<Matrix> kIn{""};
   static constexpr Output<Matrix> kOut{""};
   static constexpr SideInput<Matrix> kSide{""};
+  static constexpr SideInput<Matrix>::Optional kSubtrahend{"SUBTRAHEND"};
 
-  MEDIAPIPE_NODE_CONTRACT(kIn, kOut, kSide);
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut, kSide, kSubtrahend);
 
+  absl::Status Open(CalculatorContext* cc) override;
   absl::Status Process(CalculatorContext* cc) override;
 };
 MEDIAPIPE_REGISTER_NODE(MatrixMultiplyCalculator);
 
+absl::Status MatrixMultiplyCalculator::Open(CalculatorContext* cc) {
+  if (kSubtrahend(cc).IsConnected()) {
+    RET_CHECK_EQ(kSubtrahend(cc)->rows(), kSide(cc)->rows())
+        << "SUBTRAHEND must have as many rows as the multiplication matrix.";
+  }
+  return absl::OkStatus();
+}
+
 absl::Status MatrixMultiplyCalculator::Process(CalculatorContext* cc) {
-  kOut(cc).Send(*kSide(cc) * *kIn(cc));
+  const Matrix& side = *kSide(cc);
+  const Matrix& input = *kIn(cc);
+  auto output = std::make_unique<Matrix>(side.rows(), input.cols());
+  output->noalias() = side * input;
+  if (kSubtrahend(cc).IsConnected()) {
+    const Matrix& subtrahend = *kSubtrahend(cc);
+    if (subtrahend.cols() != output->cols()) {
+      return absl::InvalidArgumentError(
+          "SUBTRAHEND must have as many columns as the input matrix.");
+    }
+    *output -= subtrahend;
+  }
+  kOut(cc).Send(std::move(output));
   return absl::OkStatus();
 }
 
@@ -23,6 +23,7 @@
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/framework/tool/validate_type.h"
 
@@ -236,5 +237,46 @@ TEST(MatrixMultiplyCalculatorTest, Multiply) {
   EXPECT_EQ(samples.cols(), i);
 }
 
+// Applies the multiplication and the SUBTRAHEND offset in one calculator.
+TEST(MatrixMultiplyCalculatorTest, MultiplyAndSubtract) {
+  CalculatorGraphConfig::Node node_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+        calculator: "MatrixMultiplyCalculator"
+        input_stream: "samples"
+        output_stream: "multiplied_samples"
+        input_side_packet: "multiplication_matrix"
+        input_side_packet: "SUBTRAHEND:offsets"
+      )pb");
+  CalculatorRunner runner(node_config);
+  Matrix* matrix = new Matrix();
+  MatrixFromTextProto(kMatrixText, matrix);
+  runner.MutableSidePackets()->Index(0) = Adopt(matrix);
+  Matrix* offsets = new Matrix(3, 1);
+  *offsets << 1.0f, 2.0f, 3.0f;
+  runner.MutableSidePackets()->Tag("SUBTRAHEND") = Adopt(offsets);
+
+  Matrix samples;
+  MatrixFromTextProto(kSamplesText, &samples);
+  Matrix expected;
+  MatrixFromTextProto(kExpectedText, &expected);
+
+  for (int i = 0; i < samples.cols(); ++i) {
+    Eigen::MatrixXf* sample = new Eigen::MatrixXf(samples.block(0, i, 4, 1));
+    runner.MutableInputs()->Index(0).packets.push_back(
+        Adopt(sample).At(Timestamp(i)));
+  }
+
+  MP_ASSERT_OK(runner.Run());
+  ASSERT_EQ(samples.cols(), runner.Outputs().Index(0).packets.size());
+  for (int i = 0; i < samples.cols(); ++i) {
+    const Matrix& result =
+        runner.Outputs().Index(0).packets[i].Get<Matrix>();
+    ASSERT_EQ(3, result.rows());
+    EXPECT_NEAR(
+        (expected.block(0, i, 3, 1) - *offsets - result).cwiseAbs().sum(),
+        0.0, 1e-5);
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <memory>
+
 #include "Eigen/Core"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -21,11 +23,16 @@
 namespace mediapipe {
 namespace api2 {
 
+constexpr char kMinuendTag[] = "MINUEND";
+constexpr char kSubtrahendTag[] = "SUBTRAHEND";
+
 // Subtract input matrix from the side input matrix and vice versa. The matrices
 // must have the same dimension.
 // Based on the tag (MINUEND vs SUBTRAHEND), the matrices in the input stream
 // and input side packet can be either subtrahend or minuend. The output matrix
 // is generated by performing minuend matrix - subtrahend matrix.
+// When the calculator holds the only reference to the input stream matrix, the
+// result is computed in that matrix's storage instead of a new allocation.
 //
 // Example config:
 // node {
@@ -45,8 +52,8 @@ namespace api2 {
 // }
 class MatrixSubtractCalculator : public Node {
  public:
-  static constexpr Input<Matrix>::SideFallback kMinuend{"MINUEND"};
-  static constexpr Input<Matrix>::SideFallback kSubtrahend{"SUBTRAHEND"};
+  static constexpr Input<Matrix>::SideFallback kMinuend{kMinuendTag};
+  static constexpr Input<Matrix>::SideFallback kSubtrahend{kSubtrahendTag};
   static constexpr Output<Matrix> kOut{""};
 
   MEDIAPIPE_NODE_CONTRACT(kMinuend, kSubtrahend, kOut);
@@ -73,7 +80,22 @@ absl::Status MatrixSubtractCalculator::Process(CalculatorContext* cc) {
     return absl::InvalidArgumentError(
         "Minuend and subtrahend must have the same dimensions.");
   }
-  kOut(cc).Send(minuend - subtrahend);
+  const bool minuend_is_stream = kMinuend(cc).IsStream();
+  auto input = cc->Inputs()
+                   .Tag(minuend_is_stream ? kMinuendTag : kSubtrahendTag)
+                   .Value()
+                   .Consume<Matrix>();
+  if (!input.ok()) {
+    kOut(cc).Send(minuend - subtrahend);
+    return absl::OkStatus();
+  }
+  std::unique_ptr<Matrix> output = std::move(input).value();
+  if (minuend_is_stream) {
+    *output -= subtrahend;
+  } else {
+    *output = minuend - *output;
+  }
+  kOut(cc).Send(std::move(output));
   return absl::OkStatus();
 }
 
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "Eigen/Core"
+#include "absl/strings/str_cat.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/formats/matrix.h"
@@ -156,5 +157,51 @@ TEST(MatrixSubtractCalculatorTest, SubtractFromSideMatrix) {
   EXPECT_NEAR(result.sum(), -12, 1e-5);
 }
 
+// Packets that the graph hands over without keeping another reference are
+// consumed and subtracted in place; the results must match the copying path.
+TEST(MatrixSubtractCalculatorTest, SubtractsConsumedInputInPlace) {
+  for (const char* stream_tag : {kMinuendTag, kSubtrahendTag}) {
+    const char* side_tag =
+        stream_tag == kMinuendTag ? kSubtrahendTag : kMinuendTag;
+    CalculatorGraphConfig config;
+    config.add_input_stream("input_matrix");
+    config.add_output_stream("output_matrix");
+    config.add_input_side_packet("side_matrix");
+    auto* node = config.add_node();
+    node->set_calculator("MatrixSubtractCalculator");
+    node->add_input_stream(absl::StrCat(stream_tag, ":input_matrix"));
+    node->add_input_side_packet(absl::StrCat(side_tag, ":side_matrix"));
+    node->add_output_stream("output_matrix");
+
+    Matrix* side_matrix = new Matrix();
+    MatrixFromTextProto(kMatrixText, side_matrix);
+    CalculatorGraph graph;
+    MP_ASSERT_OK(graph.Initialize(config));
+    MP_ASSERT_OK_AND_ASSIGN(auto poller,
+                            graph.AddOutputStreamPoller("output_matrix"));
+    MP_ASSERT_OK(graph.StartRun({{"side_matrix", Adopt(side_matrix)}}));
+    for (int i = 0; i < 3; ++i) {
+      auto input_matrix = std::make_unique<Matrix>();
+      MatrixFromTextProto(kMatrixText2, input_matrix.get());
+      MP_ASSERT_OK(graph.AddPacketToInputStream(
+          "input_matrix", Adopt(input_matrix.release()).At(Timestamp(i))));
+    }
+    MP_ASSERT_OK(graph.CloseAllInputStreams());
+
+    const float expected_sum = stream_tag == kMinuendTag ? 12 : -12;
+    Packet packet;
+    int count = 0;
+    while (poller.Next(&packet)) {
+      const Matrix& result = packet.Get<Matrix>();
+      ASSERT_EQ(3, result.rows());
+      ASSERT_EQ(4, result.cols());
+      EXPECT_NEAR(result.sum(), expected_sum, 1e-5);
+      ++count;
+    }
+    EXPECT_EQ(3, count);
+    MP_ASSERT_OK(graph.WaitUntilDone());
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
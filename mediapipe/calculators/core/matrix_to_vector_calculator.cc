@@ -64,12 +64,10 @@ absl::Status MatrixToVectorCalculator::Process(CalculatorContext* cc) {
   const Matrix& input = *kIn(cc);
   auto output = absl::make_unique<std::vector<float>>();
 
-  // The following lines work to convert the Matrix to a vector because Matrix
-  // is an Eigen::MatrixXf and Eigen uses column-major layout by default.
-  output->resize(input.rows() * input.cols());
-  auto output_as_matrix =
-      Eigen::Map<Matrix>(output->data(), input.rows(), input.cols());
-  output_as_matrix = input;
+  // Matrix is an Eigen::MatrixXf, which is column-major and contiguous, so
+  // its storage can be copied as is.  assign() avoids zero-filling the vector
+  // before overwriting it.
+  output->assign(input.data(), input.data() + input.size());
 
   kOut(cc).Send(std::move(output));
   return absl::OkStatus();
@@ -0,0 +1,443 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/calculators/core/shared_memory_stream_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/util/shared_memory_ring.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kImageTag[] = "IMAGE";
+constexpr char kTensorTag[] = "TENSOR";
+
+// The payload kinds of the records.
+constexpr uint32_t kImageFramePayload = 1;
+constexpr uint32_t kTensorPayload = 2;
+
+// How long to sleep while waiting for the other side of the ring.
+constexpr absl::Duration kPollInterval = absl::Microseconds(100);
+// How long SharedMemoryInputCalculator::Process waits for a record before
+// returning, so that the graph can still be cancelled.
+constexpr absl::Duration kMaxProcessWait = absl::Milliseconds(10);
+// How long SharedMemoryOutputCalculator::Close waits to announce the end of
+// the stream to a consumer that holds all slots.
+constexpr absl::Duration kMaxCloseWait = absl::Seconds(1);
+
+// Returns whether ImageFrame supports `format`.
+bool IsImageFrameFormat(int32_t format) {
+  switch (format) {
+    case ImageFormat::GRAY8:
+    case ImageFormat::GRAY16:
+    case ImageFormat::SRGB:
+    case ImageFormat::SRGB48:
+    case ImageFormat::SRGBA:
+    case ImageFormat::SRGBA64:
+    case ImageFormat::VEC32F1:
+    case ImageFormat::VEC32F2:
+    case ImageFormat::VEC32F4:
+    case ImageFormat::LAB8:
+    case ImageFormat::SBGRA:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The header is written by another process, so it is checked before its
+// pixels are read from a slot of `slot_size` bytes.
+absl::Status ValidateImageFrameHeader(const SharedMemoryRecordHeader& header,
+                                      size_t slot_size) {
+  if (!IsImageFrameFormat(header.format)) {
+    return absl::DataLossError(
+        absl::StrCat("Invalid image format ", header.format));
+  }
+  const int64_t height = header.dims[0];
+  const int64_t width = header.dims[1];
+  const int64_t stride = header.stride;
+  const auto format = static_cast<ImageFormat::Format>(header.format);
+  const int64_t row_size = width *
+                           ImageFrame::NumberOfChannelsForFormat(format) *
+                           ImageFrame::ByteDepthForFormat(format);
+  if (height < 0 || width < 0 || stride < row_size ||
+      stride * height > static_cast<int64_t>(slot_size)) {
+    return absl::DataLossError(absl::StrCat(
+        "Invalid image of ", width, "x", height, " pixels with a stride of ",
+        stride, " bytes in a slot of ", slot_size, " bytes"));
+  }
+  return absl::OkStatus();
+}
+
+// The header is written by another process, so it is checked before the
+// tensor is allocated and read from a slot of `slot_size` bytes.
+absl::Status ValidateTensorHeader(const SharedMemoryRecordHeader& header,
+                                  size_t slot_size) {
+  if (header.num_dims < 0 ||
+      header.num_dims > SharedMemoryRecordHeader::kMaxDims) {
+    return absl::DataLossError(
+        absl::StrCat("Invalid number of tensor dimensions ", header.num_dims));
+  }
+  if (header.format < static_cast<int32_t>(Tensor::ElementType::kNone) ||
+      header.format > static_cast<int32_t>(Tensor::ElementType::kBool)) {
+    return absl::DataLossError(
+        absl::StrCat("Invalid tensor element type ", header.format));
+  }
+  // Every element takes at least one byte of the slot.
+  int64_t num_elements = 1;
+  for (int i = 0; i < header.num_dims; ++i) {
+    if (header.dims[i] < 0) {
+      return absl::DataLossError(
+          absl::StrCat("Invalid tensor dimension ", header.dims[i]));
+    }
+    num_elements = std::min<int64_t>(num_elements * header.dims[i],
+                                     static_cast<int64_t>(slot_size) + 1);
+  }
+  if (num_elements > static_cast<int64_t>(slot_size) ||
+      header.payload_size > slot_size) {
+    return absl::DataLossError(absl::StrCat(
+        "The tensor does not fit into a slot of ", slot_size, " bytes"));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+// Writes the packets and timestamp bounds of its input stream to a shared
+// memory ring, which SharedMemoryInputCalculator in another graph, usually in
+// another process, reads them from. Together they connect graphs across
+// processes without serializing packets: each packet is copied once into the
+// shared memory, and images are passed on without another copy.
+//
+// Only CPU data is supported. Packets that don't fit into a slot of the ring
+// fail the graph.
+//
+// Inputs, exactly one of:
+//   IMAGE: An ImageFrame.
+//   TENSOR: A Tensor, read on the CPU.
+//
+// Example config:
+// node {
+//   calculator: "SharedMemoryOutputCalculator"
+//   input_stream: "IMAGE:camera_frames"
+//   options {
+//     [mediapipe.SharedMemoryStreamCalculatorOptions.ext] {
+//       name: "/camera_frames"
+//       num_slots: 4
+//       slot_size: 8294400
+//     }
+//   }
+// }
+class SharedMemoryOutputCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Inputs().HasTag(kImageTag) !=
+              cc->Inputs().HasTag(kTensorTag))
+        << "Exactly one of IMAGE and TENSOR must be connected.";
+    if (cc->Inputs().HasTag(kImageTag)) {
+      cc->Inputs().Tag(kImageTag).Set<ImageFrame>();
+    } else {
+      cc->Inputs().Tag(kTensorTag).Set<Tensor>();
+    }
+    // Timestamp bounds are forwarded to the consumer.
+    cc->SetProcessTimestampBounds(true);
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<SharedMemoryStreamCalculatorOptions>();
+    RET_CHECK(!options_.name().empty()) << "The ring name must be set.";
+    MP_ASSIGN_OR_RETURN(ring_, SharedMemoryRing::Create(options_.name(),
+                                                        options_.num_slots(),
+                                                        options_.slot_size()));
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const bool is_image = cc->Inputs().HasTag(kImageTag);
+    const InputStream& input =
+        is_image ? cc->Inputs().Tag(kImageTag) : cc->Inputs().Tag(kTensorTag);
+    if (input.IsEmpty()) {
+      const Timestamp bound = cc->InputTimestamp().NextAllowedInStream();
+      if (bound == Timestamp::OneOverPostStream()) {
+        return absl::OkStatus();
+      }
+      MP_ASSIGN_OR_RETURN(std::optional<SharedMemoryRing::Slot> slot,
+                          AcquireSlot(options_.drop_when_full()
+                                          ? absl::ZeroDuration()
+                                          : absl::InfiniteDuration()));
+      if (slot) {
+        slot->header->type = SharedMemoryRecordHeader::kTimestampBound;
+        slot->header->timestamp = bound.Value();
+        ring_->EndWrite();
+      }
+      return absl::OkStatus();
+    }
+
+    MP_ASSIGN_OR_RETURN(std::optional<SharedMemoryRing::Slot> slot,
+                        AcquireSlot(options_.drop_when_full()
+                                        ? absl::ZeroDuration()
+                                        : absl::InfiniteDuration()));
+    if (!slot) {
+      return absl::OkStatus();
+    }
+    SharedMemoryRecordHeader& header = *slot->header;
+    header.type = SharedMemoryRecordHeader::kPayload;
+    header.timestamp = cc->InputTimestamp().Value();
+    if (is_image) {
+      MP_RETURN_IF_ERROR(WriteImageFrame(input.Get<ImageFrame>(), *slot));
+    } else {
+      MP_RETURN_IF_ERROR(WriteTensor(input.Get<Tensor>(), *slot));
+    }
+    ring_->EndWrite();
+    return absl::OkStatus();
+  }
+
+  absl::Status Close(CalculatorContext* cc) override {
+    if (!ring_) {
+      return absl::OkStatus();
+    }
+    MP_ASSIGN_OR_RETURN(std::optional<SharedMemoryRing::Slot> slot,
+                        AcquireSlot(kMaxCloseWait));
+    if (slot) {
+      slot->header->type = SharedMemoryRecordHeader::kClose;
+      slot->header->timestamp = Timestamp::Done().Value();
+      ring_->EndWrite();
+    }
+    ring_.reset();
+    return absl::OkStatus();
+  }
+
+ private:
+  // Returns a free slot, waiting up to `timeout` for the consumer to release
+  // one, or nullopt on timeout.
+  absl::StatusOr<std::optional<SharedMemoryRing::Slot>> AcquireSlot(
+      absl::Duration timeout) {
+    const absl::Time deadline = absl::Now() + timeout;
+    while (true) {
+      std::optional<SharedMemoryRing::Slot> slot = ring_->BeginWrite();
+      if (slot || absl::Now() >= deadline) {
+        return slot;
+      }
+      absl::SleepFor(kPollInterval);
+    }
+  }
+
+  absl::Status WriteImageFrame(const ImageFrame& frame,
+                               const SharedMemoryRing::Slot& slot) {
+    const int size = frame.PixelDataSizeStoredContiguously();
+    RET_CHECK_LE(static_cast<size_t>(size), ring_->slot_size())
+        << "The image does not fit into a slot of " << options_.name();
+    frame.CopyToBuffer(slot.payload, size);
+    SharedMemoryRecordHeader& header = *slot.header;
+    header.payload_kind = kImageFramePayload;
+    header.format = frame.Format();
+    header.num_dims = 2;
+    header.dims[0] = frame.Height();
+    header.dims[1] = frame.Width();
+    header.stride =
+        frame.Width() * frame.NumberOfChannels() * frame.ChannelSize();
+    header.payload_size = size;
+    return absl::OkStatus();
+  }
+
+  absl::Status WriteTensor(const Tensor& tensor,
+                           const SharedMemoryRing::Slot& slot) {
+    const std::vector<int>& dims = tensor.shape().dims;
+    RET_CHECK_LE(dims.size(),
+                 static_cast<size_t>(SharedMemoryRecordHeader::kMaxDims));
+    RET_CHECK_LE(static_cast<size_t>(tensor.bytes()), ring_->slot_size())
+        << "The tensor does not fit into a slot of " << options_.name();
+    {
+      auto view = tensor.GetCpuReadView();
+      std::memcpy(slot.payload, view.buffer<uint8_t>(), tensor.bytes());
+    }
+    SharedMemoryRecordHeader& header = *slot.header;
+    header.payload_kind = kTensorPayload;
+    header.format = static_cast<int32_t>(tensor.element_type());
+    header.num_dims = dims.size();
+    std::copy(dims.begin(), dims.end(), header.dims);
+    header.scale = tensor.quantization_parameters().scale;
+    header.zero_point = tensor.quantization_parameters().zero_point;
+    header.payload_size = tensor.bytes();
+    return absl::OkStatus();
+  }
+
+  SharedMemoryStreamCalculatorOptions options_;
+  std::unique_ptr<SharedMemoryRing> ring_;
+};
+REGISTER_CALCULATOR(SharedMemoryOutputCalculator);
+
+// Outputs the packets and timestamp bounds written to a shared memory ring by
+// a SharedMemoryOutputCalculator, usually in another process. Images are
+// output without a copy: their pixels stay in the ring until the packets are
+// released, so downstream nodes holding on to more than `num_slots` images
+// stall the producer.
+//
+// Outputs, exactly one of (matching the producer):
+//   IMAGE: An ImageFrame.
+//   TENSOR: A Tensor.
+//
+// Example config:
+// node {
+//   calculator: "SharedMemoryInputCalculator"
+//   output_stream: "IMAGE:camera_frames"
+//   options {
+//     [mediapipe.SharedMemoryStreamCalculatorOptions.ext] {
+//       name: "/camera_frames"
+//     }
+//   }
+// }
+class SharedMemoryInputCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    RET_CHECK(cc->Outputs().HasTag(kImageTag) !=
+              cc->Outputs().HasTag(kTensorTag))
+        << "Exactly one of IMAGE and TENSOR must be connected.";
+    if (cc->Outputs().HasTag(kImageTag)) {
+      cc->Outputs().Tag(kImageTag).Set<ImageFrame>();
+    } else {
+      cc->Outputs().Tag(kTensorTag).Set<Tensor>();
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    const auto& options = cc->Options<SharedMemoryStreamCalculatorOptions>();
+    RET_CHECK(!options.name().empty()) << "The ring name must be set.";
+    MP_ASSIGN_OR_RETURN(
+        ring_, SharedMemoryRing::Open(
+                   options.name(),
+                   absl::Seconds(options.open_timeout_seconds())));
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const bool is_image = cc->Outputs().HasTag(kImageTag);
+    OutputStream& output =
+        is_image ? cc->Outputs().Tag(kImageTag) : cc->Outputs().Tag(kTensorTag);
+    const absl::Time deadline = absl::Now() + kMaxProcessWait;
+    std::optional<SharedMemoryRing::Slot> slot = ring_->BeginRead();
+    while (!slot && absl::Now() < deadline) {
+      absl::SleepFor(kPollInterval);
+      slot = ring_->BeginRead();
+    }
+    // Outputs all records available at once.
+    for (; slot; slot = ring_->BeginRead()) {
+      const SharedMemoryRecordHeader& header = *slot->header;
+      // Close records carry Timestamp::Done().
+      const Timestamp timestamp =
+          Timestamp::CreateNoErrorChecking(header.timestamp);
+      switch (header.type) {
+        case SharedMemoryRecordHeader::kClose:
+          ring_->EndRead(slot->index);
+          return tool::StatusStop();
+        case SharedMemoryRecordHeader::kTimestampBound:
+          ring_->EndRead(slot->index);
+          output.SetNextTimestampBound(timestamp);
+          break;
+        case SharedMemoryRecordHeader::kPayload:
+          if (!timestamp.IsAllowedInStream()) {
+            ring_->EndRead(slot->index);
+            return absl::DataLossError(absl::StrCat(
+                "Invalid packet timestamp ", timestamp.DebugString()));
+          }
+          if (is_image) {
+            MP_ASSIGN_OR_RETURN(Packet packet, ReadImageFrame(*slot));
+            output.AddPacket(std::move(packet).At(timestamp));
+          } else {
+            MP_ASSIGN_OR_RETURN(Packet packet, ReadTensor(*slot));
+            output.AddPacket(std::move(packet).At(timestamp));
+          }
+          break;
+        default:
+          ring_->EndRead(slot->index);
+          return absl::DataLossError(
+              absl::StrCat("Unknown record type ", header.type));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  // Returns an ImageFrame showing the pixels in `slot`, which is released
+  // with the frame.
+  absl::StatusOr<Packet> ReadImageFrame(const SharedMemoryRing::Slot& slot) {
+    const SharedMemoryRecordHeader& header = *slot.header;
+    if (header.payload_kind != kImageFramePayload || header.num_dims != 2) {
+      ring_->EndRead(slot.index);
+      return absl::InvalidArgumentError("The producer did not send images.");
+    }
+    if (absl::Status status =
+            ValidateImageFrameHeader(header, ring_->slot_size());
+        !status.ok()) {
+      ring_->EndRead(slot.index);
+      return status;
+    }
+    std::shared_ptr<SharedMemoryRing> ring = ring_;
+    const uint64_t index = slot.index;
+    return MakePacket<ImageFrame>(
+        static_cast<ImageFormat::Format>(header.format), header.dims[1],
+        header.dims[0], header.stride, slot.payload,
+        [ring, index](uint8_t*) { ring->EndRead(index); });
+  }
+
+  // Returns a copy of the tensor in `slot`, which is released.
+  absl::StatusOr<Packet> ReadTensor(const SharedMemoryRing::Slot& slot) {
+    const SharedMemoryRecordHeader& header = *slot.header;
+    if (header.payload_kind != kTensorPayload) {
+      ring_->EndRead(slot.index);
+      return absl::InvalidArgumentError("The producer did not send tensors.");
+    }
+    if (absl::Status status = ValidateTensorHeader(header, ring_->slot_size());
+        !status.ok()) {
+      ring_->EndRead(slot.index);
+      return status;
+    }
+    auto tensor = std::make_unique<Tensor>(
+        static_cast<Tensor::ElementType>(header.format),
+        Tensor::Shape(std::vector<int>(header.dims,
+                                       header.dims + header.num_dims)),
+        Tensor::QuantizationParameters(header.scale, header.zero_point));
+    {
+      auto view = tensor->GetCpuWriteView();
+      std::memcpy(view.buffer<uint8_t>(), slot.payload,
+                  std::min<uint64_t>(header.payload_size, tensor->bytes()));
+    }
+    ring_->EndRead(slot.index);
+    return Adopt(tensor.release());
+  }
+
+  std::shared_ptr<SharedMemoryRing> ring_;
+};
+REGISTER_CALCULATOR(SharedMemoryInputCalculator);
+
+}  // namespace mediapipe
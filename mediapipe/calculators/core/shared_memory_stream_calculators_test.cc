@@ -0,0 +1,253 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/substitute.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/shared_memory_ring.h"
+
+namespace mediapipe {
+namespace {
+
+// Runs a producer graph and a consumer graph connected by a shared memory
+// ring, as if they were in different processes.
+class SharedMemoryStreamCalculatorsTest : public ::testing::Test {
+ protected:
+  void StartGraphs(const std::string& tag, const std::string& name,
+                   int num_expected_packets) {
+    producer_config_ = ParseTextProtoOrDie<CalculatorGraphConfig>(
+        absl::Substitute(R"pb(
+                           input_stream: "input"
+                           node {
+                             calculator: "SharedMemoryOutputCalculator"
+                             input_stream: "$0:input"
+                             options {
+                               [mediapipe.SharedMemoryStreamCalculatorOptions
+                                    .ext] {
+                                 name: "$1"
+                                 num_slots: 4
+                                 slot_size: 1024
+                               }
+                             }
+                           }
+                         )pb",
+                         tag, name));
+    consumer_config_ = ParseTextProtoOrDie<CalculatorGraphConfig>(
+        absl::Substitute(R"pb(
+                           output_stream: "output"
+                           node {
+                             calculator: "SharedMemoryInputCalculator"
+                             output_stream: "$0:output"
+                             options {
+                               [mediapipe.SharedMemoryStreamCalculatorOptions
+                                    .ext] { name: "$1" }
+                             }
+                           }
+                         )pb",
+                         tag, name));
+    received_ = std::make_unique<absl::BlockingCounter>(num_expected_packets);
+    MP_ASSERT_OK(producer_.Initialize(producer_config_));
+    MP_ASSERT_OK(consumer_.Initialize(consumer_config_));
+    MP_ASSERT_OK(
+        consumer_.ObserveOutputStream("output", [this](const Packet& packet) {
+          {
+            absl::MutexLock lock(&mutex_);
+            output_packets_.push_back(packet);
+          }
+          received_->DecrementCount();
+          return absl::OkStatus();
+        }));
+    MP_ASSERT_OK(producer_.StartRun({}));
+    MP_ASSERT_OK(consumer_.StartRun({}));
+  }
+
+  // Waits for the consumer to receive all packets before closing the
+  // producer, which unlinks the ring.
+  void FinishGraphs() {
+    received_->Wait();
+    MP_ASSERT_OK(producer_.CloseAllInputStreams());
+    MP_ASSERT_OK(producer_.WaitUntilDone());
+    MP_ASSERT_OK(consumer_.WaitUntilDone());
+  }
+
+  CalculatorGraphConfig producer_config_;
+  CalculatorGraphConfig consumer_config_;
+  CalculatorGraph producer_;
+  CalculatorGraph consumer_;
+  std::unique_ptr<absl::BlockingCounter> received_;
+  absl::Mutex mutex_;
+  std::vector<Packet> output_packets_;
+};
+
+TEST_F(SharedMemoryStreamCalculatorsTest, PassesImageFrames) {
+  StartGraphs("IMAGE", "/mediapipe_shared_memory_stream_test_image",
+              /*num_expected_packets=*/3);
+  for (int i = 0; i < 3; ++i) {
+    auto frame = std::make_unique<ImageFrame>(ImageFormat::SRGB, 5, 4);
+    for (int y = 0; y < frame->Height(); ++y) {
+      uint8_t* row = frame->MutablePixelData() + y * frame->WidthStep();
+      for (int x = 0; x < frame->Width() * 3; ++x) {
+        row[x] = i * 50 + y * 10 + x;
+      }
+    }
+    MP_ASSERT_OK(producer_.AddPacketToInputStream(
+        "input", Adopt(frame.release()).At(Timestamp(i * 100))));
+  }
+  FinishGraphs();
+
+  absl::MutexLock lock(&mutex_);
+  ASSERT_EQ(output_packets_.size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(output_packets_[i].Timestamp(), Timestamp(i * 100));
+    const ImageFrame& frame = output_packets_[i].Get<ImageFrame>();
+    EXPECT_EQ(frame.Format(), ImageFormat::SRGB);
+    EXPECT_EQ(frame.Width(), 5);
+    EXPECT_EQ(frame.Height(), 4);
+    for (int y = 0; y < frame.Height(); ++y) {
+      const uint8_t* row = frame.PixelData() + y * frame.WidthStep();
+      for (int x = 0; x < frame.Width() * 3; ++x) {
+        EXPECT_EQ(row[x], i * 50 + y * 10 + x);
+      }
+    }
+  }
+}
+
+TEST_F(SharedMemoryStreamCalculatorsTest, PassesTensors) {
+  StartGraphs("TENSOR", "/mediapipe_shared_memory_stream_test_tensor",
+              /*num_expected_packets=*/6);
+  // More tensors than slots, since the consumer copies them.
+  for (int i = 0; i < 6; ++i) {
+    auto tensor =
+        std::make_unique<Tensor>(Tensor::ElementType::kFloat32,
+                                 Tensor::Shape{1, 2, 3});
+    {
+      auto view = tensor->GetCpuWriteView();
+      float* data = view.buffer<float>();
+      for (int j = 0; j < 6; ++j) {
+        data[j] = i + j * 0.5f;
+      }
+    }
+    MP_ASSERT_OK(producer_.AddPacketToInputStream(
+        "input", Adopt(tensor.release()).At(Timestamp(i))));
+  }
+  FinishGraphs();
+
+  absl::MutexLock lock(&mutex_);
+  ASSERT_EQ(output_packets_.size(), 6);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_EQ(output_packets_[i].Timestamp(), Timestamp(i));
+    const Tensor& tensor = output_packets_[i].Get<Tensor>();
+    EXPECT_EQ(tensor.element_type(), Tensor::ElementType::kFloat32);
+    EXPECT_THAT(tensor.shape().dims, testing::ElementsAre(1, 2, 3));
+    auto view = tensor.GetCpuReadView();
+    const float* data = view.buffer<float>();
+    for (int j = 0; j < 6; ++j) {
+      EXPECT_EQ(data[j], i + j * 0.5f);
+    }
+  }
+}
+
+// Runs a consumer graph on a ring holding a single record, which is filled in
+// by `write_record` as a faulty producer might, and returns the graph status.
+absl::Status ConsumeRecord(
+    const std::string& tag, const std::string& name,
+    const std::function<void(SharedMemoryRecordHeader&)>& write_record) {
+  MP_ASSIGN_OR_RETURN(
+      std::unique_ptr<SharedMemoryRing> ring,
+      SharedMemoryRing::Create(name, /*num_slots=*/2, /*slot_size=*/64));
+  std::optional<SharedMemoryRing::Slot> slot = ring->BeginWrite();
+  RET_CHECK(slot.has_value());
+  *slot->header = SharedMemoryRecordHeader{};
+  slot->header->type = SharedMemoryRecordHeader::kPayload;
+  write_record(*slot->header);
+  ring->EndWrite();
+
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(
+      ParseTextProtoOrDie<CalculatorGraphConfig>(absl::Substitute(
+          R"pb(
+            node {
+              calculator: "SharedMemoryInputCalculator"
+              output_stream: "$0:output"
+              options {
+                [mediapipe.SharedMemoryStreamCalculatorOptions.ext] {
+                  name: "$1"
+                }
+              }
+            }
+          )pb",
+          tag, name))));
+  MP_RETURN_IF_ERROR(graph.StartRun({}));
+  return graph.WaitUntilDone();
+}
+
+TEST(SharedMemoryInputCalculatorTest, RejectsImageLargerThanSlot) {
+  absl::Status status = ConsumeRecord(
+      "IMAGE", "/mediapipe_shared_memory_stream_test_bad_image",
+      [](SharedMemoryRecordHeader& header) {
+        header.payload_kind = 1;  // An image.
+        header.format = ImageFormat::GRAY8;
+        header.num_dims = 2;
+        header.dims[0] = 8;
+        header.dims[1] = 8;
+        // 9 * 8 bytes do not fit into a slot of 64 bytes.
+        header.stride = 9;
+      });
+  EXPECT_EQ(status.code(), absl::StatusCode::kDataLoss) << status;
+}
+
+TEST(SharedMemoryInputCalculatorTest, RejectsTooManyTensorDimensions) {
+  absl::Status status = ConsumeRecord(
+      "TENSOR", "/mediapipe_shared_memory_stream_test_bad_tensor",
+      [](SharedMemoryRecordHeader& header) {
+        header.payload_kind = 2;  // A tensor.
+        header.format = static_cast<int32_t>(Tensor::ElementType::kUInt8);
+        header.num_dims = SharedMemoryRecordHeader::kMaxDims + 1;
+      });
+  EXPECT_EQ(status.code(), absl::StatusCode::kDataLoss) << status;
+}
+
+TEST(SharedMemoryInputCalculatorTest, RejectsTensorLargerThanSlot) {
+  absl::Status status = ConsumeRecord(
+      "TENSOR", "/mediapipe_shared_memory_stream_test_big_tensor",
+      [](SharedMemoryRecordHeader& header) {
+        header.payload_kind = 2;  // A tensor.
+        header.format = static_cast<int32_t>(Tensor::ElementType::kUInt8);
+        header.num_dims = 2;
+        header.dims[0] = 1 << 20;
+        header.dims[1] = 1 << 20;
+      });
+  EXPECT_EQ(status.code(), absl::StatusCode::kDataLoss) << status;
+}
+
+}  // namespace
+}  // namespace mediapipe
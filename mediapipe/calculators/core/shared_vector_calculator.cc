@@ -0,0 +1,35 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/core/shared_vector_calculator.h"
+
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe {
+
+typedef SplitSharedVectorCalculator<float> SplitSharedFloatVectorCalculator;
+MEDIAPIPE_REGISTER_NODE(SplitSharedFloatVectorCalculator);
+
+typedef SplitSharedVectorCalculator<Tensor> SplitSharedTensorVectorCalculator;
+MEDIAPIPE_REGISTER_NODE(SplitSharedTensorVectorCalculator);
+
+typedef ConcatenateSharedVectorCalculator<float>
+    ConcatenateSharedFloatVectorCalculator;
+MEDIAPIPE_REGISTER_NODE(ConcatenateSharedFloatVectorCalculator);
+
+typedef ConcatenateSharedVectorCalculator<Tensor>
+    ConcatenateSharedTensorVectorCalculator;
+MEDIAPIPE_REGISTER_NODE(ConcatenateSharedTensorVectorCalculator);
+
+}  // namespace mediapipe
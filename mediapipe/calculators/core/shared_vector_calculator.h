@@ -0,0 +1,193 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_CORE_SHARED_VECTOR_CALCULATOR_H_
+#define MEDIAPIPE_CALCULATORS_CORE_SHARED_VECTOR_CALCULATOR_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/core/concatenate_vector_calculator.pb.h"
+#include "mediapipe/calculators/core/split_vector_calculator.pb.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/shared_vector.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+// As in concatenate_vector_calculator.h, the api2 names are qualified instead
+// of placing these calculator templates in namespace api2.
+
+namespace internal {
+
+// Returns the elements of a std::vector<T> or SharedVector<T> packet as a
+// SharedVector<T>, sharing the packet payload in both cases.
+template <typename T>
+absl::StatusOr<SharedVector<T>> ToSharedVector(
+    const api2::Packet<api2::OneOf<std::vector<T>, SharedVector<T>>>& packet) {
+  if (packet.template Has<SharedVector<T>>()) {
+    return packet.template Get<SharedVector<T>>();
+  }
+  MP_ASSIGN_OR_RETURN(auto elements,
+                      packet.template Share<std::vector<T>>());
+  return SharedVector<T>(std::move(elements));
+}
+
+}  // namespace internal
+
+// Splits a vector into the ranges given in SplitVectorCalculatorOptions, like
+// SplitVectorCalculator, but outputs each range as a SharedVector<T> that
+// refers to the input elements instead of copying or moving them. The input
+// may be a std::vector<T> or a SharedVector<T>. element_only is not supported;
+// combine_outputs is.
+//
+// Example config:
+// node {
+//   calculator: "SplitSharedTensorVectorCalculator"
+//   input_stream: "tensors"
+//   output_stream: "box_tensors"
+//   output_stream: "score_tensors"
+//   options {
+//     [mediapipe.SplitVectorCalculatorOptions.ext] {
+//       ranges: { begin: 0 end: 1 }
+//       ranges: { begin: 1 end: 2 }
+//     }
+//   }
+// }
+template <typename T>
+class SplitSharedVectorCalculator : public api2::Node {
+ public:
+  static constexpr api2::Input<api2::OneOf<std::vector<T>, SharedVector<T>>>
+      kIn{""};
+  static constexpr typename api2::Output<SharedVector<T>>::Multiple kOut{""};
+
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut);
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    const auto& options =
+        cc->Options<::mediapipe::SplitVectorCalculatorOptions>();
+    RET_CHECK(!options.element_only())
+        << "element_only is not supported, outputs are SharedVectors.";
+    RET_CHECK_GT(options.ranges_size(), 0);
+    for (const auto& range : options.ranges()) {
+      RET_CHECK(range.begin() >= 0 && range.begin() < range.end())
+          << "Indices should be non-negative and ranges non-empty.";
+    }
+    if (options.combine_outputs()) {
+      RET_CHECK_EQ(kOut(cc).Count(), 1);
+    } else {
+      RET_CHECK_EQ(kOut(cc).Count(), options.ranges_size())
+          << "The number of output streams should match the number of ranges "
+             "specified in the options.";
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<::mediapipe::SplitVectorCalculatorOptions>();
+    for (const auto& range : options_.ranges()) {
+      max_range_end_ = std::max(max_range_end_, range.end());
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (kIn(cc).IsEmpty()) return absl::OkStatus();
+    MP_ASSIGN_OR_RETURN(SharedVector<T> input,
+                        internal::ToSharedVector<T>(kIn(cc)));
+    RET_CHECK_LE(max_range_end_, input.size())
+        << "Max range end " << max_range_end_ << " exceeds input size "
+        << input.size();
+    if (options_.combine_outputs()) {
+      SharedVector<T> output;
+      for (const auto& range : options_.ranges()) {
+        output.Append(input.Slice(range.begin(), range.end()));
+      }
+      kOut(cc)[0].Send(std::move(output));
+    } else {
+      for (int i = 0; i < options_.ranges_size(); ++i) {
+        const auto& range = options_.ranges(i);
+        kOut(cc)[i].Send(input.Slice(range.begin(), range.end()));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  ::mediapipe::SplitVectorCalculatorOptions options_;
+  int max_range_end_ = -1;
+};
+
+// Concatenates std::vector<T> or SharedVector<T> inputs following stream index
+// order, like ConcatenateVectorCalculator, into a SharedVector<T> that refers
+// to the input elements instead of copying or consuming them. Honors
+// ConcatenateVectorCalculatorOptions.only_emit_if_all_present.
+//
+// Example config:
+// node {
+//   calculator: "ConcatenateSharedTensorVectorCalculator"
+//   input_stream: "box_tensors"
+//   input_stream: "score_tensors"
+//   output_stream: "tensors"
+// }
+template <typename T>
+class ConcatenateSharedVectorCalculator : public api2::Node {
+ public:
+  static constexpr typename api2::Input<
+      api2::OneOf<std::vector<T>, SharedVector<T>>>::Multiple kIn{""};
+  static constexpr api2::Output<SharedVector<T>> kOut{""};
+
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut);
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    RET_CHECK_GE(kIn(cc).Count(), 1);
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    only_emit_if_all_present_ =
+        cc->Options<::mediapipe::ConcatenateVectorCalculatorOptions>()
+            .only_emit_if_all_present();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (only_emit_if_all_present_) {
+      for (const auto& input : kIn(cc)) {
+        if (input.IsEmpty()) return absl::OkStatus();
+      }
+    }
+    SharedVector<T> output;
+    for (const auto& input : kIn(cc)) {
+      if (input.IsEmpty()) continue;
+      MP_ASSIGN_OR_RETURN(SharedVector<T> elements,
+                          internal::ToSharedVector<T>(input));
+      output.Append(elements);
+    }
+    kOut(cc).Send(std::move(output));
+    return absl::OkStatus();
+  }
+
+ private:
+  bool only_emit_if_all_present_ = false;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_CORE_SHARED_VECTOR_CALCULATOR_H_
@@ -0,0 +1,168 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/core/shared_vector_calculator.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/shared_vector.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(SplitSharedVectorCalculatorTest, SlicesShareInputElements) {
+  CalculatorRunner runner(R"pb(
+    calculator: "SplitSharedFloatVectorCalculator"
+    input_stream: "input"
+    output_stream: "first"
+    output_stream: "rest"
+    options {
+      [mediapipe.SplitVectorCalculatorOptions.ext] {
+        ranges: { begin: 0 end: 1 }
+        ranges: { begin: 1 end: 3 }
+      }
+    }
+  )pb");
+  Packet input = MakePacket<std::vector<float>>(
+                     std::vector<float>{1.0f, 2.0f, 3.0f})
+                     .At(Timestamp(0));
+  runner.MutableInputs()->Index(0).packets.push_back(input);
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& first = runner.Outputs().Index(0).packets;
+  const auto& rest = runner.Outputs().Index(1).packets;
+  ASSERT_EQ(first.size(), 1);
+  ASSERT_EQ(rest.size(), 1);
+  EXPECT_EQ(first[0].Timestamp(), Timestamp(0));
+  EXPECT_THAT(first[0].Get<SharedVector<float>>().ToVector(),
+              ElementsAre(1.0f));
+  const auto& rest_vector = rest[0].Get<SharedVector<float>>();
+  EXPECT_THAT(rest_vector.ToVector(), ElementsAre(2.0f, 3.0f));
+  EXPECT_EQ(&rest_vector[0], &input.Get<std::vector<float>>()[1]);
+}
+
+TEST(SplitSharedVectorCalculatorTest, CombinesOutputs) {
+  CalculatorRunner runner(R"pb(
+    calculator: "SplitSharedFloatVectorCalculator"
+    input_stream: "input"
+    output_stream: "output"
+    options {
+      [mediapipe.SplitVectorCalculatorOptions.ext] {
+        ranges: { begin: 0 end: 1 }
+        ranges: { begin: 2 end: 4 }
+        combine_outputs: true
+      }
+    }
+  )pb");
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::vector<float>>(std::vector<float>{1.0f, 2.0f, 3.0f, 4.0f})
+          .At(Timestamp(0)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& outputs = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(outputs.size(), 1);
+  const auto& output = outputs[0].Get<SharedVector<float>>();
+  EXPECT_THAT(output.ToVector(), ElementsAre(1.0f, 3.0f, 4.0f));
+  EXPECT_EQ(output.spans().size(), 2);
+}
+
+TEST(SplitSharedVectorCalculatorTest, FailsOnShortInput) {
+  CalculatorRunner runner(R"pb(
+    calculator: "SplitSharedFloatVectorCalculator"
+    input_stream: "input"
+    output_stream: "output"
+    options {
+      [mediapipe.SplitVectorCalculatorOptions.ext] {
+        ranges: { begin: 0 end: 3 }
+      }
+    }
+  )pb");
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::vector<float>>(std::vector<float>{1.0f, 2.0f})
+          .At(Timestamp(0)));
+  EXPECT_FALSE(runner.Run().ok());
+}
+
+TEST(ConcatenateSharedVectorCalculatorTest, ConcatenatesMoveOnlyTensors) {
+  CalculatorRunner runner(R"pb(
+    calculator: "ConcatenateSharedTensorVectorCalculator"
+    input_stream: "vector"
+    input_stream: "shared"
+    output_stream: "output"
+  )pb");
+  std::vector<Tensor> first;
+  first.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape{1});
+  std::vector<Tensor> second;
+  second.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape{2});
+  second.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape{3});
+  Packet first_packet =
+      MakePacket<std::vector<Tensor>>(std::move(first)).At(Timestamp(0));
+  Packet second_packet =
+      MakePacket<SharedVector<Tensor>>(SharedVector<Tensor>(std::move(second)))
+          .At(Timestamp(0));
+  runner.MutableInputs()->Index(0).packets.push_back(first_packet);
+  runner.MutableInputs()->Index(1).packets.push_back(second_packet);
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& outputs = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(outputs.size(), 1);
+  const auto& output = outputs[0].Get<SharedVector<Tensor>>();
+  ASSERT_EQ(output.size(), 3);
+  EXPECT_EQ(&output[0], &first_packet.Get<std::vector<Tensor>>()[0]);
+  EXPECT_EQ(&output[2], &second_packet.Get<SharedVector<Tensor>>()[1]);
+  EXPECT_EQ(output[2].shape().dims, std::vector<int>{3});
+}
+
+TEST(ConcatenateSharedVectorCalculatorTest, OnlyEmitsIfAllPresent) {
+  CalculatorRunner runner(R"pb(
+    calculator: "ConcatenateSharedFloatVectorCalculator"
+    input_stream: "a"
+    input_stream: "b"
+    output_stream: "output"
+    options {
+      [mediapipe.ConcatenateVectorCalculatorOptions.ext] {
+        only_emit_if_all_present: true
+      }
+    }
+  )pb");
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::vector<float>>(std::vector<float>{1.0f})
+          .At(Timestamp(0)));
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::vector<float>>(std::vector<float>{2.0f})
+          .At(Timestamp(1)));
+  runner.MutableInputs()->Index(1).packets.push_back(
+      MakePacket<std::vector<float>>(std::vector<float>{3.0f})
+          .At(Timestamp(1)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& outputs = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(outputs.size(), 1);
+  EXPECT_EQ(outputs[0].Timestamp(), Timestamp(1));
+  EXPECT_THAT(outputs[0].Get<SharedVector<float>>().ToVector(),
+              ElementsAre(2.0f, 3.0f));
+}
+
+}  // namespace
+}  // namespace mediapipe
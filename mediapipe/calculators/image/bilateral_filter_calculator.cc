@@ -12,8 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/strings/str_replace.h"
@@ -47,6 +49,71 @@ constexpr char kInputGuideTagGpu[] = "GUIDE_GPU";
 constexpr char kOutputFrameTagGpu[] = "IMAGE_GPU";
 
 enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
+
+// Returns `size` divided by `factor`, keeping at least one pixel per dimension.
+cv::Size DownsampledSize(const cv::Size& size, int factor) {
+  return cv::Size(std::max(1, size.width / factor),
+                  std::max(1, size.height / factor));
+}
+
+// Filters the 8-bit `input` with the fast guided filter (He and Sun, 2015),
+// using the luminance of the 8-bit `guide` as guide image. Like a joint
+// bilateral filter, it smooths `input` while following the edges of `guide`,
+// but it only needs box filters, whose cost does not depend on the radius.
+// The linear coefficients are computed at 1/`subsample` of the guide size and
+// upsampled, so most of the work scales with the subsampled size. `eps`
+// regularizes the coefficients like the squared color sigma of a bilateral
+// filter, for values normalized to [0, 1]. `output` is written at the guide
+// size with the type of `input`.
+void FastGuidedFilter(const cv::Mat& input, const cv::Mat& guide, int radius,
+                      float eps, int subsample, cv::Mat* output) {
+  cv::Mat guide_gray;
+  if (guide.channels() == 3) {
+    cv::cvtColor(guide, guide_gray, cv::COLOR_RGB2GRAY);
+  } else if (guide.channels() == 4) {
+    cv::cvtColor(guide, guide_gray, cv::COLOR_RGBA2GRAY);
+  } else {
+    guide_gray = guide;
+  }
+  cv::Mat guide_full;
+  guide_gray.convertTo(guide_full, CV_32F, 1.0 / 255.0);
+
+  const cv::Size small_size = DownsampledSize(guide_full.size(), subsample);
+  cv::Mat guide_small;
+  cv::resize(guide_full, guide_small, small_size, 0, 0, cv::INTER_AREA);
+  cv::Mat input_small;
+  cv::resize(input, input_small, small_size, 0, 0, cv::INTER_AREA);
+  input_small.convertTo(input_small, CV_32F, 1.0 / 255.0);
+
+  const int small_radius = std::max(1, radius / subsample);
+  const cv::Size box(2 * small_radius + 1, 2 * small_radius + 1);
+  cv::Mat mean_guide, var_guide;
+  cv::boxFilter(guide_small, mean_guide, CV_32F, box);
+  cv::boxFilter(guide_small.mul(guide_small), var_guide, CV_32F, box);
+  var_guide -= mean_guide.mul(mean_guide);
+  var_guide += eps;
+
+  std::vector<cv::Mat> channels;
+  cv::split(input_small, channels);
+  for (cv::Mat& channel : channels) {
+    cv::Mat mean_input, cov;
+    cv::boxFilter(channel, mean_input, CV_32F, box);
+    cv::boxFilter(guide_small.mul(channel), cov, CV_32F, box);
+    cov -= mean_guide.mul(mean_input);
+    // q = a * guide + b, with a and b averaged over the windows covering q.
+    const cv::Mat a = cov / var_guide;
+    const cv::Mat b = mean_input - a.mul(mean_guide);
+    cv::Mat mean_a, mean_b;
+    cv::boxFilter(a, mean_a, CV_32F, box);
+    cv::boxFilter(b, mean_b, CV_32F, box);
+    cv::resize(mean_a, mean_a, guide_full.size(), 0, 0, cv::INTER_LINEAR);
+    cv::resize(mean_b, mean_b, guide_full.size(), 0, 0, cv::INTER_LINEAR);
+    channel = mean_a.mul(guide_full) + mean_b;
+  }
+  cv::Mat result;
+  cv::merge(channels, result);
+  result.convertTo(*output, input.type(), 255.0);
+}
 }  // namespace
 
 // A calculator for applying a bilateral filter to an image,
@@ -69,6 +136,7 @@ enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
 //   sigma_space: Pixel radius: use (sigma_space*2+1)x(sigma_space*2+1) window.
 //                This should be set based on output image pixel space.
 //   sigma_color: Color variance: normalized [0-1] color difference allowed.
+//   cpu_downsample_factor: Filter at a reduced resolution on CPU.
 //
 // Notes:
 //   * When GUIDE is present, the output image is same size as GUIDE image;
@@ -76,7 +144,9 @@ enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
 //   * On GPU the kernel window is subsampled by approximately sqrt(sigma_space)
 //     i.e. the step size is ~sqrt(sigma_space),
 //     prioritizing performance > quality.
-//   * TODO: Add CPU path for joint filter.
+//   * On CPU the joint filter is approximated with a fast guided filter on the
+//     luminance of GUIDE, using sigma_color^2 as regularization. Its cost does
+//     not depend on sigma_space.
 //
 class BilateralFilterCalculator : public CalculatorBase {
  public:
@@ -186,6 +256,7 @@ absl::Status BilateralFilterCalculator::Open(CalculatorContext* cc) {
   sigma_space_ = options_.sigma_space();
   ABSL_CHECK_GE(sigma_color_, 0.0);
   ABSL_CHECK_GE(sigma_space_, 0.0);
+  RET_CHECK_GE(options_.cpu_downsample_factor(), 1);
   if (!use_gpu_) sigma_color_ *= 255.0;
 
   if (use_gpu_) {
@@ -246,16 +317,39 @@ absl::Status BilateralFilterCalculator::RenderCpu(CalculatorContext* cc) {
         "CPU filtering supports only 1 or 3 channel input images.");
   }
 
-  auto output_frame = absl::make_unique<ImageFrame>(
-      input_frame.Format(), input_mat.cols, input_mat.rows);
   const bool has_guide_image = cc->Inputs().HasTag(kInputGuideTag) &&
                                !cc->Inputs().Tag(kInputGuideTag).IsEmpty();
+  const int downsample_factor = options_.cpu_downsample_factor();
 
+  std::unique_ptr<ImageFrame> output_frame;
   if (has_guide_image) {
-    // cv::jointBilateralFilter() is in contrib module 'ximgproc'.
-    return absl::UnimplementedError(
-        "CPU joint filtering support is not implemented yet.");
+    const auto& guide_frame =
+        cc->Inputs().Tag(kInputGuideTag).Get<ImageFrame>();
+    auto guide_mat = mediapipe::formats::MatView(&guide_frame);
+    output_frame = absl::make_unique<ImageFrame>(
+        input_frame.Format(), guide_mat.cols, guide_mat.rows);
+    auto output_mat = mediapipe::formats::MatView(output_frame.get());
+    FastGuidedFilter(input_mat, guide_mat, static_cast<int>(sigma_space_),
+                     options_.sigma_color() * options_.sigma_color(),
+                     downsample_factor, &output_mat);
+  } else if (downsample_factor > 1) {
+    output_frame = absl::make_unique<ImageFrame>(
+        input_frame.Format(), input_mat.cols, input_mat.rows);
+    auto output_mat = mediapipe::formats::MatView(output_frame.get());
+    cv::Mat small_input;
+    cv::resize(input_mat, small_input,
+               DownsampledSize(input_mat.size(), downsample_factor), 0, 0,
+               cv::INTER_AREA);
+    const float small_sigma_space = sigma_space_ / downsample_factor;
+    cv::Mat small_output;
+    cv::bilateralFilter(small_input, small_output,
+                        /*d=*/small_sigma_space * 2.0, sigma_color_,
+                        small_sigma_space);
+    cv::resize(small_output, output_mat, output_mat.size(), 0, 0,
+               cv::INTER_LINEAR);
   } else {
+    output_frame = absl::make_unique<ImageFrame>(
+        input_frame.Format(), input_mat.cols, input_mat.rows);
     auto output_mat = mediapipe::formats::MatView(output_frame.get());
     // Prefer setting 'd = sigma_space * 2' to match GPU definition of radius.
     cv::bilateralFilter(input_mat, output_mat, /*d=*/sigma_space_ * 2.0,
@@ -15,6 +15,8 @@
 #include "mediapipe/calculators/image/image_cropping_calculator.h"
 
 #include <cmath>
+#include <memory>
+#include <utility>
 
 #include "absl/log/absl_log.h"
 #include "mediapipe/framework/formats/image_frame.h"
@@ -24,6 +26,7 @@
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_macros.h"
 
 #if !MEDIAPIPE_DISABLE_GPU
 #include "mediapipe/gpu/gl_simple_shaders.h"
@@ -246,6 +249,26 @@ absl::Status ImageCroppingCalculator::RenderCpu(CalculatorContext* cc) {
   output_width *= scale;
   output_height *= scale;
 
+  // An unrotated, unscaled crop on whole pixels that lies within the input is
+  // returned as a view that shares the input pixels.
+  const float left = rect_center_x - target_width / 2.0f;
+  const float top = rect_center_y - target_height / 2.0f;
+  if (rotation == 0.0f && scale == 1.0f && target_width > 0 &&
+      target_height > 0 && left == std::floor(left) &&
+      top == std::floor(top) && left >= 0 && top >= 0 &&
+      left + target_width <= input_img.Width() &&
+      top + target_height <= input_img.Height()) {
+    MP_ASSIGN_OR_RETURN(std::shared_ptr<const ImageFrame> input_frame,
+                        cc->Inputs().Tag(kImageTag).Value().Share<ImageFrame>());
+    cc->Outputs().Tag(kImageTag).Add(
+        ImageFrame::CreateView(std::move(input_frame), static_cast<int>(left),
+                               static_cast<int>(top), target_width,
+                               target_height)
+            .release(),
+        cc->InputTimestamp());
+    return absl::OkStatus();
+  }
+
   float dst_corners[8] = {
       0, output_height, 0, 0, output_width, 0, output_width, output_height};
   const cv::Mat dst_points = cv::Mat(4, 2, CV_32F, dst_corners);
@@ -98,6 +98,44 @@ TEST(ImageCroppingCalculatorTest, IdentityFunctionCropWithOriginalSize) {
   EXPECT_EQ(max_diff, 0);
 }  // TEST
 
+// An unrotated crop on whole pixels within the input shares the input pixels.
+TEST(ImageCroppingCalculatorTest, CropWithinImageSharesInputPixels) {
+  auto calculator_node =
+      ParseTextProtoOrDie<mediapipe::CalculatorGraphConfig::Node>(
+          R"pb(
+            calculator: "ImageCroppingCalculator"
+            input_stream: "IMAGE:input_frames"
+            output_stream: "IMAGE:cropped_output_frames"
+            options: {
+              [mediapipe.ImageCroppingCalculatorOptions.ext] {
+                width: 20
+                height: 10
+                norm_center_x: 0.3
+                norm_center_y: 0.4
+              }
+            }
+          )pb");
+  mediapipe::CalculatorRunner runner(calculator_node);
+
+  const auto input_frame = GetInputFrame(input_width, input_height, 3);
+  auto input_frame_packet =
+      mediapipe::MakePacket<mediapipe::ImageFrame>(std::move(*input_frame));
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      input_frame_packet.At(mediapipe::Timestamp(1)));
+
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& input_image = input_frame_packet.Get<mediapipe::ImageFrame>();
+  const auto& output_image =
+      runner.Outputs().Tag("IMAGE").packets[0].Get<mediapipe::ImageFrame>();
+  EXPECT_TRUE(output_image.IsView());
+  EXPECT_EQ(output_image.Width(), 20);
+  EXPECT_EQ(output_image.Height(), 10);
+  // The crop spans [20, 40) x [35, 45).
+  EXPECT_EQ(output_image.PixelData(),
+            input_image.PixelData() + 35 * input_image.WidthStep() + 20 * 3);
+}  // TEST
+
 // Test identity function, where cropping size is same as input size.
 // When an image has an odd number for its size, its center falls on a
 // fractional pixel. As a result, the values for center_x and center_y need to
@@ -12,12 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+
 #include "absl/status/status.h"
 #include "mediapipe/calculators/image/image_transformation_calculator.pb.h"
 #include "mediapipe/calculators/image/rotation_mode.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_frame_pool.h"
 #include "mediapipe/framework/formats/video_stream_header.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
@@ -60,6 +66,9 @@ constexpr char kImageFrameTag[] = "IMAGE";
 constexpr char kGpuBufferTag[] = "IMAGE_GPU";
 constexpr char kVideoPrestreamTag[] = "VIDEO_PRESTREAM";
 
+// The fused CPU path does not split the output into bands of fewer rows.
+constexpr int kMinRowsPerBand = 16;
+
 int RotationModeToDegrees(mediapipe::RotationMode_Mode rotation) {
   switch (rotation) {
     case mediapipe::RotationMode::UNKNOWN:
@@ -103,6 +112,34 @@ mediapipe::ScaleMode_Mode ParseScaleMode(
       return default_mode;
   }
 }
+
+// Returns the mapping of pixel coordinates done by the rotation step of the
+// CPU path: cv::warpAffine about the image center if the rotated image has the
+// same size, cv::rotate otherwise.
+cv::Matx33d RotationTransform(mediapipe::RotationMode_Mode rotation, int width,
+                              int height, int rotated_width,
+                              int rotated_height) {
+  if (width == rotated_width && height == rotated_height) {
+    const cv::Mat rotation_mat =
+        cv::getRotationMatrix2D(cv::Point2f(width / 2.0, height / 2.0),
+                                RotationModeToDegrees(rotation), 1.0);
+    const cv::Matx23d m = rotation_mat;
+    return cv::Matx33d(m(0, 0), m(0, 1), m(0, 2), m(1, 0), m(1, 1), m(1, 2), 0,
+                       0, 1);
+  }
+  switch (rotation) {
+    case mediapipe::RotationMode::ROTATION_90:
+      // Counterclockwise: (x, y) -> (y, width - 1 - x).
+      return cv::Matx33d(0, 1, 0, -1, 0, width - 1, 0, 0, 1);
+    case mediapipe::RotationMode::ROTATION_180:
+      return cv::Matx33d(-1, 0, width - 1, 0, -1, height - 1, 0, 0, 1);
+    case mediapipe::RotationMode::ROTATION_270:
+      // Clockwise: (x, y) -> (height - 1 - y, x).
+      return cv::Matx33d(0, -1, height - 1, 1, 0, 0, 0, 0, 1);
+    default:
+      return cv::Matx33d::eye();
+  }
+}
 }  // namespace
 
 // Scales, rotates, and flips images horizontally or vertically.
@@ -191,6 +228,10 @@ class ImageTransformationCalculator : public CalculatorBase {
 
  private:
   absl::Status RenderCpu(CalculatorContext* cc);
+  // Like RenderCpu, in a single pass. See fused_cpu_transform in the options.
+  absl::Status RenderCpuFused(CalculatorContext* cc);
+  std::shared_ptr<ImageFrame> GetCpuOutputFrame(ImageFormat::Format format,
+                                                int width, int height);
   absl::Status RenderGpu(CalculatorContext* cc);
   absl::Status GlSetup();
 
@@ -211,6 +252,7 @@ class ImageTransformationCalculator : public CalculatorBase {
   bool use_gpu_ = false;
   cv::Scalar padding_color_;
   ImageTransformationCalculatorOptions::InterpolationMode interpolation_mode_;
+  std::shared_ptr<ImageFramePool> frame_pool_;
 
 #if !MEDIAPIPE_DISABLE_GPU
   GlCalculatorHelper gpu_helper_;
@@ -420,6 +462,9 @@ absl::Status ImageTransformationCalculator::Process(CalculatorContext* cc) {
     if (cc->Inputs().Tag(kImageFrameTag).IsEmpty()) {
       return absl::OkStatus();
     }
+    if (options_.fused_cpu_transform()) {
+      return RenderCpuFused(cc);
+    }
     return RenderCpu(cc);
   }
   return absl::OkStatus();
@@ -581,6 +626,151 @@ absl::Status ImageTransformationCalculator::RenderCpu(CalculatorContext* cc) {
   return absl::OkStatus();
 }
 
+absl::Status ImageTransformationCalculator::RenderCpuFused(
+    CalculatorContext* cc) {
+  const auto& input = cc->Inputs().Tag(kImageFrameTag).Get<ImageFrame>();
+  const cv::Mat input_mat = formats::MatView(&input);
+  const int input_width = input_mat.cols;
+  const int input_height = input_mat.rows;
+  int output_width;
+  int output_height;
+  ComputeOutputDimensions(input_width, input_height, &output_width,
+                          &output_height);
+
+  // Composes the mappings from input to output pixel coordinates of the steps
+  // of RenderCpu: scaling with letterboxing, rotation, then flipping.
+  cv::Matx33d scale_transform = cv::Matx33d::eye();
+  int scaled_width = input_width;
+  int scaled_height = input_height;
+  // The part of the scaled image covered by the input, outside of which FIT
+  // adds padding.
+  cv::Rect content(0, 0, input_width, input_height);
+  if (output_width_ > 0 && output_height_ > 0) {
+    scaled_width = output_width_;
+    scaled_height = output_height_;
+    content = cv::Rect(0, 0, output_width_, output_height_);
+    if (scale_mode_ != mediapipe::ScaleMode::STRETCH) {
+      const float scale =
+          std::min(static_cast<float>(output_width_) / input_width,
+                   static_cast<float>(output_height_) / input_height);
+      content.width = std::round(input_width * scale);
+      content.height = std::round(input_height * scale);
+      if (scale_mode_ == mediapipe::ScaleMode::FIT) {
+        content.x = (output_width_ - content.width) / 2;
+        content.y = (output_height_ - content.height) / 2;
+      } else {
+        scaled_width = output_width = content.width;
+        scaled_height = output_height = content.height;
+      }
+    }
+    // Maps pixel centers onto pixel centers, like cv::resize.
+    const double scale_x = static_cast<double>(content.width) / input_width;
+    const double scale_y = static_cast<double>(content.height) / input_height;
+    scale_transform =
+        cv::Matx33d(scale_x, 0, 0.5 * scale_x - 0.5 + content.x, 0, scale_y,
+                    0.5 * scale_y - 0.5 + content.y, 0, 0, 1);
+  }
+  cv::Matx33d output_transform = RotationTransform(
+      rotation_, scaled_width, scaled_height, output_width, output_height);
+  if (flip_horizontally_) {
+    output_transform =
+        cv::Matx33d(-1, 0, output_width - 1, 0, 1, 0, 0, 0, 1) *
+        output_transform;
+  }
+  if (flip_vertically_) {
+    output_transform =
+        cv::Matx33d(1, 0, 0, 0, -1, output_height - 1, 0, 0, 1) *
+        output_transform;
+  }
+  const cv::Matx33d inverse_transform =
+      (output_transform * scale_transform).inv();
+
+  if (cc->Outputs().HasTag("LETTERBOX_PADDING")) {
+    auto padding = absl::make_unique<std::array<float, 4>>();
+    ComputeOutputLetterboxPadding(input_width, input_height, output_width,
+                                  output_height, padding.get());
+    cc->Outputs()
+        .Tag("LETTERBOX_PADDING")
+        .Add(padding.release(), cc->InputTimestamp());
+  }
+
+  std::shared_ptr<ImageFrame> output_frame =
+      GetCpuOutputFrame(input.Format(), output_width, output_height);
+  cv::Mat output_mat = formats::MatView(output_frame.get());
+  const int interpolation =
+      interpolation_mode_ == ImageTransformationCalculatorOptions::NEAREST
+          ? cv::INTER_NEAREST
+          : cv::INTER_LINEAR;
+  // Samples the output rows of each band straight from the input. Edges are
+  // replicated, like cv::resize does, and the padding is painted afterwards.
+  const int num_bands = std::max(
+      1, std::min(cv::getNumThreads(), output_height / kMinRowsPerBand));
+  cv::parallel_for_(cv::Range(0, num_bands), [&](const cv::Range& range) {
+    for (int band = range.start; band < range.end; ++band) {
+      const int row_begin = output_height * band / num_bands;
+      const int row_end = output_height * (band + 1) / num_bands;
+      const cv::Matx33d band_transform =
+          inverse_transform *
+          cv::Matx33d(1, 0, 0, 0, 1, row_begin, 0, 0, 1);
+      const cv::Matx23d band_map(band_transform(0, 0), band_transform(0, 1),
+                                 band_transform(0, 2), band_transform(1, 0),
+                                 band_transform(1, 1), band_transform(1, 2));
+      cv::Mat band_mat = output_mat.rowRange(row_begin, row_end);
+      cv::warpAffine(input_mat, band_mat, band_map, band_mat.size(),
+                     interpolation | cv::WARP_INVERSE_MAP,
+                     cv::BORDER_REPLICATE);
+    }
+  });
+
+  if (scale_mode_ == mediapipe::ScaleMode::FIT && options_.constant_padding() &&
+      content != cv::Rect(0, 0, scaled_width, scaled_height)) {
+    // Rotation and flipping map the content onto a rectangle of the output.
+    const cv::Vec3d first =
+        output_transform * cv::Vec3d(content.x, content.y, 1);
+    const cv::Vec3d last = output_transform *
+                           cv::Vec3d(content.x + content.width - 1,
+                                     content.y + content.height - 1, 1);
+    const cv::Rect output_rect(0, 0, output_width, output_height);
+    const cv::Rect output_content =
+        cv::Rect(cv::Point(std::lround(std::min(first[0], last[0])),
+                           std::lround(std::min(first[1], last[1]))),
+                 cv::Point(std::lround(std::max(first[0], last[0])) + 1,
+                           std::lround(std::max(first[1], last[1])) + 1)) &
+        output_rect;
+    output_mat.rowRange(0, output_content.y).setTo(padding_color_);
+    output_mat.rowRange(output_content.br().y, output_height)
+        .setTo(padding_color_);
+    output_mat(cv::Rect(0, output_content.y, output_content.x,
+                        output_content.height))
+        .setTo(padding_color_);
+    output_mat(cv::Rect(output_content.br().x, output_content.y,
+                        output_width - output_content.br().x,
+                        output_content.height))
+        .setTo(padding_color_);
+  }
+
+  const ImageFrame* frame = output_frame.get();
+  cc->Outputs()
+      .Tag(kImageFrameTag)
+      .AddPacket(PointToForeign(frame,
+                                [output_frame = std::move(output_frame)]() {})
+                     .At(cc->InputTimestamp()));
+  return absl::OkStatus();
+}
+
+std::shared_ptr<ImageFrame> ImageTransformationCalculator::GetCpuOutputFrame(
+    ImageFormat::Format format, int width, int height) {
+  if (options_.frame_pool_size() <= 0) {
+    return std::make_shared<ImageFrame>(format, width, height);
+  }
+  if (!frame_pool_ || frame_pool_->format() != format ||
+      frame_pool_->width() != width || frame_pool_->height() != height) {
+    frame_pool_ = ImageFramePool::Create(width, height, format,
+                                         options_.frame_pool_size());
+  }
+  return frame_pool_->GetBuffer();
+}
+
 absl::Status ImageTransformationCalculator::RenderGpu(CalculatorContext* cc) {
 #if !MEDIAPIPE_DISABLE_GPU
   const auto& input = cc->Inputs().Tag(kGpuBufferTag).Get<GpuBuffer>();
@@ -426,5 +426,67 @@ TEST(ImageTransformationCalculatorTest, FitScalingClearsBackground) {
             cv::Scalar(0));
 }
 
+// Runs the CPU path on `input` with the given calculator options and returns
+// the output image packet.
+Packet RunCpuTransformation(const Packet& input, const std::string& options) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      absl::Substitute(R"pb(
+                         calculator: "ImageTransformationCalculator"
+                         input_stream: "IMAGE:input_image"
+                         output_stream: "IMAGE:output_image"
+                         options: {
+                           [mediapipe.ImageTransformationCalculatorOptions
+                                .ext]: { $0 }
+                         }
+                       )pb",
+                       options)));
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      input.At(Timestamp(0)));
+  ABSL_QCHECK_OK(runner.Run());
+  const std::vector<Packet>& packets = runner.Outputs().Tag("IMAGE").packets;
+  ABSL_QCHECK_EQ(packets.size(), 1);
+  return packets[0];
+}
+
+TEST(ImageTransformationCalculatorTest, FusedCpuTransformMatchesSteps) {
+  constexpr int kWidth = 6, kHeight = 4;
+  Packet input = MakePacket<ImageFrame>(ImageFormat::SRGB, kWidth, kHeight);
+  cv::Mat input_mat = formats::MatView(&input.Get<ImageFrame>());
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      input_mat.at<cv::Vec3b>(y, x) = cv::Vec3b(10 * x, 10 * y, 100);
+    }
+  }
+
+  // Rotations that change the size and integer upscaling are exact with
+  // nearest neighbor sampling, so both paths must agree pixel for pixel.
+  const std::vector<std::string> transformations = {
+      "rotation_mode: ROTATION_90",
+      "rotation_mode: ROTATION_270 flip_horizontally: true",
+      "rotation_mode: ROTATION_90 flip_vertically: true",
+      "output_width: 12 output_height: 8 scale_mode: STRETCH",
+      R"(output_width: 12 output_height: 12 scale_mode: FIT
+         padding_color: { red: 1 green: 2 blue: 3 })",
+      R"(output_width: 16 output_height: 8 scale_mode: FIT
+         flip_horizontally: true flip_vertically: true)",
+      "output_width: 12 output_height: 10 scale_mode: FILL_AND_CROP",
+  };
+  for (const std::string& transformation : transformations) {
+    const std::string options =
+        absl::StrCat(transformation, " interpolation_mode: NEAREST");
+    Packet expected = RunCpuTransformation(input, options);
+    Packet fused = RunCpuTransformation(
+        input, absl::StrCat(options, " fused_cpu_transform: true"));
+    const auto& expected_frame = expected.Get<ImageFrame>();
+    const auto& fused_frame = fused.Get<ImageFrame>();
+    ASSERT_EQ(fused_frame.Width(), expected_frame.Width()) << transformation;
+    ASSERT_EQ(fused_frame.Height(), expected_frame.Height()) << transformation;
+    EXPECT_EQ(cv::norm(formats::MatView(&fused_frame),
+                       formats::MatView(&expected_frame), cv::NORM_INF),
+              0)
+        << transformation;
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -12,20 +12,104 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/calculators/image/opencv_encoded_image_to_image_frame_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_frame_pool.h"
 #include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/status_builder.h"
+#include "mediapipe/framework/port/threadpool.h"
 
 namespace mediapipe {
 
+namespace {
+
+// Reads the size and number of components from the frame header of a JPEG
+// image. Returns false if data is not a JPEG image.
+bool ReadJpegHeader(absl::string_view data, int* width, int* height,
+                    int* num_components) {
+  const auto byte = [&data](size_t i) {
+    return static_cast<uint8_t>(data[i]);
+  };
+  if (data.size() < 4 || byte(0) != 0xFF || byte(1) != 0xD8) return false;
+  size_t pos = 2;
+  while (pos + 4 <= data.size()) {
+    if (byte(pos) != 0xFF) return false;
+    const uint8_t marker = byte(pos + 1);
+    pos += 2;
+    // Fill bytes and markers without a segment.
+    if (marker == 0xFF) {
+      --pos;
+      continue;
+    }
+    if (marker == 0x01 || (marker >= 0xD0 && marker <= 0xD8)) continue;
+    // Start of scan: the frame header must have come before.
+    if (marker == 0xDA || marker == 0xD9) return false;
+    const size_t length = (byte(pos) << 8) | byte(pos + 1);
+    // Start of frame markers, except DHT, JPG and DAC.
+    if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 &&
+        marker != 0xC8 && marker != 0xCC) {
+      if (pos + 8 > data.size()) return false;
+      *height = (byte(pos + 3) << 8) | byte(pos + 4);
+      *width = (byte(pos + 5) << 8) | byte(pos + 6);
+      *num_components = byte(pos + 7);
+      return true;
+    }
+    pos += length;
+  }
+  return false;
+}
+
+// Returns the cv::imdecode flags decoding a JPEG image of the given size at
+// the smallest scale that is still at least target_width x target_height, or
+// -1 if the image should be decoded at full size.
+int GetReducedDecodeFlags(int width, int height, int num_components,
+                          int target_width, int target_height) {
+  if (num_components != 1 && num_components != 3) return -1;
+  const bool gray = num_components == 1;
+  for (int denominator : {8, 4, 2}) {
+    if ((width + denominator - 1) / denominator < target_width ||
+        (height + denominator - 1) / denominator < target_height) {
+      continue;
+    }
+    switch (denominator) {
+      case 8:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_8
+                    : cv::IMREAD_REDUCED_COLOR_8;
+      case 4:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_4
+                    : cv::IMREAD_REDUCED_COLOR_4;
+      default:
+        return gray ? cv::IMREAD_REDUCED_GRAYSCALE_2
+                    : cv::IMREAD_REDUCED_COLOR_2;
+    }
+  }
+  return -1;
+}
+
+}  // namespace
+
 // Takes in an encoded image string, decodes it by OpenCV, and converts to an
 // ImageFrame. Note that this calculator only supports grayscale and RGB images
 // for now.
 //
+// For bulk decoding, JPEG images can be decoded at a reduced scale close to a
+// target size, on a pool of decoder threads, into pooled frames. See
+// OpenCvEncodedImageToImageFrameCalculatorOptions.
+//
 // Example config:
 // node {
 //   calculator: "OpenCvEncodedImageToImageFrameCalculator"
@@ -37,9 +121,42 @@ class OpenCvEncodedImageToImageFrameCalculator : public CalculatorBase {
   static absl::Status GetContract(CalculatorContract* cc);
   absl::Status Open(CalculatorContext* cc) override;
   absl::Status Process(CalculatorContext* cc) override;
+  absl::Status Close(CalculatorContext* cc) override;
 
  private:
+  // An image decoded on decoder_pool_.
+  struct DecodeJob {
+    Timestamp timestamp;
+    absl::StatusOr<Packet> frame;
+    bool done = false;
+  };
+
+  // Decodes contents into a frame packet. bgr_mat is scratch space for the
+  // decoder, reused across calls from the same thread.
+  absl::StatusOr<Packet> Decode(absl::string_view contents, cv::Mat* bgr_mat);
+  // Returns a frame to decode into, from frame_pool_ if enabled.
+  std::shared_ptr<ImageFrame> GetFrame(ImageFormat::Format format, int width,
+                                       int height);
+  // Outputs the decoded images in timestamp order, waiting for the oldest ones
+  // until no more than max_in_flight images are being decoded.
+  absl::Status OutputDecodedImages(CalculatorContext* cc, int max_in_flight);
+
+  bool IsOldestJobDone() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return in_flight_.front()->done;
+  }
+
   mediapipe::OpenCvEncodedImageToImageFrameCalculatorOptions options_;
+  cv::Mat bgr_mat_;
+
+  absl::Mutex pool_mutex_;
+  std::shared_ptr<ImageFramePool> frame_pool_ ABSL_GUARDED_BY(pool_mutex_);
+
+  absl::Mutex mutex_;
+  std::deque<std::shared_ptr<DecodeJob>> in_flight_ ABSL_GUARDED_BY(mutex_);
+  int max_in_flight_ = 0;
+  // Declared last so that pending decodes finish before the state they use is
+  // destroyed.
+  std::unique_ptr<ThreadPool> decoder_pool_;
 };
 
 absl::Status OpenCvEncodedImageToImageFrameCalculator::GetContract(
@@ -53,50 +170,163 @@ absl::Status OpenCvEncodedImageToImageFrameCalculator::Open(
     CalculatorContext* cc) {
   options_ =
       cc->Options<mediapipe::OpenCvEncodedImageToImageFrameCalculatorOptions>();
+  if (options_.num_decoder_threads() > 0) {
+    max_in_flight_ = options_.max_in_flight() > 0
+                         ? options_.max_in_flight()
+                         : 2 * options_.num_decoder_threads();
+    decoder_pool_ = std::make_unique<ThreadPool>(
+        "image_decoder", options_.num_decoder_threads());
+    decoder_pool_->StartWorkers();
+  }
   return absl::OkStatus();
 }
 
 absl::Status OpenCvEncodedImageToImageFrameCalculator::Process(
     CalculatorContext* cc) {
-  const std::string& contents = cc->Inputs().Index(0).Get<std::string>();
-  const std::vector<char> contents_vector(contents.begin(), contents.end());
-  cv::Mat decoded_mat;
+  if (!decoder_pool_) {
+    const std::string& contents = cc->Inputs().Index(0).Get<std::string>();
+    MP_ASSIGN_OR_RETURN(Packet frame, Decode(contents, &bgr_mat_));
+    cc->Outputs().Index(0).AddPacket(frame.At(cc->InputTimestamp()));
+    return absl::OkStatus();
+  }
+
+  auto job = std::make_shared<DecodeJob>();
+  job->timestamp = cc->InputTimestamp();
+  {
+    absl::MutexLock lock(&mutex_);
+    in_flight_.push_back(job);
+  }
+  decoder_pool_->Schedule([this, job, input = cc->Inputs().Index(0).Value()] {
+    cv::Mat bgr_mat;
+    absl::StatusOr<Packet> frame =
+        Decode(input.Get<std::string>(), &bgr_mat);
+    absl::MutexLock lock(&mutex_);
+    job->frame = std::move(frame);
+    job->done = true;
+  });
+  return OutputDecodedImages(cc, max_in_flight_);
+}
+
+absl::Status OpenCvEncodedImageToImageFrameCalculator::Close(
+    CalculatorContext* cc) {
+  if (!decoder_pool_) {
+    return absl::OkStatus();
+  }
+  absl::Status status = OutputDecodedImages(cc, 0);
+  decoder_pool_.reset();
+  return status;
+}
+
+absl::Status OpenCvEncodedImageToImageFrameCalculator::OutputDecodedImages(
+    CalculatorContext* cc, int max_in_flight) {
+  while (true) {
+    std::shared_ptr<DecodeJob> job;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (in_flight_.empty()) break;
+      if (in_flight_.size() > static_cast<size_t>(max_in_flight)) {
+        mutex_.Await(absl::Condition(
+            this, &OpenCvEncodedImageToImageFrameCalculator::IsOldestJobDone));
+      } else if (!in_flight_.front()->done) {
+        break;
+      }
+      job = std::move(in_flight_.front());
+      in_flight_.pop_front();
+    }
+    MP_RETURN_IF_ERROR(job->frame.status());
+    cc->Outputs().Index(0).AddPacket(
+        std::move(*job->frame).At(job->timestamp));
+  }
+  return absl::OkStatus();
+}
+
+absl::StatusOr<Packet> OpenCvEncodedImageToImageFrameCalculator::Decode(
+    absl::string_view contents, cv::Mat* bgr_mat) {
+  // Wraps the contents without copying them.
+  const cv::Mat contents_mat(
+      1, contents.size(), CV_8UC1,
+      const_cast<void*>(static_cast<const void*>(contents.data())));
+  int flags;
   if (options_.apply_orientation_from_exif_data()) {
     // We want to respect the orientation from the EXIF data, which
     // IMREAD_UNCHANGED ignores, but otherwise we want to be as permissive as
     // possible with our reading flags. Therefore, we use IMREAD_ANYCOLOR and
     // IMREAD_ANYDEPTH.
-    decoded_mat = cv::imdecode(contents_vector,
-                               cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
+    flags = cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH;
   } else {
     // Return the loaded image as-is
-    decoded_mat = cv::imdecode(contents_vector, cv::IMREAD_UNCHANGED);
+    flags = cv::IMREAD_UNCHANGED;
   }
+  int width, height, num_components;
+  if (options_.target_width() > 0 && options_.target_height() > 0 &&
+      ReadJpegHeader(contents, &width, &height, &num_components)) {
+    const int reduced_flags =
+        GetReducedDecodeFlags(width, height, num_components,
+                              options_.target_width(), options_.target_height());
+    if (reduced_flags >= 0) {
+      flags = options_.apply_orientation_from_exif_data()
+                  ? reduced_flags
+                  : reduced_flags | cv::IMREAD_IGNORE_ORIENTATION;
+    }
+  }
+  cv::imdecode(contents_mat, flags, bgr_mat);
+  const cv::Mat& decoded_mat = *bgr_mat;
+  if (decoded_mat.empty()) {
+    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+           << "Failed to decode the image.";
+  }
+
   ImageFormat::Format image_format = ImageFormat::UNKNOWN;
-  cv::Mat output_mat;
+  int conversion = -1;
   switch (decoded_mat.channels()) {
     case 1:
       image_format = ImageFormat::GRAY8;
-      output_mat = decoded_mat;
       break;
     case 3:
       image_format = ImageFormat::SRGB;
-      cv::cvtColor(decoded_mat, output_mat, cv::COLOR_BGR2RGB);
+      conversion = cv::COLOR_BGR2RGB;
       break;
     case 4:
       image_format = ImageFormat::SRGBA;
-      cv::cvtColor(decoded_mat, output_mat, cv::COLOR_BGR2RGBA);
+      conversion = cv::COLOR_BGR2RGBA;
       break;
     default:
       return mediapipe::FailedPreconditionErrorBuilder(MEDIAPIPE_LOC)
              << "Unsupported number of channels: " << decoded_mat.channels();
   }
-  std::unique_ptr<ImageFrame> output_frame = absl::make_unique<ImageFrame>(
-      image_format, decoded_mat.size().width, decoded_mat.size().height,
-      ImageFrame::kGlDefaultAlignmentBoundary);
-  output_mat.copyTo(formats::MatView(output_frame.get()));
-  cc->Outputs().Index(0).Add(output_frame.release(), cc->InputTimestamp());
-  return absl::OkStatus();
+  std::shared_ptr<ImageFrame> output_frame =
+      GetFrame(image_format, decoded_mat.cols, decoded_mat.rows);
+  // Writes the output frame once, by the color conversion if any.
+  cv::Mat output_mat = formats::MatView(output_frame.get());
+  if (conversion >= 0) {
+    cv::cvtColor(decoded_mat, output_mat, conversion);
+  } else {
+    decoded_mat.copyTo(output_mat);
+  }
+  const ImageFrame* frame = output_frame.get();
+  return PointToForeign(frame,
+                        [output_frame = std::move(output_frame)]() mutable {
+                          output_frame.reset();
+                        });
+}
+
+std::shared_ptr<ImageFrame> OpenCvEncodedImageToImageFrameCalculator::GetFrame(
+    ImageFormat::Format format, int width, int height) {
+  if (options_.frame_pool_size() <= 0) {
+    return std::make_shared<ImageFrame>(
+        format, width, height, ImageFrame::kGlDefaultAlignmentBoundary);
+  }
+  std::shared_ptr<ImageFramePool> pool;
+  {
+    absl::MutexLock lock(&pool_mutex_);
+    if (!frame_pool_ || frame_pool_->format() != format ||
+        frame_pool_->width() != width || frame_pool_->height() != height) {
+      frame_pool_ = ImageFramePool::Create(width, height, format,
+                                           options_.frame_pool_size());
+    }
+    pool = frame_pool_;
+  }
+  return pool->GetBuffer();
 }
 
 REGISTER_CALCULATOR(OpenCvEncodedImageToImageFrameCalculator);
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "absl/strings/substitute.h"
+#include "mediapipe/calculators/image/opencv_encoded_image_to_image_frame_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/deps/file_path.h"
@@ -102,5 +104,79 @@ TEST(OpenCvEncodedImageToImageFrameCalculatorTest, TestGrayscaleJpeg) {
   EXPECT_LE(max_val, 10);
 }
 
+TEST(OpenCvEncodedImageToImageFrameCalculatorTest, TestReducedScaleJpeg) {
+  std::string contents;
+  MP_ASSERT_OK(file::GetContents(
+      file::JoinPath("./", "/mediapipe/calculators/image/testdata/dino.jpg"),
+      &contents));
+  cv::Mat input_mat = cv::imread(
+      file::JoinPath("./", "/mediapipe/calculators/image/testdata/dino.jpg"));
+
+  CalculatorGraphConfig::Node node_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(absl::Substitute(
+          R"pb(
+            calculator: "OpenCvEncodedImageToImageFrameCalculator"
+            input_stream: "encoded_image"
+            output_stream: "image_frame"
+            options {
+              [mediapipe.OpenCvEncodedImageToImageFrameCalculatorOptions.ext] {
+                target_width: $0
+                target_height: $1
+              }
+            }
+          )pb",
+          input_mat.cols / 4, input_mat.rows / 4));
+  CalculatorRunner runner(node_config);
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::string>(contents).At(Timestamp(0)));
+  MP_ASSERT_OK(runner.Run());
+  const std::vector<Packet>& packets = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(1, packets.size());
+  const ImageFrame& output_frame = packets[0].Get<ImageFrame>();
+  EXPECT_EQ(output_frame.Format(), ImageFormat::SRGB);
+  // The 1/8 scale would be smaller than the target, so the 1/4 scale is used.
+  EXPECT_EQ(output_frame.Width(), (input_mat.cols + 3) / 4);
+  EXPECT_EQ(output_frame.Height(), (input_mat.rows + 3) / 4);
+}
+
+TEST(OpenCvEncodedImageToImageFrameCalculatorTest,
+     TestParallelDecodeKeepsTimestampOrder) {
+  std::string contents;
+  MP_ASSERT_OK(file::GetContents(
+      file::JoinPath("./", "/mediapipe/calculators/image/testdata/dino.jpg"),
+      &contents));
+  cv::Mat input_mat = cv::imread(
+      file::JoinPath("./", "/mediapipe/calculators/image/testdata/dino.jpg"));
+
+  CalculatorGraphConfig::Node node_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+        calculator: "OpenCvEncodedImageToImageFrameCalculator"
+        input_stream: "encoded_image"
+        output_stream: "image_frame"
+        options {
+          [mediapipe.OpenCvEncodedImageToImageFrameCalculatorOptions.ext] {
+            num_decoder_threads: 3
+            max_in_flight: 2
+            frame_pool_size: 2
+          }
+        }
+      )pb");
+  CalculatorRunner runner(node_config);
+  constexpr int kNumImages = 10;
+  for (int i = 0; i < kNumImages; ++i) {
+    runner.MutableInputs()->Index(0).packets.push_back(
+        MakePacket<std::string>(contents).At(Timestamp(i)));
+  }
+  MP_ASSERT_OK(runner.Run());
+  const std::vector<Packet>& packets = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(kNumImages, packets.size());
+  for (int i = 0; i < kNumImages; ++i) {
+    EXPECT_EQ(packets[i].Timestamp(), Timestamp(i));
+    const ImageFrame& output_frame = packets[i].Get<ImageFrame>();
+    EXPECT_EQ(output_frame.Width(), input_mat.cols);
+    EXPECT_EQ(output_frame.Height(), input_mat.rows);
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -94,13 +94,54 @@ void CropImageFrame(const ImageFrame& original, int col_start, int row_start,
   }
 }
 
+// Scales a YUVImage to the given dimensions with libyuv, plane by plane and
+// without converting the color space. NV12 and NV21 images keep their
+// interleaved chroma plane and fourcc, YV12 images keep their plane order, and
+// all other images are treated as I420.
+absl::Status ScaleYUVImage(const YUVImage& yuv_image, int width, int height,
+                           std::unique_ptr<YUVImage>* scaled_image) {
+  const int uv_width = (width + 1) / 2;
+  const int uv_height = (height + 1) / 2;
+  const int y_size = width * height;
+  const int uv_size = uv_width * uv_height;
+  std::unique_ptr<uint8_t[]> yuv_data(new uint8_t[y_size + uv_size * 2]);
+  uint8_t* y = yuv_data.get();
+  uint8_t* u = y + y_size;
+  const libyuv::FourCC fourcc = yuv_image.fourcc();
+  if (fourcc == libyuv::FOURCC_NV12 || fourcc == libyuv::FOURCC_NV21) {
+    RET_CHECK_EQ(0, libyuv::NV12Scale(yuv_image.data(0), yuv_image.stride(0),
+                                      yuv_image.data(1), yuv_image.stride(1),
+                                      yuv_image.width(), yuv_image.height(), y,
+                                      width, u, uv_width * 2, width, height,
+                                      libyuv::kFilterBox));
+    *scaled_image =
+        absl::make_unique<YUVImage>(fourcc, std::move(yuv_data), y, width, u,
+                                    uv_width * 2, nullptr, 0, width, height);
+    return absl::OkStatus();
+  }
+  uint8_t* v = u + uv_size;
+  RET_CHECK_EQ(0, libyuv::I420Scale(yuv_image.data(0), yuv_image.stride(0),
+                                    yuv_image.data(1), yuv_image.stride(1),
+                                    yuv_image.data(2), yuv_image.stride(2),
+                                    yuv_image.width(), yuv_image.height(), y,
+                                    width, u, uv_width, v, uv_width, width,
+                                    height, libyuv::kFilterBox));
+  *scaled_image = absl::make_unique<YUVImage>(
+      fourcc == libyuv::FOURCC_YV12 ? libyuv::FOURCC_YV12
+                                    : libyuv::FOURCC_I420,
+      std::move(yuv_data), y, width, u, uv_width, v, uv_width, width, height);
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 // Crops and scales an ImageFrame or YUVImage according to the options;
 // The output can be cropped and scaled ImageFrame with the SRGB format. If the
 // input is a YUVImage, the output can be a scaled YUVImage (the scaling is done
 // using libyuv). Cropping is not yet supported for a YUVImage to a scaled
-// YUVImage conversion.
+// YUVImage conversion. With scale_yuv_before_conversion, a YUVImage that is
+// only downscaled to SRGB is scaled in YUV space and converted to SRGB at the
+// output resolution.
 //
 // Example config:
 // node {
@@ -215,6 +256,13 @@ class ScaleImageCalculator : public CalculatorBase {
   // on which this function is called is used to initialize.
   absl::Status ValidateYUVImage(CalculatorContext* cc,
                                 const YUVImage& yuv_image);
+  // Converts a YUVImage to an SRGB ImageFrame, honoring use_bt709.
+  void ConvertYUVImage(const YUVImage& yuv_image, ImageFrame* image_frame);
+  // Scales the YUVImage to the output dimensions in YUV space and converts
+  // only the scaled image to SRGB. Used when scale_yuv_before_conversion is
+  // set and the image is downscaled without cropping.
+  absl::Status ScaleAndConvertYUVImage(CalculatorContext* cc,
+                                       const YUVImage& yuv_image);
 
   bool has_header_;  // True if the input stream has a header.
   int input_width_;
@@ -542,6 +590,40 @@ absl::Status ScaleImageCalculator::ValidateYUVImage(CalculatorContext* cc,
   return absl::OkStatus();
 }
 
+void ScaleImageCalculator::ConvertYUVImage(const YUVImage& yuv_image,
+                                           ImageFrame* image_frame) {
+  if (options_.use_bt709() || yuv_image.fourcc() == libyuv::FOURCC_ANY) {
+    image_frame_util::YUVImageToImageFrame(yuv_image, image_frame,
+                                           options_.use_bt709());
+  } else {
+    image_frame_util::YUVImageToImageFrameFromFormat(yuv_image, image_frame);
+  }
+}
+
+absl::Status ScaleImageCalculator::ScaleAndConvertYUVImage(
+    CalculatorContext* cc, const YUVImage& yuv_image) {
+  std::unique_ptr<YUVImage> scaled_image;
+  MP_RETURN_IF_ERROR(ScaleYUVImage(yuv_image, output_width_, output_height_,
+                                   &scaled_image));
+  auto output_frame = absl::make_unique<ImageFrame>();
+  ConvertYUVImage(*scaled_image, output_frame.get());
+  if (!output_frame->IsAligned(alignment_boundary_)) {
+    auto aligned_frame = absl::make_unique<ImageFrame>();
+    aligned_frame->CopyFrom(*output_frame, alignment_boundary_);
+    output_frame = std::move(aligned_frame);
+  }
+  if (options_.set_alignment_padding()) {
+    cc->GetCounter("Pads")->Increment();
+    output_frame->SetAlignmentPaddingAreas();
+  }
+  cc->GetCounter("Downscales")->Increment();
+  cc->GetCounter("Outputs Scaled")->Increment();
+  cc->Outputs()
+      .Get(output_data_id_)
+      .Add(output_frame.release(), cc->InputTimestamp());
+  return absl::OkStatus();
+}
+
 absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
   if (cc->InputTimestamp() == Timestamp::PreStream()) {
     if (cc->Inputs().HasTag("OVERRIDE_OPTIONS")) {
@@ -572,17 +654,18 @@ absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
     MP_RETURN_IF_ERROR(ValidateYUVImage(cc, *yuv_image));
 
     if (output_format_ == ImageFormat::SRGB) {
+      if (options_.scale_yuv_before_conversion() &&
+          row_start_ == 0 && col_start_ == 0 &&
+          crop_width_ == input_width_ && crop_height_ == input_height_ &&
+          output_width_ <= input_width_ && output_height_ <= input_height_ &&
+          (output_width_ < input_width_ || output_height_ < input_height_)) {
+        return ScaleAndConvertYUVImage(cc, *yuv_image);
+      }
       // TODO: For ease of implementation, YUVImage is converted to
       // ImageFrame immediately, before cropping and scaling. Investigate how to
-      // make color space conversion more efficient when cropping or scaling is
-      // also needed.
-      if (options_.use_bt709() || yuv_image->fourcc() == libyuv::FOURCC_ANY) {
-        image_frame_util::YUVImageToImageFrame(
-            *yuv_image, &converted_image_frame, options_.use_bt709());
-      } else {
-        image_frame_util::YUVImageToImageFrameFromFormat(
-            *yuv_image, &converted_image_frame);
-      }
+      // make color space conversion more efficient when cropping or upscaling
+      // is also needed.
+      ConvertYUVImage(*yuv_image, &converted_image_frame);
       image_frame = &converted_image_frame;
     } else if (output_format_ == ImageFormat::YCBCR420P) {
       RET_CHECK(row_start_ == 0 && col_start_ == 0 &&
@@ -591,23 +674,9 @@ absl::Status ScaleImageCalculator::Process(CalculatorContext* cc) {
              "images, the output format must be SRGB.";
 
       // Scale the YUVImage and output without converting the color space.
-      const int y_size = output_width_ * output_height_;
-      const int uv_size = output_width_ * output_height_ / 4;
-      std::unique_ptr<uint8_t[]> yuv_data(new uint8_t[y_size + uv_size * 2]);
-      uint8_t* y = yuv_data.get();
-      uint8_t* u = y + y_size;
-      uint8_t* v = u + uv_size;
-      RET_CHECK_EQ(0, I420Scale(yuv_image->data(0), yuv_image->stride(0),
-                                yuv_image->data(1), yuv_image->stride(1),
-                                yuv_image->data(2), yuv_image->stride(2),
-                                yuv_image->width(), yuv_image->height(), y,
-                                output_width_, u, output_width_ / 2, v,
-                                output_width_ / 2, output_width_,
-                                output_height_, libyuv::kFilterBox));
-      auto output_image = absl::make_unique<YUVImage>(
-          libyuv::FOURCC_I420, std::move(yuv_data), y, output_width_, u,
-          output_width_ / 2, v, output_width_ / 2, output_width_,
-          output_height_);
+      std::unique_ptr<YUVImage> output_image;
+      MP_RETURN_IF_ERROR(ScaleYUVImage(*yuv_image, output_width_,
+                                       output_height_, &output_image));
       cc->GetCounter("Outputs Scaled")->Increment();
       if (yuv_image->width() >= output_width_ &&
           yuv_image->height() >= output_height_) {
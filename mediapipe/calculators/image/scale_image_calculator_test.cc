@@ -1,11 +1,18 @@
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
+#include "absl/strings/substitute.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/yuv_image.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/framework/timestamp.h"
@@ -77,5 +84,56 @@ TEST(ScaleImageCalculatorTest, ScaleOddSize) {
                        HasSubstr("Image frame is empty before rescaling.")));
 }
 
+TEST(ScaleImageCalculatorTest, ScalesNv12BeforeConversion) {
+  constexpr int kWidth = 64;
+  constexpr int kHeight = 48;
+  // A uniform NV12 frame, so scaling before or after the color conversion
+  // gives the same pixels.
+  std::unique_ptr<uint8_t[]> data(new uint8_t[kWidth * kHeight * 3 / 2]);
+  std::fill_n(data.get(), kWidth * kHeight, 100);
+  std::fill_n(data.get() + kWidth * kHeight, kWidth * kHeight / 2, 140);
+  uint8_t* y = data.get();
+  uint8_t* uv = y + kWidth * kHeight;
+  auto yuv_image = std::make_unique<YUVImage>(
+      libyuv::FOURCC_NV12, std::move(data), y, kWidth, uv, kWidth, nullptr, 0,
+      kWidth, kHeight);
+  const Packet input_packet =
+      Adopt(yuv_image.release()).At(mediapipe::Timestamp(1));
+
+  std::vector<ImageFrame> outputs;
+  for (bool scale_yuv_before_conversion : {false, true}) {
+    mediapipe::CalculatorRunner runner(
+        ParseTextProtoOrDie<mediapipe::CalculatorGraphConfig::Node>(
+            absl::Substitute(R"pb(
+                               calculator: "ScaleImageCalculator"
+                               input_stream: "input_frames"
+                               output_stream: "scaled_frames"
+                               options {
+                                 [mediapipe.ScaleImageCalculatorOptions.ext] {
+                                   input_format: YCBCR420P
+                                   output_format: SRGB
+                                   target_width: 32
+                                   target_height: 24
+                                   scale_yuv_before_conversion: $0
+                                 }
+                               }
+                             )pb",
+                             scale_yuv_before_conversion)));
+    runner.MutableInputs()->Index(0).packets.push_back(input_packet);
+    MP_ASSERT_OK(runner.Run());
+    const auto& packets = runner.Outputs().Index(0).packets;
+    ASSERT_EQ(packets.size(), 1);
+    const auto& output = packets[0].Get<ImageFrame>();
+    EXPECT_EQ(output.Format(), ImageFormat::SRGB);
+    EXPECT_EQ(output.Width(), 32);
+    EXPECT_EQ(output.Height(), 24);
+    outputs.emplace_back();
+    outputs.back().CopyFrom(output, /*alignment_boundary=*/1);
+  }
+  const cv::Mat expected = formats::MatView(&outputs[0]);
+  const cv::Mat actual = formats::MatView(&outputs[1]);
+  EXPECT_LE(cv::norm(expected, actual, cv::NORM_INF), 1);
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -45,6 +45,41 @@ constexpr char kPreviousMaskTag[] = "MASK_PREVIOUS";
 constexpr char kOutputMaskTag[] = "MASK_SMOOTHED";
 
 enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
+
+// Blends `count` contiguous mask values: the previous mask value is mixed into
+// the new one in proportion to the uncertainty of the new value. The loop body
+// is branch-free element-wise float math (the clamp is a min), so compilers
+// vectorize it.
+void BlendMasks(const float* current, const float* previous, int count,
+                float combine_with_previous_ratio, float* output) {
+  /*
+   * Assume p := new_mask_value
+   * H(p) := 1 + (p * log(p) + (1-p) * log(1-p)) / log(2)
+   * uncertainty alpha(p) =
+   *   Clamp(1 - (1 - H(p)) * (1 - H(p)), 0, 1) [squaring the uncertainty]
+   *
+   * The following polynomial approximates uncertainty alpha as a function
+   * of (p + 0.5):
+   */
+  constexpr float c1 = 5.68842;
+  constexpr float c2 = -0.748699;
+  constexpr float c3 = -57.8051;
+  constexpr float c4 = 291.309;
+  constexpr float c5 = -624.717;
+  for (int i = 0; i < count; ++i) {
+    const float new_mask_value = current[i];
+    const float prev_mask_value = previous[i];
+    const float t = new_mask_value - 0.5f;
+    const float x = t * t;
+
+    const float uncertainty =
+        1.0f -
+        std::min(1.0f, x * (c1 + x * (c2 + x * (c3 + x * (c4 + x * c5)))));
+
+    const float mix_ratio = uncertainty * combine_with_previous_ratio;
+    output[i] = new_mask_value + (prev_mask_value - new_mask_value) * mix_ratio;
+  }
+}
 }  // namespace
 
 // A calculator for mixing two segmentation masks together,
@@ -210,45 +245,19 @@ absl::Status SegmentationSmoothingCalculator::RenderCpu(CalculatorContext* cc) {
   auto output_frame = std::make_shared<ImageFrame>(
       current_frame.image_format(), current_mat->cols, current_mat->rows);
   cv::Mat output_mat = mediapipe::formats::MatView(output_frame.get());
-  output_mat.setTo(cv::Scalar(0));
-
-  // Blending function.
-  const auto blending_fn = [&](const float prev_mask_value,
-                               const float new_mask_value) {
-    /*
-     * Assume p := new_mask_value
-     * H(p) := 1 + (p * log(p) + (1-p) * log(1-p)) / log(2)
-     * uncertainty alpha(p) =
-     *   Clamp(1 - (1 - H(p)) * (1 - H(p)), 0, 1) [squaring the uncertainty]
-     *
-     * The following polynomial approximates uncertainty alpha as a function
-     * of (p + 0.5):
-     */
-    const float c1 = 5.68842;
-    const float c2 = -0.748699;
-    const float c3 = -57.8051;
-    const float c4 = 291.309;
-    const float c5 = -624.717;
-    const float t = new_mask_value - 0.5f;
-    const float x = t * t;
 
-    const float uncertainty =
-        1.0f -
-        std::min(1.0f, x * (c1 + x * (c2 + x * (c3 + x * (c4 + x * c5)))));
-
-    return new_mask_value + (prev_mask_value - new_mask_value) *
-                                (uncertainty * combine_with_previous_ratio_);
-  };
-
-  // Write directly to the first channel of output.
-  for (int i = 0; i < output_mat.rows; ++i) {
-    float* out_ptr = output_mat.ptr<float>(i);
-    const float* curr_ptr = current_mat->ptr<float>(i);
-    const float* prev_ptr = previous_mat->ptr<float>(i);
-    for (int j = 0; j < output_mat.cols; ++j) {
-      const float new_mask_value = curr_ptr[j];
-      const float prev_mask_value = prev_ptr[j];
-      out_ptr[j] = blending_fn(prev_mask_value, new_mask_value);
+  // Every output value is written, so the output is not cleared first. Masks
+  // without row padding are blended in a single pass.
+  if (output_mat.isContinuous() && current_mat->isContinuous() &&
+      previous_mat->isContinuous()) {
+    BlendMasks(current_mat->ptr<float>(), previous_mat->ptr<float>(),
+               output_mat.rows * output_mat.cols, combine_with_previous_ratio_,
+               output_mat.ptr<float>());
+  } else {
+    for (int i = 0; i < output_mat.rows; ++i) {
+      BlendMasks(current_mat->ptr<float>(i), previous_mat->ptr<float>(i),
+                 output_mat.cols, combine_with_previous_ratio_,
+                 output_mat.ptr<float>(i));
     }
   }
 
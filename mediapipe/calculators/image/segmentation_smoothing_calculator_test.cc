@@ -12,7 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <memory>
+#include <random>
 
 #include "absl/log/absl_log.h"
 #include "mediapipe/calculators/image/segmentation_smoothing_calculator.pb.h"
@@ -203,5 +205,60 @@ TEST(SegmentationSmoothingCalculatorTest, TestSmoothing) {
   }
 }
 
+// The per pixel blending the CPU path used before it was vectorized.
+float ReferenceBlend(float prev_mask_value, float new_mask_value,
+                     float combine_with_previous_ratio) {
+  const float c1 = 5.68842;
+  const float c2 = -0.748699;
+  const float c3 = -57.8051;
+  const float c4 = 291.309;
+  const float c5 = -624.717;
+  const float t = new_mask_value - 0.5f;
+  const float x = t * t;
+
+  const float uncertainty =
+      1.0f -
+      std::min(1.0f, x * (c1 + x * (c2 + x * (c3 + x * (c4 + x * c5)))));
+
+  return new_mask_value + (prev_mask_value - new_mask_value) *
+                              (uncertainty * combine_with_previous_ratio);
+}
+
+TEST(SegmentationSmoothingCalculatorTest, CpuMatchesReferenceOnOddSizes) {
+  constexpr float kMixRatio = 0.7f;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+  // Widths that are multiples of 4 give unpadded rows, which are blended in a
+  // single pass; the others have padded rows and are blended row by row.
+  for (const cv::Size size : {cv::Size(1, 1), cv::Size(12, 7),
+                              cv::Size(17, 13), cv::Size(36, 5)}) {
+    Packet curr_packet = MakePacket<Image>(std::make_unique<ImageFrame>(
+        ImageFormat::VEC32F1, size.width, size.height));
+    Packet prev_packet = MakePacket<Image>(std::make_unique<ImageFrame>(
+        ImageFormat::VEC32F1, size.width, size.height));
+    auto curr_mat = formats::MatView(&(curr_packet.Get<Image>()));
+    auto prev_mat = formats::MatView(&(prev_packet.Get<Image>()));
+    for (int i = 0; i < size.height; ++i) {
+      for (int j = 0; j < size.width; ++j) {
+        curr_mat->at<float>(i, j) = distribution(rng);
+        prev_mat->at<float>(i, j) = distribution(rng);
+      }
+    }
+
+    cv::Mat result;
+    RunGraph(curr_packet, prev_packet, /*use_gpu=*/false, kMixRatio, &result);
+
+    ASSERT_EQ(result.size(), size);
+    for (int i = 0; i < size.height; ++i) {
+      for (int j = 0; j < size.width; ++j) {
+        EXPECT_FLOAT_EQ(result.at<float>(i, j),
+                        ReferenceBlend(prev_mat->at<float>(i, j),
+                                       curr_mat->at<float>(i, j), kMixRatio))
+            << "size " << size << " at (" << i << ", " << j << ")";
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -204,7 +204,13 @@ class AudioToTensorCalculator : public Node {
   audio_dsp::QResamplerParams params_;
   // A QResampler instance to resample an audio stream.
   std::unique_ptr<audio_dsp::QResampler<float>> resampler_;
+  // Storage of the streaming sample buffer. The buffered samples are the
+  // sample_buffer_size_ columns starting at sample_buffer_start_, so that
+  // dropping processed samples does not move the remaining ones. They are
+  // moved to the front only when appending would overflow the storage.
   Matrix sample_buffer_;
+  int sample_buffer_start_ = 0;
+  int sample_buffer_size_ = 0;
   int processed_buffer_cols_ = 0;
   double gain_ = 1.0;
 
@@ -225,15 +231,24 @@ class AudioToTensorCalculator : public Node {
                                        const Matrix& input);
 
   absl::Status SetupStreamingResampler(double input_sample_rate_);
-  void AppendToSampleBuffer(Matrix buffer_to_append);
+  // Returns the buffered samples.
+  Eigen::Ref<const Matrix> SampleBuffer() const {
+    return sample_buffer_.middleCols(sample_buffer_start_, sample_buffer_size_);
+  }
+  // Makes room for num_samples more samples at the end of the sample buffer
+  // and returns them.
+  Eigen::Ref<Matrix> ExtendSampleBuffer(int num_samples);
+  void AppendToSampleBuffer(const Eigen::Ref<const Matrix>& buffer_to_append);
   void AppendZerosToSampleBuffer(int num_samples);
+  // Drops num_samples samples from the front of the sample buffer.
+  void DropFromSampleBuffer(int num_samples);
 
   absl::StatusOr<std::vector<Tensor>> ConvertToTensor(
-      const Matrix& block, std::vector<int> tensor_dims);
-  absl::Status OutputTensor(const Matrix& block, Timestamp timestamp,
-                            CalculatorContext* cc);
-  absl::Status ProcessBuffer(const Matrix& buffer, bool should_flush,
-                             CalculatorContext* cc);
+      const Eigen::Ref<const Matrix>& block, std::vector<int> tensor_dims);
+  absl::Status OutputTensor(const Eigen::Ref<const Matrix>& block,
+                            Timestamp timestamp, CalculatorContext* cc);
+  absl::Status ProcessBuffer(const Eigen::Ref<const Matrix>& buffer,
+                             bool should_flush, CalculatorContext* cc);
 };
 
 absl::Status AudioToTensorCalculator::UpdateContract(CalculatorContract* cc) {
@@ -377,10 +392,10 @@ absl::Status AudioToTensorCalculator::Close(CalculatorContext* cc) {
   if (resampler_) {
     Matrix resampled_buffer(num_channels_, 0);
     resampler_->Flush(&resampled_buffer);
-    AppendToSampleBuffer(std::move(resampled_buffer));
+    AppendToSampleBuffer(resampled_buffer);
   }
   AppendZerosToSampleBuffer(padding_samples_after_);
-  MP_RETURN_IF_ERROR(ProcessBuffer(sample_buffer_, /*should_flush=*/true, cc));
+  MP_RETURN_IF_ERROR(ProcessBuffer(SampleBuffer(), /*should_flush=*/true, cc));
   if (fft_state_) {
     pffft_destroy_setup(fft_state_);
   }
@@ -412,23 +427,14 @@ absl::Status AudioToTensorCalculator::ProcessStreamingData(
   if (resampler_) {
     Matrix resampled_buffer(num_channels_, 0);
     resampler_->ProcessSamples(input_buffer, &resampled_buffer);
-    AppendToSampleBuffer(std::move(resampled_buffer));
+    AppendToSampleBuffer(resampled_buffer);
   } else {
-    // Tries to consume the input matrix first to avoid extra data copy.
-    auto status_or_matrix = kAudioIn(cc).packet().Consume<Matrix>();
-    if (status_or_matrix.ok()) {
-      Matrix local_matrix(num_channels_, 0);
-      local_matrix.swap(*status_or_matrix.value());
-      AppendToSampleBuffer(std::move(local_matrix));
-    } else {
-      AppendToSampleBuffer(input_buffer);
-    }
+    AppendToSampleBuffer(input_buffer);
   }
 
-  MP_RETURN_IF_ERROR(ProcessBuffer(sample_buffer_, /*should_flush=*/false, cc));
+  MP_RETURN_IF_ERROR(ProcessBuffer(SampleBuffer(), /*should_flush=*/false, cc));
   // Removes the processed samples from the global sample buffer.
-  sample_buffer_ = Matrix(sample_buffer_.rightCols(sample_buffer_.cols() -
-                                                   processed_buffer_cols_ - 1));
+  DropFromSampleBuffer(processed_buffer_cols_ + 1);
   return absl::OkStatus();
 }
 
@@ -466,24 +472,59 @@ absl::Status AudioToTensorCalculator::SetupStreamingResampler(
   return absl::OkStatus();
 }
 
+Eigen::Ref<Matrix> AudioToTensorCalculator::ExtendSampleBuffer(
+    int num_samples) {
+  const int required_cols = sample_buffer_size_ + num_samples;
+  if (sample_buffer_start_ + required_cols > sample_buffer_.cols()) {
+    if (required_cols <= sample_buffer_.cols()) {
+      // Moves the buffered samples to the front. Columns are contiguous, and
+      // the destination precedes the source.
+      std::copy_n(sample_buffer_.col(sample_buffer_start_).data(),
+                  sample_buffer_.rows() * sample_buffer_size_,
+                  sample_buffer_.data());
+    } else {
+      // Grows geometrically, so that a steady stream settles on a fixed
+      // storage after a few packets.
+      Matrix storage(sample_buffer_.rows(),
+                     std::max<Eigen::Index>(required_cols,
+                                            2 * sample_buffer_.cols()));
+      storage.leftCols(sample_buffer_size_) = SampleBuffer();
+      sample_buffer_.swap(storage);
+    }
+    sample_buffer_start_ = 0;
+  }
+  const int first_col = sample_buffer_start_ + sample_buffer_size_;
+  sample_buffer_size_ = required_cols;
+  return sample_buffer_.middleCols(first_col, num_samples);
+}
+
 void AudioToTensorCalculator::AppendZerosToSampleBuffer(int num_samples) {
   ABSL_CHECK_GE(num_samples, 0);  // Ensured by `UpdateContract`.
   if (num_samples == 0) {
     return;
   }
-  sample_buffer_.conservativeResize(Eigen::NoChange,
-                                    sample_buffer_.cols() + num_samples);
-  sample_buffer_.rightCols(num_samples).setZero();
+  ExtendSampleBuffer(num_samples).setZero();
+}
+
+void AudioToTensorCalculator::AppendToSampleBuffer(
+    const Eigen::Ref<const Matrix>& buffer_to_append) {
+  if (buffer_to_append.cols() == 0) {
+    return;
+  }
+  ExtendSampleBuffer(buffer_to_append.cols()) = buffer_to_append;
 }
 
-void AudioToTensorCalculator::AppendToSampleBuffer(Matrix buffer_to_append) {
-  sample_buffer_.conservativeResize(
-      Eigen::NoChange, sample_buffer_.cols() + buffer_to_append.cols());
-  sample_buffer_.rightCols(buffer_to_append.cols()).swap(buffer_to_append);
+void AudioToTensorCalculator::DropFromSampleBuffer(int num_samples) {
+  num_samples = std::min(num_samples, sample_buffer_size_);
+  sample_buffer_start_ += num_samples;
+  sample_buffer_size_ -= num_samples;
+  if (sample_buffer_size_ == 0) {
+    sample_buffer_start_ = 0;
+  }
 }
 
 absl::StatusOr<std::vector<Tensor>> AudioToTensorCalculator::ConvertToTensor(
-    const Matrix& block, std::vector<int> tensor_dims) {
+    const Eigen::Ref<const Matrix>& block, std::vector<int> tensor_dims) {
   Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape(tensor_dims),
                 memory_manager_);
   auto buffer_view = tensor.GetCpuWriteView();
@@ -494,22 +535,22 @@ absl::StatusOr<std::vector<Tensor>> AudioToTensorCalculator::ConvertToTensor(
   if (block.size() < total_size) {
     std::memset(buffer_view.buffer<float>(), 0, tensor.bytes());
   }
-  std::memcpy(buffer_view.buffer<float>(), block.data(),
-              block.size() * sizeof(float));
+  // Copies the block straight from the sample buffer, whatever its stride.
+  Eigen::Map<Matrix>(buffer_view.buffer<float>(), block.rows(), block.cols()) =
+      block;
   std::vector<Tensor> tensor_vector;
   tensor_vector.push_back(std::move(tensor));
   return tensor_vector;
 }
 
-absl::Status AudioToTensorCalculator::OutputTensor(const Matrix& block,
-                                                   Timestamp timestamp,
-                                                   CalculatorContext* cc) {
+absl::Status AudioToTensorCalculator::OutputTensor(
+    const Eigen::Ref<const Matrix>& block, Timestamp timestamp,
+    CalculatorContext* cc) {
   std::vector<Tensor> output_tensor;
   if (fft_state_) {
-    Eigen::VectorXf time_series_data =
-        Eigen::VectorXf::Map(block.data(), block.size());
+    // The FFT requires a single channel, so the block is one contiguous row.
     //  Window on input audio prior to FFT.
-    std::transform(time_series_data.begin(), time_series_data.end(),
+    std::transform(block.data(), block.data() + block.size(),
                    fft_window_.begin(), fft_input_buffer_.begin(),
                    std::multiplies<float>());
     pffft_transform_ordered(fft_state_, fft_input_buffer_.data(),
@@ -564,9 +605,9 @@ absl::Status AudioToTensorCalculator::OutputTensor(const Matrix& block,
   return absl::OkStatus();
 }
 
-absl::Status AudioToTensorCalculator::ProcessBuffer(const Matrix& buffer,
-                                                    bool should_flush,
-                                                    CalculatorContext* cc) {
+absl::Status AudioToTensorCalculator::ProcessBuffer(
+    const Eigen::Ref<const Matrix>& buffer, bool should_flush,
+    CalculatorContext* cc) {
   const bool should_flush_at_timestamp_max =
       stream_mode_ && should_flush &&
       flush_mode_ == Options::ENTIRE_TAIL_AT_TIMESTAMP_MAX;
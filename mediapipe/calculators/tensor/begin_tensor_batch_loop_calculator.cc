@@ -0,0 +1,206 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace api2 {
+namespace {
+
+// Splits `tensors` along their batch dimension: item i holds batch item i of
+// every tensor, with a batch dimension of 1.
+std::vector<std::vector<Tensor>> SplitBatch(const std::vector<Tensor>& tensors,
+                                            int batch_size) {
+  std::vector<std::vector<Tensor>> items(batch_size);
+  for (auto& item : items) {
+    item.reserve(tensors.size());
+  }
+  for (const Tensor& tensor : tensors) {
+    std::vector<int> dims = tensor.shape().dims;
+    dims[0] = 1;
+    const size_t item_bytes = tensor.bytes() / batch_size;
+    auto read_view = tensor.GetCpuReadView();
+    const char* buffer = read_view.buffer<char>();
+    for (int i = 0; i < batch_size; ++i) {
+      Tensor item(tensor.element_type(), Tensor::Shape(dims),
+                  tensor.quantization_parameters());
+      auto write_view = item.GetCpuWriteView();
+      std::memcpy(write_view.buffer<char>(), buffer + i * item_bytes,
+                  item_bytes);
+      items[i].push_back(std::move(item));
+    }
+  }
+  return items;
+}
+
+}  // namespace
+
+// Begins a loop over the items of a batched inference, such as an inference on
+// the tensor that ImageToTensorCalculator builds from NORM_RECTS. Each batch
+// item is sent at its own loop-internal timestamp, like the items of a
+// BeginLoopCalculator, so that the per-item postprocessing of the unbatched
+// graph can run on it unchanged, and the results are gathered again with
+// EndLoop calculators.
+//
+// Inputs:
+//   TENSORS - std::vector<Tensor>
+//     Tensors whose first dimension is the batch dimension. All tensors must
+//     have the same batch size.
+//   NORM_RECTS - std::vector<NormalizedRect> @Optional
+//   MATRICES - std::vector<std::array<float, 16>> @Optional
+//   LETTERBOX_PADDINGS - std::vector<std::array<float, 4>> @Optional
+//     Per-item values, e.g. the ROIs and the ImageToTensorCalculator outputs
+//     of the same names. Their size must be the batch size.
+//   CLONE - Any @Multiple
+//     Loop-wide constants, cloned to every item.
+//
+// Outputs:
+//   TENSORS - std::vector<Tensor>
+//     The tensors of one batch item, each with a batch dimension of 1.
+//   NORM_RECT - NormalizedRect @Optional
+//   MATRIX - std::array<float, 16> @Optional
+//   LETTERBOX_PADDING - std::array<float, 4> @Optional
+//     The per-item values of the item.
+//   CLONE - Any @Multiple
+//     The cloned inputs, at the timestamp of every item.
+//   BATCH_END - Timestamp
+//     The input timestamp, sent along with the last item for the EndLoop
+//     calculators.
+//
+// Usage example:
+// node {
+//   calculator: "BeginTensorBatchLoopCalculator"
+//   input_stream: "TENSORS:batched_tensors"
+//   input_stream: "NORM_RECTS:rects"
+//   input_stream: "CLONE:image_size"
+//   output_stream: "TENSORS:item_tensors"
+//   output_stream: "NORM_RECT:item_rect"
+//   output_stream: "CLONE:item_image_size"
+//   output_stream: "BATCH_END:batch_end"
+// }
+class BeginTensorBatchLoopCalculator : public Node {
+ public:
+  static constexpr Input<std::vector<Tensor>> kInTensors{"TENSORS"};
+  static constexpr Input<std::vector<NormalizedRect>>::Optional kInNormRects{
+      "NORM_RECTS"};
+  static constexpr Input<std::vector<std::array<float, 16>>>::Optional
+      kInMatrices{"MATRICES"};
+  static constexpr Input<std::vector<std::array<float, 4>>>::Optional
+      kInLetterboxPaddings{"LETTERBOX_PADDINGS"};
+  static constexpr Input<AnyType>::Multiple kInClone{"CLONE"};
+
+  static constexpr Output<std::vector<Tensor>> kOutTensors{"TENSORS"};
+  static constexpr Output<NormalizedRect>::Optional kOutNormRect{"NORM_RECT"};
+  static constexpr Output<std::array<float, 16>>::Optional kOutMatrix{
+      "MATRIX"};
+  static constexpr Output<std::array<float, 4>>::Optional kOutLetterboxPadding{
+      "LETTERBOX_PADDING"};
+  static constexpr Output<AnyType>::Multiple kOutClone{"CLONE"};
+  static constexpr Output<Timestamp> kOutBatchEnd{"BATCH_END"};
+
+  MEDIAPIPE_NODE_CONTRACT(kInTensors, kInNormRects, kInMatrices,
+                          kInLetterboxPaddings, kInClone, kOutTensors,
+                          kOutNormRect, kOutMatrix, kOutLetterboxPadding,
+                          kOutClone, kOutBatchEnd,
+                          TimestampChange::Arbitrary());
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    // Like BeginLoopCalculator, processes timestamp bound updates, so that
+    // the EndLoop calculators also get a BATCH_END when there is nothing to
+    // loop over.
+    cc->SetProcessTimestampBounds(true);
+    RET_CHECK_EQ(kInClone(cc).Count(), kOutClone(cc).Count())
+        << "Number of CLONE inputs and outputs must match";
+    for (int n = 0; n < kOutClone(cc).Count(); ++n) {
+      cc->Outputs().Get("CLONE", n).SetSameAs(&cc->Inputs().Get("CLONE", n));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const Timestamp first_timestamp = loop_internal_timestamp_;
+    if (!kInTensors(cc).IsEmpty() && !kInTensors(cc)->empty()) {
+      const std::vector<Tensor>& tensors = *kInTensors(cc);
+      RET_CHECK(!tensors[0].shape().dims.empty())
+          << "Tensors must have a batch dimension";
+      const int batch_size = tensors[0].shape().dims[0];
+      for (const Tensor& tensor : tensors) {
+        RET_CHECK(!tensor.shape().dims.empty() &&
+                  tensor.shape().dims[0] == batch_size)
+            << "All tensors must have the same batch size";
+      }
+      MP_RETURN_IF_ERROR(CheckBatchSize(kInNormRects(cc), batch_size));
+      MP_RETURN_IF_ERROR(CheckBatchSize(kInMatrices(cc), batch_size));
+      MP_RETURN_IF_ERROR(CheckBatchSize(kInLetterboxPaddings(cc), batch_size));
+
+      std::vector<std::vector<Tensor>> items = SplitBatch(tensors, batch_size);
+      for (int i = 0; i < batch_size; ++i) {
+        kOutTensors(cc).Send(std::move(items[i]), loop_internal_timestamp_);
+        SendItem(kInNormRects(cc), i, kOutNormRect(cc));
+        SendItem(kInMatrices(cc), i, kOutMatrix(cc));
+        SendItem(kInLetterboxPaddings(cc), i, kOutLetterboxPadding(cc));
+        for (int n = 0; n < kInClone(cc).Count(); ++n) {
+          kOutClone(cc)[n].Send(kInClone(cc)[n].At(loop_internal_timestamp_));
+        }
+        ++loop_internal_timestamp_;
+      }
+    }
+
+    // Nothing to loop over: use up a timestamp for BATCH_END.
+    if (loop_internal_timestamp_ == first_timestamp) {
+      ++loop_internal_timestamp_;
+      for (auto it = cc->Outputs().begin(); it < cc->Outputs().end(); ++it) {
+        it->SetNextTimestampBound(loop_internal_timestamp_);
+      }
+    }
+
+    kOutBatchEnd(cc).Send(cc->InputTimestamp(), loop_internal_timestamp_ - 1);
+    return absl::OkStatus();
+  }
+
+ private:
+  template <typename InputT>
+  static absl::Status CheckBatchSize(const InputT& input, int batch_size) {
+    if (input.IsEmpty()) return absl::OkStatus();
+    RET_CHECK_EQ(input->size(), batch_size)
+        << "Per-item inputs must have one value per batch item";
+    return absl::OkStatus();
+  }
+
+  template <typename InputT, typename OutputT>
+  void SendItem(const InputT& input, int index, OutputT&& output) {
+    if (input.IsEmpty()) return;
+    output.Send((*input)[index], loop_internal_timestamp_);
+  }
+
+  // Fake timestamps generated per batch item.
+  Timestamp loop_internal_timestamp_ = Timestamp(0);
+};
+
+MEDIAPIPE_REGISTER_NODE(BeginTensorBatchLoopCalculator);
+
+}  // namespace api2
+}  // namespace mediapipe
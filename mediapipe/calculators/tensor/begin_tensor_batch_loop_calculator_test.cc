@@ -0,0 +1,163 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::ParseTextProtoOrDie;
+using ::testing::ElementsAre;
+
+using Node = CalculatorGraphConfig::Node;
+
+Tensor MakeTensor(const std::vector<int>& dims,
+                  const std::vector<float>& values) {
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape(dims));
+  auto view = tensor.GetCpuWriteView();
+  std::copy(values.begin(), values.end(), view.buffer<float>());
+  return tensor;
+}
+
+std::vector<float> TensorValues(const Tensor& tensor) {
+  auto view = tensor.GetCpuReadView();
+  const float* buffer = view.buffer<float>();
+  return std::vector<float>(buffer, buffer + tensor.shape().num_elements());
+}
+
+TEST(BeginTensorBatchLoopCalculatorTest, SplitsBatchIntoLoopItems) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "BeginTensorBatchLoopCalculator"
+    input_stream: "TENSORS:tensors"
+    input_stream: "NORM_RECTS:rects"
+    input_stream: "CLONE:extra"
+    output_stream: "TENSORS:item_tensors"
+    output_stream: "NORM_RECT:item_rect"
+    output_stream: "CLONE:item_extra"
+    output_stream: "BATCH_END:batch_end"
+  )pb"));
+
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->push_back(MakeTensor({2, 3}, {1, 2, 3, 4, 5, 6}));
+  tensors->push_back(MakeTensor({2, 1}, {7, 8}));
+  std::vector<NormalizedRect> rects(2);
+  rects[0].set_x_center(0.25f);
+  rects[1].set_x_center(0.75f);
+  runner.MutableInputs()->Tag("TENSORS").packets.push_back(
+      Adopt(tensors.release()).At(Timestamp(10)));
+  runner.MutableInputs()->Tag("NORM_RECTS").packets.push_back(
+      MakePacket<std::vector<NormalizedRect>>(rects).At(Timestamp(10)));
+  runner.MutableInputs()->Tag("CLONE").packets.push_back(
+      MakePacket<int>(42).At(Timestamp(10)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& item_tensors = runner.Outputs().Tag("TENSORS").packets;
+  ASSERT_EQ(item_tensors.size(), 2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(item_tensors[i].Timestamp(), Timestamp(i));
+    const auto& item = item_tensors[i].Get<std::vector<Tensor>>();
+    ASSERT_EQ(item.size(), 2);
+    EXPECT_THAT(item[0].shape().dims, ElementsAre(1, 3));
+    EXPECT_THAT(item[1].shape().dims, ElementsAre(1, 1));
+  }
+  EXPECT_THAT(TensorValues(item_tensors[0].Get<std::vector<Tensor>>()[0]),
+              ElementsAre(1, 2, 3));
+  EXPECT_THAT(TensorValues(item_tensors[1].Get<std::vector<Tensor>>()[0]),
+              ElementsAre(4, 5, 6));
+  EXPECT_THAT(TensorValues(item_tensors[1].Get<std::vector<Tensor>>()[1]),
+              ElementsAre(8));
+
+  const auto& item_rects = runner.Outputs().Tag("NORM_RECT").packets;
+  ASSERT_EQ(item_rects.size(), 2);
+  EXPECT_FLOAT_EQ(item_rects[1].Get<NormalizedRect>().x_center(), 0.75f);
+  EXPECT_EQ(item_rects[1].Timestamp(), Timestamp(1));
+
+  const auto& item_extra = runner.Outputs().Tag("CLONE").packets;
+  ASSERT_EQ(item_extra.size(), 2);
+  EXPECT_EQ(item_extra[1].Get<int>(), 42);
+
+  const auto& batch_end = runner.Outputs().Tag("BATCH_END").packets;
+  ASSERT_EQ(batch_end.size(), 1);
+  EXPECT_EQ(batch_end[0].Timestamp(), Timestamp(1));
+  EXPECT_EQ(batch_end[0].Get<Timestamp>(), Timestamp(10));
+}
+
+TEST(BeginTensorBatchLoopCalculatorTest, SendsBatchEndWithoutTensors) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "tensors"
+        input_stream: "rects"
+        node {
+          calculator: "BeginTensorBatchLoopCalculator"
+          input_stream: "TENSORS:tensors"
+          input_stream: "NORM_RECTS:rects"
+          output_stream: "TENSORS:item_tensors"
+          output_stream: "BATCH_END:batch_end"
+        }
+      )pb");
+  std::vector<Packet> item_tensors;
+  std::vector<Packet> batch_end;
+  tool::AddVectorSink("item_tensors", &config, &item_tensors);
+  tool::AddVectorSink("batch_end", &config, &batch_end);
+
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "rects",
+      MakePacket<std::vector<NormalizedRect>>().At(Timestamp(10))));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "tensors", MakePacket<std::vector<Tensor>>().At(Timestamp(10))));
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  EXPECT_TRUE(item_tensors.empty());
+  ASSERT_EQ(batch_end.size(), 1);
+  EXPECT_EQ(batch_end[0].Timestamp(), Timestamp(0));
+  EXPECT_EQ(batch_end[0].Get<Timestamp>(), Timestamp(10));
+}
+
+TEST(BeginTensorBatchLoopCalculatorTest, FailsOnMismatchedPerItemInputs) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "BeginTensorBatchLoopCalculator"
+    input_stream: "TENSORS:tensors"
+    input_stream: "NORM_RECTS:rects"
+    output_stream: "TENSORS:item_tensors"
+    output_stream: "BATCH_END:batch_end"
+  )pb"));
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->push_back(MakeTensor({2, 1}, {1, 2}));
+  runner.MutableInputs()->Tag("TENSORS").packets.push_back(
+      Adopt(tensors.release()).At(Timestamp(0)));
+  runner.MutableInputs()->Tag("NORM_RECTS").packets.push_back(
+      MakePacket<std::vector<NormalizedRect>>(3).At(Timestamp(0)));
+  EXPECT_FALSE(runner.Run().ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
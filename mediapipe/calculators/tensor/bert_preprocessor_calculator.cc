@@ -25,6 +25,7 @@
 #include "absl/strings/ascii.h"
 #include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/bert_preprocessor_calculator.pb.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/port.h"
@@ -35,6 +36,7 @@
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/tasks/cc/core/utils.h"
 #include "mediapipe/tasks/cc/metadata/metadata_extractor.h"
+#include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer_utils.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
@@ -92,7 +94,9 @@ constexpr absl::string_view kSeparatorToken = "[SEP]";
 //       (3): the input mask ids, which are 1 at each of the input token indices
 //            and 0 elsewhere.
 //     The Tensors will have size equal to the max sequence length for the BERT
-//     model.
+//     model. If the input tensors are dynamic, they have the size of the input
+//     tokens instead, rounded up to the smallest of `seq_len_buckets` that
+//     fits them if any are given.
 //
 // Example:
 // node {
@@ -121,6 +125,11 @@ class BertPreprocessorCalculator : public Node {
 
  private:
   std::unique_ptr<tasks::text::tokenizers::Tokenizer> tokenizer_;
+  // Set if `tokenizer_` is a BertTokenizer, which can tokenize straight into
+  // the input tensors.
+  const tasks::text::tokenizers::BertTokenizer* bert_tokenizer_ = nullptr;
+  int classifier_token_id_ = 0;
+  int separator_token_id_ = 0;
   // The max sequence length accepted by the BERT model if its input tensors
   // are static.
   int bert_max_seq_len_ = 2;
@@ -131,6 +140,8 @@ class BertPreprocessorCalculator : public Node {
   int input_masks_tensor_index_ = 2;
   // Whether the model's input tensor shapes are dynamic.
   bool has_dynamic_input_tensors_ = false;
+  // Sorted sequence lengths that dynamic input tensors are padded to.
+  std::vector<int> seq_len_buckets_;
 
   // Applies `tokenizer_` to the `input_text` to generate a vector of tokens.
   // This util prepends "[CLS]" and appends "[SEP]" to the input tokens and
@@ -141,6 +152,9 @@ class BertPreprocessorCalculator : public Node {
   // `tensor_size` for the BERT model.
   std::vector<Tensor> GenerateInputTensors(
       const std::vector<std::string>& input_tokens, int tensor_size);
+  // Tokenizes `input_text` with `bert_tokenizer_` directly into the three
+  // static input tensors, without intermediate token strings or id vectors.
+  std::vector<Tensor> TokenizeIntoInputTensors(absl::string_view input_text);
 
   // Enable pooling of AHWBs in Tensor instances.
   MemoryManager* memory_manager_ = nullptr;
@@ -151,6 +165,9 @@ absl::Status BertPreprocessorCalculator::UpdateContract(
   const auto& options =
       cc->Options<mediapipe::BertPreprocessorCalculatorOptions>();
   if (options.has_dynamic_input_tensors()) {
+    for (int bucket : options.seq_len_buckets()) {
+      RET_CHECK_GE(bucket, 2) << "seq_len_buckets must be at least 2";
+    }
     return absl::OkStatus();
   } else {
     RET_CHECK(options.has_bert_max_seq_len()) << "bert_max_seq_len is required";
@@ -172,6 +189,13 @@ absl::Status BertPreprocessorCalculator::Open(CalculatorContext* cc) {
   MP_ASSIGN_OR_RETURN(tokenizer_,
                       tasks::text::tokenizers::CreateTokenizerFromProcessUnit(
                           tokenizer_metadata, metadata_extractor));
+  bert_tokenizer_ =
+      dynamic_cast<const tasks::text::tokenizers::BertTokenizer*>(
+          tokenizer_.get());
+  if (bert_tokenizer_ != nullptr) {
+    tokenizer_->LookupId(kClassifierToken, &classifier_token_id_);
+    tokenizer_->LookupId(kSeparatorToken, &separator_token_id_);
+  }
 
   auto* input_tensors_metadata = metadata_extractor->GetInputTensorMetadata();
   input_ids_tensor_index_ = FindTensorIndexByMetadataName(
@@ -194,14 +218,24 @@ absl::Status BertPreprocessorCalculator::Open(CalculatorContext* cc) {
       cc->Options<mediapipe::BertPreprocessorCalculatorOptions>();
   bert_max_seq_len_ = options.bert_max_seq_len();
   has_dynamic_input_tensors_ = options.has_dynamic_input_tensors();
+  seq_len_buckets_.assign(options.seq_len_buckets().begin(),
+                          options.seq_len_buckets().end());
+  std::sort(seq_len_buckets_.begin(), seq_len_buckets_.end());
   return absl::OkStatus();
 }
 
 absl::Status BertPreprocessorCalculator::Process(CalculatorContext* cc) {
+  if (bert_tokenizer_ != nullptr && !has_dynamic_input_tensors_) {
+    kTensorsOut(cc).Send(TokenizeIntoInputTensors(kTextIn(cc).Get()));
+    return absl::OkStatus();
+  }
   int tensor_size = bert_max_seq_len_;
   std::vector<std::string> input_tokens = TokenizeInputText(kTextIn(cc).Get());
   if (has_dynamic_input_tensors_) {
     tensor_size = input_tokens.size();
+    auto bucket = std::lower_bound(seq_len_buckets_.begin(),
+                                   seq_len_buckets_.end(), tensor_size);
+    if (bucket != seq_len_buckets_.end()) tensor_size = *bucket;
   }
   kTensorsOut(cc).Send(GenerateInputTensors(input_tokens, tensor_size));
   return absl::OkStatus();
@@ -270,6 +304,33 @@ std::vector<Tensor> BertPreprocessorCalculator::GenerateInputTensors(
   return input_tensors;
 }
 
+std::vector<Tensor> BertPreprocessorCalculator::TokenizeIntoInputTensors(
+    absl::string_view input_text) {
+  std::string processed_input = std::string(input_text);
+  absl::AsciiStrToLower(&processed_input);
+
+  std::vector<Tensor> input_tensors;
+  input_tensors.reserve(kNumInputTensorsForBert);
+  for (int i = 0; i < kNumInputTensorsForBert; ++i) {
+    input_tensors.push_back({Tensor::ElementType::kInt32,
+                             Tensor::Shape({1, bert_max_seq_len_}),
+                             memory_manager_});
+  }
+  {
+    auto ids_view = input_tensors[input_ids_tensor_index_].GetCpuWriteView();
+    auto segment_ids_view =
+        input_tensors[segment_ids_tensor_index_].GetCpuWriteView();
+    auto masks_view =
+        input_tensors[input_masks_tensor_index_].GetCpuWriteView();
+    const absl::string_view input = processed_input;
+    bert_tokenizer_->TokenizeBatch(
+        absl::MakeConstSpan(&input, 1), classifier_token_id_,
+        separator_token_id_, bert_max_seq_len_, ids_view.buffer<int32_t>(),
+        segment_ids_view.buffer<int32_t>(), masks_view.buffer<int32_t>());
+  }
+  return input_tensors;
+}
+
 MEDIAPIPE_REGISTER_NODE(BertPreprocessorCalculator);
 
 }  // namespace api2
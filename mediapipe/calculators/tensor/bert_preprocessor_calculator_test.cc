@@ -44,7 +44,8 @@ constexpr absl::string_view kTestModelPath =
 
 absl::StatusOr<std::vector<std::vector<int>>> RunBertPreprocessorCalculator(
     absl::string_view text, absl::string_view model_path,
-    bool has_dynamic_input_tensors = false, int tensor_size = kBertMaxSeqLen) {
+    bool has_dynamic_input_tensors = false, int tensor_size = kBertMaxSeqLen,
+    absl::string_view seq_len_buckets = "") {
   auto graph_config = ParseTextProtoOrDie<CalculatorGraphConfig>(
       absl::Substitute(R"(
         input_stream: "text"
@@ -58,11 +59,13 @@ absl::StatusOr<std::vector<std::vector<int>>> RunBertPreprocessorCalculator(
             [mediapipe.BertPreprocessorCalculatorOptions.ext] {
               bert_max_seq_len: $0
               has_dynamic_input_tensors: $1
+              $2
             }
           }
         }
       )",
-                       tensor_size, has_dynamic_input_tensors));
+                       tensor_size, has_dynamic_input_tensors,
+                       seq_len_buckets));
   std::vector<Packet> output_packets;
   tool::AddVectorSink("tensors", &graph_config, &output_packets);
 
@@ -100,6 +103,11 @@ absl::StatusOr<std::vector<std::vector<int>>> RunBertPreprocessorCalculator(
     if (tensor.element_type() != Tensor::ElementType::kInt32) {
       return absl::InvalidArgumentError("Expected tensor element type kInt32");
     }
+    if (tensor.shape().num_elements() != tensor_size) {
+      return absl::InvalidArgumentError(
+          absl::Substitute("tensor has $0 elements, expected $1",
+                           tensor.shape().num_elements(), tensor_size));
+    }
     auto* buffer = tensor.GetCpuReadView().buffer<int>();
     std::vector<int> buffer_view(buffer, buffer + tensor_size);
     results.push_back(buffer_view);
@@ -127,6 +135,43 @@ TEST(BertPreprocessorCalculatorTest, TextClassifierWithBertModel) {
   EXPECT_THAT(processed_tensor_values, ElementsAreArray(expected_result));
 }
 
+TEST(BertPreprocessorCalculatorTest, DynamicInputPaddedToSmallestBucket) {
+  constexpr int kBucket = 16;
+  std::vector<std::vector<int>> expected_result = {
+      {101, 2009, 1005, 1055, 1037, 11951, 1998, 2411, 12473, 4990, 102}};
+  // segment_ids
+  expected_result.push_back(std::vector(kBucket, 0));
+  // input_masks
+  expected_result.push_back(std::vector(expected_result[0].size(), 1));
+  expected_result[2].resize(kBucket);
+  // padding input_ids
+  expected_result[0].resize(kBucket);
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::vector<int>> processed_tensor_values,
+      RunBertPreprocessorCalculator(
+          "it's a charming and often affecting journey", kTestModelPath,
+          /*has_dynamic_input_tensors=*/true, kBucket,
+          "seq_len_buckets: 64 seq_len_buckets: 8 seq_len_buckets: 16"));
+  EXPECT_THAT(processed_tensor_values, ElementsAreArray(expected_result));
+}
+
+TEST(BertPreprocessorCalculatorTest, DynamicInputLongerThanAllBuckets) {
+  std::vector<std::vector<int>> expected_result = {
+      {101, 2009, 1005, 1055, 1037, 11951, 1998, 2411, 12473, 4990, 102}};
+  const int num_tokens = expected_result[0].size();
+  expected_result.push_back(std::vector(num_tokens, 0));
+  expected_result.push_back(std::vector(num_tokens, 1));
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::vector<int>> processed_tensor_values,
+      RunBertPreprocessorCalculator(
+          "it's a charming and often affecting journey", kTestModelPath,
+          /*has_dynamic_input_tensors=*/true, num_tokens,
+          "seq_len_buckets: 4 seq_len_buckets: 8"));
+  EXPECT_THAT(processed_tensor_values, ElementsAreArray(expected_result));
+}
+
 TEST(BertPreprocessorCalculatorTest, LongInput) {
   std::stringstream long_input;
   long_input
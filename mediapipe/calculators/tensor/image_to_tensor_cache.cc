@@ -0,0 +1,101 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/calculators/tensor/image_to_tensor_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/gpu/gpu_buffer_storage_image_frame.h"
+
+namespace mediapipe {
+namespace {
+
+// Returns the CPU pixel data of `image` if it already has any, without
+// transferring it from the GPU.
+const uint8_t* GetCpuPixelData(const Image& image) {
+  auto storage = image.GetGpuBuffer(/*upload_to_gpu=*/false)
+                     .internal_storage<GpuBufferStorageImageFrame>();
+  return storage ? storage->image_frame()->PixelData() : nullptr;
+}
+
+bool IsSameRoi(const RotatedRect& a, const RotatedRect& b) {
+  return a.center_x == b.center_x && a.center_y == b.center_y &&
+         a.width == b.width && a.height == b.height &&
+         a.rotation == b.rotation;
+}
+
+bool KeysMatch(const ImageToTensorCacheKey& a, const ImageToTensorCacheKey& b) {
+  return a.element_type == b.element_type && a.dims == b.dims &&
+         a.range_min == b.range_min && a.range_max == b.range_max &&
+         a.border_mode == b.border_mode &&
+         a.uses_gpu == b.uses_gpu && a.gpu_origin == b.gpu_origin &&
+         a.single_tensor == b.single_tensor &&
+         std::equal(a.rois.begin(), a.rois.end(), b.rois.begin(),
+                    b.rois.end(), IsSameRoi) &&
+         IsSameImageContent(a.image, b.image);
+}
+
+}  // namespace
+
+bool IsSameImageContent(const Image& a, const Image& b) {
+  if (a == b) return true;
+  if (a.width() != b.width() || a.height() != b.height() ||
+      a.format() != b.format()) {
+    return false;
+  }
+  const uint8_t* a_pixels = GetCpuPixelData(a);
+  return a_pixels != nullptr && a_pixels == GetCpuPixelData(b) &&
+         a.step() == b.step();
+}
+
+Packet ImageToTensorCache::Lookup(const ImageToTensorCacheKey& key) {
+  absl::MutexLock lock(&mutex_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (KeysMatch(it->key, key)) {
+      entries_.splice(entries_.begin(), entries_, it);
+      return it->tensors;
+    }
+  }
+  return Packet();
+}
+
+void ImageToTensorCache::Insert(ImageToTensorCacheKey key, Packet tensors) {
+  absl::MutexLock lock(&mutex_);
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (KeysMatch(it->key, key)) {
+      entries_.erase(it);
+      break;
+    }
+  }
+  entries_.push_front({std::move(key), std::move(tensors)});
+  while (entries_.size() > static_cast<size_t>(options_.max_entries)) {
+    entries_.pop_back();
+  }
+}
+
+int ImageToTensorCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+}  // namespace mediapipe
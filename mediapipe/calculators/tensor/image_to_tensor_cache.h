@@ -0,0 +1,110 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CACHE_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CACHE_H_
+
+#include <list>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/graph_service.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/gpu/gpu_origin.pb.h"
+
+namespace mediapipe {
+
+// Describes one image-to-tensor conversion. Two conversions with equal keys
+// produce identical tensors.
+struct ImageToTensorCacheKey {
+  // The converted image. Images match if they are the same Image or if they
+  // share their CPU pixel data, as the copies ImageCloneCalculator makes for
+  // each task do.
+  Image image;
+  std::vector<RotatedRect> rois;
+  Tensor::ElementType element_type = Tensor::ElementType::kNone;
+  std::vector<int> dims;
+  float range_min = 0.0f;
+  float range_max = 0.0f;
+  BorderMode border_mode = BorderMode::kZero;
+  // Whether the image is converted on GPU, and the origin it has there.
+  bool uses_gpu = false;
+  GpuOrigin::Mode gpu_origin = GpuOrigin::DEFAULT;
+  // Whether the tensors were sent as a single Tensor or as a vector.
+  bool single_tensor = false;
+};
+
+// Returns true if `a` and `b` refer to the same pixel data.
+bool IsSameImageContent(const Image& a, const Image& b);
+
+// Shares the tensors converted from an image among the ImageToTensorCalculators
+// of several graphs, e.g. tasks running different models on the same camera
+// frame with the same input size and normalization.
+//
+// The cache holds the most recently used conversions, together with a
+// reference to their images so that the pixel data of an entry cannot be
+// reused for a different image while the entry exists. Cached tensors are
+// shared, not copied, and must not be modified. Graphs that convert on GPU
+// must share their GpuResources to share a cache.
+//
+// The cache is shared by setting the same instance as the
+// kImageToTensorCacheService object of every graph.
+class ImageToTensorCache {
+ public:
+  struct Options {
+    // The maximum number of conversions held by the cache. The least recently
+    // used conversion is evicted when a new one is inserted beyond this limit.
+    int max_entries = 8;
+  };
+
+  ImageToTensorCache() : ImageToTensorCache(Options()) {}
+  explicit ImageToTensorCache(const Options& options) : options_(options) {}
+
+  // Returns the packet holding the tensors of a conversion equal to `key`, or
+  // an empty packet if there is none.
+  Packet Lookup(const ImageToTensorCacheKey& key);
+
+  // Stores `tensors`, a packet holding the result of the conversion described
+  // by `key`.
+  void Insert(ImageToTensorCacheKey key, Packet tensors);
+
+  // Returns the number of conversions held by the cache.
+  int size() const;
+
+ private:
+  struct Entry {
+    ImageToTensorCacheKey key;
+    Packet tensors;
+  };
+
+  const Options options_;
+  mutable absl::Mutex mutex_;
+  // Ordered from the most to the least recently used.
+  std::list<Entry> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Graph service for an ImageToTensorCache shared among graphs. If the service
+// object is set, ImageToTensorCalculator reuses the tensors converted by other
+// graphs from the same image.
+inline constexpr GraphService<ImageToTensorCache> kImageToTensorCacheService(
+    "mediapipe::ImageToTensorCacheService");
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_IMAGE_TO_TENSOR_CACHE_H_
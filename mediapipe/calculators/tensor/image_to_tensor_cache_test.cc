@@ -0,0 +1,120 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/calculators/tensor/image_to_tensor_cache.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+Image CreateImage() {
+  return Image(std::make_shared<ImageFrame>(ImageFormat::SRGB, /*width=*/8,
+                                            /*height=*/4));
+}
+
+ImageToTensorCacheKey CreateKey(const Image& image) {
+  ImageToTensorCacheKey key;
+  key.image = image;
+  key.rois = {{/*center_x=*/4.0f, /*center_y=*/2.0f, /*width=*/8.0f,
+               /*height=*/4.0f, /*rotation=*/0.0f}};
+  key.element_type = Tensor::ElementType::kFloat32;
+  key.dims = {1, 2, 2, 3};
+  key.range_min = 0.0f;
+  key.range_max = 1.0f;
+  return key;
+}
+
+Packet CreateTensors() {
+  return MakePacket<Tensor>(Tensor::ElementType::kFloat32,
+                            Tensor::Shape({1, 2, 2, 3}));
+}
+
+TEST(ImageToTensorCacheTest, ReturnsTensorsOfSameConversion) {
+  ImageToTensorCache cache;
+  Image image = CreateImage();
+  Packet tensors = CreateTensors();
+  cache.Insert(CreateKey(image), tensors);
+
+  Packet cached = cache.Lookup(CreateKey(image));
+  ASSERT_FALSE(cached.IsEmpty());
+  EXPECT_EQ(&cached.Get<Tensor>(), &tensors.Get<Tensor>());
+}
+
+TEST(ImageToTensorCacheTest, MatchesImagesSharingPixelData) {
+  ImageToTensorCache cache;
+  Image image = CreateImage();
+  const ImageFrame& frame = *image.GetImageFrameSharedPtr();
+  // A copy such as the ones ImageCloneCalculator creates for each task.
+  Image clone(std::make_shared<ImageFrame>(
+      frame.Format(), frame.Width(), frame.Height(), frame.WidthStep(),
+      const_cast<uint8_t*>(frame.PixelData()), [](uint8_t*) {}));
+  ASSERT_NE(image, clone);
+  cache.Insert(CreateKey(image), CreateTensors());
+
+  EXPECT_FALSE(cache.Lookup(CreateKey(clone)).IsEmpty());
+  EXPECT_TRUE(cache.Lookup(CreateKey(CreateImage())).IsEmpty());
+}
+
+TEST(ImageToTensorCacheTest, DoesNotMatchDifferentConversions) {
+  ImageToTensorCache cache;
+  Image image = CreateImage();
+  cache.Insert(CreateKey(image), CreateTensors());
+
+  ImageToTensorCacheKey other_roi = CreateKey(image);
+  other_roi.rois[0].rotation = 1.0f;
+  EXPECT_TRUE(cache.Lookup(other_roi).IsEmpty());
+
+  ImageToTensorCacheKey other_shape = CreateKey(image);
+  other_shape.dims = {1, 4, 4, 3};
+  EXPECT_TRUE(cache.Lookup(other_shape).IsEmpty());
+
+  ImageToTensorCacheKey other_range = CreateKey(image);
+  other_range.range_min = -1.0f;
+  EXPECT_TRUE(cache.Lookup(other_range).IsEmpty());
+
+  ImageToTensorCacheKey other_output = CreateKey(image);
+  other_output.single_tensor = true;
+  EXPECT_TRUE(cache.Lookup(other_output).IsEmpty());
+}
+
+TEST(ImageToTensorCacheTest, EvictsLeastRecentlyUsedConversion) {
+  ImageToTensorCache cache({/*max_entries=*/2});
+  Image image1 = CreateImage();
+  Image image2 = CreateImage();
+  Image image3 = CreateImage();
+  cache.Insert(CreateKey(image1), CreateTensors());
+  cache.Insert(CreateKey(image2), CreateTensors());
+  // Makes image1 the most recently used conversion.
+  EXPECT_FALSE(cache.Lookup(CreateKey(image1)).IsEmpty());
+
+  cache.Insert(CreateKey(image3), CreateTensors());
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_FALSE(cache.Lookup(CreateKey(image1)).IsEmpty());
+  EXPECT_TRUE(cache.Lookup(CreateKey(image2)).IsEmpty());
+  EXPECT_FALSE(cache.Lookup(CreateKey(image3)).IsEmpty());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/log/absl_log.h"
+#include "mediapipe/calculators/tensor/image_to_tensor_cache.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_calculator.pb.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_converter.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_utils.h"
@@ -29,6 +30,8 @@
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/formats/tensor_pool.h"
+#include "mediapipe/framework/formats/tensor_pool_service.h"
 #include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/memory_manager_service.h"
 #include "mediapipe/framework/port.h"
@@ -92,9 +95,23 @@ namespace api2 {
 //     Describes region of image to extract.
 //     @Optional: rect covering the whole image is used if not specified.
 //
+//   NORM_RECTS - std::vector<NormalizedRect> @Optional
+//     Describes multiple regions of image to extract. All regions are written
+//     into a single tensor whose batch dimension equals the number of rects.
+//     Cannot be used together with NORM_RECT. Nothing is output (only the
+//     timestamp bound is updated) when the vector is empty. The tensor shape
+//     is marked dynamic, so that InferenceCalculator resizes the model input
+//     to the number of rects.
+//
 // Outputs:
 //   TENSORS - std::vector<Tensor>
 //     Vector containing a single Tensor populated with an extracted RGB image.
+//     If the graph provides an ImageToTensorCacheService, tensors that another
+//     graph converted from the same image with the same parameters are sent
+//     instead of converting the image again.
+//   TENSOR - Tensor
+//     Alternative to TENSORS holding the same tensor. It is recycled from the
+//     TensorPoolService when the graph provides one.
 //   MATRIX - std::array<float, 16> @Optional
 //     An std::array<float, 16> representing a 4x4 row-major-order matrix that
 //     maps a point on the input image to a point on the output tensor, and
@@ -111,6 +128,14 @@ namespace api2 {
 //     20x20 and places it in the middle of the output image with an equal
 //     padding of 10 pixels at the top and the bottom. The resulting array is
 //     therefore [0.f, 0.25f, 0.f, 0.25f] (10/40 = 0.25f).
+//   MATRICES - std::vector<std::array<float, 16>> @Optional
+//   LETTERBOX_PADDINGS - std::vector<std::array<float, 4>> @Optional
+//     Per-rect MATRIX and LETTERBOX_PADDING, in the order of NORM_RECTS. Only
+//     supported with NORM_RECTS.
+//
+//   Note: batched extraction (NORM_RECTS) requires a converter that can write
+//   at a non-zero tensor buffer offset, i.e. the OpenCV, OpenGL ES 3.1+ buffer
+//   or Metal converters.
 //
 // Example:
 // node {
@@ -139,14 +164,21 @@ class ImageToTensorCalculator : public Node {
   static constexpr Input<GpuBuffer>::Optional kInGpu{"IMAGE_GPU"};
   static constexpr Input<mediapipe::NormalizedRect>::Optional kInNormRect{
       "NORM_RECT"};
+  static constexpr Input<std::vector<mediapipe::NormalizedRect>>::Optional
+      kInNormRects{"NORM_RECTS"};
   static constexpr Output<std::vector<Tensor>>::Optional kOutTensors{"TENSORS"};
   static constexpr Output<Tensor>::Optional kOutTensor{"TENSOR"};
   static constexpr Output<std::array<float, 4>>::Optional kOutLetterboxPadding{
       "LETTERBOX_PADDING"};
   static constexpr Output<std::array<float, 16>>::Optional kOutMatrix{"MATRIX"};
+  static constexpr Output<std::vector<std::array<float, 4>>>::Optional
+      kOutLetterboxPaddings{"LETTERBOX_PADDINGS"};
+  static constexpr Output<std::vector<std::array<float, 16>>>::Optional
+      kOutMatrices{"MATRICES"};
 
-  MEDIAPIPE_NODE_CONTRACT(kIn, kInGpu, kInNormRect, kOutTensors, kOutTensor,
-                          kOutLetterboxPadding, kOutMatrix);
+  MEDIAPIPE_NODE_CONTRACT(kIn, kInGpu, kInNormRect, kInNormRects, kOutTensors,
+                          kOutTensor, kOutLetterboxPadding, kOutMatrix,
+                          kOutLetterboxPaddings, kOutMatrices);
 
   static absl::Status UpdateContract(CalculatorContract* cc) {
     const auto& options =
@@ -157,6 +189,19 @@ class ImageToTensorCalculator : public Node {
         << "One and only one of IMAGE and IMAGE_GPU input is expected.";
     RET_CHECK(kOutTensors(cc).IsConnected() ^ kOutTensor(cc).IsConnected())
         << "One and only one of TENSORS and TENSOR output is supported.";
+    RET_CHECK(!(kInNormRect(cc).IsConnected() &&
+                kInNormRects(cc).IsConnected()))
+        << "At most one of NORM_RECT and NORM_RECTS input is supported.";
+    if (kInNormRects(cc).IsConnected()) {
+      RET_CHECK(!kOutLetterboxPadding(cc).IsConnected() &&
+                !kOutMatrix(cc).IsConnected())
+          << "LETTERBOX_PADDING and MATRIX are not supported with NORM_RECTS, "
+             "use LETTERBOX_PADDINGS and MATRICES instead.";
+    } else {
+      RET_CHECK(!kOutLetterboxPaddings(cc).IsConnected() &&
+                !kOutMatrices(cc).IsConnected())
+          << "LETTERBOX_PADDINGS and MATRICES require NORM_RECTS input.";
+    }
 
 #if MEDIAPIPE_DISABLE_GPU
     if (kInGpu(cc).IsConnected()) {
@@ -175,6 +220,8 @@ class ImageToTensorCalculator : public Node {
 #endif  // MEDIAPIPE_DISABLE_GPU
 
     cc->UseService(kMemoryManagerService).Optional();
+    cc->UseService(kTensorPoolService).Optional();
+    cc->UseService(kImageToTensorCacheService).Optional();
     return absl::OkStatus();
   }
 
@@ -182,6 +229,15 @@ class ImageToTensorCalculator : public Node {
     if (cc->Service(kMemoryManagerService).IsAvailable()) {
       memory_manager_ = &cc->Service(kMemoryManagerService).GetObject();
     }
+    // Pooled tensors can only be sent on their own, so the pool is not used
+    // for the TENSORS output.
+    if (kOutTensor(cc).IsConnected() &&
+        cc->Service(kTensorPoolService).IsAvailable()) {
+      tensor_pool_ = &cc->Service(kTensorPoolService).GetObject();
+    }
+    if (cc->Service(kImageToTensorCacheService).IsAvailable()) {
+      cache_ = &cc->Service(kImageToTensorCacheService).GetObject();
+    }
     options_ = cc->Options<mediapipe::ImageToTensorCalculatorOptions>();
     params_ = GetOutputTensorParams(options_);
     return absl::OkStatus();
@@ -194,14 +250,22 @@ class ImageToTensorCalculator : public Node {
       return absl::OkStatus();
     }
 
-    absl::optional<mediapipe::NormalizedRect> norm_rect;
-    if (kInNormRect(cc).IsConnected()) {
+    std::vector<absl::optional<mediapipe::NormalizedRect>> norm_rects;
+    if (kInNormRects(cc).IsConnected()) {
+      if (kInNormRects(cc).IsEmpty() || kInNormRects(cc)->empty()) {
+        // Timestamp bound update happens automatically. (See Open().)
+        return absl::OkStatus();
+      }
+      for (const auto& rect : *kInNormRects(cc)) {
+        norm_rects.push_back(rect);
+      }
+    } else if (kInNormRect(cc).IsConnected()) {
       if (kInNormRect(cc).IsEmpty()) {
         // Timestamp bound update happens automatically. (See Open().)
         return absl::OkStatus();
       }
-      norm_rect = *kInNormRect(cc);
-      if (norm_rect->width() == 0 && norm_rect->height() == 0) {
+      const auto& norm_rect = *kInNormRect(cc);
+      if (norm_rect.width() == 0 && norm_rect.height() == 0) {
         // WORKAROUND: some existing graphs may use sentinel rects {width=0,
         // height=0, ...} quite often and calculator has to handle them
         // gracefully by updating timestamp bound instead of returning failure.
@@ -211,6 +275,9 @@ class ImageToTensorCalculator : public Node {
             << "Updating timestamp bound in response to a sentinel rect";
         return absl::OkStatus();
       }
+      norm_rects.push_back(norm_rect);
+    } else {
+      norm_rects.push_back(absl::nullopt);
     }
 
 #if MEDIAPIPE_DISABLE_GPU
@@ -221,48 +288,141 @@ class ImageToTensorCalculator : public Node {
                                                  : GetInputImage(kIn(cc)));
 #endif  // MEDIAPIPE_DISABLE_GPU
 
-    RotatedRect roi = GetRoi(image->width(), image->height(), norm_rect);
     const int tensor_width = params_.output_width.value_or(image->width());
     const int tensor_height = params_.output_height.value_or(image->height());
-    MP_ASSIGN_OR_RETURN(auto padding,
-                        PadRoi(tensor_width, tensor_height,
-                               options_.keep_aspect_ratio(), &roi));
-    if (kOutLetterboxPadding(cc).IsConnected()) {
-      kOutLetterboxPadding(cc).Send(padding);
-    }
-    if (kOutMatrix(cc).IsConnected()) {
+    const int num_channels = GetNumOutputChannels(*image);
+    const int batch_size = norm_rects.size();
+
+    std::vector<RotatedRect> rois;
+    std::vector<std::array<float, 4>> paddings;
+    std::vector<std::array<float, 16>> matrices;
+    rois.reserve(batch_size);
+    paddings.reserve(batch_size);
+    matrices.reserve(batch_size);
+    for (const auto& norm_rect : norm_rects) {
+      RotatedRect roi = GetRoi(image->width(), image->height(), norm_rect);
+      MP_ASSIGN_OR_RETURN(auto padding,
+                          PadRoi(tensor_width, tensor_height,
+                                 options_.keep_aspect_ratio(), &roi));
       std::array<float, 16> matrix;
       GetRotatedSubRectToRectTransformMatrix(
           roi, image->width(), image->height(),
           /*flip_horizontally=*/false, &matrix);
-      kOutMatrix(cc).Send(std::move(matrix));
+      rois.push_back(roi);
+      paddings.push_back(padding);
+      matrices.push_back(matrix);
     }
 
-    // Lazy initialization of the GPU or CPU converter.
-    MP_RETURN_IF_ERROR(InitConverterIfNecessary(cc, *image.get()));
+    if (kOutLetterboxPadding(cc).IsConnected()) {
+      kOutLetterboxPadding(cc).Send(paddings[0]);
+    }
+    if (kOutMatrix(cc).IsConnected()) {
+      kOutMatrix(cc).Send(matrices[0]);
+    }
+    if (kOutLetterboxPaddings(cc).IsConnected()) {
+      kOutLetterboxPaddings(cc).Send(std::move(paddings));
+    }
+    if (kOutMatrices(cc).IsConnected()) {
+      kOutMatrices(cc).Send(std::move(matrices));
+    }
 
     Tensor::ElementType output_tensor_type =
         GetOutputTensorType(image->UsesGpu(), params_);
-    Tensor tensor(
-        output_tensor_type,
-        {1, tensor_height, tensor_width, GetNumOutputChannels(*image)},
-        memory_manager_);
-    MP_RETURN_IF_ERROR((image->UsesGpu() ? gpu_converter_ : cpu_converter_)
-                           ->Convert(*image, roi, params_.range_min,
-                                     params_.range_max,
-                                     /*tensor_buffer_offset=*/0, tensor));
+    const Tensor::Shape output_shape(
+        {batch_size, tensor_height, tensor_width, num_channels},
+        /*is_dynamic=*/kInNormRects(cc).IsConnected());
 
+    // Another graph may already have converted the same image the same way.
+    ImageToTensorCacheKey cache_key;
+    if (cache_ != nullptr) {
+      cache_key = {*image,
+                   rois,
+                   output_tensor_type,
+                   output_shape.dims,
+                   params_.range_min,
+                   params_.range_max,
+                   GetBorderMode(options_.border_mode()),
+                   /*uses_gpu=*/image->UsesGpu(),
+                   options_.gpu_origin(),
+                   /*single_tensor=*/kOutTensor(cc).IsConnected()};
+      mediapipe::Packet cached_tensors = cache_->Lookup(cache_key);
+      if (!cached_tensors.IsEmpty()) {
+        SendTensors(cc, std::move(cached_tensors).At(cc->InputTimestamp()));
+        return absl::OkStatus();
+      }
+    }
+
+    // Lazy initialization of the GPU or CPU converter.
+    MP_RETURN_IF_ERROR(InitConverterIfNecessary(cc, *image.get()));
+
+    // Pooled tensors have a fixed shape, so batches of NORM_RECTS are not
+    // pooled.
+    if (tensor_pool_ != nullptr && !output_shape.is_dynamic) {
+      MP_ASSIGN_OR_RETURN(
+          std::shared_ptr<Tensor> tensor,
+          tensor_pool_->GetTensor({output_tensor_type, output_shape.dims}));
+      MP_RETURN_IF_ERROR(ConvertRois(*image, rois, *tensor));
+      SendAndCacheTensors(
+          cc, std::move(cache_key),
+          TensorPool::ToPacket(std::move(tensor)).At(cc->InputTimestamp()));
+      return absl::OkStatus();
+    }
+
+    Tensor tensor(output_tensor_type, output_shape, memory_manager_);
+    MP_RETURN_IF_ERROR(ConvertRois(*image, rois, tensor));
+
+    mediapipe::Packet tensors;
     if (kOutTensors(cc).IsConnected()) {
       auto result = std::make_unique<std::vector<Tensor>>();
       result->push_back(std::move(tensor));
-      kOutTensors(cc).Send(std::move(result));
+      tensors = Adopt(result.release());
     } else {
-      kOutTensor(cc).Send(std::move(tensor));
+      tensors = mediapipe::MakePacket<Tensor>(std::move(tensor));
     }
+    SendAndCacheTensors(cc, std::move(cache_key),
+                        std::move(tensors).At(cc->InputTimestamp()));
     return absl::OkStatus();
   }
 
  private:
+  // Sends `tensors`, a packet holding either a Tensor or a vector of tensors,
+  // to the connected output.
+  void SendTensors(CalculatorContext* cc, mediapipe::Packet tensors) {
+    if (kOutTensors(cc).IsConnected()) {
+      kOutTensors(cc).Send(
+          FromOldPacket(std::move(tensors)).As<std::vector<Tensor>>());
+    } else {
+      kOutTensor(cc).Send(FromOldPacket(std::move(tensors)).As<Tensor>());
+    }
+  }
+
+  // Sends `tensors` and, if the graph shares an ImageToTensorCache, makes them
+  // available to other graphs converting the same image.
+  void SendAndCacheTensors(CalculatorContext* cc,
+                           ImageToTensorCacheKey cache_key,
+                           mediapipe::Packet tensors) {
+    if (cache_ != nullptr) {
+      cache_->Insert(std::move(cache_key), tensors);
+    }
+    SendTensors(cc, std::move(tensors));
+  }
+
+  // Converts every ROI in place into its own batch slice of the tensor buffer,
+  // so no per-ROI tensor is allocated or copied.
+  absl::Status ConvertRois(const Image& image,
+                           const std::vector<RotatedRect>& rois,
+                           Tensor& tensor) {
+    ImageToTensorConverter* converter =
+        image.UsesGpu() ? gpu_converter_.get() : cpu_converter_.get();
+    const int tensor_bytes_per_image = tensor.bytes() / rois.size();
+    for (int i = 0; i < rois.size(); ++i) {
+      MP_RETURN_IF_ERROR(converter->Convert(
+          image, rois[i], params_.range_min, params_.range_max,
+          /*tensor_buffer_offset=*/i * tensor_bytes_per_image, tensor));
+    }
+    return absl::OkStatus();
+  }
+
   absl::Status InitConverterIfNecessary(CalculatorContext* cc,
                                         const Image& image) {
     // Lazy initialization of the GPU or CPU converter.
@@ -341,6 +501,8 @@ class ImageToTensorCalculator : public Node {
   mediapipe::ImageToTensorCalculatorOptions options_;
   OutputTensorParams params_;
   MemoryManager* memory_manager_ = nullptr;
+  TensorPool* tensor_pool_ = nullptr;
+  ImageToTensorCache* cache_ = nullptr;
 };
 
 MEDIAPIPE_REGISTER_NODE(ImageToTensorCalculator);
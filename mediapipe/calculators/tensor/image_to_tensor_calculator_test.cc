@@ -12,9 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -37,6 +39,7 @@
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/util/image_test_utils.h"
@@ -557,6 +560,176 @@ TEST(ImageToTensorCalculatorTest, CanBeUsedWithoutGpuServiceSet) {
   MP_ASSERT_OK(graph.WaitUntilDone());
 }
 
+TEST(ImageToTensorCalculatorTest, MultipleRectsProduceBatchedTensor) {
+  CalculatorRunner runner(
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+        calculator: "ImageToTensorCalculator"
+        input_stream: "IMAGE:image"
+        input_stream: "NORM_RECTS:rects"
+        output_stream: "TENSORS:tensors"
+        output_stream: "MATRICES:matrices"
+        output_stream: "LETTERBOX_PADDINGS:paddings"
+        options {
+          [mediapipe.ImageToTensorCalculatorOptions.ext] {
+            output_tensor_width: 2
+            output_tensor_height: 2
+            output_tensor_float_range { min: 0.0f max: 1.0f }
+          }
+        }
+      )pb"));
+
+  // Left half of the image is black, right half is white.
+  cv::Mat input(2, 4, CV_8UC3, cv::Scalar(0, 0, 0));
+  input(cv::Rect(2, 0, 2, 2)).setTo(cv::Scalar(255, 255, 255));
+  std::vector<NormalizedRect> rects(2);
+  rects[0].set_x_center(0.25f);
+  rects[1].set_x_center(0.75f);
+  for (auto& rect : rects) {
+    rect.set_y_center(0.5f);
+    rect.set_width(0.5f);
+    rect.set_height(1.0f);
+  }
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      MakeImagePacket(input).At(Timestamp(0)));
+  runner.MutableInputs()->Tag("NORM_RECTS").packets.push_back(
+      MakePacket<std::vector<NormalizedRect>>(rects).At(Timestamp(0)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& tensor_packets = runner.Outputs().Tag("TENSORS").packets;
+  ASSERT_EQ(tensor_packets.size(), 1);
+  const auto& tensors = tensor_packets[0].Get<std::vector<Tensor>>();
+  ASSERT_EQ(tensors.size(), 1);
+  const Tensor& tensor = tensors[0];
+  EXPECT_EQ(tensor.shape().dims, std::vector<int>({2, 2, 2, 3}));
+  auto view = tensor.GetCpuReadView();
+  const float* data = view.buffer<float>();
+  const int num_elements_per_image = tensor.shape().num_elements() / 2;
+  for (int i = 0; i < num_elements_per_image; ++i) {
+    EXPECT_NEAR(data[i], 0.0f, 1e-5f);
+    EXPECT_NEAR(data[num_elements_per_image + i], 1.0f, 1e-5f);
+  }
+
+  const auto& matrix_packets = runner.Outputs().Tag("MATRICES").packets;
+  ASSERT_EQ(matrix_packets.size(), 1);
+  EXPECT_EQ(matrix_packets[0].Get<std::vector<std::array<float, 16>>>().size(),
+            2);
+  const auto& padding_packets =
+      runner.Outputs().Tag("LETTERBOX_PADDINGS").packets;
+  ASSERT_EQ(padding_packets.size(), 1);
+  EXPECT_EQ(padding_packets[0].Get<std::vector<std::array<float, 4>>>().size(),
+            2);
+}
+
+// The single pass warp and normalization the OpenCV converter used before it
+// was split into bands, kept as the reference.
+cv::Mat ReferenceOpenCvConvert(const cv::Mat& input, const RotatedRect& roi,
+                               int output_width, int output_height,
+                               float range_min, float range_max) {
+  const cv::RotatedRect rotated_rect(cv::Point2f(roi.center_x, roi.center_y),
+                                     cv::Size2f(roi.width, roi.height),
+                                     roi.rotation * 180.f / M_PI);
+  cv::Mat src_points;
+  cv::boxPoints(rotated_rect, src_points);
+  const float dst_width = output_width;
+  const float dst_height = output_height;
+  float dst_corners[8] = {0.0f,      dst_height, 0.0f,      0.0f,
+                          dst_width, 0.0f,       dst_width, dst_height};
+  const cv::Mat dst_points = cv::Mat(4, 2, CV_32F, dst_corners);
+  const cv::Mat projection_matrix =
+      cv::getPerspectiveTransform(src_points, dst_points);
+  cv::Mat transformed;
+  cv::warpPerspective(input, transformed, projection_matrix,
+                      cv::Size(output_width, output_height), cv::INTER_LINEAR,
+                      cv::BORDER_REPLICATE);
+  if (transformed.channels() == 4) {
+    cv::cvtColor(transformed, transformed, cv::COLOR_RGBA2RGB);
+  }
+  const ValueTransformation transform =
+      GetValueRangeTransformation(0.0f, 255.0f, range_min, range_max).value();
+  cv::Mat result;
+  transformed.convertTo(result, CV_32F, transform.scale, transform.offset);
+  return result;
+}
+
+TEST(ImageToTensorCalculatorTest, CpuBandsMatchSinglePassConversion) {
+  // The output height is not a multiple of the band height, so bands differ
+  // in size.
+  constexpr int kOutputWidth = 71;
+  constexpr int kOutputHeight = 133;
+  constexpr float kRangeMin = -1.0f;
+  constexpr float kRangeMax = 1.0f;
+  const int num_threads = cv::getNumThreads();
+
+  std::mt19937 rng(0);
+  std::uniform_int_distribution<int> value(0, 255);
+  NormalizedRect norm_rect;
+  norm_rect.set_x_center(0.45f);
+  norm_rect.set_y_center(0.55f);
+  norm_rect.set_width(0.7f);
+  norm_rect.set_height(0.8f);
+  norm_rect.set_rotation(0.3f);
+  const auto node_config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+          absl::Substitute(R"pb(
+            calculator: "ImageToTensorCalculator"
+            input_stream: "IMAGE:image"
+            input_stream: "NORM_RECT:rect"
+            output_stream: "TENSORS:tensors"
+            options {
+              [mediapipe.ImageToTensorCalculatorOptions.ext] {
+                output_tensor_width: $0
+                output_tensor_height: $1
+                output_tensor_float_range { min: $2 max: $3 }
+                border_mode: BORDER_REPLICATE
+              }
+            }
+          )pb",
+                           kOutputWidth, kOutputHeight, kRangeMin,
+                           kRangeMax));
+  for (const int channels : {4, 1}) {
+    cv::Mat input(83, 97, CV_8UC(channels));
+    for (int i = 0; i < input.rows; ++i) {
+      uint8_t* row = input.ptr<uint8_t>(i);
+      for (int j = 0; j < input.cols * channels; ++j) row[j] = value(rng);
+    }
+    const cv::Mat expected = ReferenceOpenCvConvert(
+        input, GetRoi(input.cols, input.rows, norm_rect), kOutputWidth,
+        kOutputHeight, kRangeMin, kRangeMax);
+
+    // One thread converts the output in a single band, four threads in bands
+    // of 33 and 34 rows.
+    for (const int threads : {1, 4}) {
+      cv::setNumThreads(threads);
+      CalculatorRunner runner(node_config);
+      runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+          MakeImagePacket(input).At(Timestamp(0)));
+      runner.MutableInputs()->Tag("NORM_RECT").packets.push_back(
+          MakePacket<NormalizedRect>(norm_rect).At(Timestamp(0)));
+      MP_ASSERT_OK(runner.Run());
+
+      const auto& tensor_packets = runner.Outputs().Tag("TENSORS").packets;
+      ASSERT_EQ(tensor_packets.size(), 1);
+      const Tensor& tensor = tensor_packets[0].Get<std::vector<Tensor>>()[0];
+      ASSERT_EQ(tensor.element_type(), Tensor::ElementType::kFloat32);
+      const int output_channels = channels == 1 ? 1 : 3;
+      EXPECT_EQ(tensor.shape().dims,
+                std::vector<int>(
+                    {1, kOutputHeight, kOutputWidth, output_channels}));
+      auto view = tensor.GetCpuReadView();
+      const cv::Mat actual(kOutputHeight, kOutputWidth,
+                           CV_32FC(output_channels),
+                           const_cast<float*>(view.buffer<float>()));
+
+      // Each band inverts its own shifted projection, so sampling positions
+      // can round to a neighboring subpixel and move a value by one level.
+      EXPECT_LE(cv::norm(actual, expected, cv::NORM_INF),
+                (kRangeMax - kRangeMin) / 255.0f + 1e-5f)
+          << "channels " << channels << ", threads " << threads;
+    }
+  }
+  cv::setNumThreads(num_threads);
+}
+
 #if !MEDIAPIPE_DISABLE_GPU && !MEDIAPIPE_METAL_ENABLED
 
 TEST(ImageToTensorCalculatorTest,
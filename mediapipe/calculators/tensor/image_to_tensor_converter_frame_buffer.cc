@@ -63,6 +63,14 @@ class ImageToTensorFrameBufferConverter : public ImageToTensorConverter {
   absl::Status CropRotateResize90Degrees(
       std::shared_ptr<const FrameBuffer> input, const RotatedRect& roi,
       std::shared_ptr<FrameBuffer> output);
+  // Crops and resizes a YUV input straight into the float output tensor in a
+  // single pass. Returns false without touching the tensor if the fused path
+  // does not apply to this input and region-of-interest.
+  absl::StatusOr<bool> TryCropResizeYuvToFloatTensor(const FrameBuffer& input,
+                                                     const RotatedRect& roi,
+                                                     float range_min,
+                                                     float range_max,
+                                                     Tensor& output_tensor);
   // Converts the input FrameBuffer to a float Tensor. Output tensor must have
   // type kFloat32.
   absl::Status ConvertToFloatTensor(
@@ -109,6 +117,13 @@ absl::Status ImageToTensorFrameBufferConverter::Convert(
           frame_buffer::CreateFromRgbRawBuffer(data, output_dimension);
       return CropRotateResize90Degrees(input_frame, roi, output_frame);
     } else {
+      MP_ASSIGN_OR_RETURN(
+          bool converted,
+          TryCropResizeYuvToFloatTensor(*input_frame, roi, range_min,
+                                        range_max, output_tensor));
+      if (converted) {
+        return absl::OkStatus();
+      }
       size_t output_buffer_size = frame_buffer::GetFrameBufferByteSize(
           output_dimension, FrameBuffer::Format::kRGB);
       if (output_buffer_size > output_buffer_size_) {
@@ -209,6 +224,40 @@ absl::Status ImageToTensorFrameBufferConverter::CropRotateResize90Degrees(
   return absl::OkStatus();
 }
 
+absl::StatusOr<bool>
+ImageToTensorFrameBufferConverter::TryCropResizeYuvToFloatTensor(
+    const FrameBuffer& input, const RotatedRect& roi, float range_min,
+    float range_max, Tensor& output_tensor) {
+  if (input.format() != FrameBuffer::Format::kNV12 &&
+      input.format() != FrameBuffer::Format::kNV21 &&
+      input.format() != FrameBuffer::Format::kYV12 &&
+      input.format() != FrameBuffer::Format::kYV21) {
+    return false;
+  }
+  if (RadiansToDegrees(roi.rotation) != 0) {
+    return false;
+  }
+  const int left = roi.center_x - roi.width / 2;
+  const int right = left + roi.width - 1;
+  const int top = roi.center_y - roi.height / 2;
+  const int bottom = top + roi.height - 1;
+  // YUV crops must start on even coordinates to keep the Y and UV planes
+  // aligned.
+  if (left % 2 != 0 || top % 2 != 0) {
+    return false;
+  }
+  constexpr float kInputImageRangeMin = 0.0f;
+  constexpr float kInputImageRangeMax = 255.0f;
+  MP_ASSIGN_OR_RETURN(
+      auto transform,
+      GetValueRangeTransformation(kInputImageRangeMin, kInputImageRangeMax,
+                                  range_min, range_max));
+  MP_RETURN_IF_ERROR(frame_buffer::CropResizeToFloatTensor(
+      input, left, top, right, bottom, transform.scale, transform.offset,
+      output_tensor));
+  return true;
+}
+
 absl::Status ImageToTensorFrameBufferConverter::ConvertToFloatTensor(
     std::shared_ptr<const FrameBuffer> input_frame, float range_min,
     float range_max, Tensor& output_tensor) {
@@ -18,6 +18,7 @@
 
 #import <Metal/Metal.h>
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <vector>
@@ -183,16 +184,48 @@ class SubRectExtractorMetal {
                        float alpha, float beta,
                        const tflite::gpu::HW& destination_size,
                        id<MTLCommandBuffer> command_buffer,
-                       id<MTLBuffer> destination) {
-    auto output_texture = MTLTextureWithBuffer(destination_size, destination);
+                       id<MTLBuffer> destination,
+                       NSUInteger destination_offset) {
+    auto output_texture = GetOrCreateTextureWithBuffer(
+        destination_size, destination, destination_offset);
     return InternalExecute(input_texture, sub_rect, flip_horizontally, alpha,
                            beta, destination_size, command_buffer,
                            output_texture);
   }
 
  private:
+  // Output tensors usually come from a TensorPool, so the same few buffers are
+  // rendered to over and over. Keeping their texture views around avoids
+  // re-creating one per frame.
+  static constexpr int kMaxCachedTextures = 4;
+  struct CachedTexture {
+    id<MTLBuffer> buffer;
+    NSUInteger offset;
+    tflite::gpu::HW size;
+    id<MTLTexture> texture;
+  };
+
+  id<MTLTexture> GetOrCreateTextureWithBuffer(const tflite::gpu::HW& size,
+                                              id<MTLBuffer> buffer,
+                                              NSUInteger offset) {
+    for (auto it = texture_cache_.begin(); it != texture_cache_.end(); ++it) {
+      if (it->buffer == buffer && it->offset == offset &&
+          it->size.h == size.h && it->size.w == size.w) {
+        // Move to front so that the least recently used entry is evicted.
+        std::rotate(texture_cache_.begin(), it, it + 1);
+        return texture_cache_.front().texture;
+      }
+    }
+    id<MTLTexture> texture = MTLTextureWithBuffer(size, buffer, offset);
+    // A cached texture retains its buffer, so the cache is kept small.
+    if (texture_cache_.size() == kMaxCachedTextures) texture_cache_.pop_back();
+    texture_cache_.insert(texture_cache_.begin(),
+                          {buffer, offset, size, texture});
+    return texture;
+  }
+
   id<MTLTexture> MTLTextureWithBuffer(const tflite::gpu::HW& size,
-                                      id<MTLBuffer> buffer) {
+                                      id<MTLBuffer> buffer, NSUInteger offset) {
     MTLTextureDescriptor* texture_desc = [MTLTextureDescriptor
         texture2DDescriptorWithPixelFormat:GetPixelFormat(output_format_)
                                      width:size.w
@@ -204,7 +237,7 @@ class SubRectExtractorMetal {
 
     id<MTLTexture> texture =
         [buffer newTextureWithDescriptor:texture_desc
-                                  offset:0
+                                  offset:offset
                              bytesPerRow:output_bytes_per_row];
     return texture;
   }
@@ -218,16 +251,12 @@ class SubRectExtractorMetal {
     RET_CHECK(command_buffer != nil);
     RET_CHECK(output_texture != nil);
 
-    // Obtain texture mapping coordinates transformation matrix and copy its
-    // data to the buffer.
+    // Obtain texture mapping coordinates transformation matrix. It is small
+    // enough to be passed inline rather than through a per-frame buffer.
     std::array<float, 16> transform_mat;
     GetRotatedSubRectToRectTransformMatrix(sub_rect, input_texture.width,
                                            input_texture.height,
                                            flip_horizontally, &transform_mat);
-    id<MTLBuffer> transform_mat_buffer =
-        [device_ newBufferWithBytes:&transform_mat
-                             length:sizeof(transform_mat)
-                            options:MTLResourceOptionCPUCacheModeDefault];
 
     // Create parameters wrapper.
     float parameters[] = {alpha, beta};
@@ -246,7 +275,9 @@ class SubRectExtractorMetal {
     [command_encoder setRenderPipelineState:pipeline_state_];
     [command_encoder setVertexBuffer:positions_buffer_ offset:0 atIndex:0];
     [command_encoder setVertexBuffer:tex_coords_buffer_ offset:0 atIndex:1];
-    [command_encoder setVertexBuffer:transform_mat_buffer offset:0 atIndex:2];
+    [command_encoder setVertexBytes:transform_mat.data()
+                             length:sizeof(transform_mat)
+                            atIndex:2];
     [command_encoder setFragmentTexture:input_texture atIndex:0];
     [command_encoder setFragmentBytes:&parameters
                                length:sizeof(parameters)
@@ -338,6 +369,7 @@ class SubRectExtractorMetal {
   id<MTLDevice> device_;
   id<MTLRenderPipelineState> pipeline_state_;
   OutputFormat output_format_;
+  std::vector<CachedTexture> texture_cache_;
 };
 
 class ImageToTensorMetalConverter : public ImageToTensorConverter {
@@ -362,10 +394,17 @@ class ImageToTensorMetalConverter : public ImageToTensorConverter {
           "Only 4-channel texture input formats are supported, passed format: ",
           static_cast<uint32_t>(input.format())));
     }
-    RET_CHECK_EQ(tensor_buffer_offset, 0)
-        << "The non-zero tensor_buffer_offset input is not supported yet.";
     const auto& output_shape = output_tensor.shape();
     MP_RETURN_IF_ERROR(ValidateTensorShape(output_shape));
+    // Each batch element is a separate image, so the offset must land on an
+    // image boundary inside the tensor buffer.
+    const int image_bytes = output_shape.dims[1] * output_shape.dims[2] *
+                            output_shape.dims[3] * sizeof(float);
+    RET_CHECK_GE(tensor_buffer_offset, 0);
+    RET_CHECK_EQ(tensor_buffer_offset % image_bytes, 0)
+        << "tensor_buffer_offset must be a multiple of the image size.";
+    RET_CHECK_LT(tensor_buffer_offset / image_bytes, output_shape.dims[0])
+        << "tensor_buffer_offset is out of the tensor bounds.";
 
     @autoreleasepool {
       id<MTLTexture> texture =
@@ -385,7 +424,7 @@ class ImageToTensorMetalConverter : public ImageToTensorConverter {
           texture, roi,
           /*flip_horizontally=*/false, transform.scale, transform.offset,
           tflite::gpu::HW(output_shape.dims[1], output_shape.dims[2]),
-          command_buffer, buffer_view.buffer()));
+          command_buffer, buffer_view.buffer(), tensor_buffer_offset));
       [command_buffer commit];
       return absl::OkStatus();
     }
@@ -395,9 +434,8 @@ class ImageToTensorMetalConverter : public ImageToTensorConverter {
   absl::Status ValidateTensorShape(const Tensor::Shape& output_shape) {
     RET_CHECK_EQ(output_shape.dims.size(), 4)
         << "Wrong output dims size: " << output_shape.dims.size();
-    RET_CHECK_EQ(output_shape.dims[0], 1)
-        << "Handling batch dimension not equal to 1 is not implemented in this "
-           "converter.";
+    RET_CHECK_GE(output_shape.dims[0], 1)
+        << "Wrong output batch: " << output_shape.dims[0];
     RET_CHECK_EQ(output_shape.dims[3], 4)
         << "Wrong output channel: " << output_shape.dims[3];
     return absl::OkStatus();
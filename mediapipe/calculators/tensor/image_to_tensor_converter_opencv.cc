@@ -14,6 +14,7 @@
 
 #include "mediapipe/calculators/tensor/image_to_tensor_converter_opencv.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 
@@ -149,17 +150,6 @@ class ImageToTensorOpenCvConverter : public ImageToTensorConverter {
     cv::Mat dst_points = cv::Mat(4, 2, CV_32F, dst_corners);
     cv::Mat projection_matrix =
         cv::getPerspectiveTransform(src_points, dst_points);
-    cv::Mat transformed;
-    cv::warpPerspective(*src, transformed, projection_matrix,
-                        cv::Size(dst_width, dst_height),
-                        /*flags=*/flags_,
-                        /*borderMode=*/border_mode_);
-
-    if (transformed.channels() > output_channels) {
-      cv::Mat proper_channels_mat;
-      cv::cvtColor(transformed, proper_channels_mat, cv::COLOR_RGBA2RGB);
-      transformed = proper_channels_mat;
-    }
 
     constexpr float kInputImageRangeMin = 0.0f;
     constexpr float kInputImageRangeMax = 255.0f;
@@ -167,8 +157,34 @@ class ImageToTensorOpenCvConverter : public ImageToTensorConverter {
         auto transform,
         GetValueRangeTransformation(kInputImageRangeMin, kInputImageRangeMax,
                                     range_min, range_max));
-    transformed.convertTo(dst, dst_data_type, transform.scale,
-                          transform.offset);
+
+    // Warps and normalizes the output in horizontal bands, so that each
+    // band's intermediate image stays in cache and bands run in parallel.
+    const int num_bands = std::max(
+        1, std::min(cv::getNumThreads(), output_height / kMinRowsPerBand));
+    cv::parallel_for_(cv::Range(0, num_bands), [&](const cv::Range& range) {
+      for (int band = range.start; band < range.end; ++band) {
+        const int row_begin = output_height * band / num_bands;
+        const int row_end = output_height * (band + 1) / num_bands;
+        // Shifts the projection so that the band's first row maps to row 0.
+        const cv::Mat row_shift =
+            (cv::Mat_<double>(3, 3) << 1, 0, 0, 0, 1, -row_begin, 0, 0, 1);
+        const cv::Mat band_projection = row_shift * projection_matrix;
+        cv::Mat transformed;
+        cv::warpPerspective(*src, transformed, band_projection,
+                            cv::Size(output_width, row_end - row_begin),
+                            /*flags=*/flags_,
+                            /*borderMode=*/border_mode_);
+        if (transformed.channels() > output_channels) {
+          cv::Mat proper_channels_mat;
+          cv::cvtColor(transformed, proper_channels_mat, cv::COLOR_RGBA2RGB);
+          transformed = proper_channels_mat;
+        }
+        cv::Mat dst_band = dst.rowRange(row_begin, row_end);
+        transformed.convertTo(dst_band, dst_data_type, transform.scale,
+                              transform.offset);
+      }
+    });
     return absl::OkStatus();
   }
 
@@ -183,6 +199,9 @@ class ImageToTensorOpenCvConverter : public ImageToTensorConverter {
     return absl::OkStatus();
   }
 
+  // Bands smaller than this do not amortize the per-band warp setup.
+  static constexpr int kMinRowsPerBand = 32;
+
   enum cv::BorderTypes border_mode_;
   Tensor::ElementType tensor_type_;
   cv::InterpolationFlags flags_;
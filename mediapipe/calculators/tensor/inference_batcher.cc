@@ -0,0 +1,158 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/inference_batcher.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Returns the shape of `tensor` with its batch dimension set to `batch_size`.
+Tensor::Shape WithBatchSize(const Tensor& tensor, int batch_size,
+                            bool is_dynamic) {
+  std::vector<int> dims = tensor.shape().dims;
+  dims[0] = batch_size;
+  return Tensor::Shape(dims, is_dynamic);
+}
+
+// Returns true if `a` and `b` agree in all but the batch dimension.
+bool HaveSameItemShape(const Tensor& a, const Tensor& b) {
+  const std::vector<int>& a_dims = a.shape().dims;
+  const std::vector<int>& b_dims = b.shape().dims;
+  return a_dims.size() == b_dims.size() &&
+         std::equal(a_dims.begin() + 1, a_dims.end(), b_dims.begin() + 1);
+}
+
+}  // namespace
+
+InferenceBatcher::InferenceBatcher(
+    const mediapipe::InferenceCalculatorOptions::Batching& options)
+    : max_batch_size_(options.max_batch_size()),
+      max_batch_delay_(options.max_batch_delay_us() > 0
+                           ? absl::Microseconds(options.max_batch_delay_us())
+                           : absl::InfiniteDuration()) {}
+
+void InferenceBatcher::Add(Timestamp timestamp, std::vector<Packet> packets,
+                           TensorSpan tensors, absl::Time now) {
+  pending_.push_back(
+      {timestamp, std::move(packets), std::move(tensors), now});
+}
+
+bool InferenceBatcher::IsBatchReady(absl::Time now) const {
+  if (pending_.empty()) return false;
+  return pending_.size() >= max_batch_size_ ||
+         now - pending_.front().arrival_time >= max_batch_delay_;
+}
+
+absl::StatusOr<InferenceBatcher::Batch> InferenceBatcher::TakeBatch() {
+  RET_CHECK(!pending_.empty());
+  std::vector<PendingInput> pending = std::move(pending_);
+  pending_.clear();
+
+  Batch batch;
+  const TensorSpan& first = pending.front().tensors;
+  int total_batch_size = 0;
+  for (const PendingInput& input : pending) {
+    RET_CHECK_EQ(input.tensors.size(), first.size())
+        << "Number of input tensors changed at " << input.timestamp;
+    RET_CHECK_GT(input.tensors.size(), 0);
+    RET_CHECK(!input.tensors[0].shape().dims.empty())
+        << "Batched input tensors need a batch dimension.";
+    const int batch_size = input.tensors[0].shape().dims[0];
+    RET_CHECK_GT(batch_size, 0);
+    for (int i = 0; i < input.tensors.size(); ++i) {
+      const Tensor& tensor = input.tensors[i];
+      RET_CHECK(!tensor.shape().dims.empty() &&
+                tensor.shape().dims[0] == batch_size)
+          << "Input tensor " << i << " at " << input.timestamp
+          << " does not have batch size " << batch_size;
+      RET_CHECK(tensor.element_type() == first[i].element_type() &&
+                HaveSameItemShape(tensor, first[i]))
+          << "Input tensor " << i << " at " << input.timestamp
+          << " does not match the type and shape of the batch";
+    }
+    batch.timestamps.push_back(input.timestamp);
+    batch.batch_sizes.push_back(batch_size);
+    total_batch_size += batch_size;
+  }
+
+  batch.tensors.reserve(first.size());
+  for (int i = 0; i < first.size(); ++i) {
+    Tensor batched(first[i].element_type(),
+                   WithBatchSize(first[i], total_batch_size,
+                                 /*is_dynamic=*/true),
+                   first[i].quantization_parameters());
+    auto write_view = batched.GetCpuWriteView();
+    uint8_t* dst = write_view.buffer<uint8_t>();
+    for (const PendingInput& input : pending) {
+      const Tensor& tensor = input.tensors[i];
+      auto read_view = tensor.GetCpuReadView();
+      std::memcpy(dst, read_view.buffer<uint8_t>(), tensor.bytes());
+      dst += tensor.bytes();
+    }
+    batch.tensors.push_back(std::move(batched));
+  }
+  return batch;
+}
+
+// static
+absl::StatusOr<std::vector<std::vector<Tensor>>>
+InferenceBatcher::SplitOutputs(const Batch& batch,
+                               std::vector<Tensor>&& batched_tensors) {
+  int total_batch_size = 0;
+  for (int batch_size : batch.batch_sizes) total_batch_size += batch_size;
+
+  std::vector<std::vector<Tensor>> outputs(batch.timestamps.size());
+  for (std::vector<Tensor>& output : outputs) {
+    output.reserve(batched_tensors.size());
+  }
+  for (int i = 0; i < batched_tensors.size(); ++i) {
+    const Tensor& batched = batched_tensors[i];
+    RET_CHECK(!batched.shape().dims.empty() &&
+              batched.shape().dims[0] == total_batch_size)
+        << "Output tensor " << i << " does not have the batch size "
+        << total_batch_size << " of the inputs.";
+    const int item_bytes = batched.bytes() / total_batch_size;
+    auto read_view = batched.GetCpuReadView();
+    const uint8_t* src = read_view.buffer<uint8_t>();
+    for (int j = 0; j < outputs.size(); ++j) {
+      Tensor output(batched.element_type(),
+                    WithBatchSize(batched, batch.batch_sizes[j],
+                                  batched.shape().is_dynamic),
+                    batched.quantization_parameters());
+      const int bytes = item_bytes * batch.batch_sizes[j];
+      std::memcpy(output.GetCpuWriteView().buffer<uint8_t>(), src, bytes);
+      src += bytes;
+      outputs[j].push_back(std::move(output));
+    }
+  }
+  return outputs;
+}
+
+}  // namespace mediapipe
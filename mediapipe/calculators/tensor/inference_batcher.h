@@ -0,0 +1,88 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_BATCHER_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_BATCHER_H_
+
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+// Collects the input tensors of consecutive timestamps into batches for
+// InferenceCalculator, see InferenceCalculatorOptions::Batching.
+//
+// The first dimension of each tensor is its batch dimension. All input
+// tensors of one timestamp must have the same batch size, and the tensors at
+// the same index must agree in element type and in all other dimensions.
+class InferenceBatcher {
+ public:
+  // The batched input tensors of several timestamps.
+  struct Batch {
+    std::vector<Timestamp> timestamps;
+    // The batch size of the inputs at each timestamp.
+    std::vector<int> batch_sizes;
+    // The input tensors of all timestamps, concatenated along the batch
+    // dimension. The shapes are dynamic, so that the interpreter is resized.
+    std::vector<Tensor> tensors;
+  };
+
+  explicit InferenceBatcher(
+      const mediapipe::InferenceCalculatorOptions::Batching& options);
+
+  // Adds the input tensors of one timestamp. The packets own the tensors and
+  // are held until the batch is taken.
+  void Add(Timestamp timestamp, std::vector<Packet> packets,
+           TensorSpan tensors, absl::Time now);
+
+  // Returns true if the pending inputs fill a batch, or if the oldest pending
+  // input has waited for the maximum batch delay.
+  bool IsBatchReady(absl::Time now) const;
+
+  bool IsEmpty() const { return pending_.empty(); }
+
+  // Returns the timestamp of the oldest pending input. Must not be empty.
+  Timestamp OldestTimestamp() const { return pending_.front().timestamp; }
+
+  // Concatenates the pending inputs into a Batch and clears them.
+  absl::StatusOr<Batch> TakeBatch();
+
+  // Splits the batched output tensors of a Batch into the output tensors of
+  // each of its timestamps.
+  static absl::StatusOr<std::vector<std::vector<Tensor>>> SplitOutputs(
+      const Batch& batch, std::vector<Tensor>&& batched_tensors);
+
+ private:
+  struct PendingInput {
+    Timestamp timestamp;
+    std::vector<Packet> packets;
+    TensorSpan tensors;
+    absl::Time arrival_time;
+  };
+
+  const int max_batch_size_;
+  const absl::Duration max_batch_delay_;
+  std::vector<PendingInput> pending_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_BATCHER_H_
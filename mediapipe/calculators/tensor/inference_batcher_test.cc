@@ -0,0 +1,142 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/inference_batcher.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using Batching = ::mediapipe::InferenceCalculatorOptions::Batching;
+
+Batching MakeBatching(int max_batch_size, int64_t max_batch_delay_us = 0) {
+  Batching batching;
+  batching.set_max_batch_size(max_batch_size);
+  batching.set_max_batch_delay_us(max_batch_delay_us);
+  return batching;
+}
+
+// Returns a packet holding one float tensor of shape [1, 2] filled with
+// `value` and `value + 1`.
+Packet MakeTensorPacket(float value) {
+  std::vector<Tensor> tensors;
+  tensors.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape({1, 2}));
+  float* buffer = tensors[0].GetCpuWriteView().buffer<float>();
+  buffer[0] = value;
+  buffer[1] = value + 1;
+  return MakePacket<std::vector<Tensor>>(std::move(tensors));
+}
+
+void AddTensorPacket(InferenceBatcher& batcher, Timestamp timestamp,
+                     float value, absl::Time now) {
+  Packet packet = MakeTensorPacket(value);
+  TensorSpan tensors = MakeTensorSpan(packet.Get<std::vector<Tensor>>());
+  batcher.Add(timestamp, {std::move(packet)}, std::move(tensors), now);
+}
+
+std::vector<float> Values(const Tensor& tensor) {
+  auto view = tensor.GetCpuReadView();
+  const float* buffer = view.buffer<float>();
+  return std::vector<float>(buffer, buffer + tensor.shape().num_elements());
+}
+
+TEST(InferenceBatcherTest, WaitsForFullBatch) {
+  InferenceBatcher batcher(MakeBatching(/*max_batch_size=*/3));
+  const absl::Time now = absl::UnixEpoch();
+  EXPECT_FALSE(batcher.IsBatchReady(now));
+  AddTensorPacket(batcher, Timestamp(1), 10, now);
+  AddTensorPacket(batcher, Timestamp(2), 20, now);
+  EXPECT_EQ(batcher.OldestTimestamp(), Timestamp(1));
+  EXPECT_FALSE(batcher.IsBatchReady(now + absl::Hours(1)));
+  AddTensorPacket(batcher, Timestamp(3), 30, now);
+  EXPECT_TRUE(batcher.IsBatchReady(now));
+}
+
+TEST(InferenceBatcherTest, RunsPartialBatchAfterDelay) {
+  InferenceBatcher batcher(
+      MakeBatching(/*max_batch_size=*/3, /*max_batch_delay_us=*/1000));
+  const absl::Time now = absl::UnixEpoch();
+  AddTensorPacket(batcher, Timestamp(1), 10, now);
+  EXPECT_FALSE(batcher.IsBatchReady(now + absl::Microseconds(999)));
+  EXPECT_TRUE(batcher.IsBatchReady(now + absl::Microseconds(1000)));
+}
+
+TEST(InferenceBatcherTest, ConcatenatesAndSplitsTensors) {
+  InferenceBatcher batcher(MakeBatching(/*max_batch_size=*/2));
+  AddTensorPacket(batcher, Timestamp(1), 10, absl::UnixEpoch());
+  AddTensorPacket(batcher, Timestamp(2), 20, absl::UnixEpoch());
+
+  MP_ASSERT_OK_AND_ASSIGN(InferenceBatcher::Batch batch, batcher.TakeBatch());
+  EXPECT_TRUE(batcher.IsEmpty());
+  EXPECT_THAT(batch.timestamps, ElementsAre(Timestamp(1), Timestamp(2)));
+  EXPECT_THAT(batch.batch_sizes, ElementsAre(1, 1));
+  ASSERT_EQ(batch.tensors.size(), 1);
+  EXPECT_THAT(batch.tensors[0].shape().dims, ElementsAre(2, 2));
+  EXPECT_TRUE(batch.tensors[0].shape().is_dynamic);
+  EXPECT_THAT(Values(batch.tensors[0]), ElementsAre(10, 11, 20, 21));
+
+  // Stand in for a model that outputs its input.
+  std::vector<Tensor> batched_outputs;
+  batched_outputs.push_back(std::move(batch.tensors[0]));
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::vector<Tensor>> outputs,
+      InferenceBatcher::SplitOutputs(batch, std::move(batched_outputs)));
+  ASSERT_EQ(outputs.size(), 2);
+  ASSERT_EQ(outputs[0].size(), 1);
+  EXPECT_THAT(outputs[0][0].shape().dims, ElementsAre(1, 2));
+  EXPECT_THAT(Values(outputs[0][0]), ElementsAre(10, 11));
+  ASSERT_EQ(outputs[1].size(), 1);
+  EXPECT_THAT(Values(outputs[1][0]), ElementsAre(20, 21));
+}
+
+TEST(InferenceBatcherTest, RejectsMismatchedShapes) {
+  InferenceBatcher batcher(MakeBatching(/*max_batch_size=*/2));
+  AddTensorPacket(batcher, Timestamp(1), 10, absl::UnixEpoch());
+  std::vector<Tensor> tensors;
+  tensors.emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape({1, 3}));
+  Packet packet = MakePacket<std::vector<Tensor>>(std::move(tensors));
+  TensorSpan span = MakeTensorSpan(packet.Get<std::vector<Tensor>>());
+  batcher.Add(Timestamp(2), {std::move(packet)}, std::move(span),
+              absl::UnixEpoch());
+  EXPECT_FALSE(batcher.TakeBatch().ok());
+}
+
+TEST(InferenceBatcherTest, RejectsUnbatchedOutputs) {
+  InferenceBatcher batcher(MakeBatching(/*max_batch_size=*/2));
+  AddTensorPacket(batcher, Timestamp(1), 10, absl::UnixEpoch());
+  AddTensorPacket(batcher, Timestamp(2), 20, absl::UnixEpoch());
+  MP_ASSERT_OK_AND_ASSIGN(InferenceBatcher::Batch batch, batcher.TakeBatch());
+
+  std::vector<Tensor> batched_outputs;
+  batched_outputs.emplace_back(Tensor::ElementType::kFloat32,
+                               Tensor::Shape({1, 4}));
+  EXPECT_FALSE(
+      InferenceBatcher::SplitOutputs(batch, std::move(batched_outputs)).ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -111,6 +111,12 @@ absl::Status InferenceCalculator::TensorContractCheck(CalculatorContract* cc) {
       << "Exactly one of TENSORS and TENSOR must be used for input.";
   RET_CHECK(kOutTensors(cc).IsConnected() ^ (kOutTensor(cc).Count() > 0))
       << "Exactly one of TENSORS and TENSOR must be used for output.";
+  if (cc->Options<mediapipe::InferenceCalculatorOptions>()
+          .batching()
+          .max_batch_size() > 1) {
+    // The timestamp bound is set by InferenceCalculatorNodeImpl instead.
+    cc->SetTimestampOffset(TimestampDiff::Unset());
+  }
   return absl::OkStatus();
 }
 
@@ -24,7 +24,10 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/time/clock.h"
+#include "mediapipe/calculators/tensor/inference_batcher.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 #include "mediapipe/calculators/tensor/inference_io_mapper.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/api2/node.h"
@@ -53,6 +56,10 @@ namespace api2 {
 // When the input tensors are on GPU, inference is GPU and output can be CPU or
 // GPU.
 //
+// If InferenceCalculatorOptions.batching is set, the input tensors of several
+// timestamps are run in one inference call, and the output tensors are sent
+// at the original timestamps once the batch has run.
+//
 // Input:
 //  TENSORS - Vector of Tensors
 //
@@ -149,7 +156,9 @@ class InferenceCalculator : public NodeIntf {
                       std::function<void(TfLiteOpaqueDelegate*)>>;
 
   // Helper to be used in subclass UpdateContract calls to enforce constraints
-  // when TENSORS and TENSOR are both available.
+  // when TENSORS and TENSOR are both available. With batching, it also makes
+  // the output timestamps independent of the input ones, since the outputs of
+  // a batch are sent after later inputs have been received.
   static absl::Status TensorContractCheck(CalculatorContract* cc);
 
   static absl::StatusOr<Packet<TfLiteModelPtr>> GetModelAsPacket(
@@ -195,6 +204,22 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
 
   // Override Process to handle common Tensor I/O functionality.
   absl::Status Process(CalculatorContext* cc) final {
+    const auto& batching =
+        cc->Options<mediapipe::InferenceCalculatorOptions>().batching();
+    if (batching.max_batch_size() > 1) {
+      if (batcher_ == nullptr) {
+        RET_CHECK(GetInputOutputConfig(cc).feedback_tensor_links().empty())
+            << "Feedback tensors are not supported with batching.";
+        batcher_ = std::make_unique<InferenceBatcher>(batching);
+      }
+      MP_RETURN_IF_ERROR(BatchAndProcess(cc));
+      // The outputs of the pending inputs are still to be sent, so the bound
+      // stops at the oldest of them.
+      SetNextTimestampBound(cc, batcher_->IsEmpty()
+                                    ? cc->InputTimestamp().NextAllowedInStream()
+                                    : batcher_->OldestTimestamp());
+      return absl::OkStatus();
+    }
     if (InferenceCalculator::kInTensors(cc).IsConnected()) {
       // Using old vector<Tensor> inputs; skip if empty input stream, but error
       // if the input vector is empty.
@@ -206,7 +231,8 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
       MP_ASSIGN_OR_RETURN(
           auto output_tensors,
           RemapAndProcessTensors(cc, MakeTensorSpan(input_tensors)));
-      return SendOutputTensors(cc, std::move(output_tensors));
+      return SendOutputTensors(cc, std::move(output_tensors),
+                               cc->InputTimestamp());
     }
     // Using new direct Tensor inputs; return early if any empty streams.
     for (int i = 0; i < InferenceCalculator::kInTensor(cc).Count(); ++i) {
@@ -219,7 +245,8 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
         auto output_tensors,
         RemapAndProcessTensors(
             cc, MakeTensorSpan(InferenceCalculator::kInTensor(cc))));
-    return SendOutputTensors(cc, std::move(output_tensors));
+    return SendOutputTensors(cc, std::move(output_tensors),
+                             cc->InputTimestamp());
   }
 
  protected:
@@ -236,7 +263,86 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
   virtual absl::StatusOr<std::vector<Tensor>> Process(
       CalculatorContext* cc, const TensorSpan& tensor_span) = 0;
 
+  // Runs the warm-up inferences configured in the options, if any, on
+  // zero-filled inputs of the model's input shapes. InferenceCalculator
+  // implementations must call this at the end of Open, once Process can run.
+  absl::Status WarmUp(CalculatorContext* cc) {
+    const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
+    const int num_invocations = options.warmup().num_invocations();
+    if (num_invocations <= 0) {
+      return absl::OkStatus();
+    }
+    // Warm-up outputs would be fed back into the next real inference.
+    RET_CHECK(GetInputOutputConfig(cc).feedback_tensor_links().empty())
+        << "Warm-up is not supported with feedback tensors.";
+    MP_ASSIGN_OR_RETURN(Packet<TfLiteModelPtr> model_packet,
+                        InferenceCalculator::GetModelAsPacket(cc));
+    MP_ASSIGN_OR_RETURN(std::vector<Tensor> input_tensors,
+                        CreateZeroFilledInputTensors(*model_packet.Get()));
+    // The tensors are in model input order, so the IO mapping is bypassed.
+    for (int i = 0; i < num_invocations; ++i) {
+      MP_RETURN_IF_ERROR(Process(cc, MakeTensorSpan(input_tensors)).status());
+    }
+    return absl::OkStatus();
+  }
+
+  // Runs the inputs that are still pending when batching is enabled.
+  // InferenceCalculator implementations must call this in Close, before the
+  // inference runner is released.
+  absl::Status FlushBatch(CalculatorContext* cc) {
+    if (batcher_ == nullptr || batcher_->IsEmpty()) {
+      return absl::OkStatus();
+    }
+    return ProcessBatch(cc);
+  }
+
  private:
+  // Adds the input tensors to the pending batch, and runs the batch once it is
+  // full or its oldest input has waited for the maximum batch delay.
+  absl::Status BatchAndProcess(CalculatorContext* cc) {
+    const absl::Time now = absl::Now();
+    std::vector<mediapipe::Packet> packets;
+    if (InferenceCalculator::kInTensors(cc).IsConnected()) {
+      if (InferenceCalculator::kInTensors(cc).IsEmpty()) {
+        return absl::OkStatus();
+      }
+      RET_CHECK(!InferenceCalculator::kInTensors(cc)->empty());
+      packets.push_back(InferenceCalculator::kInTensors(cc).packet());
+      batcher_->Add(cc->InputTimestamp(), std::move(packets),
+                    MakeTensorSpan(*InferenceCalculator::kInTensors(cc)), now);
+    } else {
+      for (int i = 0; i < InferenceCalculator::kInTensor(cc).Count(); ++i) {
+        if (InferenceCalculator::kInTensor(cc)[i].IsEmpty()) {
+          return absl::OkStatus();
+        }
+        packets.push_back(InferenceCalculator::kInTensor(cc)[i].packet());
+      }
+      batcher_->Add(cc->InputTimestamp(), std::move(packets),
+                    MakeTensorSpan(InferenceCalculator::kInTensor(cc)), now);
+    }
+    if (!batcher_->IsBatchReady(now)) {
+      return absl::OkStatus();
+    }
+    return ProcessBatch(cc);
+  }
+
+  // Runs one inference call on the pending batch and sends the outputs of
+  // each of its timestamps.
+  absl::Status ProcessBatch(CalculatorContext* cc) {
+    MP_ASSIGN_OR_RETURN(InferenceBatcher::Batch batch, batcher_->TakeBatch());
+    MP_ASSIGN_OR_RETURN(
+        std::vector<Tensor> output_tensors,
+        RemapAndProcessTensors(cc, MakeTensorSpan(batch.tensors)));
+    MP_ASSIGN_OR_RETURN(
+        std::vector<std::vector<Tensor>> outputs,
+        InferenceBatcher::SplitOutputs(batch, std::move(output_tensors)));
+    for (int i = 0; i < outputs.size(); ++i) {
+      MP_RETURN_IF_ERROR(SendOutputTensors(cc, std::move(outputs[i]),
+                                           batch.timestamps[i]));
+    }
+    return absl::OkStatus();
+  }
+
   // Remaps input tensors according to the IO map, runs inference, and remaps
   // output tensors.
   absl::StatusOr<std::vector<Tensor>> RemapAndProcessTensors(
@@ -255,21 +361,32 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
   // those Tensors are expected to be sent. We take an rvalue-reference to
   // ensure we can destroy/move the tensors.
   static absl::Status SendOutputTensors(CalculatorContext* cc,
-                                        std::vector<Tensor>&& output_tensors) {
+                                        std::vector<Tensor>&& output_tensors,
+                                        Timestamp timestamp) {
     if (InferenceCalculator::kOutTensors(cc).IsConnected()) {
-      InferenceCalculator::kOutTensors(cc).Send(std::move(output_tensors));
+      InferenceCalculator::kOutTensors(cc).Send(std::move(output_tensors),
+                                                timestamp);
     } else {
       const int output_count =
           std::min(InferenceCalculator::kOutTensor(cc).Count(),
                    static_cast<int>(output_tensors.size()));
       for (int i = 0; i < output_count; ++i) {
         InferenceCalculator::kOutTensor(cc)[i].Send(
-            std::move(output_tensors[i]));
+            std::move(output_tensors[i]), timestamp);
       }
     }
     return absl::OkStatus();
   }
 
+  // Sets the next timestamp bound of the TENSORS or TENSOR outputs.
+  static void SetNextTimestampBound(CalculatorContext* cc,
+                                    Timestamp timestamp) {
+    InferenceCalculator::kOutTensors(cc).SetNextTimestampBound(timestamp);
+    for (int i = 0; i < InferenceCalculator::kOutTensor(cc).Count(); ++i) {
+      InferenceCalculator::kOutTensor(cc)[i].SetNextTimestampBound(timestamp);
+    }
+  }
+
   // Looks up InputOutputConfig from side-packet or options. Returns an
   // empty map in case of missing configuration.
   static mediapipe::InferenceCalculatorOptions::InputOutputConfig
@@ -288,6 +405,7 @@ class InferenceCalculatorNodeImpl : public NodeImpl<Intf, Impl> {
   }
 
   std::unique_ptr<InferenceIoMapper> io_mapper_;
+  std::unique_ptr<InferenceBatcher> batcher_;
 };
 
 }  // namespace api2
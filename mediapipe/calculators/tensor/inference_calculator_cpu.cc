@@ -26,10 +26,13 @@
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 #include "mediapipe/calculators/tensor/inference_runner.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/calculators/tensor/xnnpack_weights_cache.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/shared_executor_registry.h"
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
 #if defined(MEDIAPIPE_ANDROID)
 #include "tensorflow/lite/delegates/nnapi/nnapi_delegate.h"
 #endif  // ANDROID
@@ -50,7 +53,11 @@ class InferenceCalculatorCpuImpl
  private:
   absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunner(
       CalculatorContext* cc);
-  absl::StatusOr<TfLiteDelegatePtr> MaybeCreateDelegate(CalculatorContext* cc);
+  // Creates the delegate of an interpreter for `model`. If the delegate uses a
+  // shared XNNPACK weights cache, returns it in `weights_cache`.
+  absl::StatusOr<TfLiteDelegatePtr> MaybeCreateDelegate(
+      CalculatorContext* cc, const tflite::FlatBufferModel& model,
+      std::shared_ptr<XnnpackWeightsCache>* weights_cache);
   absl::StatusOr<std::vector<Tensor>> Process(
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
   std::unique_ptr<InferenceRunner> inference_runner_;
@@ -63,14 +70,16 @@ absl::Status InferenceCalculatorCpuImpl::UpdateContract(
       << "Either model as side packet or model path in options is required.";
 
   MP_RETURN_IF_ERROR(TensorContractCheck(cc));
+  cc->UseService(tasks::core::kInferenceRunnerPoolService).Optional();
 
   return absl::OkStatus();
 }
 
 absl::Status InferenceCalculatorCpuImpl::Open(CalculatorContext* cc) {
   MP_ASSIGN_OR_RETURN(inference_runner_, CreateInferenceRunner(cc));
-  return InferenceCalculatorNodeImpl::UpdateIoMapping(
-      cc, inference_runner_->GetInputOutputTensorNames());
+  MP_RETURN_IF_ERROR(InferenceCalculatorNodeImpl::UpdateIoMapping(
+      cc, inference_runner_->GetInputOutputTensorNames()));
+  return WarmUp(cc);
 }
 
 absl::StatusOr<std::vector<Tensor>> InferenceCalculatorCpuImpl::Process(
@@ -81,6 +90,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorCpuImpl::Process(
 }
 
 absl::Status InferenceCalculatorCpuImpl::Close(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(FlushBatch(cc));
   inference_runner_ = nullptr;
   return absl::OkStatus();
 }
@@ -92,15 +102,39 @@ InferenceCalculatorCpuImpl::CreateInferenceRunner(CalculatorContext* cc) {
   const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
   const int interpreter_num_threads =
       cc->Options<mediapipe::InferenceCalculatorOptions>().cpu_num_thread();
-  MP_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, MaybeCreateDelegate(cc));
-  return CreateInferenceInterpreterDelegateRunner(
-      std::move(model_packet), std::move(op_resolver_packet),
-      std::move(delegate), interpreter_num_threads,
-      &options.input_output_config());
+  auto create_runner =
+      [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    std::shared_ptr<XnnpackWeightsCache> weights_cache;
+    MP_ASSIGN_OR_RETURN(
+        TfLiteDelegatePtr delegate,
+        MaybeCreateDelegate(cc, *model_packet.Get(), &weights_cache));
+    MP_ASSIGN_OR_RETURN(auto runner,
+                        CreateInferenceInterpreterDelegateRunner(
+                            model_packet, op_resolver_packet,
+                            std::move(delegate), interpreter_num_threads,
+                            &options.input_output_config()));
+    if (weights_cache) MP_RETURN_IF_ERROR(weights_cache->Finalize());
+    return runner;
+  };
+  auto delegate_options = options.delegate();
+  if (!kDelegate(cc).IsEmpty()) {
+    delegate_options.MergeFrom(kDelegate(cc).Get());
+  }
+  // Interpreters built with different op resolvers are not shared.
+  const tflite::OpResolver* op_resolver =
+      kSideInOpResolver(cc).IsConnected() ||
+              kSideInCustomOpResolver(cc).IsConnected()
+          ? &op_resolver_packet.Get()
+          : nullptr;
+  return tasks::core::MaybeCreatePooledInferenceRunner(
+      cc, *model_packet.Get(), op_resolver, delegate_options,
+      interpreter_num_threads, create_runner);
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
-InferenceCalculatorCpuImpl::MaybeCreateDelegate(CalculatorContext* cc) {
+InferenceCalculatorCpuImpl::MaybeCreateDelegate(
+    CalculatorContext* cc, const tflite::FlatBufferModel& model,
+    std::shared_ptr<XnnpackWeightsCache>* weights_cache) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   auto opts_delegate = calculator_opts.delegate();
@@ -154,10 +188,27 @@ InferenceCalculatorCpuImpl::MaybeCreateDelegate(CalculatorContext* cc) {
 
   if (use_xnnpack) {
     auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
-    xnnpack_opts.num_threads =
-        GetXnnpackNumThreads(opts_has_delegate, opts_delegate);
-    return TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
-                             &TfLiteXNNPackDelegateDelete);
+    // The delegate's threads count against the process-wide thread budget.
+    std::shared_ptr<SharedExecutorRegistry::ThreadReservation> threads =
+        SharedExecutorRegistry::Get().ReserveThreads(
+            GetXnnpackNumThreads(opts_has_delegate, opts_delegate));
+    xnnpack_opts.num_threads = threads->num_threads();
+    if (opts_delegate.xnnpack().share_weights_cache()) {
+      // The packed weights do not depend on the op resolver.
+      const std::string weights_cache_key =
+          tasks::core::InferenceRunnerPool::GetRunnerKey(
+              model, /*op_resolver=*/nullptr, opts_delegate,
+              /*num_threads=*/0);
+      MP_ASSIGN_OR_RETURN(*weights_cache,
+                          XnnpackWeightsCache::GetOrCreate(weights_cache_key));
+      xnnpack_opts.weights_cache = (*weights_cache)->get();
+    }
+    // The delegate holds on to the weights cache until it is deleted.
+    return TfLiteDelegatePtr(
+        TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+        [threads, weights_cache = *weights_cache](TfLiteDelegate* delegate) {
+          TfLiteXNNPackDelegateDelete(delegate);
+        });
   }
 
   return nullptr;
@@ -25,6 +25,7 @@
 #include "absl/time/time.h"
 #include "mediapipe/calculators/tensor/inference_calculator.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_feedback_manager.h"
 #include "mediapipe/calculators/tensor/inference_io_mapper.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
 #include "mediapipe/framework/api2/node.h"
@@ -86,6 +87,9 @@ class InferenceCalculatorGlImpl
     std::vector<std::unique_ptr<Tensor>> gpu_buffers_out_;
     size_t output_size_ = 0;
     InputOutputTensorNames input_output_tensor_names_;
+    // Set if the model has feedback tensors. They stay in gpu_buffers_out_ /
+    // gpu_buffers_in_ and are forwarded with GPU buffer copies.
+    std::unique_ptr<InferenceFeedbackManager> feedback_manager_;
   };
 
   absl::StatusOr<std::vector<Tensor>> Process(
@@ -99,6 +103,7 @@ class InferenceCalculatorGlImpl
 
 InferenceCalculatorGlImpl::GpuInferenceRunner::~GpuInferenceRunner() {
   init_gl_context_->Run([this]() {
+    feedback_manager_ = nullptr;
     gpu_buffers_in_.clear();
     gpu_buffers_out_.clear();
     // Delegate must outlive the interpreter, hence the order is important.
@@ -168,6 +173,22 @@ InferenceCalculatorGlImpl::GpuInferenceRunner::LoadDelegateAndAllocateTensors(
   RET_CHECK_NE(
       interpreter_->tensor(interpreter_->inputs()[0])->quantization.type,
       kTfLiteAffineQuantization);
+
+  const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
+  if (options.has_input_output_config()) {
+    feedback_manager_ = std::make_unique<InferenceFeedbackManager>();
+    MP_RETURN_IF_ERROR(feedback_manager_->Init(options.input_output_config(),
+                                               input_output_tensor_names_,
+                                               interpreter_.get()));
+    // The first inference step reads zeros from the feedback inputs.
+    for (const auto& link : feedback_manager_->GetFeedbackTensorLinks()) {
+      Tensor& feedback_input = *gpu_buffers_in_[link.to_idx];
+      const std::vector<char> zeros(feedback_input.bytes(), 0);
+      auto write_view = feedback_input.GetOpenGlBufferWriteView();
+      glBindBuffer(GL_COPY_WRITE_BUFFER, write_view.name());
+      glBufferSubData(GL_COPY_WRITE_BUFFER, 0, zeros.size(), zeros.data());
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -237,12 +258,24 @@ absl::Status InferenceCalculatorGlImpl::GpuInferenceRunner::LoadDelegate(
 absl::Status InferenceCalculatorGlImpl::GpuInferenceRunner::Process(
     CalculatorContext* cc, const TensorSpan& input_tensors,
     std::vector<Tensor>& output_tensors) {
-  // Explicitly copy input.
+  const int num_feedback_tensors =
+      feedback_manager_ ? feedback_manager_->GetNumberOfFeedbackTensors() : 0;
+  RET_CHECK_EQ(input_tensors.size() + num_feedback_tensors,
+               gpu_buffers_in_.size());
+
+  // Explicitly copy input. Feedback inputs already hold the feedback outputs
+  // of the previous step.
   for (int i = 0; i < input_tensors.size(); ++i) {
+    int model_input_idx = i;
+    if (feedback_manager_) {
+      MP_ASSIGN_OR_RETURN(model_input_idx,
+                          feedback_manager_->MapInputTensorToModelIndex(i));
+    }
     glBindBuffer(GL_COPY_READ_BUFFER,
                  input_tensors[i].GetOpenGlBufferReadView().name());
-    glBindBuffer(GL_COPY_WRITE_BUFFER,
-                 gpu_buffers_in_[i]->GetOpenGlBufferWriteView().name());
+    glBindBuffer(
+        GL_COPY_WRITE_BUFFER,
+        gpu_buffers_in_[model_input_idx]->GetOpenGlBufferWriteView().name());
     glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
                         input_tensors[i].bytes());
   }
@@ -253,8 +286,29 @@ absl::Status InferenceCalculatorGlImpl::GpuInferenceRunner::Process(
     RET_CHECK_EQ(interpreter_->Invoke(), kTfLiteOk);
   }
 
-  output_tensors.reserve(output_size_);
+  // Forward the feedback outputs to the feedback inputs of the next step.
+  // The buffers are bound to the delegate, so their handles cannot be
+  // swapped; the copy stays on the GPU.
+  if (feedback_manager_) {
+    for (const auto& link : feedback_manager_->GetFeedbackTensorLinks()) {
+      const Tensor& feedback_output = *gpu_buffers_out_[link.from_idx];
+      glBindBuffer(GL_COPY_READ_BUFFER,
+                   feedback_output.GetOpenGlBufferReadView().name());
+      glBindBuffer(
+          GL_COPY_WRITE_BUFFER,
+          gpu_buffers_in_[link.to_idx]->GetOpenGlBufferWriteView().name());
+      glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                          feedback_output.bytes());
+    }
+  }
+
+  output_tensors.reserve(output_size_ - num_feedback_tensors);
   for (int i = 0; i < output_size_; ++i) {
+    if (feedback_manager_ &&
+        feedback_manager_->IsFeedbackOutputTensorAtIndex(i)) {
+      // Feedback tensors are not part of the calculator output.
+      continue;
+    }
     const auto& t = gpu_buffers_out_[i];
     output_tensors.emplace_back(Tensor::ElementType::kFloat32,
                                 gpu_buffers_out_[i]->shape());
@@ -281,7 +335,6 @@ absl::Status InferenceCalculatorGlImpl::UpdateContract(CalculatorContract* cc) {
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
       << "Either model as side packet or model path in options is required.";
 
-  WarnFeedbackTensorsUnsupported(cc);
   return mediapipe::GlCalculatorHelper::UpdateContract(cc);
 }
 
@@ -289,8 +342,9 @@ absl::Status InferenceCalculatorGlImpl::Open(CalculatorContext* cc) {
   MP_RETURN_IF_ERROR(gpu_helper_.Open(cc));
 
   MP_ASSIGN_OR_RETURN(gpu_inference_runner_, CreateInferenceRunner(cc));
-  return InferenceCalculatorNodeImpl::UpdateIoMapping(
-      cc, gpu_inference_runner_->GetInputOutputTensorNames());
+  MP_RETURN_IF_ERROR(InferenceCalculatorNodeImpl::UpdateIoMapping(
+      cc, gpu_inference_runner_->GetInputOutputTensorNames()));
+  return WarmUp(cc);
 }
 
 absl::StatusOr<std::vector<Tensor>> InferenceCalculatorGlImpl::Process(
@@ -305,6 +359,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorGlImpl::Process(
 }
 
 absl::Status InferenceCalculatorGlImpl::Close(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(FlushBatch(cc));
   gpu_inference_runner_ = nullptr;
   return absl::OkStatus();
 }
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -89,6 +91,12 @@ class InferenceCalculatorGlAdvancedImpl
 
     std::vector<Tensor::Shape> output_shapes_;
 
+    // Completion of the inferences that may still be running on the GPU,
+    // oldest first. Every frame binds freshly allocated output tensors, so
+    // each of these inferences writes to its own buffers.
+    std::deque<GlSyncToken> in_flight_;
+    int max_frames_in_flight_ = 1;
+
     InferenceOnDiskCacheHelper on_disk_cache_helper_;
 
     InputOutputTensorNames input_output_tensor_names_;
@@ -106,6 +114,10 @@ class InferenceCalculatorGlAdvancedImpl
 InferenceCalculatorGlAdvancedImpl::GpuInferenceRunner::~GpuInferenceRunner() {
   const auto success =
       initialization_gl_context_->Run([this]() -> absl::Status {
+        for (const GlSyncToken& token : in_flight_) {
+          token->Wait();
+        }
+        in_flight_.clear();
         tflite_gpu_runner_.reset();
         return absl::OkStatus();
       });
@@ -133,6 +145,7 @@ absl::Status InferenceCalculatorGlAdvancedImpl::GpuInferenceRunner::Init(
   }
 
   MP_RETURN_IF_ERROR(on_disk_cache_helper_.Init(options, delegate.gpu()));
+  max_frames_in_flight_ = std::max(1, delegate.gpu().max_frames_in_flight());
 
   return initialization_gl_context_->Run(
       [this, &cc, &delegate]() -> absl::Status {
@@ -143,6 +156,14 @@ absl::Status InferenceCalculatorGlAdvancedImpl::GpuInferenceRunner::Init(
 absl::StatusOr<std::vector<Tensor>>
 InferenceCalculatorGlAdvancedImpl::GpuInferenceRunner::Process(
     CalculatorContext* cc, const TensorSpan& input_tensors) {
+  // Let the uploads and readbacks of this frame overlap the inference of up to
+  // max_frames_in_flight_ previous ones, but do not queue more than that.
+  while (!in_flight_.empty() &&
+         (static_cast<int>(in_flight_.size()) >= max_frames_in_flight_ ||
+          in_flight_.front()->IsReady())) {
+    in_flight_.front()->Wait();
+    in_flight_.pop_front();
+  }
   std::vector<Tensor> output_tensors;
   for (int i = 0; i < input_tensors.size(); ++i) {
     MP_RETURN_IF_ERROR(tflite_gpu_runner_->BindSSBOToInputTensor(
@@ -158,7 +179,8 @@ InferenceCalculatorGlAdvancedImpl::GpuInferenceRunner::Process(
   // Run inference.
   {
     MEDIAPIPE_PROFILING(GPU_TASK_INVOKE_ADVANCED, cc);
-    MP_RETURN_IF_ERROR(tflite_gpu_runner_->Invoke());
+    MP_ASSIGN_OR_RETURN(GlSyncToken done, tflite_gpu_runner_->InvokeAsync());
+    in_flight_.push_back(std::move(done));
   }
   return output_tensors;
 }
@@ -270,8 +292,9 @@ absl::Status InferenceCalculatorGlAdvancedImpl::Open(CalculatorContext* cc) {
   gpu_inference_runner_ = std::make_unique<GpuInferenceRunner>();
   MP_RETURN_IF_ERROR(
       gpu_inference_runner_->Init(cc, gpu_helper_.GetSharedGlContext()));
-  return InferenceCalculatorNodeImpl::UpdateIoMapping(
-      cc, gpu_inference_runner_->GetInputOutputTensorNames());
+  MP_RETURN_IF_ERROR(InferenceCalculatorNodeImpl::UpdateIoMapping(
+      cc, gpu_inference_runner_->GetInputOutputTensorNames()));
+  return WarmUp(cc);
 }
 
 absl::StatusOr<std::vector<Tensor>> InferenceCalculatorGlAdvancedImpl::Process(
@@ -286,6 +309,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorGlAdvancedImpl::Process(
 }
 
 absl::Status InferenceCalculatorGlAdvancedImpl::Close(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(FlushBatch(cc));
   gpu_inference_runner_.reset();
 
   return absl::OkStatus();
@@ -102,6 +102,16 @@ class InferenceCalculatorMetalImpl
   void AddDelegate(CalculatorContext* cc,
                    tflite::InterpreterBuilder* interpreter_builder);
   absl::Status CreateConverters(CalculatorContext* cc);
+#if MEDIAPIPE_TFLITE_METAL_INFERENCE
+  // Whether the input can be copied into the delegate buffer as is, without
+  // layout or precision conversion.
+  bool IsBphwc4Compatible(const Tensor& input, const tflite::gpu::BHWC& shape,
+                          const Tensor& delegate_input) const {
+    return !allow_precision_loss_ &&
+           input.element_type() == Tensor::ElementType::kFloat32 &&
+           shape.c == 4 && input.bytes() == delegate_input.bytes();
+  }
+#endif  // MEDIAPIPE_TFLITE_METAL_INFERENCE
 
   // TfLite requires us to keep the model alive as long as the interpreter is.
   Packet<TfLiteModelPtr> model_packet_;
@@ -143,7 +153,8 @@ absl::Status InferenceCalculatorMetalImpl::Open(CalculatorContext* cc) {
 
   gpu_helper_ = [[MPPMetalHelper alloc] initWithCalculatorContext:cc];
   RET_CHECK(gpu_helper_);
-  return InitInterpreter(cc);
+  MP_RETURN_IF_ERROR(InitInterpreter(cc));
+  return WarmUp(cc);
 }
 
 absl::StatusOr<std::vector<Tensor>> InferenceCalculatorMetalImpl::Process(
@@ -162,6 +173,19 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorMetalImpl::Process(
     tflite::gpu::BHWC shape = BhwcFromTensorShape(tensor_span[i].shape());
     auto gpu_buffer_view =
         MtlBufferView::GetWriteView(*gpu_buffers_in_[i], command_buffer);
+    if (IsBphwc4Compatible(tensor_span[i], shape, *gpu_buffers_in_[i])) {
+      // With 4 channels BHWC and BPHWC4 have the same layout, e.g. for the
+      // output of ImageToTensorCalculator, so a plain copy is enough.
+      id<MTLBlitCommandEncoder> blit_encoder =
+          [command_buffer blitCommandEncoder];
+      [blit_encoder copyFromBuffer:input_view.buffer()
+                      sourceOffset:0
+                          toBuffer:gpu_buffer_view.buffer()
+                 destinationOffset:0
+                              size:tensor_span[i].bytes()];
+      [blit_encoder endEncoding];
+      continue;
+    }
     id<MTLComputeCommandEncoder> input_encoder =
         [command_buffer computeCommandEncoder];
     [converter_to_BPHWC4_ convertWithEncoder:input_encoder
@@ -204,6 +228,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorMetalImpl::Process(
 }
 
 absl::Status InferenceCalculatorMetalImpl::Close(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(FlushBatch(cc));
   converter_to_BPHWC4_ = nil;
   converter_from_BPHWC4_ = nil;
   gpu_buffers_in_.clear();
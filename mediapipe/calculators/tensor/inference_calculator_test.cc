@@ -253,6 +253,82 @@ TEST(InferenceCalculatorTest, SmokeTestTfliteWithTensorAlignment) {
       /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/true);
 }
 
+TEST(InferenceCalculatorTest, SmokeTestTfliteWithWarmup) {
+  DoSmokeTest(
+      /*graph_proto=*/absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate",
+            "delegate { tflite {} } warmup { num_invocations: 2 }"},
+           {"$mmap", "false"}}),
+      /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/false);
+}
+TEST(InferenceCalculatorTest, SmokeTestXnnpackWithWarmup) {
+  DoSmokeTest(
+      /*graph_proto=*/absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate",
+            "delegate { xnnpack {} } warmup { num_invocations: 1 }"},
+           {"$mmap", "false"}}),
+      /*use_vectors=*/true, /*apply_default_tflite_tensor_alignment=*/false);
+}
+
+// Runs `num_packets` inputs through the add model with batching, where the
+// input values of packet i are i + 1, and checks that each output holds the
+// result for its own input at its own timestamp.
+void RunBatchedGraph(int num_packets, int max_batch_size) {
+  CalculatorGraphConfig graph_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig>(absl::StrReplaceAll(
+          kGraphWithModelPathInOption,
+          {{"$delegate", absl::StrCat("delegate { tflite {} } batching { ",
+                                      "max_batch_size: ", max_batch_size,
+                                      " }")},
+           {"$mmap", "false"}}));
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensor_out", &graph_config, &output_packets);
+  CalculatorGraph graph(graph_config);
+  MP_ASSERT_OK(graph.StartRun({}));
+  for (int i = 0; i < num_packets; ++i) {
+    std::vector<Tensor> input_vec =
+        CreateInputs(/*apply_default_tflite_tensor_alignment=*/false);
+    {
+      auto view = input_vec[0].GetCpuWriteView();
+      float* buffer = view.buffer<float>();
+      for (int j = 0; j < input_vec[0].shape().num_elements(); ++j) {
+        buffer[j] = i + 1;
+      }
+    }
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "tensor_in", MakePacket<std::vector<Tensor>>(std::move(input_vec))
+                         .At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.CloseInputStream("tensor_in"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  ASSERT_EQ(output_packets.size(), num_packets);
+  for (int i = 0; i < num_packets; ++i) {
+    EXPECT_EQ(output_packets[i].Timestamp(), Timestamp(i));
+    const auto& result_vec = output_packets[i].Get<std::vector<Tensor>>();
+    ASSERT_EQ(result_vec.size(), 1);
+    const Tensor& result = result_vec[0];
+    EXPECT_EQ(result.shape().dims,
+              std::vector<int>({1, kTensorHeight, kTensorWidth,
+                                kTensorChannels}));
+    auto view = result.GetCpuReadView();
+    const float* result_buffer = view.buffer<float>();
+    for (int j = 0; j < result.shape().num_elements(); ++j) {
+      ASSERT_EQ(result_buffer[j], 3 * (i + 1));
+    }
+  }
+}
+
+TEST(InferenceCalculatorTest, BatchesFullBatchAndSendsOutputsPerTimestamp) {
+  RunBatchedGraph(/*num_packets=*/3, /*max_batch_size=*/3);
+}
+
+TEST(InferenceCalculatorTest, BatchesAndFlushesPartialBatchOnClose) {
+  RunBatchedGraph(/*num_packets=*/5, /*max_batch_size=*/2);
+}
+
 void BM_InitializeCalculator(benchmark::State& state) {
   mediapipe::InferenceCalculatorOptions::Delegate delegate;
   delegate.mutable_tflite();
@@ -14,6 +14,7 @@
 
 #include "mediapipe/calculators/tensor/inference_calculator_utils.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <ostream>
@@ -36,7 +37,9 @@
 #include "mediapipe/framework/port/status_macros.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
 #include "tensorflow/lite/portable_type_to_tflitetype.h"
+#include "tensorflow/lite/schema/schema_generated.h"
 #include "tensorflow/lite/string_util.h"
 
 ABSL_FLAG(int, xnnpack_default_num_threads, 0,
@@ -365,6 +368,14 @@ absl::StatusOr<Tensor> CreateTensorWithTfLiteTensorSpecs(
     shape = std::vector<int>(reference_tflite_tensor.dims->data,
                              reference_tflite_tensor.dims->data +
                                  reference_tflite_tensor.dims->size);
+    // Outputs with a dynamic dimension in the model signature, e.g. a batch
+    // dimension, resize the interpreter of a downstream model they feed.
+    const TfLiteIntArray* signature = reference_tflite_tensor.dims_signature;
+    if (signature != nullptr) {
+      shape.is_dynamic =
+          std::find(signature->data, signature->data + signature->size, -1) !=
+          signature->data + signature->size;
+    }
   } else {
     ABSL_LOG(ERROR) << "TfLite tensor with empty dimensions: "
                     << GetTfLiteTensorDebugInfo(reference_tflite_tensor)
@@ -416,4 +427,61 @@ absl::StatusOr<Tensor> CreateTensorWithTfLiteTensorSpecs(
                    TfLiteTypeGetName(reference_tflite_tensor.type)));
 }
 
+absl::StatusOr<std::vector<Tensor>> CreateZeroFilledInputTensors(
+    const tflite::FlatBufferModel& model) {
+  const tflite::Model* flatbuffer = model.GetModel();
+  RET_CHECK(flatbuffer != nullptr && flatbuffer->subgraphs() != nullptr &&
+            flatbuffer->subgraphs()->size() > 0)
+      << "Model has no subgraph.";
+  const tflite::SubGraph* subgraph = flatbuffer->subgraphs()->Get(0);
+  RET_CHECK(subgraph->inputs() != nullptr && subgraph->tensors() != nullptr)
+      << "Model subgraph has no input tensors.";
+
+  std::vector<Tensor> tensors;
+  tensors.reserve(subgraph->inputs()->size());
+  for (const int32_t index : *subgraph->inputs()) {
+    RET_CHECK(index >= 0 &&
+              index < static_cast<int>(subgraph->tensors()->size()))
+        << "Invalid input tensor index " << index;
+    const tflite::Tensor* tflite_tensor = subgraph->tensors()->Get(index);
+    Tensor::ElementType element_type;
+    switch (tflite_tensor->type()) {
+      case tflite::TensorType_FLOAT16:
+        element_type = Tensor::ElementType::kFloat16;
+        break;
+      case tflite::TensorType_FLOAT32:
+        element_type = Tensor::ElementType::kFloat32;
+        break;
+      case tflite::TensorType_UINT8:
+        element_type = Tensor::ElementType::kUInt8;
+        break;
+      case tflite::TensorType_INT8:
+        element_type = Tensor::ElementType::kInt8;
+        break;
+      case tflite::TensorType_INT32:
+        element_type = Tensor::ElementType::kInt32;
+        break;
+      case tflite::TensorType_INT64:
+        element_type = Tensor::ElementType::kInt64;
+        break;
+      case tflite::TensorType_BOOL:
+        element_type = Tensor::ElementType::kBool;
+        break;
+      default:
+        return absl::InvalidArgumentError(absl::StrCat(
+            "Unsupported input tensor type:",
+            tflite::EnumNameTensorType(tflite_tensor->type())));
+    }
+    std::vector<int> dims;
+    if (tflite_tensor->shape() != nullptr) {
+      dims.assign(tflite_tensor->shape()->begin(),
+                  tflite_tensor->shape()->end());
+    }
+    tensors.emplace_back(element_type, Tensor::Shape(dims));
+    auto view = tensors.back().GetCpuWriteView();
+    std::memset(view.buffer<char>(), 0, tensors.back().bytes());
+  }
+  return tensors;
+}
+
 }  // namespace mediapipe
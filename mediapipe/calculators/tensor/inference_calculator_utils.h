@@ -17,6 +17,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "absl/flags/declare.h"
 #include "absl/status/status.h"
@@ -26,6 +27,7 @@
 #include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/model_builder.h"
 #include "tensorflow/lite/util.h"
 
 ABSL_DECLARE_FLAG(int, xnnpack_default_num_threads);
@@ -78,11 +80,18 @@ absl::Status SetTfLiteCustomAllocation(tflite::Interpreter& interpreter,
 
 // Creates a new MP Tensor instance that matches the size and type of the
 // specified TfLite tensor. If optional 'alignment' is specified, the returned
-// tensor will be byte aligned to that value.
+// tensor will be byte aligned to that value. The shape is marked dynamic if the
+// TfLite tensor signature has a dynamic dimension.
 absl::StatusOr<Tensor> CreateTensorWithTfLiteTensorSpecs(
     const TfLiteTensor& reference_tflite_tensor,
     MemoryManager* memory_manager = nullptr, int alignment = 0);
 
+// Creates zero-filled tensors with the shapes and types of the inputs of the
+// primary subgraph of `model`, in the order of the model inputs. Returns
+// InvalidArgumentError for input types that have no MP Tensor equivalent.
+absl::StatusOr<std::vector<Tensor>> CreateZeroFilledInputTensors(
+    const tflite::FlatBufferModel& model);
+
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_CALCULATORS_TENSOR_INFERENCE_CALCULATOR_UTILS_H_
@@ -25,10 +25,13 @@
 #include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
 #include "mediapipe/calculators/tensor/inference_runner.h"
 #include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/calculators/tensor/xnnpack_weights_cache.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/shared_executor_registry.h"
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
 #include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
 
 namespace mediapipe {
@@ -48,7 +51,11 @@ class InferenceCalculatorXnnpackImpl
       CalculatorContext* cc, const TensorSpan& tensor_span) override;
   absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunner(
       CalculatorContext* cc);
-  absl::StatusOr<TfLiteDelegatePtr> CreateDelegate(CalculatorContext* cc);
+  // Creates the delegate of an interpreter for `model`. If the delegate uses a
+  // shared XNNPACK weights cache, returns it in `weights_cache`.
+  absl::StatusOr<TfLiteDelegatePtr> CreateDelegate(
+      CalculatorContext* cc, const tflite::FlatBufferModel& model,
+      std::shared_ptr<XnnpackWeightsCache>* weights_cache);
 
   std::unique_ptr<InferenceRunner> inference_runner_;
 };
@@ -61,13 +68,16 @@ absl::Status InferenceCalculatorXnnpackImpl::UpdateContract(
   RET_CHECK(!options.model_path().empty() ^ kSideInModel(cc).IsConnected())
       << "Either model as side packet or model path in options is required.";
 
+  cc->UseService(tasks::core::kInferenceRunnerPoolService).Optional();
+
   return absl::OkStatus();
 }
 
 absl::Status InferenceCalculatorXnnpackImpl::Open(CalculatorContext* cc) {
   MP_ASSIGN_OR_RETURN(inference_runner_, CreateInferenceRunner(cc));
-  return InferenceCalculatorNodeImpl::UpdateIoMapping(
-      cc, inference_runner_->GetInputOutputTensorNames());
+  MP_RETURN_IF_ERROR(InferenceCalculatorNodeImpl::UpdateIoMapping(
+      cc, inference_runner_->GetInputOutputTensorNames()));
+  return WarmUp(cc);
 }
 
 absl::StatusOr<std::vector<Tensor>> InferenceCalculatorXnnpackImpl::Process(
@@ -78,6 +88,7 @@ absl::StatusOr<std::vector<Tensor>> InferenceCalculatorXnnpackImpl::Process(
 }
 
 absl::Status InferenceCalculatorXnnpackImpl::Close(CalculatorContext* cc) {
+  MP_RETURN_IF_ERROR(FlushBatch(cc));
   inference_runner_ = nullptr;
   return absl::OkStatus();
 }
@@ -89,16 +100,40 @@ InferenceCalculatorXnnpackImpl::CreateInferenceRunner(CalculatorContext* cc) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   const int interpreter_num_threads = calculator_opts.cpu_num_thread();
-  MP_ASSIGN_OR_RETURN(TfLiteDelegatePtr delegate, CreateDelegate(cc));
-  return CreateInferenceInterpreterDelegateRunner(
-      std::move(model_packet), std::move(op_resolver_packet),
-      std::move(delegate), interpreter_num_threads,
-      &calculator_opts.input_output_config(),
-      calculator_opts.delegate().xnnpack().enable_zero_copy_tensor_io());
+  auto create_runner =
+      [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    std::shared_ptr<XnnpackWeightsCache> weights_cache;
+    MP_ASSIGN_OR_RETURN(
+        TfLiteDelegatePtr delegate,
+        CreateDelegate(cc, *model_packet.Get(), &weights_cache));
+    MP_ASSIGN_OR_RETURN(
+        auto runner,
+        CreateInferenceInterpreterDelegateRunner(
+            model_packet, op_resolver_packet, std::move(delegate),
+            interpreter_num_threads, &calculator_opts.input_output_config(),
+            calculator_opts.delegate().xnnpack().enable_zero_copy_tensor_io()));
+    if (weights_cache) MP_RETURN_IF_ERROR(weights_cache->Finalize());
+    return runner;
+  };
+  auto delegate_options = calculator_opts.delegate();
+  if (!kDelegate(cc).IsEmpty()) {
+    delegate_options.MergeFrom(kDelegate(cc).Get());
+  }
+  // Interpreters built with different op resolvers are not shared.
+  const tflite::OpResolver* op_resolver =
+      kSideInOpResolver(cc).IsConnected() ||
+              kSideInCustomOpResolver(cc).IsConnected()
+          ? &op_resolver_packet.Get()
+          : nullptr;
+  return tasks::core::MaybeCreatePooledInferenceRunner(
+      cc, *model_packet.Get(), op_resolver, delegate_options,
+      interpreter_num_threads, create_runner);
 }
 
 absl::StatusOr<TfLiteDelegatePtr>
-InferenceCalculatorXnnpackImpl::CreateDelegate(CalculatorContext* cc) {
+InferenceCalculatorXnnpackImpl::CreateDelegate(
+    CalculatorContext* cc, const tflite::FlatBufferModel& model,
+    std::shared_ptr<XnnpackWeightsCache>* weights_cache) {
   const auto& calculator_opts =
       cc->Options<mediapipe::InferenceCalculatorOptions>();
   auto opts_delegate = calculator_opts.delegate();
@@ -117,10 +152,27 @@ InferenceCalculatorXnnpackImpl::CreateDelegate(CalculatorContext* cc) {
       calculator_opts.has_delegate() || !kDelegate(cc).IsEmpty();
 
   auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
-  xnnpack_opts.num_threads =
-      GetXnnpackNumThreads(opts_has_delegate, opts_delegate);
-  return TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
-                           &TfLiteXNNPackDelegateDelete);
+  // The delegate's threads count against the process-wide thread budget.
+  std::shared_ptr<SharedExecutorRegistry::ThreadReservation> threads =
+      SharedExecutorRegistry::Get().ReserveThreads(
+          GetXnnpackNumThreads(opts_has_delegate, opts_delegate));
+  xnnpack_opts.num_threads = threads->num_threads();
+  if (opts_delegate.xnnpack().share_weights_cache()) {
+    // The packed weights do not depend on the op resolver.
+    const std::string weights_cache_key =
+        tasks::core::InferenceRunnerPool::GetRunnerKey(
+            model, /*op_resolver=*/nullptr, opts_delegate,
+            /*num_threads=*/0);
+    MP_ASSIGN_OR_RETURN(*weights_cache,
+                        XnnpackWeightsCache::GetOrCreate(weights_cache_key));
+    xnnpack_opts.weights_cache = (*weights_cache)->get();
+  }
+  // The delegate holds on to the weights cache until it is deleted.
+  return TfLiteDelegatePtr(
+      TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+      [threads, weights_cache = *weights_cache](TfLiteDelegate* delegate) {
+        TfLiteXNNPackDelegateDelete(delegate);
+      });
 }
 
 }  // namespace api2
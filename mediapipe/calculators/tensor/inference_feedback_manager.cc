@@ -71,8 +71,11 @@ absl::Status InferenceFeedbackManager::Init(
         << "Feedback tensors must have the same spec.";
     // Since the TfLite API isn't specific about the initialization of newly
     // allocated Tensor memory, we initialize the input to_tensor tensor with
-    // zeros.
-    memset(to_tensor->data.raw, 0, to_tensor->bytes);
+    // zeros. Tensors without CPU memory, e.g. ones bound to GPU buffers, are
+    // initialized by their runner.
+    if (to_tensor->data.raw != nullptr) {
+      memset(to_tensor->data.raw, 0, to_tensor->bytes);
+    }
   }
 
   // Populate input_tensor_to_model_indices_ which maps InferenceRunner input
@@ -20,6 +20,12 @@ namespace mediapipe {
 // and efficiently swaps them from output to input with zero copies.
 class InferenceFeedbackManager {
  public:
+  // Links between feedback tensors defined by model tensor indices.
+  struct TensorFeedbackIndicesLink {
+    int from_idx;
+    int to_idx;
+  };
+
   // Initializes the feedback tensors with zeros and generates
   // feedback_tensor_indices_links_. The provided interpreter must outlive the
   // InferenceFeedbackManager instance.
@@ -49,12 +55,16 @@ class InferenceFeedbackManager {
   // Returns true if the tensor at the given index is a feedback output tensor.
   bool IsFeedbackOutputTensorAtIndex(int idx) const;
 
+  // Returns the feedback links as model output / input indices. Runners that
+  // keep tensors outside of the interpreter, e.g. in GPU buffers bound to the
+  // delegate, use them to forward the feedback tensors themselves instead of
+  // calling SwapFeedbackTensors.
+  const std::vector<TensorFeedbackIndicesLink>& GetFeedbackTensorLinks()
+      const {
+    return feedback_tensor_indices_links_;
+  }
+
  private:
-  // Links between feedback tensors defined by model tensor indices.
-  struct TensorFeedbackIndicesLink {
-    int from_idx;
-    int to_idx;
-  };
 
   // Translates the tensor names from the input/output config into the
   // corresponding TfLite tensor indices.
@@ -189,14 +189,20 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
           interpreter_tensor->dims->data,
           interpreter_tensor->dims->data + interpreter_tensor->dims->size};
       if (interpreter_dims != input_tensor.shape().dims) {
-        interpreter_->ResizeInputTensorStrict(input_tensor_index,
-                                              input_tensor.shape().dims);
+        RET_CHECK_EQ(interpreter_->ResizeInputTensorStrict(
+                         interpreter_->inputs()[input_tensor_index],
+                         input_tensor.shape().dims),
+                     kTfLiteOk);
         resized_tensor_shapes = true;
       }
     }
   }
-  // Reallocation is needed for memory sanity.
-  if (resized_tensor_shapes) interpreter_->AllocateTensors();
+  // Reallocation is needed for memory sanity. Shapes only change when the
+  // input length does, e.g. when a text preprocessor switches sequence length
+  // buckets, so steady-state inference does not reallocate.
+  if (resized_tensor_shapes) {
+    RET_CHECK_EQ(interpreter_->AllocateTensors(), kTfLiteOk);
+  }
 
   // TODO: Replace this using the util function in
   // inference_calculator_utils.
@@ -241,9 +247,9 @@ absl::StatusOr<std::vector<Tensor>> InferenceInterpreterDelegateRunner::Run(
     }
   }
 
-  // Reallocation is needed for memory sanity.
-  if (resized_tensor_shapes || !input_tensor_views.empty() ||
-      !output_tensor_views.empty()) {
+  // Custom allocations take effect on reallocation. Resized tensors have
+  // already been reallocated above.
+  if (!input_tensor_views.empty() || !output_tensor_views.empty()) {
     interpreter_->AllocateTensors();
   }
 
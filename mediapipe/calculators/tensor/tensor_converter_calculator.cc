@@ -23,6 +23,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/optional.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/tensor/tensor_converter_calculator.pb.h"
 #include "mediapipe/calculators/tensor/tensor_converter_cpu.h"
 #include "mediapipe/calculators/tensor/tensor_converter_gpu.h"
@@ -89,10 +90,12 @@ absl::StatusOr<bool> ShouldFlipVertically(
 }
 
 constexpr char kImageFrameTag[] = "IMAGE";
+constexpr char kImageFramesTag[] = "IMAGES";
 constexpr char kGpuBufferTag[] = "IMAGE_GPU";
 constexpr char kTensorsTag[] = "TENSORS";
 constexpr char kTensorTag[] = "TENSOR";
 constexpr char kMatrixTag[] = "MATRIX";
+constexpr char kMatricesTag[] = "MATRICES";
 
 constexpr std::pair<float, float> kDefaultOutputRange = {0.0f, 1.0f};
 
@@ -106,14 +109,19 @@ namespace mediapipe {
 // This calculator is designed to be used with the TfLiteInferenceCalculator,
 // as a pre-processing step for calculator inputs.
 //
-// IMAGE and IMAGE_GPU inputs are normalized to [-1,1] (default) or [0,1],
-// specified by options (unless outputting a quantized tensor).
+// IMAGE, IMAGES and IMAGE_GPU inputs are normalized to [-1,1] (default) or
+// [0,1], specified by options (unless outputting a quantized tensor).
 //
 // Input:
 //  One of the following tags:
 //  IMAGE - ImageFrame (assumed to be 8-bit or 32-bit data).
+//  IMAGES - std::vector<ImageFrame>, converted to a single tensor batched
+//           along the first dimension. All images must have the same format
+//           and size.
 //  IMAGE_GPU - GpuBuffer (assumed to be RGBA or RGB GL texture).
 //  MATRIX - Matrix.
+//  MATRICES - std::vector<Matrix>, converted to a single batched tensor. All
+//             matrices must have the same size.
 //
 // Output:
 //  One of the following tags:
@@ -122,6 +130,8 @@ namespace mediapipe {
 //          - SSBO if Metal is unavailable and OpenGL ES 3.1 is available
 //          - Texture2D if Metal and GLES 3.1 are not available and GLES 3.0 is.
 //  TENSOR  - Tensor of type kFloat32. Resource type same as in TENSORS
+//  With use_quantized_tensors, 8-bit CPU images are output as kUInt8 tensors
+//  holding the unnormalized pixel values.
 //
 // Example use:
 // node {
@@ -162,6 +172,7 @@ class TensorConverterCalculator : public CalculatorBase {
   std::optional<std::pair<float, float>> output_range_;
   bool flip_vertically_ = false;
   bool row_major_matrix_ = false;
+  bool use_quantized_tensors_ = false;
   int max_num_channels_ = 3;
 
   std::unique_ptr<TensorConverterGpu> tensor_converter_gpu_;
@@ -174,17 +185,26 @@ REGISTER_CALCULATOR(TensorConverterCalculator);
 absl::Status TensorConverterCalculator::GetContract(CalculatorContract* cc) {
   // Confirm only one of the input streams is present.
   RET_CHECK(static_cast<int>(cc->Inputs().HasTag(kImageFrameTag)) +
+                static_cast<int>(cc->Inputs().HasTag(kImageFramesTag)) +
                 static_cast<int>(cc->Inputs().HasTag(kGpuBufferTag)) +
-                static_cast<int>(cc->Inputs().HasTag(kMatrixTag)) ==
+                static_cast<int>(cc->Inputs().HasTag(kMatrixTag)) +
+                static_cast<int>(cc->Inputs().HasTag(kMatricesTag)) ==
             1)
-      << "Only one input tag of {IMAGE, IMAGE_GPU, MATRIX} may be specified";
+      << "Only one input tag of {IMAGE, IMAGES, IMAGE_GPU, MATRIX, MATRICES} "
+         "may be specified";
 
   if (cc->Inputs().HasTag(kImageFrameTag)) {
     cc->Inputs().Tag(kImageFrameTag).Set<ImageFrame>();
   }
+  if (cc->Inputs().HasTag(kImageFramesTag)) {
+    cc->Inputs().Tag(kImageFramesTag).Set<std::vector<ImageFrame>>();
+  }
   if (cc->Inputs().HasTag(kMatrixTag)) {
     cc->Inputs().Tag(kMatrixTag).Set<Matrix>();
   }
+  if (cc->Inputs().HasTag(kMatricesTag)) {
+    cc->Inputs().Tag(kMatricesTag).Set<std::vector<Matrix>>();
+  }
   cc->UseService(kMemoryManagerService).Optional();
 #if !MEDIAPIPE_DISABLE_GPU
   if (cc->Inputs().HasTag(kGpuBufferTag)) {
@@ -286,11 +306,43 @@ absl::StatusOr<std::optional<Tensor>> TensorConverterCalculator::ProcessCPU(
         cc->Inputs().Tag(kImageFrameTag).Get<ImageFrame>();
     MP_ASSIGN_OR_RETURN(
         Tensor output,
-        ConvertImageFrameToTensorOnCpu(
-            image_frame,
+        ConvertImageFramesToTensorOnCpu(
+            absl::MakeConstSpan(&image_frame, 1),
             output_range_.has_value() ? output_range_.value()
                                       : kDefaultOutputRange,
-            flip_vertically_, max_num_channels_, memory_manager_));
+            flip_vertically_, max_num_channels_, use_quantized_tensors_,
+            memory_manager_));
+    return std::move(output);
+  } else if (cc->Inputs().HasTag(kImageFramesTag)) {
+    if (cc->Inputs().Tag(kImageFramesTag).IsEmpty()) {
+      return std::nullopt;
+    }
+    const auto& image_frames =
+        cc->Inputs().Tag(kImageFramesTag).Get<std::vector<ImageFrame>>();
+    if (image_frames.empty()) {
+      return std::nullopt;
+    }
+    MP_ASSIGN_OR_RETURN(
+        Tensor output,
+        ConvertImageFramesToTensorOnCpu(
+            image_frames,
+            output_range_.has_value() ? output_range_.value()
+                                      : kDefaultOutputRange,
+            flip_vertically_, max_num_channels_, use_quantized_tensors_,
+            memory_manager_));
+    return std::move(output);
+  } else if (cc->Inputs().HasTag(kMatricesTag)) {
+    if (cc->Inputs().Tag(kMatricesTag).IsEmpty()) {
+      return std::nullopt;
+    }
+    const auto& matrices =
+        cc->Inputs().Tag(kMatricesTag).Get<std::vector<Matrix>>();
+    if (matrices.empty()) {
+      return std::nullopt;
+    }
+    MP_ASSIGN_OR_RETURN(Tensor output,
+                        ConvertMatricesToTensorOnCpu(
+                            matrices, row_major_matrix_, memory_manager_));
     return std::move(output);
   } else if (cc->Inputs().HasTag(kMatrixTag)) {
     if (cc->Inputs().Tag(kMatrixTag).IsEmpty()) {
@@ -426,6 +478,9 @@ absl::Status TensorConverterCalculator::LoadOptions(CalculatorContext* cc,
   // Get row_major_matrix mode.
   row_major_matrix_ = options.row_major_matrix();
 
+  // Quantized output is only produced for CPU images.
+  use_quantized_tensors_ = options.use_quantized_tensors() && !use_gpu;
+
   // Get desired way to handle input channels.
   max_num_channels_ = options.max_num_channels();
   ABSL_CHECK_GE(max_num_channels_, 1);
@@ -370,6 +370,57 @@ TEST_F(TensorConverterCalculatorTest,
   MP_ASSERT_OK(graph.WaitUntilDone());
 }
 
+TEST_F(TensorConverterCalculatorTest, ShouldConvertImageBatch) {
+  CalculatorGraph graph;
+  CalculatorGraphConfig graph_config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(
+          R"pb(
+            input_stream: "input_images"
+            node {
+              calculator: "TensorConverterCalculator"
+              input_stream: "IMAGES:input_images"
+              output_stream: "TENSORS:tensor"
+              options {
+                [mediapipe.TensorConverterCalculatorOptions.ext] {
+                  zero_center: false
+                }
+              }
+            }
+          )pb");
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensor", &graph_config, &output_packets);
+
+  // Run the graph.
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  auto input_images = std::make_unique<std::vector<ImageFrame>>();
+  for (const uint8_t value : {200, 100}) {
+    ImageFrame& image = input_images->emplace_back(ImageFormat::GRAY8, 1, 1);
+    *image.MutablePixelData() = value;
+  }
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "input_images", Adopt(input_images.release()).At(Timestamp(0))));
+
+  // Wait until the calculator finishes processing.
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+  ASSERT_EQ(output_packets.size(), 1);
+
+  // Both images are stored in a single tensor.
+  const std::vector<Tensor>& tensor_vec =
+      output_packets[0].Get<std::vector<Tensor>>();
+  ASSERT_EQ(tensor_vec.size(), 1);
+  const Tensor& tensor = tensor_vec[0];
+  EXPECT_EQ(tensor.shape().dims, std::vector<int>({2, 1, 1, 1}));
+  auto view = tensor.GetCpuReadView();
+  EXPECT_FLOAT_EQ(view.buffer<float>()[0], 200.0 / 255.0);
+  EXPECT_FLOAT_EQ(view.buffer<float>()[1], 100.0 / 255.0);
+
+  // Fully close graph at end, otherwise calculator+tensors are destroyed
+  // after calling WaitUntilDone().
+  MP_ASSERT_OK(graph.CloseInputStream("input_images"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+}
+
 TEST_F(TensorConverterCalculatorTest, FlipVertically) {
   CalculatorGraph graph;
   CalculatorGraphConfig graph_config =
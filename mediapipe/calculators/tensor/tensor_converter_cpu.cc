@@ -16,10 +16,12 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/tensor.h"
@@ -53,6 +55,16 @@ absl::Status NormalizeImage(const ImageFrame& image_frame, bool flip_vertically,
     const T* image_ptr = reinterpret_cast<const T*>(
         image_frame.PixelData() +
         (flip_vertically ? height - 1 - i : i) * image_frame.WidthStep());
+    if (channels_ignored == 0) {
+      // All channels are kept, so the row is normalized as one contiguous
+      // run, which compilers vectorize.
+      const int row_size = width * channels;
+      for (int k = 0; k < row_size; ++k) {
+        tensor_ptr[k] = image_ptr[k] * scale + bias;
+      }
+      tensor_ptr += row_size;
+      continue;
+    }
     for (int j = 0; j < width; ++j) {
       for (int c = 0; c < channels_preserved; ++c) {
         *tensor_ptr++ = *image_ptr++ * scale + bias;
@@ -63,6 +75,31 @@ absl::Status NormalizeImage(const ImageFrame& image_frame, bool flip_vertically,
   return absl::OkStatus();
 }
 
+// Copies the 8-bit values of `image_frame` as they are, for quantized models.
+void CopyUInt8Image(const ImageFrame& image_frame, bool flip_vertically,
+                    int max_num_channels, uint8_t* tensor_ptr) {
+  const int height = image_frame.Height();
+  const int width = image_frame.Width();
+  const int channels = image_frame.NumberOfChannels();
+  const int channels_preserved = std::min(channels, max_num_channels);
+  for (int i = 0; i < height; ++i) {
+    const uint8_t* image_ptr =
+        image_frame.PixelData() +
+        (flip_vertically ? height - 1 - i : i) * image_frame.WidthStep();
+    if (channels_preserved == channels) {
+      std::memcpy(tensor_ptr, image_ptr, width * channels);
+      tensor_ptr += width * channels;
+      continue;
+    }
+    for (int j = 0; j < width; ++j) {
+      for (int c = 0; c < channels_preserved; ++c) {
+        *tensor_ptr++ = image_ptr[c];
+      }
+      image_ptr += channels;
+    }
+  }
+}
+
 }  // namespace
 
 absl::Status NormalizeUInt8Image(const ImageFrame& image_frame,
@@ -98,35 +135,66 @@ absl::Status CopyMatrixToTensor(const Matrix& matrix, bool is_row_major_matrix,
 absl::StatusOr<Tensor> ConvertImageFrameToTensorOnCpu(
     const ImageFrame& image_frame, const std::pair<float, float>& output_range,
     bool flip_vertically, int max_num_channels, MemoryManager* memory_manager) {
-  const int height = image_frame.Height();
-  const int width = image_frame.Width();
-  const int channels = image_frame.NumberOfChannels();
+  return ConvertImageFramesToTensorOnCpu(
+      absl::MakeConstSpan(&image_frame, 1), output_range, flip_vertically,
+      max_num_channels, /*use_quantized_tensors=*/false, memory_manager);
+}
+
+absl::StatusOr<Tensor> ConvertImageFramesToTensorOnCpu(
+    absl::Span<const ImageFrame> image_frames,
+    const std::pair<float, float>& output_range, bool flip_vertically,
+    int max_num_channels, bool use_quantized_tensors,
+    MemoryManager* memory_manager) {
+  RET_CHECK(!image_frames.empty());
+  const ImageFrame& first_frame = image_frames[0];
+  const int height = first_frame.Height();
+  const int width = first_frame.Width();
+  const int channels = first_frame.NumberOfChannels();
   const int channels_preserved = std::min(channels, max_num_channels);
-  const mediapipe::ImageFormat::Format format = image_frame.Format();
+  const mediapipe::ImageFormat::Format format = first_frame.Format();
 
   if (!(format == mediapipe::ImageFormat::SRGBA ||
         format == mediapipe::ImageFormat::SRGB ||
         format == mediapipe::ImageFormat::GRAY8 ||
         format == mediapipe::ImageFormat::VEC32F1))
     RET_CHECK_FAIL() << "Unsupported CPU input format.";
+  for (const ImageFrame& image_frame : image_frames) {
+    RET_CHECK(image_frame.Format() == format && image_frame.Width() == width &&
+              image_frame.Height() == height)
+        << "All images of a batch must have the same format and size.";
+  }
+  if (use_quantized_tensors) {
+    RET_CHECK_EQ(first_frame.ByteDepth(), 1)
+        << "Quantized tensors require 8-bit images.";
+  }
 
-  Tensor output_tensor(Tensor::ElementType::kFloat32,
-                       Tensor::Shape{1, height, width, channels_preserved},
+  const int batch_size = image_frames.size();
+  const int frame_size = height * width * channels_preserved;
+  Tensor output_tensor(use_quantized_tensors ? Tensor::ElementType::kUInt8
+                                             : Tensor::ElementType::kFloat32,
+                       Tensor::Shape{batch_size, height, width,
+                                     channels_preserved},
                        memory_manager);
   auto cpu_view = output_tensor.GetCpuWriteView();
 
-  // Copy image data into tensor.
-  if (image_frame.ByteDepth() == 1) {
-    MP_RETURN_IF_ERROR(NormalizeUInt8Image(image_frame, flip_vertically,
-                                           output_range, max_num_channels,
-                                           cpu_view.buffer<float>()));
-  } else if (image_frame.ByteDepth() == 4) {
-    MP_RETURN_IF_ERROR(NormalizeFloatImage(image_frame, flip_vertically,
-                                           output_range, max_num_channels,
-                                           cpu_view.buffer<float>()));
-  } else {
-    return absl::InternalError(
-        "Only byte-based (8 bit) and float (32 bit) images supported.");
+  // Copy image data into tensor, one batch entry after the other.
+  for (int b = 0; b < batch_size; ++b) {
+    const ImageFrame& image_frame = image_frames[b];
+    if (use_quantized_tensors) {
+      CopyUInt8Image(image_frame, flip_vertically, max_num_channels,
+                     cpu_view.buffer<uint8_t>() + b * frame_size);
+    } else if (image_frame.ByteDepth() == 1) {
+      MP_RETURN_IF_ERROR(NormalizeUInt8Image(
+          image_frame, flip_vertically, output_range, max_num_channels,
+          cpu_view.buffer<float>() + b * frame_size));
+    } else if (image_frame.ByteDepth() == 4) {
+      MP_RETURN_IF_ERROR(NormalizeFloatImage(
+          image_frame, flip_vertically, output_range, max_num_channels,
+          cpu_view.buffer<float>() + b * frame_size));
+    } else {
+      return absl::InternalError(
+          "Only byte-based (8 bit) and float (32 bit) images supported.");
+    }
   }
   return output_tensor;
 }
@@ -134,15 +202,31 @@ absl::StatusOr<Tensor> ConvertImageFrameToTensorOnCpu(
 absl::StatusOr<Tensor> ConvertMatrixToTensorOnCpu(
     const Matrix& matrix, bool row_major_matrix,
     MemoryManager* memory_manager) {
-  const int height = matrix.rows();
-  const int width = matrix.cols();
+  return ConvertMatricesToTensorOnCpu(absl::MakeConstSpan(&matrix, 1),
+                                      row_major_matrix, memory_manager);
+}
+
+absl::StatusOr<Tensor> ConvertMatricesToTensorOnCpu(
+    absl::Span<const Matrix> matrices, bool row_major_matrix,
+    MemoryManager* memory_manager) {
+  RET_CHECK(!matrices.empty());
+  const int height = matrices[0].rows();
+  const int width = matrices[0].cols();
   const int channels = 1;
+  for (const Matrix& matrix : matrices) {
+    RET_CHECK(matrix.rows() == height && matrix.cols() == width)
+        << "All matrices of a batch must have the same size.";
+  }
+  const int batch_size = matrices.size();
   Tensor output_tensor(Tensor::ElementType::kFloat32,
-                       Tensor::Shape{1, height, width, channels},
+                       Tensor::Shape{batch_size, height, width, channels},
                        memory_manager);
-  MP_RETURN_IF_ERROR(
-      CopyMatrixToTensor(matrix, row_major_matrix,
-                         output_tensor.GetCpuWriteView().buffer<float>()));
+  auto cpu_view = output_tensor.GetCpuWriteView();
+  for (int b = 0; b < batch_size; ++b) {
+    MP_RETURN_IF_ERROR(
+        CopyMatrixToTensor(matrices[b], row_major_matrix,
+                           cpu_view.buffer<float>() + b * height * width));
+  }
   return output_tensor;
 }
 
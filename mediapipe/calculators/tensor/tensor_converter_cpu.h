@@ -19,6 +19,7 @@
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/tensor.h"
@@ -47,6 +48,26 @@ absl::StatusOr<Tensor> ConvertImageFrameToTensorOnCpu(
 absl::StatusOr<Tensor> ConvertMatrixToTensorOnCpu(
     const Matrix& matrix, bool row_major_matrix, MemoryManager* memory_manager);
 
+// Converts a batch of ImageFrames to a single Tensor of shape
+// {image_frames.size(), height, width, channels}. All frames must have the
+// same format and size.
+// @use_quantized_tensors copies the values of 8-bit images to a kUInt8 tensor
+// instead of normalizing them to a kFloat32 tensor; @output_range is then
+// ignored.
+// Other parameters are as in ConvertImageFrameToTensorOnCpu.
+absl::StatusOr<Tensor> ConvertImageFramesToTensorOnCpu(
+    absl::Span<const ImageFrame> image_frames,
+    const std::pair<float, float>& output_range, bool flip_vertically,
+    int max_num_channels, bool use_quantized_tensors,
+    MemoryManager* memory_manager);
+
+// Converts a batch of Matrices to a single Tensor of shape
+// {matrices.size(), rows, cols, 1}. All matrices must have the same size.
+// Parameters are as in ConvertMatrixToTensorOnCpu.
+absl::StatusOr<Tensor> ConvertMatricesToTensorOnCpu(
+    absl::Span<const Matrix> matrices, bool row_major_matrix,
+    MemoryManager* memory_manager);
+
 // For testing only below.
 absl::Status NormalizeUInt8Image(const ImageFrame& image_frame,
                                  bool flip_vertically,
@@ -175,6 +175,95 @@ TEST(TensorConverterCpuTest, ConvertMatrixToTensorOnCpu) {
   }
 }
 
+TEST(TensorConverterCpuTest, ConvertImageFramesToBatchedTensorOnCpu) {
+  MemoryManager memory_manager;
+  std::vector<ImageFrame> image_frames;
+  image_frames.push_back(CreateTestRgba8ImageFrame(/*width=*/3, /*height=*/4));
+  image_frames.push_back(CreateTestRgba8ImageFrame(/*width=*/3, /*height=*/4));
+  image_frames[1].MutablePixelData()[0] = 7;
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      Tensor output,
+      ConvertImageFramesToTensorOnCpu(
+          image_frames, {-1.0f, 1.0f}, /*flip_vertically=*/false,
+          /*max_num_channels=*/3, /*use_quantized_tensors=*/false,
+          &memory_manager));
+
+  EXPECT_EQ(output.shape().dims, std::vector<int>({2, 4, 3, 3}));
+  const auto cpu_read_view = output.GetCpuReadView();
+  const float* tensor_ptr = cpu_read_view.buffer<float>();
+  for (int b = 0; b < 2; ++b) {
+    for (int i = 0; i < 4 * 3; ++i) {
+      const uint8_t* pixel = image_frames[b].PixelData() + i * 4;
+      for (int c = 0; c < 3; ++c) {
+        EXPECT_FLOAT_EQ(*tensor_ptr++, pixel[c] * (2.0f / 255.0f) - 1.0f);
+      }
+    }
+  }
+}
+
+TEST(TensorConverterCpuTest, ConvertImageFramesToQuantizedTensorOnCpu) {
+  MemoryManager memory_manager;
+  std::vector<ImageFrame> image_frames;
+  image_frames.push_back(CreateTestRgba8ImageFrame(/*width=*/3, /*height=*/4));
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      Tensor output,
+      ConvertImageFramesToTensorOnCpu(
+          image_frames, {0.0f, 1.0f}, /*flip_vertically=*/true,
+          /*max_num_channels=*/3, /*use_quantized_tensors=*/true,
+          &memory_manager));
+
+  EXPECT_EQ(output.element_type(), Tensor::ElementType::kUInt8);
+  EXPECT_EQ(output.shape().dims, std::vector<int>({1, 4, 3, 3}));
+  const auto cpu_read_view = output.GetCpuReadView();
+  const uint8_t* tensor_ptr = cpu_read_view.buffer<uint8_t>();
+  const ImageFrame& image_frame = image_frames[0];
+  for (int y = 0; y < 4; ++y) {
+    const uint8_t* row =
+        image_frame.PixelData() + (3 - y) * image_frame.WidthStep();
+    for (int x = 0; x < 3; ++x) {
+      for (int c = 0; c < 3; ++c) {
+        EXPECT_EQ(*tensor_ptr++, row[x * 4 + c]);
+      }
+    }
+  }
+}
+
+TEST(TensorConverterCpuTest, ShouldRejectImagesOfDifferentSizes) {
+  MemoryManager memory_manager;
+  std::vector<ImageFrame> image_frames;
+  image_frames.push_back(CreateTestGrey8ImageFrame(/*width=*/3, /*height=*/4));
+  image_frames.push_back(CreateTestGrey8ImageFrame(/*width=*/4, /*height=*/3));
+
+  EXPECT_FALSE(ConvertImageFramesToTensorOnCpu(
+                   image_frames, {0.0f, 1.0f}, /*flip_vertically=*/false,
+                   /*max_num_channels=*/1, /*use_quantized_tensors=*/false,
+                   &memory_manager)
+                   .ok());
+}
+
+TEST(TensorConverterCpuTest, ConvertMatricesToBatchedTensorOnCpu) {
+  MemoryManager memory_manager;
+  std::vector<Matrix> matrices = {
+      CreateTestMatrix(/*num_rows=*/3, /*num_columns=*/4),
+      CreateTestMatrix(/*num_rows=*/3, /*num_columns=*/4) * 2.0f};
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      Tensor output,
+      ConvertMatricesToTensorOnCpu(matrices, /*row_major_matrix=*/false,
+                                   &memory_manager));
+
+  EXPECT_EQ(output.shape().dims, std::vector<int>({2, 3, 4, 1}));
+  const auto cpu_read_view = output.GetCpuReadView();
+  const float* tensor_ptr = cpu_read_view.buffer<float>();
+  for (const Matrix& matrix : matrices) {
+    for (int i = 0; i < matrix.size(); ++i) {
+      EXPECT_FLOAT_EQ(*tensor_ptr++, matrix.data()[i]);
+    }
+  }
+}
+
 }  // namespace
 
 }  // namespace mediapipe
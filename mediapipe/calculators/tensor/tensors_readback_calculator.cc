@@ -0,0 +1,116 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_join.h"
+#include "mediapipe/calculators/tensor/tensors_readback_calculator.pb.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+namespace api2 {
+namespace {
+
+// Returns true if `shape` matches `expected`, which leaves out the batch
+// dimension of size 1.
+bool MatchesExpectedShape(
+    const Tensor::Shape& shape,
+    const TensorsReadbackCalculatorOptions::TensorShape& expected) {
+  std::vector<int> dims = shape.dims;
+  if (dims.size() == expected.dims_size() + 1) {
+    if (dims[0] != 1) return false;
+    dims.erase(dims.begin());
+  }
+  return std::equal(dims.begin(), dims.end(), expected.dims().begin(),
+                    expected.dims().end());
+}
+
+}  // namespace
+
+// Starts reading back the input tensors from the GPU to the CPU without
+// waiting for the transfer, and forwards the tensors as they are. Placed right
+// after a GPU inference, it lets the transfer overlap with the GPU work of the
+// next frame; downstream CPU calculators only block in GetCpuReadView() if the
+// transfer has not finished by then. Tensors already on the CPU are forwarded
+// without any work.
+//
+// Input:
+//  TENSORS - Vector of Tensors, typically held by OpenGL.
+// Output:
+//  TENSORS - The same vector of Tensors, whose CPU read-back is in flight.
+//
+// Options:
+//  tensor_shape - If set, the expected shape of each input tensor, checked at
+//    runtime. The batch dimension of size 1 may be left out.
+//
+// Usage example:
+// node {
+//   calculator: "TensorsReadbackCalculator"
+//   input_stream: "TENSORS:gpu_tensors"
+//   output_stream: "TENSORS:tensors"
+// }
+class TensorsReadbackCalculator : public Node {
+ public:
+  static constexpr Input<std::vector<Tensor>> kInTensors{"TENSORS"};
+  static constexpr Output<std::vector<Tensor>> kOutTensors{"TENSORS"};
+  MEDIAPIPE_NODE_CONTRACT(kInTensors, kOutTensors);
+
+  absl::Status Open(CalculatorContext* cc) override;
+  absl::Status Process(CalculatorContext* cc) override;
+
+ private:
+  TensorsReadbackCalculatorOptions options_;
+};
+
+absl::Status TensorsReadbackCalculator::Open(CalculatorContext* cc) {
+  options_ = cc->Options<TensorsReadbackCalculatorOptions>();
+  return absl::OkStatus();
+}
+
+absl::Status TensorsReadbackCalculator::Process(CalculatorContext* cc) {
+  if (kInTensors(cc).IsEmpty()) {
+    return absl::OkStatus();
+  }
+  const auto& input_tensors = *kInTensors(cc);
+  if (options_.tensor_shape_size() > 0) {
+    RET_CHECK_EQ(input_tensors.size(), options_.tensor_shape_size())
+        << "Number of input tensors doesn't match the number of expected "
+           "tensor shapes.";
+    for (int i = 0; i < input_tensors.size(); ++i) {
+      RET_CHECK(MatchesExpectedShape(input_tensors[i].shape(),
+                                     options_.tensor_shape(i)))
+          << "Input tensor " << i << " has shape ["
+          << absl::StrJoin(input_tensors[i].shape().dims, ", ")
+          << "], expected ["
+          << absl::StrJoin(options_.tensor_shape(i).dims(), ", ") << "].";
+    }
+  }
+  for (const Tensor& tensor : input_tensors) {
+    tensor.RequestCpuReadAsync();
+  }
+  kOutTensors(cc).Send(kInTensors(cc).packet().As<std::vector<Tensor>>());
+  return absl::OkStatus();
+}
+
+MEDIAPIPE_REGISTER_NODE(TensorsReadbackCalculator);
+
+}  // namespace api2
+}  // namespace mediapipe
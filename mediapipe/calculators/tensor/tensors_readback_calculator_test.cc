@@ -0,0 +1,85 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::ParseTextProtoOrDie;
+using ::testing::ElementsAre;
+using Node = ::mediapipe::CalculatorGraphConfig::Node;
+
+void PushTensor(CalculatorRunner& runner, const std::vector<int>& dims) {
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape(dims));
+  auto view = tensors->back().GetCpuWriteView();
+  float* buffer = view.buffer<float>();
+  for (int i = 0; i < tensors->back().shape().num_elements(); ++i) {
+    buffer[i] = i;
+  }
+  runner.MutableInputs()->Tag("TENSORS").packets.push_back(
+      Adopt(tensors.release()).At(Timestamp(0)));
+}
+
+TEST(TensorsReadbackCalculatorTest, ForwardsTensors) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsReadbackCalculator"
+    input_stream: "TENSORS:input"
+    output_stream: "TENSORS:output"
+    options {
+      [mediapipe.TensorsReadbackCalculatorOptions.ext] {
+        tensor_shape { dims: 1 dims: 3 }
+      }
+    }
+  )pb"));
+  PushTensor(runner, {1, 1, 3});
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& output_packets = runner.Outputs().Tag("TENSORS").packets;
+  ASSERT_EQ(output_packets.size(), 1);
+  EXPECT_EQ(output_packets[0].Timestamp(), Timestamp(0));
+  const auto& tensors = output_packets[0].Get<std::vector<Tensor>>();
+  ASSERT_EQ(tensors.size(), 1);
+  auto view = tensors[0].GetCpuReadView();
+  const float* buffer = view.buffer<float>();
+  EXPECT_THAT(std::vector<float>(buffer, buffer + 3), ElementsAre(0, 1, 2));
+}
+
+TEST(TensorsReadbackCalculatorTest, RejectsUnexpectedShape) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsReadbackCalculator"
+    input_stream: "TENSORS:input"
+    output_stream: "TENSORS:output"
+    options {
+      [mediapipe.TensorsReadbackCalculatorOptions.ext] {
+        tensor_shape { dims: 2 }
+      }
+    }
+  )pb"));
+  PushTensor(runner, {1, 3});
+  EXPECT_FALSE(runner.Run().ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -66,6 +66,10 @@ void SetClassificationLabel(const LabelMapItem label_map_item,
 //  CLASSIFICATIONS - Result MediaPipe ClassificationList. The score and index
 //                    fields of each classification are set, while the label
 //                    field is only set if label_map_path is provided.
+//  BATCHED_CLASSIFICATIONS - Optional, used in place of CLASSIFICATIONS when
+//                    the first dimension of the tensor is a batch dimension.
+//                    Contains one ClassificationList per batch item, in batch
+//                    order.
 //
 // Usage example:
 // node {
@@ -82,9 +86,20 @@ void SetClassificationLabel(const LabelMapItem label_map_item,
 class TensorsToClassificationCalculator : public Node {
  public:
   static constexpr Input<std::vector<Tensor>> kInTensors{"TENSORS"};
-  static constexpr Output<ClassificationList> kOutClassificationList{
+  static constexpr Output<ClassificationList>::Optional kOutClassificationList{
       "CLASSIFICATIONS"};
-  MEDIAPIPE_NODE_CONTRACT(kInTensors, kOutClassificationList);
+  static constexpr Output<std::vector<ClassificationList>>::Optional
+      kOutBatchedClassificationLists{"BATCHED_CLASSIFICATIONS"};
+  MEDIAPIPE_NODE_CONTRACT(kInTensors, kOutClassificationList,
+                          kOutBatchedClassificationLists);
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    RET_CHECK(kOutClassificationList(cc).IsConnected() ^
+              kOutBatchedClassificationLists(cc).IsConnected())
+        << "Exactly one of CLASSIFICATIONS and BATCHED_CLASSIFICATIONS must "
+           "be connected.";
+    return absl::OkStatus();
+  }
 
   absl::Status Open(CalculatorContext* cc) override;
   absl::Status Process(CalculatorContext* cc) override;
@@ -106,7 +121,14 @@ class TensorsToClassificationCalculator : public Node {
   // Allowed or ignored class indices based on provided options.
   // These are used to filter out the output classification results.
   ClassIndexSet class_index_set_;
+  // The (score, class index) pairs considered for output, reused across calls.
+  std::vector<std::pair<float, int>> candidates_;
   bool IsClassIndexAllowed(int class_index);
+  // Converts the `num_classes` scores of one batch item into a
+  // ClassificationList.
+  absl::Status ScoresToClassificationList(
+      const float* raw_scores, int num_classes, CalculatorContext* cc,
+      ClassificationList* classification_list);
   const proto_ns::Map<int64_t, LabelMapItem>& GetLabelMap(
       CalculatorContext* cc);
 };
@@ -170,9 +192,38 @@ absl::Status TensorsToClassificationCalculator::Process(CalculatorContext* cc) {
   const auto& input_tensors = *kInTensors(cc);
   RET_CHECK_EQ(input_tensors.size(), 1);
   RET_CHECK(input_tensors[0].element_type() == Tensor::ElementType::kFloat32);
+  auto view = input_tensors[0].GetCpuReadView();
+  auto raw_scores = view.buffer<float>();
 
-  int num_classes = input_tensors[0].shape().num_elements();
+  if (kOutBatchedClassificationLists(cc).IsConnected()) {
+    const auto& dims = input_tensors[0].shape().dims;
+    RET_CHECK(!dims.empty() && dims[0] > 0)
+        << "Batched classification needs a batch dimension.";
+    const int batch_size = dims[0];
+    const int num_classes =
+        input_tensors[0].shape().num_elements() / batch_size;
+    auto classification_lists =
+        std::make_unique<std::vector<ClassificationList>>(batch_size);
+    for (int i = 0; i < batch_size; ++i) {
+      MP_RETURN_IF_ERROR(
+          ScoresToClassificationList(raw_scores + i * num_classes, num_classes,
+                                     cc, &(*classification_lists)[i]));
+    }
+    kOutBatchedClassificationLists(cc).Send(std::move(classification_lists));
+    return absl::OkStatus();
+  }
 
+  auto classification_list = std::make_unique<ClassificationList>();
+  MP_RETURN_IF_ERROR(ScoresToClassificationList(
+      raw_scores, input_tensors[0].shape().num_elements(), cc,
+      classification_list.get()));
+  kOutClassificationList(cc).Send(std::move(classification_list));
+  return absl::OkStatus();
+}
+
+absl::Status TensorsToClassificationCalculator::ScoresToClassificationList(
+    const float* raw_scores, int num_classes, CalculatorContext* cc,
+    ClassificationList* classification_list) {
   if (is_binary_classification_) {
     RET_CHECK_EQ(num_classes, 1);
     // Number of classes for binary classification.
@@ -181,63 +232,48 @@ absl::Status TensorsToClassificationCalculator::Process(CalculatorContext* cc) {
   if (label_map_loaded_) {
     RET_CHECK_EQ(num_classes, GetLabelMap(cc).size());
   }
-  auto view = input_tensors[0].GetCpuReadView();
-  auto raw_scores = view.buffer<float>();
-
-  auto classification_list = std::make_unique<ClassificationList>();
+  // Candidates are selected and ordered as (score, index) pairs, so that
+  // Classification protos are only built, and labels only looked up, for the
+  // classes that are output.
+  candidates_.clear();
   if (is_binary_classification_) {
-    Classification* class_first = classification_list->add_classification();
-    Classification* class_second = classification_list->add_classification();
-    class_first->set_index(0);
-    class_second->set_index(1);
-    class_first->set_score(raw_scores[0]);
-    class_second->set_score(1. - raw_scores[0]);
-
-    if (label_map_loaded_) {
-      SetClassificationLabel(GetLabelMap(cc).at(0), class_first);
-      SetClassificationLabel(GetLabelMap(cc).at(1), class_second);
-    }
+    candidates_.emplace_back(raw_scores[0], 0);
+    candidates_.emplace_back(1. - raw_scores[0], 1);
   } else {
     for (int i = 0; i < num_classes; ++i) {
-      if (!IsClassIndexAllowed(i)) {
-        continue;
-      }
       if (raw_scores[i] < min_score_threshold_) {
         continue;
       }
-      Classification* classification =
-          classification_list->add_classification();
-      classification->set_index(i);
-      classification->set_score(raw_scores[i]);
-      if (label_map_loaded_) {
-        SetClassificationLabel(GetLabelMap(cc).at(i), classification);
+      if (!IsClassIndexAllowed(i)) {
+        continue;
       }
+      candidates_.emplace_back(raw_scores[i], i);
     }
   }
 
-  auto raw_classification_list = classification_list->mutable_classification();
+  const auto by_descending_score = [](const std::pair<float, int>& a,
+                                      const std::pair<float, int>& b) {
+    return a.first > b.first;
+  };
   if (top_k_ > 0) {
-    int desired_size =
-        std::min(classification_list->classification_size(), top_k_);
-    std::partial_sort(raw_classification_list->begin(),
-                      raw_classification_list->begin() + desired_size,
-                      raw_classification_list->end(),
-                      [](const Classification a, const Classification b) {
-                        return a.score() > b.score();
-                      });
+    const int desired_size =
+        std::min(static_cast<int>(candidates_.size()), top_k_);
+    std::partial_sort(candidates_.begin(), candidates_.begin() + desired_size,
+                      candidates_.end(), by_descending_score);
+    candidates_.resize(desired_size);
+  } else if (sort_by_descending_score_) {
+    std::sort(candidates_.begin(), candidates_.end(), by_descending_score);
+  }
 
-    if (desired_size >= top_k_) {
-      // Resizes the underlying list to have only top_k_ classifications.
-      raw_classification_list->DeleteSubrange(
-          top_k_, raw_classification_list->size() - top_k_);
+  classification_list->mutable_classification()->Reserve(candidates_.size());
+  for (const auto& [score, index] : candidates_) {
+    Classification* classification = classification_list->add_classification();
+    classification->set_index(index);
+    classification->set_score(score);
+    if (label_map_loaded_) {
+      SetClassificationLabel(GetLabelMap(cc).at(index), classification);
     }
-  } else if (sort_by_descending_score_) {
-    std::sort(raw_classification_list->begin(), raw_classification_list->end(),
-              [](const Classification a, const Classification b) {
-                return a.score() > b.score();
-              });
   }
-  kOutClassificationList(cc).Send(std::move(classification_list));
   return absl::OkStatus();
 }
 
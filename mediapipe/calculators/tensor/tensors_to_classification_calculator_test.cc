@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <vector>
 
@@ -323,4 +324,40 @@ TEST_F(TensorsToClassificationCalculatorTest,
   ASSERT_TRUE(classification_list.classification(1).has_label());
 }
 
+TEST_F(TensorsToClassificationCalculatorTest, CorrectBatchedOutput) {
+  mediapipe::CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsToClassificationCalculator"
+    input_stream: "TENSORS:tensors"
+    output_stream: "BATCHED_CLASSIFICATIONS:classifications"
+    options {
+      [mediapipe.TensorsToClassificationCalculatorOptions.ext] { top_k: 1 }
+    }
+  )pb"));
+
+  auto tensors = absl::make_unique<std::vector<Tensor>>();
+  tensors->emplace_back(Tensor::ElementType::kFloat32, Tensor::Shape{2, 3});
+  {
+    auto view = tensors->back().GetCpuWriteView();
+    float* tensor_buffer = view.buffer<float>();
+    const float scores[] = {0.1, 0.7, 0.2, 0.6, 0.3, 0.1};
+    std::copy(std::begin(scores), std::end(scores), tensor_buffer);
+  }
+  runner.MutableInputs()->Tag("TENSORS").packets.push_back(
+      mediapipe::Adopt(tensors.release()).At(mediapipe::Timestamp(0)));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& output_packets_ =
+      runner.Outputs().Tag("BATCHED_CLASSIFICATIONS").packets;
+  ASSERT_EQ(1, output_packets_.size());
+  const auto& classification_lists =
+      output_packets_[0].Get<std::vector<ClassificationList>>();
+  ASSERT_EQ(2, classification_lists.size());
+  ASSERT_EQ(1, classification_lists[0].classification_size());
+  EXPECT_EQ(1, classification_lists[0].classification(0).index());
+  EXPECT_FLOAT_EQ(0.7, classification_lists[0].classification(0).score());
+  ASSERT_EQ(1, classification_lists[1].classification_size());
+  EXPECT_EQ(0, classification_lists[1].classification(0).index());
+  EXPECT_FLOAT_EQ(0.6, classification_lists[1].classification(0).score());
+}
+
 }  // namespace mediapipe
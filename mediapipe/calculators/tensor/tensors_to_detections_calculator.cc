@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -137,6 +138,23 @@ BoxFormat GetBoxFormat(const TensorsToDetectionsCalculatorOptions& options) {
   return mediapipe::TensorsToDetectionsCalculatorOptions::YXHW;
 }
 
+// Returns the intersection over union of two boxes given as
+// {ymin, xmin, ymax, xmax}.
+float IntersectionOverUnion(const float* box1, const float* box2) {
+  const float ymin = std::max(box1[0], box2[0]);
+  const float xmin = std::max(box1[1], box2[1]);
+  const float ymax = std::min(box1[2], box2[2]);
+  const float xmax = std::min(box1[3], box2[3]);
+  if (ymin >= ymax || xmin >= xmax) {
+    return 0.0f;
+  }
+  const float intersection = (ymax - ymin) * (xmax - xmin);
+  const float area1 = (box1[2] - box1[0]) * (box1[3] - box1[1]);
+  const float area2 = (box2[2] - box2[0]) * (box2[3] - box2[1]);
+  const float union_area = area1 + area2 - intersection;
+  return union_area > 0.0f ? intersection / union_area : 0.0f;
+}
+
 }  // namespace
 
 // Convert result Tensors from object detection models into MediaPipe
@@ -182,6 +200,13 @@ BoxFormat GetBoxFormat(const TensorsToDetectionsCalculatorOptions& options) {
 //     }
 //   }
 // }
+//
+// If `non_max_suppression` is set in the options, the boxes are filtered by
+// score and suppressed before being converted to detections, so that a
+// following NonMaxSuppressionCalculator is not needed:
+//       min_score_thresh: 0.5
+//       max_results: 10
+//       non_max_suppression { min_suppression_threshold: 0.3 }
 class TensorsToDetectionsCalculator : public Node {
  public:
   static constexpr Input<std::vector<Tensor>> kInTensors{"TENSORS"};
@@ -209,10 +234,31 @@ class TensorsToDetectionsCalculator : public Node {
   absl::Status DecodeBoxes(const float* raw_boxes,
                            const std::vector<Anchor>& anchors,
                            std::vector<float>* boxes);
+  // Decodes box `box_index` of `raw_boxes` into the `num_coords_` values at
+  // `box`.
+  void DecodeBox(const float* raw_boxes, int box_index, const Anchor& anchor,
+                 float* box);
   absl::Status ConvertToDetections(const float* detection_boxes,
                                    const float* detection_scores,
-                                   const int* detection_classes,
+                                   const int* detection_classes, int num_boxes,
                                    std::vector<Detection>* output_detections);
+  // Returns the indices of the boxes with an allowed class and a score of at
+  // least `min_score_thresh`, in the order of decreasing score, truncated to
+  // `non_max_suppression.max_candidates`.
+  std::vector<int> SelectCandidates(const float* detection_scores,
+                                    const int* detection_classes);
+  // Suppresses overlapping boxes among `candidates`, whose decoded boxes are
+  // stored consecutively in `candidate_boxes`, and converts the kept boxes to
+  // detections. `candidate_boxes` is reused to hold the kept boxes.
+  absl::Status ConvertToSuppressedDetections(
+      absl::Span<const int> candidates, std::vector<float>& candidate_boxes,
+      const float* detection_scores, const int* detection_classes,
+      std::vector<Detection>* output_detections);
+  // Selects the candidates among the decoded `boxes` and converts them to
+  // detections with ConvertToSuppressedDetections.
+  absl::Status ConvertToSuppressedDetections(
+      const float* boxes, const float* detection_scores,
+      const int* detection_classes, std::vector<Detection>* output_detections);
   Detection ConvertToDetection(float box_ymin, float box_xmin, float box_ymax,
                                float box_xmax, absl::Span<const float> scores,
                                absl::Span<const int> class_ids,
@@ -416,8 +462,6 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
       }
       anchors_init_ = true;
     }
-    std::vector<float> boxes(num_boxes_ * num_coords_);
-    MP_RETURN_IF_ERROR(DecodeBoxes(raw_boxes, anchors_, &boxes));
 
     std::vector<float> detection_scores(num_boxes_);
     std::vector<int> detection_classes(num_boxes_);
@@ -451,13 +495,32 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
       detection_classes[i] = class_id;
     }
 
-    MP_RETURN_IF_ERROR(
-        ConvertToDetections(boxes.data(), detection_scores.data(),
-                            detection_classes.data(), output_detections));
+    if (options_.has_non_max_suppression()) {
+      // Only the candidates that pass the score filter are decoded.
+      const std::vector<int> candidates =
+          SelectCandidates(detection_scores.data(), detection_classes.data());
+      std::vector<float> candidate_boxes(candidates.size() * num_coords_);
+      for (int i = 0; i < candidates.size(); ++i) {
+        DecodeBox(raw_boxes, candidates[i], anchors_[candidates[i]],
+                  &candidate_boxes[i * num_coords_]);
+      }
+      MP_RETURN_IF_ERROR(ConvertToSuppressedDetections(
+          candidates, candidate_boxes, detection_scores.data(),
+          detection_classes.data(), output_detections));
+    } else {
+      std::vector<float> boxes(num_boxes_ * num_coords_);
+      MP_RETURN_IF_ERROR(DecodeBoxes(raw_boxes, anchors_, &boxes));
+      MP_RETURN_IF_ERROR(ConvertToDetections(
+          boxes.data(), detection_scores.data(), detection_classes.data(),
+          num_boxes_, output_detections));
+    }
   } else {
     // Postprocessing on CPU with postprocessing op (e.g. anchor decoding and
     // non-maximum suppression) within the model.
     RET_CHECK_EQ(input_tensors.size(), 4);
+    RET_CHECK(!options_.has_non_max_suppression())
+        << "non_max_suppression is not supported for models with a built-in "
+           "post-processing op.";
     auto num_boxes_tensor =
         &input_tensors[tensor_mapping_.num_detections_tensor_index()];
     RET_CHECK_EQ(num_boxes_tensor->shape().dims.size(), 1);
@@ -508,7 +571,7 @@ absl::Status TensorsToDetectionsCalculator::ProcessCPU(
       detection_classes[i] = static_cast<int>(detection_classes_ptr[i]);
     }
     MP_RETURN_IF_ERROR(ConvertToDetections(detection_boxes, detection_scores,
-                                           detection_classes.data(),
+                                           detection_classes.data(), num_boxes_,
                                            output_detections));
   }
   return absl::OkStatus();
@@ -587,9 +650,15 @@ absl::Status TensorsToDetectionsCalculator::ProcessGPU(
   }
   auto decoded_boxes_view = decoded_boxes_buffer_->GetCpuReadView();
   auto boxes = decoded_boxes_view.buffer<float>();
-  MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
-                                         detection_classes.data(),
-                                         output_detections));
+  if (options_.has_non_max_suppression()) {
+    MP_RETURN_IF_ERROR(ConvertToSuppressedDetections(
+        boxes, detection_scores.data(), detection_classes.data(),
+        output_detections));
+  } else {
+    MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
+                                           detection_classes.data(), num_boxes_,
+                                           output_detections));
+  }
 #elif MEDIAPIPE_METAL_ENABLED
   if (!anchors_init_) {
     if (input_tensors.size() == kNumInputTensorsWithAnchors) {
@@ -674,9 +743,15 @@ absl::Status TensorsToDetectionsCalculator::ProcessGPU(
   }
   auto decoded_boxes_view = decoded_boxes_buffer_->GetCpuReadView();
   auto boxes = decoded_boxes_view.buffer<float>();
-  MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
-                                         detection_classes.data(),
-                                         output_detections));
+  if (options_.has_non_max_suppression()) {
+    MP_RETURN_IF_ERROR(ConvertToSuppressedDetections(
+        boxes, detection_scores.data(), detection_classes.data(),
+        output_detections));
+  } else {
+    MP_RETURN_IF_ERROR(ConvertToDetections(boxes, detection_scores.data(),
+                                           detection_classes.data(), num_boxes_,
+                                           output_detections));
+  }
 
 #else
   ABSL_LOG(ERROR) << "GPU input on non-Android not supported yet.";
@@ -787,93 +862,98 @@ absl::Status TensorsToDetectionsCalculator::DecodeBoxes(
     const float* raw_boxes, const std::vector<Anchor>& anchors,
     std::vector<float>* boxes) {
   for (int i = 0; i < num_boxes_; ++i) {
-    const int box_offset = i * num_coords_ + options_.box_coord_offset();
-
-    float y_center = 0.0;
-    float x_center = 0.0;
-    float h = 0.0;
-    float w = 0.0;
-    // TODO
-    switch (box_output_format_) {
-      case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
-      case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
-        y_center = raw_boxes[box_offset];
-        x_center = raw_boxes[box_offset + 1];
-        h = raw_boxes[box_offset + 2];
-        w = raw_boxes[box_offset + 3];
-        break;
-      case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
-        x_center = raw_boxes[box_offset];
-        y_center = raw_boxes[box_offset + 1];
-        w = raw_boxes[box_offset + 2];
-        h = raw_boxes[box_offset + 3];
-        break;
-      case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
-        x_center = (-raw_boxes[box_offset] + raw_boxes[box_offset + 2]) / 2;
-        y_center = (-raw_boxes[box_offset + 1] + raw_boxes[box_offset + 3]) / 2;
-        w = raw_boxes[box_offset + 2] + raw_boxes[box_offset];
-        h = raw_boxes[box_offset + 3] + raw_boxes[box_offset + 1];
-        break;
-    }
-    x_center =
-        x_center / options_.x_scale() * anchors[i].w() + anchors[i].x_center();
-    y_center =
-        y_center / options_.y_scale() * anchors[i].h() + anchors[i].y_center();
-
-    if (options_.apply_exponential_on_box_size()) {
-      h = std::exp(h / options_.h_scale()) * anchors[i].h();
-      w = std::exp(w / options_.w_scale()) * anchors[i].w();
-    } else {
-      h = h / options_.h_scale() * anchors[i].h();
-      w = w / options_.w_scale() * anchors[i].w();
-    }
+    DecodeBox(raw_boxes, i, anchors[i], &(*boxes)[i * num_coords_]);
+  }
+  return absl::OkStatus();
+}
 
-    const float ymin = y_center - h / 2.f;
-    const float xmin = x_center - w / 2.f;
-    const float ymax = y_center + h / 2.f;
-    const float xmax = x_center + w / 2.f;
-
-    (*boxes)[i * num_coords_ + 0] = ymin;
-    (*boxes)[i * num_coords_ + 1] = xmin;
-    (*boxes)[i * num_coords_ + 2] = ymax;
-    (*boxes)[i * num_coords_ + 3] = xmax;
-
-    if (options_.num_keypoints()) {
-      for (int k = 0; k < options_.num_keypoints(); ++k) {
-        const int offset = i * num_coords_ + options_.keypoint_coord_offset() +
-                           k * options_.num_values_per_keypoint();
-
-        float keypoint_y = 0.0;
-        float keypoint_x = 0.0;
-        switch (box_output_format_) {
-          case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
-          case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
-            keypoint_y = raw_boxes[offset];
-            keypoint_x = raw_boxes[offset + 1];
-            break;
-          case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
-          case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
-            keypoint_x = raw_boxes[offset];
-            keypoint_y = raw_boxes[offset + 1];
-            break;
-        }
+void TensorsToDetectionsCalculator::DecodeBox(const float* raw_boxes,
+                                              int box_index,
+                                              const Anchor& anchor,
+                                              float* box) {
+  const float* raw_box = raw_boxes + box_index * num_coords_;
+  const int box_offset = options_.box_coord_offset();
+
+  float y_center = 0.0;
+  float x_center = 0.0;
+  float h = 0.0;
+  float w = 0.0;
+  // TODO
+  switch (box_output_format_) {
+    case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
+    case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
+      y_center = raw_box[box_offset];
+      x_center = raw_box[box_offset + 1];
+      h = raw_box[box_offset + 2];
+      w = raw_box[box_offset + 3];
+      break;
+    case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
+      x_center = raw_box[box_offset];
+      y_center = raw_box[box_offset + 1];
+      w = raw_box[box_offset + 2];
+      h = raw_box[box_offset + 3];
+      break;
+    case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
+      x_center = (-raw_box[box_offset] + raw_box[box_offset + 2]) / 2;
+      y_center = (-raw_box[box_offset + 1] + raw_box[box_offset + 3]) / 2;
+      w = raw_box[box_offset + 2] + raw_box[box_offset];
+      h = raw_box[box_offset + 3] + raw_box[box_offset + 1];
+      break;
+  }
+  x_center = x_center / options_.x_scale() * anchor.w() + anchor.x_center();
+  y_center = y_center / options_.y_scale() * anchor.h() + anchor.y_center();
 
-        (*boxes)[offset] = keypoint_x / options_.x_scale() * anchors[i].w() +
-                           anchors[i].x_center();
-        (*boxes)[offset + 1] =
-            keypoint_y / options_.y_scale() * anchors[i].h() +
-            anchors[i].y_center();
+  if (options_.apply_exponential_on_box_size()) {
+    h = std::exp(h / options_.h_scale()) * anchor.h();
+    w = std::exp(w / options_.w_scale()) * anchor.w();
+  } else {
+    h = h / options_.h_scale() * anchor.h();
+    w = w / options_.w_scale() * anchor.w();
+  }
+
+  const float ymin = y_center - h / 2.f;
+  const float xmin = x_center - w / 2.f;
+  const float ymax = y_center + h / 2.f;
+  const float xmax = x_center + w / 2.f;
+
+  box[0] = ymin;
+  box[1] = xmin;
+  box[2] = ymax;
+  box[3] = xmax;
+
+  if (options_.num_keypoints()) {
+    for (int k = 0; k < options_.num_keypoints(); ++k) {
+      const int offset = options_.keypoint_coord_offset() +
+                         k * options_.num_values_per_keypoint();
+
+      float keypoint_y = 0.0;
+      float keypoint_x = 0.0;
+      switch (box_output_format_) {
+        case mediapipe::TensorsToDetectionsCalculatorOptions::UNSPECIFIED:
+        case mediapipe::TensorsToDetectionsCalculatorOptions::YXHW:
+          keypoint_y = raw_box[offset];
+          keypoint_x = raw_box[offset + 1];
+          break;
+        case mediapipe::TensorsToDetectionsCalculatorOptions::XYWH:
+        case mediapipe::TensorsToDetectionsCalculatorOptions::XYXY:
+          keypoint_x = raw_box[offset];
+          keypoint_y = raw_box[offset + 1];
+          break;
       }
+
+      box[offset] = keypoint_x / options_.x_scale() * anchor.w() +
+                    anchor.x_center();
+      box[offset + 1] = keypoint_y / options_.y_scale() * anchor.h() +
+                        anchor.y_center();
     }
   }
-
-  return absl::OkStatus();
 }
 
 absl::Status TensorsToDetectionsCalculator::ConvertToDetections(
     const float* detection_boxes, const float* detection_scores,
-    const int* detection_classes, std::vector<Detection>* output_detections) {
-  for (int i = 0; i < num_boxes_ * classes_per_detection_;
+    const int* detection_classes, int num_boxes,
+    std::vector<Detection>* output_detections) {
+  for (int i = 0; i < num_boxes * classes_per_detection_;
        i += classes_per_detection_) {
     if (max_results_ > 0 && output_detections->size() == max_results_) {
       break;
@@ -920,6 +1000,94 @@ absl::Status TensorsToDetectionsCalculator::ConvertToDetections(
   return absl::OkStatus();
 }
 
+std::vector<int> TensorsToDetectionsCalculator::SelectCandidates(
+    const float* detection_scores, const int* detection_classes) {
+  std::vector<int> candidates;
+  for (int i = 0; i < num_boxes_; ++i) {
+    if (detection_classes[i] < 0 ||
+        (options_.has_min_score_thresh() &&
+         detection_scores[i] < options_.min_score_thresh())) {
+      continue;
+    }
+    candidates.push_back(i);
+  }
+  // Ties are broken by box index to keep the output deterministic.
+  auto higher_score = [detection_scores](int a, int b) {
+    return detection_scores[a] > detection_scores[b] ||
+           (detection_scores[a] == detection_scores[b] && a < b);
+  };
+  const int max_candidates = options_.non_max_suppression().max_candidates();
+  if (max_candidates > 0 && max_candidates < candidates.size()) {
+    std::partial_sort(candidates.begin(), candidates.begin() + max_candidates,
+                      candidates.end(), higher_score);
+    candidates.resize(max_candidates);
+  } else {
+    std::sort(candidates.begin(), candidates.end(), higher_score);
+  }
+  return candidates;
+}
+
+absl::Status TensorsToDetectionsCalculator::ConvertToSuppressedDetections(
+    absl::Span<const int> candidates, std::vector<float>& candidate_boxes,
+    const float* detection_scores, const int* detection_classes,
+    std::vector<Detection>* output_detections) {
+  const float min_suppression_threshold =
+      options_.non_max_suppression().min_suppression_threshold();
+  std::vector<float> kept_scores;
+  std::vector<int> kept_classes;
+  // The kept boxes are moved to the front of `candidate_boxes`. As candidates
+  // are visited in order, a kept box never overwrites an unvisited one.
+  int num_kept = 0;
+  for (int i = 0; i < candidates.size(); ++i) {
+    if (max_results_ > 0 && num_kept == max_results_) {
+      break;
+    }
+    const float* box = &candidate_boxes[i * num_coords_];
+    const float height = box[2] - box[0];
+    const float width = box[3] - box[1];
+    // Invalid boxes are dropped later by ConvertToDetections, so they must not
+    // suppress valid ones.
+    if (width < 0 || height < 0 || std::isnan(width) || std::isnan(height)) {
+      continue;
+    }
+    bool suppressed = false;
+    for (int j = 0; j < num_kept; ++j) {
+      if (IntersectionOverUnion(box, &candidate_boxes[j * num_coords_]) >
+          min_suppression_threshold) {
+        suppressed = true;
+        break;
+      }
+    }
+    if (suppressed) {
+      continue;
+    }
+    if (num_kept != i) {
+      std::copy(box, box + num_coords_,
+                &candidate_boxes[num_kept * num_coords_]);
+    }
+    kept_scores.push_back(detection_scores[candidates[i]]);
+    kept_classes.push_back(detection_classes[candidates[i]]);
+    ++num_kept;
+  }
+  return ConvertToDetections(candidate_boxes.data(), kept_scores.data(),
+                             kept_classes.data(), num_kept, output_detections);
+}
+
+absl::Status TensorsToDetectionsCalculator::ConvertToSuppressedDetections(
+    const float* boxes, const float* detection_scores,
+    const int* detection_classes, std::vector<Detection>* output_detections) {
+  const std::vector<int> candidates =
+      SelectCandidates(detection_scores, detection_classes);
+  std::vector<float> candidate_boxes(candidates.size() * num_coords_);
+  for (int i = 0; i < candidates.size(); ++i) {
+    const float* box = boxes + candidates[i] * num_coords_;
+    std::copy(box, box + num_coords_, &candidate_boxes[i * num_coords_]);
+  }
+  return ConvertToSuppressedDetections(candidates, candidate_boxes,
+                                       detection_scores, detection_classes,
+                                       output_detections);
+}
+
 Detection TensorsToDetectionsCalculator::ConvertToDetection(
     float box_ymin, float box_xmin, float box_ymax, float box_xmax,
     absl::Span<const float> scores, absl::Span<const int> class_ids,
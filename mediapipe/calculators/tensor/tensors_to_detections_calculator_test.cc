@@ -0,0 +1,151 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/object_detection/anchor.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::ParseTextProtoOrDie;
+using Node = ::mediapipe::CalculatorGraphConfig::Node;
+
+constexpr int kNumBoxes = 4;
+
+// Raw boxes as {y_center, x_center, h, w}, decoded with unit anchors at the
+// origin, and their scores.
+constexpr float kRawBoxes[kNumBoxes][4] = {{0.5f, 0.5f, 0.2f, 0.2f},
+                                           {0.51f, 0.5f, 0.2f, 0.2f},
+                                           {0.2f, 0.2f, 0.1f, 0.1f},
+                                           {0.8f, 0.8f, 0.1f, 0.1f}};
+constexpr float kRawScores[kNumBoxes] = {0.9f, 0.8f, 0.7f, 0.1f};
+
+std::unique_ptr<CalculatorRunner> CreateRunner(
+    const std::string& extra_options) {
+  auto runner = std::make_unique<CalculatorRunner>(
+      ParseTextProtoOrDie<Node>(absl::StrCat(R"pb(
+        calculator: "TensorsToDetectionsCalculator"
+        input_stream: "TENSORS:tensors"
+        input_side_packet: "ANCHORS:anchors"
+        output_stream: "DETECTIONS:detections"
+        options {
+          [mediapipe.TensorsToDetectionsCalculatorOptions.ext] {
+            num_classes: 1
+            num_boxes: 4
+            num_coords: 4
+            x_scale: 1.0
+            y_scale: 1.0
+            w_scale: 1.0
+            h_scale: 1.0
+            min_score_thresh: 0.5
+          )pb",
+                                             extra_options, "}}")));
+
+  std::vector<Anchor> anchors(kNumBoxes);
+  for (Anchor& anchor : anchors) {
+    anchor.set_x_center(0.0f);
+    anchor.set_y_center(0.0f);
+    anchor.set_w(1.0f);
+    anchor.set_h(1.0f);
+  }
+  runner->MutableSidePackets()->Tag("ANCHORS") =
+      MakePacket<std::vector<Anchor>>(std::move(anchors));
+
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->emplace_back(Tensor::ElementType::kFloat32,
+                        Tensor::Shape({1, kNumBoxes, 4}));
+  tensors->emplace_back(Tensor::ElementType::kFloat32,
+                        Tensor::Shape({1, kNumBoxes, 1}));
+  {
+    auto boxes_view = (*tensors)[0].GetCpuWriteView();
+    float* boxes = boxes_view.buffer<float>();
+    auto scores_view = (*tensors)[1].GetCpuWriteView();
+    float* scores = scores_view.buffer<float>();
+    for (int i = 0; i < kNumBoxes; ++i) {
+      for (int j = 0; j < 4; ++j) boxes[i * 4 + j] = kRawBoxes[i][j];
+      scores[i] = kRawScores[i];
+    }
+  }
+  runner->MutableInputs()->Tag("TENSORS").packets.push_back(
+      Adopt(tensors.release()).At(Timestamp(0)));
+  return runner;
+}
+
+std::vector<float> GetScores(const CalculatorRunner& runner) {
+  const auto& packets = runner.Outputs().Tag("DETECTIONS").packets;
+  ABSL_CHECK_EQ(packets.size(), 1);
+  std::vector<float> scores;
+  for (const Detection& detection :
+       packets[0].Get<std::vector<Detection>>()) {
+    ABSL_CHECK_EQ(detection.score_size(), 1);
+    scores.push_back(detection.score(0));
+  }
+  return scores;
+}
+
+TEST(TensorsToDetectionsCalculatorTest, ConvertsAllBoxesAboveThreshold) {
+  auto runner = CreateRunner("");
+  MP_ASSERT_OK(runner->Run());
+  EXPECT_THAT(GetScores(*runner), testing::ElementsAre(0.9f, 0.8f, 0.7f));
+}
+
+TEST(TensorsToDetectionsCalculatorTest, SuppressesOverlappingBoxes) {
+  auto runner = CreateRunner(R"pb(
+    non_max_suppression { min_suppression_threshold: 0.3 }
+  )pb");
+  MP_ASSERT_OK(runner->Run());
+  EXPECT_THAT(GetScores(*runner), testing::ElementsAre(0.9f, 0.7f));
+
+  const auto& detections = runner->Outputs()
+                               .Tag("DETECTIONS")
+                               .packets[0]
+                               .Get<std::vector<Detection>>();
+  const auto& bbox = detections[1].location_data().relative_bounding_box();
+  EXPECT_FLOAT_EQ(bbox.xmin(), 0.15f);
+  EXPECT_FLOAT_EQ(bbox.ymin(), 0.15f);
+  EXPECT_FLOAT_EQ(bbox.width(), 0.1f);
+  EXPECT_FLOAT_EQ(bbox.height(), 0.1f);
+}
+
+TEST(TensorsToDetectionsCalculatorTest, LimitsSuppressionCandidates) {
+  auto runner = CreateRunner(R"pb(
+    non_max_suppression { max_candidates: 1 }
+  )pb");
+  MP_ASSERT_OK(runner->Run());
+  EXPECT_THAT(GetScores(*runner), testing::ElementsAre(0.9f));
+}
+
+TEST(TensorsToDetectionsCalculatorTest, LimitsSuppressedResults) {
+  auto runner = CreateRunner(R"pb(
+    max_results: 1 non_max_suppression {}
+  )pb");
+  MP_ASSERT_OK(runner->Run());
+  EXPECT_THAT(GetScores(*runner), testing::ElementsAre(0.9f));
+}
+
+}  // namespace
+}  // namespace mediapipe
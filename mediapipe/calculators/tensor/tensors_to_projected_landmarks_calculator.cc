@@ -0,0 +1,238 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensor/tensors_to_projected_landmarks_calculator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "mediapipe/calculators/tensor/tensors_to_landmarks_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensors_to_projected_landmarks_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+namespace api2 {
+namespace {
+
+// Number of tensor values mapped to landmark fields: x, y, z, visibility and
+// presence. Further values of each landmark are ignored.
+constexpr int kMaxDimensions = 5;
+
+void ApplyActivation(TensorsToLandmarksCalculatorOptions::Activation activation,
+                     absl::Span<float> values) {
+  if (activation != TensorsToLandmarksCalculatorOptions::SIGMOID) {
+    return;
+  }
+  for (float& value : values) {
+    value = 1.0f / (1.0f + std::exp(-value));
+  }
+}
+
+// Decodes the first tensor of `tensors` into `num_landmarks` landmarks, one
+// field at a time, and applies the visibility and presence activations.
+// Coordinates are left in model input pixels.
+absl::StatusOr<LandmarkArray> DecodeLandmarks(
+    const std::vector<Tensor>& tensors,
+    const TensorsToLandmarksCalculatorOptions& options) {
+  RET_CHECK(!tensors.empty());
+  const Tensor& tensor = tensors[0];
+  RET_CHECK(tensor.element_type() == Tensor::ElementType::kFloat32);
+  const int num_landmarks = options.num_landmarks();
+  const int num_dimensions = tensor.shape().num_elements() / num_landmarks;
+  RET_CHECK_GT(num_dimensions, 0);
+
+  LandmarkArray landmarks(num_landmarks);
+  float* fields[kMaxDimensions] = {
+      landmarks.mutable_x().data(), landmarks.mutable_y().data(),
+      landmarks.mutable_z().data(), landmarks.mutable_visibility().data(),
+      landmarks.mutable_presence().data()};
+  auto view = tensor.GetCpuReadView();
+  const float* raw_landmarks = view.buffer<float>();
+  for (int d = 0; d < std::min(num_dimensions, kMaxDimensions); ++d) {
+    float* field = fields[d];
+    const float* raw = raw_landmarks + d;
+    for (int i = 0; i < num_landmarks; ++i) {
+      field[i] = raw[i * num_dimensions];
+    }
+  }
+  landmarks.set_has_visibility(num_dimensions > 3);
+  landmarks.set_has_presence(num_dimensions > 4);
+  if (landmarks.has_visibility()) {
+    ApplyActivation(options.visibility_activation(),
+                    landmarks.mutable_visibility());
+  }
+  if (landmarks.has_presence()) {
+    ApplyActivation(options.presence_activation(),
+                    landmarks.mutable_presence());
+  }
+  return landmarks;
+}
+
+// Maps landmarks from model input pixels to coordinates normalized by the
+// model input size, flipping them if requested.
+void NormalizeLandmarks(const TensorsToLandmarksCalculatorOptions& options,
+                        LandmarkArray& landmarks) {
+  const int n = landmarks.size();
+  float* x = landmarks.mutable_x().data();
+  float* y = landmarks.mutable_y().data();
+  float* z = landmarks.mutable_z().data();
+  const float width = options.input_image_width();
+  const float height = options.input_image_height();
+  const float normalize_z = options.normalize_z();
+  if (options.flip_horizontally()) {
+    for (int i = 0; i < n; ++i) x[i] = width - x[i];
+  }
+  if (options.flip_vertically()) {
+    for (int i = 0; i < n; ++i) y[i] = height - y[i];
+  }
+  for (int i = 0; i < n; ++i) {
+    x[i] = x[i] / width;
+    y[i] = y[i] / height;
+    // Scale Z coordinate as X + allow additional uniform normalization.
+    z[i] = z[i] / width / normalize_z;
+  }
+}
+
+// Same as LandmarkLetterboxRemovalCalculator.
+void RemoveLetterbox(const std::array<float, 4>& padding,
+                     LandmarkArray& landmarks) {
+  const int n = landmarks.size();
+  float* x = landmarks.mutable_x().data();
+  float* y = landmarks.mutable_y().data();
+  float* z = landmarks.mutable_z().data();
+  const float left = padding[0];
+  const float top = padding[1];
+  const float left_and_right = padding[0] + padding[2];
+  const float top_and_bottom = padding[1] + padding[3];
+  for (int i = 0; i < n; ++i) {
+    x[i] = (x[i] - left) / (1.0f - left_and_right);
+    y[i] = (y[i] - top) / (1.0f - top_and_bottom);
+    z[i] = z[i] / (1.0f - left_and_right);  // Scale Z coordinate as X.
+  }
+}
+
+// Same as LandmarkProjectionCalculator with NORM_RECT only.
+void ProjectLandmarks(const NormalizedRect& rect, bool ignore_rotation,
+                      LandmarkArray& landmarks) {
+  const int n = landmarks.size();
+  float* x = landmarks.mutable_x().data();
+  float* y = landmarks.mutable_y().data();
+  float* z = landmarks.mutable_z().data();
+  const float angle = ignore_rotation ? 0 : rect.rotation();
+  const float cos_angle = std::cos(angle);
+  const float sin_angle = std::sin(angle);
+  const float width = rect.width();
+  const float height = rect.height();
+  const float x_center = rect.x_center();
+  const float y_center = rect.y_center();
+  for (int i = 0; i < n; ++i) {
+    const float rel_x = x[i] - 0.5f;
+    const float rel_y = y[i] - 0.5f;
+    x[i] = (cos_angle * rel_x - sin_angle * rel_y) * width + x_center;
+    y[i] = (sin_angle * rel_x + cos_angle * rel_y) * height + y_center;
+    z[i] = z[i] * width;  // Scale Z coordinate as X.
+  }
+}
+
+// Same as WorldLandmarkProjectionCalculator.
+void RotateWorldLandmarks(const NormalizedRect& rect,
+                          LandmarkArray& landmarks) {
+  const int n = landmarks.size();
+  float* x = landmarks.mutable_x().data();
+  float* y = landmarks.mutable_y().data();
+  const float cosa = std::cos(rect.rotation());
+  const float sina = std::sin(rect.rotation());
+  for (int i = 0; i < n; ++i) {
+    const float in_x = x[i];
+    const float in_y = y[i];
+    x[i] = cosa * in_x - sina * in_y;
+    y[i] = sina * in_x + cosa * in_y;
+  }
+}
+
+}  // namespace
+
+class TensorsToProjectedLandmarksCalculatorImpl
+    : public NodeImpl<TensorsToProjectedLandmarksCalculator> {
+ public:
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<TensorsToProjectedLandmarksCalculatorOptions>();
+    const auto& decode_options = options_.tensors_to_landmarks();
+    RET_CHECK(decode_options.has_num_landmarks());
+    RET_CHECK(decode_options.has_input_image_width() &&
+              decode_options.has_input_image_height())
+        << "Must provide input width/height for getting normalized landmarks.";
+    RET_CHECK_EQ(kInWorldTensors(cc).IsConnected(),
+                 kOutWorldLandmarks(cc).IsConnected())
+        << "WORLD_TENSORS and WORLD_LANDMARKS must be used together.";
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const auto& decode_options = options_.tensors_to_landmarks();
+    const bool missing_rect =
+        kInNormRect(cc).IsConnected() && kInNormRect(cc).IsEmpty();
+    const bool missing_padding = kInLetterboxPadding(cc).IsConnected() &&
+                                 kInLetterboxPadding(cc).IsEmpty();
+
+    if (kOutNormLandmarks(cc).IsConnected() && !kInTensors(cc).IsEmpty() &&
+        !missing_rect && !missing_padding) {
+      MP_ASSIGN_OR_RETURN(LandmarkArray landmarks,
+                          DecodeLandmarks(*kInTensors(cc), decode_options));
+      NormalizeLandmarks(decode_options, landmarks);
+      if (kInLetterboxPadding(cc).IsConnected()) {
+        RemoveLetterbox(*kInLetterboxPadding(cc), landmarks);
+      }
+      if (kInNormRect(cc).IsConnected()) {
+        ProjectLandmarks(*kInNormRect(cc), options_.ignore_rotation(),
+                         landmarks);
+      }
+      NormalizedLandmarkList output;
+      LandmarkArrayToProto(landmarks, &output);
+      kOutNormLandmarks(cc).Send(std::move(output));
+    }
+
+    if (kOutWorldLandmarks(cc).IsConnected() &&
+        !kInWorldTensors(cc).IsEmpty() && !missing_rect) {
+      MP_ASSIGN_OR_RETURN(
+          LandmarkArray landmarks,
+          DecodeLandmarks(*kInWorldTensors(cc), decode_options));
+      if (kInNormRect(cc).IsConnected()) {
+        RotateWorldLandmarks(*kInNormRect(cc), landmarks);
+      }
+      LandmarkList output;
+      LandmarkArrayToProto(landmarks, &output);
+      kOutWorldLandmarks(cc).Send(std::move(output));
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  TensorsToProjectedLandmarksCalculatorOptions options_;
+};
+MEDIAPIPE_NODE_IMPLEMENTATION(TensorsToProjectedLandmarksCalculatorImpl);
+
+}  // namespace api2
+}  // namespace mediapipe
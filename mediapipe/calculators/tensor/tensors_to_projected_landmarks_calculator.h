@@ -0,0 +1,100 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_PROJECTED_LANDMARKS_CALCULATOR_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_PROJECTED_LANDMARKS_CALCULATOR_H_
+
+#include <array>
+#include <vector>
+
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe {
+namespace api2 {
+
+// A calculator that decodes the landmark tensor of a landmark model and maps
+// the landmarks back to the full image in one step. It produces the same
+// landmarks as the chain
+//   TensorsToLandmarksCalculator (NORM_LANDMARKS)
+//   -> LandmarkLetterboxRemovalCalculator
+//   -> LandmarkProjectionCalculator (NORM_RECT)
+// and, for WORLD_TENSORS, as
+//   TensorsToLandmarksCalculator (LANDMARKS)
+//   -> WorldLandmarkProjectionCalculator
+// but reads the tensor once into a LandmarkArray and applies every step as a
+// loop over its coordinate arrays, instead of building and copying a proto
+// list per step.
+//
+// Inputs:
+//   TENSORS - std::vector<Tensor>
+//     Output of the landmark model. Only the first tensor is used; it must be
+//     kFloat32 and hold num_landmarks x num_dimensions values.
+//   LETTERBOX_PADDING (optional) - std::array<float, 4>
+//     Normalized [left, top, right, bottom] padding added to the ROI to fit
+//     the model input, as output by ImageToTensorCalculator.
+//   NORM_RECT (optional) - NormalizedRect
+//     ROI the model ran on. Without it the landmarks stay relative to the ROI.
+//   WORLD_TENSORS (optional) - std::vector<Tensor>
+//     World landmark output of the model, decoded the same way but neither
+//     normalized nor flipped, and only rotated by the NORM_RECT rotation.
+//
+// Outputs:
+//   NORM_LANDMARKS (optional) - NormalizedLandmarkList
+//   WORLD_LANDMARKS (optional) - LandmarkList
+//
+// Like the chain, nothing is output for a timestamp at which one of the
+// connected inputs is empty.
+//
+// Example:
+//   node {
+//     calculator: "TensorsToProjectedLandmarksCalculator"
+//     input_stream: "TENSORS:landmark_tensors"
+//     input_stream: "LETTERBOX_PADDING:letterbox_padding"
+//     input_stream: "NORM_RECT:roi"
+//     output_stream: "NORM_LANDMARKS:landmarks"
+//     options: {
+//       [mediapipe.TensorsToProjectedLandmarksCalculatorOptions.ext] {
+//         tensors_to_landmarks {
+//           num_landmarks: 21
+//           input_image_width: 224
+//           input_image_height: 224
+//         }
+//       }
+//     }
+//   }
+class TensorsToProjectedLandmarksCalculator : public NodeIntf {
+ public:
+  static constexpr Input<std::vector<Tensor>> kInTensors{"TENSORS"};
+  static constexpr Input<std::array<float, 4>>::Optional kInLetterboxPadding{
+      "LETTERBOX_PADDING"};
+  static constexpr Input<NormalizedRect>::Optional kInNormRect{"NORM_RECT"};
+  static constexpr Input<std::vector<Tensor>>::Optional kInWorldTensors{
+      "WORLD_TENSORS"};
+  static constexpr Output<NormalizedLandmarkList>::Optional kOutNormLandmarks{
+      "NORM_LANDMARKS"};
+  static constexpr Output<LandmarkList>::Optional kOutWorldLandmarks{
+      "WORLD_LANDMARKS"};
+  MEDIAPIPE_NODE_INTERFACE(TensorsToProjectedLandmarksCalculator, kInTensors,
+                           kInLetterboxPadding, kInNormRect, kInWorldTensors,
+                           kOutNormLandmarks, kOutWorldLandmarks);
+};
+
+}  // namespace api2
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_TENSORS_TO_PROJECTED_LANDMARKS_CALCULATOR_H_
@@ -0,0 +1,197 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_format.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumLandmarks = 7;
+constexpr int kNumDimensions = 5;
+
+// Runs the fused calculator next to the calculator chain it replaces and
+// returns the {fused, chained} outputs of `stream`.
+std::array<Packet, 2> RunFusedAndChained(const std::string& decode_options,
+                                         const std::string& stream) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(absl::StrFormat(
+      R"pb(
+        input_stream: "tensors"
+        input_stream: "world_tensors"
+        input_stream: "padding"
+        input_stream: "rect"
+        node {
+          calculator: "TensorsToProjectedLandmarksCalculator"
+          input_stream: "TENSORS:tensors"
+          input_stream: "WORLD_TENSORS:world_tensors"
+          input_stream: "LETTERBOX_PADDING:padding"
+          input_stream: "NORM_RECT:rect"
+          output_stream: "NORM_LANDMARKS:fused_landmarks"
+          output_stream: "WORLD_LANDMARKS:fused_world_landmarks"
+          options {
+            [mediapipe.TensorsToProjectedLandmarksCalculatorOptions.ext] {
+              tensors_to_landmarks { %s }
+            }
+          }
+        }
+        node {
+          calculator: "TensorsToLandmarksCalculator"
+          input_stream: "TENSORS:tensors"
+          output_stream: "NORM_LANDMARKS:decoded"
+          options {
+            [mediapipe.TensorsToLandmarksCalculatorOptions.ext] { %s }
+          }
+        }
+        node {
+          calculator: "LandmarkLetterboxRemovalCalculator"
+          input_stream: "LANDMARKS:decoded"
+          input_stream: "LETTERBOX_PADDING:padding"
+          output_stream: "LANDMARKS:unpadded"
+        }
+        node {
+          calculator: "LandmarkProjectionCalculator"
+          input_stream: "NORM_LANDMARKS:unpadded"
+          input_stream: "NORM_RECT:rect"
+          output_stream: "NORM_LANDMARKS:chained_landmarks"
+        }
+        node {
+          calculator: "TensorsToLandmarksCalculator"
+          input_stream: "TENSORS:world_tensors"
+          output_stream: "LANDMARKS:world_decoded"
+          options {
+            [mediapipe.TensorsToLandmarksCalculatorOptions.ext] {
+              num_landmarks: %d
+              visibility_activation: SIGMOID
+              presence_activation: SIGMOID
+            }
+          }
+        }
+        node {
+          calculator: "WorldLandmarkProjectionCalculator"
+          input_stream: "LANDMARKS:world_decoded"
+          input_stream: "NORM_RECT:rect"
+          output_stream: "LANDMARKS:chained_world_landmarks"
+        }
+      )pb",
+      decode_options, decode_options, kNumLandmarks));
+  std::vector<Packet> fused;
+  std::vector<Packet> chained;
+  tool::AddVectorSink(absl::StrFormat("fused_%s", stream), &config, &fused);
+  tool::AddVectorSink(absl::StrFormat("chained_%s", stream), &config,
+                      &chained);
+
+  auto make_tensors = [](float offset) {
+    std::vector<Tensor> tensors;
+    tensors.emplace_back(Tensor::ElementType::kFloat32,
+                         Tensor::Shape{1, kNumLandmarks * kNumDimensions});
+    auto view = tensors[0].GetCpuWriteView();
+    float* values = view.buffer<float>();
+    for (int i = 0; i < kNumLandmarks * kNumDimensions; ++i) {
+      values[i] = offset + 17.3f * i - 3.1f * (i % kNumDimensions);
+    }
+    return tensors;
+  };
+  NormalizedRect rect;
+  rect.set_x_center(0.4f);
+  rect.set_y_center(0.6f);
+  rect.set_width(0.3f);
+  rect.set_height(0.5f);
+  rect.set_rotation(0.7f);
+
+  CalculatorGraph graph;
+  MP_EXPECT_OK(graph.Initialize(config));
+  MP_EXPECT_OK(graph.StartRun({}));
+  const Timestamp timestamp(0);
+  MP_EXPECT_OK(graph.AddPacketToInputStream(
+      "tensors", MakePacket<std::vector<Tensor>>(make_tensors(-20.0f))
+                     .At(timestamp)));
+  MP_EXPECT_OK(graph.AddPacketToInputStream(
+      "world_tensors",
+      MakePacket<std::vector<Tensor>>(make_tensors(-0.9f)).At(timestamp)));
+  MP_EXPECT_OK(graph.AddPacketToInputStream(
+      "padding", MakePacket<std::array<float, 4>>(
+                     std::array<float, 4>{0.1f, 0.05f, 0.2f, 0.15f})
+                     .At(timestamp)));
+  MP_EXPECT_OK(graph.AddPacketToInputStream(
+      "rect", MakePacket<NormalizedRect>(rect).At(timestamp)));
+  MP_EXPECT_OK(graph.CloseAllInputStreams());
+  MP_EXPECT_OK(graph.WaitUntilDone());
+  EXPECT_EQ(fused.size(), 1);
+  EXPECT_EQ(chained.size(), 1);
+  if (fused.size() != 1 || chained.size() != 1) {
+    return {};
+  }
+  return {fused[0], chained[0]};
+}
+
+TEST(TensorsToProjectedLandmarksCalculatorTest, MatchesChainedCalculators) {
+  const std::array<Packet, 2> outputs =
+      RunFusedAndChained(R"pb(num_landmarks: 7
+                              input_image_width: 256
+                              input_image_height: 192
+                              normalize_z: 0.4
+                              visibility_activation: SIGMOID
+                              presence_activation: SIGMOID)pb",
+                         "landmarks");
+  ASSERT_FALSE(outputs[0].IsEmpty());
+  const auto& fused = outputs[0].Get<NormalizedLandmarkList>();
+  const auto& chained = outputs[1].Get<NormalizedLandmarkList>();
+  EXPECT_EQ(fused.landmark_size(), kNumLandmarks);
+  EXPECT_EQ(fused.SerializeAsString(), chained.SerializeAsString());
+}
+
+TEST(TensorsToProjectedLandmarksCalculatorTest, MatchesChainedWhenFlipped) {
+  const std::array<Packet, 2> outputs =
+      RunFusedAndChained(R"pb(num_landmarks: 7
+                              input_image_width: 256
+                              input_image_height: 256
+                              flip_horizontally: true
+                              flip_vertically: true)pb",
+                         "landmarks");
+  ASSERT_FALSE(outputs[0].IsEmpty());
+  EXPECT_EQ(outputs[0].Get<NormalizedLandmarkList>().SerializeAsString(),
+            outputs[1].Get<NormalizedLandmarkList>().SerializeAsString());
+}
+
+TEST(TensorsToProjectedLandmarksCalculatorTest, MatchesChainedWorldLandmarks) {
+  const std::array<Packet, 2> outputs =
+      RunFusedAndChained(R"pb(num_landmarks: 7
+                              input_image_width: 256
+                              input_image_height: 256
+                              visibility_activation: SIGMOID
+                              presence_activation: SIGMOID)pb",
+                         "world_landmarks");
+  ASSERT_FALSE(outputs[0].IsEmpty());
+  const auto& fused = outputs[0].Get<LandmarkList>();
+  EXPECT_EQ(fused.landmark_size(), kNumLandmarks);
+  EXPECT_TRUE(fused.landmark(0).has_presence());
+  EXPECT_EQ(fused.SerializeAsString(),
+            outputs[1].Get<LandmarkList>().SerializeAsString());
+}
+
+}  // namespace
+}  // namespace mediapipe
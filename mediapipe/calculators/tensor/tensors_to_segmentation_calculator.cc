@@ -42,6 +42,11 @@
 #else
 #include "mediapipe/calculators/tensor/tensors_to_segmentation_converter_gl_texture.h"
 #endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
+#if MEDIAPIPE_USE_WEBGPU
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_converter_webgpu.h"
+#include "mediapipe/gpu/webgpu/webgpu_check.h"
+#include "mediapipe/gpu/webgpu/webgpu_service.h"
+#endif  // MEDIAPIPE_USE_WEBGPU
 #endif  // !MEDIAPIPE_DISABLE_GPU
 
 #if !MEDIAPIPE_DISABLE_OPENCV
@@ -68,7 +73,9 @@ namespace mediapipe {
 //
 // If at least one input tensor is already on GPU, processing happens on GPU and
 // the output mask is also stored on GPU. Otherwise, processing and the output
-// mask are both on CPU.
+// mask are both on CPU. In WebGPU-enabled builds, an input tensor stored in a
+// WebGPU texture is processed with a WebGPU compute shader and the mask stays
+// in a WebGPU texture.
 //
 // On GPU, the mask is an RGBA image, in both the R & A channels, scaled 0-1.
 // On CPU, the mask is a ImageFormat::VEC32F1 image, with values scaled 0-1.
@@ -124,6 +131,13 @@ class TensorsToSegmentationCalculator : public Node {
     if (use_gpu) {
 #if !MEDIAPIPE_DISABLE_GPU
       if (!gpu_converter_) {
+#if MEDIAPIPE_USE_WEBGPU
+        if (use_webgpu_) {
+          MP_ASSIGN_OR_RETURN(gpu_converter_,
+                              CreateWebGpuConverter(cc, options_));
+          return absl::OkStatus();
+        }
+#endif  // MEDIAPIPE_USE_WEBGPU
 #if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
         MP_ASSIGN_OR_RETURN(gpu_converter_,
                             CreateGlBufferConverter(cc, options_));
@@ -154,6 +168,9 @@ class TensorsToSegmentationCalculator : public Node {
   mediapipe::TensorsToSegmentationCalculatorOptions options_;
   std::unique_ptr<TensorsToSegmentationConverter> cpu_converter_;
   std::unique_ptr<TensorsToSegmentationConverter> gpu_converter_;
+  // Whether gpu_converter_ is, or is to be, the WebGPU converter. Decided by
+  // the first GPU input tensor.
+  bool use_webgpu_ = false;
 };
 MEDIAPIPE_REGISTER_NODE(TensorsToSegmentationCalculator);
 
@@ -169,6 +186,9 @@ absl::Status TensorsToSegmentationCalculator::UpdateContract(
 #if MEDIAPIPE_METAL_ENABLED
     MP_RETURN_IF_ERROR([MPPMetalHelper updateContract:cc]);
 #endif  // MEDIAPIPE_METAL_ENABLED
+#if MEDIAPIPE_USE_WEBGPU
+    cc->UseService(kWebGpuService).Optional();
+#endif  // MEDIAPIPE_USE_WEBGPU
 #endif  // !MEDIAPIPE_DISABLE_GPU
   }
 
@@ -230,6 +250,12 @@ absl::Status TensorsToSegmentationCalculator::Process(CalculatorContext* cc) {
 
   if (use_gpu) {
 #if !MEDIAPIPE_DISABLE_GPU
+#if MEDIAPIPE_USE_WEBGPU
+    if (!gpu_converter_) {
+      use_webgpu_ =
+          input_tensor->ready_as_webgpu_texture_2d() && IsWebGpuAvailable();
+    }
+#endif  // MEDIAPIPE_USE_WEBGPU
     // Lazily initialize converter
     MP_RETURN_IF_ERROR(InitConverterIfNecessary(use_gpu, cc));
     MP_ASSIGN_OR_RETURN(
@@ -0,0 +1,258 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_converter_webgpu.h"
+
+#include <webgpu/webgpu_cpp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_converter.h"
+#include "mediapipe/calculators/tensor/tensors_to_segmentation_utils.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/gpu/gpu_buffer.h"
+#include "mediapipe/gpu/gpu_buffer_format.h"
+#include "mediapipe/gpu/webgpu/webgpu_service.h"
+#include "mediapipe/gpu/webgpu/webgpu_texture_buffer.h"
+
+namespace mediapipe {
+namespace {
+
+using ::mediapipe::tensors_to_segmentation_utils::GetHwcFromDims;
+using Options = ::mediapipe::TensorsToSegmentationCalculatorOptions;
+
+constexpr uint32_t kTileSize = 8;
+
+// Returns the WGSL body of `fn mask_value`, which applies the activation to
+// the tensor value `value`.
+std::string GetActivationSource(const Options& options) {
+  switch (options.activation()) {
+    case Options::SOFTMAX:
+      // Only two channel input tensor is supported.
+      return absl::StrFormat(R"(
+  let shift = max(value.r, value.g);
+  let softmax_denom = exp(value.r - shift) + exp(value.g - shift);
+  return exp(mix(value.r, value.g, %d.0) - shift) / softmax_denom;)",
+                             options.output_layer_index());
+    case Options::SIGMOID:
+      return R"(
+  return 1.0 / (exp(-value.r) + 1.0);)";
+    case Options::NONE:
+    default:
+      return R"(
+  return value.r;)";
+  }
+}
+
+// Computes the mask at the output resolution in one compute pass: every
+// output pixel applies the activation to its four nearest tensor values and
+// interpolates them bilinearly, which matches running the activation at
+// tensor resolution followed by a linear upsampling, as the GL converters do,
+// without the intermediate texture.
+//
+// TODO: Support `gpu_origin`. WebGPU textures and tensors both start at the
+// top, so no flip is applied.
+class TensorsToSegmentationWebGpuConverter
+    : public TensorsToSegmentationConverter {
+ public:
+  explicit TensorsToSegmentationWebGpuConverter(CalculatorContext* cc)
+      : service_(cc->Service(kWebGpuService).GetObject()) {}
+
+  absl::Status Init(const Options& options) {
+    const std::string shader = absl::StrFormat(R"(
+struct Parameters {
+  input_size : vec2<u32>,
+  output_size : vec2<u32>,
+};
+
+@group(0) @binding(0) var input : texture_2d<f32>;
+@group(0) @binding(1) var output : texture_storage_2d<rgba8unorm, write>;
+@group(0) @binding(2) var<uniform> params : Parameters;
+
+fn mask_value(coord : vec2<i32>) -> f32 {
+  let max_coord = vec2<i32>(params.input_size) - vec2<i32>(1);
+  let value = textureLoad(input, clamp(coord, vec2<i32>(0), max_coord), 0);%s
+}
+
+@compute @workgroup_size(%d, %d)
+fn main(@builtin(global_invocation_id) gid : vec3<u32>) {
+  if (gid.x >= params.output_size.x || gid.y >= params.output_size.y) {
+    return;
+  }
+  let scale = vec2<f32>(params.input_size) / vec2<f32>(params.output_size);
+  let coord = (vec2<f32>(gid.xy) + vec2<f32>(0.5)) * scale - vec2<f32>(0.5);
+  let base = floor(coord);
+  let t = coord - base;
+  let p = vec2<i32>(base);
+  let top = mix(mask_value(p), mask_value(p + vec2<i32>(1, 0)), t.x);
+  let bottom = mix(mask_value(p + vec2<i32>(0, 1)),
+                   mask_value(p + vec2<i32>(1, 1)), t.x);
+  let mask = mix(top, bottom, t.y);
+  textureStore(output, vec2<i32>(gid.xy), vec4<f32>(mask, 0.0, 0.0, mask));
+}
+)",
+                                               GetActivationSource(options),
+                                               kTileSize, kTileSize);
+
+    // Create the shader module.
+    wgpu::ShaderModuleWGSLDescriptor wgsl;
+    wgsl.code = shader.c_str();
+    wgpu::ShaderModuleDescriptor shader_desc = {.nextInChain = &wgsl};
+    wgpu::ShaderModule module =
+        service_.device().CreateShaderModule(&shader_desc);
+
+    // Create the compute pipeline.
+    wgpu::ComputePipelineDescriptor pipeline_desc = {
+        .compute =
+            {
+                .module = module,
+                .entryPoint = "main",
+                .constantCount = 0,
+                .constants = nullptr,
+            },
+    };
+    pipeline_ = service_.device().CreateComputePipeline(&pipeline_desc);
+    RET_CHECK(pipeline_) << "Problem initializing the compute pipeline.";
+
+    // Create a uniform buffer for the parameters.
+    wgpu::BufferDescriptor buffer_desc = {
+        .usage = wgpu::BufferUsage::Uniform | wgpu::BufferUsage::CopyDst,
+        .size = sizeof(Parameters),
+    };
+    params_buffer_ = service_.device().CreateBuffer(&buffer_desc);
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<std::unique_ptr<Image>> Convert(const Tensor& input_tensor,
+                                                 int output_width,
+                                                 int output_height) override {
+    RET_CHECK(output_width > 0 && output_height > 0)
+        << "Empty output dimensions.";
+    MP_ASSIGN_OR_RETURN(auto hwc, GetHwcFromDims(input_tensor.shape().dims));
+    auto [tensor_height, tensor_width, tensor_channels] = hwc;
+    const wgpu::Device& device = service_.device();
+
+    // Go through CPU if not already a WebGPU texture (no direct conversion
+    // yet). Tensor::GetWebGpuTexture2dReadView() only uploads from CPU.
+    if (!input_tensor.ready_as_webgpu_texture_2d()) {
+      (void)input_tensor.GetCpuReadView();
+    }
+    auto read_view = input_tensor.GetWebGpuTexture2dReadView(service_);
+    wgpu::Texture src_texture = read_view.name();
+
+    auto& pool = GetWebGpuDeviceCachedAttachment(device, kWebGpuTexturePool);
+    MP_ASSIGN_OR_RETURN(
+        std::shared_ptr<WebGpuTextureBuffer> output_buffer,
+        pool.GetBuffer(output_width, output_height, GpuBufferFormat::kRGBA32));
+    GpuBuffer output(std::move(output_buffer));
+    wgpu::Texture dst_texture =
+        output.GetWriteView<WebGpuTextureView>().texture();
+
+    Parameters params = {
+        .input_width = static_cast<uint32_t>(tensor_width),
+        .input_height = static_cast<uint32_t>(tensor_height),
+        .output_width = static_cast<uint32_t>(output_width),
+        .output_height = static_cast<uint32_t>(output_height),
+    };
+    if (memcmp(&params, &last_params_, sizeof(Parameters)) != 0) {
+      last_params_ = params;
+      device.GetQueue().WriteBuffer(params_buffer_, 0, &last_params_,
+                                    sizeof(Parameters));
+    }
+
+    // Create the bind group.
+    // [[group(0), binding(0)]] is the input tensor texture.
+    // [[group(0), binding(1)]] is the output mask texture.
+    // [[group(0), binding(2)]] is the shader parameters uniform buffer.
+    wgpu::BindGroupEntry entries[] = {
+        {
+            .binding = 0,
+            .textureView = src_texture.CreateView(),
+        },
+        {
+            .binding = 1,
+            .textureView = dst_texture.CreateView(),
+        },
+        {
+            .binding = 2,
+            .buffer = params_buffer_,
+            .size = sizeof(Parameters),
+        },
+    };
+    wgpu::BindGroupDescriptor bind_group_desc = {
+        .layout = pipeline_.GetBindGroupLayout(0),
+        .entryCount = std::size(entries),
+        .entries = entries,
+    };
+    wgpu::BindGroup bind_group = device.CreateBindGroup(&bind_group_desc);
+
+    // Round up the number of workgroups to cover the whole mask.
+    const uint32_t num_groups_x = (output_width + kTileSize - 1) / kTileSize;
+    const uint32_t num_groups_y = (output_height + kTileSize - 1) / kTileSize;
+
+    // Create and submit a command buffer that dispatches the compute shader.
+    // The mask stays on the GPU; the queue orders it before later commands
+    // reading the texture.
+    auto command_encoder = device.CreateCommandEncoder();
+    auto pass_encoder = command_encoder.BeginComputePass();
+    pass_encoder.SetPipeline(pipeline_);
+    pass_encoder.SetBindGroup(0, bind_group);
+    pass_encoder.DispatchWorkgroups(num_groups_x, num_groups_y);
+    pass_encoder.End();
+    wgpu::CommandBuffer command_buffers[] = {
+        command_encoder.Finish(),
+    };
+    device.GetQueue().Submit(std::size(command_buffers), command_buffers);
+
+    return std::make_unique<Image>(std::move(output));
+  }
+
+ private:
+  struct Parameters {  // Must match `Parameters` in WGSL above.
+    uint32_t input_width;
+    uint32_t input_height;
+    uint32_t output_width;
+    uint32_t output_height;
+  };
+
+  const WebGpuService& service_;
+  wgpu::ComputePipeline pipeline_;
+  wgpu::Buffer params_buffer_;
+  Parameters last_params_ = {};
+};
+
+}  // namespace
+
+absl::StatusOr<std::unique_ptr<TensorsToSegmentationConverter>>
+CreateWebGpuConverter(CalculatorContext* cc, const Options& options) {
+  auto converter = std::make_unique<TensorsToSegmentationWebGpuConverter>(cc);
+  MP_RETURN_IF_ERROR(converter->Init(options));
+  return converter;
+}
+
+}  // namespace mediapipe
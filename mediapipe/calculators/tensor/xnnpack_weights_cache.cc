@@ -0,0 +1,78 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/calculators/tensor/xnnpack_weights_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace mediapipe {
+namespace {
+
+struct Registry {
+  absl::Mutex mutex;
+  absl::flat_hash_map<std::string, std::weak_ptr<XnnpackWeightsCache>> caches
+      ABSL_GUARDED_BY(mutex);
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+}  // namespace
+
+XnnpackWeightsCache::~XnnpackWeightsCache() {
+  TfLiteXNNPackDelegateWeightsCacheDelete(cache_);
+}
+
+/* static */
+absl::StatusOr<std::shared_ptr<XnnpackWeightsCache>>
+XnnpackWeightsCache::GetOrCreate(const std::string& key) {
+  Registry& registry = GetRegistry();
+  absl::MutexLock lock(&registry.mutex);
+  std::weak_ptr<XnnpackWeightsCache>& entry = registry.caches[key];
+  if (std::shared_ptr<XnnpackWeightsCache> cache = entry.lock()) {
+    return cache;
+  }
+  TfLiteXNNPackDelegateWeightsCache* cache =
+      TfLiteXNNPackDelegateWeightsCacheCreate();
+  if (cache == nullptr) {
+    registry.caches.erase(key);
+    return absl::InternalError("Failed to create XNNPACK weights cache.");
+  }
+  auto shared_cache =
+      std::shared_ptr<XnnpackWeightsCache>(new XnnpackWeightsCache(cache));
+  entry = shared_cache;
+  return shared_cache;
+}
+
+absl::Status XnnpackWeightsCache::Finalize() {
+  absl::MutexLock lock(&mutex_);
+  if (finalized_) return absl::OkStatus();
+  if (!TfLiteXNNPackDelegateWeightsCacheFinalizeSoft(cache_)) {
+    return absl::InternalError("Failed to finalize XNNPACK weights cache.");
+  }
+  finalized_ = true;
+  return absl::OkStatus();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,65 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSOR_XNNPACK_WEIGHTS_CACHE_H_
+#define MEDIAPIPE_CALCULATORS_TENSOR_XNNPACK_WEIGHTS_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace mediapipe {
+
+// An XNNPACK weights cache shared by the XNNPACK delegates of all interpreters
+// in the process that run the same model with the same delegate options, so
+// that the packed weights of the model are created and kept in memory once.
+class XnnpackWeightsCache {
+ public:
+  XnnpackWeightsCache(const XnnpackWeightsCache&) = delete;
+  XnnpackWeightsCache& operator=(const XnnpackWeightsCache&) = delete;
+  ~XnnpackWeightsCache();
+
+  // Returns the weights cache for `key`, creating it on first use. The cache
+  // is destroyed when the last returned pointer is released, so delegates
+  // using the cache must hold on to it.
+  static absl::StatusOr<std::shared_ptr<XnnpackWeightsCache>> GetOrCreate(
+      const std::string& key);
+
+  // The cache to set in TfLiteXNNPackDelegateOptions::weights_cache.
+  TfLiteXNNPackDelegateWeightsCache* get() const { return cache_; }
+
+  // Finalizes the cache after the first delegate using it was applied to an
+  // interpreter, as XNNPACK runs inference only with finalized caches. The
+  // finalization is soft, so that the delegates of later interpreters can
+  // still look up the packed weights.
+  absl::Status Finalize();
+
+ private:
+  explicit XnnpackWeightsCache(TfLiteXNNPackDelegateWeightsCache* cache)
+      : cache_(cache) {}
+
+  TfLiteXNNPackDelegateWeightsCache* const cache_;
+  absl::Mutex mutex_;
+  bool finalized_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSOR_XNNPACK_WEIGHTS_CACHE_H_
@@ -0,0 +1,53 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/calculators/tensor/xnnpack_weights_cache.h"
+
+#include <memory>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(XnnpackWeightsCacheTest, SharesCachesByKey) {
+  MP_ASSERT_OK_AND_ASSIGN(auto a, XnnpackWeightsCache::GetOrCreate("a"));
+  MP_ASSERT_OK_AND_ASSIGN(auto a2, XnnpackWeightsCache::GetOrCreate("a"));
+  MP_ASSERT_OK_AND_ASSIGN(auto b, XnnpackWeightsCache::GetOrCreate("b"));
+  EXPECT_EQ(a, a2);
+  EXPECT_NE(a, b);
+  EXPECT_NE(a->get(), nullptr);
+}
+
+TEST(XnnpackWeightsCacheTest, DestroysCacheAfterLastUser) {
+  std::weak_ptr<XnnpackWeightsCache> weak_cache;
+  {
+    MP_ASSERT_OK_AND_ASSIGN(auto cache, XnnpackWeightsCache::GetOrCreate("a"));
+    weak_cache = cache;
+  }
+  EXPECT_TRUE(weak_cache.expired());
+  MP_ASSERT_OK_AND_ASSIGN(auto cache, XnnpackWeightsCache::GetOrCreate("a"));
+  EXPECT_NE(cache, nullptr);
+}
+
+TEST(XnnpackWeightsCacheTest, FinalizesOnce) {
+  MP_ASSERT_OK_AND_ASSIGN(auto cache, XnnpackWeightsCache::GetOrCreate("a"));
+  MP_EXPECT_OK(cache->Finalize());
+  MP_EXPECT_OK(cache->Finalize());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "mediapipe/calculators/tensorflow/image_frame_to_tensor_calculator.pb.h"
+#include "mediapipe/calculators/tensorflow/packet_tensor_buffer.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/port/proto_ns.h"
@@ -183,6 +184,15 @@ absl::Status ImageFrameToTensorCalculator::Process(CalculatorContext* cc) {
         << "Tensor data type does not support memcpy (type=" << data_type
         << ")";
 
+    if (video_frame.IsContiguous() &&
+        CanReferenceInTensor(video_frame.PixelData())) {
+      // The tensor shares the frame's pixels and keeps the input packet alive.
+      tensor = ::absl::make_unique<tf::Tensor>(MakeTensorReferencingPacket(
+          input_item, data_type, tensor_shape, video_frame.PixelData()));
+      cc->Outputs().Index(0).Add(tensor.release(), cc->InputTimestamp());
+      return absl::OkStatus();
+    }
+
     // Create the output tensor.
     tensor = ::absl::make_unique<tf::Tensor>(data_type, tensor_shape);
 
@@ -12,14 +12,22 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "mediapipe/calculators/tensorflow/lapped_tensor_buffer_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/profiler/circular_buffer.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
@@ -36,6 +44,53 @@ const char kCalculatorOptions[] = "CALCULATOR_OPTIONS";
 
 namespace tf = tensorflow;
 
+namespace {
+
+char* MutableTensorData(const tf::Tensor& tensor) {
+  return const_cast<char*>(tensor.tensor_data().data());
+}
+
+absl::StatusOr<Tensor::ElementType> MediaPipeElementType(tf::DataType dtype) {
+  switch (dtype) {
+    case tf::DT_FLOAT:
+      return Tensor::ElementType::kFloat32;
+    case tf::DT_HALF:
+      return Tensor::ElementType::kFloat16;
+    case tf::DT_UINT8:
+      return Tensor::ElementType::kUInt8;
+    case tf::DT_INT8:
+      return Tensor::ElementType::kInt8;
+    case tf::DT_INT32:
+      return Tensor::ElementType::kInt32;
+    case tf::DT_INT64:
+      return Tensor::ElementType::kInt64;
+    case tf::DT_BOOL:
+      return Tensor::ElementType::kBool;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("No mediapipe::Tensor element type for ",
+                       tf::DataTypeString(dtype)));
+  }
+}
+
+// Copies `tensor` into a new mediapipe::Tensor of the same shape.
+absl::StatusOr<std::unique_ptr<Tensor>> ToMediaPipeTensor(
+    const tf::Tensor& tensor) {
+  MP_ASSIGN_OR_RETURN(Tensor::ElementType element_type,
+                      MediaPipeElementType(tensor.dtype()));
+  std::vector<int> dims;
+  for (int i = 0; i < tensor.dims(); ++i) {
+    dims.push_back(tensor.dim_size(i));
+  }
+  auto output = absl::make_unique<Tensor>(element_type, Tensor::Shape(dims));
+  auto view = output->GetCpuWriteView();
+  std::memcpy(view.buffer<char>(), tensor.tensor_data().data(),
+              tensor.TotalBytes());
+  return output;
+}
+
+}  // namespace
+
 // Given an input stream of tensors, concatenates the tensors over timesteps.
 // The concatenated output tensors can be specified to have overlap between
 // output timesteps. The tensors are concatenated along the first dimension, and
@@ -65,6 +120,11 @@ namespace tf = tensorflow;
 //   }
 // }
 //
+// With contiguous_window_buffer set, each input tensor is copied once into a
+// buffer that holds up to twice buffer_size tensors, and the windows are
+// output as slices of that buffer. This avoids copying the whole window for
+// every output, which dominates for large windows with a large overlap.
+//
 // Example config with padding and timestamp output:
 // node {
 //   calculator: "LappedTensorBufferCalculator"
@@ -96,6 +156,16 @@ class LappedTensorBufferCalculator : public CalculatorBase {
   absl::Status AddBatchDimension(tf::Tensor* input_tensor);
   // Sends the current buffer downstream.
   absl::Status ProcessBuffer(CalculatorContext* cc);
+  // Adds a tensor to the window. The next window is output after
+  // `frames_until_output` tensors, including this one, have been added.
+  absl::Status PushFrame(const tf::Tensor& tensor, Timestamp timestamp,
+                         int frames_until_output);
+  // Copies `tensor` to the end of window_buffer_, moving the tensors of the
+  // next window to a new buffer first if window_buffer_ is full.
+  absl::Status AppendToWindowBuffer(const tf::Tensor& tensor,
+                                    int frames_until_output);
+  // Returns the current window as a slice of window_buffer_.
+  absl::StatusOr<tf::Tensor> WindowFromBuffer();
 
   int steps_until_output_;
   int buffer_size_;
@@ -105,6 +175,11 @@ class LappedTensorBufferCalculator : public CalculatorBase {
 
   std::unique_ptr<CircularBuffer<Timestamp>> timestamp_buffer_;
   std::unique_ptr<CircularBuffer<tf::Tensor>> buffer_;
+  // Used with contiguous_window_buffer. Holds window_buffer_frames_ input
+  // tensors concatenated along the first dimension, and room for up to
+  // 2 * buffer_size_ of them.
+  tf::Tensor window_buffer_;
+  int window_buffer_frames_ = 0;
   LappedTensorBufferCalculatorOptions options_;
 };
 
@@ -133,9 +208,16 @@ absl::Status LappedTensorBufferCalculator::GetContract(CalculatorContract* cc) {
         .Tag(kCalculatorOptions)
         .Set<LappedTensorBufferCalculatorOptions>();
   }
-  cc->Outputs().Index(0).Set<tf::Tensor>(
-      // Output tensorflow::Tensor stream with possibly overlapping steps.
-  );
+  if (cc->Options<LappedTensorBufferCalculatorOptions>()
+          .output_mediapipe_tensor()) {
+    cc->Outputs().Index(0).Set<Tensor>(
+        // Output mediapipe::Tensor stream with possibly overlapping steps.
+    );
+  } else {
+    cc->Outputs().Index(0).Set<tf::Tensor>(
+        // Output tensorflow::Tensor stream with possibly overlapping steps.
+    );
+  }
   // Output timestamp stream with possibly overlapping steps.
   if (cc->Outputs().NumEntries() > 1) {
     cc->Outputs().Index(1).Set<std::vector<Timestamp>>();
@@ -175,6 +257,8 @@ absl::Status LappedTensorBufferCalculator::Open(CalculatorContext* cc) {
   buffer_ = absl::make_unique<CircularBuffer<tf::Tensor>>(buffer_size_);
   steps_until_output_ = buffer_size_ - options_.padding();
   initialized_ = false;
+  window_buffer_ = tf::Tensor();
+  window_buffer_frames_ = 0;
   return absl::OkStatus();
 }
 
@@ -188,13 +272,14 @@ absl::Status LappedTensorBufferCalculator::Process(CalculatorContext* cc) {
   // Pad frames at the beginning with the first frame.
   if (!initialized_) {
     for (int i = 0; i < options_.padding(); ++i) {
-      buffer_->push_back(input_tensor);
-      timestamp_buffer_->push_back(cc->InputTimestamp());
+      MP_RETURN_IF_ERROR(
+          PushFrame(input_tensor, cc->InputTimestamp(),
+                    options_.padding() - i + steps_until_output_));
     }
     initialized_ = true;
   }
-  buffer_->push_back(input_tensor);
-  timestamp_buffer_->push_back(cc->InputTimestamp());
+  MP_RETURN_IF_ERROR(
+      PushFrame(input_tensor, cc->InputTimestamp(), steps_until_output_));
   --steps_until_output_;
   if (steps_until_output_ <= 0) {
     MP_RETURN_IF_ERROR(ProcessBuffer(cc));
@@ -208,10 +293,12 @@ absl::Status LappedTensorBufferCalculator::Close(CalculatorContext* cc) {
     return absl::OkStatus();
   }
   int last_frame = buffer_size_ - steps_until_output_ - 1;
-  const auto& pad_frame = buffer_->Get(last_frame);
-  for (int i = 0; i < steps_until_output_ + options_.padding(); ++i) {
-    buffer_->push_back(pad_frame);
-    timestamp_buffer_->push_back(cc->InputTimestamp());
+  // A shallow copy, since pushing frames overwrites the buffer entry.
+  const tf::Tensor pad_frame = buffer_->Get(last_frame);
+  const int num_pad_frames = steps_until_output_ + options_.padding();
+  for (int i = 0; i < num_pad_frames; ++i) {
+    MP_RETURN_IF_ERROR(
+        PushFrame(pad_frame, cc->InputTimestamp(), num_pad_frames - i));
   }
   MP_RETURN_IF_ERROR(ProcessBuffer(cc));
 
@@ -232,17 +319,93 @@ absl::Status LappedTensorBufferCalculator::AddBatchDimension(
   return absl::OkStatus();
 }
 
+absl::Status LappedTensorBufferCalculator::PushFrame(const tf::Tensor& tensor,
+                                                     Timestamp timestamp,
+                                                     int frames_until_output) {
+  buffer_->push_back(tensor);
+  timestamp_buffer_->push_back(timestamp);
+  if (options_.contiguous_window_buffer()) {
+    MP_RETURN_IF_ERROR(AppendToWindowBuffer(tensor, frames_until_output));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status LappedTensorBufferCalculator::AppendToWindowBuffer(
+    const tf::Tensor& tensor, int frames_until_output) {
+  if (window_buffer_.IsInitialized()) {
+    RET_CHECK(tensor.dtype() == window_buffer_.dtype() &&
+              tensor.NumElements() * buffer_size_ * 2 ==
+                  window_buffer_.NumElements())
+        << "contiguous_window_buffer requires input tensors of the same "
+           "shape and type.";
+  } else {
+    RET_CHECK(tf::DataTypeCanUseMemcpy(tensor.dtype()))
+        << "contiguous_window_buffer does not support tensors of type "
+        << tf::DataTypeString(tensor.dtype());
+    RET_CHECK_GE(tensor.dims(), 1)
+        << "contiguous_window_buffer requires tensors with a first dimension.";
+  }
+
+  const size_t frame_bytes = tensor.TotalBytes();
+  const int capacity = 2 * buffer_size_;
+  if (!window_buffer_.IsInitialized() || window_buffer_frames_ == capacity) {
+    tf::TensorShape shape(tensor.shape());
+    shape.set_dim(0, tensor.dim_size(0) * capacity);
+    tf::Tensor next_buffer(tensor.dtype(), shape);
+    // Only the tensors received so far that belong to the next window are
+    // carried over; earlier windows keep the old buffer alive.
+    const int carried = std::max(
+        0, std::min(window_buffer_frames_, buffer_size_ - frames_until_output));
+    if (carried > 0) {
+      std::memcpy(MutableTensorData(next_buffer),
+                  MutableTensorData(window_buffer_) +
+                      (window_buffer_frames_ - carried) * frame_bytes,
+                  carried * frame_bytes);
+    }
+    window_buffer_ = std::move(next_buffer);
+    window_buffer_frames_ = carried;
+  }
+  std::memcpy(
+      MutableTensorData(window_buffer_) + window_buffer_frames_ * frame_bytes,
+      tensor.tensor_data().data(), frame_bytes);
+  ++window_buffer_frames_;
+  return absl::OkStatus();
+}
+
+absl::StatusOr<tf::Tensor> LappedTensorBufferCalculator::WindowFromBuffer() {
+  RET_CHECK_GE(window_buffer_frames_, buffer_size_);
+  const int64_t frame_rows = window_buffer_.dim_size(0) / (2 * buffer_size_);
+  tf::Tensor window =
+      window_buffer_.Slice((window_buffer_frames_ - buffer_size_) * frame_rows,
+                           window_buffer_frames_ * frame_rows);
+  // TensorFlow kernels expect aligned tensors; a slice that starts at an
+  // unaligned offset is copied instead.
+  if (!window.IsAligned()) {
+    window = tf::tensor::DeepCopy(window);
+  }
+  return window;
+}
+
 // Process buffer
 absl::Status LappedTensorBufferCalculator::ProcessBuffer(
     CalculatorContext* cc) {
-  auto concatenated = ::absl::make_unique<tf::Tensor>();
-  const tf::Status concat_status = tf::tensor::Concat(
-      std::vector<tf::Tensor>(buffer_->begin(), buffer_->end()),
-      concatenated.get());
-  RET_CHECK(concat_status.ok()) << concat_status.ToString();
+  tf::Tensor window;
+  if (options_.contiguous_window_buffer()) {
+    MP_ASSIGN_OR_RETURN(window, WindowFromBuffer());
+  } else {
+    const tf::Status concat_status = tf::tensor::Concat(
+        std::vector<tf::Tensor>(buffer_->begin(), buffer_->end()), &window);
+    RET_CHECK(concat_status.ok()) << concat_status.ToString();
+  }
   // Output cancatenated tensor.
-  cc->Outputs().Index(0).Add(concatenated.release(),
-                             timestamp_buffer_->Get(timestamp_offset_));
+  if (options_.output_mediapipe_tensor()) {
+    MP_ASSIGN_OR_RETURN(auto output, ToMediaPipeTensor(window));
+    cc->Outputs().Index(0).Add(output.release(),
+                               timestamp_buffer_->Get(timestamp_offset_));
+  } else {
+    cc->Outputs().Index(0).Add(new tf::Tensor(window),
+                               timestamp_buffer_->Get(timestamp_offset_));
+  }
   if (cc->Outputs().NumEntries() > 1) {
     auto output_timestamp = ::absl::make_unique<std::vector<Timestamp>>();
     // Output timestamp vector.
@@ -16,6 +16,7 @@
 #include "mediapipe/calculators/tensorflow/lapped_tensor_buffer_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -51,6 +52,30 @@ class LappedTensorBufferCalculatorTest : public ::testing::Test {
     options->set_padding(padding);
     runner_ = ::absl::make_unique<CalculatorRunner>(config);
   }
+
+  // Runs a calculator with the given options on num_timesteps tensors of
+  // shape [1, 16] and returns the output packets.
+  std::vector<Packet> RunWithOptions(
+      const LappedTensorBufferCalculatorOptions& options, int num_timesteps) {
+    CalculatorGraphConfig::Node config;
+    config.set_calculator("LappedTensorBufferCalculator");
+    config.add_input_stream("input_tensor");
+    config.add_output_stream("output_tensor");
+    *config.mutable_options()->MutableExtension(
+        LappedTensorBufferCalculatorOptions::ext) = options;
+    CalculatorRunner runner(config);
+    for (int i = 0; i < num_timesteps; ++i) {
+      auto input = ::absl::make_unique<tf::Tensor>(tf::DT_FLOAT,
+                                                   tf::TensorShape({1, 16}));
+      for (int j = 0; j < 16; ++j) {
+        input->matrix<float>()(0, j) = i * 100 + j;
+      }
+      runner.MutableInputs()->Index(0).packets.push_back(
+          Adopt(input.release()).At(Timestamp(i)));
+    }
+    EXPECT_TRUE(runner.Run().ok());
+    return runner.Outputs().Index(0).packets;
+  }
   std::unique_ptr<CalculatorRunner> runner_;
 };
 
@@ -302,5 +327,58 @@ TEST_F(LappedTensorBufferCalculatorTest,
   ASSERT_EQ(output_size, output_timestamps.size());
 }
 
+TEST_F(LappedTensorBufferCalculatorTest,
+       ContiguousWindowBufferMatchesConcatenation) {
+  LappedTensorBufferCalculatorOptions options;
+  options.set_buffer_size(5);
+  options.set_overlap(4);
+  options.set_padding(2);
+  const std::vector<Packet> concatenated = RunWithOptions(options, 23);
+  options.set_contiguous_window_buffer(true);
+  const std::vector<Packet> sliced = RunWithOptions(options, 23);
+
+  ASSERT_EQ(concatenated.size(), sliced.size());
+  for (int i = 0; i < sliced.size(); ++i) {
+    EXPECT_EQ(concatenated[i].Timestamp(), sliced[i].Timestamp());
+    const tf::Tensor& expected = concatenated[i].Get<tf::Tensor>();
+    const tf::Tensor& actual = sliced[i].Get<tf::Tensor>();
+    ASSERT_EQ(expected.shape(), actual.shape());
+    EXPECT_EQ(expected.tensor_data(), actual.tensor_data());
+  }
+}
+
+TEST_F(LappedTensorBufferCalculatorTest, OutputsMediaPipeTensor) {
+  CalculatorGraphConfig::Node config;
+  config.set_calculator("LappedTensorBufferCalculator");
+  config.add_input_stream("input_tensor");
+  config.add_output_stream("output_tensor");
+  auto* options = config.mutable_options()->MutableExtension(
+      LappedTensorBufferCalculatorOptions::ext);
+  options->set_buffer_size(2);
+  options->set_overlap(1);
+  options->set_contiguous_window_buffer(true);
+  options->set_output_mediapipe_tensor(true);
+  CalculatorRunner runner(config);
+  for (int i = 0; i < 3; ++i) {
+    auto input = ::absl::make_unique<tf::Tensor>(tf::DT_FLOAT,
+                                                 tf::TensorShape({1}));
+    input->tensor<float, 1>()(0) = i;
+    runner.MutableInputs()->Index(0).packets.push_back(
+        Adopt(input.release()).At(Timestamp(i)));
+  }
+  ASSERT_TRUE(runner.Run().ok());
+
+  const std::vector<Packet>& output_packets = runner.Outputs().Index(0).packets;
+  ASSERT_EQ(2, output_packets.size());
+  for (int i = 0; i < output_packets.size(); ++i) {
+    const Tensor& tensor = output_packets[i].Get<Tensor>();
+    EXPECT_EQ(tensor.element_type(), Tensor::ElementType::kFloat32);
+    EXPECT_EQ(tensor.shape().dims, std::vector<int>({2}));
+    auto view = tensor.GetCpuReadView();
+    EXPECT_EQ(view.buffer<float>()[0], i);
+    EXPECT_EQ(view.buffer<float>()[1], i + 1);
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -14,6 +14,7 @@
 
 #include "absl/log/absl_check.h"
 #include "mediapipe/calculators/tensorflow/matrix_to_tensor_calculator_options.pb.h"
+#include "mediapipe/calculators/tensorflow/packet_tensor_buffer.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/time_series_header.pb.h"
@@ -60,6 +61,19 @@ typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
 typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::ColMajor>
     ColMajorMatrixXf;
 
+namespace {
+void CopyMatrixToTensorData(const Matrix& matrix, bool transpose,
+                            float* tensor_data) {
+  if (transpose) {
+    Eigen::Map<ColMajorMatrixXf>(tensor_data, matrix.rows(), matrix.cols()) =
+        matrix;
+  } else {
+    Eigen::Map<RowMajorMatrixXf>(tensor_data, matrix.rows(), matrix.cols()) =
+        matrix;
+  }
+}
+}  // namespace
+
 // Converts an input Matrix into a 2D or 3D tf::Tensor.
 //
 // The calculator expects one input (a packet containing a Matrix) and
@@ -122,24 +136,27 @@ absl::Status MatrixToTensorCalculator::Open(CalculatorContext* cc) {
 }
 
 absl::Status MatrixToTensorCalculator::Process(CalculatorContext* cc) {
-  const Matrix& matrix = cc->Inputs().Index(0).Get<Matrix>();
+  const Packet& input = cc->Inputs().Index(0).Value();
+  const Matrix& matrix = input.Get<Matrix>();
   tf::TensorShape tensor_shape;
   if (options_.transpose()) {
     tensor_shape = tf::TensorShape({matrix.cols(), matrix.rows()});
   } else {
     tensor_shape = tf::TensorShape({matrix.rows(), matrix.cols()});
   }
-  auto tensor = ::absl::make_unique<tf::Tensor>(tf::DT_FLOAT, tensor_shape);
 
-  float* tensor_data = tensor->flat<float>().data();
-  if (options_.transpose()) {
-    auto matrix_map =
-        Eigen::Map<ColMajorMatrixXf>(tensor_data, matrix.rows(), matrix.cols());
-    matrix_map = matrix;
+  // The column-major Matrix storage already has the row-major layout of the
+  // tensor when the tensor is transposed or either dimension is 1. The tensor
+  // then shares the storage and keeps the input packet alive.
+  std::unique_ptr<tf::Tensor> tensor;
+  if ((options_.transpose() || matrix.rows() == 1 || matrix.cols() == 1) &&
+      CanReferenceInTensor(matrix.data())) {
+    tensor = ::absl::make_unique<tf::Tensor>(MakeTensorReferencingPacket(
+        input, tf::DT_FLOAT, tensor_shape, matrix.data()));
   } else {
-    auto matrix_map =
-        Eigen::Map<RowMajorMatrixXf>(tensor_data, matrix.rows(), matrix.cols());
-    matrix_map = matrix;
+    tensor = ::absl::make_unique<tf::Tensor>(tf::DT_FLOAT, tensor_shape);
+    CopyMatrixToTensorData(matrix, options_.transpose(),
+                           tensor->flat<float>().data());
   }
 
   if (options_.add_trailing_dimension()) {
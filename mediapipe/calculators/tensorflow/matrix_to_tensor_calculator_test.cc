@@ -161,4 +161,26 @@ TEST_F(MatrixToTensorCalculatorTest, RandomMatrixAddDimension) {
   }
 }
 
+TEST_F(MatrixToTensorCalculatorTest, TransposedTensorSharesMatrixStorage) {
+  runner_ = ::absl::make_unique<CalculatorRunner>(
+      "MatrixToTensorCalculator", kTransposeOptionsString, 1, 1, 0);
+  AddRandomMatrix(5, 3, kSeed);
+  const float* matrix_data = runner_->MutableInputs()
+                                 ->Index(0)
+                                 .packets[0]
+                                 .Get<Matrix>()
+                                 .data();
+  MP_ASSERT_OK(runner_->Run());
+  const std::vector<Packet>& output_packets =
+      runner_->Outputs().Index(0).packets;
+  ASSERT_EQ(1, output_packets.size());
+  const tf::Tensor& tensor = output_packets[0].Get<tf::Tensor>();
+  EXPECT_EQ(matrix_data, tensor.flat<float>().data());
+
+  // The tensor keeps the matrix alive after the input packet is released.
+  const float first_value = tensor.matrix<float>()(0, 0);
+  runner_->MutableInputs()->Index(0).packets.clear();
+  EXPECT_EQ(first_value, tensor.matrix<float>()(0, 0));
+}
+
 }  // namespace mediapipe
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <fstream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -21,6 +23,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/strip.h"
+#include "google/protobuf/util/delimited_message_util.h"
 #include "mediapipe/calculators/image/opencv_image_encoder_calculator.pb.h"
 #include "mediapipe/calculators/tensorflow/pack_media_sequence_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -28,6 +31,7 @@
 #include "mediapipe/framework/formats/location.h"
 #include "mediapipe/framework/formats/location_opencv.h"
 #include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
+#include "mediapipe/framework/port/proto_ns.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/util/sequence/media_sequence.h"
 #include "mediapipe/util/sequence/media_sequence_util.h"
@@ -51,6 +55,7 @@ const char kBBoxTag[] = "BBOX";
 const char kKeypointsTag[] = "KEYPOINTS";
 const char kSegmentationMaskTag[] = "CLASS_SEGMENTATION";
 const char kClipMediaIdTag[] = "CLIP_MEDIA_ID";
+const char kOutputFilePathTag[] = "OUTPUT_FILE_PATH";
 
 namespace tf = ::tensorflow;
 namespace mpms = mediapipe::mediasequence;
@@ -81,6 +86,16 @@ namespace mpms = mediapipe::mediasequence;
 // prefixed versions of each stream, which allows for multiple image streams to
 // be included. However, the default names are supported by more tools.
 //
+// If the "OUTPUT_FILE_PATH" input side packet is set, the sequence is streamed
+// to that file instead of being held in memory until Close: every
+// max_timestamps_per_chunk input timestamps the accumulated feature lists are
+// written as a length-delimited SequenceExample chunk and cleared, and the
+// context is written as the last chunk. The optional SEQUENCE_EXAMPLE output
+// then only holds the context. mediasequence::ReadSequenceExampleChunks
+// reassembles the file. Metadata is not reconciled in this mode, since it
+// depends on the whole sequence; call mediasequence::ReconcileMetadata on the
+// reassembled sequence instead.
+//
 // Example config:
 // node {
 //   calculator: "PackMediaSequenceCalculator"
@@ -118,6 +133,9 @@ class PackMediaSequenceCalculator : public CalculatorBase {
     if (cc->InputSidePackets().HasTag(kClipMediaIdTag)) {
       cc->InputSidePackets().Tag(kClipMediaIdTag).Set<std::string>();
     }
+    if (cc->InputSidePackets().HasTag(kOutputFilePathTag)) {
+      cc->InputSidePackets().Tag(kOutputFilePathTag).Set<std::string>();
+    }
 
     if (cc->Inputs().HasTag(kForwardFlowEncodedTag)) {
       cc->Inputs()
@@ -196,9 +214,10 @@ class PackMediaSequenceCalculator : public CalculatorBase {
     }
 
     RET_CHECK(cc->Outputs().HasTag(kSequenceExampleTag) ||
-              cc->OutputSidePackets().HasTag(kSequenceExampleTag))
-        << "Neither the output stream nor the output side packet is set to "
-           "output the sequence example.";
+              cc->OutputSidePackets().HasTag(kSequenceExampleTag) ||
+              cc->InputSidePackets().HasTag(kOutputFilePathTag))
+        << "Neither the output stream, the output side packet nor the output "
+           "file is set to output the sequence example.";
     if (cc->Outputs().HasTag(kSequenceExampleTag)) {
       cc->Outputs().Tag(kSequenceExampleTag).Set<tf::SequenceExample>();
     }
@@ -220,6 +239,17 @@ class PackMediaSequenceCalculator : public CalculatorBase {
       clip_media_id_ =
           cc->InputSidePackets().Tag(kClipMediaIdTag).Get<std::string>();
     }
+    if (cc->InputSidePackets().HasTag(kOutputFilePathTag)) {
+      RET_CHECK_GT(cc->Options<PackMediaSequenceCalculatorOptions>()
+                       .max_timestamps_per_chunk(),
+                   0);
+      const std::string& path =
+          cc->InputSidePackets().Tag(kOutputFilePathTag).Get<std::string>();
+      chunk_output_ = std::make_unique<std::ofstream>(
+          path, std::ios::binary | std::ios::trunc);
+      RET_CHECK(chunk_output_->is_open())
+          << "Failed to open output file: " << path;
+    }
 
     const auto& context_features =
         cc->Options<PackMediaSequenceCalculatorOptions>().context_feature_map();
@@ -371,8 +401,30 @@ class PackMediaSequenceCalculator : public CalculatorBase {
     return absl::OkStatus();
   }
 
+  // Writes the feature lists accumulated since the last chunk to
+  // chunk_output_, and clears them. The feature lists keep their keys, so
+  // that checks for the presence of a feature are unaffected.
+  absl::Status WriteChunk() {
+    tf::SequenceExample chunk;
+    for (auto& [key, feature_list] :
+         *sequence_->mutable_feature_lists()->mutable_feature_list()) {
+      if (feature_list.feature().empty()) continue;
+      (*chunk.mutable_feature_lists()->mutable_feature_list())[key]
+          .mutable_feature()
+          ->Swap(feature_list.mutable_feature());
+    }
+    RET_CHECK(proto_ns::util::SerializeDelimitedToOstream(
+        chunk, chunk_output_.get()))
+        << "Failed to write a sequence example chunk.";
+    num_timestamps_in_chunk_ = 0;
+    return absl::OkStatus();
+  }
+
   absl::Status Close(CalculatorContext* cc) override {
     auto& options = cc->Options<PackMediaSequenceCalculatorOptions>();
+    if (chunk_output_ != nullptr) {
+      return CloseChunkOutput(cc);
+    }
     if (options.reconcile_metadata()) {
       RET_CHECK_OK(mpms::ReconcileMetadata(
           options.reconcile_bbox_annotations(),
@@ -407,6 +459,41 @@ class PackMediaSequenceCalculator : public CalculatorBase {
     return absl::OkStatus();
   }
 
+  absl::Status CloseChunkOutput(CalculatorContext* cc) {
+    auto& options = cc->Options<PackMediaSequenceCalculatorOptions>();
+    if (options.output_only_if_all_present()) {
+      absl::Status status = VerifySequence();
+      if (!status.ok()) {
+        cc->GetCounter(status.ToString())->Increment();
+        return status;
+      }
+    }
+    MP_RETURN_IF_ERROR(WriteChunk());
+    tf::SequenceExample context;
+    *context.mutable_context() = sequence_->context();
+    RET_CHECK(proto_ns::util::SerializeDelimitedToOstream(
+        context, chunk_output_.get()))
+        << "Failed to write the sequence example context.";
+    chunk_output_->close();
+    RET_CHECK(!chunk_output_->fail()) << "Failed to close the output file.";
+    chunk_output_.reset();
+
+    if (cc->OutputSidePackets().HasTag(kSequenceExampleTag)) {
+      cc->OutputSidePackets()
+          .Tag(kSequenceExampleTag)
+          .Set(MakePacket<tensorflow::SequenceExample>(context));
+    }
+    if (cc->Outputs().HasTag(kSequenceExampleTag)) {
+      cc->Outputs()
+          .Tag(kSequenceExampleTag)
+          .Add(new tf::SequenceExample(std::move(context)),
+               options.output_as_zero_timestamp() ? Timestamp(0ll)
+                                                  : Timestamp::PostStream());
+    }
+    sequence_.reset();
+    return absl::OkStatus();
+  }
+
   absl::Status Process(CalculatorContext* cc) override {
     int image_height = -1;
     int image_width = -1;
@@ -738,10 +825,18 @@ class PackMediaSequenceCalculator : public CalculatorBase {
     if (clip_media_id_.has_value()) {
       mpms::SetClipMediaId(*clip_media_id_, sequence_.get());
     }
+    if (chunk_output_ != nullptr &&
+        ++num_timestamps_in_chunk_ >=
+            cc->Options<PackMediaSequenceCalculatorOptions>()
+                .max_timestamps_per_chunk()) {
+      MP_RETURN_IF_ERROR(WriteChunk());
+    }
     return absl::OkStatus();
   }
 
   std::unique_ptr<tf::SequenceExample> sequence_;
+  std::unique_ptr<std::ofstream> chunk_output_;
+  int num_timestamps_in_chunk_ = 0;
   std::optional<std::string> clip_media_id_ = std::nullopt;
   std::map<std::string, bool> features_present_;
   bool replace_keypoints_;
@@ -13,6 +13,8 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <cstdlib>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <vector>
@@ -73,6 +75,7 @@ constexpr char kImagePrefixTag[] = "IMAGE_PREFIX";
 constexpr char kSequenceExampleTag[] = "SEQUENCE_EXAMPLE";
 constexpr char kImageTag[] = "IMAGE";
 constexpr char kClipMediaIdTag[] = "CLIP_MEDIA_ID";
+constexpr char kOutputFilePathTag[] = "OUTPUT_FILE_PATH";
 constexpr char kClipLabelTestTag[] = "CLIP_LABEL_TEST";
 constexpr char kClipLabelOtherTag[] = "CLIP_LABEL_OTHER";
 constexpr char kClipLabelAnotherTag[] = "CLIP_LABEL_ANOTHER";
@@ -242,6 +245,58 @@ TEST_F(PackMediaSequenceCalculatorTest, PacksTwoFloatLists) {
   }
 }
 
+TEST_F(PackMediaSequenceCalculatorTest, StreamsFloatListsInChunks) {
+  CalculatorGraphConfig::Node config;
+  config.set_calculator("PackMediaSequenceCalculator");
+  config.add_input_side_packet("SEQUENCE_EXAMPLE:input_sequence");
+  config.add_input_side_packet("OUTPUT_FILE_PATH:output_path");
+  config.add_input_stream("FLOAT_FEATURE_TEST:test");
+  config.add_output_stream("SEQUENCE_EXAMPLE:output_sequence");
+  auto* options = config.mutable_options()->MutableExtension(
+      PackMediaSequenceCalculatorOptions::ext);
+  options->set_max_timestamps_per_chunk(2);
+  runner_ = ::absl::make_unique<CalculatorRunner>(config);
+
+  auto input_sequence = ::absl::make_unique<tf::SequenceExample>();
+  mpms::SetClipMediaId("test_video_id", input_sequence.get());
+  int num_timesteps = 5;
+  for (int i = 0; i < num_timesteps; ++i) {
+    auto vf_ptr = ::absl::make_unique<std::vector<float>>(2, 2 << i);
+    runner_->MutableInputs()
+        ->Tag(kFloatFeatureTestTag)
+        .packets.push_back(Adopt(vf_ptr.release()).At(Timestamp(i)));
+  }
+  const std::string path =
+      absl::StrCat(getenv("TEST_TMPDIR"), "/streamed_sequence");
+  runner_->MutableSidePackets()->Tag(kSequenceExampleTag) =
+      Adopt(input_sequence.release());
+  runner_->MutableSidePackets()->Tag(kOutputFilePathTag) =
+      MakePacket<std::string>(path);
+
+  MP_ASSERT_OK(runner_->Run());
+
+  const std::vector<Packet>& output_packets =
+      runner_->Outputs().Tag(kSequenceExampleTag).packets;
+  ASSERT_EQ(1, output_packets.size());
+  const tf::SequenceExample& context =
+      output_packets[0].Get<tf::SequenceExample>();
+  ASSERT_EQ(mpms::GetClipMediaId(context), "test_video_id");
+  ASSERT_EQ(context.feature_lists().feature_list_size(), 0);
+
+  std::ifstream input(path, std::ios::binary);
+  tf::SequenceExample output_sequence;
+  MP_ASSERT_OK(mpms::ReadSequenceExampleChunks(&input, &output_sequence));
+  ASSERT_EQ(mpms::GetClipMediaId(output_sequence), "test_video_id");
+  ASSERT_EQ(num_timesteps,
+            mpms::GetFeatureTimestampSize("TEST", output_sequence));
+  ASSERT_EQ(num_timesteps, mpms::GetFeatureFloatsSize("TEST", output_sequence));
+  for (int i = 0; i < num_timesteps; ++i) {
+    ASSERT_EQ(i, mpms::GetFeatureTimestampAt("TEST", output_sequence, i));
+    ASSERT_THAT(mpms::GetFeatureFloatsAt("TEST", output_sequence, i),
+                ::testing::ElementsAreArray(std::vector<float>(2, 2 << i)));
+  }
+}
+
 TEST_F(PackMediaSequenceCalculatorTest, PacksTwoIntLists) {
   SetUpCalculator({"INT_FEATURE_TEST:test", "INT_FEATURE_OTHER:test2"}, {},
                   false, true);
@@ -0,0 +1,53 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensorflow/packet_tensor_buffer.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "tensorflow/core/platform/refcount.h"
+
+namespace mediapipe {
+
+namespace tf = ::tensorflow;
+
+PacketTensorBuffer::PacketTensorBuffer(Packet packet, const void* data,
+                                       size_t size)
+    : tf::TensorBuffer(const_cast<void*>(data)),
+      packet_(std::move(packet)),
+      size_(size) {}
+
+void PacketTensorBuffer::FillAllocationDescription(
+    tf::AllocationDescription* proto) const {
+  proto->set_requested_bytes(size_);
+  proto->set_allocator_name("mediapipe_packet");
+}
+
+bool CanReferenceInTensor(const void* data) {
+  return reinterpret_cast<uintptr_t>(data) % EIGEN_MAX_ALIGN_BYTES == 0;
+}
+
+tf::Tensor MakeTensorReferencingPacket(const Packet& packet,
+                                       tf::DataType dtype,
+                                       const tf::TensorShape& shape,
+                                       const void* data) {
+  auto* buffer = new PacketTensorBuffer(
+      packet, data, shape.num_elements() * tf::DataTypeSize(dtype));
+  // The tensor acquires its own reference to the buffer.
+  tf::core::ScopedUnref unref(buffer);
+  return tf::Tensor(dtype, shape, buffer);
+}
+
+}  // namespace mediapipe
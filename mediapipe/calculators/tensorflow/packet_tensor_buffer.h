@@ -0,0 +1,63 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSORFLOW_PACKET_TENSOR_BUFFER_H_
+#define MEDIAPIPE_CALCULATORS_TENSORFLOW_PACKET_TENSOR_BUFFER_H_
+
+#include <cstddef>
+
+#include "mediapipe/framework/packet.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/types.h"
+
+namespace mediapipe {
+
+// A tf::TensorBuffer backed by memory owned by the payload of a MediaPipe
+// packet. The buffer holds a copy of the packet, so the payload stays alive for
+// as long as any tensor refers to the buffer.
+//
+// Packet payloads are immutable, so the buffer reports that it does not own its
+// memory; this keeps TensorFlow kernels from forwarding it as an output buffer
+// and writing into it.
+class PacketTensorBuffer : public tensorflow::TensorBuffer {
+ public:
+  PacketTensorBuffer(Packet packet, const void* data, size_t size);
+
+  size_t size() const override { return size_; }
+  tensorflow::TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(
+      tensorflow::AllocationDescription* proto) const override;
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const Packet packet_;
+  const size_t size_;
+};
+
+// Returns true if a tensor can refer to `data` in place. TensorFlow's Eigen
+// kernels assume that tensor buffers are aligned to EIGEN_MAX_ALIGN_BYTES.
+bool CanReferenceInTensor(const void* data);
+
+// Returns a tensor of type `dtype` and shape `shape` that reads its elements
+// from `data`, which must point into the payload of `packet` and satisfy
+// CanReferenceInTensor(). The elements are not copied.
+tensorflow::Tensor MakeTensorReferencingPacket(
+    const Packet& packet, tensorflow::DataType dtype,
+    const tensorflow::TensorShape& shape, const void* data);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSORFLOW_PACKET_TENSOR_BUFFER_H_
@@ -205,9 +205,10 @@ absl::Status TensorToMatrixCalculator::Process(CalculatorContext* cc) {
     RET_CHECK_EQ(width, header_.num_samples())
         << "The number of samples at runtime does not match the header.";
   }
-  auto output = absl::make_unique<Matrix>(width, length);
-  *output =
-      Eigen::MatrixXf::Map(input_tensor.flat<float>().data(), length, width);
+  // Matrix owns its storage, so the tensor data is copied exactly once,
+  // straight into a matrix of the final shape.
+  auto output = absl::make_unique<Matrix>(
+      Eigen::MatrixXf::Map(input_tensor.flat<float>().data(), length, width));
   cc->Outputs().Tag(kMatrix).Add(output.release(), cc->InputTimestamp());
   return absl::OkStatus();
 }
@@ -0,0 +1,178 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensorflow/tensorflow_batch_scheduler.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "tensorflow/core/framework/tensor_util.h"
+
+namespace mediapipe {
+
+namespace tf = ::tensorflow;
+
+namespace {
+
+// Returns the key of the group of calls that can be batched together.
+std::string BatchKey(
+    const tf::Session* session,
+    const std::vector<std::pair<std::string, tf::Tensor>>& inputs,
+    const std::vector<std::string>& output_names) {
+  std::string key = absl::StrCat(reinterpret_cast<uintptr_t>(session));
+  for (const auto& input : inputs) {
+    absl::StrAppend(&key, "|", input.first);
+  }
+  absl::StrAppend(&key, "|");
+  for (const auto& name : output_names) {
+    absl::StrAppend(&key, "|", name);
+  }
+  return key;
+}
+
+}  // namespace
+
+TensorFlowBatchScheduler::TensorFlowBatchScheduler(const Options& options)
+    : options_(options) {}
+
+absl::StatusOr<std::vector<tf::Tensor>> TensorFlowBatchScheduler::Run(
+    tf::Session* session,
+    const std::vector<std::pair<std::string, tf::Tensor>>& inputs,
+    const std::vector<std::string>& output_names) {
+  RET_CHECK(!inputs.empty()) << "A batched run needs at least one input.";
+  Request request{&inputs, 0};
+  for (const auto& input : inputs) {
+    RET_CHECK_GE(input.second.dims(), 1)
+        << "Input " << input.first << " has no batch dimension.";
+    if (&input == &inputs.front()) {
+      request.batch_size = input.second.dim_size(0);
+    }
+    RET_CHECK_EQ(input.second.dim_size(0), request.batch_size)
+        << "Inputs disagree on the batch size.";
+  }
+
+  const std::string key = BatchKey(session, inputs, output_names);
+  std::vector<Request*> requests;
+  {
+    absl::MutexLock lock(&mutex_);
+    Batch& batch = batches_[key];
+    batch.requests.push_back(&request);
+    batch.batch_size += request.batch_size;
+    if (batch.requests.size() > 1) {
+      // The first call of the batch runs it.
+      if (batch.batch_size >= options_.max_batch_size) {
+        batch_full_.SignalAll();
+      }
+      while (!request.done) {
+        batch_done_.Wait(&mutex_);
+      }
+      return std::move(request.outputs);
+    }
+
+    const absl::Time deadline = absl::Now() + options_.max_latency;
+    while (batch.batch_size < options_.max_batch_size) {
+      if (batch_full_.WaitWithDeadline(&mutex_, deadline)) break;
+    }
+    requests = std::move(batch.requests);
+    batches_.erase(key);
+  }
+
+  RunBatch(session, output_names, requests);
+
+  {
+    absl::MutexLock lock(&mutex_);
+    for (Request* r : requests) {
+      r->done = true;
+    }
+    batch_done_.SignalAll();
+  }
+  return std::move(request.outputs);
+}
+
+// static
+void TensorFlowBatchScheduler::RunBatch(
+    tf::Session* session, const std::vector<std::string>& output_names,
+    const std::vector<Request*>& requests) {
+  auto fail_all = [&requests](const absl::Status& status) {
+    for (Request* r : requests) {
+      r->outputs = status;
+    }
+  };
+
+  std::vector<std::pair<std::string, tf::Tensor>> feeds;
+  if (requests.size() == 1) {
+    feeds = *requests[0]->inputs;
+  } else {
+    const auto& first_inputs = *requests[0]->inputs;
+    for (int i = 0; i < first_inputs.size(); ++i) {
+      std::vector<tf::Tensor> parts;
+      parts.reserve(requests.size());
+      for (const Request* r : requests) {
+        parts.push_back((*r->inputs)[i].second);
+      }
+      tf::Tensor concated;
+      const tf::Status status = tf::tensor::Concat(parts, &concated);
+      if (!status.ok()) {
+        fail_all(absl::InvalidArgumentError(
+            absl::StrCat("Could not batch input ", first_inputs[i].first, ": ",
+                         status.ToString())));
+        return;
+      }
+      feeds.emplace_back(first_inputs[i].first, std::move(concated));
+    }
+  }
+
+  std::vector<tf::Tensor> outputs;
+  const tf::Status run_status =
+      session->Run(feeds, output_names, {} /* target_node_names */, &outputs);
+  if (!run_status.ok()) {
+    fail_all(absl::InternalError(
+        absl::StrCat("Run failed: ", run_status.ToString())));
+    return;
+  }
+
+  if (requests.size() == 1) {
+    requests[0]->outputs = std::move(outputs);
+    return;
+  }
+  std::vector<int64_t> split_sizes;
+  split_sizes.reserve(requests.size());
+  for (Request* r : requests) {
+    split_sizes.push_back(r->batch_size);
+    r->outputs = std::vector<tf::Tensor>();
+  }
+  for (int i = 0; i < outputs.size(); ++i) {
+    std::vector<tf::Tensor> parts;
+    const tf::Status status =
+        tf::tensor::Split(outputs[i], split_sizes, &parts);
+    if (!status.ok()) {
+      fail_all(absl::InternalError(absl::StrCat("Could not split output ",
+                                                output_names[i], ": ",
+                                                status.ToString())));
+      return;
+    }
+    for (int j = 0; j < requests.size(); ++j) {
+      requests[j]->outputs->push_back(std::move(parts[j]));
+    }
+  }
+}
+
+}  // namespace mediapipe
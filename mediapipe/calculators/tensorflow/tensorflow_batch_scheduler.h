@@ -0,0 +1,108 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_TENSORFLOW_TENSORFLOW_BATCH_SCHEDULER_H_
+#define MEDIAPIPE_CALCULATORS_TENSORFLOW_TENSORFLOW_BATCH_SCHEDULER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/graph_service.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/public/session.h"
+
+namespace mediapipe {
+
+// Merges Session::Run calls from many callers, typically the
+// TensorFlowInferenceCalculators of many graphs, into batched runs.
+//
+// Calls are grouped by session, feed names and fetch names. Every feed tensor
+// of a call must have the batch as its 0th dimension, and all feed tensors of
+// a call must agree on its size. The first call of a group waits until the
+// group holds max_batch_size batch elements or max_latency has passed, then
+// concatenates the feeds of all waiting calls along the 0th dimension, runs
+// the session once, and splits the fetched tensors back among the calls. The
+// other calls of the group block until that run completes. This keeps
+// accelerator batches full regardless of the frame rate of any single stream.
+//
+// The scheduler is shared by setting the same instance as the
+// kTensorFlowBatchSchedulerService object of every graph.
+class TensorFlowBatchScheduler {
+ public:
+  struct Options {
+    // The number of batch elements at which a batch runs without waiting
+    // for max_latency. A batch can exceed this size by the elements of calls
+    // that arrive while the full batch is being collected.
+    int max_batch_size = 8;
+
+    // The maximum time that the first call of a batch waits for other calls.
+    absl::Duration max_latency = absl::Milliseconds(5);
+  };
+
+  TensorFlowBatchScheduler() : TensorFlowBatchScheduler(Options()) {}
+  explicit TensorFlowBatchScheduler(const Options& options);
+
+  // Runs `session` on `inputs` as part of a batch and returns the fetched
+  // `output_names` tensors for this call's batch elements. Blocks until the
+  // batch has run.
+  absl::StatusOr<std::vector<tensorflow::Tensor>> Run(
+      tensorflow::Session* session,
+      const std::vector<std::pair<std::string, tensorflow::Tensor>>& inputs,
+      const std::vector<std::string>& output_names);
+
+ private:
+  struct Request {
+    const std::vector<std::pair<std::string, tensorflow::Tensor>>* inputs;
+    int64_t batch_size;
+    absl::StatusOr<std::vector<tensorflow::Tensor>> outputs;
+    bool done = false;
+  };
+
+  struct Batch {
+    std::vector<Request*> requests;
+    int64_t batch_size = 0;
+  };
+
+  // Runs the collected `requests` and stores the outputs of each one.
+  static void RunBatch(tensorflow::Session* session,
+                       const std::vector<std::string>& output_names,
+                       const std::vector<Request*>& requests);
+
+  const Options options_;
+  absl::Mutex mutex_;
+  // Signaled when a batch reaches max_batch_size.
+  absl::CondVar batch_full_;
+  // Signaled when a batch has run.
+  absl::CondVar batch_done_;
+  // The batches that are being collected, by group. A std::map keeps the
+  // batches in place while their first caller waits without the lock.
+  std::map<std::string, Batch> batches_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Graph service for a TensorFlowBatchScheduler shared among graphs. If the
+// service object is set, TensorFlowInferenceCalculators with
+// use_batch_scheduler enabled run their session through it.
+inline constexpr GraphService<TensorFlowBatchScheduler>
+    kTensorFlowBatchSchedulerService("TensorFlowBatchSchedulerService");
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_TENSORFLOW_TENSORFLOW_BATCH_SCHEDULER_H_
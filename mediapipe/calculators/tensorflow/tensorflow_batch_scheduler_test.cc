@@ -0,0 +1,123 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/tensorflow/tensorflow_batch_scheduler.h"
+
+#include <atomic>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/public/session.h"
+
+namespace mediapipe {
+namespace {
+
+namespace tf = ::tensorflow;
+
+// Doubles the "x" feed into the "y" fetch and counts the runs.
+class DoublingSession : public tf::Session {
+ public:
+  tf::Status Create(const tf::GraphDef& graph) override {
+    return tf::Status();
+  }
+  tf::Status Extend(const tf::GraphDef& graph) override {
+    return tf::Status();
+  }
+  tf::Status Close() override { return tf::Status(); }
+
+  tf::Status Run(const std::vector<std::pair<std::string, tf::Tensor>>& inputs,
+                 const std::vector<std::string>& output_tensor_names,
+                 const std::vector<std::string>& target_node_names,
+                 std::vector<tf::Tensor>* outputs) override {
+    ++num_runs;
+    tf::Tensor output(tf::DT_FLOAT, inputs[0].second.shape());
+    auto in = inputs[0].second.flat<float>();
+    auto out = output.flat<float>();
+    for (int i = 0; i < in.size(); ++i) {
+      out(i) = 2 * in(i);
+    }
+    outputs->push_back(output);
+    return tf::Status();
+  }
+
+  std::atomic<int> num_runs{0};
+};
+
+tf::Tensor MakeInput(float value) {
+  tf::Tensor tensor(tf::DT_FLOAT, tf::TensorShape({1, 2}));
+  tensor.flat<float>()(0) = value;
+  tensor.flat<float>()(1) = -value;
+  return tensor;
+}
+
+TEST(TensorFlowBatchSchedulerTest, BatchesConcurrentRuns) {
+  constexpr int kNumCallers = 4;
+  TensorFlowBatchScheduler::Options options;
+  options.max_batch_size = kNumCallers;
+  // The batch runs only once every caller has joined it.
+  options.max_latency = absl::InfiniteDuration();
+  TensorFlowBatchScheduler scheduler(options);
+  DoublingSession session;
+
+  std::vector<float> results(kNumCallers);
+  std::vector<std::thread> callers;
+  for (int i = 0; i < kNumCallers; ++i) {
+    callers.emplace_back([&, i] {
+      auto outputs = scheduler.Run(&session, {{"x", MakeInput(i + 1)}}, {"y"});
+      MP_ASSERT_OK(outputs);
+      ASSERT_EQ(outputs->size(), 1);
+      ASSERT_EQ((*outputs)[0].dim_size(0), 1);
+      results[i] = (*outputs)[0].flat<float>()(0);
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  EXPECT_EQ(session.num_runs, 1);
+  EXPECT_THAT(results, testing::ElementsAre(2, 4, 6, 8));
+}
+
+TEST(TensorFlowBatchSchedulerTest, RunsPartialBatchAfterMaxLatency) {
+  TensorFlowBatchScheduler::Options options;
+  options.max_batch_size = 8;
+  options.max_latency = absl::Milliseconds(1);
+  TensorFlowBatchScheduler scheduler(options);
+  DoublingSession session;
+
+  auto outputs = scheduler.Run(&session, {{"x", MakeInput(3)}}, {"y"});
+  MP_ASSERT_OK(outputs);
+  EXPECT_EQ(session.num_runs, 1);
+  EXPECT_EQ((*outputs)[0].flat<float>()(1), -6);
+}
+
+TEST(TensorFlowBatchSchedulerTest, RejectsInputsWithoutBatchDimension) {
+  TensorFlowBatchScheduler scheduler;
+  DoublingSession session;
+  tf::Tensor scalar(tf::DT_FLOAT, tf::TensorShape({}));
+
+  EXPECT_FALSE(scheduler.Run(&session, {{"x", scalar}}, {"y"}).ok());
+  EXPECT_EQ(session.num_runs, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -25,6 +25,7 @@
 #include "absl/memory/memory.h"
 #include "absl/strings/str_split.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/calculators/tensorflow/tensorflow_batch_scheduler.h"
 #include "mediapipe/calculators/tensorflow/tensorflow_inference_calculator.pb.h"
 #include "mediapipe/calculators/tensorflow/tensorflow_session.h"
 #include "mediapipe/framework/calculator_context.h"
@@ -131,6 +132,11 @@ class InferenceState {
 // corresponding to the input stream packets. Setting the batch_size to 1
 // completely disables batching, but is independent of add_batch_dim_to_tensors.
 //
+// With use_batch_scheduler set, the session runs go through the
+// kTensorFlowBatchSchedulerService object of the graph, if provided. Sharing
+// one TensorFlowBatchScheduler among many graphs batches their runs together,
+// up to a maximum batch size and a maximum latency set on the scheduler.
+//
 // The TensorFlowInferenceCalculator also support feeding states recurrently for
 // RNNs and LSTMs. Simply set the recurrent_tag_pair options to define the
 // recurrent tensors. Initializing the recurrent state can be handled by the
@@ -265,6 +271,9 @@ class TensorFlowInferenceCalculator : public CalculatorBase {
           .Tag(kRecurrentInitTensorsTag)
           .Set<std::unique_ptr<std::map<std::string, tf::Tensor>>>();
     }
+    if (options.use_batch_scheduler()) {
+      cc->UseService(kTensorFlowBatchSchedulerService).Optional();
+    }
     return absl::OkStatus();
   }
 
@@ -345,6 +354,13 @@ class TensorFlowInferenceCalculator : public CalculatorBase {
       inference_state_ = std::unique_ptr<InferenceState>();
     }
 
+    if (options_.use_batch_scheduler()) {
+      auto scheduler = cc->Service(kTensorFlowBatchSchedulerService);
+      if (scheduler.IsAvailable()) {
+        batch_scheduler_ = &scheduler.GetObject();
+      }
+    }
+
     if (options_.batch_size() == 1 || options_.batched_input()) {
       cc->SetOffset(0);
     }
@@ -552,8 +568,18 @@ class TensorFlowInferenceCalculator : public CalculatorBase {
 #if !defined(MEDIAPIPE_MOBILE) && !defined(__APPLE__)
       tsl::profiler::TraceMe trace(absl::string_view(cc->NodeName()));
 #endif
-      tf_status = session_->Run(input_tensors, output_tensor_names,
-                                {} /* target_node_names */, &outputs);
+      if (batch_scheduler_ != nullptr) {
+        auto batched_outputs = batch_scheduler_->Run(
+            session_, input_tensors, output_tensor_names);
+        if (batched_outputs.ok()) {
+          outputs = *std::move(batched_outputs);
+        } else {
+          tf_status = batched_outputs.status();
+        }
+      } else {
+        tf_status = session_->Run(input_tensors, output_tensor_names,
+                                  {} /* target_node_names */, &outputs);
+      }
     }
 
     if (session_run_throttle != nullptr) {
@@ -634,6 +660,10 @@ class TensorFlowInferenceCalculator : public CalculatorBase {
   // may be shared across threads.
   tf::Session* session_;
 
+  // The scheduler that batches session runs across graphs, if enabled by
+  // use_batch_scheduler and provided by the graph.
+  TensorFlowBatchScheduler* batch_scheduler_ = nullptr;
+
   // A mapping between stream tags and the tensor names they are bound to.
   std::map<std::string, std::string> tag_to_tensor_map_;
 
@@ -13,18 +13,30 @@
 // limitations under the License.
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/calculators/tensorflow/tfrecord_reader_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/threadpool.h"
+#include "mediapipe/util/sequence/media_sequence.h"
 #include "tensorflow/core/example/example.pb.h"
 #include "tensorflow/core/lib/core/status.h"
 #include "tensorflow/core/lib/io/record_reader.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system.h"
 
 namespace mediapipe {
@@ -40,6 +52,15 @@ const char kSequenceExampleTag[] = "SEQUENCE_EXAMPLE";
 // record index. Otherwise, the reader always reads the first example/sequence
 // example of the tfrecord file.
 //
+// If the example/sequence example is an output stream instead of an output
+// side packet, the calculator outputs every record of the file from the one
+// at RECORD_INDEX, timestamped with its record index. A reader thread then
+// reads up to read_ahead_records records ahead of the graph, and
+// num_parser_threads threads parse them in parallel.
+//
+// For sequence examples, context_keys and feature_list_keys in the options
+// restrict parsing to the features the graph consumes.
+//
 // Example config:
 // node {
 //   calculator: "TFRecordReaderCalculator"
@@ -47,79 +68,254 @@ const char kSequenceExampleTag[] = "SEQUENCE_EXAMPLE";
 //   input_side_packet: "RECORD_INDEX:record_index"
 //   output_side_packet: "SEQUENCE_EXAMPLE:sequence_example"
 // }
+//
+// node {
+//   calculator: "TFRecordReaderCalculator"
+//   input_side_packet: "TFRECORD_PATH:tfrecord_path"
+//   output_stream: "SEQUENCE_EXAMPLE:sequence_examples"
+//   options {
+//     [mediapipe.TFRecordReaderCalculatorOptions.ext] {
+//       num_parser_threads: 4
+//       feature_list_keys: "image/timestamp"
+//       feature_list_keys: "image/encoded"
+//     }
+//   }
+// }
 class TFRecordReaderCalculator : public CalculatorBase {
  public:
+  ~TFRecordReaderCalculator() override;
+
   static absl::Status GetContract(CalculatorContract* cc);
 
   absl::Status Open(CalculatorContext* cc) override;
   absl::Status Process(CalculatorContext* cc) override;
+  absl::Status Close(CalculatorContext* cc) override;
+
+ private:
+  // A record read ahead of the graph, and its parsed example once done.
+  struct PendingRecord {
+    int64_t index;
+    tensorflow::tstring serialized;
+    absl::StatusOr<Packet> parsed;
+    bool done = false;
+  };
+
+  absl::StatusOr<Packet> ParseRecord(absl::string_view serialized) const;
+
+  // Runs on reader_pool_ and reads records into pending_ until the end of the
+  // file, a read error or StopReading().
+  void ReadRecords(uint64_t offset, int64_t index);
+  void StopReading();
+
+  bool CanReadAhead() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return stopping_ || pending_.size() < static_cast<size_t>(read_ahead_records_);
+  }
+  bool IsNextRecordReady() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return pending_.empty() ? reader_done_ : pending_.front()->done;
+  }
+
+  bool output_example_ = false;
+  absl::flat_hash_set<std::string> context_keys_;
+  absl::flat_hash_set<std::string> feature_list_keys_;
+  int read_ahead_records_ = 0;
+
+  std::unique_ptr<tensorflow::RandomAccessFile> file_;
+  std::unique_ptr<tensorflow::io::RecordReader> reader_;
+
+  absl::Mutex mutex_;
+  std::deque<std::shared_ptr<PendingRecord>> pending_ ABSL_GUARDED_BY(mutex_);
+  absl::Status reader_status_ ABSL_GUARDED_BY(mutex_);
+  bool reader_done_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stopping_ ABSL_GUARDED_BY(mutex_) = false;
+
+  // Declared last so that their threads are joined before the state above is
+  // destroyed.
+  std::unique_ptr<ThreadPool> parser_pool_;
+  std::unique_ptr<ThreadPool> reader_pool_;
 };
 
+TFRecordReaderCalculator::~TFRecordReaderCalculator() { StopReading(); }
+
 absl::Status TFRecordReaderCalculator::GetContract(CalculatorContract* cc) {
   cc->InputSidePackets().Tag(kTFRecordPath).Set<std::string>();
   if (cc->InputSidePackets().HasTag(kRecordIndex)) {
     cc->InputSidePackets().Tag(kRecordIndex).Set<int>();
   }
 
-  RET_CHECK(cc->OutputSidePackets().HasTag(kExampleTag) ||
-            cc->OutputSidePackets().HasTag(kSequenceExampleTag))
+  RET_CHECK(cc->OutputSidePackets().HasTag(kExampleTag) +
+                cc->OutputSidePackets().HasTag(kSequenceExampleTag) +
+                cc->Outputs().HasTag(kExampleTag) +
+                cc->Outputs().HasTag(kSequenceExampleTag) ==
+            1)
       << "TFRecordReaderCalculator must output either Tensorflow example or "
          "sequence example.";
   if (cc->OutputSidePackets().HasTag(kExampleTag)) {
     cc->OutputSidePackets().Tag(kExampleTag).Set<tensorflow::Example>();
-  } else {
+  } else if (cc->OutputSidePackets().HasTag(kSequenceExampleTag)) {
     cc->OutputSidePackets()
         .Tag(kSequenceExampleTag)
         .Set<tensorflow::SequenceExample>();
+  } else if (cc->Outputs().HasTag(kExampleTag)) {
+    cc->Outputs().Tag(kExampleTag).Set<tensorflow::Example>();
+  } else {
+    cc->Outputs().Tag(kSequenceExampleTag).Set<tensorflow::SequenceExample>();
   }
   return absl::OkStatus();
 }
 
 absl::Status TFRecordReaderCalculator::Open(CalculatorContext* cc) {
-  std::unique_ptr<tensorflow::RandomAccessFile> file;
+  const auto& options = cc->Options<TFRecordReaderCalculatorOptions>();
+  output_example_ = cc->OutputSidePackets().HasTag(kExampleTag) ||
+                    cc->Outputs().HasTag(kExampleTag);
+  context_keys_.insert(options.context_keys().begin(),
+                       options.context_keys().end());
+  feature_list_keys_.insert(options.feature_list_keys().begin(),
+                            options.feature_list_keys().end());
+
   auto tf_status = tensorflow::Env::Default()->NewRandomAccessFile(
-      cc->InputSidePackets().Tag(kTFRecordPath).Get<std::string>(), &file);
+      cc->InputSidePackets().Tag(kTFRecordPath).Get<std::string>(), &file_);
   RET_CHECK(tf_status.ok())
       << "Failed to open tfrecord file: " << tf_status.ToString();
-  tensorflow::io::RecordReader reader(file.get(),
-                                      tensorflow::io::RecordReaderOptions());
+  tensorflow::io::RecordReaderOptions reader_options;
+  reader_options.buffer_size = options.read_buffer_size();
+  reader_ = std::make_unique<tensorflow::io::RecordReader>(file_.get(),
+                                                           reader_options);
+
+  // Skips the records before the target without copying them out.
   uint64_t offset = 0;
-  tensorflow::tstring example_str;
   const int target_idx =
       cc->InputSidePackets().HasTag(kRecordIndex)
           ? cc->InputSidePackets().Tag(kRecordIndex).Get<int>()
           : 0;
-  int current_idx = 0;
-  while (current_idx <= target_idx) {
-    tf_status = reader.ReadRecord(&offset, &example_str);
+  if (target_idx > 0) {
+    int num_skipped = 0;
+    tf_status = reader_->SkipRecords(&offset, target_idx, &num_skipped);
     RET_CHECK(tf_status.ok())
         << "Failed to read tfrecord: " << tf_status.ToString();
-    if (current_idx == target_idx) {
-      if (cc->OutputSidePackets().HasTag(kExampleTag)) {
-        tensorflow::Example tf_example;
-        tf_example.ParseFromArray(example_str.data(), example_str.size());
-        cc->OutputSidePackets()
-            .Tag(kExampleTag)
-            .Set(MakePacket<tensorflow::Example>(std::move(tf_example)));
-      } else {
-        tensorflow::SequenceExample tf_sequence_example;
-        tf_sequence_example.ParseFromString(example_str);
-        cc->OutputSidePackets()
-            .Tag(kSequenceExampleTag)
-            .Set(MakePacket<tensorflow::SequenceExample>(
-                std::move(tf_sequence_example)));
-      }
-    }
-    ++current_idx;
   }
 
+  if (cc->Outputs().NumEntries() > 0) {
+    RET_CHECK_GT(options.read_ahead_records(), 0);
+    RET_CHECK_GT(options.num_parser_threads(), 0);
+    read_ahead_records_ = options.read_ahead_records();
+    parser_pool_ = std::make_unique<ThreadPool>("tfrecord_parser",
+                                                options.num_parser_threads());
+    parser_pool_->StartWorkers();
+    reader_pool_ = std::make_unique<ThreadPool>("tfrecord_reader", 1);
+    reader_pool_->StartWorkers();
+    reader_pool_->Schedule(
+        [this, offset, target_idx] { ReadRecords(offset, target_idx); });
+    return absl::OkStatus();
+  }
+
+  tensorflow::tstring example_str;
+  tf_status = reader_->ReadRecord(&offset, &example_str);
+  RET_CHECK(tf_status.ok())
+      << "Failed to read tfrecord: " << tf_status.ToString();
+  MP_ASSIGN_OR_RETURN(
+      Packet example,
+      ParseRecord(absl::string_view(example_str.data(), example_str.size())));
+  cc->OutputSidePackets()
+      .Tag(output_example_ ? kExampleTag : kSequenceExampleTag)
+      .Set(std::move(example));
   return absl::OkStatus();
 }
 
 absl::Status TFRecordReaderCalculator::Process(CalculatorContext* cc) {
+  if (cc->Outputs().NumEntries() == 0) {
+    return absl::OkStatus();
+  }
+  std::shared_ptr<PendingRecord> record;
+  {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(
+        absl::Condition(this, &TFRecordReaderCalculator::IsNextRecordReady));
+    if (pending_.empty()) {
+      MP_RETURN_IF_ERROR(reader_status_);
+      return tool::StatusStop();
+    }
+    record = std::move(pending_.front());
+    pending_.pop_front();
+  }
+  MP_RETURN_IF_ERROR(record->parsed.status());
+  cc->Outputs()
+      .Tag(output_example_ ? kExampleTag : kSequenceExampleTag)
+      .AddPacket(std::move(*record->parsed).At(Timestamp(record->index)));
   return absl::OkStatus();
 }
 
+absl::Status TFRecordReaderCalculator::Close(CalculatorContext* cc) {
+  StopReading();
+  return absl::OkStatus();
+}
+
+absl::StatusOr<Packet> TFRecordReaderCalculator::ParseRecord(
+    absl::string_view serialized) const {
+  if (output_example_) {
+    tensorflow::Example tf_example;
+    RET_CHECK(tf_example.ParseFromArray(serialized.data(), serialized.size()))
+        << "Failed to parse tensorflow example.";
+    return MakePacket<tensorflow::Example>(std::move(tf_example));
+  }
+  tensorflow::SequenceExample tf_sequence_example;
+  if (context_keys_.empty() && feature_list_keys_.empty()) {
+    RET_CHECK(tf_sequence_example.ParseFromArray(serialized.data(),
+                                                 serialized.size()))
+        << "Failed to parse tensorflow sequence example.";
+  } else {
+    MP_RETURN_IF_ERROR(mediasequence::ParseSequenceExampleFeatures(
+        serialized, context_keys_, feature_list_keys_, &tf_sequence_example));
+  }
+  return MakePacket<tensorflow::SequenceExample>(
+      std::move(tf_sequence_example));
+}
+
+void TFRecordReaderCalculator::ReadRecords(uint64_t offset, int64_t index) {
+  while (true) {
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(
+          absl::Condition(this, &TFRecordReaderCalculator::CanReadAhead));
+      if (stopping_) break;
+    }
+    auto record = std::make_shared<PendingRecord>();
+    record->index = index++;
+    auto tf_status = reader_->ReadRecord(&offset, &record->serialized);
+    if (!tf_status.ok()) {
+      if (!tensorflow::errors::IsOutOfRange(tf_status)) {
+        absl::MutexLock lock(&mutex_);
+        reader_status_ = absl::InternalError(
+            absl::StrCat("Failed to read tfrecord: ", tf_status.ToString()));
+      }
+      break;
+    }
+    {
+      absl::MutexLock lock(&mutex_);
+      pending_.push_back(record);
+    }
+    parser_pool_->Schedule([this, record] {
+      absl::StatusOr<Packet> parsed = ParseRecord(absl::string_view(
+          record->serialized.data(), record->serialized.size()));
+      record->serialized = tensorflow::tstring();
+      absl::MutexLock lock(&mutex_);
+      record->parsed = std::move(parsed);
+      record->done = true;
+    });
+  }
+  absl::MutexLock lock(&mutex_);
+  reader_done_ = true;
+}
+
+void TFRecordReaderCalculator::StopReading() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  // Joins the reader before the parsers, which it schedules work on.
+  reader_pool_.reset();
+  parser_pool_.reset();
+}
+
 REGISTER_CALCULATOR(TFRecordReaderCalculator);
 
 }  // namespace mediapipe
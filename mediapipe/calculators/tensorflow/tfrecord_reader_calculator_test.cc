@@ -0,0 +1,147 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/calculators/tensorflow/tfrecord_reader_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/sequence/media_sequence.h"
+#include "tensorflow/core/example/example.pb.h"
+#include "tensorflow/core/lib/io/record_writer.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/file_system.h"
+
+namespace mediapipe {
+namespace {
+
+namespace mpms = mediapipe::mediasequence;
+namespace tf = ::tensorflow;
+
+constexpr int kNumRecords = 20;
+
+// Writes kNumRecords sequence examples whose data path and image timestamp
+// are the record index, and returns the path of the tfrecord file.
+std::string WriteSequenceExamples(const std::string& name) {
+  const std::string path = absl::StrCat(getenv("TEST_TMPDIR"), "/", name);
+  std::unique_ptr<tf::WritableFile> file;
+  EXPECT_TRUE(tf::Env::Default()->NewWritableFile(path, &file).ok());
+  tf::io::RecordWriter writer(file.get());
+  for (int i = 0; i < kNumRecords; ++i) {
+    tf::SequenceExample sequence;
+    mpms::SetClipDataPath(absl::StrCat(i), &sequence);
+    mpms::AddImageTimestamp(i, &sequence);
+    mpms::AddImageEncoded("image", &sequence);
+    EXPECT_TRUE(writer.WriteRecord(sequence.SerializeAsString()).ok());
+  }
+  EXPECT_TRUE(writer.Close().ok());
+  EXPECT_TRUE(file->Close().ok());
+  return path;
+}
+
+TEST(TFRecordReaderCalculatorTest, OutputsSequenceExampleAtRecordIndex) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "TFRecordReaderCalculator"
+    input_side_packet: "TFRECORD_PATH:path"
+    input_side_packet: "RECORD_INDEX:index"
+    output_side_packet: "SEQUENCE_EXAMPLE:sequence"
+  )pb"));
+  runner.MutableSidePackets()->Tag("TFRECORD_PATH") =
+      MakePacket<std::string>(WriteSequenceExamples("side_packet.tfrecord"));
+  runner.MutableSidePackets()->Tag("RECORD_INDEX") = MakePacket<int>(7);
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& sequence = runner.OutputSidePackets()
+                             .Tag("SEQUENCE_EXAMPLE")
+                             .Get<tf::SequenceExample>();
+  EXPECT_EQ(mpms::GetClipDataPath(sequence), "7");
+  EXPECT_EQ(mpms::GetImageEncodedSize(sequence), 1);
+}
+
+TEST(TFRecordReaderCalculatorTest, StreamsSequenceExamplesInOrder) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "TFRecordReaderCalculator"
+    input_side_packet: "TFRECORD_PATH:path"
+    input_side_packet: "RECORD_INDEX:index"
+    output_stream: "SEQUENCE_EXAMPLE:sequences"
+    options {
+      [mediapipe.TFRecordReaderCalculatorOptions.ext] {
+        read_ahead_records: 3
+        num_parser_threads: 4
+      }
+    }
+  )pb"));
+  runner.MutableSidePackets()->Tag("TFRECORD_PATH") =
+      MakePacket<std::string>(WriteSequenceExamples("stream.tfrecord"));
+  runner.MutableSidePackets()->Tag("RECORD_INDEX") = MakePacket<int>(2);
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& packets = runner.Outputs().Tag("SEQUENCE_EXAMPLE").packets;
+  ASSERT_EQ(packets.size(), kNumRecords - 2);
+  for (int i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(packets[i].Timestamp(), Timestamp(i + 2));
+    const auto& sequence = packets[i].Get<tf::SequenceExample>();
+    EXPECT_EQ(mpms::GetClipDataPath(sequence), absl::StrCat(i + 2));
+    EXPECT_EQ(mpms::GetImageEncodedSize(sequence), 1);
+  }
+}
+
+TEST(TFRecordReaderCalculatorTest, ParsesOnlySelectedFeatures) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "TFRecordReaderCalculator"
+    input_side_packet: "TFRECORD_PATH:path"
+    output_stream: "SEQUENCE_EXAMPLE:sequences"
+    options {
+      [mediapipe.TFRecordReaderCalculatorOptions.ext] {
+        feature_list_keys: "image/timestamp"
+      }
+    }
+  )pb"));
+  runner.MutableSidePackets()->Tag("TFRECORD_PATH") =
+      MakePacket<std::string>(WriteSequenceExamples("selected.tfrecord"));
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& packets = runner.Outputs().Tag("SEQUENCE_EXAMPLE").packets;
+  ASSERT_EQ(packets.size(), kNumRecords);
+  for (int i = 0; i < packets.size(); ++i) {
+    const auto& sequence = packets[i].Get<tf::SequenceExample>();
+    EXPECT_FALSE(mpms::HasClipDataPath(sequence));
+    EXPECT_EQ(mpms::GetImageEncodedSize(sequence), 0);
+    ASSERT_EQ(mpms::GetImageTimestampSize(sequence), 1);
+    EXPECT_EQ(mpms::GetImageTimestampAt(sequence, 0), i);
+  }
+}
+
+TEST(TFRecordReaderCalculatorTest, FailsOnMissingFile) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "TFRecordReaderCalculator"
+    input_side_packet: "TFRECORD_PATH:path"
+    output_stream: "SEQUENCE_EXAMPLE:sequences"
+  )pb"));
+  runner.MutableSidePackets()->Tag("TFRECORD_PATH") = MakePacket<std::string>(
+      absl::StrCat(getenv("TEST_TMPDIR"), "/missing.tfrecord"));
+  EXPECT_FALSE(runner.Run().ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
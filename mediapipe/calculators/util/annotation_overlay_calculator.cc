@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstddef>
 #include <memory>
 
 #include "absl/log/absl_log.h"
@@ -29,6 +30,7 @@
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/vector.h"
+#include "mediapipe/util/annotation_batch.h"
 #include "mediapipe/util/annotation_renderer.h"
 #include "mediapipe/util/color.pb.h"
 #include "mediapipe/util/render_data.pb.h"
@@ -51,6 +53,12 @@ constexpr char kImageFrameTag[] = "IMAGE";
 constexpr char kImageTag[] = "UIMAGE";  // Universal Image
 
 enum { ATTRIB_VERTEX, ATTRIB_TEXTURE_POSITION, NUM_ATTRIBUTES };
+enum {
+  ATTRIB_ANNOTATION_POSITION,
+  ATTRIB_ANNOTATION_COLOR,
+  ATTRIB_ANNOTATION_SHAPE,
+  NUM_ANNOTATION_ATTRIBUTES
+};
 
 // Round up n to next multiple of m.
 size_t RoundUp(size_t n, size_t m) { return ((n + m - 1) / m) * m; }  // NOLINT
@@ -95,6 +103,11 @@ inline bool HasImageTag(mediapipe::CalculatorContext* cc) {
 // Note: When using GPU, drawing with color kAnnotationBackgroundColor (defined
 // above) is not supported.
 //
+// With gpu_direct_rendering enabled, GPU frames whose annotations are all
+// supported by AnnotationBatch are drawn straight into the output texture with
+// a single draw call, skipping the OpenCV canvas and its upload. Frames with
+// text or rounded rectangles still go through the canvas.
+//
 // Example config (CPU):
 // node {
 //   calculator: "AnnotationOverlayCalculator"
@@ -155,9 +168,19 @@ class AnnotationOverlayCalculator : public CalculatorBase {
                            const ImageFormat::Format& target_format,
                            uchar* data_image);
 
-  absl::Status GlRender(CalculatorContext* cc);
+  // Collects the render data of the current timestamp into batch_. Returns
+  // false if any of it has to be drawn by renderer_ instead.
+  bool BatchRenderData(CalculatorContext* cc, int width, int height);
+  template <typename Type, const char* Tag>
+  absl::Status RenderBatchToGpu(CalculatorContext* cc);
+
+#if !MEDIAPIPE_DISABLE_GPU
+  absl::Status GlRender(CalculatorContext* cc, GLuint program);
+#endif  // !MEDIAPIPE_DISABLE_GPU
+  absl::Status GlRenderBatch(int width, int height);
   template <typename Type, const char* Tag>
   absl::Status GlSetup(CalculatorContext* cc);
+  absl::Status GlSetupDirectRendering();
 
   // Options for the calculator.
   AnnotationOverlayCalculatorOptions options_;
@@ -165,6 +188,9 @@ class AnnotationOverlayCalculator : public CalculatorBase {
   // Underlying helper renderer library.
   std::unique_ptr<AnnotationRenderer> renderer_;
 
+  // Triangles of the current frame for gpu_direct_rendering.
+  AnnotationBatch batch_;
+
   // Indicates if image frame is available as input.
   bool image_frame_available_ = false;
 
@@ -178,6 +204,11 @@ class AnnotationOverlayCalculator : public CalculatorBase {
   int height_ = 0;
   int width_canvas_ = 0;  // Size of overlay drawing texture canvas.
   int height_canvas_ = 0;
+  // Programs and vertex buffer for gpu_direct_rendering.
+  GLuint copy_program_ = 0;
+  GLuint batch_program_ = 0;
+  GLint batch_transform_location_ = -1;
+  GLuint batch_vbo_ = 0;
 #endif  // MEDIAPIPE_DISABLE_GPU
 };
 REGISTER_CALCULATOR(AnnotationOverlayCalculator);
@@ -314,21 +345,47 @@ absl::Status AnnotationOverlayCalculator::Process(CalculatorContext* cc) {
     use_gpu_ = cc->Inputs().Tag(kImageTag).Get<mediapipe::Image>().UsesGpu();
   }
 
+#if !MEDIAPIPE_DISABLE_GPU
+  if (use_gpu_ && !gpu_initialized_) {
+    MP_RETURN_IF_ERROR(gpu_helper_.RunInGlContext([this, cc]() -> absl::Status {
+      if (HasImageTag(cc)) {
+        return GlSetup<mediapipe::Image, kImageTag>(cc);
+      }
+      return GlSetup<mediapipe::GpuBuffer, kGpuBufferTag>(cc);
+    }));
+    gpu_initialized_ = true;
+  }
+
+  if (use_gpu_ && image_frame_available_ &&
+      options_.gpu_direct_rendering()) {
+    int width = 0;
+    int height = 0;
+    if (HasImageTag(cc)) {
+      const auto& image = cc->Inputs().Tag(kImageTag).Get<mediapipe::Image>();
+      width = image.width();
+      height = image.height();
+    } else {
+      const auto& buffer =
+          cc->Inputs().Tag(kGpuBufferTag).Get<mediapipe::GpuBuffer>();
+      width = buffer.width();
+      height = buffer.height();
+    }
+    if (BatchRenderData(cc, width, height)) {
+      return gpu_helper_.RunInGlContext([this, cc]() -> absl::Status {
+        if (HasImageTag(cc)) {
+          return RenderBatchToGpu<mediapipe::Image, kImageTag>(cc);
+        }
+        return RenderBatchToGpu<mediapipe::GpuBuffer, kGpuBufferTag>(cc);
+      });
+    }
+  }
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
   // Initialize render target, drawn with OpenCV.
   std::unique_ptr<cv::Mat> image_mat;
   ImageFormat::Format target_format;
   if (use_gpu_) {
 #if !MEDIAPIPE_DISABLE_GPU
-    if (!gpu_initialized_) {
-      MP_RETURN_IF_ERROR(
-          gpu_helper_.RunInGlContext([this, cc]() -> absl::Status {
-            if (HasImageTag(cc)) {
-              return GlSetup<mediapipe::Image, kImageTag>(cc);
-            }
-            return GlSetup<mediapipe::GpuBuffer, kGpuBufferTag>(cc);
-          }));
-      gpu_initialized_ = true;
-    }
     if (HasImageTag(cc)) {
       MP_RETURN_IF_ERROR(
           (CreateRenderTargetGpu<mediapipe::Image, kImageTag>(cc, image_mat)));
@@ -406,6 +463,12 @@ absl::Status AnnotationOverlayCalculator::Close(CalculatorContext* cc) {
     program_ = 0;
     if (image_mat_tex_) glDeleteTextures(1, &image_mat_tex_);
     image_mat_tex_ = 0;
+    if (copy_program_) glDeleteProgram(copy_program_);
+    copy_program_ = 0;
+    if (batch_program_) glDeleteProgram(batch_program_);
+    batch_program_ = 0;
+    if (batch_vbo_) glDeleteBuffers(1, &batch_vbo_);
+    batch_vbo_ = 0;
   });
 #endif  // !MEDIAPIPE_DISABLE_GPU
 
@@ -470,7 +533,7 @@ absl::Status AnnotationOverlayCalculator::RenderToGpu(CalculatorContext* cc,
     glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, image_mat_tex_);
 
-    MP_RETURN_IF_ERROR(GlRender(cc));
+    MP_RETURN_IF_ERROR(GlRender(cc, program_));
 
     glActiveTexture(GL_TEXTURE2);
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -491,6 +554,68 @@ absl::Status AnnotationOverlayCalculator::RenderToGpu(CalculatorContext* cc,
   return absl::OkStatus();
 }
 
+bool AnnotationOverlayCalculator::BatchRenderData(CalculatorContext* cc,
+                                                  int width, int height) {
+  batch_.Reset(width, height);
+  for (CollectionItemId id = cc->Inputs().BeginId(); id < cc->Inputs().EndId();
+       ++id) {
+    auto tag_and_index = cc->Inputs().TagAndIndexFromId(id);
+    std::string tag = tag_and_index.first;
+    if (!tag.empty() && tag != kVectorTag) {
+      continue;
+    }
+    if (cc->Inputs().Get(id).IsEmpty()) {
+      continue;
+    }
+    if (tag.empty()) {
+      if (!batch_.Append(cc->Inputs().Get(id).Get<RenderData>())) {
+        return false;
+      }
+    } else {
+      for (const RenderData& render_data :
+           cc->Inputs().Get(id).Get<std::vector<RenderData>>()) {
+        if (!batch_.Append(render_data)) return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Type, const char* Tag>
+absl::Status AnnotationOverlayCalculator::RenderBatchToGpu(
+    CalculatorContext* cc) {
+#if !MEDIAPIPE_DISABLE_GPU
+  const auto& input_frame = cc->Inputs().Tag(Tag).Get<Type>();
+  auto input_texture = gpu_helper_.CreateSourceTexture(input_frame);
+
+  auto output_texture = gpu_helper_.CreateDestinationTexture(
+      input_texture.width(), input_texture.height(),
+      mediapipe::GpuBufferFormat::kBGRA32);
+
+  {
+    gpu_helper_.BindFramebuffer(output_texture);
+
+    // Copy the input, then draw all annotations on top of it.
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, input_texture.name());
+    MP_RETURN_IF_ERROR(GlRender(cc, copy_program_));
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    MP_RETURN_IF_ERROR(
+        GlRenderBatch(input_texture.width(), input_texture.height()));
+    glFlush();
+  }
+
+  auto output_frame = output_texture.template GetFrame<Type>();
+  cc->Outputs().Tag(Tag).Add(output_frame.release(), cc->InputTimestamp());
+
+  input_texture.Release();
+  output_texture.Release();
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+  return absl::OkStatus();
+}
+
 absl::Status AnnotationOverlayCalculator::CreateRenderTargetCpu(
     CalculatorContext* cc, std::unique_ptr<cv::Mat>& image_mat,
     ImageFormat::Format* target_format) {
@@ -613,8 +738,9 @@ absl::Status AnnotationOverlayCalculator::CreateRenderTargetGpu(
   return absl::OkStatus();
 }
 
-absl::Status AnnotationOverlayCalculator::GlRender(CalculatorContext* cc) {
 #if !MEDIAPIPE_DISABLE_GPU
+absl::Status AnnotationOverlayCalculator::GlRender(CalculatorContext* cc,
+                                                   GLuint program) {
   static const GLfloat square_vertices[] = {
       -1.0f, -1.0f,  // bottom left
       1.0f,  -1.0f,  // bottom right
@@ -629,7 +755,7 @@ absl::Status AnnotationOverlayCalculator::GlRender(CalculatorContext* cc) {
   };
 
   // program
-  glUseProgram(program_);
+  glUseProgram(program);
 
   // vertex storage
   GLuint vbo[2];
@@ -662,6 +788,131 @@ absl::Status AnnotationOverlayCalculator::GlRender(CalculatorContext* cc) {
   glBindVertexArray(0);
   glDeleteVertexArrays(1, &vao);
   glDeleteBuffers(2, vbo);
+
+  return absl::OkStatus();
+}
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+absl::Status AnnotationOverlayCalculator::GlRenderBatch(int width,
+                                                        int height) {
+#if !MEDIAPIPE_DISABLE_GPU
+  if (batch_.empty()) return absl::OkStatus();
+
+  glUseProgram(batch_program_);
+  // Maps pixel coordinates to clip space. Output row 0 is at y = -1, which is
+  // the top of the image for top-left origin textures.
+  const float y_scale = options_.gpu_uses_top_left_origin() ? 2.0f : -2.0f;
+  glUniform4f(batch_transform_location_, 2.0f / width, y_scale / height, -1.0f,
+              -y_scale / 2.0f);
+
+  GLuint vao;
+  glGenVertexArrays(1, &vao);
+  glBindVertexArray(vao);
+
+  const auto& vertices = batch_.vertices();
+  glBindBuffer(GL_ARRAY_BUFFER, batch_vbo_);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(AnnotationVertex),
+               vertices.data(), GL_STREAM_DRAW);
+  constexpr GLsizei kStride = sizeof(AnnotationVertex);
+  glEnableVertexAttribArray(ATTRIB_ANNOTATION_POSITION);
+  glVertexAttribPointer(
+      ATTRIB_ANNOTATION_POSITION, 2, GL_FLOAT, GL_FALSE, kStride,
+      reinterpret_cast<const void*>(offsetof(AnnotationVertex, x)));
+  glEnableVertexAttribArray(ATTRIB_ANNOTATION_COLOR);
+  glVertexAttribPointer(
+      ATTRIB_ANNOTATION_COLOR, 3, GL_FLOAT, GL_FALSE, kStride,
+      reinterpret_cast<const void*>(offsetof(AnnotationVertex, r)));
+  glEnableVertexAttribArray(ATTRIB_ANNOTATION_SHAPE);
+  glVertexAttribPointer(
+      ATTRIB_ANNOTATION_SHAPE, 2, GL_FLOAT, GL_FALSE, kStride,
+      reinterpret_cast<const void*>(offsetof(AnnotationVertex, u)));
+
+  glDrawArrays(GL_TRIANGLES, 0, vertices.size());
+
+  glDisableVertexAttribArray(ATTRIB_ANNOTATION_POSITION);
+  glDisableVertexAttribArray(ATTRIB_ANNOTATION_COLOR);
+  glDisableVertexAttribArray(ATTRIB_ANNOTATION_SHAPE);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindVertexArray(0);
+  glDeleteVertexArrays(1, &vao);
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+  return absl::OkStatus();
+}
+
+absl::Status AnnotationOverlayCalculator::GlSetupDirectRendering() {
+#if !MEDIAPIPE_DISABLE_GPU
+  {
+    const GLint attr_location[NUM_ATTRIBUTES] = {
+        ATTRIB_VERTEX,
+        ATTRIB_TEXTURE_POSITION,
+    };
+    const GLchar* attr_name[NUM_ATTRIBUTES] = {
+        "position",
+        "texture_coordinate",
+    };
+    mediapipe::GlhCreateProgram(mediapipe::kBasicVertexShader,
+                                mediapipe::kBasicTexturedFragmentShader,
+                                NUM_ATTRIBUTES, &attr_name[0], attr_location,
+                                &copy_program_);
+    RET_CHECK(copy_program_) << "Problem initializing the copy program.";
+    glUseProgram(copy_program_);
+    glUniform1i(glGetUniformLocation(copy_program_, "video_frame"), 1);
+  }
+
+  const GLint attr_location[NUM_ANNOTATION_ATTRIBUTES] = {
+      ATTRIB_ANNOTATION_POSITION,
+      ATTRIB_ANNOTATION_COLOR,
+      ATTRIB_ANNOTATION_SHAPE,
+  };
+  const GLchar* attr_name[NUM_ANNOTATION_ATTRIBUTES] = {
+      "position",
+      "color",
+      "shape_coordinate",
+  };
+
+  // Positions are in pixels; transform holds the scale (xy) and offset (zw)
+  // to clip space.
+  constexpr char kVertSrcBody[] = R"(
+    in vec2 position;
+    in vec3 color;
+    in vec2 shape_coordinate;
+    uniform vec4 transform;
+    out vec3 annotation_color;
+    out vec2 annotation_shape_coordinate;
+
+    void main() {
+      gl_Position = vec4(position * transform.xy + transform.zw, 0.0, 1.0);
+      annotation_color = color;
+      annotation_shape_coordinate = shape_coordinate;
+    }
+  )";
+
+  // Discs are quads with shape coordinates in [-1, 1]; everything outside the
+  // unit circle is cut away. Other shapes have all shape coordinates at 0.
+  constexpr char kFragSrcBody[] = R"(
+    DEFAULT_PRECISION(mediump, float)
+    in vec3 annotation_color;
+    in vec2 annotation_shape_coordinate;
+
+    void main() {
+      vec2 p = annotation_shape_coordinate;
+      if (dot(p, p) > 1.0) discard;
+      gl_FragColor = vec4(annotation_color, 1.0);
+    }
+  )";
+
+  const std::string vert_src =
+      absl::StrCat(mediapipe::kMediaPipeVertexShaderPreamble, kVertSrcBody);
+  const std::string frag_src =
+      absl::StrCat(mediapipe::kMediaPipeFragmentShaderPreamble, kFragSrcBody);
+  mediapipe::GlhCreateProgram(vert_src.c_str(), frag_src.c_str(),
+                              NUM_ANNOTATION_ATTRIBUTES, &attr_name[0],
+                              attr_location, &batch_program_);
+  RET_CHECK(batch_program_) << "Problem initializing the annotation program.";
+  batch_transform_location_ =
+      glGetUniformLocation(batch_program_, "transform");
+  glGenBuffers(1, &batch_vbo_);
 #endif  // !MEDIAPIPE_DISABLE_GPU
 
   return absl::OkStatus();
@@ -766,6 +1017,10 @@ absl::Status AnnotationOverlayCalculator::GlSetup(CalculatorContext* cc) {
     glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glBindTexture(GL_TEXTURE_2D, 0);
   }
+
+  if (options_.gpu_direct_rendering() && image_frame_available_) {
+    MP_RETURN_IF_ERROR(GlSetupDirectRendering());
+  }
 #endif  // !MEDIAPIPE_DISABLE_GPU
 
   return absl::OkStatus();
@@ -15,11 +15,16 @@
 #ifndef MEDIAPIPE_CALCULATORS_UTIL_ASSOCIATION_CALCULATOR_H_
 #define MEDIAPIPE_CALCULATORS_UTIL_ASSOCIATION_CALCULATOR_H_
 
+#include <algorithm>
+#include <list>
 #include <memory>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/memory/memory.h"
+#include "absl/types/span.h"
 #include "mediapipe/calculators/util/association_calculator.pb.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -42,6 +47,8 @@ namespace mediapipe {
 // input stream that don't overlap with other elements are not added to the
 // output. This stream is designed to take detections from previous timestamp,
 // e.g. output of PreviousLoopbackCalculator to provide temporal association.
+// With association_mode GREEDY_MATCHING, the elements are associated in one
+// batch from their IoU matrix instead, see association_calculator.proto.
 // See AssociationDetectionCalculator and AssociationNormRectCalculator for
 // example uses.
 template <typename T>
@@ -79,6 +86,11 @@ class AssociationCalculator : public CalculatorBase {
   }
 
   absl::Status Process(CalculatorContext* cc) override {
+    if (options_.association_mode() ==
+        AssociationCalculatorOptions::GREEDY_MATCHING) {
+      return ProcessWithGreedyMatching(cc);
+    }
+
     auto get_non_overlapping_elements = GetNonOverlappingElements(cc);
     if (!get_non_overlapping_elements.ok()) {
       return get_non_overlapping_elements.status();
@@ -123,6 +135,133 @@ class AssociationCalculator : public CalculatorBase {
   virtual void SetId(T* input, int id) {}
 
  private:
+  absl::Status ProcessWithGreedyMatching(CalculatorContext* cc) {
+    // Gather the elements of all regular input streams in increasing order of
+    // priority.
+    std::vector<T> elements;
+    for (CollectionItemId id = cc->Inputs().BeginId();
+         id < cc->Inputs().EndId(); ++id) {
+      if (id == prev_input_stream_id_ || cc->Inputs().Get(id).IsEmpty()) {
+        continue;
+      }
+      const std::vector<T>& input_vec =
+          cc->Inputs().Get(id).template Get<std::vector<T>>();
+      elements.insert(elements.end(), input_vec.begin(), input_vec.end());
+    }
+    MP_ASSIGN_OR_RETURN(RectangleArrays rects, GetRectangles(elements));
+
+    const int num_elements = elements.size();
+    const float threshold = options_.min_similarity_threshold();
+    std::vector<float> ious(num_elements);
+    std::vector<bool> kept(num_elements, false);
+    std::vector<bool> suppressed(num_elements, false);
+    for (int i = num_elements - 1; i >= 0; --i) {
+      if (suppressed[i]) {
+        continue;
+      }
+      kept[i] = true;
+      CalculateIous(rects, i, rects, absl::MakeSpan(ious));
+      // All elements of higher priority are already kept or suppressed.
+      float best_iou = 0.0f;
+      int best_id = -1;
+      bool change_id = false;
+      for (int j = i - 1; j >= 0; --j) {
+        if (suppressed[j] || ious[j] <= threshold) {
+          continue;
+        }
+        suppressed[j] = true;
+        const std::pair<bool, int> id = GetId(elements[j]);
+        if (id.first && (!change_id || ious[j] > best_iou)) {
+          change_id = true;
+          best_iou = ious[j];
+          best_id = id.second;
+        }
+      }
+      if (change_id) {
+        SetId(&elements[i], best_id);
+      }
+    }
+
+    auto output = absl::make_unique<std::vector<T>>();
+    for (int i = 0; i < num_elements; ++i) {
+      if (kept[i]) {
+        output->push_back(std::move(elements[i]));
+      }
+    }
+
+    if (has_prev_input_stream_ &&
+        !cc->Inputs().Get(prev_input_stream_id_).IsEmpty()) {
+      const std::vector<T>& prev_input_vec =
+          cc->Inputs()
+              .Get(prev_input_stream_id_)
+              .template Get<std::vector<T>>();
+      MP_RETURN_IF_ERROR(MatchIdsFromPrevious(prev_input_vec, output.get()));
+    }
+
+    cc->Outputs().Index(0).Add(output.release(), cc->InputTimestamp());
+    return absl::OkStatus();
+  }
+
+  // Matches the elements of |current| one-to-one with the elements of
+  // |prev_input_vec| that have an ID, in decreasing order of IoU, and copies
+  // the IDs of the matched previous elements.
+  absl::Status MatchIdsFromPrevious(const std::vector<T>& prev_input_vec,
+                                    std::vector<T>* current) {
+    std::vector<T> prev_with_ids;
+    std::vector<int> prev_ids;
+    for (const T& prev : prev_input_vec) {
+      const std::pair<bool, int> id = GetId(prev);
+      if (id.first) {
+        prev_with_ids.push_back(prev);
+        prev_ids.push_back(id.second);
+      }
+    }
+    MP_ASSIGN_OR_RETURN(RectangleArrays cur_rects, GetRectangles(*current));
+    MP_ASSIGN_OR_RETURN(RectangleArrays prev_rects,
+                        GetRectangles(prev_with_ids));
+
+    // (IoU, current index, previous index) of all overlapping pairs.
+    std::vector<std::tuple<float, int, int>> pairs;
+    std::vector<float> ious(prev_rects.size());
+    for (int i = 0; i < cur_rects.size(); ++i) {
+      CalculateIous(cur_rects, i, prev_rects, absl::MakeSpan(ious));
+      for (int j = 0; j < prev_rects.size(); ++j) {
+        if (ious[j] > options_.min_similarity_threshold()) {
+          pairs.emplace_back(ious[j], i, j);
+        }
+      }
+    }
+    std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+      if (std::get<0>(a) != std::get<0>(b)) {
+        return std::get<0>(a) > std::get<0>(b);
+      }
+      return std::make_pair(std::get<1>(a), std::get<2>(a)) <
+             std::make_pair(std::get<1>(b), std::get<2>(b));
+    });
+
+    std::vector<bool> cur_matched(cur_rects.size(), false);
+    std::vector<bool> prev_matched(prev_rects.size(), false);
+    for (const auto& [iou, i, j] : pairs) {
+      if (cur_matched[i] || prev_matched[j]) {
+        continue;
+      }
+      cur_matched[i] = true;
+      prev_matched[j] = true;
+      SetId(&(*current)[i], prev_ids[j]);
+    }
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<RectangleArrays> GetRectangles(
+      const std::vector<T>& elements) {
+    RectangleArrays rects;
+    for (const T& element : elements) {
+      MP_ASSIGN_OR_RETURN(Rectangle_f rect, GetRectangle(element));
+      rects.Add(rect);
+    }
+    return rects;
+  }
+
   // Get a list of non-overlapping elements from all input streams, with
   // increasing order of priority based on input stream index.
   absl::StatusOr<std::list<T>> GetNonOverlappingElements(
@@ -274,6 +274,107 @@ TEST_F(AssociationDetectionCalculatorTest, DetectionAssocTestReverse) {
   EXPECT_THAT(assoc_rects[2], EqualsProto(det_2));
 }
 
+TEST_F(AssociationDetectionCalculatorTest, DetectionAssocTestGreedyMatching) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "AssociationDetectionCalculator"
+    input_stream: "input_vec_0"
+    input_stream: "input_vec_1"
+    input_stream: "input_vec_2"
+    output_stream: "output_vec"
+    options {
+      [mediapipe.AssociationCalculatorOptions.ext] {
+        min_similarity_threshold: 0.1
+        association_mode: GREEDY_MATCHING
+      }
+    }
+  )pb"));
+
+  // Input Stream 0: det_0, det_1, det_2.
+  auto input_vec_0 = absl::make_unique<std::vector<::mediapipe::Detection>>();
+  input_vec_0->push_back(det_0);
+  input_vec_0->push_back(det_1);
+  input_vec_0->push_back(det_2);
+  runner.MutableInputs()->Index(0).packets.push_back(
+      Adopt(input_vec_0.release()).At(Timestamp(1)));
+
+  // Input Stream 1: det_3, det_4.
+  auto input_vec_1 = absl::make_unique<std::vector<::mediapipe::Detection>>();
+  input_vec_1->push_back(det_3);
+  input_vec_1->push_back(det_4);
+  runner.MutableInputs()->Index(1).packets.push_back(
+      Adopt(input_vec_1.release()).At(Timestamp(1)));
+
+  // Input Stream 2: det_5.
+  auto input_vec_2 = absl::make_unique<std::vector<::mediapipe::Detection>>();
+  input_vec_2->push_back(det_5);
+  runner.MutableInputs()->Index(2).packets.push_back(
+      Adopt(input_vec_2.release()).At(Timestamp(1)));
+
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+  const std::vector<Packet>& output = runner.Outputs().Index(0).packets;
+  EXPECT_EQ(1, output.size());
+  const auto& assoc_rects =
+      output[0].Get<std::vector<::mediapipe::Detection>>();
+
+  // det_5 is kept first and suppresses det_3 and det_1. det_4 suppresses
+  // det_2. Unlike in the sequential mode, det_0 is kept: it only overlaps
+  // det_3, which is suppressed.
+  ASSERT_EQ(3, assoc_rects.size());
+  EXPECT_THAT(assoc_rects[0], EqualsProto(det_0));
+
+  // det_4 overlaps with det_2, so new id for det_4 is 2.
+  det_4.set_detection_id(2);
+  EXPECT_THAT(assoc_rects[1], EqualsProto(det_4));
+
+  // det_5 overlaps det_3 more than det_1, so new id for det_5 is 3.
+  det_5.set_detection_id(3);
+  EXPECT_THAT(assoc_rects[2], EqualsProto(det_5));
+}
+
+TEST_F(AssociationDetectionCalculatorTest,
+       DetectionAssocTestGreedyMatchingWithPrev) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+    calculator: "AssociationDetectionCalculator"
+    input_stream: "PREV:input_vec_0"
+    input_stream: "input_vec_1"
+    output_stream: "output_vec"
+    options {
+      [mediapipe.AssociationCalculatorOptions.ext] {
+        min_similarity_threshold: 0.1
+        association_mode: GREEDY_MATCHING
+      }
+    }
+  )pb"));
+
+  // Input Stream 0: det_3.
+  auto input_vec_0 = absl::make_unique<std::vector<::mediapipe::Detection>>();
+  input_vec_0->push_back(det_3);
+  runner.MutableInputs()
+      ->Get(runner.MutableInputs()->GetId("PREV", 0))
+      .packets.push_back(Adopt(input_vec_0.release()).At(Timestamp(1)));
+
+  // Input Stream 1: det_0, det_5.
+  auto input_vec_1 = absl::make_unique<std::vector<::mediapipe::Detection>>();
+  input_vec_1->push_back(det_0);
+  input_vec_1->push_back(det_5);
+  runner.MutableInputs()
+      ->Get(runner.MutableInputs()->GetId("", 0))
+      .packets.push_back(Adopt(input_vec_1.release()).At(Timestamp(1)));
+
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+  const std::vector<Packet>& output = runner.Outputs().Index(0).packets;
+  EXPECT_EQ(1, output.size());
+  const auto& assoc_rects =
+      output[0].Get<std::vector<::mediapipe::Detection>>();
+
+  // det_0 and det_5 both overlap with det_3, but det_3 is only matched with
+  // det_5, which overlaps it more. det_0 keeps its id.
+  ASSERT_EQ(2, assoc_rects.size());
+  EXPECT_THAT(assoc_rects[0], EqualsProto(det_0));
+  det_5.set_detection_id(3);
+  EXPECT_THAT(assoc_rects[1], EqualsProto(det_5));
+}
+
 class AssociationNormRectCalculatorTest : public ::testing::Test {
  protected:
   AssociationNormRectCalculatorTest() {
@@ -0,0 +1,172 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/calculators/util/detection_scheduler_calculator.pb.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+namespace api2 {
+
+namespace {
+
+// Returns the largest displacement, in rect sizes per second, between each
+// current rect and the closest previous rect. Returns infinity if there is no
+// previous rect to compare with.
+float ComputeMotion(const std::vector<NormalizedRect>& previous,
+                    const std::vector<NormalizedRect>& current,
+                    double elapsed_seconds) {
+  if (previous.empty() || elapsed_seconds <= 0.0) {
+    return std::numeric_limits<float>::infinity();
+  }
+  float motion = 0.0f;
+  for (const auto& rect : current) {
+    float closest = std::numeric_limits<float>::infinity();
+    for (const auto& previous_rect : previous) {
+      const float width = std::max(rect.width(), previous_rect.width());
+      const float height = std::max(rect.height(), previous_rect.height());
+      if (width <= 0.0f || height <= 0.0f) continue;
+      const float dx = (rect.x_center() - previous_rect.x_center()) / width;
+      const float dy = (rect.y_center() - previous_rect.y_center()) / height;
+      closest = std::min(closest, std::hypot(dx, dy));
+    }
+    motion = std::max(motion, closest);
+  }
+  return motion / elapsed_seconds;
+}
+
+int64_t SecondsToMicroseconds(float seconds) {
+  return std::llround(seconds * 1e6);
+}
+
+}  // namespace
+
+// Decides on every frame whether a detector needs to run, for graphs that
+// track objects by feeding landmark-derived rects back to the next frame and
+// only run the detector when objects are missing.
+//
+// Detection always runs when nothing is tracked. While fewer than
+// max_num_objects objects are tracked, it runs at an interval that shrinks
+// from max_detection_interval_seconds to min_detection_interval_seconds as the
+// tracked objects move faster, since fast motion makes new objects entering
+// the frame more likely. Once max_num_objects objects are tracked, it only runs
+// when max_tracking_age_seconds is exceeded. With default options this is
+// equivalent to checking that at least max_num_objects rects are tracked.
+//
+// Inputs:
+//   TICK - Any type.
+//     Drives the calculator; typically the input image.
+//   TRACKED_RECTS - std::vector<NormalizedRect> @Optional
+//     Rects tracked from the previous frame, typically the PREV_LOOP output of
+//     a PreviousLoopbackCalculator. Missing packets mean nothing is tracked.
+//
+// Outputs:
+//   SKIP_DETECTION - bool
+//     Whether detection can be skipped for this frame. Sent on every TICK.
+//
+// Example:
+// node {
+//   calculator: "DetectionSchedulerCalculator"
+//   input_stream: "TICK:image"
+//   input_stream: "TRACKED_RECTS:prev_hand_rects"
+//   output_stream: "SKIP_DETECTION:skip_hand_detection"
+//   options {
+//     [mediapipe.DetectionSchedulerCalculatorOptions.ext] {
+//       max_num_objects: 2
+//       min_detection_interval_seconds: 0.1
+//       max_detection_interval_seconds: 0.5
+//       max_tracking_age_seconds: 2
+//     }
+//   }
+// }
+class DetectionSchedulerCalculator : public Node {
+ public:
+  static constexpr Input<AnyType> kInTick{"TICK"};
+  static constexpr Input<std::vector<NormalizedRect>>::Optional
+      kInTrackedRects{"TRACKED_RECTS"};
+  static constexpr Output<bool> kOutSkipDetection{"SKIP_DETECTION"};
+
+  MEDIAPIPE_NODE_CONTRACT(kInTick, kInTrackedRects, kOutSkipDetection);
+
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<DetectionSchedulerCalculatorOptions>();
+    RET_CHECK_GT(options_.max_num_objects(), 0);
+    RET_CHECK_GE(options_.min_detection_interval_seconds(), 0.0f);
+    RET_CHECK_GE(options_.max_detection_interval_seconds(),
+                 options_.min_detection_interval_seconds());
+    RET_CHECK_GT(options_.max_motion(), 0.0f);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const int64_t now = cc->InputTimestamp().Microseconds();
+    std::vector<NormalizedRect> tracked_rects;
+    if (kInTrackedRects(cc).IsConnected() && !kInTrackedRects(cc).IsEmpty()) {
+      tracked_rects = *kInTrackedRects(cc);
+    }
+
+    const int num_tracked = tracked_rects.size();
+    const int64_t since_detection = has_detected_
+                                        ? now - last_detection_us_
+                                        : std::numeric_limits<int64_t>::max();
+    bool detect;
+    if (num_tracked == 0) {
+      detect = true;
+    } else if (num_tracked >= options_.max_num_objects()) {
+      detect = options_.max_tracking_age_seconds() > 0.0f &&
+               since_detection >=
+                   SecondsToMicroseconds(options_.max_tracking_age_seconds());
+    } else {
+      const float motion = ComputeMotion(
+          previous_rects_, tracked_rects, (now - previous_us_) * 1e-6);
+      const float t = std::min(motion / options_.max_motion(), 1.0f);
+      const float interval =
+          options_.max_detection_interval_seconds() -
+          t * (options_.max_detection_interval_seconds() -
+               options_.min_detection_interval_seconds());
+      detect = since_detection >= SecondsToMicroseconds(interval);
+    }
+
+    if (detect) {
+      has_detected_ = true;
+      last_detection_us_ = now;
+    }
+    previous_rects_ = std::move(tracked_rects);
+    previous_us_ = now;
+    kOutSkipDetection(cc).Send(!detect);
+    return absl::OkStatus();
+  }
+
+ private:
+  DetectionSchedulerCalculatorOptions options_;
+  std::vector<NormalizedRect> previous_rects_;
+  int64_t previous_us_ = 0;
+  bool has_detected_ = false;
+  int64_t last_detection_us_ = 0;
+};
+MEDIAPIPE_REGISTER_NODE(DetectionSchedulerCalculator);
+
+}  // namespace api2
+}  // namespace mediapipe
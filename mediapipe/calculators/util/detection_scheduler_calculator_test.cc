@@ -0,0 +1,150 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kTickTag[] = "TICK";
+constexpr char kTrackedRectsTag[] = "TRACKED_RECTS";
+constexpr char kSkipDetectionTag[] = "SKIP_DETECTION";
+
+constexpr int64_t kFrameIntervalUs = 100000;
+
+CalculatorGraphConfig::Node MakeNodeConfig(const std::string& options) {
+  return ParseTextProtoOrDie<CalculatorGraphConfig::Node>(absl::StrCat(R"pb(
+    calculator: "DetectionSchedulerCalculator"
+    input_stream: "TICK:tick"
+    input_stream: "TRACKED_RECTS:tracked_rects"
+    output_stream: "SKIP_DETECTION:skip_detection"
+    options {
+      [mediapipe.DetectionSchedulerCalculatorOptions.ext] {)pb",
+                                                                 options,
+                                                                 "}}"));
+}
+
+NormalizedRect MakeRect(float x_center, float y_center) {
+  NormalizedRect rect;
+  rect.set_x_center(x_center);
+  rect.set_y_center(y_center);
+  rect.set_width(0.2f);
+  rect.set_height(0.2f);
+  return rect;
+}
+
+// Adds a frame at index `frame`, with `rects` as the tracked rects unless
+// nullptr.
+void AddFrame(int frame, const std::vector<NormalizedRect>* rects,
+              CalculatorRunner* runner) {
+  const Timestamp timestamp(frame * kFrameIntervalUs);
+  runner->MutableInputs()->Tag(kTickTag).packets.push_back(
+      MakePacket<int>(frame).At(timestamp));
+  if (rects != nullptr) {
+    runner->MutableInputs()->Tag(kTrackedRectsTag).packets.push_back(
+        MakePacket<std::vector<NormalizedRect>>(*rects).At(timestamp));
+  }
+}
+
+std::vector<bool> GetSkipDecisions(const CalculatorRunner& runner) {
+  std::vector<bool> skip;
+  for (const Packet& packet : runner.Outputs().Tag(kSkipDetectionTag).packets) {
+    skip.push_back(packet.Get<bool>());
+  }
+  return skip;
+}
+
+TEST(DetectionSchedulerCalculatorTest, DefaultsSkipOnlyWhenAllTracked) {
+  CalculatorRunner runner(MakeNodeConfig("max_num_objects: 2"));
+  const std::vector<NormalizedRect> one = {MakeRect(0.5f, 0.5f)};
+  const std::vector<NormalizedRect> two = {MakeRect(0.3f, 0.5f),
+                                           MakeRect(0.7f, 0.5f)};
+  AddFrame(0, nullptr, &runner);
+  AddFrame(1, &one, &runner);
+  AddFrame(2, &two, &runner);
+  AddFrame(3, &two, &runner);
+  AddFrame(4, nullptr, &runner);
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_THAT(GetSkipDecisions(runner),
+              testing::ElementsAre(false, false, true, true, false));
+}
+
+TEST(DetectionSchedulerCalculatorTest, StillObjectsUseMaxInterval) {
+  CalculatorRunner runner(MakeNodeConfig(R"pb(
+    max_num_objects: 2
+    min_detection_interval_seconds: 0.1
+    max_detection_interval_seconds: 0.3
+  )pb"));
+  const std::vector<NormalizedRect> one = {MakeRect(0.5f, 0.5f)};
+  AddFrame(0, nullptr, &runner);
+  for (int frame = 1; frame <= 6; ++frame) {
+    AddFrame(frame, &one, &runner);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  // Frame 1 has no previous rects to measure motion against, so it uses the
+  // min interval. After that, detection runs every 3 frames.
+  EXPECT_THAT(GetSkipDecisions(runner),
+              testing::ElementsAre(false, false, true, true, false, true,
+                                   true));
+}
+
+TEST(DetectionSchedulerCalculatorTest, MovingObjectsUseMinInterval) {
+  CalculatorRunner runner(MakeNodeConfig(R"pb(
+    max_num_objects: 2
+    min_detection_interval_seconds: 0.1
+    max_detection_interval_seconds: 0.3
+    max_motion: 1.0
+  )pb"));
+  AddFrame(0, nullptr, &runner);
+  for (int frame = 1; frame <= 4; ++frame) {
+    // Moves by half a rect size every 100ms, i.e. 5 rect sizes per second.
+    const std::vector<NormalizedRect> one = {MakeRect(0.1f * frame, 0.5f)};
+    AddFrame(frame, &one, &runner);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_THAT(GetSkipDecisions(runner),
+              testing::ElementsAre(false, false, false, false, false));
+}
+
+TEST(DetectionSchedulerCalculatorTest, MaxTrackingAgeForcesDetection) {
+  CalculatorRunner runner(MakeNodeConfig(R"pb(
+    max_num_objects: 1 max_tracking_age_seconds: 0.2
+  )pb"));
+  const std::vector<NormalizedRect> one = {MakeRect(0.5f, 0.5f)};
+  AddFrame(0, nullptr, &runner);
+  for (int frame = 1; frame <= 4; ++frame) {
+    AddFrame(frame, &one, &runner);
+  }
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_THAT(GetSkipDecisions(runner),
+              testing::ElementsAre(false, true, false, true, false));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -13,10 +13,12 @@
 // limitations under the License.
 
 #include <cmath>
+#include <memory>
 #include <vector>
 
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/port/ret_check.h"
 
 namespace mediapipe {
@@ -35,16 +37,17 @@ constexpr char kLetterboxPaddingTag[] = "LETTERBOX_PADDING";
 // corresponding input image before letterboxing.
 //
 // Input:
-//   LANDMARKS: A NormalizedLandmarkList representing landmarks on an
-//   letterboxed image.
+//   LANDMARKS: A NormalizedLandmarkList or LandmarkArray representing landmarks
+//   on an letterboxed image.
 //
 //   LETTERBOX_PADDING: An std::array<float, 4> representing the letterbox
 //   padding from the 4 sides ([left, top, right, bottom]) of the letterboxed
 //   image, normalized to [0.f, 1.f] by the letterboxed image dimensions.
 //
 // Output:
-//   LANDMARKS: An NormalizedLandmarkList proto representing landmarks with
-//   their locations adjusted to the letterbox-removed (non-padded) image.
+//   LANDMARKS: An NormalizedLandmarkList proto or LandmarkArray, matching the
+//   input, representing landmarks with their locations adjusted to the
+//   letterbox-removed (non-padded) image.
 //
 // Usage example:
 // node {
@@ -75,13 +78,14 @@ class LandmarkLetterboxRemovalCalculator : public CalculatorBase {
 
     for (CollectionItemId id = cc->Inputs().BeginId(kLandmarksTag);
          id != cc->Inputs().EndId(kLandmarksTag); ++id) {
-      cc->Inputs().Get(id).Set<NormalizedLandmarkList>();
+      cc->Inputs().Get(id).SetOneOf<NormalizedLandmarkList, LandmarkArray>();
     }
     cc->Inputs().Tag(kLetterboxPaddingTag).Set<std::array<float, 4>>();
 
+    CollectionItemId input_id = cc->Inputs().BeginId(kLandmarksTag);
     for (CollectionItemId id = cc->Outputs().BeginId(kLandmarksTag);
-         id != cc->Outputs().EndId(kLandmarksTag); ++id) {
-      cc->Outputs().Get(id).Set<NormalizedLandmarkList>();
+         id != cc->Outputs().EndId(kLandmarksTag); ++id, ++input_id) {
+      cc->Outputs().Get(id).SetSameAs(&cc->Inputs().Get(input_id));
     }
 
     return absl::OkStatus();
@@ -114,6 +118,27 @@ class LandmarkLetterboxRemovalCalculator : public CalculatorBase {
         continue;
       }
 
+      if (input_packet.Value().ValidateAsType<LandmarkArray>().ok()) {
+        auto output_landmarks = std::make_unique<LandmarkArray>(
+            input_packet.Get<LandmarkArray>());
+        const int n = output_landmarks->size();
+        float* x = output_landmarks->mutable_x().data();
+        float* y = output_landmarks->mutable_y().data();
+        float* z = output_landmarks->mutable_z().data();
+        for (int i = 0; i < n; ++i) {
+          x[i] = (x[i] - left) / (1.0f - left_and_right);
+        }
+        for (int i = 0; i < n; ++i) {
+          y[i] = (y[i] - top) / (1.0f - top_and_bottom);
+        }
+        for (int i = 0; i < n; ++i) {
+          z[i] = z[i] / (1.0f - left_and_right);  // Scale Z coordinate as X.
+        }
+        cc->Outputs().Get(output_id).Add(output_landmarks.release(),
+                                         cc->InputTimestamp());
+        continue;
+      }
+
       const NormalizedLandmarkList& input_landmarks =
           input_packet.Get<NormalizedLandmarkList>();
       NormalizedLandmarkList output_landmarks;
@@ -15,6 +15,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
@@ -113,4 +114,44 @@ TEST(LandmarkLetterboxRemovalCalculatorTest, PaddingTopBottom) {
   EXPECT_THAT(output_landmarks.landmark(2).y(), testing::FloatNear(1.0f, 1e-5));
 }
 
+TEST(LandmarkLetterboxRemovalCalculatorTest, LandmarkArray) {
+  CalculatorRunner runner(GetDefaultNode());
+
+  auto landmarks = absl::make_unique<LandmarkArray>(2);
+  landmarks->mutable_x()[0] = 0.5f;
+  landmarks->mutable_y()[0] = 0.5f;
+  landmarks->mutable_z()[0] = 0.5f;
+  landmarks->mutable_x()[1] = 0.2f;
+  landmarks->mutable_y()[1] = 0.2f;
+  landmarks->mutable_presence()[1] = 0.9f;
+  landmarks->set_has_presence(true);
+  runner.MutableInputs()
+      ->Tag(kLandmarksTag)
+      .packets.push_back(
+          Adopt(landmarks.release()).At(Timestamp::PostStream()));
+
+  auto padding = absl::make_unique<std::array<float, 4>>(
+      std::array<float, 4>{0.2f, 0.2f, 0.3f, 0.3f});
+  runner.MutableInputs()
+      ->Tag(kLetterboxPaddingTag)
+      .packets.push_back(Adopt(padding.release()).At(Timestamp::PostStream()));
+
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+  const std::vector<Packet>& output =
+      runner.Outputs().Tag(kLandmarksTag).packets;
+  ASSERT_EQ(1, output.size());
+  const auto& output_landmarks = output[0].Get<LandmarkArray>();
+
+  ASSERT_EQ(output_landmarks.size(), 2);
+  EXPECT_THAT(output_landmarks.x(), testing::ElementsAre(
+                                        testing::FloatNear(0.6f, 1e-5),
+                                        testing::FloatNear(0.0f, 1e-5)));
+  EXPECT_THAT(output_landmarks.y(), testing::ElementsAre(
+                                        testing::FloatNear(0.6f, 1e-5),
+                                        testing::FloatNear(0.0f, 1e-5)));
+  EXPECT_THAT(output_landmarks.z()[0], testing::FloatNear(1.0f, 1e-5));
+  EXPECT_TRUE(output_landmarks.has_presence());
+  EXPECT_FLOAT_EQ(output_landmarks.presence()[1], 0.9f);
+}
+
 }  // namespace mediapipe
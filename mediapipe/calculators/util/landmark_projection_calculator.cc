@@ -14,7 +14,7 @@
 
 #include <array>
 #include <cmath>
-#include <functional>
+#include <memory>
 #include <utility>
 
 #include "absl/log/absl_log.h"
@@ -24,6 +24,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/collection_item_id.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/port/ret_check.h"
 
@@ -42,7 +43,7 @@ constexpr char kImageDimensionsTag[] = "IMAGE_DIMENSIONS";
 
 // Projects normalized landmarks to its original coordinates.
 // Input:
-//   NORM_LANDMARKS - NormalizedLandmarkList
+//   NORM_LANDMARKS - NormalizedLandmarkList or LandmarkArray
 //     Represents landmarks in a normalized rectangle if NORM_RECT is specified
 //     or landmarks that should be projected using PROJECTION_MATRIX if
 //     specified. (Prefer using PROJECTION_MATRIX as it eliminates need of
@@ -65,8 +66,8 @@ constexpr char kImageDimensionsTag[] = "IMAGE_DIMENSIONS";
 //     the normalized region of interest used during landmarks detection.
 //
 // Output:
-//   NORM_LANDMARKS - NormalizedLandmarkList
-//     Landmarks with their locations adjusted according to the inputs.
+//   NORM_LANDMARKS - NormalizedLandmarkList or LandmarkArray, matching the
+//     input. Landmarks with their locations adjusted according to the inputs.
 //
 // Usage example:
 // node {
@@ -112,7 +113,7 @@ class LandmarkProjectionCalculator : public CalculatorBase {
 
     for (CollectionItemId id = cc->Inputs().BeginId(kLandmarksTag);
          id != cc->Inputs().EndId(kLandmarksTag); ++id) {
-      cc->Inputs().Get(id).Set<NormalizedLandmarkList>();
+      cc->Inputs().Get(id).SetOneOf<NormalizedLandmarkList, LandmarkArray>();
     }
     RET_CHECK(cc->Inputs().HasTag(kRectTag) ^
               cc->Inputs().HasTag(kProjectionMatrix))
@@ -129,9 +130,10 @@ class LandmarkProjectionCalculator : public CalculatorBase {
       cc->Inputs().Tag(kProjectionMatrix).Set<std::array<float, 16>>();
     }
 
+    CollectionItemId input_id = cc->Inputs().BeginId(kLandmarksTag);
     for (CollectionItemId id = cc->Outputs().BeginId(kLandmarksTag);
-         id != cc->Outputs().EndId(kLandmarksTag); ++id) {
-      cc->Outputs().Get(id).Set<NormalizedLandmarkList>();
+         id != cc->Outputs().EndId(kLandmarksTag); ++id, ++input_id) {
+      cc->Outputs().Get(id).SetSameAs(&cc->Inputs().Get(input_id));
     }
 
     return absl::OkStatus();
@@ -143,13 +145,11 @@ class LandmarkProjectionCalculator : public CalculatorBase {
     return absl::OkStatus();
   }
 
-  static void ProjectXY(const NormalizedLandmark& lm,
-                        const std::array<float, 16>& matrix,
-                        NormalizedLandmark* out) {
-    out->set_x(lm.x() * matrix[0] + lm.y() * matrix[1] + lm.z() * matrix[2] +
-               matrix[3]);
-    out->set_y(lm.x() * matrix[4] + lm.y() * matrix[5] + lm.z() * matrix[6] +
-               matrix[7]);
+  static void ProjectXY(float x, float y, float z,
+                        const std::array<float, 16>& matrix, float* out_x,
+                        float* out_y) {
+    *out_x = x * matrix[0] + y * matrix[1] + z * matrix[2] + matrix[3];
+    *out_y = x * matrix[4] + y * matrix[5] + z * matrix[6] + matrix[7];
   }
 
   /**
@@ -159,23 +159,66 @@ class LandmarkProjectionCalculator : public CalculatorBase {
    * 2. Calculate length of the projected segment.
    */
   static float CalculateZScale(const std::array<float, 16>& matrix) {
-    NormalizedLandmark a;
-    a.set_x(0.0f);
-    a.set_y(0.0f);
-    NormalizedLandmark b;
-    b.set_x(1.0f);
-    b.set_y(0.0f);
-    NormalizedLandmark a_projected;
-    ProjectXY(a, matrix, &a_projected);
-    NormalizedLandmark b_projected;
-    ProjectXY(b, matrix, &b_projected);
-    return std::sqrt(std::pow(b_projected.x() - a_projected.x(), 2) +
-                     std::pow(b_projected.y() - a_projected.y(), 2));
+    float a_x, a_y;
+    ProjectXY(0.0f, 0.0f, 0.0f, matrix, &a_x, &a_y);
+    float b_x, b_y;
+    ProjectXY(1.0f, 0.0f, 0.0f, matrix, &b_x, &b_y);
+    return std::sqrt(std::pow(b_x - a_x, 2) + std::pow(b_y - a_y, 2));
+  }
+
+  // Projects the landmarks of every non-empty input with `project`, called as
+  // project(x, y, z, &new_x, &new_y, &new_z). Visibility and presence are
+  // passed through. The projection is a template argument, so that it is
+  // inlined in the loop over a LandmarkArray.
+  template <typename ProjectFn>
+  static void ProjectLandmarks(CalculatorContext* cc,
+                               const ProjectFn& project) {
+    CollectionItemId input_id = cc->Inputs().BeginId(kLandmarksTag);
+    CollectionItemId output_id = cc->Outputs().BeginId(kLandmarksTag);
+    // Number of inputs and outputs is the same according to the contract.
+    for (; input_id != cc->Inputs().EndId(kLandmarksTag);
+         ++input_id, ++output_id) {
+      const auto& input_packet = cc->Inputs().Get(input_id);
+      if (input_packet.IsEmpty()) {
+        continue;
+      }
+
+      if (input_packet.Value().ValidateAsType<LandmarkArray>().ok()) {
+        auto output_landmarks = std::make_unique<LandmarkArray>(
+            input_packet.Get<LandmarkArray>());
+        const int n = output_landmarks->size();
+        float* x = output_landmarks->mutable_x().data();
+        float* y = output_landmarks->mutable_y().data();
+        float* z = output_landmarks->mutable_z().data();
+        for (int i = 0; i < n; ++i) {
+          project(x[i], y[i], z[i], &x[i], &y[i], &z[i]);
+        }
+        cc->Outputs().Get(output_id).Add(output_landmarks.release(),
+                                         cc->InputTimestamp());
+        continue;
+      }
+
+      const auto& input_landmarks = input_packet.Get<NormalizedLandmarkList>();
+      NormalizedLandmarkList output_landmarks;
+      for (int i = 0; i < input_landmarks.landmark_size(); ++i) {
+        const NormalizedLandmark& landmark = input_landmarks.landmark(i);
+        NormalizedLandmark* new_landmark = output_landmarks.add_landmark();
+        *new_landmark = landmark;
+        float new_x, new_y, new_z;
+        project(landmark.x(), landmark.y(), landmark.z(), &new_x, &new_y,
+                &new_z);
+        new_landmark->set_x(new_x);
+        new_landmark->set_y(new_y);
+        new_landmark->set_z(new_z);
+      }
+
+      cc->Outputs().Get(output_id).AddPacket(
+          MakePacket<NormalizedLandmarkList>(std::move(output_landmarks))
+              .At(cc->InputTimestamp()));
+    }
   }
 
   absl::Status Process(CalculatorContext* cc) override {
-    std::function<void(const NormalizedLandmark&, NormalizedLandmark*)>
-        project_fn;
     std::array<float, 16> project_mat;
     const bool has_rect = cc->Inputs().HasTag(kRectTag);
     const bool has_image_dims = cc->Inputs().HasTag(kImageDimensionsTag);
@@ -190,25 +233,22 @@ class LandmarkProjectionCalculator : public CalculatorBase {
       const auto& input_rect = cc->Inputs().Tag(kRectTag).Get<NormalizedRect>();
       const auto& options =
           cc->Options<mediapipe::LandmarkProjectionCalculatorOptions>();
-      project_fn = [&input_rect, &options](const NormalizedLandmark& landmark,
-                                           NormalizedLandmark* new_landmark) {
-        const float x = landmark.x() - 0.5f;
-        const float y = landmark.y() - 0.5f;
-        const float angle =
-            options.ignore_rotation() ? 0 : input_rect.rotation();
-        float new_x = std::cos(angle) * x - std::sin(angle) * y;
-        float new_y = std::sin(angle) * x + std::cos(angle) * y;
-
-        new_x = new_x * input_rect.width() + input_rect.x_center();
-        new_y = new_y * input_rect.height() + input_rect.y_center();
-        const float new_z =
-            landmark.z() * input_rect.width();  // Scale Z coordinate as X.
-
-        *new_landmark = landmark;
-        new_landmark->set_x(new_x);
-        new_landmark->set_y(new_y);
-        new_landmark->set_z(new_z);
-      };
+      const float angle = options.ignore_rotation() ? 0 : input_rect.rotation();
+      const float cos_angle = std::cos(angle);
+      const float sin_angle = std::sin(angle);
+      const float width = input_rect.width();
+      const float height = input_rect.height();
+      const float x_center = input_rect.x_center();
+      const float y_center = input_rect.y_center();
+      ProjectLandmarks(cc, [=](float x, float y, float z, float* new_x,
+                               float* new_y, float* new_z) {
+        x -= 0.5f;
+        y -= 0.5f;
+        *new_x = (cos_angle * x - sin_angle * y) * width + x_center;
+        *new_y = (sin_angle * x + cos_angle * y) * height + y_center;
+        *new_z = z * width;  // Scale Z coordinate as X.
+      });
+      return absl::OkStatus();
     } else if (has_rect && has_image_dims) {
       if (cc->Inputs().Tag(kRectTag).IsEmpty() ||
           cc->Inputs().Tag(kImageDimensionsTag).IsEmpty()) {
@@ -229,52 +269,23 @@ class LandmarkProjectionCalculator : public CalculatorBase {
       GetRotatedSubRectToRectTransformMatrix(
           rotated_rect, image_dimensions.first, image_dimensions.second,
           /*flip_horizontaly=*/false, &project_mat);
-      const float z_scale = CalculateZScale(project_mat);
-      project_fn = [&project_mat, z_scale](const NormalizedLandmark& lm,
-                                           NormalizedLandmark* new_landmark) {
-        *new_landmark = lm;
-        ProjectXY(lm, project_mat, new_landmark);
-        new_landmark->set_z(z_scale * lm.z());
-      };
     } else if (cc->Inputs().HasTag(kProjectionMatrix)) {
       if (cc->Inputs().Tag(kProjectionMatrix).IsEmpty()) {
         return absl::OkStatus();
       }
       project_mat =
           cc->Inputs().Tag(kProjectionMatrix).Get<std::array<float, 16>>();
-      const float z_scale = CalculateZScale(project_mat);
-      project_fn = [&project_mat, z_scale](const NormalizedLandmark& lm,
-                                           NormalizedLandmark* new_landmark) {
-        *new_landmark = lm;
-        ProjectXY(lm, project_mat, new_landmark);
-        new_landmark->set_z(z_scale * lm.z());
-      };
     } else {
       return absl::InternalError("Either rect or matrix must be specified.");
     }
 
-    CollectionItemId input_id = cc->Inputs().BeginId(kLandmarksTag);
-    CollectionItemId output_id = cc->Outputs().BeginId(kLandmarksTag);
-    // Number of inputs and outputs is the same according to the contract.
-    for (; input_id != cc->Inputs().EndId(kLandmarksTag);
-         ++input_id, ++output_id) {
-      const auto& input_packet = cc->Inputs().Get(input_id);
-      if (input_packet.IsEmpty()) {
-        continue;
-      }
-
-      const auto& input_landmarks = input_packet.Get<NormalizedLandmarkList>();
-      NormalizedLandmarkList output_landmarks;
-      for (int i = 0; i < input_landmarks.landmark_size(); ++i) {
-        const NormalizedLandmark& landmark = input_landmarks.landmark(i);
-        NormalizedLandmark* new_landmark = output_landmarks.add_landmark();
-        project_fn(landmark, new_landmark);
-      }
-
-      cc->Outputs().Get(output_id).AddPacket(
-          MakePacket<NormalizedLandmarkList>(std::move(output_landmarks))
-              .At(cc->InputTimestamp()));
-    }
+    const float z_scale = CalculateZScale(project_mat);
+    ProjectLandmarks(cc, [&project_mat, z_scale](float x, float y, float z,
+                                                 float* new_x, float* new_y,
+                                                 float* new_z) {
+      ProjectXY(x, y, z, project_mat, new_x, new_y);
+      *new_z = z_scale * z;
+    });
     return absl::OkStatus();
   }
 };
@@ -7,6 +7,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -244,6 +245,55 @@ TEST(LandmarkProjectionCalculatorTest, ProjectingWithIdentityMatrix) {
       )pb")));
 }
 
+TEST(LandmarkProjectionCalculatorTest, ProjectingLandmarkArrayWithMatrix) {
+  const auto landmarks =
+      ParseTextProtoOrDie<mediapipe::NormalizedLandmarkList>(R"pb(
+        landmark { x: 10, y: 20, z: -0.5 presence: 0.5 }
+        landmark { x: 1, y: 2, z: 3 presence: 0.25 }
+      )pb");
+  // clang-format off
+  std::array<float, 16> matrix = {
+    2.0f, 0.0f, 0.0f, 1.0f,
+    0.0f, 3.0f, 0.0f, 2.0f,
+    0.0f, 0.0f, 1.0f, 0.0f,
+    0.0f, 0.0f, 0.0f, 1.0f,
+  };
+  // clang-format on
+  mediapipe::CalculatorRunner runner(
+      ParseTextProtoOrDie<mediapipe::CalculatorGraphConfig::Node>(R"pb(
+        calculator: "LandmarkProjectionCalculator"
+        input_stream: "NORM_LANDMARKS:landmarks"
+        input_stream: "PROJECTION_MATRIX:matrix"
+        output_stream: "NORM_LANDMARKS:projected_landmarks"
+      )pb"));
+  runner.MutableInputs()
+      ->Tag(kNormLandmarksTag)
+      .packets.push_back(
+          MakePacket<LandmarkArray>(LandmarkArrayFromProto(landmarks))
+              .At(Timestamp(1)));
+  runner.MutableInputs()
+      ->Tag(kProjectionMatrixTag)
+      .packets.push_back(
+          MakePacket<std::array<float, 16>>(matrix).At(Timestamp(1)));
+
+  MP_ASSERT_OK(runner.Run());
+  const auto& output_packets = runner.Outputs().Tag(kNormLandmarksTag).packets;
+  ASSERT_EQ(output_packets.size(), 1);
+  mediapipe::NormalizedLandmarkList result;
+  LandmarkArrayToProto(output_packets[0].Get<LandmarkArray>(), &result);
+
+  // Same projection as for the proto input.
+  auto expected = RunCalculator(landmarks, matrix);
+  MP_ASSERT_OK(expected);
+  EXPECT_THAT(result, EqualsProto(expected.value()));
+  EXPECT_THAT(
+      result,
+      EqualsProto(ParseTextProtoOrDie<mediapipe::NormalizedLandmarkList>(R"pb(
+        landmark { x: 21, y: 62, z: -1 presence: 0.5 }
+        landmark { x: 3, y: 8, z: 6 presence: 0.25 }
+      )pb")));
+}
+
 TEST(LandmarkProjectionCalculatorTest, ProjectingWithCroppedRectMatrix) {
   constexpr int kRectWidth = 1280;
   constexpr int kRectHeight = 720;
@@ -61,18 +61,6 @@ absl::StatusOr<int> GetNumberOfRefinedLandmarks(
   return n_idxs;
 }
 
-void RefineXY(const proto_ns::RepeatedField<int>& indexes_mapping,
-              const NormalizedLandmarkList& landmarks,
-              NormalizedLandmarkList* refined_landmarks) {
-  for (int i = 0; i < landmarks.landmark_size(); ++i) {
-    const auto& landmark = landmarks.landmark(i);
-    auto* refined_landmark =
-        refined_landmarks->mutable_landmark(indexes_mapping.Get(i));
-    refined_landmark->set_x(landmark.x());
-    refined_landmark->set_y(landmark.y());
-  }
-}
-
 float GetZAverage(const NormalizedLandmarkList& landmarks,
                   const proto_ns::RepeatedField<int>& indexes) {
   double z_sum = 0;
@@ -82,25 +70,43 @@ float GetZAverage(const NormalizedLandmarkList& landmarks,
   return z_sum / indexes.size();
 }
 
-void RefineZ(
+// Refines X, Y and Z of the landmarks at `indexes_mapping` in a single pass,
+// so that each refined landmark is looked up only once.
+void Refine(
     const proto_ns::RepeatedField<int>& indexes_mapping,
     const LandmarksRefinementCalculatorOptions::ZRefinement& z_refinement,
     const NormalizedLandmarkList& landmarks,
     NormalizedLandmarkList* refined_landmarks) {
+  const int* mapping = indexes_mapping.data();
+  const int n = landmarks.landmark_size();
+  auto* refined = refined_landmarks->mutable_landmark();
   if (z_refinement.has_none()) {
-    // Do nothing and keep Z that is already in refined landmarks.
+    // Keep Z that is already in refined landmarks.
+    for (int i = 0; i < n; ++i) {
+      const auto& landmark = landmarks.landmark(i);
+      auto* refined_landmark = refined->Mutable(mapping[i]);
+      refined_landmark->set_x(landmark.x());
+      refined_landmark->set_y(landmark.y());
+    }
   } else if (z_refinement.has_copy()) {
-    for (int i = 0; i < landmarks.landmark_size(); ++i) {
-      refined_landmarks->mutable_landmark(indexes_mapping.Get(i))
-          ->set_z(landmarks.landmark(i).z());
+    for (int i = 0; i < n; ++i) {
+      const auto& landmark = landmarks.landmark(i);
+      auto* refined_landmark = refined->Mutable(mapping[i]);
+      refined_landmark->set_x(landmark.x());
+      refined_landmark->set_y(landmark.y());
+      refined_landmark->set_z(landmark.z());
     }
   } else if (z_refinement.has_assign_average()) {
+    // The average is taken over Z refined by the preceding refinements.
     const float z_average =
         GetZAverage(*refined_landmarks,
                     z_refinement.assign_average().indexes_for_average());
-    for (int i = 0; i < indexes_mapping.size(); ++i) {
-      refined_landmarks->mutable_landmark(indexes_mapping.Get(i))
-          ->set_z(z_average);
+    for (int i = 0; i < n; ++i) {
+      const auto& landmark = landmarks.landmark(i);
+      auto* refined_landmark = refined->Mutable(mapping[i]);
+      refined_landmark->set_x(landmark.x());
+      refined_landmark->set_y(landmark.y());
+      refined_landmark->set_z(z_average);
     }
   } else {
     ABSL_CHECK(false)
@@ -156,10 +162,12 @@ class LandmarksRefinementCalculatorImpl
       }
     }
 
-    // Initialize refined landmarks list.
+    // Initialize refined landmarks list in a single allocation.
     auto refined_landmarks = absl::make_unique<NormalizedLandmarkList>();
+    auto* refined = refined_landmarks->mutable_landmark();
+    refined->Reserve(n_refined_landmarks_);
     for (int i = 0; i < n_refined_landmarks_; ++i) {
-      refined_landmarks->add_landmark();
+      refined->Add();
     }
 
     // Apply input landmarks to outpu refined landmarks in provided order.
@@ -173,13 +181,9 @@ class LandmarksRefinementCalculatorImpl
           << " refinement landmarks while mapping has "
           << refinement.indexes_mapping_size();
 
-      // Refine X and Y.
-      RefineXY(refinement.indexes_mapping(), landmarks,
-               refined_landmarks.get());
-
-      // Refine Z.
-      RefineZ(refinement.indexes_mapping(), refinement.z_refinement(),
-              landmarks, refined_landmarks.get());
+      // Refine X, Y and Z.
+      Refine(refinement.indexes_mapping(), refinement.z_refinement(),
+             landmarks, refined_landmarks.get());
 
       // Visibility and presence are not currently refined and are left as `0`.
     }
@@ -0,0 +1,129 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr char kLandmarksTag[] = "LANDMARKS";
+constexpr char kRefinedLandmarksTag[] = "REFINED_LANDMARKS";
+
+constexpr char kNodeConfig[] = R"pb(
+  calculator: "LandmarksRefinementCalculator"
+  input_stream: "LANDMARKS:0:mesh_landmarks"
+  input_stream: "LANDMARKS:1:eye_landmarks"
+  input_stream: "LANDMARKS:2:iris_landmarks"
+  output_stream: "REFINED_LANDMARKS:refined_landmarks"
+  options: {
+    [mediapipe.LandmarksRefinementCalculatorOptions.ext] {
+      refinement: {
+        indexes_mapping: [ 0, 1, 2 ]
+        z_refinement: { copy {} }
+      }
+      refinement: {
+        indexes_mapping: [ 2, 1 ]
+        z_refinement: { none {} }
+      }
+      refinement: {
+        indexes_mapping: [ 3 ]
+        z_refinement: {
+          assign_average: { indexes_for_average: [ 0, 1 ] }
+        }
+      }
+    }
+  }
+)pb";
+
+void AddLandmarks(CalculatorRunner* runner, int index, const char* landmarks) {
+  runner->MutableInputs()
+      ->Get(kLandmarksTag, index)
+      .packets.push_back(
+          MakePacket<NormalizedLandmarkList>(
+              ParseTextProtoOrDie<NormalizedLandmarkList>(landmarks))
+              .At(Timestamp(0)));
+}
+
+TEST(LandmarksRefinementCalculatorTest, RefinesLandmarksInProvidedOrder) {
+  CalculatorRunner runner(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kNodeConfig));
+  AddLandmarks(&runner, 0, R"pb(
+    landmark { x: 0.1 y: 0.1 z: 1 visibility: 0.5 }
+    landmark { x: 0.2 y: 0.2 z: 2 }
+    landmark { x: 0.3 y: 0.3 z: 3 }
+  )pb");
+  AddLandmarks(&runner, 1, R"pb(
+    landmark { x: 0.5 y: 0.6 z: 10 }
+    landmark { x: 0.7 y: 0.8 z: 20 }
+  )pb");
+  AddLandmarks(&runner, 2, R"pb(
+    landmark { x: 0.9 y: 0.4 z: 30 }
+  )pb");
+  MP_ASSERT_OK(runner.Run());
+
+  const auto& packets = runner.Outputs().Tag(kRefinedLandmarksTag).packets;
+  ASSERT_EQ(packets.size(), 1);
+  EXPECT_THAT(packets[0].Get<NormalizedLandmarkList>(),
+              EqualsProto(ParseTextProtoOrDie<NormalizedLandmarkList>(R"pb(
+                landmark { x: 0.1 y: 0.1 z: 1 }
+                landmark { x: 0.7 y: 0.8 z: 2 }
+                landmark { x: 0.5 y: 0.6 z: 3 }
+                landmark { x: 0.9 y: 0.4 z: 1.5 }
+              )pb")));
+}
+
+TEST(LandmarksRefinementCalculatorTest, SkipsRefinementIfLandmarksAreMissing) {
+  CalculatorRunner runner(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kNodeConfig));
+  AddLandmarks(&runner, 0, R"pb(
+    landmark { x: 0.1 y: 0.1 z: 1 }
+    landmark { x: 0.2 y: 0.2 z: 2 }
+    landmark { x: 0.3 y: 0.3 z: 3 }
+  )pb");
+  AddLandmarks(&runner, 2, R"pb(
+    landmark { x: 0.9 y: 0.4 z: 30 }
+  )pb");
+  MP_ASSERT_OK(runner.Run());
+
+  EXPECT_TRUE(runner.Outputs().Tag(kRefinedLandmarksTag).packets.empty());
+}
+
+TEST(LandmarksRefinementCalculatorTest, FailsOnMappingSizeMismatch) {
+  CalculatorRunner runner(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kNodeConfig));
+  AddLandmarks(&runner, 0, R"pb(
+    landmark { x: 0.1 y: 0.1 z: 1 }
+  )pb");
+  AddLandmarks(&runner, 1, R"pb(
+    landmark { x: 0.5 y: 0.6 z: 10 }
+    landmark { x: 0.7 y: 0.8 z: 20 }
+  )pb");
+  AddLandmarks(&runner, 2, R"pb(
+    landmark { x: 0.9 y: 0.4 z: 30 }
+  )pb");
+
+  EXPECT_FALSE(runner.Run().ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
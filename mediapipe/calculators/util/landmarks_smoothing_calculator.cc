@@ -21,6 +21,7 @@
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/timestamp.h"
 
@@ -64,8 +65,6 @@ class LandmarksSmoothingCalculatorImpl
         absl::Microseconds(cc->InputTimestamp().Microseconds());
 
     if (kInNormLandmarks(cc).IsConnected()) {
-      const auto& in_norm_landmarks = kInNormLandmarks(cc).Get();
-
       int image_width;
       int image_height;
       std::tie(image_width, image_height) = kImageSize(cc).Get();
@@ -76,39 +75,68 @@ class LandmarksSmoothingCalculatorImpl
         object_scale = GetObjectScale(roi, image_width, image_height);
       }
 
-      auto in_landmarks = absl::make_unique<LandmarkList>();
-      NormalizedLandmarksToLandmarks(in_norm_landmarks, image_width,
-                                     image_height, *in_landmarks.get());
-
-      auto out_landmarks = absl::make_unique<LandmarkList>();
-      MP_RETURN_IF_ERROR(landmarks_filter_->Apply(
-          *in_landmarks, timestamp, object_scale, *out_landmarks));
+      if (kInNormLandmarks(cc).Has<LandmarkArray>()) {
+        return SmoothNormalizedLandmarks<LandmarkArray, LandmarkArray>(
+            cc, timestamp, image_width, image_height, object_scale);
+      }
+      return SmoothNormalizedLandmarks<NormalizedLandmarkList, LandmarkList>(
+          cc, timestamp, image_width, image_height, object_scale);
+    }
 
-      auto out_norm_landmarks = absl::make_unique<NormalizedLandmarkList>();
-      LandmarksToNormalizedLandmarks(*out_landmarks, image_width, image_height,
-                                     *out_norm_landmarks.get());
+    absl::optional<float> object_scale;
+    if (kObjectScaleRoi(cc).IsConnected() && !kObjectScaleRoi(cc).IsEmpty()) {
+      auto& roi = kObjectScaleRoi(cc).Get<Rect>();
+      object_scale = GetObjectScale(roi);
+    }
 
-      kOutNormLandmarks(cc).Send(std::move(out_norm_landmarks));
-    } else {
-      const auto& in_landmarks = kInLandmarks(cc).Get();
+    if (kInLandmarks(cc).Has<LandmarkArray>()) {
+      return SmoothLandmarks<LandmarkArray>(cc, timestamp, object_scale);
+    }
+    return SmoothLandmarks<LandmarkList>(cc, timestamp, object_scale);
+  }
 
-      absl::optional<float> object_scale;
-      if (kObjectScaleRoi(cc).IsConnected() && !kObjectScaleRoi(cc).IsEmpty()) {
-        auto& roi = kObjectScaleRoi(cc).Get<Rect>();
-        object_scale = GetObjectScale(roi);
-      }
+ private:
+  // Smooths NORM_LANDMARKS, of type NormListT, in absolute coordinates of
+  // type ListT.
+  template <typename NormListT, typename ListT>
+  absl::Status SmoothNormalizedLandmarks(
+      CalculatorContext* cc, const absl::Duration& timestamp, int image_width,
+      int image_height, const absl::optional<float>& object_scale) {
+    const auto& in_norm_landmarks = kInNormLandmarks(cc).Get<NormListT>();
+
+    ListT in_landmarks;
+    NormalizedLandmarksToLandmarks(in_norm_landmarks, image_width,
+                                   image_height, in_landmarks);
+
+    ListT out_landmarks;
+    MP_RETURN_IF_ERROR(landmarks_filter_->Apply(in_landmarks, timestamp,
+                                                object_scale, out_landmarks));
+
+    auto out_norm_landmarks = std::make_unique<NormListT>();
+    LandmarksToNormalizedLandmarks(out_landmarks, image_width, image_height,
+                                   *out_norm_landmarks);
+
+    kOutNormLandmarks(cc).Send(PacketAdopting(std::move(out_norm_landmarks))
+                                   .At(cc->InputTimestamp()));
+    return absl::OkStatus();
+  }
 
-      auto out_landmarks = absl::make_unique<LandmarkList>();
-      MP_RETURN_IF_ERROR(landmarks_filter_->Apply(
-          in_landmarks, timestamp, object_scale, *out_landmarks));
+  // Smooths LANDMARKS, of type ListT.
+  template <typename ListT>
+  absl::Status SmoothLandmarks(CalculatorContext* cc,
+                               const absl::Duration& timestamp,
+                               const absl::optional<float>& object_scale) {
+    const auto& in_landmarks = kInLandmarks(cc).Get<ListT>();
 
-      kOutLandmarks(cc).Send(std::move(out_landmarks));
-    }
+    auto out_landmarks = std::make_unique<ListT>();
+    MP_RETURN_IF_ERROR(landmarks_filter_->Apply(in_landmarks, timestamp,
+                                                object_scale, *out_landmarks));
 
+    kOutLandmarks(cc).Send(
+        PacketAdopting(std::move(out_landmarks)).At(cc->InputTimestamp()));
     return absl::OkStatus();
   }
 
- private:
   std::unique_ptr<LandmarksFilter> landmarks_filter_;
 };
 MEDIAPIPE_NODE_IMPLEMENTATION(LandmarksSmoothingCalculatorImpl);
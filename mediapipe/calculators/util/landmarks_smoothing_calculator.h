@@ -17,6 +17,7 @@
 
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/port/ret_check.h"
 
@@ -26,9 +27,10 @@ namespace api2 {
 // A calculator to smooth landmarks over time.
 //
 // Inputs:
-//   NORM_LANDMARKS (optional): A NormalizedLandmarkList of landmarks you want
+//   NORM_LANDMARKS (optional): A NormalizedLandmarkList or LandmarkArray of
+//     landmarks you want to smooth.
+//   LANDMARKS (optional): A LandmarkList or LandmarkArray of landmarks you want
 //     to smooth.
-//   LANDMARKS (optional): A LandmarkList of landmarks you want to smooth.
 //   IMAGE_SIZE (optional): A std::pair<int, int> represention of image width
 //     and height. Required to perform all computations in absolute coordinates
 //     when smoothing NORM_LANDMARKS to avoid any influence of normalized
@@ -40,8 +42,9 @@ namespace api2 {
 //
 // Outputs:
 //   NORM_FILTERED_LANDMARKS (optional): A NormalizedLandmarkList of smoothed
-//     landmarks.
-//   FILTERED_LANDMARKS (optional): A LandmarkList of smoothed landmarks.
+//     landmarks, or a LandmarkArray if NORM_LANDMARKS is one.
+//   FILTERED_LANDMARKS (optional): A LandmarkList of smoothed landmarks, or a
+//     LandmarkArray if LANDMARKS is one.
 //
 // Example config:
 //   node {
@@ -62,18 +65,22 @@ namespace api2 {
 //
 class LandmarksSmoothingCalculator : public NodeIntf {
  public:
-  static constexpr Input<mediapipe::NormalizedLandmarkList>::Optional
+  static constexpr Input<OneOf<mediapipe::NormalizedLandmarkList,
+                               mediapipe::LandmarkArray>>::Optional
       kInNormLandmarks{"NORM_LANDMARKS"};
-  static constexpr Input<mediapipe::LandmarkList>::Optional kInLandmarks{
-      "LANDMARKS"};
+  static constexpr Input<
+      OneOf<mediapipe::LandmarkList, mediapipe::LandmarkArray>>::Optional
+      kInLandmarks{"LANDMARKS"};
   static constexpr Input<std::pair<int, int>>::Optional kImageSize{
       "IMAGE_SIZE"};
   static constexpr Input<OneOf<NormalizedRect, Rect>>::Optional kObjectScaleRoi{
       "OBJECT_SCALE_ROI"};
-  static constexpr Output<mediapipe::NormalizedLandmarkList>::Optional
+  static constexpr Output<OneOf<mediapipe::NormalizedLandmarkList,
+                                mediapipe::LandmarkArray>>::Optional
       kOutNormLandmarks{"NORM_FILTERED_LANDMARKS"};
-  static constexpr Output<mediapipe::LandmarkList>::Optional kOutLandmarks{
-      "FILTERED_LANDMARKS"};
+  static constexpr Output<
+      OneOf<mediapipe::LandmarkList, mediapipe::LandmarkArray>>::Optional
+      kOutLandmarks{"FILTERED_LANDMARKS"};
   MEDIAPIPE_NODE_INTERFACE(LandmarksSmoothingCalculator, kInNormLandmarks,
                            kInLandmarks, kImageSize, kObjectScaleRoi,
                            kOutNormLandmarks, kOutLandmarks);
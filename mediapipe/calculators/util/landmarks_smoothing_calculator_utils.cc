@@ -14,14 +14,21 @@
 
 #include "mediapipe/calculators/util/landmarks_smoothing_calculator_utils.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
 
+#include "absl/types/span.h"
 #include "mediapipe/calculators/util/landmarks_smoothing_calculator.pb.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/port/ret_check.h"
-#include "mediapipe/util/filtering/one_euro_filter.h"
-#include "mediapipe/util/filtering/relative_velocity_filter.h"
+#include "mediapipe/util/filtering/one_euro_filter_bank.h"
+#include "mediapipe/util/filtering/relative_velocity_filter_bank.h"
 
 namespace mediapipe {
 namespace landmarks_smoothing {
@@ -29,9 +36,9 @@ namespace landmarks_smoothing {
 namespace {
 
 using ::mediapipe::NormalizedRect;
-using ::mediapipe::OneEuroFilter;
+using ::mediapipe::OneEuroFilterBank;
 using ::mediapipe::Rect;
-using ::mediapipe::RelativeVelocityFilter;
+using ::mediapipe::RelativeVelocityFilterBank;
 
 // Estimate object scale to use its inverse value as velocity scale for
 // RelativeVelocityFilter. If value will be too small (less than
@@ -58,6 +65,61 @@ float GetObjectScale(const LandmarkList& landmarks) {
   return (object_width + object_height) / 2.0f;
 }
 
+float GetObjectScale(const LandmarkArray& landmarks) {
+  const absl::Span<const float> x = landmarks.x();
+  const absl::Span<const float> y = landmarks.y();
+  const auto x_minmax = absl::c_minmax_element(x);
+  const auto y_minmax = absl::c_minmax_element(y);
+  const float object_width = *x_minmax.second - *x_minmax.first;
+  const float object_height = *y_minmax.second - *y_minmax.first;
+  return (object_width + object_height) / 2.0f;
+}
+
+int LandmarkCount(const LandmarkList& landmarks) {
+  return landmarks.landmark_size();
+}
+
+int LandmarkCount(const LandmarkArray& landmarks) { return landmarks.size(); }
+
+// Filters the x, y and z coordinates of all landmarks with a single call to
+// the filter bank, which holds filters for all x, then all y, then all z
+// coordinates. `values` is scratch space reused across frames.
+template <typename FilterBank, typename ValueScale>
+void ApplyFilterBank(const LandmarkList& in_landmarks,
+                     const absl::Duration& timestamp, ValueScale value_scale,
+                     FilterBank& filters, std::vector<float>& values,
+                     LandmarkList& out_landmarks) {
+  const int n = in_landmarks.landmark_size();
+  values.resize(3 * n);
+  for (int i = 0; i < n; ++i) {
+    const auto& in_landmark = in_landmarks.landmark(i);
+    values[i] = in_landmark.x();
+    values[n + i] = in_landmark.y();
+    values[2 * n + i] = in_landmark.z();
+  }
+
+  filters.Apply(timestamp, value_scale, absl::MakeSpan(values));
+
+  for (int i = 0; i < n; ++i) {
+    auto* out_landmark = out_landmarks.add_landmark();
+    *out_landmark = in_landmarks.landmark(i);
+    out_landmark->set_x(values[i]);
+    out_landmark->set_y(values[n + i]);
+    out_landmark->set_z(values[2 * n + i]);
+  }
+}
+
+// LandmarkArray keeps the coordinates in the filter bank's layout already, so
+// they are filtered in place in the output and `values` is not needed.
+template <typename FilterBank, typename ValueScale>
+void ApplyFilterBank(const LandmarkArray& in_landmarks,
+                     const absl::Duration& timestamp, ValueScale value_scale,
+                     FilterBank& filters, std::vector<float>& values,
+                     LandmarkArray& out_landmarks) {
+  out_landmarks = in_landmarks;
+  filters.Apply(timestamp, value_scale, out_landmarks.mutable_xyz());
+}
+
 // Returns landmarks as is without smoothing.
 class NoFilter : public LandmarksFilter {
  public:
@@ -68,6 +130,14 @@ class NoFilter : public LandmarksFilter {
     out_landmarks = in_landmarks;
     return absl::OkStatus();
   }
+
+  absl::Status Apply(const LandmarkArray& in_landmarks,
+                     const absl::Duration& timestamp,
+                     const absl::optional<float> object_scale_opt,
+                     LandmarkArray& out_landmarks) override {
+    out_landmarks = in_landmarks;
+    return absl::OkStatus();
+  }
 };
 
 // Please check RelativeVelocityFilter documentation for details.
@@ -80,10 +150,13 @@ class VelocityFilter : public LandmarksFilter {
         min_allowed_object_scale_(min_allowed_object_scale),
         disable_value_scaling_(disable_value_scaling) {}
 
+  // Keeps the filter bank, which is reused if the number of landmarks does
+  // not change.
   absl::Status Reset() override {
-    x_filters_.clear();
-    y_filters_.clear();
-    z_filters_.clear();
+    if (filters_ != nullptr) {
+      filters_->Reset();
+    }
+    filters_reset_ = true;
     return absl::OkStatus();
   }
 
@@ -91,6 +164,22 @@ class VelocityFilter : public LandmarksFilter {
                      const absl::Duration& timestamp,
                      const absl::optional<float> object_scale_opt,
                      LandmarkList& out_landmarks) override {
+    return ApplyImpl(in_landmarks, timestamp, object_scale_opt, out_landmarks);
+  }
+
+  absl::Status Apply(const LandmarkArray& in_landmarks,
+                     const absl::Duration& timestamp,
+                     const absl::optional<float> object_scale_opt,
+                     LandmarkArray& out_landmarks) override {
+    return ApplyImpl(in_landmarks, timestamp, object_scale_opt, out_landmarks);
+  }
+
+ private:
+  template <typename ListT>
+  absl::Status ApplyImpl(const ListT& in_landmarks,
+                         const absl::Duration& timestamp,
+                         const absl::optional<float> object_scale_opt,
+                         ListT& out_landmarks) {
     // Get value scale as inverse value of the object scale.
     // If value is too small smoothing will be disabled and landmarks will be
     // returned as is.
@@ -106,42 +195,27 @@ class VelocityFilter : public LandmarksFilter {
     }
 
     // Initialize filters once.
-    MP_RETURN_IF_ERROR(InitializeFiltersIfEmpty(in_landmarks.landmark_size()));
+    MP_RETURN_IF_ERROR(InitializeFiltersIfEmpty(LandmarkCount(in_landmarks)));
 
     // Filter landmarks. Every axis of every landmark is filtered separately.
-    for (int i = 0; i < in_landmarks.landmark_size(); ++i) {
-      const auto& in_landmark = in_landmarks.landmark(i);
-
-      auto* out_landmark = out_landmarks.add_landmark();
-      *out_landmark = in_landmark;
-      out_landmark->set_x(
-          x_filters_[i].Apply(timestamp, value_scale, in_landmark.x()));
-      out_landmark->set_y(
-          y_filters_[i].Apply(timestamp, value_scale, in_landmark.y()));
-      out_landmark->set_z(
-          z_filters_[i].Apply(timestamp, value_scale, in_landmark.z()));
-    }
-
+    ApplyFilterBank(in_landmarks, timestamp, value_scale, *filters_, values_,
+                    out_landmarks);
     return absl::OkStatus();
   }
 
- private:
   // Initializes filters for the first time or after Reset. If initialized then
   // check the size.
   absl::Status InitializeFiltersIfEmpty(const int n_landmarks) {
-    if (!x_filters_.empty()) {
-      RET_CHECK_EQ(x_filters_.size(), n_landmarks);
-      RET_CHECK_EQ(y_filters_.size(), n_landmarks);
-      RET_CHECK_EQ(z_filters_.size(), n_landmarks);
+    if (filters_ != nullptr && filters_->size() > 0 &&
+        (!filters_reset_ || filters_->size() == 3 * n_landmarks)) {
+      RET_CHECK_EQ(filters_->size(), 3 * n_landmarks);
+      filters_reset_ = false;
       return absl::OkStatus();
     }
 
-    x_filters_.resize(n_landmarks,
-                      RelativeVelocityFilter(window_size_, velocity_scale_));
-    y_filters_.resize(n_landmarks,
-                      RelativeVelocityFilter(window_size_, velocity_scale_));
-    z_filters_.resize(n_landmarks,
-                      RelativeVelocityFilter(window_size_, velocity_scale_));
+    filters_ = std::make_unique<RelativeVelocityFilterBank>(
+        3 * n_landmarks, window_size_, velocity_scale_);
+    filters_reset_ = false;
 
     return absl::OkStatus();
   }
@@ -151,9 +225,12 @@ class VelocityFilter : public LandmarksFilter {
   float min_allowed_object_scale_;
   bool disable_value_scaling_;
 
-  std::vector<RelativeVelocityFilter> x_filters_;
-  std::vector<RelativeVelocityFilter> y_filters_;
-  std::vector<RelativeVelocityFilter> z_filters_;
+  // Filters for the x, y and z coordinates of all landmarks, in that order.
+  std::unique_ptr<RelativeVelocityFilterBank> filters_;
+  // Whether filters_ was reset since the last Apply(), and can then be
+  // replaced if the number of landmarks changed.
+  bool filters_reset_ = false;
+  std::vector<float> values_;
 };
 
 // Please check OneEuroFilter documentation for details.
@@ -169,10 +246,13 @@ class OneEuroFilterImpl : public LandmarksFilter {
         min_allowed_object_scale_(min_allowed_object_scale),
         disable_value_scaling_(disable_value_scaling) {}
 
+  // Keeps the filter bank, which is reused if the number of landmarks does
+  // not change.
   absl::Status Reset() override {
-    x_filters_.clear();
-    y_filters_.clear();
-    z_filters_.clear();
+    if (filters_ != nullptr) {
+      filters_->Reset();
+    }
+    filters_reset_ = true;
     return absl::OkStatus();
   }
 
@@ -180,8 +260,24 @@ class OneEuroFilterImpl : public LandmarksFilter {
                      const absl::Duration& timestamp,
                      const absl::optional<float> object_scale_opt,
                      LandmarkList& out_landmarks) override {
+    return ApplyImpl(in_landmarks, timestamp, object_scale_opt, out_landmarks);
+  }
+
+  absl::Status Apply(const LandmarkArray& in_landmarks,
+                     const absl::Duration& timestamp,
+                     const absl::optional<float> object_scale_opt,
+                     LandmarkArray& out_landmarks) override {
+    return ApplyImpl(in_landmarks, timestamp, object_scale_opt, out_landmarks);
+  }
+
+ private:
+  template <typename ListT>
+  absl::Status ApplyImpl(const ListT& in_landmarks,
+                         const absl::Duration& timestamp,
+                         const absl::optional<float> object_scale_opt,
+                         ListT& out_landmarks) {
     // Initialize filters once.
-    MP_RETURN_IF_ERROR(InitializeFiltersIfEmpty(in_landmarks.landmark_size()));
+    MP_RETURN_IF_ERROR(InitializeFiltersIfEmpty(LandmarkCount(in_landmarks)));
 
     // Get value scale as inverse value of the object scale.
     // If value is too small smoothing will be disabled and landmarks will be
@@ -198,41 +294,24 @@ class OneEuroFilterImpl : public LandmarksFilter {
     }
 
     // Filter landmarks. Every axis of every landmark is filtered separately.
-    for (int i = 0; i < in_landmarks.landmark_size(); ++i) {
-      const auto& in_landmark = in_landmarks.landmark(i);
-
-      auto* out_landmark = out_landmarks.add_landmark();
-      *out_landmark = in_landmark;
-      out_landmark->set_x(
-          x_filters_[i].Apply(timestamp, value_scale, in_landmark.x()));
-      out_landmark->set_y(
-          y_filters_[i].Apply(timestamp, value_scale, in_landmark.y()));
-      out_landmark->set_z(
-          z_filters_[i].Apply(timestamp, value_scale, in_landmark.z()));
-    }
-
+    ApplyFilterBank(in_landmarks, timestamp, value_scale, *filters_, values_,
+                    out_landmarks);
     return absl::OkStatus();
   }
 
- private:
   // Initializes filters for the first time or after Reset. If initialized then
   // check the size.
   absl::Status InitializeFiltersIfEmpty(const int n_landmarks) {
-    if (!x_filters_.empty()) {
-      RET_CHECK_EQ(x_filters_.size(), n_landmarks);
-      RET_CHECK_EQ(y_filters_.size(), n_landmarks);
-      RET_CHECK_EQ(z_filters_.size(), n_landmarks);
+    if (filters_ != nullptr && filters_->size() > 0 &&
+        (!filters_reset_ || filters_->size() == 3 * n_landmarks)) {
+      RET_CHECK_EQ(filters_->size(), 3 * n_landmarks);
+      filters_reset_ = false;
       return absl::OkStatus();
     }
 
-    for (int i = 0; i < n_landmarks; ++i) {
-      x_filters_.push_back(
-          OneEuroFilter(frequency_, min_cutoff_, beta_, derivate_cutoff_));
-      y_filters_.push_back(
-          OneEuroFilter(frequency_, min_cutoff_, beta_, derivate_cutoff_));
-      z_filters_.push_back(
-          OneEuroFilter(frequency_, min_cutoff_, beta_, derivate_cutoff_));
-    }
+    filters_ = std::make_unique<OneEuroFilterBank>(
+        3 * n_landmarks, frequency_, min_cutoff_, beta_, derivate_cutoff_);
+    filters_reset_ = false;
 
     return absl::OkStatus();
   }
@@ -244,9 +323,12 @@ class OneEuroFilterImpl : public LandmarksFilter {
   double min_allowed_object_scale_;
   bool disable_value_scaling_;
 
-  std::vector<OneEuroFilter> x_filters_;
-  std::vector<OneEuroFilter> y_filters_;
-  std::vector<OneEuroFilter> z_filters_;
+  // Filters for the x, y and z coordinates of all landmarks, in that order.
+  std::unique_ptr<OneEuroFilterBank> filters_;
+  // Whether filters_ was reset since the last Apply(), and can then be
+  // replaced if the number of landmarks changed.
+  bool filters_reset_ = false;
+  std::vector<float> values_;
 };
 
 }  // namespace
@@ -304,6 +386,28 @@ void LandmarksToNormalizedLandmarks(const LandmarkList& landmarks,
   }
 }
 
+void NormalizedLandmarksToLandmarks(const LandmarkArray& norm_landmarks,
+                                    const int image_width,
+                                    const int image_height,
+                                    LandmarkArray& landmarks) {
+  landmarks = norm_landmarks;
+  for (float& x : landmarks.mutable_x()) x *= image_width;
+  for (float& y : landmarks.mutable_y()) y *= image_height;
+  // Scale Z the same way as X (using image width).
+  for (float& z : landmarks.mutable_z()) z *= image_width;
+}
+
+void LandmarksToNormalizedLandmarks(const LandmarkArray& landmarks,
+                                    const int image_width,
+                                    const int image_height,
+                                    LandmarkArray& norm_landmarks) {
+  norm_landmarks = landmarks;
+  for (float& x : norm_landmarks.mutable_x()) x /= image_width;
+  for (float& y : norm_landmarks.mutable_y()) y /= image_height;
+  // Scale Z the same way as X (using image width).
+  for (float& z : norm_landmarks.mutable_z()) z /= image_width;
+}
+
 float GetObjectScale(const NormalizedRect& roi, const int image_width,
                      const int image_height) {
   const float object_width = roi.width() * image_width;
@@ -348,29 +452,44 @@ absl::StatusOr<LandmarksFilter*> MultiLandmarkFilters::GetOrCreate(
     return it->second.get();
   }
 
-  MP_ASSIGN_OR_RETURN(auto landmarks_filter,
-                      InitializeLandmarksFilter(options));
-  filters_[tracking_id] = std::move(landmarks_filter);
-  return filters_[tracking_id].get();
+  std::unique_ptr<LandmarksFilter> landmarks_filter;
+  if (!free_filters_.empty()) {
+    landmarks_filter = std::move(free_filters_.back());
+    free_filters_.pop_back();
+  } else {
+    MP_ASSIGN_OR_RETURN(landmarks_filter, InitializeLandmarksFilter(options));
+  }
+  LandmarksFilter* filter = landmarks_filter.get();
+  filters_.emplace(tracking_id, std::move(landmarks_filter));
+  return filter;
 }
 
 void MultiLandmarkFilters::ClearUnused(
     const std::vector<int64_t>& tracking_ids) {
-  std::vector<int64_t> unused_tracking_ids;
-  for (const auto& it : filters_) {
-    bool unused = true;
-    for (int64_t tracking_id : tracking_ids) {
-      if (tracking_id == it.first) unused = false;
+  for (auto it = filters_.begin(); it != filters_.end();) {
+    if (std::find(tracking_ids.begin(), tracking_ids.end(), it->first) ==
+        tracking_ids.end()) {
+      Recycle(std::move(it->second));
+      filters_.erase(it++);
+    } else {
+      ++it;
     }
-    if (unused) unused_tracking_ids.push_back(it.first);
   }
+}
 
-  for (int64_t tracking_id : unused_tracking_ids) {
-    filters_.erase(tracking_id);
+void MultiLandmarkFilters::Clear() {
+  for (auto& [tracking_id, filter] : filters_) {
+    Recycle(std::move(filter));
   }
+  filters_.clear();
 }
 
-void MultiLandmarkFilters::Clear() { filters_.clear(); }
+void MultiLandmarkFilters::Recycle(std::unique_ptr<LandmarksFilter> filter) {
+  // A filter that cannot be reset is dropped.
+  if (filter->Reset().ok()) {
+    free_filters_.push_back(std::move(filter));
+  }
+}
 
 }  // namespace landmarks_smoothing
 }  // namespace mediapipe
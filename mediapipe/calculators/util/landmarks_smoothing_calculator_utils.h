@@ -15,9 +15,15 @@
 #ifndef MEDIAPIPE_CALCULATORS_UTIL_LANDMARKS_SMOOTHING_CALCULATOR_UTILS_H_
 #define MEDIAPIPE_CALCULATORS_UTIL_LANDMARKS_SMOOTHING_CALCULATOR_UTILS_H_
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
 #include "mediapipe/calculators/util/landmarks_smoothing_calculator.pb.h"
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/util/filtering/one_euro_filter.h"
 #include "mediapipe/util/filtering/relative_velocity_filter.h"
@@ -34,6 +40,15 @@ void LandmarksToNormalizedLandmarks(
     const mediapipe::LandmarkList& landmarks, const int image_width,
     const int image_height, mediapipe::NormalizedLandmarkList& norm_landmarks);
 
+void NormalizedLandmarksToLandmarks(
+    const mediapipe::LandmarkArray& norm_landmarks, const int image_width,
+    const int image_height, mediapipe::LandmarkArray& landmarks);
+
+void LandmarksToNormalizedLandmarks(const mediapipe::LandmarkArray& landmarks,
+                                    const int image_width,
+                                    const int image_height,
+                                    mediapipe::LandmarkArray& norm_landmarks);
+
 float GetObjectScale(const NormalizedRect& roi, const int image_width,
                      const int image_height);
 
@@ -50,11 +65,24 @@ class LandmarksFilter {
                              const absl::Duration& timestamp,
                              const absl::optional<float> object_scale_opt,
                              mediapipe::LandmarkList& out_landmarks) = 0;
+
+  // Same as above for landmarks held in a LandmarkArray, whose x, y and z
+  // blocks are filtered without any conversion.
+  virtual absl::Status Apply(const mediapipe::LandmarkArray& in_landmarks,
+                             const absl::Duration& timestamp,
+                             const absl::optional<float> object_scale_opt,
+                             mediapipe::LandmarkArray& out_landmarks) = 0;
 };
 
 absl::StatusOr<std::unique_ptr<LandmarksFilter>> InitializeLandmarksFilter(
     const mediapipe::LandmarksSmoothingCalculatorOptions& options);
 
+// Landmarks filters of several objects, by tracking id.
+//
+// The filters of the tracking ids that disappear are reset and kept in a free
+// list, and reused for the next new tracking ids, so that objects entering
+// and leaving the scene do not allocate new filter banks. `options` must
+// therefore be the same for all calls to GetOrCreate().
 class MultiLandmarkFilters {
  public:
   virtual ~MultiLandmarkFilters() = default;
@@ -68,7 +96,11 @@ class MultiLandmarkFilters {
   virtual void Clear();
 
  private:
-  std::map<int64_t, std::unique_ptr<LandmarksFilter>> filters_;
+  // Resets `filter` and adds it to the free list.
+  void Recycle(std::unique_ptr<LandmarksFilter> filter);
+
+  absl::flat_hash_map<int64_t, std::unique_ptr<LandmarksFilter>> filters_;
+  std::vector<std::unique_ptr<LandmarksFilter>> free_filters_;
 };
 
 }  // namespace landmarks_smoothing
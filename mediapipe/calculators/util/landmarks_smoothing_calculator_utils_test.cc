@@ -16,6 +16,7 @@ limitations under the License.
 #include "mediapipe/calculators/util/landmarks_smoothing_calculator_utils.h"
 
 #include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/landmark_array.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 
@@ -113,6 +114,140 @@ TEST(LandmarksSmoothingCalculatorUtilsTest,
   EXPECT_FALSE(norm_landmark.has_presence());
 }
 
+TEST(LandmarksSmoothingCalculatorUtilsTest, LandmarkArrayRoundTrip) {
+  LandmarkArray norm_landmarks(1);
+  norm_landmarks.mutable_x()[0] = 0.1;
+  norm_landmarks.mutable_y()[0] = 0.2;
+  norm_landmarks.mutable_z()[0] = 0.3;
+  norm_landmarks.mutable_visibility()[0] = 0.4;
+  norm_landmarks.set_has_visibility(true);
+
+  LandmarkArray landmarks;
+  NormalizedLandmarksToLandmarks(norm_landmarks, /*image_width=*/10,
+                                 /*image_height=*/20, landmarks);
+  EXPECT_NEAR(landmarks.x()[0], 1.0, 1e-6);
+  EXPECT_NEAR(landmarks.y()[0], 4.0, 1e-6);
+  EXPECT_NEAR(landmarks.z()[0], 3.0, 1e-6);
+  EXPECT_NEAR(landmarks.visibility()[0], 0.4, 1e-6);
+  EXPECT_TRUE(landmarks.has_visibility());
+  EXPECT_FALSE(landmarks.has_presence());
+
+  LandmarkArray round_trip;
+  LandmarksToNormalizedLandmarks(landmarks, /*image_width=*/10,
+                                 /*image_height=*/20, round_trip);
+  EXPECT_NEAR(round_trip.x()[0], 0.1, 1e-6);
+  EXPECT_NEAR(round_trip.y()[0], 0.2, 1e-6);
+  EXPECT_NEAR(round_trip.z()[0], 0.3, 1e-6);
+}
+
+TEST(LandmarksSmoothingCalculatorUtilsTest,
+     FiltersLandmarkArrayLikeLandmarkList) {
+  LandmarksSmoothingCalculatorOptions options;
+  options.mutable_one_euro_filter()->set_min_cutoff(0.1);
+  options.mutable_one_euro_filter()->set_beta(0.5);
+  auto list_filter = InitializeLandmarksFilter(options);
+  auto array_filter = InitializeLandmarksFilter(options);
+  ASSERT_TRUE(list_filter.ok());
+  ASSERT_TRUE(array_filter.ok());
+
+  for (int frame = 0; frame < 5; ++frame) {
+    LandmarkList landmarks;
+    for (int i = 0; i < 3; ++i) {
+      Landmark* landmark = landmarks.add_landmark();
+      landmark->set_x(10.0f * i + frame);
+      landmark->set_y(5.0f * i - frame);
+      landmark->set_z(0.5f * frame);
+      landmark->set_presence(0.9f);
+    }
+    const absl::Duration timestamp = absl::Milliseconds(33 * frame);
+
+    LandmarkList filtered_list;
+    ASSERT_TRUE((*list_filter)
+                    ->Apply(landmarks, timestamp, absl::nullopt, filtered_list)
+                    .ok());
+    LandmarkArray filtered_array;
+    ASSERT_TRUE((*array_filter)
+                    ->Apply(LandmarkArrayFromProto(landmarks), timestamp,
+                            absl::nullopt, filtered_array)
+                    .ok());
+
+    LandmarkList converted;
+    LandmarkArrayToProto(filtered_array, &converted);
+    EXPECT_EQ(converted.SerializeAsString(), filtered_list.SerializeAsString());
+  }
+}
+
+LandmarkList MakeLandmarks(int num_landmarks, int frame) {
+  LandmarkList landmarks;
+  for (int i = 0; i < num_landmarks; ++i) {
+    Landmark* landmark = landmarks.add_landmark();
+    landmark->set_x(10.0f * i + frame);
+    landmark->set_y(5.0f * i - frame * frame);
+    landmark->set_z(0.5f * frame);
+  }
+  return landmarks;
+}
+
+TEST(MultiLandmarkFiltersTest, RecyclesFiltersOfUnusedTrackingIds) {
+  LandmarksSmoothingCalculatorOptions options;
+  options.mutable_one_euro_filter()->set_min_cutoff(0.1);
+  options.mutable_one_euro_filter()->set_beta(0.5);
+  MultiLandmarkFilters multi_filters;
+  auto first = multi_filters.GetOrCreate(1, options);
+  ASSERT_TRUE(first.ok());
+  for (int frame = 0; frame < 3; ++frame) {
+    LandmarkList filtered;
+    ASSERT_TRUE((*first)
+                    ->Apply(MakeLandmarks(3, frame),
+                            absl::Milliseconds(100 + 33 * frame), 1.0f,
+                            filtered)
+                    .ok());
+  }
+
+  multi_filters.ClearUnused({2});
+  auto second = multi_filters.GetOrCreate(2, options);
+  ASSERT_TRUE(second.ok());
+  EXPECT_EQ(*second, *first);
+  auto third = multi_filters.GetOrCreate(3, options);
+  ASSERT_TRUE(third.ok());
+  EXPECT_NE(*third, *first);
+
+  // The recycled filter behaves like a new one, including for a different
+  // number of landmarks.
+  auto new_filter = InitializeLandmarksFilter(options);
+  ASSERT_TRUE(new_filter.ok());
+  for (int frame = 0; frame < 3; ++frame) {
+    const LandmarkList landmarks = MakeLandmarks(4, frame + 5);
+    const absl::Duration timestamp = absl::Milliseconds(10 + 33 * frame);
+    LandmarkList expected;
+    ASSERT_TRUE(
+        (*new_filter)->Apply(landmarks, timestamp, 1.0f, expected).ok());
+    LandmarkList filtered;
+    ASSERT_TRUE((*second)->Apply(landmarks, timestamp, 1.0f, filtered).ok());
+    EXPECT_EQ(filtered.SerializeAsString(), expected.SerializeAsString());
+  }
+}
+
+TEST(MultiLandmarkFiltersTest, KeepsFiltersOfUsedTrackingIds) {
+  LandmarksSmoothingCalculatorOptions options;
+  options.mutable_velocity_filter()->set_window_size(5);
+  MultiLandmarkFilters multi_filters;
+  auto first = multi_filters.GetOrCreate(1, options);
+  auto second = multi_filters.GetOrCreate(2, options);
+  ASSERT_TRUE(first.ok());
+  ASSERT_TRUE(second.ok());
+
+  multi_filters.ClearUnused({2});
+  auto second_again = multi_filters.GetOrCreate(2, options);
+  ASSERT_TRUE(second_again.ok());
+  EXPECT_EQ(*second_again, *second);
+
+  multi_filters.Clear();
+  auto recycled = multi_filters.GetOrCreate(3, options);
+  ASSERT_TRUE(recycled.ok());
+  EXPECT_TRUE(*recycled == *first || *recycled == *second);
+}
+
 }  // namespace
 }  // namespace landmarks_smoothing
 }  // namespace mediapipe
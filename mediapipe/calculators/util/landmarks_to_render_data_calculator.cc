@@ -13,9 +13,14 @@
 // limitations under the License.
 #include "mediapipe/calculators/util/landmarks_to_render_data_calculator.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/calculators/util/landmarks_to_render_data_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_options.pb.h"
@@ -73,6 +78,40 @@ inline float Remap(float x, float lo, float hi, float scale) {
   return (x - lo) / (hi - lo + 1e-6) * scale;
 }
 
+// Writes the annotations of a RenderData in order. Annotations left in the
+// RenderData by a previous frame are updated in place when they hold the same
+// kind of data, which allocates nothing: a given kind of annotation always
+// gets the same fields set below.
+class AnnotationWriter {
+ public:
+  explicit AnnotationWriter(RenderData* render_data)
+      : annotations_(render_data->mutable_render_annotations()) {}
+
+  RenderAnnotation* Next(RenderAnnotation::DataCase data_case) {
+    if (next_ == annotations_->size()) {
+      ++next_;
+      return annotations_->Add();
+    }
+    RenderAnnotation* annotation = annotations_->Mutable(next_++);
+    if (annotation->data_case() != data_case) {
+      annotation->Clear();
+    }
+    return annotation;
+  }
+
+  // Removes the annotations that were not written. The repeated field keeps
+  // them allocated for later frames.
+  void Finish() {
+    while (annotations_->size() > next_) {
+      annotations_->RemoveLast();
+    }
+  }
+
+ private:
+  proto_ns::RepeatedPtrField<RenderAnnotation>* annotations_;
+  int next_ = 0;
+};
+
 template <class LandmarkListType, class LandmarkType>
 inline void GetMinMaxZ(const LandmarkListType& landmarks, float* z_min,
                        float* z_max) {
@@ -123,8 +162,8 @@ void AddConnectionToRenderData(const LandmarkType& start,
                                const LandmarkType& end,
                                const Color& color_start, const Color& color_end,
                                float thickness, bool normalized,
-                               RenderData* render_data) {
-  auto* connection_annotation = render_data->add_render_annotations();
+                               AnnotationWriter* writer) {
+  auto* connection_annotation = writer->Next(RenderAnnotation::kGradientLine);
   RenderAnnotation::GradientLine* line =
       connection_annotation->mutable_gradient_line();
   line->set_x_start(start.x());
@@ -151,7 +190,7 @@ void AddConnectionsWithDepth(const LandmarkListType& landmarks,
                              bool normalized, float min_z, float max_z,
                              const Color& min_depth_line_color,
                              const Color& max_depth_line_color,
-                             RenderData* render_data) {
+                             AnnotationWriter* writer) {
   for (int i = 0; i < landmark_connections.size(); i += 2) {
     if (landmark_connections[i] >= landmarks.landmark_size() ||
         landmark_connections[i + 1] >= landmarks.landmark_size()) {
@@ -172,7 +211,7 @@ void AddConnectionsWithDepth(const LandmarkListType& landmarks,
     const Color color1 = MixColors(min_depth_line_color, max_depth_line_color,
                                    Remap(ld1.z(), min_z, max_z, 1.f));
     AddConnectionToRenderData<LandmarkType>(ld0, ld1, color0, color1, thickness,
-                                            normalized, render_data);
+                                            normalized, writer);
   }
 }
 
@@ -180,8 +219,8 @@ template <class LandmarkType>
 void AddConnectionToRenderData(const LandmarkType& start,
                                const LandmarkType& end,
                                const Color& connection_color, float thickness,
-                               bool normalized, RenderData* render_data) {
-  auto* connection_annotation = render_data->add_render_annotations();
+                               bool normalized, AnnotationWriter* writer) {
+  auto* connection_annotation = writer->Next(RenderAnnotation::kLine);
   RenderAnnotation::Line* line = connection_annotation->mutable_line();
   line->set_x_start(start.x());
   line->set_y_start(start.y());
@@ -198,7 +237,7 @@ void AddConnections(const LandmarkListType& landmarks,
                     bool utilize_visibility, float visibility_threshold,
                     bool utilize_presence, float presence_threshold,
                     const Color& connection_color, float thickness,
-                    bool normalized, RenderData* render_data) {
+                    bool normalized, AnnotationWriter* writer) {
   for (int i = 0; i < landmark_connections.size(); i += 2) {
     if (landmark_connections[i] >= landmarks.landmark_size() ||
         landmark_connections[i + 1] >= landmarks.landmark_size()) {
@@ -215,13 +254,14 @@ void AddConnections(const LandmarkListType& landmarks,
       continue;
     }
     AddConnectionToRenderData<LandmarkType>(ld0, ld1, connection_color,
-                                            thickness, normalized, render_data);
+                                            thickness, normalized, writer);
   }
 }
 
 RenderAnnotation* AddPointRenderData(const Color& landmark_color,
-                                     float thickness, RenderData* render_data) {
-  auto* landmark_data_annotation = render_data->add_render_annotations();
+                                     float thickness,
+                                     AnnotationWriter* writer) {
+  auto* landmark_data_annotation = writer->Next(RenderAnnotation::kPoint);
   landmark_data_annotation->set_scene_tag(kLandmarkLabel);
   SetColor(landmark_data_annotation, landmark_color);
   landmark_data_annotation->set_thickness(thickness);
@@ -230,6 +270,29 @@ RenderAnnotation* AddPointRenderData(const Color& landmark_color,
 
 }  // namespace
 
+// RenderData messages released by downstream calculators, for reuse.
+class LandmarksToRenderDataCalculator::RenderDataPool {
+ public:
+  std::unique_ptr<RenderData> Get() {
+    absl::MutexLock lock(&mutex_);
+    if (free_.empty()) {
+      return absl::make_unique<RenderData>();
+    }
+    std::unique_ptr<RenderData> render_data = std::move(free_.back());
+    free_.pop_back();
+    return render_data;
+  }
+
+  void Release(RenderData* render_data) {
+    absl::MutexLock lock(&mutex_);
+    free_.emplace_back(render_data);
+  }
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<RenderData>> free_ ABSL_GUARDED_BY(mutex_);
+};
+
 absl::Status LandmarksToRenderDataCalculator::GetContract(
     CalculatorContract* cc) {
   RET_CHECK(cc->Inputs().HasTag(kLandmarksTag) ||
@@ -280,7 +343,16 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
     return absl::OkStatus();
   }
 
-  auto render_data = absl::make_unique<RenderData>();
+  std::unique_ptr<RenderData> render_data;
+  if (options_.reuse_render_data()) {
+    if (!render_data_pool_) {
+      render_data_pool_ = std::make_shared<RenderDataPool>();
+    }
+    render_data = render_data_pool_->Get();
+  } else {
+    render_data = absl::make_unique<RenderData>();
+  }
+  AnnotationWriter writer(render_data.get());
   bool visualize_depth = options_.visualize_landmark_depth();
   float z_min = 0.f;
   float z_max = 0.f;
@@ -314,13 +386,13 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
           landmarks, landmark_connections_, options_.utilize_visibility(),
           options_.visibility_threshold(), options_.utilize_presence(),
           options_.presence_threshold(), thickness, /*normalized=*/false, z_min,
-          z_max, min_depth_line_color, max_depth_line_color, render_data.get());
+          z_max, min_depth_line_color, max_depth_line_color, &writer);
     } else {
       AddConnections<LandmarkList, Landmark>(
           landmarks, landmark_connections_, options_.utilize_visibility(),
           options_.visibility_threshold(), options_.utilize_presence(),
           options_.presence_threshold(), options_.connection_color(), thickness,
-          /*normalized=*/false, render_data.get());
+          /*normalized=*/false, &writer);
     }
     if (options_.render_landmarks()) {
       for (int i = 0; i < landmarks.landmark_size(); ++i) {
@@ -333,8 +405,8 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
           continue;
         }
 
-        auto* landmark_data_render = AddPointRenderData(
-            options_.landmark_color(), thickness, render_data.get());
+        auto* landmark_data_render =
+            AddPointRenderData(options_.landmark_color(), thickness, &writer);
         if (visualize_depth) {
           SetColorSizeValueFromZ(landmark.z(), z_min, z_max,
                                  landmark_data_render,
@@ -363,13 +435,13 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
           landmarks, landmark_connections_, options_.utilize_visibility(),
           options_.visibility_threshold(), options_.utilize_presence(),
           options_.presence_threshold(), thickness, /*normalized=*/true, z_min,
-          z_max, min_depth_line_color, max_depth_line_color, render_data.get());
+          z_max, min_depth_line_color, max_depth_line_color, &writer);
     } else {
       AddConnections<NormalizedLandmarkList, NormalizedLandmark>(
           landmarks, landmark_connections_, options_.utilize_visibility(),
           options_.visibility_threshold(), options_.utilize_presence(),
           options_.presence_threshold(), options_.connection_color(), thickness,
-          /*normalized=*/true, render_data.get());
+          /*normalized=*/true, &writer);
     }
     if (options_.render_landmarks()) {
       for (int i = 0; i < landmarks.landmark_size(); ++i) {
@@ -382,8 +454,8 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
           continue;
         }
 
-        auto* landmark_data_render = AddPointRenderData(
-            options_.landmark_color(), thickness, render_data.get());
+        auto* landmark_data_render =
+            AddPointRenderData(options_.landmark_color(), thickness, &writer);
         if (visualize_depth) {
           SetColorSizeValueFromZ(landmark.z(), z_min, z_max,
                                  landmark_data_render,
@@ -398,9 +470,21 @@ absl::Status LandmarksToRenderDataCalculator::Process(CalculatorContext* cc) {
     }
   }
 
-  cc->Outputs()
-      .Tag(kRenderDataTag)
-      .Add(render_data.release(), cc->InputTimestamp());
+  writer.Finish();
+  if (options_.reuse_render_data()) {
+    // The RenderData goes back to the pool once all copies of the packet are
+    // destroyed.
+    const RenderData* data = render_data.release();
+    cc->Outputs()
+        .Tag(kRenderDataTag)
+        .AddPacket(PointToForeign(data, [pool = render_data_pool_, data]() {
+                     pool->Release(const_cast<RenderData*>(data));
+                   }).At(cc->InputTimestamp()));
+  } else {
+    cc->Outputs()
+        .Tag(kRenderDataTag)
+        .Add(render_data.release(), cc->InputTimestamp());
+  }
   return absl::OkStatus();
 }
 
@@ -14,6 +14,9 @@
 #ifndef MEDIAPIPE_CALCULATORS_UTIL_LANDMARKS_TO_RENDER_DATA_CALCULATOR_H_
 #define MEDIAPIPE_CALCULATORS_UTIL_LANDMARKS_TO_RENDER_DATA_CALCULATOR_H_
 
+#include <memory>
+#include <vector>
+
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
@@ -63,6 +66,11 @@ class LandmarksToRenderDataCalculator : public CalculatorBase {
  protected:
   ::mediapipe::LandmarksToRenderDataCalculatorOptions options_;
   std::vector<int> landmark_connections_;
+
+ private:
+  class RenderDataPool;
+  // Created on first use when options_.reuse_render_data() is set.
+  std::shared_ptr<RenderDataPool> render_data_pool_;
 };
 
 }  // namespace mediapipe
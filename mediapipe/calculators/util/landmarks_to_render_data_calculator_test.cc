@@ -0,0 +1,136 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+// Runs a calculator that reuses its RenderData next to one that does not.
+class LandmarksToRenderDataCalculatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+      input_stream: "landmarks"
+      node {
+        calculator: "LandmarksToRenderDataCalculator"
+        input_stream: "NORM_LANDMARKS:landmarks"
+        output_stream: "RENDER_DATA:fresh"
+        options {
+          [mediapipe.LandmarksToRenderDataCalculatorOptions.ext] {
+            landmark_connections: [ 0, 1, 1, 2 ]
+            utilize_visibility: true
+            visibility_threshold: 0.5
+          }
+        }
+      }
+      node {
+        calculator: "LandmarksToRenderDataCalculator"
+        input_stream: "NORM_LANDMARKS:landmarks"
+        output_stream: "RENDER_DATA:reused"
+        options {
+          [mediapipe.LandmarksToRenderDataCalculatorOptions.ext] {
+            landmark_connections: [ 0, 1, 1, 2 ]
+            utilize_visibility: true
+            visibility_threshold: 0.5
+            reuse_render_data: true
+          }
+        }
+      }
+    )pb");
+    MP_ASSERT_OK(graph_.Initialize(config));
+    MP_ASSERT_OK(graph_.ObserveOutputStream("fresh", [this](const Packet& p) {
+      fresh_ = p.Get<RenderData>().SerializeAsString();
+      return absl::OkStatus();
+    }));
+    MP_ASSERT_OK(graph_.ObserveOutputStream("reused", [this](const Packet& p) {
+      reused_ = p.Get<RenderData>().SerializeAsString();
+      reused_address_ = &p.Get<RenderData>();
+      return absl::OkStatus();
+    }));
+    MP_ASSERT_OK(graph_.StartRun({}));
+  }
+
+  void TearDown() override {
+    MP_ASSERT_OK(graph_.CloseAllPacketSources());
+    MP_ASSERT_OK(graph_.WaitUntilDone());
+  }
+
+  void Send(const std::string& landmarks_text, int64_t timestamp) {
+    MP_ASSERT_OK(graph_.AddPacketToInputStream(
+        "landmarks", MakePacket<NormalizedLandmarkList>(
+                         ParseTextProtoOrDie<NormalizedLandmarkList>(
+                             landmarks_text))
+                         .At(Timestamp(timestamp))));
+    MP_ASSERT_OK(graph_.WaitUntilIdle());
+  }
+
+  CalculatorGraph graph_;
+  std::string fresh_;
+  std::string reused_;
+  const RenderData* reused_address_ = nullptr;
+};
+
+TEST_F(LandmarksToRenderDataCalculatorTest, ReusedRenderDataMatchesFreshOne) {
+  Send(R"pb(
+         landmark { x: 0.1 y: 0.2 z: 0.0 }
+         landmark { x: 0.3 y: 0.4 z: 0.5 }
+         landmark { x: 0.5 y: 0.6 z: 1.0 }
+       )pb",
+       0);
+  EXPECT_EQ(reused_, fresh_);
+  const RenderData* first_address = reused_address_;
+
+  // Same structure, new coordinates.
+  Send(R"pb(
+         landmark { x: 0.2 y: 0.3 z: 0.0 }
+         landmark { x: 0.4 y: 0.5 z: 0.0 }
+         landmark { x: 0.6 y: 0.7 z: 0.0 }
+       )pb",
+       1);
+  EXPECT_EQ(reused_, fresh_);
+  EXPECT_EQ(reused_address_, first_address);
+
+  // Fewer annotations: a hidden landmark drops both of its connections.
+  Send(R"pb(
+         landmark { x: 0.2 y: 0.3 z: 0.0 }
+         landmark { x: 0.4 y: 0.5 z: 0.0 visibility: 0.1 }
+         landmark { x: 0.6 y: 0.7 z: 0.0 }
+       )pb",
+       2);
+  EXPECT_EQ(reused_, fresh_);
+  EXPECT_EQ(reused_address_, first_address);
+
+  // More annotations again, with depth.
+  Send(R"pb(
+         landmark { x: 0.1 y: 0.2 z: 0.0 }
+         landmark { x: 0.3 y: 0.4 z: 0.5 }
+         landmark { x: 0.5 y: 0.6 z: 1.0 }
+       )pb",
+       3);
+  EXPECT_EQ(reused_, fresh_);
+  EXPECT_EQ(reused_address_, first_address);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,331 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/util/latency_slo_monitor_calculator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/calculators/util/latency.pb.h"
+#include "mediapipe/calculators/util/latency_slo_monitor_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/deps/monotonic_clock.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/name_util.h"
+#include "mediapipe/util/log_linear_histogram.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kClockTag[] = "CLOCK";
+constexpr char kSloCallbackTag[] = "SLO_CALLBACK";
+constexpr char kReferenceSignalTag[] = "REFERENCE_SIGNAL";
+constexpr char kSloReportTag[] = "SLO_REPORT";
+constexpr char kAtRiskTag[] = "AT_RISK";
+
+// The latencies of the most recent packets of a monitored stream.
+struct LatencyWindow {
+  std::deque<int64_t> latencies_usec;
+  LogLinearHistogram histogram;
+};
+
+}  // namespace
+
+// Monitors a latency service level objective (SLO) over several packet
+// streams, typically the output streams of a graph: the budget_quantile of the
+// latencies of each stream must stay within latency_budget_usec.
+//
+// The latency of a packet is the time between the arrival of the reference
+// packet with the same timestamp and its own arrival. For each stream, the
+// p50, p95 and p99 latencies are computed over a sliding window of its most
+// recent packets with a LogLinearHistogram, whose buckets bound the relative
+// error of the quantiles to 1/64. Packets without a matching reference packet
+// among the max_pending_references most recent ones are ignored.
+//
+// Whenever the worst state of the streams changes, the SLO_CALLBACK side
+// packet is called, and AT_RISK outputs whether the SLO is no longer OK when
+// that changes, so that a graph can react, e.g. by lowering the max_in_flight
+// of a FlowLimiterCalculator or by selecting a lighter model in a
+// SwitchContainer.
+// Each packet over budget also increments the "<label>_over_latency_budget"
+// counter of the graph.
+//
+// NOTE: Like PacketLatencyCalculator, this calculator is meant to be used with
+// an ImmediateInputStreamHandler in real-time or simulated real-time graphs.
+// Since packets of different streams can then arrive out of timestamp order,
+// the SLO_REPORT and AT_RISK outputs skip the packets whose timestamp is not
+// greater than the last one output. A skipped AT_RISK change is output with
+// the next packet that can be.
+//
+// Use AddLatencySloMonitor to monitor all the output streams of a graph.
+//
+// Input side packets:
+// CLOCK (optional): A std::shared_ptr<Clock> to measure latencies with.
+// SLO_CALLBACK (optional): A LatencySloCallback.
+//
+// Inputs:
+// 0- Packet stream 0.
+// ...
+// N- Packet stream N.
+// REFERENCE_SIGNAL: The stream the above packets are derived from.
+//
+// Outputs:
+// SLO_REPORT (optional): A LatencySloReport for each monitored packet.
+// AT_RISK (optional): Whether the worst state is not OK, when that changes.
+//
+// Example config:
+// node {
+//   calculator: "LatencySloMonitorCalculator"
+//   input_stream: "detections"
+//   input_stream: "output_video"
+//   input_stream: "REFERENCE_SIGNAL:input_video"
+//   output_stream: "SLO_REPORT:slo_report"
+//   options {
+//     [mediapipe.LatencySloMonitorCalculatorOptions.ext] {
+//       latency_budget_usec: 33000
+//     }
+//   }
+//   input_stream_handler {
+//     input_stream_handler: "ImmediateInputStreamHandler"
+//   }
+// }
+class LatencySloMonitorCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc);
+
+  absl::Status Open(CalculatorContext* cc) override;
+  absl::Status Process(CalculatorContext* cc) override;
+
+ private:
+  // Returns the SLO state of a stream given its window of latencies.
+  LatencySloReport::State StreamState(const LatencyWindow& window) const;
+
+  // Adds `latency_usec` to the window of stream `i`.
+  void AddLatency(int i, int64_t latency_usec);
+
+  // Fills in the report for the current windows.
+  void UpdateReport();
+
+  LatencySloMonitorCalculatorOptions options_;
+  std::shared_ptr<Clock> clock_;
+  LatencySloCallback callback_;
+
+  // The timestamps and arrival times of the recent reference packets, in
+  // timestamp order.
+  std::deque<std::pair<Timestamp, int64_t>> references_;
+
+  std::vector<LatencyWindow> windows_;
+  std::vector<std::string> counter_names_;
+  LatencySloReport report_;
+  Timestamp last_output_timestamp_ = Timestamp::Unset();
+  // The last value output on AT_RISK, which can lag behind the state when
+  // the packet of a transition could not be output.
+  bool last_emitted_at_risk_ = false;
+};
+REGISTER_CALCULATOR(LatencySloMonitorCalculator);
+
+absl::Status LatencySloMonitorCalculator::GetContract(CalculatorContract* cc) {
+  RET_CHECK_GE(cc->Inputs().NumEntries(""), 1);
+  for (int i = 0; i < cc->Inputs().NumEntries(""); ++i) {
+    cc->Inputs().Get("", i).SetAny();
+  }
+  cc->Inputs().Tag(kReferenceSignalTag).SetAny();
+  cc->Outputs().Tag(kSloReportTag).Set<LatencySloReport>().Optional();
+  cc->Outputs().Tag(kAtRiskTag).Set<bool>().Optional();
+  cc->InputSidePackets()
+      .Tag(kClockTag)
+      .Set<std::shared_ptr<Clock>>()
+      .Optional();
+  cc->InputSidePackets()
+      .Tag(kSloCallbackTag)
+      .Set<LatencySloCallback>()
+      .Optional();
+  return absl::OkStatus();
+}
+
+absl::Status LatencySloMonitorCalculator::Open(CalculatorContext* cc) {
+  options_ = cc->Options<LatencySloMonitorCalculatorOptions>();
+  RET_CHECK_GT(options_.latency_budget_usec(), 0);
+  RET_CHECK(options_.budget_quantile() > 0 && options_.budget_quantile() <= 1);
+  RET_CHECK_GT(options_.window_size(), 0);
+  RET_CHECK_GT(options_.max_pending_references(), 0);
+
+  const int num_streams = cc->Inputs().NumEntries("");
+  if (!options_.packet_labels().empty()) {
+    RET_CHECK_EQ(options_.packet_labels_size(), num_streams)
+        << "Expected one packet label per monitored stream.";
+  }
+  windows_.resize(num_streams);
+  for (int i = 0; i < num_streams; ++i) {
+    auto* stream = report_.add_stream();
+    if (!options_.packet_labels().empty()) {
+      stream->set_label(options_.packet_labels(i));
+    } else {
+      const CollectionItemId id = cc->Inputs().GetId("", i);
+      stream->set_label(cc->Inputs().TagMap()->Names()[id.value()]);
+    }
+    stream->set_state(LatencySloReport::OK);
+    counter_names_.push_back(
+        absl::StrCat(stream->label(), "_over_latency_budget"));
+  }
+  report_.set_state(LatencySloReport::OK);
+
+  if (cc->InputSidePackets().HasTag(kClockTag)) {
+    clock_ = cc->InputSidePackets()
+                 .Tag(kClockTag)
+                 .Get<std::shared_ptr<Clock>>();
+  } else {
+    clock_ = std::shared_ptr<Clock>(
+        MonotonicClock::CreateSynchronizedMonotonicClock());
+  }
+  if (cc->InputSidePackets().HasTag(kSloCallbackTag)) {
+    callback_ =
+        cc->InputSidePackets().Tag(kSloCallbackTag).Get<LatencySloCallback>();
+  }
+  return absl::OkStatus();
+}
+
+LatencySloReport::State LatencySloMonitorCalculator::StreamState(
+    const LatencyWindow& window) const {
+  if (window.histogram.count() < options_.min_samples()) {
+    return LatencySloReport::OK;
+  }
+  const int64_t latency_usec =
+      window.histogram.Quantile(options_.budget_quantile());
+  if (latency_usec > options_.latency_budget_usec()) {
+    return LatencySloReport::VIOLATED;
+  }
+  if (latency_usec >
+      options_.at_risk_fraction() * options_.latency_budget_usec()) {
+    return LatencySloReport::AT_RISK;
+  }
+  return LatencySloReport::OK;
+}
+
+void LatencySloMonitorCalculator::AddLatency(int i, int64_t latency_usec) {
+  LatencyWindow& window = windows_[i];
+  window.latencies_usec.push_back(latency_usec);
+  window.histogram.Add(latency_usec);
+  if (window.latencies_usec.size() > options_.window_size()) {
+    window.histogram.Remove(window.latencies_usec.front());
+    window.latencies_usec.pop_front();
+  }
+}
+
+void LatencySloMonitorCalculator::UpdateReport() {
+  LatencySloReport::State worst_state = LatencySloReport::OK;
+  for (int i = 0; i < windows_.size(); ++i) {
+    const LogLinearHistogram& histogram = windows_[i].histogram;
+    auto* stream = report_.mutable_stream(i);
+    stream->set_num_samples(histogram.count());
+    stream->set_p50_latency_usec(histogram.Quantile(0.5));
+    stream->set_p95_latency_usec(histogram.Quantile(0.95));
+    stream->set_p99_latency_usec(histogram.Quantile(0.99));
+    stream->set_state(StreamState(windows_[i]));
+    worst_state = std::max(worst_state, stream->state());
+  }
+  report_.set_state(worst_state);
+}
+
+absl::Status LatencySloMonitorCalculator::Process(CalculatorContext* cc) {
+  const int64_t now_usec = absl::ToUnixMicros(clock_->TimeNow());
+  const Timestamp timestamp = cc->InputTimestamp();
+  if (!cc->Inputs().Tag(kReferenceSignalTag).IsEmpty()) {
+    if (references_.empty() || references_.back().first < timestamp) {
+      references_.emplace_back(timestamp, now_usec);
+    }
+    if (references_.size() > options_.max_pending_references()) {
+      references_.pop_front();
+    }
+  }
+
+  auto reference = std::lower_bound(
+      references_.begin(), references_.end(), timestamp,
+      [](const std::pair<Timestamp, int64_t>& entry, Timestamp t) {
+        return entry.first < t;
+      });
+  if (reference == references_.end() || reference->first != timestamp) {
+    return absl::OkStatus();
+  }
+  bool updated = false;
+  for (int i = 0; i < windows_.size(); ++i) {
+    if (cc->Inputs().Get("", i).IsEmpty()) continue;
+    const int64_t latency_usec = now_usec - reference->second;
+    AddLatency(i, latency_usec);
+    if (latency_usec > options_.latency_budget_usec()) {
+      cc->GetCounter(counter_names_[i])->Increment();
+    }
+    updated = true;
+  }
+  if (!updated) {
+    return absl::OkStatus();
+  }
+
+  const LatencySloReport::State previous_state = report_.state();
+  UpdateReport();
+  const bool state_changed = report_.state() != previous_state;
+  if (state_changed && callback_) {
+    callback_(report_);
+  }
+  if (last_output_timestamp_ != Timestamp::Unset() &&
+      timestamp <= last_output_timestamp_) {
+    return absl::OkStatus();
+  }
+  last_output_timestamp_ = timestamp;
+  if (cc->Outputs().HasTag(kSloReportTag)) {
+    cc->Outputs().Tag(kSloReportTag).AddPacket(
+        MakePacket<LatencySloReport>(report_).At(timestamp));
+  }
+  const bool at_risk = report_.state() != LatencySloReport::OK;
+  if (at_risk != last_emitted_at_risk_ && cc->Outputs().HasTag(kAtRiskTag)) {
+    cc->Outputs().Tag(kAtRiskTag).AddPacket(
+        MakePacket<bool>(at_risk).At(timestamp));
+    last_emitted_at_risk_ = at_risk;
+  }
+  return absl::OkStatus();
+}
+
+CalculatorGraphConfig::Node* AddLatencySloMonitor(
+    const std::string& reference_stream, const std::string& report_stream,
+    const LatencySloMonitorCalculatorOptions& options,
+    CalculatorGraphConfig* config) {
+  auto* node = config->add_node();
+  node->set_calculator("LatencySloMonitorCalculator");
+  // The monitored streams are untagged inputs, so the tags of the graph
+  // output streams are dropped.
+  for (const std::string& output_stream : config->output_stream()) {
+    node->add_input_stream(tool::ParseNameFromStream(output_stream));
+  }
+  node->add_input_stream(absl::StrCat(kReferenceSignalTag, ":",
+                                      reference_stream));
+  node->add_output_stream(absl::StrCat(kSloReportTag, ":", report_stream));
+  node->mutable_input_stream_handler()->set_input_stream_handler(
+      "ImmediateInputStreamHandler");
+  *node->mutable_options()->MutableExtension(
+      LatencySloMonitorCalculatorOptions::ext) = options;
+  return node;
+}
+
+}  // namespace mediapipe
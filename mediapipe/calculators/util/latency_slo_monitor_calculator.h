@@ -0,0 +1,51 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_CALCULATORS_UTIL_LATENCY_SLO_MONITOR_CALCULATOR_H_
+#define MEDIAPIPE_CALCULATORS_UTIL_LATENCY_SLO_MONITOR_CALCULATOR_H_
+
+#include <functional>
+#include <string>
+
+#include "mediapipe/calculators/util/latency.pb.h"
+#include "mediapipe/calculators/util/latency_slo_monitor_calculator.pb.h"
+#include "mediapipe/framework/calculator.pb.h"
+
+namespace mediapipe {
+
+// The type of the SLO_CALLBACK input side packet of
+// LatencySloMonitorCalculator, called whenever the worst state of the
+// monitored streams changes.
+using LatencySloCallback = std::function<void(const LatencySloReport&)>;
+
+// Adds a LatencySloMonitorCalculator to `config` that monitors the latency of
+// every graph output stream of `config` with respect to `reference_stream`,
+// typically the graph input stream of camera frames, and outputs its reports
+// on `report_stream`. Returns the added node, to which an SLO_CALLBACK input
+// side packet can be added.
+//
+// Example:
+//   LatencySloMonitorCalculatorOptions options;
+//   options.set_latency_budget_usec(33000);
+//   AddLatencySloMonitor("input_video", "slo_report", options, &config);
+//   MP_RETURN_IF_ERROR(graph.Initialize(config));
+//   MP_RETURN_IF_ERROR(graph.ObserveOutputStream("slo_report", ...));
+CalculatorGraphConfig::Node* AddLatencySloMonitor(
+    const std::string& reference_stream, const std::string& report_stream,
+    const LatencySloMonitorCalculatorOptions& options,
+    CalculatorGraphConfig* config);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_CALCULATORS_UTIL_LATENCY_SLO_MONITOR_CALCULATOR_H_
@@ -0,0 +1,227 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/calculators/util/latency_slo_monitor_calculator.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/calculators/util/latency.pb.h"
+#include "mediapipe/calculators/util/latency_slo_monitor_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/simulation_clock.h"
+#include "mediapipe/framework/tool/simulation_clock_executor.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+class LatencySloMonitorCalculatorTest : public ::testing::Test {
+ protected:
+  // Starts a graph monitoring the given graph input streams.
+  void StartGraph(const std::vector<std::string>& monitored_streams) {
+    CalculatorGraphConfig config =
+        ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+          input_stream: "frames"
+          node {
+            calculator: "LatencySloMonitorCalculator"
+            input_side_packet: "CLOCK:clock"
+            input_side_packet: "SLO_CALLBACK:callback"
+            input_stream: "REFERENCE_SIGNAL:frames"
+            output_stream: "SLO_REPORT:report"
+            output_stream: "AT_RISK:at_risk"
+            options {
+              [mediapipe.LatencySloMonitorCalculatorOptions.ext] {
+                latency_budget_usec: 100
+                at_risk_fraction: 0.5
+                window_size: 3
+                min_samples: 1
+              }
+            }
+            input_stream_handler {
+              input_stream_handler: "ImmediateInputStreamHandler"
+            }
+          }
+        )pb");
+    for (const std::string& stream : monitored_streams) {
+      config.add_input_stream(stream);
+      config.mutable_node(0)->add_input_stream(stream);
+    }
+    tool::AddVectorSink("report", &config, &report_packets_);
+    tool::AddVectorSink("at_risk", &config, &at_risk_packets_);
+
+    auto executor = std::make_shared<SimulationClockExecutor>(4);
+    clock_ = executor->GetClock();
+    MP_ASSERT_OK(graph_.SetExecutor("", executor));
+    MP_ASSERT_OK(graph_.Initialize(config));
+    LatencySloCallback callback = [this](const LatencySloReport& report) {
+      callback_states_.push_back(report.state());
+    };
+    MP_ASSERT_OK(graph_.StartRun(
+        {{"clock", MakePacket<std::shared_ptr<Clock>>(clock_)},
+         {"callback", MakePacket<LatencySloCallback>(callback)}}));
+    MP_ASSERT_OK(graph_.WaitUntilIdle());
+  }
+
+  // Sends a packet on `stream`, then waits `delay_usec` of simulated time.
+  void SendPacket(const std::string& stream, int64_t timestamp,
+                  int64_t delay_usec) {
+    auto* clock = dynamic_cast<SimulationClock*>(clock_.get());
+    clock->ThreadStart();
+    MP_ASSERT_OK(graph_.AddPacketToInputStream(
+        stream, MakePacket<int>(0).At(Timestamp(timestamp))));
+    clock_->Sleep(absl::Microseconds(delay_usec));
+    clock->ThreadFinish();
+  }
+
+  // Sends a frame, then the output for it `latency_usec` later.
+  void SendFrame(int64_t timestamp, int64_t latency_usec) {
+    SendPacket("frames", timestamp, latency_usec);
+    SendPacket("output", timestamp, 1000);
+  }
+
+  CalculatorGraph graph_;
+  std::shared_ptr<Clock> clock_;
+  std::vector<Packet> report_packets_;
+  std::vector<Packet> at_risk_packets_;
+  std::vector<LatencySloReport::State> callback_states_;
+};
+
+TEST_F(LatencySloMonitorCalculatorTest, ReportsQuantilesAndStateChanges) {
+  StartGraph({"output"});
+  SendFrame(0, 20);
+  SendFrame(1, 20);
+  SendFrame(2, 60);
+  SendFrame(3, 150);
+  // The window of the 3 most recent latencies is back within 50 usec.
+  SendFrame(4, 10);
+  SendFrame(5, 10);
+  SendFrame(6, 10);
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+
+  std::vector<LatencySloReport::State> states;
+  for (const Packet& packet : report_packets_) {
+    states.push_back(packet.Get<LatencySloReport>().state());
+  }
+  EXPECT_THAT(
+      states,
+      ElementsAre(LatencySloReport::OK, LatencySloReport::OK,
+                  LatencySloReport::AT_RISK, LatencySloReport::VIOLATED,
+                  LatencySloReport::VIOLATED, LatencySloReport::VIOLATED,
+                  LatencySloReport::OK));
+  const LatencySloReport& report = report_packets_[3].Get<LatencySloReport>();
+  ASSERT_EQ(report.stream_size(), 1);
+  EXPECT_EQ(report.stream(0).label(), "output");
+  EXPECT_EQ(report.stream(0).num_samples(), 3);
+  EXPECT_EQ(report.stream(0).p50_latency_usec(), 60);
+  EXPECT_GE(report.stream(0).p99_latency_usec(), 150);
+  EXPECT_LE(report.stream(0).p99_latency_usec(), 152);
+
+  EXPECT_THAT(callback_states_,
+              ElementsAre(LatencySloReport::AT_RISK, LatencySloReport::VIOLATED,
+                          LatencySloReport::OK));
+  ASSERT_EQ(at_risk_packets_.size(), 2);
+  EXPECT_EQ(at_risk_packets_[0].Timestamp(), Timestamp(2));
+  EXPECT_TRUE(at_risk_packets_[0].Get<bool>());
+  EXPECT_EQ(at_risk_packets_[1].Timestamp(), Timestamp(6));
+  EXPECT_FALSE(at_risk_packets_[1].Get<bool>());
+}
+
+TEST_F(LatencySloMonitorCalculatorTest, OutputsSkippedAtRiskChangeLater) {
+  StartGraph({"fast", "slow"});
+  SendPacket("frames", 0, 0);
+  SendPacket("frames", 1, 10);
+  SendPacket("fast", 1, 1000);
+  // The slow stream turns the state AT_RISK on a packet older than the last
+  // report, so that change cannot be output at its timestamp.
+  SendPacket("slow", 0, 1000);
+  SendPacket("frames", 2, 10);
+  SendPacket("fast", 2, 1000);
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+
+  EXPECT_THAT(callback_states_, ElementsAre(LatencySloReport::VIOLATED));
+  ASSERT_EQ(at_risk_packets_.size(), 1);
+  EXPECT_EQ(at_risk_packets_[0].Timestamp(), Timestamp(2));
+  EXPECT_TRUE(at_risk_packets_[0].Get<bool>());
+}
+
+TEST(AddLatencySloMonitorTest, MonitorsAllGraphOutputStreams) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "frames"
+    output_stream: "a"
+    output_stream: "b"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "frames"
+      input_stream: "frames"
+      output_stream: "a"
+      output_stream: "b"
+    }
+  )pb");
+  LatencySloMonitorCalculatorOptions options;
+  options.set_latency_budget_usec(33000);
+  const CalculatorGraphConfig::Node* node =
+      AddLatencySloMonitor("frames", "report", options, &config);
+
+  EXPECT_EQ(node->calculator(), "LatencySloMonitorCalculator");
+  EXPECT_THAT(node->input_stream(),
+              ElementsAre("a", "b", "REFERENCE_SIGNAL:frames"));
+  EXPECT_THAT(node->output_stream(), ElementsAre("SLO_REPORT:report"));
+  EXPECT_EQ(node->options()
+                .GetExtension(LatencySloMonitorCalculatorOptions::ext)
+                .latency_budget_usec(),
+            33000);
+  CalculatorGraph graph;
+  MP_EXPECT_OK(graph.Initialize(config));
+}
+
+TEST(AddLatencySloMonitorTest, DropsTagsOfGraphOutputStreams) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "frames"
+    output_stream: "DETECTIONS:a"
+    output_stream: "b"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "frames"
+      input_stream: "frames"
+      output_stream: "a"
+      output_stream: "b"
+    }
+  )pb");
+  LatencySloMonitorCalculatorOptions options;
+  options.set_latency_budget_usec(33000);
+  const CalculatorGraphConfig::Node* node =
+      AddLatencySloMonitor("frames", "report", options, &config);
+
+  EXPECT_THAT(node->input_stream(),
+              ElementsAre("a", "b", "REFERENCE_SIGNAL:frames"));
+  CalculatorGraph graph;
+  MP_EXPECT_OK(graph.Initialize(config));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -22,7 +22,9 @@
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/resources.h"
+#include "mediapipe/framework/shared_resource_cache.h"
 #include "mediapipe/util/resource_util.h"
+#include "mediapipe/util/resource_util_custom.h"
 
 namespace mediapipe {
 
@@ -39,6 +41,9 @@ constexpr char kContentsTag[] = "CONTENTS";
 // NOTE: file loading can be batched by providing multiple input/output side
 // packets.
 //
+// NOTE: with the share_contents option, graph instances that load the same
+// file share its contents instead of holding a copy each.
+//
 // Example config:
 // node {
 //   calculator: "LocalFileContentsCalculator"
@@ -92,6 +97,17 @@ class LocalFileContentsCalculator : public CalculatorBase {
           cc->InputSidePackets().Get(input_id).Get<std::string>();
       MP_ASSIGN_OR_RETURN(file_path, PathToResourceAsFile(file_path));
 
+      if (options.share_contents() && !options.text_mode() &&
+          !HasCustomGlobalResourceProvider()) {
+        MP_ASSIGN_OR_RETURN(
+            std::shared_ptr<const std::string> contents,
+            SharedResourceCache::Global().GetString(file_path));
+        const std::string* contents_ptr = contents.get();
+        cc->OutputSidePackets().Get(output_id).Set(PointToForeign(
+            contents_ptr, [contents = std::move(contents)]() {}));
+        continue;
+      }
+
       MP_ASSIGN_OR_RETURN(
           std::unique_ptr<Resource> resource,
           cc->GetResources().Get(file_path,
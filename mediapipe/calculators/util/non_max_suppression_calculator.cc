@@ -13,7 +13,10 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +28,7 @@
 #include "mediapipe/framework/formats/detection.pb.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/location.h"
+#include "mediapipe/framework/formats/run_length_mask.h"
 #include "mediapipe/framework/port/rectangle.h"
 #include "mediapipe/framework/port/status.h"
 
@@ -98,6 +102,28 @@ float OverlapSimilarity(
   return normalization > 0.0f ? intersection_area / normalization : 0.0f;
 }
 
+// Computes an overlap similarity between two masks from their runs, with the
+// areas of the masks in place of the areas of rectangles.
+float OverlapSimilarity(
+    const NonMaxSuppressionCalculatorOptions::OverlapType overlap_type,
+    const RunLengthMask& mask1, const RunLengthMask& mask2) {
+  const int64_t intersection_area = IntersectionArea(mask1, mask2);
+  if (intersection_area == 0) return 0.0f;
+  int64_t normalization;
+  switch (overlap_type) {
+    case NonMaxSuppressionCalculatorOptions::JACCARD:
+    case NonMaxSuppressionCalculatorOptions::INTERSECTION_OVER_UNION:
+      normalization = mask1.Area() + mask2.Area() - intersection_area;
+      break;
+    case NonMaxSuppressionCalculatorOptions::MODIFIED_JACCARD:
+      normalization = mask2.Area();
+      break;
+    default:
+      ABSL_LOG(FATAL) << "Unrecognized overlap type: " << overlap_type;
+  }
+  return static_cast<float>(intersection_area) / normalization;
+}
+
 // Computes an overlap similarity between two locations by first extracting the
 // relative box (dimension normalized by frame width/height) from the location.
 float OverlapSimilarity(
@@ -121,6 +147,163 @@ float OverlapSimilarity(
   return OverlapSimilarity(overlap_type, rect1, rect2);
 }
 
+// A relative bounding box with the coordinates and area of the Rectangle_f that
+// Location::GetRelativeBBox() returns for it.
+struct Box {
+  float xmin;
+  float ymin;
+  float xmax;
+  float ymax;
+  float area;
+};
+
+Box MakeBox(const LocationData::RelativeBoundingBox& box) {
+  const Rectangle_f rect(box.xmin(), box.ymin(), box.width(), box.height());
+  return {rect.xmin(), rect.ymin(), rect.xmax(), rect.ymax(), rect.Area()};
+}
+
+// Boxes in a structure-of-arrays layout, so that the overlap similarities of
+// one box with all of them are computed in loops that the compiler vectorizes.
+class BoxBuffer {
+ public:
+  void Reserve(size_t size) {
+    xmin_.reserve(size);
+    ymin_.reserve(size);
+    xmax_.reserve(size);
+    ymax_.reserve(size);
+  }
+
+  void Clear() {
+    xmin_.clear();
+    ymin_.clear();
+    xmax_.clear();
+    ymax_.clear();
+  }
+
+  void Add(const Box& box) {
+    xmin_.push_back(box.xmin);
+    ymin_.push_back(box.ymin);
+    xmax_.push_back(box.xmax);
+    ymax_.push_back(box.ymax);
+  }
+
+  Box Get(int i) const {
+    return {xmin_[i], ymin_[i], xmax_[i], ymax_[i],
+            (xmax_[i] - xmin_[i]) * (ymax_[i] - ymin_[i])};
+  }
+
+  int size() const { return static_cast<int>(xmin_.size()); }
+
+  // Sets `similarities[i]` to OverlapSimilarity(overlap_type, box i, `rect2`)
+  // for all boxes, with bit-identical results. `similarities` must hold size()
+  // values. Returns false for an unrecognized overlap type.
+  bool OverlapSimilarities(
+      NonMaxSuppressionCalculatorOptions::OverlapType overlap_type,
+      const Box& rect2, float* similarities) const {
+    switch (overlap_type) {
+      case NonMaxSuppressionCalculatorOptions::JACCARD:
+        OverlapSimilarities<NonMaxSuppressionCalculatorOptions::JACCARD>(
+            rect2, similarities);
+        return true;
+      case NonMaxSuppressionCalculatorOptions::MODIFIED_JACCARD:
+        OverlapSimilarities<
+            NonMaxSuppressionCalculatorOptions::MODIFIED_JACCARD>(rect2,
+                                                                  similarities);
+        return true;
+      case NonMaxSuppressionCalculatorOptions::INTERSECTION_OVER_UNION:
+        OverlapSimilarities<
+            NonMaxSuppressionCalculatorOptions::INTERSECTION_OVER_UNION>(
+            rect2, similarities);
+        return true;
+      default:
+        return false;
+    }
+  }
+
+ private:
+  // Mirrors the Rectangle_f operations of OverlapSimilarity without branches,
+  // keeping the order of the operands of each operation. The division is done
+  // in a separate pass, since the compiler does not turn a selection between
+  // a quotient and zero into a vector blend. Areas are recomputed rather than
+  // loaded, which keeps the number of arrays within the aliasing checks that
+  // the compiler emits for a vectorized loop.
+  template <NonMaxSuppressionCalculatorOptions::OverlapType kOverlapType>
+  void OverlapSimilarities(const Box& rect2, float* similarities) const {
+    using Options = NonMaxSuppressionCalculatorOptions;
+    const int n = size();
+    divisors_.resize(n);
+    const float* xmin = xmin_.data();
+    const float* ymin = ymin_.data();
+    const float* xmax = xmax_.data();
+    const float* ymax = ymax_.data();
+    float* divisors = divisors_.data();
+    const float xmin2 = rect2.xmin;
+    const float ymin2 = rect2.ymin;
+    const float xmax2 = rect2.xmax;
+    const float ymax2 = rect2.ymax;
+    const float area2 = rect2.area;
+    if (xmin2 > xmax2 || ymin2 > ymax2) {
+      // An empty rectangle intersects none.
+      std::fill(similarities, similarities + n, 0.0f);
+      return;
+    }
+    for (int i = 0; i < n; ++i) {
+      const float xmin1 = xmin[i];
+      const float ymin1 = ymin[i];
+      const float xmax1 = xmax[i];
+      const float ymax1 = ymax[i];
+      const bool intersects =
+          !((xmin1 > xmax1) | (ymin1 > ymax1) | (xmax2 < xmin1) |
+            (xmax1 < xmin2) | (ymax2 < ymin1) | (ymax1 < ymin2));
+      const float intersection_area =
+          (std::min(xmax1, xmax2) - std::max(xmin1, xmin2)) *
+          (std::min(ymax1, ymax2) - std::max(ymin1, ymin2));
+      float normalization;
+      if constexpr (kOverlapType == Options::JACCARD) {
+        normalization = (std::max(xmax1, xmax2) - std::min(xmin1, xmin2)) *
+                        (std::max(ymax1, ymax2) - std::min(ymin1, ymin2));
+      } else if constexpr (kOverlapType == Options::MODIFIED_JACCARD) {
+        normalization = area2;
+      } else {
+        const float area1 = (xmax1 - xmin1) * (ymax1 - ymin1);
+        normalization = area1 + area2 - intersection_area;
+      }
+      // A similarity of zero is computed as 0 / 1.
+      const bool nonzero = intersects & (normalization > 0.0f);
+      similarities[i] = nonzero ? intersection_area : 0.0f;
+      divisors[i] = nonzero ? normalization : 1.0f;
+    }
+    for (int i = 0; i < n; ++i) {
+      similarities[i] /= divisors[i];
+    }
+  }
+
+  std::vector<float> xmin_;
+  std::vector<float> ymin_;
+  std::vector<float> xmax_;
+  std::vector<float> ymax_;
+  // Scratch space of OverlapSimilarities.
+  mutable std::vector<float> divisors_;
+};
+
+// Returns true if the overlap similarities of `detections` can be computed with
+// a BoxBuffer, which requires relative bounding boxes.
+bool CanUseBoxBuffer(
+    const NonMaxSuppressionCalculatorOptions::OverlapType overlap_type,
+    const Detections& detections) {
+  if (overlap_type != NonMaxSuppressionCalculatorOptions::JACCARD &&
+      overlap_type != NonMaxSuppressionCalculatorOptions::MODIFIED_JACCARD &&
+      overlap_type !=
+          NonMaxSuppressionCalculatorOptions::INTERSECTION_OVER_UNION) {
+    return false;
+  }
+  return std::all_of(
+      detections.begin(), detections.end(), [](const Detection& detection) {
+        return detection.location_data().format() ==
+               LocationData::RELATIVE_BOUNDING_BOX;
+      });
+}
+
 }  // namespace
 
 // A calculator performing non-maximum suppression on a set of detections.
@@ -253,8 +436,21 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
   void NonMaxSuppression(const IndexedScores& indexed_scores,
                          const Detections& detections, int max_num_detections,
                          CalculatorContext* cc, Detections* output_detections) {
+    // Relative bounding boxes, which need no conversion with the frame size,
+    // are kept in a BoxBuffer instead of Locations.
+    const bool use_box_buffer =
+        CanUseBoxBuffer(options_.overlap_type(), detections);
     std::vector<Location> retained_locations;
-    retained_locations.reserve(max_num_detections);
+    // The masks of the retained locations, when use_mask_overlap is set and
+    // the location is a mask.
+    std::vector<std::optional<RunLengthMask>> retained_masks;
+    BoxBuffer retained_boxes;
+    std::vector<float> similarities;
+    if (use_box_buffer) {
+      retained_boxes.Reserve(max_num_detections);
+    } else {
+      retained_locations.reserve(max_num_detections);
+    }
     // We traverse the detections by decreasing score.
     for (const auto& indexed_score : indexed_scores) {
       const auto& detection = detections[indexed_score.first];
@@ -262,14 +458,42 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
           detection.score(0) < options_.min_score_threshold()) {
         break;
       }
+      if (use_box_buffer) {
+        const Box box =
+            MakeBox(detection.location_data().relative_bounding_box());
+        similarities.resize(retained_boxes.size());
+        retained_boxes.OverlapSimilarities(options_.overlap_type(), box,
+                                           similarities.data());
+        const bool suppressed = std::any_of(
+            similarities.begin(), similarities.end(), [this](float s) {
+              return s > options_.min_suppression_threshold();
+            });
+        if (!suppressed) {
+          output_detections->push_back(detection);
+          retained_boxes.Add(box);
+        }
+        if (output_detections->size() >= max_num_detections) {
+          break;
+        }
+        continue;
+      }
       const Location location(detection.location_data());
+      std::optional<RunLengthMask> mask;
+      if (options_.use_mask_overlap() &&
+          detection.location_data().format() == LocationData::MASK) {
+        mask = RunLengthMask::FromBinaryMask(detection.location_data().mask());
+      }
       bool suppressed = false;
       // The current detection is suppressed iff there exists a retained
       // detection, whose location overlaps more than the specified
       // threshold with the location of the current detection.
-      for (const auto& retained_location : retained_locations) {
+      for (size_t i = 0; i < retained_locations.size(); ++i) {
+        const Location& retained_location = retained_locations[i];
         float similarity;
-        if (cc->Inputs().HasTag(kImageTag)) {
+        if (mask.has_value() && retained_masks[i].has_value()) {
+          similarity = OverlapSimilarity(options_.overlap_type(),
+                                         *retained_masks[i], *mask);
+        } else if (cc->Inputs().HasTag(kImageTag)) {
           const auto& frame = cc->Inputs().Tag(kImageTag).Get<ImageFrame>();
           similarity = OverlapSimilarity(frame.Width(), frame.Height(),
                                          options_.overlap_type(),
@@ -286,6 +510,7 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
       if (!suppressed) {
         output_detections->push_back(detection);
         retained_locations.push_back(location);
+        retained_masks.push_back(std::move(mask));
       }
       if (output_detections->size() >= max_num_detections) {
         break;
@@ -301,6 +526,22 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
     remained_indexed_scores.assign(indexed_scores.begin(),
                                    indexed_scores.end());
 
+    // The boxes of remained_indexed_scores, in the same order.
+    const bool use_box_buffer =
+        CanUseBoxBuffer(options_.overlap_type(), detections);
+    BoxBuffer remained_boxes;
+    BoxBuffer next_remained_boxes;
+    std::vector<float> similarities;
+    if (use_box_buffer) {
+      remained_boxes.Reserve(indexed_scores.size());
+      next_remained_boxes.Reserve(indexed_scores.size());
+      for (const auto& indexed_score : indexed_scores) {
+        remained_boxes.Add(MakeBox(detections[indexed_score.first]
+                                       .location_data()
+                                       .relative_bounding_box()));
+      }
+    }
+
     IndexedScores remained;
     IndexedScores candidates;
     output_detections->clear();
@@ -313,16 +554,28 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
       }
       remained.clear();
       candidates.clear();
-      const Location location(detection.location_data());
+      similarities.resize(remained_indexed_scores.size());
+      if (use_box_buffer) {
+        remained_boxes.OverlapSimilarities(options_.overlap_type(),
+                                           remained_boxes.Get(0),
+                                           similarities.data());
+      } else {
+        const Location location(detection.location_data());
+        for (int i = 0; i < remained_indexed_scores.size(); ++i) {
+          Location rest_location(
+              detections[remained_indexed_scores[i].first].location_data());
+          similarities[i] = OverlapSimilarity(options_.overlap_type(),
+                                              rest_location, location);
+        }
+      }
+      next_remained_boxes.Clear();
       // This includes the first box.
-      for (const auto& indexed_score : remained_indexed_scores) {
-        Location rest_location(detections[indexed_score.first].location_data());
-        float similarity =
-            OverlapSimilarity(options_.overlap_type(), rest_location, location);
-        if (similarity > options_.min_suppression_threshold()) {
-          candidates.push_back(indexed_score);
+      for (int i = 0; i < remained_indexed_scores.size(); ++i) {
+        if (similarities[i] > options_.min_suppression_threshold()) {
+          candidates.push_back(remained_indexed_scores[i]);
         } else {
-          remained.push_back(indexed_score);
+          remained.push_back(remained_indexed_scores[i]);
+          if (use_box_buffer) next_remained_boxes.Add(remained_boxes.Get(i));
         }
       }
       auto weighted_detection = detection;
@@ -375,6 +628,7 @@ class NonMaxSuppressionCalculator : public CalculatorBase {
         break;
       } else {
         remained_indexed_scores = std::move(remained);
+        std::swap(remained_boxes, next_remained_boxes);
       }
     }
   }
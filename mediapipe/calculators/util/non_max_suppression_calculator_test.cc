@@ -0,0 +1,177 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/calculators/util/non_max_suppression_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+using ::testing::Property;
+using Node = ::mediapipe::CalculatorGraphConfig::Node;
+
+Detection RelativeDetection(float score, float xmin, float ymin, float width,
+                            float height) {
+  Detection detection;
+  detection.add_score(score);
+  detection.add_label_id(0);
+  LocationData* location_data = detection.mutable_location_data();
+  location_data->set_format(LocationData::RELATIVE_BOUNDING_BOX);
+  auto* box = location_data->mutable_relative_bounding_box();
+  box->set_xmin(xmin);
+  box->set_ymin(ymin);
+  box->set_width(width);
+  box->set_height(height);
+  return detection;
+}
+
+Detection AbsoluteDetection(float score, int xmin, int ymin, int width,
+                            int height) {
+  Detection detection;
+  detection.add_score(score);
+  detection.add_label_id(0);
+  LocationData* location_data = detection.mutable_location_data();
+  location_data->set_format(LocationData::BOUNDING_BOX);
+  auto* box = location_data->mutable_bounding_box();
+  box->set_xmin(xmin);
+  box->set_ymin(ymin);
+  box->set_width(width);
+  box->set_height(height);
+  return detection;
+}
+
+// A detection with a 10x10 mask covering columns [left_x, right_x] of rows
+// [ymin, ymax].
+Detection MaskDetection(float score, int left_x, int right_x, int ymin,
+                        int ymax) {
+  Detection detection;
+  detection.add_score(score);
+  detection.add_label_id(0);
+  LocationData* location_data = detection.mutable_location_data();
+  location_data->set_format(LocationData::MASK);
+  auto* mask = location_data->mutable_mask();
+  mask->set_width(10);
+  mask->set_height(10);
+  for (int y = ymin; y <= ymax; ++y) {
+    auto* interval = mask->mutable_rasterization()->add_interval();
+    interval->set_y(y);
+    interval->set_left_x(left_x);
+    interval->set_right_x(right_x);
+  }
+  return detection;
+}
+
+Node MakeNode(const std::string& algorithm, bool with_image = false) {
+  return ParseTextProtoOrDie<Node>(absl::StrCat(
+      R"pb(
+        calculator: "NonMaxSuppressionCalculator"
+        input_stream: "detections"
+        output_stream: "nms_detections"
+      )pb",
+      with_image ? R"pb(input_stream: "IMAGE:image")pb" : "",
+      R"pb(
+        options {
+          [mediapipe.NonMaxSuppressionCalculatorOptions.ext] {
+            min_suppression_threshold: 0.3
+            overlap_type: INTERSECTION_OVER_UNION
+            algorithm: )pb",
+      algorithm, "\n}\n}"));
+}
+
+// Two overlapping detections, with an intersection over union of 0.39, and a
+// separate one.
+std::vector<Detection> MakeRelativeDetections() {
+  return {RelativeDetection(0.6f, 0.1f, 0.1f, 0.4f, 0.4f),
+          RelativeDetection(0.9f, 0.0f, 0.0f, 0.4f, 0.4f),
+          RelativeDetection(0.5f, 0.6f, 0.6f, 0.2f, 0.2f)};
+}
+
+const std::vector<Detection>& RunCalculator(
+    CalculatorRunner& runner, const std::vector<Detection>& detections) {
+  runner.MutableInputs()->Index(0).packets.push_back(
+      MakePacket<std::vector<Detection>>(detections).At(Timestamp(0)));
+  MP_EXPECT_OK(runner.Run());
+  return runner.Outputs().Index(0).packets[0].Get<std::vector<Detection>>();
+}
+
+auto HasScore(float score) {
+  return Property(&Detection::score, ElementsAre(FloatEq(score)));
+}
+
+TEST(NonMaxSuppressionCalculatorTest, SuppressesOverlappingDetections) {
+  CalculatorRunner runner(MakeNode("DEFAULT"));
+  EXPECT_THAT(RunCalculator(runner, MakeRelativeDetections()),
+              ElementsAre(HasScore(0.9f), HasScore(0.5f)));
+}
+
+TEST(NonMaxSuppressionCalculatorTest, SuppressesAbsoluteBoundingBoxes) {
+  CalculatorRunner runner(MakeNode("DEFAULT", /*with_image=*/true));
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      MakePacket<ImageFrame>(ImageFormat::SRGB, 100, 100).At(Timestamp(0)));
+  EXPECT_THAT(RunCalculator(runner, {AbsoluteDetection(0.6f, 10, 10, 40, 40),
+                                     AbsoluteDetection(0.9f, 0, 0, 40, 40),
+                                     AbsoluteDetection(0.5f, 60, 60, 20, 20)}),
+              ElementsAre(HasScore(0.9f), HasScore(0.5f)));
+}
+
+TEST(NonMaxSuppressionCalculatorTest, ComparesMasksByPixels) {
+  Node node = MakeNode("DEFAULT");
+  node.mutable_options()
+      ->MutableExtension(NonMaxSuppressionCalculatorOptions::ext)
+      ->set_use_mask_overlap(true);
+  CalculatorRunner runner(node);
+  // The vertical and horizontal bars share no pixel. The last mask covers
+  // half of the vertical bar.
+  EXPECT_THAT(RunCalculator(runner, {MaskDetection(0.9f, 0, 1, 0, 9),
+                                     MaskDetection(0.8f, 2, 9, 0, 1),
+                                     MaskDetection(0.7f, 0, 1, 5, 9)}),
+              ElementsAre(HasScore(0.9f), HasScore(0.8f)));
+}
+
+TEST(NonMaxSuppressionCalculatorTest, WeightsOverlappingDetections) {
+  CalculatorRunner runner(MakeNode("WEIGHTED"));
+  const std::vector<Detection>& detections =
+      RunCalculator(runner, MakeRelativeDetections());
+  ASSERT_EQ(detections.size(), 2);
+  const auto& weighted_box =
+      detections[0].location_data().relative_bounding_box();
+  EXPECT_THAT(detections[0], HasScore(0.9f));
+  // The boxes are averaged with the weights 0.9 and 0.6.
+  EXPECT_NEAR(weighted_box.xmin(), 0.04f, 1e-6f);
+  EXPECT_NEAR(weighted_box.ymin(), 0.04f, 1e-6f);
+  EXPECT_NEAR(weighted_box.width(), 0.4f, 1e-6f);
+  EXPECT_NEAR(weighted_box.height(), 0.4f, 1e-6f);
+  EXPECT_THAT(detections[1], HasScore(0.5f));
+  EXPECT_FLOAT_EQ(detections[1].location_data().relative_bounding_box().xmin(),
+                  0.6f);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,137 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/calculators/util/packet_recorder_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/deps/monotonic_clock.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/tool/packet_log.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Tag name for clock side packet.
+constexpr char kClockTag[] = "CLOCK";
+
+}  // namespace
+
+// Records the packets of its input streams to a packet log file, together with
+// their timestamps and the times at which they arrived. The log can be
+// replayed into a graph with tool::ReplayPacketLog() to benchmark the graph
+// offline against the recorded traffic.
+//
+// Packets must hold protobuf messages or types registered with serialize
+// functions. Each packet is recorded under the name of its input stream, so
+// that a replay feeds it to the graph input stream of the same name.
+//
+// InputSidePacket (Optional):
+// CLOCK: A clock (std::shared_ptr<::mediapipe::Clock>) for the arrival times.
+//   Defaults to a monotonic clock.
+//
+// Inputs:
+// Any number of streams of any type.
+//
+// Example config:
+// node {
+//   calculator: "PacketRecorderCalculator"
+//   input_stream: "detections"
+//   input_stream: "rects"
+//   options {
+//     [mediapipe.PacketRecorderCalculatorOptions.ext] {
+//       output_path: "/tmp/traffic.log"
+//     }
+//   }
+//   input_stream_handler {
+//     input_stream_handler: 'ImmediateInputStreamHandler'
+//   }
+// }
+class PacketRecorderCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    for (CollectionItemId id = cc->Inputs().BeginId();
+         id < cc->Inputs().EndId(); ++id) {
+      cc->Inputs().Get(id).SetAny();
+    }
+    if (cc->InputSidePackets().HasTag(kClockTag)) {
+      cc->InputSidePackets()
+          .Tag(kClockTag)
+          .Set<std::shared_ptr<::mediapipe::Clock>>();
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    const auto& options = cc->Options<PacketRecorderCalculatorOptions>();
+    RET_CHECK(!options.output_path().empty())
+        << "PacketRecorderCalculator requires an output_path.";
+    if (cc->InputSidePackets().HasTag(kClockTag)) {
+      clock_ = cc->InputSidePackets()
+                   .Tag(kClockTag)
+                   .Get<std::shared_ptr<::mediapipe::Clock>>();
+    } else {
+      clock_ = std::shared_ptr<::mediapipe::Clock>(
+          ::mediapipe::MonotonicClock::CreateSynchronizedMonotonicClock());
+    }
+    const std::vector<std::string>& names = cc->Inputs().TagMap()->Names();
+    stream_names_.assign(names.begin(), names.end());
+    return writer_.Open(options.output_path());
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const absl::Time now = clock_->TimeNow();
+    if (first_record_time_ == absl::InfinitePast()) {
+      first_record_time_ = now;
+    }
+    const int64_t record_time_us =
+        absl::ToInt64Microseconds(now - first_record_time_);
+    for (CollectionItemId id = cc->Inputs().BeginId();
+         id < cc->Inputs().EndId(); ++id) {
+      const Packet& packet = cc->Inputs().Get(id).Value();
+      if (packet.IsEmpty()) {
+        continue;
+      }
+      MP_ASSIGN_OR_RETURN(
+          PacketLogRecord record,
+          tool::PacketToLogRecord(stream_names_[id.value()], packet));
+      record.set_record_time_us(record_time_us);
+      MP_RETURN_IF_ERROR(writer_.Write(record));
+    }
+    return absl::OkStatus();
+  }
+
+  absl::Status Close(CalculatorContext* cc) override {
+    return writer_.Close();
+  }
+
+ private:
+  std::shared_ptr<::mediapipe::Clock> clock_;
+  absl::Time first_record_time_ = absl::InfinitePast();
+  // The name of each input stream, by CollectionItemId.
+  std::vector<std::string> stream_names_;
+  tool::PacketLogWriter writer_;
+};
+
+REGISTER_CALCULATOR(PacketRecorderCalculator);
+
+}  // namespace mediapipe
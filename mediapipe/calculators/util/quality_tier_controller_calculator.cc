@@ -0,0 +1,194 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+
+#include "mediapipe/calculators/util/latency.pb.h"
+#include "mediapipe/calculators/util/quality_tier_controller_calculator.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kSloReportTag[] = "SLO_REPORT";
+constexpr char kThermalStateTag[] = "THERMAL_STATE";
+constexpr char kSelectTag[] = "SELECT";
+
+}  // namespace
+
+// Selects the quality tier of a graph, e.g. a lite, full or heavy landmark
+// model contained in a SwitchContainer, to keep its latency within budget.
+//
+// The tier steps down one level after downgrade_after_violated_reports
+// consecutive VIOLATED reports from a LatencySloMonitorCalculator, and steps
+// back up one level after upgrade_after_ok_reports consecutive OK reports.
+// AT_RISK reports hold the current tier. A THERMAL_STATE, such as the Android
+// thermal status or the iOS thermal state, caps the tier according to
+// max_tier_for_thermal_state.
+//
+// Steps down take effect at once. Steps up, including the ones allowed when
+// the device cools down, wait min_upgrade_interval_usec after the previous
+// switch, so that the latency can settle at the new tier.
+//
+// The selected tier is output on the first input packet and whenever it
+// changes. The SwitchContainer should start on the same tier, through its
+// "select" option.
+//
+// NOTE: The contained nodes of a SwitchContainer are all opened with the
+// graph, so the models of the inactive tiers stay loaded.
+//
+// Inputs:
+// SLO_REPORT (optional): A LatencySloReport.
+// THERMAL_STATE (optional): An int, higher for hotter states.
+//
+// Outputs:
+// SELECT: The selected tier as an int.
+//
+// Example config:
+// node {
+//   calculator: "QualityTierControllerCalculator"
+//   input_stream: "SLO_REPORT:slo_report"
+//   input_stream: "THERMAL_STATE:thermal_state"
+//   output_stream: "SELECT:tier"
+//   options {
+//     [mediapipe.QualityTierControllerCalculatorOptions.ext] {
+//       num_tiers: 3
+//       initial_tier: 1
+//       max_tier_for_thermal_state: [ 2, 2, 1, 0 ]
+//     }
+//   }
+// }
+// node {
+//   calculator: "SwitchContainer"
+//   input_stream: "SELECT:tier"
+//   input_stream: "IMAGE:image"
+//   output_stream: "LANDMARKS:landmarks"
+//   options {
+//     [mediapipe.SwitchContainerOptions.ext] {
+//       select: 1
+//       async_selection: true
+//       contained_node: { calculator: "PoseLandmarkLiteSubgraph" }
+//       contained_node: { calculator: "PoseLandmarkFullSubgraph" }
+//       contained_node: { calculator: "PoseLandmarkHeavySubgraph" }
+//     }
+//   }
+// }
+class QualityTierControllerCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Tag(kSloReportTag).Set<LatencySloReport>().Optional();
+    cc->Inputs().Tag(kThermalStateTag).Set<int>().Optional();
+    cc->Outputs().Tag(kSelectTag).Set<int>();
+    cc->SetInputStreamHandler("ImmediateInputStreamHandler");
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<QualityTierControllerCalculatorOptions>();
+    RET_CHECK_GT(options_.num_tiers(), 0);
+    RET_CHECK_LT(options_.initial_tier(), options_.num_tiers());
+    RET_CHECK_GT(options_.upgrade_after_ok_reports(), 0);
+    RET_CHECK_GT(options_.downgrade_after_violated_reports(), 0);
+    max_tier_ = options_.num_tiers() - 1;
+    desired_tier_ = options_.initial_tier() < 0 ? max_tier_
+                                                : options_.initial_tier();
+    thermal_max_tier_ = max_tier_;
+    tier_ = desired_tier_;
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const Timestamp timestamp = cc->InputTimestamp();
+    if (!cc->Inputs().Tag(kSloReportTag).IsEmpty()) {
+      UpdateDesiredTier(
+          cc->Inputs().Tag(kSloReportTag).Get<LatencySloReport>());
+    }
+    if (!cc->Inputs().Tag(kThermalStateTag).IsEmpty()) {
+      const int state = cc->Inputs().Tag(kThermalStateTag).Get<int>();
+      RET_CHECK_GE(state, 0);
+      const auto& caps = options_.max_tier_for_thermal_state();
+      if (!caps.empty()) {
+        thermal_max_tier_ = caps[std::min(state, caps.size() - 1)];
+      }
+    }
+
+    const int target_tier =
+        std::clamp(std::min(desired_tier_, thermal_max_tier_), 0, max_tier_);
+    if (last_output_timestamp_ == Timestamp::Unset()) {
+      tier_ = target_tier;
+    } else if (timestamp <= last_output_timestamp_) {
+      // With the ImmediateInputStreamHandler, the two input streams can arrive
+      // out of timestamp order. A switch then waits for the next packet.
+      return absl::OkStatus();
+    } else if (target_tier < tier_ ||
+               (target_tier > tier_ &&
+                (timestamp - last_output_timestamp_).Value() >=
+                    options_.min_upgrade_interval_usec())) {
+      tier_ = target_tier;
+    } else {
+      return absl::OkStatus();
+    }
+    last_output_timestamp_ = timestamp;
+    cc->Outputs().Tag(kSelectTag).AddPacket(
+        MakePacket<int>(tier_).At(timestamp));
+    return absl::OkStatus();
+  }
+
+ private:
+  void UpdateDesiredTier(const LatencySloReport& report) {
+    switch (report.state()) {
+      case LatencySloReport::OK:
+        ++num_ok_reports_;
+        num_violated_reports_ = 0;
+        break;
+      case LatencySloReport::AT_RISK:
+        num_ok_reports_ = 0;
+        num_violated_reports_ = 0;
+        break;
+      case LatencySloReport::VIOLATED:
+        num_ok_reports_ = 0;
+        ++num_violated_reports_;
+        break;
+    }
+    // Steps are taken from the current tier, which can be below the desired
+    // one while the tier is capped or an upgrade is pending.
+    if (num_violated_reports_ >= options_.downgrade_after_violated_reports()) {
+      desired_tier_ = std::max(tier_ - 1, 0);
+      num_violated_reports_ = 0;
+    } else if (num_ok_reports_ >= options_.upgrade_after_ok_reports()) {
+      desired_tier_ = std::min(tier_ + 1, max_tier_);
+      num_ok_reports_ = 0;
+    }
+  }
+
+  QualityTierControllerCalculatorOptions options_;
+  int max_tier_ = 0;
+  // The tier requested by the latency reports, before the thermal cap.
+  int desired_tier_ = 0;
+  int thermal_max_tier_ = 0;
+  // The selected tier.
+  int tier_ = 0;
+  int num_ok_reports_ = 0;
+  int num_violated_reports_ = 0;
+  // The timestamp of the last switch.
+  Timestamp last_output_timestamp_ = Timestamp::Unset();
+};
+REGISTER_CALCULATOR(QualityTierControllerCalculator);
+
+}  // namespace mediapipe
@@ -0,0 +1,126 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "mediapipe/calculators/util/latency.pb.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+
+class QualityTierControllerCalculatorTest : public ::testing::Test {
+ protected:
+  void StartGraph(const std::string& options) {
+    auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(absl::StrCat(
+        R"pb(
+          input_stream: "slo_report"
+          input_stream: "thermal_state"
+          node {
+            calculator: "QualityTierControllerCalculator"
+            input_stream: "SLO_REPORT:slo_report"
+            input_stream: "THERMAL_STATE:thermal_state"
+            output_stream: "SELECT:tier"
+            options {
+              [mediapipe.QualityTierControllerCalculatorOptions.ext] {
+        )pb",
+        options, R"pb(
+              }
+            }
+          }
+        )pb"));
+    tool::AddVectorSink("tier", &config, &tier_packets_);
+    MP_ASSERT_OK(graph_.Initialize(config));
+    MP_ASSERT_OK(graph_.StartRun({}));
+  }
+
+  void SendReport(int64_t timestamp, LatencySloReport::State state) {
+    LatencySloReport report;
+    report.set_state(state);
+    MP_ASSERT_OK(graph_.AddPacketToInputStream(
+        "slo_report",
+        MakePacket<LatencySloReport>(report).At(Timestamp(timestamp))));
+    MP_ASSERT_OK(graph_.WaitUntilIdle());
+  }
+
+  void SendThermalState(int64_t timestamp, int state) {
+    MP_ASSERT_OK(graph_.AddPacketToInputStream(
+        "thermal_state", MakePacket<int>(state).At(Timestamp(timestamp))));
+    MP_ASSERT_OK(graph_.WaitUntilIdle());
+  }
+
+  // Returns the (timestamp, tier) pairs output so far.
+  std::vector<std::pair<int64_t, int>> Tiers() {
+    std::vector<std::pair<int64_t, int>> tiers;
+    for (const Packet& packet : tier_packets_) {
+      tiers.emplace_back(packet.Timestamp().Value(), packet.Get<int>());
+    }
+    return tiers;
+  }
+
+  void TearDown() override {
+    MP_ASSERT_OK(graph_.CloseAllInputStreams());
+    MP_ASSERT_OK(graph_.WaitUntilDone());
+  }
+
+  CalculatorGraph graph_;
+  std::vector<Packet> tier_packets_;
+};
+
+TEST_F(QualityTierControllerCalculatorTest, StepsDownAndBackUp) {
+  StartGraph(R"pb(
+    num_tiers: 3
+    upgrade_after_ok_reports: 2
+    downgrade_after_violated_reports: 1
+    min_upgrade_interval_usec: 10
+  )pb");
+  SendReport(0, LatencySloReport::OK);
+  SendReport(1, LatencySloReport::VIOLATED);
+  SendReport(2, LatencySloReport::VIOLATED);
+  SendReport(3, LatencySloReport::AT_RISK);
+  SendReport(4, LatencySloReport::OK);
+  // The upgrade is allowed but waits for min_upgrade_interval_usec.
+  SendReport(5, LatencySloReport::OK);
+  SendReport(12, LatencySloReport::OK);
+  EXPECT_THAT(Tiers(), ElementsAre(Pair(0, 2), Pair(1, 1), Pair(2, 0),
+                                   Pair(12, 1)));
+}
+
+TEST_F(QualityTierControllerCalculatorTest, ThermalStateCapsTier) {
+  StartGraph(R"pb(
+    num_tiers: 3
+    initial_tier: 1
+    min_upgrade_interval_usec: 10
+    max_tier_for_thermal_state: [ 2, 1, 0 ]
+  )pb");
+  SendThermalState(0, 0);
+  SendThermalState(1, 5);
+  SendThermalState(2, 0);
+  SendThermalState(20, 0);
+  EXPECT_THAT(Tiers(), ElementsAre(Pair(0, 1), Pair(1, 0), Pair(20, 1)));
+}
+
+}  // namespace
+}  // namespace mediapipe
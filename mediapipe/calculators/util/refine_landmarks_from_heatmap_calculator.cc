@@ -14,6 +14,11 @@
 
 #include "mediapipe/calculators/util/refine_landmarks_from_heatmap_calculator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include "mediapipe/calculators/util/refine_landmarks_from_heatmap_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 
@@ -118,6 +123,12 @@ absl::StatusOr<mediapipe::NormalizedLandmarkList> RefineLandmarksFromHeatMap(
   int hm_row_size = hm_width * hm_channels;
   int hm_pixel_size = hm_channels;
 
+  // The kernel window of one landmark, gathered from its channel of the
+  // heatmap. The strided reads happen once per value, and the sigmoid and the
+  // sums then run over contiguous memory.
+  const int max_window_size = std::max(kernel_size, 0);
+  std::vector<float> window(max_window_size * max_window_size);
+
   mediapipe::NormalizedLandmarkList out_lms = in_lms;
   for (int lm_index = 0; lm_index < out_lms.landmark_size(); ++lm_index) {
     int center_col = out_lms.landmark(lm_index).x() * hm_width;
@@ -136,26 +147,44 @@ absl::StatusOr<mediapipe::NormalizedLandmarkList> RefineLandmarksFromHeatMap(
     int begin_row = std::max(0, center_row - offset);
     int end_row = std::min(hm_height, center_row + offset + 1);
 
+    const int window_cols = end_col - begin_col;
+    const int window_size = (end_row - begin_row) * window_cols;
+
+    // Gather the kernel area, tracking the max raw value. Sigmoid is
+    // monotonic, so the sigmoid of the max value is the max confidence.
+    float max_value = -std::numeric_limits<float>::infinity();
+    float* window_value = window.data();
+    for (int row = begin_row; row < end_row; ++row) {
+      // We expect memory to be in HWC layout without padding.
+      const float* hm_value = heatmap_raw_data + hm_row_size * row +
+                              hm_pixel_size * begin_col + lm_index;
+      for (int col = 0; col < window_cols; ++col) {
+        *window_value = hm_value[col * hm_pixel_size];
+        max_value = std::max(max_value, *window_value);
+        ++window_value;
+      }
+    }
+    // Right now we hardcode sigmoid activation as it will be wasteful to
+    // calculate sigmoid for each value of heatmap in the model itself.  If
+    // we ever have other activations it should be trivial to expand via
+    // options.
+    for (int i = 0; i < window_size; ++i) {
+      window[i] = Sigmoid(window[i]);
+    }
+    const float max_confidence_value = std::max(0.0f, Sigmoid(max_value));
+
+    // Main loop. Go over kernel and calculate weighted sum of coordinates and
+    // sum of weights.
     float sum = 0;
     float weighted_col = 0;
     float weighted_row = 0;
-    float max_confidence_value = 0;
-
-    // Main loop. Go over kernel and calculate weighted sum of coordinates,
-    // sum of weights and max weights.
+    const float* confidence = window.data();
     for (int row = begin_row; row < end_row; ++row) {
       for (int col = begin_col; col < end_col; ++col) {
-        // We expect memory to be in HWC layout without padding.
-        int idx = hm_row_size * row + hm_pixel_size * col + lm_index;
-        // Right now we hardcode sigmoid activation as it will be wasteful to
-        // calculate sigmoid for each value of heatmap in the model itself.  If
-        // we ever have other activations it should be trivial to expand via
-        // options.
-        float confidence = Sigmoid(heatmap_raw_data[idx]);
-        sum += confidence;
-        max_confidence_value = std::max(max_confidence_value, confidence);
-        weighted_col += col * confidence;
-        weighted_row += row * confidence;
+        sum += *confidence;
+        weighted_col += col * *confidence;
+        weighted_row += row * *confidence;
+        ++confidence;
       }
     }
     if (max_confidence_value >= min_confidence_to_refine && sum > 0) {
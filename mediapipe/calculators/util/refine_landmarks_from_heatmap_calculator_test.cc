@@ -14,6 +14,11 @@
 
 #include "mediapipe/calculators/util/refine_landmarks_from_heatmap_calculator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/status_matchers.h"
@@ -149,5 +154,99 @@ TEST(RefineLandmarksFromHeatmapTest, Border) {
                           Pair(FloatEq(2 / 3.), FloatEq(1 / 6. + 2 / 6.))));
 }
 
+float ReferenceSigmoid(float value) { return 1.0f / (1.0f + std::exp(-value)); }
+
+// The scalar loop the refinement used before windows were gathered, kept as the
+// reference.
+mediapipe::NormalizedLandmarkList ReferenceRefine(
+    const mediapipe::NormalizedLandmarkList& in_lms, const float* heatmap,
+    int hm_height, int hm_width, int kernel_size,
+    float min_confidence_to_refine) {
+  const int hm_channels = in_lms.landmark_size();
+  mediapipe::NormalizedLandmarkList out_lms = in_lms;
+  for (int lm_index = 0; lm_index < out_lms.landmark_size(); ++lm_index) {
+    int center_col = out_lms.landmark(lm_index).x() * hm_width;
+    int center_row = out_lms.landmark(lm_index).y() * hm_height;
+    if (center_col < 0 || center_col >= hm_width || center_row < 0 ||
+        center_row >= hm_height) {
+      continue;
+    }
+    int offset = (kernel_size - 1) / 2;
+    int begin_col = std::max(0, center_col - offset);
+    int end_col = std::min(hm_width, center_col + offset + 1);
+    int begin_row = std::max(0, center_row - offset);
+    int end_row = std::min(hm_height, center_row + offset + 1);
+
+    float sum = 0;
+    float weighted_col = 0;
+    float weighted_row = 0;
+    float max_confidence_value = 0;
+    for (int row = begin_row; row < end_row; ++row) {
+      for (int col = begin_col; col < end_col; ++col) {
+        int idx = hm_width * hm_channels * row + hm_channels * col + lm_index;
+        float confidence = ReferenceSigmoid(heatmap[idx]);
+        sum += confidence;
+        max_confidence_value = std::max(max_confidence_value, confidence);
+        weighted_col += col * confidence;
+        weighted_row += row * confidence;
+      }
+    }
+    auto* landmark = out_lms.mutable_landmark(lm_index);
+    if (max_confidence_value >= min_confidence_to_refine && sum > 0) {
+      landmark->set_x(weighted_col / hm_width / sum);
+      landmark->set_y(weighted_row / hm_height / sum);
+    }
+    if (sum > 0) {
+      landmark->set_presence(
+          std::min(landmark->presence(), max_confidence_value));
+      landmark->set_visibility(
+          std::min(landmark->visibility(), max_confidence_value));
+    }
+  }
+  return out_lms;
+}
+
+TEST(RefineLandmarksFromHeatmapTest, MatchesReferenceOnOddSizes) {
+  constexpr int kHeight = 13;
+  constexpr int kWidth = 11;
+  constexpr int kChannels = 7;
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> logit(-6.0f, 6.0f);
+  // Landmarks spread over the heatmap, some on or past its border.
+  std::uniform_real_distribution<float> position(-0.1f, 1.1f);
+  std::vector<float> hm(kHeight * kWidth * kChannels);
+  for (float& value : hm) value = logit(rng);
+  mediapipe::NormalizedLandmarkList lms;
+  for (int i = 0; i < kChannels; ++i) {
+    auto* landmark = lms.add_landmark();
+    landmark->set_x(i == 0 ? 0.0f : position(rng));
+    landmark->set_y(i == 0 ? 0.99f : position(rng));
+    landmark->set_presence(0.9f);
+    landmark->set_visibility(0.8f);
+  }
+
+  // Even sizes shrink to the next odd window, and large ones cover the whole
+  // heatmap.
+  for (const int kernel_size : {1, 2, 3, 4, 5, 9, 31}) {
+    for (const float min_confidence : {0.0f, 0.5f, 0.99f}) {
+      auto ret_or_error = RefineLandmarksFromHeatMap(
+          lms, hm.data(), {kHeight, kWidth, kChannels}, kernel_size,
+          min_confidence, /*refine_presence=*/true,
+          /*refine_visibility=*/true);
+      MP_ASSERT_OK(ret_or_error);
+      const mediapipe::NormalizedLandmarkList expected = ReferenceRefine(
+          lms, hm.data(), kHeight, kWidth, kernel_size, min_confidence);
+      ASSERT_EQ(ret_or_error->landmark_size(), expected.landmark_size());
+      for (int i = 0; i < expected.landmark_size(); ++i) {
+        const auto& actual = ret_or_error->landmark(i);
+        EXPECT_FLOAT_EQ(actual.x(), expected.landmark(i).x());
+        EXPECT_FLOAT_EQ(actual.y(), expected.landmark(i).y());
+        EXPECT_FLOAT_EQ(actual.presence(), expected.landmark(i).presence());
+        EXPECT_FLOAT_EQ(actual.visibility(), expected.landmark(i).visibility());
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -1196,9 +1196,22 @@ void BoxTrackerCalculator::StreamTrack(const TrackingData& data,
   const int from_frame = data_frame_num - (forward ? 1 : 0);
   const int to_frame = forward ? from_frame + 1 : from_frame - 1;
 
+  std::vector<MotionBox*> boxes;
+  boxes.reserve(box_map->size());
   for (auto& motion_box : *box_map) {
-    if (!motion_box.second.box.TrackStep(from_frame,  // from frame.
-                                         mvf, forward)) {
+    boxes.push_back(&motion_box.second.box);
+  }
+  const std::vector<int> failed_boxes =
+      MotionBox::TrackStepBatch(from_frame, mvf, forward, boxes);
+
+  auto failed_box = failed_boxes.begin();
+  int box_idx = 0;
+  for (auto& motion_box : *box_map) {
+    const bool failed =
+        failed_box != failed_boxes.end() && *failed_box == box_idx;
+    ++box_idx;
+    if (failed) {
+      ++failed_box;
       failed_ids->push_back(motion_box.first);
       ABSL_LOG(INFO) << "lost track. pushed failed id: " << motion_box.first;
     } else {
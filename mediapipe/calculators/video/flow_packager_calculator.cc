@@ -126,6 +126,9 @@ absl::Status FlowPackagerCalculator::GetContract(CalculatorContract* cc) {
 
 absl::Status FlowPackagerCalculator::Open(CalculatorContext* cc) {
   options_ = cc->Options<FlowPackagerCalculatorOptions>();
+  RET_CHECK(!options_.binary_chunk_format() ||
+            options_.flow_packager_options().binary_tracking_data_support())
+      << "binary_chunk_format requires binary_tracking_data_support.";
 
   flow_packager_.reset(new FlowPackager(options_.flow_packager_options()));
 
@@ -248,7 +251,11 @@ void FlowPackagerCalculator::WriteChunk(const TrackingDataChunk& chunk) const {
   }
 
   std::string data;
-  chunk.SerializeToString(&data);
+  if (options_.binary_chunk_format()) {
+    flow_packager_->EncodeTrackingDataChunk(chunk, &data);
+  } else {
+    chunk.SerializeToString(&data);
+  }
 
   const char* temp_filename = tempnam(cache_dir_.c_str(), nullptr);
   std::ofstream out_file(temp_filename);
@@ -36,6 +36,7 @@
 #include "mediapipe/util/tracking/motion_analysis.h"
 #include "mediapipe/util/tracking/motion_estimation.h"
 #include "mediapipe/util/tracking/motion_models.h"
+#include "mediapipe/util/tracking/parallel_invoker.h"
 #include "mediapipe/util/tracking/region_flow.pb.h"
 
 namespace mediapipe {
@@ -431,6 +432,9 @@ absl::Status MotionAnalysisCalculator::Process(CalculatorContext* cc) {
   // Checked on Open.
   ABSL_CHECK(video_stream || selection_stream);
 
+  ScopedParallelInvokerExecutor scoped_executor(
+      options_.parallel_on_graph_executor() ? cc->GetExecutor() : nullptr);
+
   // Lazy init.
   if (frame_width_ < 0 || frame_height_ < 0) {
     MP_RETURN_IF_ERROR(InitOnProcess(video_stream, selection_stream));
@@ -598,6 +602,8 @@ absl::Status MotionAnalysisCalculator::Process(CalculatorContext* cc) {
 }
 
 absl::Status MotionAnalysisCalculator::Close(CalculatorContext* cc) {
+  ScopedParallelInvokerExecutor scoped_executor(
+      options_.parallel_on_graph_executor() ? cc->GetExecutor() : nullptr);
   // Guard against empty videos.
   if (motion_analysis_) {
     OutputMotionAnalyzedFrames(true, cc);
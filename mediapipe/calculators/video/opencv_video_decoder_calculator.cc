@@ -14,11 +14,17 @@
 
 #include <stdlib.h>
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include "absl/log/absl_log.h"
+#include "mediapipe/calculators/video/opencv_video_decoder_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image_format.pb.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/image_frame_opencv.h"
+#include "mediapipe/framework/formats/image_frame_pool.h"
 #include "mediapipe/framework/formats/video_stream_header.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/opencv_video_inc.h"
@@ -33,6 +39,8 @@ constexpr char kSavedAudioPathTag[] = "SAVED_AUDIO_PATH";
 constexpr char kVideoPrestreamTag[] = "VIDEO_PRESTREAM";
 constexpr char kVideoTag[] = "VIDEO";
 constexpr char kInputFilePathTag[] = "INPUT_FILE_PATH";
+constexpr char kStartTimeUsTag[] = "START_TIME_US";
+constexpr char kEndTimeUsTag[] = "END_TIME_US";
 
 // cv::VideoCapture set data type to unsigned char by default. Therefore, the
 // image format is only related to the number of channles the cv::Mat has.
@@ -54,6 +62,35 @@ ImageFormat::Format GetImageFormat(int num_channels) {
   }
   return format;
 }
+
+// Returns the cv::VideoCapture open parameters requested by `options`.
+std::vector<int> GetVideoCaptureParams(
+    const OpenCvVideoDecoderCalculatorOptions& options) {
+  std::vector<int> params;
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR > 5) || \
+    (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR == 5 && CV_VERSION_REVISION >= 2)
+  if (options.use_hardware_acceleration()) {
+    params.push_back(cv::CAP_PROP_HW_ACCELERATION);
+    params.push_back(cv::VIDEO_ACCELERATION_ANY);
+  }
+#else
+  if (options.use_hardware_acceleration()) {
+    ABSL_LOG(WARNING) << "Hardware accelerated decoding requires OpenCV 4.5.2.";
+  }
+#endif
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 6)
+  if (options.num_decoder_threads() > 0) {
+    params.push_back(cv::CAP_PROP_N_THREADS);
+    params.push_back(options.num_decoder_threads());
+  }
+#else
+  if (options.num_decoder_threads() > 0) {
+    ABSL_LOG(WARNING) << "Setting the number of decoder threads requires "
+                         "OpenCV 4.6.";
+  }
+#endif
+  return params;
+}
 }  // namespace
 
 // This Calculator takes no input streams and produces video packets.
@@ -67,6 +104,15 @@ ImageFormat::Format GetImageFormat(int num_channels) {
 //       Timestamp::PreStream() for the corresponding stream.
 // Input Side Packets:
 //   INPUT_FILE_PATH: The input file path.
+//   START_TIME_US: Optional. The time (int64, in microseconds) to seek to
+//       before decoding. Frames keep their timestamps in the whole video, so
+//       several instances can decode different parts of the same video in
+//       parallel, see tool::RunGraphInSegments.
+//   END_TIME_US: Optional. Decoding stops at the first frame at or after this
+//       time (int64, in microseconds).
+//
+// See OpenCvVideoDecoderCalculatorOptions for hardware accelerated and
+// multithreaded decoding, and for pooling the output frames.
 //
 // Example config:
 // node {
@@ -95,6 +141,12 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
  public:
   static absl::Status GetContract(CalculatorContract* cc) {
     cc->InputSidePackets().Tag(kInputFilePathTag).Set<std::string>();
+    if (cc->InputSidePackets().HasTag(kStartTimeUsTag)) {
+      cc->InputSidePackets().Tag(kStartTimeUsTag).Set<int64_t>();
+    }
+    if (cc->InputSidePackets().HasTag(kEndTimeUsTag)) {
+      cc->InputSidePackets().Tag(kEndTimeUsTag).Set<int64_t>();
+    }
     cc->Outputs().Tag(kVideoTag).Set<ImageFrame>();
     if (cc->Outputs().HasTag(kVideoPrestreamTag)) {
       cc->Outputs().Tag(kVideoPrestreamTag).Set<VideoHeader>();
@@ -108,7 +160,14 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
   absl::Status Open(CalculatorContext* cc) override {
     const std::string& input_file_path =
         cc->InputSidePackets().Tag(kInputFilePathTag).Get<std::string>();
-    cap_ = absl::make_unique<cv::VideoCapture>(input_file_path);
+    const auto& options = cc->Options<OpenCvVideoDecoderCalculatorOptions>();
+    const std::vector<int> params = GetVideoCaptureParams(options);
+    if (params.empty()) {
+      cap_ = absl::make_unique<cv::VideoCapture>(input_file_path);
+    } else {
+      cap_ = absl::make_unique<cv::VideoCapture>(input_file_path, cv::CAP_ANY,
+                                                 params);
+    }
     if (!cap_->isOpened()) {
       return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
              << "Fail to open video file at " << input_file_path;
@@ -153,8 +212,24 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
           .Add(header.release(), Timestamp::PreStream());
       cc->Outputs().Tag(kVideoPrestreamTag).Close();
     }
-    // Rewind to the very first frame.
+    // Rewind to the very first frame, or seek to the requested start.
     cap_->set(cv::CAP_PROP_POS_AVI_RATIO, 0);
+    if (cc->InputSidePackets().HasTag(kStartTimeUsTag)) {
+      start_timestamp_ =
+          Timestamp(cc->InputSidePackets().Tag(kStartTimeUsTag).Get<int64_t>());
+      if (start_timestamp_ > Timestamp(0)) {
+        cap_->set(cv::CAP_PROP_POS_MSEC, start_timestamp_.Value() / 1000.0);
+      }
+    }
+    if (cc->InputSidePackets().HasTag(kEndTimeUsTag)) {
+      end_timestamp_ =
+          Timestamp(cc->InputSidePackets().Tag(kEndTimeUsTag).Get<int64_t>());
+    }
+
+    if (options.frame_pool_size() > 0) {
+      frame_pool_ = ImageFramePool::Create(width_, height_, format_,
+                                           options.frame_pool_size());
+    }
 
     if (cc->OutputSidePackets().HasTag(kSavedAudioPathTag)) {
 #ifdef HAVE_FFMPEG
@@ -189,34 +264,62 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
   }
 
   absl::Status Process(CalculatorContext* cc) override {
-    auto image_frame = absl::make_unique<ImageFrame>(format_, width_, height_,
-                                                     /*alignment_boundary=*/1);
+    std::unique_ptr<ImageFrame> owned_frame;
+    std::shared_ptr<ImageFrame> pooled_frame;
+    ImageFrame* image_frame;
+    if (frame_pool_) {
+      pooled_frame = frame_pool_->GetBuffer();
+      image_frame = pooled_frame.get();
+    } else {
+      owned_frame = absl::make_unique<ImageFrame>(format_, width_, height_,
+                                                  /*alignment_boundary=*/1);
+      image_frame = owned_frame.get();
+    }
     if (format_ == ImageFormat::GRAY8) {
-      cv::Mat frame = formats::MatView(image_frame.get());
+      cv::Mat frame = formats::MatView(image_frame);
       ReadFrame(frame);
       if (frame.empty()) {
         return tool::StatusStop();
       }
     } else {
-      cv::Mat tmp_frame;
-      ReadFrame(tmp_frame);
-      if (tmp_frame.empty()) {
+      // The decoder writes into the same buffer every frame, so only the
+      // color conversion touches the output frame.
+      ReadFrame(decoded_frame_);
+      if (decoded_frame_.empty()) {
         return tool::StatusStop();
       }
       if (format_ == ImageFormat::SRGB) {
-        cv::cvtColor(tmp_frame, formats::MatView(image_frame.get()),
+        cv::cvtColor(decoded_frame_, formats::MatView(image_frame),
                      cv::COLOR_BGR2RGB);
       } else if (format_ == ImageFormat::SRGBA) {
-        cv::cvtColor(tmp_frame, formats::MatView(image_frame.get()),
+        cv::cvtColor(decoded_frame_, formats::MatView(image_frame),
                      cv::COLOR_BGRA2RGBA);
       }
     }
     // Use microsecond as the unit of time.
     Timestamp timestamp(cap_->get(cv::CAP_PROP_POS_MSEC) * 1000);
+    if (timestamp >= end_timestamp_) {
+      return tool::StatusStop();
+    }
+    // Seeking may land on a keyframe before the requested start.
+    if (timestamp < start_timestamp_) {
+      return absl::OkStatus();
+    }
     // If the timestamp of the current frame is not greater than the one of the
     // previous frame, the new frame will be discarded.
     if (prev_timestamp_ < timestamp) {
-      cc->Outputs().Tag(kVideoTag).Add(image_frame.release(), timestamp);
+      Packet packet;
+      if (pooled_frame) {
+        // The frame returns to the pool once all packets referring to it are
+        // destroyed.
+        packet = PointToForeign(image_frame,
+                                [frame = std::move(pooled_frame)]() mutable {
+                                  frame.reset();
+                                });
+      } else {
+        packet = Adopt(owned_frame.release());
+      }
+      cc->Outputs().Tag(kVideoTag).AddPacket(packet.At(timestamp));
       prev_timestamp_ = timestamp;
       decoded_frames_++;
     }
@@ -228,7 +331,9 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
     if (cap_ && cap_->isOpened()) {
       cap_->release();
     }
-    if (decoded_frames_ != frame_count_) {
+    const bool decodes_whole_video = start_timestamp_ == Timestamp::Min() &&
+                                     end_timestamp_ == Timestamp::Max();
+    if (decodes_whole_video && decoded_frames_ != frame_count_) {
       ABSL_LOG(WARNING) << "Not all the frames are decoded (total frames: "
                         << frame_count_
                         << " vs decoded frames: " << decoded_frames_ << ").";
@@ -246,12 +351,18 @@ class OpenCvVideoDecoderCalculator : public CalculatorBase {
 
  private:
   std::unique_ptr<cv::VideoCapture> cap_;
+  // Reused across frames for decoded frames that need a color conversion.
+  cv::Mat decoded_frame_;
+  std::shared_ptr<ImageFramePool> frame_pool_;
   int width_;
   int height_;
   int frame_count_;
   int decoded_frames_ = 0;
   ImageFormat::Format format_;
   Timestamp prev_timestamp_ = Timestamp::Unset();
+  // The range of frames to output, from START_TIME_US and END_TIME_US.
+  Timestamp start_timestamp_ = Timestamp::Min();
+  Timestamp end_timestamp_ = Timestamp::Max();
 };
 
 REGISTER_CALCULATOR(OpenCvVideoDecoderCalculator);
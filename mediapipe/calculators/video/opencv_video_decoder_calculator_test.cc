@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "mediapipe/calculators/video/opencv_video_decoder_calculator.pb.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/deps/file_path.h"
 #include "mediapipe/framework/formats/image_frame.h"
@@ -77,6 +78,47 @@ TEST(OpenCvVideoDecoderCalculatorTest, TestMp4Avc720pVideo) {
   }
 }
 
+TEST(OpenCvVideoDecoderCalculatorTest, TestMp4Avc720pVideoWithFramePool) {
+  CalculatorGraphConfig::Node node_config =
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
+        calculator: "OpenCvVideoDecoderCalculator"
+        input_side_packet: "INPUT_FILE_PATH:input_file_path"
+        output_stream: "VIDEO:video"
+        options {
+          [mediapipe.OpenCvVideoDecoderCalculatorOptions.ext] {
+            frame_pool_size: 4
+          }
+        })pb");
+  CalculatorRunner runner(node_config);
+  runner.MutableSidePackets()->Tag(kInputFilePathTag) =
+      MakePacket<std::string>(file::JoinPath(GetTestDataDir(kTestPackageRoot),
+                                             "format_MP4_AVC720P_AAC.video"));
+  MP_EXPECT_OK(runner.Run());
+
+  // The runner holds on to every output packet, so none of the pooled frames
+  // may have been recycled.
+  const auto& packets = runner.Outputs().Tag(kVideoTag).packets;
+  int num_of_packets = packets.size();
+  EXPECT_GE(num_of_packets, 180);
+  for (int i = 0; i < num_of_packets; ++i) {
+    Packet image_frame_packet = packets[i];
+    if (i > 0) {
+      EXPECT_NE(&image_frame_packet.Get<ImageFrame>(),
+                &packets[i - 1].Get<ImageFrame>());
+    }
+    cv::Mat output_mat =
+        formats::MatView(&(image_frame_packet.Get<ImageFrame>()));
+    EXPECT_EQ(1280, output_mat.size().width);
+    EXPECT_EQ(640, output_mat.size().height);
+    EXPECT_EQ(3, output_mat.channels());
+    cv::Scalar s = cv::mean(output_mat);
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_GT(s[i], 0);
+      EXPECT_LT(s[i], 255);
+    }
+  }
+}
+
 TEST(OpenCvVideoDecoderCalculatorTest, TestFlvH264Video) {
   CalculatorGraphConfig::Node node_config =
       ParseTextProtoOrDie<CalculatorGraphConfig::Node>(R"pb(
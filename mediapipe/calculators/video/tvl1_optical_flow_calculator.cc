@@ -12,6 +12,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <deque>
+#include <utility>
+
 #include "absl/base/macros.h"
 #include "absl/log/absl_check.h"
 #include "absl/synchronization/mutex.h"
@@ -34,16 +37,23 @@ bool ImageSizesMatch(const ImageFrame& img1, const ImageFrame& img2) {
   return (img1.Width() == img2.Width()) && (img1.Height() == img2.Height());
 }
 
-// Converts an RGB image to grayscale.
+// Converts an RGB or grayscale image to a CV_32FC1 grayscale image with
+// values in [0, 1], the input DualTVL1OpticalFlow would otherwise convert 8 bit
+// images to on every call.
 cv::Mat ConvertToGrayscale(const cv::Mat& image) {
-  if (image.channels() == 1) {
-    return image;
+  cv::Mat gray = image;
+  if (image.channels() != 1) {
+    cv::cvtColor(image, gray, cv::COLOR_RGB2GRAY);
   }
-  cv::Mat gray;
-  cv::cvtColor(image, gray, cv::COLOR_RGB2GRAY);
-  return gray;
+  cv::Mat gray_float;
+  gray.convertTo(gray_float, CV_32F, 1.0 / 255.0);
+  return gray_float;
 }
 
+// Number of converted frames kept by the calculator. Consecutive pairs share a
+// frame, which may be processed out of order if max_in_flight is set.
+constexpr int kMaxCachedFrames = 8;
+
 }  // namespace
 
 // Calls OpenCV's DenseOpticalFlow to compute the optical flow between a pair of
@@ -60,6 +70,10 @@ cv::Mat ConvertToGrayscale(const cv::Mat& image) {
 // packets will be automatically ordered by timestamp before they are passed
 // along to downstream calculators.
 //
+// Each frame is converted to grayscale once, for both flow directions and,
+// if the SECOND_FRAME packet of a pair is sent again as FIRST_FRAME of the
+// next pair, for both pairs.
+//
 // Inputs:
 //   FIRST_FRAME: An ImageFrame in either SRGB or GRAY8 format.
 //   SECOND_FRAME: An ImageFrame in either SRGB or GRAY8 format.
@@ -85,9 +99,11 @@ class Tvl1OpticalFlowCalculator : public CalculatorBase {
   absl::Status Process(CalculatorContext* cc) override;
 
  private:
-  absl::Status CalculateOpticalFlow(const ImageFrame& current_frame,
-                                    const ImageFrame& next_frame,
-                                    OpticalFlowField* flow);
+  // Returns the grayscale conversion of the ImageFrame held by packet, reusing
+  // the conversion of recently processed packets.
+  cv::Mat GrayscaleFrame(const Packet& packet);
+  void CalculateOpticalFlow(const cv::Mat& first, const cv::Mat& second,
+                            OpticalFlowField* flow);
   bool forward_requested_ = false;
   bool backward_requested_ = false;
   // Stores the idle DenseOpticalFlow objects.
@@ -96,6 +112,10 @@ class Tvl1OpticalFlowCalculator : public CalculatorBase {
   // memory leak.
   std::list<cv::Ptr<cv::DenseOpticalFlow>> tvl1_computers_
       ABSL_GUARDED_BY(mutex_);
+  // Recently converted frames, oldest first. The packets are retained so that
+  // the addresses of their ImageFrames identify them.
+  std::deque<std::pair<Packet, cv::Mat>> converted_frames_
+      ABSL_GUARDED_BY(mutex_);
   absl::Mutex mutex_;
 };
 
@@ -133,22 +153,24 @@ absl::Status Tvl1OpticalFlowCalculator::Open(CalculatorContext* cc) {
 }
 
 absl::Status Tvl1OpticalFlowCalculator::Process(CalculatorContext* cc) {
-  const ImageFrame& first_frame =
-      cc->Inputs().Tag(kFirstFrameTag).Value().Get<ImageFrame>();
-  const ImageFrame& second_frame =
-      cc->Inputs().Tag(kSecondFrameTag).Value().Get<ImageFrame>();
+  const Packet& first_packet = cc->Inputs().Tag(kFirstFrameTag).Value();
+  const Packet& second_packet = cc->Inputs().Tag(kSecondFrameTag).Value();
+  if (!ImageSizesMatch(first_packet.Get<ImageFrame>(),
+                       second_packet.Get<ImageFrame>())) {
+    return tool::StatusInvalid("Images are different sizes.");
+  }
+  const cv::Mat first = GrayscaleFrame(first_packet);
+  const cv::Mat second = GrayscaleFrame(second_packet);
   if (forward_requested_) {
     auto forward_optical_flow_field = absl::make_unique<OpticalFlowField>();
-    MP_RETURN_IF_ERROR(CalculateOpticalFlow(first_frame, second_frame,
-                                            forward_optical_flow_field.get()));
+    CalculateOpticalFlow(first, second, forward_optical_flow_field.get());
     cc->Outputs()
         .Tag(kForwardFlowTag)
         .Add(forward_optical_flow_field.release(), cc->InputTimestamp());
   }
   if (backward_requested_) {
     auto backward_optical_flow_field = absl::make_unique<OpticalFlowField>();
-    MP_RETURN_IF_ERROR(CalculateOpticalFlow(second_frame, first_frame,
-                                            backward_optical_flow_field.get()));
+    CalculateOpticalFlow(second, first, backward_optical_flow_field.get());
     cc->Outputs()
         .Tag(kBackwardFlowTag)
         .Add(backward_optical_flow_field.release(), cc->InputTimestamp());
@@ -156,16 +178,29 @@ absl::Status Tvl1OpticalFlowCalculator::Process(CalculatorContext* cc) {
   return absl::OkStatus();
 }
 
-absl::Status Tvl1OpticalFlowCalculator::CalculateOpticalFlow(
-    const ImageFrame& current_frame, const ImageFrame& next_frame,
-    OpticalFlowField* flow) {
-  ABSL_CHECK(flow);
-  if (!ImageSizesMatch(current_frame, next_frame)) {
-    return tool::StatusInvalid("Images are different sizes.");
+cv::Mat Tvl1OpticalFlowCalculator::GrayscaleFrame(const Packet& packet) {
+  const ImageFrame* frame = &packet.Get<ImageFrame>();
+  {
+    absl::MutexLock lock(&mutex_);
+    for (const auto& converted : converted_frames_) {
+      if (&converted.first.Get<ImageFrame>() == frame) {
+        return converted.second;
+      }
+    }
+  }
+  cv::Mat gray = ConvertToGrayscale(formats::MatView(frame));
+  absl::MutexLock lock(&mutex_);
+  converted_frames_.emplace_back(packet, gray);
+  if (converted_frames_.size() > kMaxCachedFrames) {
+    converted_frames_.pop_front();
   }
-  const cv::Mat& first = ConvertToGrayscale(formats::MatView(&current_frame));
-  const cv::Mat& second = ConvertToGrayscale(formats::MatView(&next_frame));
+  return gray;
+}
 
+void Tvl1OpticalFlowCalculator::CalculateOpticalFlow(const cv::Mat& first,
+                                                     const cv::Mat& second,
+                                                     OpticalFlowField* flow) {
+  ABSL_CHECK(flow);
   // Tries getting an idle DenseOpticalFlow object from the cache. If not,
   // creates a new DenseOpticalFlow.
   cv::Ptr<cv::DenseOpticalFlow> tvl1_computer;
@@ -189,7 +224,6 @@ absl::Status Tvl1OpticalFlowCalculator::CalculateOpticalFlow(
     absl::MutexLock lock(&mutex_);
     tvl1_computers_.push_back(tvl1_computer);
   }
-  return absl::OkStatus();
 }
 
 REGISTER_CALCULATOR(Tvl1OpticalFlowCalculator);
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <vector>
+
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/deps/file_path.h"
@@ -22,6 +24,7 @@
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/framework/port/opencv_video_inc.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
 
@@ -123,5 +126,93 @@ TEST(Tvl1OpticalFlowCalculatorTest, TestParallelExecution) {
   RunTest(/*num_input_packets=*/20, /*max_in_flight=*/10);
 }
 
+// Creates frames of a smooth random texture that moves by a subpixel amount
+// between frames.
+std::vector<Packet> CreateMovingTextureFrames(ImageFormat::Format format,
+                                              int width, int height,
+                                              int num_frames) {
+  cv::Mat texture(height + num_frames, width + num_frames, CV_8UC1);
+  cv::randu(texture, 0, 256);
+  cv::GaussianBlur(texture, texture, cv::Size(7, 7), 2.0);
+  std::vector<Packet> frames;
+  for (int i = 0; i < num_frames; ++i) {
+    cv::Mat shift = (cv::Mat_<double>(2, 3) << 1, 0, 0.7 * i, 0, 1, 0.4 * i);
+    cv::Mat gray;
+    cv::warpAffine(texture, gray, shift, cv::Size(width, height));
+    Packet packet = MakePacket<ImageFrame>(format, width, height);
+    cv::Mat mat = formats::MatView(&(packet.Get<ImageFrame>()));
+    if (format == ImageFormat::SRGB) {
+      cv::cvtColor(gray, mat, cv::COLOR_GRAY2RGB);
+    } else {
+      gray.copyTo(mat);
+    }
+    frames.push_back(packet);
+  }
+  return frames;
+}
+
+// The flow computation before frames were converted once and cached: 8 bit
+// grayscale frames passed to DualTVL1 for every flow direction.
+cv::Mat ReferenceFlow(const Packet& first, const Packet& second) {
+  auto gray = [](const Packet& packet) {
+    cv::Mat mat = formats::MatView(&(packet.Get<ImageFrame>()));
+    if (mat.channels() == 1) {
+      return mat;
+    }
+    cv::Mat gray;
+    cv::cvtColor(mat, gray, cv::COLOR_RGB2GRAY);
+    return gray;
+  };
+  cv::Mat flow;
+  cv::createOptFlow_DualTVL1()->calc(gray(first), gray(second), flow);
+  return flow;
+}
+
+TEST(Tvl1OpticalFlowCalculatorTest, MatchesPerPairConversion) {
+  for (const ImageFormat::Format format :
+       {ImageFormat::SRGB, ImageFormat::GRAY8}) {
+    // Odd sizes. Consecutive pairs share a frame packet, so all but the first
+    // frame are converted by an earlier pair.
+    const std::vector<Packet> frames =
+        CreateMovingTextureFrames(format, /*width=*/53, /*height=*/37,
+                                  /*num_frames=*/4);
+    const int num_pairs = frames.size() - 1;
+    CalculatorRunner runner(R"pb(
+      calculator: "Tvl1OpticalFlowCalculator"
+      input_stream: "FIRST_FRAME:first_frames"
+      input_stream: "SECOND_FRAME:second_frames"
+      output_stream: "FORWARD_FLOW:forward_flow"
+      output_stream: "BACKWARD_FLOW:backward_flow"
+    )pb");
+    for (int i = 0; i < num_pairs; ++i) {
+      runner.MutableInputs()->Tag("FIRST_FRAME").packets.push_back(
+          frames[i].At(Timestamp(i)));
+      runner.MutableInputs()->Tag("SECOND_FRAME").packets.push_back(
+          frames[i + 1].At(Timestamp(i)));
+    }
+    MP_ASSERT_OK(runner.Run());
+
+    const std::vector<Packet>& forward =
+        runner.Outputs().Tag("FORWARD_FLOW").packets;
+    const std::vector<Packet>& backward =
+        runner.Outputs().Tag("BACKWARD_FLOW").packets;
+    ASSERT_EQ(forward.size(), num_pairs);
+    ASSERT_EQ(backward.size(), num_pairs);
+    for (int i = 0; i < num_pairs; ++i) {
+      const cv::Mat expected_forward = ReferenceFlow(frames[i], frames[i + 1]);
+      const cv::Mat expected_backward =
+          ReferenceFlow(frames[i + 1], frames[i]);
+      EXPECT_LE(cv::norm(forward[i].Get<OpticalFlowField>().flow_data(),
+                         expected_forward, cv::NORM_INF),
+                1e-2)
+          << "format " << format << ", pair " << i;
+      EXPECT_LE(cv::norm(backward[i].Get<OpticalFlowField>().flow_data(),
+                         expected_backward, cv::NORM_INF),
+                1e-2)
+          << "format " << format << ", pair " << i;
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
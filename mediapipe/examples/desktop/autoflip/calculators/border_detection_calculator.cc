@@ -71,7 +71,7 @@ class BorderDetectionCalculator : public CalculatorBase {
 
  private:
   // Given a color and image direction, check to see if a border of that color
-  // exists.
+  // exists. The frame may be narrower than the input frame, but not shorter.
   void DetectBorder(const cv::Mat& frame, const Color& color,
                     const Border::RelativePosition& direction,
                     StaticFeatures* features);
@@ -91,6 +91,9 @@ class BorderDetectionCalculator : public CalculatorBase {
 
   // Options for processing.
   BorderDetectionCalculatorOptions options_;
+
+  // Scratch mask of the pixels matching a color in ColorCount().
+  mutable cv::Mat color_mask_;
 };
 REGISTER_CALCULATOR(BorderDetectionCalculator);
 
@@ -138,16 +141,28 @@ absl::Status BorderDetectionCalculator::Process(
   features->mutable_non_static_area()->set_height(
       std::max(0, frame_height_ - options_.default_padding_px() * 2));
 
+  // Search for borders on a narrower copy of the frame if requested. Rows are
+  // kept so that border positions stay exact.
+  cv::Mat search_frame = frame;
+  const int search_width = options_.border_search_max_width();
+  if (search_width > 0 && frame_width_ > search_width) {
+    cv::resize(frame, search_frame, cv::Size(search_width, frame_height_), 0, 0,
+               cv::INTER_NEAREST);
+  }
+
   // Check for border at the top of the frame.
   Color seed_color_top;
-  FindDominantColor(frame(cv::Rect(0, 0, frame_width_, 1)), &seed_color_top);
-  DetectBorder(frame, seed_color_top, Border::TOP, features.get());
+  FindDominantColor(search_frame(cv::Rect(0, 0, search_frame.cols, 1)),
+                    &seed_color_top);
+  DetectBorder(search_frame, seed_color_top, Border::TOP, features.get());
 
   // Check for border at the bottom of the frame.
   Color seed_color_bottom;
-  FindDominantColor(frame(cv::Rect(0, frame_height_ - 1, frame_width_, 1)),
-                    &seed_color_bottom);
-  DetectBorder(frame, seed_color_bottom, Border::BOTTOM, features.get());
+  FindDominantColor(
+      search_frame(cv::Rect(0, frame_height_ - 1, search_frame.cols, 1)),
+      &seed_color_bottom);
+  DetectBorder(search_frame, seed_color_bottom, Border::BOTTOM,
+               features.get());
 
   // Check the non-border area for a dominant color.
   cv::Mat non_static_frame = frame(
@@ -209,20 +224,17 @@ double BorderDetectionCalculator::FindDominantColor(const cv::Mat& image_raw,
 
 double BorderDetectionCalculator::ColorCount(const Color& mask_color,
                                              const cv::Mat& image) const {
-  int background_count = 0;
-  for (int i = 0; i < image.rows; i++) {
-    const uint8_t* row_ptr = image.ptr<uint8_t>(i);
-    for (int j = 0; j < image.cols * 3; j += 3) {
-      if (std::abs(mask_color.r() - static_cast<int>(row_ptr[j + 2])) <=
-              options_.color_tolerance() &&
-          std::abs(mask_color.g() - static_cast<int>(row_ptr[j + 1])) <=
-              options_.color_tolerance() &&
-          std::abs(mask_color.b() - static_cast<int>(row_ptr[j])) <=
-              options_.color_tolerance()) {
-        background_count++;
-      }
-    }
-  }
+  // Matches all channels of all pixels against the tolerance range at once,
+  // using OpenCV's vectorized kernels. Channels are in the order b, g, r.
+  const int tolerance = options_.color_tolerance();
+  const cv::Scalar lower(mask_color.b() - tolerance,
+                         mask_color.g() - tolerance,
+                         mask_color.r() - tolerance);
+  const cv::Scalar upper(mask_color.b() + tolerance,
+                         mask_color.g() + tolerance,
+                         mask_color.r() + tolerance);
+  cv::inRange(image, lower, upper, color_mask_);
+  const int background_count = cv::countNonZero(color_mask_);
   return background_count / static_cast<double>(image.rows * image.cols);
 }
 
@@ -266,7 +278,7 @@ void BorderDetectionCalculator::DetectBorder(
 
   switch (direction) {
     case Border::TOP:
-      SetRect(cv::Rect(0, 0, frame.cols, last_border), Border::TOP,
+      SetRect(cv::Rect(0, 0, frame_width_, last_border), Border::TOP,
               features->add_border());
       features->mutable_non_static_area()->set_y(
           last_border + features->non_static_area().y());
@@ -276,7 +288,7 @@ void BorderDetectionCalculator::DetectBorder(
       break;
     case Border::BOTTOM:
       SetRect(
-          cv::Rect(0, frame.rows - last_border - 1, frame.cols, last_border),
+          cv::Rect(0, frame.rows - last_border - 1, frame_width_, last_border),
           Border::BOTTOM, features->add_border());
 
       features->mutable_non_static_area()->set_height(std::max(
@@ -63,6 +63,17 @@ const char kConfigPad[] = R"(
     }
     })";
 
+const char kConfigSubsampled[] = R"(
+    calculator: "BorderDetectionCalculator"
+    input_stream: "VIDEO:camera_frames"
+    output_stream: "DETECTED_BORDERS:regions"
+    options:{
+    [mediapipe.autoflip.BorderDetectionCalculatorOptions.ext]:{
+      border_object_padding_px: 0
+      border_search_max_width: 160
+    }
+    })";
+
 const int kTestFrameWidth = 640;
 const int kTestFrameHeight = 480;
 
@@ -272,6 +283,47 @@ TEST(BorderDetectionCalculatorTest, TopBottomBorderTest) {
   EXPECT_EQ(Border::BOTTOM, part.relative_position());
 }
 
+TEST(BorderDetectionCalculatorTest, TopBottomBorderSubsampledTest) {
+  auto runner = ::absl::make_unique<CalculatorRunner>(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kConfigSubsampled));
+
+  const int kBottomBorderHeight = 50;
+  const int kTopBorderHeight = 25;
+
+  auto input_frame = ::absl::make_unique<ImageFrame>(
+      ImageFormat::SRGB, kTestFrameWidth, kTestFrameHeight);
+  cv::Mat input_mat = mediapipe::formats::MatView(input_frame.get());
+  input_mat.setTo(cv::Scalar(0, 0, 0));
+  input_mat(cv::Rect(0, 0, kTestFrameWidth, kTopBorderHeight))
+      .setTo(cv::Scalar(0, 255, 0));
+  input_mat(cv::Rect(0, kTestFrameHeight - kBottomBorderHeight,
+                     kTestFrameWidth, kBottomBorderHeight))
+      .setTo(cv::Scalar(255, 0, 0));
+  runner->MutableInputs()->Tag(kVideoTag).packets.push_back(
+      Adopt(input_frame.release()).At(Timestamp::PostStream()));
+
+  // Run the calculator.
+  MP_ASSERT_OK(runner->Run());
+
+  // Borders are found at full resolution positions and width.
+  const std::vector<Packet>& output_packets =
+      runner->Outputs().Tag(kDetectedBordersTag).packets;
+  ASSERT_EQ(1, output_packets.size());
+  const auto& static_features = output_packets[0].Get<StaticFeatures>();
+  ASSERT_EQ(2, static_features.border().size());
+  auto part = static_features.border(0);
+  EXPECT_EQ(part.border_position().y(), 0);
+  EXPECT_EQ(part.border_position().width(), kTestFrameWidth);
+  EXPECT_LT(std::abs(part.border_position().height() - kTopBorderHeight), 2);
+  EXPECT_EQ(Border::TOP, part.relative_position());
+  part = static_features.border(1);
+  EXPECT_EQ(part.border_position().y(), kTestFrameHeight - kBottomBorderHeight);
+  EXPECT_EQ(part.border_position().width(), kTestFrameWidth);
+  EXPECT_LT(std::abs(part.border_position().height() - kBottomBorderHeight), 2);
+  EXPECT_EQ(Border::BOTTOM, part.relative_position());
+  EXPECT_EQ(kTestFrameWidth, static_features.non_static_area().width());
+}
+
 TEST(BorderDetectionCalculatorTest, TopBottomBorderTestAspect2) {
   auto runner = ::absl::make_unique<CalculatorRunner>(
       ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kConfig));
@@ -14,7 +14,11 @@
 
 #include "mediapipe/examples/desktop/autoflip/calculators/scene_cropping_calculator.h"
 
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_format.h"
@@ -30,6 +34,7 @@
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/threadpool.h"
 #include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
@@ -173,6 +178,22 @@ absl::Status SceneCroppingCalculator::Open(CalculatorContext* cc) {
         absl::make_unique<std::vector<ExternalRenderFrame>>();
   }
   should_perform_frame_cropping_ = cc->Outputs().HasTag(kOutputCroppedFrames);
+  if (options_.buffer_frames_on_disk()) {
+    RET_CHECK(!cc->Outputs().HasTag(kOutputKeyFrameCropViz) &&
+              !cc->Outputs().HasTag(kOutputFocusPointFrameViz) &&
+              !cc->Outputs().HasTag(kOutputFramingAndDetections))
+        << "Visualization outputs are not supported when buffering frames on "
+           "disk.";
+  }
+  RET_CHECK_GE(options_.num_scene_threads(), 0)
+      << "Number of scene threads is negative.";
+  if (options_.num_scene_threads() > 0 && should_perform_frame_cropping_) {
+    RET_CHECK(!options_.buffer_frames_on_disk())
+        << "Scene threads are not supported when buffering frames on disk.";
+    scene_pool_ = std::make_unique<ThreadPool>("autoflip_scene",
+                                               options_.num_scene_threads());
+    scene_pool_->StartWorkers();
+  }
   scene_camera_motion_analyzer_ = absl::make_unique<SceneCameraMotionAnalyzer>(
       options_.scene_camera_motion_analyzer_options());
   return absl::OkStatus();
@@ -394,9 +415,18 @@ absl::Status SceneCroppingCalculator::Process(
     if (should_perform_frame_cropping_) {
       const auto& frame = cc->Inputs().Tag(kInputVideoFrames).Get<ImageFrame>();
       const cv::Mat frame_mat = formats::MatView(&frame);
-      cv::Mat copy_mat;
-      frame_mat.copyTo(copy_mat);
-      scene_frames_or_empty_.push_back(copy_mat);
+      if (options_.buffer_frames_on_disk()) {
+        if (!frame_buffer_) {
+          MP_RETURN_IF_ERROR(FrameBufferFile::Create(
+              frame_mat.cols, frame_mat.rows, frame_mat.type(),
+              &frame_buffer_));
+        }
+        MP_RETURN_IF_ERROR(frame_buffer_->Append(frame_mat));
+      } else {
+        cv::Mat copy_mat;
+        frame_mat.copyTo(copy_mat);
+        scene_frames_or_empty_.push_back(copy_mat);
+      }
     }
     scene_frame_timestamps_.push_back(cc->InputTimestamp().Value());
     is_key_frames_.push_back(
@@ -429,6 +459,10 @@ absl::Status SceneCroppingCalculator::Process(
     continue_last_scene_ = true;
   }
 
+  if (scene_pool_) {
+    MP_RETURN_IF_ERROR(
+        OutputRenderedScenes(cc, options_.num_scene_threads()));
+  }
   return absl::OkStatus();
 }
 
@@ -436,6 +470,10 @@ absl::Status SceneCroppingCalculator::Close(mediapipe::CalculatorContext* cc) {
   if (!scene_frame_timestamps_.empty()) {
     MP_RETURN_IF_ERROR(ProcessScene(/* is_end_of_scene = */ true, cc));
   }
+  if (scene_pool_) {
+    MP_RETURN_IF_ERROR(OutputRenderedScenes(cc, /*max_in_flight=*/0));
+    scene_pool_.reset();
+  }
   if (cc->Outputs().HasTag(kOutputSummary)) {
     cc->Outputs()
         .Tag(kOutputSummary)
@@ -583,14 +621,40 @@ absl::Status SceneCroppingCalculator::ProcessScene(const bool is_end_of_scene,
   std::vector<cv::Mat> cropped_frames;
   std::vector<cv::Rect> crop_from_locations;
 
+  // Frames buffered on disk are cropped one at a time when they are output,
+  // and frames rendered on scene_pool_ are cropped there.
   auto* cropped_frames_ptr =
-      should_perform_frame_cropping_ ? &cropped_frames : nullptr;
-
-  MP_RETURN_IF_ERROR(scene_cropper_->CropFrames(
-      scene_summary, scene_frame_timestamps_, is_key_frames_,
-      scene_frames_or_empty_, focus_point_frames, prior_focus_point_frames_,
-      top_static_border_size, bottom_static_border_size, continue_last_scene_,
-      &crop_from_locations, cropped_frames_ptr));
+      should_perform_frame_cropping_ && !frame_buffer_ && !scene_pool_
+          ? &cropped_frames
+          : nullptr;
+
+  std::vector<cv::Mat> scene_frame_xforms;
+  if (scene_pool_) {
+    MP_RETURN_IF_ERROR(scene_cropper_->ComputeTransforms(
+        scene_summary, scene_frame_timestamps_, is_key_frames_,
+        focus_point_frames, prior_focus_point_frames_, top_static_border_size,
+        bottom_static_border_size, continue_last_scene_, &crop_from_locations,
+        &scene_frame_xforms));
+  } else {
+    MP_RETURN_IF_ERROR(scene_cropper_->CropFrames(
+        scene_summary, scene_frame_timestamps_, is_key_frames_,
+        scene_frames_or_empty_, focus_point_frames, prior_focus_point_frames_,
+        top_static_border_size, bottom_static_border_size,
+        continue_last_scene_, &crop_from_locations, cropped_frames_ptr));
+  }
+
+  // Maps the crop windows from the border-removed frames back to the input
+  // frames buffered on disk.
+  std::vector<cv::Rect> crop_regions;
+  if (frame_buffer_) {
+    crop_regions.reserve(crop_from_locations.size());
+    for (const auto& crop_from : crop_from_locations) {
+      crop_regions.emplace_back(
+          crop_from.x,
+          crop_from.y - top_static_border_size + top_border_distance_,
+          crop_from.width, crop_from.height);
+    }
+  }
 
   // Formats and outputs cropped frames.
   bool apply_padding = false;
@@ -600,7 +664,8 @@ absl::Status SceneCroppingCalculator::ProcessScene(const bool is_end_of_scene,
   MP_RETURN_IF_ERROR(FormatAndOutputCroppedFrames(
       scene_summary.crop_window_width(), scene_summary.crop_window_height(),
       scene_frame_timestamps_.size(), &render_to_locations, &apply_padding,
-      &padding_colors, &vertical_fill_percent, cropped_frames_ptr, cc));
+      &padding_colors, &vertical_fill_percent, cropped_frames_ptr,
+      crop_regions, scene_frame_xforms, cc));
   // Caches prior FocusPointFrames if this was not the end of a scene.
   prior_focus_point_frames_.clear();
   if (!is_end_of_scene) {
@@ -662,6 +727,9 @@ absl::Status SceneCroppingCalculator::ProcessScene(const bool is_end_of_scene,
 
   key_frame_infos_.clear();
   scene_frames_or_empty_.clear();
+  if (frame_buffer_) {
+    frame_buffer_->Clear();
+  }
   scene_frame_timestamps_.clear();
   is_key_frames_.clear();
   static_features_.clear();
@@ -673,7 +741,9 @@ absl::Status SceneCroppingCalculator::FormatAndOutputCroppedFrames(
     const int crop_width, const int crop_height, const int num_frames,
     std::vector<cv::Rect>* render_to_locations, bool* apply_padding,
     std::vector<cv::Scalar>* padding_colors, float* vertical_fill_percent,
-    const std::vector<cv::Mat>* cropped_frames_ptr, CalculatorContext* cc) {
+    const std::vector<cv::Mat>* cropped_frames_ptr,
+    const std::vector<cv::Rect>& crop_regions,
+    const std::vector<cv::Mat>& scene_frame_xforms, CalculatorContext* cc) {
   RET_CHECK(apply_padding) << "Has padding boolean is null.";
 
   // Computes scaling factor and decides if padding is needed.
@@ -693,7 +763,7 @@ absl::Status SceneCroppingCalculator::FormatAndOutputCroppedFrames(
       scaled_width != target_width_ || scaled_height != target_height_;
   *vertical_fill_percent = scaled_height / static_cast<float>(target_height_);
   if (*apply_padding) {
-    padder_ = absl::make_unique<PaddingEffectGenerator>(
+    padder_ = std::make_shared<PaddingEffectGenerator>(
         scaled_width, scaled_height, target_aspect_ratio_);
     VLOG(1) << "Scene is padded: scaled width = " << scaled_width
             << " target width = " << target_width_
@@ -741,48 +811,156 @@ absl::Status SceneCroppingCalculator::FormatAndOutputCroppedFrames(
     }
     padding_colors->push_back(padding_color_to_add);
   }
-  if (!cropped_frames_ptr) {
+  if (!cropped_frames_ptr && !frame_buffer_ && !scene_pool_) {
     return absl::OkStatus();
   }
+  if (frame_buffer_) {
+    RET_CHECK_EQ(frame_buffer_->num_frames(), num_frames)
+        << "Number of buffered frames does not match the scene size.";
+    RET_CHECK_EQ(static_cast<int>(crop_regions.size()), num_frames)
+        << "Number of crop regions does not match the scene size.";
+  }
+
+  PaddingEffectGenerator* padder = *apply_padding ? padder_.get() : nullptr;
+  if (scene_pool_) {
+    // Crops, scales and pads the frames on scene_pool_. The frames are output
+    // in timestamp order by OutputRenderedScenes().
+    auto job = std::make_shared<SceneRenderJob>();
+    job->frames = scene_frames_or_empty_;
+    job->xforms = scene_frame_xforms;
+    job->timestamps = scene_frame_timestamps_;
+    job->crop_size = cv::Size(crop_width, crop_height);
+    job->scaled_width = scaled_width;
+    job->scaled_height = scaled_height;
+    job->scaling = scaling;
+    job->padder = padder ? padder_ : nullptr;
+    if (padder && has_solid_background_) {
+      job->background_colors = *padding_colors;
+    }
+    {
+      absl::MutexLock lock(&mutex_);
+      scenes_in_flight_.push_back(job);
+    }
+    scene_pool_->Schedule([this, job] {
+      std::vector<std::unique_ptr<ImageFrame>> output_frames;
+      absl::Status status = RenderScene(*job, &output_frames);
+      absl::MutexLock lock(&mutex_);
+      job->output_frames = std::move(output_frames);
+      job->status = std::move(status);
+      job->done = true;
+    });
+    return OutputRenderedScenes(cc, options_.num_scene_threads());
+  }
 
   // Resizes cropped frames, pads frames, and output frames.
+  cv::Mat buffered_frame;
   for (int i = 0; i < num_frames; ++i) {
     const int64_t time_ms = scene_frame_timestamps_[i];
     const Timestamp timestamp(time_ms);
-    auto scaled_frame = absl::make_unique<ImageFrame>(
-        frame_format_, scaled_width, scaled_height);
-    auto destination = formats::MatView(scaled_frame.get());
-    if (scaled_width == crop_width && scaled_height == crop_height) {
-      cropped_frames_ptr->at(i).copyTo(destination);
+    cv::Mat cropped_frame;
+    if (frame_buffer_) {
+      MP_RETURN_IF_ERROR(frame_buffer_->Read(i, &buffered_frame));
+      cv::Rect roi = crop_regions[i];
+      RET_CHECK(roi.width <= buffered_frame.cols &&
+                roi.height <= buffered_frame.rows)
+          << "Crop region exceeds the frame size.";
+      roi.x = std::clamp(roi.x, 0, buffered_frame.cols - roi.width);
+      roi.y = std::clamp(roi.y, 0, buffered_frame.rows - roi.height);
+      cropped_frame = buffered_frame(roi);
     } else {
-      // cubic is better quality for upscaling and area is good for
-      // downscaling
-      const int interpolation_method =
-          scaling > 1 ? cv::INTER_CUBIC : cv::INTER_AREA;
-      cv::resize(cropped_frames_ptr->at(i), destination, destination.size(), 0,
-                 0, interpolation_method);
+      cropped_frame = cropped_frames_ptr->at(i);
     }
-    if (*apply_padding) {
-      cv::Scalar* background_color = nullptr;
-      if (has_solid_background_) {
-        background_color = &padding_colors->at(i);
+    const cv::Scalar* background_color =
+        padder && has_solid_background_ ? &padding_colors->at(i) : nullptr;
+    std::unique_ptr<ImageFrame> output_frame;
+    MP_RETURN_IF_ERROR(ScaleAndPadFrame(cropped_frame, scaled_width,
+                                        scaled_height, scaling, padder,
+                                        background_color, &output_frame));
+    cc->Outputs()
+        .Tag(kOutputCroppedFrames)
+        .Add(output_frame.release(), timestamp);
+  }
+  return absl::OkStatus();
+}
+
+absl::Status SceneCroppingCalculator::ScaleAndPadFrame(
+    const cv::Mat& cropped_frame, const int scaled_width,
+    const int scaled_height, const double scaling,
+    PaddingEffectGenerator* padder, const cv::Scalar* background_color,
+    std::unique_ptr<ImageFrame>* output_frame) const {
+  auto scaled_frame = absl::make_unique<ImageFrame>(
+      frame_format_, scaled_width, scaled_height);
+  auto destination = formats::MatView(scaled_frame.get());
+  if (scaled_width == cropped_frame.cols &&
+      scaled_height == cropped_frame.rows) {
+    cropped_frame.copyTo(destination);
+  } else {
+    // cubic is better quality for upscaling and area is good for
+    // downscaling
+    const int interpolation_method =
+        scaling > 1 ? cv::INTER_CUBIC : cv::INTER_AREA;
+    cv::resize(cropped_frame, destination, destination.size(), 0, 0,
+               interpolation_method);
+  }
+  if (!padder) {
+    *output_frame = std::move(scaled_frame);
+    return absl::OkStatus();
+  }
+  auto padded_frame = absl::make_unique<ImageFrame>();
+  MP_RETURN_IF_ERROR(padder->Process(
+      *scaled_frame, background_contrast_,
+      std::min({blur_cv_size_, scaled_width, scaled_height}), overlay_opacity_,
+      padded_frame.get(), background_color));
+  RET_CHECK_EQ(padded_frame->Width(), target_width_)
+      << "Padded frame width is off.";
+  RET_CHECK_EQ(padded_frame->Height(), target_height_)
+      << "Padded frame height is off.";
+  *output_frame = std::move(padded_frame);
+  return absl::OkStatus();
+}
+
+absl::Status SceneCroppingCalculator::RenderScene(
+    const SceneRenderJob& job,
+    std::vector<std::unique_ptr<ImageFrame>>* output_frames) const {
+  const int num_frames = job.frames.size();
+  std::vector<cv::Mat> cropped_frames(num_frames);
+  for (int i = 0; i < num_frames; ++i) {
+    cropped_frames[i] = cv::Mat::zeros(job.crop_size, job.frames[i].type());
+  }
+  MP_RETURN_IF_ERROR(AffineRetarget(job.crop_size, job.frames, job.xforms,
+                                    &cropped_frames));
+  output_frames->resize(num_frames);
+  for (int i = 0; i < num_frames; ++i) {
+    const cv::Scalar* background_color =
+        job.background_colors.empty() ? nullptr : &job.background_colors[i];
+    MP_RETURN_IF_ERROR(ScaleAndPadFrame(
+        cropped_frames[i], job.scaled_width, job.scaled_height, job.scaling,
+        job.padder.get(), background_color, &(*output_frames)[i]));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status SceneCroppingCalculator::OutputRenderedScenes(
+    CalculatorContext* cc, int max_in_flight) {
+  while (true) {
+    std::shared_ptr<SceneRenderJob> job;
+    {
+      absl::MutexLock lock(&mutex_);
+      if (scenes_in_flight_.empty()) break;
+      if (scenes_in_flight_.size() > static_cast<size_t>(max_in_flight)) {
+        mutex_.Await(absl::Condition(
+            this, &SceneCroppingCalculator::IsOldestSceneRendered));
+      } else if (!scenes_in_flight_.front()->done) {
+        break;
       }
-      auto padded_frame = absl::make_unique<ImageFrame>();
-      MP_RETURN_IF_ERROR(padder_->Process(
-          *scaled_frame, background_contrast_,
-          std::min({blur_cv_size_, scaled_width, scaled_height}),
-          overlay_opacity_, padded_frame.get(), background_color));
-      RET_CHECK_EQ(padded_frame->Width(), target_width_)
-          << "Padded frame width is off.";
-      RET_CHECK_EQ(padded_frame->Height(), target_height_)
-          << "Padded frame height is off.";
-      cc->Outputs()
-          .Tag(kOutputCroppedFrames)
-          .Add(padded_frame.release(), timestamp);
-    } else {
+      job = std::move(scenes_in_flight_.front());
+      scenes_in_flight_.pop_front();
+    }
+    MP_RETURN_IF_ERROR(job->status);
+    for (int i = 0; i < job->output_frames.size(); ++i) {
       cc->Outputs()
           .Tag(kOutputCroppedFrames)
-          .Add(scaled_frame.release(), timestamp);
+          .Add(job->output_frames[i].release(), Timestamp(job->timestamps[i]));
     }
   }
   return absl::OkStatus();
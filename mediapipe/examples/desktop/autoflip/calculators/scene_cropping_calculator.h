@@ -16,13 +16,18 @@
 #define MEDIAPIPE_EXAMPLES_DESKTOP_AUTOFLIP_CALCULATORS_SCENE_CROPPING_CALCULATOR_H_
 
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
 #include "mediapipe/examples/desktop/autoflip/autoflip_messages.pb.h"
 #include "mediapipe/examples/desktop/autoflip/calculators/scene_cropping_calculator.pb.h"
 #include "mediapipe/examples/desktop/autoflip/quality/cropping.pb.h"
 #include "mediapipe/examples/desktop/autoflip/quality/focus_point.pb.h"
+#include "mediapipe/examples/desktop/autoflip/quality/frame_buffer_file.h"
 #include "mediapipe/examples/desktop/autoflip/quality/frame_crop_region_computer.h"
 #include "mediapipe/examples/desktop/autoflip/quality/padding_effect_generator.h"
 #include "mediapipe/examples/desktop/autoflip/quality/piecewise_linear_function.h"
@@ -34,6 +39,7 @@
 #include "mediapipe/framework/port/opencv_core_inc.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/threadpool.h"
 
 namespace mediapipe {
 namespace autoflip {
@@ -175,12 +181,60 @@ class SceneCroppingCalculator : public CalculatorBase {
   // |cropped_frames_ptr| to nullptr, to bypass the actual output of the
   // cropped frames. This is useful when the calculator is only used for
   // computing the cropping metadata rather than doing the actual cropping
-  // operation.
+  // operation. If |frame_buffer_| is set, |cropped_frames_ptr| is ignored and
+  // the frames are instead read back from |frame_buffer_| and cropped to
+  // |crop_regions|, given in input frame coordinates. If |scene_pool_| is set,
+  // the scene frames are instead cropped with |scene_frame_xforms| on the pool
+  // and output later by OutputRenderedScenes().
   absl::Status FormatAndOutputCroppedFrames(
       const int crop_width, const int crop_height, const int num_frames,
       std::vector<cv::Rect>* render_to_locations, bool* apply_padding,
       std::vector<cv::Scalar>* padding_colors, float* vertical_fill_percent,
-      const std::vector<cv::Mat>* cropped_frames_ptr, CalculatorContext* cc);
+      const std::vector<cv::Mat>* cropped_frames_ptr,
+      const std::vector<cv::Rect>& crop_regions,
+      const std::vector<cv::Mat>& scene_frame_xforms, CalculatorContext* cc);
+
+  // Scales a cropped frame to |scaled_width| x |scaled_height| and, if
+  // |padder| is not null, pads it to the target size with |background_color|
+  // or, if that is null, a blurred background.
+  absl::Status ScaleAndPadFrame(
+      const cv::Mat& cropped_frame, const int scaled_width,
+      const int scaled_height, const double scaling,
+      PaddingEffectGenerator* padder, const cv::Scalar* background_color,
+      std::unique_ptr<ImageFrame>* output_frame) const;
+
+  // The frames of a scene to be cropped, scaled and padded on scene_pool_.
+  struct SceneRenderJob {
+    std::vector<cv::Mat> frames;
+    std::vector<cv::Mat> xforms;
+    std::vector<int64_t> timestamps;
+    cv::Size crop_size;
+    int scaled_width = 0;
+    int scaled_height = 0;
+    double scaling = 1.0;
+    // Null if the scene is not padded.
+    std::shared_ptr<PaddingEffectGenerator> padder;
+    // Empty unless padding with a solid background.
+    std::vector<cv::Scalar> background_colors;
+
+    // Results, set on scene_pool_ under mutex_.
+    absl::Status status;
+    std::vector<std::unique_ptr<ImageFrame>> output_frames;
+    bool done = false;
+  };
+
+  // Crops, scales and pads the frames of |job|. Runs on scene_pool_.
+  absl::Status RenderScene(
+      const SceneRenderJob& job,
+      std::vector<std::unique_ptr<ImageFrame>>* output_frames) const;
+
+  // Outputs the rendered scenes in timestamp order, waiting for the oldest ones
+  // until no more than |max_in_flight| scenes are being rendered.
+  absl::Status OutputRenderedScenes(CalculatorContext* cc, int max_in_flight);
+
+  bool IsOldestSceneRendered() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return scenes_in_flight_.front()->done;
+  }
 
   // Draws and outputs visualization frames if those streams are present.
   absl::Status OutputVizFrames(
@@ -228,6 +282,11 @@ class SceneCroppingCalculator : public CalculatorBase {
   std::vector<int64_t> scene_frame_timestamps_;
   std::vector<bool> is_key_frames_;
 
+  // Buffered frames of the current scene when |buffer_frames_on_disk| is set,
+  // in which case scene_frames_or_empty_ stays empty. Created on the first
+  // frame.
+  std::unique_ptr<FrameBufferFile> frame_buffer_;
+
   // Static border information for the scene.
   int top_border_distance_ = -1;
   int effective_frame_height_ = -1;
@@ -271,8 +330,9 @@ class SceneCroppingCalculator : public CalculatorBase {
   float background_contrast_ = -1.0;
   int blur_cv_size_ = -1;
   float overlay_opacity_ = -1.0;
-  // Object for padding an image to a target aspect ratio.
-  std::unique_ptr<PaddingEffectGenerator> padder_ = nullptr;
+  // Object for padding an image to a target aspect ratio. Shared with the
+  // SceneRenderJob of the scene when rendering on scene_pool_.
+  std::shared_ptr<PaddingEffectGenerator> padder_ = nullptr;
 
   // Optional diagnostic summary output emitted in Close().
   std::unique_ptr<VideoCroppingSummary> summary_ = nullptr;
@@ -287,6 +347,14 @@ class SceneCroppingCalculator : public CalculatorBase {
   // processing. Some debugging visualization inevitably will be disabled
   // because of this flag too.
   bool should_perform_frame_cropping_ = false;
+
+  // Scenes being rendered on scene_pool_, in timestamp order.
+  absl::Mutex mutex_;
+  std::deque<std::shared_ptr<SceneRenderJob>> scenes_in_flight_
+      ABSL_GUARDED_BY(mutex_);
+  // Pool for rendering scenes if num_scene_threads is positive. Declared last
+  // so that pending renders finish before the state they use is destroyed.
+  std::unique_ptr<ThreadPool> scene_pool_;
 };
 }  // namespace autoflip
 }  // namespace mediapipe
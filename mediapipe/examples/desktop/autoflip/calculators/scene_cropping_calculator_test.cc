@@ -501,6 +501,44 @@ TEST(SceneCroppingCalculatorTest, CropsToTargetSize) {
   CheckCroppedFrames(*runner, num_frames, kTargetWidth, kTargetHeight);
 }
 
+// Checks that rendering scenes on a thread pool outputs the same frames, in
+// the same order, as rendering them on the calculator thread.
+TEST(SceneCroppingCalculatorTest, RendersScenesOnThreads) {
+  std::vector<Packet> outputs[2];
+  for (int num_scene_threads : {0, 2}) {
+    auto config = ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+        absl::Substitute(kConfig, kTargetWidth, kTargetHeight, kTargetSizeType,
+                         kMaxSceneSize, kPriorFrameBufferSize));
+    config.mutable_options()
+        ->MutableExtension(SceneCroppingCalculatorOptions::ext)
+        ->set_num_scene_threads(num_scene_threads);
+    auto runner = absl::make_unique<CalculatorRunner>(config);
+    GetGen().seed(0);
+    for (int i = 0; i < kNumScenes; ++i) {
+      AddScene(i * kSceneSize, kSceneSize, kInputFrameWidth, kInputFrameHeight,
+               kKeyFrameWidth, kKeyFrameHeight, kDownSampleRate,
+               runner->MutableInputs());
+    }
+    // Adds a scene that is force flushed.
+    AddScene(kNumScenes * kSceneSize, 2 * kMaxSceneSize, kInputFrameWidth,
+             kInputFrameHeight, kKeyFrameWidth, kKeyFrameHeight,
+             kDownSampleRate, runner->MutableInputs());
+    MP_ASSERT_OK(runner->Run());
+    outputs[num_scene_threads > 0] =
+        runner->Outputs().Tag(kCroppedFramesTag).packets;
+  }
+
+  ASSERT_EQ(outputs[0].size(), kNumScenes * kSceneSize + 2 * kMaxSceneSize);
+  ASSERT_EQ(outputs[1].size(), outputs[0].size());
+  for (int i = 0; i < outputs[0].size(); ++i) {
+    EXPECT_EQ(outputs[1][i].Timestamp(), outputs[0][i].Timestamp());
+    const cv::Mat expected = formats::MatView(&outputs[0][i].Get<ImageFrame>());
+    const cv::Mat actual = formats::MatView(&outputs[1][i].Get<ImageFrame>());
+    ASSERT_EQ(actual.size(), expected.size());
+    EXPECT_EQ(cv::norm(actual, expected, cv::NORM_INF), 0);
+  }
+}
+
 // Checks that the calculator crops scene frames to input size when the target
 // size type is KEEP_ORIGINAL_DIMENSION.
 TEST(SceneCroppingCalculatorTest, CropsToOriginalDimension) {
@@ -12,13 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <map>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "absl/container/btree_map.h"
+#include "absl/container/flat_hash_map.h"
 #include "mediapipe/examples/desktop/autoflip/autoflip_messages.pb.h"
 #include "mediapipe/examples/desktop/autoflip/calculators/signal_fusing_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
@@ -112,8 +112,13 @@ class SignalFusingCalculator : public mediapipe::CalculatorBase {
  private:
   absl::Status ProcessScene(mediapipe::CalculatorContext* cc);
   std::vector<Packet> GetSignalPackets(mediapipe::CalculatorContext* cc);
+  // Returns the settings for a signal type, or nullptr if there are none.
+  const SignalSettings* FindSettings(const SignalType& signal_type) const;
   SignalFusingCalculatorOptions options_;
-  std::map<std::string, SignalSettings> settings_by_type_;
+  // Settings indexed by standard signal type, and by custom signal type. Point
+  // into options_, with later settings for a type overriding earlier ones.
+  std::vector<const SignalSettings*> standard_settings_;
+  absl::flat_hash_map<std::string, const SignalSettings*> custom_settings_;
   std::vector<Frame> scene_frames_;
   bool tag_input_interface_;
   bool process_by_scene_;
@@ -121,19 +126,14 @@ class SignalFusingCalculator : public mediapipe::CalculatorBase {
 REGISTER_CALCULATOR(SignalFusingCalculator);
 
 namespace {
-std::string CreateSettingsKey(const SignalType& signal_type) {
-  if (signal_type.has_standard()) {
-    return "standard_" + std::to_string(signal_type.standard());
-  } else {
-    return "custom_" + signal_type.custom();
-  }
-}
-std::string CreateKey(const InputSignal& detection) {
-  std::string id_source = std::to_string(detection.source);
-  std::string id_signal = std::to_string(detection.signal.tracking_id());
-  std::string id = id_source + ":" + id_signal;
-  return id;
-}
+// Sum of the scores of a tracked detection over a scene, keyed by its input
+// source and tracking id.
+struct TrackScore {
+  float score_sum = 0.0;
+  int count = 0;
+};
+using TrackKey = std::pair<int, int64_t>;
+
 void SetupTagInput(mediapipe::CalculatorContract* cc) {
   if (cc->Inputs().HasTag(kIsShotBoundaryTag)) {
     cc->Inputs().Tag(kIsShotBoundaryTag).Set<bool>();
@@ -155,8 +155,13 @@ void SetupOrderedInput(mediapipe::CalculatorContract* cc) {
 
 absl::Status SignalFusingCalculator::Open(mediapipe::CalculatorContext* cc) {
   options_ = cc->Options<SignalFusingCalculatorOptions>();
+  standard_settings_.assign(SignalType::StandardType_ARRAYSIZE, nullptr);
   for (const auto& setting : options_.signal_settings()) {
-    settings_by_type_[CreateSettingsKey(setting.type())] = setting;
+    if (setting.type().has_standard()) {
+      standard_settings_[setting.type().standard()] = &setting;
+    } else {
+      custom_settings_[setting.type().custom()] = &setting;
+    }
   }
   if (cc->Inputs().HasTag(kSignalInputsTag)) {
     tag_input_interface_ = true;
@@ -175,58 +180,62 @@ absl::Status SignalFusingCalculator::Close(mediapipe::CalculatorContext* cc) {
   return absl::OkStatus();
 }
 
+const SignalSettings* SignalFusingCalculator::FindSettings(
+    const SignalType& signal_type) const {
+  if (signal_type.has_standard()) {
+    const int index = signal_type.standard();
+    if (index < 0 || index >= static_cast<int>(standard_settings_.size())) {
+      return nullptr;
+    }
+    return standard_settings_[index];
+  }
+  auto settings_it = custom_settings_.find(signal_type.custom());
+  return settings_it != custom_settings_.end() ? settings_it->second : nullptr;
+}
+
 absl::Status SignalFusingCalculator::ProcessScene(
     mediapipe::CalculatorContext* cc) {
-  absl::btree_map<std::string, int> detection_count;
-  absl::btree_map<std::string, float> multiframe_score;
   // Create a unified score for all items with temporal ids.
+  absl::flat_hash_map<TrackKey, TrackScore> track_scores;
   for (const Frame& frame : scene_frames_) {
     for (const auto& detection : frame.input_detections) {
       if (detection.signal.has_tracking_id()) {
-        // Create key for each detector type
-        if (detection_count.find(CreateKey(detection)) ==
-            detection_count.end()) {
-          multiframe_score[CreateKey(detection)] = 0.0;
-          detection_count[CreateKey(detection)] = 0;
-        }
-        multiframe_score[CreateKey(detection)] += detection.signal.score();
-        detection_count[CreateKey(detection)]++;
+        TrackScore& track_score = track_scores[TrackKey(
+            detection.source, detection.signal.tracking_id())];
+        track_score.score_sum += detection.signal.score();
+        track_score.count++;
       }
     }
   }
-  // Average scores.
-  for (auto iterator = multiframe_score.begin();
-       iterator != multiframe_score.end(); iterator++) {
-    multiframe_score[iterator->first] =
-        iterator->second / detection_count[iterator->first];
-  }
   // Process detections.
   for (const Frame& frame : scene_frames_) {
     std::unique_ptr<DetectionSet> processed_detections(new DetectionSet());
-    for (auto detection : frame.input_detections) {
-      float score = detection.signal.score();
-      if (detection.signal.has_tracking_id()) {
-        std::string id_source = std::to_string(detection.source);
-        std::string id_signal = std::to_string(detection.signal.tracking_id());
-        std::string id = id_source + ":" + id_signal;
-        score = multiframe_score[id];
+    processed_detections->mutable_detections()->Reserve(
+        frame.input_detections.size());
+    for (const auto& detection : frame.input_detections) {
+      SalientRegion* region = processed_detections->add_detections();
+      *region = detection.signal;
+      float score = region->score();
+      if (region->has_tracking_id()) {
+        // Average score over the scene.
+        const TrackScore& track_score = track_scores.at(
+            TrackKey(detection.source, region->tracking_id()));
+        score = track_score.score_sum / track_score.count;
       }
       // Normalize within range.
       float min_value = 0.0;
       float max_value = 1.0;
 
-      auto settings_it = settings_by_type_.find(
-          CreateSettingsKey(detection.signal.signal_type()));
-      if (settings_it != settings_by_type_.end()) {
-        min_value = settings_it->second.min_score();
-        max_value = settings_it->second.max_score();
-        detection.signal.set_is_required(settings_it->second.is_required());
-        detection.signal.set_only_required(settings_it->second.only_required());
+      const SignalSettings* settings = FindSettings(region->signal_type());
+      if (settings) {
+        min_value = settings->min_score();
+        max_value = settings->max_score();
+        region->set_is_required(settings->is_required());
+        region->set_only_required(settings->only_required());
       }
 
       float final_score = score * (max_value - min_value) + min_value;
-      detection.signal.set_score(final_score);
-      *processed_detections->add_detections() = detection.signal;
+      region->set_score(final_score);
     }
     if (tag_input_interface_) {
       cc->Outputs()
@@ -282,14 +291,11 @@ absl::Status SignalFusingCalculator::Process(mediapipe::CalculatorContext* cc) {
     }
     const auto& detection_set = packet.Get<autoflip::DetectionSet>();
     for (const auto& detection : detection_set.detections()) {
-      InputSignal input;
-      input.signal = detection;
-      input.source = i;
-      frame.input_detections.push_back(input);
+      frame.input_detections.push_back({detection, i});
     }
   }
   frame.time = cc->InputTimestamp();
-  scene_frames_.push_back(frame);
+  scene_frames_.push_back(std::move(frame));
 
   // Flush buffer on same input if it exceeds max_scene_size or if there is not
   // shot input information.
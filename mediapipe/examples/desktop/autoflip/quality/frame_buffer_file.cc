@@ -0,0 +1,88 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/examples/desktop/autoflip/quality/frame_buffer_file.h"
+
+#include <sys/types.h>
+
+#include <cstdio>
+#include <memory>
+
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+namespace autoflip {
+
+absl::Status FrameBufferFile::Create(int width, int height, int type,
+                                     std::unique_ptr<FrameBufferFile>* buffer) {
+  RET_CHECK_GT(width, 0) << "Frame width is non-positive.";
+  RET_CHECK_GT(height, 0) << "Frame height is non-positive.";
+  RET_CHECK(buffer) << "Output frame buffer is null.";
+  std::FILE* file = std::tmpfile();
+  RET_CHECK(file) << "Failed to create a temporary file for the frame buffer.";
+  buffer->reset(new FrameBufferFile(file, width, height, type));
+  return absl::OkStatus();
+}
+
+FrameBufferFile::FrameBufferFile(std::FILE* file, int width, int height,
+                                 int type)
+    : file_(file),
+      width_(width),
+      height_(height),
+      type_(type),
+      row_size_(static_cast<size_t>(width) * CV_ELEM_SIZE(type)),
+      frame_size_(row_size_ * height) {}
+
+FrameBufferFile::~FrameBufferFile() { std::fclose(file_); }
+
+absl::Status FrameBufferFile::Seek(int index) {
+  // Uses fseeko, as the buffer of a long scene may exceed the range of long.
+  RET_CHECK_EQ(fseeko(file_, static_cast<off_t>(index) * frame_size_,
+                      SEEK_SET),
+               0)
+      << "Failed to seek to frame " << index << " in the frame buffer.";
+  return absl::OkStatus();
+}
+
+absl::Status FrameBufferFile::Append(const cv::Mat& frame) {
+  RET_CHECK(frame.cols == width_ && frame.rows == height_ &&
+            frame.type() == type_)
+      << "Frame does not match the size or type of the frame buffer.";
+  MP_RETURN_IF_ERROR(Seek(num_frames_));
+  for (int row = 0; row < height_; ++row) {
+    RET_CHECK_EQ(std::fwrite(frame.ptr(row), 1, row_size_, file_), row_size_)
+        << "Failed to write frame to the frame buffer.";
+  }
+  ++num_frames_;
+  return absl::OkStatus();
+}
+
+absl::Status FrameBufferFile::Read(int index, cv::Mat* frame) {
+  RET_CHECK(index >= 0 && index < num_frames_)
+      << "Frame " << index << " is not in the frame buffer.";
+  RET_CHECK(frame) << "Output frame is null.";
+  MP_RETURN_IF_ERROR(Seek(index));
+  frame->create(height_, width_, type_);
+  for (int row = 0; row < height_; ++row) {
+    RET_CHECK_EQ(std::fread(frame->ptr(row), 1, row_size_, file_), row_size_)
+        << "Failed to read frame from the frame buffer.";
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace autoflip
+}  // namespace mediapipe
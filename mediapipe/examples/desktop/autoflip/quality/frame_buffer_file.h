@@ -0,0 +1,73 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_EXAMPLES_DESKTOP_AUTOFLIP_QUALITY_FRAME_BUFFER_FILE_H_
+#define MEDIAPIPE_EXAMPLES_DESKTOP_AUTOFLIP_QUALITY_FRAME_BUFFER_FILE_H_
+
+#include <cstdio>
+#include <memory>
+
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/status.h"
+
+namespace mediapipe {
+namespace autoflip {
+
+// Buffers video frames of a fixed size and type in an anonymous temporary
+// file, so that the frames of a long scene can be read back one at a time once
+// the scene is processed, instead of being held in memory. The file is deleted
+// when the buffer is destroyed.
+class FrameBufferFile {
+ public:
+  // Creates a buffer for frames with the given size and OpenCV type.
+  static absl::Status Create(int width, int height, int type,
+                             std::unique_ptr<FrameBufferFile>* buffer);
+
+  FrameBufferFile(const FrameBufferFile&) = delete;
+  FrameBufferFile& operator=(const FrameBufferFile&) = delete;
+  ~FrameBufferFile();
+
+  // Appends a copy of `frame` to the buffer.
+  absl::Status Append(const cv::Mat& frame);
+
+  // Reads the frame at `index` into `frame`.
+  absl::Status Read(int index, cv::Mat* frame);
+
+  // Removes all frames. The file space is reused by the next frames.
+  void Clear() { num_frames_ = 0; }
+
+  // Returns the number of buffered frames.
+  int num_frames() const { return num_frames_; }
+
+ private:
+  FrameBufferFile(std::FILE* file, int width, int height, int type);
+
+  // Moves the file position to the frame at `index`.
+  absl::Status Seek(int index);
+
+  std::FILE* const file_;
+  const int width_;
+  const int height_;
+  const int type_;
+  // The number of bytes of a frame row and of a frame in the file.
+  const size_t row_size_;
+  const size_t frame_size_;
+  int num_frames_ = 0;
+};
+
+}  // namespace autoflip
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_EXAMPLES_DESKTOP_AUTOFLIP_QUALITY_FRAME_BUFFER_FILE_H_
@@ -0,0 +1,93 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/examples/desktop/autoflip/quality/frame_buffer_file.h"
+
+#include <memory>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace autoflip {
+namespace {
+
+constexpr int kWidth = 7;
+constexpr int kHeight = 5;
+
+cv::Mat MakeFrame(int value) {
+  return cv::Mat(kHeight, kWidth, CV_8UC3, cv::Scalar(value, value + 1, 2));
+}
+
+bool FramesEqual(const cv::Mat& a, const cv::Mat& b) {
+  return a.size() == b.size() && a.type() == b.type() &&
+         cv::norm(a, b, cv::NORM_INF) == 0;
+}
+
+TEST(FrameBufferFileTest, AppendsAndReadsFrames) {
+  std::unique_ptr<FrameBufferFile> buffer;
+  MP_ASSERT_OK(FrameBufferFile::Create(kWidth, kHeight, CV_8UC3, &buffer));
+  for (int i = 0; i < 3; ++i) {
+    MP_ASSERT_OK(buffer->Append(MakeFrame(i * 10)));
+  }
+  EXPECT_EQ(buffer->num_frames(), 3);
+  cv::Mat frame;
+  for (int i = 2; i >= 0; --i) {
+    MP_ASSERT_OK(buffer->Read(i, &frame));
+    EXPECT_TRUE(FramesEqual(frame, MakeFrame(i * 10)));
+  }
+}
+
+TEST(FrameBufferFileTest, AppendsNonContinuousFrames) {
+  std::unique_ptr<FrameBufferFile> buffer;
+  MP_ASSERT_OK(FrameBufferFile::Create(kWidth, kHeight, CV_8UC3, &buffer));
+  cv::Mat large(kHeight * 2, kWidth * 2, CV_8UC3, cv::Scalar(0, 0, 0));
+  MakeFrame(50).copyTo(large(cv::Rect(1, 1, kWidth, kHeight)));
+  MP_ASSERT_OK(buffer->Append(large(cv::Rect(1, 1, kWidth, kHeight))));
+  cv::Mat frame;
+  MP_ASSERT_OK(buffer->Read(0, &frame));
+  EXPECT_TRUE(FramesEqual(frame, MakeFrame(50)));
+}
+
+TEST(FrameBufferFileTest, ClearReusesBuffer) {
+  std::unique_ptr<FrameBufferFile> buffer;
+  MP_ASSERT_OK(FrameBufferFile::Create(kWidth, kHeight, CV_8UC3, &buffer));
+  MP_ASSERT_OK(buffer->Append(MakeFrame(1)));
+  MP_ASSERT_OK(buffer->Append(MakeFrame(2)));
+  buffer->Clear();
+  EXPECT_EQ(buffer->num_frames(), 0);
+  cv::Mat frame;
+  EXPECT_FALSE(buffer->Read(0, &frame).ok());
+  MP_ASSERT_OK(buffer->Append(MakeFrame(3)));
+  MP_ASSERT_OK(buffer->Read(0, &frame));
+  EXPECT_TRUE(FramesEqual(frame, MakeFrame(3)));
+}
+
+TEST(FrameBufferFileTest, RejectsMismatchedFrames) {
+  std::unique_ptr<FrameBufferFile> buffer;
+  MP_ASSERT_OK(FrameBufferFile::Create(kWidth, kHeight, CV_8UC3, &buffer));
+  EXPECT_FALSE(
+      buffer->Append(cv::Mat(kHeight, kWidth + 1, CV_8UC3, cv::Scalar(0)))
+          .ok());
+  EXPECT_FALSE(
+      buffer->Append(cv::Mat(kHeight, kWidth, CV_8UC1, cv::Scalar(0))).ok());
+  EXPECT_EQ(buffer->num_frames(), 0);
+}
+
+}  // namespace
+}  // namespace autoflip
+}  // namespace mediapipe
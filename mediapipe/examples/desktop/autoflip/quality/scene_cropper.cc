@@ -80,16 +80,16 @@ absl::Status SceneCropper::ProcessKinematicPathSolver(
   return absl::OkStatus();
 }
 
-absl::Status SceneCropper::CropFrames(
+absl::Status SceneCropper::ComputeTransforms(
     const SceneKeyFrameCropSummary& scene_summary,
     const std::vector<int64_t>& scene_timestamps,
     const std::vector<bool>& is_key_frames,
-    const std::vector<cv::Mat>& scene_frames_or_empty,
     const std::vector<FocusPointFrame>& focus_point_frames,
     const std::vector<FocusPointFrame>& prior_focus_point_frames,
     int top_static_border_size, int bottom_static_border_size,
     const bool continue_last_scene, std::vector<cv::Rect>* crop_from_location,
-    std::vector<cv::Mat>* cropped_frames) {
+    std::vector<cv::Mat>* scene_frame_xforms) {
+  RET_CHECK(scene_frame_xforms) << "Output transforms are null.";
   const int num_scene_frames = scene_timestamps.size();
   RET_CHECK_GT(num_scene_frames, 0) << "No scene frames.";
   RET_CHECK_EQ(focus_point_frames.size(), num_scene_frames)
@@ -110,8 +110,8 @@ absl::Status SceneCropper::CropFrames(
       << "No camera motion model selected.";
 
   // Computes transforms.
-
-  std::vector<cv::Mat> scene_frame_xforms;
+  std::vector<cv::Mat>& xforms = *scene_frame_xforms;
+  xforms.clear();
   int num_prior = 0;
   if (camera_motion_options_.has_polynomial_path_solver()) {
     num_prior = prior_focus_point_frames.size();
@@ -121,11 +121,11 @@ absl::Status SceneCropper::CropFrames(
         focus_point_frames, prior_focus_point_frames, frame_width, frame_height,
         crop_width, crop_height, &all_xforms));
 
-    scene_frame_xforms =
+    xforms =
         std::vector<cv::Mat>(all_xforms.begin() + num_prior, all_xforms.end());
 
     // Convert the matrix from center-aligned to upper-left aligned.
-    for (cv::Mat& xform : scene_frame_xforms) {
+    for (cv::Mat& xform : xforms) {
       cv::Mat affine_opencv = cv::Mat::eye(2, 3, CV_32FC1);
       affine_opencv.at<float>(0, 2) =
           -(xform.at<float>(0, 2) + frame_width / 2 - crop_width / 2);
@@ -137,22 +137,43 @@ absl::Status SceneCropper::CropFrames(
     num_prior = 0;
     MP_RETURN_IF_ERROR(ProcessKinematicPathSolver(
         scene_summary, scene_timestamps, is_key_frames, focus_point_frames,
-        continue_last_scene, &scene_frame_xforms));
+        continue_last_scene, &xforms));
   }
 
   // Store the "crop from" location on the input frame for use with an external
   // renderer.
   for (int i = 0; i < num_scene_frames; i++) {
-    const int left = -(scene_frame_xforms[i].at<float>(0, 2));
-    const int top =
-        top_static_border_size - (scene_frame_xforms[i].at<float>(1, 2));
+    const int left = -(xforms[i].at<float>(0, 2));
+    const int top = top_static_border_size - (xforms[i].at<float>(1, 2));
     crop_from_location->push_back(cv::Rect(left, top, crop_width, crop_height));
   }
+  return absl::OkStatus();
+}
+
+absl::Status SceneCropper::CropFrames(
+    const SceneKeyFrameCropSummary& scene_summary,
+    const std::vector<int64_t>& scene_timestamps,
+    const std::vector<bool>& is_key_frames,
+    const std::vector<cv::Mat>& scene_frames_or_empty,
+    const std::vector<FocusPointFrame>& focus_point_frames,
+    const std::vector<FocusPointFrame>& prior_focus_point_frames,
+    int top_static_border_size, int bottom_static_border_size,
+    const bool continue_last_scene, std::vector<cv::Rect>* crop_from_location,
+    std::vector<cv::Mat>* cropped_frames) {
+  std::vector<cv::Mat> scene_frame_xforms;
+  MP_RETURN_IF_ERROR(ComputeTransforms(
+      scene_summary, scene_timestamps, is_key_frames, focus_point_frames,
+      prior_focus_point_frames, top_static_border_size,
+      bottom_static_border_size, continue_last_scene, crop_from_location,
+      &scene_frame_xforms));
 
   // If no cropped_frames is passed in, return directly.
   if (!cropped_frames) {
     return absl::OkStatus();
   }
+  const int num_scene_frames = scene_timestamps.size();
+  const int crop_width = scene_summary.crop_window_width();
+  const int crop_height = scene_summary.crop_window_height();
   RET_CHECK(!scene_frames_or_empty.empty())
       << "If |cropped_frames| != nullptr, scene_frames_or_empty must not be "
          "empty.";
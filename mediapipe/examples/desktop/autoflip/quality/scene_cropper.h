@@ -59,7 +59,6 @@ class SceneCropper {
   // there was no actual scene change). Optionally crops the input frames based
   // on the transform matrix if |cropped_frames| is not nullptr and
   // |scene_frames_or_empty| isn't empty.
-  // TODO: split this function into two separate functions.
   absl::Status CropFrames(
       const SceneKeyFrameCropSummary& scene_summary,
       const std::vector<int64_t>& scene_timestamps,
@@ -71,6 +70,19 @@ class SceneCropper {
       const bool continue_last_scene, std::vector<cv::Rect>* crop_from_location,
       std::vector<cv::Mat>* cropped_frames);
 
+  // Computes the transformation matrices of CropFrames() without cropping any
+  // frames. The scene frames can then be cropped separately, e.g. on another
+  // thread, by AffineRetarget() with |scene_frame_xforms|.
+  absl::Status ComputeTransforms(
+      const SceneKeyFrameCropSummary& scene_summary,
+      const std::vector<int64_t>& scene_timestamps,
+      const std::vector<bool>& is_key_frames,
+      const std::vector<FocusPointFrame>& focus_point_frames,
+      const std::vector<FocusPointFrame>& prior_focus_point_frames,
+      int top_static_border_size, int bottom_static_border_size,
+      const bool continue_last_scene, std::vector<cv::Rect>* crop_from_location,
+      std::vector<cv::Mat>* scene_frame_xforms);
+
   absl::Status ProcessKinematicPathSolver(
       const SceneKeyFrameCropSummary& scene_summary,
       const std::vector<int64_t>& scene_timestamps,
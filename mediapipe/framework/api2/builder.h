@@ -749,6 +749,10 @@ class Graph {
     return *executor_p;
   }
 
+  // Returns the number of nodes added so far. Nodes appear in the config
+  // returned by GetConfig() in the order they were added.
+  int NumNodes() const { return nodes_.size(); }
+
   // Graph ports, non-typed.
   MultiSource<> In(absl::string_view graph_input) {
     return graph_boundary_.Out(graph_input);
@@ -2,6 +2,7 @@
 #define MEDIAPIPE_FRAMEWORK_API2_NODE_H_
 
 #include <memory>
+#include <optional>
 #include <type_traits>
 
 #include "absl/status/status.h"
@@ -11,6 +12,7 @@
 #include "mediapipe/framework/calculator_contract.h"
 #include "mediapipe/framework/deps/registration.h"
 #include "mediapipe/framework/subgraph.h"
+#include "mediapipe/framework/tool/type_util.h"
 
 namespace mediapipe {
 namespace api2 {
@@ -45,6 +47,8 @@ class CalculatorBaseFactoryFor<
     return std::make_unique<T>();
   }
 
+  std::optional<TypeId> CalculatorType() const final { return kTypeId<T>; }
+
  private:
   template <typename U>
   auto UpdateContract(CalculatorContract* cc)
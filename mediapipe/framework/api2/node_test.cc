@@ -571,6 +571,76 @@ TEST(NodeTest, ConsumeInputs) {
   MP_EXPECT_OK(graph.WaitUntilDone());
 }
 
+struct TypedPacketForwarder : public Node {
+  static constexpr Input<int> kIn{"IN"};
+  static constexpr Output<int> kOut{"OUT"};
+
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    RET_CHECK_EQ(kIn(cc).timestamp(), cc->InputTimestamp());
+    kOut(cc).Send(kIn(cc));
+    return {};
+  }
+};
+MEDIAPIPE_REGISTER_NODE(TypedPacketForwarder);
+
+TEST(NodeTest, TypedInputSharesValidatedPayload) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        output_stream: "out"
+        node {
+          calculator: "TypedPacketForwarder"
+          input_stream: "IN:in"
+          output_stream: "OUT:out"
+        }
+      )pb");
+  std::vector<mediapipe::Packet> out_packets;
+  tool::AddVectorSink("out", &config, &out_packets);
+  mediapipe::CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, {}));
+  MP_ASSERT_OK(graph.StartRun({}));
+  const mediapipe::Packet in_packet =
+      mediapipe::MakePacket<int>(10).At(Timestamp(1));
+  MP_ASSERT_OK(graph.AddPacketToInputStream("in", in_packet));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "in", mediapipe::MakePacket<int>(20).At(Timestamp(3))));
+  MP_ASSERT_OK(graph.CloseAllPacketSources());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  ASSERT_THAT(PacketValues<int>(out_packets), testing::ElementsAre(10, 20));
+  EXPECT_EQ(out_packets[0].Timestamp(), Timestamp(1));
+  EXPECT_EQ(out_packets[1].Timestamp(), Timestamp(3));
+  // The port reads the payload without copying it.
+  EXPECT_EQ(&out_packets[0].Get<int>(), &in_packet.Get<int>());
+}
+
+TEST(NodeTest, TypedInputRejectsWrongTypeAtStreamEntry) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        output_stream: "out"
+        node {
+          calculator: "TypedPacketForwarder"
+          input_stream: "IN:in"
+          output_stream: "OUT:out"
+        }
+      )pb");
+  std::vector<mediapipe::Packet> out_packets;
+  tool::AddVectorSink("out", &config, &out_packets);
+  mediapipe::CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config, {}));
+  MP_ASSERT_OK(graph.StartRun({}));
+  // Typed ports rely on this validation instead of checking every read.
+  const absl::Status status = graph.AddPacketToInputStream(
+      "in", mediapipe::MakePacket<float>(10).At(Timestamp(1)));
+  EXPECT_THAT(status.message(), testing::HasSubstr("float"));
+  MP_EXPECT_OK(graph.CloseAllPacketSources());
+  EXPECT_FALSE(graph.WaitUntilDone().ok());
+  EXPECT_THAT(out_packets, testing::IsEmpty());
+}
+
 // Just to test that single-port contracts work.
 struct LogSinkNode : public Node {
   static constexpr Input<int> kIn{"IN"};
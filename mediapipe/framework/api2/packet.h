@@ -34,6 +34,10 @@ using HolderBase = mediapipe::packet_internal::HolderBase;
 
 template <typename T>
 class Packet;
+template <typename T>
+class InputShardAccess;
+template <typename T>
+class InputShardOrSideAccess;
 
 struct AnyType {
   AnyType() = delete;
@@ -117,6 +121,17 @@ class PacketBase {
   std::shared_ptr<const HolderBase> payload_;
   Timestamp timestamp_;
 
+  // Like As<T>, but for payloads whose type has already been validated
+  // against T, e.g. by the input stream when the packet was added. When T is
+  // a single concrete type the runtime type check is skipped in optimized
+  // builds; OneOf and Generic fall back to As<T>.
+  template <typename T>
+  Packet<T> AsValidated() const;
+
+  template <typename T>
+  friend class InputShardAccess;
+  template <typename T>
+  friend class InputShardOrSideAccess;
   template <typename T>
   friend PacketBase PacketBaseAdopting(const T* ptr);
   friend PacketBase FromOldPacket(const mediapipe::Packet& op);
@@ -217,6 +232,15 @@ template <class V, class... U>
 struct IsCompatibleType<V, OneOf<U...>>
     : std::integral_constant<bool, (std::is_same_v<V, U> || ...)> {};
 
+// True if T names a single concrete payload type, i.e. a packet is compatible
+// with T exactly when its payload type id is kTypeId<T>.
+template <class T>
+struct IsExactType : std::true_type {};
+template <>
+struct IsExactType<internal::Generic> : std::false_type {};
+template <class... U>
+struct IsExactType<OneOf<U...>> : std::false_type {};
+
 }  // namespace internal
 
 template <typename T>
@@ -229,6 +253,18 @@ inline Packet<T> PacketBase::As() const {
 template <>
 inline Packet<internal::Generic> PacketBase::As<internal::Generic>() const;
 
+template <typename T>
+inline Packet<T> PacketBase::AsValidated() const {
+  if constexpr (internal::IsExactType<T>{}) {
+    ABSL_DCHECK(!payload_ || payload_->PayloadIsOfType<T>())
+        << "The Packet stores \"" << payload_->DebugTypeName() << "\", but \""
+        << MediaPipeTypeStringOrDemangled<T>() << "\" was requested.";
+    return Packet<T>(payload_).At(timestamp_);
+  } else {
+    return As<T>();
+  }
+}
+
 template <typename T = internal::Generic>
 class Packet;
 #if __cplusplus >= 201703L
@@ -640,9 +640,12 @@ class InputShardAccess : public Packet<T> {
   }
 
  private:
+  // The input stream validates each packet against the port's type when it is
+  // added, so the type check does not need to be repeated here.
   InputShardAccess(const CalculatorContext&, InputStreamShard* stream)
-      : Packet<T>(stream ? FromOldPacket(stream->Value()).template As<T>()
-                         : Packet<T>()),
+      : Packet<T>(stream
+                      ? FromOldPacket(stream->Value()).template AsValidated<T>()
+                      : Packet<T>()),
         stream_(stream) {}
 
   template <class F, class... A>
@@ -695,9 +698,10 @@ class InputShardOrSideAccess : public Packet<T> {
  private:
   InputShardOrSideAccess(const CalculatorContext&, InputStreamShard* stream,
                          const mediapipe::Packet* packet)
-      : Packet<T>(stream   ? FromOldPacket(stream->Value()).template As<T>()
-                  : packet ? FromOldPacket(*packet).template As<T>()
-                           : Packet<T>()),
+      : Packet<T>(
+            stream   ? FromOldPacket(stream->Value()).template AsValidated<T>()
+            : packet ? FromOldPacket(*packet).template As<T>()
+                     : Packet<T>()),
         stream_(stream),
         connected_(stream_ != nullptr || packet != nullptr) {}
   InputStreamShard* stream_;
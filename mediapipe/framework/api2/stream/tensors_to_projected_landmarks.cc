@@ -0,0 +1,46 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/api2/stream/tensors_to_projected_landmarks.h"
+
+#include <array>
+#include <vector>
+
+#include "mediapipe/calculators/tensor/tensors_to_landmarks_calculator.pb.h"
+#include "mediapipe/calculators/tensor/tensors_to_projected_landmarks_calculator.h"
+#include "mediapipe/calculators/tensor/tensors_to_projected_landmarks_calculator.pb.h"
+#include "mediapipe/framework/api2/builder.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe::api2::builder {
+
+Stream<NormalizedLandmarkList> ConvertTensorsToProjectedLandmarks(
+    Stream<std::vector<Tensor>> landmark_tensors,
+    Stream<std::array<float, 4>> letterbox_padding, Stream<NormalizedRect> roi,
+    const TensorsToLandmarksCalculatorOptions& options, Graph& graph) {
+  auto& to_landmarks = graph.AddNode("TensorsToProjectedLandmarksCalculator");
+  *to_landmarks.GetOptions<TensorsToProjectedLandmarksCalculatorOptions>()
+       .mutable_tensors_to_landmarks() = options;
+  landmark_tensors.ConnectTo(
+      to_landmarks[TensorsToProjectedLandmarksCalculator::kInTensors]);
+  letterbox_padding.ConnectTo(
+      to_landmarks[TensorsToProjectedLandmarksCalculator::kInLetterboxPadding]);
+  roi.ConnectTo(
+      to_landmarks[TensorsToProjectedLandmarksCalculator::kInNormRect]);
+  return to_landmarks[TensorsToProjectedLandmarksCalculator::kOutNormLandmarks];
+}
+
+}  // namespace mediapipe::api2::builder
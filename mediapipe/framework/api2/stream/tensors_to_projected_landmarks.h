@@ -0,0 +1,48 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_API2_STREAM_TENSORS_TO_PROJECTED_LANDMARKS_H_
+#define MEDIAPIPE_FRAMEWORK_API2_STREAM_TENSORS_TO_PROJECTED_LANDMARKS_H_
+
+#include <array>
+#include <vector>
+
+#include "mediapipe/calculators/tensor/tensors_to_landmarks_calculator.pb.h"
+#include "mediapipe/framework/api2/builder.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+
+namespace mediapipe::api2::builder {
+
+// Updates @graph to decode @landmark_tensors into normalized landmarks, remove
+// @letterbox_padding from them and project them from @roi to the full image,
+// all in a single TensorsToProjectedLandmarksCalculator.
+//
+// @landmark_tensors - landmark output of the model.
+// @letterbox_padding - padding added around @roi to fit the model input.
+// @roi - region of interest the model ran on.
+// @options - how to decode @landmark_tensors; num_landmarks,
+//   input_image_width and input_image_height are required.
+// @graph - mediapipe graph to update.
+Stream<mediapipe::NormalizedLandmarkList> ConvertTensorsToProjectedLandmarks(
+    Stream<std::vector<Tensor>> landmark_tensors,
+    Stream<std::array<float, 4>> letterbox_padding,
+    Stream<mediapipe::NormalizedRect> roi,
+    const mediapipe::TensorsToLandmarksCalculatorOptions& options,
+    Graph& graph);
+
+}  // namespace mediapipe::api2::builder
+
+#endif  // MEDIAPIPE_FRAMEWORK_API2_STREAM_TENSORS_TO_PROJECTED_LANDMARKS_H_
@@ -0,0 +1,79 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/api2/stream/tensors_to_projected_landmarks.h"
+
+#include <array>
+#include <vector>
+
+#include "mediapipe/calculators/tensor/tensors_to_landmarks_calculator.pb.h"
+#include "mediapipe/framework/api2/builder.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe::api2::builder {
+namespace {
+
+TEST(ConvertTensorsToProjectedLandmarks, ConvertTensorsToProjectedLandmarks) {
+  Graph graph;
+
+  Stream<std::vector<Tensor>> tensors =
+      graph.In("TENSORS").Cast<std::vector<Tensor>>();
+  Stream<std::array<float, 4>> letterbox_padding =
+      graph.In("LETTERBOX_PADDING").Cast<std::array<float, 4>>();
+  Stream<NormalizedRect> roi = graph.In("NORM_RECT").Cast<NormalizedRect>();
+  TensorsToLandmarksCalculatorOptions options;
+  options.set_num_landmarks(21);
+  options.set_input_image_width(224);
+  options.set_input_image_height(224);
+  Stream<NormalizedLandmarkList> landmarks = ConvertTensorsToProjectedLandmarks(
+      tensors, letterbox_padding, roi, options, graph);
+  landmarks.SetName("landmarks");
+
+  EXPECT_THAT(
+      graph.GetConfig(),
+      EqualsProto(ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        node {
+          calculator: "TensorsToProjectedLandmarksCalculator"
+          input_stream: "LETTERBOX_PADDING:__stream_0"
+          input_stream: "NORM_RECT:__stream_1"
+          input_stream: "TENSORS:__stream_2"
+          output_stream: "NORM_LANDMARKS:landmarks"
+          options {
+            [mediapipe.TensorsToProjectedLandmarksCalculatorOptions.ext] {
+              tensors_to_landmarks {
+                num_landmarks: 21
+                input_image_width: 224
+                input_image_height: 224
+              }
+            }
+          }
+        }
+        input_stream: "LETTERBOX_PADDING:__stream_0"
+        input_stream: "NORM_RECT:__stream_1"
+        input_stream: "TENSORS:__stream_2"
+      )pb")));
+
+  CalculatorGraph calculator_graph;
+  MP_EXPECT_OK(calculator_graph.Initialize(graph.GetConfig()));
+}
+
+}  // namespace
+}  // namespace mediapipe::api2::builder
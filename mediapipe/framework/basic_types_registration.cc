@@ -1,7 +1,9 @@
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
+#include "mediapipe/framework/packet_size.h"
 #include "mediapipe/framework/type_map.h"
 
 #define MEDIAPIPE_REGISTER_GENERIC_TYPE(type)                              \
@@ -32,3 +34,47 @@ MEDIAPIPE_REGISTER_GENERIC_TYPE(::std::vector<int64_t>);
 MEDIAPIPE_REGISTER_GENERIC_TYPE(::std::vector<std::string>);
 MEDIAPIPE_REGISTER_GENERIC_TYPE(::std::vector<::std::vector<float>>);
 MEDIAPIPE_REGISTER_GENERIC_TYPE_WITH_NAME(::std::string, "string");
+
+// Size estimates for packet memory accounting, see packet_size.h.
+namespace {
+
+size_t StringBytes(const std::string& value) {
+  return sizeof(value) + value.capacity();
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& value) {
+  return sizeof(value) + value.capacity() * sizeof(T);
+}
+
+size_t BoolVectorBytes(const std::vector<bool>& value) {
+  return sizeof(value) + value.capacity() / 8;
+}
+
+size_t StringVectorBytes(const std::vector<std::string>& value) {
+  size_t bytes = VectorBytes(value);
+  for (const std::string& s : value) bytes += s.capacity();
+  return bytes;
+}
+
+size_t FloatVectorVectorBytes(const std::vector<std::vector<float>>& value) {
+  size_t bytes = VectorBytes(value);
+  for (const std::vector<float>& v : value) {
+    bytes += v.capacity() * sizeof(float);
+  }
+  return bytes;
+}
+
+}  // namespace
+
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::string, StringBytes);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<bool>, BoolVectorBytes);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<double>, VectorBytes<double>);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<float>, VectorBytes<float>);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<int>, VectorBytes<int>);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<int64_t>,
+                                  VectorBytes<int64_t>);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<std::string>,
+                                  StringVectorBytes);
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::std::vector<::std::vector<float>>,
+                                  FloatVectorVectorBytes);
@@ -18,6 +18,7 @@
 #define MEDIAPIPE_FRAMEWORK_CALCULATOR_BASE_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
 
@@ -28,6 +29,7 @@
 #include "mediapipe/framework/deps/registration.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/type_util.h"
 
 namespace mediapipe {
 
@@ -157,6 +159,19 @@ class CalculatorBase {
   // documentation for the suggested solution.
   virtual absl::Status Close(CalculatorContext* cc) { return absl::OkStatus(); }
 
+  // Is called in place of constructing and opening a new calculator when a
+  // graph that reuses its calculators (see CalculatorGraphPool) starts
+  // another run with unchanged input side packets.  The calculator has been
+  // opened and closed in an earlier run.  Calculators holding expensive
+  // state, such as loaded models or GPU resources, can override Reset() to
+  // clear their per-run state and keep the rest.  Output side packets set by
+  // Open() are re-sent by the framework and must not be set again.  The
+  // default returns absl::UnimplementedError(), in which case the framework
+  // destroys the calculator and calls Open() on a new one.
+  virtual absl::Status Reset(CalculatorContext* cc) {
+    return absl::UnimplementedError("Reset() is not implemented.");
+  }
+
   // Returns a value according to which the framework selects
   // the next source calculator to Process(); smaller value means
   // Process() first. The default implementation returns the smallest
@@ -183,6 +198,9 @@ class CalculatorBaseFactory {
   virtual std::unique_ptr<CalculatorBase> CreateCalculator(
       CalculatorContext* calculator_context) = 0;
   virtual std::string ContractMethodName() { return "GetContract"; }
+  // Returns the calculator class, which determines the contract, or
+  // std::nullopt if the factory does not create a single class.
+  virtual std::optional<TypeId> CalculatorType() const { return std::nullopt; }
 };
 
 // Functions for checking that the calculator has the required GetContract.
@@ -228,6 +246,8 @@ class CalculatorBaseFactoryFor<
       CalculatorContext* calculator_context) final {
     return absl::make_unique<T>();
   }
+
+  std::optional<TypeId> CalculatorType() const final { return kTypeId<T>; }
 };
 
 }  // namespace internal
@@ -14,6 +14,8 @@
 
 #include "mediapipe/framework/calculator_context.h"
 
+#include <vector>
+
 #include "absl/log/absl_check.h"
 
 namespace mediapipe {
@@ -48,6 +50,19 @@ CounterFactory* CalculatorContext::GetCounterFactory() {
   return calculator_state_->GetCounterFactory();
 }
 
+std::vector<Timestamp> CalculatorContext::InputTimestamps() const {
+  std::vector<Timestamp> result;
+  for (Timestamp timestamp : input_timestamps_) {
+    // A batch may be followed by Timestamp::Done() when the node closes.
+    if (static_cast<int>(result.size()) == input_batch_size_ ||
+        !timestamp.IsAllowedInStream()) {
+      break;
+    }
+    result.push_back(timestamp);
+  }
+  return result;
+}
+
 const PacketSet& CalculatorContext::InputSidePackets() const {
   return calculator_state_->InputSidePackets();
 }
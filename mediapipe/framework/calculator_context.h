@@ -15,24 +15,31 @@
 #ifndef MEDIAPIPE_FRAMEWORK_CALCULATOR_CONTEXT_H_
 #define MEDIAPIPE_FRAMEWORK_CALCULATOR_CONTEXT_H_
 
+#include <deque>
 #include <memory>
-#include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/absl_check.h"
 #include "absl/status/status.h"
 #include "mediapipe/framework/calculator_state.h"
 #include "mediapipe/framework/counter.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/executor_parallel_for.h"
 #include "mediapipe/framework/graph_service.h"
 #include "mediapipe/framework/graph_service_manager.h"
 #include "mediapipe/framework/input_stream_shard.h"
 #include "mediapipe/framework/output_stream_shard.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_arena.h"
 #include "mediapipe/framework/packet_set.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/any_proto.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/resources.h"
+#include "mediapipe/framework/scratch_arena.h"
 #include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
@@ -87,6 +94,41 @@ class CalculatorContext {
   // No prefix is added to counters created in this way.
   CounterFactory* GetCounterFactory();
 
+  // Creates a packet containing an object of type T initialized with the
+  // provided arguments, like MakePacket<T>(), but takes the memory from the
+  // graph's packet arena, see MakePacketInArena(). Prefer this for small
+  // payloads sent on every timestamp. The payload cannot be released with
+  // Packet::Consume(); Packet::ConsumeOrCopy() copies it.
+  template <typename T, typename... Args>
+  Packet MakePacketInArena(Args&&... args) {
+    return mediapipe::MakePacketInArena<T>(calculator_state_->GetPacketArena(),
+                                           std::forward<Args>(args)...);
+  }
+
+  // Returns an arena for temporaries of the current Open(), Process() or
+  // Close() call.  The framework resets the arena when the call returns, so
+  // nothing allocated from it may be referenced by output packets or kept
+  // in the calculator.  See ScratchArena.
+  mediapipe::ScratchArena& ScratchArena() {
+    if (!scratch_arena_) {
+      scratch_arena_ = std::make_unique<mediapipe::ScratchArena>();
+    }
+    return *scratch_arena_;
+  }
+
+  // Returns the executor this calculator runs on, or null if it runs on the
+  // application thread. Calculators can schedule helper work on it instead of
+  // starting their own threads.
+  Executor* GetExecutor() const { return calculator_state_->GetExecutor(); }
+
+  // Calls fn(chunk_begin, chunk_end) for chunks of at most grain_size indices
+  // covering [begin, end), spreading the chunks over the calling thread and
+  // the executor this calculator runs on. See ExecutorParallelFor().
+  void ParallelFor(int begin, int end, int grain_size,
+                   absl::FunctionRef<void(int, int)> fn) {
+    ExecutorParallelFor(GetExecutor(), begin, end, grain_size, fn);
+  }
+
   // Returns the current input timestamp, or Timestamp::Unset if there are
   // no input packets.
   Timestamp InputTimestamp() const {
@@ -94,6 +136,13 @@ class CalculatorContext {
                                      : input_timestamps_.front();
   }
 
+  // Returns the input timestamps of the current Process() call in increasing
+  // order. This is just InputTimestamp(), unless the calculator processes
+  // input batches (see CalculatorContract::SetProcessInputBatches()), in which
+  // case the i-th timestamp corresponds to the i-th packet of
+  // InputStreamShard::Packets() on every input stream.
+  std::vector<Timestamp> InputTimestamps() const;
+
   // Returns a reference to the input side packet set.
   const PacketSet& InputSidePackets() const;
   // Returns a reference to the output side packet collection.
@@ -171,16 +220,26 @@ class CalculatorContext {
 
   // Adds a new input timestamp by the friend class CalculatorContextManager.
   void PushInputTimestamp(Timestamp input_timestamp) {
-    input_timestamps_.push(input_timestamp);
+    input_timestamps_.push_back(input_timestamp);
   }
 
   void PopInputTimestamp() {
     ABSL_CHECK(!input_timestamps_.empty());
-    input_timestamps_.pop();
+    input_timestamps_.pop_front();
   }
 
+  // Limits InputTimestamps() to the first batch_size input timestamps.
+  void SetInputBatchSize(int batch_size) { input_batch_size_ = batch_size; }
+
   void SetGraphStatus(const absl::Status& status) { graph_status_ = status; }
 
+  // Releases the memory taken from ScratchArena().
+  void ResetScratchArena() {
+    if (scratch_arena_) {
+      scratch_arena_->Reset();
+    }
+  }
+
   // Interface for the friend class Calculator.
   const InputStreamSet& InputStreams() const;
   const OutputStreamSet& OutputStreams() const;
@@ -198,13 +257,26 @@ class CalculatorContext {
   mutable std::unique_ptr<InputStreamSet> input_streams_;
   mutable std::unique_ptr<OutputStreamSet> output_streams_;
   // The queue of timestamp values to Process() in this calculator context.
-  std::queue<Timestamp> input_timestamps_;
+  std::deque<Timestamp> input_timestamps_;
+  // The number of input timestamps passed to the current Process() call.
+  int input_batch_size_ = 1;
 
   // The status of the graph run. Only used when Close() is called.
   absl::Status graph_status_;
 
+  // Created by the first ScratchArena() call.
+  std::unique_ptr<mediapipe::ScratchArena> scratch_arena_;
+
+  // When this context was last queued for execution and taken from the queue
+  // by a worker thread, set only if enable_scheduling_latency is profiled.
+  // The profiler clears them once sampled, through a const reference.
+  mutable int64_t queued_time_usec_ = 0;
+  mutable int64_t dispatched_time_usec_ = 0;
+
   // Accesses CalculatorContext for setting input timestamp.
   friend class CalculatorContextManager;
+  // Records the scheduling times.
+  friend class GraphProfiler;
 };
 
 }  // namespace mediapipe
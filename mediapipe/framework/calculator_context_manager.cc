@@ -14,6 +14,7 @@
 
 #include "mediapipe/framework/calculator_context_manager.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "absl/log/absl_check.h"
@@ -61,8 +62,8 @@ CalculatorContext* CalculatorContextManager::GetFrontCalculatorContext(
   ABSL_CHECK(calculator_run_in_parallel_);
   absl::MutexLock lock(&contexts_mutex_);
   ABSL_CHECK(!active_contexts_.empty());
-  *context_input_timestamp = active_contexts_.begin()->first;
-  return active_contexts_.begin()->second.get();
+  *context_input_timestamp = active_contexts_.front().first;
+  return active_contexts_.front().second.get();
 }
 
 CalculatorContext* CalculatorContextManager::PrepareCalculatorContext(
@@ -71,33 +72,39 @@ CalculatorContext* CalculatorContextManager::PrepareCalculatorContext(
     return GetDefaultCalculatorContext();
   }
   absl::MutexLock lock(&contexts_mutex_);
-  ABSL_CHECK(!mediapipe::ContainsKey(active_contexts_, input_timestamp))
-      << "Multiple invocations with the same timestamps are not allowed with "
-         "parallel execution, input_timestamp = "
-      << input_timestamp;
-  CalculatorContext* calculator_context = nullptr;
+  auto it = active_contexts_.end();
+  if (!active_contexts_.empty() &&
+      active_contexts_.back().first >= input_timestamp) {
+    it = std::lower_bound(
+        active_contexts_.begin(), active_contexts_.end(), input_timestamp,
+        [](const auto& entry, Timestamp timestamp) {
+          return entry.first < timestamp;
+        });
+    ABSL_CHECK(it->first != input_timestamp)
+        << "Multiple invocations with the same timestamps are not allowed "
+           "with parallel execution, input_timestamp = "
+        << input_timestamp;
+  }
+  std::unique_ptr<CalculatorContext> context;
   if (idle_contexts_.empty()) {
-    auto new_context = absl::make_unique<CalculatorContext>(
+    context = absl::make_unique<CalculatorContext>(
         calculator_state_, input_tag_map_, output_tag_map_);
-    MEDIAPIPE_CHECK_OK(setup_shards_callback_(new_context.get()));
-    calculator_context = new_context.get();
-    active_contexts_.emplace(input_timestamp, std::move(new_context));
+    MEDIAPIPE_CHECK_OK(setup_shards_callback_(context.get()));
   } else {
     // Retrieves an inactive calculator context from idle_contexts_.
-    calculator_context = idle_contexts_.front().get();
-    active_contexts_.emplace(input_timestamp,
-                             std::move(idle_contexts_.front()));
+    context = std::move(idle_contexts_.front());
     idle_contexts_.pop_front();
   }
+  CalculatorContext* calculator_context = context.get();
+  active_contexts_.emplace(it, input_timestamp, std::move(context));
   return calculator_context;
 }
 
 void CalculatorContextManager::RecycleCalculatorContext() {
   absl::MutexLock lock(&contexts_mutex_);
   // The first element in active_contexts_ will be recycled.
-  auto iter = active_contexts_.begin();
-  idle_contexts_.push_back(std::move(iter->second));
-  active_contexts_.erase(iter);
+  idle_contexts_.push_back(std::move(active_contexts_.front().second));
+  active_contexts_.pop_front();
 }
 
 bool CalculatorContextManager::HasActiveContexts() {
@@ -17,7 +17,6 @@
 
 #include <deque>
 #include <functional>
-#include <map>
 #include <memory>
 
 #include "absl/base/thread_annotations.h"
@@ -107,12 +106,23 @@ class CalculatorContextManager {
     calculator_context->PopInputTimestamp();
   }
 
+  void SetInputBatchSizeInContext(CalculatorContext* calculator_context,
+                                  int batch_size) {
+    ABSL_CHECK(calculator_context);
+    calculator_context->SetInputBatchSize(batch_size);
+  }
+
   void SetGraphStatusInContext(CalculatorContext* calculator_context,
                                const absl::Status& status) {
     ABSL_CHECK(calculator_context);
     calculator_context->SetGraphStatus(status);
   }
 
+  void ResetScratchArenaInContext(CalculatorContext* calculator_context) {
+    ABSL_CHECK(calculator_context);
+    calculator_context->ResetScratchArena();
+  }
+
  private:
   CalculatorState* calculator_state_;
   std::shared_ptr<tool::TagMap> input_tag_map_;
@@ -133,9 +143,11 @@ class CalculatorContextManager {
   // The mutex for synchronizing the operations on active_contexts_ and
   // idle_contexts_ during parallel execution.
   absl::Mutex contexts_mutex_;
-  // A map from input timestamps to calculator contexts.
-  std::map<Timestamp, std::unique_ptr<CalculatorContext>> active_contexts_
-      ABSL_GUARDED_BY(contexts_mutex_);
+  // The calculator contexts in ascending order of their input timestamps.
+  // Invocations are scheduled in timestamp order, so contexts are appended at
+  // the back and recycled from the front.
+  std::deque<std::pair<Timestamp, std::unique_ptr<CalculatorContext>>>
+      active_contexts_ ABSL_GUARDED_BY(contexts_mutex_);
   // Idle calculator contexts that are ready for reuse.
   std::deque<std::unique_ptr<CalculatorContext>> idle_contexts_
       ABSL_GUARDED_BY(contexts_mutex_);
@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/status_builder.h"
@@ -165,4 +166,46 @@ absl::Status CalculatorContract::Initialize(const StatusHandlerConfig& node) {
   return absl::OkStatus();
 }
 
+bool CalculatorContract::CopyExpectationsFrom(
+    const CalculatorContract& other) {
+  std::pair<PacketTypeSet*, const PacketTypeSet*> sets[] = {
+      {inputs_.get(), other.inputs_.get()},
+      {outputs_.get(), other.outputs_.get()},
+      {input_side_packets_.get(), other.input_side_packets_.get()},
+      {output_side_packets_.get(), other.output_side_packets_.get()},
+  };
+  // Copy every PacketType by value, then point the "SameAs" types at the
+  // roots owned by this contract rather than by "other".
+  absl::flat_hash_map<const PacketType*, PacketType*> copies;
+  for (auto& [dst, src] : sets) {
+    if (!dst != !src) return false;
+    if (!dst) continue;
+    if (!dst->TagMap()->SameAs(*src->TagMap())) return false;
+    for (CollectionItemId id = src->BeginId(); id < src->EndId(); ++id) {
+      dst->Get(id) = src->Get(id);
+      copies[&src->Get(id)] = &dst->Get(id);
+    }
+  }
+  for (auto& [dst, src] : sets) {
+    if (!dst) continue;
+    for (CollectionItemId id = src->BeginId(); id < src->EndId(); ++id) {
+      const PacketType* root = src->Get(id).GetSameAs();
+      if (root == &src->Get(id)) continue;
+      auto it = copies.find(root);
+      if (it == copies.end()) return false;
+      dst->Get(id).SetSameAs(it->second);
+    }
+  }
+  input_stream_handler_ = other.input_stream_handler_;
+  input_stream_handler_options_ = other.input_stream_handler_options_;
+  service_requests_.clear();
+  service_requests_.insert(other.service_requests_.begin(),
+                           other.service_requests_.end());
+  process_timestamps_ = other.process_timestamps_;
+  process_batches_ = other.process_batches_;
+  process_max_in_flight_ = other.process_max_in_flight_;
+  timestamp_offset_ = other.timestamp_offset_;
+  return true;
+}
+
 }  // namespace mediapipe
@@ -131,6 +131,30 @@ class CalculatorContract {
   }
   bool GetProcessTimestampBounds() const { return process_timestamps_; }
 
+  // When true, and the input stream handler collects batches of input
+  // timestamps (e.g. BatchInputStreamHandler), Process is called once per
+  // batch rather than once per timestamp. CalculatorContext::InputTimestamps()
+  // then lists the timestamps in the batch, and InputStreamShard::Packets()
+  // holds the corresponding packets of each input stream.
+  void SetProcessInputBatches(bool process_batches) {
+    process_batches_ = process_batches;
+  }
+  bool GetProcessInputBatches() const { return process_batches_; }
+
+  // Declares that Process keeps no state across invocations, so the framework
+  // may run it concurrently for different input timestamps, with up to
+  // max_in_flight invocations at once, or one per hardware thread if
+  // max_in_flight is 0. Outputs are still delivered in timestamp order, and
+  // Open and Close never overlap Process. A max_in_flight set in the node
+  // config takes precedence. Ignored for source nodes and for calculators that
+  // process input batches.
+  void SetProcessReentrant(int max_in_flight = 0) {
+    process_max_in_flight_ = max_in_flight;
+  }
+  // Returns the max_in_flight declared by SetProcessReentrant, 1 if Process
+  // is not reentrant.
+  int GetProcessMaxInFlight() const { return process_max_in_flight_; }
+
   // Specifies the maximum difference between input and output timestamps.
   // When specified, the mediapipe framework automatically computes output
   // timestamp bounds based on input timestamps.  The special value
@@ -187,6 +211,13 @@ class CalculatorContract {
 
   const ServiceReqMap& ServiceRequests() const { return service_requests_; }
 
+  // Copies everything declared by GetContract from "other", which must have
+  // been initialized from an identical node config.  "SameAs" packet types
+  // are redirected to the corresponding entries of this contract.  Returns
+  // false, leaving this contract partially copied, if a "SameAs" type refers
+  // to a PacketType outside of "other".
+  bool CopyExpectationsFrom(const CalculatorContract& other);
+
  private:
   template <class T>
   void GetNodeOptions(T* result) const;
@@ -209,6 +240,8 @@ class CalculatorContract {
   std::string node_name_;
   ServiceReqMap service_requests_;
   bool process_timestamps_ = false;
+  bool process_batches_ = false;
+  int process_max_in_flight_ = 1;
   TimestampDiff timestamp_offset_ = TimestampDiff::Unset();
 
   friend class CalculatorNode;
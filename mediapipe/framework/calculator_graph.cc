@@ -136,6 +136,7 @@ CalculatorGraph::CalculatorGraph() : CalculatorGraph(/*cc=*/nullptr) {}
 // Adopt all services from the CalculatorContext / parent graph.
 CalculatorGraph::CalculatorGraph(CalculatorContext* cc)
     : counter_factory_(std::make_unique<BasicCounterFactory>()),
+      packet_arena_(std::make_shared<PacketArena>()),
       service_manager_(cc != nullptr ? cc->GetGraphServiceManager() : nullptr),
       profiler_(std::make_shared<ProfilingContext>()),
       scheduler_(this) {
@@ -337,6 +338,23 @@ absl::Status CalculatorGraph::InitializePacketGeneratorNodes(
 
 absl::Status CalculatorGraph::InitializeProfiler() {
   profiler_->Initialize(*validated_graph_);
+  // Connects the input streams to their memory counters, which are null
+  // unless enable_memory_accounting is set.
+  for (int node_id = 0; node_id < validated_graph_->CalculatorInfos().size();
+       ++node_id) {
+    const NodeTypeInfo& node_info = validated_graph_->CalculatorInfos()[node_id];
+    for (int i = 0; i < node_info.InputStreamTypes().NumEntries(); ++i) {
+      input_stream_managers_[node_info.InputStreamBaseIndex() + i]
+          .SetMemoryCounter(profiler_->GetInputStreamMemoryCounter(node_id, i));
+    }
+    // Likewise for the packet lifetime counters of the output streams, which
+    // are null unless enable_packet_lifetime is set.
+    for (int i = 0; i < node_info.OutputStreamTypes().NumEntries(); ++i) {
+      output_stream_managers_[node_info.OutputStreamBaseIndex() + i]
+          .SetLifetimeCounter(
+              profiler_->GetOutputStreamLifetimeCounter(node_id, i));
+    }
+  }
   return absl::OkStatus();
 }
 
@@ -801,6 +819,16 @@ absl::Status CalculatorGraph::PrepareForRun(
                   std::placeholders::_1, std::placeholders::_2);
     node->SetQueueSizeCallbacks(queue_size_callback, queue_size_callback);
     scheduler_.AssignNodeToSchedulerQueue(node.get());
+    // Nodes on the application thread get no executor: tasks they schedule
+    // would only run once they return.
+    Executor* node_executor = nullptr;
+    if (!node->Executor().empty() || !use_application_thread_) {
+      auto executor_it = executors_.find(node->Executor());
+      if (executor_it != executors_.end()) {
+        node_executor = executor_it->second.get();
+      }
+    }
+    node->SetReuseCalculator(reuse_calculators_);
     // TODO: update calculator node to use GraphServiceManager
     // instead of service packets?
     const absl::Status result = node->PrepareForRun(
@@ -812,7 +840,7 @@ absl::Status CalculatorGraph::PrepareForRun(
         std::bind(&internal::Scheduler::ScheduleNodeIfNotThrottled, &scheduler_,
                   node.get(), std::placeholders::_1),
         std::bind(&CalculatorGraph::RecordError, this, std::placeholders::_1),
-        counter_factory_.get());
+        counter_factory_.get(), packet_arena_, node_executor);
     if (!result.ok()) {
       // Collect as many errors as we can before failing.
       RecordError(result);
@@ -935,83 +963,111 @@ absl::Status CalculatorGraph::SetInputStreamTimestampBound(
   return absl::OkStatus();
 }
 
-// We avoid having two copies of this code for AddPacketToInputStream(
-// const Packet&) and AddPacketToInputStream(Packet &&) by having this
-// internal-only templated version.  T&& is a forwarding reference here, so
-// std::forward will deduce the correct type as we pass along packet.
-template <typename T>
-absl::Status CalculatorGraph::AddPacketToInputStreamInternal(
-    absl::string_view stream_name, T&& packet) {
+absl::StatusOr<std::pair<CalculatorGraph::GraphInputStream*, int>>
+CalculatorGraph::FindGraphInputStream(absl::string_view stream_name,
+                                      absl::string_view caller) {
   auto stream_it = graph_input_streams_.find(stream_name);
-  std::unique_ptr<GraphInputStream>* stream =
-      stream_it == graph_input_streams_.end() ? nullptr : &stream_it->second;
-  RET_CHECK(stream).SetNoLogging() << absl::Substitute(
-      "AddPacketToInputStream called on input stream \"$0\" which is not a "
-      "graph input stream.",
-      stream_name);
+  RET_CHECK(stream_it != graph_input_streams_.end()).SetNoLogging()
+      << absl::Substitute(
+             "$0 called on input stream \"$1\" which is not a graph input "
+             "stream.",
+             caller, stream_name);
   auto node_id_it = graph_input_stream_node_ids_.find(stream_name);
   ABSL_CHECK(node_id_it != graph_input_stream_node_ids_.end())
       << "Map key not found: " << stream_name;
   int node_id = node_id_it->second;
   ABSL_CHECK_GE(node_id, validated_graph_->CalculatorInfos().size());
-  {
-    absl::MutexLock lock(&full_input_streams_mutex_);
-    if (full_input_streams_.empty()) {
-      return mediapipe::FailedPreconditionErrorBuilder(MEDIAPIPE_LOC)
-             << "CalculatorGraph::AddPacketToInputStream() is called before "
-                "StartRun()";
+  return std::make_pair(stream_it->second.get(), node_id);
+}
+
+absl::Status CalculatorGraph::WaitUntilGraphInputStreamsNotThrottled(
+    absl::Span<const int> node_ids, absl::string_view caller) {
+  auto any_throttled = [this, node_ids]()
+                           ABSL_EXCLUSIVE_LOCKS_REQUIRED(
+                               full_input_streams_mutex_) {
+                             for (int node_id : node_ids) {
+                               if (!full_input_streams_[node_id].empty()) {
+                                 return true;
+                               }
+                             }
+                             return false;
+                           };
+  absl::MutexLock lock(&full_input_streams_mutex_);
+  if (full_input_streams_.empty()) {
+    return mediapipe::FailedPreconditionErrorBuilder(MEDIAPIPE_LOC)
+           << "CalculatorGraph::" << caller << "() is called before "
+           << "StartRun()";
+  }
+  if (graph_input_stream_add_mode_ ==
+      GraphInputStreamAddMode::ADD_IF_NOT_FULL) {
+    if (has_error_) {
+      absl::Status error_status;
+      GetCombinedErrors("Graph has errors: ", &error_status);
+      return error_status;
     }
-    if (graph_input_stream_add_mode_ ==
-        GraphInputStreamAddMode::ADD_IF_NOT_FULL) {
-      if (has_error_) {
-        absl::Status error_status;
-        GetCombinedErrors("Graph has errors: ", &error_status);
-        return error_status;
-      }
-      // Return with StatusUnavailable if this stream is being throttled.
-      if (!full_input_streams_[node_id].empty()) {
-        return mediapipe::UnavailableErrorBuilder(MEDIAPIPE_LOC)
-               << "Graph is throttled.";
-      }
-    } else if (graph_input_stream_add_mode_ ==
-               GraphInputStreamAddMode::WAIT_TILL_NOT_FULL) {
-      // Wait until this stream is not being throttled.
-      // TODO: instead of checking has_error_, we could just check
-      // if the graph is done. That could also be indicated by returning an
-      // error from WaitUntilGraphInputStreamUnthrottled.
-      while (!has_error_ && !full_input_streams_[node_id].empty()) {
-        // TODO: allow waiting for a specific stream?
-        scheduler_.WaitUntilGraphInputStreamUnthrottled(
-            &full_input_streams_mutex_);
-      }
-      if (has_error_) {
-        absl::Status error_status;
-        GetCombinedErrors("Graph has errors: ", &error_status);
-        return error_status;
-      }
+    // Return with StatusUnavailable if any of the streams is being throttled.
+    if (any_throttled()) {
+      return mediapipe::UnavailableErrorBuilder(MEDIAPIPE_LOC)
+             << "Graph is throttled.";
+    }
+  } else if (graph_input_stream_add_mode_ ==
+             GraphInputStreamAddMode::WAIT_TILL_NOT_FULL) {
+    // Wait until none of the streams is being throttled.
+    // TODO: instead of checking has_error_, we could just check
+    // if the graph is done. That could also be indicated by returning an
+    // error from WaitUntilGraphInputStreamUnthrottled.
+    while (!has_error_ && any_throttled()) {
+      // TODO: allow waiting for a specific stream?
+      scheduler_.WaitUntilGraphInputStreamUnthrottled(
+          &full_input_streams_mutex_);
+    }
+    if (has_error_) {
+      absl::Status error_status;
+      GetCombinedErrors("Graph has errors: ", &error_status);
+      return error_status;
     }
   }
+  return absl::OkStatus();
+}
 
+void CalculatorGraph::LogGraphInputPacket(GraphInputStream* stream,
+                                          const Packet& packet) {
   // Adding profiling info for a new packet entering the graph.
-  const std::string* stream_id = &(*stream)->GetManager()->Name();
+  const std::string* stream_id = &stream->GetManager()->Name();
   profiler_->LogEvent(TraceEvent(TraceEvent::PROCESS)
                           .set_is_finish(true)
                           .set_input_ts(packet.Timestamp())
                           .set_stream_id(stream_id)
                           .set_packet_ts(packet.Timestamp())
                           .set_packet_data_id(&packet));
+}
+
+// We avoid having two copies of this code for AddPacketToInputStream(
+// const Packet&) and AddPacketToInputStream(Packet &&) by having this
+// internal-only templated version.  T&& is a forwarding reference here, so
+// std::forward will deduce the correct type as we pass along packet.
+template <typename T>
+absl::Status CalculatorGraph::AddPacketToInputStreamInternal(
+    absl::string_view stream_name, T&& packet) {
+  MP_ASSIGN_OR_RETURN(auto stream_and_node_id,
+                      FindGraphInputStream(stream_name,
+                                           "AddPacketToInputStream"));
+  auto [stream, node_id] = stream_and_node_id;
+  MP_RETURN_IF_ERROR(WaitUntilGraphInputStreamsNotThrottled(
+      {node_id}, "AddPacketToInputStream"));
+  LogGraphInputPacket(stream, packet);
 
   // InputStreamManager is thread safe. GraphInputStream is not, so this method
   // should not be called by multiple threads concurrently. Note that this could
   // potentially lead to the max queue size being exceeded by one packet at most
   // because we don't have the lock over the input stream.
-  (*stream)->AddPacket(std::forward<T>(packet));
+  stream->AddPacket(std::forward<T>(packet));
   if (has_error_) {
     absl::Status error_status;
     GetCombinedErrors("Graph has errors: ", &error_status);
     return error_status;
   }
-  (*stream)->PropagateUpdatesToMirrors();
+  stream->PropagateUpdatesToMirrors();
 
   VLOG(2) << "Packet added directly to: " << stream_name;
   // Note: one reason why we need to call the scheduler here is that we have
@@ -1022,6 +1078,62 @@ absl::Status CalculatorGraph::AddPacketToInputStreamInternal(
   return absl::OkStatus();
 }
 
+absl::Status CalculatorGraph::AddPacketsToInputStream(
+    absl::string_view stream_name, std::vector<Packet>&& packets) {
+  std::map<std::string, std::vector<Packet>> stream_packets;
+  stream_packets.emplace(std::string(stream_name), std::move(packets));
+  absl::Status status = AddPacketsToInputStreams(std::move(stream_packets));
+  if (!status.ok() && !stream_packets.empty()) {
+    // The run was rejected before any packet was added, so the caller keeps
+    // its packets.
+    packets = std::move(stream_packets.begin()->second);
+  }
+  return status;
+}
+
+absl::Status CalculatorGraph::AddPacketsToInputStreams(
+    std::map<std::string, std::vector<Packet>>&& stream_packets) {
+  std::vector<GraphInputStream*> streams;
+  std::vector<int> node_ids;
+  streams.reserve(stream_packets.size());
+  node_ids.reserve(stream_packets.size());
+  for (const auto& [stream_name, packets] : stream_packets) {
+    MP_ASSIGN_OR_RETURN(auto stream_and_node_id,
+                        FindGraphInputStream(stream_name,
+                                             "AddPacketsToInputStreams"));
+    streams.push_back(stream_and_node_id.first);
+    node_ids.push_back(stream_and_node_id.second);
+  }
+  MP_RETURN_IF_ERROR(WaitUntilGraphInputStreamsNotThrottled(
+      node_ids, "AddPacketsToInputStreams"));
+
+  // As in AddPacketToInputStream, the packets are not added under the lock,
+  // so the max queue size can be exceeded by the size of a batch.
+  int i = 0;
+  for (auto& [stream_name, packets] : stream_packets) {
+    GraphInputStream* stream = streams[i++];
+    for (Packet& packet : packets) {
+      LogGraphInputPacket(stream, packet);
+      stream->AddPacket(std::move(packet));
+    }
+  }
+  stream_packets.clear();
+  if (has_error_) {
+    absl::Status error_status;
+    GetCombinedErrors("Graph has errors: ", &error_status);
+    return error_status;
+  }
+  // Each stream hands its whole batch to its mirrors at once.
+  for (GraphInputStream* stream : streams) {
+    stream->PropagateUpdatesToMirrors();
+  }
+
+  VLOG(2) << "Packet batches added directly to " << streams.size()
+          << " graph input streams";
+  scheduler_.AddedPacketToGraphInputStream();
+  return absl::OkStatus();
+}
+
 absl::Status CalculatorGraph::SetInputStreamMaxQueueSize(
     const std::string& stream_name, int max_queue_size) {
   // graph_input_streams_ has not been filled in yet, so we'll check this when
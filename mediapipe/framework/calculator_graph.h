@@ -34,6 +34,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_base.h"
 #include "mediapipe/framework/calculator_node.h"
@@ -48,6 +49,7 @@
 #include "mediapipe/framework/output_stream_poller.h"
 #include "mediapipe/framework/output_stream_shard.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_arena.h"
 #include "mediapipe/framework/packet_generator_graph.h"
 #include "mediapipe/framework/resources_service.h"
 #include "mediapipe/framework/scheduler.h"
@@ -279,6 +281,22 @@ class CalculatorGraph {
   absl::Status AddPacketToInputStream(absl::string_view stream_name,
                                       Packet&& packet);
 
+  // Adds a run of packets to a graph input stream, in order. This is
+  // equivalent to calling AddPacketToInputStream for each packet, except that
+  // the graph input mode is applied to the run as a whole: the run is added
+  // once the stream is not throttled, and the packets are delivered to the
+  // graph together. The stream queue can therefore exceed its max_queue_size
+  // by the size of the run. In ADD_IF_NOT_FULL mode with a throttled stream,
+  // returns StatusUnavailable and leaves `packets` unchanged.
+  absl::Status AddPacketsToInputStream(absl::string_view stream_name,
+                                       std::vector<Packet>&& packets);
+
+  // Same as AddPacketsToInputStream, for runs of packets keyed by graph input
+  // stream name. The runs are added once none of their streams is throttled.
+  // If any stream is unknown or throttled, nothing is added.
+  absl::Status AddPacketsToInputStreams(
+      std::map<std::string, std::vector<Packet>>&& stream_packets);
+
   // Indicates that input will arrive no earlier than a certain timestamp.
   absl::Status SetInputStreamTimestampBound(const std::string& stream_name,
                                             Timestamp timestamp);
@@ -362,6 +380,12 @@ class CalculatorGraph {
   // Set the mode for adding packets to an input stream.
   void SetGraphInputStreamAddMode(GraphInputStreamAddMode mode);
 
+  // Keeps the calculators of a successful run for the next StartRun().
+  // Calculators that implement CalculatorBase::Reset() are then reset rather
+  // than constructed and opened again.  Takes effect at the next StartRun().
+  // See CalculatorGraphPool.
+  void SetReuseCalculators(bool reuse) { reuse_calculators_ = reuse; }
+
   // Aborts the scheduler if the graph is not terminated; no-op otherwise. Does
   // not wait for all work in progress to finish. To stop the run and wait for
   // work in progress to finish, see CloseAllInputStreams() and WaitUntilDone().
@@ -549,6 +573,22 @@ class CalculatorGraph {
   absl::Status AddPacketToInputStreamInternal(absl::string_view stream_name,
                                               T&& packet);
 
+  // Returns the graph input stream named `stream_name` and the id of its
+  // virtual node, or an error naming `caller` if there is no such stream.
+  absl::StatusOr<std::pair<GraphInputStream*, int>> FindGraphInputStream(
+      absl::string_view stream_name, absl::string_view caller);
+
+  // Applies the graph input stream add mode to the graph input streams with
+  // the given virtual node ids before packets are added to them. Waits until
+  // none of them is throttled in WAIT_TILL_NOT_FULL mode, and returns
+  // StatusUnavailable if any of them is throttled in ADD_IF_NOT_FULL mode.
+  absl::Status WaitUntilGraphInputStreamsNotThrottled(
+      absl::Span<const int> node_ids, absl::string_view caller)
+      ABSL_LOCKS_EXCLUDED(full_input_streams_mutex_);
+
+  // Logs the profiler event of a packet entering the graph.
+  void LogGraphInputPacket(GraphInputStream* stream, const Packet& packet);
+
   // Sets the executor that will run the nodes assigned to the executor
   // named |name|.  If |name| is empty, this sets the default executor.
   // Does not check that the graph is uninitialized and |name| is not a
@@ -712,6 +752,10 @@ class CalculatorGraph {
   // The factory for making counters associated with this graph.
   std::unique_ptr<CounterFactory> counter_factory_;
 
+  // The arena for packets created with CalculatorContext::MakePacketInArena().
+  // Shared with the calculators, and kept alive by the packets it allocated.
+  std::shared_ptr<PacketArena> packet_arena_;
+
   // Executors for the scheduler, keyed by the executor's name. The default
   // executor's name is the empty string.
   std::map<std::string, std::shared_ptr<Executor>> executors_;
@@ -735,6 +779,9 @@ class CalculatorGraph {
   // True if the default executor uses the application thread.
   bool use_application_thread_ = false;
 
+  // True if calculators are kept across successful graph runs.
+  bool reuse_calculators_ = false;
+
   // Condition variable that waits until all input streams that depend on a
   // graph input stream are below the maximum queue size.
   absl::CondVar wait_to_add_packet_cond_var_
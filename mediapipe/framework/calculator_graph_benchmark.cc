@@ -0,0 +1,149 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// Benchmarks for the end-to-end overhead of running packets through a
+// CalculatorGraph: per-node cost, scheduler dispatch across executor threads,
+// and the cost of the different input stream handlers.
+#include <string>
+
+#include "absl/log/absl_check.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_graph.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/stream_handler.pb.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+// Number of packets sent per benchmark iteration before waiting for the graph
+// to become idle. Amortizes the cost of WaitUntilIdle.
+constexpr int kPacketsPerIteration = 100;
+
+// Starts the graph, then repeatedly sends kPacketsPerIteration packets into
+// each of the given graph input streams and waits for the graph to drain them.
+void RunGraph(benchmark::State& state, const CalculatorGraphConfig& config,
+              int num_input_streams) {
+  CalculatorGraph graph;
+  ABSL_CHECK_OK(graph.Initialize(config));
+  ABSL_CHECK_OK(graph.StartRun({}));
+  int64_t t = 0;
+  for (auto _ : state) {
+    for (int i = 0; i < kPacketsPerIteration; ++i, ++t) {
+      for (int s = 0; s < num_input_streams; ++s) {
+        ABSL_CHECK_OK(graph.AddPacketToInputStream(
+            absl::StrCat("in", s), MakePacket<int>(i).At(Timestamp(t))));
+      }
+    }
+    ABSL_CHECK_OK(graph.WaitUntilIdle());
+  }
+  ABSL_CHECK_OK(graph.CloseAllInputStreams());
+  ABSL_CHECK_OK(graph.WaitUntilDone());
+}
+
+// A linear chain of state.range(0) pass-through nodes. Items processed counts
+// node invocations, so the reported rate is the per-node overhead.
+void BM_CalculatorGraphChain(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  CalculatorGraphConfig config;
+  config.add_input_stream("in0");
+  config.set_num_threads(1);
+  std::string prev = "in0";
+  for (int i = 0; i < num_nodes; ++i) {
+    auto* node = config.add_node();
+    node->set_calculator("PassThroughCalculator");
+    node->add_input_stream(prev);
+    prev = absl::StrCat("chain", i);
+    node->add_output_stream(prev);
+  }
+  RunGraph(state, config, /*num_input_streams=*/1);
+  state.SetItemsProcessed(state.iterations() * kPacketsPerIteration *
+                          num_nodes);
+}
+BENCHMARK(BM_CalculatorGraphChain)->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+
+// state.range(0) independent pass-through nodes fed from one graph input,
+// run on state.range(1) executor threads. Every packet makes all nodes ready
+// at once, so this stresses SchedulerQueue dispatch and executor hand-off.
+void BM_SchedulerDispatchFanOut(benchmark::State& state) {
+  const int num_nodes = state.range(0);
+  CalculatorGraphConfig config;
+  config.add_input_stream("in0");
+  config.set_num_threads(state.range(1));
+  for (int i = 0; i < num_nodes; ++i) {
+    auto* node = config.add_node();
+    node->set_calculator("PassThroughCalculator");
+    node->add_input_stream("in0");
+    node->add_output_stream(absl::StrCat("fan", i));
+  }
+  RunGraph(state, config, /*num_input_streams=*/1);
+  state.SetItemsProcessed(state.iterations() * kPacketsPerIteration *
+                          num_nodes);
+}
+BENCHMARK(BM_SchedulerDispatchFanOut)
+    ->ArgsProduct({{4, 16}, {1, 2, 4}})
+    ->ArgNames({"nodes", "threads"})
+    ->UseRealTime();
+
+// Returns the input_stream_handler config for BM_InputStreamHandler.
+std::string HandlerConfigText(int index) {
+  switch (index) {
+    case 0:
+      return R"pb(input_stream_handler: "DefaultInputStreamHandler")pb";
+    case 1:
+      return R"pb(input_stream_handler: "ImmediateInputStreamHandler")pb";
+    default:
+      return R"pb(input_stream_handler: "SyncSetInputStreamHandler"
+                  options {
+                    [mediapipe.SyncSetInputStreamHandlerOptions.ext] {
+                      sync_set { tag_index: ":0" }
+                      sync_set { tag_index: ":1" }
+                    }
+                  })pb";
+  }
+}
+
+// A single node with two inputs, using the input stream handler selected by
+// state.range(0): default, immediate or sync-set (one set per stream).
+void BM_InputStreamHandler(benchmark::State& state) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "in0"
+        input_stream: "in1"
+        num_threads: 1
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "in0"
+          input_stream: "in1"
+          output_stream: "out0"
+          output_stream: "out1"
+        }
+      )pb");
+  *config.mutable_node(0)->mutable_input_stream_handler() =
+      ParseTextProtoOrDie<InputStreamHandlerConfig>(
+          HandlerConfigText(state.range(0)));
+  state.SetLabel(config.node(0).input_stream_handler().input_stream_handler());
+  RunGraph(state, config, /*num_input_streams=*/2);
+  state.SetItemsProcessed(state.iterations() * kPacketsPerIteration);
+}
+BENCHMARK(BM_InputStreamHandler)->DenseRange(0, 2)->UseRealTime();
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -14,6 +14,7 @@
 
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -539,6 +540,107 @@ TEST_F(CalculatorGraphEventLoopTest, WaitToAddPacketToInputStream) {
   ASSERT_EQ(kNumInputPackets, output_packets_.size());
 }
 
+// Test adding batches of packets to several graph input streams at once. The
+// batches are larger than max_queue_size, and are admitted whole whenever the
+// streams are not throttled.
+TEST_F(CalculatorGraphEventLoopTest, AddPacketBatchesToInputStreams) {
+  CalculatorGraphConfig graph_config;
+  ASSERT_TRUE(proto_ns::TextFormat::ParseFromString(
+      R"(
+          node {
+            calculator: "PassThroughCalculator"
+            input_stream: "input_a"
+            input_stream: "input_b"
+            output_stream: "output_a"
+            output_stream: "output_b"
+          }
+          node {
+            calculator: "CallbackCalculator"
+            input_stream: "output_a"
+            input_side_packet: "CALLBACK:callback"
+          }
+          input_stream: "input_a"
+          input_stream: "input_b"
+          num_threads: 2
+          max_queue_size: 2
+      )",
+      &graph_config));
+
+  CalculatorGraph graph(graph_config);
+  MP_ASSERT_OK(graph.StartRun(
+      {{"callback", MakePacket<std::function<void(const Packet&)>>(std::bind(
+                        &CalculatorGraphEventLoopTest::AddThreadSafeVectorSink,
+                        this, std::placeholders::_1))}}));
+
+  constexpr int kNumBatches = 4;
+  constexpr int kBatchSize = 5;
+  for (int i = 0; i < kNumBatches; ++i) {
+    std::map<std::string, std::vector<Packet>> batches;
+    for (int j = i * kBatchSize; j < (i + 1) * kBatchSize; ++j) {
+      batches["input_a"].push_back(Adopt(new int(j)).At(Timestamp(j)));
+      batches["input_b"].push_back(Adopt(new int(-j)).At(Timestamp(j)));
+    }
+    MP_ASSERT_OK(graph.AddPacketsToInputStreams(std::move(batches)));
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  absl::ReaderMutexLock lock(&output_packets_mutex_);
+  ASSERT_EQ(output_packets_.size(), kNumBatches * kBatchSize);
+  for (int i = 0; i < output_packets_.size(); ++i) {
+    EXPECT_EQ(output_packets_[i].Get<int>(), i);
+  }
+}
+
+// Verify that a batch is rejected as a whole by a throttled graph input stream
+// in ADD_IF_NOT_FULL mode, and left with the caller.
+TEST_F(CalculatorGraphEventLoopTest, ThrottleGraphInputStreamBatch) {
+  CalculatorGraphConfig graph_config;
+  ASSERT_TRUE(proto_ns::TextFormat::ParseFromString(
+      R"(
+          node {
+            calculator: "BlockingPassThroughCalculator"
+            input_stream: "input_numbers"
+            output_stream: "output_numbers"
+            input_side_packet: "blocking_mutex"
+          }
+          input_stream: "input_numbers"
+          max_queue_size: 1
+      )",
+      &graph_config));
+
+  absl::Mutex* mutex = new absl::Mutex();
+  Packet mutex_side_packet = AdoptAsUniquePtr(mutex);
+
+  CalculatorGraph graph(graph_config);
+  graph.SetGraphInputStreamAddMode(
+      CalculatorGraph::GraphInputStreamAddMode::ADD_IF_NOT_FULL);
+  MP_ASSERT_OK(graph.StartRun({{"blocking_mutex", mutex_side_packet}}));
+
+  // Lock the mutex so that the BlockingPassThroughCalculator cannot drain the
+  // input stream queue.
+  mutex->Lock();
+  std::vector<Packet> batch;
+  for (int i = 0; i < 3; ++i) {
+    batch.push_back(Adopt(new int(i)).At(Timestamp(i)));
+  }
+  MP_EXPECT_OK(graph.AddPacketsToInputStream("input_numbers", std::move(batch)));
+
+  batch.clear();
+  for (int i = 3; i < 6; ++i) {
+    batch.push_back(Adopt(new int(i)).At(Timestamp(i)));
+  }
+  absl::Status status =
+      graph.AddPacketsToInputStream("input_numbers", std::move(batch));
+  mutex->Unlock();
+  EXPECT_EQ(status.code(), absl::StatusCode::kUnavailable);
+  EXPECT_THAT(status.message(), testing::HasSubstr("Graph is throttled."));
+  EXPECT_EQ(batch.size(), 3);
+
+  MP_ASSERT_OK(graph.CloseInputStream("input_numbers"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+}
+
 // Captures log messages during testing.
 class TextMessageLogSink : public LogSink {
  public:
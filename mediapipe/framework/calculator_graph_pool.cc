@@ -0,0 +1,69 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/calculator_graph_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+
+CalculatorGraphPool::CalculatorGraphPool(CalculatorGraphConfig config,
+                                         int max_idle_graphs, GraphSetup setup)
+    : config_(std::move(config)),
+      max_idle_graphs_(static_cast<size_t>(std::max(max_idle_graphs, 0))),
+      setup_(std::move(setup)) {}
+
+CalculatorGraphPool::~CalculatorGraphPool() = default;
+
+absl::StatusOr<std::unique_ptr<CalculatorGraph>>
+CalculatorGraphPool::Acquire() {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!idle_graphs_.empty()) {
+      std::unique_ptr<CalculatorGraph> graph = std::move(idle_graphs_.back());
+      idle_graphs_.pop_back();
+      return graph;
+    }
+  }
+  auto graph = std::make_unique<CalculatorGraph>();
+  MP_RETURN_IF_ERROR(graph->Initialize(config_));
+  graph->SetReuseCalculators(true);
+  if (setup_) {
+    MP_RETURN_IF_ERROR(setup_(*graph));
+  }
+  return graph;
+}
+
+void CalculatorGraphPool::Release(std::unique_ptr<CalculatorGraph> graph) {
+  if (!graph) return;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (idle_graphs_.size() < max_idle_graphs_) {
+      idle_graphs_.push_back(std::move(graph));
+      return;
+    }
+  }
+  // The pool is full, so the graph is destroyed outside of the lock.
+}
+
+int CalculatorGraphPool::NumIdleGraphs() const {
+  absl::MutexLock lock(&mutex_);
+  return idle_graphs_.size();
+}
+
+}  // namespace mediapipe
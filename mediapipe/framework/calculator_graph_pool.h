@@ -0,0 +1,90 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_CALCULATOR_GRAPH_POOL_H_
+#define MEDIAPIPE_FRAMEWORK_CALCULATOR_GRAPH_POOL_H_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_graph.h"
+
+namespace mediapipe {
+
+// Keeps initialized CalculatorGraphs warm between runs, for serving one
+// graph run per request.  Graphs handed out by the pool reuse their
+// calculators across runs (see CalculatorGraph::SetReuseCalculators), so
+// calculators implementing CalculatorBase::Reset() skip their Open() costs,
+// such as loading models, after the first run.
+//
+// Example:
+//   CalculatorGraphPool pool(config, /*max_idle_graphs=*/4,
+//                            [](CalculatorGraph& graph) {
+//                              return graph.ObserveOutputStream(...);
+//                            });
+//   MP_ASSIGN_OR_RETURN(auto graph, pool.Acquire());
+//   MP_RETURN_IF_ERROR(graph->StartRun({}));
+//   ...
+//   absl::Status status = graph->WaitUntilDone();
+//   pool.Release(std::move(graph));
+//
+// This class is thread-safe.
+class CalculatorGraphPool {
+ public:
+  // Called once on each new graph after Initialize(), e.g. to observe
+  // output streams.  The graph keeps these settings for all of its runs.
+  using GraphSetup = std::function<absl::Status(CalculatorGraph& graph)>;
+
+  // At most max_idle_graphs released graphs are kept for reuse.
+  CalculatorGraphPool(CalculatorGraphConfig config, int max_idle_graphs,
+                      GraphSetup setup = nullptr);
+  ~CalculatorGraphPool();
+
+  CalculatorGraphPool(const CalculatorGraphPool&) = delete;
+  CalculatorGraphPool& operator=(const CalculatorGraphPool&) = delete;
+
+  // Returns a graph ready for StartRun(), either an idle graph from the pool
+  // or a newly initialized one.
+  absl::StatusOr<std::unique_ptr<CalculatorGraph>> Acquire()
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns a graph obtained from Acquire() to the pool.  WaitUntilDone()
+  // must have returned on the graph.  The graph is destroyed if the pool
+  // already holds max_idle_graphs idle graphs.
+  void Release(std::unique_ptr<CalculatorGraph> graph)
+      ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the number of idle graphs.
+  int NumIdleGraphs() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  const CalculatorGraphConfig config_;
+  const size_t max_idle_graphs_;
+  const GraphSetup setup_;
+
+  mutable absl::Mutex mutex_;
+  std::vector<std::unique_ptr<CalculatorGraph>> idle_graphs_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_CALCULATOR_GRAPH_POOL_H_
@@ -0,0 +1,131 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/calculator_graph_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+struct CallCounts {
+  int constructed = 0;
+  int opened = 0;
+  int reset = 0;
+};
+
+// Passes packets through and counts construction, Open() and Reset().
+template <bool kSupportsReset>
+class CountingPassThroughCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).SetAny();
+    cc->Outputs().Index(0).SetSameAs(&cc->Inputs().Index(0));
+    return absl::OkStatus();
+  }
+
+  CountingPassThroughCalculator() { ++counts.constructed; }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    ++counts.opened;
+    return absl::OkStatus();
+  }
+
+  absl::Status Reset(CalculatorContext* cc) override {
+    if (!kSupportsReset) {
+      return CalculatorBase::Reset(cc);
+    }
+    ++counts.reset;
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    cc->Outputs().Index(0).AddPacket(cc->Inputs().Index(0).Value());
+    return absl::OkStatus();
+  }
+
+  static CallCounts counts;
+};
+
+template <bool kSupportsReset>
+CallCounts CountingPassThroughCalculator<kSupportsReset>::counts;
+
+using ResettableCalculator = CountingPassThroughCalculator<true>;
+REGISTER_CALCULATOR(ResettableCalculator);
+using NonResettableCalculator = CountingPassThroughCalculator<false>;
+REGISTER_CALCULATOR(NonResettableCalculator);
+
+// Runs one request through a graph from the pool.
+void RunRequest(CalculatorGraphPool& pool, int value) {
+  auto graph = pool.Acquire();
+  MP_ASSERT_OK(graph);
+  MP_ASSERT_OK((*graph)->StartRun({}));
+  MP_EXPECT_OK((*graph)->AddPacketToInputStream(
+      "in", MakePacket<int>(value).At(Timestamp(0))));
+  MP_EXPECT_OK((*graph)->CloseAllInputStreams());
+  MP_EXPECT_OK((*graph)->WaitUntilDone());
+  pool.Release(std::move(graph).value());
+}
+
+TEST(CalculatorGraphPoolTest, ResetsCalculatorsBetweenRuns) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        output_stream: "out"
+        node {
+          calculator: "ResettableCalculator"
+          input_stream: "in"
+          output_stream: "mid"
+        }
+        node {
+          calculator: "NonResettableCalculator"
+          input_stream: "mid"
+          output_stream: "out"
+        }
+      )pb");
+  ResettableCalculator::counts = {};
+  NonResettableCalculator::counts = {};
+  std::vector<int> outputs;
+  CalculatorGraphPool pool(config, /*max_idle_graphs=*/1,
+                           [&outputs](CalculatorGraph& graph) {
+                             return graph.ObserveOutputStream(
+                                 "out", [&outputs](const Packet& packet) {
+                                   outputs.push_back(packet.Get<int>());
+                                   return absl::OkStatus();
+                                 });
+                           });
+
+  EXPECT_EQ(pool.NumIdleGraphs(), 0);
+  RunRequest(pool, 1);
+  EXPECT_EQ(pool.NumIdleGraphs(), 1);
+  RunRequest(pool, 2);
+  RunRequest(pool, 3);
+  EXPECT_EQ(outputs, std::vector<int>({1, 2, 3}));
+
+  EXPECT_EQ(ResettableCalculator::counts.constructed, 1);
+  EXPECT_EQ(ResettableCalculator::counts.opened, 1);
+  EXPECT_EQ(ResettableCalculator::counts.reset, 2);
+  EXPECT_EQ(NonResettableCalculator::counts.constructed, 3);
+  EXPECT_EQ(NonResettableCalculator::counts.opened, 3);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -1580,6 +1580,18 @@ TEST(CalculatorGraph, RunsCorrectlyWithMultipleExecutors) {
   RunComprehensiveTest(&graph, proto, /*define_node_5=*/true);
 }
 
+TEST(CalculatorGraph, RunsCorrectlyWithWorkStealingExecutor) {
+  CalculatorGraph graph;
+  CalculatorGraphConfig proto = GetConfig();
+  ExecutorConfig* executor = proto.add_executor();
+  executor->set_type("WorkStealingThreadPoolExecutor");
+  ThreadPoolExecutorOptions* extension =
+      executor->mutable_options()->MutableExtension(
+          ThreadPoolExecutorOptions::ext);
+  extension->set_num_threads(4);
+  RunComprehensiveTest(&graph, proto, /*define_node_5=*/true);
+}
+
 // Packet generator for an arbitrary unit64 packet.
 class Uint64PacketGenerator : public PacketGenerator {
  public:
@@ -3559,6 +3571,59 @@ TEST(CalculatorGraph, AddPacketNoBusyLoop) {
   }
 }
 
+// Tests that an invocation past its deadline is shed, and that its output
+// stream still advances past the shed timestamp.
+TEST(CalculatorGraph, ShedsExpiredInputs) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "a"
+        input_stream: "b"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "a"
+          output_stream: "a_out"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "b"
+          output_stream: "b_out"
+          deadline_budget_usec: 10
+          shed_expired_inputs: true
+        }
+      )pb");
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  std::vector<Packet> b_packets;
+  MP_ASSERT_OK(graph.ObserveOutputStream(
+      "b_out",
+      [&b_packets](const Packet& packet) {
+        b_packets.push_back(packet);
+        return absl::OkStatus();
+      },
+      /*observe_timestamp_bounds=*/true));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+
+  // While the graph is paused, schedule "b" at timestamp 0 and then "a" at
+  // timestamp 100, which expires the deadline 0 + 10 of "b".
+  graph.Pause();
+  MP_ASSERT_OK(
+      graph.AddPacketToInputStream("b", MakePacket<int>(0).At(Timestamp(0))));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "a", MakePacket<int>(100).At(Timestamp(100))));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "b", MakePacket<int>(100).At(Timestamp(100))));
+  graph.Resume();
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  // The packet at timestamp 0 is shed, but its timestamp is settled.
+  ASSERT_EQ(b_packets.size(), 2);
+  EXPECT_TRUE(b_packets[0].IsEmpty());
+  EXPECT_EQ(b_packets[0].Timestamp(), Timestamp(0));
+  EXPECT_EQ(b_packets[1].Get<int>(), 100);
+}
+
 namespace nested_ns {
 
 typedef std::function<absl::Status(const InputStreamShardSet&,
@@ -4603,6 +4668,74 @@ TEST(CalculatorGraph, TestOutputStreamPollerDesiredQueueSize) {
   }
 }
 
+TEST(CalculatorGraph, TestPollPacketBatches) {
+  CalculatorGraphConfig config;
+  CalculatorGraphConfig::Node* node = config.add_node();
+  node->set_calculator("CountingSourceCalculator");
+  node->add_output_stream("output");
+  node->add_input_side_packet("MAX_COUNT:max_count");
+
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  auto status_or_poller = graph.AddOutputStreamPoller("output");
+  ASSERT_TRUE(status_or_poller.ok());
+  OutputStreamPoller poller = std::move(status_or_poller.value());
+  poller.ReserveQueue(kDefaultMaxCount);
+  MP_ASSERT_OK(
+      graph.StartRun({{"max_count", MakePacket<int>(kDefaultMaxCount)}}));
+  constexpr int kMaxBatchSize = 16;
+  std::vector<Packet> packets;
+  int num_packets = 0;
+  while (poller.NextBatch(&packets, kMaxBatchSize)) {
+    EXPECT_FALSE(packets.empty());
+    EXPECT_LE(packets.size(), kMaxBatchSize);
+    for (const Packet& packet : packets) {
+      EXPECT_EQ(num_packets, packet.Get<int>());
+      ++num_packets;
+    }
+  }
+  MP_ASSERT_OK(graph.CloseAllPacketSources());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_FALSE(poller.NextBatch(&packets, kMaxBatchSize));
+  EXPECT_TRUE(packets.empty());
+  EXPECT_EQ(kDefaultMaxCount, num_packets);
+}
+
+TEST(CalculatorGraph, TestPollPacketBatchTimeout) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "input"
+          output_stream: "output"
+        }
+      )pb");
+
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  auto status_or_poller = graph.AddOutputStreamPoller("output");
+  ASSERT_TRUE(status_or_poller.ok());
+  OutputStreamPoller poller = std::move(status_or_poller.value());
+  MP_ASSERT_OK(graph.StartRun({}));
+  std::vector<Packet> packets;
+  EXPECT_TRUE(poller.NextBatch(&packets, 4, absl::Milliseconds(10)));
+  EXPECT_TRUE(packets.empty());
+
+  for (int i = 0; i < 3; ++i) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "input", MakePacket<int>(i).At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  ASSERT_TRUE(poller.NextBatch(&packets, 4, absl::Milliseconds(10)));
+  ASSERT_EQ(packets.size(), 3);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(packets[i].Get<int>(), i);
+  }
+  EXPECT_FALSE(poller.NextBatch(&packets, 4, absl::Milliseconds(10)));
+}
+
 TEST(CalculatorGraph, TestPollPacketsFromMultipleStreams) {
   CalculatorGraphConfig config;
   CalculatorGraphConfig::Node* node1 = config.add_node();
@@ -14,11 +14,15 @@
 
 #include "mediapipe/framework/calculator_node.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
@@ -33,6 +37,8 @@
 #include "mediapipe/framework/calculator_base.h"
 #include "mediapipe/framework/calculator_state.h"
 #include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/formats/cpu_allocator.h"
+#include "mediapipe/framework/formats/cpu_allocator_service.h"
 #include "mediapipe/framework/graph_service_manager.h"
 #include "mediapipe/framework/input_stream_manager.h"
 #include "mediapipe/framework/mediapipe_profiling.h"
@@ -137,8 +143,8 @@ absl::Status CalculatorNode::Initialize(
   const CalculatorGraphConfig::Node* node_config;
   if (node_ref.type == NodeTypeInfo::NodeType::CALCULATOR) {
     node_config = &validated_graph_->Config().node(node_ref.index);
-    name_ = tool::CanonicalNodeName(validated_graph_->Config(), node_ref.index);
     node_type_info_ = &validated_graph_->CalculatorInfos()[node_ref.index];
+    name_ = node_type_info_->Contract().GetNodeName();
   } else if (node_ref.type == NodeTypeInfo::NodeType::PACKET_GENERATOR) {
     const PacketGeneratorConfig& pg_config =
         validated_graph_->Config().packet_generator(node_ref.index);
@@ -151,14 +157,26 @@ absl::Status CalculatorNode::Initialize(
         "node_ref is not a calculator or packet generator");
   }
 
+  const CalculatorContract& contract = node_type_info_->Contract();
+
   max_in_flight_ = node_config->max_in_flight();
-  max_in_flight_ = max_in_flight_ ? max_in_flight_ : 1;
+  if (max_in_flight_ == 0 && contract.GetProcessMaxInFlight() != 1 &&
+      node_type_info_->InputStreamTypes().NumEntries() > 0 &&
+      !contract.GetProcessInputBatches()) {
+    // The calculator declared Process reentrant.
+    max_in_flight_ = contract.GetProcessMaxInFlight();
+    if (max_in_flight_ == 0) {
+      max_in_flight_ = std::thread::hardware_concurrency();
+    }
+  }
+  max_in_flight_ = std::max(max_in_flight_, 1);
   if (!node_config->executor().empty()) {
     executor_ = node_config->executor();
   }
   source_layer_ = node_config->source_layer();
-
-  const CalculatorContract& contract = node_type_info_->Contract();
+  deadline_budget_usec_ = std::max<int64_t>(node_config->deadline_budget_usec(),
+                                            0);
+  shed_expired_inputs_ = node_config->shed_expired_inputs();
 
   // TODO Propagate types between calculators when SetAny is used.
 
@@ -214,6 +232,7 @@ absl::Status CalculatorNode::Initialize(
   }
   input_stream_handler_->SetProcessTimestampBounds(
       contract.GetProcessTimestampBounds());
+  process_input_batches_ = contract.GetProcessInputBatches();
 
   return InitializeInputStreams(input_stream_managers, output_stream_managers);
 }
@@ -378,6 +397,13 @@ void CalculatorNode::SetMaxInputStreamQueueSize(int max_queue_size) {
   input_stream_handler_->SetMaxQueueSize(max_queue_size);
 }
 
+void CalculatorNode::SetReuseCalculator(bool reuse) {
+  reuse_calculator_ = reuse;
+  if (!reuse_calculator_) {
+    calculator_ = nullptr;
+  }
+}
+
 absl::Status CalculatorNode::PrepareForRun(
     const std::map<std::string, Packet>& all_side_packets,
     const std::map<std::string, Packet>& service_packets,
@@ -385,7 +411,8 @@ absl::Status CalculatorNode::PrepareForRun(
     std::function<void()> source_node_opened_callback,
     std::function<void(CalculatorContext*)> schedule_callback,
     std::function<void(absl::Status)> error_callback,
-    CounterFactory* counter_factory) {
+    CounterFactory* counter_factory,
+    std::shared_ptr<PacketArena> packet_arena, mediapipe::Executor* executor) {
   RET_CHECK(ready_for_open_callback) << "ready_for_open_callback is NULL";
   RET_CHECK(schedule_callback) << "schedule_callback is NULL";
   RET_CHECK(error_callback) << "error_callback is NULL";
@@ -410,6 +437,8 @@ absl::Status CalculatorNode::PrepareForRun(
       &input_side_packet_handler_.InputSidePackets());
   calculator_state_->SetOutputSidePackets(output_side_packets_.get());
   calculator_state_->SetCounterFactory(counter_factory);
+  calculator_state_->SetPacketArena(std::move(packet_arena));
+  calculator_state_->SetExecutor(executor);
 
   for (const auto& svc_req : contract.ServiceRequests()) {
     const auto& req = svc_req.second;
@@ -423,15 +452,19 @@ absl::Status CalculatorNode::PrepareForRun(
     }
   }
 
+  auto cpu_allocator = service_packets.find(kCpuAllocatorService.key);
+  cpu_allocator_ = cpu_allocator == service_packets.end()
+                       ? nullptr
+                       : cpu_allocator->second
+                             .Get<std::shared_ptr<CpuAllocator>>();
+
   MP_RETURN_IF_ERROR(calculator_context_manager_.PrepareForRun(std::bind(
       &CalculatorNode::ConnectShardsToStreams, this, std::placeholders::_1)));
 
-  MP_ASSIGN_OR_RETURN(
-      auto calculator_factory,
-      CalculatorBaseRegistry::CreateByNameInNamespace(
-          validated_graph_->Package(), calculator_state_->CalculatorType()));
-  calculator_ = calculator_factory->CreateCalculator(
-      calculator_context_manager_.GetDefaultCalculatorContext());
+  calculator_reused_ = calculator_ != nullptr;
+  if (!calculator_reused_) {
+    MP_RETURN_IF_ERROR(CreateCalculator());
+  }
 
   needs_to_close_ = false;
 
@@ -472,6 +505,34 @@ absl::Status ResendSidePackets(CalculatorContext* cc) {
 }
 }  // namespace
 
+absl::Status CalculatorNode::CreateCalculator() {
+  MP_ASSIGN_OR_RETURN(
+      auto calculator_factory,
+      CalculatorBaseRegistry::CreateByNameInNamespace(
+          validated_graph_->Package(), calculator_state_->CalculatorType()));
+  calculator_ = calculator_factory->CreateCalculator(
+      calculator_context_manager_.GetDefaultCalculatorContext());
+  return absl::OkStatus();
+}
+
+absl::Status CalculatorNode::ResetOrOpenCalculator(CalculatorContext* cc) {
+  if (calculator_reused_ &&
+      !input_side_packet_handler_.InputSidePacketsChanged()) {
+    absl::Status result = calculator_->Reset(cc);
+    if (!absl::IsUnimplemented(result)) {
+      MP_RETURN_IF_ERROR(result);
+      // Output side packets set by Open() in an earlier run are announced
+      // again, as for nodes with constant outputs.
+      return ResendSidePackets(cc);
+    }
+  }
+  if (calculator_reused_) {
+    MP_RETURN_IF_ERROR(CreateCalculator());
+    calculator_reused_ = false;
+  }
+  return calculator_->Open(cc);
+}
+
 bool CalculatorNode::OutputsAreConstant(CalculatorContext* cc) {
   if (cc->Inputs().NumEntries() > 0 || cc->Outputs().NumEntries() > 0) {
     return false;
@@ -482,6 +543,48 @@ bool CalculatorNode::OutputsAreConstant(CalculatorContext* cc) {
   return true;
 }
 
+absl::Status CalculatorNode::ProcessInputBatch(
+    CalculatorContext* calculator_context) {
+  calculator_context_manager_.SetInputBatchSizeInContext(
+      calculator_context,
+      calculator_context_manager_.NumberOfContextTimestamps(
+          *calculator_context));
+  const std::vector<Timestamp> input_timestamps =
+      calculator_context->InputTimestamps();
+  if (input_timestamps.empty()) {
+    calculator_context_manager_.SetInputBatchSizeInContext(calculator_context,
+                                                           1);
+    return absl::OkStatus();
+  }
+  output_stream_handler_->PrepareOutputs(input_timestamps.front(),
+                                         &calculator_context->Outputs());
+
+  VLOG(2) << "Calling Calculator::Process() for node: " << DebugName()
+          << " timestamps: " << input_timestamps.front() << " to "
+          << input_timestamps.back();
+  absl::Status result;
+  {
+    MEDIAPIPE_PROFILING(PROCESS, calculator_context);
+    LegacyCalculatorSupport::Scoped<CalculatorContext> s(calculator_context);
+    ScopedCpuAllocator scoped_allocator(cpu_allocator_);
+    result = calculator_->Process(calculator_context);
+  }
+  calculator_context_manager_.ResetScratchArenaInContext(calculator_context);
+  calculator_context_manager_.SetInputBatchSizeInContext(calculator_context, 1);
+
+  // Removes the packets and input timestamps of the whole batch.
+  for (int i = 0; i < input_timestamps.size(); ++i) {
+    input_stream_handler_->ClearCurrentInputs(calculator_context);
+  }
+  if (!result.ok() && result != tool::StatusStop()) {
+    return mediapipe::StatusBuilder(result, MEDIAPIPE_LOC).SetPrepend()
+           << absl::Substitute("Calculator::Process() for node \"$0\" failed: ",
+                               DebugName());
+  }
+  output_stream_handler_->PostProcess(input_timestamps.back());
+  return result;
+}
+
 absl::Status CalculatorNode::OpenNode() {
   VLOG(2) << "CalculatorNode::OpenNode() for " << DebugName();
 
@@ -503,8 +606,10 @@ absl::Status CalculatorNode::OpenNode() {
   } else {
     MEDIAPIPE_PROFILING(OPEN, default_context);
     LegacyCalculatorSupport::Scoped<CalculatorContext> s(default_context);
-    result = calculator_->Open(default_context);
+    ScopedCpuAllocator scoped_allocator(cpu_allocator_);
+    result = ResetOrOpenCalculator(default_context);
   }
+  calculator_context_manager_.ResetScratchArenaInContext(default_context);
 
   calculator_context_manager_.PopInputTimestampFromContext(default_context);
   if (IsSource()) {
@@ -605,8 +710,10 @@ absl::Status CalculatorNode::CloseNode(const absl::Status& graph_status,
   } else {
     MEDIAPIPE_PROFILING(CLOSE, default_context);
     LegacyCalculatorSupport::Scoped<CalculatorContext> s(default_context);
+    ScopedCpuAllocator scoped_allocator(cpu_allocator_);
     result = calculator_->Close(default_context);
   }
+  calculator_context_manager_.ResetScratchArenaInContext(default_context);
   needs_to_close_ = false;
 
   ABSL_LOG_IF(FATAL, result == tool::StatusStop()) << absl::Substitute(
@@ -641,7 +748,9 @@ void CalculatorNode::CleanupAfterRun(const absl::Status& graph_status) {
         Timestamp::Done());
     CloseNode(graph_status, /*graph_run_ended=*/true).IgnoreError();
   }
-  calculator_ = nullptr;
+  if (!reuse_calculator_ || !graph_status.ok()) {
+    calculator_ = nullptr;
+  }
   // All pending output packets are automatically dropped when calculator
   // context manager destroys all calculator context objects.
   calculator_context_manager_.CleanupAfterRun();
@@ -803,8 +912,19 @@ std::string CalculatorNode::DebugName() const {
 }
 
 // TODO: Split this function.
-absl::Status CalculatorNode::ProcessNode(
-    CalculatorContext* calculator_context) {
+Timestamp CalculatorNode::Deadline(Timestamp input_timestamp) const {
+  if (deadline_budget_usec_ == 0 || !input_timestamp.IsRangeValue()) {
+    return Timestamp::Max();
+  }
+  // Saturates at Timestamp::Max().
+  return Timestamp(
+      input_timestamp.Value() +
+      std::min(deadline_budget_usec_,
+               Timestamp::Max().Value() - input_timestamp.Value()));
+}
+
+absl::Status CalculatorNode::ProcessNode(CalculatorContext* calculator_context,
+                                         Timestamp newest_input_timestamp) {
   if (IsSource()) {
     // This is a source Calculator.
     if (Closed()) {
@@ -822,8 +942,10 @@ absl::Status CalculatorNode::ProcessNode(
     {
       MEDIAPIPE_PROFILING(PROCESS, calculator_context);
       LegacyCalculatorSupport::Scoped<CalculatorContext> s(calculator_context);
+      ScopedCpuAllocator scoped_allocator(cpu_allocator_);
       result = calculator_->Process(calculator_context);
     }
+    calculator_context_manager_.ResetScratchArenaInContext(calculator_context);
 
     bool node_stopped = false;
     if (!result.ok()) {
@@ -855,6 +977,15 @@ absl::Status CalculatorNode::ProcessNode(
     RET_CHECK(num_invocations <= 1 || max_in_flight_ <= 1)
         << "num_invocations:" << num_invocations
         << ", max_in_flight_:" << max_in_flight_;
+    if (process_input_batches_ && num_invocations > 1) {
+      result = ProcessInputBatch(calculator_context);
+      if (!result.ok()) {
+        return result;
+      }
+      // At most Timestamp::Done() is left, which closes the node below.
+      num_invocations = calculator_context_manager_.NumberOfContextTimestamps(
+          *calculator_context);
+    }
     for (int i = 0; i < num_invocations; ++i) {
       const Timestamp input_timestamp = calculator_context->InputTimestamp();
       // The node is ready for Process().
@@ -865,15 +996,30 @@ absl::Status CalculatorNode::ProcessNode(
         VLOG(2) << "Calling Calculator::Process() for node: " << DebugName()
                 << " timestamp: " << input_timestamp;
 
-        if (OutputsAreConstant(calculator_context)) {
+        if (shed_expired_inputs_ &&
+            Deadline(input_timestamp) < newest_input_timestamp) {
+          // The invocation has expired. Skip Process() and let the outputs
+          // settle the input timestamp.
+          VLOG(2) << "Shedding expired input for node: " << DebugName()
+                  << " timestamp: " << input_timestamp;
+          for (CollectionItemId id = outputs->BeginId(); id < outputs->EndId();
+               ++id) {
+            outputs->Get(id).SetNextTimestampBound(
+                input_timestamp.NextAllowedInStream());
+          }
+          result = absl::OkStatus();
+        } else if (OutputsAreConstant(calculator_context)) {
           // Do nothing.
           result = absl::OkStatus();
         } else {
           MEDIAPIPE_PROFILING(PROCESS, calculator_context);
           LegacyCalculatorSupport::Scoped<CalculatorContext> s(
               calculator_context);
+          ScopedCpuAllocator scoped_allocator(cpu_allocator_);
           result = calculator_->Process(calculator_context);
         }
+        calculator_context_manager_.ResetScratchArenaInContext(
+            calculator_context);
 
         VLOG(2) << "Called Calculator::Process() for node: " << DebugName()
                 << " timestamp: " << input_timestamp;
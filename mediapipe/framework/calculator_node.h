@@ -35,6 +35,8 @@
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/calculator_context_manager.h"
 #include "mediapipe/framework/calculator_state.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/formats/cpu_allocator.h"
 #include "mediapipe/framework/graph_service_manager.h"
 #include "mediapipe/framework/input_side_packet_handler.h"
 #include "mediapipe/framework/input_stream_handler.h"
@@ -42,6 +44,7 @@
 #include "mediapipe/framework/output_side_packet_impl.h"
 #include "mediapipe/framework/output_stream_handler.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_arena.h"
 #include "mediapipe/framework/packet_set.h"
 #include "mediapipe/framework/packet_type.h"
 #include "mediapipe/framework/port.h"
@@ -97,7 +100,19 @@ class CalculatorNode {
   void SetExecutor(const std::string& executor);
 
   // Calls Process() on the Calculator corresponding to this node.
-  absl::Status ProcessNode(CalculatorContext* calculator_context);
+  absl::Status ProcessNode(CalculatorContext* calculator_context) {
+    return ProcessNode(calculator_context, Timestamp::Unset());
+  }
+
+  // Calls Process() on the Calculator corresponding to this node, shedding
+  // the invocations whose deadline is before newest_input_timestamp if the
+  // node sheds expired inputs.
+  absl::Status ProcessNode(CalculatorContext* calculator_context,
+                           Timestamp newest_input_timestamp);
+
+  // Returns the deadline of an invocation at input_timestamp, or
+  // Timestamp::Max() if the node has no deadline budget.
+  Timestamp Deadline(Timestamp input_timestamp) const;
 
   // Initializes the node.  The buffer_size_hint argument is
   // set to the value specified in the graph proto for this field.
@@ -124,7 +139,9 @@ class CalculatorNode {
   // the priority queue). ready_for_open_callback is called when OpenNode()
   // can be scheduled. source_node_opened_callback is called when a source
   // node is opened. schedule_callback is passed to the InputStreamHandler
-  // and is called each time a new invocation can be scheduled.
+  // and is called each time a new invocation can be scheduled. executor is
+  // the executor the node runs on, or null if the node runs on the
+  // application thread.
   absl::Status PrepareForRun(
       const std::map<std::string, Packet>& all_side_packets,
       const std::map<std::string, Packet>& service_packets,
@@ -132,14 +149,16 @@ class CalculatorNode {
       std::function<void()> source_node_opened_callback,
       std::function<void(CalculatorContext*)> schedule_callback,
       std::function<void(absl::Status)> error_callback,
-      CounterFactory* counter_factory) ABSL_LOCKS_EXCLUDED(status_mutex_);
+      CounterFactory* counter_factory,
+      std::shared_ptr<PacketArena> packet_arena, mediapipe::Executor* executor)
+      ABSL_LOCKS_EXCLUDED(status_mutex_);
   // Opens the node.
   absl::Status OpenNode() ABSL_LOCKS_EXCLUDED(status_mutex_);
   // Called when a source node's layer becomes active.
   void ActivateNode() ABSL_LOCKS_EXCLUDED(status_mutex_);
   // Cleans up the node after the CalculatorGraph has been run. Deletes
-  // the Calculator managed by this node. graph_status is the status of
-  // the graph run.
+  // the Calculator managed by this node, unless calculator reuse is enabled
+  // and the run succeeded. graph_status is the status of the graph run.
   void CleanupAfterRun(const absl::Status& graph_status)
       ABSL_LOCKS_EXCLUDED(status_mutex_);
 
@@ -216,6 +235,11 @@ class CalculatorNode {
   // max_queue_size to trigger callbacks.
   void SetMaxInputStreamQueueSize(int max_queue_size);
 
+  // Keeps the calculator after a successful graph run, so that the next
+  // run calls CalculatorBase::Reset() on it instead of constructing and
+  // opening a new calculator.
+  void SetReuseCalculator(bool reuse);
+
   // Closes the node's calculator and input and output streams.
   // graph_status is the current status of the graph run. graph_run_ended
   // indicates whether the graph run has ended.
@@ -288,10 +312,25 @@ class CalculatorNode {
   // Returns true if all outputs will be identical to the previous graph run.
   bool OutputsAreConstant(CalculatorContext* cc);
 
+  // Creates a new calculator of this node's type.
+  absl::Status CreateCalculator();
+
+  // Resets a calculator kept from the previous graph run, or replaces it
+  // with a newly opened one if it doesn't support Reset() or its input side
+  // packets have changed.
+  absl::Status ResetOrOpenCalculator(CalculatorContext* cc);
+
+  // Calls Process() once for all the input timestamps in calculator_context
+  // that are allowed in stream, for calculators that process input batches.
+  absl::Status ProcessInputBatch(CalculatorContext* calculator_context);
+
   // The calculator.
   std::unique_ptr<CalculatorBase> calculator_;
   // Keeps data which a Calculator subclass needs access to.
   std::unique_ptr<CalculatorState> calculator_state_;
+  // The allocator of ImageFrame and Tensor CPU storage set with
+  // kCpuAllocatorService, if any.
+  std::shared_ptr<CpuAllocator> cpu_allocator_;
 
   std::string name_;  // Optional user-defined name
   // Name of the executor which the node will execute on. If empty, the node
@@ -299,6 +338,14 @@ class CalculatorNode {
   std::string executor_;
   // The layer a source calculator operates on.
   int source_layer_ = 0;
+  // The deadline budget of an invocation, in microseconds. Zero means no
+  // deadline.
+  int64_t deadline_budget_usec_ = 0;
+  // True if invocations past their deadline skip Process().
+  bool shed_expired_inputs_ = false;
+  // True if the calculator receives a batch of input timestamps per Process()
+  // call. See CalculatorContract::SetProcessInputBatches().
+  bool process_input_batches_ = false;
   // The status of the current Calculator that this CalculatorNode
   // is wrapping.  kStateActive is currently used only for source nodes.
   enum NodeStatus {
@@ -371,6 +418,11 @@ class CalculatorNode {
   // True if CleanupAfterRun() needs to call CloseNode().
   bool needs_to_close_ = false;
 
+  // True if the calculator is kept across successful graph runs.
+  bool reuse_calculator_ = false;
+  // True if calculator_ was kept from the previous graph run.
+  bool calculator_reused_ = false;
+
   internal::SchedulerQueue* scheduler_queue_ = nullptr;
 
   const ValidatedGraphConfig* validated_graph_ = nullptr;
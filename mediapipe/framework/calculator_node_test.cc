@@ -181,6 +181,8 @@ class CalculatorNodeTest : public ::testing::Test {
                   this, std::placeholders::_1,        //
                   &schedule_count_),                  //
         CheckFail,                                    //
+        nullptr,                                      //
+        nullptr,                                      //
         nullptr);
   }
 
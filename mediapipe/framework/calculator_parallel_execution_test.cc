@@ -19,6 +19,7 @@
 //
 // TODO: Add more tests to verify the correctness of parallel execution.
 
+#include <atomic>
 #include <memory>
 #include <random>
 #include <string>
@@ -76,6 +77,39 @@ class SlowPlusOneCalculator : public CalculatorBase {
 
 REGISTER_CALCULATOR(SlowPlusOneCalculator);
 
+// Declares Process reentrant and records how many invocations overlap.
+class ReentrantPlusOneCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<int>();
+    cc->Outputs().Index(0).Set<int>();
+    cc->SetTimestampOffset(0);
+    cc->SetProcessReentrant(/*max_in_flight=*/4);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const int in_flight = ++in_flight_;
+    int max_in_flight = max_in_flight_.load();
+    while (max_in_flight < in_flight &&
+           !max_in_flight_.compare_exchange_weak(max_in_flight, in_flight)) {
+    }
+    absl::SleepFor(absl::Milliseconds(20));
+    cc->Outputs().Index(0).Add(new int(cc->Inputs().Index(0).Get<int>() + 1),
+                               cc->InputTimestamp());
+    --in_flight_;
+    return absl::OkStatus();
+  }
+
+  static std::atomic<int> max_in_flight_;
+
+ private:
+  std::atomic<int> in_flight_{0};
+};
+std::atomic<int> ReentrantPlusOneCalculator::max_in_flight_{0};
+
+REGISTER_CALCULATOR(ReentrantPlusOneCalculator);
+
 class ParallelExecutionTest : public testing::Test {
  public:
   void AddThreadSafeVectorSink(const Packet& packet) {
@@ -152,5 +186,46 @@ TEST_F(ParallelExecutionTest, SlowPlusOneCalculatorsTest) {
   }
 }
 
+TEST_F(ParallelExecutionTest, ReentrantCalculatorRunsInParallel) {
+  CalculatorGraphConfig graph_config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        node {
+          calculator: "ReentrantPlusOneCalculator"
+          input_stream: "input"
+          output_stream: "output"
+        }
+        node {
+          calculator: "CallbackCalculator"
+          input_stream: "output"
+          input_side_packet: "CALLBACK:callback"
+        }
+        num_threads: 4
+      )pb");
+
+  ReentrantPlusOneCalculator::max_in_flight_ = 0;
+  CalculatorGraph graph(graph_config);
+  MP_ASSERT_OK(graph.StartRun(
+      {{"callback", MakePacket<std::function<void(const Packet&)>>(std::bind(
+                        &ParallelExecutionTest::AddThreadSafeVectorSink, this,
+                        std::placeholders::_1))}}));
+  const int kTotalNums = 40;
+  for (int i = 0; i < kTotalNums; ++i) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "input", Adopt(new int(i)).At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.CloseInputStream("input"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+
+  EXPECT_GT(ReentrantPlusOneCalculator::max_in_flight_, 1);
+  EXPECT_LE(ReentrantPlusOneCalculator::max_in_flight_, 4);
+  absl::ReaderMutexLock lock(&output_packets_mutex_);
+  ASSERT_EQ(kTotalNums, output_packets_.size());
+  for (int i = 0; i < kTotalNums; ++i) {
+    EXPECT_EQ(Timestamp(i), output_packets_[i].Timestamp());
+    EXPECT_EQ(i + 1, output_packets_[i].Get<int>());
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
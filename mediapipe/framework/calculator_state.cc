@@ -56,6 +56,8 @@ CalculatorState::~CalculatorState() {}
 void CalculatorState::ResetBetweenRuns() {
   input_side_packets_ = nullptr;
   counter_factory_ = nullptr;
+  packet_arena_ = nullptr;
+  executor_ = nullptr;
 }
 
 void CalculatorState::SetInputSidePackets(const PacketSet* input_side_packets) {
@@ -27,9 +27,11 @@
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/counter.h"
 #include "mediapipe/framework/counter_factory.h"
+#include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/graph_service.h"
 #include "mediapipe/framework/graph_service_manager.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_arena.h"
 #include "mediapipe/framework/packet_set.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/any_proto.h"
@@ -91,6 +93,15 @@ class CalculatorState {
   // created by this counter set do not have the NodeName prefix.
   CounterFactory* GetCounterFactory();
 
+  // Returns the graph's packet arena, or null if there is none.
+  const std::shared_ptr<PacketArena>& GetPacketArena() const {
+    return packet_arena_;
+  }
+
+  // Returns the executor the calculator runs on, or null if it runs on the
+  // application thread.
+  Executor* GetExecutor() const { return executor_; }
+
   std::shared_ptr<ProfilingContext> GetSharedProfilingContext() const {
     return profiling_context_;
   }
@@ -115,6 +126,12 @@ class CalculatorState {
   void SetCounterFactory(CounterFactory* counter_factory) {
     counter_factory_ = counter_factory;
   }
+  // Sets the packet arena.
+  void SetPacketArena(std::shared_ptr<PacketArena> packet_arena) {
+    packet_arena_ = std::move(packet_arena);
+  }
+  // Sets the executor.
+  void SetExecutor(Executor* executor) { executor_ = executor; }
 
   absl::Status SetServicePacket(const GraphServiceBase& service,
                                 Packet packet) {
@@ -164,6 +181,12 @@ class CalculatorState {
   OutputSidePacketSet* output_side_packets_;
 
   CounterFactory* counter_factory_;
+
+  // The graph's packet arena, set by CalculatorNode::PrepareForRun().
+  std::shared_ptr<PacketArena> packet_arena_;
+
+  // The node's executor, set by CalculatorNode::PrepareForRun().
+  Executor* executor_;
 };
 
 }  // namespace mediapipe
@@ -14,9 +14,16 @@
 
 #include "mediapipe/framework/counter_factory.h"
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
 #include <vector>
 
+#include "absl/base/optimization.h"
 #include "absl/log/absl_log.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 
@@ -24,32 +31,51 @@ namespace mediapipe {
 namespace {
 
 // Counter implementation when we're not using Flume.
-// TODO: Consider using Dax atomic counters instead of this.
+// Increments go to one of several cache-line sized shards, picked per thread,
+// so that concurrent updates neither lock nor contend on the same cache line.
+// Get() sums the shards and may miss increments that happen concurrently.
 // This class is thread safe.
 class BasicCounter : public Counter {
  public:
-  explicit BasicCounter(const std::string& name) : value_(0) {}
+  explicit BasicCounter(const std::string& name) {}
 
-  void Increment() ABSL_LOCKS_EXCLUDED(mu_) override {
-    absl::WriterMutexLock lock(&mu_);
-    ++value_;
-  }
+  void Increment() override { IncrementBy(1); }
 
-  void IncrementBy(int amount) ABSL_LOCKS_EXCLUDED(mu_) override {
-    absl::WriterMutexLock lock(&mu_);
-    value_ += amount;
+  void IncrementBy(int amount) override {
+    shards_[ShardIndex()].value.fetch_add(amount, std::memory_order_relaxed);
   }
 
-  int64_t Get() ABSL_LOCKS_EXCLUDED(mu_) override {
-    absl::ReaderMutexLock lock(&mu_);
-    return value_;
+  int64_t Get() override {
+    int64_t sum = 0;
+    for (const Shard& shard : shards_) {
+      sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
   }
 
  private:
-  absl::Mutex mu_;
-  int64_t value_ ABSL_GUARDED_BY(mu_);
+  static constexpr int kNumShards = 16;
+
+  struct alignas(ABSL_CACHELINE_SIZE) Shard {
+    std::atomic<int64_t> value{0};
+  };
+
+  // Threads are assigned shards round-robin on first use.
+  static int ShardIndex() {
+    static std::atomic<int> next_index{0};
+    thread_local const int index =
+        next_index.fetch_add(1, std::memory_order_relaxed) % kNumShards;
+    return index;
+  }
+
+  Shard shards_[kNumShards];
 };
 
+bool IsPrometheusNameChar(char c, bool first) {
+  return absl::ascii_isalpha(c) || c == '_' || c == ':' ||
+         (!first && absl::ascii_isdigit(c));
+}
+
 }  // namespace
 
 CounterSet::CounterSet() {}
@@ -84,6 +110,22 @@ std::map<std::string, int64_t> CounterSet::GetCountersValues()
   return result;
 }
 
+std::string CountersToPrometheusText(
+    const std::map<std::string, int64_t>& values, absl::string_view prefix) {
+  std::string result;
+  for (const auto& [name, value] : values) {
+    std::string metric_name = absl::StrCat(prefix, name);
+    for (int i = 0; i < metric_name.size(); ++i) {
+      if (!IsPrometheusNameChar(metric_name[i], /*first=*/i == 0)) {
+        metric_name[i] = '_';
+      }
+    }
+    absl::StrAppend(&result, "# TYPE ", metric_name, " counter\n", metric_name,
+                    " ", value, "\n");
+  }
+  return result;
+}
+
 Counter* BasicCounterFactory::GetCounter(const std::string& name) {
   return counter_set_.Emplace<BasicCounter>(name, name);
 }
@@ -22,6 +22,7 @@
 #include <string>
 
 #include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "mediapipe/framework/counter.h"
@@ -52,6 +53,16 @@ class CounterSet {
   template <typename CounterType, typename... Args>
   Counter* Emplace(const std::string& name, Args&&... args)
       ABSL_LOCKS_EXCLUDED(mu_) {
+    // Counters are usually looked up again on every packet, so try the
+    // shared lock first.
+    {
+      absl::ReaderMutexLock lock(&mu_);
+      std::unique_ptr<Counter>* existing_counter =
+          FindOrNull(counters_, name);
+      if (existing_counter) {
+        return existing_counter->get();
+      }
+    }
     absl::WriterMutexLock lock(&mu_);
     std::unique_ptr<Counter>* existing_counter = FindOrNull(counters_, name);
     if (existing_counter) {
@@ -74,6 +85,13 @@ class CounterSet {
       ABSL_GUARDED_BY(mu_);
 };
 
+// Formats counter values in the Prometheus text exposition format. Each
+// counter name is prefixed with |prefix| and characters that are not valid in
+// a metric name are replaced with '_'.
+std::string CountersToPrometheusText(
+    const std::map<std::string, int64_t>& values,
+    absl::string_view prefix = "mediapipe_");
+
 // Generic counter factory
 class CounterFactory {
  public:
@@ -86,6 +104,9 @@ class CounterFactory {
 };
 
 // Counter factory that makes the counters be our own basic counters.
+// Increments do not take a lock: each counter keeps per-thread shards which
+// are summed when the value is read, so counters are cheap enough to be
+// updated for every packet.
 class BasicCounterFactory : public CounterFactory {
  public:
   ~BasicCounterFactory() override {}
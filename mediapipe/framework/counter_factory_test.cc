@@ -0,0 +1,66 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/counter_factory.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "mediapipe/framework/counter.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(BasicCounterFactoryTest, ReturnsSameCounterForSameName) {
+  BasicCounterFactory factory;
+  Counter* counter = factory.GetCounter("frames");
+  EXPECT_EQ(factory.GetCounter("frames"), counter);
+  EXPECT_NE(factory.GetCounter("drops"), counter);
+}
+
+TEST(BasicCounterFactoryTest, SumsConcurrentIncrements) {
+  constexpr int kNumThreads = 8;
+  constexpr int kIncrementsPerThread = 10000;
+  BasicCounterFactory factory;
+  Counter* counter = factory.GetCounter("packets");
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([counter] {
+      for (int j = 0; j < kIncrementsPerThread; ++j) {
+        counter->Increment();
+        counter->IncrementBy(2);
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(counter->Get(), 3 * kNumThreads * kIncrementsPerThread);
+}
+
+TEST(CountersToPrometheusTextTest, SanitizesNames) {
+  const std::map<std::string, int64_t> values = {{"Node-frames", 3},
+                                                 {"9lives", 9}};
+  EXPECT_EQ(CountersToPrometheusText(values, ""),
+            "# TYPE _lives counter\n_lives 9\n"
+            "# TYPE Node_frames counter\nNode_frames 3\n");
+  EXPECT_EQ(CountersToPrometheusText({{"a", 1}}),
+            "# TYPE mediapipe_a counter\nmediapipe_a 1\n");
+}
+
+}  // namespace
+}  // namespace mediapipe
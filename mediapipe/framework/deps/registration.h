@@ -16,6 +16,7 @@
 #define MEDIAPIPE_DEPS_REGISTRATION_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <string>
 #include <tuple>
@@ -23,6 +24,7 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "absl/base/macros.h"
 #include "absl/base/thread_annotations.h"
@@ -169,6 +171,11 @@ class NamespaceAllowlist {
   static const absl::flat_hash_set<std::string>& TopNamespaces();
 };
 
+// Registrations are only recorded by Register(), which mostly runs during
+// static initialization, and are validated and indexed on the first lookup.
+// This keeps the hundreds of calculator registrations of a binary off its
+// startup path. As a consequence, a duplicate or malformed name is reported
+// by the first lookup rather than at startup.
 template <typename R, typename... Args>
 class FunctionRegistry {
  public:
@@ -181,19 +188,14 @@ class FunctionRegistry {
 
   RegistrationToken Register(absl::string_view name, Function func)
       ABSL_LOCKS_EXCLUDED(lock_) {
-    std::string normalized_name = GetNormalizedName(name);
-    absl::WriterMutexLock lock(&lock_);
-    std::string adjusted_name = GetAdjustedName(normalized_name);
-    if (adjusted_name != normalized_name) {
-      functions_.insert(std::make_pair(adjusted_name, func));
-    }
-    if (functions_.insert(std::make_pair(normalized_name, std::move(func)))
-            .second) {
-      return RegistrationToken(
-          [this, normalized_name]() { Unregister(normalized_name); });
+    std::string registered_name(name);
+    {
+      absl::WriterMutexLock lock(&lock_);
+      pending_.emplace_back(registered_name, std::move(func));
+      has_pending_.store(true, std::memory_order_release);
     }
-    ABSL_LOG(FATAL) << "Function with name " << name << " already registered.";
-    return RegistrationToken([]() {});
+    return RegistrationToken(
+        [this, registered_name]() { Unregister(registered_name); });
   }
 
   // Force 'args' to be deduced by templating the function, instead of just
@@ -211,13 +213,16 @@ class FunctionRegistry {
                               int> = 0>
   ReturnType Invoke(absl::string_view name, Args2&&... args)
       ABSL_LOCKS_EXCLUDED(lock_) {
+    ApplyPendingRegistrations();
     Function function;
     {
       absl::ReaderMutexLock lock(&lock_);
       auto it = functions_.find(name);
       if (it == functions_.end()) {
-        return absl::NotFoundError(
-            absl::StrCat("No registered object with name: ", name));
+        return absl::NotFoundError(absl::StrCat(
+            "No registered object with name: ", name,
+            ". Check that the library registering it is linked into the "
+            "binary, e.g. with alwayslink = 1."));
       }
       function = it->second;
     }
@@ -236,6 +241,7 @@ class FunctionRegistry {
   // unregistered, though this will never happen with registrations made via
   // MEDIAPIPE_REGISTER_FACTORY_FUNCTION.
   bool IsRegistered(absl::string_view name) const ABSL_LOCKS_EXCLUDED(lock_) {
+    ApplyPendingRegistrations();
     absl::ReaderMutexLock lock(&lock_);
     return functions_.count(name) != 0;
   }
@@ -253,6 +259,7 @@ class FunctionRegistry {
   // MEDIAPIPE_REGISTER_FACTORY_FUNCTION.
   std::unordered_set<std::string> GetRegisteredNames() const
       ABSL_LOCKS_EXCLUDED(lock_) {
+    ApplyPendingRegistrations();
     absl::ReaderMutexLock lock(&lock_);
     std::unordered_set<std::string> names;
     std::for_each(functions_.cbegin(), functions_.cend(),
@@ -265,7 +272,7 @@ class FunctionRegistry {
   // Normalizes a C++ qualified name.  Validates the name qualification.
   // The name must be either unqualified or fully qualified with a leading "::".
   // The leading "::" in a fully qualified name is stripped.
-  std::string GetNormalizedName(absl::string_view name) {
+  static std::string GetNormalizedName(absl::string_view name) {
     using ::mediapipe::registration_internal::kCxxSep;
     std::vector<std::string> names = absl::StrSplit(name, kCxxSep);
     if (names[0].empty()) {
@@ -294,6 +301,7 @@ class FunctionRegistry {
       return cxx_name;
     }
     std::vector<std::string> spaces = absl::StrSplit(ns, kNameSep);
+    ApplyPendingRegistrations();
     absl::ReaderMutexLock lock(&lock_);
     while (!spaces.empty()) {
       std::string cxx_ns = absl::StrJoin(spaces, kCxxSep);
@@ -320,10 +328,42 @@ class FunctionRegistry {
 
  private:
   mutable absl::Mutex lock_;
-  absl::flat_hash_map<std::string, Function> functions_ ABSL_GUARDED_BY(lock_);
+  mutable absl::flat_hash_map<std::string, Function> functions_
+      ABSL_GUARDED_BY(lock_);
+  // The registrations not yet in functions_, in registration order.
+  mutable std::vector<std::pair<std::string, Function>> pending_
+      ABSL_GUARDED_BY(lock_);
+  // Whether pending_ is non-empty, checked by lookups without locking.
+  mutable std::atomic<bool> has_pending_{false};
+
+  // Moves the pending registrations into functions_.
+  void ApplyPendingRegistrations() const ABSL_LOCKS_EXCLUDED(lock_) {
+    if (!has_pending_.load(std::memory_order_acquire)) return;
+    absl::WriterMutexLock lock(&lock_);
+    functions_.reserve(functions_.size() + pending_.size());
+    for (auto& [name, func] : pending_) {
+      AddFunction(name, std::move(func));
+    }
+    pending_.clear();
+    has_pending_.store(false, std::memory_order_release);
+  }
+
+  void AddFunction(absl::string_view name, Function func) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    std::string normalized_name = GetNormalizedName(name);
+    std::string adjusted_name = GetAdjustedName(normalized_name);
+    if (adjusted_name != normalized_name) {
+      functions_.insert(std::make_pair(adjusted_name, func));
+    }
+    if (!functions_.insert(std::make_pair(normalized_name, std::move(func)))
+             .second) {
+      ABSL_LOG(FATAL) << "Function with name " << name
+                      << " already registered.";
+    }
+  }
 
   // For names included in NamespaceAllowlist, strips the namespace.
-  std::string GetAdjustedName(absl::string_view name) {
+  static std::string GetAdjustedName(absl::string_view name) {
     using ::mediapipe::registration_internal::kCxxSep;
     std::vector<std::string> names = absl::StrSplit(name, kCxxSep);
     std::string base_name = names.back();
@@ -335,7 +375,9 @@ class FunctionRegistry {
     return std::string(name);
   }
 
-  void Unregister(absl::string_view name) {
+  void Unregister(absl::string_view registered_name) {
+    ApplyPendingRegistrations();
+    std::string name = GetNormalizedName(registered_name);
     absl::WriterMutexLock lock(&lock_);
     std::string adjusted_name = GetAdjustedName(name);
     if (adjusted_name != name) {
@@ -0,0 +1,77 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/deps/registration.h"
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+using TestRegistry = FunctionRegistry<int, int>;
+
+TEST(FunctionRegistryTest, RegistersOnFirstLookup) {
+  TestRegistry registry;
+  RegistrationToken add_one =
+      registry.Register("::my_ns::AddOne", [](int x) { return x + 1; });
+  RegistrationToken add_two =
+      registry.Register("::mediapipe::AddTwo", [](int x) { return x + 2; });
+
+  EXPECT_TRUE(registry.IsRegistered("my_ns::AddOne"));
+  EXPECT_TRUE(registry.IsRegistered("my_ns.sub_ns", "AddOne"));
+  // Names in the mediapipe namespace can also be looked up unqualified.
+  EXPECT_TRUE(registry.IsRegistered("AddTwo"));
+  EXPECT_EQ(registry.Invoke("my_ns::AddOne", 1).value(), 2);
+  EXPECT_EQ(registry.Invoke("AddTwo", 1).value(), 3);
+  EXPECT_THAT(registry.GetRegisteredNames(),
+              testing::UnorderedElementsAre("my_ns::AddOne", "AddTwo",
+                                            "mediapipe::AddTwo"));
+
+  add_two.Unregister();
+  EXPECT_FALSE(registry.IsRegistered("AddTwo"));
+  EXPECT_FALSE(registry.IsRegistered("mediapipe::AddTwo"));
+  EXPECT_TRUE(registry.IsRegistered("my_ns::AddOne"));
+}
+
+TEST(FunctionRegistryTest, UnregistersBeforeFirstLookup) {
+  TestRegistry registry;
+  RegistrationToken token =
+      registry.Register("AddOne", [](int x) { return x + 1; });
+  token.Unregister();
+  EXPECT_FALSE(registry.IsRegistered("AddOne"));
+}
+
+TEST(FunctionRegistryTest, ReportsMissingNames) {
+  TestRegistry registry;
+  RegistrationToken token =
+      registry.Register("AddOne", [](int x) { return x + 1; });
+  absl::StatusOr<int> result = registry.Invoke("AddTwo", 1);
+  EXPECT_EQ(result.status().code(), absl::StatusCode::kNotFound);
+  EXPECT_THAT(result.status().message(),
+              testing::HasSubstr("No registered object with name: AddTwo"));
+}
+
+TEST(FunctionRegistryDeathTest, ReportsDuplicatesOnFirstLookup) {
+  TestRegistry registry;
+  RegistrationToken first =
+      registry.Register("AddOne", [](int x) { return x + 1; });
+  RegistrationToken second =
+      registry.Register("AddOne", [](int x) { return x + 1; });
+  EXPECT_DEATH(registry.IsRegistered("AddOne"), "already registered");
+}
+
+}  // namespace
+}  // namespace mediapipe
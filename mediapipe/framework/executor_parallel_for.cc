@@ -0,0 +1,126 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/executor_parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/function_ref.h"
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/executor.h"
+
+namespace mediapipe {
+
+namespace {
+
+// The parallelism left to the chunk running on this thread, or 0 outside of
+// ExecutorParallelFor.
+thread_local int chunk_parallelism = 0;
+
+// State shared by the calling thread and the helper tasks of one loop. Helper
+// tasks may start after the loop has returned, so they own it together with
+// the calling thread.
+struct LoopState {
+  LoopState(int begin, int end, int grain_size, int num_chunks,
+            int parallelism_per_chunk, absl::FunctionRef<void(int, int)> fn)
+      : begin(begin),
+        end(end),
+        grain_size(grain_size),
+        num_chunks(num_chunks),
+        parallelism_per_chunk(parallelism_per_chunk),
+        fn(fn) {}
+
+  const int begin;
+  const int end;
+  const int grain_size;
+  const int num_chunks;
+  const int parallelism_per_chunk;
+  // Only called after claiming a chunk, which is impossible once the loop
+  // has returned.
+  const absl::FunctionRef<void(int, int)> fn;
+
+  std::atomic<int> next_chunk{0};
+  absl::Mutex mutex;
+  int num_chunks_done ABSL_GUARDED_BY(mutex) = 0;
+};
+
+// Claims and runs chunks until none are left.
+void RunChunks(LoopState& loop) {
+  const int saved_parallelism = chunk_parallelism;
+  chunk_parallelism = loop.parallelism_per_chunk;
+  int num_chunks_done = 0;
+  for (int chunk = loop.next_chunk.fetch_add(1, std::memory_order_relaxed);
+       chunk < loop.num_chunks;
+       chunk = loop.next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+    const int chunk_begin = loop.begin + chunk * loop.grain_size;
+    loop.fn(chunk_begin, std::min(loop.end, chunk_begin + loop.grain_size));
+    ++num_chunks_done;
+  }
+  chunk_parallelism = saved_parallelism;
+  if (num_chunks_done > 0) {
+    absl::MutexLock lock(&loop.mutex);
+    loop.num_chunks_done += num_chunks_done;
+  }
+}
+
+bool AllChunksDone(LoopState* loop)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(loop->mutex) {
+  return loop->num_chunks_done == loop->num_chunks;
+}
+
+}  // namespace
+
+void ExecutorParallelFor(Executor* executor, int begin, int end,
+                         int grain_size, absl::FunctionRef<void(int, int)> fn,
+                         int max_parallelism) {
+  ABSL_CHECK_GT(grain_size, 0);
+  if (end <= begin) return;
+  const int num_chunks = (end - begin + grain_size - 1) / grain_size;
+
+  if (max_parallelism <= 0) {
+    max_parallelism =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  if (chunk_parallelism > 0) {
+    max_parallelism = std::min(max_parallelism, chunk_parallelism);
+  }
+  const int num_workers = std::min(num_chunks, max_parallelism);
+  if (executor == nullptr || num_workers <= 1) {
+    for (int chunk_begin = begin; chunk_begin < end;
+         chunk_begin += grain_size) {
+      fn(chunk_begin, std::min(end, chunk_begin + grain_size));
+    }
+    return;
+  }
+
+  auto loop = std::make_shared<LoopState>(
+      begin, end, grain_size, num_chunks,
+      std::max(1, max_parallelism / num_workers), fn);
+  for (int i = 1; i < num_workers; ++i) {
+    executor->Schedule([loop] { RunChunks(*loop); });
+  }
+  RunChunks(*loop);
+
+  // The remaining chunks have been claimed by helpers that are running them.
+  absl::MutexLock lock(&loop->mutex);
+  loop->mutex.Await(absl::Condition(&AllChunksDone, loop.get()));
+}
+
+}  // namespace mediapipe
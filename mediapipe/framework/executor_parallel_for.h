@@ -0,0 +1,44 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_EXECUTOR_PARALLEL_FOR_H_
+#define MEDIAPIPE_FRAMEWORK_EXECUTOR_PARALLEL_FOR_H_
+
+#include "absl/functional/function_ref.h"
+#include "mediapipe/framework/executor.h"
+
+namespace mediapipe {
+
+// Calls fn(chunk_begin, chunk_end) for the chunks [begin, begin + grain_size),
+// [begin + grain_size, begin + 2 * grain_size), ... covering [begin, end), and
+// returns when all calls have returned.
+//
+// Chunks are claimed one at a time by the calling thread and by up to
+// max_parallelism - 1 helper tasks scheduled on executor. The calling thread
+// never waits for a helper that has not started, so the loop makes progress
+// even when every thread of executor is busy, and nested loops cannot
+// deadlock. A loop called from inside a chunk of another loop only uses the
+// share of max_parallelism left to that chunk; once the outer loop occupies
+// all threads, the inner loops run on their calling threads.
+//
+// If executor is null, or max_parallelism is 1, all chunks run on the calling
+// thread in order. max_parallelism <= 0 means the number of hardware threads.
+void ExecutorParallelFor(Executor* executor, int begin, int end,
+                         int grain_size, absl::FunctionRef<void(int, int)> fn,
+                         int max_parallelism = 0);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_EXECUTOR_PARALLEL_FOR_H_
@@ -0,0 +1,81 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/executor_parallel_for.h"
+
+#include <atomic>
+#include <vector>
+
+#include "absl/synchronization/notification.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/thread_pool_executor.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(ExecutorParallelForTest, WithoutExecutorRunsChunksInOrder) {
+  std::vector<std::pair<int, int>> chunks;
+  ExecutorParallelFor(/*executor=*/nullptr, 3, 10, 3,
+                      [&chunks](int begin, int end) {
+                        chunks.emplace_back(begin, end);
+                      });
+  EXPECT_THAT(chunks, testing::ElementsAre(std::make_pair(3, 6),
+                                           std::make_pair(6, 9),
+                                           std::make_pair(9, 10)));
+}
+
+TEST(ExecutorParallelForTest, VisitsEveryIndexOnce) {
+  ThreadPoolExecutor executor(4);
+  std::vector<std::atomic<int>> visits(1000);
+  ExecutorParallelFor(&executor, 0, visits.size(), 7,
+                      [&visits](int begin, int end) {
+                        for (int i = begin; i < end; ++i) {
+                          visits[i].fetch_add(1);
+                        }
+                      });
+  for (const auto& count : visits) {
+    EXPECT_EQ(count.load(), 1);
+  }
+}
+
+TEST(ExecutorParallelForTest, CompletesWhileExecutorIsBlocked) {
+  ThreadPoolExecutor executor(1);
+  absl::Notification unblock;
+  executor.Schedule([&unblock] { unblock.WaitForNotification(); });
+  std::atomic<int> sum = 0;
+  ExecutorParallelFor(&executor, 0, 100, 1,
+                      [&sum](int begin, int end) { sum.fetch_add(begin); });
+  EXPECT_EQ(sum.load(), 4950);
+  unblock.Notify();
+}
+
+TEST(ExecutorParallelForTest, NestedLoopsCompleteOnOneThread) {
+  ThreadPoolExecutor executor(1);
+  std::atomic<int> count = 0;
+  executor.Schedule([&executor, &count] {
+    ExecutorParallelFor(&executor, 0, 8, 1, [&executor, &count](int, int) {
+      ExecutorParallelFor(&executor, 0, 8, 1,
+                          [&count](int, int) { count.fetch_add(1); });
+    });
+  });
+  absl::Notification done;
+  executor.Schedule([&done] { done.Notify(); });
+  done.WaitForNotification();
+  EXPECT_EQ(count.load(), 64);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,222 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_allocator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/port/aligned_malloc_and_free.h"
+#include "mediapipe/util/cpu_util.h"
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/mman.h>
+#define MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES 1
+#else
+#define MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES 0
+#endif
+
+namespace mediapipe {
+
+namespace {
+
+// The smallest page size of the supported platforms.
+constexpr size_t kMinPageSize = 4096;
+
+// Points to the allocator of the innermost ScopedCpuAllocator of the thread.
+thread_local const std::shared_ptr<CpuAllocator>* current_allocator = nullptr;
+
+void* AlignedMalloc(size_t size, size_t alignment) {
+  return aligned_malloc(size, std::max(alignment, sizeof(void*)));
+}
+
+size_t RoundUpToHugePage(size_t size) {
+  constexpr size_t kMask = HugePageCpuAllocator::kHugePageSize - 1;
+  return (size + kMask) & ~kMask;
+}
+
+#if MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+// Maps `size` bytes, a multiple of the huge page size, at an address aligned
+// to the huge page size, and advises the kernel to back them with
+// transparent huge pages.
+void* MapTransparentHugePages(size_t size) {
+  constexpr size_t kAlignment = HugePageCpuAllocator::kHugePageSize;
+  // Over-map by one huge page and unmap the unaligned head and tail.
+  const size_t mapped_size = size + kAlignment;
+  void* mapped = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) return nullptr;
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(mapped);
+  const uintptr_t aligned = (begin + kAlignment - 1) & ~(kAlignment - 1);
+  if (aligned > begin) {
+    munmap(mapped, aligned - begin);
+  }
+  const uintptr_t end = begin + mapped_size;
+  if (end > aligned + size) {
+    munmap(reinterpret_cast<void*>(aligned + size), end - aligned - size);
+  }
+  void* ptr = reinterpret_cast<void*>(aligned);
+  // Huge pages are an optimization; the mapping is usable without them.
+  madvise(ptr, size, MADV_HUGEPAGE);
+  return ptr;
+}
+#endif  // MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+
+class AlignedCpuAllocator : public CpuAllocator {
+ public:
+  void* Allocate(size_t size, size_t alignment) override {
+    return AlignedMalloc(size, alignment);
+  }
+  void Deallocate(void* ptr, size_t size) override { aligned_free(ptr); }
+};
+
+}  // namespace
+
+const std::shared_ptr<CpuAllocator>& CurrentCpuAllocator() {
+  static const std::shared_ptr<CpuAllocator>* const kNoAllocator =
+      new std::shared_ptr<CpuAllocator>();
+  return current_allocator ? *current_allocator : *kNoAllocator;
+}
+
+ScopedCpuAllocator::ScopedCpuAllocator(
+    const std::shared_ptr<CpuAllocator>& allocator)
+    : previous_(current_allocator) {
+  current_allocator = &allocator;
+}
+
+ScopedCpuAllocator::~ScopedCpuAllocator() { current_allocator = previous_; }
+
+HugePageCpuAllocator::HugePageCpuAllocator(Mode mode, size_t min_size)
+    : mode_(mode), min_size_(min_size) {
+  ABSL_CHECK_GT(min_size_, 0);
+}
+
+void* HugePageCpuAllocator::Allocate(size_t size, size_t alignment) {
+#if MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+  if (size >= min_size_) {
+    if (alignment > kHugePageSize) return nullptr;
+    const size_t mapped_size = RoundUpToHugePage(size);
+    if (mode_ == Mode::kHugeTlb) {
+      void* ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (ptr != MAP_FAILED) return ptr;
+    }
+    return MapTransparentHugePages(mapped_size);
+  }
+#endif  // MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+  return AlignedMalloc(size, alignment);
+}
+
+void HugePageCpuAllocator::Deallocate(void* ptr, size_t size) {
+#if MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+  if (size >= min_size_) {
+    munmap(ptr, RoundUpToHugePage(size));
+    return;
+  }
+#endif  // MEDIAPIPE_CPU_ALLOCATOR_HUGE_PAGES
+  aligned_free(ptr);
+}
+
+NumaLocalCpuAllocator::NumaLocalCpuAllocator(
+    std::shared_ptr<CpuAllocator> backing)
+    : backing_(std::move(backing)), multiple_nodes_(NumNumaNodes() > 1) {
+  ABSL_CHECK(backing_);
+}
+
+void* NumaLocalCpuAllocator::Allocate(size_t size, size_t alignment) {
+  void* ptr = backing_->Allocate(size, alignment);
+  if (ptr != nullptr && multiple_nodes_) {
+    volatile uint8_t* bytes = static_cast<uint8_t*>(ptr);
+    for (size_t offset = 0; offset < size; offset += kMinPageSize) {
+      bytes[offset] = 0;
+    }
+  }
+  return ptr;
+}
+
+void NumaLocalCpuAllocator::Deallocate(void* ptr, size_t size) {
+  backing_->Deallocate(ptr, size);
+}
+
+RecyclingCpuAllocator::RecyclingCpuAllocator(
+    std::shared_ptr<CpuAllocator> backing, size_t max_cached_bytes)
+    : backing_(std::move(backing)), max_cached_bytes_(max_cached_bytes) {
+  ABSL_CHECK(backing_);
+}
+
+RecyclingCpuAllocator::~RecyclingCpuAllocator() { Trim(); }
+
+void* RecyclingCpuAllocator::Allocate(size_t size, size_t alignment) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = free_lists_.find(size);
+    if (it != free_lists_.end()) {
+      std::vector<void*>& free_list = it->second;
+      // Prefer the most recently released buffer, which is likely cached.
+      for (auto ptr = free_list.rbegin(); ptr != free_list.rend(); ++ptr) {
+        if (reinterpret_cast<uintptr_t>(*ptr) % alignment == 0) {
+          void* result = *ptr;
+          free_list.erase(std::next(ptr).base());
+          cached_bytes_ -= size;
+          return result;
+        }
+      }
+    }
+  }
+  return backing_->Allocate(size, alignment);
+}
+
+void RecyclingCpuAllocator::Deallocate(void* ptr, size_t size) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (cached_bytes_ + size <= max_cached_bytes_) {
+      free_lists_[size].push_back(ptr);
+      cached_bytes_ += size;
+      return;
+    }
+  }
+  backing_->Deallocate(ptr, size);
+}
+
+void RecyclingCpuAllocator::Trim() {
+  absl::flat_hash_map<size_t, std::vector<void*>> free_lists;
+  {
+    absl::MutexLock lock(&mutex_);
+    free_lists = std::move(free_lists_);
+    free_lists_.clear();
+    cached_bytes_ = 0;
+  }
+  for (const auto& [size, free_list] : free_lists) {
+    for (void* ptr : free_list) {
+      backing_->Deallocate(ptr, size);
+    }
+  }
+}
+
+size_t RecyclingCpuAllocator::CachedBytes() const {
+  absl::MutexLock lock(&mutex_);
+  return cached_bytes_;
+}
+
+std::shared_ptr<CpuAllocator> MakeAlignedCpuAllocator() {
+  return std::make_shared<AlignedCpuAllocator>();
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,142 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+
+// Allocates the CPU storage of ImageFrame and Tensor. Implementations must be
+// thread-safe: buffers can be released on any thread.
+class CpuAllocator {
+ public:
+  virtual ~CpuAllocator() = default;
+
+  // Returns `size` bytes aligned to `alignment`, a power of two, or nullptr on
+  // failure.
+  virtual void* Allocate(size_t size, size_t alignment) = 0;
+
+  // Releases `ptr`, returned by Allocate() with the same `size`.
+  virtual void Deallocate(void* ptr, size_t size) = 0;
+};
+
+// Returns the allocator installed on the calling thread by ScopedCpuAllocator,
+// or null if ImageFrame and Tensor should use their default allocation.
+const std::shared_ptr<CpuAllocator>& CurrentCpuAllocator();
+
+// Installs `allocator` as the current allocator of the calling thread for the
+// lifetime of this object. A null `allocator` restores the default
+// allocation. `allocator` must outlive this object. CalculatorNode installs
+// the allocator set with kCpuAllocatorService around Open, Process and Close.
+class ScopedCpuAllocator {
+ public:
+  explicit ScopedCpuAllocator(const std::shared_ptr<CpuAllocator>& allocator);
+  ~ScopedCpuAllocator();
+
+  ScopedCpuAllocator(const ScopedCpuAllocator&) = delete;
+  ScopedCpuAllocator& operator=(const ScopedCpuAllocator&) = delete;
+
+ private:
+  const std::shared_ptr<CpuAllocator>* previous_;
+};
+
+// Backs allocations of at least `min_size` bytes with 2 MiB huge pages, which
+// reduces TLB misses when large images and tensors are traversed. Smaller
+// allocations use aligned_malloc. Huge pages are only used on Linux;
+// elsewhere all allocations use aligned_malloc.
+class HugePageCpuAllocator : public CpuAllocator {
+ public:
+  enum class Mode {
+    // Aligns allocations to huge pages and advises the kernel to back them
+    // with transparent huge pages (madvise MADV_HUGEPAGE). Requires THP to be
+    // enabled in "madvise" or "always" mode.
+    kTransparent,
+    // Maps allocations from the reserved huge page pool (mmap MAP_HUGETLB),
+    // falling back to kTransparent when the pool is exhausted.
+    kHugeTlb,
+  };
+
+  static constexpr size_t kHugePageSize = 2 << 20;
+
+  explicit HugePageCpuAllocator(Mode mode = Mode::kTransparent,
+                                size_t min_size = kHugePageSize / 2);
+
+  void* Allocate(size_t size, size_t alignment) override;
+  void Deallocate(void* ptr, size_t size) override;
+
+ private:
+  const Mode mode_;
+  const size_t min_size_;
+};
+
+// Touches every page of the buffers returned by `backing` on the allocating
+// thread, so that the kernel's first-touch policy places them on the NUMA
+// node running the calculator rather than on the node of the thread first
+// writing them. This is only effective for freshly mapped pages, e.g. from
+// HugePageCpuAllocator, and is a no-op on single-node machines.
+class NumaLocalCpuAllocator : public CpuAllocator {
+ public:
+  explicit NumaLocalCpuAllocator(std::shared_ptr<CpuAllocator> backing);
+
+  void* Allocate(size_t size, size_t alignment) override;
+  void Deallocate(void* ptr, size_t size) override;
+
+ private:
+  std::shared_ptr<CpuAllocator> backing_;
+  const bool multiple_nodes_;
+};
+
+// Keeps released buffers in free lists keyed by size and hands them out again
+// to allocations of the same size, which avoids mapping and faulting in pages
+// for every frame of a stream with constant dimensions. At most
+// `max_cached_bytes` are kept; further releases go to `backing`.
+class RecyclingCpuAllocator : public CpuAllocator {
+ public:
+  RecyclingCpuAllocator(std::shared_ptr<CpuAllocator> backing,
+                        size_t max_cached_bytes);
+  ~RecyclingCpuAllocator() override;
+
+  void* Allocate(size_t size, size_t alignment) override;
+  void Deallocate(void* ptr, size_t size) override;
+
+  // Releases all cached buffers to `backing`.
+  void Trim();
+
+  // Returns the number of bytes currently cached.
+  size_t CachedBytes() const;
+
+ private:
+  std::shared_ptr<CpuAllocator> backing_;
+  const size_t max_cached_bytes_;
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<size_t, std::vector<void*>> free_lists_
+      ABSL_GUARDED_BY(mutex_);
+  size_t cached_bytes_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Returns an allocator using aligned_malloc, for composing with
+// NumaLocalCpuAllocator and RecyclingCpuAllocator.
+std::shared_ptr<CpuAllocator> MakeAlignedCpuAllocator();
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_H_
@@ -0,0 +1,36 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_SERVICE_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_SERVICE_H_
+
+#include "mediapipe/framework/formats/cpu_allocator.h"
+#include "mediapipe/framework/graph_service.h"
+
+namespace mediapipe {
+
+// Graph-wide allocator of ImageFrame and Tensor CPU storage. When set, every
+// ImageFrame and Tensor CPU buffer allocated in the Open, Process or Close of
+// a node of the graph is allocated with it, e.g.
+//
+//   graph.SetServiceObject(
+//       kCpuAllocatorService,
+//       std::make_shared<RecyclingCpuAllocator>(
+//           std::make_shared<HugePageCpuAllocator>(), 256 << 20));
+inline constexpr GraphService<CpuAllocator> kCpuAllocatorService(
+    "CpuAllocatorService");
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_CPU_ALLOCATOR_SERVICE_H_
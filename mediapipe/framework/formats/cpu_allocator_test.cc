@@ -0,0 +1,166 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/cpu_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+// Counts the live allocations of an aligned allocator.
+class CountingCpuAllocator : public CpuAllocator {
+ public:
+  void* Allocate(size_t size, size_t alignment) override {
+    ++allocations_;
+    live_bytes_ += size;
+    return backing_->Allocate(size, alignment);
+  }
+  void Deallocate(void* ptr, size_t size) override {
+    ++deallocations_;
+    live_bytes_ -= size;
+    backing_->Deallocate(ptr, size);
+  }
+
+  int allocations_ = 0;
+  int deallocations_ = 0;
+  size_t live_bytes_ = 0;
+
+ private:
+  std::shared_ptr<CpuAllocator> backing_ = MakeAlignedCpuAllocator();
+};
+
+bool IsAligned(const void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(CpuAllocatorTest, ScopesNest) {
+  EXPECT_EQ(CurrentCpuAllocator(), nullptr);
+  std::shared_ptr<CpuAllocator> outer = MakeAlignedCpuAllocator();
+  std::shared_ptr<CpuAllocator> inner = MakeAlignedCpuAllocator();
+  {
+    ScopedCpuAllocator outer_scope(outer);
+    EXPECT_EQ(CurrentCpuAllocator(), outer);
+    {
+      ScopedCpuAllocator inner_scope(inner);
+      EXPECT_EQ(CurrentCpuAllocator(), inner);
+    }
+    EXPECT_EQ(CurrentCpuAllocator(), outer);
+  }
+  EXPECT_EQ(CurrentCpuAllocator(), nullptr);
+}
+
+TEST(CpuAllocatorTest, ImageFrameUsesCurrentAllocator) {
+  auto counting = std::make_shared<CountingCpuAllocator>();
+  std::shared_ptr<CpuAllocator> allocator = counting;
+  std::unique_ptr<ImageFrame> frame;
+  {
+    ScopedCpuAllocator scope(allocator);
+    frame = std::make_unique<ImageFrame>(ImageFormat::SRGB, 5, 4, 32);
+  }
+  EXPECT_EQ(counting->allocations_, 1);
+  EXPECT_EQ(frame->WidthStep(), 32);
+  EXPECT_EQ(counting->live_bytes_, 4 * 32);
+  EXPECT_TRUE(frame->IsAligned(32));
+  frame->SetToZero();
+  // The frame is released with its allocator outside of the scope.
+  frame.reset();
+  EXPECT_EQ(counting->deallocations_, 1);
+  EXPECT_EQ(counting->live_bytes_, 0);
+}
+
+TEST(CpuAllocatorTest, TensorUsesCurrentAllocator) {
+  auto counting = std::make_shared<CountingCpuAllocator>();
+  std::shared_ptr<CpuAllocator> allocator = counting;
+  Tensor tensor(Tensor::ElementType::kFloat32, Tensor::Shape{2, 3});
+  {
+    ScopedCpuAllocator scope(allocator);
+    auto view = tensor.GetCpuWriteView();
+    EXPECT_TRUE(IsAligned(view.buffer<float>(), alignof(std::max_align_t)));
+    view.buffer<float>()[5] = 1.0f;
+  }
+  EXPECT_EQ(counting->allocations_, 1);
+  Tensor moved = std::move(tensor);
+  EXPECT_EQ(moved.GetCpuReadView().buffer<float>()[5], 1.0f);
+  {
+    Tensor released = std::move(moved);
+  }
+  EXPECT_EQ(counting->deallocations_, 1);
+  EXPECT_EQ(counting->live_bytes_, 0);
+}
+
+TEST(CpuAllocatorTest, HugePageAllocatorAlignsLargeBuffers) {
+  for (auto mode : {HugePageCpuAllocator::Mode::kTransparent,
+                    HugePageCpuAllocator::Mode::kHugeTlb}) {
+    HugePageCpuAllocator allocator(mode);
+    const size_t large_size = 3 * HugePageCpuAllocator::kHugePageSize + 5;
+    auto* large = static_cast<uint8_t*>(allocator.Allocate(large_size, 64));
+    ASSERT_NE(large, nullptr);
+    EXPECT_TRUE(IsAligned(large, 64));
+    large[0] = 1;
+    large[large_size - 1] = 2;
+    auto* small = static_cast<uint8_t*>(allocator.Allocate(100, 64));
+    ASSERT_NE(small, nullptr);
+    EXPECT_TRUE(IsAligned(small, 64));
+    small[99] = 3;
+    allocator.Deallocate(small, 100);
+    allocator.Deallocate(large, large_size);
+  }
+}
+
+TEST(CpuAllocatorTest, NumaLocalAllocatorForwardsToBacking) {
+  auto counting = std::make_shared<CountingCpuAllocator>();
+  NumaLocalCpuAllocator allocator(counting);
+  void* ptr = allocator.Allocate(10000, 16);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(counting->live_bytes_, 10000);
+  allocator.Deallocate(ptr, 10000);
+  EXPECT_EQ(counting->live_bytes_, 0);
+}
+
+TEST(CpuAllocatorTest, RecyclingAllocatorReusesBuffers) {
+  auto counting = std::make_shared<CountingCpuAllocator>();
+  {
+    RecyclingCpuAllocator allocator(counting, /*max_cached_bytes=*/1000);
+    void* first = allocator.Allocate(600, 16);
+    void* second = allocator.Allocate(600, 16);
+    allocator.Deallocate(first, 600);
+    // Exceeds max_cached_bytes.
+    allocator.Deallocate(second, 600);
+    EXPECT_EQ(allocator.CachedBytes(), 600);
+    EXPECT_EQ(counting->deallocations_, 1);
+
+    EXPECT_EQ(allocator.Allocate(600, 16), first);
+    EXPECT_EQ(allocator.CachedBytes(), 0);
+    EXPECT_EQ(counting->allocations_, 2);
+    // A different size isn't served from the cache.
+    void* third = allocator.Allocate(300, 16);
+    EXPECT_EQ(counting->allocations_, 3);
+    allocator.Deallocate(third, 300);
+    allocator.Deallocate(first, 600);
+    EXPECT_EQ(allocator.CachedBytes(), 900);
+  }
+  // The destructor releases the cached buffers.
+  EXPECT_EQ(counting->live_bytes_, 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
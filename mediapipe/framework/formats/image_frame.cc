@@ -21,12 +21,15 @@
 #include <string.h>
 
 #include <algorithm>
+#include <memory>
 #include <utility>
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/strings/str_cat.h"
+#include "mediapipe/framework/formats/cpu_allocator.h"
 #include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/packet_size.h"
 #include "mediapipe/framework/port/aligned_malloc_and_free.h"
 #include "mediapipe/framework/port/proto_ns.h"
 
@@ -86,14 +89,48 @@ ImageFrame& ImageFrame::operator=(ImageFrame&& move_from) {
   width_ = move_from.width_;
   height_ = move_from.height_;
   width_step_ = move_from.width_step_;
+  is_view_ = move_from.is_view_;
 
   move_from.format_ = ImageFormat::UNKNOWN;
   move_from.width_ = 0;
   move_from.height_ = 0;
   move_from.width_step_ = 0;
+  move_from.is_view_ = false;
   return *this;
 }
 
+std::unique_ptr<ImageFrame> ImageFrame::CreateView(
+    std::shared_ptr<const ImageFrame> source, int x, int y, int width,
+    int height) {
+  ABSL_CHECK(source != nullptr);
+  ABSL_CHECK(!source->IsEmpty());
+  ABSL_CHECK_GE(x, 0);
+  ABSL_CHECK_GE(y, 0);
+  ABSL_CHECK_GT(width, 0);
+  ABSL_CHECK_GT(height, 0);
+  ABSL_CHECK_LE(x + width, source->Width());
+  ABSL_CHECK_LE(y + height, source->Height());
+
+  const int pixel_size = source->NumberOfChannels() * source->ChannelSize();
+  uint8_t* pixel_data = const_cast<uint8_t*>(source->PixelData()) +
+                        y * source->WidthStep() + x * pixel_size;
+  const ImageFormat::Format format = source->Format();
+  const int width_step = source->WidthStep();
+  // The deleter holds the reference to source.
+  auto view = std::make_unique<ImageFrame>(
+      format, width, height, width_step, pixel_data,
+      [source = std::move(source)](uint8_t*) {});
+  view->is_view_ = true;
+  return view;
+}
+
+void ImageFrame::CopyViewPixelData() {
+  ImageFrame copy(format_, width_, height_, kDefaultAlignmentBoundary);
+  copy.InternalCopyFrom(width_, height_, width_step_, ChannelSize(),
+                        pixel_data_.get());
+  *this = std::move(copy);
+}
+
 void ImageFrame::Reset(ImageFormat::Format format, int width, int height,
                        uint32_t alignment_boundary) {
   format_ = format;
@@ -101,8 +138,18 @@ void ImageFrame::Reset(ImageFormat::Format format, int width, int height,
   height_ = height;
   ABSL_CHECK_NE(ImageFormat::UNKNOWN, format_);
   ABSL_CHECK(IsValidAlignmentNumber(alignment_boundary));
+  is_view_ = false;
   width_step_ = width * NumberOfChannels() * ChannelSize();
-  if (alignment_boundary == 1) {
+  if (const std::shared_ptr<CpuAllocator>& allocator = CurrentCpuAllocator()) {
+    width_step_ = ((width_step_ - 1) | (alignment_boundary - 1)) + 1;
+    const size_t size = static_cast<size_t>(height) * width_step_;
+    auto* pixel_data = static_cast<uint8_t*>(
+        allocator->Allocate(size, alignment_boundary));
+    ABSL_CHECK(pixel_data) << "Failed to allocate " << size << " bytes.";
+    pixel_data_ = {pixel_data, [allocator, size](uint8_t* ptr) {
+                     allocator->Deallocate(ptr, size);
+                   }};
+  } else if (alignment_boundary == 1) {
     pixel_data_ = {new uint8_t[height * width_step_],
                    PixelDataDeleter::kArrayDelete};
   } else {
@@ -129,9 +176,11 @@ void ImageFrame::AdoptPixelData(ImageFormat::Format format, int width,
   ABSL_CHECK_GE(width_step_, width * NumberOfChannels() * ChannelSize());
 
   pixel_data_ = {pixel_data, deleter};
+  is_view_ = false;
 }
 
 std::unique_ptr<uint8_t[], ImageFrame::Deleter> ImageFrame::Release() {
+  is_view_ = false;
   return std::move(pixel_data_);
 }
 
@@ -179,6 +228,7 @@ void ImageFrame::InternalCopyToBuffer(int width_step, char* buffer) const {
 }
 
 void ImageFrame::SetToZero() {
+  if (is_view_) CopyViewPixelData();
   if (pixel_data_) {
     std::fill_n(pixel_data_.get(), width_step_ * height_, 0);
   }
@@ -188,6 +238,7 @@ void ImageFrame::SetAlignmentPaddingAreas() {
   if (!pixel_data_) {
     return;
   }
+  if (is_view_) CopyViewPixelData();
   ABSL_CHECK_GE(width_, 1);
   ABSL_CHECK_GE(height_, 1);
 
@@ -401,4 +452,9 @@ void ImageFrame::CopyToBuffer(float* buffer, int buffer_size) const {
                          reinterpret_cast<char*>(buffer));
   }
 }
+
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(ImageFrame, [](const ImageFrame& frame) {
+  return sizeof(frame) + frame.PixelDataSize();
+});
+
 }  // namespace mediapipe
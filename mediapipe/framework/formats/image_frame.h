@@ -122,6 +122,23 @@ class ImageFrame {
   ImageFrame(ImageFrame&& move_from);
   ImageFrame& operator=(ImageFrame&& move_from);
 
+  // Creates a frame that shows the region of source with top-left corner
+  // (x, y) and the given width and height, without copying any pixels. The
+  // view keeps source alive and uses its WidthStep(). The region must lie
+  // within source.
+  //
+  // The view is copy-on-write: the first call to MutablePixelData() (or any
+  // other method that writes pixels) copies the region into a buffer owned by
+  // the view, so writes never reach source. Read through PixelData() to keep
+  // sharing.
+  static std::unique_ptr<ImageFrame> CreateView(
+      std::shared_ptr<const ImageFrame> source, int x, int y, int width,
+      int height);
+
+  // Returns true if the pixel data is shared with another frame, i.e. the
+  // frame was created by CreateView() and has not been written to since.
+  bool IsView() const { return is_view_; }
+
   // Returns true if the ImageFrame is unallocated.
   bool IsEmpty() const { return pixel_data_ == nullptr; }
 
@@ -171,8 +188,12 @@ class ImageFrame {
   void CopyFrom(const ImageFrame& image_frame, uint32_t alignment_boundary);
 
   // Get a mutable pointer to the underlying image data.  The ImageFrame
-  // retains ownership.
-  uint8_t* MutablePixelData() { return pixel_data_.get(); }
+  // retains ownership.  Copies the pixel data first if the frame is a view
+  // (see CreateView()).
+  uint8_t* MutablePixelData() {
+    if (is_view_) CopyViewPixelData();
+    return pixel_data_.get();
+  }
   // Get a const pointer to the underlying image data.
   const uint8_t* PixelData() const { return pixel_data_.get(); }
 
@@ -211,7 +232,8 @@ class ImageFrame {
              uint32_t alignment_boundary);
 
   // Relinquishes ownership of the pixel data.  Notice that the unique_ptr
-  // uses a non-standard deleter.
+  // uses a non-standard deleter.  The pixel data of a view must not be
+  // modified.
   std::unique_ptr<uint8_t[], Deleter> Release();
 
   // Copy the 8-bit ImageFrame into a contiguous, pre-allocated buffer. Note
@@ -241,6 +263,9 @@ class ImageFrame {
   void InternalCopyFrom(int width, int height, int width_step, int channel_size,
                         const uint8_t* pixel_data);
 
+  // Replaces the shared pixel data of a view with an owned copy.
+  void CopyViewPixelData();
+
   // The internal implementation of copying data to the provided buffer.
   // If width_step is 0, then calculates width_step assuming no padding.
   void InternalCopyToBuffer(int width_step, char* buffer) const;
@@ -251,6 +276,9 @@ class ImageFrame {
   int width_step_;
 
   std::unique_ptr<uint8_t[], Deleter> pixel_data_;
+
+  // See IsView().
+  bool is_view_ = false;
 };
 
 }  // namespace mediapipe
@@ -92,5 +92,10 @@ cv::Mat MatView(const ImageFrame* image) {
                  steps);
 }
 
+cv::Mat MatView(ImageFrame* image) {
+  if (image->IsView()) image->MutablePixelData();
+  return MatView(static_cast<const ImageFrame*>(image));
+}
+
 }  // namespace formats
 }  // namespace mediapipe
@@ -30,6 +30,11 @@ namespace formats {
 // even though the returned data is mutable.
 cv::Mat MatView(const ImageFrame* image);
 
+// Same as above for a mutable ImageFrame. If image is a view (see
+// ImageFrame::CreateView()), its pixels are copied first, so that writes to
+// the returned cv::Mat do not reach the frame it shares them with.
+cv::Mat MatView(ImageFrame* image);
+
 }  // namespace formats
 }  // namespace mediapipe
 
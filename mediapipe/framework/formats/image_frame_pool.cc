@@ -14,74 +14,207 @@
 
 #include "mediapipe/framework/formats/image_frame_pool.h"
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/util/cpu_util.h"
 
 namespace mediapipe {
 
+std::shared_ptr<ImageFramePool> ImageFramePool::Create(
+    int width, int height, ImageFormat::Format format,
+    const ImageFramePoolOptions& options) {
+  std::shared_ptr<ImageFramePool> pool(
+      new ImageFramePool(width, height, format, options));
+  if (options.prewarm_count > 0) {
+    const int numa_node =
+        pool->num_numa_nodes_ > 1
+            ? std::min(CurrentNumaNode(), pool->num_numa_nodes_ - 1)
+            : 0;
+    const absl::Time now = pool->clock_->TimeNow();
+    absl::MutexLock lock(&pool->mutex_);
+    for (int i = 0; i < options.prewarm_count; ++i) {
+      pool->available_[numa_node].push_back({pool->NewBuffer(), now});
+    }
+    pool->stats_.allocated += options.prewarm_count;
+  }
+  return pool;
+}
+
 ImageFramePool::ImageFramePool(int width, int height,
-                               ImageFormat::Format format, int keep_count)
+                               ImageFormat::Format format,
+                               const ImageFramePoolOptions& options)
     : width_(width),
       height_(height),
       format_(format),
-      keep_count_(keep_count) {}
+      options_(options),
+      min_count_(std::max(options.keep_count, options.prewarm_count)),
+      clock_(options.clock ? options.clock : Clock::RealClock()),
+      num_numa_nodes_(NumNumaNodes()),
+      available_(num_numa_nodes_),
+      window_start_(clock_->TimeNow()) {}
+
+std::unique_ptr<ImageFrame> ImageFramePool::NewBuffer() const {
+  // Fix alignment at 4 for best compatability with OpenGL.
+  auto buffer = std::make_unique<ImageFrame>(
+      format_, width_, height_, ImageFrame::kGlDefaultAlignmentBoundary);
+  if (num_numa_nodes_ > 1) {
+    // Touch the pixels on this thread, so that their pages are allocated on
+    // this thread's NUMA node rather than where they are first written.
+    buffer->SetToZero();
+  }
+  return buffer;
+}
 
 ImageFrameSharedPtr ImageFramePool::GetBuffer() {
+  const int numa_node =
+      num_numa_nodes_ > 1 ? std::min(CurrentNumaNode(), num_numa_nodes_ - 1)
+                          : 0;
   std::unique_ptr<ImageFrame> buffer;
+  std::vector<std::unique_ptr<ImageFrame>> trimmed;
 
   {
     absl::MutexLock lock(&mutex_);
-    if (available_.empty()) {
-      // Fix alignment at 4 for best compatability with OpenGL.
-      buffer = std::make_unique<ImageFrame>(
-          format_, width_, height_, ImageFrame::kGlDefaultAlignmentBoundary);
-      if (!buffer) return nullptr;
+    auto& available = available_[numa_node];
+    if (!available.empty()) {
+      buffer = std::move(available.back().frame);
+      available.pop_back();
+      ++stats_.reused;
     } else {
-      buffer = std::move(available_.back());
-      available_.pop_back();
+      ++stats_.allocated;
     }
 
     ++in_use_count_;
+    ++stats_.requests;
+    stats_.peak_in_use = std::max(stats_.peak_in_use, in_use_count_);
+    if (IsTimed()) {
+      const absl::Time now = clock_->TimeNow();
+      UpdateSteadyState(now);
+      TrimIdle(now, &trimmed);
+    }
+  }
+  // The trimmed buffers are released without holding the lock.
+  trimmed.clear();
+
+  if (!buffer) {
+    buffer = NewBuffer();
   }
 
   // Return a shared_ptr with a custom deleter that adds the buffer back
   // to our available list.
   std::weak_ptr<ImageFramePool> weak_pool(shared_from_this());
   return std::shared_ptr<ImageFrame>(buffer.release(),
-                                     [weak_pool](ImageFrame* buf) {
+                                     [weak_pool, numa_node](ImageFrame* buf) {
                                        auto pool = weak_pool.lock();
                                        if (pool) {
-                                         pool->Return(buf);
+                                         pool->Return(buf, numa_node);
                                        } else {
                                          delete buf;
                                        }
                                      });
 }
 
+void ImageFramePool::ReleaseIdleBuffers() {
+  std::vector<std::unique_ptr<ImageFrame>> trimmed;
+  {
+    absl::MutexLock lock(&mutex_);
+    const absl::Time now = clock_->TimeNow();
+    UpdateSteadyState(now);
+    TrimIdle(now, &trimmed);
+  }
+}
+
+ImageFramePoolStats ImageFramePool::GetStats() {
+  absl::MutexLock lock(&mutex_);
+  ImageFramePoolStats stats = stats_;
+  stats.in_use = in_use_count_;
+  stats.available = AvailableCount();
+  stats.steady_state_in_use = std::max(current_peak_, previous_peak_);
+  return stats;
+}
+
 std::pair<int, int> ImageFramePool::GetInUseAndAvailableCounts() {
   absl::MutexLock lock(&mutex_);
-  return {in_use_count_, available_.size()};
+  return {in_use_count_, AvailableCount()};
 }
 
-void ImageFramePool::Return(ImageFrame* buf) {
+void ImageFramePool::Return(ImageFrame* buf, int numa_node) {
   std::vector<std::unique_ptr<ImageFrame>> trimmed;
   {
     absl::MutexLock lock(&mutex_);
     --in_use_count_;
-    available_.emplace_back(buf);
-    TrimAvailable(&trimmed);
+    const absl::Time now =
+        IsTimed() ? clock_->TimeNow() : absl::InfinitePast();
+    available_[numa_node].push_back({std::unique_ptr<ImageFrame>(buf), now});
+    if (IsTimed()) {
+      UpdateSteadyState(now);
+      TrimIdle(now, &trimmed);
+    }
+    TrimAvailable(numa_node, &trimmed);
   }
   // The trimmed buffers will be released without holding the lock.
 }
 
+void ImageFramePool::UpdateSteadyState(absl::Time now) {
+  if (options_.steady_state_window <= absl::ZeroDuration()) return;
+  const absl::Duration elapsed = now - window_start_;
+  if (elapsed >= options_.steady_state_window / 2) {
+    // Nothing happened during the previous half if a whole window elapsed.
+    previous_peak_ = elapsed >= options_.steady_state_window ? in_use_count_
+                                                             : current_peak_;
+    current_peak_ = in_use_count_;
+    window_start_ = now;
+  }
+  current_peak_ = std::max(current_peak_, in_use_count_);
+}
+
+int ImageFramePool::TargetCount() const {
+  return std::max({min_count_, current_peak_, previous_peak_});
+}
+
+int ImageFramePool::AvailableCount() const {
+  int available_count = 0;
+  for (const auto& available : available_) {
+    available_count += available.size();
+  }
+  return available_count;
+}
+
 void ImageFramePool::TrimAvailable(
-    std::vector<std::unique_ptr<ImageFrame>>* trimmed) {
-  int keep = std::max(keep_count_ - in_use_count_, 0);
-  if (available_.size() > keep) {
-    auto trim_it = std::next(available_.begin(), keep);
-    if (trimmed) {
-      std::move(trim_it, available_.end(), std::back_inserter(*trimmed));
+    int numa_node, std::vector<std::unique_ptr<ImageFrame>>* trimmed) {
+  int surplus = AvailableCount() - std::max(TargetCount() - in_use_count_, 0);
+  for (int i = 1; i <= num_numa_nodes_ && surplus > 0; ++i) {
+    // Visit numa_node last.
+    auto& available = available_[(numa_node + i) % num_numa_nodes_];
+    int trim_count = std::min<int>(surplus, available.size());
+    for (auto it = std::prev(available.end(), trim_count);
+         it != available.end(); ++it) {
+      if (trimmed) trimmed->push_back(std::move(it->frame));
+    }
+    available.erase(std::prev(available.end(), trim_count), available.end());
+    surplus -= trim_count;
+    stats_.released += trim_count;
+  }
+}
+
+void ImageFramePool::TrimIdle(
+    absl::Time now, std::vector<std::unique_ptr<ImageFrame>>* trimmed) {
+  if (options_.max_idle_duration == absl::InfiniteDuration()) return;
+  const absl::Time idle_before = now - options_.max_idle_duration;
+  for (auto& available : available_) {
+    // The least recently returned buffers come first.
+    auto it = available.begin();
+    for (; it != available.end() && it->returned_time < idle_before; ++it) {
+      if (trimmed) trimmed->push_back(std::move(it->frame));
+      ++stats_.released;
     }
-    available_.erase(trim_it, available_.end());
+    available.erase(available.begin(), it);
   }
 }
 
@@ -18,16 +18,63 @@
 #ifndef MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_FRAME_POOL_H_
 #define MEDIAPIPE_FRAMEWORK_FORMATS_IMAGE_FRAME_POOL_H_
 
+#include <cstdint>
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/formats/image_frame.h"
 
 namespace mediapipe {
 
 using ImageFrameSharedPtr = std::shared_ptr<ImageFrame>;
 
+// How many buffers an ImageFramePool keeps for reuse.
+struct ImageFramePoolOptions {
+  // Keep this many buffers allocated, in use or available.
+  int keep_count = 2;
+
+  // If positive, also keep as many buffers as were in use at once during
+  // about the last steady_state_window (a moving high-water mark). Streams
+  // holding more than keep_count frames at a time then reuse their buffers
+  // instead of allocating new ones, while the buffers allocated for a burst
+  // are released once the burst falls out of the window.
+  absl::Duration steady_state_window = absl::ZeroDuration();
+
+  // Available buffers unused for longer than this are released, even below
+  // keep_count, so that pools which are no longer used release their memory.
+  absl::Duration max_idle_duration = absl::InfiniteDuration();
+
+  // Allocate this many buffers when the pool is created, e.g. the number of
+  // frames expected in flight, so that the first frames don't pay for the
+  // allocations. The pool keeps at least max(keep_count, prewarm_count)
+  // buffers.
+  int prewarm_count = 0;
+
+  // The clock measuring the durations above. Defaults to the real clock.
+  Clock* clock = nullptr;
+};
+
+// Counters describing how well an ImageFramePool reuses its buffers.
+struct ImageFramePoolStats {
+  // Number of buffers requested, and how many of them were reused.
+  int64_t requests = 0;
+  int64_t reused = 0;
+  // Number of buffers allocated, and released by the pool.
+  int64_t allocated = 0;
+  int64_t released = 0;
+  // Number of buffers currently in use and available.
+  int in_use = 0;
+  int available = 0;
+  // The highest number of buffers in use at once, ever and within the steady
+  // state window.
+  int peak_in_use = 0;
+  int steady_state_in_use = 0;
+};
+
 class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
  public:
   // Creates a pool. This pool will manage buffers of the specified dimensions,
@@ -37,40 +84,100 @@ class ImageFramePool : public std::enable_shared_from_this<ImageFramePool> {
   static std::shared_ptr<ImageFramePool> Create(int width, int height,
                                                 ImageFormat::Format format,
                                                 int keep_count) {
-    return std::shared_ptr<ImageFramePool>(
-        new ImageFramePool(width, height, format, keep_count));
+    ImageFramePoolOptions options;
+    options.keep_count = keep_count;
+    return Create(width, height, format, options);
   }
 
+  // Creates a pool keeping buffers as configured by `options`.
+  static std::shared_ptr<ImageFramePool> Create(
+      int width, int height, ImageFormat::Format format,
+      const ImageFramePoolOptions& options);
+
   // Obtains a buffers. May either be reused or created anew.
+  // On a machine with several NUMA nodes, buffers are kept per NUMA node: a
+  // buffer is only reused on the NUMA node of the thread that created it, and
+  // a new buffer is first touched by the calling thread, so that its memory
+  // is allocated on the caller's NUMA node.
   ImageFrameSharedPtr GetBuffer();
 
+  // Releases the available buffers idle for longer than max_idle_duration.
+  // This also happens whenever a buffer is obtained or returned, so it only
+  // needs to be called for pools that may stop being used.
+  void ReleaseIdleBuffers();
+
   int width() const { return width_; }
   int height() const { return height_; }
   ImageFormat::Format format() const { return format_; }
 
+  ImageFramePoolStats GetStats();
+
   // This method is meant for testing.
   std::pair<int, int> GetInUseAndAvailableCounts();
 
  private:
+  // A buffer which is not in use, and when it was returned.
+  struct AvailableBuffer {
+    std::unique_ptr<ImageFrame> frame;
+    absl::Time returned_time;
+  };
+
   ImageFramePool(int width, int height, ImageFormat::Format format,
-                 int keep_count);
+                 const ImageFramePoolOptions& options);
 
-  // Return a buffer to the pool.
-  void Return(ImageFrame* buf);
+  // Allocates a buffer on the calling thread.
+  std::unique_ptr<ImageFrame> NewBuffer() const;
+
+  // Return a buffer created on numa_node to the pool.
+  void Return(ImageFrame* buf, int numa_node);
+
+  // Whether the pool's retention depends on time.
+  bool IsTimed() const {
+    return options_.steady_state_window > absl::ZeroDuration() ||
+           options_.max_idle_duration != absl::InfiniteDuration();
+  }
+
+  // Moves the steady state window to `now` and accounts for the current
+  // number of buffers in use.
+  void UpdateSteadyState(absl::Time now) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // The number of buffers to keep, in use or available.
+  int TargetCount() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  int AvailableCount() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // If the total number of buffers is greater than the target count, destroys
+  // any surplus buffers that are no longer in use, starting with the buffers
+  // of other NUMA nodes than numa_node.
+  void TrimAvailable(int numa_node,
+                     std::vector<std::unique_ptr<ImageFrame>>* trimmed)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // If the total number of buffers is greater than keep_count, destroys any
-  // surplus buffers that are no longer in use.
-  void TrimAvailable(std::vector<std::unique_ptr<ImageFrame>>* trimmed)
+  // Destroys the buffers available since before now - max_idle_duration.
+  void TrimIdle(absl::Time now,
+                std::vector<std::unique_ptr<ImageFrame>>* trimmed)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   const int width_;
   const int height_;
   const ImageFormat::Format format_;
-  const int keep_count_;
+  const ImageFramePoolOptions options_;
+  // The minimum number of buffers to keep.
+  const int min_count_;
+  Clock* const clock_;
+  const int num_numa_nodes_;
 
   absl::Mutex mutex_;
   int in_use_count_ ABSL_GUARDED_BY(mutex_) = 0;
-  std::vector<std::unique_ptr<ImageFrame>> available_ ABSL_GUARDED_BY(mutex_);
+  // The available buffers, indexed by the NUMA node they were created on,
+  // least recently returned first.
+  std::vector<std::vector<AvailableBuffer>> available_ ABSL_GUARDED_BY(mutex_);
+  // The steady state window is tracked as two halves: the highest in-use
+  // counts since window_start_ and during the half before it.
+  absl::Time window_start_ ABSL_GUARDED_BY(mutex_);
+  int current_peak_ ABSL_GUARDED_BY(mutex_) = 0;
+  int previous_peak_ ABSL_GUARDED_BY(mutex_) = 0;
+  ImageFramePoolStats stats_ ABSL_GUARDED_BY(mutex_);
 };
 
 }  // namespace mediapipe
@@ -15,6 +15,8 @@
 #include "mediapipe/framework/formats/image_frame_pool.h"
 
 #include "absl/memory/memory.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/status.h"
@@ -99,5 +101,93 @@ TEST(ImageFrameBufferPoolStaticTest, BufferCanOutlivePool) {
   buffer = nullptr;
 }
 
+// A clock which only advances when told to.
+class FakeClock : public Clock {
+ public:
+  absl::Time TimeNow() override { return now_; }
+  void Sleep(absl::Duration d) override { now_ += d; }
+  void SleepUntil(absl::Time wakeup_time) override {
+    now_ = std::max(now_, wakeup_time);
+  }
+
+ private:
+  absl::Time now_ = absl::UnixEpoch();
+};
+
+TEST(ImageFramePoolOptionsTest, PrewarmsBuffers) {
+  ImageFramePoolOptions options;
+  options.keep_count = 1;
+  options.prewarm_count = 3;
+  auto pool = ImageFramePool::Create(kWidth, kHeight, kFormat, options);
+  EXPECT_EQ(Pair(0, 3), pool->GetInUseAndAvailableCounts());
+
+  std::vector<ImageFrameSharedPtr> buffers;
+  for (int i = 0; i < 3; ++i) {
+    buffers.emplace_back(pool->GetBuffer());
+  }
+  buffers.clear();
+  // The prewarmed buffers are kept.
+  EXPECT_EQ(Pair(0, 3), pool->GetInUseAndAvailableCounts());
+  const ImageFramePoolStats stats = pool->GetStats();
+  EXPECT_EQ(stats.requests, 3);
+  EXPECT_EQ(stats.reused, 3);
+  EXPECT_EQ(stats.allocated, 3);
+}
+
+TEST(ImageFramePoolOptionsTest, KeepsSteadyStateBuffers) {
+  FakeClock clock;
+  ImageFramePoolOptions options;
+  options.keep_count = 1;
+  options.steady_state_window = absl::Seconds(2);
+  options.clock = &clock;
+  auto pool = ImageFramePool::Create(kWidth, kHeight, kFormat, options);
+
+  // Three buffers in flight at a time.
+  std::vector<ImageFrameSharedPtr> buffers;
+  for (int i = 0; i < 3; ++i) {
+    buffers.emplace_back(pool->GetBuffer());
+  }
+  for (int frame = 0; frame < 10; ++frame) {
+    clock.Sleep(absl::Milliseconds(100));
+    buffers.erase(buffers.begin());
+    buffers.emplace_back(pool->GetBuffer());
+  }
+  EXPECT_EQ(pool->GetStats().allocated, 3);
+  EXPECT_EQ(pool->GetStats().steady_state_in_use, 3);
+
+  // Once demand drops, the surplus buffers are released after the window.
+  buffers.resize(1);
+  EXPECT_EQ(Pair(1, 2), pool->GetInUseAndAvailableCounts());
+  clock.Sleep(absl::Seconds(3));
+  buffers.clear();
+  EXPECT_EQ(Pair(0, 1), pool->GetInUseAndAvailableCounts());
+  EXPECT_EQ(pool->GetStats().released, 2);
+}
+
+TEST(ImageFramePoolOptionsTest, ReleasesIdleBuffers) {
+  FakeClock clock;
+  ImageFramePoolOptions options;
+  options.keep_count = 4;
+  options.max_idle_duration = absl::Seconds(1);
+  options.clock = &clock;
+  auto pool = ImageFramePool::Create(kWidth, kHeight, kFormat, options);
+
+  std::vector<ImageFrameSharedPtr> buffers;
+  for (int i = 0; i < 3; ++i) {
+    buffers.emplace_back(pool->GetBuffer());
+  }
+  buffers.clear();
+  EXPECT_EQ(Pair(0, 3), pool->GetInUseAndAvailableCounts());
+
+  clock.Sleep(absl::Milliseconds(500));
+  pool->ReleaseIdleBuffers();
+  EXPECT_EQ(Pair(0, 3), pool->GetInUseAndAvailableCounts());
+  // A reused buffer is no longer idle.
+  pool->GetBuffer();
+  clock.Sleep(absl::Milliseconds(600));
+  pool->ReleaseIdleBuffers();
+  EXPECT_EQ(Pair(0, 1), pool->GetInUseAndAvailableCounts());
+}
+
 }  // anonymous namespace
 }  // namespace mediapipe
@@ -0,0 +1,108 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/image_frame.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+std::shared_ptr<ImageFrame> MakeGradientFrame(int width, int height) {
+  auto frame = std::make_shared<ImageFrame>(ImageFormat::GRAY8, width, height);
+  for (int y = 0; y < height; ++y) {
+    uint8_t* row = frame->MutablePixelData() + y * frame->WidthStep();
+    for (int x = 0; x < width; ++x) {
+      row[x] = static_cast<uint8_t>(y * width + x);
+    }
+  }
+  return frame;
+}
+
+TEST(ImageFrameTest, ViewSharesPixelsOfSource) {
+  std::shared_ptr<ImageFrame> source = MakeGradientFrame(8, 6);
+
+  std::unique_ptr<ImageFrame> view =
+      ImageFrame::CreateView(source, /*x=*/2, /*y=*/1, /*width=*/4,
+                             /*height=*/3);
+
+  EXPECT_TRUE(view->IsView());
+  EXPECT_EQ(view->Format(), ImageFormat::GRAY8);
+  EXPECT_EQ(view->Width(), 4);
+  EXPECT_EQ(view->Height(), 3);
+  EXPECT_EQ(view->WidthStep(), source->WidthStep());
+  EXPECT_EQ(view->PixelData(),
+            source->PixelData() + source->WidthStep() + 2);
+  EXPECT_EQ(view->PixelData()[view->WidthStep() + 1], 2 * 8 + 3);
+}
+
+TEST(ImageFrameTest, ViewKeepsSourceAlive) {
+  std::shared_ptr<ImageFrame> source = MakeGradientFrame(8, 6);
+  std::weak_ptr<ImageFrame> weak_source = source;
+
+  std::unique_ptr<ImageFrame> view =
+      ImageFrame::CreateView(std::move(source), 0, 0, 8, 6);
+  EXPECT_FALSE(weak_source.expired());
+
+  view.reset();
+  EXPECT_TRUE(weak_source.expired());
+}
+
+TEST(ImageFrameTest, WritingToViewCopiesPixels) {
+  std::shared_ptr<ImageFrame> source = MakeGradientFrame(8, 6);
+  std::unique_ptr<ImageFrame> view = ImageFrame::CreateView(source, 2, 1, 4, 3);
+  std::weak_ptr<ImageFrame> weak_source = source;
+  source.reset();
+
+  uint8_t* pixels = view->MutablePixelData();
+  pixels[0] = 255;
+
+  EXPECT_FALSE(view->IsView());
+  EXPECT_TRUE(weak_source.expired());
+  EXPECT_EQ(view->Width(), 4);
+  EXPECT_EQ(view->Height(), 3);
+  EXPECT_TRUE(view->IsAligned(ImageFrame::kDefaultAlignmentBoundary));
+  EXPECT_EQ(view->PixelData()[0], 255);
+  EXPECT_EQ(view->PixelData()[1], 1 * 8 + 3);
+  EXPECT_EQ(view->PixelData()[2 * view->WidthStep() + 3], 3 * 8 + 5);
+}
+
+TEST(ImageFrameTest, WritingToViewLeavesSourceUnchanged) {
+  std::shared_ptr<ImageFrame> source = MakeGradientFrame(8, 6);
+  std::unique_ptr<ImageFrame> view = ImageFrame::CreateView(source, 0, 0, 8, 6);
+
+  view->SetToZero();
+
+  EXPECT_EQ(view->PixelData()[9], 0);
+  EXPECT_EQ(source->PixelData()[source->WidthStep() + 1], 9);
+}
+
+TEST(ImageFrameTest, MovedViewStaysView) {
+  std::shared_ptr<ImageFrame> source = MakeGradientFrame(8, 6);
+  std::unique_ptr<ImageFrame> view = ImageFrame::CreateView(source, 0, 0, 8, 6);
+
+  ImageFrame moved(std::move(*view));
+
+  EXPECT_TRUE(moved.IsView());
+  EXPECT_FALSE(view->IsView());
+  moved.MutablePixelData()[0] = 42;
+  EXPECT_EQ(source->PixelData()[0], 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -30,7 +30,8 @@
 
 namespace mediapipe {
 
-// Keep this many buffers allocated for a given frame size.
+// Keep this many GPU buffers allocated for a given frame size. CPU pools are
+// configured by ImageFramePoolOptions, which default to the same count.
 static constexpr int kKeepCount = 2;
 // The maximum size of the ImageMultiPool. When the limit is reached, the
 // oldest IBufferSpec will be dropped.
@@ -116,7 +117,7 @@ Image ImageMultiPool::GetBufferFromSimplePool(
 ImageMultiPool::SimplePoolCpu ImageMultiPool::MakeSimplePoolCpu(
     IBufferSpec spec) {
   return ImageFramePool::Create(spec.width, spec.height, spec.format,
-                                kKeepCount);
+                                cpu_pool_options_);
 }
 
 Image ImageMultiPool::GetBufferFromSimplePool(
@@ -188,6 +189,30 @@ Image ImageMultiPool::GetBuffer(int width, int height, bool use_gpu,
   }
 }
 
+void ImageMultiPool::ReleaseIdleCpuBuffers() {
+  absl::MutexLock lock(&mutex_cpu_);
+  for (const auto& [spec, pool] : pools_cpu_) {
+    pool->ReleaseIdleBuffers();
+  }
+}
+
+ImageFramePoolStats ImageMultiPool::GetCpuStats() {
+  absl::MutexLock lock(&mutex_cpu_);
+  ImageFramePoolStats total;
+  for (const auto& [spec, pool] : pools_cpu_) {
+    const ImageFramePoolStats stats = pool->GetStats();
+    total.requests += stats.requests;
+    total.reused += stats.reused;
+    total.allocated += stats.allocated;
+    total.released += stats.released;
+    total.in_use += stats.in_use;
+    total.available += stats.available;
+    total.peak_in_use += stats.peak_in_use;
+    total.steady_state_in_use += stats.steady_state_in_use;
+  }
+  return total;
+}
+
 ImageMultiPool::~ImageMultiPool() {
 #if !MEDIAPIPE_DISABLE_GPU
 #ifdef __APPLE__
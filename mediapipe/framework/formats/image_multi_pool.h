@@ -51,12 +51,23 @@ class ImageMultiPool {
  public:
   ImageMultiPool() {}
   explicit ImageMultiPool(void* ignored) {}
+  // Creates a pool whose CPU buffers of each size are kept as configured by
+  // `cpu_pool_options`.
+  explicit ImageMultiPool(const ImageFramePoolOptions& cpu_pool_options)
+      : cpu_pool_options_(cpu_pool_options) {}
   ~ImageMultiPool();
 
   // Obtains a buffer. May either be reused or created anew.
   Image GetBuffer(int width, int height, bool use_gpu,
                   ImageFormat::Format format /*= ImageFormat::SRGBA*/);
 
+  // Releases the idle CPU buffers of all sizes, see
+  // ImageFramePool::ReleaseIdleBuffers.
+  void ReleaseIdleCpuBuffers();
+
+  // Returns the stats of the CPU buffers, summed over all sizes.
+  ImageFramePoolStats GetCpuStats();
+
 #if !MEDIAPIPE_DISABLE_GPU
 #ifdef __APPLE__
   // TODO: add tests for the texture cache registration.
@@ -120,6 +131,8 @@ class ImageMultiPool {
 
   typedef std::shared_ptr<ImageFramePool> SimplePoolCpu;
   SimplePoolCpu MakeSimplePoolCpu(IBufferSpec spec);
+
+  const ImageFramePoolOptions cpu_pool_options_;
   Image GetBufferFromSimplePool(IBufferSpec spec, const SimplePoolCpu& pool);
 
   absl::Mutex mutex_cpu_;
@@ -0,0 +1,117 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/landmark_array.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/type_map.h"
+
+namespace mediapipe {
+
+namespace {
+
+template <typename ListT>
+LandmarkArray FromProto(const ListT& landmarks) {
+  const int n = landmarks.landmark_size();
+  LandmarkArray array(n);
+  float* x = array.mutable_x().data();
+  float* y = array.mutable_y().data();
+  float* z = array.mutable_z().data();
+  float* visibility = array.mutable_visibility().data();
+  float* presence = array.mutable_presence().data();
+  bool has_visibility = n > 0;
+  bool has_presence = n > 0;
+  for (int i = 0; i < n; ++i) {
+    const auto& landmark = landmarks.landmark(i);
+    x[i] = landmark.x();
+    y[i] = landmark.y();
+    z[i] = landmark.z();
+    visibility[i] = landmark.visibility();
+    presence[i] = landmark.presence();
+    has_visibility &= landmark.has_visibility();
+    has_presence &= landmark.has_presence();
+  }
+  array.set_has_visibility(has_visibility);
+  array.set_has_presence(has_presence);
+  return array;
+}
+
+template <typename ListT>
+void ToProto(const LandmarkArray& array, ListT* landmarks) {
+  const int n = array.size();
+  landmarks->Clear();
+  landmarks->mutable_landmark()->Reserve(n);
+  const float* x = array.x().data();
+  const float* y = array.y().data();
+  const float* z = array.z().data();
+  const float* visibility = array.visibility().data();
+  const float* presence = array.presence().data();
+  for (int i = 0; i < n; ++i) {
+    auto* landmark = landmarks->add_landmark();
+    landmark->set_x(x[i]);
+    landmark->set_y(y[i]);
+    landmark->set_z(z[i]);
+    if (array.has_visibility()) {
+      landmark->set_visibility(visibility[i]);
+    }
+    if (array.has_presence()) {
+      landmark->set_presence(presence[i]);
+    }
+  }
+}
+
+}  // namespace
+
+LandmarkArray::LandmarkArray(int size)
+    : size_(size), data_(kNumFields * size, 0.0f) {}
+
+void LandmarkArray::Resize(int size) {
+  if (size == size_) {
+    return;
+  }
+  std::vector<float> data(kNumFields * size, 0.0f);
+  const int kept = std::min(size, size_);
+  for (int field = 0; field < kNumFields; ++field) {
+    std::copy_n(data_.begin() + field * size_, kept,
+                data.begin() + field * size);
+  }
+  data_ = std::move(data);
+  size_ = size;
+}
+
+LandmarkArray LandmarkArrayFromProto(const NormalizedLandmarkList& landmarks) {
+  return FromProto(landmarks);
+}
+
+LandmarkArray LandmarkArrayFromProto(const LandmarkList& landmarks) {
+  return FromProto(landmarks);
+}
+
+void LandmarkArrayToProto(const LandmarkArray& array,
+                          NormalizedLandmarkList* landmarks) {
+  ToProto(array, landmarks);
+}
+
+void LandmarkArrayToProto(const LandmarkArray& array, LandmarkList* landmarks) {
+  ToProto(array, landmarks);
+}
+
+MEDIAPIPE_REGISTER_TYPE(mediapipe::LandmarkArray, "::mediapipe::LandmarkArray",
+                        nullptr, nullptr);
+
+}  // namespace mediapipe
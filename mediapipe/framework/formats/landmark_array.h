@@ -0,0 +1,107 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// A flat alternative to the NormalizedLandmarkList and LandmarkList protos.
+//
+// LandmarkArray stores the landmarks as a structure of arrays: all x
+// coordinates, then all y, all z, all visibilities and all presences, in one
+// contiguous buffer. Calculators that transform every landmark the same way
+// can then loop over plain float arrays, which compilers vectorize, instead of
+// going through proto accessors for each field of each landmark. The x, y and
+// z blocks are adjacent, so they can also be handed as a single span to code
+// such as the filter banks in mediapipe/util/filtering.
+//
+// A LandmarkArray does not record whether its coordinates are normalized;
+// like for the protos, that follows from the stream it is sent on.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_LANDMARK_ARRAY_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_LANDMARK_ARRAY_H_
+
+#include <vector>
+
+#include "absl/types/span.h"
+#include "mediapipe/framework/formats/landmark.pb.h"
+
+namespace mediapipe {
+
+class LandmarkArray {
+ public:
+  LandmarkArray() = default;
+  // Creates an array of `size` landmarks with all values set to zero.
+  explicit LandmarkArray(int size);
+
+  int size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Resizes the array to `size` landmarks. The values of the first
+  // min(size, size()) landmarks are kept, the others are set to zero.
+  void Resize(int size);
+
+  absl::Span<const float> x() const { return Field(kX); }
+  absl::Span<const float> y() const { return Field(kY); }
+  absl::Span<const float> z() const { return Field(kZ); }
+  absl::Span<const float> visibility() const { return Field(kVisibility); }
+  absl::Span<const float> presence() const { return Field(kPresence); }
+  absl::Span<float> mutable_x() { return MutableField(kX); }
+  absl::Span<float> mutable_y() { return MutableField(kY); }
+  absl::Span<float> mutable_z() { return MutableField(kZ); }
+  absl::Span<float> mutable_visibility() { return MutableField(kVisibility); }
+  absl::Span<float> mutable_presence() { return MutableField(kPresence); }
+
+  // The x, then y, then z coordinates of all landmarks, 3 * size() values.
+  absl::Span<const float> xyz() const {
+    return absl::MakeConstSpan(data_.data(), 3 * size_);
+  }
+  absl::Span<float> mutable_xyz() {
+    return absl::MakeSpan(data_.data(), 3 * size_);
+  }
+
+  // Whether the visibility and presence values are set. Like the optional
+  // proto fields, they are left unset by models that do not support them.
+  bool has_visibility() const { return has_visibility_; }
+  void set_has_visibility(bool has_visibility) {
+    has_visibility_ = has_visibility;
+  }
+  bool has_presence() const { return has_presence_; }
+  void set_has_presence(bool has_presence) { has_presence_ = has_presence; }
+
+ private:
+  enum FieldIndex { kX = 0, kY, kZ, kVisibility, kPresence, kNumFields };
+
+  absl::Span<const float> Field(FieldIndex field) const {
+    return absl::MakeConstSpan(data_.data() + field * size_, size_);
+  }
+  absl::Span<float> MutableField(FieldIndex field) {
+    return absl::MakeSpan(data_.data() + field * size_, size_);
+  }
+
+  int size_ = 0;
+  // kNumFields blocks of size_ values, in FieldIndex order.
+  std::vector<float> data_;
+  bool has_visibility_ = false;
+  bool has_presence_ = false;
+};
+
+// Conversions from and to the landmark protos, one pass over the landmarks
+// each. Visibility and presence are only kept when every landmark of the list
+// has them, which is the case for the output of landmark models.
+LandmarkArray LandmarkArrayFromProto(const NormalizedLandmarkList& landmarks);
+LandmarkArray LandmarkArrayFromProto(const LandmarkList& landmarks);
+void LandmarkArrayToProto(const LandmarkArray& array,
+                          NormalizedLandmarkList* landmarks);
+void LandmarkArrayToProto(const LandmarkArray& array, LandmarkList* landmarks);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_LANDMARK_ARRAY_H_
@@ -0,0 +1,87 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/landmark_array.h"
+
+#include "mediapipe/framework/formats/landmark.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+TEST(LandmarkArrayTest, FieldsAreContiguousBlocks) {
+  LandmarkArray array(2);
+  array.mutable_x()[0] = 1.0f;
+  array.mutable_x()[1] = 2.0f;
+  array.mutable_y()[0] = 3.0f;
+  array.mutable_y()[1] = 4.0f;
+  array.mutable_z()[0] = 5.0f;
+  array.mutable_z()[1] = 6.0f;
+  EXPECT_THAT(array.xyz(), ElementsAre(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f));
+  EXPECT_THAT(array.visibility(), ElementsAre(0.0f, 0.0f));
+  EXPECT_FALSE(array.has_visibility());
+  EXPECT_FALSE(array.has_presence());
+}
+
+TEST(LandmarkArrayTest, ResizeKeepsValues) {
+  LandmarkArray array(2);
+  array.mutable_x()[1] = 1.0f;
+  array.mutable_presence()[1] = 2.0f;
+  array.Resize(3);
+  EXPECT_THAT(array.x(), ElementsAre(0.0f, 1.0f, 0.0f));
+  EXPECT_THAT(array.presence(), ElementsAre(0.0f, 2.0f, 0.0f));
+  array.Resize(1);
+  EXPECT_THAT(array.x(), ElementsAre(0.0f));
+  EXPECT_THAT(array.presence(), ElementsAre(0.0f));
+}
+
+TEST(LandmarkArrayTest, RoundTripsNormalizedLandmarkList) {
+  const auto landmarks = ParseTextProtoOrDie<NormalizedLandmarkList>(R"pb(
+    landmark { x: 0.1 y: 0.2 z: 0.3 visibility: 0.4 presence: 0.5 }
+    landmark { x: 0.6 y: 0.7 z: 0.8 visibility: 0.9 presence: 1.0 }
+  )pb");
+  const LandmarkArray array = LandmarkArrayFromProto(landmarks);
+  ASSERT_EQ(array.size(), 2);
+  EXPECT_THAT(array.y(), ElementsAre(0.2f, 0.7f));
+  EXPECT_TRUE(array.has_visibility());
+  EXPECT_TRUE(array.has_presence());
+
+  NormalizedLandmarkList converted;
+  LandmarkArrayToProto(array, &converted);
+  EXPECT_EQ(converted.SerializeAsString(), landmarks.SerializeAsString());
+}
+
+TEST(LandmarkArrayTest, DropsVisibilityMissingOnSomeLandmarks) {
+  const auto landmarks = ParseTextProtoOrDie<LandmarkList>(R"pb(
+    landmark { x: 10 y: 20 z: 30 visibility: 0.4 presence: 0.5 }
+    landmark { x: 60 y: 70 z: 80 presence: 1.0 }
+  )pb");
+  const LandmarkArray array = LandmarkArrayFromProto(landmarks);
+  EXPECT_FALSE(array.has_visibility());
+  EXPECT_TRUE(array.has_presence());
+
+  LandmarkList converted;
+  LandmarkArrayToProto(array, &converted);
+  ASSERT_EQ(converted.landmark_size(), 2);
+  EXPECT_FALSE(converted.landmark(0).has_visibility());
+  EXPECT_FLOAT_EQ(converted.landmark(0).presence(), 0.5f);
+  EXPECT_FLOAT_EQ(converted.landmark(1).x(), 60.0f);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -20,6 +20,7 @@
 #include "absl/strings/substitute.h"
 #include "mediapipe/framework/formats/annotation/rasterization.pb.h"
 #include "mediapipe/framework/formats/location.h"
+#include "mediapipe/framework/formats/run_length_mask.h"
 #include "mediapipe/framework/port/opencv_imgproc_inc.h"
 #include "mediapipe/framework/port/statusor.h"
 
@@ -46,13 +47,10 @@ Rectangle_i MaskToRectangle(const LocationData& location_data) {
 }
 
 std::unique_ptr<cv::Mat> MaskToMat(const LocationData::BinaryMask& mask) {
-  auto image = absl::make_unique<cv::Mat>();
-  *image = cv::Mat::zeros(cv::Size(mask.width(), mask.height()), CV_32FC1);
-  for (const auto& interval : mask.rasterization().interval()) {
-    for (int x = interval.left_x(); x <= interval.right_x(); ++x) {
-      image->at<float>(interval.y(), x) = 1.0f;
-    }
-  }
+  auto image = absl::make_unique<cv::Mat>(mask.height(), mask.width(),
+                                          CV_32FC1);
+  RunLengthMask::FromBinaryMask(mask).Decode(image->ptr<float>(),
+                                             image->step1());
   return image;
 }
 absl::StatusOr<std::unique_ptr<cv::Mat>> RectangleToMat(
@@ -89,12 +87,9 @@ std::unique_ptr<cv::Mat> GetCvMask(const Location& location) {
   ABSL_CHECK_EQ(LocationData::MASK, location_data.format());
   const auto& mask = location_data.mask();
   std::unique_ptr<cv::Mat> mat(
-      new cv::Mat(mask.height(), mask.width(), CV_8UC1, cv::Scalar(0)));
-  for (const auto& interval : location_data.mask().rasterization().interval()) {
-    for (int x = interval.left_x(); x <= interval.right_x(); ++x) {
-      mat->at<uint8_t>(interval.y(), x) = 255;
-    }
-  }
+      new cv::Mat(mask.height(), mask.width(), CV_8UC1));
+  RunLengthMask::FromBinaryMask(mask).Decode(mat->ptr<uint8_t>(),
+                                             mat->step1());
   return mat;
 }
 
@@ -189,29 +184,9 @@ Location CreateCvMaskLocation(const cv::Mat_<T>& mask) {
 
   LocationData location_data;
   location_data.set_format(LocationData::MASK);
-  location_data.mutable_mask()->set_width(mask.cols);
-  location_data.mutable_mask()->set_height(mask.rows);
-  auto* rasterization = location_data.mutable_mask()->mutable_rasterization();
-  const auto kForegroundThreshold = static_cast<T>(0);
-  for (int y = 0; y < mask.rows; y++) {
-    Rasterization::Interval* interval;
-    bool traversing = false;
-    for (int x = 0; x < mask.cols; x++) {
-      const bool is_foreground =
-          mask.template at<T>(y, x) > kForegroundThreshold;
-      if (is_foreground) {
-        if (!traversing) {
-          interval = rasterization->add_interval();
-          interval->set_y(y);
-          interval->set_left_x(x);
-          traversing = true;
-        }
-        interval->set_right_x(x);
-      } else {
-        traversing = false;
-      }
-    }
-  }
+  RunLengthMask::Encode(mask.template ptr<T>(), mask.cols, mask.rows,
+                        mask.step1(), /*threshold=*/static_cast<T>(0))
+      .ToBinaryMask(location_data.mutable_mask());
   return Location(location_data);
 }
 
@@ -0,0 +1,211 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/run_length_mask.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/formats/annotation/rasterization.pb.h"
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/port/rectangle.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Appends the foreground runs of one row to `mask`. The two inner loops only
+// compare and advance, so long runs of either kind are skipped without
+// touching the output.
+template <typename T>
+void EncodeRow(const T* row, int width, T threshold, int y,
+               RunLengthMask* mask) {
+  int x = 0;
+  while (x < width) {
+    while (x < width && !(row[x] > threshold)) ++x;
+    if (x == width) break;
+    const int left_x = x;
+    while (x < width && row[x] > threshold) ++x;
+    mask->AddRun(y, left_x, x - 1);
+  }
+}
+
+template <typename T>
+RunLengthMask EncodeImage(const T* pixels, int width, int height,
+                          int row_stride, T threshold) {
+  RunLengthMask mask(width, height);
+  for (int y = 0; y < height; ++y) {
+    EncodeRow(pixels + static_cast<int64_t>(y) * row_stride, width, threshold,
+              y, &mask);
+  }
+  return mask;
+}
+
+// Writes the mask rows one after the other: each row is cleared and its runs
+// are filled, so every pixel is written while the row is in cache.
+template <typename T>
+void DecodeImage(const RunLengthMask& mask, T* pixels, int row_stride,
+                 T value) {
+  const auto& runs = mask.runs();
+  auto run = runs.begin();
+  for (int y = 0; y < mask.height(); ++y) {
+    T* row = pixels + static_cast<int64_t>(y) * row_stride;
+    std::fill_n(row, mask.width(), T(0));
+    for (; run != runs.end() && run->y == y; ++run) {
+      std::fill(row + run->left_x, row + run->right_x + 1, value);
+    }
+  }
+}
+
+bool RunLess(const RunLengthMask::Run& run1, const RunLengthMask::Run& run2) {
+  return run1.y < run2.y || (run1.y == run2.y && run1.left_x < run2.left_x);
+}
+
+}  // namespace
+
+RunLengthMask RunLengthMask::Encode(const uint8_t* pixels, int width,
+                                    int height, int row_stride,
+                                    uint8_t threshold) {
+  return EncodeImage(pixels, width, height, row_stride, threshold);
+}
+
+RunLengthMask RunLengthMask::Encode(const float* pixels, int width, int height,
+                                    int row_stride, float threshold) {
+  return EncodeImage(pixels, width, height, row_stride, threshold);
+}
+
+absl::StatusOr<RunLengthMask> RunLengthMask::Encode(const ImageFrame& image,
+                                                    float threshold) {
+  switch (image.Format()) {
+    case ImageFormat::GRAY8:
+      return Encode(image.PixelData(), image.Width(), image.Height(),
+                    image.WidthStep(),
+                    static_cast<uint8_t>(std::clamp(threshold, 0.0f, 255.0f)));
+    case ImageFormat::VEC32F1:
+      return Encode(reinterpret_cast<const float*>(image.PixelData()),
+                    image.Width(), image.Height(),
+                    image.WidthStep() / static_cast<int>(sizeof(float)),
+                    threshold);
+    default:
+      return absl::InvalidArgumentError(
+          "Only GRAY8 and VEC32F1 images can be encoded as masks.");
+  }
+}
+
+RunLengthMask RunLengthMask::FromBinaryMask(
+    const LocationData::BinaryMask& mask) {
+  RunLengthMask result(mask.width(), mask.height());
+  const auto& intervals = mask.rasterization().interval();
+  result.runs_.reserve(intervals.size());
+  for (const auto& interval : intervals) {
+    result.AddRun(interval.y(), interval.left_x(), interval.right_x());
+  }
+  if (!std::is_sorted(result.runs_.begin(), result.runs_.end(), RunLess)) {
+    std::sort(result.runs_.begin(), result.runs_.end(), RunLess);
+  }
+  return result;
+}
+
+void RunLengthMask::ToBinaryMask(LocationData::BinaryMask* mask) const {
+  mask->set_width(width_);
+  mask->set_height(height_);
+  auto* intervals = mask->mutable_rasterization()->mutable_interval();
+  intervals->Clear();
+  intervals->Reserve(runs_.size());
+  for (const Run& run : runs_) {
+    auto* interval = intervals->Add();
+    interval->set_y(run.y);
+    interval->set_left_x(run.left_x);
+    interval->set_right_x(run.right_x);
+  }
+}
+
+void RunLengthMask::Decode(uint8_t* pixels, int row_stride,
+                           uint8_t value) const {
+  DecodeImage(*this, pixels, row_stride, value);
+}
+
+void RunLengthMask::Decode(float* pixels, int row_stride, float value) const {
+  DecodeImage(*this, pixels, row_stride, value);
+}
+
+int64_t RunLengthMask::Area() const {
+  int64_t area = 0;
+  for (const Run& run : runs_) {
+    area += run.right_x - run.left_x + 1;
+  }
+  return area;
+}
+
+Rectangle_i RunLengthMask::BoundingBox() const {
+  if (runs_.empty()) {
+    return Rectangle_i(0, 0, 0, 0);
+  }
+  // Runs are sorted by row, so only the columns need a pass over the runs.
+  int xmin = std::numeric_limits<int>::max();
+  int xmax = std::numeric_limits<int>::lowest();
+  for (const Run& run : runs_) {
+    xmin = std::min(xmin, run.left_x);
+    xmax = std::max(xmax, run.right_x);
+  }
+  const int ymin = runs_.front().y;
+  const int ymax = runs_.back().y;
+  return Rectangle_i(xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
+}
+
+int64_t IntersectionArea(const RunLengthMask& mask1,
+                         const RunLengthMask& mask2) {
+  const auto& runs1 = mask1.runs();
+  const auto& runs2 = mask2.runs();
+  int64_t area = 0;
+  auto run1 = runs1.begin();
+  auto run2 = runs2.begin();
+  while (run1 != runs1.end() && run2 != runs2.end()) {
+    if (run1->y != run2->y) {
+      if (run1->y < run2->y) {
+        ++run1;
+      } else {
+        ++run2;
+      }
+      continue;
+    }
+    const int left_x = std::max(run1->left_x, run2->left_x);
+    const int right_x = std::min(run1->right_x, run2->right_x);
+    if (left_x <= right_x) {
+      area += right_x - left_x + 1;
+    }
+    // The run ending first cannot overlap any later run of the other mask.
+    if (run1->right_x < run2->right_x) {
+      ++run1;
+    } else {
+      ++run2;
+    }
+  }
+  return area;
+}
+
+float IntersectionOverUnion(const RunLengthMask& mask1,
+                            const RunLengthMask& mask2) {
+  const int64_t intersection = IntersectionArea(mask1, mask2);
+  const int64_t union_area = mask1.Area() + mask2.Area() - intersection;
+  return union_area > 0 ? static_cast<float>(intersection) / union_area : 0.0f;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,108 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// A binary mask stored as its horizontal runs of foreground pixels.
+//
+// RunLengthMask holds the same information as the mediapipe.Rasterization of a
+// LocationData::BinaryMask, but as a flat vector of plain structs, and keeps
+// its runs sorted by row and then column. Encoding and decoding work on rows
+// of contiguous pixels, and the bounding box, area and overlap of masks are
+// computed from the runs alone, in time linear in the number of runs rather
+// than the number of pixels.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_RUN_LENGTH_MASK_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_RUN_LENGTH_MASK_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/port/rectangle.h"
+
+namespace mediapipe {
+
+class RunLengthMask {
+ public:
+  // A run of foreground pixels [left_x, right_x] on row y. Both ends are
+  // inclusive, as in mediapipe.Rasterization.Interval.
+  struct Run {
+    int y;
+    int left_x;
+    int right_x;
+  };
+
+  RunLengthMask() = default;
+  // Creates an empty mask of the given dimensions.
+  RunLengthMask(int width, int height) : width_(width), height_(height) {}
+
+  // Encodes a row-major single-channel image, treating the pixels with values
+  // greater than `threshold` as foreground. `row_stride` is the distance
+  // between rows in elements, not bytes. This also covers CPU float Tensor
+  // masks, e.g. through Tensor::GetCpuReadView().buffer<float>().
+  static RunLengthMask Encode(const uint8_t* pixels, int width, int height,
+                              int row_stride, uint8_t threshold = 0);
+  static RunLengthMask Encode(const float* pixels, int width, int height,
+                              int row_stride, float threshold = 0.0f);
+  // Encodes a GRAY8 or VEC32F1 ImageFrame.
+  static absl::StatusOr<RunLengthMask> Encode(const ImageFrame& image,
+                                              float threshold = 0.0f);
+
+  // Conversions from and to the LocationData mask representation. Intervals
+  // within a row of the rasterization may come in any order.
+  static RunLengthMask FromBinaryMask(const LocationData::BinaryMask& mask);
+  void ToBinaryMask(LocationData::BinaryMask* mask) const;
+
+  // Writes `value` to the foreground pixels and zero to the background pixels
+  // of a width() x height() image with the given row stride in elements.
+  void Decode(uint8_t* pixels, int row_stride, uint8_t value = 255) const;
+  void Decode(float* pixels, int row_stride, float value = 1.0f) const;
+
+  // Appends a run. Runs must be added in row order, and from left to right
+  // without overlap within a row.
+  void AddRun(int y, int left_x, int right_x) {
+    runs_.push_back({y, left_x, right_x});
+  }
+
+  int width() const { return width_; }
+  int height() const { return height_; }
+  const std::vector<Run>& runs() const { return runs_; }
+  bool empty() const { return runs_.empty(); }
+
+  // The number of foreground pixels.
+  int64_t Area() const;
+  // The tightest rectangle containing the foreground pixels, or an empty
+  // rectangle at the origin for an empty mask, like Location does.
+  Rectangle_i BoundingBox() const;
+
+ private:
+  int width_ = 0;
+  int height_ = 0;
+  std::vector<Run> runs_;
+};
+
+// The number of pixels that are foreground in both masks, computed by merging
+// the runs of the two masks row by row.
+int64_t IntersectionArea(const RunLengthMask& mask1,
+                         const RunLengthMask& mask2);
+
+// The intersection over union of the foreground pixels of two masks, or 0 if
+// both masks are empty.
+float IntersectionOverUnion(const RunLengthMask& mask1,
+                            const RunLengthMask& mask2);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_RUN_LENGTH_MASK_H_
@@ -0,0 +1,128 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/run_length_mask.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "mediapipe/framework/formats/image_format.pb.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/location_data.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/rectangle.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+
+MATCHER_P3(RunIs, y, left_x, right_x, "") {
+  return arg.y == y && arg.left_x == left_x && arg.right_x == right_x;
+}
+
+// A 5x3 mask:
+//   .##.#
+//   .....
+//   ####.
+constexpr uint8_t kPixels[] = {0, 9, 9, 0, 9,  //
+                               0, 0, 0, 0, 0,  //
+                               9, 9, 9, 9, 0};
+
+TEST(RunLengthMaskTest, EncodesAndDecodesRows) {
+  const RunLengthMask mask = RunLengthMask::Encode(kPixels, /*width=*/5,
+                                                   /*height=*/3,
+                                                   /*row_stride=*/5);
+  EXPECT_THAT(mask.runs(),
+              ElementsAre(RunIs(0, 1, 2), RunIs(0, 4, 4), RunIs(2, 0, 3)));
+  EXPECT_EQ(mask.Area(), 7);
+  EXPECT_EQ(mask.BoundingBox(), Rectangle_i(0, 0, 5, 3));
+
+  std::vector<uint8_t> decoded(3 * 6, 7);
+  mask.Decode(decoded.data(), /*row_stride=*/6, /*value=*/1);
+  EXPECT_THAT(decoded, ElementsAre(0, 1, 1, 0, 1, 7,  //
+                                   0, 0, 0, 0, 0, 7,  //
+                                   1, 1, 1, 1, 0, 7));
+}
+
+TEST(RunLengthMaskTest, EncodesImageFrameWithThreshold) {
+  ImageFrame frame(ImageFormat::VEC32F1, 4, 2);
+  for (int y = 0; y < 2; ++y) {
+    float* row = reinterpret_cast<float*>(frame.MutablePixelData() +
+                                          y * frame.WidthStep());
+    row[0] = 0.1f;
+    row[1] = 0.9f;
+    row[2] = y == 0 ? 0.8f : 0.2f;
+    row[3] = 0.6f;
+  }
+  MP_ASSERT_OK_AND_ASSIGN(RunLengthMask mask,
+                          RunLengthMask::Encode(frame, /*threshold=*/0.5f));
+  EXPECT_THAT(mask.runs(),
+              ElementsAre(RunIs(0, 1, 3), RunIs(1, 1, 1), RunIs(1, 3, 3)));
+  EXPECT_EQ(mask.BoundingBox(), Rectangle_i(1, 0, 3, 2));
+
+  EXPECT_FALSE(
+      RunLengthMask::Encode(ImageFrame(ImageFormat::SRGB, 4, 2)).ok());
+}
+
+TEST(RunLengthMaskTest, RoundTripsBinaryMask) {
+  const auto binary_mask =
+      ParseTextProtoOrDie<LocationData::BinaryMask>(R"pb(
+        width: 10
+        height: 4
+        rasterization {
+          interval { y: 1 left_x: 6 right_x: 8 }
+          interval { y: 1 left_x: 2 right_x: 3 }
+          interval { y: 3 left_x: 0 right_x: 0 }
+        }
+      )pb");
+  const RunLengthMask mask = RunLengthMask::FromBinaryMask(binary_mask);
+  EXPECT_EQ(mask.width(), 10);
+  EXPECT_EQ(mask.height(), 4);
+  EXPECT_THAT(mask.runs(),
+              ElementsAre(RunIs(1, 2, 3), RunIs(1, 6, 8), RunIs(3, 0, 0)));
+
+  LocationData::BinaryMask converted;
+  mask.ToBinaryMask(&converted);
+  ASSERT_EQ(converted.rasterization().interval_size(), 3);
+  EXPECT_EQ(converted.rasterization().interval(0).left_x(), 2);
+  EXPECT_EQ(converted.rasterization().interval(1).left_x(), 6);
+  EXPECT_EQ(converted.width(), 10);
+}
+
+TEST(RunLengthMaskTest, ComputesOverlapOnRuns) {
+  RunLengthMask mask1(10, 3);
+  mask1.AddRun(0, 0, 4);
+  mask1.AddRun(1, 0, 1);
+  mask1.AddRun(1, 5, 9);
+  RunLengthMask mask2(10, 3);
+  mask2.AddRun(1, 1, 6);
+  mask2.AddRun(2, 0, 9);
+
+  // Row 1: [0, 1] and [5, 9] against [1, 6] overlap on 1 and 5-6.
+  EXPECT_EQ(IntersectionArea(mask1, mask2), 3);
+  EXPECT_EQ(IntersectionArea(mask2, mask1), 3);
+  // Areas are 12 and 16.
+  EXPECT_THAT(IntersectionOverUnion(mask1, mask2), FloatEq(3.0f / 25.0f));
+  EXPECT_THAT(IntersectionOverUnion(mask1, mask1), FloatEq(1.0f));
+  EXPECT_EQ(IntersectionOverUnion(RunLengthMask(), RunLengthMask()), 0.0f);
+  EXPECT_EQ(RunLengthMask().BoundingBox(), Rectangle_i(0, 0, 0, 0));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,154 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SharedVector<T> is an immutable sequence of elements whose storage is shared
+// by reference counting: it is a list of segments, each a contiguous range of
+// a shared std::vector<T>. Slicing and appending only copy the segment list,
+// never the elements, which also makes them work for move-only types such as
+// Tensor. A SharedVector can share the vector held by a packet, so that
+// splitting or concatenating the std::vector<Tensor> outputs of a model costs
+// O(1) per output instead of a copy or a Consume() of every input.
+//
+// Consumers that need contiguous memory iterate over spans(); each span stays
+// valid as long as any SharedVector refers to its storage.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_SHARED_VECTOR_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_SHARED_VECTOR_H_
+
+#include <algorithm>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/types/span.h"
+
+namespace mediapipe {
+
+template <typename T>
+class SharedVector {
+ public:
+  SharedVector() = default;
+
+  // Takes ownership of `elements` without copying them.
+  explicit SharedVector(std::vector<T> elements) {
+    AppendSegment(
+        std::make_shared<const std::vector<T>>(std::move(elements)));
+  }
+
+  // Shares `elements`, e.g. the payload of a packet obtained with
+  // Packet::Share<std::vector<T>>(), without copying them.
+  explicit SharedVector(std::shared_ptr<const std::vector<T>> elements) {
+    AppendSegment(std::move(elements));
+  }
+
+  int size() const { return ends_.empty() ? 0 : ends_.back(); }
+  bool empty() const { return size() == 0; }
+
+  // Returns element `i`, in O(log(number of segments)).
+  const T& operator[](int i) const {
+    ABSL_DCHECK(i >= 0 && i < size());
+    const int segment = std::upper_bound(ends_.begin(), ends_.end(), i) -
+                        ends_.begin();
+    const int segment_begin = segment == 0 ? 0 : ends_[segment - 1];
+    return (*segments_[segment].storage)[segments_[segment].begin + i -
+                                         segment_begin];
+  }
+
+  // Returns the elements [begin, end), sharing their storage.
+  SharedVector Slice(int begin, int end) const {
+    ABSL_CHECK(0 <= begin && begin <= end && end <= size());
+    SharedVector result;
+    int segment_begin = 0;
+    for (int s = 0; s < segments_.size() && segment_begin < end; ++s) {
+      const Segment& segment = segments_[s];
+      const int segment_end = ends_[s];
+      const int first = std::max(begin, segment_begin);
+      const int last = std::min(end, segment_end);
+      if (first < last) {
+        result.AppendSegment(segment.storage,
+                             segment.begin + first - segment_begin,
+                             segment.begin + last - segment_begin);
+      }
+      segment_begin = segment_end;
+    }
+    return result;
+  }
+
+  // Appends the elements of `other`, sharing their storage.
+  void Append(const SharedVector& other) {
+    for (const Segment& segment : other.segments_) {
+      AppendSegment(segment.storage, segment.begin, segment.end);
+    }
+  }
+
+  // The elements as contiguous spans, in order.
+  std::vector<absl::Span<const T>> spans() const {
+    std::vector<absl::Span<const T>> result;
+    result.reserve(segments_.size());
+    for (const Segment& segment : segments_) {
+      result.push_back(absl::MakeConstSpan(
+          segment.storage->data() + segment.begin,
+          segment.end - segment.begin));
+    }
+    return result;
+  }
+
+  // Copies the elements into a std::vector, for consumers that need one.
+  template <typename U = T,
+            std::enable_if_t<std::is_copy_constructible<U>::value, bool> = true>
+  std::vector<T> ToVector() const {
+    std::vector<T> result;
+    result.reserve(size());
+    for (absl::Span<const T> span : spans()) {
+      result.insert(result.end(), span.begin(), span.end());
+    }
+    return result;
+  }
+
+ private:
+  struct Segment {
+    std::shared_ptr<const std::vector<T>> storage;
+    int begin;
+    int end;
+  };
+
+  void AppendSegment(std::shared_ptr<const std::vector<T>> storage) {
+    const int end = storage->size();
+    AppendSegment(std::move(storage), 0, end);
+  }
+
+  void AppendSegment(std::shared_ptr<const std::vector<T>> storage, int begin,
+                     int end) {
+    if (begin == end) return;
+    // Merge with the previous segment if it ends where this one starts.
+    if (!segments_.empty() && segments_.back().storage == storage &&
+        segments_.back().end == begin) {
+      segments_.back().end = end;
+      ends_.back() += end - begin;
+      return;
+    }
+    ends_.push_back(size() + end - begin);
+    segments_.push_back({std::move(storage), begin, end});
+  }
+
+  std::vector<Segment> segments_;
+  // The index one past the last element of each segment.
+  std::vector<int> ends_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_SHARED_VECTOR_H_
@@ -0,0 +1,81 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/shared_vector.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::SizeIs;
+
+TEST(SharedVectorTest, SlicesShareStorage) {
+  const SharedVector<int> vector(std::vector<int>{0, 1, 2, 3, 4, 5});
+  const SharedVector<int> slice = vector.Slice(2, 5);
+  EXPECT_EQ(slice.size(), 3);
+  EXPECT_EQ(slice[0], 2);
+  EXPECT_EQ(&slice[0], &vector[2]);
+  EXPECT_THAT(slice.ToVector(), ElementsAre(2, 3, 4));
+  EXPECT_TRUE(vector.Slice(3, 3).empty());
+}
+
+TEST(SharedVectorTest, AppendsWithoutCopying) {
+  SharedVector<int> a(std::vector<int>{0, 1, 2});
+  const SharedVector<int> b(std::vector<int>{3, 4});
+  const int* b_data = &b[0];
+  a.Append(b);
+  EXPECT_EQ(a.size(), 5);
+  EXPECT_EQ(&a[3], b_data);
+  EXPECT_THAT(a.spans(), SizeIs(2));
+  EXPECT_THAT(a.ToVector(), ElementsAre(0, 1, 2, 3, 4));
+
+  // Slices across segments.
+  EXPECT_THAT(a.Slice(1, 4).ToVector(), ElementsAre(1, 2, 3));
+  EXPECT_THAT(a.Slice(3, 5).spans(), SizeIs(1));
+}
+
+TEST(SharedVectorTest, MergesAdjacentSlices) {
+  const SharedVector<int> vector(std::vector<int>{0, 1, 2, 3});
+  SharedVector<int> joined = vector.Slice(0, 2);
+  joined.Append(vector.Slice(2, 4));
+  EXPECT_THAT(joined.spans(), SizeIs(1));
+  EXPECT_THAT(joined.ToVector(), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(SharedVectorTest, SharesPacketPayload) {
+  auto elements = std::make_unique<std::vector<std::unique_ptr<int>>>();
+  elements->push_back(std::make_unique<int>(7));
+  elements->push_back(std::make_unique<int>(8));
+  Packet packet = Adopt(elements.release());
+  const auto& payload = packet.Get<std::vector<std::unique_ptr<int>>>();
+  auto shared = packet.Share<std::vector<std::unique_ptr<int>>>();
+  ASSERT_TRUE(shared.ok());
+  SharedVector<std::unique_ptr<int>> vector(*std::move(shared));
+  // The payload outlives the packet.
+  packet = Packet();
+  ASSERT_EQ(vector.size(), 2);
+  EXPECT_EQ(&vector[1], &payload[1]);
+  EXPECT_EQ(*vector.Slice(1, 2)[0], 8);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -16,15 +16,20 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/cpu_allocator.h"
 #include "mediapipe/framework/memory_manager.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/aligned_malloc_and_free.h"  // IWYU pragma: keep
@@ -75,6 +80,58 @@ int BhwcDepthFromShape(const Tensor::Shape& shape) {
   return shape.dims.size() < 2 ? 1 : shape.dims[shape.dims.size() - 1];
 }
 
+// A GPU-to-CPU transfer that runs once, on whichever thread gets to it first:
+// the GL context thread it is queued on by RequestCpuReadAsync(), or a thread
+// that requests the CPU view.
+class Tensor::CpuReadback {
+ public:
+  explicit CpuReadback(absl::AnyInvocable<absl::Status()> transfer)
+      : transfer_(std::move(transfer)) {}
+
+  // Runs the transfer unless it has already been started or cancelled.
+  void RunIfPending() {
+    absl::AnyInvocable<absl::Status()> transfer = Take();
+    if (transfer) Finish(transfer());
+  }
+
+  // Runs the transfer unless it has already been started, and waits for it
+  // to finish.
+  absl::Status Wait() {
+    RunIfPending();
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(&done_));
+    return status_;
+  }
+
+  // Drops the transfer unless it has already been started, in which case
+  // waits for it to finish.
+  void Cancel() {
+    if (Take()) {
+      Finish(absl::CancelledError("GPU-to-CPU read-back cancelled."));
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(&done_));
+  }
+
+ private:
+  absl::AnyInvocable<absl::Status()> Take() {
+    absl::MutexLock lock(&mutex_);
+    return std::exchange(transfer_, nullptr);
+  }
+
+  void Finish(absl::Status status) {
+    absl::MutexLock lock(&mutex_);
+    status_ = std::move(status);
+    done_ = true;
+  }
+
+  absl::Mutex mutex_;
+  absl::AnyInvocable<absl::Status()> transfer_ ABSL_GUARDED_BY(mutex_);
+  bool done_ ABSL_GUARDED_BY(mutex_) = false;
+  absl::Status status_ ABSL_GUARDED_BY(mutex_);
+};
+
 // TODO: Match channels count and padding for Texture2D:
 // 1) support 1/2/4 channels texture for 1/2/3-4 depth.
 // 2) Allocate cpu_buffer_ with padded amount of memory
@@ -153,6 +210,7 @@ MtlBufferView MtlBufferView::GetWriteView(const Tensor& tensor,
 MtlBufferView MtlBufferView::GetWriteView(const Tensor& tensor,
                                           id<MTLDevice> device) {
   auto lock(std::make_unique<absl::MutexLock>(&tensor.view_mutex_));
+  tensor.CancelCpuReadback();
   tensor.valid_ = Tensor::kValidMetalBuffer;
   AllocateMtlBuffer(tensor, device);
   return {tensor.mtl_resources_->metal_buffer, std::move(lock)};
@@ -244,6 +302,7 @@ Tensor::OpenGlTexture2dView Tensor::GetOpenGlTexture2dWriteView() const {
     texture_is_half_float_ = true;
   }
 #endif
+  CancelCpuReadback();
   valid_ = kValidOpenGlTexture2d;
   return {opengl_texture2d_, std::move(lock)};
 }
@@ -412,6 +471,7 @@ Tensor::OpenGlBufferView Tensor::GetOpenGlBufferWriteView(
            "Tensor instance are not supported and may lead to undefined "
            "behavior due to lack of synchronization.";
   }
+  CancelCpuReadback();
   valid_ = kValidOpenGlBuffer;
   return {opengl_buffer_, std::move(lock), nullptr};
 }
@@ -450,6 +510,8 @@ void Tensor::Move(Tensor* src) {
   element_type_ = src->element_type();
   src->element_type_ = ElementType::kNone;  // Mark as invalidated.
   cpu_buffer_ = std::exchange(src->cpu_buffer_, nullptr);
+  cpu_allocator_ = std::move(src->cpu_allocator_);
+  cpu_readback_ = std::move(src->cpu_readback_);
   ahwb_tracking_key_ = src->ahwb_tracking_key_;
   mtl_resources_ = std::move(src->mtl_resources_);
   MoveAhwbStuff(src);
@@ -470,6 +532,7 @@ void Tensor::Move(Tensor* src) {
 
 #if MEDIAPIPE_USE_WEBGPU
   webgpu_texture2d_ = std::move(src->webgpu_texture2d_);
+  webgpu_buffer_ = std::move(src->webgpu_buffer_);
   webgpu_device_ = std::move(src->webgpu_device_);
 #endif  // MEDIAPIPE_USE_WEBGPU
 }
@@ -509,6 +572,7 @@ void Tensor::Invalidate() {
 #endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
   {
     absl::MutexLock lock(&view_mutex_);
+    CancelCpuReadback();
     // If memory is allocated and not owned by the metal buffer.
     // TODO: Re-design cpu buffer memory management.
     if (cpu_buffer_ && !mtl_resources_->metal_buffer) {
@@ -552,6 +616,7 @@ void Tensor::Invalidate() {
 #endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
   {
     absl::MutexLock lock(&view_mutex_);
+    CancelCpuReadback();
     ReleaseAhwbStuff();
 
     // Don't need to wait for the resource to be deleted because if will be
@@ -587,11 +652,59 @@ void Tensor::Invalidate() {
 
 #if MEDIAPIPE_USE_WEBGPU
   if (webgpu_texture2d_) webgpu_texture2d_.Destroy();
+  if (webgpu_buffer_) webgpu_buffer_.Destroy();
 #endif  // MEDIAPIPE_USE_WEBGPU
   FreeCpuBuffer();
 }
 #endif  // MEDIAPIPE_METAL_ENABLED
 
+#if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
+namespace {
+
+#if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
+// Copies the first `bytes` of the SSBO `buffer` to `dst`. Expects a current GL
+// context.
+void ReadOpenGlBuffer(GLuint buffer, int bytes, void* dst) {
+  glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+  const void* ptr =
+      glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+  std::memcpy(dst, ptr, bytes);
+  glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+}
+#endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
+
+// Copies the RGBA `texture`, which holds a BHWC tensor of `shape` with the
+// depth padded to a multiple of 4, to the unpadded `dst`. Expects a current GL
+// context.
+void ReadOpenGlTexture2d(GLuint frame_buffer, GLuint texture, int width,
+                         int height, const Tensor::Shape& shape,
+                         int element_size, void* dst) {
+  const int padded_size = height * width * 4 * element_size;
+  auto temp_buffer = std::make_unique<uint8_t[]>(padded_size);
+  uint8_t* buffer = temp_buffer.get();
+
+  glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer);
+  glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                         texture, 0);
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  glReadPixels(0, 0, width, height, GL_RGBA, GL_FLOAT, buffer);
+  uint8_t* dest_buffer = reinterpret_cast<uint8_t*>(dst);
+  const int actual_depth_size = BhwcDepthFromShape(shape) * element_size;
+  const int num_slices = (BhwcDepthFromShape(shape) + 3) / 4;
+  const int padded_depth_size = num_slices * 4 * element_size;
+  const int num_elements = BhwcWidthFromShape(shape) *
+                           BhwcHeightFromShape(shape) *
+                           BhwcBatchFromShape(shape);
+  for (int e = 0; e < num_elements; e++) {
+    std::memcpy(dest_buffer, buffer, actual_depth_size);
+    dest_buffer += actual_depth_size;
+    buffer += padded_depth_size;
+  }
+}
+
+}  // namespace
+#endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
+
 absl::Status Tensor::ReadBackGpuToCpu() const {
   // GPU-to-CPU synchronization and read-back.
 #if MEDIAPIPE_METAL_ENABLED
@@ -611,13 +724,8 @@ absl::Status Tensor::ReadBackGpuToCpu() const {
   // TODO: we cannot just grab the GL context's lock while holding
   // the view mutex here.
   if (valid_ & kValidOpenGlBuffer) {
-    gl_context_->Run([this]() {
-      glBindBuffer(GL_SHADER_STORAGE_BUFFER, opengl_buffer_);
-      const void* ptr = glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, bytes(),
-                                         GL_MAP_READ_BIT);
-      std::memcpy(cpu_buffer_, ptr, bytes());
-      glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-    });
+    gl_context_->Run(
+        [this]() { ReadOpenGlBuffer(opengl_buffer_, bytes(), cpu_buffer_); });
     return absl::OkStatus();
   }
 #endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
@@ -625,35 +733,21 @@ absl::Status Tensor::ReadBackGpuToCpu() const {
   // yet.
   if (valid_ & kValidOpenGlTexture2d) {
     gl_context_->Run([this]() {
-      const int padded_size =
-          texture_height_ * texture_width_ * 4 * element_size();
-      auto temp_buffer = std::make_unique<uint8_t[]>(padded_size);
-      uint8_t* buffer = temp_buffer.get();
-
-      glBindFramebuffer(GL_FRAMEBUFFER, frame_buffer_);
-      glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-                             GL_TEXTURE_2D, opengl_texture2d_, 0);
-      glPixelStorei(GL_PACK_ALIGNMENT, 4);
-      glReadPixels(0, 0, texture_width_, texture_height_, GL_RGBA, GL_FLOAT,
-                   buffer);
-      uint8_t* dest_buffer = reinterpret_cast<uint8_t*>(cpu_buffer_);
-      const int actual_depth_size = BhwcDepthFromShape(shape_) * element_size();
-      const int num_slices = (BhwcDepthFromShape(shape_) + 3) / 4;
-      const int padded_depth_size = num_slices * 4 * element_size();
-      const int num_elements = BhwcWidthFromShape(shape_) *
-                               BhwcHeightFromShape(shape_) *
-                               BhwcBatchFromShape(shape_);
-      for (int e = 0; e < num_elements; e++) {
-        std::memcpy(dest_buffer, buffer, actual_depth_size);
-        dest_buffer += actual_depth_size;
-        buffer += padded_depth_size;
-      }
+      ReadOpenGlTexture2d(frame_buffer_, opengl_texture2d_, texture_width_,
+                          texture_height_, shape_, element_size(),
+                          cpu_buffer_);
     });
     return absl::OkStatus();
   }
 #endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
 #if __EMSCRIPTEN__ && MEDIAPIPE_USE_WEBGPU
-  // TODO: GetTexture2dData is only supported on Emscripten right now.
+  // TODO: GetBufferData and GetTexture2dData are only supported on
+  // Emscripten right now.
+  if (valid_ & kValidWebGpuBuffer) {
+    return GetBufferData(webgpu_device_, webgpu_device_.GetQueue(),
+                         webgpu_buffer_, bytes(),
+                         reinterpret_cast<uint8_t*>(cpu_buffer_));
+  }
   if (valid_ & kValidWebGpuTexture2d) {
     const int width = BhwcWidthFromShape(shape_);
     const int height = BhwcHeightFromShape(shape_);
@@ -717,6 +811,7 @@ Tensor::CpuReadView Tensor::GetCpuReadView() const {
 #endif  // MEDIAPIPE_TENSOR_USE_AHWB
 
   ABSL_CHECK_OK(AllocateCpuBuffer()) << "AllocateCpuBuffer failed.";
+  ABSL_CHECK_OK(FinishCpuReadback()) << "Asynchronous read-back failed.";
   if (!(valid_ & kValidCpu)) {
     ABSL_CHECK_OK(ReadBackGpuToCpu()) << "ReadBackGpuToCpu failed.";
     valid_ |= kValidCpu;
@@ -724,6 +819,68 @@ Tensor::CpuReadView Tensor::GetCpuReadView() const {
   return {cpu_buffer_, std::move(lock)};
 }
 
+void Tensor::RequestCpuReadAsync() const {
+#if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
+  std::shared_ptr<mediapipe::GlContext> gl_context;
+  std::shared_ptr<CpuReadback> readback;
+  {
+    absl::MutexLock lock(&view_mutex_);
+    // AHardwareBuffers are synchronized with fences by GetCpuReadView.
+    if (ready_on_cpu() || cpu_readback_ || use_ahwb_ ||
+        !(valid_ & (kValidOpenGlBuffer | kValidOpenGlTexture2d))) {
+      return;
+    }
+    if (!AllocateCpuBuffer().ok() || !cpu_buffer_) return;
+    absl::AnyInvocable<absl::Status()> transfer;
+#if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
+    if (valid_ & kValidOpenGlBuffer) {
+      transfer = [gl_context = gl_context_, buffer = opengl_buffer_,
+                  bytes = bytes(), dst = cpu_buffer_]() {
+        return gl_context->Run([&]() {
+          ReadOpenGlBuffer(buffer, bytes, dst);
+          return absl::OkStatus();
+        });
+      };
+    }
+#endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
+    if (!transfer) {
+      transfer = [gl_context = gl_context_, frame_buffer = frame_buffer_,
+                  texture = opengl_texture2d_, width = texture_width_,
+                  height = texture_height_, shape = shape_,
+                  element_size = element_size(), dst = cpu_buffer_]() {
+        return gl_context->Run([&]() {
+          ReadOpenGlTexture2d(frame_buffer, texture, width, height, shape,
+                              element_size, dst);
+          return absl::OkStatus();
+        });
+      };
+    }
+    readback = std::make_shared<CpuReadback>(std::move(transfer));
+    cpu_readback_ = readback;
+    gl_context = gl_context_;
+  }
+  // Do not hold the view mutex while invoking GlContext::RunWithoutWaiting,
+  // since that method may acquire the context's own lock. The task comes after
+  // the GPU work already queued on the context, e.g. the inference that wrote
+  // the tensor.
+  gl_context->RunWithoutWaiting([readback]() { readback->RunIfPending(); });
+#endif  // MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_30
+}
+
+absl::Status Tensor::FinishCpuReadback() const {
+  if (!cpu_readback_) return absl::OkStatus();
+  std::shared_ptr<CpuReadback> readback = std::exchange(cpu_readback_, nullptr);
+  MP_RETURN_IF_ERROR(readback->Wait());
+  valid_ |= kValidCpu;
+  return absl::OkStatus();
+}
+
+void Tensor::CancelCpuReadback() const {
+  if (cpu_readback_) {
+    std::exchange(cpu_readback_, nullptr)->Cancel();
+  }
+}
+
 Tensor::CpuWriteView Tensor::GetCpuWriteView(
     uint64_t source_location_hash) const {
   auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
@@ -735,6 +892,7 @@ Tensor::CpuWriteView Tensor::GetCpuWriteView(
            "Tensor instance are not supported and may lead to undefined "
            "behavior due to lack of synchronization.";
   }
+  CancelCpuReadback();
   valid_ = kValidCpu;
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   if (__builtin_available(android 26, *)) {
@@ -766,7 +924,14 @@ absl::Status Tensor::AllocateCpuBuffer() const {
     // memory page which should match common alignment requirements.
     cpu_buffer_ = AllocateVirtualMemory(bytes());
 #else
-    if (memory_alignment_ > 0) {
+    if (const auto& allocator = CurrentCpuAllocator()) {
+      // The buffer is released with the allocator it was allocated with, even
+      // if it is freed outside of the allocator's scope.
+      cpu_allocator_ = allocator;
+      cpu_buffer_ = allocator->Allocate(
+          std::max(memory_alignment_, bytes()),
+          std::max<size_t>(memory_alignment_, alignof(std::max_align_t)));
+    } else if (memory_alignment_ > 0) {
       // TODO b/339271330 - Investigate how aligned memory performs in
       // MP WebAssembly targets.
       // TfLite custom allocation requires at least memory_alignment_ bytes.
@@ -788,7 +953,11 @@ void Tensor::FreeCpuBuffer() const {
 #if MEDIAPIPE_METAL_ENABLED
   free(cpu_buffer_);
 #else
-  if (memory_alignment_ > 0) {
+  if (cpu_allocator_) {
+    cpu_allocator_->Deallocate(cpu_buffer_,
+                               std::max(memory_alignment_, bytes()));
+    cpu_allocator_ = nullptr;
+  } else if (memory_alignment_ > 0) {
     aligned_free(cpu_buffer_);
   } else {
     free(cpu_buffer_);
@@ -29,6 +29,7 @@
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/cpu_allocator.h"
 #include "mediapipe/framework/formats/tensor/internal.h"
 #include "mediapipe/framework/memory_manager.h"
 // Exports MEDIAPIPE_TENSOR_USE_AHWB macro.
@@ -98,6 +99,13 @@ namespace mediapipe {
 // auto view = tensor.GetCpuReadView();
 // float* pointer = view.buffer<float>();
 // ...reading the cpu memory...
+//
+// The GPU-to-CPU transfer can be started ahead of the CPU view request, so that
+// it overlaps with other work of the calling thread:
+//
+// tensor.RequestCpuReadAsync();
+// ...other work...
+// auto view = tensor.GetCpuReadView();  // Blocks only if not yet transferred.
 
 struct MtlResources;
 class Tensor {
@@ -201,6 +209,14 @@ class Tensor {
   };
   using CpuReadView = CpuView<const void>;
   CpuReadView GetCpuReadView() const;
+  // Starts transferring the tensor contents from an OpenGL buffer or texture
+  // to the CPU without waiting for the transfer to finish. The transfer is
+  // queued on the GL context that holds the data, after the GPU work already
+  // scheduled there. A following GetCpuReadView() blocks only while the
+  // transfer is still in progress, and performs it itself if the GL context
+  // has not started it yet. Does nothing if the data is already on the CPU or
+  // is not held by OpenGL.
+  void RequestCpuReadAsync() const;
   using CpuWriteView = CpuView<void>;
   CpuWriteView GetCpuWriteView(
       uint64_t source_location_hash =
@@ -344,6 +360,33 @@ class Tensor {
       const WebGpuService& service) const;
   WebGpuTexture2dView GetWebGpuTexture2dWriteView(
       const WebGpuService& service) const;
+
+  // A storage buffer holding the tensor densely, in the same layout as the CPU
+  // buffer, so that compute shaders can address any shape and depth.
+  class WebGpuBufferView : public View {
+   public:
+    WebGpuBufferView(WebGpuBufferView&& src)
+        : View(std::move(src.lock_)) {  // Only moves the View portion of src.
+      name_ = std::exchange(src.name_, nullptr);
+    }
+
+    wgpu::Buffer name() const { return name_; }
+
+   protected:
+    friend class Tensor;
+
+    WebGpuBufferView(wgpu::Buffer name,
+                     std::unique_ptr<absl::MutexLock>&& lock)
+        : View(std::move(lock)), name_(name) {}
+
+    wgpu::Buffer name_;
+  };
+
+  // The buffer has Storage, CopySrc and CopyDst usage. A read view uploads the
+  // CPU data if the tensor is not already valid as a WebGPU buffer; there is
+  // no direct conversion from the other GPU storages yet.
+  WebGpuBufferView GetWebGpuBufferReadView(const WebGpuService& service) const;
+  WebGpuBufferView GetWebGpuBufferWriteView(const WebGpuService& service) const;
 #endif  // MEDIAPIPE_USE_WEBGPU
 
 #if MEDIAPIPE_OPENGL_ES_VERSION >= MEDIAPIPE_OPENGL_ES_31
@@ -415,7 +458,7 @@ class Tensor {
   bool ready_on_gpu() const {
     return valid_ &
            (kValidMetalBuffer | kValidOpenGlBuffer | kValidWebGpuTexture2d |
-            kValidAHardwareBuffer | kValidOpenGlTexture2d);
+            kValidWebGpuBuffer | kValidAHardwareBuffer | kValidOpenGlTexture2d);
   }
   bool ready_as_metal_buffer() const { return valid_ & kValidMetalBuffer; }
   bool ready_as_opengl_buffer() const {
@@ -428,12 +471,19 @@ class Tensor {
   bool ready_as_webgpu_texture_2d() const {
     return valid_ & kValidWebGpuTexture2d;
   }
+  bool ready_as_webgpu_buffer() const { return valid_ & kValidWebGpuBuffer; }
 
  private:
   friend class MtlBufferView;
   void Move(Tensor*);
   void Invalidate();
   absl::Status ReadBackGpuToCpu() const;
+  // Waits for the transfer started by RequestCpuReadAsync(), if any, and marks
+  // the CPU buffer valid. Expects view_mutex_ to be held.
+  absl::Status FinishCpuReadback() const;
+  // Drops the transfer started by RequestCpuReadAsync() unless it is already
+  // in progress, in which case waits for it. Expects view_mutex_ to be held.
+  void CancelCpuReadback() const;
 
   ElementType element_type_;
   Shape shape_;
@@ -449,14 +499,21 @@ class Tensor {
     kValidOpenGlTexture2d = 1 << 3,
     kValidWebGpuTexture2d = 1 << 4,
     kValidAHardwareBuffer = 1 << 5,
+    kValidWebGpuBuffer = 1 << 6,
   };
   // A list of resource which are currently allocated and synchronized between
   // each-other: valid_ = kValidCpu | kValidMetalBuffer;
   mutable int valid_ = 0;
   // The mutex is locked by Get*View and is kept by all Views.
   mutable absl::Mutex view_mutex_;
+  // The transfer started by RequestCpuReadAsync(), if it is not finished yet.
+  class CpuReadback;
+  mutable std::shared_ptr<CpuReadback> cpu_readback_;
 
   mutable void* cpu_buffer_ = nullptr;
+  // The allocator of cpu_buffer_, if it was allocated with the current
+  // CpuAllocator.
+  mutable std::shared_ptr<CpuAllocator> cpu_allocator_;
   absl::Status AllocateCpuBuffer() const;
   void FreeCpuBuffer() const;
   // Forward declaration of the MtlResources provides compile-time verification
@@ -466,6 +523,7 @@ class Tensor {
 #if MEDIAPIPE_USE_WEBGPU
   mutable wgpu::Device webgpu_device_;
   mutable wgpu::Texture webgpu_texture2d_;
+  mutable wgpu::Buffer webgpu_buffer_;
 #endif  // MEDIAPIPE_USE_WEBGPU
 #ifdef MEDIAPIPE_TENSOR_USE_AHWB
   mutable std::shared_ptr<HardwareBuffer> ahwb_;
@@ -285,6 +285,7 @@ Tensor::AHardwareBufferView Tensor::GetAHardwareBufferWriteView() const {
            "Tensor instance are not supported and may lead to undefined "
            "behavior due to lack of synchronization.";
   }
+  CancelCpuReadback();
   valid_ = kValidAHardwareBuffer;
 
   EraseCompletedUsages(ahwb_usages_);
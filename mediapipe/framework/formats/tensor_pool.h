@@ -0,0 +1,146 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/gpu/multi_pool.h"
+#include "mediapipe/gpu/reusable_pool.h"
+
+namespace mediapipe {
+
+// Describes a class of interchangeable tensors. Tensors with equal specs can
+// be recycled for one another.
+struct TensorSpec {
+  Tensor::ElementType element_type;
+  std::vector<int> dims;
+  Tensor::QuantizationParameters quantization_parameters;
+  // See Tensor's memory_alignment constructor argument.
+  int memory_alignment = 0;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const TensorSpec& spec) {
+    return H::combine(std::move(h), spec.element_type, spec.dims,
+                      spec.quantization_parameters.scale,
+                      spec.quantization_parameters.zero_point,
+                      spec.memory_alignment);
+  }
+};
+
+inline bool operator==(const TensorSpec& lhs, const TensorSpec& rhs) {
+  return lhs.element_type == rhs.element_type && lhs.dims == rhs.dims &&
+         lhs.quantization_parameters.scale ==
+             rhs.quantization_parameters.scale &&
+         lhs.quantization_parameters.zero_point ==
+             rhs.quantization_parameters.zero_point &&
+         lhs.memory_alignment == rhs.memory_alignment;
+}
+inline bool operator!=(const TensorSpec& lhs, const TensorSpec& rhs) {
+  return !operator==(lhs, rhs);
+}
+
+namespace internal {
+
+// The item stored by the pool. ReusablePool requires a Reuse() method, which
+// Tensor does not have: a recycled tensor keeps all the storages (CPU, SSBO,
+// AHWB, ...) it has allocated so far, and the next write view invalidates
+// whatever it does not write to.
+struct PooledTensor {
+  template <typename... Args>
+  explicit PooledTensor(Args&&... args)
+      : tensor(std::forward<Args>(args)...) {}
+  void Reuse() {}
+
+  Tensor tensor;
+};
+
+// Pools tensors with identical TensorSpec.
+class TensorSpecPool : public ReusablePool<PooledTensor> {
+ public:
+  static std::shared_ptr<TensorSpecPool> Create(
+      const TensorSpec& spec, const MultiPoolOptions& options) {
+    return std::shared_ptr<TensorSpecPool>(new TensorSpecPool(spec, options));
+  }
+  static absl::StatusOr<std::unique_ptr<PooledTensor>> CreateBufferWithoutPool(
+      const TensorSpec& spec) {
+    return std::make_unique<PooledTensor>(
+        spec.element_type, Tensor::Shape(spec.dims),
+        spec.quantization_parameters, /*memory_manager=*/nullptr,
+        spec.memory_alignment);
+  }
+  const TensorSpec& spec() const { return spec_; }
+
+ protected:
+  TensorSpecPool(const TensorSpec& spec, const MultiPoolOptions& options)
+      : ReusablePool<PooledTensor>(
+            [this] { return CreateBufferWithoutPool(spec_); }, options),
+        spec_(spec) {}
+
+  const TensorSpec spec_;
+};
+
+}  // namespace internal
+
+// Vends reusable tensors, so that calculators producing tensors of the same
+// type and shape every frame do not reallocate their CPU and GPU buffers.
+//
+// A tensor goes back to the pool when the last reference to it is released.
+// Since tensors are move-only, pooled tensors are passed around as
+// std::shared_ptr<Tensor>; use ToPacket() to send one in a Packet<Tensor>.
+//
+// Example:
+//   MP_ASSIGN_OR_RETURN(std::shared_ptr<Tensor> tensor,
+//                       pool.GetTensor({Tensor::ElementType::kFloat32,
+//                                       {1, 256, 256, 3}}));
+//   ... write to *tensor ...
+//   kOutTensor(cc).Send(api2::FromOldPacket(TensorPool::ToPacket(
+//       std::move(tensor)).At(cc->InputTimestamp())).As<Tensor>());
+class TensorPool
+    : public MultiPool<internal::TensorSpecPool, TensorSpec,
+                       std::shared_ptr<internal::PooledTensor>> {
+ public:
+  TensorPool() = default;
+
+  explicit TensorPool(const MultiPoolOptions& options)
+      : MultiPool<internal::TensorSpecPool, TensorSpec,
+                  std::shared_ptr<internal::PooledTensor>>(options) {}
+
+  // Returns a tensor matching spec. It is either recycled, in which case its
+  // contents are unspecified, or newly created.
+  absl::StatusOr<std::shared_ptr<Tensor>> GetTensor(const TensorSpec& spec) {
+    MP_ASSIGN_OR_RETURN(auto pooled, Get(spec));
+    return std::shared_ptr<Tensor>(pooled, &pooled->tensor);
+  }
+
+  // Wraps a pooled tensor in a Packet. The tensor returns to the pool once the
+  // packet and all its copies are destroyed.
+  static Packet ToPacket(std::shared_ptr<Tensor> tensor) {
+    const Tensor* ptr = tensor.get();
+    return PointToForeign(ptr, [tensor = std::move(tensor)]() mutable {
+      tensor.reset();
+    });
+  }
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_H_
@@ -0,0 +1,30 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_SERVICE_H_
+#define MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_SERVICE_H_
+
+#include "mediapipe/framework/formats/tensor_pool.h"
+#include "mediapipe/framework/graph_service.h"
+
+namespace mediapipe {
+
+// Graph-wide pool of reusable tensors. Calculators should request it as an
+// optional service and fall back to allocating tensors when it is missing.
+inline constexpr GraphService<TensorPool> kTensorPoolService(
+    "TensorPoolService", GraphServiceBase::kAllowDefaultInitialization);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_FORMATS_TENSOR_POOL_SERVICE_H_
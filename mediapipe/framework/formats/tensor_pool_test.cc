@@ -0,0 +1,128 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/formats/tensor_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+MultiPoolOptions GetTestOptions() {
+  MultiPoolOptions options;
+  options.min_requests_before_pool = 0;
+  return options;
+}
+
+TEST(TensorPoolTest, ReusesReleasedTensor) {
+  TensorPool pool(GetTestOptions());
+  const TensorSpec spec = {Tensor::ElementType::kFloat32, {1, 4, 4, 3}};
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> tensor,
+                          pool.GetTensor(spec));
+  EXPECT_EQ(tensor->element_type(), Tensor::ElementType::kFloat32);
+  EXPECT_EQ(tensor->shape().dims, std::vector<int>({1, 4, 4, 3}));
+  const Tensor* first = tensor.get();
+  tensor.reset();
+
+  MP_ASSERT_OK_AND_ASSIGN(tensor, pool.GetTensor(spec));
+  EXPECT_EQ(tensor.get(), first);
+}
+
+TEST(TensorPoolTest, DoesNotShareTensorsInUse) {
+  TensorPool pool(GetTestOptions());
+  const TensorSpec spec = {Tensor::ElementType::kUInt8, {2, 2}};
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> tensor1,
+                          pool.GetTensor(spec));
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> tensor2,
+                          pool.GetTensor(spec));
+  EXPECT_NE(tensor1.get(), tensor2.get());
+}
+
+TEST(TensorPoolTest, DoesNotMixSpecs) {
+  TensorPool pool(GetTestOptions());
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::shared_ptr<Tensor> tensor,
+      pool.GetTensor({Tensor::ElementType::kFloat32, {1, 8}}));
+  const Tensor* first = tensor.get();
+  tensor.reset();
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      tensor, pool.GetTensor({Tensor::ElementType::kFloat32, {1, 16}}));
+  EXPECT_NE(tensor.get(), first);
+  EXPECT_EQ(tensor->shape().dims, std::vector<int>({1, 16}));
+}
+
+TEST(TensorPoolTest, PacketReturnsTensorToPool) {
+  TensorPool pool(GetTestOptions());
+  const TensorSpec spec = {Tensor::ElementType::kInt32, {3}};
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> tensor,
+                          pool.GetTensor(spec));
+  const Tensor* first = tensor.get();
+  {
+    Packet packet = TensorPool::ToPacket(std::move(tensor));
+    EXPECT_EQ(&packet.Get<Tensor>(), first);
+    MP_ASSERT_OK_AND_ASSIGN(tensor, pool.GetTensor(spec));
+    EXPECT_NE(tensor.get(), first);
+  }
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> recycled,
+                          pool.GetTensor(spec));
+  EXPECT_EQ(recycled.get(), first);
+}
+
+TEST(TensorPoolTest, CountsPoolHitsAndMisses) {
+  MultiPoolOptions options;
+  options.min_requests_before_pool = 2;
+  TensorPool pool(options);
+  const TensorSpec spec = {Tensor::ElementType::kFloat32, {2}};
+
+  MP_ASSERT_OK(pool.GetTensor(spec));
+  MP_ASSERT_OK(pool.GetTensor(spec));
+  MP_ASSERT_OK(pool.GetTensor(spec));
+
+  const MultiPoolStats stats = pool.GetStats();
+  EXPECT_EQ(stats.requests, 3);
+  EXPECT_EQ(stats.pool_misses, 1);
+  EXPECT_EQ(stats.pool_hits, 2);
+  EXPECT_EQ(stats.pools_created, 1);
+  EXPECT_EQ(stats.pools_evicted, 0);
+}
+
+TEST(TensorPoolTest, TrimDropsPoolsButKeepsTensorsInUse) {
+  TensorPool pool(GetTestOptions());
+  const TensorSpec spec = {Tensor::ElementType::kFloat32, {4}};
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> tensor,
+                          pool.GetTensor(spec));
+  pool.Trim(0);
+  EXPECT_EQ(pool.GetStats().pools_evicted, 1);
+  EXPECT_EQ(tensor->shape().dims, std::vector<int>({4}));
+  tensor.reset();
+
+  MP_ASSERT_OK_AND_ASSIGN(tensor, pool.GetTensor(spec));
+  EXPECT_EQ(pool.GetStats().pools_created, 2);
+}
+
+}  // namespace
+}  // namespace mediapipe
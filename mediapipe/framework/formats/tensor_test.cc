@@ -95,6 +95,20 @@ TEST(Cpu, TestViewMove) {
   EXPECT_EQ(v1.buffer<float>(), nullptr);  // NOLINT
 }
 
+TEST(Cpu, TestRequestCpuReadAsync) {
+  Tensor t(Tensor::ElementType::kFloat32, Tensor::Shape{1, 2});
+  {
+    auto view = t.GetCpuWriteView();
+    view.buffer<float>()[0] = 1.0f;
+    view.buffer<float>()[1] = 2.0f;
+  }
+  // The data is already on the CPU, so there is nothing to transfer.
+  t.RequestCpuReadAsync();
+  auto view = t.GetCpuReadView();
+  EXPECT_EQ(view.buffer<float>()[0], 1.0f);
+  EXPECT_EQ(view.buffer<float>()[1], 2.0f);
+}
+
 }  // namespace mediapipe
 
 int main(int argc, char** argv) {
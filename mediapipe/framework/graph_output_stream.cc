@@ -16,6 +16,8 @@
 
 #include "absl/log/absl_check.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/port/status.h"
 
 namespace mediapipe {
@@ -161,6 +163,11 @@ void OutputStreamPollerImpl::SetMaxQueueSize(int queue_size) {
 
 int OutputStreamPollerImpl::QueueSize() { return input_stream_->QueueSize(); }
 
+void OutputStreamPollerImpl::ReserveQueue(int capacity) {
+  ABSL_CHECK_GE(capacity, 0) << "Queue capacity must be non-negative.";
+  input_stream_->ReserveQueue(capacity);
+}
+
 absl::Status OutputStreamPollerImpl::Notify() {
   mutex_.Lock();
   handler_condvar_.Signal();
@@ -222,5 +229,54 @@ bool OutputStreamPollerImpl::Next(Packet* packet) {
   return true;
 }
 
+bool OutputStreamPollerImpl::NextBatch(std::vector<Packet>* packets,
+                                       int max_count, absl::Duration timeout) {
+  ABSL_CHECK(packets);
+  ABSL_CHECK_GT(max_count, 0);
+  packets->clear();
+  const absl::Time deadline = absl::Now() + timeout;
+  bool empty_queue = true;
+  bool timestamp_bound_changed = false;
+  bool timed_out = false;
+  Timestamp min_timestamp = Timestamp::Unset();
+  mutex_.Lock();
+  while (true) {
+    min_timestamp = input_stream_->MinTimestampOrBound(&empty_queue);
+    if (empty_queue) {
+      timestamp_bound_changed =
+          input_stream_handler_->ProcessTimestampBounds() &&
+          output_timestamp_ < min_timestamp.PreviousAllowedInStream();
+    }
+    if (graph_has_error_ || !empty_queue || timestamp_bound_changed ||
+        min_timestamp == Timestamp::Done() || timed_out) {
+      break;
+    } else {
+      timed_out = handler_condvar_.WaitWithDeadline(&mutex_, deadline);
+    }
+  }
+  if (empty_queue && (graph_has_error_ || !timestamp_bound_changed)) {
+    // The graph has an error, the stream is done, or the timeout expired.
+    const bool has_error = graph_has_error_;
+    mutex_.Unlock();
+    return !has_error && min_timestamp != Timestamp::Done();
+  }
+  if (empty_queue) {
+    output_timestamp_ = min_timestamp.PreviousAllowedInStream();
+    packets->push_back(Packet().At(output_timestamp_));
+    mutex_.Unlock();
+    return true;
+  }
+  mutex_.Unlock();
+  // Only this consumer pops from the queue, so it still holds every packet
+  // seen above. One pass pops them all under a single stream lock.
+  bool stream_is_done = false;
+  input_stream_->PopPackets(max_count, packets, &stream_is_done);
+  ABSL_CHECK(!packets->empty());
+  mutex_.Lock();
+  output_timestamp_ = packets->back().Timestamp();
+  mutex_.Unlock();
+  return true;
+}
+
 }  // namespace internal
 }  // namespace mediapipe
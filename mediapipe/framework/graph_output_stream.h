@@ -25,6 +25,7 @@
 #include "absl/log/absl_log.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/input_stream_handler.h"
 #include "mediapipe/framework/input_stream_manager.h"
 #include "mediapipe/framework/output_stream_manager.h"
@@ -157,6 +158,12 @@ class OutputStreamPollerImpl : public GraphOutputStream {
   // Returns the number of packets in the queue.
   int QueueSize();
 
+  // Preallocates the packet queue to hold at least `capacity` packets, so that
+  // the queue is not reallocated while the graph runs as long as no more
+  // packets are pending. Combined with NextBatch(), the consumer drains the
+  // preallocated ring buffer in one pass per wakeup.
+  void ReserveQueue(int capacity);
+
   // Notifies the poller of new packets emitted by the output stream.
   absl::Status Notify() override;
 
@@ -167,6 +174,15 @@ class OutputStreamPollerImpl : public GraphOutputStream {
   // done).  Returns true if successful.
   ABSL_MUST_USE_RESULT bool Next(Packet* packet);
 
+  // Replaces the contents of `packets` with up to `max_count` packets, in
+  // timestamp order. Blocks until at least one packet is available, the
+  // stream is done, or `timeout` expires, and then returns every available
+  // packet up to `max_count` without blocking again. Returns false if the
+  // stream is done or the graph has an error and no packets are available.
+  // Returns true with an empty `packets` if `timeout` expires.
+  ABSL_MUST_USE_RESULT bool NextBatch(std::vector<Packet>* packets,
+                                      int max_count, absl::Duration timeout);
+
  private:
   absl::Mutex mutex_;
   absl::CondVar handler_condvar_ ABSL_GUARDED_BY(mutex_);
@@ -169,9 +169,16 @@ bool InputStreamHandler::ScheduleInvocations(int max_allowance,
         // timestamp in the calculator context. This allows timestamp
         // propagation to be performed only for the first timestamp, and
         // prevents propagation for the subsequent inputs.
-        *input_bound =
-            calculator_context_manager_->GetDefaultCalculatorContext()
-                ->InputTimestamp();
+        CalculatorContext* default_context =
+            calculator_context_manager_->GetDefaultCalculatorContext();
+        *input_bound = default_context->InputTimestamp();
+        if (ScheduleIncompleteBatch(
+                calculator_context_manager_->NumberOfContextTimestamps(
+                    *default_context))) {
+          schedule_callback_(default_context);
+          ++invocations_scheduled;
+          break;
+        }
       } else {
         *input_bound = min_stream_timestamp;
       }
@@ -269,6 +276,7 @@ void InputStreamHandler::AddPackets(CollectionItemId id,
     error_callback_(result);
   }
   if (notify) {
+    StreamUpdated(id);
     notification_();
   }
 }
@@ -284,6 +292,7 @@ void InputStreamHandler::MovePackets(CollectionItemId id,
     error_callback_(result);
   }
   if (notify) {
+    StreamUpdated(id);
     notification_();
   }
 }
@@ -297,6 +306,7 @@ void InputStreamHandler::SetNextTimestampBound(CollectionItemId id,
     error_callback_(result);
   }
   if (notify) {
+    StreamUpdated(id);
     notification_();
   }
 }
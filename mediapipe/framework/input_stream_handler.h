@@ -269,6 +269,19 @@ class InputStreamHandler {
   virtual void FillInputSet(Timestamp input_timestamp,
                             InputStreamShardSet* input_set) = 0;
 
+  // Invoked after packets are added to, or the timestamp bound is advanced on,
+  // the input stream |id|, whenever that changes the stream's
+  // MinTimestampOrBound(). It runs on the producer's thread before the node is
+  // notified, so subclasses that cache per-stream state can mark the stream
+  // stale here instead of rescanning every stream in GetNodeReadiness().
+  virtual void StreamUpdated(CollectionItemId id) {}
+
+  // Invoked when batching is enabled, the node is not ready, and the pending
+  // batch holds only num_timestamps input sets. Returns true to schedule the
+  // incomplete batch now rather than wait for it to fill up or for the node
+  // to close.
+  virtual bool ScheduleIncompleteBatch(int num_timestamps) { return false; }
+
   // Collection of InputStreamManager objects.
   InputStreamManagerSet input_stream_managers_;
   // A pointer to the calculator context manager of the calculator node.
@@ -14,8 +14,8 @@
 
 #include "mediapipe/framework/input_stream_manager.h"
 
+#include <algorithm>
 #include <string>
-#include <type_traits>
 #include <utility>
 
 #include "absl/log/absl_check.h"
@@ -52,28 +52,37 @@ void InputStreamManager::SetQueueSizeCallbacks(
   becomes_not_full_callback_ = becomes_not_full_callback;
 }
 
+void InputStreamManager::SetMemoryCounter(
+    PacketMemoryCounter* memory_counter) {
+  memory_counter_ = memory_counter;
+}
+
 void InputStreamManager::PrepareForRun() {
+  absl::MutexLock producer_lock(&producer_mutex_);
   absl::MutexLock stream_lock(&stream_mutex_);
-  queue_.clear();
+  if (memory_counter_) {
+    for (size_t i = 0; i < queue_.size(); ++i) {
+      ReleasePacketBytes(queue_.At(i));
+    }
+  }
+  queue_.Clear();
   last_reported_stream_full_ = false;
-  num_packets_added_ = 0;
-  next_timestamp_bound_ = Timestamp::PreStream();
+  num_packets_added_.store(0, std::memory_order_relaxed);
+  next_timestamp_bound_.store(Timestamp::PreStream().Value(),
+                              std::memory_order_release);
   last_select_timestamp_ = Timestamp::Unstarted();
-  closed_ = false;
+  closed_.store(false, std::memory_order_release);
   header_ = Packet();
 }
 
-bool InputStreamManager::IsEmpty() const {
-  absl::MutexLock stream_lock(&stream_mutex_);
-  return queue_.empty();
-}
+bool InputStreamManager::IsEmpty() const { return queue_.empty(); }
 
 Packet InputStreamManager::QueueHead() const {
   absl::MutexLock stream_lock(&stream_mutex_);
   if (queue_.empty()) {
     return Packet();
   }
-  return queue_.front();
+  return queue_.Front();
 }
 
 absl::Status InputStreamManager::SetHeader(const Packet& header) {
@@ -97,16 +106,40 @@ absl::Status InputStreamManager::MovePackets(std::list<Packet>* container,
   return AddOrMovePacketsInternal<std::list<Packet>&>(*container, notify);
 }
 
+void InputStreamManager::PushPacket(Packet&& packet) {
+  if (!queue_.TryPush(std::move(packet))) {
+    // The ring buffer is full. Growing it moves the queued packets, so the
+    // consumer must be excluded.
+    absl::MutexLock stream_lock(&stream_mutex_);
+    queue_.Grow();
+    ABSL_CHECK(queue_.TryPush(std::move(packet)));
+  }
+}
+
+void InputStreamManager::RaiseNextTimestampBound(Timestamp bound) {
+  int64_t current = next_timestamp_bound_.load(std::memory_order_relaxed);
+  while (current < bound.Value() &&
+         !next_timestamp_bound_.compare_exchange_weak(
+             current, bound.Value(), std::memory_order_acq_rel,
+             std::memory_order_relaxed)) {
+  }
+}
+
+bool InputStreamManager::IsFullAtSize(size_t queue_size) const {
+  const int max_queue_size = max_queue_size_.load(std::memory_order_relaxed);
+  return max_queue_size != -1 && queue_size >= max_queue_size;
+}
+
 template <typename Container>
 absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
                                                           bool* notify) {
   *notify = false;
-  bool queue_became_non_empty = false;
-  bool queue_became_full = false;
+  int num_pushed = 0;
+  size_t queue_size = 0;
   {
     // Scope to prevent locking the stream when notification is called.
-    absl::MutexLock stream_lock(&stream_mutex_);
-    if (closed_) {
+    absl::MutexLock producer_lock(&producer_mutex_);
+    if (closed_.load(std::memory_order_acquire)) {
       // There are some elaborate use cases where adding to an already closed
       // stream may be fine (e.g. CalculatorGraph.DirectFormII test case).
       // However, high chances packet dropping indicates issues in calculators
@@ -122,11 +155,6 @@ absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
           name_);
       return absl::OkStatus();
     }
-    // Check if the queue was full before packets came in.
-    bool was_queue_full =
-        (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
-    // Check if the queue becomes non-empty.
-    queue_became_non_empty = queue_.empty() && !container.empty();
     for (auto& packet : container) {
       absl::Status result = packet_type_->Validate(packet);
       if (!result.ok()) {
@@ -149,18 +177,20 @@ absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
         // is also true for PreStream() but doesn't need to be checked because
         // Timestamp::PreStream().NextAllowedInStream() is
         // Timestamp::OneOverPostStream().
-        if (timestamp == Timestamp::PostStream() && num_packets_added_ > 0) {
+        if (timestamp == Timestamp::PostStream() &&
+            num_packets_added_.load(std::memory_order_relaxed) > 0) {
           return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
                  << "In stream \"" << name_
                  << "\", a packet at Timestamp::PostStream() must be the only "
                     "Packet in an InputStream.";
         }
-        if (timestamp < next_timestamp_bound_) {
+        const Timestamp next_timestamp_bound = NextTimestampBound();
+        if (timestamp < next_timestamp_bound) {
           return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
                  << "Packet timestamp mismatch on a calculator receiving from "
                     "stream \""
                  << name_ << "\". Current minimum expected timestamp is "
-                 << next_timestamp_bound_.DebugString() << " but received "
+                 << next_timestamp_bound.DebugString() << " but received "
                  << timestamp.DebugString()
                  << ". Are you using a custom InputStreamHandler? Note that "
                     "some InputStreamHandlers allow timestamps that are not "
@@ -168,30 +198,47 @@ absl::Status InputStreamManager::AddOrMovePacketsInternal(Container container,
                     "ImmediateInputStreamHandler class comment.";
         }
       }
-      next_timestamp_bound_ = timestamp.NextAllowedInStream();
 
       // If the caller is MovePackets(), packet's underlying holder should be
       // transferred into queue_. Otherwise, queue_ keeps a copy of the packet.
-      ++num_packets_added_;
+      num_packets_added_.fetch_add(1, std::memory_order_relaxed);
       VLOG(3) << "Input stream:" << name_
               << " has added packet at time: " << packet.Timestamp();
-      if (std::is_const<
-              typename std::remove_reference<Container>::type>::value) {
-        queue_.emplace_back(packet);
+      // The bytes are counted before the consumer can pop the packet.
+      if (memory_counter_) memory_counter_->Add(EstimatePacketBytes(packet));
+      // For a const container, std::move() yields a const rvalue and the
+      // Packet constructor below copies.
+      PushPacket(Packet(std::move(packet)));
+      ++num_pushed;
+
+      // The bound is raised only after the packet is visible in queue_.
+      if (enable_timestamps_) {
+        RaiseNextTimestampBound(timestamp.NextAllowedInStream());
       } else {
-        queue_.emplace_back(std::move(packet));
+        // Without timestamps only the producer and Close() (which excludes
+        // the producer) write the bound.
+        next_timestamp_bound_.store(timestamp.NextAllowedInStream().Value(),
+                                    std::memory_order_release);
       }
     }
-    queue_became_full = (!was_queue_full && max_queue_size_ != -1 &&
-                         queue_.size() >= max_queue_size_);
-    if (queue_.size() > 1) {
+    queue_size = queue_.size();
+    if (queue_size > 1) {
       VLOG(3) << "Queue size greater than 1: stream name: " << name_
-              << " queue_size: " << queue_.size();
+              << " queue_size: " << queue_size;
     }
-    VLOG(3) << "Input stream:" << name_
-            << " becomes non-empty status:" << queue_became_non_empty
-            << " Size: " << queue_.size();
   }
+  // The consumer may pop concurrently, so the transitions are evaluated
+  // against a single snapshot of the queue size taken after the packets were
+  // pushed. If older packets are still queued at that point, the consumer has
+  // yet to pop them and will see the new packets when it does.
+  const bool queue_became_non_empty =
+      num_pushed > 0 && queue_size <= num_pushed;
+  const bool queue_became_full =
+      num_pushed > 0 && IsFullAtSize(queue_size) &&
+      !IsFullAtSize(queue_size - std::min<size_t>(queue_size, num_pushed));
+  VLOG(3) << "Input stream:" << name_
+          << " becomes non-empty status:" << queue_became_non_empty
+          << " Size: " << queue_size;
   if (queue_became_full) {
     VLOG(3) << "Queue became full: " << Name();
     becomes_full_callback_(this, &last_reported_stream_full_);
@@ -205,27 +252,28 @@ absl::Status InputStreamManager::SetNextTimestampBound(const Timestamp bound,
   *notify = false;
   {
     // Scope to prevent locking the stream when notification is called.
-    absl::MutexLock stream_lock(&stream_mutex_);
-    if (closed_) {
+    absl::MutexLock producer_lock(&producer_mutex_);
+    if (closed_.load(std::memory_order_acquire)) {
       return absl::OkStatus();
     }
 
-    if (enable_timestamps_ && bound < next_timestamp_bound_) {
+    const Timestamp next_timestamp_bound = NextTimestampBound();
+    if (enable_timestamps_ && bound < next_timestamp_bound) {
       return mediapipe::UnknownErrorBuilder(MEDIAPIPE_LOC)
              << "SetNextTimestampBound must be called with a timestamp greater "
                 "than or equal to the current bound. In stream \""
              << name_ << "\". Current minimum expected timestamp is "
-             << next_timestamp_bound_.DebugString() << " but received "
+             << next_timestamp_bound.DebugString() << " but received "
              << bound.DebugString();
     }
 
     // Even if enable_timestamps_ is false, Timestamp::Done() is used to
     // indicate the end of stream. So this code is common to both timed and
     // untimed scheduling policies.
-    if (bound > next_timestamp_bound_) {
-      next_timestamp_bound_ = bound;
+    if (bound > next_timestamp_bound) {
+      RaiseNextTimestampBound(bound);
       VLOG(3) << "Next timestamp bound for input " << name_ << " is "
-              << next_timestamp_bound_;
+              << bound;
       if (queue_.empty()) {
         // If the queue was not empty then a change to the next_timestamp_bound_
         // is not detectable by the consumer.
@@ -239,26 +287,32 @@ absl::Status InputStreamManager::SetNextTimestampBound(const Timestamp bound,
 void InputStreamManager::DisableTimestamps() { enable_timestamps_ = false; }
 
 void InputStreamManager::Close() {
+  absl::MutexLock producer_lock(&producer_mutex_);
   absl::MutexLock stream_lock(&stream_mutex_);
-  if (closed_) {
+  if (closed_.load(std::memory_order_relaxed)) {
     return;
   }
-  next_timestamp_bound_ = Timestamp::Done();
+  next_timestamp_bound_.store(Timestamp::Done().Value(),
+                              std::memory_order_release);
   last_select_timestamp_ = Timestamp::Done();
-  closed_ = true;
+  closed_.store(true, std::memory_order_release);
 }
 
 Timestamp InputStreamManager::MinTimestampOrBound(bool* is_empty) const {
   absl::MutexLock stream_lock(&stream_mutex_);
-  if (is_empty) {
-    *is_empty = queue_.empty();
-  }
-  return MinTimestampOrBoundHelper();
+  return MinTimestampOrBoundHelper(is_empty);
 }
 
-Timestamp InputStreamManager::MinTimestampOrBoundHelper() const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(stream_mutex_) {
-  return queue_.empty() ? next_timestamp_bound_ : queue_.front().Timestamp();
+Timestamp InputStreamManager::MinTimestampOrBoundHelper(
+    bool* is_empty) const {
+  // The bound must be loaded before the queue is inspected, see
+  // next_timestamp_bound_.
+  const Timestamp bound = NextTimestampBound();
+  const bool empty = queue_.empty();
+  if (is_empty) {
+    *is_empty = empty;
+  }
+  return empty ? bound : queue_.Front().Timestamp();
 }
 
 Packet InputStreamManager::PopPacketAtTimestamp(Timestamp timestamp,
@@ -267,7 +321,8 @@ Packet InputStreamManager::PopPacketAtTimestamp(Timestamp timestamp,
   ABSL_CHECK(enable_timestamps_);
   *num_packets_dropped = -1;
   *stream_is_done = false;
-  bool queue_became_non_full = false;
+  int num_popped = 0;
+  size_t queue_size = 0;
   Packet packet;
   {
     absl::MutexLock stream_lock(&stream_mutex_);
@@ -277,41 +332,37 @@ Packet InputStreamManager::PopPacketAtTimestamp(Timestamp timestamp,
 
     // Make sure AddPacket and SetNextTimestampBound are not called with
     // timestamps we have already passed.
-    if (next_timestamp_bound_ <= timestamp) {
-      next_timestamp_bound_ = timestamp.NextAllowedInStream();
-    }
+    RaiseNextTimestampBound(timestamp.NextAllowedInStream());
 
     VLOG(3) << "Input stream " << name_
             << " selecting at timestamp:" << timestamp.Value()
-            << " next timestamp bound: " << next_timestamp_bound_;
+            << " next timestamp bound: " << NextTimestampBound();
 
     // Advances time to timestamp.
     Timestamp current_timestamp = Timestamp::Unset();
 
-    // Checks if queue is full.
-    bool was_queue_full =
-        (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
-
-    while (!queue_.empty() && queue_.front().Timestamp() <= timestamp) {
-      packet = std::move(queue_.front());
-      queue_.pop_front();
+    while (!queue_.empty() && queue_.Front().Timestamp() <= timestamp) {
+      packet = std::move(queue_.Front());
+      queue_.PopFront();
+      ReleasePacketBytes(packet);
       current_timestamp = packet.Timestamp();
       ++(*num_packets_dropped);
+      ++num_popped;
     }
     // Clear value_ if it doesn't have exactly the right timestamp.
     if (current_timestamp != timestamp) {
       // The timestamp bound reported when no packet is sent.
-      Timestamp bound = MinTimestampOrBoundHelper();
+      Timestamp bound = MinTimestampOrBoundHelper(/*is_empty=*/nullptr);
       packet = Packet().At(bound.PreviousAllowedInStream());
       ++(*num_packets_dropped);
     }
 
+    queue_size = queue_.size();
     VLOG(3) << "Input stream removed packets:" << name_
-            << " Size:" << queue_.size();
-    queue_became_non_full = (was_queue_full && queue_.size() < max_queue_size_);
+            << " Size:" << queue_size;
     *stream_is_done = IsDone();
   }
-  if (queue_became_non_full) {
+  if (IsFullAtSize(queue_size + num_popped) && !IsFullAtSize(queue_size)) {
     VLOG(3) << "Queue became non-full: " << Name();
     becomes_not_full_callback_(this, &last_reported_stream_full_);
   }
@@ -321,59 +372,94 @@ Packet InputStreamManager::PopPacketAtTimestamp(Timestamp timestamp,
 Packet InputStreamManager::PopQueueHead(bool* stream_is_done) {
   ABSL_CHECK(!enable_timestamps_);
   *stream_is_done = false;
-  bool queue_became_non_full = false;
+  int num_popped = 0;
+  size_t queue_size = 0;
   Packet packet;
   {
     absl::MutexLock stream_lock(&stream_mutex_);
 
     VLOG(3) << "Input stream " << name_ << " selecting at queue head";
 
-    // Check if queue is full.
-    bool was_queue_full =
-        (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
-
     if (!queue_.empty()) {
-      packet = std::move(queue_.front());
-      queue_.pop_front();
+      packet = std::move(queue_.Front());
+      queue_.PopFront();
+      ReleasePacketBytes(packet);
+      ++num_popped;
     } else {
       packet = Packet();
     }
 
+    queue_size = queue_.size();
     VLOG(3) << "Input stream removed a packet:" << name_
-            << " Size:" << queue_.size();
-    queue_became_non_full = (was_queue_full && queue_.size() < max_queue_size_);
+            << " Size:" << queue_size;
     *stream_is_done = IsDone();
   }
-  if (queue_became_non_full) {
+  if (IsFullAtSize(queue_size + num_popped) && !IsFullAtSize(queue_size)) {
     VLOG(3) << "Queue became non-full: " << Name();
     becomes_not_full_callback_(this, &last_reported_stream_full_);
   }
   return packet;
 }
 
+int InputStreamManager::PopPackets(int max_count,
+                                   std::vector<Packet>* packets,
+                                   bool* stream_is_done) {
+  ABSL_CHECK(enable_timestamps_);
+  *stream_is_done = false;
+  int num_popped = 0;
+  size_t queue_size = 0;
+  {
+    absl::MutexLock stream_lock(&stream_mutex_);
+    while (num_popped < max_count && !queue_.empty()) {
+      Timestamp timestamp = queue_.Front().Timestamp();
+      ABSL_CHECK_LE(last_select_timestamp_, timestamp);
+      last_select_timestamp_ = timestamp;
+      RaiseNextTimestampBound(timestamp.NextAllowedInStream());
+      packets->push_back(std::move(queue_.Front()));
+      queue_.PopFront();
+      ReleasePacketBytes(packets->back());
+      ++num_popped;
+    }
+
+    queue_size = queue_.size();
+    VLOG(3) << "Input stream removed " << num_popped << " packets:" << name_
+            << " Size:" << queue_size;
+    *stream_is_done = IsDone();
+  }
+  if (IsFullAtSize(queue_size + num_popped) && !IsFullAtSize(queue_size)) {
+    VLOG(3) << "Queue became non-full: " << Name();
+    becomes_not_full_callback_(this, &last_reported_stream_full_);
+  }
+  return num_popped;
+}
+
+void InputStreamManager::ReserveQueue(int capacity) {
+  absl::MutexLock producer_lock(&producer_mutex_);
+  absl::MutexLock stream_lock(&stream_mutex_);
+  queue_.Reserve(capacity);
+}
+
 int InputStreamManager::NumPacketsAdded() const {
-  absl::MutexLock lock(&stream_mutex_);
-  return num_packets_added_;
+  return num_packets_added_.load(std::memory_order_relaxed);
 }
 
 int InputStreamManager::QueueSize() const {
-  absl::MutexLock lock(&stream_mutex_);
   return static_cast<int>(queue_.size());
 }
 
 int InputStreamManager::MaxQueueSize() const {
-  absl::MutexLock lock(&stream_mutex_);
-  return max_queue_size_;
+  return max_queue_size_.load(std::memory_order_relaxed);
 }
 
 void InputStreamManager::SetMaxQueueSize(int max_queue_size) {
   bool was_full;
   bool is_full;
   {
-    absl::MutexLock lock(&stream_mutex_);
-    was_full = (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
-    max_queue_size_ = max_queue_size;
-    is_full = (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
+    absl::MutexLock producer_lock(&producer_mutex_);
+    absl::MutexLock stream_lock(&stream_mutex_);
+    was_full = IsFullAtSize(queue_.size());
+    max_queue_size_.store(max_queue_size, std::memory_order_relaxed);
+    is_full = IsFullAtSize(queue_.size());
   }
 
   // QueueSizeCallback is called with no mutexes held.
@@ -386,43 +472,42 @@ void InputStreamManager::SetMaxQueueSize(int max_queue_size) {
   }
 }
 
-bool InputStreamManager::IsFull() const {
-  absl::MutexLock lock(&stream_mutex_);
-  return max_queue_size_ != -1 && queue_.size() >= max_queue_size_;
-}
+bool InputStreamManager::IsFull() const { return IsFullAtSize(queue_.size()); }
 
 Timestamp InputStreamManager::GetMinTimestampAmongNLatest(int n) const {
   absl::MutexLock lock(&stream_mutex_);
-  if (queue_.empty()) {
+  const size_t queue_size = queue_.size();
+  if (queue_size == 0) {
     return Timestamp::Unset();
   }
-  return (queue_.cend() - std::min((size_t)n, queue_.size()))->Timestamp();
+  return queue_.At(queue_size - std::min((size_t)n, queue_size)).Timestamp();
 }
 
 void InputStreamManager::ErasePacketsEarlierThan(Timestamp timestamp) {
-  bool queue_became_non_full = false;
+  int num_popped = 0;
+  size_t queue_size = 0;
   {
     absl::MutexLock lock(&stream_mutex_);
-    // Checks if queue is full.
-    bool was_queue_full =
-        (max_queue_size_ != -1 && queue_.size() >= max_queue_size_);
-
-    while (!queue_.empty() && queue_.front().Timestamp() < timestamp) {
-      queue_.pop_front();
+    while (!queue_.empty() && queue_.Front().Timestamp() < timestamp) {
+      ReleasePacketBytes(queue_.Front());
+      queue_.PopFront();
+      ++num_popped;
     }
 
+    queue_size = queue_.size();
     VLOG(3) << "Input stream removed packets:" << name_
-            << " Size:" << queue_.size();
-    queue_became_non_full = (was_queue_full && queue_.size() < max_queue_size_);
+            << " Size:" << queue_size;
   }
-  if (queue_became_non_full) {
+  if (IsFullAtSize(queue_size + num_popped) && !IsFullAtSize(queue_size)) {
     VLOG(3) << "Queue became non-full: " << Name();
     becomes_not_full_callback_(this, &last_reported_stream_full_);
   }
 }
 
 bool InputStreamManager::IsDone() const {
-  return queue_.empty() && next_timestamp_bound_ == Timestamp::Done();
+  // The bound must be loaded before the queue is inspected, see
+  // next_timestamp_bound_.
+  return NextTimestampBound() == Timestamp::Done() && queue_.empty();
 }
 
 }  // namespace mediapipe
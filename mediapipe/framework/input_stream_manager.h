@@ -15,18 +15,21 @@
 #ifndef MEDIAPIPE_FRAMEWORK_INPUT_STREAM_MANAGER_H_
 #define MEDIAPIPE_FRAMEWORK_INPUT_STREAM_MANAGER_H_
 
+#include <atomic>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_size.h"
 #include "mediapipe/framework/packet_type.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/spsc_ring_buffer.h"
 #include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
@@ -43,6 +46,14 @@ namespace mediapipe {
 // An input stream is written to by exactly one output stream and is read by a
 // single node. None of its methods should hold a lock when they invoke a
 // callback in the scheduler.
+//
+// Since every stream has a single producer and a single consumer, packets are
+// kept in a single-producer/single-consumer ring buffer. The producer side
+// (AddPackets, MovePackets, SetNextTimestampBound) is serialized by
+// producer_mutex_ and the consumer side by stream_mutex_, so the upstream and
+// downstream nodes never contend for the same lock on the per-packet path.
+// Rare operations (Close, PrepareForRun, SetMaxQueueSize and growing the ring
+// buffer) hold both mutexes.
 class InputStreamManager {
  public:
   // Function type for becomes_full_callback and becomes_not_full_callback.
@@ -76,7 +87,7 @@ class InputStreamManager {
 
   // Reset the input stream for another run of the graph (i.e. another
   // image/video/audio).
-  void PrepareForRun() ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  void PrepareForRun() ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
   // Adds a list of timestamped packets. Sets "notify" to true if the queue
   // becomes non-empty. Does nothing if the input stream is closed.
@@ -91,16 +102,16 @@ class InputStreamManager {
   //   stream.
   // Violation of any of these conditions causes an error status.
   absl::Status AddPackets(const std::list<Packet>& container, bool* notify)
-      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+      ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
   // Move a list of timestamped packets. Sets "notify" to true if the queue
   // becomes non-empty. Does nothing if the input stream is closed. After the
   // move, all packets in the container must be empty.
   absl::Status MovePackets(std::list<Packet>* container, bool* notify)
-      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+      ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
   // Closes the input stream.  This function can be called multiple times.
-  void Close() ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  void Close() ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
   // Sets the bound on the next timestamp to be added to the input stream.
   // Sets "notify" to true if the bound is advanced while the packet queue is
@@ -108,7 +119,7 @@ class InputStreamManager {
   // DisableTimestamps() is called. Does nothing if the input stream is
   // closed.
   absl::Status SetNextTimestampBound(Timestamp bound, bool* notify)
-      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+      ABSL_LOCKS_EXCLUDED(producer_mutex_);
 
   // Returns the smallest timestamp at which we might see an input in
   // this input stream. This is the timestamp of the first item in the queue if
@@ -121,7 +132,7 @@ class InputStreamManager {
   void DisableTimestamps();
 
   // Returns true iff the queue is empty.
-  bool IsEmpty() const ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  bool IsEmpty() const;
 
   // If the queue is not empty, returns the packet at the front of the queue.
   // Otherwise, returns an empty packet.
@@ -145,22 +156,37 @@ class InputStreamManager {
   // Timestamp::Done() after the pop.
   Packet PopQueueHead(bool* stream_is_done) ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
-  // Returns the number of packets in the queue.
-  int NumPacketsAdded() const ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  // Pops up to "max_count" packets from the head of the queue and appends
+  // them to "packets", in timestamp order. Advances time as if
+  // PopPacketAtTimestamp() were called at the timestamp of each popped packet,
+  // so no packets are dropped. Returns the number of packets popped. Sets
+  // "stream_is_done" if the next timestamp bound reaches Timestamp::Done()
+  // after the pops.
+  int PopPackets(int max_count, std::vector<Packet>* packets,
+                 bool* stream_is_done) ABSL_LOCKS_EXCLUDED(stream_mutex_);
+
+  // Preallocates the queue to hold at least "capacity" packets, so that
+  // adding up to that many packets never reallocates it.
+  void ReserveQueue(int capacity)
+      ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
+
+  // Returns the number of packets added to the queue.
+  int NumPacketsAdded() const;
 
   // Returns the number of packets in the queue.
-  int QueueSize() const ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  int QueueSize() const;
 
   // Returns true iff the queue is full.
-  bool IsFull() const ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  bool IsFull() const;
 
   // Returns the max queue size. -1 indicates that there is no maximum.
-  int MaxQueueSize() const ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  int MaxQueueSize() const;
 
   // Sets the maximum queue size for the stream. Used to determine when the
   // callbacks for becomes_full and becomes_not_full should be invoked. A value
   // of -1 means that there is no maximum queue size.
-  void SetMaxQueueSize(int max_queue_size) ABSL_LOCKS_EXCLUDED(stream_mutex_);
+  void SetMaxQueueSize(int max_queue_size)
+      ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
   // If there are equal to or more than n packets in the queue, this function
   // returns the min timestamp of among the latest n packets of the queue.  If
@@ -175,6 +201,11 @@ class InputStreamManager {
   void ErasePacketsEarlierThan(Timestamp timestamp)
       ABSL_LOCKS_EXCLUDED(stream_mutex_);
 
+  // Counts the estimated bytes of the queued packets in |memory_counter|, see
+  // packet_size.h. Pass nullptr to disable counting. Must be called before
+  // the graph runs; |memory_counter| must outlive the stream.
+  void SetMemoryCounter(PacketMemoryCounter* memory_counter);
+
   // If a maximum queue size is specified (!= -1), these callbacks that are
   // invoked when the input queue becomes full (>= max_queue_size_) or when it
   // becomes non-full (< max_queue_size_).
@@ -190,24 +221,62 @@ class InputStreamManager {
   // non-const reference.
   template <typename Container>
   absl::Status AddOrMovePacketsInternal(Container container, bool* notify)
-      ABSL_LOCKS_EXCLUDED(stream_mutex_);
+      ABSL_LOCKS_EXCLUDED(producer_mutex_, stream_mutex_);
 
-  // Returns true if the next timestamp bound reaches Timestamp::Done().
+  // Appends a packet to queue_, growing queue_ if it is full.
+  void PushPacket(Packet&& packet)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(producer_mutex_)
+          ABSL_LOCKS_EXCLUDED(stream_mutex_);
+
+  // Subtracts the estimated bytes of popped packets from memory_counter_.
+  void ReleasePacketBytes(const Packet& packet) {
+    if (memory_counter_) memory_counter_->Add(-EstimatePacketBytes(packet));
+  }
+
+  // Returns the next timestamp bound.
+  Timestamp NextTimestampBound() const {
+    return Timestamp::CreateNoErrorChecking(
+        next_timestamp_bound_.load(std::memory_order_acquire));
+  }
+
+  // Raises the next timestamp bound to "bound" unless it is already at or
+  // above it. Both the producer and the consumer raise the bound.
+  void RaiseNextTimestampBound(Timestamp bound);
+
+  // Returns true if a queue of "queue_size" packets is full.
+  bool IsFullAtSize(size_t queue_size) const;
+
+  // Returns true if the next timestamp bound reaches Timestamp::Done() and
+  // the queue is empty.
   bool IsDone() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(stream_mutex_);
 
   // Returns the smallest timestamp at which this stream might see an input.
-  Timestamp MinTimestampOrBoundHelper() const;
-
+  // Sets *is_empty to whether the queue was empty, if is_empty is not null.
+  Timestamp MinTimestampOrBoundHelper(bool* is_empty) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(stream_mutex_);
+
+  // Serializes the producer side. Acquired before stream_mutex_ when both are
+  // needed.
+  mutable absl::Mutex producer_mutex_ ABSL_ACQUIRED_BEFORE(stream_mutex_);
+  // Serializes the consumer side and guards the header.
   mutable absl::Mutex stream_mutex_;
-  std::deque<Packet> queue_ ABSL_GUARDED_BY(stream_mutex_);
+  // The producer pushes with producer_mutex_ held, the consumer reads and pops
+  // with stream_mutex_ held. Growing and clearing require both mutexes.
+  internal::SpscRingBuffer<Packet> queue_;
   // The number of packets added to queue_.  Used to verify a packet at
-  // Timestamp::PostStream() is the only Packet in the stream.
-  int64_t num_packets_added_ ABSL_GUARDED_BY(stream_mutex_);
-  Timestamp next_timestamp_bound_ ABSL_GUARDED_BY(stream_mutex_);
+  // Timestamp::PostStream() is the only Packet in the stream. Written with
+  // producer_mutex_ held.
+  std::atomic<int64_t> num_packets_added_{0};
+  // The value of the next timestamp bound. Packets are pushed to queue_
+  // before the bound is raised past them, and readers load the bound before
+  // inspecting queue_, so a reader that sees a raised bound also sees the
+  // packets below it.
+  std::atomic<int64_t> next_timestamp_bound_{Timestamp::PreStream().Value()};
   // The |timestamp| argument passed to the last SelectAtTimestamp() call.
   // Ignored if enable_timestamps_ is false.
   Timestamp last_select_timestamp_ ABSL_GUARDED_BY(stream_mutex_);
-  bool closed_ ABSL_GUARDED_BY(stream_mutex_);
+  // Written with both mutexes held.
+  std::atomic<bool> closed_{false};
   // True if packet timestamps are used.
   bool enable_timestamps_ = true;
   std::string name_;
@@ -216,8 +285,12 @@ class InputStreamManager {
   // The header packet of the input stream.
   Packet header_ ABSL_GUARDED_BY(stream_mutex_);
 
-  // The maximum queue size for this stream if set.
-  int max_queue_size_ ABSL_GUARDED_BY(stream_mutex_) = -1;
+  // The maximum queue size for this stream if set. Written with both mutexes
+  // held.
+  std::atomic<int> max_queue_size_{-1};
+
+  // Counts the bytes of the queued packets, if memory accounting is enabled.
+  PacketMemoryCounter* memory_counter_ = nullptr;
 
   // Callback to notify the framework that we have hit the maximum queue size.
   QueueSizeCallback becomes_full_callback_;
@@ -0,0 +1,116 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// Benchmarks for adding packets to and popping packets from an
+// InputStreamManager.
+#include <list>
+
+#include "absl/log/absl_check.h"
+#include "mediapipe/framework/input_stream_manager.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_type.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+class InputStreamManagerFixture {
+ public:
+  InputStreamManagerFixture() {
+    packet_type_.Set<int>();
+    ABSL_CHECK_OK(manager_.Initialize("input", &packet_type_,
+                                      /*back_edge=*/false));
+    manager_.PrepareForRun();
+  }
+
+  InputStreamManager& manager() { return manager_; }
+
+ private:
+  PacketType packet_type_;
+  InputStreamManager manager_;
+};
+
+// Adds a batch of packets, then pops them one at a time by timestamp, as the
+// default input stream handler does.
+void BM_AddAndPopPacketAtTimestamp(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  InputStreamManagerFixture fixture;
+  InputStreamManager& manager = fixture.manager();
+  int64_t t = 0;
+  for (auto _ : state) {
+    std::list<Packet> packets;
+    for (int i = 0; i < batch_size; ++i) {
+      packets.push_back(MakePacket<int>(i).At(Timestamp(t + i)));
+    }
+    bool notify = false;
+    ABSL_CHECK_OK(manager.MovePackets(&packets, &notify));
+    for (int i = 0; i < batch_size; ++i) {
+      int num_dropped = 0;
+      bool stream_is_done = false;
+      Packet packet = manager.PopPacketAtTimestamp(
+          Timestamp(t + i), &num_dropped, &stream_is_done);
+      benchmark::DoNotOptimize(packet);
+    }
+    t += batch_size;
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_AddAndPopPacketAtTimestamp)->Arg(1)->Arg(16)->Arg(256);
+
+// Same as above but copies the packets in with AddPackets, as output streams
+// with more than one mirror do.
+void BM_AddCopiesAndPopQueueHead(benchmark::State& state) {
+  const int batch_size = state.range(0);
+  InputStreamManagerFixture fixture;
+  InputStreamManager& manager = fixture.manager();
+  int64_t t = 0;
+  for (auto _ : state) {
+    std::list<Packet> packets;
+    for (int i = 0; i < batch_size; ++i) {
+      packets.push_back(MakePacket<int>(i).At(Timestamp(t + i)));
+    }
+    bool notify = false;
+    ABSL_CHECK_OK(manager.AddPackets(packets, &notify));
+    for (int i = 0; i < batch_size; ++i) {
+      bool stream_is_done = false;
+      Packet packet = manager.PopQueueHead(&stream_is_done);
+      benchmark::DoNotOptimize(packet);
+    }
+    t += batch_size;
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+BENCHMARK(BM_AddCopiesAndPopQueueHead)->Arg(1)->Arg(16)->Arg(256);
+
+// Queries the timestamp bound, which input stream handlers do for every
+// stream whenever readiness is rechecked.
+void BM_MinTimestampOrBound(benchmark::State& state) {
+  InputStreamManagerFixture fixture;
+  InputStreamManager& manager = fixture.manager();
+  std::list<Packet> packets = {MakePacket<int>(0).At(Timestamp(0))};
+  bool notify = false;
+  ABSL_CHECK_OK(manager.MovePackets(&packets, &notify));
+  for (auto _ : state) {
+    bool is_empty = false;
+    benchmark::DoNotOptimize(manager.MinTimestampOrBound(&is_empty));
+  }
+}
+BENCHMARK(BM_MinTimestampOrBound);
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -14,9 +14,13 @@
 
 #include "mediapipe/framework/input_stream_manager.h"
 
+#include <list>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
 #include "mediapipe/framework/input_stream_shard.h"
 #include "mediapipe/framework/lifetime_tracker.h"
 #include "mediapipe/framework/packet.h"
@@ -245,6 +249,36 @@ TEST_F(InputStreamManagerTest, AddPacketsReverseTimestamps) {
   EXPECT_FALSE(notify_);
 }
 
+TEST_F(InputStreamManagerTest, PopPackets) {
+  input_stream_manager_->ReserveQueue(8);
+  std::list<Packet> packets;
+  for (int i = 1; i <= 3; ++i) {
+    packets.push_back(MakePacket<std::string>(absl::StrCat("packet ", i))
+                          .At(Timestamp(i * 10)));
+  }
+  MP_ASSERT_OK(input_stream_manager_->AddPackets(packets, &notify_));
+  EXPECT_TRUE(notify_);
+
+  std::vector<Packet> popped_packets;
+  EXPECT_EQ(2, input_stream_manager_->PopPackets(/*max_count=*/2,
+                                                 &popped_packets,
+                                                 &stream_is_done_));
+  ASSERT_EQ(2, popped_packets.size());
+  EXPECT_EQ("packet 1", popped_packets[0].Get<std::string>());
+  EXPECT_EQ(Timestamp(20), popped_packets[1].Timestamp());
+  EXPECT_FALSE(stream_is_done_);
+  EXPECT_EQ(Timestamp(30), input_stream_manager_->QueueHead().Timestamp());
+
+  input_stream_manager_->Close();
+  EXPECT_EQ(1, input_stream_manager_->PopPackets(/*max_count=*/2,
+                                                 &popped_packets,
+                                                 &stream_is_done_));
+  ASSERT_EQ(3, popped_packets.size());
+  EXPECT_EQ("packet 3", popped_packets[2].Get<std::string>());
+  EXPECT_TRUE(stream_is_done_);
+  EXPECT_TRUE(input_stream_manager_->IsEmpty());
+}
+
 TEST_F(InputStreamManagerTest, PopPacketAtTimestamp) {
   std::string expected_value_at_10("packet 1");
   std::string expected_value_at_20("packet 2");
@@ -14,6 +14,8 @@
 
 #include "mediapipe/framework/output_stream_handler.h"
 
+#include <algorithm>
+
 #include "absl/log/absl_check.h"
 #include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/collection_item_id.h"
@@ -102,7 +104,11 @@ void OutputStreamHandler::PostProcess(Timestamp input_timestamp) {
   }
   {
     absl::MutexLock lock(&timestamp_mutex_);
-    completed_input_timestamps_.insert(input_timestamp);
+    // Searches from the back, where a timestamp completing in order belongs.
+    auto it = std::upper_bound(completed_input_timestamps_.rbegin(),
+                               completed_input_timestamps_.rend(),
+                               input_timestamp, std::greater<Timestamp>());
+    completed_input_timestamps_.insert(it.base(), input_timestamp);
     if (propagation_state_ == kPropagatingBound) {
       propagation_state_ = kPropagationPending;
       return;
@@ -15,9 +15,9 @@
 #ifndef MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_HANDLER_H_
 #define MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_HANDLER_H_
 
+#include <deque>
 #include <functional>
 #include <memory>
-#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -148,8 +148,11 @@ class OutputStreamHandler {
   const bool calculator_run_in_parallel_;
 
   absl::Mutex timestamp_mutex_;
-  // A set of the completed input timestamps in ascending order.
-  std::set<Timestamp> completed_input_timestamps_
+  // The completed input timestamps in ascending order. Invocations mostly
+  // complete in the order they started, so new timestamps are appended at or
+  // near the back and the smallest one is popped from the front, both in
+  // constant time. Holds at most max_in_flight timestamps.
+  std::deque<Timestamp> completed_input_timestamps_
       ABSL_GUARDED_BY(timestamp_mutex_);
   // The current minimum timestamp for which a new packet could possibly arrive.
   // TODO: Rename the variable to be more descriptive.
@@ -14,8 +14,10 @@
 
 #include "mediapipe/framework/output_stream_manager.h"
 
+#include <memory>
+#include <utility>
+
 #include "absl/log/absl_check.h"
-#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/input_stream_handler.h"
 #include "mediapipe/framework/port/status_builder.h"
 
@@ -36,21 +38,16 @@ void OutputStreamManager::PrepareForRun(
 
   output_stream_spec_.locked_intro_data = false;
   output_stream_spec_.header = Packet();
-  {
-    absl::MutexLock lock(&stream_mutex_);
-    next_timestamp_bound_ = Timestamp::PreStream();
-    closed_ = false;
-  }
+  next_timestamp_bound_.store(Timestamp::PreStream().Value(),
+                              std::memory_order_relaxed);
+  closed_.store(false, std::memory_order_release);
 }
 
 void OutputStreamManager::Close() {
-  {
-    absl::MutexLock lock(&stream_mutex_);
-    if (closed_) {
-      return;
-    }
-    closed_ = true;
-    next_timestamp_bound_ = Timestamp::Done();
+  next_timestamp_bound_.store(Timestamp::Done().Value(),
+                              std::memory_order_release);
+  if (closed_.exchange(true, std::memory_order_acq_rel)) {
+    return;
   }
 
   for (const auto& mirror : mirrors_) {
@@ -60,8 +57,7 @@ void OutputStreamManager::Close() {
 }
 
 bool OutputStreamManager::IsClosed() const {
-  absl::MutexLock lock(&stream_mutex_);
-  return closed_;
+  return closed_.load(std::memory_order_acquire);
 }
 
 void OutputStreamManager::PropagateHeader() {
@@ -92,8 +88,8 @@ void OutputStreamManager::SetMaxQueueSize(int max_queue_size) {
 }
 
 Timestamp OutputStreamManager::NextTimestampBound() const {
-  absl::MutexLock lock(&stream_mutex_);
-  return next_timestamp_bound_;
+  return Timestamp::CreateNoErrorChecking(
+      next_timestamp_bound_.load(std::memory_order_acquire));
 }
 
 // TODO Consider moving the output bound computing logic to
@@ -165,13 +161,13 @@ Timestamp OutputStreamManager::ComputeOutputTimestampBound(
 void OutputStreamManager::PropagateUpdatesToMirrors(
     Timestamp next_timestamp_bound, OutputStreamShard* output_stream_shard) {
   ABSL_CHECK(output_stream_shard);
-  {
-    if (next_timestamp_bound != Timestamp::Unset()) {
-      absl::MutexLock lock(&stream_mutex_);
-      next_timestamp_bound_ = next_timestamp_bound;
-      VLOG(3) << "Next timestamp bound for output " << output_stream_spec_.name
-              << " is " << next_timestamp_bound_;
-    }
+  bool bound_changed = false;
+  if (next_timestamp_bound != Timestamp::Unset()) {
+    const int64_t previous_bound = next_timestamp_bound_.exchange(
+        next_timestamp_bound.Value(), std::memory_order_acq_rel);
+    bound_changed = previous_bound != next_timestamp_bound.Value();
+    VLOG(3) << "Next timestamp bound for output " << output_stream_spec_.name
+            << " is " << next_timestamp_bound;
   }
   std::list<Packet>* packets_to_propagate = output_stream_shard->OutputQueue();
   VLOG(3) << "Output stream: " << Name()
@@ -179,11 +175,22 @@ void OutputStreamManager::PropagateUpdatesToMirrors(
   VLOG(3) << "Output stream: " << Name()
           << " next timestamp: " << next_timestamp_bound;
   bool add_packets = !packets_to_propagate->empty();
+  // Without packets, the mirrors already have an unchanged bound. With
+  // packets, the mirrors derive the bound from the last packet if it matches.
   bool set_bound =
       (next_timestamp_bound != Timestamp::Unset()) &&
-      (!add_packets ||
-       packets_to_propagate->back().Timestamp().NextAllowedInStream() !=
-           next_timestamp_bound);
+      (add_packets
+           ? packets_to_propagate->back().Timestamp().NextAllowedInStream() !=
+                 next_timestamp_bound
+           : bound_changed);
+  if (!add_packets && !set_bound) {
+    return;
+  }
+  if (add_packets && lifetime_counter_) {
+    for (const Packet& packet : *packets_to_propagate) {
+      PacketLifetimeTracker::Get().TrackPacket(packet, lifetime_counter_);
+    }
+  }
   int mirror_count = mirrors_.size();
   for (int idx = 0; idx < mirror_count; ++idx) {
     const Mirror& mirror = mirrors_[idx];
@@ -208,14 +215,13 @@ void OutputStreamManager::PropagateUpdatesToMirrors(
 }
 
 void OutputStreamManager::ResetShard(OutputStreamShard* output_stream_shard) {
-  Timestamp next_timestamp_bound;
-  bool closed = false;
-  absl::MutexLock lock(&stream_mutex_);
-  {
-    next_timestamp_bound = next_timestamp_bound_;
-    closed = closed_;
-  }
-  output_stream_shard->Reset(next_timestamp_bound, closed);
+  const bool closed = IsClosed();
+  output_stream_shard->Reset(NextTimestampBound(), closed);
+}
+
+void OutputStreamManager::SetLifetimeCounter(
+    std::shared_ptr<PacketLifetimeCounter> lifetime_counter) {
+  lifetime_counter_ = std::move(lifetime_counter);
 }
 
 }  // namespace mediapipe
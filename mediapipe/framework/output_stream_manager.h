@@ -15,13 +15,16 @@
 #ifndef MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_MANAGER_H_
 #define MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_MANAGER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
-#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/output_stream_shard.h"
 #include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/packet_lifetime.h"
 #include "mediapipe/framework/packet_type.h"
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/status.h"
@@ -93,12 +96,20 @@ class OutputStreamManager {
       Timestamp input_timestamp) const;
 
   // Propagates the updates to the mirrors and clears the packet queue in
-  // the OutputStreamShard afterwards.
+  // the OutputStreamShard afterwards. A bound equal to the current bound is
+  // not propagated again unless packets are added, so redundant bound updates
+  // do not wake the downstream nodes.
   void PropagateUpdatesToMirrors(Timestamp next_timestamp_bound,
                                  OutputStreamShard* output_stream_shard);
 
   void ResetShard(OutputStreamShard* output_stream_shard);
 
+  // Tracks the lifetime of the packets sent on this stream in
+  // |lifetime_counter|, see packet_lifetime.h. Pass nullptr to disable
+  // tracking. Must be called before the graph runs.
+  void SetLifetimeCounter(
+      std::shared_ptr<PacketLifetimeCounter> lifetime_counter);
+
   OutputStreamSpec* Spec() { return &output_stream_spec_; }
   const OutputStreamSpec* Spec() const { return &output_stream_spec_; }
 
@@ -117,9 +128,14 @@ class OutputStreamManager {
   OutputStreamSpec output_stream_spec_;
   std::vector<Mirror> mirrors_;
 
-  mutable absl::Mutex stream_mutex_;
-  Timestamp next_timestamp_bound_ ABSL_GUARDED_BY(stream_mutex_);
-  bool closed_ ABSL_GUARDED_BY(stream_mutex_);
+  // Counts the lifetime of the sent packets, if packet lifetimes are tracked.
+  std::shared_ptr<PacketLifetimeCounter> lifetime_counter_;
+
+  // The value of the next timestamp bound. Read without locking by the
+  // OutputStreamHandler when it checks whether a bound needs propagating.
+  std::atomic<int64_t> next_timestamp_bound_{Timestamp::PreStream().Value()};
+  // Set after next_timestamp_bound_ reaches Timestamp::Done().
+  std::atomic<bool> closed_{false};
 };
 
 }  // namespace mediapipe
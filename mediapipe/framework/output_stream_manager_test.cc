@@ -81,7 +81,7 @@ class OutputStreamManagerTest : public ::testing::Test {
 
   void HeadersReadyNoOp() {}
 
-  void NotifyNoOp() {}
+  void NotifyNoOp() { ++num_notifications_; }
 
   void ScheduleNoOp(CalculatorContext* cc) {}
 
@@ -115,6 +115,8 @@ class OutputStreamManagerTest : public ::testing::Test {
 
   // Vector of errors encountered while using the stream.
   std::vector<absl::Status> errors_;
+  // The number of times the mirror notified its node.
+  int num_notifications_ = 0;
 };
 
 TEST_F(OutputStreamManagerTest, Init) {}
@@ -567,6 +569,29 @@ TEST_F(OutputStreamManagerTest, SetNextTimestampBoundReverseTimestamps) {
   EXPECT_THAT(errors_[0].ToString(), testing::HasSubstr("40"));
 }
 
+TEST_F(OutputStreamManagerTest, SetNextTimestampBoundCoalescesRepeats) {
+  output_stream_manager_->PropagateUpdatesToMirrors(Timestamp(10),
+                                                    &output_stream_shard_);
+  EXPECT_EQ(Timestamp(10), output_stream_manager_->NextTimestampBound());
+  EXPECT_EQ(1, num_notifications_);
+
+  // Repeating the bound neither notifies nor changes the mirrors.
+  output_stream_manager_->PropagateUpdatesToMirrors(Timestamp(10),
+                                                    &output_stream_shard_);
+  EXPECT_EQ(1, num_notifications_);
+  bool is_empty = false;
+  EXPECT_EQ(Timestamp(10),
+            input_stream_manager_.MinTimestampOrBound(&is_empty));
+  EXPECT_TRUE(is_empty);
+
+  output_stream_manager_->PropagateUpdatesToMirrors(Timestamp(20),
+                                                    &output_stream_shard_);
+  EXPECT_EQ(2, num_notifications_);
+  EXPECT_EQ(Timestamp(20),
+            input_stream_manager_.MinTimestampOrBound(&is_empty));
+  EXPECT_TRUE(errors_.empty());
+}
+
 TEST_F(OutputStreamManagerTest, BadPacketType) {
   output_stream_shard_.AddPacket(Adopt(new int(10)).At(Timestamp(10)));
   ASSERT_EQ(1, errors_.size());
@@ -16,8 +16,10 @@
 #define MEDIAPIPE_FRAMEWORK_OUTPUT_STREAM_POLLER_H_
 
 #include <memory>
+#include <vector>
 
 #include "absl/log/absl_check.h"
+#include "absl/time/time.h"
 #include "mediapipe/framework/graph_output_stream.h"
 
 namespace mediapipe {
@@ -49,12 +51,33 @@ class OutputStreamPoller {
     return poller->Next(packet);
   }
 
+  // Gets up to max_count packets at once (block until at least one is
+  // available, the stream is done, or timeout expires). Returns false if the
+  // stream is done. Returns true with an empty batch if timeout expires. See
+  // OutputStreamPollerImpl::NextBatch.
+  ABSL_MUST_USE_RESULT bool NextBatch(
+      std::vector<Packet>* packets, int max_count,
+      absl::Duration timeout = absl::InfiniteDuration()) {
+    auto poller = internal_poller_impl_.lock();
+    if (!poller) {
+      return false;
+    }
+    return poller->NextBatch(packets, max_count, timeout);
+  }
+
   void SetMaxQueueSize(int queue_size) {
     auto poller = internal_poller_impl_.lock();
     ABSL_CHECK(poller) << "OutputStreamPollerImpl is already destroyed.";
     return poller->SetMaxQueueSize(queue_size);
   }
 
+  // Preallocates the queue to hold at least capacity packets.
+  void ReserveQueue(int capacity) {
+    auto poller = internal_poller_impl_.lock();
+    ABSL_CHECK(poller) << "OutputStreamPollerImpl is already destroyed.";
+    poller->ReserveQueue(capacity);
+  }
+
   // Returns the number of packets in the queue.
   int QueueSize() {
     auto poller = internal_poller_impl_.lock();
@@ -130,6 +130,8 @@ class OutputStreamShard : public OutputStream {
   friend class GraphTracer;
   // Accesses OutputStreamShard for profiling.
   friend class PerfettoTraceScope;
+  // Accesses OutputStreamShard for profiling.
+  friend class SystemTraceExporter;
   // Accesses OutputStreamShard for post processing.
   friend class OutputStreamManager;
 };
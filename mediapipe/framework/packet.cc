@@ -14,6 +14,7 @@
 
 #include "mediapipe/framework/packet.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -36,7 +37,23 @@
 namespace mediapipe {
 namespace packet_internal {
 
-HolderBase::~HolderBase() {}
+std::atomic<HolderObserver*> holder_observer{nullptr};
+
+HolderBase::~HolderBase() {
+  if (HolderObserver* observer = GetHolderObserver()) {
+    observer->OnHolderDestroyed(this);
+  }
+}
+
+void SetHolderObserver(HolderObserver* observer) {
+  holder_observer.store(observer, std::memory_order_release);
+}
+
+void NotifyHolderCopied(const Packet& packet) {
+  if (HolderObserver* observer = GetHolderObserver()) {
+    observer->OnHolderCopied(GetHolder(packet));
+  }
+}
 
 Packet Create(HolderBase* holder) {
   Packet result;
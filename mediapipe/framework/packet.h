@@ -17,6 +17,7 @@
 #ifndef MEDIAPIPE_FRAMEWORK_PACKET_H_
 #define MEDIAPIPE_FRAMEWORK_PACKET_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -69,6 +70,28 @@ const std::shared_ptr<const HolderBase>& GetHolderShared(const Packet& packet);
 std::shared_ptr<const HolderBase> GetHolderShared(Packet&& packet);
 absl::StatusOr<Packet> PacketFromDynamicProto(const std::string& type_name,
                                               const std::string& serialized);
+
+// True if MakePacket<T>(Args...) copy-constructs a T from an existing object
+// rather than moving it or building a new one. Copies of non-class types are
+// too cheap to report.
+template <typename T, typename... Args>
+struct IsCopyConstruction : std::false_type {};
+
+template <typename T, typename Arg>
+struct IsCopyConstruction<T, Arg>
+    : std::integral_constant<
+          bool, std::is_class<T>::value &&
+                    std::is_same<typename std::decay<Arg>::type,
+                                 typename std::remove_cv<T>::type>::value &&
+                    (std::is_lvalue_reference<Arg>::value ||
+                     std::is_const<
+                         typename std::remove_reference<Arg>::type>::value)> {
+};
+
+// Reports the holder of |packet|, just created by MakePacket() as a copy, to
+// the holder observer, if any.
+void NotifyHolderCopied(const Packet& packet);
+
 }  // namespace packet_internal
 
 // A generic container class which can hold data of any type.  The type of
@@ -288,6 +311,9 @@ class Packet {
   friend class PacketType;
   absl::Status ValidateAsType(TypeId type_id) const;
 
+  // Reports the outcome of ConsumeOrCopy() to the holder observer, if any.
+  void NotifyConsumedOrCopied(bool copied) const;
+
   std::shared_ptr<const packet_internal::HolderBase> holder_;
   class Timestamp timestamp_;
 };
@@ -380,7 +406,11 @@ template <typename T,
           typename std::enable_if<!std::is_array<T>::value>::type* = nullptr,
           typename... Args>
 Packet MakePacket(Args&&... args) {  // NOLINT(build/c++11)
-  return Adopt(new T(std::forward<Args>(args)...));
+  Packet packet = Adopt(new T(std::forward<Args>(args)...));
+  if constexpr (packet_internal::IsCopyConstruction<T, Args...>::value) {
+    packet_internal::NotifyHolderCopied(packet);
+  }
+  return packet;
 }
 
 // Version for arrays. We have to use reinterpret_cast because new T[N]
@@ -427,7 +457,7 @@ class ForeignHolder;
 
 class HolderBase {
  public:
-  HolderBase() {}
+  explicit HolderBase(TypeId type_id) : type_id_(type_id) {}
   HolderBase(const HolderBase&) = delete;
   HolderBase& operator=(const HolderBase&) = delete;
   virtual ~HolderBase();
@@ -442,8 +472,9 @@ class HolderBase {
   // Returns the registered type name if it's available, otherwise the
   // empty string.
   virtual const std::string RegisteredTypeName() const = 0;
-  // Get the type id of the underlying data type.
-  virtual TypeId GetTypeId() const = 0;
+  // Get the type id of the underlying data type. This is stored rather than
+  // virtual so that type checks on the packet hot path avoid an indirect call.
+  TypeId GetTypeId() const { return type_id_; }
 
   // Downcasts this to Holder<T>.  Returns nullptr if deserialization
   // failed or if the requested type is not what is stored.
@@ -467,8 +498,38 @@ class HolderBase {
   GetVectorOfProtoMessageLite() const = 0;
 
   virtual bool HasForeignOwner() const { return false; }
+
+ private:
+  const TypeId type_id_;
+};
+
+// Observes packet holders for the packet lifetime tracker, see
+// mediapipe/framework/packet_lifetime.h. An observer is installed only while
+// a graph tracks packet lifetimes, so the hooks cost one atomic load
+// otherwise.
+class HolderObserver {
+ public:
+  virtual ~HolderObserver() = default;
+  // Called when MakePacket<T>() copies an existing T into |holder|.
+  virtual void OnHolderCopied(const HolderBase* holder) = 0;
+  // Called when Packet::ConsumeOrCopy() takes the payload of |holder|, which
+  // is shared by |use_count| packets, either by releasing or by copying it.
+  virtual void OnHolderConsumed(const HolderBase* holder, int64_t use_count,
+                                bool copied) = 0;
+  // Called when |holder| is destroyed.
+  virtual void OnHolderDestroyed(const HolderBase* holder) = 0;
 };
 
+// The installed HolderObserver, or nullptr. Defined in packet.cc.
+extern std::atomic<HolderObserver*> holder_observer;
+
+inline HolderObserver* GetHolderObserver() {
+  return holder_observer.load(std::memory_order_acquire);
+}
+
+// Installs |observer|, or removes the current observer if null.
+void SetHolderObserver(HolderObserver* observer);
+
 // Two helper functions to get the proto base pointers.
 template <typename T>
 const proto_ns::MessageLite* ConvertToProtoMessageLite(const T* data,
@@ -553,10 +614,9 @@ struct HolderPayloadRegistrator<
 template <typename T>
 class Holder : public HolderBase, private HolderPayloadRegistrator<T> {
  public:
-  explicit Holder(const T* ptr) : ptr_(ptr) {}
+  explicit Holder(const T* ptr) : HolderBase(kTypeId<T>), ptr_(ptr) {}
   ~Holder() override { delete_helper(); }
   const T& data() const { return *ptr_; }
-  TypeId GetTypeId() const final { return kTypeId<T>; }
   // Releases the underlying data pointer and transfers the ownership to a
   // unique pointer.
   // This method is dangerous and is only used by Packet::Consume() if the
@@ -689,6 +749,13 @@ inline Packet& Packet::operator=(const Packet& packet) {
   return *this;
 }
 
+inline void Packet::NotifyConsumedOrCopied(bool copied) const {
+  if (packet_internal::HolderObserver* observer =
+          packet_internal::GetHolderObserver()) {
+    observer->OnHolderConsumed(holder_.get(), holder_.use_count(), copied);
+  }
+}
+
 template <typename T>
 inline absl::StatusOr<std::unique_ptr<T>> Packet::Consume() {
   // If type validation fails, returns error.
@@ -722,6 +789,7 @@ inline absl::StatusOr<std::unique_ptr<T>> Packet::ConsumeOrCopy(
     absl::StatusOr<std::unique_ptr<T>> release_result =
         holder_->AsMutable<T>()->Release();
     if (release_result.ok()) {
+      NotifyConsumedOrCopied(/*copied=*/false);
       VLOG(2) << "Setting " << DebugString() << " to empty.";
       holder_.reset();
     }
@@ -732,6 +800,7 @@ inline absl::StatusOr<std::unique_ptr<T>> Packet::ConsumeOrCopy(
   }
   VLOG(2) << "Copying the data of " << DebugString();
   std::unique_ptr<T> data_ptr = absl::make_unique<T>(Get<T>());
+  NotifyConsumedOrCopied(/*copied=*/true);
   VLOG(2) << "Setting " << DebugString() << " to empty.";
   holder_.reset();
   if (was_copied) {
@@ -752,6 +821,7 @@ inline absl::StatusOr<std::unique_ptr<T>> Packet::ConsumeOrCopy(
     absl::StatusOr<std::unique_ptr<T>> release_result =
         holder_->AsMutable<T>()->Release();
     if (release_result.ok()) {
+      NotifyConsumedOrCopied(/*copied=*/false);
       VLOG(2) << "Setting " << DebugString() << " to empty.";
       holder_.reset();
     }
@@ -768,6 +838,7 @@ inline absl::StatusOr<std::unique_ptr<T>> Packet::ConsumeOrCopy(
   // Copies bounded array data into data_ptr.
   std::copy(std::begin(original_array), std::end(original_array),
             std::begin(*data_ptr));
+  NotifyConsumedOrCopied(/*copied=*/true);
   VLOG(2) << "Setting " << DebugString() << " to empty.";
   holder_.reset();
   if (was_copied) {
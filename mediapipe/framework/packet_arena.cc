@@ -0,0 +1,113 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/packet_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "absl/synchronization/mutex.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr size_t kMinPooledBlockSize = 64;
+
+size_t SizeClassBlockSize(int index) { return kMinPooledBlockSize << index; }
+
+}  // namespace
+
+PacketArena::PacketArena(int max_cached_blocks_per_class)
+    : max_cached_blocks_per_class_(
+          static_cast<size_t>(std::max(max_cached_blocks_per_class, 0))) {
+  static_assert(kMinPooledBlockSize << (kNumSizeClasses - 1) ==
+                    kMaxPooledBlockSize,
+                "size classes must end at kMaxPooledBlockSize");
+}
+
+PacketArena::~PacketArena() {
+  for (SizeClass& size_class : size_classes_) {
+    absl::MutexLock lock(&size_class.mutex);
+    for (void* block : size_class.free_blocks) {
+      ::operator delete(block);
+    }
+    size_class.free_blocks.clear();
+  }
+}
+
+// static
+int PacketArena::SizeClassIndex(size_t size) {
+  if (size > kMaxPooledBlockSize) {
+    return -1;
+  }
+  int index = 0;
+  while (SizeClassBlockSize(index) < size) {
+    ++index;
+  }
+  return index;
+}
+
+void* PacketArena::Allocate(size_t size) {
+  const int index = SizeClassIndex(size);
+  if (index < 0) {
+    return ::operator new(size);
+  }
+  SizeClass& size_class = size_classes_[index];
+  {
+    absl::MutexLock lock(&size_class.mutex);
+    if (!size_class.free_blocks.empty()) {
+      void* block = size_class.free_blocks.back();
+      size_class.free_blocks.pop_back();
+      ++size_class.num_reused;
+      return block;
+    }
+  }
+  return ::operator new(SizeClassBlockSize(index));
+}
+
+void PacketArena::Deallocate(void* block, size_t size) {
+  const int index = SizeClassIndex(size);
+  if (index >= 0) {
+    SizeClass& size_class = size_classes_[index];
+    absl::MutexLock lock(&size_class.mutex);
+    if (size_class.free_blocks.size() < max_cached_blocks_per_class_) {
+      size_class.free_blocks.push_back(block);
+      return;
+    }
+  }
+  ::operator delete(block);
+}
+
+int PacketArena::NumCachedBlocks() const {
+  int num_blocks = 0;
+  for (const SizeClass& size_class : size_classes_) {
+    absl::MutexLock lock(&size_class.mutex);
+    num_blocks += size_class.free_blocks.size();
+  }
+  return num_blocks;
+}
+
+int64_t PacketArena::NumReusedBlocks() const {
+  int64_t num_reused = 0;
+  for (const SizeClass& size_class : size_classes_) {
+    absl::MutexLock lock(&size_class.mutex);
+    num_reused += size_class.num_reused;
+  }
+  return num_reused;
+}
+
+}  // namespace mediapipe
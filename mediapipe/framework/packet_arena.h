@@ -0,0 +1,172 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_PACKET_ARENA_H_
+#define MEDIAPIPE_FRAMEWORK_PACKET_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe {
+
+// A thread-safe pool of memory blocks for packets.
+//
+// Blocks are grouped into power-of-two size classes. A freed block is kept on
+// the free list of its size class, up to max_cached_blocks_per_class, and is
+// handed out again by the next allocation of the same class. Blocks larger
+// than kMaxPooledBlockSize are not pooled.
+//
+// Packets created by MakePacketInArena() keep a reference to their arena, so
+// the arena can be released before the packets it allocated.
+class PacketArena {
+ public:
+  // The largest block size that is pooled.
+  static constexpr size_t kMaxPooledBlockSize = 4096;
+
+  explicit PacketArena(int max_cached_blocks_per_class = 256);
+  PacketArena(const PacketArena&) = delete;
+  PacketArena& operator=(const PacketArena&) = delete;
+  ~PacketArena();
+
+  // Returns a block of at least "size" bytes, aligned for any fundamental
+  // type.
+  void* Allocate(size_t size);
+
+  // Returns a block obtained from Allocate(size) to the arena.
+  void Deallocate(void* block, size_t size);
+
+  // Returns the number of free blocks cached by the arena.
+  int NumCachedBlocks() const;
+
+  // Returns the number of allocations served from cached blocks.
+  int64_t NumReusedBlocks() const;
+
+ private:
+  // Size classes are 64, 128, ..., kMaxPooledBlockSize bytes.
+  static constexpr int kNumSizeClasses = 7;
+
+  struct SizeClass {
+    mutable absl::Mutex mutex;
+    std::vector<void*> free_blocks ABSL_GUARDED_BY(mutex);
+    int64_t num_reused ABSL_GUARDED_BY(mutex) = 0;
+  };
+
+  // Returns the index of the smallest size class holding "size" bytes, or -1
+  // if "size" is not pooled.
+  static int SizeClassIndex(size_t size);
+
+  const size_t max_cached_blocks_per_class_;
+  SizeClass size_classes_[kNumSizeClasses];
+};
+
+namespace packet_internal {
+
+// A standard allocator that takes its memory from a PacketArena. Each copy
+// keeps the arena alive.
+template <typename T>
+class PacketArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit PacketArenaAllocator(std::shared_ptr<PacketArena> arena)
+      : arena_(std::move(arena)) {}
+  template <typename U>
+  PacketArenaAllocator(const PacketArenaAllocator<U>& other)  // NOLINT
+      : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) { arena_->Deallocate(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const PacketArenaAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const PacketArenaAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class PacketArenaAllocator;
+
+  std::shared_ptr<PacketArena> arena_;
+};
+
+// Like Holder, but stores the payload inline. The payload belongs to the
+// holder's memory block, so it cannot be released: Packet::Consume() fails
+// and Packet::ConsumeOrCopy() copies.
+template <typename T>
+class ArenaHolder : public Holder<T> {
+ public:
+  template <typename... Args>
+  explicit ArenaHolder(Args&&... args) : Holder<T>(nullptr) {
+    this->ptr_ = new (&storage_) T(std::forward<Args>(args)...);
+  }
+
+  ~ArenaHolder() override {
+    this->ptr_->~T();
+    // Null out ptr_ so it doesn't get deleted by ~Holder.
+    this->ptr_ = nullptr;
+  }
+
+  bool HasForeignOwner() const final { return true; }
+
+ private:
+  alignas(T) unsigned char storage_[sizeof(T)];
+};
+
+}  // namespace packet_internal
+
+// Creates a packet containing an object of type T initialized with the
+// provided arguments, like MakePacket<T>(). The control block, the holder and
+// the payload share a single block taken from "arena", and the block returns
+// to the arena when the last copy of the packet is destroyed.
+//
+// Falls back to MakePacket<T>() if "arena" is null or if T needs more than
+// the default new alignment.
+template <typename T,
+          typename std::enable_if<!std::is_array<T>::value>::type* = nullptr,
+          typename... Args>
+Packet MakePacketInArena(const std::shared_ptr<PacketArena>& arena,
+                         Args&&... args) {
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return MakePacket<T>(std::forward<Args>(args)...);
+  } else {
+    if (arena == nullptr) {
+      return MakePacket<T>(std::forward<Args>(args)...);
+    }
+    return packet_internal::Create(
+        std::allocate_shared<packet_internal::ArenaHolder<T>>(
+            packet_internal::PacketArenaAllocator<
+                packet_internal::ArenaHolder<T>>(arena),
+            std::forward<Args>(args)...),
+        Timestamp::Unset());
+  }
+}
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PACKET_ARENA_H_
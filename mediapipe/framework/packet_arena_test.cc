@@ -0,0 +1,130 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/packet_arena.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(PacketArenaTest, ReusesFreedBlocks) {
+  auto arena = std::make_shared<PacketArena>();
+  Packet packet = MakePacketInArena<std::string>(arena, "hello");
+  EXPECT_EQ(packet.Get<std::string>(), "hello");
+  EXPECT_EQ(arena->NumCachedBlocks(), 0);
+
+  packet = Packet();
+  EXPECT_EQ(arena->NumCachedBlocks(), 1);
+  packet = MakePacketInArena<std::string>(arena, "world");
+  EXPECT_EQ(packet.Get<std::string>(), "world");
+  EXPECT_EQ(arena->NumCachedBlocks(), 0);
+  EXPECT_EQ(arena->NumReusedBlocks(), 1);
+}
+
+TEST(PacketArenaTest, LimitsCachedBlocks) {
+  auto arena = std::make_shared<PacketArena>(/*max_cached_blocks_per_class=*/2);
+  std::vector<Packet> packets;
+  for (int i = 0; i < 5; ++i) {
+    packets.push_back(MakePacketInArena<int>(arena, i));
+  }
+  packets.clear();
+  EXPECT_EQ(arena->NumCachedBlocks(), 2);
+}
+
+TEST(PacketArenaTest, PacketOutlivesArena) {
+  auto arena = std::make_shared<PacketArena>();
+  Packet packet = MakePacketInArena<std::string>(arena, "hello").At(
+      Timestamp(10));
+  arena.reset();
+  EXPECT_EQ(packet.Get<std::string>(), "hello");
+  EXPECT_EQ(packet.Timestamp(), Timestamp(10));
+}
+
+TEST(PacketArenaTest, FallsBackWithoutArena) {
+  Packet packet = MakePacketInArena<int>(/*arena=*/nullptr, 17);
+  EXPECT_EQ(packet.Get<int>(), 17);
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<int> value, packet.Consume<int>());
+  EXPECT_EQ(*value, 17);
+}
+
+TEST(PacketArenaTest, ConsumeOrCopyCopiesArenaPayload) {
+  auto arena = std::make_shared<PacketArena>();
+  Packet packet = MakePacketInArena<std::string>(arena, "hello");
+  EXPECT_FALSE(packet.Consume<std::string>().ok());
+  EXPECT_FALSE(packet.IsEmpty());
+
+  bool was_copied = false;
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<std::string> value,
+                          packet.ConsumeOrCopy<std::string>(&was_copied));
+  EXPECT_TRUE(was_copied);
+  EXPECT_EQ(*value, "hello");
+  EXPECT_TRUE(packet.IsEmpty());
+  EXPECT_EQ(arena->NumCachedBlocks(), 1);
+}
+
+// Outputs its input side packet value on every timestamp, using the arena.
+class ArenaSourceCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Outputs().Index(0).Set<int>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) final {
+    if (count_ == 10) {
+      return tool::StatusStop();
+    }
+    cc->Outputs().Index(0).AddPacket(
+        cc->MakePacketInArena<int>(count_).At(Timestamp(count_)));
+    ++count_;
+    return absl::OkStatus();
+  }
+
+ private:
+  int count_ = 0;
+};
+REGISTER_CALCULATOR(ArenaSourceCalculator);
+
+TEST(PacketArenaTest, CalculatorContextMakesArenaPackets) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        node { calculator: "ArenaSourceCalculator" output_stream: "out" }
+      )pb");
+  std::vector<Packet> packets;
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.ObserveOutputStream("out", [&packets](const Packet& p) {
+    packets.push_back(p);
+    return absl::OkStatus();
+  }));
+  MP_ASSERT_OK(graph.Run());
+  ASSERT_EQ(packets.size(), 10);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(packets[i].Get<int>(), i);
+    EXPECT_EQ(packets[i].Timestamp(), Timestamp(i));
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,105 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//
+// Benchmarks for Packet creation, copy and move.
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+void BM_MakePacketInt(benchmark::State& state) {
+  int64_t t = 0;
+  for (auto _ : state) {
+    Packet packet = MakePacket<int>(42).At(Timestamp(++t));
+    benchmark::DoNotOptimize(packet);
+  }
+}
+BENCHMARK(BM_MakePacketInt);
+
+void BM_MakePacketString(benchmark::State& state) {
+  const std::string payload(state.range(0), 'x');
+  int64_t t = 0;
+  for (auto _ : state) {
+    Packet packet = MakePacket<std::string>(payload).At(Timestamp(++t));
+    benchmark::DoNotOptimize(packet);
+  }
+  state.SetBytesProcessed(state.iterations() * payload.size());
+}
+BENCHMARK(BM_MakePacketString)->Arg(16)->Arg(1024)->Arg(64 << 10);
+
+void BM_CopyPacket(benchmark::State& state) {
+  const Packet packet = MakePacket<int>(42).At(Timestamp(0));
+  for (auto _ : state) {
+    Packet copy = packet;
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_CopyPacket);
+
+// Copying a packet while restamping it, as output streams do for
+// pass-through outputs.
+void BM_CopyPacketAt(benchmark::State& state) {
+  const Packet packet = MakePacket<int>(42).At(Timestamp(0));
+  int64_t t = 0;
+  for (auto _ : state) {
+    Packet copy = packet.At(Timestamp(++t));
+    benchmark::DoNotOptimize(copy);
+  }
+}
+BENCHMARK(BM_CopyPacketAt);
+
+void BM_MovePacketAt(benchmark::State& state) {
+  Packet packet = MakePacket<int>(42).At(Timestamp(0));
+  int64_t t = 0;
+  for (auto _ : state) {
+    packet = std::move(packet).At(Timestamp(++t));
+    benchmark::DoNotOptimize(packet);
+  }
+}
+BENCHMARK(BM_MovePacketAt);
+
+void BM_GetPacketContents(benchmark::State& state) {
+  const Packet packet = MakePacket<int>(42).At(Timestamp(0));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(packet.Get<int>());
+  }
+}
+BENCHMARK(BM_GetPacketContents);
+
+// Copies a vector of packets, as happens when a calculator forwards all of
+// its inputs.
+void BM_CopyPacketVector(benchmark::State& state) {
+  std::vector<Packet> packets;
+  for (int i = 0; i < state.range(0); ++i) {
+    packets.push_back(MakePacket<int>(i).At(Timestamp(i)));
+  }
+  for (auto _ : state) {
+    std::vector<Packet> copy = packets;
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * packets.size());
+}
+BENCHMARK(BM_CopyPacketVector)->Arg(8)->Arg(64);
+
+}  // namespace
+}  // namespace mediapipe
+
+BENCHMARK_MAIN();
@@ -0,0 +1,134 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/packet_lifetime.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "mediapipe/framework/deps/no_destructor.h"
+#include "mediapipe/framework/packet_size.h"
+
+namespace mediapipe {
+namespace {
+
+int64_t NowUsec() { return absl::GetCurrentTimeNanos() / 1000; }
+
+}  // namespace
+
+void PacketLifetimeCounter::Reset() {
+  packets_.store(0, std::memory_order_relaxed);
+  released_packets_.store(0, std::memory_order_relaxed);
+  total_lifetime_usec_.store(0, std::memory_order_relaxed);
+  max_lifetime_usec_.store(0, std::memory_order_relaxed);
+  copied_packets_.store(0, std::memory_order_relaxed);
+  consumed_packets_.store(0, std::memory_order_relaxed);
+  bytes_copied_.store(0, std::memory_order_relaxed);
+  max_references_.store(0, std::memory_order_relaxed);
+}
+
+PacketLifetimeTracker& PacketLifetimeTracker::Get() {
+  // Never destroyed, since holders may be released during static teardown.
+  static NoDestructor<PacketLifetimeTracker> tracker;
+  return *tracker;
+}
+
+void PacketLifetimeTracker::Attach() {
+  absl::MutexLock lock(&mutex_);
+  if (num_attached_++ == 0) {
+    packet_internal::SetHolderObserver(this);
+  }
+}
+
+void PacketLifetimeTracker::Detach() {
+  absl::MutexLock lock(&mutex_);
+  ABSL_CHECK_GT(num_attached_, 0);
+  if (--num_attached_ == 0) {
+    packet_internal::SetHolderObserver(nullptr);
+    records_.clear();
+  }
+}
+
+void PacketLifetimeTracker::TrackPacket(
+    const Packet& packet, std::shared_ptr<PacketLifetimeCounter> counter) {
+  const packet_internal::HolderBase* holder =
+      packet_internal::GetHolder(packet);
+  if (holder == nullptr || counter == nullptr) {
+    return;
+  }
+  const int64_t bytes = EstimatePacketBytes(packet);
+  absl::MutexLock lock(&mutex_);
+  if (num_attached_ == 0) {
+    return;
+  }
+  HolderRecord& record = records_[holder];
+  if (record.counter != nullptr) {
+    return;
+  }
+  record.counter = std::move(counter);
+  record.sent_time_usec = NowUsec();
+  record.bytes = bytes;
+  record.counter->AddPacket(record.copied, bytes);
+}
+
+void PacketLifetimeTracker::RecordCopy(const Packet& packet) {
+  const packet_internal::HolderBase* holder =
+      packet_internal::GetHolder(packet);
+  if (holder == nullptr) {
+    return;
+  }
+  absl::MutexLock lock(&mutex_);
+  auto iter = records_.find(holder);
+  if (iter != records_.end() && iter->second.counter != nullptr) {
+    iter->second.counter->AddCopy(iter->second.bytes);
+  }
+}
+
+void PacketLifetimeTracker::OnHolderCopied(
+    const packet_internal::HolderBase* holder) {
+  absl::MutexLock lock(&mutex_);
+  records_[holder].copied = true;
+}
+
+void PacketLifetimeTracker::OnHolderConsumed(
+    const packet_internal::HolderBase* holder, int64_t use_count,
+    bool copied) {
+  absl::MutexLock lock(&mutex_);
+  auto iter = records_.find(holder);
+  if (iter != records_.end() && iter->second.counter != nullptr) {
+    iter->second.counter->AddConsumeOrCopy(copied, iter->second.bytes,
+                                           use_count);
+  }
+}
+
+void PacketLifetimeTracker::OnHolderDestroyed(
+    const packet_internal::HolderBase* holder) {
+  absl::MutexLock lock(&mutex_);
+  auto iter = records_.find(holder);
+  if (iter == records_.end()) {
+    return;
+  }
+  if (iter->second.counter != nullptr) {
+    iter->second.counter->AddRelease(
+        std::max<int64_t>(NowUsec() - iter->second.sent_time_usec, 0));
+  }
+  records_.erase(iter);
+}
+
+}  // namespace mediapipe
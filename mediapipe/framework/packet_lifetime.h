@@ -0,0 +1,172 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tracks the packets sent on output streams from the time they are sent to
+// the destruction of their payload, and the copies made of their payload,
+// for the GraphProfiler.
+//
+// A payload copy is counted against the stream its packet was sent on when
+//   - Packet::ConsumeOrCopy() falls back to copying the payload,
+//   - MakePacket<T>(value) copies an existing T, and the new packet is then
+//     sent on a tracked stream,
+//   - a calculator converts the payload and calls RecordCopy(), for example
+//     after an image format conversion.
+// Copied bytes are estimated by the functions registered with
+// MEDIAPIPE_REGISTER_PACKET_SIZE_FN, see packet_size.h.
+
+#ifndef MEDIAPIPE_FRAMEWORK_PACKET_LIFETIME_H_
+#define MEDIAPIPE_FRAMEWORK_PACKET_LIFETIME_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe {
+
+// Counts the packets sent on one output stream, their lifetimes and the
+// copies made of their payloads. Updated from any thread.
+class PacketLifetimeCounter {
+ public:
+  PacketLifetimeCounter() = default;
+
+  PacketLifetimeCounter(const PacketLifetimeCounter&) = delete;
+  PacketLifetimeCounter& operator=(const PacketLifetimeCounter&) = delete;
+
+  // Counts a packet sent on the stream. |copied_bytes| is the size of its
+  // payload if the payload was created as a copy, 0 otherwise.
+  void AddPacket(bool copied, int64_t copied_bytes) {
+    packets_.fetch_add(1, std::memory_order_relaxed);
+    if (copied) AddCopy(copied_bytes);
+  }
+
+  // Counts the destruction of a payload sent on the stream |lifetime_usec|
+  // earlier.
+  void AddRelease(int64_t lifetime_usec) {
+    released_packets_.fetch_add(1, std::memory_order_relaxed);
+    total_lifetime_usec_.fetch_add(lifetime_usec, std::memory_order_relaxed);
+    RaiseTo(max_lifetime_usec_, lifetime_usec);
+  }
+
+  // Counts a Packet::ConsumeOrCopy() call on a packet sent on the stream,
+  // whose payload was shared by |use_count| packets.
+  void AddConsumeOrCopy(bool copied, int64_t bytes, int64_t use_count) {
+    if (copied) {
+      AddCopy(bytes);
+    } else {
+      consumed_packets_.fetch_add(1, std::memory_order_relaxed);
+    }
+    RaiseTo(max_references_, use_count);
+  }
+
+  // Counts a copy of |bytes| made of a payload sent on the stream.
+  void AddCopy(int64_t bytes) {
+    copied_packets_.fetch_add(1, std::memory_order_relaxed);
+    bytes_copied_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  // Clears all counts.
+  void Reset();
+
+  int64_t packets() const { return packets_.load(std::memory_order_relaxed); }
+  int64_t released_packets() const {
+    return released_packets_.load(std::memory_order_relaxed);
+  }
+  int64_t total_lifetime_usec() const {
+    return total_lifetime_usec_.load(std::memory_order_relaxed);
+  }
+  int64_t max_lifetime_usec() const {
+    return max_lifetime_usec_.load(std::memory_order_relaxed);
+  }
+  int64_t copied_packets() const {
+    return copied_packets_.load(std::memory_order_relaxed);
+  }
+  int64_t consumed_packets() const {
+    return consumed_packets_.load(std::memory_order_relaxed);
+  }
+  int64_t bytes_copied() const {
+    return bytes_copied_.load(std::memory_order_relaxed);
+  }
+  int64_t max_references() const {
+    return max_references_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static void RaiseTo(std::atomic<int64_t>& maximum, int64_t value) {
+    int64_t current = maximum.load(std::memory_order_relaxed);
+    while (value > current && !maximum.compare_exchange_weak(
+                                  current, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  std::atomic<int64_t> packets_{0};
+  std::atomic<int64_t> released_packets_{0};
+  std::atomic<int64_t> total_lifetime_usec_{0};
+  std::atomic<int64_t> max_lifetime_usec_{0};
+  std::atomic<int64_t> copied_packets_{0};
+  std::atomic<int64_t> consumed_packets_{0};
+  std::atomic<int64_t> bytes_copied_{0};
+  std::atomic<int64_t> max_references_{0};
+};
+
+// Maps the payload of each tracked packet to the counter of the stream it
+// was first sent on. There is one tracker per process; it observes packet
+// holders only while at least one graph is attached.
+class PacketLifetimeTracker : public packet_internal::HolderObserver {
+ public:
+  static PacketLifetimeTracker& Get();
+
+  // Attach() starts observing packet holders, and a matching Detach() stops
+  // once no graph is attached anymore.
+  void Attach();
+  void Detach();
+
+  // Records that |packet| is sent on the stream counted by |counter|. A
+  // payload sent on several streams is counted on the first one.
+  void TrackPacket(const Packet& packet,
+                   std::shared_ptr<PacketLifetimeCounter> counter);
+
+  // Counts a copy of the payload of |packet|, made outside of MakePacket()
+  // and Packet::ConsumeOrCopy(), against the stream it was sent on.
+  void RecordCopy(const Packet& packet);
+
+  // packet_internal::HolderObserver.
+  void OnHolderCopied(const packet_internal::HolderBase* holder) override;
+  void OnHolderConsumed(const packet_internal::HolderBase* holder,
+                        int64_t use_count, bool copied) override;
+  void OnHolderDestroyed(const packet_internal::HolderBase* holder) override;
+
+ private:
+  struct HolderRecord {
+    // Null until the payload is sent on a tracked stream.
+    std::shared_ptr<PacketLifetimeCounter> counter;
+    int64_t sent_time_usec = 0;
+    int64_t bytes = 0;
+    // True if the payload was created by MakePacket() as a copy.
+    bool copied = false;
+  };
+
+  absl::Mutex mutex_;
+  absl::flat_hash_map<const packet_internal::HolderBase*, HolderRecord>
+      records_ ABSL_GUARDED_BY(mutex_);
+  int num_attached_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PACKET_LIFETIME_H_
@@ -0,0 +1,91 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/packet_lifetime.h"
+
+#include <memory>
+#include <string>
+
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+class PacketLifetimeTrackerTest : public ::testing::Test {
+ protected:
+  void SetUp() override { PacketLifetimeTracker::Get().Attach(); }
+  void TearDown() override { PacketLifetimeTracker::Get().Detach(); }
+
+  std::shared_ptr<PacketLifetimeCounter> counter_ =
+      std::make_shared<PacketLifetimeCounter>();
+};
+
+TEST_F(PacketLifetimeTrackerTest, CountsReleasedPackets) {
+  {
+    Packet packet = MakePacket<std::string>("hello");
+    PacketLifetimeTracker::Get().TrackPacket(packet, counter_);
+    // A payload sent on several streams is counted once.
+    PacketLifetimeTracker::Get().TrackPacket(packet, counter_);
+    EXPECT_EQ(counter_->packets(), 1);
+    EXPECT_EQ(counter_->released_packets(), 0);
+  }
+  EXPECT_EQ(counter_->released_packets(), 1);
+  EXPECT_GE(counter_->total_lifetime_usec(), 0);
+  EXPECT_EQ(counter_->copied_packets(), 0);
+}
+
+TEST_F(PacketLifetimeTrackerTest, CountsConsumeOrCopy) {
+  Packet packet = MakePacket<std::string>("hello");
+  PacketLifetimeTracker::Get().TrackPacket(packet, counter_);
+  MP_ASSERT_OK(packet.ConsumeOrCopy<std::string>());
+  EXPECT_EQ(counter_->consumed_packets(), 1);
+  EXPECT_EQ(counter_->copied_packets(), 0);
+  EXPECT_EQ(counter_->released_packets(), 1);
+
+  packet = MakePacket<std::string>("world");
+  PacketLifetimeTracker::Get().TrackPacket(packet, counter_);
+  Packet shared = packet;
+  MP_ASSERT_OK(packet.ConsumeOrCopy<std::string>());
+  EXPECT_EQ(counter_->copied_packets(), 1);
+  // std::string has a size function in basic_types_registration.
+  EXPECT_GT(counter_->bytes_copied(), 0);
+  EXPECT_EQ(counter_->max_references(), 2);
+}
+
+TEST_F(PacketLifetimeTrackerTest, CountsMakePacketCopies) {
+  const std::string value = "hello";
+  Packet copied = MakePacket<std::string>(value);
+  Packet moved = MakePacket<std::string>(std::string("world"));
+  PacketLifetimeTracker::Get().TrackPacket(copied, counter_);
+  PacketLifetimeTracker::Get().TrackPacket(moved, counter_);
+  EXPECT_EQ(counter_->packets(), 2);
+  EXPECT_EQ(counter_->copied_packets(), 1);
+
+  PacketLifetimeTracker::Get().RecordCopy(moved);
+  EXPECT_EQ(counter_->copied_packets(), 2);
+}
+
+TEST_F(PacketLifetimeTrackerTest, IgnoresUntrackedPackets) {
+  Packet packet = MakePacket<std::string>("hello");
+  Packet shared = packet;
+  MP_ASSERT_OK(packet.ConsumeOrCopy<std::string>());
+  PacketLifetimeTracker::Get().RecordCopy(shared);
+  EXPECT_EQ(counter_->copied_packets(), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
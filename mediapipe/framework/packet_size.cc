@@ -0,0 +1,83 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/packet_size.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "absl/container/node_hash_map.h"
+#include "absl/log/absl_log.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deps/no_destructor.h"
+
+namespace mediapipe {
+namespace {
+
+// The registered size functions, keyed by TypeId hash code.
+class PacketBytesRegistry {
+ public:
+  static PacketBytesRegistry& Get() {
+    static NoDestructor<PacketBytesRegistry> registry;
+    return *registry;
+  }
+
+  void Register(TypeId type_id, packet_size_internal::PacketBytesFn fn) {
+    absl::MutexLock lock(&mutex_);
+    if (!functions_.emplace(type_id.hash_code(), std::move(fn)).second) {
+      ABSL_LOG(WARNING) << "A packet size function is already registered for "
+                        << type_id.name();
+    }
+  }
+
+  const packet_size_internal::PacketBytesFn* Find(TypeId type_id) {
+    absl::ReaderMutexLock lock(&mutex_);
+    auto it = functions_.find(type_id.hash_code());
+    // Functions are never removed and node_hash_map does not move them, so
+    // the pointer remains valid.
+    return it == functions_.end() ? nullptr : &it->second;
+  }
+
+ private:
+  absl::Mutex mutex_;
+  absl::node_hash_map<size_t, packet_size_internal::PacketBytesFn> functions_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace
+
+int64_t EstimatePacketBytes(const Packet& packet) {
+  if (packet.IsEmpty()) {
+    return 0;
+  }
+  const packet_size_internal::PacketBytesFn* fn =
+      PacketBytesRegistry::Get().Find(packet.GetTypeId());
+  return fn ? (*fn)(packet) : 0;
+}
+
+bool PacketBytesEstimatorIsRegistered(TypeId type_id) {
+  return PacketBytesRegistry::Get().Find(type_id) != nullptr;
+}
+
+namespace packet_size_internal {
+
+bool RegisterPacketBytesFn(TypeId type_id, PacketBytesFn fn) {
+  PacketBytesRegistry::Get().Register(type_id, std::move(fn));
+  return true;
+}
+
+}  // namespace packet_size_internal
+}  // namespace mediapipe
@@ -0,0 +1,125 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Estimates of the memory held by packets, used by the GraphProfiler to
+// account for the bytes queued in each input stream.
+//
+// The size of a packet type is estimated by a function registered alongside
+// the type, for example:
+//
+//   MEDIAPIPE_REGISTER_TYPE(::mediapipe::MyType, "::mediapipe::MyType",
+//                           nullptr, nullptr);
+//   MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::mediapipe::MyType,
+//                                     [](const ::mediapipe::MyType& value) {
+//                                       return sizeof(value) + value.size();
+//                                     });
+//
+// Packets of types without a registered function are counted as 0 bytes.
+
+#ifndef MEDIAPIPE_FRAMEWORK_PACKET_SIZE_H_
+#define MEDIAPIPE_FRAMEWORK_PACKET_SIZE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/tool/type_util.h"
+#include "mediapipe/framework/type_map.h"
+
+namespace mediapipe {
+
+// Returns the estimated number of bytes held by the payload of |packet|, or 0
+// if the packet is empty or no size function is registered for its type.
+int64_t EstimatePacketBytes(const Packet& packet);
+
+// Returns true if a size function is registered for |type_id|.
+bool PacketBytesEstimatorIsRegistered(TypeId type_id);
+
+namespace packet_size_internal {
+
+using PacketBytesFn = std::function<int64_t(const Packet& packet)>;
+
+// Registers |fn| to estimate the bytes of packets holding |type_id|.
+// Returns true, so that it can initialize a static variable.
+bool RegisterPacketBytesFn(TypeId type_id, PacketBytesFn fn);
+
+template <typename T, typename SizeFn>
+bool RegisterPacketSizeFn(SizeFn size_fn) {
+  return RegisterPacketBytesFn(kTypeId<T>, [size_fn](const Packet& packet) {
+    return static_cast<int64_t>(size_fn(packet.Get<T>()));
+  });
+}
+
+}  // namespace packet_size_internal
+
+// Registers |size_fn|, a function taking a const reference to |type| and
+// returning its size in bytes, as the size estimate for packets of |type|.
+// As for MEDIAPIPE_REGISTER_TYPE, types containing commas must be defined by
+// a macro in advance.
+#define MEDIAPIPE_REGISTER_PACKET_SIZE_FN(type, size_fn)                      \
+  static const bool TYPE_MAP_TEMP_OBJECT_NAME =                               \
+      ::mediapipe::packet_size_internal::RegisterPacketSizeFn<                \
+          ::mediapipe::type_map_internal::ReflectType<void(type*)>::Type>(    \
+          size_fn)
+
+// Counts the bytes held by the packets queued in an input stream, and their
+// high-water mark. A counter may have a parent, such as the counter of the
+// node owning the stream, which is updated with the same changes.
+class PacketMemoryCounter {
+ public:
+  explicit PacketMemoryCounter(PacketMemoryCounter* parent = nullptr)
+      : parent_(parent) {}
+
+  PacketMemoryCounter(const PacketMemoryCounter&) = delete;
+  PacketMemoryCounter& operator=(const PacketMemoryCounter&) = delete;
+
+  // Adds |bytes| to the live bytes, which may be negative when packets are
+  // released, and raises the high-water mark if needed.
+  void Add(int64_t bytes) {
+    if (bytes == 0) return;
+    const int64_t live =
+        live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (live > peak && !peak_bytes_.compare_exchange_weak(
+                              peak, live, std::memory_order_relaxed)) {
+    }
+    if (parent_) parent_->Add(bytes);
+  }
+
+  // The bytes held by the packets currently counted.
+  int64_t live_bytes() const {
+    return live_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // The largest value of live_bytes() since construction or ResetPeak().
+  int64_t peak_bytes() const {
+    return peak_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // Lowers the high-water mark to the current live bytes.
+  void ResetPeak() {
+    peak_bytes_.store(live_bytes(), std::memory_order_relaxed);
+  }
+
+ private:
+  PacketMemoryCounter* const parent_;
+  std::atomic<int64_t> live_bytes_{0};
+  std::atomic<int64_t> peak_bytes_{0};
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PACKET_SIZE_H_
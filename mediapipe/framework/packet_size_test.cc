@@ -0,0 +1,85 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/packet_size.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+
+struct SizedStruct {
+  std::vector<char> data;
+};
+
+struct UnsizedStruct {
+  int value = 0;
+};
+
+MEDIAPIPE_REGISTER_PACKET_SIZE_FN(::mediapipe::SizedStruct,
+                                  [](const ::mediapipe::SizedStruct& value) {
+                                    return value.data.size();
+                                  });
+
+namespace {
+
+TEST(PacketSizeTest, UsesRegisteredFunction) {
+  SizedStruct value;
+  value.data.resize(1234);
+  Packet packet = MakePacket<SizedStruct>(value);
+  EXPECT_TRUE(PacketBytesEstimatorIsRegistered(kTypeId<SizedStruct>));
+  EXPECT_EQ(EstimatePacketBytes(packet), 1234);
+}
+
+TEST(PacketSizeTest, UnregisteredOrEmptyPacketsHaveNoSize) {
+  EXPECT_FALSE(PacketBytesEstimatorIsRegistered(kTypeId<UnsizedStruct>));
+  EXPECT_EQ(EstimatePacketBytes(MakePacket<UnsizedStruct>()), 0);
+  EXPECT_EQ(EstimatePacketBytes(Packet()), 0);
+}
+
+TEST(PacketSizeTest, BasicTypesAreRegistered) {
+  std::string text(1000, 'x');
+  EXPECT_GE(EstimatePacketBytes(MakePacket<std::string>(text)), 1000);
+  EXPECT_GE(EstimatePacketBytes(MakePacket<std::vector<float>>(100)),
+            100 * sizeof(float));
+}
+
+TEST(PacketMemoryCounterTest, TracksPeakAndParent) {
+  PacketMemoryCounter node;
+  PacketMemoryCounter stream_1(&node);
+  PacketMemoryCounter stream_2(&node);
+
+  stream_1.Add(100);
+  stream_2.Add(50);
+  stream_1.Add(-100);
+  stream_2.Add(20);
+  EXPECT_EQ(stream_1.live_bytes(), 0);
+  EXPECT_EQ(stream_1.peak_bytes(), 100);
+  EXPECT_EQ(stream_2.live_bytes(), 70);
+  EXPECT_EQ(stream_2.peak_bytes(), 70);
+  EXPECT_EQ(node.live_bytes(), 70);
+  EXPECT_EQ(node.peak_bytes(), 150);
+
+  node.ResetPeak();
+  EXPECT_EQ(node.peak_bytes(), 70);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,148 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/profiler/critical_path.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+
+namespace mediapipe {
+
+namespace {
+
+using CalculatorTrace = GraphTrace::CalculatorTrace;
+
+// A PROCESS call in the dependency DAG of one input timestamp.
+struct Task {
+  const CalculatorTrace* trace;
+  // Indices of the tasks that output the input packets of this task.
+  std::vector<int> producers;
+  // Indices of the tasks that received the output packets of this task.
+  std::vector<int> consumers;
+  // The latest finish time that does not delay the last task.
+  int64_t latest_finish = 0;
+};
+
+int64_t Duration(const CalculatorTrace& trace) {
+  return trace.finish_time() - trace.start_time();
+}
+
+// Computes the critical path of the PROCESS calls at one input timestamp.
+void ComputeCriticalPath(int64_t input_timestamp,
+                         std::vector<const CalculatorTrace*> calls,
+                         TimestampCriticalPath* result) {
+  // Sorting by start time orders every producer before its consumers.
+  std::stable_sort(calls.begin(), calls.end(),
+                   [](const CalculatorTrace* a, const CalculatorTrace* b) {
+                     return std::make_pair(a->start_time(), a->finish_time()) <
+                            std::make_pair(b->start_time(), b->finish_time());
+                   });
+  std::vector<Task> tasks(calls.size());
+  absl::flat_hash_map<std::pair<int32_t, int64_t>, int> packet_producers;
+  for (int i = 0; i < calls.size(); ++i) {
+    tasks[i].trace = calls[i];
+    for (const auto& output : calls[i]->output_trace()) {
+      packet_producers[{output.stream_id(), output.packet_timestamp()}] = i;
+    }
+  }
+  for (int i = 0; i < tasks.size(); ++i) {
+    for (const auto& input : tasks[i].trace->input_trace()) {
+      auto it = packet_producers.find(
+          std::make_pair(input.stream_id(), input.packet_timestamp()));
+      // Only earlier tasks are accepted as producers, which keeps the graph
+      // acyclic even if a trace is inconsistent.
+      if (it == packet_producers.end() || it->second >= i) continue;
+      std::vector<int>& producers = tasks[i].producers;
+      if (std::find(producers.begin(), producers.end(), it->second) ==
+          producers.end()) {
+        producers.push_back(it->second);
+        tasks[it->second].consumers.push_back(i);
+      }
+    }
+  }
+
+  int64_t first_start = std::numeric_limits<int64_t>::max();
+  int64_t last_finish = std::numeric_limits<int64_t>::min();
+  int sink = 0;
+  for (int i = 0; i < tasks.size(); ++i) {
+    first_start = std::min(first_start, tasks[i].trace->start_time());
+    if (tasks[i].trace->finish_time() >= last_finish) {
+      last_finish = tasks[i].trace->finish_time();
+      sink = i;
+    }
+  }
+
+  // Backward pass: a task must finish before each consumer's latest start.
+  for (int i = tasks.size() - 1; i >= 0; --i) {
+    Task& task = tasks[i];
+    task.latest_finish = last_finish;
+    for (int consumer : task.consumers) {
+      task.latest_finish =
+          std::min(task.latest_finish, tasks[consumer].latest_finish -
+                                           Duration(*tasks[consumer].trace));
+    }
+  }
+
+  // Walk back from the last task through the producers that finished last.
+  std::vector<int> path = {sink};
+  while (!tasks[path.back()].producers.empty()) {
+    const std::vector<int>& producers = tasks[path.back()].producers;
+    path.push_back(*std::max_element(
+        producers.begin(), producers.end(), [&tasks](int a, int b) {
+          return tasks[a].trace->finish_time() < tasks[b].trace->finish_time();
+        }));
+  }
+
+  result->set_input_timestamp(input_timestamp);
+  result->set_latency(last_finish - first_start);
+  for (auto it = path.rbegin(); it != path.rend(); ++it) {
+    result->add_critical_path_node_id(tasks[*it].trace->node_id());
+  }
+  for (const Task& task : tasks) {
+    auto* timing = result->add_node_timing();
+    timing->set_node_id(task.trace->node_id());
+    timing->set_start_time(task.trace->start_time());
+    timing->set_finish_time(task.trace->finish_time());
+    timing->set_slack(
+        std::max<int64_t>(0, task.latest_finish - task.trace->finish_time()));
+  }
+}
+
+}  // namespace
+
+void ComputeCriticalPaths(const GraphTrace& trace, GraphCriticalPaths* result) {
+  result->Clear();
+  std::map<int64_t, std::vector<const CalculatorTrace*>> calls_by_timestamp;
+  for (const CalculatorTrace& call : trace.calculator_trace()) {
+    if (call.event_type() != GraphTrace::PROCESS ||
+        !call.has_input_timestamp() || !call.has_start_time() ||
+        !call.has_finish_time()) {
+      continue;
+    }
+    calls_by_timestamp[call.input_timestamp()].push_back(&call);
+  }
+  for (auto& [input_timestamp, calls] : calls_by_timestamp) {
+    ComputeCriticalPath(input_timestamp, std::move(calls),
+                        result->add_timestamp_path());
+  }
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,39 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_PROFILER_CRITICAL_PATH_H_
+#define MEDIAPIPE_FRAMEWORK_PROFILER_CRITICAL_PATH_H_
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+
+namespace mediapipe {
+
+// Computes the critical path of each input timestamp in a GraphTrace.
+//
+// For each input timestamp, the PROCESS calls at that timestamp form a DAG:
+// a call depends on the calls that output its input packets, matched by
+// stream id and packet timestamp. The critical path starts at the call that
+// finishes last and repeatedly steps to the producer that finished last, so
+// it is the chain of calls that bounds the timestamp's latency. The slack of
+// a call is how much later it could finish without delaying the last call,
+// assuming every downstream call keeps its duration.
+//
+// The trace must come from GraphTracer::GetTrace(), since only that format
+// matches input packets with the calls that output them. Timestamps with no
+// PROCESS call that both started and finished in the trace are skipped.
+void ComputeCriticalPaths(const GraphTrace& trace, GraphCriticalPaths* result);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PROFILER_CRITICAL_PATH_H_
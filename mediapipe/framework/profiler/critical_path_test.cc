@@ -0,0 +1,125 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/profiler/critical_path.h"
+
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+// A diamond at timestamp 0: node 1 feeds nodes 2 and 3, which both feed
+// node 4. Node 2 is the slower branch. Timestamp 100 has a single call.
+constexpr char kDiamondTrace[] = R"pb(
+  calculator_trace {
+    node_id: 1
+    input_timestamp: 0
+    event_type: PROCESS
+    start_time: 0
+    finish_time: 10
+    output_trace { packet_timestamp: 0 stream_id: 1 }
+  }
+  calculator_trace {
+    node_id: 3
+    input_timestamp: 0
+    event_type: PROCESS
+    start_time: 11
+    finish_time: 14
+    input_trace { packet_timestamp: 0 stream_id: 1 }
+    output_trace { packet_timestamp: 0 stream_id: 3 }
+  }
+  calculator_trace {
+    node_id: 2
+    input_timestamp: 0
+    event_type: PROCESS
+    start_time: 12
+    finish_time: 20
+    input_trace { packet_timestamp: 0 stream_id: 1 }
+    output_trace { packet_timestamp: 0 stream_id: 2 }
+  }
+  calculator_trace {
+    node_id: 4
+    input_timestamp: 0
+    event_type: PROCESS
+    start_time: 21
+    finish_time: 25
+    input_trace { packet_timestamp: 0 stream_id: 2 }
+    input_trace { packet_timestamp: 0 stream_id: 3 }
+  }
+  calculator_trace {
+    node_id: 1
+    input_timestamp: 100
+    event_type: PROCESS
+    start_time: 40
+    finish_time: 45
+  }
+  calculator_trace {
+    node_id: 1
+    input_timestamp: 200
+    event_type: PROCESS
+    start_time: 50
+  }
+  calculator_trace { node_id: 2 event_type: READY_FOR_PROCESS start_time: 1 }
+)pb";
+
+TEST(CriticalPathTest, FindsSlowestChainAndSlack) {
+  GraphTrace trace = ParseTextProtoOrDie<GraphTrace>(kDiamondTrace);
+  GraphCriticalPaths result;
+  ComputeCriticalPaths(trace, &result);
+  ASSERT_EQ(result.timestamp_path_size(), 2);
+
+  const TimestampCriticalPath& path = result.timestamp_path(0);
+  EXPECT_EQ(path.input_timestamp(), 0);
+  EXPECT_EQ(path.latency(), 25);
+  EXPECT_THAT(path.critical_path_node_id(), ElementsAre(1, 2, 4));
+  ASSERT_EQ(path.node_timing_size(), 4);
+  // The node timings are ordered by start time.
+  EXPECT_EQ(path.node_timing(0).node_id(), 1);
+  EXPECT_EQ(path.node_timing(0).slack(), 3);
+  EXPECT_EQ(path.node_timing(1).node_id(), 3);
+  EXPECT_EQ(path.node_timing(1).slack(), 7);
+  EXPECT_EQ(path.node_timing(2).node_id(), 2);
+  EXPECT_EQ(path.node_timing(2).slack(), 1);
+  EXPECT_EQ(path.node_timing(3).node_id(), 4);
+  EXPECT_EQ(path.node_timing(3).slack(), 0);
+}
+
+TEST(CriticalPathTest, SkipsIncompleteCalls) {
+  GraphTrace trace = ParseTextProtoOrDie<GraphTrace>(kDiamondTrace);
+  GraphCriticalPaths result;
+  ComputeCriticalPaths(trace, &result);
+  ASSERT_EQ(result.timestamp_path_size(), 2);
+
+  const TimestampCriticalPath& path = result.timestamp_path(1);
+  EXPECT_EQ(path.input_timestamp(), 100);
+  EXPECT_EQ(path.latency(), 5);
+  EXPECT_THAT(path.critical_path_node_id(), ElementsAre(1));
+  ASSERT_EQ(path.node_timing_size(), 1);
+  EXPECT_EQ(path.node_timing(0).slack(), 0);
+}
+
+TEST(CriticalPathTest, EmptyTrace) {
+  GraphCriticalPaths result;
+  result.add_timestamp_path();
+  ComputeCriticalPaths(GraphTrace(), &result);
+  EXPECT_EQ(result.timestamp_path_size(), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
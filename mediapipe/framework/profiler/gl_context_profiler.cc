@@ -13,13 +13,132 @@
 // limitations under the License.
 
 #include <memory>
+#include <utility>
 
-#include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
-#include "absl/memory/memory.h"
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "mediapipe/framework/profiler/graph_profiler.h"
 
-namespace mediapipe {}  // namespace mediapipe
+namespace mediapipe {
+
+namespace {
+
+// The GPU clock drifts relative to the CPU clock, so the offset between them
+// is measured again periodically.
+constexpr absl::Duration kRecalibrationInterval = absl::Seconds(1);
+
+}  // namespace
+
+absl::Time GlContextProfiler::TimeNow() {
+  std::shared_ptr<mediapipe::Clock> clock = profiling_context_->GetClock();
+  return clock ? clock->TimeNow() : absl::Now();
+}
+
+bool GlContextProfiler::Initialize() {
+  if (!checked_timing_supported_) {
+    checked_timing_supported_ = true;
+    timing_measurement_supported_ = gpu_timer_->Initialize();
+    if (!timing_measurement_supported_) {
+      ABSL_LOG(INFO) << "GPU timer queries are not supported by this context.";
+      return false;
+    }
+    CalibrateTimer();
+  }
+  return timing_measurement_supported_;
+}
+
+void GlContextProfiler::CalibrateTimer() {
+  // Bracket the GPU clock reading between two CPU clock readings, and assume
+  // that it was taken half way between them.
+  absl::Time cpu_before = TimeNow();
+  absl::optional<int64_t> gpu_time_ns = gpu_timer_->GetGpuTimeNs();
+  absl::Time cpu_after = TimeNow();
+  if (!gpu_time_ns) {
+    ABSL_LOG(WARNING) << "Unable to read the GPU clock, GPU timing disabled.";
+    timing_measurement_supported_ = false;
+    return;
+  }
+  absl::Time cpu_time = cpu_before + (cpu_after - cpu_before) / 2;
+  gpu_time_offset_ = cpu_time - absl::FromUnixNanos(*gpu_time_ns);
+  last_calibration_time_ = cpu_time;
+
+  TraceEvent event(GraphTrace::GPU_CALIBRATION);
+  event.set_event_time(cpu_time);
+  event.event_data = *gpu_time_ns;
+  profiling_context_->LogEvent(event);
+}
+
+void GlContextProfiler::MarkTimestamp(int node_id, Timestamp input_timestamp,
+                                      bool is_finish) {
+  if (!Initialize()) {
+    return;
+  }
+  if (gpu_timer_->CheckDisjoint()) {
+    DiscardPendingGlTimings();
+    CalibrateTimer();
+    if (!timing_measurement_supported_) {
+      return;
+    }
+  }
+  RetireReadyGlTimings();
+  if (!is_finish && pending_gl_times_.empty() &&
+      TimeNow() - last_calibration_time_ >= kRecalibrationInterval) {
+    CalibrateTimer();
+    if (!timing_measurement_supported_) {
+      return;
+    }
+  }
+
+  absl::optional<GpuTimer::Query> query = gpu_timer_->RequestTimestamp();
+  if (!query) {
+    return;
+  }
+  pending_gl_times_.push_back(
+      {*query, TraceEvent(GraphTrace::GPU_TASK)
+                   .set_node_id(node_id)
+                   .set_input_ts(input_timestamp)
+                   .set_is_finish(is_finish)});
+}
+
+void GlContextProfiler::RetireReadyGlTimings(bool wait) {
+  // Queries complete in the order they are issued.
+  while (!pending_gl_times_.empty()) {
+    GlTimingInfo& info = pending_gl_times_.front();
+    absl::optional<int64_t> gpu_time_ns =
+        gpu_timer_->GetTimestamp(info.query, wait);
+    if (!gpu_time_ns) {
+      if (wait) {
+        // The query failed and was released; drop its event.
+        pending_gl_times_.pop_front();
+        continue;
+      }
+      break;
+    }
+    info.trace_event.set_event_time(absl::FromUnixNanos(*gpu_time_ns) +
+                                    gpu_time_offset_);
+    profiling_context_->LogEvent(info.trace_event);
+    pending_gl_times_.pop_front();
+  }
+}
+
+void GlContextProfiler::DiscardPendingGlTimings() {
+  for (const GlTimingInfo& info : pending_gl_times_) {
+    gpu_timer_->ReleaseQuery(info.query);
+  }
+  pending_gl_times_.clear();
+}
+
+void GlContextProfiler::LogAllTimestamps() {
+  if (!timing_measurement_supported_) {
+    return;
+  }
+  if (gpu_timer_->CheckDisjoint()) {
+    DiscardPendingGlTimings();
+    return;
+  }
+  RetireReadyGlTimings(/*wait=*/true);
+}
+
+}  // namespace mediapipe
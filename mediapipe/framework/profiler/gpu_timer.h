@@ -0,0 +1,61 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_PROFILER_GPU_TIMER_H_
+#define MEDIAPIPE_FRAMEWORK_PROFILER_GPU_TIMER_H_
+
+#include <cstdint>
+
+#include "absl/types/optional.h"
+
+namespace mediapipe {
+
+// Reads the GPU clock for GlContextProfiler. The OpenGL implementation,
+// GlTimerQuery in mediapipe/gpu, is injected by GlContext so that the
+// profiler does not depend on OpenGL. All methods are called on the thread
+// of the GL context that owns the timer.
+class GpuTimer {
+ public:
+  using Query = uint32_t;
+
+  virtual ~GpuTimer() = default;
+
+  // Returns false if the context cannot measure GPU timestamps.
+  virtual bool Initialize() = 0;
+
+  // Returns the current GPU clock in nanoseconds, without waiting for
+  // pending GPU commands.
+  virtual absl::optional<int64_t> GetGpuTimeNs() = 0;
+
+  // Requests the GPU clock at the time all previously issued GPU commands
+  // have completed.
+  virtual absl::optional<Query> RequestTimestamp() = 0;
+
+  // Returns the GPU clock in nanoseconds recorded for `query`. If the GPU has
+  // not reached the query yet, waits for it if `wait` is true and otherwise
+  // returns nullopt. A query is released once its time is returned.
+  virtual absl::optional<int64_t> GetTimestamp(Query query, bool wait) = 0;
+
+  // Releases a query without reading its time.
+  virtual void ReleaseQuery(Query query) = 0;
+
+  // Returns true if the GPU clock has been disjoint since the previous call,
+  // e.g. due to a frequency change, so that pending timestamps are invalid.
+  virtual bool CheckDisjoint() = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PROFILER_GPU_TIMER_H_
@@ -44,6 +44,7 @@ namespace {
 const int kDefaultLogIntervalCount = 10;
 const int kDefaultLogFileCount = 2;
 const char kDefaultLogFilePrefix[] = "mediapipe_trace_";
+const int64_t kDefaultTraceRingCapacity = 262144;
 
 // The number of recent timestamps tracked for each input stream.
 const int kPacketInfoRecentCount = 400;
@@ -154,7 +155,11 @@ GraphProfiler::GraphProfiler()
       mediapipe::MonotonicClock::CreateSynchronizedMonotonicClock());
 }
 
-GraphProfiler::~GraphProfiler() {}
+GraphProfiler::~GraphProfiler() {
+  if (lifetime_tracker_attached_) {
+    PacketLifetimeTracker::Get().Detach();
+  }
+}
 
 void GraphProfiler::Initialize(
     const ValidatedGraphConfig& validated_graph_config) {
@@ -170,31 +175,61 @@ void GraphProfiler::Initialize(
   if (IsTracerEnabled(profiler_config_)) {
     packet_tracer_ = absl::make_unique<GraphTracer>(profiler_config_);
   }
+  std::vector<std::string> node_names;
   for (int node_id = 0;
        node_id < validated_graph_config.CalculatorInfos().size(); ++node_id) {
-    std::string node_name =
-        tool::CanonicalNodeName(validated_graph_config.Config(), node_id);
+    const std::string& node_name =
+        validated_graph_config.CalculatorInfos()[node_id]
+            .Contract()
+            .GetNodeName();
+    node_names.push_back(node_name);
     CalculatorProfile profile;
     profile.set_name(node_name);
     InitializeTimeHistogram(interval_size_usec, num_intervals,
                             profile.mutable_process_runtime());
+    const CalculatorGraphConfig::Node& node_config =
+        validated_graph_config.Config().node(node_id);
     if (profiler_config_.enable_stream_latency()) {
       InitializeTimeHistogram(interval_size_usec, num_intervals,
                               profile.mutable_process_input_latency());
       InitializeTimeHistogram(interval_size_usec, num_intervals,
                               profile.mutable_process_output_latency());
 
-      const CalculatorGraphConfig::Node& node_config =
-          validated_graph_config.Config().node(node_id);
       InitializeOutputStreams(node_config);
+    }
+    if (profiler_config_.enable_scheduling_latency()) {
+      if (profiler_config_.enable_stream_latency()) {
+        InitializeTimeHistogram(interval_size_usec, num_intervals,
+                                profile.mutable_process_input_wait_latency());
+      }
+      InitializeTimeHistogram(interval_size_usec, num_intervals,
+                              profile.mutable_process_queue_latency());
+      InitializeTimeHistogram(interval_size_usec, num_intervals,
+                              profile.mutable_process_dispatch_latency());
+    }
+    const bool memory_accounting = IsProfilerEnabled(profiler_config_) &&
+                                   profiler_config_.enable_memory_accounting();
+    if (profiler_config_.enable_stream_latency() || memory_accounting) {
       InitializeInputStreams(node_config, interval_size_usec, num_intervals,
                              &profile);
     }
+    if (memory_accounting) {
+      InitializeMemoryCounters(node_name, node_id,
+                               profile.input_stream_profiles_size());
+    }
+    if (IsProfilerEnabled(profiler_config_) &&
+        profiler_config_.enable_packet_lifetime()) {
+      InitializeLifetimeCounters(node_config, node_id, &profile);
+    }
 
     auto iter = calculator_profiles_.insert({node_name, profile});
     ABSL_CHECK(iter.second) << absl::Substitute(
         "Calculator \"$0\" has already been added.", node_name);
   }
+  if (profiler_config_.system_trace_enabled() && SystemTrace::Get()) {
+    system_trace_exporter_ = std::make_unique<SystemTraceExporter>(
+        SystemTrace::Get(), std::move(node_names));
+  }
   profile_builder_ = std::make_unique<GraphProfileBuilder>(this);
   graph_id_ = ++next_instance_id_;
 
@@ -233,17 +268,48 @@ void GraphProfiler::Reset() {
     ResetTimeHistogram(calculator_profile->mutable_process_runtime());
     ResetTimeHistogram(calculator_profile->mutable_process_input_latency());
     ResetTimeHistogram(calculator_profile->mutable_process_output_latency());
+    if (profiler_config_.enable_scheduling_latency()) {
+      ResetTimeHistogram(
+          calculator_profile->mutable_process_input_wait_latency());
+      ResetTimeHistogram(calculator_profile->mutable_process_queue_latency());
+      ResetTimeHistogram(
+          calculator_profile->mutable_process_dispatch_latency());
+    }
     for (auto& input_stream_profile :
          *(calculator_profile->mutable_input_stream_profiles())) {
       ResetTimeHistogram(input_stream_profile.mutable_latency());
     }
   }
+  for (auto& entry : memory_counters_) {
+    entry.second.node.ResetPeak();
+    for (auto& counter : entry.second.input_streams) {
+      counter->ResetPeak();
+    }
+  }
+  for (auto& entry : lifetime_counters_) {
+    for (auto& counter : entry.second) {
+      counter->Reset();
+    }
+  }
 }
 
 // Begins profiling for a single graph run.
 absl::Status GraphProfiler::Start(mediapipe::Executor* executor) {
   // If specified, start periodic profile output while the graph runs.
   Resume();
+  // If specified, stream trace events to the ring file rather than writing
+  // GraphProfile logs.
+  if (is_tracing_ && IsTraceLogEnabled(profiler_config_) && tracer() &&
+      profiler_config_.trace_log_streaming() && !trace_ring_exporter_) {
+    MP_ASSIGN_OR_RETURN(std::string trace_log_path, GetTraceLogPath());
+    auto exporter = CreateTraceRingExporter(trace_log_path);
+    if (exporter.ok()) {
+      trace_ring_exporter_ = std::move(exporter).value();
+    } else {
+      ABSL_LOG(ERROR) << "cannot stream trace events to: " << trace_log_path
+                      << ": " << exporter.status();
+    }
+  }
   if (is_tracing_ && IsTraceIntervalEnabled(profiler_config_, tracer()) &&
       executor != nullptr) {
     // Inform the user via logging the path to the trace logs.
@@ -306,6 +372,10 @@ void GraphProfiler::LogEvent(const TraceEvent& event) {
     }
   }
 
+  if (system_trace_exporter_) {
+    system_trace_exporter_->LogEvent(event);
+  }
+
   // Record event info in the profiling histograms.
   if (event.event_type == GraphTrace::PROCESS && event.node_id == -1) {
     AddPacketInfo(event);
@@ -347,10 +417,115 @@ absl::Status GraphProfiler::GetCalculatorProfiles(
       << "GetCalculatorProfiles can only be called after Initialize()";
   for (auto& entry : calculator_profiles_) {
     profiles->push_back(entry.second);
+    AddMemoryProfile(&profiles->back());
+    AddLifetimeProfile(&profiles->back());
   }
   return absl::OkStatus();
 }
 
+void GraphProfiler::InitializeMemoryCounters(const std::string& node_name,
+                                             int node_id,
+                                             int num_input_streams) {
+  NodeMemoryCounters& counters = memory_counters_[node_name];
+  for (int i = 0; i < num_input_streams; ++i) {
+    counters.input_streams.push_back(
+        std::make_unique<PacketMemoryCounter>(&counters.node));
+  }
+  memory_counters_by_id_.resize(node_id + 1, nullptr);
+  memory_counters_by_id_[node_id] = &counters;
+}
+
+void GraphProfiler::AddMemoryProfile(
+    CalculatorProfile* calculator_profile) const {
+  auto iter = memory_counters_.find(calculator_profile->name());
+  if (iter == memory_counters_.end()) {
+    return;
+  }
+  const NodeMemoryCounters& counters = iter->second;
+  calculator_profile->set_live_input_bytes(counters.node.live_bytes());
+  calculator_profile->set_peak_input_bytes(counters.node.peak_bytes());
+  for (int i = 0; i < counters.input_streams.size() &&
+                  i < calculator_profile->input_stream_profiles_size();
+       ++i) {
+    StreamProfile* stream_profile =
+        calculator_profile->mutable_input_stream_profiles(i);
+    stream_profile->set_live_bytes(counters.input_streams[i]->live_bytes());
+    stream_profile->set_peak_bytes(counters.input_streams[i]->peak_bytes());
+  }
+}
+
+PacketMemoryCounter* GraphProfiler::GetInputStreamMemoryCounter(
+    int node_id, int input_index) {
+  if (node_id < 0 || node_id >= memory_counters_by_id_.size() ||
+      !memory_counters_by_id_[node_id]) {
+    return nullptr;
+  }
+  auto& input_streams = memory_counters_by_id_[node_id]->input_streams;
+  if (input_index < 0 || input_index >= input_streams.size()) {
+    return nullptr;
+  }
+  return input_streams[input_index].get();
+}
+
+void GraphProfiler::InitializeLifetimeCounters(
+    const CalculatorGraphConfig::Node& node_config, int node_id,
+    CalculatorProfile* calculator_profile) {
+  if (!lifetime_tracker_attached_) {
+    PacketLifetimeTracker::Get().Attach();
+    lifetime_tracker_attached_ = true;
+  }
+  StreamLifetimeCounters& counters =
+      lifetime_counters_[calculator_profile->name()];
+  std::shared_ptr<tool::TagMap> output_tag_map =
+      TagMap::Create(node_config.output_stream()).value();
+  for (const std::string& output_stream_name : output_tag_map->Names()) {
+    calculator_profile->add_output_stream_profiles()->set_name(
+        output_stream_name);
+    counters.push_back(std::make_shared<PacketLifetimeCounter>());
+  }
+  lifetime_counters_by_id_.resize(node_id + 1, nullptr);
+  lifetime_counters_by_id_[node_id] = &counters;
+}
+
+void GraphProfiler::AddLifetimeProfile(
+    CalculatorProfile* calculator_profile) const {
+  auto iter = lifetime_counters_.find(calculator_profile->name());
+  if (iter == lifetime_counters_.end()) {
+    return;
+  }
+  const StreamLifetimeCounters& counters = iter->second;
+  for (int i = 0; i < counters.size() &&
+                  i < calculator_profile->output_stream_profiles_size();
+       ++i) {
+    const PacketLifetimeCounter& counter = *counters[i];
+    PacketLifetimeProfile* lifetime =
+        calculator_profile->mutable_output_stream_profiles(i)
+            ->mutable_packet_lifetime();
+    lifetime->set_packets(counter.packets());
+    lifetime->set_released_packets(counter.released_packets());
+    lifetime->set_total_lifetime_usec(counter.total_lifetime_usec());
+    lifetime->set_max_lifetime_usec(counter.max_lifetime_usec());
+    lifetime->set_copied_packets(counter.copied_packets());
+    lifetime->set_bytes_copied(counter.bytes_copied());
+    lifetime->set_consumed_packets(counter.consumed_packets());
+    lifetime->set_max_references(counter.max_references());
+  }
+}
+
+std::shared_ptr<PacketLifetimeCounter>
+GraphProfiler::GetOutputStreamLifetimeCounter(int node_id, int output_index) {
+  if (node_id < 0 || node_id >= lifetime_counters_by_id_.size() ||
+      !lifetime_counters_by_id_[node_id]) {
+    return nullptr;
+  }
+  const StreamLifetimeCounters& output_streams =
+      *lifetime_counters_by_id_[node_id];
+  if (output_index < 0 || output_index >= output_streams.size()) {
+    return nullptr;
+  }
+  return output_streams[output_index];
+}
+
 void GraphProfiler::InitializeTimeHistogram(int64_t interval_size_usec,
                                             int64_t num_intervals,
                                             TimeHistogram* histogram) {
@@ -434,10 +609,12 @@ void GraphProfiler::AddPacketInfoForOutputPackets(
 
 int64_t GraphProfiler::AddStreamLatencies(
     const CalculatorContext& calculator_context, int64_t start_time_usec,
-    int64_t end_time_usec, CalculatorProfile* calculator_profile) {
+    int64_t end_time_usec, CalculatorProfile* calculator_profile,
+    int64_t* min_production_time_usec) {
   // Update input streams profiles.
-  int64_t min_source_process_start_usec = AddInputStreamTimeSamples(
-      calculator_context, start_time_usec, calculator_profile);
+  int64_t min_source_process_start_usec =
+      AddInputStreamTimeSamples(calculator_context, start_time_usec,
+                                calculator_profile, min_production_time_usec);
 
   // Update output production times.
   AddPacketInfoForOutputPackets(calculator_context.Outputs(), end_time_usec,
@@ -511,7 +688,7 @@ void GraphProfiler::AddTimeSample(int64_t start_time_usec,
 
 int64_t GraphProfiler::AddInputStreamTimeSamples(
     const CalculatorContext& calculator_context, int64_t start_time_usec,
-    CalculatorProfile* calculator_profile) {
+    CalculatorProfile* calculator_profile, int64_t* min_production_time_usec) {
   int64_t input_timestamp_usec = calculator_context.InputTimestamp().Value();
   int64_t min_source_process_start_usec = start_time_usec;
   int64_t input_stream_counter = -1;
@@ -542,6 +719,10 @@ int64_t GraphProfiler::AddInputStreamTimeSamples(
 
     min_source_process_start_usec = std::min(
         min_source_process_start_usec, packet_info->source_process_start_usec);
+    if (min_production_time_usec != nullptr) {
+      *min_production_time_usec = std::min(*min_production_time_usec,
+                                           packet_info->production_time_usec);
+    }
   }
 
   return min_source_process_start_usec;
@@ -566,22 +747,65 @@ void GraphProfiler::AddProcessSample(
   AddTimeSample(start_time_usec, end_time_usec,
                 calculator_profile->mutable_process_runtime());
 
+  // The scheduling times are only valid if the context went through the
+  // scheduler queue since its previous Process() call.
+  const bool scheduling_latency =
+      profiler_config_.enable_scheduling_latency() &&
+      calculator_context.dispatched_time_usec_ != 0;
   if (profiler_config_.enable_stream_latency()) {
-    int64_t min_source_process_start_usec = AddStreamLatencies(
-        calculator_context, start_time_usec, end_time_usec, calculator_profile);
+    int64_t min_production_time_usec = start_time_usec;
+    int64_t min_source_process_start_usec =
+        AddStreamLatencies(calculator_context, start_time_usec, end_time_usec,
+                           calculator_profile, &min_production_time_usec);
     // Update input and output trace latencies.
     AddTimeSample(min_source_process_start_usec, start_time_usec,
                   calculator_profile->mutable_process_input_latency());
     AddTimeSample(min_source_process_start_usec, end_time_usec,
                   calculator_profile->mutable_process_output_latency());
+    if (scheduling_latency) {
+      // Source nodes have no input packets, and spend no time waiting.
+      AddTimeSample(
+          std::min(min_production_time_usec,
+                   calculator_context.queued_time_usec_),
+          calculator_context.queued_time_usec_,
+          calculator_profile->mutable_process_input_wait_latency());
+    }
+  }
+  if (scheduling_latency) {
+    AddTimeSample(calculator_context.queued_time_usec_,
+                  calculator_context.dispatched_time_usec_,
+                  calculator_profile->mutable_process_queue_latency());
+    AddTimeSample(calculator_context.dispatched_time_usec_, start_time_usec,
+                  calculator_profile->mutable_process_dispatch_latency());
+    calculator_context.queued_time_usec_ = 0;
+    calculator_context.dispatched_time_usec_ = 0;
   }
 }
 
-std::unique_ptr<GlProfilingHelper> GraphProfiler::CreateGlProfilingHelper() {
-  if (!IsTracerEnabled(profiler_config_)) {
+void GraphProfiler::MarkContextQueued(CalculatorContext* calculator_context) {
+  if (!is_profiling_ || !profiler_config_.enable_scheduling_latency()) {
+    return;
+  }
+  calculator_context->queued_time_usec_ = TimeNowUsec();
+  calculator_context->dispatched_time_usec_ = 0;
+}
+
+void GraphProfiler::MarkContextDispatched(
+    CalculatorContext* calculator_context) {
+  if (!is_profiling_ || !profiler_config_.enable_scheduling_latency() ||
+      calculator_context->queued_time_usec_ == 0) {
+    return;
+  }
+  calculator_context->dispatched_time_usec_ = TimeNowUsec();
+}
+
+std::unique_ptr<GlProfilingHelper> GraphProfiler::CreateGlProfilingHelper(
+    std::unique_ptr<GpuTimer> gpu_timer) {
+  if (!IsTracerEnabled(profiler_config_) || !gpu_timer) {
     return nullptr;
   }
-  return absl::make_unique<mediapipe::GlProfilingHelper>(shared_from_this());
+  return absl::make_unique<mediapipe::GlProfilingHelper>(shared_from_this(),
+                                                         std::move(gpu_timer));
 }
 
 // A simple ZeroCopyOutputStream that writes to a std::ostream.
@@ -624,11 +848,7 @@ void AssignNodeNames(GraphProfile* profile) {
   if (graph_trace) {
     graph_trace->clear_calculator_name();
   }
-  std::vector<std::string> canonical_names;
-  canonical_names.reserve(graph_config->node().size());
-  for (int i = 0; i < graph_config->node().size(); ++i) {
-    canonical_names.push_back(CanonicalNodeName(*graph_config, i));
-  }
+  std::vector<std::string> canonical_names = CanonicalNodeNames(*graph_config);
   for (int i = 0; i < graph_config->node().size(); ++i) {
     graph_config->mutable_node(i)->set_name(canonical_names[i]);
   }
@@ -654,6 +874,13 @@ void CleanCalculatorProfiles(GraphProfile* profile) {
     CleanTimeHistogram(p.mutable_process_runtime());
     CleanTimeHistogram(p.mutable_process_input_latency());
     CleanTimeHistogram(p.mutable_process_output_latency());
+    if (p.has_process_input_wait_latency()) {
+      CleanTimeHistogram(p.mutable_process_input_wait_latency());
+    }
+    if (p.has_process_queue_latency()) {
+      CleanTimeHistogram(p.mutable_process_queue_latency());
+      CleanTimeHistogram(p.mutable_process_dispatch_latency());
+    }
     for (StreamProfile& s : *p.mutable_input_stream_profiles()) {
       CleanTimeHistogram(s.mutable_latency());
     }
@@ -676,6 +903,16 @@ absl::StatusOr<std::string> GraphProfiler::GetTraceLogPath() {
   }
 }
 
+absl::StatusOr<std::unique_ptr<TraceRingExporter>>
+GraphProfiler::CreateTraceRingExporter(const std::string& trace_log_path) {
+  const CalculatorGraphConfig& config = validated_graph_->Config();
+  std::vector<std::string> node_names = CanonicalNodeNames(config);
+  int64_t capacity = profiler_config_.trace_log_ring_capacity() > 0
+                         ? profiler_config_.trace_log_ring_capacity()
+                         : kDefaultTraceRingCapacity;
+  return TraceRingExporter::Create(trace_log_path, capacity, node_names);
+}
+
 absl::Status GraphProfiler::CaptureProfile(
     GraphProfile* result, PopulateGraphConfig populate_config) {
   // Record the GraphTrace events since the previous WriteProfile.
@@ -717,6 +954,10 @@ absl::Status GraphProfiler::WriteProfile() {
     // Logging is disabled, so we can exit writing without error.
     return absl::OkStatus();
   }
+  if (trace_ring_exporter_) {
+    // Only the trace events are streamed, without serializing a GraphProfile.
+    return trace_ring_exporter_->Export(tracer()->GetTraceBuffer());
+  }
   MP_ASSIGN_OR_RETURN(std::string trace_log_path, GetTraceLogPath());
   int log_interval_count = GetLogIntervalCount(profiler_config_);
   int log_file_count = GetLogFileCount(profiler_config_);
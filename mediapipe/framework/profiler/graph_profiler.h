@@ -18,6 +18,8 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -30,8 +32,13 @@
 #include "mediapipe/framework/deps/clock.h"
 #include "mediapipe/framework/deps/monotonic_clock.h"
 #include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/packet_lifetime.h"
+#include "mediapipe/framework/packet_size.h"
+#include "mediapipe/framework/profiler/gpu_timer.h"
 #include "mediapipe/framework/profiler/graph_tracer.h"
 #include "mediapipe/framework/profiler/sharded_map.h"
+#include "mediapipe/framework/profiler/system_trace.h"
+#include "mediapipe/framework/profiler/trace_ring_file.h"
 #include "mediapipe/framework/validated_graph_config.h"
 
 namespace mediapipe {
@@ -159,13 +166,37 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
 
   // Writes recent profiling and tracing data to a file specified in the
   // ProfilerConfig.  Includes events since the previous call to WriteProfile.
+  // If trace_log_streaming is set, only the new trace events are written,
+  // to the trace ring file.
   absl::Status WriteProfile();
 
   // Returns the trace event buffer.
   GraphTracer* tracer() { return packet_tracer_.get(); }
 
-  // Creates and returns a GlProfilingHelper interface for a single GLContext.
-  std::unique_ptr<GlProfilingHelper> CreateGlProfilingHelper();
+  // Returns the counter for the bytes queued in the input stream with index
+  // |input_index| of node |node_id|, or nullptr if enable_memory_accounting
+  // is not set. The counter lives as long as the profiler.
+  PacketMemoryCounter* GetInputStreamMemoryCounter(int node_id,
+                                                   int input_index);
+
+  // Returns the counter for the lifetimes of the packets sent on the output
+  // stream with index |output_index| of node |node_id|, or nullptr if
+  // enable_packet_lifetime is not set.
+  std::shared_ptr<PacketLifetimeCounter> GetOutputStreamLifetimeCounter(
+      int node_id, int output_index);
+
+  // Record when |calculator_context| is queued for execution by the scheduler
+  // and when a worker thread takes it from the queue. The next Process() call
+  // for the context then reports its scheduling latencies. No-op unless
+  // enable_scheduling_latency is set.
+  void MarkContextQueued(CalculatorContext* calculator_context);
+  void MarkContextDispatched(CalculatorContext* calculator_context);
+
+  // Creates and returns a GlProfilingHelper interface for a single GLContext,
+  // which measures GPU times using |gpu_timer|. Returns nullptr if tracing is
+  // disabled or |gpu_timer| is null.
+  std::unique_ptr<GlProfilingHelper> CreateGlProfilingHelper(
+      std::unique_ptr<GpuTimer> gpu_timer);
 
   // Convenience temporary object to record scoped entry and exit.
   // Gets start_time_usec_ on construction and records process runtime on
@@ -188,9 +219,16 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
         profiler_->packet_tracer_->LogInputEvents(
             calculator_method_, &calculator_context_, time_now);
       }
+      system_traced_ = profiler_->system_trace_exporter_ &&
+                       profiler_->system_trace_exporter_->BeginCall(
+                           calculator_method_, calculator_context_);
     }
 
     inline ~Scope() {
+      if (system_traced_) {
+        profiler_->system_trace_exporter_->EndCall(calculator_method_,
+                                                   calculator_context_);
+      }
       int64_t end_time_usec;
       if (profiler_->is_profiling_ || profiler_->is_tracing_) {
         end_time_usec = profiler_->TimeNowUsec();
@@ -228,6 +266,7 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
     const CalculatorContext& calculator_context_;
     GraphProfiler* profiler_;
     int64_t start_time_usec_;
+    bool system_traced_;
   };
 
   const ProfilerConfig& profiler_config() { return profiler_config_; }
@@ -268,6 +307,18 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   void InitializeInputStreams(const CalculatorGraphConfig::Node& node_config,
                               int64_t interval_size_usec, int64_t num_intervals,
                               CalculatorProfile* calculator_profile);
+  // Creates the memory counters for a calculator and its input streams.
+  void InitializeMemoryCounters(const std::string& node_name, int node_id,
+                                int num_input_streams);
+  // Copies the memory counters of a calculator into its profile.
+  void AddMemoryProfile(CalculatorProfile* calculator_profile) const;
+  // Creates the packet lifetime counters for the output streams of a
+  // calculator, and adds their stream profiles to |calculator_profile|.
+  void InitializeLifetimeCounters(
+      const CalculatorGraphConfig::Node& node_config, int node_id,
+      CalculatorProfile* calculator_profile);
+  // Copies the packet lifetime counters of a calculator into its profile.
+  void AddLifetimeProfile(CalculatorProfile* calculator_profile) const;
   // Returns the input stream back edges for a calculator.
   std::set<int> GetBackEdgeIds(const CalculatorGraphConfig::Node& node_config,
                                const tool::TagMap& input_tag_map);
@@ -281,9 +332,12 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
       int64_t production_time_usec, int64_t source_process_start_usec);
 
   // Updates the production time for outputs and the stream profile for inputs.
+  // If |min_production_time_usec| is not null, it is lowered to the earliest
+  // production time of the input packets.
   int64_t AddStreamLatencies(const CalculatorContext& calculator_context,
                              int64_t start_time_usec, int64_t end_time_usec,
-                             CalculatorProfile* calculator_profile);
+                             CalculatorProfile* calculator_profile,
+                             int64_t* min_production_time_usec = nullptr);
 
   void SetOpenRuntime(const CalculatorContext& calculator_context,
                       int64_t start_time_usec, int64_t end_time_usec)
@@ -297,7 +351,8 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // packets and back-edge packets. Returns -1 if there is no input packets.
   int64_t AddInputStreamTimeSamples(const CalculatorContext& calculator_context,
                                     int64_t start_time_usec,
-                                    CalculatorProfile* calculator_profile);
+                                    CalculatorProfile* calculator_profile,
+                                    int64_t* min_production_time_usec);
 
   // Updates the Process() data for calculator.
   // Requires ReaderLock for is_profiling_.
@@ -310,6 +365,10 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // trace_log_path.
   absl::StatusOr<std::string> GetTraceLogPath();
 
+  // Creates the exporter for the trace ring file under `trace_log_path`.
+  absl::StatusOr<std::unique_ptr<TraceRingExporter>> CreateTraceRingExporter(
+      const std::string& trace_log_path);
+
   // Helper method to get the clock time in microsecond.
   int64_t TimeNowUsec() { return ToUnixMicros(clock_->TimeNow()); }
 
@@ -338,6 +397,29 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // Global mutex for the profiler.
   mutable absl::Mutex profiler_mutex_;
 
+  // Counts the bytes queued for a calculator and for each of its input
+  // streams, if enable_memory_accounting is set.
+  struct NodeMemoryCounters {
+    PacketMemoryCounter node;
+    std::vector<std::unique_ptr<PacketMemoryCounter>> input_streams;
+  };
+  // Keyed by calculator name, written only in Initialize().
+  std::map<std::string, NodeMemoryCounters> memory_counters_;
+  // Indexed by node id.
+  std::vector<NodeMemoryCounters*> memory_counters_by_id_;
+
+  // Counts the packet lifetimes for each output stream of each calculator, if
+  // enable_packet_lifetime is set. Shared with PacketLifetimeTracker, which
+  // may outlive the profiler. Keyed by calculator name and written only in
+  // Initialize().
+  using StreamLifetimeCounters =
+      std::vector<std::shared_ptr<PacketLifetimeCounter>>;
+  std::map<std::string, StreamLifetimeCounters> lifetime_counters_;
+  // Indexed by node id.
+  std::vector<StreamLifetimeCounters*> lifetime_counters_by_id_;
+  // Whether this profiler is attached to PacketLifetimeTracker.
+  bool lifetime_tracker_attached_ = false;
+
   // Buffer of recent profile trace events.
   std::unique_ptr<GraphTracer> packet_tracer_;
 
@@ -353,6 +435,12 @@ class GraphProfiler : public std::enable_shared_from_this<ProfilingContext> {
   // The index number of the previous output log.
   std::atomic<int> previous_log_index_;
 
+  // Writes trace events to the system trace, if system_trace_enabled is set.
+  std::unique_ptr<SystemTraceExporter> system_trace_exporter_;
+
+  // Streams trace events into a ring file, if trace_log_streaming is set.
+  std::unique_ptr<TraceRingExporter> trace_ring_exporter_;
+
   // The configuration for the graph being profiled.
   const ValidatedGraphConfig* validated_graph_;
 
@@ -378,43 +466,39 @@ class ProfilingContext : public GraphProfiler {
   using GraphProfiler::GraphProfiler;
 };
 
-// For now, OSS always uses GlContextProfilerStub.
-// TODO: Switch to GlContextProfiler when GlContext is moved to OSS.
-#define MEDIAPIPE_DISABLE_GPU_PROFILER 1
-
 // GlContextProfiler keeps track of all timestamp queries within a specific
-// GlContext object. When created, the GlContextProfiler must be initialized
-// before marking timestamps. Finally, when GlContext is no longer interested
-// in marking timestamps or is about to be destroyed, Finish() must be called
-// to complete all pending time queries and detach the timer from the GlContext.
-// Note that the GlContextProfiler must be created and initialized within a
-// valid GlContext object.
-#if !MEDIAPIPE_DISABLE_GPU_PROFILER
+// GlContext object. Timestamps are measured by a GpuTimer, which reads the GPU
+// clock using timer queries and is calibrated against the profiler clock.
+// Queries are read back without blocking the GL thread: each call to
+// MarkTimestamp logs the queries that the GPU has already completed. When
+// GlContext is no longer interested in marking timestamps or is about to be
+// destroyed, LogAllTimestamps() must be called to complete all pending time
+// queries. All methods must be called within the GlContext that owns the
+// GpuTimer.
 class GlContextProfiler {
  public:
-  explicit GlContextProfiler(
-      std::shared_ptr<ProfilingContext> profiling_context)
-      : profiling_context_(profiling_context) {}
+  GlContextProfiler(std::shared_ptr<ProfilingContext> profiling_context,
+                    std::unique_ptr<GpuTimer> gpu_timer)
+      : profiling_context_(profiling_context),
+        gpu_timer_(std::move(gpu_timer)) {}
 
   // Not copyable or movable.
   GlContextProfiler(const GlContextProfiler&) = delete;
   GlContextProfiler& operator=(const GlContextProfiler&) = delete;
 
-  // Add a GlTimingInfo object to the collection of pending timestamp queries
-  // associated with a specific graph node_id, packet input_timestamp and mark
-  // if it is a start or stop event. When a stop event is marked, this function
-  // blocks on the corresponding start event to complete.
+  // Requests a GPU timestamp associated with a specific graph node_id, packet
+  // input_timestamp, and whether it is a start or stop event. The timestamp is
+  // logged as a GPU_TASK event once the GPU reaches it.
   void MarkTimestamp(int node_id, Timestamp input_timestamp, bool is_finish);
 
-  // Complete all pending timing queries and detach the timer from the
-  // GlContext.
+  // Complete all pending timing queries.
   void LogAllTimestamps();
 
  private:
-  // Store GlTimeQuery and the corresponding TraceEvent object that should be
-  // populated when the query completes together.
+  // A pending GpuTimer query and the TraceEvent object that should be
+  // populated when the query completes.
   struct GlTimingInfo {
-    GlTimeQuery time_query;
+    GpuTimer::Query query;
     TraceEvent trace_event;
   };
 
@@ -425,30 +509,26 @@ class GlContextProfiler {
 
   absl::Time TimeNow();
 
-  // Calibrate the GPU timer w.r.t. the CPU clock. If calibration is fails,
+  // Calibrate the GPU timer w.r.t. the CPU clock. If calibration fails,
   // timing_measurement_supported_ is set to false.
-  void CalibrateTimer(bool recalibrate);
-
-  // Log a TraceEvent object to represent if the GPU calibration period has
-  // started or just ended.
-  void LogCalibrationEvent(bool started, absl::Time time);
+  void CalibrateTimer();
 
   // Log TraceEvent objects for completed time queries. If the parameter wait is
   // set to true, wait for all time queries to complete before returning.
   void RetireReadyGlTimings(bool wait = false);
 
-  // Get the TraceEvent object containing the timestamp recorded by the GPU if
-  // the provided query was fulfilled. If it is still pending and wait is false,
-  // return absl::nullopt.
-  absl::optional<TraceEvent> GetTimeFromQuery(
-      std::unique_ptr<GlTimingInfo>& query, bool wait);
+  // Drops all pending queries, whose times are invalid after a disjoint
+  // operation.
+  void DiscardPendingGlTimings();
 
   std::shared_ptr<ProfilingContext> profiling_context_;
-  GlSimpleTimer gl_timer_;
+  std::unique_ptr<GpuTimer> gpu_timer_;
   bool checked_timing_supported_ = false;
   bool timing_measurement_supported_ = false;
-  std::deque<std::unique_ptr<GlTimingInfo>> pending_gl_times_;
-  std::unique_ptr<GlTimingInfo> gl_start_query_;
+  // The CPU time minus the GPU time, from the last calibration.
+  absl::Duration gpu_time_offset_;
+  absl::Time last_calibration_time_;
+  std::deque<GlTimingInfo> pending_gl_times_;
 };
 
 // The API class used to access the preferred GlContext profiler, such as
@@ -458,23 +538,6 @@ class GlContextProfiler {
 class GlProfilingHelper : public GlContextProfiler {
   using GlContextProfiler::GlContextProfiler;
 };
-#else   // MEDIAPIPE_DISABLE_GPU_PROFILER
-class GlContextProfilerStub {
- public:
-  explicit GlContextProfilerStub(
-      std::shared_ptr<ProfilingContext> profiling_context) {}
-  // Not copyable or movable.
-  GlContextProfilerStub(const GlContextProfilerStub&) = delete;
-  GlContextProfilerStub& operator=(const GlContextProfilerStub&) = delete;
-  bool Initialze() { return false; }
-  void MarkTimestamp(int node_id, Timestamp input_timestamp, bool is_finish) {}
-  void LogAllTimestamps() {}
-};
-class GlProfilingHelper : public GlContextProfilerStub {
-  using GlContextProfilerStub::GlContextProfilerStub;
-};
-#endif  // !MEDIAPIPE_DISABLE_GPU_PROFILER
-#undef MEDIAPIPE_DISABLE_GPU_PROFILER
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_FRAMEWORK_PROFILER_GRAPH_PROFILER_H_
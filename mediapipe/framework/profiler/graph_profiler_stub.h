@@ -16,8 +16,10 @@
 #define MEDIAPIPE_FRAMEWORK_PROFILER_MEDIAPIPE_PROFILER_STUB_H_
 
 #include <cstdint>
+#include <memory>
 
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/profiler/gpu_timer.h"
 #include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
@@ -31,9 +33,12 @@ using mediapipe::CalculatorProfile;
 using mediapipe::GraphProfile;
 using mediapipe::GraphTrace;
 
+class CalculatorContext;
 class ValidatedGraphConfig;
 class Executor;
 class Packet;
+class PacketLifetimeCounter;
+class PacketMemoryCounter;
 class Clock;
 class GraphTracer;
 class GlProfilingHelper;
@@ -104,7 +109,18 @@ class GraphProfilerStub {
   }
   inline absl::Status Stop() { return absl::OkStatus(); }
   inline GraphTracer* tracer() { return nullptr; }
-  inline std::unique_ptr<GlProfilingHelper> CreateGlProfilingHelper() {
+  inline PacketMemoryCounter* GetInputStreamMemoryCounter(int node_id,
+                                                          int input_index) {
+    return nullptr;
+  }
+  inline std::shared_ptr<PacketLifetimeCounter> GetOutputStreamLifetimeCounter(
+      int node_id, int output_index) {
+    return nullptr;
+  }
+  inline void MarkContextQueued(CalculatorContext* calculator_context) {}
+  inline void MarkContextDispatched(CalculatorContext* calculator_context) {}
+  inline std::unique_ptr<GlProfilingHelper> CreateGlProfilingHelper(
+      std::unique_ptr<GpuTimer> gpu_timer) {
     return nullptr;
   }
   const std::shared_ptr<mediapipe::Clock> GetClock() const { return nullptr; }
@@ -120,8 +136,8 @@ class ProfilingContext : public GraphProfilerStub {};
 // GlContextProfiler when the main implementation is disabled.
 class GlContextProfilerStub {
  public:
-  explicit GlContextProfilerStub(
-      std::shared_ptr<ProfilingContext> profiling_context) {}
+  GlContextProfilerStub(std::shared_ptr<ProfilingContext> profiling_context,
+                        std::unique_ptr<GpuTimer> gpu_timer) {}
   // Not copyable or movable.
   GlContextProfilerStub(const GlContextProfilerStub&) = delete;
   GlContextProfilerStub& operator=(const GlContextProfilerStub&) = delete;
@@ -24,6 +24,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/mediapipe_profiling.h"
+#include "mediapipe/framework/packet_size.h"
 #include "mediapipe/framework/port/core_proto_inc.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -113,6 +114,33 @@ PacketInfo* GetPacketInfo(PacketInfoMap* map, const PacketId& packet_id) {
   }
   return nullptr;
 }
+
+// A GpuTimer whose GPU clock and query completion are set by the test.
+class FakeGpuTimer : public GpuTimer {
+ public:
+  bool Initialize() override { return true; }
+  absl::optional<int64_t> GetGpuTimeNs() override { return gpu_time_ns; }
+  absl::optional<Query> RequestTimestamp() override {
+    query_times_.push_back(gpu_time_ns);
+    return query_times_.size() - 1;
+  }
+  absl::optional<int64_t> GetTimestamp(Query query, bool wait) override {
+    if (!wait && query >= completed_queries) {
+      return absl::nullopt;
+    }
+    return query_times_[query];
+  }
+  void ReleaseQuery(Query query) override {}
+  bool CheckDisjoint() override { return false; }
+
+  // The current GPU time.
+  int64_t gpu_time_ns = 0;
+  // The number of queries that the GPU has reached.
+  size_t completed_queries = 0;
+
+ private:
+  std::vector<int64_t> query_times_;
+};
 }  // namespace
 
 class GraphProfilerTestPeer : public testing::Test {
@@ -1184,6 +1212,86 @@ TEST_F(GraphProfilerTestPeer, AddProcessSampleWithStreamLatency) {
   ASSERT_NE(GetPacketInfo(GetPacketsInfoMap(), {"stream_1", 100}), nullptr);
 }
 
+// Tests that AddProcessSample() splits the time before Process() into the
+// input wait, queue and dispatch latencies marked by the scheduler.
+TEST_F(GraphProfilerTestPeer, AddProcessSampleWithSchedulingLatency) {
+  InitializeProfilerWithGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      enable_stream_latency: true
+      enable_scheduling_latency: true
+    }
+    node {
+      calculator: "DummyTestCalculator"
+      name: "source_calc"
+      output_stream: "stream_0"
+    }
+    node {
+      calculator: "DummyTestCalculator"
+      name: "consumer_calc"
+      input_stream: "stream_0"
+    })");
+  std::shared_ptr<mediapipe::SimulationClock> simulation_clock(
+      new SimulationClock());
+  simulation_clock->ThreadStart();
+  profiler_.SetClock(simulation_clock);
+
+  TestContextBuilder source_context("source_calc", /*node_id=*/0, {},
+                                    {"stream_0"});
+  source_context.AddInputs({});
+  source_context.AddOutputs(
+      {{MakePacket<std::string>("15").At(Timestamp(100))}});
+  simulation_clock->SleepUntil(absl::FromUnixMicros(1000));
+  profiler_.MarkContextQueued(source_context.get());
+  simulation_clock->Sleep(absl::Microseconds(30));
+  profiler_.MarkContextDispatched(source_context.get());
+  simulation_clock->Sleep(absl::Microseconds(5));
+  {
+    GraphProfiler::Scope profiler_scope(GraphTrace::PROCESS,
+                                        source_context.get(), &profiler_);
+    simulation_clock->Sleep(absl::Microseconds(100));
+  }
+
+  // The packet is produced at 1135, and the consumer is queued at 1200.
+  TestContextBuilder consumer_context("consumer_calc", /*node_id=*/0,
+                                      {"stream_0"}, {});
+  consumer_context.AddInputs(
+      {MakePacket<std::string>("15").At(Timestamp(100))});
+  simulation_clock->SleepUntil(absl::FromUnixMicros(1200));
+  profiler_.MarkContextQueued(consumer_context.get());
+  simulation_clock->Sleep(absl::Microseconds(300));
+  profiler_.MarkContextDispatched(consumer_context.get());
+  simulation_clock->Sleep(absl::Microseconds(20));
+  {
+    GraphProfiler::Scope profiler_scope(GraphTrace::PROCESS,
+                                        consumer_context.get(), &profiler_);
+    simulation_clock->Sleep(absl::Microseconds(100));
+  }
+
+  // A Process() call that did not go through the scheduler queue again is
+  // not sampled.
+  {
+    GraphProfiler::Scope profiler_scope(GraphTrace::PROCESS,
+                                        consumer_context.get(), &profiler_);
+  }
+
+  std::vector<CalculatorProfile> profiles = Profiles();
+  simulation_clock->ThreadFinish();
+
+  EXPECT_THAT(GetProfileWithName(profiles, "source_calc"),
+              Partially(EqualsProto(R"pb(
+                process_input_wait_latency { total: 0 count: 1 }
+                process_queue_latency { total: 30 count: 1 }
+                process_dispatch_latency { total: 5 count: 1 }
+              )pb")));
+  EXPECT_THAT(GetProfileWithName(profiles, "consumer_calc"),
+              Partially(EqualsProto(R"pb(
+                process_input_wait_latency { total: 65 count: 1 }
+                process_queue_latency { total: 300 count: 1 }
+                process_dispatch_latency { total: 20 count: 1 }
+              )pb")));
+}
+
 // This test shows that CalculatorGraph::GetCalculatorProfiles and
 // GraphProfiler::AddProcessSample() can be called in parallel.
 // Without the GraphProfiler::profiler_mutex_ this test should
@@ -1363,6 +1471,49 @@ TEST(GraphProfilerTest, CaptureProfilePopulateConfig) {
                   )pb"))));
 }
 
+TEST(GraphProfilerTest, MemoryAccounting) {
+  CalculatorGraphConfig config = CreateGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      enable_memory_accounting: true
+    }
+    input_stream: "text"
+    input_stream: "gate"
+    node {
+      calculator: "DummyTestCalculator"
+      input_stream: "text"
+      input_stream: "gate"
+    })");
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+
+  // The "text" packets stay queued until "gate" reaches their timestamps.
+  Packet text = MakePacket<std::string>(std::string(1000, 'x'));
+  int64_t text_bytes = EstimatePacketBytes(text);
+  ASSERT_GT(text_bytes, 1000);
+  for (int i = 0; i < 3; ++i) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream("text", text.At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+
+  std::vector<CalculatorProfile> profiles;
+  MP_ASSERT_OK(graph.profiler()->GetCalculatorProfiles(&profiles));
+  ASSERT_EQ(profiles.size(), 1);
+  EXPECT_EQ(profiles[0].live_input_bytes(), 3 * text_bytes);
+  ASSERT_EQ(profiles[0].input_stream_profiles_size(), 2);
+  EXPECT_EQ(profiles[0].input_stream_profiles(0).live_bytes(), 3 * text_bytes);
+  EXPECT_EQ(profiles[0].input_stream_profiles(1).live_bytes(), 0);
+
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  profiles.clear();
+  MP_ASSERT_OK(graph.profiler()->GetCalculatorProfiles(&profiles));
+  EXPECT_EQ(profiles[0].live_input_bytes(), 0);
+  EXPECT_EQ(profiles[0].peak_input_bytes(), 3 * text_bytes);
+  EXPECT_EQ(profiles[0].input_stream_profiles(0).peak_bytes(), 3 * text_bytes);
+}
+
 TEST_F(GraphProfilerTestPeer, ExecutorRunEarly) {
   // Checks defaults before initialization.
   ASSERT_EQ(GetIsInitialized(), false);
@@ -1444,5 +1595,77 @@ TEST_F(GraphProfilerTestPeer, ExecutorRunLate) {
   executor.Run();
 }
 
+TEST_F(GraphProfilerTestPeer, GlProfilingHelperLogsGpuTimes) {
+  CalculatorGraphConfig graph_config = CreateGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      trace_enabled: true
+    }
+    input_stream: "input_stream"
+    node {
+      calculator: "DummyTestCalculator"
+      input_stream: "input_stream"
+    })");
+  mediapipe::ValidatedGraphConfig validated_graph;
+  MP_ASSERT_OK(validated_graph.Initialize(graph_config));
+  profiler_.Initialize(validated_graph);
+  MP_ASSERT_OK(profiler_.Start(nullptr));
+
+  auto gpu_timer = std::make_unique<FakeGpuTimer>();
+  FakeGpuTimer* timer = gpu_timer.get();
+  std::unique_ptr<GlProfilingHelper> helper =
+      profiler_.CreateGlProfilingHelper(std::move(gpu_timer));
+  ASSERT_NE(helper, nullptr);
+
+  // The GPU clock is calibrated when the first task starts, and the task
+  // finishes 3 ms later, after the GL thread has moved on.
+  timer->gpu_time_ns = 2000000;
+  helper->MarkTimestamp(/*node_id=*/0, Timestamp(100), /*is_finish=*/false);
+  timer->gpu_time_ns = 5000000;
+  helper->MarkTimestamp(/*node_id=*/0, Timestamp(100), /*is_finish=*/true);
+
+  // The first query is logged without blocking once the GPU reaches it.
+  timer->completed_queries = 1;
+  helper->MarkTimestamp(/*node_id=*/0, Timestamp(200), /*is_finish=*/false);
+  helper->LogAllTimestamps();
+
+  std::vector<TraceEvent> events;
+  for (const TraceEvent& event : profiler_.tracer()->GetTraceBuffer()) {
+    if (event.event_type == GraphTrace::GPU_TASK ||
+        event.event_type == GraphTrace::GPU_CALIBRATION) {
+      events.push_back(event);
+    }
+  }
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(events[0].event_type, GraphTrace::GPU_CALIBRATION);
+  EXPECT_EQ(events[0].event_data, 2000000);
+  absl::Time calibration_time = events[0].event_time;
+  EXPECT_EQ(events[1].event_type, GraphTrace::GPU_TASK);
+  EXPECT_EQ(events[1].is_finish, false);
+  EXPECT_EQ(events[1].input_ts, Timestamp(100));
+  EXPECT_EQ(events[1].event_time, calibration_time);
+  EXPECT_EQ(events[2].is_finish, true);
+  EXPECT_EQ(events[2].event_time - calibration_time, absl::Milliseconds(3));
+  EXPECT_EQ(events[3].input_ts, Timestamp(200));
+  MP_ASSERT_OK(profiler_.Stop());
+}
+
+TEST_F(GraphProfilerTestPeer, GlProfilingHelperRequiresGpuTimer) {
+  CalculatorGraphConfig graph_config = CreateGraphConfig(R"(
+    profiler_config {
+      enable_profiler: true
+      trace_enabled: true
+    }
+    input_stream: "input_stream"
+    node {
+      calculator: "DummyTestCalculator"
+      input_stream: "input_stream"
+    })");
+  mediapipe::ValidatedGraphConfig validated_graph;
+  MP_ASSERT_OK(validated_graph.Initialize(graph_config));
+  profiler_.Initialize(validated_graph);
+  EXPECT_EQ(profiler_.CreateGlProfilingHelper(nullptr), nullptr);
+}
+
 }  // namespace
 }  // namespace mediapipe
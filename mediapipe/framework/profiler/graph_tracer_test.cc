@@ -39,6 +39,7 @@
 #include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/framework/profiler/graph_profiler.h"
 #include "mediapipe/framework/profiler/test_context_builder.h"
+#include "mediapipe/framework/profiler/trace_ring_file.h"
 #include "mediapipe/framework/tool/simulation_clock.h"
 #include "mediapipe/framework/tool/simulation_clock_executor.h"
 #include "mediapipe/framework/tool/status_util.h"
@@ -57,6 +58,7 @@ class GraphProfilerTestPeer {
 
 namespace {
 
+using testing::Contains;
 using testing::ElementsAre;
 
 class GraphTracerTest : public ::testing::Test {
@@ -1011,6 +1013,25 @@ TEST_F(GraphTracerE2ETest, DemuxGraphLogFile) {
   EXPECT_EQ(113, profile.graph_trace(0).calculator_trace().size());
 }
 
+TEST_F(GraphTracerE2ETest, DemuxGraphTraceRing) {
+  std::string log_path = absl::StrCat(getenv("TEST_TMPDIR"), "/trace_ring_");
+  SetUpDemuxInFlightGraph();
+  graph_config_.mutable_profiler_config()->set_trace_log_path(log_path);
+  graph_config_.mutable_profiler_config()->set_trace_log_interval_usec(-1);
+  graph_config_.mutable_profiler_config()->set_trace_log_streaming(true);
+  RunDemuxInFlightGraph();
+
+  // Every buffered event is streamed, and no GraphProfile log is written.
+  const TraceBuffer& buffer = graph_.profiler()->tracer()->GetTraceBuffer();
+  MP_ASSERT_OK_AND_ASSIGN(TraceRing ring, ReadTraceRing(log_path));
+  EXPECT_EQ(ring.records.size(), buffer.end() - buffer.begin());
+  EXPECT_EQ(ring.records.back().event_time_usec,
+            absl::ToUnixMicros(
+                buffer.Get(buffer.end() - buffer.begin() - 1).event_time));
+  EXPECT_THAT(ring.node_names, Contains("FlowLimiterCalculator"));
+  EXPECT_FALSE(file::Exists(absl::StrCat(log_path, 0, ".binarypb")).ok());
+}
+
 TEST_F(GraphTracerE2ETest, DemuxGraphLogFiles) {
   std::string log_path = absl::StrCat(getenv("TEST_TMPDIR"), "/log_files_");
   SetUpDemuxInFlightGraph();
@@ -0,0 +1,57 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// This program converts a trace ring file, written by a graph with
+// ProfilerConfig.trace_log_streaming set, to a JSON trace that can be opened
+// in Perfetto UI (ui.perfetto.dev) or chrome://tracing.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "mediapipe/framework/profiler/trace_ring_file.h"
+
+ABSL_FLAG(std::string, trace_log_path, "",
+          "the trace_log_path of the profiled graph, which prefixes the "
+          "trace_ring.bin and trace_ring_names.txt files.");
+ABSL_FLAG(std::string, output, "",
+          "the JSON file to write. If empty, the JSON is written to stdout.");
+
+int main(int argc, char** argv) {
+  absl::SetProgramUsageMessage(
+      "Convert a MediaPipe trace ring file to a Perfetto JSON trace.");
+  absl::ParseCommandLine(argc, argv);
+
+  auto ring = mediapipe::ReadTraceRing(absl::GetFlag(FLAGS_trace_log_path));
+  if (!ring.ok()) {
+    std::cerr << ring.status() << "\n";
+    return 1;
+  }
+  const std::string& output = absl::GetFlag(FLAGS_output);
+  if (output.empty()) {
+    mediapipe::WriteChromeTrace(*ring, &std::cout);
+    return 0;
+  }
+  std::ofstream ofs(output, std::ofstream::out | std::ofstream::trunc);
+  if (!ofs.is_open()) {
+    std::cerr << "Cannot open " << output << "\n";
+    return 1;
+  }
+  mediapipe::WriteChromeTrace(*ring, &ofs);
+  return 0;
+}
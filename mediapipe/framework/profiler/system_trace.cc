@@ -0,0 +1,233 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/profiler/system_trace.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__ANDROID__)
+#include <dlfcn.h>
+#endif  // __ANDROID__
+
+#include <cerrno>
+#include <string>
+#include <utility>
+
+#include "absl/hash/hash.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/input_stream_shard.h"
+#include "mediapipe/framework/output_stream_shard.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe {
+
+namespace {
+
+// Writes atrace text lines to an ftrace trace_marker file.
+class TraceMarkerSystemTrace : public SystemTrace {
+ public:
+  explicit TraceMarkerSystemTrace(int fd) : fd_(fd), pid_(getpid()) {}
+  ~TraceMarkerSystemTrace() override { close(fd_); }
+
+  // The kernel discards trace_marker writes while tracing is off.
+  bool IsEnabled() override { return true; }
+
+  void BeginSlice(absl::string_view name) override {
+    Write(absl::StrCat("B|", pid_, "|", name));
+  }
+  void EndSlice() override { Write(absl::StrCat("E|", pid_)); }
+  void BeginAsyncSlice(absl::string_view name, int32_t cookie) override {
+    Write(absl::StrCat("S|", pid_, "|", name, "|", cookie));
+  }
+  void EndAsyncSlice(absl::string_view name, int32_t cookie) override {
+    Write(absl::StrCat("F|", pid_, "|", name, "|", cookie));
+  }
+  void SetCounter(absl::string_view name, int64_t value) override {
+    Write(absl::StrCat("C|", pid_, "|", name, "|", value));
+  }
+
+ private:
+  // Writes one line with a single write, so that lines from different
+  // threads do not interleave.
+  void Write(std::string line) {
+    line.push_back('\n');
+    (void)!write(fd_, line.data(), line.size());
+  }
+
+  int fd_;
+  int pid_;
+};
+
+#if defined(__ANDROID__)
+// Writes events through the NDK ATrace functions, which are loaded at
+// runtime because the async and counter functions require API level 29.
+class ATraceSystemTrace : public SystemTrace {
+ public:
+  static std::unique_ptr<SystemTrace> Load() {
+    void* lib = dlopen("libandroid.so", RTLD_NOW | RTLD_LOCAL);
+    if (lib == nullptr) {
+      return nullptr;
+    }
+    auto result = absl::WrapUnique(new ATraceSystemTrace());
+    result->is_enabled_ = reinterpret_cast<decltype(is_enabled_)>(
+        dlsym(lib, "ATrace_isEnabled"));
+    result->begin_section_ = reinterpret_cast<decltype(begin_section_)>(
+        dlsym(lib, "ATrace_beginSection"));
+    result->end_section_ = reinterpret_cast<decltype(end_section_)>(
+        dlsym(lib, "ATrace_endSection"));
+    result->begin_async_section_ =
+        reinterpret_cast<decltype(begin_async_section_)>(
+            dlsym(lib, "ATrace_beginAsyncSection"));
+    result->end_async_section_ =
+        reinterpret_cast<decltype(end_async_section_)>(
+            dlsym(lib, "ATrace_endAsyncSection"));
+    result->set_counter_ = reinterpret_cast<decltype(set_counter_)>(
+        dlsym(lib, "ATrace_setCounter"));
+    if (!result->is_enabled_ || !result->begin_section_ ||
+        !result->end_section_) {
+      return nullptr;
+    }
+    return result;
+  }
+
+  bool IsEnabled() override { return is_enabled_(); }
+  void BeginSlice(absl::string_view name) override {
+    begin_section_(std::string(name).c_str());
+  }
+  void EndSlice() override { end_section_(); }
+  void BeginAsyncSlice(absl::string_view name, int32_t cookie) override {
+    if (begin_async_section_) {
+      begin_async_section_(std::string(name).c_str(), cookie);
+    }
+  }
+  void EndAsyncSlice(absl::string_view name, int32_t cookie) override {
+    if (end_async_section_) {
+      end_async_section_(std::string(name).c_str(), cookie);
+    }
+  }
+  void SetCounter(absl::string_view name, int64_t value) override {
+    if (set_counter_) {
+      set_counter_(std::string(name).c_str(), value);
+    }
+  }
+
+ private:
+  ATraceSystemTrace() = default;
+
+  bool (*is_enabled_)() = nullptr;
+  void (*begin_section_)(const char*) = nullptr;
+  void (*end_section_)() = nullptr;
+  void (*begin_async_section_)(const char*, int32_t) = nullptr;
+  void (*end_async_section_)(const char*, int32_t) = nullptr;
+  void (*set_counter_)(const char*, int64_t) = nullptr;
+};
+#endif  // __ANDROID__
+
+std::unique_ptr<SystemTrace> CreatePlatformSystemTrace() {
+#if defined(__ANDROID__)
+  return ATraceSystemTrace::Load();
+#elif defined(__linux__)
+  for (const char* path : {"/sys/kernel/tracing/trace_marker",
+                           "/sys/kernel/debug/tracing/trace_marker"}) {
+    auto result = SystemTrace::CreateTraceMarker(path);
+    if (result.ok()) {
+      return std::move(result).value();
+    }
+  }
+  return nullptr;
+#else
+  return nullptr;
+#endif
+}
+
+// Identifies a packet on a stream, to match the ends of its async slice.
+int32_t PacketCookie(absl::string_view stream_name, Timestamp timestamp) {
+  return static_cast<int32_t>(absl::HashOf(stream_name, timestamp.Value()));
+}
+
+}  // namespace
+
+SystemTrace* SystemTrace::Get() {
+  static SystemTrace* system_trace = CreatePlatformSystemTrace().release();
+  return system_trace;
+}
+
+absl::StatusOr<std::unique_ptr<SystemTrace>> SystemTrace::CreateTraceMarker(
+    const std::string& path) {
+  int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, absl::StrCat("Cannot open ", path));
+  }
+  return std::make_unique<TraceMarkerSystemTrace>(fd);
+}
+
+SystemTraceExporter::SystemTraceExporter(SystemTrace* system_trace,
+                                         std::vector<std::string> node_names)
+    : system_trace_(system_trace), node_names_(std::move(node_names)) {}
+
+absl::string_view SystemTraceExporter::NodeName(int node_id) const {
+  if (node_id < 0 || node_id >= node_names_.size()) {
+    return "";
+  }
+  return node_names_[node_id];
+}
+
+bool SystemTraceExporter::BeginCall(GraphTrace::EventType event_type,
+                                    const CalculatorContext& context) {
+  if (!system_trace_->IsEnabled()) {
+    return false;
+  }
+  for (const InputStreamShard& in_stream : context.Inputs()) {
+    const Packet& packet = in_stream.Value();
+    if (!packet.IsEmpty()) {
+      system_trace_->EndAsyncSlice(
+          in_stream.Name(), PacketCookie(in_stream.Name(), packet.Timestamp()));
+    }
+  }
+  absl::string_view node_name = NodeName(context.NodeId());
+  if (event_type == GraphTrace::PROCESS) {
+    system_trace_->BeginSlice(node_name);
+  } else {
+    system_trace_->BeginSlice(absl::StrCat(
+        node_name, " (", GraphTrace::EventType_Name(event_type), ")"));
+  }
+  return true;
+}
+
+void SystemTraceExporter::EndCall(GraphTrace::EventType event_type,
+                                  const CalculatorContext& context) {
+  system_trace_->EndSlice();
+  for (const OutputStreamShard& out_stream : context.Outputs()) {
+    for (const Packet& packet : *out_stream.OutputQueue()) {
+      system_trace_->BeginAsyncSlice(
+          out_stream.Name(),
+          PacketCookie(out_stream.Name(), packet.Timestamp()));
+    }
+  }
+}
+
+void SystemTraceExporter::LogEvent(const TraceEvent& event) {
+  if (event.event_type != GraphTrace::PACKET_QUEUED ||
+      event.stream_id == nullptr || !system_trace_->IsEnabled()) {
+    return;
+  }
+  system_trace_->SetCounter(
+      absl::StrCat(NodeName(event.node_id), ":", *event.stream_id, " queue"),
+      event.event_data);
+}
+
+}  // namespace mediapipe
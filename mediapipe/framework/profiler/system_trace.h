@@ -0,0 +1,101 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_PROFILER_SYSTEM_TRACE_H_
+#define MEDIAPIPE_FRAMEWORK_PROFILER_SYSTEM_TRACE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/profiler/trace_buffer.h"
+
+namespace mediapipe {
+
+// Writes trace events to the system trace of the platform, so that they
+// share one timeline with the scheduling, CPU frequency and GPU events
+// recorded by Perfetto or systrace.
+//
+// On Android, events are written through ATrace and are recorded when the
+// app is traced, e.g. with Perfetto's "atrace_apps" option. On Linux, events
+// are written to the ftrace trace_marker in the atrace text format, which
+// Perfetto turns into slices and counters when "ftrace/print" is recorded.
+class SystemTrace {
+ public:
+  virtual ~SystemTrace() = default;
+
+  // Returns the system trace of this platform, or nullptr if there is none.
+  static SystemTrace* Get();
+
+  // Returns a system trace that writes atrace text lines to `path`.
+  static absl::StatusOr<std::unique_ptr<SystemTrace>> CreateTraceMarker(
+      const std::string& path);
+
+  // Returns true if events are being recorded.
+  virtual bool IsEnabled() = 0;
+
+  // Begins and ends a slice on the calling thread. Slices must nest.
+  virtual void BeginSlice(absl::string_view name) = 0;
+  virtual void EndSlice() = 0;
+
+  // Begins and ends a slice that can end on another thread. The `cookie`
+  // distinguishes overlapping slices with the same name.
+  virtual void BeginAsyncSlice(absl::string_view name, int32_t cookie) = 0;
+  virtual void EndAsyncSlice(absl::string_view name, int32_t cookie) = 0;
+
+  // Sets the value of a counter track.
+  virtual void SetCounter(absl::string_view name, int64_t value) = 0;
+};
+
+// Emits the trace events of one graph to a SystemTrace:
+//   - a slice for each Open, Process and Close call, named after the node,
+//   - an async slice on a track named after the stream for each packet,
+//     from the call that outputs it to the call that consumes it,
+//   - a counter "<node>:<stream> queue" with each input queue size.
+class SystemTraceExporter {
+ public:
+  // `node_names` are indexed by node id.
+  SystemTraceExporter(SystemTrace* system_trace,
+                      std::vector<std::string> node_names);
+
+  // Begins the slice of a calculator call, and ends the slices of its input
+  // packets. Returns false if the system trace is not being recorded.
+  bool BeginCall(GraphTrace::EventType event_type,
+                 const CalculatorContext& context);
+
+  // Ends the slice of a calculator call, and begins the slices of its output
+  // packets. Must follow a BeginCall that returned true.
+  void EndCall(GraphTrace::EventType event_type,
+               const CalculatorContext& context);
+
+  // Updates the queue size counters from PACKET_QUEUED events.
+  void LogEvent(const TraceEvent& event);
+
+ private:
+  // Returns the name of a node, or "" for an unknown node id.
+  absl::string_view NodeName(int node_id) const;
+
+  SystemTrace* system_trace_;
+  std::vector<std::string> node_names_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PROFILER_SYSTEM_TRACE_H_
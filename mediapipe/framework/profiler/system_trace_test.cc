@@ -0,0 +1,118 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/profiler/system_trace.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/profiler/test_context_builder.h"
+#include "mediapipe/framework/profiler/trace_buffer.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::MatchesRegex;
+
+class SystemTraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    path_ = absl::StrCat(getenv("TEST_TMPDIR"), "/trace_marker");
+    MP_ASSERT_OK(file::SetContents(path_, ""));
+    MP_ASSERT_OK_AND_ASSIGN(system_trace_,
+                            SystemTrace::CreateTraceMarker(path_));
+    pid_ = absl::StrCat(getpid());
+  }
+
+  // Returns the lines written to the trace marker.
+  std::vector<std::string> ReadLines() {
+    std::string contents;
+    MEDIAPIPE_CHECK_OK(file::GetContents(path_, &contents));
+    return absl::StrSplit(contents, '\n', absl::SkipEmpty());
+  }
+
+  std::string path_;
+  std::string pid_;
+  std::unique_ptr<SystemTrace> system_trace_;
+};
+
+TEST_F(SystemTraceTest, WritesAtraceLines) {
+  system_trace_->BeginSlice("Process");
+  system_trace_->EndSlice();
+  system_trace_->BeginAsyncSlice("packet", 7);
+  system_trace_->EndAsyncSlice("packet", 7);
+  system_trace_->SetCounter("queue", 3);
+
+  EXPECT_THAT(ReadLines(),
+              ElementsAre(absl::StrCat("B|", pid_, "|Process"),
+                          absl::StrCat("E|", pid_),
+                          absl::StrCat("S|", pid_, "|packet|7"),
+                          absl::StrCat("F|", pid_, "|packet|7"),
+                          absl::StrCat("C|", pid_, "|queue|3")));
+}
+
+TEST_F(SystemTraceTest, ExportsCallsPacketsAndQueues) {
+  SystemTraceExporter exporter(system_trace_.get(),
+                               {"PCalculator_1", "PCalculator_2"});
+  TestContextBuilder context("PCalculator_1", /*node_id=*/0, {"up_1"},
+                             {"down_1"});
+
+  // The packet on "down_1" is consumed by a downstream call, which ends the
+  // async slice begun by the call that output it.
+  context.AddInputs({MakePacket<std::string>("in").At(Timestamp(10))});
+  ASSERT_TRUE(exporter.BeginCall(GraphTrace::PROCESS, *context.get()));
+  context.AddOutputs({{MakePacket<std::string>("out").At(Timestamp(10))}});
+  exporter.EndCall(GraphTrace::PROCESS, *context.get());
+  TestContextBuilder downstream("PCalculator_2", /*node_id=*/1, {"down_1"},
+                                {});
+  downstream.AddInputs({MakePacket<std::string>("out").At(Timestamp(10))});
+  ASSERT_TRUE(exporter.BeginCall(GraphTrace::CLOSE, *downstream.get()));
+  exporter.EndCall(GraphTrace::CLOSE, *downstream.get());
+  const std::string up_1 = "up_1";
+  exporter.LogEvent(TraceEvent(GraphTrace::PACKET_QUEUED)
+                        .set_node_id(0)
+                        .set_stream_id(&up_1)
+                        .set_event_data(2));
+
+  std::vector<std::string> lines = ReadLines();
+  ASSERT_EQ(lines.size(), 8);
+  EXPECT_THAT(lines[0], MatchesRegex(absl::StrCat("F\\|", pid_,
+                                                  "\\|up_1\\|-?[0-9]+")));
+  EXPECT_EQ(lines[1], absl::StrCat("B|", pid_, "|PCalculator_1"));
+  EXPECT_EQ(lines[2], absl::StrCat("E|", pid_));
+  EXPECT_THAT(lines[3], MatchesRegex(absl::StrCat("S\\|", pid_,
+                                                  "\\|down_1\\|-?[0-9]+")));
+  EXPECT_EQ(lines[4], absl::StrCat("F", lines[3].substr(1)));
+  EXPECT_EQ(lines[5], absl::StrCat("B|", pid_, "|PCalculator_2 (CLOSE)"));
+  EXPECT_EQ(lines[6], absl::StrCat("E|", pid_));
+  EXPECT_EQ(lines[7], absl::StrCat("C|", pid_, "|PCalculator_1:up_1 queue|2"));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,359 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/profiler/trace_ring_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <tuple>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/memory/memory.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr char kNodeKind[] = "node";
+constexpr char kStreamKind[] = "stream";
+
+TraceRecord ToTraceRecord(const TraceEvent& event, int32_t stream_id) {
+  TraceRecord record;
+  record.event_time_usec = absl::ToUnixMicros(event.event_time);
+  record.input_ts = event.input_ts.Value();
+  record.packet_ts = event.packet_ts.Value();
+  record.event_data = event.event_data;
+  record.node_id = event.node_id;
+  record.stream_id = stream_id;
+  record.thread_id = event.thread_id;
+  record.event_type = static_cast<int16_t>(event.event_type);
+  record.is_finish = event.is_finish;
+  return record;
+}
+
+// Writes `s` as a quoted JSON string.
+void WriteJsonString(absl::string_view s, std::ostream* out) {
+  *out << '"';
+  for (char c : s) {
+    switch (c) {
+      case '"':
+        *out << "\\\"";
+        break;
+      case '\\':
+        *out << "\\\\";
+        break;
+      case '\n':
+        *out << "\\n";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          *out << ' ';
+        } else {
+          *out << c;
+        }
+    }
+  }
+  *out << '"';
+}
+
+// Returns the displayed name of a record.
+std::string RecordName(const TraceRing& ring, const TraceRecord& record) {
+  if (record.node_id >= 0 && record.node_id < ring.node_names.size()) {
+    return ring.node_names[record.node_id];
+  }
+  return GraphTrace::EventType_Name(
+      static_cast<GraphTrace::EventType>(record.event_type));
+}
+
+// Writes one Chrome trace event. `duration_usec` is used for "X" events.
+void WriteChromeEvent(const TraceRing& ring, const TraceRecord& record,
+                      char phase, int64_t duration_usec, std::ostream* out) {
+  *out << "{\"name\":";
+  WriteJsonString(RecordName(ring, record), out);
+  *out << ",\"cat\":";
+  WriteJsonString(GraphTrace::EventType_Name(static_cast<GraphTrace::EventType>(
+                      record.event_type)),
+                  out);
+  *out << ",\"ph\":\"" << phase << "\",\"ts\":" << record.event_time_usec;
+  if (phase == 'X') {
+    *out << ",\"dur\":" << duration_usec;
+  } else {
+    *out << ",\"s\":\"t\"";
+  }
+  *out << ",\"pid\":1,\"tid\":" << record.thread_id << ",\"args\":{";
+  *out << "\"input_ts\":" << record.input_ts;
+  *out << ",\"packet_ts\":" << record.packet_ts;
+  if (record.stream_id >= 0 && record.stream_id < ring.stream_names.size()) {
+    *out << ",\"stream\":";
+    WriteJsonString(ring.stream_names[record.stream_id], out);
+  }
+  if (record.event_data != 0) {
+    *out << ",\"event_data\":" << record.event_data;
+  }
+  *out << "}}";
+}
+
+}  // namespace
+
+std::string TraceRingRecordPath(const std::string& path_prefix) {
+  return absl::StrCat(path_prefix, "trace_ring.bin");
+}
+
+std::string TraceRingNamesPath(const std::string& path_prefix) {
+  return absl::StrCat(path_prefix, "trace_ring_names.txt");
+}
+
+#ifdef _WIN32
+
+absl::StatusOr<std::unique_ptr<TraceRingWriter>> TraceRingWriter::Create(
+    const std::string& path, int64_t capacity) {
+  return absl::UnimplementedError("Trace ring files require mmap.");
+}
+
+TraceRingWriter::~TraceRingWriter() {}
+
+absl::Status TraceRingWriter::Flush() { return absl::OkStatus(); }
+
+#else
+
+absl::StatusOr<std::unique_ptr<TraceRingWriter>> TraceRingWriter::Create(
+    const std::string& path, int64_t capacity) {
+  RET_CHECK_GT(capacity, 0);
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, absl::StrCat("Cannot open ", path));
+  }
+  size_t mapping_size =
+      sizeof(TraceRingHeader) + capacity * sizeof(TraceRecord);
+  if (ftruncate(fd, mapping_size) != 0) {
+    absl::Status status =
+        absl::ErrnoToStatus(errno, absl::StrCat("Cannot resize ", path));
+    close(fd);
+    return status;
+  }
+  void* mapping =
+      mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    absl::Status status =
+        absl::ErrnoToStatus(errno, absl::StrCat("Cannot map ", path));
+    close(fd);
+    return status;
+  }
+  auto result = absl::WrapUnique(new TraceRingWriter(fd, mapping, mapping_size));
+  TraceRingHeader* header = result->header_;
+  std::memcpy(header->magic, TraceRingHeader::kMagic, sizeof(header->magic));
+  header->version = TraceRingHeader::kVersion;
+  header->record_size = sizeof(TraceRecord);
+  header->capacity = capacity;
+  header->record_count = 0;
+  return result;
+}
+
+TraceRingWriter::~TraceRingWriter() {
+  munmap(mapping_, mapping_size_);
+  close(fd_);
+}
+
+absl::Status TraceRingWriter::Flush() {
+  if (msync(mapping_, mapping_size_, MS_ASYNC) != 0) {
+    return absl::ErrnoToStatus(errno, "Cannot flush trace ring");
+  }
+  return absl::OkStatus();
+}
+
+#endif  // _WIN32
+
+TraceRingWriter::TraceRingWriter(int fd, void* mapping, size_t mapping_size)
+    : fd_(fd),
+      mapping_(mapping),
+      mapping_size_(mapping_size),
+      header_(static_cast<TraceRingHeader*>(mapping)),
+      records_(reinterpret_cast<TraceRecord*>(header_ + 1)) {}
+
+void TraceRingWriter::Append(const TraceRecord& record) {
+  records_[header_->record_count % header_->capacity] = record;
+  // A reader of the mapping sees the record before the count that covers it.
+  std::atomic_thread_fence(std::memory_order_release);
+  ++header_->record_count;
+}
+
+TraceRingExporter::TraceRingExporter(std::unique_ptr<TraceRingWriter> writer,
+                                     std::ofstream names)
+    : writer_(std::move(writer)), names_(std::move(names)) {}
+
+absl::StatusOr<std::unique_ptr<TraceRingExporter>> TraceRingExporter::Create(
+    const std::string& path_prefix, int64_t capacity,
+    const std::vector<std::string>& node_names) {
+  MP_ASSIGN_OR_RETURN(
+      auto writer,
+      TraceRingWriter::Create(TraceRingRecordPath(path_prefix), capacity));
+  std::string names_path = TraceRingNamesPath(path_prefix);
+  std::ofstream names(names_path, std::ofstream::out | std::ofstream::trunc);
+  RET_CHECK(names.is_open()) << "Cannot open " << names_path;
+  for (int i = 0; i < node_names.size(); ++i) {
+    names << kNodeKind << '\t' << i << '\t' << node_names[i] << '\n';
+  }
+  names.flush();
+  return absl::WrapUnique(
+      new TraceRingExporter(std::move(writer), std::move(names)));
+}
+
+int32_t TraceRingExporter::GetStreamId(const std::string* stream_name) {
+  if (stream_name == nullptr) {
+    return -1;
+  }
+  auto it = stream_ids_.find(stream_name);
+  if (it != stream_ids_.end()) {
+    return it->second;
+  }
+  // Input and output streams hold separate copies of a stream name.
+  auto [name_it, inserted] =
+      stream_name_ids_.insert({*stream_name, stream_name_ids_.size()});
+  if (inserted) {
+    names_ << kStreamKind << '\t' << name_it->second << '\t' << *stream_name
+           << '\n';
+  }
+  stream_ids_[stream_name] = name_it->second;
+  return name_it->second;
+}
+
+absl::Status TraceRingExporter::Export(const TraceBuffer& buffer) {
+  absl::MutexLock lock(&mutex_);
+  const TraceBuffer::iterator origin(&buffer, 0);
+  size_t begin_index = buffer.begin() - origin;
+  size_t end_index = buffer.end() - origin;
+  if (next_index_ < begin_index) {
+    dropped_count_ += begin_index - next_index_;
+    next_index_ = begin_index;
+  }
+  size_t stream_count = stream_name_ids_.size();
+  for (; next_index_ < end_index; ++next_index_) {
+    TraceEvent event = buffer.GetAbsolute(next_index_);
+    writer_->Append(ToTraceRecord(event, GetStreamId(event.stream_id)));
+  }
+  if (stream_name_ids_.size() != stream_count) {
+    names_.flush();
+  }
+  return writer_->Flush();
+}
+
+int64_t TraceRingExporter::dropped_count() const {
+  absl::MutexLock lock(&mutex_);
+  return dropped_count_;
+}
+
+absl::StatusOr<TraceRing> ReadTraceRing(const std::string& path_prefix) {
+  TraceRing result;
+  std::string record_path = TraceRingRecordPath(path_prefix);
+  std::ifstream in(record_path, std::ifstream::in | std::ifstream::binary);
+  RET_CHECK(in.is_open()) << "Cannot open " << record_path;
+  TraceRingHeader header;
+  RET_CHECK(in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+      << "Cannot read the header of " << record_path;
+  RET_CHECK(std::memcmp(header.magic, TraceRingHeader::kMagic,
+                        sizeof(header.magic)) == 0)
+      << record_path << " is not a trace ring file";
+  RET_CHECK_EQ(header.version, TraceRingHeader::kVersion);
+  RET_CHECK_EQ(header.record_size, sizeof(TraceRecord));
+  RET_CHECK_GT(header.capacity, 0);
+  std::vector<TraceRecord> slots(header.capacity);
+  RET_CHECK(in.read(reinterpret_cast<char*>(slots.data()),
+                    slots.size() * sizeof(TraceRecord)))
+      << "Cannot read the records of " << record_path;
+  uint64_t count = std::min(header.record_count, header.capacity);
+  uint64_t first = header.record_count - count;
+  result.records.reserve(count);
+  for (uint64_t i = first; i < header.record_count; ++i) {
+    result.records.push_back(slots[i % header.capacity]);
+  }
+
+  std::string names_path = TraceRingNamesPath(path_prefix);
+  std::ifstream names(names_path);
+  RET_CHECK(names.is_open()) << "Cannot open " << names_path;
+  for (std::string line; std::getline(names, line);) {
+    std::vector<std::string> fields =
+        absl::StrSplit(line, absl::MaxSplits('\t', 2));
+    int id;
+    RET_CHECK(fields.size() == 3 && absl::SimpleAtoi(fields[1], &id) &&
+              id >= 0)
+        << "Invalid line in " << names_path << ": " << line;
+    std::vector<std::string>* target = nullptr;
+    if (fields[0] == kNodeKind) {
+      target = &result.node_names;
+    } else if (fields[0] == kStreamKind) {
+      target = &result.stream_names;
+    } else {
+      continue;
+    }
+    if (target->size() <= id) {
+      target->resize(id + 1);
+    }
+    (*target)[id] = std::move(fields[2]);
+  }
+  return result;
+}
+
+void WriteChromeTrace(const TraceRing& ring, std::ostream* out) {
+  using TaskKey = std::tuple<int32_t, int64_t, int16_t>;
+  absl::flat_hash_map<TaskKey, size_t> open_tasks;
+  std::vector<bool> matched(ring.records.size());
+  *out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  *out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+          "\"args\":{\"name\":\"MediaPipe\"}}";
+  for (size_t i = 0; i < ring.records.size(); ++i) {
+    const TraceRecord& record = ring.records[i];
+    TaskKey key{record.node_id, record.input_ts, record.event_type};
+    if (!record.is_finish) {
+      open_tasks[key] = i;
+      continue;
+    }
+    auto it = open_tasks.find(key);
+    if (it == open_tasks.end()) {
+      continue;
+    }
+    const TraceRecord& start = ring.records[it->second];
+    matched[it->second] = true;
+    matched[i] = true;
+    open_tasks.erase(it);
+    *out << ",\n";
+    WriteChromeEvent(ring, start, 'X',
+                     record.event_time_usec - start.event_time_usec, out);
+  }
+  for (size_t i = 0; i < ring.records.size(); ++i) {
+    if (!matched[i]) {
+      *out << ",\n";
+      WriteChromeEvent(ring, ring.records[i], 'i', 0, out);
+    }
+  }
+  *out << "]}\n";
+}
+
+}  // namespace mediapipe
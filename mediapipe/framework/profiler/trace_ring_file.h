@@ -0,0 +1,173 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_PROFILER_TRACE_RING_FILE_H_
+#define MEDIAPIPE_FRAMEWORK_PROFILER_TRACE_RING_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/profiler/trace_buffer.h"
+
+namespace mediapipe {
+
+// A trace ring file holds the most recent TraceEvents of a graph as
+// fixed-size binary records. It is written through a shared memory mapping,
+// so appending an event costs a copy into the page cache and the kernel
+// writes the pages back in the background. Unlike the GraphProfile logs,
+// nothing is serialized while the graph runs, so tracing can stay enabled
+// in long-running graphs.
+//
+// A ring with path prefix P consists of two files:
+//   P + "trace_ring.bin": a TraceRingHeader followed by `capacity` records.
+//   P + "trace_ring_names.txt": one line "node|stream <tab> id <tab> name"
+//       for each node and stream id used by the records.
+
+// One TraceEvent, as stored in a trace ring file.
+struct TraceRecord {
+  int64_t event_time_usec;
+  int64_t input_ts;
+  int64_t packet_ts;
+  int64_t event_data;
+  int32_t node_id;
+  // The id of the stream name, or -1 for none.
+  int32_t stream_id;
+  int32_t thread_id;
+  int16_t event_type;
+  int16_t is_finish;
+};
+static_assert(sizeof(TraceRecord) == 48, "TraceRecord must be packed");
+
+// The first bytes of a trace ring file.
+struct TraceRingHeader {
+  static constexpr char kMagic[8] = "MPTRING";
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t capacity;
+  // The number of records ever appended. Record i is stored in slot
+  // i % capacity, so the ring holds the last min(record_count, capacity).
+  uint64_t record_count;
+  char reserved[32];
+};
+static_assert(sizeof(TraceRingHeader) == 64, "TraceRingHeader must be packed");
+
+// Returns the path of the record file for a ring path prefix.
+std::string TraceRingRecordPath(const std::string& path_prefix);
+
+// Returns the path of the names file for a ring path prefix.
+std::string TraceRingNamesPath(const std::string& path_prefix);
+
+// Appends TraceRecords to a memory-mapped trace ring file.
+// Not thread-safe.
+class TraceRingWriter {
+ public:
+  // Creates or truncates the file at `path` to hold `capacity` records.
+  static absl::StatusOr<std::unique_ptr<TraceRingWriter>> Create(
+      const std::string& path, int64_t capacity);
+  ~TraceRingWriter();
+  TraceRingWriter(const TraceRingWriter&) = delete;
+  TraceRingWriter& operator=(const TraceRingWriter&) = delete;
+
+  // Stores a record, overwriting the oldest one once the ring is full.
+  void Append(const TraceRecord& record);
+
+  // Schedules the written pages for writeback, without waiting for it.
+  absl::Status Flush();
+
+  int64_t capacity() const { return header_->capacity; }
+  int64_t record_count() const { return header_->record_count; }
+
+ private:
+  TraceRingWriter(int fd, void* mapping, size_t mapping_size);
+
+  int fd_;
+  void* mapping_;
+  size_t mapping_size_;
+  TraceRingHeader* header_;
+  TraceRecord* records_;
+};
+
+// Copies the TraceEvents appended to a TraceBuffer into a trace ring file.
+// Each call to Export copies only the events added since the previous call,
+// so the cost of an export is proportional to the number of new events.
+class TraceRingExporter {
+ public:
+  // Creates the ring files for `path_prefix` and records `node_names`,
+  // indexed by node id.
+  static absl::StatusOr<std::unique_ptr<TraceRingExporter>> Create(
+      const std::string& path_prefix, int64_t capacity,
+      const std::vector<std::string>& node_names);
+
+  // Copies the events appended to `buffer` since the previous call.
+  // Events that were overwritten in `buffer` before they could be copied
+  // are counted in dropped_count().
+  absl::Status Export(const TraceBuffer& buffer) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  // The number of events lost because `buffer` wrapped between exports.
+  int64_t dropped_count() const ABSL_LOCKS_EXCLUDED(mutex_);
+
+ private:
+  TraceRingExporter(std::unique_ptr<TraceRingWriter> writer,
+                    std::ofstream names);
+
+  // Returns the id for a stream name, recording new names.
+  int32_t GetStreamId(const std::string* stream_name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  mutable absl::Mutex mutex_;
+  std::unique_ptr<TraceRingWriter> writer_ ABSL_GUARDED_BY(mutex_);
+  std::ofstream names_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<const std::string*, int32_t> stream_ids_
+      ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string, int32_t> stream_name_ids_
+      ABSL_GUARDED_BY(mutex_);
+  // The absolute TraceBuffer index of the next event to export.
+  size_t next_index_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t dropped_count_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// The contents of a trace ring file, oldest record first.
+struct TraceRing {
+  std::vector<TraceRecord> records;
+  std::vector<std::string> node_names;
+  std::vector<std::string> stream_names;
+};
+
+// Reads the trace ring files for `path_prefix`.
+absl::StatusOr<TraceRing> ReadTraceRing(const std::string& path_prefix);
+
+// Writes a trace ring in the Chrome JSON trace event format, which can be
+// opened in Perfetto UI (ui.perfetto.dev) and chrome://tracing. A start
+// event and the next finish event with the same node, input timestamp and
+// event type become one complete ("X") event; all other records become
+// instant ("i") events.
+void WriteChromeTrace(const TraceRing& ring, std::ostream* out);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_PROFILER_TRACE_RING_FILE_H_
@@ -0,0 +1,156 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/profiler/trace_ring_file.h"
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/profiler/trace_buffer.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+std::string TestPathPrefix(const std::string& name) {
+  return absl::StrCat(getenv("TEST_TMPDIR"), "/", name, "_");
+}
+
+TraceEvent MakeEvent(GraphTrace::EventType type, int64_t time_usec,
+                     int node_id, int64_t input_ts, bool is_finish = false,
+                     const std::string* stream_id = nullptr) {
+  TraceEvent event(type);
+  event.set_event_time(absl::FromUnixMicros(time_usec))
+      .set_node_id(node_id)
+      .set_input_ts(Timestamp(input_ts))
+      .set_packet_ts(Timestamp(input_ts))
+      .set_stream_id(stream_id);
+  event.is_finish = is_finish;
+  return event;
+}
+
+std::vector<int64_t> RecordTimes(const TraceRing& ring) {
+  std::vector<int64_t> result;
+  for (const TraceRecord& record : ring.records) {
+    result.push_back(record.event_time_usec);
+  }
+  return result;
+}
+
+TEST(TraceRingFileTest, ExportCopiesNewEvents) {
+  std::string prefix = TestPathPrefix("new_events");
+  const std::string stream_a = "a";
+  const std::string stream_b = "b";
+  TraceBuffer buffer(100);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto exporter, TraceRingExporter::Create(prefix, 16, {"Node0", "Node1"}));
+
+  buffer.push_back(MakeEvent(GraphTrace::PROCESS, 100, 0, 10, false,
+                             &stream_a));
+  buffer.push_back(MakeEvent(GraphTrace::PROCESS, 110, 0, 10, true));
+  MP_ASSERT_OK(exporter->Export(buffer));
+  buffer.push_back(MakeEvent(GraphTrace::PROCESS, 120, 1, 10, false,
+                             &stream_b));
+  MP_ASSERT_OK(exporter->Export(buffer));
+  MP_ASSERT_OK(exporter->Export(buffer));
+
+  MP_ASSERT_OK_AND_ASSIGN(TraceRing ring, ReadTraceRing(prefix));
+  EXPECT_THAT(RecordTimes(ring), ElementsAre(100, 110, 120));
+  EXPECT_THAT(ring.node_names, ElementsAre("Node0", "Node1"));
+  EXPECT_THAT(ring.stream_names, ElementsAre("a", "b"));
+  EXPECT_EQ(ring.records[0].stream_id, 0);
+  EXPECT_EQ(ring.records[1].stream_id, -1);
+  EXPECT_EQ(ring.records[1].is_finish, 1);
+  EXPECT_EQ(ring.records[2].node_id, 1);
+  EXPECT_EQ(ring.records[2].input_ts, 10);
+  EXPECT_EQ(ring.records[2].event_type, GraphTrace::PROCESS);
+  EXPECT_EQ(exporter->dropped_count(), 0);
+}
+
+TEST(TraceRingFileTest, RingKeepsLatestRecords) {
+  std::string prefix = TestPathPrefix("latest_records");
+  TraceBuffer buffer(100);
+  MP_ASSERT_OK_AND_ASSIGN(auto exporter,
+                          TraceRingExporter::Create(prefix, 4, {}));
+  for (int i = 0; i < 10; ++i) {
+    buffer.push_back(MakeEvent(GraphTrace::PACKET_QUEUED, i, -1, i));
+    MP_ASSERT_OK(exporter->Export(buffer));
+  }
+
+  MP_ASSERT_OK_AND_ASSIGN(TraceRing ring, ReadTraceRing(prefix));
+  EXPECT_THAT(RecordTimes(ring), ElementsAre(6, 7, 8, 9));
+}
+
+TEST(TraceRingFileTest, CountsOverwrittenEvents) {
+  std::string prefix = TestPathPrefix("overwritten_events");
+  TraceBuffer buffer(4);
+  MP_ASSERT_OK_AND_ASSIGN(auto exporter,
+                          TraceRingExporter::Create(prefix, 16, {}));
+  for (int i = 0; i < 10; ++i) {
+    buffer.push_back(MakeEvent(GraphTrace::PACKET_QUEUED, i, -1, i));
+  }
+  MP_ASSERT_OK(exporter->Export(buffer));
+
+  MP_ASSERT_OK_AND_ASSIGN(TraceRing ring, ReadTraceRing(prefix));
+  EXPECT_THAT(RecordTimes(ring), ElementsAre(6, 7, 8, 9));
+  EXPECT_EQ(exporter->dropped_count(), 6);
+}
+
+TEST(TraceRingFileTest, WriteChromeTrace) {
+  TraceRing ring;
+  ring.node_names = {"Node0"};
+  ring.stream_names = {"input"};
+  auto record = [](GraphTrace::EventType type, int64_t time_usec, int node_id,
+                   bool is_finish, int stream_id) {
+    TraceRecord result = {};
+    result.event_time_usec = time_usec;
+    result.input_ts = 10;
+    result.packet_ts = 10;
+    result.node_id = node_id;
+    result.stream_id = stream_id;
+    result.thread_id = 3;
+    result.event_type = type;
+    result.is_finish = is_finish;
+    return result;
+  };
+  ring.records = {record(GraphTrace::PROCESS, 100, 0, false, -1),
+                  record(GraphTrace::PACKET_QUEUED, 105, -1, false, 0),
+                  record(GraphTrace::PROCESS, 130, 0, true, -1)};
+
+  std::ostringstream out;
+  WriteChromeTrace(ring, &out);
+  const std::string json = out.str();
+  EXPECT_THAT(json, HasSubstr(R"({"name":"Node0","cat":"PROCESS","ph":"X",)"
+                              R"("ts":100,"dur":30,"pid":1,"tid":3,)"));
+  EXPECT_THAT(json,
+              HasSubstr(R"({"name":"PACKET_QUEUED","cat":"PACKET_QUEUED",)"
+                        R"("ph":"i","ts":105,"s":"t","pid":1,"tid":3,)"
+                        R"("args":{"input_ts":10,"packet_ts":10,)"
+                        R"("stream":"input"}})"));
+}
+
+}  // namespace
+}  // namespace mediapipe
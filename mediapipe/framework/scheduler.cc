@@ -73,6 +73,7 @@ void Scheduler::Reset() {
   }
   shared_.stopping = false;
   shared_.has_error = false;
+  shared_.newest_input_timestamp = Timestamp::Unset().Value();
 }
 
 void Scheduler::CloseAllSourceNodes() { shared_.stopping = true; }
@@ -14,6 +14,8 @@
 
 #include "mediapipe/framework/scheduler_queue.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <queue>
 #include <utility>
@@ -22,6 +24,7 @@
 #include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/calculator_node.h"
 #include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/mediapipe_profiling.h"
 #include "mediapipe/framework/port/canonical_errors.h"
 #include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/status.h"
@@ -44,6 +47,8 @@ SchedulerQueue::Item::Item(CalculatorNode* node, CalculatorContext* cc)
   if (is_source_) {
     layer_ = node->source_layer();
     source_process_order_ = node->SourceProcessOrder(cc).Value();
+  } else {
+    deadline_ = node->Deadline(cc->InputTimestamp()).Value();
   }
 }
 
@@ -82,6 +87,8 @@ bool SchedulerQueue::Item::operator<(const SchedulerQueue::Item& that) const {
   } else {
     // Non-sources run before sources.
     if (that.is_source_) return false;
+    // Later deadlines run after earlier deadlines.
+    if (deadline_ != that.deadline_) return deadline_ > that.deadline_;
     // For non-sources, higher ids run before lower ids.
     return id_ < that.id_;
   }
@@ -121,6 +128,19 @@ void SchedulerQueue::AddNode(CalculatorNode* node, CalculatorContext* cc) {
     ABSL_CHECK(node->IsSource()) << node->DebugName();
     return;
   }
+  if (!node->IsSource() && cc->InputTimestamp().IsRangeValue()) {
+    // Advance the newest input timestamp, against which deadlines expire.
+    const int64_t input_timestamp = cc->InputTimestamp().Value();
+    int64_t newest =
+        shared_->newest_input_timestamp.load(std::memory_order_relaxed);
+    while (newest < input_timestamp &&
+           !shared_->newest_input_timestamp.compare_exchange_weak(
+               newest, input_timestamp, std::memory_order_relaxed)) {
+    }
+  }
+  if (ProfilingContext* profiler = cc->GetProfilingContext()) {
+    profiler->MarkContextQueued(cc);
+  }
   AddItemToQueue(Item(node, cc));
 }
 
@@ -205,6 +225,11 @@ void SchedulerQueue::RunNextTask() {
     ABSL_CHECK(!node->Closed())
         << "Scheduled a node that was closed. This should not happen.";
   }
+  ProfilingContext* profiler =
+      calculator_context ? calculator_context->GetProfilingContext() : nullptr;
+  if (profiler) {
+    profiler->MarkContextDispatched(calculator_context);
+  }
 
   // On iOS, calculators may rely on the existence of an autorelease pool
   // (either directly, or because system code they call does). We do not
@@ -259,7 +284,8 @@ void SchedulerQueue::RunCalculatorNode(CalculatorNode* node,
     // Note that we don't need a lock because only one thread can execute this
     // due to the lock on running_nodes.
     int64_t start_time = shared_->timer.StartNode();
-    const absl::Status result = node->ProcessNode(cc);
+    const absl::Status result = node->ProcessNode(
+        cc, Timestamp::CreateNoErrorChecking(shared_->newest_input_timestamp));
     shared_->timer.EndNode(start_time);
 
     if (!result.ok()) {
@@ -27,6 +27,7 @@
 #include "mediapipe/framework/calculator_context.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/scheduler_shared.h"
+#include "mediapipe/framework/timestamp.h"
 
 namespace mediapipe {
 
@@ -62,12 +63,15 @@ class SchedulerQueue : public TaskQueue {
     // - Sources are sorted by layer (lower layer numbers run first), then by
     //   Calculator::SourceProcessOrder (smaller values run first), then by
     //   node id: smaller ids run first, since they come earlier in the config.
-    // - Non-sources are sorted by node id: larger ids run first, because they
-    //   are closer to the leaves.
+    // - Non-sources are sorted by deadline (earlier deadlines run first, and
+    //   invocations without a deadline run last), then by node id: larger ids
+    //   run first, because they are closer to the leaves.
     bool operator<(const Item& that) const;
 
    private:
     int64_t source_process_order_ = 0;
+    // The deadline of a non-source invocation, see CalculatorNode::Deadline.
+    int64_t deadline_ = Timestamp::Max().Value();
     CalculatorNode* node_;
     CalculatorContext* cc_;
     int id_ = 0;
@@ -105,6 +105,10 @@ struct SchedulerShared {
   // flag indicates that the graph is in that mode.
   std::atomic<bool> stopping;
   std::atomic<bool> has_error;
+  // The newest input timestamp of the invocations added to the scheduler
+  // queues in the current run. Deadlines expire relative to it, see
+  // CalculatorGraphConfig::Node::deadline_budget_usec.
+  std::atomic<int64_t> newest_input_timestamp;
   std::function<void(const absl::Status& error)> error_callback;
   // Collects timing information for measuring overhead.
   internal::SchedulerTimer timer;
@@ -0,0 +1,79 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/scratch_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+namespace mediapipe {
+
+ScratchArena::ScratchArena(size_t block_size)
+    : block_size_(std::max<size_t>(block_size, 64)) {}
+
+ScratchArena::~ScratchArena() {
+  for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+    it->first(it->second);
+  }
+}
+
+void* ScratchArena::Allocate(size_t size, size_t alignment) {
+  uintptr_t next = reinterpret_cast<uintptr_t>(next_);
+  uintptr_t aligned = (next + alignment - 1) & ~(alignment - 1);
+  if (next_ == nullptr ||
+      aligned + size > reinterpret_cast<uintptr_t>(end_)) {
+    AddBlock(size + alignment);
+    next = reinterpret_cast<uintptr_t>(next_);
+    aligned = (next + alignment - 1) & ~(alignment - 1);
+  }
+  next_ = reinterpret_cast<char*>(aligned + size);
+  bytes_used_ += size;
+  return reinterpret_cast<void*>(aligned);
+}
+
+void ScratchArena::AddBlock(size_t min_size) {
+  size_t size = blocks_.empty() ? block_size_ : blocks_.back().size * 2;
+  size = std::max(size, min_size);
+  blocks_.push_back({std::unique_ptr<char[]>(new char[size]), size});
+  next_ = blocks_.back().data.get();
+  end_ = next_ + size;
+}
+
+void ScratchArena::Reset() {
+  for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+    it->first(it->second);
+  }
+  destructors_.clear();
+  if (blocks_.size() > 1) {
+    size_t capacity = Capacity();
+    blocks_.clear();
+    blocks_.push_back({std::unique_ptr<char[]>(new char[capacity]), capacity});
+  }
+  if (!blocks_.empty()) {
+    next_ = blocks_.front().data.get();
+    end_ = next_ + blocks_.front().size;
+  }
+  bytes_used_ = 0;
+}
+
+size_t ScratchArena::Capacity() const {
+  size_t capacity = 0;
+  for (const Block& block : blocks_) {
+    capacity += block.size;
+  }
+  return capacity;
+}
+
+}  // namespace mediapipe
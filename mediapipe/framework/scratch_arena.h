@@ -0,0 +1,145 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_SCRATCH_ARENA_H_
+#define MEDIAPIPE_FRAMEWORK_SCRATCH_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/span.h"
+
+namespace mediapipe {
+
+// A bump allocator for temporaries that live until the next Reset().  The
+// framework resets the arena of a CalculatorContext after each Open(),
+// Process() and Close() call, see CalculatorContext::ScratchArena().  Once
+// the arena has grown to the size needed by one call, allocating from it no
+// longer touches the heap.
+//
+// Example:
+//   ScratchArena& arena = cc->ScratchArena();
+//   absl::Span<float> scores = arena.NewArray<float>(num_boxes);
+//   std::vector<int, ScratchAllocator<int>> indices{
+//       ScratchAllocator<int>(&arena)};
+//
+// This class is thread-compatible.
+class ScratchArena {
+ public:
+  // The size of the first block allocated by the arena.
+  static constexpr size_t kDefaultBlockSize = 4096;
+
+  explicit ScratchArena(size_t block_size = kDefaultBlockSize);
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+  ~ScratchArena();
+
+  // Returns "size" bytes aligned to "alignment", which must be a power of
+  // two.
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  // Constructs a T in the arena.  Its destructor runs at the next Reset().
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    T* object = new (Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value) {
+      destructors_.emplace_back(
+          [](void* p) { static_cast<T*>(p)->~T(); }, object);
+    }
+    return object;
+  }
+
+  // Returns an array of n default-initialized Ts, which are left
+  // uninitialized for arithmetic types.
+  template <typename T>
+  absl::Span<T> NewArray(size_t n) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "NewArray requires a trivially destructible type.");
+    T* data = static_cast<T*>(Allocate(n * sizeof(T), alignof(T)));
+    for (size_t i = 0; i < n; ++i) {
+      new (data + i) T;
+    }
+    return absl::MakeSpan(data, n);
+  }
+
+  // Destroys the objects created by New() and makes all memory available
+  // again.  If more than one block was needed since the last Reset(), the
+  // blocks are replaced by a single block holding all of them.
+  void Reset();
+
+  // Returns the number of bytes allocated since the last Reset().
+  size_t BytesUsed() const { return bytes_used_; }
+
+  // Returns the total size of the blocks owned by the arena.
+  size_t Capacity() const;
+
+ private:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+
+  // Starts a new block with room for at least min_size bytes.
+  void AddBlock(size_t min_size);
+
+  const size_t block_size_;
+  std::vector<Block> blocks_;
+  char* next_ = nullptr;
+  char* end_ = nullptr;
+  size_t bytes_used_ = 0;
+  std::vector<std::pair<void (*)(void*), void*>> destructors_;
+};
+
+// A standard allocator taking memory from a ScratchArena, for containers used
+// as temporaries.  Deallocation is a no-op; the memory is reclaimed by
+// ScratchArena::Reset().
+template <typename T>
+class ScratchAllocator {
+ public:
+  using value_type = T;
+
+  explicit ScratchAllocator(ScratchArena* arena) : arena_(arena) {}
+  template <typename U>
+  ScratchAllocator(const ScratchAllocator<U>& other)  // NOLINT
+      : arena_(other.arena_) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, size_t n) {}
+
+  template <typename U>
+  bool operator==(const ScratchAllocator<U>& other) const {
+    return arena_ == other.arena_;
+  }
+  template <typename U>
+  bool operator!=(const ScratchAllocator<U>& other) const {
+    return arena_ != other.arena_;
+  }
+
+ private:
+  template <typename U>
+  friend class ScratchAllocator;
+
+  ScratchArena* arena_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_SCRATCH_ARENA_H_
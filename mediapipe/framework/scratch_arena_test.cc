@@ -0,0 +1,141 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/scratch_arena.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(ScratchArenaTest, AllocatesAlignedMemory) {
+  ScratchArena arena(/*block_size=*/64);
+  arena.Allocate(1, 1);
+  void* p = arena.Allocate(8, 32);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 32, 0);
+  absl::Span<double> values = arena.NewArray<double>(100);
+  EXPECT_EQ(values.size(), 100);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(values.data()) % alignof(double), 0);
+  EXPECT_EQ(arena.BytesUsed(), 1 + 8 + 100 * sizeof(double));
+}
+
+TEST(ScratchArenaTest, ResetMergesBlocks) {
+  ScratchArena arena(/*block_size=*/64);
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(48);
+  }
+  size_t capacity = arena.Capacity();
+  EXPECT_GE(capacity, 480);
+  arena.Reset();
+  EXPECT_EQ(arena.BytesUsed(), 0);
+  EXPECT_EQ(arena.Capacity(), capacity);
+
+  // The merged block now serves the same allocations without growing.
+  for (int i = 0; i < 10; ++i) {
+    arena.Allocate(48);
+  }
+  EXPECT_EQ(arena.Capacity(), capacity);
+}
+
+TEST(ScratchArenaTest, ResetRunsDestructors) {
+  ScratchArena arena;
+  int num_destroyed = 0;
+  struct Tracker {
+    explicit Tracker(int* count) : count(count) {}
+    ~Tracker() { ++*count; }
+    int* count;
+  };
+  arena.New<Tracker>(&num_destroyed);
+  arena.New<Tracker>(&num_destroyed);
+  std::string* text = arena.New<std::string>(100, 'x');
+  EXPECT_EQ(text->size(), 100);
+  EXPECT_EQ(num_destroyed, 0);
+  arena.Reset();
+  EXPECT_EQ(num_destroyed, 2);
+}
+
+TEST(ScratchArenaTest, ScratchAllocatorBacksContainers) {
+  ScratchArena arena;
+  std::vector<int, ScratchAllocator<int>> values{ScratchAllocator<int>(&arena)};
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(i);
+  }
+  EXPECT_EQ(values[999], 999);
+  EXPECT_GE(arena.BytesUsed(), 1000 * sizeof(int));
+}
+
+// Sums its input using scratch memory and checks that the arena was reset
+// since the previous Process() call.
+class ScratchSumCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<int>();
+    cc->Outputs().Index(0).Set<int>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    ScratchArena& arena = cc->ScratchArena();
+    RET_CHECK_EQ(arena.BytesUsed(), 0);
+    const int n = cc->Inputs().Index(0).Get<int>();
+    absl::Span<int> terms = arena.NewArray<int>(n);
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+      terms[i] = i;
+      sum += terms[i];
+    }
+    cc->Outputs().Index(0).AddPacket(
+        MakePacket<int>(sum).At(cc->InputTimestamp()));
+    return absl::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(ScratchSumCalculator);
+
+TEST(ScratchArenaTest, ResetAfterEachProcess) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        node {
+          calculator: "ScratchSumCalculator"
+          input_stream: "in"
+          output_stream: "out"
+        }
+      )pb");
+  std::vector<Packet> outputs;
+  tool::AddVectorSink("out", &config, &outputs);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.Initialize(config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  for (int i = 0; i < 5; ++i) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "in", MakePacket<int>(100).At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.CloseAllInputStreams());
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  ASSERT_EQ(outputs.size(), 5);
+  for (const Packet& packet : outputs) {
+    EXPECT_EQ(packet.Get<int>(), 4950);
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
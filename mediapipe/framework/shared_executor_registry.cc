@@ -0,0 +1,96 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/shared_executor_registry.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/thread_pool_executor.h"
+#include "mediapipe/util/cpu_util.h"
+
+namespace mediapipe {
+
+SharedExecutorRegistry::ThreadReservation::~ThreadReservation() {
+  registry_->ReleaseThreads(num_threads_);
+}
+
+/* static */
+SharedExecutorRegistry& SharedExecutorRegistry::Get() {
+  static SharedExecutorRegistry* registry = new SharedExecutorRegistry();
+  return *registry;
+}
+
+void SharedExecutorRegistry::SetThreadBudget(int num_threads) {
+  absl::MutexLock lock(&mutex_);
+  thread_budget_ = std::max(num_threads, 0);
+}
+
+int SharedExecutorRegistry::thread_budget() const {
+  absl::MutexLock lock(&mutex_);
+  return thread_budget_;
+}
+
+int SharedExecutorRegistry::NumUsedThreads() const {
+  absl::MutexLock lock(&mutex_);
+  return num_used_threads_;
+}
+
+int SharedExecutorRegistry::AcquireThreads(int num_threads) {
+  if (num_threads <= 0) num_threads = NumCPUCores();
+  if (thread_budget_ > 0) {
+    num_threads =
+        std::clamp(thread_budget_ - num_used_threads_, 1, num_threads);
+  }
+  num_used_threads_ += num_threads;
+  return num_threads;
+}
+
+void SharedExecutorRegistry::ReleaseThreads(int num_threads) {
+  absl::MutexLock lock(&mutex_);
+  num_used_threads_ -= num_threads;
+}
+
+std::shared_ptr<Executor> SharedExecutorRegistry::GetOrCreateExecutor(
+    const std::string& name, int num_threads) {
+  absl::MutexLock lock(&mutex_);
+  std::weak_ptr<Executor>& entry = executors_[name];
+  if (std::shared_ptr<Executor> executor = entry.lock()) {
+    return executor;
+  }
+  const int granted_threads = AcquireThreads(num_threads);
+  // The registry outlives the executors, as it is never destroyed when
+  // obtained with Get(), and must otherwise outlive its executors.
+  std::shared_ptr<Executor> executor(
+      new ThreadPoolExecutor(granted_threads),
+      [this, granted_threads](Executor* executor) {
+        delete executor;
+        ReleaseThreads(granted_threads);
+      });
+  entry = executor;
+  return executor;
+}
+
+std::unique_ptr<SharedExecutorRegistry::ThreadReservation>
+SharedExecutorRegistry::ReserveThreads(int num_threads) {
+  absl::MutexLock lock(&mutex_);
+  return std::unique_ptr<ThreadReservation>(
+      new ThreadReservation(this, AcquireThreads(num_threads)));
+}
+
+}  // namespace mediapipe
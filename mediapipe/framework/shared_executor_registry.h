@@ -0,0 +1,109 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_REGISTRY_H_
+#define MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_REGISTRY_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/executor.h"
+
+namespace mediapipe {
+
+// A process-wide registry of thread pools shared by the graphs of all tasks,
+// and of the threads created by other components, such as the XNNPACK
+// delegates of the inference calculators.
+//
+// Executors are shared by name: the first request for a name creates a
+// ThreadPoolExecutor, and later requests return the same executor until the
+// last user releases it.
+//
+// If a thread budget is set, the threads of all registry executors and of all
+// thread reservations are counted against it. A new executor or reservation
+// gets the requested number of threads, reduced to what is left of the budget
+// but at least one thread, so that a process with many tasks does not end up
+// with far more threads than cores.
+class SharedExecutorRegistry {
+ public:
+  // Threads counted against the budget while the reservation is alive.
+  class ThreadReservation {
+   public:
+    ThreadReservation(const ThreadReservation&) = delete;
+    ThreadReservation& operator=(const ThreadReservation&) = delete;
+    ~ThreadReservation();
+
+    // The number of threads granted by the registry.
+    int num_threads() const { return num_threads_; }
+
+   private:
+    friend class SharedExecutorRegistry;
+    ThreadReservation(SharedExecutorRegistry* registry, int num_threads)
+        : registry_(registry), num_threads_(num_threads) {}
+
+    SharedExecutorRegistry* registry_;
+    int num_threads_;
+  };
+
+  // Returns the process-wide registry.
+  static SharedExecutorRegistry& Get();
+
+  SharedExecutorRegistry() = default;
+  SharedExecutorRegistry(const SharedExecutorRegistry&) = delete;
+  SharedExecutorRegistry& operator=(const SharedExecutorRegistry&) = delete;
+
+  // Sets the maximum number of threads of all executors and reservations.
+  // Zero or a negative value removes the limit. Threads that already exist
+  // are not affected.
+  void SetThreadBudget(int num_threads);
+
+  // Returns the thread budget, or 0 if there is no limit.
+  int thread_budget() const;
+
+  // Returns the number of threads of all live executors and reservations.
+  int NumUsedThreads() const;
+
+  // Returns the executor named `name`, creating a ThreadPoolExecutor with
+  // `num_threads` threads, or the number of CPU cores if `num_threads` is not
+  // positive, within the budget. The executor is destroyed when the last
+  // returned pointer is released.
+  std::shared_ptr<Executor> GetOrCreateExecutor(const std::string& name,
+                                                int num_threads = 0);
+
+  // Reserves `num_threads` threads, or the number of CPU cores if
+  // `num_threads` is not positive, within the budget, for a thread pool that
+  // is not owned by the registry. The caller should create no more threads
+  // than the returned reservation grants.
+  std::unique_ptr<ThreadReservation> ReserveThreads(int num_threads);
+
+ private:
+  // Returns the number of threads granted for a request of `num_threads`,
+  // and counts them as used.
+  int AcquireThreads(int num_threads) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void ReleaseThreads(int num_threads);
+
+  mutable absl::Mutex mutex_;
+  int thread_budget_ ABSL_GUARDED_BY(mutex_) = 0;
+  int num_used_threads_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::flat_hash_map<std::string, std::weak_ptr<Executor>> executors_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_SHARED_EXECUTOR_REGISTRY_H_
@@ -0,0 +1,75 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/shared_executor_registry.h"
+
+#include <memory>
+
+#include "absl/synchronization/notification.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(SharedExecutorRegistryTest, SharesExecutorsByName) {
+  SharedExecutorRegistry registry;
+  std::shared_ptr<Executor> a = registry.GetOrCreateExecutor("a", 2);
+  std::shared_ptr<Executor> a2 = registry.GetOrCreateExecutor("a", 3);
+  std::shared_ptr<Executor> b = registry.GetOrCreateExecutor("b", 3);
+  EXPECT_EQ(a, a2);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(registry.NumUsedThreads(), 5);
+
+  absl::Notification done;
+  a->Schedule([&done] { done.Notify(); });
+  done.WaitForNotification();
+
+  a.reset();
+  EXPECT_EQ(registry.NumUsedThreads(), 5);
+  a2.reset();
+  EXPECT_EQ(registry.NumUsedThreads(), 3);
+  b.reset();
+  EXPECT_EQ(registry.NumUsedThreads(), 0);
+}
+
+TEST(SharedExecutorRegistryTest, LimitsThreadsToBudget) {
+  SharedExecutorRegistry registry;
+  registry.SetThreadBudget(4);
+  std::shared_ptr<Executor> a = registry.GetOrCreateExecutor("a", 3);
+  auto reservation = registry.ReserveThreads(3);
+  EXPECT_EQ(reservation->num_threads(), 1);
+  // Every request gets at least one thread.
+  auto over_budget = registry.ReserveThreads(2);
+  EXPECT_EQ(over_budget->num_threads(), 1);
+  EXPECT_EQ(registry.NumUsedThreads(), 5);
+
+  a.reset();
+  over_budget.reset();
+  EXPECT_EQ(registry.NumUsedThreads(), 1);
+  EXPECT_EQ(registry.ReserveThreads(8)->num_threads(), 3);
+  reservation.reset();
+  EXPECT_EQ(registry.NumUsedThreads(), 0);
+}
+
+TEST(SharedExecutorRegistryTest, UnlimitedWithoutBudget) {
+  SharedExecutorRegistry registry;
+  EXPECT_EQ(registry.thread_budget(), 0);
+  EXPECT_EQ(registry.ReserveThreads(64)->num_threads(), 64);
+  EXPECT_GT(registry.ReserveThreads(0)->num_threads(), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,271 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/shared_resource_cache.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef ABSL_HAVE_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // ABSL_HAVE_MMAP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deps/no_destructor.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/resources.h"
+#include "mediapipe/util/resource_util.h"
+#include "mediapipe/util/resource_util_custom.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr int64_t kNanosecondsPerSecond = 1000000000;
+
+#ifndef _WIN32
+int64_t ToNanoseconds(const struct timespec& time) {
+  return int64_t{time.tv_sec} * kNanosecondsPerSecond + time.tv_nsec;
+}
+#endif  // _WIN32
+
+#ifdef ABSL_HAVE_MMAP
+class MappedFile {
+ public:
+  MappedFile(void* data, size_t size) : data_(data), size_(size) {}
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile() { munmap(data_, size_); }
+
+  absl::string_view contents() const {
+    return absl::string_view(static_cast<const char*>(data_), size_);
+  }
+
+ private:
+  void* data_;
+  size_t size_;
+};
+
+// Returns nullptr if the file cannot be mapped.
+std::shared_ptr<MappedFile> MapFile(const std::string& path, size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  void* data = mmap(/*addr=*/nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  return std::make_shared<MappedFile>(data, size);
+}
+#endif  // ABSL_HAVE_MMAP
+
+// Keeps the cached contents alive while the resource is.
+class SharedResource : public Resource {
+ public:
+  SharedResource(absl::string_view contents, std::shared_ptr<const void> holder)
+      : Resource(contents.data(), contents.size()),
+        holder_(std::move(holder)) {}
+
+ private:
+  std::shared_ptr<const void> holder_;
+};
+
+class SharedResources : public Resources {
+ public:
+  SharedResources(std::unique_ptr<Resources> resources,
+                  SharedResourceCache& cache)
+      : resources_(std::move(resources)), cache_(cache) {}
+
+  absl::StatusOr<std::unique_ptr<Resource>> Get(
+      absl::string_view resource_id, const Options& options) const final {
+    if (options.read_as_binary && !HasCustomGlobalResourceProvider()) {
+      absl::StatusOr<std::string> path =
+          PathToResourceAsFile(std::string(resource_id));
+      if (path.ok()) {
+        absl::StatusOr<std::unique_ptr<Resource>> resource = cache_.Get(*path);
+        if (resource.ok()) {
+          return resource;
+        }
+      }
+    }
+    // Also reports the errors, e.g. for missing files.
+    return resources_->Get(resource_id, options);
+  }
+
+ private:
+  std::unique_ptr<Resources> resources_;
+  SharedResourceCache& cache_;
+};
+
+}  // namespace
+
+/* static */
+SharedResourceCache& SharedResourceCache::Global() {
+  static NoDestructor<SharedResourceCache> cache;
+  return *cache;
+}
+
+absl::StatusOr<std::unique_ptr<Resource>> SharedResourceCache::Get(
+    const std::string& path) {
+  MP_ASSIGN_OR_RETURN(Entry entry, GetEntry(path, /*as_string=*/false));
+  return std::make_unique<SharedResource>(entry.contents,
+                                          std::move(entry.holder));
+}
+
+absl::StatusOr<std::shared_ptr<const std::string>>
+SharedResourceCache::GetString(const std::string& path) {
+  MP_ASSIGN_OR_RETURN(Entry entry, GetEntry(path, /*as_string=*/true));
+  return std::static_pointer_cast<const std::string>(std::move(entry.holder));
+}
+
+absl::StatusOr<SharedResourceCache::Entry> SharedResourceCache::GetEntry(
+    const std::string& path, bool as_string) {
+  struct stat info;
+  if (stat(path.c_str(), &info) != 0) {
+    return absl::NotFoundError(absl::StrCat("Unable to stat file: ", path));
+  }
+  if ((info.st_mode & S_IFMT) != S_IFREG) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Not a regular file: ", path));
+  }
+  FileVersion version;
+  version.device = info.st_dev;
+  version.inode = info.st_ino;
+  version.size = info.st_size;
+#if defined(__APPLE__)
+  version.mtime_nsec = ToNanoseconds(info.st_mtimespec);
+  version.ctime_nsec = ToNanoseconds(info.st_ctimespec);
+#elif defined(_WIN32)
+  version.mtime_nsec = int64_t{info.st_mtime} * kNanosecondsPerSecond;
+  version.ctime_nsec = int64_t{info.st_ctime} * kNanosecondsPerSecond;
+#else
+  version.mtime_nsec = ToNanoseconds(info.st_mtim);
+  version.ctime_nsec = ToNanoseconds(info.st_ctim);
+#endif
+
+  const std::pair<std::string, bool> key(path, as_string);
+  {
+    absl::MutexLock lock(&mutex_);
+    if (std::optional<Entry> entry = UseEntryLocked(key, version)) {
+      return *std::move(entry);
+    }
+  }
+
+  // Loading does not block the lookups of other files. Concurrent lookups of
+  // the same file may each load it, and then share the copy inserted first.
+  Entry loaded;
+  loaded.version = version;
+#ifdef ABSL_HAVE_MMAP
+  if (!as_string) {
+    if (auto mapped = MapFile(path, version.size)) {
+      loaded.contents = mapped->contents();
+      loaded.holder = std::move(mapped);
+    }
+  }
+#endif  // ABSL_HAVE_MMAP
+  if (loaded.holder == nullptr) {
+    auto contents = std::make_shared<std::string>();
+    MP_RETURN_IF_ERROR(
+        file::GetContents(path, contents.get(), /*read_as_binary=*/true));
+    loaded.contents = *contents;
+    loaded.holder = std::move(contents);
+  }
+
+  absl::MutexLock lock(&mutex_);
+  if (std::optional<Entry> entry = UseEntryLocked(key, version)) {
+    return *std::move(entry);
+  }
+  // Holders of a previous version keep it alive.
+  entries_[key] = loaded;
+  return *UseEntryLocked(key, version);
+}
+
+std::optional<SharedResourceCache::Entry> SharedResourceCache::UseEntryLocked(
+    const std::pair<std::string, bool>& key, const FileVersion& version) {
+  auto it = entries_.find(key);
+  if (it == entries_.end() || it->second.version != version) {
+    return std::nullopt;
+  }
+  it->second.last_use = ++use_count_;
+  // The copy references the holder, so the entry is not evicted here.
+  Entry result = it->second;
+  EvictUnusedLocked(options_.max_unused_bytes);
+  return result;
+}
+
+void SharedResourceCache::EvictUnused() {
+  absl::MutexLock lock(&mutex_);
+  EvictUnusedLocked(0);
+}
+
+int SharedResourceCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return entries_.size();
+}
+
+void SharedResourceCache::EvictUnusedLocked(size_t max_unused_bytes) {
+  // An entry whose holder is only referenced by the cache is unused. Holders
+  // are only copied under mutex_, so an unused entry cannot become used
+  // concurrently.
+  std::vector<std::pair<uint64_t, const std::pair<std::string, bool>*>> unused;
+  size_t unused_bytes = 0;
+  for (const auto& [key, entry] : entries_) {
+    if (entry.holder.use_count() == 1) {
+      unused.emplace_back(entry.last_use, &key);
+      unused_bytes += entry.contents.size();
+    }
+  }
+  if (unused_bytes <= max_unused_bytes) {
+    return;
+  }
+  std::sort(unused.begin(), unused.end());
+  std::vector<std::pair<std::string, bool>> evicted;
+  for (const auto& [last_use, key] : unused) {
+    if (unused_bytes <= max_unused_bytes) {
+      break;
+    }
+    unused_bytes -= entries_.at(*key).contents.size();
+    evicted.push_back(*key);
+  }
+  for (const auto& key : evicted) {
+    entries_.erase(key);
+  }
+}
+
+std::unique_ptr<Resources> CreateSharedResources(
+    std::unique_ptr<Resources> resources, SharedResourceCache& cache) {
+  return std::make_unique<SharedResources>(std::move(resources), cache);
+}
+
+}  // namespace mediapipe
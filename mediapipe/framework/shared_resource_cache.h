@@ -0,0 +1,149 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_SHARED_RESOURCE_CACHE_H_
+#define MEDIAPIPE_FRAMEWORK_SHARED_RESOURCE_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/resources.h"
+
+namespace mediapipe {
+
+// Caches the contents of files so that graphs loading the same file share a
+// single copy of it, e.g. when many instances of a graph run in one process.
+//
+// Files are memory-mapped where supported and read otherwise. A cached file is
+// reused as long as its inode, size, and modification and status change times
+// are unchanged, and stays alive while any Resource or string obtained from it
+// does. Cached files that are no longer referenced are kept, up to
+// Options::max_unused_bytes in total, so that a graph that is re-created soon
+// does not load them again; beyond that the least recently used ones are
+// dropped. Files are loaded without holding the cache lock, so a slow load
+// does not block the lookups of other files.
+//
+// Mapped files must be replaced, e.g. by renaming a new file over them, rather
+// than modified in place: writes show up in the contents handed out, and
+// truncating a mapped file makes reading the cut off part raise SIGBUS in
+// whoever holds the contents. A change that keeps the inode, size and both
+// times, e.g. on a file system with coarse timestamps, is not noticed.
+//
+// Thread-safe.
+class SharedResourceCache {
+ public:
+  struct Options {
+    // The maximum total size of the unreferenced files that are kept.
+    size_t max_unused_bytes = 32 << 20;
+  };
+
+  // Returns the cache shared by the whole process.
+  static SharedResourceCache& Global();
+
+  SharedResourceCache() : SharedResourceCache(Options()) {}
+  explicit SharedResourceCache(const Options& options) : options_(options) {}
+
+  // Returns the contents of the file at `path`, which must be a path in the
+  // file system, as returned by PathToResourceAsFile. The Resource may outlive
+  // the cache.
+  absl::StatusOr<std::unique_ptr<Resource>> Get(const std::string& path);
+
+  // Like Get, for APIs that need the contents as a std::string. The string is
+  // cached separately from the mapped contents.
+  absl::StatusOr<std::shared_ptr<const std::string>> GetString(
+      const std::string& path);
+
+  // Drops all the cached files that are not referenced anymore.
+  void EvictUnused();
+
+  // Returns the number of cached files, referenced or not.
+  int size() const;
+
+ private:
+  // Identifies a version of a file.
+  struct FileVersion {
+    uint64_t device = 0;
+    uint64_t inode = 0;
+    int64_t size = 0;
+    int64_t mtime_nsec = 0;
+    int64_t ctime_nsec = 0;
+
+    bool operator==(const FileVersion& other) const {
+      return device == other.device && inode == other.inode &&
+             size == other.size && mtime_nsec == other.mtime_nsec &&
+             ctime_nsec == other.ctime_nsec;
+    }
+    bool operator!=(const FileVersion& other) const {
+      return !(*this == other);
+    }
+  };
+
+  struct Entry {
+    // The version of the file the contents were loaded from.
+    FileVersion version;
+    // Owns the contents. Referenced by every Resource or string handed out.
+    std::shared_ptr<const void> holder;
+    absl::string_view contents;
+    uint64_t last_use = 0;
+  };
+
+  // Returns a copy of the up to date entry for the file, loading it if
+  // needed.
+  absl::StatusOr<Entry> GetEntry(const std::string& path, bool as_string);
+
+  // Marks the cached entry for `key` as used and returns a copy of it, if it
+  // holds `version`.
+  std::optional<Entry> UseEntryLocked(
+      const std::pair<std::string, bool>& key, const FileVersion& version)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Drops the least recently used unreferenced files until their total size
+  // is at most `max_unused_bytes`.
+  void EvictUnusedLocked(size_t max_unused_bytes)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  const Options options_;
+
+  mutable absl::Mutex mutex_;
+  // Keyed by path and whether the contents are held in a std::string.
+  absl::flat_hash_map<std::pair<std::string, bool>, Entry> entries_
+      ABSL_GUARDED_BY(mutex_);
+  uint64_t use_count_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+// Wraps `resources` so that binary resources which resolve to files, see
+// PathToResourceAsFile, are served from `cache`. Other resources, and all of
+// them while a custom global resource provider is set, are loaded by
+// `resources`.
+//
+// Example:
+//   graph.SetServiceObject(
+//       kResourcesService,
+//       CreateSharedResources(CreateDefaultResources()));
+std::unique_ptr<Resources> CreateSharedResources(
+    std::unique_ptr<Resources> resources,
+    SharedResourceCache& cache = SharedResourceCache::Global());
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_SHARED_RESOURCE_CACHE_H_
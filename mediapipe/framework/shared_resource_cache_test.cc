@@ -0,0 +1,132 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/shared_resource_cache.h"
+
+#include <utime.h>
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/resources.h"
+
+namespace mediapipe {
+namespace {
+
+std::string TestFilePath(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+TEST(SharedResourceCacheTest, SharesContentsOfUnchangedFile) {
+  const std::string path = TestFilePath("shared");
+  MP_ASSERT_OK(file::SetContents(path, "contents"));
+  SharedResourceCache cache;
+  MP_ASSERT_OK_AND_ASSIGN(auto first, cache.Get(path));
+  MP_ASSERT_OK_AND_ASSIGN(auto second, cache.Get(path));
+  EXPECT_EQ(first->ToStringView(), "contents");
+  EXPECT_EQ(first->data(), second->data());
+
+  MP_ASSERT_OK_AND_ASSIGN(auto first_string, cache.GetString(path));
+  MP_ASSERT_OK_AND_ASSIGN(auto second_string, cache.GetString(path));
+  EXPECT_EQ(*first_string, "contents");
+  EXPECT_EQ(first_string.get(), second_string.get());
+  EXPECT_EQ(cache.size(), 2);
+}
+
+TEST(SharedResourceCacheTest, ReloadsChangedFile) {
+  const std::string path = TestFilePath("changed");
+  MP_ASSERT_OK(file::SetContents(path, "old"));
+  SharedResourceCache cache;
+  MP_ASSERT_OK_AND_ASSIGN(auto old_resource, cache.Get(path));
+  // Replaces the file, as modifying a mapped file in place is not supported.
+  const std::string new_path = TestFilePath("changed.new");
+  MP_ASSERT_OK(file::SetContents(new_path, "newer"));
+  ASSERT_EQ(std::rename(new_path.c_str(), path.c_str()), 0);
+  MP_ASSERT_OK_AND_ASSIGN(auto new_resource, cache.Get(path));
+  EXPECT_EQ(new_resource->ToStringView(), "newer");
+  EXPECT_EQ(old_resource->ToStringView(), "old");
+}
+
+TEST(SharedResourceCacheTest, ReloadsReplacedFileWithSameSizeAndTimes) {
+  const std::string path = TestFilePath("replaced");
+  const std::string new_path = TestFilePath("replaced.new");
+  MP_ASSERT_OK(file::SetContents(path, "old"));
+  MP_ASSERT_OK(file::SetContents(new_path, "new"));
+  // Both files claim to be modified at the same time.
+  struct utimbuf times = {/*actime=*/1000000000, /*modtime=*/1000000000};
+  ASSERT_EQ(utime(path.c_str(), &times), 0);
+  ASSERT_EQ(utime(new_path.c_str(), &times), 0);
+  SharedResourceCache cache;
+  MP_ASSERT_OK_AND_ASSIGN(auto old_string, cache.GetString(path));
+  ASSERT_EQ(std::rename(new_path.c_str(), path.c_str()), 0);
+  MP_ASSERT_OK_AND_ASSIGN(auto new_string, cache.GetString(path));
+  EXPECT_EQ(*new_string, "new");
+  EXPECT_EQ(*old_string, "old");
+}
+
+TEST(SharedResourceCacheTest, EvictsOnlyUnusedFiles) {
+  const std::string used_path = TestFilePath("used");
+  const std::string unused_path = TestFilePath("unused");
+  MP_ASSERT_OK(file::SetContents(used_path, std::string(100, 'u')));
+  MP_ASSERT_OK(file::SetContents(unused_path, std::string(100, 'x')));
+  SharedResourceCache::Options options;
+  options.max_unused_bytes = 150;
+  SharedResourceCache cache(options);
+  MP_ASSERT_OK_AND_ASSIGN(auto used, cache.Get(used_path));
+  MP_ASSERT_OK(cache.Get(unused_path).status());
+  MP_ASSERT_OK_AND_ASSIGN(auto used_string, cache.GetString(used_path));
+  used_string.reset();
+  // 200 unused bytes are only noticed on the next access.
+  EXPECT_EQ(cache.size(), 3);
+
+  // Drops the least recently used unused contents, the mapped "unused" file.
+  MP_ASSERT_OK_AND_ASSIGN(auto unused_string, cache.GetString(unused_path));
+  EXPECT_EQ(cache.size(), 3);
+
+  cache.EvictUnused();
+  EXPECT_EQ(cache.size(), 2);
+  unused_string.reset();
+  cache.EvictUnused();
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_EQ(used->ToStringView(), std::string(100, 'u'));
+}
+
+TEST(SharedResourceCacheTest, ReportsMissingFile) {
+  SharedResourceCache cache;
+  EXPECT_FALSE(cache.Get(TestFilePath("missing")).ok());
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(SharedResourcesTest, ServesFilesFromCache) {
+  const std::string path = TestFilePath("resource");
+  MP_ASSERT_OK(file::SetContents(path, "resource contents"));
+  SharedResourceCache cache;
+  std::unique_ptr<Resources> resources =
+      CreateSharedResources(CreateDefaultResources(), cache);
+  MP_ASSERT_OK_AND_ASSIGN(auto first, resources->Get(path));
+  MP_ASSERT_OK_AND_ASSIGN(auto second, resources->Get(path));
+  EXPECT_EQ(first->ToStringView(), "resource contents");
+  EXPECT_EQ(first->data(), second->data());
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_FALSE(resources->Get(TestFilePath("missing")).ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,146 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_SPSC_RING_BUFFER_H_
+#define MEDIAPIPE_FRAMEWORK_SPSC_RING_BUFFER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include "absl/base/optimization.h"
+#include "absl/log/absl_check.h"
+
+namespace mediapipe {
+namespace internal {
+
+// A bounded single-producer/single-consumer ring buffer.
+//
+// One producer may call TryPush() while one consumer concurrently calls
+// Front(), At() and PopFront(); neither side ever blocks or retries.
+// size() and empty() may be called from any thread. Grow() and Clear()
+// require exclusive access, i.e. neither the producer nor the consumer may
+// be active. Callers typically serialize each side with its own mutex and
+// hold both mutexes for the exclusive operations.
+template <typename T>
+class SpscRingBuffer {
+ public:
+  // The capacity is rounded up to a power of two.
+  explicit SpscRingBuffer(size_t capacity = 16) { Reset(capacity); }
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  // Producer: appends "value" unless the buffer is full. Returns false (and
+  // leaves "value" untouched) if the buffer is full.
+  bool TryPush(T&& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == capacity_) {
+      return false;
+    }
+    slots_[tail & mask_] = std::move(value);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer: returns the oldest element. REQUIRES: !empty().
+  T& Front() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    ABSL_DCHECK_NE(head, tail_.load(std::memory_order_acquire));
+    return slots_[head & mask_];
+  }
+  const T& Front() const {
+    return const_cast<SpscRingBuffer*>(this)->Front();
+  }
+
+  // Consumer: returns the i-th oldest element. REQUIRES: i < size().
+  const T& At(size_t i) const {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    ABSL_DCHECK_LT(i, tail_.load(std::memory_order_acquire) - head);
+    return slots_[(head + i) & mask_];
+  }
+
+  // Consumer: destroys the oldest element. REQUIRES: !empty().
+  void PopFront() {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    ABSL_DCHECK_NE(head, tail_.load(std::memory_order_acquire));
+    // Reset the slot before publishing the new head, so that the producer
+    // never reuses a slot that still owns a value.
+    slots_[head & mask_] = T();
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  // Returns the number of elements. When called concurrently with the
+  // producer or the consumer, the result is a value the size had at some
+  // point during the call.
+  size_t size() const {
+    // The head is read first: the tail read afterwards can only be larger.
+    const size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_t capacity() const { return capacity_; }
+
+  // Doubles the capacity, keeping the elements. REQUIRES: exclusive access.
+  void Grow() {
+    const size_t new_capacity = capacity_ * 2;
+    auto new_slots = std::make_unique<T[]>(new_capacity);
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t count = tail_.load(std::memory_order_relaxed) - head;
+    for (size_t i = 0; i < count; ++i) {
+      new_slots[i] = std::move(slots_[(head + i) & mask_]);
+    }
+    slots_ = std::move(new_slots);
+    capacity_ = new_capacity;
+    mask_ = new_capacity - 1;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(count, std::memory_order_relaxed);
+  }
+
+  // Grows the capacity to at least "capacity", keeping the elements.
+  // REQUIRES: exclusive access.
+  void Reserve(size_t capacity) {
+    while (capacity_ < capacity) Grow();
+  }
+
+  // Destroys all elements. REQUIRES: exclusive access.
+  void Clear() {
+    while (!empty()) PopFront();
+  }
+
+ private:
+  void Reset(size_t capacity) {
+    capacity_ = 1;
+    while (capacity_ < capacity) capacity_ *= 2;
+    mask_ = capacity_ - 1;
+    slots_ = std::make_unique<T[]>(capacity_);
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+  }
+
+  std::unique_ptr<T[]> slots_;
+  size_t capacity_;
+  size_t mask_;
+  // Index of the oldest element. Written only by the consumer.
+  ABSL_CACHELINE_ALIGNED std::atomic<size_t> head_;
+  // One past the index of the newest element. Written only by the producer.
+  ABSL_CACHELINE_ALIGNED std::atomic<size_t> tail_;
+};
+
+}  // namespace internal
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_SPSC_RING_BUFFER_H_
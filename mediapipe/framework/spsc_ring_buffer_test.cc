@@ -0,0 +1,100 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/spsc_ring_buffer.h"
+
+#include <memory>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace internal {
+namespace {
+
+TEST(SpscRingBufferTest, RoundsCapacityUpToPowerOfTwo) {
+  SpscRingBuffer<int> buffer(5);
+  EXPECT_EQ(buffer.capacity(), 8);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscRingBufferTest, PushAndPopInOrder) {
+  SpscRingBuffer<int> buffer(4);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(buffer.TryPush(int(i)));
+  }
+  EXPECT_FALSE(buffer.TryPush(4));
+  EXPECT_EQ(buffer.size(), 4);
+  EXPECT_EQ(buffer.At(2), 2);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(buffer.Front(), i);
+    buffer.PopFront();
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscRingBufferTest, GrowKeepsElementsAcrossWrapAround) {
+  SpscRingBuffer<int> buffer(4);
+  for (int i = 0; i < 3; ++i) buffer.TryPush(int(i));
+  buffer.PopFront();
+  buffer.PopFront();
+  // The elements now wrap around the end of the slots.
+  for (int i = 3; i < 6; ++i) EXPECT_TRUE(buffer.TryPush(int(i)));
+  buffer.Grow();
+  EXPECT_EQ(buffer.capacity(), 8);
+  for (int i = 6; i < 10; ++i) EXPECT_TRUE(buffer.TryPush(int(i)));
+  for (int i = 2; i < 10; ++i) {
+    EXPECT_EQ(buffer.Front(), i);
+    buffer.PopFront();
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscRingBufferTest, PopFrontReleasesElement) {
+  SpscRingBuffer<std::shared_ptr<int>> buffer(2);
+  auto value = std::make_shared<int>(1);
+  buffer.TryPush(std::shared_ptr<int>(value));
+  EXPECT_EQ(value.use_count(), 2);
+  buffer.PopFront();
+  EXPECT_EQ(value.use_count(), 1);
+  buffer.TryPush(std::shared_ptr<int>(value));
+  buffer.Clear();
+  EXPECT_EQ(value.use_count(), 1);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(SpscRingBufferTest, ConcurrentProducerAndConsumer) {
+  constexpr int kNumValues = 100000;
+  SpscRingBuffer<int> buffer(64);
+  std::thread producer([&buffer] {
+    for (int i = 0; i < kNumValues; ++i) {
+      while (!buffer.TryPush(int(i))) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (int expected = 0; expected < kNumValues; ++expected) {
+    while (buffer.empty()) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(buffer.Front(), expected);
+    buffer.PopFront();
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.empty());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace mediapipe
@@ -0,0 +1,133 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/stream_handler/batch_input_stream_handler.h"
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/deps/threadpool.h"
+#include "mediapipe/framework/input_stream_handler.h"
+#include "mediapipe/framework/stream_handler/batch_input_stream_handler.pb.h"
+
+namespace mediapipe {
+
+REGISTER_INPUT_STREAM_HANDLER(BatchInputStreamHandler);
+
+namespace {
+
+const BatchInputStreamHandlerOptions& GetOptions(
+    const MediaPipeOptions& options) {
+  return options.GetExtension(BatchInputStreamHandlerOptions::ext);
+}
+
+}  // namespace
+
+BatchInputStreamHandler::BatchInputStreamHandler(
+    std::shared_ptr<tool::TagMap> tag_map, CalculatorContextManager* cc_manager,
+    const MediaPipeOptions& options, bool calculator_run_in_parallel)
+    : DefaultInputStreamHandler(std::move(tag_map), cc_manager, options,
+                                calculator_run_in_parallel),
+      max_batch_size_(GetOptions(options).max_batch_size()),
+      max_wait_(absl::Microseconds(GetOptions(options).max_wait_us())) {
+  ABSL_CHECK_GE(max_batch_size_, 1);
+  ABSL_CHECK_GE(max_wait_, absl::ZeroDuration());
+  SetBatchSize(max_batch_size_);
+}
+
+BatchInputStreamHandler::~BatchInputStreamHandler() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stop_timer_ = true;
+    timer_cond_.Signal();
+  }
+  // Joins the timer thread.
+  timer_thread_.reset();
+}
+
+void BatchInputStreamHandler::PrepareForRun(
+    std::function<void()> headers_ready_callback,
+    std::function<void()> notification_callback,
+    std::function<void(CalculatorContext*)> schedule_callback,
+    std::function<void(absl::Status)> error_callback) {
+  {
+    absl::MutexLock lock(&mutex_);
+    pending_count_ = 0;
+    timer_notified_ = false;
+    notification_callback_ = notification_callback;
+  }
+  if (max_wait_ > absl::ZeroDuration() && timer_thread_ == nullptr) {
+    timer_thread_ = std::make_unique<ThreadPool>("batch_timer", 1);
+    timer_thread_->StartWorkers();
+    timer_thread_->Schedule([this] { RunTimer(); });
+  }
+  DefaultInputStreamHandler::PrepareForRun(
+      std::move(headers_ready_callback), std::move(notification_callback),
+      std::move(schedule_callback), std::move(error_callback));
+}
+
+void BatchInputStreamHandler::FillInputSet(Timestamp input_timestamp,
+                                           InputStreamShardSet* input_set) {
+  DefaultInputStreamHandler::FillInputSet(input_timestamp, input_set);
+  absl::MutexLock lock(&mutex_);
+  if (pending_count_ == 0) {
+    batch_start_ = absl::Now();
+    timer_notified_ = false;
+    timer_cond_.Signal();
+  }
+  // A full batch is scheduled by InputStreamHandler::ScheduleInvocations.
+  pending_count_ = (pending_count_ + 1) % max_batch_size_;
+}
+
+bool BatchInputStreamHandler::ScheduleIncompleteBatch(int num_timestamps) {
+  absl::MutexLock lock(&mutex_);
+  if (pending_count_ == 0 || absl::Now() - batch_start_ < max_wait_) {
+    return false;
+  }
+  pending_count_ = 0;
+  return true;
+}
+
+void BatchInputStreamHandler::RunTimer() {
+  mutex_.Lock();
+  while (!stop_timer_) {
+    if (pending_count_ == 0 || timer_notified_) {
+      timer_cond_.Wait(&mutex_);
+      continue;
+    }
+    const absl::Time deadline = batch_start_ + max_wait_;
+    if (absl::Now() < deadline) {
+      timer_cond_.WaitWithDeadline(&mutex_, deadline);
+      continue;
+    }
+    // The node is notified without holding the lock, since scheduling calls
+    // back into ScheduleIncompleteBatch.
+    timer_notified_ = true;
+    std::function<void()> notification_callback = notification_callback_;
+    mutex_.Unlock();
+    if (notification_callback) {
+      notification_callback();
+    }
+    mutex_.Lock();
+  }
+  mutex_.Unlock();
+}
+
+}  // namespace mediapipe
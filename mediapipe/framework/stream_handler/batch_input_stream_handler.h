@@ -0,0 +1,112 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_BATCH_INPUT_STREAM_HANDLER_H_
+#define MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_BATCH_INPUT_STREAM_HANDLER_H_
+
+#include <functional>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_context_manager.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/threadpool.h"
+#include "mediapipe/framework/input_stream_handler.h"
+#include "mediapipe/framework/stream_handler/default_input_stream_handler.h"
+
+namespace mediapipe {
+
+// Input stream handler that collects up to max_batch_size input timestamps,
+// synchronized as in DefaultInputStreamHandler, before scheduling the node.
+// An incomplete batch is scheduled once no further input timestamp is ready
+// and its first input timestamp has waited at least max_wait_us. A timer
+// thread re-checks the wait, so that a batch is flushed even when no further
+// input arrives.
+//
+// Calculators that call CalculatorContract::SetProcessInputBatches(true)
+// receive the whole batch in a single Process() call, which lets them
+// amortize per-call overhead such as inference setup. Other calculators have
+// Process() called once per timestamp of the batch.
+//
+// Batching is not supported with max_in_flight > 1.
+//
+// Example config:
+//   node {
+//     calculator: "TensorsToClassificationCalculator"
+//     input_stream: "TENSORS:tensors"
+//     output_stream: "CLASSIFICATIONS:classifications"
+//     input_stream_handler {
+//       input_stream_handler: "BatchInputStreamHandler"
+//       options {
+//         [mediapipe.BatchInputStreamHandlerOptions.ext] {
+//           max_batch_size: 4
+//           max_wait_us: 10000
+//         }
+//       }
+//     }
+//   }
+class BatchInputStreamHandler : public DefaultInputStreamHandler {
+ public:
+  BatchInputStreamHandler() = delete;
+  BatchInputStreamHandler(std::shared_ptr<tool::TagMap> tag_map,
+                          CalculatorContextManager* cc_manager,
+                          const MediaPipeOptions& options,
+                          bool calculator_run_in_parallel);
+  ~BatchInputStreamHandler() override;
+
+ protected:
+  void PrepareForRun(std::function<void()> headers_ready_callback,
+                     std::function<void()> notification_callback,
+                     std::function<void(CalculatorContext*)> schedule_callback,
+                     std::function<void(absl::Status)> error_callback) override;
+
+  // Records when the first input set of a batch is filled.
+  void FillInputSet(Timestamp input_timestamp,
+                    InputStreamShardSet* input_set) override;
+
+  // Returns true once the batch has waited at least max_wait_.
+  bool ScheduleIncompleteBatch(int num_timestamps) override;
+
+ private:
+  // Notifies the node once the pending batch has waited max_wait_, so that
+  // the node schedules it without further input. Runs until the handler is
+  // destroyed.
+  void RunTimer();
+
+  const int max_batch_size_;
+  const absl::Duration max_wait_;
+
+  absl::Mutex mutex_;
+  // Signaled when a batch starts or the timer stops.
+  absl::CondVar timer_cond_;
+  // The number of input sets filled into the pending batch.
+  int pending_count_ ABSL_GUARDED_BY(mutex_) = 0;
+  // When the first input set of the pending batch was filled.
+  absl::Time batch_start_ ABSL_GUARDED_BY(mutex_);
+  // Whether the timer has notified the node of the pending batch.
+  bool timer_notified_ ABSL_GUARDED_BY(mutex_) = false;
+  bool stop_timer_ ABSL_GUARDED_BY(mutex_) = false;
+  // Checks whether the node became ready.
+  std::function<void()> notification_callback_ ABSL_GUARDED_BY(mutex_);
+  // Runs RunTimer. Created on the first run if max_wait_ is positive.
+  std::unique_ptr<ThreadPool> timer_thread_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_BATCH_INPUT_STREAM_HANDLER_H_
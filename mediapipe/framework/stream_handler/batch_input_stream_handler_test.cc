@@ -0,0 +1,182 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/stream_handler/batch_input_stream_handler.pb.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Outputs, at every input timestamp, the size of the batch it arrived in.
+class BatchSizeCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).Set<int>();
+    cc->Outputs().Index(0).Set<int>();
+    cc->SetProcessInputBatches(true);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    const std::vector<Timestamp> timestamps = cc->InputTimestamps();
+    const auto packets = cc->Inputs().Index(0).Packets();
+    RET_CHECK_EQ(timestamps.size(), packets.size());
+    for (int i = 0; i < timestamps.size(); ++i) {
+      RET_CHECK_EQ(packets[i].Timestamp(), timestamps[i]);
+      cc->Outputs().Index(0).AddPacket(
+          MakePacket<int>(timestamps.size()).At(timestamps[i]));
+    }
+    return absl::OkStatus();
+  }
+};
+REGISTER_CALCULATOR(BatchSizeCalculator);
+
+CalculatorGraphConfig BatchGraphConfig(const std::string& calculator,
+                                       int64_t max_wait_us) {
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "input"
+    node {
+      input_stream: "input"
+      output_stream: "output"
+      input_stream_handler {
+        input_stream_handler: "BatchInputStreamHandler"
+        options {
+          [mediapipe.BatchInputStreamHandlerOptions.ext] { max_batch_size: 3 }
+        }
+      }
+    }
+  )pb");
+  auto* node = config.mutable_node(0);
+  node->set_calculator(calculator);
+  node->mutable_input_stream_handler()
+      ->mutable_options()
+      ->MutableExtension(BatchInputStreamHandlerOptions::ext)
+      ->set_max_wait_us(max_wait_us);
+  return config;
+}
+
+class BatchInputStreamHandlerTest : public ::testing::Test {
+ protected:
+  void SetUpGraph(const CalculatorGraphConfig& config) {
+    MP_ASSERT_OK(graph_.Initialize(config));
+    MP_ASSERT_OK(graph_.ObserveOutputStream("output", [this](const Packet& p) {
+      absl::MutexLock lock(&mutex_);
+      timestamps_.push_back(p.Timestamp().Value());
+      if (p.ValidateAsType<int>().ok()) {
+        batch_sizes_.push_back(p.Get<int>());
+      }
+      return absl::OkStatus();
+    }));
+    MP_ASSERT_OK(graph_.StartRun({}));
+  }
+
+  void AddInput(int64_t timestamp) {
+    MP_ASSERT_OK(graph_.AddPacketToInputStream(
+        "input", MakePacket<int>(0).At(Timestamp(timestamp))));
+  }
+
+  // Returns whether `num_outputs` outputs arrive within `timeout`.
+  bool WaitForOutputs(int num_outputs, absl::Duration timeout) {
+    auto has_outputs = [this, num_outputs]() {
+      return static_cast<int>(timestamps_.size()) >= num_outputs;
+    };
+    absl::MutexLock lock(&mutex_);
+    return mutex_.AwaitWithTimeout(absl::Condition(&has_outputs), timeout);
+  }
+
+  CalculatorGraph graph_;
+  absl::Mutex mutex_;
+  std::vector<int64_t> timestamps_;
+  std::vector<int> batch_sizes_;
+};
+
+TEST_F(BatchInputStreamHandlerTest, DeliversFullBatchesInOneProcessCall) {
+  SetUpGraph(BatchGraphConfig("BatchSizeCalculator",
+                              /*max_wait_us=*/3600 * 1000000LL));
+  for (int t = 0; t < 7; ++t) {
+    AddInput(t);
+  }
+  MP_ASSERT_OK(graph_.WaitUntilIdle());
+  // The seventh timestamp waits for a full batch.
+  EXPECT_THAT(timestamps_, ElementsAre(0, 1, 2, 3, 4, 5));
+
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+  EXPECT_THAT(timestamps_, ElementsAre(0, 1, 2, 3, 4, 5, 6));
+  EXPECT_THAT(batch_sizes_, ElementsAre(3, 3, 3, 3, 3, 3, 1));
+}
+
+TEST_F(BatchInputStreamHandlerTest, SchedulesIncompleteBatchWithoutWait) {
+  SetUpGraph(BatchGraphConfig("BatchSizeCalculator", /*max_wait_us=*/0));
+  for (int t = 0; t < 3; ++t) {
+    AddInput(t);
+    MP_ASSERT_OK(graph_.WaitUntilIdle());
+  }
+  EXPECT_THAT(timestamps_, ElementsAre(0, 1, 2));
+  EXPECT_THAT(batch_sizes_, ElementsAre(1, 1, 1));
+
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+}
+
+TEST_F(BatchInputStreamHandlerTest, SchedulesIncompleteBatchWhenInputStops) {
+  SetUpGraph(BatchGraphConfig("BatchSizeCalculator", /*max_wait_us=*/200000));
+  AddInput(0);
+  AddInput(1);
+  // No further input arrives, so the batch is flushed by the timer.
+  ASSERT_TRUE(WaitForOutputs(2, absl::Seconds(10)));
+  {
+    absl::MutexLock lock(&mutex_);
+    EXPECT_THAT(timestamps_, ElementsAre(0, 1));
+    EXPECT_THAT(batch_sizes_, ElementsAre(2, 2));
+  }
+
+  // The next batch gets its own wait.
+  AddInput(2);
+  ASSERT_TRUE(WaitForOutputs(3, absl::Seconds(10)));
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+  EXPECT_THAT(timestamps_, ElementsAre(0, 1, 2));
+  EXPECT_THAT(batch_sizes_, ElementsAre(2, 2, 1));
+}
+
+TEST_F(BatchInputStreamHandlerTest, ProcessesBatchesPerTimestampByDefault) {
+  SetUpGraph(BatchGraphConfig("PassThroughCalculator",
+                              /*max_wait_us=*/3600 * 1000000LL));
+  for (int t = 0; t < 4; ++t) {
+    AddInput(t);
+  }
+  MP_ASSERT_OK(graph_.CloseAllInputStreams());
+  MP_ASSERT_OK(graph_.WaitUntilDone());
+  EXPECT_THAT(timestamps_, ElementsAre(0, 1, 2, 3));
+}
+
+}  // namespace
+}  // namespace mediapipe
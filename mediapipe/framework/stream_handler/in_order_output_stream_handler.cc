@@ -33,7 +33,7 @@ void InOrderOutputStreamHandler::PropagationLoop() {
     calculator_context = calculator_context_manager_->GetFrontCalculatorContext(
         &context_timestamp);
     if (!completed_input_timestamps_.empty()) {
-      Timestamp completed_timestamp = *completed_input_timestamps_.begin();
+      Timestamp completed_timestamp = completed_input_timestamps_.front();
       if (context_timestamp != completed_timestamp) {
         ABSL_CHECK_LT(context_timestamp, completed_timestamp);
         return;
@@ -59,7 +59,7 @@ void InOrderOutputStreamHandler::PropagatePackets(
   PropagateOutputPackets(*context_timestamp, &(*calculator_context)->Outputs());
   calculator_context_manager_->RecycleCalculatorContext();
   timestamp_mutex_.Lock();
-  completed_input_timestamps_.erase(completed_input_timestamps_.begin());
+  completed_input_timestamps_.pop_front();
   // The first check is for performance reasons (it's cheaper).
   // Note that completed_input_timestamps_ is a subset of the input
   // timestamps of the active contexts. Therefore, the second check
@@ -81,7 +81,7 @@ void InOrderOutputStreamHandler::PropagatePackets(
   *calculator_context =
       calculator_context_manager_->GetFrontCalculatorContext(context_timestamp);
   if (!completed_input_timestamps_.empty() &&
-      *context_timestamp == *completed_input_timestamps_.begin()) {
+      *context_timestamp == completed_input_timestamps_.front()) {
     // Continues propagating output packets if the smallest completed
     // input timestamp is equal to the input timestamp of the earliest
     // active calculator context.
@@ -118,7 +118,7 @@ void InOrderOutputStreamHandler::PropagationBound(
   *calculator_context =
       calculator_context_manager_->GetFrontCalculatorContext(context_timestamp);
   if (completed_input_timestamps_.empty() ||
-      *context_timestamp != *completed_input_timestamps_.begin()) {
+      *context_timestamp != completed_input_timestamps_.front()) {
     // If there is no newly completed invocation or the newly arrived packets
     // are not ready for propagation, the propagation process is completed.
     propagation_state_ = kIdle;
@@ -83,7 +83,11 @@ absl::Status InputsToDebugString(const InputStreamShardSet& inputs,
   return absl::OkStatus();
 }
 
-TEST(SyncSetInputStreamHandlerTest, OrdinaryOperation) {
+// Runs the tests against each handler implementing the sync set semantics.
+class SyncSetInputStreamHandlerTest
+    : public testing::TestWithParam<std::string> {};
+
+TEST_P(SyncSetInputStreamHandlerTest, OrdinaryOperation) {
   CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
       R"pb(
         input_stream: "a"
@@ -125,6 +129,9 @@ TEST(SyncSetInputStreamHandlerTest, OrdinaryOperation) {
             }
           }
         })pb");
+  config.mutable_node(0)
+      ->mutable_input_stream_handler()
+      ->set_input_stream_handler(GetParam());
   // The sync sets by stream name and CollectionItemId.
   //   {a, c, e}, {b, d}, {f}, {g}, {h}
   //   {0, 2, 4}, {1, 3}, {5}, {6}, {7}
@@ -324,5 +331,10 @@ TEST(SyncSetInputStreamHandlerTest, OrdinaryOperation) {
   }
 }
 
+INSTANTIATE_TEST_SUITE_P(
+    SyncSetHandlers, SyncSetInputStreamHandlerTest,
+    testing::Values("SyncSetInputStreamHandler",
+                    "TimestampIndexedInputStreamHandler"));
+
 }  // namespace
 }  // namespace mediapipe
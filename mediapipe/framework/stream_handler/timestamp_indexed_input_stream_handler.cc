@@ -0,0 +1,242 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/stream_handler/timestamp_indexed_input_stream_handler.h"
+
+#include <algorithm>
+#include <functional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/collection_item_id.h"
+#include "mediapipe/framework/input_stream_handler.h"
+#include "mediapipe/framework/packet_set.h"
+#include "mediapipe/framework/port/map_util.h"
+#include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/stream_handler/sync_set_input_stream_handler.pb.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+
+REGISTER_INPUT_STREAM_HANDLER(TimestampIndexedInputStreamHandler);
+
+void TimestampIndexedInputStreamHandler::PrepareForRun(
+    std::function<void()> headers_ready_callback,
+    std::function<void()> notification_callback,
+    std::function<void(CalculatorContext*)> schedule_callback,
+    std::function<void(absl::Status)> error_callback) {
+  const auto& handler_options =
+      options_.GetExtension(mediapipe::SyncSetInputStreamHandlerOptions::ext);
+  {
+    absl::MutexLock lock(&mutex_);
+    std::vector<std::vector<CollectionItemId>> sync_set_ids;
+    std::set<CollectionItemId> used_ids;
+    for (const auto& sync_set : handler_options.sync_set()) {
+      std::vector<CollectionItemId> stream_ids;
+      ABSL_CHECK_LT(0, sync_set.tag_index_size());
+      for (const auto& tag_index : sync_set.tag_index()) {
+        std::string tag;
+        int index;
+        MEDIAPIPE_CHECK_OK(tool::ParseTagIndex(tag_index, &tag, &index));
+        CollectionItemId id = input_stream_managers_.GetId(tag, index);
+        ABSL_CHECK(id.IsValid())
+            << "stream \"" << tag_index << "\" is not found.";
+        ABSL_CHECK(!mediapipe::ContainsKey(used_ids, id))
+            << "stream \"" << tag_index << "\" is in more than one sync set.";
+        used_ids.insert(id);
+        stream_ids.push_back(id);
+      }
+      sync_set_ids.push_back(std::move(stream_ids));
+    }
+    std::vector<CollectionItemId> remaining_ids;
+    for (CollectionItemId id = input_stream_managers_.BeginId();
+         id < input_stream_managers_.EndId(); ++id) {
+      if (!mediapipe::ContainsKey(used_ids, id)) {
+        remaining_ids.push_back(id);
+      }
+    }
+    if (!remaining_ids.empty()) {
+      sync_set_ids.push_back(std::move(remaining_ids));
+    }
+
+    sync_sets_.clear();
+    streams_.assign(input_stream_managers_.NumEntries(), StreamEntry());
+    stale_ids_.clear();
+    for (int i = 0; i < sync_set_ids.size(); ++i) {
+      for (CollectionItemId id : sync_set_ids[i]) {
+        streams_[id.value()].sync_set_index = i;
+        MarkStale(id);
+      }
+      sync_sets_.emplace_back(this, std::move(sync_set_ids[i]));
+    }
+    open_sync_set_count_ = sync_sets_.size();
+    ready_sync_set_index_ = -1;
+    ready_timestamp_ = Timestamp::Done();
+  }
+
+  InputStreamHandler::PrepareForRun(
+      std::move(headers_ready_callback), std::move(notification_callback),
+      std::move(schedule_callback), std::move(error_callback));
+}
+
+void TimestampIndexedInputStreamHandler::StreamUpdated(CollectionItemId id) {
+  absl::MutexLock lock(&mutex_);
+  MarkStale(id);
+}
+
+void TimestampIndexedInputStreamHandler::MarkStale(CollectionItemId id) {
+  StreamEntry& entry = streams_[id.value()];
+  if (!entry.stale) {
+    entry.stale = true;
+    stale_ids_.push_back(id);
+  }
+}
+
+void TimestampIndexedInputStreamHandler::ReindexStaleStreams() {
+  for (CollectionItemId id : stale_ids_) {
+    StreamEntry& entry = streams_[id.value()];
+    entry.stale = false;
+    IndexedSyncSet& sync_set = sync_sets_[entry.sync_set_index];
+    if (sync_set.done) {
+      continue;
+    }
+    if (entry.indexed) {
+      auto& index = entry.empty ? sync_set.bounds : sync_set.packets;
+      index.erase({entry.key, id});
+    }
+    entry.key = input_stream_managers_.Get(id)->MinTimestampOrBound(
+        &entry.empty);
+    auto& index = entry.empty ? sync_set.bounds : sync_set.packets;
+    index.insert({entry.key, id});
+    entry.indexed = true;
+  }
+  stale_ids_.clear();
+}
+
+NodeReadiness TimestampIndexedInputStreamHandler::GetReadiness(
+    IndexedSyncSet& sync_set, Timestamp* min_stream_timestamp) {
+  const Timestamp min_bound = sync_set.bounds.empty()
+                                  ? Timestamp::Done()
+                                  : sync_set.bounds.begin()->first;
+  const Timestamp min_packet = sync_set.packets.empty()
+                                   ? Timestamp::Done()
+                                   : sync_set.packets.begin()->first;
+  *min_stream_timestamp = std::min(min_packet, min_bound);
+  if (*min_stream_timestamp >= Timestamp::OneOverPostStream()) {
+    // Either OneOverPostStream or Done indicates no more packets.
+    *min_stream_timestamp = Timestamp::Done();
+    sync_set.last_processed_ts = Timestamp::Done().PreviousAllowedInStream();
+    return NodeReadiness::kReadyForClose;
+  }
+  if (!ProcessTimestampBounds()) {
+    // Only an input_ts with packets can be processed.
+    // Note that (min_bound - 1) is the highest fully settled timestamp.
+    if (min_bound > min_packet) {
+      sync_set.last_processed_ts = *min_stream_timestamp;
+      return NodeReadiness::kReadyForProcess;
+    }
+  } else {
+    // Any unprocessed input_ts can be processed. See
+    // InputStreamHandler::SyncSet::GetReadiness().
+    Timestamp settled =
+        (min_packet == Timestamp::PostStream() && min_bound > min_packet)
+            ? min_packet
+            : min_bound.PreviousAllowedInStream();
+    Timestamp input_timestamp = std::min(min_packet, settled);
+    if (input_timestamp >
+        std::max(sync_set.last_processed_ts, Timestamp::Unstarted())) {
+      *min_stream_timestamp = input_timestamp;
+      sync_set.last_processed_ts = input_timestamp;
+      return NodeReadiness::kReadyForProcess;
+    }
+  }
+  return NodeReadiness::kNotReady;
+}
+
+NodeReadiness TimestampIndexedInputStreamHandler::GetNodeReadiness(
+    Timestamp* min_stream_timestamp) {
+  ABSL_DCHECK(min_stream_timestamp);
+  absl::MutexLock lock(&mutex_);
+  if (ready_sync_set_index_ >= 0) {
+    *min_stream_timestamp = ready_timestamp_;
+    return NodeReadiness::kReadyForProcess;
+  }
+  ReindexStaleStreams();
+  for (int sync_set_index = 0; sync_set_index < sync_sets_.size();
+       ++sync_set_index) {
+    IndexedSyncSet& sync_set = sync_sets_[sync_set_index];
+    if (sync_set.done) {
+      continue;
+    }
+    NodeReadiness readiness = GetReadiness(sync_set, min_stream_timestamp);
+    if (readiness == NodeReadiness::kReadyForClose) {
+      // Done sync sets are kept so that stream entries can keep referring to
+      // them by index.
+      sync_set.done = true;
+      sync_set.packets.clear();
+      sync_set.bounds.clear();
+      --open_sync_set_count_;
+      continue;
+    }
+    if (readiness == NodeReadiness::kReadyForProcess &&
+        *min_stream_timestamp < ready_timestamp_) {
+      // Pick the sync set with the earliest input timestamp.
+      ready_timestamp_ = *min_stream_timestamp;
+      ready_sync_set_index_ = sync_set_index;
+    }
+  }
+  if (ready_sync_set_index_ >= 0) {
+    *min_stream_timestamp = ready_timestamp_;
+    return NodeReadiness::kReadyForProcess;
+  }
+  if (open_sync_set_count_ == 0) {
+    *min_stream_timestamp = Timestamp::Done();
+    return NodeReadiness::kReadyForClose;
+  }
+  return NodeReadiness::kNotReady;
+}
+
+void TimestampIndexedInputStreamHandler::FillInputSet(
+    Timestamp input_timestamp, InputStreamShardSet* input_set) {
+  // Assume that all current packets are already cleared.
+  absl::MutexLock lock(&mutex_);
+  ABSL_CHECK_LE(0, ready_sync_set_index_);
+  for (int i = 0; i < sync_sets_.size(); ++i) {
+    if (i == ready_sync_set_index_) {
+      sync_sets_[i].sync_set.FillInputSet(input_timestamp, input_set);
+    } else if (!sync_sets_[i].done) {
+      sync_sets_[i].sync_set.FillInputBounds(input_set);
+    }
+  }
+  // Popping packets changes the streams' MinTimestampOrBound() without going
+  // through StreamUpdated().
+  for (const auto& [key, id] : sync_sets_[ready_sync_set_index_].packets) {
+    MarkStale(id);
+  }
+  ready_sync_set_index_ = -1;
+  ready_timestamp_ = Timestamp::Done();
+}
+
+int TimestampIndexedInputStreamHandler::SyncSetCount() {
+  absl::MutexLock lock(&mutex_);
+  return open_sync_set_count_;
+}
+
+}  // namespace mediapipe
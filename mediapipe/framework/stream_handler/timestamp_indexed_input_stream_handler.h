@@ -0,0 +1,149 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_TIMESTAMP_INDEXED_INPUT_STREAM_HANDLER_H_
+#define MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_TIMESTAMP_INDEXED_INPUT_STREAM_HANDLER_H_
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator_context_manager.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/collection_item_id.h"
+#include "mediapipe/framework/input_stream_handler.h"
+#include "mediapipe/framework/mediapipe_options.pb.h"
+#include "mediapipe/framework/packet_set.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/tag_map.h"
+
+namespace mediapipe {
+
+// An input stream handler with the semantics of SyncSetInputStreamHandler,
+// and configured with the same SyncSetInputStreamHandlerOptions, intended for
+// nodes with many inputs.
+//
+// SyncSetInputStreamHandler queries every input stream each time readiness is
+// evaluated, i.e. on every packet arrival. This handler instead keeps, for
+// each sync set, the streams ordered by their next packet timestamp or
+// timestamp bound, and only re-reads the streams that changed since the last
+// evaluation. Readiness then costs O(log n) per changed stream plus O(1) per
+// sync set.
+//
+// Example config:
+//   input_stream_handler {
+//     input_stream_handler: "TimestampIndexedInputStreamHandler"
+//     options {
+//       [mediapipe.SyncSetInputStreamHandlerOptions.ext] {
+//         sync_set { tag_index: "IMU:0" tag_index: "IMU:1" }
+//         sync_set { tag_index: "GPS" }
+//       }
+//     }
+//   }
+class TimestampIndexedInputStreamHandler : public InputStreamHandler {
+ public:
+  TimestampIndexedInputStreamHandler() = delete;
+  TimestampIndexedInputStreamHandler(
+      std::shared_ptr<tool::TagMap> tag_map,
+      CalculatorContextManager* cc_manager,
+      const mediapipe::MediaPipeOptions& extendable_options,
+      bool calculator_run_in_parallel)
+      : InputStreamHandler(std::move(tag_map), cc_manager, extendable_options,
+                           calculator_run_in_parallel) {}
+
+  void PrepareForRun(std::function<void()> headers_ready_callback,
+                     std::function<void()> notification_callback,
+                     std::function<void(CalculatorContext*)> schedule_callback,
+                     std::function<void(absl::Status)> error_callback) override;
+
+ protected:
+  // A node is ready if any of its sync sets is ready, as in
+  // SyncSetInputStreamHandler.
+  NodeReadiness GetNodeReadiness(Timestamp* min_stream_timestamp) override;
+
+  // Only invoked when associated GetNodeReadiness() returned kReadyForProcess.
+  // Populates packets for the ready sync set, and populates timestamp bounds
+  // for all other open sync sets.
+  void FillInputSet(Timestamp input_timestamp,
+                    InputStreamShardSet* input_set) override;
+
+  // Marks the stream as needing to be re-indexed.
+  void StreamUpdated(CollectionItemId id) override;
+
+  // Returns the number of sync sets that are not yet done.
+  int SyncSetCount() override;
+
+ private:
+  // A stream's position in the index of its sync set: the timestamp returned
+  // by InputStreamManager::MinTimestampOrBound() and the stream id.
+  using IndexKey = std::pair<Timestamp, CollectionItemId>;
+
+  struct IndexedSyncSet {
+    IndexedSyncSet(InputStreamHandler* handler,
+                   std::vector<CollectionItemId> stream_ids)
+        : sync_set(handler, std::move(stream_ids)) {}
+
+    // Used to move packets and bounds into the input set.
+    InputStreamHandler::SyncSet sync_set;
+    // Streams with queued packets, ordered by their first packet timestamp.
+    std::set<IndexKey> packets;
+    // Streams with empty queues, ordered by their next timestamp bound.
+    std::set<IndexKey> bounds;
+    Timestamp last_processed_ts = Timestamp::Unset();
+    bool done = false;
+  };
+
+  struct StreamEntry {
+    int sync_set_index = -1;
+    Timestamp key = Timestamp::Unset();
+    bool empty = true;
+    bool indexed = false;
+    bool stale = false;
+  };
+
+  // Marks the stream stale. Stale streams are re-indexed by the next
+  // GetNodeReadiness().
+  void MarkStale(CollectionItemId id) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Re-reads the stale streams and updates their sync set indexes.
+  void ReindexStaleStreams() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Evaluates the readiness of one sync set from its indexes. Mirrors
+  // InputStreamHandler::SyncSet::GetReadiness().
+  NodeReadiness GetReadiness(IndexedSyncSet& sync_set,
+                             Timestamp* min_stream_timestamp)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  absl::Mutex mutex_;
+  std::vector<IndexedSyncSet> sync_sets_ ABSL_GUARDED_BY(mutex_);
+  // Indexed by CollectionItemId::value().
+  std::vector<StreamEntry> streams_ ABSL_GUARDED_BY(mutex_);
+  std::vector<CollectionItemId> stale_ids_ ABSL_GUARDED_BY(mutex_);
+  int open_sync_set_count_ ABSL_GUARDED_BY(mutex_) = 0;
+  // The index of the ready sync set, or -1 if no sync set is ready.
+  int ready_sync_set_index_ ABSL_GUARDED_BY(mutex_) = -1;
+  // The timestamp at which the sync set is ready, or Timestamp::Done() if no
+  // sync set is ready.
+  Timestamp ready_timestamp_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_STREAM_HANDLER_TIMESTAMP_INDEXED_INPUT_STREAM_HANDLER_H_
@@ -94,11 +94,19 @@ bool GraphRegistry::IsRegistered(const std::string& ns,
 absl::StatusOr<CalculatorGraphConfig> GraphRegistry::CreateByName(
     absl::string_view ns, absl::string_view type_name,
     SubgraphContext* context) const {
+  bool depends_only_on_options;
+  return CreateByName(ns, type_name, context, &depends_only_on_options);
+}
+
+absl::StatusOr<CalculatorGraphConfig> GraphRegistry::CreateByName(
+    absl::string_view ns, absl::string_view type_name,
+    SubgraphContext* context, bool* depends_only_on_options) const {
   absl::StatusOr<std::unique_ptr<Subgraph>> maker =
       local_factories_.IsRegistered(ns, type_name)
           ? local_factories_.Invoke(ns, type_name)
           : global_factories_->Invoke(ns, type_name);
   MP_RETURN_IF_ERROR(maker.status());
+  *depends_only_on_options = maker.value()->ConfigDependsOnlyOnOptions();
   if (context != nullptr) {
     return maker.value()->GetConfig(context);
   }
@@ -143,6 +143,11 @@ class Subgraph {
     return absl::UnimplementedError("Not implemented.");
   }
 
+  // Returns true if the config returned by GetConfig depends only on the
+  // options of the subgraph node, so that subgraph expansion can reuse one
+  // config for all nodes of this type with identical options.
+  virtual bool ConfigDependsOnlyOnOptions() const { return false; }
+
   // Returns options of a specific type.
   template <typename T>
   static T GetOptions(const Subgraph::SubgraphOptions& supgraph_options) {
@@ -177,6 +182,7 @@ class ProtoSubgraph : public Subgraph {
   virtual ~ProtoSubgraph();
   virtual absl::StatusOr<CalculatorGraphConfig> GetConfig(
       const Subgraph::SubgraphOptions& options);
+  bool ConfigDependsOnlyOnOptions() const override { return true; }
 
  private:
   CalculatorGraphConfig config_;
@@ -189,6 +195,7 @@ class TemplateSubgraph : public Subgraph {
   virtual ~TemplateSubgraph();
   virtual absl::StatusOr<CalculatorGraphConfig> GetConfig(
       const Subgraph::SubgraphOptions& options);
+  bool ConfigDependsOnlyOnOptions() const override { return true; }
 
  private:
   CalculatorGraphTemplate templ_;
@@ -226,6 +233,12 @@ class GraphRegistry {
       absl::string_view ns, absl::string_view type_name,
       SubgraphContext* context = nullptr) const;
 
+  // Returns the specified graph config, and sets *depends_only_on_options to
+  // Subgraph::ConfigDependsOnlyOnOptions of the subgraph.
+  absl::StatusOr<CalculatorGraphConfig> CreateByName(
+      absl::string_view ns, absl::string_view type_name,
+      SubgraphContext* context, bool* depends_only_on_options) const;
+
   static GraphRegistry global_graph_registry;
 
  private:
@@ -14,32 +14,27 @@
 
 #include "mediapipe/framework/thread_pool_executor.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <set>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "mediapipe/framework/port/canonical_errors.h"
 #include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/status_builder.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/thread_pool_executor.pb.h"
 #include "mediapipe/util/cpu_util.h"
+#include "mediapipe/util/thermal_state.h"
 
 namespace mediapipe {
 
-// static
-absl::StatusOr<Executor*> ThreadPoolExecutor::Create(
-    const MediaPipeOptions& extendable_options) {
-  auto& options =
-      extendable_options.GetExtension(ThreadPoolExecutorOptions::ext);
-  if (!options.has_num_threads()) {
-    return absl::InvalidArgumentError(
-        "num_threads is not specified in ThreadPoolExecutorOptions.");
-  }
-  if (options.num_threads() <= 0) {
-    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
-           << "The num_threads field in ThreadPoolExecutorOptions should be "
-              "positive but is "
-           << options.num_threads();
-  }
+namespace internal {
 
+absl::StatusOr<ThreadOptions> ThreadOptionsFromExecutorOptions(
+    const ThreadPoolExecutorOptions& options) {
   ThreadOptions thread_options;
   if (options.has_stack_size()) {
     // thread_options.set_stack_size() takes a size_t as input, so we must not
@@ -70,8 +65,56 @@ absl::StatusOr<Executor*> ThreadPoolExecutor::Create(
     default:
       break;
   }
+  if (options.has_numa_node()) {
+    if (options.numa_node() < 0 || options.numa_node() >= NumNumaNodes()) {
+      return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+             << "The numa_node field in ThreadPoolExecutorOptions should be "
+                "in [0, "
+             << NumNumaNodes() << ") but is " << options.numa_node();
+    }
+    std::set<int> cpu_set = NumaNodeCpuIds(options.numa_node());
+    if (!thread_options.cpu_set().empty()) {
+      // Keep the processors of the requested performance on the NUMA node,
+      // if there are any.
+      std::set<int> node_cpu_set;
+      absl::c_set_intersection(thread_options.cpu_set(), cpu_set,
+                               std::inserter(node_cpu_set,
+                                             node_cpu_set.begin()));
+      if (!node_cpu_set.empty()) {
+        cpu_set = std::move(node_cpu_set);
+      }
+    }
+    thread_options.set_cpu_set(cpu_set);
+  }
 #endif
-  return new ThreadPoolExecutor(thread_options, options.num_threads());
+  return thread_options;
+}
+
+}  // namespace internal
+
+// static
+absl::StatusOr<Executor*> ThreadPoolExecutor::Create(
+    const MediaPipeOptions& extendable_options) {
+  auto& options =
+      extendable_options.GetExtension(ThreadPoolExecutorOptions::ext);
+  if (!options.has_num_threads()) {
+    return absl::InvalidArgumentError(
+        "num_threads is not specified in ThreadPoolExecutorOptions.");
+  }
+  if (options.num_threads() <= 0) {
+    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+           << "The num_threads field in ThreadPoolExecutorOptions should be "
+              "positive but is "
+           << options.num_threads();
+  }
+  MP_ASSIGN_OR_RETURN(ThreadOptions thread_options,
+                      internal::ThreadOptionsFromExecutorOptions(options));
+  auto* executor =
+      new ThreadPoolExecutor(thread_options, options.num_threads());
+  executor->running_task_limits_.assign(
+      options.max_running_tasks_for_thermal_state().begin(),
+      options.max_running_tasks_for_thermal_state().end());
+  return executor;
 }
 
 ThreadPoolExecutor::ThreadPoolExecutor(int num_threads)
@@ -94,7 +137,48 @@ ThreadPoolExecutor::~ThreadPoolExecutor() {
 }
 
 void ThreadPoolExecutor::Schedule(std::function<void()> task) {
-  thread_pool_.Schedule(std::move(task));
+  if (running_task_limits_.empty()) {
+    thread_pool_.Schedule(std::move(task));
+    return;
+  }
+  absl::MutexLock lock(&throttle_mutex_);
+  throttled_tasks_.push_back(std::move(task));
+  DispatchThrottledTasks();
+}
+
+int ThreadPoolExecutor::RunningTaskLimit() const {
+  const int state = std::min<int>(GetThermalState(),
+                                  running_task_limits_.size() - 1);
+  const int limit = running_task_limits_[state];
+  return limit > 0 ? limit : thread_pool_.num_threads();
+}
+
+void ThreadPoolExecutor::DispatchThrottledTasks() {
+  const int limit = RunningTaskLimit();
+  while (!throttled_tasks_.empty() && num_running_tasks_ < limit) {
+    ++num_running_tasks_;
+    thread_pool_.Schedule(
+        [this, task = std::move(throttled_tasks_.front())]() mutable {
+          RunThrottled(std::move(task));
+        });
+    throttled_tasks_.pop_front();
+  }
+}
+
+void ThreadPoolExecutor::RunThrottled(std::function<void()> task) {
+  while (true) {
+    task();
+    absl::MutexLock lock(&throttle_mutex_);
+    // Keep running queued tasks on this thread while the limit allows it.
+    if (throttled_tasks_.empty() || num_running_tasks_ > RunningTaskLimit()) {
+      --num_running_tasks_;
+      DispatchThrottledTasks();
+      return;
+    }
+    task = std::move(throttled_tasks_.front());
+    throttled_tasks_.pop_front();
+    DispatchThrottledTasks();
+  }
 }
 
 void ThreadPoolExecutor::Start() {
@@ -15,14 +15,26 @@
 #ifndef MEDIAPIPE_FRAMEWORK_THREAD_POOL_EXECUTOR_H_
 #define MEDIAPIPE_FRAMEWORK_THREAD_POOL_EXECUTOR_H_
 
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/deps/thread_options.h"
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/port/statusor.h"
 #include "mediapipe/framework/port/threadpool.h"
+#include "mediapipe/framework/thread_pool_executor.pb.h"
 
 namespace mediapipe {
 
 // A multithreaded executor based on a thread pool.
+//
+// With max_running_tasks_for_thermal_state in its ThreadPoolExecutorOptions,
+// the executor runs fewer tasks at once in the hotter thermal states reported
+// through mediapipe/util/thermal_state.h. The tasks over the limit are queued
+// and run by the threads of the tasks that finish.
 class ThreadPoolExecutor : public Executor {
  public:
   static absl::StatusOr<Executor*> Create(
@@ -43,6 +55,26 @@ class ThreadPoolExecutor : public Executor {
   // Saves the value of the stack size option and starts the thread pool.
   void Start();
 
+  // Returns the maximum number of running tasks in the current thermal state.
+  int RunningTaskLimit() const;
+
+  // Runs `task`, then the throttled tasks allowed by the running task limit.
+  void RunThrottled(std::function<void()> task);
+
+  // Schedules throttled tasks on the thread pool up to the running task limit.
+  void DispatchThrottledTasks() ABSL_EXCLUSIVE_LOCKS_REQUIRED(throttle_mutex_);
+
+  // The max_running_tasks_for_thermal_state option. Set before any task is
+  // scheduled; no throttling if empty.
+  std::vector<int> running_task_limits_;
+
+  absl::Mutex throttle_mutex_;
+  int num_running_tasks_ ABSL_GUARDED_BY(throttle_mutex_) = 0;
+  std::deque<std::function<void()>> throttled_tasks_
+      ABSL_GUARDED_BY(throttle_mutex_);
+
+  // Declared after the throttling state, which its threads use until they are
+  // joined.
   mediapipe::ThreadPool thread_pool_;
 
   // Records the stack size in ThreadOptions right before we call
@@ -58,6 +90,17 @@ class ThreadPoolExecutor : public Executor {
   size_t stack_size_ = 0;
 };
 
+namespace internal {
+
+// Converts the thread-related fields of ThreadPoolExecutorOptions (stack size,
+// nice priority level, name prefix and processor performance) into
+// ThreadOptions. Shared by the executors that accept
+// ThreadPoolExecutorOptions.
+absl::StatusOr<ThreadOptions> ThreadOptionsFromExecutorOptions(
+    const ThreadPoolExecutorOptions& options);
+
+}  // namespace internal
+
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_FRAMEWORK_THREAD_POOL_EXECUTOR_H_
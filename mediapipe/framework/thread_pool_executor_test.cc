@@ -0,0 +1,129 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/thread_pool_executor.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/mediapipe_options.pb.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/thread_pool_executor.pb.h"
+#include "mediapipe/util/thermal_state.h"
+
+namespace mediapipe {
+namespace {
+
+// Options for 4 threads, 2 of which run in thermal state 1 and 1 from state 2.
+MediaPipeOptions ThrottledOptions() {
+  MediaPipeOptions options;
+  auto* extension = options.MutableExtension(ThreadPoolExecutorOptions::ext);
+  extension->set_num_threads(4);
+  extension->add_max_running_tasks_for_thermal_state(0);
+  extension->add_max_running_tasks_for_thermal_state(2);
+  extension->add_max_running_tasks_for_thermal_state(1);
+  return options;
+}
+
+// Runs `num_tasks` tasks of 2 ms on `executor` and returns the largest number
+// of them that ran at once.
+int MaxRunningTasks(Executor& executor, int num_tasks) {
+  absl::Mutex mutex;
+  int num_running = 0;
+  int max_running = 0;
+  absl::BlockingCounter done(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    executor.Schedule([&] {
+      {
+        absl::MutexLock lock(&mutex);
+        ++num_running;
+        max_running = std::max(max_running, num_running);
+      }
+      absl::SleepFor(absl::Milliseconds(2));
+      {
+        absl::MutexLock lock(&mutex);
+        --num_running;
+      }
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+  return max_running;
+}
+
+class ThreadPoolExecutorTest : public ::testing::Test {
+ protected:
+  void TearDown() override { SetThermalState(0); }
+};
+
+TEST_F(ThreadPoolExecutorTest, RunsAllThreadsWhenNotThrottled) {
+  MP_ASSERT_OK_AND_ASSIGN(Executor * executor_ptr,
+                          ThreadPoolExecutor::Create(ThrottledOptions()));
+  std::unique_ptr<Executor> executor(executor_ptr);
+  // Completes only if the 4 tasks run at once.
+  absl::Mutex mutex;
+  int num_started = 0;
+  absl::BlockingCounter done(4);
+  for (int i = 0; i < 4; ++i) {
+    executor->Schedule([&] {
+      absl::MutexLock lock(&mutex);
+      ++num_started;
+      mutex.Await(absl::Condition(
+          +[](int* num_started) { return *num_started == 4; }, &num_started));
+      done.DecrementCount();
+    });
+  }
+  done.Wait();
+}
+
+TEST_F(ThreadPoolExecutorTest, LimitsRunningTasksInHotThermalStates) {
+  MP_ASSERT_OK_AND_ASSIGN(Executor * executor_ptr,
+                          ThreadPoolExecutor::Create(ThrottledOptions()));
+  std::unique_ptr<Executor> executor(executor_ptr);
+  SetThermalState(1);
+  EXPECT_LE(MaxRunningTasks(*executor, 12), 2);
+  // States past the end of the option use its last entry.
+  SetThermalState(5);
+  EXPECT_EQ(MaxRunningTasks(*executor, 12), 1);
+}
+
+TEST_F(ThreadPoolExecutorTest, RunsQueuedTasksWhenCooledDown) {
+  MP_ASSERT_OK_AND_ASSIGN(Executor * executor_ptr,
+                          ThreadPoolExecutor::Create(ThrottledOptions()));
+  std::unique_ptr<Executor> executor(executor_ptr);
+  SetThermalState(2);
+  absl::BlockingCounter done(8);
+  absl::Notification released;
+  executor->Schedule([&] {
+    // Cools down while the other tasks are queued behind this one.
+    released.WaitForNotification();
+    done.DecrementCount();
+  });
+  for (int i = 0; i < 7; ++i) {
+    executor->Schedule([&] { done.DecrementCount(); });
+  }
+  SetThermalState(0);
+  released.Notify();
+  done.Wait();
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,223 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_partition.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/tool/validate_name.h"
+
+namespace mediapipe {
+namespace tool {
+
+namespace {
+
+absl::StatusOr<std::string> NameOf(const std::string& tag_index_name) {
+  std::string tag;
+  int index;
+  std::string name;
+  MP_RETURN_IF_ERROR(ParseTagIndexName(tag_index_name, &tag, &index, &name));
+  return name;
+}
+
+// Maps the names of the streams or side packets in `tag_index_names` to their
+// declarations.
+absl::StatusOr<std::map<std::string, std::string>> DeclarationsByName(
+    const proto_ns::RepeatedPtrField<std::string>& tag_index_names) {
+  std::map<std::string, std::string> declarations;
+  for (const std::string& tag_index_name : tag_index_names) {
+    MP_ASSIGN_OR_RETURN(std::string name, NameOf(tag_index_name));
+    declarations[name] = tag_index_name;
+  }
+  return declarations;
+}
+
+}  // namespace
+
+absl::StatusOr<std::map<std::string, CalculatorGraphConfig>> PartitionGraph(
+    const CalculatorGraphConfig& config, const GraphPartitionOptions& options) {
+  RET_CHECK(options.remote_stream_factory)
+      << "A remote stream factory is required.";
+  MP_ASSIGN_OR_RETURN(const auto graph_input_streams,
+                      DeclarationsByName(config.input_stream()));
+  MP_ASSIGN_OR_RETURN(const auto graph_input_side_packets,
+                      DeclarationsByName(config.input_side_packet()));
+  std::set<std::string> declared_executors;
+  for (const ExecutorConfig& executor : config.executor()) {
+    declared_executors.insert(executor.name());
+  }
+
+  // The partition of each node, and of each stream and side packet output by
+  // a node.
+  std::vector<std::string> node_partitions;
+  std::map<std::string, std::string> stream_partitions;
+  std::map<std::string, std::string> side_packet_partitions;
+  for (const CalculatorGraphConfig::Node& node : config.node()) {
+    const std::string& partition = node.executor().empty()
+                                       ? options.default_partition
+                                       : node.executor();
+    node_partitions.push_back(partition);
+    for (const std::string& output_stream : node.output_stream()) {
+      MP_ASSIGN_OR_RETURN(std::string name, NameOf(output_stream));
+      if (graph_input_streams.count(name) > 0 ||
+          !stream_partitions.emplace(name, partition).second) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Stream \"", name, "\" has more than one producer."));
+      }
+    }
+    for (const std::string& output_side_packet : node.output_side_packet()) {
+      MP_ASSIGN_OR_RETURN(std::string name, NameOf(output_side_packet));
+      side_packet_partitions[name] = partition;
+    }
+  }
+
+  // Each partition starts with the graph-level settings of `config`.
+  CalculatorGraphConfig base_config = config;
+  base_config.clear_node();
+  base_config.clear_input_stream();
+  base_config.clear_output_stream();
+  base_config.clear_input_side_packet();
+  base_config.clear_output_side_packet();
+  base_config.clear_executor();
+  base_config.clear_packet_factory();
+  base_config.clear_packet_generator();
+  base_config.clear_status_handler();
+  std::map<std::string, CalculatorGraphConfig> partitions;
+  auto partition_config =
+      [&](const std::string& partition) -> CalculatorGraphConfig& {
+    return partitions.try_emplace(partition, base_config).first->second;
+  };
+
+  // The streams and side packets each partition already receives.
+  std::set<std::pair<std::string, std::string>> partition_streams;
+  std::set<std::pair<std::string, std::string>> partition_side_packets;
+  std::set<std::pair<std::string, std::string>> partition_executors;
+  for (int i = 0; i < config.node_size(); ++i) {
+    const CalculatorGraphConfig::Node& node = config.node(i);
+    const std::string& partition = node_partitions[i];
+    CalculatorGraphConfig& graph = partition_config(partition);
+    CalculatorGraphConfig::Node* partition_node = graph.add_node();
+    *partition_node = node;
+    if (declared_executors.count(node.executor()) > 0) {
+      partition_executors.emplace(partition, node.executor());
+    } else {
+      partition_node->clear_executor();
+    }
+
+    for (const std::string& input_stream : node.input_stream()) {
+      MP_ASSIGN_OR_RETURN(std::string name, NameOf(input_stream));
+      auto graph_input = graph_input_streams.find(name);
+      if (graph_input != graph_input_streams.end()) {
+        if (partition_streams.emplace(partition, name).second) {
+          graph.add_input_stream(graph_input->second);
+        }
+        continue;
+      }
+      auto producer = stream_partitions.find(name);
+      if (producer == stream_partitions.end()) {
+        return absl::InvalidArgumentError(
+            absl::StrCat("Stream \"", name, "\" has no producer."));
+      }
+      if (producer->second == partition ||
+          !partition_streams.emplace(partition, name).second) {
+        continue;
+      }
+      MP_ASSIGN_OR_RETURN(auto remote_nodes,
+                          options.remote_stream_factory(
+                              {name, producer->second, partition}));
+      *partition_config(producer->second).add_node() =
+          std::move(remote_nodes.first);
+      *graph.add_node() = std::move(remote_nodes.second);
+    }
+
+    for (const std::string& input_side_packet : node.input_side_packet()) {
+      MP_ASSIGN_OR_RETURN(std::string name, NameOf(input_side_packet));
+      auto producer = side_packet_partitions.find(name);
+      if (producer != side_packet_partitions.end()) {
+        if (producer->second != partition) {
+          return absl::UnimplementedError(absl::StrCat(
+              "Side packet \"", name, "\" can't be passed from partition \"",
+              producer->second, "\" to partition \"", partition, "\"."));
+        }
+        continue;
+      }
+      auto graph_input = graph_input_side_packets.find(name);
+      if (graph_input != graph_input_side_packets.end() &&
+          partition_side_packets.emplace(partition, name).second) {
+        graph.add_input_side_packet(graph_input->second);
+      }
+    }
+  }
+
+  for (const std::string& output_stream : config.output_stream()) {
+    MP_ASSIGN_OR_RETURN(std::string name, NameOf(output_stream));
+    auto producer = stream_partitions.find(name);
+    if (producer != stream_partitions.end()) {
+      partition_config(producer->second).add_output_stream(output_stream);
+      continue;
+    }
+    // A graph input stream passed through to the output.
+    auto graph_input = graph_input_streams.find(name);
+    if (graph_input == graph_input_streams.end()) {
+      return absl::InvalidArgumentError(
+          absl::StrCat("Stream \"", name, "\" has no producer."));
+    }
+    CalculatorGraphConfig& graph = partition_config(options.default_partition);
+    if (partition_streams.emplace(options.default_partition, name).second) {
+      graph.add_input_stream(graph_input->second);
+    }
+    graph.add_output_stream(output_stream);
+  }
+  for (const std::string& output_side_packet : config.output_side_packet()) {
+    MP_ASSIGN_OR_RETURN(std::string name, NameOf(output_side_packet));
+    auto producer = side_packet_partitions.find(name);
+    partition_config(producer != side_packet_partitions.end()
+                         ? producer->second
+                         : options.default_partition)
+        .add_output_side_packet(output_side_packet);
+  }
+
+  // The default executor config applies to every partition, the others only
+  // to the partitions using them.
+  for (const ExecutorConfig& executor : config.executor()) {
+    for (auto& [partition, graph] : partitions) {
+      if (executor.name().empty() ||
+          partition_executors.count({partition, executor.name()}) > 0) {
+        *graph.add_executor() = executor;
+      }
+    }
+  }
+
+  if (config.packet_factory_size() > 0 || config.packet_generator_size() > 0 ||
+      config.status_handler_size() > 0) {
+    CalculatorGraphConfig& graph = partition_config(options.default_partition);
+    *graph.mutable_packet_factory() = config.packet_factory();
+    *graph.mutable_packet_generator() = config.packet_generator();
+    *graph.mutable_status_handler() = config.status_handler();
+  }
+  return partitions;
+}
+
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,83 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_PARTITION_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_PARTITION_H_
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+
+namespace mediapipe {
+namespace tool {
+
+// A stream whose producer and consumers are in different partitions.
+struct CutStream {
+  // The name of the stream.
+  std::string name;
+  // The partition of the node producing the stream.
+  std::string producer_partition;
+  // A partition with nodes consuming the stream.
+  std::string consumer_partition;
+};
+
+// Returns the two nodes carrying `stream` across partitions: a sink node,
+// added to the producer partition, with an input stream named `stream.name`,
+// and a source node, added to the consumer partition, with an output stream
+// named `stream.name`. The nodes must forward timestamp bounds as well as
+// packets, so that the consumers are not stalled by missing packets.
+using RemoteStreamFactory = std::function<
+    absl::StatusOr<std::pair<CalculatorGraphConfig::Node,
+                             CalculatorGraphConfig::Node>>(const CutStream&)>;
+
+// Options for PartitionGraph().
+struct GraphPartitionOptions {
+  // The partition of nodes which don't set an executor.
+  std::string default_partition = "default";
+
+  // Creates the nodes replacing each cut stream, e.g.
+  // SharedMemoryOutputCalculator and SharedMemoryInputCalculator for
+  // partitions on the same machine, or network transport calculators.
+  // Required.
+  RemoteStreamFactory remote_stream_factory;
+};
+
+// Splits the graph described by `config` into one graph per partition, keyed
+// by partition name, so that the partitions can run in different processes
+// or on different machines. Each node is placed in the partition named by its
+// `executor` field. Executors declared in `config` are kept in the partitions
+// using them; undeclared executor names only annotate the placement and are
+// cleared.
+//
+// Streams between partitions are replaced by the nodes returned by
+// `options.remote_stream_factory`, once per consuming partition. Graph input
+// streams and side packets are declared by every partition consuming them,
+// and graph output streams by the partition producing them. Packet generators
+// and status handlers are kept in the default partition. Side packets output
+// by nodes can't cross partitions.
+//
+// A subgraph node is placed as a whole. To place the nodes of subgraphs
+// individually, partition the expanded config, i.e.
+// ValidatedGraphConfig::Config().
+absl::StatusOr<std::map<std::string, CalculatorGraphConfig>> PartitionGraph(
+    const CalculatorGraphConfig& config, const GraphPartitionOptions& options);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_GRAPH_PARTITION_H_
@@ -0,0 +1,194 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/graph_partition.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/deps/message_matchers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace tool {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::Key;
+
+// Replaces cut streams by RemoteSink and RemoteSource nodes.
+GraphPartitionOptions TestOptions() {
+  GraphPartitionOptions options;
+  options.remote_stream_factory = [](const CutStream& stream) {
+    const std::string channel = absl::StrCat(
+        stream.producer_partition, "/", stream.name, "/",
+        stream.consumer_partition);
+    CalculatorGraphConfig::Node sink;
+    sink.set_calculator("RemoteSink");
+    sink.add_input_stream(stream.name);
+    sink.add_input_side_packet(absl::StrCat("CHANNEL:", channel));
+    CalculatorGraphConfig::Node source;
+    source.set_calculator("RemoteSource");
+    source.add_output_stream(stream.name);
+    source.add_input_side_packet(absl::StrCat("CHANNEL:", channel));
+    return std::make_pair(std::move(sink), std::move(source));
+  };
+  return options;
+}
+
+TEST(GraphPartitionTest, CutsStreamsBetweenPartitions) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "VIDEO:frames"
+        output_stream: "detections"
+        output_stream: "annotated_frames"
+        num_threads: 4
+        executor {
+          name: "gpu"
+          type: "ThreadPoolExecutor"
+        }
+        node {
+          calculator: "Preprocess"
+          executor: "cpu"
+          input_stream: "IMAGE:frames"
+          output_stream: "TENSORS:tensors"
+        }
+        node {
+          calculator: "Inference"
+          executor: "gpu"
+          input_stream: "TENSORS:tensors"
+          output_stream: "DETECTIONS:detections"
+        }
+        node {
+          calculator: "Annotate"
+          input_stream: "IMAGE:frames"
+          input_stream: "DETECTIONS:detections"
+          output_stream: "IMAGE:annotated_frames"
+        }
+      )pb");
+  MP_ASSERT_OK_AND_ASSIGN(auto partitions,
+                          PartitionGraph(config, TestOptions()));
+  EXPECT_THAT(partitions, ElementsAre(Key("cpu"), Key("default"), Key("gpu")));
+
+  // The "cpu" executor only annotates the placement.
+  EXPECT_THAT(partitions["cpu"],
+              EqualsProto(ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+                input_stream: "VIDEO:frames"
+                num_threads: 4
+                node {
+                  calculator: "Preprocess"
+                  input_stream: "IMAGE:frames"
+                  output_stream: "TENSORS:tensors"
+                }
+                node {
+                  calculator: "RemoteSink"
+                  input_stream: "tensors"
+                  input_side_packet: "CHANNEL:cpu/tensors/gpu"
+                }
+              )pb")));
+  EXPECT_THAT(partitions["gpu"],
+              EqualsProto(ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+                output_stream: "detections"
+                num_threads: 4
+                executor {
+                  name: "gpu"
+                  type: "ThreadPoolExecutor"
+                }
+                node {
+                  calculator: "Inference"
+                  executor: "gpu"
+                  input_stream: "TENSORS:tensors"
+                  output_stream: "DETECTIONS:detections"
+                }
+                node {
+                  calculator: "RemoteSource"
+                  output_stream: "tensors"
+                  input_side_packet: "CHANNEL:cpu/tensors/gpu"
+                }
+                node {
+                  calculator: "RemoteSink"
+                  input_stream: "detections"
+                  input_side_packet: "CHANNEL:gpu/detections/default"
+                }
+              )pb")));
+  // The graph output stream stays with its producer.
+  EXPECT_THAT(partitions["default"],
+              EqualsProto(ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+                input_stream: "VIDEO:frames"
+                output_stream: "annotated_frames"
+                num_threads: 4
+                node {
+                  calculator: "Annotate"
+                  input_stream: "IMAGE:frames"
+                  input_stream: "DETECTIONS:detections"
+                  output_stream: "IMAGE:annotated_frames"
+                }
+                node {
+                  calculator: "RemoteSource"
+                  output_stream: "detections"
+                  input_side_packet: "CHANNEL:gpu/detections/default"
+                }
+              )pb")));
+}
+
+TEST(GraphPartitionTest, KeepsSinglePartitionIntact) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "in"
+        output_stream: "out"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "in"
+          output_stream: "middle"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "middle"
+          output_stream: "out"
+        }
+      )pb");
+  MP_ASSERT_OK_AND_ASSIGN(auto partitions,
+                          PartitionGraph(config, TestOptions()));
+  ASSERT_THAT(partitions, ElementsAre(Key("default")));
+  EXPECT_THAT(partitions["default"], EqualsProto(config));
+}
+
+TEST(GraphPartitionTest, RejectsSidePacketsBetweenPartitions) {
+  CalculatorGraphConfig config = ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        node {
+          calculator: "ModelLoader"
+          executor: "cpu"
+          output_side_packet: "MODEL:model"
+        }
+        node {
+          calculator: "Inference"
+          executor: "gpu"
+          input_side_packet: "MODEL:model"
+        }
+      )pb");
+  EXPECT_EQ(PartitionGraph(config, TestOptions()).status().code(),
+            absl::StatusCode::kUnimplemented);
+}
+
+}  // namespace
+}  // namespace tool
+}  // namespace mediapipe
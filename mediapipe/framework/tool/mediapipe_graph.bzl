@@ -13,6 +13,11 @@ Example:
     ]
   )
 
+With expand_subgraphs = True, subgraph nodes are expanded at build time using
+the subgraphs registered by deps, which saves the expansion when the graph is
+loaded. Graph options passed at runtime are then not applied to the nodes
+inlined from subgraphs.
+
 """
 
 load("//mediapipe/framework:encode_binary_proto.bzl", "encode_binary_proto", "generate_proto_descriptor_set")
@@ -25,7 +30,7 @@ load("//mediapipe/framework/tool:build_defs.bzl", "clean_dep")
 load("//mediapipe/framework/deps:descriptor_set.bzl", "direct_descriptor_set", "transitive_descriptor_set")
 load("@org_tensorflow//tensorflow/lite/core/shims:cc_library_with_tflite.bzl", "cc_library_with_tflite")
 
-def mediapipe_binary_graph(name, graph = None, output_name = None, deps = [], testonly = False, **kwargs):
+def mediapipe_binary_graph(name, graph = None, output_name = None, deps = [], testonly = False, expand_subgraphs = False, **kwargs):
     """Converts a graph from text format to binary format."""
 
     if not graph:
@@ -47,7 +52,7 @@ def mediapipe_binary_graph(name, graph = None, output_name = None, deps = [], te
         deps = [
             clean_dep("//mediapipe/framework/tool:text_to_binary_graph"),
             name + "_gather_cc_protos",
-        ],
+        ] + (deps if expand_subgraphs else []),
         tags = ["manual"],
         testonly = testonly,
     )
@@ -60,7 +65,8 @@ def mediapipe_binary_graph(name, graph = None, output_name = None, deps = [], te
         cmd = (
             "$(location " + name + "_text_to_binary_graph" + ") " +
             ("--proto_source=$(location %s) " % graph) +
-            ("--proto_output=\"$@\" ")
+            ("--proto_output=\"$@\" ") +
+            ("--expand_subgraphs " if expand_subgraphs else "")
         ),
         tools = [name + "_text_to_binary_graph"],
         testonly = testonly,
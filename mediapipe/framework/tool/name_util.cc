@@ -17,6 +17,7 @@
 #include <set>
 #include <unordered_map>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -93,6 +94,33 @@ std::string CanonicalNodeName(const CalculatorGraphConfig& graph_config,
   return absl::StrCat(node_name, "_", sequence + 1);
 }
 
+std::vector<std::string> CanonicalNodeNames(
+    const CalculatorGraphConfig& graph_config) {
+  const int num_nodes = graph_config.node_size();
+  std::vector<std::string> names(num_nodes);
+  // The number of nodes sharing each name.
+  absl::flat_hash_map<absl::string_view, int> counts;
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node_config = graph_config.node(i);
+    ++counts[node_config.name().empty() ? node_config.calculator()
+                                        : node_config.name()];
+  }
+  // The number of nodes seen so far with each shared name.
+  absl::flat_hash_map<absl::string_view, int> sequences;
+  for (int i = 0; i < num_nodes; ++i) {
+    const auto& node_config = graph_config.node(i);
+    absl::string_view node_name = node_config.name().empty()
+                                      ? node_config.calculator()
+                                      : node_config.name();
+    if (counts[node_name] <= 1) {
+      names[i] = std::string(node_name);
+    } else {
+      names[i] = absl::StrCat(node_name, "_", ++sequences[node_name]);
+    }
+  }
+  return names;
+}
+
 std::string ParseNameFromStream(const std::string& stream) {
   std::string tag, name;
   int index;
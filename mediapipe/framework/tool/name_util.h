@@ -16,6 +16,8 @@
 #define MEDIAPIPE_FRAMEWORK_TOOL_NAME_UTIL_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "mediapipe/framework/calculator.pb.h"
 
@@ -73,6 +75,12 @@ std::string GetUnusedNodeName(const CalculatorGraphConfig& config,
 std::string CanonicalNodeName(const CalculatorGraphConfig& graph_config,
                               int node_id);
 
+// Returns the CanonicalNodeName of every node, in node order. Takes time
+// linear in the number of nodes, where calling CanonicalNodeName for every
+// node takes quadratic time.
+std::vector<std::string> CanonicalNodeNames(
+    const CalculatorGraphConfig& graph_config);
+
 // Parses the name from a "tag:index:name".
 std::string ParseNameFromStream(const std::string& stream);
 
@@ -94,6 +102,7 @@ std::string CatStream(const std::pair<std::string, int>& tag_index,
 
 namespace mediapipe {
 using mediapipe::tool::CanonicalNodeName;
+using mediapipe::tool::CanonicalNodeNames;
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_FRAMEWORK_TOOL_NAME_UTIL_H_
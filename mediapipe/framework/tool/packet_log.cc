@@ -0,0 +1,129 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/packet_log.h"
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/util/delimited_message_util.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+#include "mediapipe/framework/type_map.h"
+
+namespace mediapipe {
+namespace tool {
+
+absl::StatusOr<PacketLogRecord> PacketToLogRecord(const std::string& stream,
+                                                  const Packet& packet) {
+  PacketLogRecord record;
+  record.set_stream(stream);
+  record.set_timestamp(packet.Timestamp().Value());
+  if (packet.ValidateAsProtoMessageLite().ok()) {
+    const proto_ns::MessageLite& message = packet.GetProtoMessageLite();
+    record.set_encoding(PacketLogRecord::PROTO_MESSAGE);
+    record.set_type_name(message.GetTypeName());
+    RET_CHECK(message.SerializeToString(record.mutable_payload()));
+    return record;
+  }
+  const MediaPipeTypeData* type_data =
+      PacketTypeIdToMediaPipeTypeData::GetValue(packet.GetTypeId().hash_code());
+  if (type_data == nullptr || !type_data->serialize_fn) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Packets of type ", packet.GetTypeId().name(), " on stream \"", stream,
+        "\" are neither protobuf messages nor registered with serialize "
+        "functions, so they cannot be recorded."));
+  }
+  record.set_encoding(PacketLogRecord::REGISTERED_TYPE);
+  record.set_type_name(type_data->type_string);
+  MP_RETURN_IF_ERROR(type_data->serialize_fn(
+      *packet_internal::GetHolder(packet), record.mutable_payload()));
+  return record;
+}
+
+absl::StatusOr<Packet> PacketFromLogRecord(const PacketLogRecord& record) {
+  Packet packet;
+  switch (record.encoding()) {
+    case PacketLogRecord::PROTO_MESSAGE: {
+      MP_ASSIGN_OR_RETURN(packet, packet_internal::PacketFromDynamicProto(
+                                      record.type_name(), record.payload()));
+      break;
+    }
+    case PacketLogRecord::REGISTERED_TYPE: {
+      const MediaPipeTypeData* type_data =
+          PacketTypeStringToMediaPipeTypeData::GetValue(record.type_name());
+      RET_CHECK(type_data != nullptr && type_data->deserialize_fn)
+          << "No deserialize function registered for type "
+          << record.type_name();
+      std::unique_ptr<packet_internal::HolderBase> holder;
+      MP_RETURN_IF_ERROR(type_data->deserialize_fn(record.payload(), &holder));
+      packet = packet_internal::Create(holder.release());
+      break;
+    }
+  }
+  return packet.At(Timestamp::CreateNoErrorChecking(record.timestamp()));
+}
+
+absl::Status PacketLogWriter::Open(const std::string& path) {
+  file_.open(path, std::ios::binary | std::ios::trunc);
+  RET_CHECK(file_.is_open()) << "Unable to open packet log " << path;
+  return absl::OkStatus();
+}
+
+absl::Status PacketLogWriter::Write(const PacketLogRecord& record) {
+  RET_CHECK(proto_ns::util::SerializeDelimitedToOstream(record, &file_))
+      << "Unable to write packet log record.";
+  return absl::OkStatus();
+}
+
+absl::Status PacketLogWriter::Close() {
+  if (!file_.is_open()) {
+    return absl::OkStatus();
+  }
+  file_.close();
+  RET_CHECK(!file_.fail()) << "Unable to write packet log.";
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<PacketLogRecord>> ReadPacketLog(
+    const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  RET_CHECK(file.is_open()) << "Unable to open packet log " << path;
+  proto_ns::io::IstreamInputStream stream(&file);
+  std::vector<PacketLogRecord> records;
+  while (true) {
+    PacketLogRecord record;
+    bool clean_eof = false;
+    if (!proto_ns::util::ParseDelimitedFromZeroCopyStream(&record, &stream,
+                                                          &clean_eof)) {
+      RET_CHECK(clean_eof) << "Malformed packet log " << path;
+      break;
+    }
+    records.push_back(std::move(record));
+  }
+  return records;
+}
+
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,60 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Conversion of packets to and from PacketLogRecords, and reading and writing
+// packet logs. See PacketRecorderCalculator and ReplayPacketLog().
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_PACKET_LOG_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_PACKET_LOG_H_
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+
+namespace mediapipe {
+namespace tool {
+
+// Serializes `packet` into a record for `stream`. The packet must hold a
+// protobuf message or a type registered with serialize functions, otherwise
+// returns an InvalidArgumentError. The record time is left unset.
+absl::StatusOr<PacketLogRecord> PacketToLogRecord(const std::string& stream,
+                                                  const Packet& packet);
+
+// Restores the packet of `record`, at the recorded timestamp.
+absl::StatusOr<Packet> PacketFromLogRecord(const PacketLogRecord& record);
+
+// Appends records to a packet log file.
+class PacketLogWriter {
+ public:
+  absl::Status Open(const std::string& path);
+  absl::Status Write(const PacketLogRecord& record);
+  absl::Status Close();
+
+ private:
+  std::ofstream file_;
+};
+
+// Reads all the records of the packet log at `path`, in recorded order.
+absl::StatusOr<std::vector<PacketLogRecord>> ReadPacketLog(
+    const std::string& path);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_PACKET_LOG_H_
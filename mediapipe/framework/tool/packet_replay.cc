@@ -0,0 +1,92 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/packet_replay.h"
+
+#include <memory>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_graph.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/deps/monotonic_clock.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/tool/packet_log.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+#include "mediapipe/framework/tool/simulation_clock.h"
+
+namespace mediapipe {
+namespace tool {
+
+namespace {
+
+// Adds the recorded packets to the graph input streams, sleeping on `clock`
+// until each one is due unless `max_speed` is set.
+absl::Status FeedRecords(const std::vector<PacketLogRecord>& records,
+                         bool max_speed, absl::Time start_time, Clock& clock,
+                         CalculatorGraph& graph) {
+  for (const PacketLogRecord& record : records) {
+    MP_ASSIGN_OR_RETURN(Packet packet, PacketFromLogRecord(record));
+    if (!max_speed) {
+      clock.SleepUntil(start_time +
+                       absl::Microseconds(record.record_time_us()));
+    }
+    MP_RETURN_IF_ERROR(graph.AddPacketToInputStream(record.stream(), packet));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::StatusOr<PacketReplayReport> ReplayPacketLog(
+    const std::vector<PacketLogRecord>& records,
+    const PacketReplayOptions& options, CalculatorGraph& graph) {
+  std::shared_ptr<Clock> clock = options.clock;
+  if (clock == nullptr) {
+    clock = std::shared_ptr<Clock>(
+        MonotonicClock::CreateSynchronizedMonotonicClock());
+  }
+  // A simulated clock only advances while all the threads using it sleep, so
+  // the feeding thread has to be counted among them.
+  auto* simulation_clock = dynamic_cast<SimulationClock*>(clock.get());
+
+  MP_RETURN_IF_ERROR(graph.StartRun(options.side_packets));
+  if (simulation_clock != nullptr) simulation_clock->ThreadStart();
+  const absl::Time start_time = clock->TimeNow();
+  absl::Status status =
+      FeedRecords(records, options.max_speed, start_time, *clock, graph);
+  if (simulation_clock != nullptr) simulation_clock->ThreadFinish();
+  MP_RETURN_IF_ERROR(status);
+  MP_RETURN_IF_ERROR(graph.CloseAllInputStreams());
+  MP_RETURN_IF_ERROR(graph.WaitUntilDone());
+
+  PacketReplayReport report;
+  report.num_packets = records.size();
+  report.duration = clock->TimeNow() - start_time;
+  if (report.duration > absl::ZeroDuration()) {
+    report.packets_per_second =
+        report.num_packets / absl::ToDoubleSeconds(report.duration);
+  }
+  if (graph.Config().profiler_config().enable_profiler()) {
+    MP_RETURN_IF_ERROR(
+        graph.profiler()->GetCalculatorProfiles(&report.calculator_profiles));
+  }
+  return report;
+}
+
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,90 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Replays a packet log recorded with PacketRecorderCalculator into a graph, to
+// benchmark graph changes offline against recorded traffic.
+//
+// Example:
+//   MP_ASSIGN_OR_RETURN(auto records, tool::ReadPacketLog(log_path));
+//   CalculatorGraph graph;
+//   MP_RETURN_IF_ERROR(graph.Initialize(config));  // With enable_profiler.
+//   tool::PacketReplayOptions options;
+//   options.max_speed = true;
+//   MP_ASSIGN_OR_RETURN(tool::PacketReplayReport report,
+//                       tool::ReplayPacketLog(records, options, graph));
+//
+// Replaying a log is deterministic when the graph runs on a
+// SimulationClockExecutor and its clock is passed as PacketReplayOptions.clock:
+// the packets are then added at the recorded simulated times.
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_PACKET_REPLAY_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_PACKET_REPLAY_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_graph.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/deps/clock.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+
+namespace mediapipe {
+namespace tool {
+
+struct PacketReplayOptions {
+  // If true, the packets are added as fast as the graph accepts them.
+  // Otherwise they are added at the recorded intervals.
+  bool max_speed = false;
+
+  // The clock used to pace the replay and to measure its duration. Defaults to
+  // a monotonic clock.
+  std::shared_ptr<Clock> clock;
+
+  // Input side packets to start the graph run with.
+  std::map<std::string, Packet> side_packets;
+};
+
+struct PacketReplayReport {
+  // The number of packets added to the graph.
+  int64_t num_packets = 0;
+
+  // The time from adding the first packet to the graph run being done.
+  absl::Duration duration;
+
+  // num_packets / duration.
+  double packets_per_second = 0;
+
+  // The per-node Process() runtime and input/output latency histograms of the
+  // replay, if the graph config enables the profiler.
+  std::vector<CalculatorProfile> calculator_profiles;
+};
+
+// Runs `graph`, which must be initialized and not running, on the packets of
+// `records`: each packet is added to the graph input stream named after its
+// recorded stream. All input streams are closed after the last packet, and
+// the report is returned once the graph is done.
+absl::StatusOr<PacketReplayReport> ReplayPacketLog(
+    const std::vector<PacketLogRecord>& records,
+    const PacketReplayOptions& options, CalculatorGraph& graph);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_PACKET_REPLAY_H_
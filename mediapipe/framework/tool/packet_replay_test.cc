@@ -0,0 +1,161 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/tool/packet_replay.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/packet_log.h"
+#include "mediapipe/framework/tool/packet_log.pb.h"
+#include "mediapipe/framework/tool/simulation_clock_executor.h"
+#include "mediapipe/framework/tool/sink.h"
+
+namespace mediapipe {
+namespace tool {
+namespace {
+
+using ::testing::HasSubstr;
+
+NormalizedRect MakeRect(float x_center) {
+  NormalizedRect rect;
+  rect.set_x_center(x_center);
+  rect.set_y_center(0.5f);
+  rect.set_width(0.1f);
+  rect.set_height(0.1f);
+  return rect;
+}
+
+TEST(PacketLogTest, RoundTripsProtoPackets) {
+  const Packet packet = MakePacket<NormalizedRect>(MakeRect(0.25f)).At(
+      Timestamp(1234));
+  MP_ASSERT_OK_AND_ASSIGN(PacketLogRecord record,
+                          PacketToLogRecord("rects", packet));
+  EXPECT_EQ(record.stream(), "rects");
+  EXPECT_EQ(record.timestamp(), 1234);
+  EXPECT_EQ(record.encoding(), PacketLogRecord::PROTO_MESSAGE);
+
+  MP_ASSERT_OK_AND_ASSIGN(Packet restored, PacketFromLogRecord(record));
+  EXPECT_EQ(restored.Timestamp(), Timestamp(1234));
+  EXPECT_FLOAT_EQ(restored.Get<NormalizedRect>().x_center(), 0.25f);
+}
+
+TEST(PacketLogTest, RejectsTypesWithoutSerialization) {
+  EXPECT_THAT(PacketToLogRecord("ints", MakePacket<int>(1)).status().message(),
+              HasSubstr("cannot be recorded"));
+}
+
+TEST(PacketLogTest, WritesAndReadsLog) {
+  const std::string path = absl::StrCat(::testing::TempDir(), "/rects.log");
+  PacketLogWriter writer;
+  MP_ASSERT_OK(writer.Open(path));
+  for (int i = 0; i < 3; ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(
+        PacketLogRecord record,
+        PacketToLogRecord("rects",
+                          MakePacket<NormalizedRect>(MakeRect(i)).At(
+                              Timestamp(i))));
+    record.set_record_time_us(i * 1000);
+    MP_ASSERT_OK(writer.Write(record));
+  }
+  MP_ASSERT_OK(writer.Close());
+
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<PacketLogRecord> records,
+                          ReadPacketLog(path));
+  ASSERT_EQ(records.size(), 3);
+  EXPECT_EQ(records[2].timestamp(), 2);
+  EXPECT_EQ(records[2].record_time_us(), 2000);
+}
+
+TEST(PacketReplayTest, RecordsAndReplaysGraphInputs) {
+  const std::string path = absl::StrCat(::testing::TempDir(), "/replay.log");
+
+  // Record the inputs of a graph.
+  {
+    CalculatorGraph graph;
+    MP_ASSERT_OK(graph.Initialize(ParseTextProtoOrDie<CalculatorGraphConfig>(
+        absl::StrCat(R"pb(
+          input_stream: "rects"
+          node {
+            calculator: "PacketRecorderCalculator"
+            input_stream: "rects"
+            options {
+              [mediapipe.PacketRecorderCalculatorOptions.ext] {
+                output_path: ")pb",
+                     path, R"pb("
+              }
+            }
+          }
+        )pb"))));
+    MP_ASSERT_OK(graph.StartRun({}));
+    for (int i = 0; i < 5; ++i) {
+      MP_ASSERT_OK(graph.AddPacketToInputStream(
+          "rects", MakePacket<NormalizedRect>(MakeRect(i)).At(Timestamp(i))));
+    }
+    MP_ASSERT_OK(graph.CloseAllInputStreams());
+    MP_ASSERT_OK(graph.WaitUntilDone());
+  }
+
+  // Replay them into another graph, at the recorded pace on a simulated clock.
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<PacketLogRecord> records,
+                          ReadPacketLog(path));
+  ASSERT_EQ(records.size(), 5);
+  for (int i = 0; i < records.size(); ++i) {
+    records[i].set_record_time_us(i * 10000);
+  }
+
+  auto config = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "rects"
+    node {
+      calculator: "PassThroughCalculator"
+      input_stream: "rects"
+      output_stream: "out"
+    }
+    profiler_config { enable_profiler: true }
+  )pb");
+  std::vector<Packet> output_packets;
+  AddVectorSink("out", &config, &output_packets);
+  auto executor = std::make_shared<SimulationClockExecutor>(/*num_threads=*/2);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.SetExecutor("", executor));
+  MP_ASSERT_OK(graph.Initialize(config));
+
+  PacketReplayOptions options;
+  options.clock = executor->GetClock();
+  MP_ASSERT_OK_AND_ASSIGN(PacketReplayReport report,
+                          ReplayPacketLog(records, options, graph));
+
+  ASSERT_EQ(output_packets.size(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(output_packets[i].Timestamp(), Timestamp(i));
+    EXPECT_FLOAT_EQ(output_packets[i].Get<NormalizedRect>().x_center(), i);
+  }
+  EXPECT_EQ(report.num_packets, 5);
+  EXPECT_GE(report.duration, absl::Milliseconds(40));
+  EXPECT_GT(report.packets_per_second, 0);
+  EXPECT_FALSE(report.calculator_profiles.empty());
+}
+
+}  // namespace
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,134 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/tool/segmented_graph_runner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/calculator_graph.h"
+#include "mediapipe/framework/deps/threadpool.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/timestamp.h"
+
+namespace mediapipe {
+namespace tool {
+
+namespace {
+
+// A segment of the time range and the packets its graph instance output in it.
+struct Segment {
+  int64_t start_us;
+  int64_t end_us;
+  bool is_first;
+  bool is_last;
+  std::map<std::string, std::vector<Packet>> packets;
+  absl::Status status;
+};
+
+bool IsInSegment(const Segment& segment, Timestamp timestamp) {
+  if (timestamp == Timestamp::PreStream()) return segment.is_first;
+  if (timestamp == Timestamp::PostStream()) return segment.is_last;
+  return timestamp >= Timestamp(segment.start_us) &&
+         timestamp < Timestamp(segment.end_us);
+}
+
+absl::Status RunSegment(const CalculatorGraphConfig& config,
+                        std::map<std::string, Packet> side_packets,
+                        const SegmentedRunOptions& options, Segment& segment) {
+  const int64_t warm_up_start_us =
+      std::max(options.start_us, segment.start_us - options.overlap_us);
+  side_packets[options.start_side_packet] =
+      MakePacket<int64_t>(warm_up_start_us);
+  side_packets[options.end_side_packet] = MakePacket<int64_t>(segment.end_us);
+
+  CalculatorGraph graph;
+  MP_RETURN_IF_ERROR(graph.Initialize(config));
+  for (const std::string& stream : options.output_streams) {
+    std::vector<Packet>* packets = &segment.packets[stream];
+    MP_RETURN_IF_ERROR(graph.ObserveOutputStream(
+        stream, [&segment, packets](const Packet& packet) {
+          if (IsInSegment(segment, packet.Timestamp())) {
+            packets->push_back(packet);
+          }
+          return absl::OkStatus();
+        }));
+  }
+  MP_RETURN_IF_ERROR(graph.StartRun(side_packets));
+  return graph.WaitUntilDone();
+}
+
+}  // namespace
+
+absl::StatusOr<std::map<std::string, std::vector<Packet>>> RunGraphInSegments(
+    const CalculatorGraphConfig& config,
+    const std::map<std::string, Packet>& side_packets,
+    const SegmentedRunOptions& options) {
+  RET_CHECK_GT(options.num_segments, 0);
+  RET_CHECK_GT(options.end_us, options.start_us);
+  RET_CHECK_GE(options.overlap_us, 0);
+
+  const int num_segments = options.num_segments;
+  const int64_t duration_us = options.end_us - options.start_us;
+  std::vector<Segment> segments(num_segments);
+  for (int i = 0; i < num_segments; ++i) {
+    Segment& segment = segments[i];
+    segment.start_us = options.start_us + duration_us * i / num_segments;
+    segment.end_us = options.start_us + duration_us * (i + 1) / num_segments;
+    segment.is_first = i == 0;
+    segment.is_last = i == num_segments - 1;
+  }
+
+  {
+    const int num_threads = options.max_parallel_graphs > 0
+                                ? std::min(options.max_parallel_graphs,
+                                           num_segments)
+                                : num_segments;
+    ThreadPool pool("segmented_graph_runner", num_threads);
+    pool.StartWorkers();
+    for (Segment& segment : segments) {
+      pool.Schedule([&config, &side_packets, &options, &segment] {
+        segment.status = RunSegment(config, side_packets, options, segment);
+      });
+    }
+    // The pool's destructor waits for all segments to be processed.
+  }
+
+  std::map<std::string, std::vector<Packet>> results;
+  for (const std::string& stream : options.output_streams) {
+    results[stream];
+  }
+  for (Segment& segment : segments) {
+    MP_RETURN_IF_ERROR(segment.status);
+    for (auto& [stream, packets] : segment.packets) {
+      std::vector<Packet>& merged = results[stream];
+      merged.insert(merged.end(), std::make_move_iterator(packets.begin()),
+                    std::make_move_iterator(packets.end()));
+    }
+  }
+  return results;
+}
+
+}  // namespace tool
+}  // namespace mediapipe
@@ -0,0 +1,83 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_FRAMEWORK_TOOL_SEGMENTED_GRAPH_RUNNER_H_
+#define MEDIAPIPE_FRAMEWORK_TOOL_SEGMENTED_GRAPH_RUNNER_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/packet.h"
+
+namespace mediapipe {
+namespace tool {
+
+// Options for RunGraphInSegments().
+struct SegmentedRunOptions {
+  // The time range to process, in microseconds: [start_us, end_us).
+  int64_t start_us = 0;
+  int64_t end_us = 0;
+
+  // The number of consecutive segments of equal duration the time range is
+  // split into. Each segment is processed by its own graph instance.
+  int num_segments = 1;
+
+  // The maximum number of graph instances running at once. 0 runs all
+  // segments at once.
+  int max_parallel_graphs = 0;
+
+  // How long before its segment each graph instance starts processing, in
+  // microseconds. Stateful calculators (trackers, smoothers, ...) warm up over
+  // the overlap, and outputs in the overlap are discarded, so a segment's
+  // outputs match those of a sequential run as long as the state of these
+  // calculators depends on no more than `overlap_us` of past input.
+  int64_t overlap_us = 0;
+
+  // The int64 input side packets through which each graph instance receives
+  // the time range it must process, in microseconds. The graph is expected to
+  // read its input from that range only, e.g. by connecting them to the
+  // START_TIME_US and END_TIME_US side packets of OpenCvVideoDecoderCalculator.
+  std::string start_side_packet = "segment_start_us";
+  std::string end_side_packet = "segment_end_us";
+
+  // The output streams to collect.
+  std::vector<std::string> output_streams;
+};
+
+// Runs one instance of the graph described by `config` on each segment of
+// `options`, in parallel, and returns the packets of each output stream merged
+// in timestamp order. Packets a graph instance outputs outside of its segment
+// are dropped, except for PreStream packets of the first segment and
+// PostStream packets of the last.
+//
+// Meant for offline processing of long inputs such as videos, whose wall-clock
+// time then scales with the number of cores rather than with the input
+// duration.
+//
+// `side_packets` are passed to every graph instance in addition to the
+// segment range side packets.
+absl::StatusOr<std::map<std::string, std::vector<Packet>>> RunGraphInSegments(
+    const CalculatorGraphConfig& config,
+    const std::map<std::string, Packet>& side_packets,
+    const SegmentedRunOptions& options);
+
+}  // namespace tool
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_TOOL_SEGMENTED_GRAPH_RUNNER_H_
@@ -0,0 +1,153 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/framework/tool/segmented_graph_runner.h"
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace tool {
+namespace {
+
+constexpr int64_t kStepUs = 10000;
+constexpr int kWindowSize = 3;
+
+// Outputs a packet every kStepUs in [START_US, END_US), whose value is the sum
+// of the timestamps of the last kWindowSize packets. Stands in for a decoder
+// followed by a stateful calculator such as a smoother.
+class WindowedSumSourceCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->InputSidePackets().Tag("START_US").Set<int64_t>();
+    cc->InputSidePackets().Tag("END_US").Set<int64_t>();
+    cc->Outputs().Index(0).Set<int64_t>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Open(CalculatorContext* cc) override {
+    const int64_t start_us =
+        cc->InputSidePackets().Tag("START_US").Get<int64_t>();
+    next_us_ = (start_us + kStepUs - 1) / kStepUs * kStepUs;
+    end_us_ = cc->InputSidePackets().Tag("END_US").Get<int64_t>();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (next_us_ >= end_us_) {
+      return tool::StatusStop();
+    }
+    window_.push_back(next_us_);
+    if (window_.size() > kWindowSize) window_.pop_front();
+    int64_t sum = 0;
+    for (int64_t value : window_) sum += value;
+    cc->Outputs().Index(0).AddPacket(
+        MakePacket<int64_t>(sum).At(Timestamp(next_us_)));
+    next_us_ += kStepUs;
+    return absl::OkStatus();
+  }
+
+ private:
+  int64_t next_us_ = 0;
+  int64_t end_us_ = 0;
+  std::deque<int64_t> window_;
+};
+REGISTER_CALCULATOR(WindowedSumSourceCalculator);
+
+CalculatorGraphConfig GetGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_side_packet: "segment_start_us"
+    input_side_packet: "segment_end_us"
+    output_stream: "sums"
+    node {
+      calculator: "WindowedSumSourceCalculator"
+      input_side_packet: "START_US:segment_start_us"
+      input_side_packet: "END_US:segment_end_us"
+      output_stream: "sums"
+    }
+  )pb");
+}
+
+std::vector<std::pair<int64_t, int64_t>> GetTimestampsAndValues(
+    const std::vector<Packet>& packets) {
+  std::vector<std::pair<int64_t, int64_t>> result;
+  for (const Packet& packet : packets) {
+    result.emplace_back(packet.Timestamp().Value(), packet.Get<int64_t>());
+  }
+  return result;
+}
+
+SegmentedRunOptions GetOptions(int num_segments, int64_t overlap_us) {
+  SegmentedRunOptions options;
+  options.start_us = 0;
+  options.end_us = 1000000;
+  options.num_segments = num_segments;
+  options.max_parallel_graphs = 2;
+  options.overlap_us = overlap_us;
+  options.output_streams = {"sums"};
+  return options;
+}
+
+TEST(SegmentedGraphRunnerTest, MatchesSequentialRunWithEnoughOverlap) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto sequential,
+      RunGraphInSegments(GetGraphConfig(), {}, GetOptions(1, 0)));
+  ASSERT_EQ(sequential["sums"].size(), 100);
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto segmented,
+      RunGraphInSegments(GetGraphConfig(), {},
+                         GetOptions(4, (kWindowSize - 1) * kStepUs)));
+
+  EXPECT_EQ(GetTimestampsAndValues(segmented["sums"]),
+            GetTimestampsAndValues(sequential["sums"]));
+}
+
+TEST(SegmentedGraphRunnerTest, DiffersFromSequentialRunWithoutOverlap) {
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto sequential,
+      RunGraphInSegments(GetGraphConfig(), {}, GetOptions(1, 0)));
+
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto segmented,
+      RunGraphInSegments(GetGraphConfig(), {}, GetOptions(4, 0)));
+
+  // Every segment outputs the same timestamps, but the windowed sums restart
+  // at the segment boundaries.
+  ASSERT_EQ(segmented["sums"].size(), sequential["sums"].size());
+  EXPECT_NE(GetTimestampsAndValues(segmented["sums"]),
+            GetTimestampsAndValues(sequential["sums"]));
+}
+
+TEST(SegmentedGraphRunnerTest, FailsWithEmptyRange) {
+  SegmentedRunOptions options = GetOptions(4, 0);
+  options.end_us = options.start_us;
+
+  EXPECT_FALSE(RunGraphInSegments(GetGraphConfig(), {}, options).ok());
+}
+
+}  // namespace
+}  // namespace tool
+}  // namespace mediapipe
@@ -23,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
 #include "mediapipe/framework/graph_service_manager.h"
@@ -98,10 +99,7 @@ absl::Status TransformNames(
         config->mutable_output_side_packet()}) {
     MP_RETURN_IF_ERROR(TransformStreamNames(streams, transform));
   }
-  std::vector<std::string> node_names(config->node_size());
-  for (int node_id = 0; node_id < config->node_size(); ++node_id) {
-    node_names[node_id] = CanonicalNodeName(*config, node_id);
-  }
+  std::vector<std::string> node_names = CanonicalNodeNames(*config);
   for (int node_id = 0; node_id < config->node_size(); ++node_id) {
     config->mutable_node(node_id)->set_name(transform(node_names[node_id]));
   }
@@ -181,10 +179,8 @@ absl::Status FindCorrespondingStreams(
 
 // The following fields can be used in a Node message for a subgraph:
 //   name, calculator, input_stream, output_stream, input_side_packet,
-//   output_side_packet, options.
+//   output_side_packet, options, executor.
 // All other fields are only applicable to calculators.
-// TODO: Check whether executor is not set in the subgraph node
-// after this issues is properly solved.
 absl::Status ValidateSubgraphFields(
     const CalculatorGraphConfig::Node& subgraph_node) {
   if (subgraph_node.source_layer() || subgraph_node.buffer_size_hint() ||
@@ -197,6 +193,20 @@ absl::Status ValidateSubgraphFields(
   return absl::OkStatus();
 }
 
+// Runs the nodes of a subgraph that do not specify an executor on the executor
+// of the subgraph node, if any. Executors are looked up by name in the final
+// graph config, so the executor still has to be declared there.
+static void InheritSubgraphExecutor(
+    const CalculatorGraphConfig::Node& subgraph_node,
+    CalculatorGraphConfig* subgraph_config) {
+  if (subgraph_node.executor().empty()) return;
+  for (auto& node : *subgraph_config->mutable_node()) {
+    if (node.executor().empty()) {
+      node.set_executor(subgraph_node.executor());
+    }
+  }
+}
+
 absl::Status ConnectSubgraphStreams(
     const CalculatorGraphConfig::Node& subgraph_node,
     CalculatorGraphConfig* subgraph_config) {
@@ -273,6 +283,28 @@ absl::Status ConnectSubgraphStreams(
   return absl::OkStatus();
 }
 
+namespace {
+
+// Appends a length-prefixed field to a cache key.
+void AppendKeyField(absl::string_view field, std::string* key) {
+  absl::StrAppend(key, field.size(), ":", field);
+}
+
+// Returns a key identifying the subgraph type and options of a subgraph node.
+std::string SubgraphCacheKey(const CalculatorGraphConfig::Node& node) {
+  std::string key;
+  AppendKeyField(node.calculator(), &key);
+  AppendKeyField(node.has_options() ? node.options().SerializeAsString() : "",
+                 &key);
+  for (const auto& options : node.node_options()) {
+    AppendKeyField(options.type_url(), &key);
+    AppendKeyField(options.value(), &key);
+  }
+  return key;
+}
+
+}  // namespace
+
 absl::Status ExpandSubgraphs(CalculatorGraphConfig* config,
                              const GraphRegistry* graph_registry,
                              const Subgraph::SubgraphOptions* graph_options,
@@ -283,6 +315,10 @@ absl::Status ExpandSubgraphs(CalculatorGraphConfig* config,
 
   MP_RETURN_IF_ERROR(mediapipe::tool::DefineGraphOptions(
       graph_options ? *graph_options : CalculatorGraphConfig::Node(), config));
+  // Subgraph configs that depend only on the node options, keyed by
+  // SubgraphCacheKey. Large generated graphs instantiate the same subgraph
+  // with the same options many times.
+  absl::flat_hash_map<std::string, CalculatorGraphConfig> subgraph_cache;
   auto* nodes = config->mutable_node();
   while (1) {
     auto subgraph_nodes_start = std::stable_partition(
@@ -293,20 +329,33 @@ absl::Status ExpandSubgraphs(CalculatorGraphConfig* config,
         });
     if (subgraph_nodes_start == nodes->end()) break;
     std::vector<CalculatorGraphConfig> subgraphs;
+    const std::vector<std::string> node_names = CanonicalNodeNames(*config);
     for (auto it = subgraph_nodes_start; it != nodes->end(); ++it) {
       auto& node = *it;
       int node_id = it - nodes->begin();
-      std::string node_name = CanonicalNodeName(*config, node_id);
+      const std::string& node_name = node_names[node_id];
       MP_RETURN_IF_ERROR(ValidateSubgraphFields(node));
-      SubgraphContext subgraph_context(&node, service_manager);
-      MP_ASSIGN_OR_RETURN(
-          auto subgraph,
-          graph_registry->CreateByName(config->package(), node.calculator(),
-                                       &subgraph_context));
+      const std::string cache_key = SubgraphCacheKey(node);
+      CalculatorGraphConfig subgraph;
+      auto cached = subgraph_cache.find(cache_key);
+      if (cached != subgraph_cache.end()) {
+        subgraph = cached->second;
+      } else {
+        SubgraphContext subgraph_context(&node, service_manager);
+        bool depends_only_on_options = false;
+        MP_ASSIGN_OR_RETURN(
+            subgraph, graph_registry->CreateByName(
+                          config->package(), node.calculator(),
+                          &subgraph_context, &depends_only_on_options));
+        if (depends_only_on_options) {
+          subgraph_cache.emplace(cache_key, subgraph);
+        }
+      }
       MP_RETURN_IF_ERROR(mediapipe::tool::DefineGraphOptions(node, &subgraph));
       MP_RETURN_IF_ERROR(PrefixNames(node_name, &subgraph));
       MP_RETURN_IF_ERROR(ConnectSubgraphStreams(node, &subgraph));
-      subgraphs.push_back(subgraph);
+      InheritSubgraphExecutor(node, &subgraph);
+      subgraphs.push_back(std::move(subgraph));
     }
     nodes->erase(subgraph_nodes_start, nodes->end());
     for (const auto& subgraph : subgraphs) {
@@ -325,6 +374,78 @@ absl::Status ExpandSubgraphs(CalculatorGraphConfig* config,
   return absl::OkStatus();
 }
 
+namespace {
+
+// Returns true if the node only forwards one stream and has no configuration
+// that could make removing it observable to its consumers.
+bool IsElidablePassThrough(const CalculatorGraphConfig::Node& node) {
+  return node.calculator() == "PassThroughCalculator" &&
+         node.input_stream_size() == 1 && node.output_stream_size() == 1 &&
+         node.input_side_packet_size() == 0 &&
+         node.output_side_packet_size() == 0 &&
+         !node.has_input_stream_handler() &&
+         !node.has_output_stream_handler() &&
+         node.input_stream_info_size() == 0 && node.executor().empty() &&
+         node.max_in_flight() == 0;
+}
+
+}  // namespace
+
+absl::Status ElidePassThroughNodes(CalculatorGraphConfig* config,
+                                   std::vector<std::string>* elided_nodes) {
+  std::set<std::string> graph_outputs;
+  for (const auto& stream : config->output_stream()) {
+    graph_outputs.insert(ParseNameFromStream(stream));
+  }
+
+  // Maps each removed output stream to the stream it forwards.
+  std::map<std::string, std::string> forwarded;
+  std::vector<bool> elided(config->node_size(), false);
+  std::vector<std::string> node_names;
+  if (elided_nodes) {
+    node_names = CanonicalNodeNames(*config);
+  }
+  for (int i = 0; i < config->node_size(); ++i) {
+    const auto& node = config->node(i);
+    if (!IsElidablePassThrough(node)) continue;
+    std::string out = ParseNameFromStream(node.output_stream(0));
+    if (graph_outputs.count(out) > 0) continue;
+    forwarded[out] = ParseNameFromStream(node.input_stream(0));
+    elided[i] = true;
+    if (elided_nodes) {
+      elided_nodes->push_back(node_names[i]);
+    }
+  }
+  if (forwarded.empty()) return absl::OkStatus();
+
+  // Resolves chains of pass-throughs to the first non-elided stream.
+  auto resolve = [&forwarded](absl::string_view name) {
+    std::string result(name);
+    for (size_t hops = 0; hops <= forwarded.size(); ++hops) {
+      auto it = forwarded.find(result);
+      if (it == forwarded.end()) return result;
+      result = it->second;
+    }
+    return result;
+  };
+  for (const auto& [out, in] : forwarded) {
+    RET_CHECK(forwarded.count(resolve(out)) == 0)
+        << "Cycle of PassThroughCalculator nodes through stream \"" << out
+        << "\".";
+  }
+
+  proto_ns::RepeatedPtrField<CalculatorGraphConfig::Node> kept_nodes;
+  for (int i = 0; i < config->node_size(); ++i) {
+    auto* node = config->mutable_node(i);
+    if (elided[i]) continue;
+    MP_RETURN_IF_ERROR(
+        TransformStreamNames(node->mutable_input_stream(), resolve));
+    *kept_nodes.Add() = std::move(*node);
+  }
+  config->mutable_node()->Swap(&kept_nodes);
+  return absl::OkStatus();
+}
+
 CalculatorGraphConfig MakeSingleNodeGraph(CalculatorGraphConfig::Node node) {
   using RepeatedStringField = proto_ns::RepeatedPtrField<ProtoString>;
   struct Connections {
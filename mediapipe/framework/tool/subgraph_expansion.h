@@ -75,6 +75,15 @@ absl::Status ExpandSubgraphs(
     const Subgraph::SubgraphOptions* graph_options = nullptr,
     const GraphServiceManager* service_manager = nullptr);
 
+// Removes single-stream PassThroughCalculator nodes from the given config by
+// connecting their consumers directly to the pass-through's input stream.
+// Nodes that customize stream handling (stream handlers, input stream info,
+// executors) or whose output is a graph output stream are kept. The names of
+// the removed nodes are appended to |elided_nodes| if it is not null.
+// Removed output streams can no longer be observed by name.
+absl::Status ElidePassThroughNodes(CalculatorGraphConfig* config,
+                                   std::vector<std::string>* elided_nodes);
+
 // Creates a graph wrapping the provided node and exposing all of its
 // connections
 CalculatorGraphConfig MakeSingleNodeGraph(
@@ -462,6 +462,101 @@ TEST(SubgraphExpansionTest, ExpandSubgraphs) {
   EXPECT_THAT(supergraph, mediapipe::EqualsProto(expected_graph));
 }
 
+// A NodeChainSubgraph that declares its config depends only on its options,
+// and counts the configs it creates.
+class CountingNodeChainSubgraph : public NodeChainSubgraph {
+ public:
+  explicit CountingNodeChainSubgraph(int* num_configs)
+      : num_configs_(num_configs) {}
+
+  absl::StatusOr<CalculatorGraphConfig> GetConfig(
+      const SubgraphOptions& options) override {
+    ++*num_configs_;
+    return NodeChainSubgraph::GetConfig(options);
+  }
+
+  bool ConfigDependsOnlyOnOptions() const override { return true; }
+
+ private:
+  int* num_configs_;
+};
+
+TEST(SubgraphExpansionTest, ReusesConfigsForIdenticalOptions) {
+  int num_configs = 0;
+  GraphRegistry graph_registry;
+  graph_registry.Register("CountingNodeChainSubgraph", [&num_configs] {
+    return std::make_unique<CountingNodeChainSubgraph>(&num_configs);
+  });
+  CalculatorGraphConfig supergraph =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        node {
+          calculator: "CountingNodeChainSubgraph"
+          input_stream: "INPUT:in"
+          output_stream: "OUTPUT:a"
+          options: {
+            [mediapipe.NodeChainSubgraphOptions.ext] {
+              node_type: "SomeRegularCalculator"
+              chain_length: 1
+            }
+          }
+        }
+        node {
+          calculator: "CountingNodeChainSubgraph"
+          input_stream: "INPUT:a"
+          output_stream: "OUTPUT:b"
+          options: {
+            [mediapipe.NodeChainSubgraphOptions.ext] {
+              node_type: "SomeRegularCalculator"
+              chain_length: 2
+            }
+          }
+        }
+        node {
+          calculator: "CountingNodeChainSubgraph"
+          input_stream: "INPUT:b"
+          output_stream: "OUTPUT:c"
+          options: {
+            [mediapipe.NodeChainSubgraphOptions.ext] {
+              node_type: "SomeRegularCalculator"
+              chain_length: 1
+            }
+          }
+        }
+      )pb");
+  CalculatorGraphConfig expected_graph =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "in"
+        node {
+          name: "countingnodechainsubgraph_1__SomeRegularCalculator"
+          calculator: "SomeRegularCalculator"
+          input_stream: "in"
+          output_stream: "a"
+        }
+        node {
+          name: "countingnodechainsubgraph_2__SomeRegularCalculator_1"
+          calculator: "SomeRegularCalculator"
+          input_stream: "a"
+          output_stream: "countingnodechainsubgraph_2__stream_1"
+        }
+        node {
+          name: "countingnodechainsubgraph_2__SomeRegularCalculator_2"
+          calculator: "SomeRegularCalculator"
+          input_stream: "countingnodechainsubgraph_2__stream_1"
+          output_stream: "b"
+        }
+        node {
+          name: "countingnodechainsubgraph_3__SomeRegularCalculator"
+          calculator: "SomeRegularCalculator"
+          input_stream: "b"
+          output_stream: "c"
+        }
+      )pb");
+  MP_ASSERT_OK(tool::ExpandSubgraphs(&supergraph, &graph_registry));
+  EXPECT_THAT(supergraph, mediapipe::EqualsProto(expected_graph));
+  EXPECT_EQ(num_configs, 2);
+}
+
 TEST(SubgraphExpansionTest, ValidateSubgraphFields) {
   CalculatorGraphConfig supergraph =
       mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
@@ -529,6 +624,140 @@ TEST(SubgraphExpansionTest, ExecutorFieldOfNodeInSubgraphPreserved) {
   EXPECT_THAT(supergraph, mediapipe::EqualsProto(expected_graph));
 }
 
+// A subgraph used in the SubgraphNodeExecutorIsInherited test. The subgraph
+// contains a node without an executor and a NodeWithExecutorSubgraph.
+class MixedExecutorSubgraph : public Subgraph {
+ public:
+  absl::StatusOr<CalculatorGraphConfig> GetConfig(
+      const SubgraphOptions& options) override {
+    CalculatorGraphConfig config =
+        mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+          input_stream: "IN:foo"
+          output_stream: "OUT:bar"
+          node {
+            calculator: "PassThroughCalculator"
+            input_stream: "foo"
+            output_stream: "baz"
+          }
+          node {
+            calculator: "NodeWithExecutorSubgraph"
+            input_stream: "INPUT:baz"
+            output_stream: "OUTPUT:bar"
+          }
+        )pb");
+    return config;
+  }
+};
+REGISTER_MEDIAPIPE_GRAPH(MixedExecutorSubgraph);
+
+TEST(SubgraphExpansionTest, SubgraphNodeExecutorIsInherited) {
+  CalculatorGraphConfig supergraph =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        executor {
+          name: "custom_thread_pool"
+          type: "ThreadPoolExecutor"
+          options {
+            [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 4 }
+          }
+        }
+        executor {
+          name: "branch"
+          type: "ThreadPoolExecutor"
+          options {
+            [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 1 }
+          }
+        }
+        node {
+          calculator: "MixedExecutorSubgraph"
+          input_stream: "IN:input"
+          output_stream: "OUT:output"
+          executor: "branch"
+        }
+      )pb");
+  CalculatorGraphConfig expected_graph = mediapipe::ParseTextProtoOrDie<
+      CalculatorGraphConfig>(R"pb(
+    input_stream: "input"
+    executor {
+      name: "custom_thread_pool"
+      type: "ThreadPoolExecutor"
+      options {
+        [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 4 }
+      }
+    }
+    executor {
+      name: "branch"
+      type: "ThreadPoolExecutor"
+      options {
+        [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 1 }
+      }
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      name: "mixedexecutorsubgraph__PassThroughCalculator"
+      input_stream: "input"
+      output_stream: "mixedexecutorsubgraph__baz"
+      executor: "branch"
+    }
+    node {
+      calculator: "PassThroughCalculator"
+      name: "mixedexecutorsubgraph__nodewithexecutorsubgraph__PassThroughCalculator"
+      input_stream: "mixedexecutorsubgraph__baz"
+      output_stream: "output"
+      executor: "custom_thread_pool"
+    }
+  )pb");
+  MP_EXPECT_OK(tool::ExpandSubgraphs(&supergraph));
+  EXPECT_THAT(supergraph, mediapipe::EqualsProto(expected_graph));
+
+  CalculatorGraph calculator_graph;
+  MP_EXPECT_OK(calculator_graph.Initialize(supergraph));
+}
+
+// A subgraph used in the SubgraphNodeMaxInFlightIsNotInherited test. The first
+// node sets its own max_in_flight, the second one does not.
+class MaxInFlightSubgraph : public Subgraph {
+ public:
+  absl::StatusOr<CalculatorGraphConfig> GetConfig(
+      const SubgraphOptions& options) override {
+    return mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+      input_stream: "IN:foo"
+      output_stream: "OUT:bar"
+      node {
+        calculator: "PassThroughCalculator"
+        input_stream: "foo"
+        output_stream: "baz"
+        max_in_flight: 1
+      }
+      node {
+        calculator: "PassThroughCalculator"
+        input_stream: "baz"
+        output_stream: "bar"
+      }
+    )pb");
+  }
+};
+REGISTER_MEDIAPIPE_GRAPH(MaxInFlightSubgraph);
+
+// Only the inner nodes know whether they keep state across timestamps, so each
+// one has to opt into running concurrently itself.
+TEST(SubgraphExpansionTest, SubgraphNodeMaxInFlightIsNotInherited) {
+  CalculatorGraphConfig supergraph =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        node {
+          calculator: "MaxInFlightSubgraph"
+          input_stream: "IN:input"
+          output_stream: "OUT:output"
+          max_in_flight: 4
+        }
+      )pb");
+  MP_ASSERT_OK(tool::ExpandSubgraphs(&supergraph));
+  ASSERT_EQ(supergraph.node_size(), 2);
+  EXPECT_EQ(supergraph.node(0).max_in_flight(), 1);
+  EXPECT_EQ(supergraph.node(1).max_in_flight(), 0);
+}
+
 const mediapipe::GraphService<std::string> kStringTestService{
     "mediapipe::StringTestService"};
 class GraphServicesClientTestSubgraph : public Subgraph {
@@ -962,5 +1191,70 @@ TEST(SubgraphExpansionTest, GraphExecutorsSubstituteSubgraphExecutors) {
   MP_EXPECT_OK(calculator_graph.Initialize(supergraph));
 }
 
+TEST(SubgraphExpansionTest, ElidePassThroughNodes) {
+  CalculatorGraphConfig config =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        output_stream: "output"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "input"
+          output_stream: "a"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "a"
+          output_stream: "b"
+        }
+        node {
+          calculator: "SomeCalculator"
+          input_stream: "IN:b"
+          input_stream: "SYNC:a"
+          output_stream: "c"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "c"
+          input_stream: "input"
+          output_stream: "d"
+          output_stream: "e"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "d"
+          output_stream: "output"
+        }
+      )pb");
+  CalculatorGraphConfig expected_graph =
+      mediapipe::ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+        input_stream: "input"
+        output_stream: "output"
+        node {
+          calculator: "SomeCalculator"
+          input_stream: "IN:input"
+          input_stream: "SYNC:input"
+          output_stream: "c"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "c"
+          input_stream: "input"
+          output_stream: "d"
+          output_stream: "e"
+        }
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "d"
+          output_stream: "output"
+        }
+      )pb");
+  std::vector<std::string> elided_nodes;
+  MP_EXPECT_OK(tool::ElidePassThroughNodes(&config, &elided_nodes));
+  EXPECT_THAT(config, mediapipe::EqualsProto(expected_graph));
+  EXPECT_THAT(elided_nodes,
+              testing::ElementsAre("PassThroughCalculator_1",
+                                   "PassThroughCalculator_2"));
+}
+
 }  // namespace
 }  // namespace mediapipe
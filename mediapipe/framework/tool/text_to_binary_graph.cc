@@ -13,6 +13,10 @@
 // limitations under the License.
 //
 // A command line utility to parse a text proto and output a binary proto.
+//
+// With --expand_subgraphs, subgraph nodes are replaced by the registered
+// subgraphs linked into this binary before the graph is written, so that
+// loading the graph at runtime does not need to expand them again.
 
 #include <stdlib.h>
 
@@ -28,12 +32,17 @@
 #include "mediapipe/framework/port/logging.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/framework/tool/subgraph_expansion.h"
 
 ABSL_FLAG(std::string, proto_source, "",
           "The template source file containing CalculatorGraphConfig "
           "protobuf text with inline template params.");
 ABSL_FLAG(std::string, proto_output, "",
           "An output template file in binary CalculatorGraphTemplate form.");
+ABSL_FLAG(bool, expand_subgraphs, false,
+          "If true, subgraph nodes are expanded using the subgraphs registered "
+          "in this binary before the graph is written. The output graph then "
+          "reflects the default graph options only.");
 
 #define EXIT_IF_ERROR(status)  \
   if (!status.ok()) {          \
@@ -112,6 +121,9 @@ int main(int argc, char** argv) {
   mediapipe::CalculatorGraphConfig config;
   EXIT_IF_ERROR(
       mediapipe::ReadFile(absl::GetFlag(FLAGS_proto_source), true, &config));
+  if (absl::GetFlag(FLAGS_expand_subgraphs)) {
+    EXIT_IF_ERROR(mediapipe::tool::ExpandSubgraphs(&config));
+  }
   EXIT_IF_ERROR(
       mediapipe::WriteFile(absl::GetFlag(FLAGS_proto_output), false, config));
   return EXIT_SUCCESS;
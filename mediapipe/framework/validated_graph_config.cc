@@ -15,7 +15,9 @@
 #include "mediapipe/framework/validated_graph_config.h"
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_check.h"
@@ -24,6 +26,7 @@
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_base.h"
 #include "mediapipe/framework/graph_service_manager.h"
@@ -47,6 +50,7 @@
 #include "mediapipe/framework/tool/name_util.h"
 #include "mediapipe/framework/tool/status_util.h"
 #include "mediapipe/framework/tool/subgraph_expansion.h"
+#include "mediapipe/framework/tool/type_util.h"
 #include "mediapipe/framework/tool/validate.h"
 #include "mediapipe/framework/tool/validate_name.h"
 
@@ -145,6 +149,83 @@ absl::Status AddPredefinedExecutorConfigs(CalculatorGraphConfig* graph_config) {
   return absl::OkStatus();
 }
 
+// Upper bound on the number of contracts kept by ContractCache.  The cache is
+// flushed when it fills up, which only happens for processes that keep
+// creating graphs with distinct node configs.
+constexpr int kMaxCachedContracts = 4096;
+
+// A validated calculator contract, together with the node config it refers
+// to and the calculator class that produced it.
+struct CachedContract {
+  explicit CachedContract(TypeId calculator_type)
+      : calculator_type(calculator_type) {}
+
+  TypeId calculator_type;
+  CalculatorGraphConfig::Node node;
+  CalculatorContract contract;
+};
+
+// Process-wide cache of validated calculator contracts, used by graphs that
+// set cache_calculator_contracts.  Re-creating such a graph with the same node
+// configs copies the contracts from here instead of running GetContract and
+// resolving the packet types again.
+class ContractCache {
+ public:
+  static ContractCache& Get() {
+    static ContractCache* cache = new ContractCache();
+    return *cache;
+  }
+
+  // Builds the cache key for a calculator node.  The canonical node name is
+  // part of the key because it is visible to GetContract.  The calculator
+  // class is part of it so that a name registered again for another class
+  // does not get the old contract.
+  static std::string Key(const std::string& package,
+                         const std::string& node_name, TypeId calculator_type,
+                         const CalculatorGraphConfig::Node& node) {
+    return absl::StrCat(package.size(), ":", package, node_name.size(), ":",
+                        node_name, calculator_type.hash_code(), ":",
+                        node.SerializeAsString());
+  }
+
+  std::shared_ptr<const CachedContract> Find(const std::string& key,
+                                             TypeId calculator_type) {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() ||
+        !(it->second->calculator_type == calculator_type)) {
+      return nullptr;
+    }
+    return it->second;
+  }
+
+  void Clear() {
+    absl::MutexLock lock(&mutex_);
+    entries_.clear();
+  }
+
+  void Insert(std::string key, TypeId calculator_type,
+              const CalculatorGraphConfig::Node& node,
+              const CalculatorContract& contract) {
+    auto entry = std::make_shared<CachedContract>(calculator_type);
+    entry->node = node;
+    if (!entry->contract.Initialize(entry->node).ok() ||
+        !entry->contract.CopyExpectationsFrom(contract)) {
+      return;
+    }
+    absl::MutexLock lock(&mutex_);
+    if (entries_.size() >= kMaxCachedContracts) {
+      entries_.clear();
+    }
+    entries_.emplace(std::move(key), std::move(entry));
+  }
+
+ private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::shared_ptr<const CachedContract>>
+      entries_ ABSL_GUARDED_BY(mutex_);
+};
+
 }  // namespace
 
 // static
@@ -167,12 +248,12 @@ std::string NodeTypeInfo::NodeTypeToString(NodeType node_type) {
 
 absl::Status NodeTypeInfo::Initialize(
     const ValidatedGraphConfig& validated_graph,
-    const CalculatorGraphConfig::Node& node, int node_index) {
+    const CalculatorGraphConfig::Node& node, int node_index,
+    std::string node_name) {
   node_.type = NodeType::CALCULATOR;
   node_.index = node_index;
   MP_RETURN_IF_ERROR(contract_.Initialize(node));
-  contract_.SetNodeName(
-      CanonicalNodeName(validated_graph.Config(), node_index));
+  contract_.SetNodeName(std::move(node_name));
 
   // Ensure input_stream_info field is well formed.
   if (!node.input_stream_info().empty()) {
@@ -212,6 +293,7 @@ absl::Status NodeTypeInfo::Initialize(
         << "' specified more than once for a single calculator node config.";
   }
 #endif
+
   LegacyCalculatorSupport::Scoped<CalculatorContract> s(&contract_);
   // A number of calculators use the non-CC methods on GlCalculatorHelper
   // even though they are CalculatorBase-based.
@@ -220,6 +302,27 @@ absl::Status NodeTypeInfo::Initialize(
       CalculatorBaseRegistry::CreateByNameInNamespace(validated_graph.Package(),
                                                       node_class),
       _ << "Unable to find Calculator \"" << node_class << "\"");
+
+  // Contracts are only cached for factories that identify their calculator
+  // class.
+  const std::optional<TypeId> calculator_type =
+      validated_graph.Config().cache_calculator_contracts()
+          ? calculator_factory->CalculatorType()
+          : std::nullopt;
+  std::string cache_key;
+  if (calculator_type.has_value()) {
+    cache_key = ContractCache::Key(validated_graph.Package(),
+                                   contract_.GetNodeName(), *calculator_type,
+                                   node);
+    if (auto cached = ContractCache::Get().Find(cache_key, *calculator_type)) {
+      if (contract_.CopyExpectationsFrom(cached->contract)) {
+        return absl::OkStatus();
+      }
+      // Run GetContract on a fresh contract if the cached one can't be
+      // copied.
+      MP_RETURN_IF_ERROR(contract_.Initialize(node));
+    }
+  }
   MP_RETURN_IF_ERROR(calculator_factory->GetContract(&contract_)).SetPrepend()
       << node_class << ": ";
 
@@ -249,6 +352,10 @@ absl::Status NodeTypeInfo::Initialize(
                      " failed to validate: "),
         statuses);
   }
+  if (calculator_type.has_value()) {
+    ContractCache::Get().Insert(std::move(cache_key), *calculator_type, node,
+                                contract_);
+  }
   return absl::OkStatus();
 }
 
@@ -402,6 +509,7 @@ absl::Status ValidatedGraphConfig::Initialize(
 
   MP_RETURN_IF_ERROR(ComputeSourceDependence());
 
+  MP_RETURN_IF_ERROR(ResolveColocatedExecutors());
   MP_RETURN_IF_ERROR(ValidateExecutors());
 
 #if !defined(MEDIAPIPE_MOBILE)
@@ -471,18 +579,31 @@ absl::Status ValidatedGraphConfig::PerformBasicTransforms(
     }
   }
 
+  // Runs after the graph-level input stream handler is applied, so that nodes
+  // inheriting a custom handler are not elided.
+  if (config_.elide_pass_through_nodes()) {
+    std::vector<std::string> elided_nodes;
+    MP_RETURN_IF_ERROR(tool::ElidePassThroughNodes(&config_, &elided_nodes));
+    if (!elided_nodes.empty()) {
+      VLOG(1) << "Elided " << elided_nodes.size()
+              << " pass-through nodes: " << absl::StrJoin(elided_nodes, ", ");
+    }
+  }
+
   return absl::OkStatus();
 }
 
 absl::Status ValidatedGraphConfig::InitializeCalculatorInfo() {
+  std::vector<std::string> node_names = tool::CanonicalNodeNames(config_);
   std::vector<absl::Status> statuses;
   calculators_.reserve(config_.node_size());
   for (const auto& node : config_.node()) {
+    const int node_index = calculators_.size();
     calculators_.emplace_back();
-    absl::Status status =
-        calculators_.back().Initialize(*this, node, calculators_.size() - 1);
+    absl::Status status = calculators_.back().Initialize(
+        *this, node, node_index, std::move(node_names[node_index]));
     if (!status.ok()) {
-      statuses.push_back(status);
+      statuses.push_back(std::move(status));
     }
   }
   return tool::CombinedStatus("ValidatedGraphConfig Initialization failed.",
@@ -974,6 +1095,38 @@ absl::Status ValidatedGraphConfig::ValidateStreamTypes() {
   return absl::OkStatus();
 }
 
+absl::Status ValidatedGraphConfig::ResolveColocatedExecutors() {
+  // Producers precede their consumers, so a chain of colocated nodes is
+  // resolved in one pass.
+  for (int node_index = 0; node_index < calculators_.size(); ++node_index) {
+    CalculatorGraphConfig::Node* node_config = config_.mutable_node(node_index);
+    if (!node_config->colocate_with_producer() ||
+        !node_config->executor().empty()) {
+      continue;
+    }
+    const NodeTypeInfo& node_type_info = calculators_[node_index];
+    for (int stream_index = node_type_info.InputStreamBaseIndex();
+         stream_index < node_type_info.InputStreamBaseIndex() +
+                            node_type_info.InputStreamTypes().NumEntries();
+         ++stream_index) {
+      const EdgeInfo& input_edge_info = input_streams_[stream_index];
+      if (input_edge_info.back_edge) {
+        continue;
+      }
+      RET_CHECK_LE(0, input_edge_info.upstream)
+          << "input stream \"" << input_edge_info.name
+          << "\" is not connected to an output stream.";
+      const NodeTypeInfo::NodeRef& producer =
+          output_streams_[input_edge_info.upstream].parent_node;
+      if (producer.type == NodeTypeInfo::NodeType::CALCULATOR) {
+        node_config->set_executor(config_.node(producer.index).executor());
+      }
+      break;
+    }
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ValidatedGraphConfig::ValidateExecutors() {
   absl::flat_hash_set<ProtoString> declared_names;
   for (const ExecutorConfig& executor_config : config_.executor()) {
@@ -1019,6 +1172,11 @@ bool ValidatedGraphConfig::IsReservedExecutorName(const std::string& name) {
   return name == "default" || name == "gpu" || absl::StartsWith(name, "__");
 }
 
+// static
+void ValidatedGraphConfig::ClearContractCache() {
+  ContractCache::Get().Clear();
+}
+
 absl::Status ValidatedGraphConfig::ValidateRequiredSidePackets(
     const std::map<std::string, Packet>& side_packets) const {
   std::vector<absl::Status> statuses;
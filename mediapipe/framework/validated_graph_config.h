@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "google/protobuf/repeated_ptr_field.h"
 #include "mediapipe/framework/calculator.pb.h"
@@ -74,10 +75,11 @@ class NodeTypeInfo {
   NodeTypeInfo(NodeTypeInfo&& other) = default;
 
   // node_index is the index of this node among the nodes of the same type
-  // in the validated graph config.
+  // in the validated graph config. node_name is the canonical name of a
+  // calculator node.
   absl::Status Initialize(const ValidatedGraphConfig& validated_graph,
                           const CalculatorGraphConfig::Node& node,
-                          int node_index);
+                          int node_index, std::string node_name);
   absl::Status Initialize(const ValidatedGraphConfig& validated_graph,
                           const PacketGeneratorConfig& node, int node_index);
   absl::Status Initialize(const ValidatedGraphConfig& validated_graph,
@@ -313,6 +315,12 @@ class ValidatedGraphConfig {
   // Returns true if |name| is a reserved executor name.
   static bool IsReservedExecutorName(const std::string& name);
 
+  // Drops the calculator contracts cached across graph instances by graphs
+  // that set cache_calculator_contracts.  Graphs initialized afterwards run
+  // each calculator's GetContract again, e.g. after changing state that
+  // GetContract depends on.
+  static void ClearContractCache();
+
   // Returns true if a side packet is provided as an input to the graph.
   bool IsExternalSidePacket(const std::string& name) const {
     return required_side_packets_.count(name) > 0;
@@ -416,6 +424,10 @@ class ValidatedGraphConfig {
   // Returns an error if the graph of calculators does not have consistent
   // type specifications for streams.
   absl::Status ValidateStreamTypes();
+  // Assigns each node config that sets colocate_with_producer and no
+  // executor the executor of the node producing its first input stream.
+  // Must be called on topologically sorted nodes.
+  absl::Status ResolveColocatedExecutors();
   // Returns an error if the graph does not have valid ExecutorConfigs, or
   // if the executor name in a node config is reserved or is not declared
   // in an ExecutorConfig.
@@ -434,14 +446,14 @@ class ValidatedGraphConfig {
   std::vector<NodeTypeInfo*> sorted_nodes_;
 
   // Mapping from stream name to the output_streams_ index which produces it.
-  std::map<std::string, int> stream_to_producer_;
+  absl::flat_hash_map<std::string, int> stream_to_producer_;
 
   // Mapping from output streams to consumer node ids. Used for profiling.
-  std::map<int, std::vector<int>> output_streams_to_consumer_nodes_;
+  absl::flat_hash_map<int, std::vector<int>> output_streams_to_consumer_nodes_;
 
   // Mapping from side packet name to the output_side_packets_ index
   // which produces it.
-  std::map<std::string, int> side_packet_to_producer_;
+  absl::flat_hash_map<std::string, int> side_packet_to_producer_;
 
   // A structure to manage deletion of PacketType objects which need to
   // be owned by this object (used for graph input stream PacketType).
@@ -1,16 +1,21 @@
 #include "mediapipe/framework/validated_graph_config.h"
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/deps/registration.h"
 #include "mediapipe/framework/graph_service.h"
 #include "mediapipe/framework/graph_service_manager.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/status_matchers.h"
@@ -164,4 +169,159 @@ TEST(ValidatedGraphConfigTest, InitializeSubgraphWithServiceCalculatorB) {
   }
 }
 
+TEST(ValidatedGraphConfigTest, ColocateWithProducerInheritsExecutor) {
+  // The nodes are listed out of order to exercise the topological sort.
+  auto graph = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    executor { name: "numa0" }
+    node {
+      calculator: "CalculatorC"
+      input_stream: "NN:b"
+      output_stream: "NN:c"
+      colocate_with_producer: true
+    }
+    node {
+      calculator: "CalculatorB"
+      input_stream: "NN:a"
+      output_stream: "NN:b"
+      colocate_with_producer: true
+    }
+    node {
+      calculator: "CalculatorA"
+      input_stream: "NN:in"
+      output_stream: "NN:a"
+      executor: "numa0"
+    }
+    node {
+      calculator: "CalculatorA"
+      input_stream: "NN:in"
+      output_stream: "NN:d"
+      colocate_with_producer: true
+    }
+  )pb");
+
+  ValidatedGraphConfig config;
+  MP_ASSERT_OK(config.Initialize(graph));
+  ASSERT_EQ(config.Config().node_size(), 4);
+  for (const auto& node : config.Config().node()) {
+    if (node.output_stream(0) == "NN:d") {
+      // A graph input stream has no producer node.
+      EXPECT_EQ(node.executor(), "");
+    } else {
+      EXPECT_EQ(node.executor(), "numa0") << node.calculator();
+    }
+  }
+}
+
+// Counts GetContract calls and declares its output the same type as its
+// input.
+class CountingContractCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    ++num_contracts;
+    cc->Inputs().Index(0).SetAny();
+    cc->Outputs().Index(0).SetSameAs(&cc->Inputs().Index(0));
+    cc->SetTimestampOffset(0);
+    return absl::OkStatus();
+  }
+  absl::Status Process(CalculatorContext* cc) override {
+    return absl::OkStatus();
+  }
+  static int num_contracts;
+};
+int CountingContractCalculator::num_contracts = 0;
+REGISTER_CALCULATOR(CountingContractCalculator);
+
+TEST(ValidatedGraphConfigTest, ReusesContractsAcrossGraphs) {
+  auto graph = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    cache_calculator_contracts: true
+    input_stream: "in"
+    node {
+      calculator: "CountingContractCalculator"
+      input_stream: "in"
+      output_stream: "out"
+    }
+  )pb");
+  CountingContractCalculator::num_contracts = 0;
+  ValidatedGraphConfig first;
+  MP_ASSERT_OK(first.Initialize(graph));
+  ValidatedGraphConfig second;
+  MP_ASSERT_OK(second.Initialize(graph));
+  EXPECT_EQ(CountingContractCalculator::num_contracts, 1);
+
+  const CalculatorContract& contract = second.CalculatorInfos()[0].Contract();
+  EXPECT_EQ(contract.GetTimestampOffset(), TimestampDiff(0));
+  EXPECT_EQ(contract.Outputs().Index(0).GetSameAs(),
+            contract.Inputs().Index(0).GetSameAs());
+}
+
+TEST(ValidatedGraphConfigTest, DoesNotCacheContractsByDefault) {
+  auto graph = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    input_stream: "in"
+    node {
+      calculator: "CountingContractCalculator"
+      input_stream: "in"
+      output_stream: "out"
+    }
+  )pb");
+  CountingContractCalculator::num_contracts = 0;
+  ValidatedGraphConfig first;
+  MP_ASSERT_OK(first.Initialize(graph));
+  ValidatedGraphConfig second;
+  MP_ASSERT_OK(second.Initialize(graph));
+  EXPECT_EQ(CountingContractCalculator::num_contracts, 2);
+}
+
+// Outputs packets of type T.
+template <typename T>
+class TypedOutputCalculator : public CalculatorBase {
+ public:
+  static absl::Status GetContract(CalculatorContract* cc) {
+    cc->Inputs().Index(0).SetAny();
+    cc->Outputs().Index(0).Set<T>();
+    return absl::OkStatus();
+  }
+  absl::Status Process(CalculatorContext* cc) override {
+    return absl::OkStatus();
+  }
+};
+
+// Returns whether the output of a node whose calculator name is registered
+// for class T accepts `packet`. The node's graph caches contracts.
+template <typename T>
+absl::StatusOr<bool> OutputAcceptsPacketOfType(const Packet& packet) {
+  auto graph = ParseTextProtoOrDie<CalculatorGraphConfig>(R"pb(
+    cache_calculator_contracts: true
+    input_stream: "in"
+    node {
+      calculator: "ReregisteredCalculator"
+      input_stream: "in"
+      output_stream: "out"
+    }
+  )pb");
+  Unregister registration(CalculatorBaseRegistry::Register(
+      "ReregisteredCalculator", [] {
+        return std::make_unique<internal::CalculatorBaseFactoryFor<T>>();
+      }));
+  ValidatedGraphConfig config;
+  MP_RETURN_IF_ERROR(config.Initialize(graph));
+  return config.CalculatorInfos()[0].Contract().Outputs().Index(0).Validate(
+             packet).ok();
+}
+
+TEST(ValidatedGraphConfigTest, DoesNotReuseContractsOfReregisteredNames) {
+  const Packet int_packet = MakePacket<int>(0);
+  MP_ASSERT_OK_AND_ASSIGN(
+      bool accepts_int,
+      OutputAcceptsPacketOfType<TypedOutputCalculator<int>>(int_packet));
+  EXPECT_TRUE(accepts_int);
+  // The name now refers to another calculator class, so its contract is not
+  // taken from the cache.
+  MP_ASSERT_OK_AND_ASSIGN(
+      accepts_int,
+      OutputAcceptsPacketOfType<TypedOutputCalculator<std::string>>(
+          int_packet));
+  EXPECT_FALSE(accepts_int);
+}
+
 }  // namespace mediapipe
@@ -0,0 +1,162 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/work_stealing_thread_pool_executor.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/port/canonical_errors.h"
+#include "mediapipe/framework/port/logging.h"
+#include "mediapipe/framework/port/status_builder.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/thread_pool_executor.h"
+#include "mediapipe/framework/thread_pool_executor.pb.h"
+
+namespace mediapipe {
+
+namespace {
+
+// The executor and worker index of the current thread, if it is a worker
+// thread of a WorkStealingThreadPoolExecutor.
+thread_local const void* current_executor = nullptr;
+thread_local int current_worker = -1;
+
+}  // namespace
+
+// static
+absl::StatusOr<Executor*> WorkStealingThreadPoolExecutor::Create(
+    const MediaPipeOptions& extendable_options) {
+  auto& options =
+      extendable_options.GetExtension(ThreadPoolExecutorOptions::ext);
+  if (!options.has_num_threads()) {
+    return absl::InvalidArgumentError(
+        "num_threads is not specified in ThreadPoolExecutorOptions.");
+  }
+  if (options.num_threads() <= 0) {
+    return mediapipe::InvalidArgumentErrorBuilder(MEDIAPIPE_LOC)
+           << "The num_threads field in ThreadPoolExecutorOptions should be "
+              "positive but is "
+           << options.num_threads();
+  }
+  MP_ASSIGN_OR_RETURN(ThreadOptions thread_options,
+                      internal::ThreadOptionsFromExecutorOptions(options));
+  return new WorkStealingThreadPoolExecutor(thread_options,
+                                            options.num_threads());
+}
+
+WorkStealingThreadPoolExecutor::WorkStealingThreadPoolExecutor(
+    int num_threads)
+    : num_threads_(num_threads), thread_pool_("mediapipe", num_threads) {
+  Start();
+}
+
+WorkStealingThreadPoolExecutor::WorkStealingThreadPoolExecutor(
+    const ThreadOptions& thread_options, int num_threads)
+    : num_threads_(num_threads),
+      thread_pool_(thread_options,
+                   thread_options.name_prefix().empty()
+                       ? "mediapipe"
+                       : thread_options.name_prefix(),
+                   num_threads) {
+  Start();
+}
+
+WorkStealingThreadPoolExecutor::~WorkStealingThreadPoolExecutor() {
+  VLOG(2) << "Terminating work-stealing thread pool.";
+  absl::MutexLock lock(&idle_mutex_);
+  stopped_ = true;
+  idle_condition_.SignalAll();
+  // thread_pool_ joins the worker threads when it is destroyed. The workers
+  // drain all queued tasks before they exit.
+}
+
+void WorkStealingThreadPoolExecutor::Start() {
+  queues_.reserve(num_threads_);
+  for (int i = 0; i < num_threads_; ++i) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  thread_pool_.StartWorkers();
+  for (int i = 0; i < num_threads_; ++i) {
+    thread_pool_.Schedule([this, i] { RunWorker(i); });
+  }
+  VLOG(2) << "Started work-stealing thread pool with " << num_threads_
+          << " threads.";
+}
+
+void WorkStealingThreadPoolExecutor::Schedule(std::function<void()> task) {
+  int index;
+  if (current_executor == this) {
+    index = current_worker;
+  } else {
+    index = next_queue_.fetch_add(1, std::memory_order_relaxed) % num_threads_;
+  }
+  // The count is incremented before the task is pushed, so it never drops
+  // below the number of queued tasks. The sequentially consistent increment
+  // followed by the load of num_idle_workers_ pairs with the opposite order in
+  // RunWorker, so either an idle worker sees the new task or we see the idle
+  // worker.
+  num_queued_tasks_.fetch_add(1);
+  {
+    WorkerQueue& queue = *queues_[index];
+    absl::MutexLock lock(&queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  if (num_idle_workers_.load() > 0) {
+    absl::MutexLock lock(&idle_mutex_);
+    idle_condition_.Signal();
+  }
+}
+
+bool WorkStealingThreadPoolExecutor::PopTask(int index,
+                                             std::function<void()>* task) {
+  for (int i = 0; i < num_threads_; ++i) {
+    WorkerQueue& queue = *queues_[(index + i) % num_threads_];
+    absl::MutexLock lock(&queue.mutex);
+    if (!queue.tasks.empty()) {
+      *task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+      num_queued_tasks_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingThreadPoolExecutor::RunWorker(int index) {
+  current_executor = this;
+  current_worker = index;
+  std::function<void()> task;
+  while (true) {
+    if (PopTask(index, &task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    absl::MutexLock lock(&idle_mutex_);
+    num_idle_workers_.fetch_add(1);
+    while (num_queued_tasks_.load() == 0 && !stopped_) {
+      idle_condition_.Wait(&idle_mutex_);
+    }
+    num_idle_workers_.fetch_sub(1);
+    if (stopped_ && num_queued_tasks_.load() == 0) break;
+  }
+  current_executor = nullptr;
+  current_worker = -1;
+}
+
+REGISTER_EXECUTOR(WorkStealingThreadPoolExecutor);
+
+}  // namespace mediapipe
@@ -0,0 +1,115 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_FRAMEWORK_WORK_STEALING_THREAD_POOL_EXECUTOR_H_
+#define MEDIAPIPE_FRAMEWORK_WORK_STEALING_THREAD_POOL_EXECUTOR_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/deps/thread_options.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/framework/port/threadpool.h"
+
+namespace mediapipe {
+
+// A multithreaded executor in which every worker thread owns a task deque.
+//
+// Tasks scheduled from a worker thread of this executor go to that worker's
+// own deque, and tasks scheduled from other threads are distributed round
+// robin over the workers. A worker that runs out of tasks steals from the
+// other workers before going to sleep. Compared with ThreadPoolExecutor, this
+// replaces the single shared task queue (and its mutex) with per-worker
+// queues, which reduces contention when many small calculators run on many
+// threads.
+//
+// The executor only decides which thread runs a task. The order in which
+// ready nodes run is still decided by SchedulerQueue, since every task added
+// by the scheduler runs the highest priority SchedulerQueue::Item.
+//
+// Use it through an ExecutorConfig with the type
+// "WorkStealingThreadPoolExecutor". It accepts ThreadPoolExecutorOptions:
+//
+// executor {
+//   type: "WorkStealingThreadPoolExecutor"
+//   options {
+//     [mediapipe.ThreadPoolExecutorOptions.ext] { num_threads: 16 }
+//   }
+// }
+class WorkStealingThreadPoolExecutor : public Executor {
+ public:
+  static absl::StatusOr<Executor*> Create(
+      const MediaPipeOptions& extendable_options);
+
+  explicit WorkStealingThreadPoolExecutor(int num_threads);
+  // Waits for all scheduled tasks to complete.
+  ~WorkStealingThreadPoolExecutor() override;
+  void Schedule(std::function<void()> task) override;
+
+  // For testing.
+  int num_threads() const { return num_threads_; }
+
+ private:
+  // A worker's task deque. The owner and thieves both take tasks from the
+  // front, so each worker runs its own tasks in FIFO order.
+  struct WorkerQueue {
+    absl::Mutex mutex;
+    std::deque<std::function<void()>> tasks ABSL_GUARDED_BY(mutex);
+  };
+
+  WorkStealingThreadPoolExecutor(const ThreadOptions& thread_options,
+                                 int num_threads);
+
+  // Starts one worker loop per thread of thread_pool_.
+  void Start();
+
+  // Runs tasks on behalf of worker "index" until the executor is stopped and
+  // no tasks are left.
+  void RunWorker(int index);
+
+  // Takes a task from the worker's own deque, or steals one from another
+  // worker. Returns false if no task is queued anywhere.
+  bool PopTask(int index, std::function<void()>* task);
+
+  const int num_threads_;
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+
+  // Round-robin cursor for tasks scheduled from non-worker threads.
+  std::atomic<unsigned int> next_queue_{0};
+
+  // Number of tasks that are queued but not yet taken by a worker.
+  std::atomic<int> num_queued_tasks_{0};
+
+  // Number of workers that are waiting (or about to wait) on
+  // idle_condition_. Schedule() only takes idle_mutex_ if this is non-zero.
+  std::atomic<int> num_idle_workers_{0};
+
+  absl::Mutex idle_mutex_;
+  absl::CondVar idle_condition_;
+  bool stopped_ ABSL_GUARDED_BY(idle_mutex_) = false;
+
+  // Hosts the worker loops. Declared last so that it is destroyed (and its
+  // threads joined) before the queues.
+  mediapipe::ThreadPool thread_pool_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_FRAMEWORK_WORK_STEALING_THREAD_POOL_EXECUTOR_H_
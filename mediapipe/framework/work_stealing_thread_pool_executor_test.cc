@@ -0,0 +1,129 @@
+// Copyright 2024 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/framework/work_stealing_thread_pool_executor.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "absl/synchronization/mutex.h"
+#include "absl/synchronization/notification.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/mediapipe_options.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/thread_pool_executor.pb.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(WorkStealingThreadPoolExecutorTest, SingleThreadRunsTasksInOrder) {
+  absl::Mutex mu;
+  std::vector<int> order;
+  {
+    WorkStealingThreadPoolExecutor executor(1);
+    ASSERT_EQ(executor.num_threads(), 1);
+    for (int i = 0; i < 100; ++i) {
+      executor.Schedule([i, &mu, &order] {
+        absl::MutexLock lock(&mu);
+        order.push_back(i);
+      });
+    }
+  }
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(WorkStealingThreadPoolExecutorTest, MultiThreadsRunAllTasks) {
+  absl::Mutex mu;
+  int n = 1000;
+  {
+    WorkStealingThreadPoolExecutor executor(8);
+    ASSERT_EQ(executor.num_threads(), 8);
+    for (int i = 0; i < 1000; ++i) {
+      executor.Schedule([&n, &mu] {
+        absl::MutexLock lock(&mu);
+        --n;
+      });
+    }
+  }
+  EXPECT_EQ(n, 0);
+}
+
+// Tasks scheduled from a worker thread go to that worker's own deque. With a
+// single busy worker holding all the tasks, the idle workers must steal them.
+TEST(WorkStealingThreadPoolExecutorTest, IdleWorkersStealNestedTasks) {
+  constexpr int kNumTasks = 4;
+  absl::Mutex mu;
+  int num_running = 0;
+  int max_running = 0;
+  absl::Notification all_running;
+  {
+    WorkStealingThreadPoolExecutor executor(kNumTasks + 1);
+    executor.Schedule([&] {
+      for (int i = 0; i < kNumTasks; ++i) {
+        executor.Schedule([&] {
+          absl::MutexLock lock(&mu);
+          ++num_running;
+          max_running = std::max(max_running, num_running);
+          if (num_running == kNumTasks) all_running.Notify();
+          // Wait until every nested task runs at the same time, which is only
+          // possible if the other workers have stolen them.
+          mu.Await(absl::Condition(
+              +[](absl::Notification* n) { return n->HasBeenNotified(); },
+              &all_running));
+          --num_running;
+        });
+      }
+      all_running.WaitForNotification();
+    });
+  }
+  EXPECT_EQ(max_running, kNumTasks);
+}
+
+TEST(WorkStealingThreadPoolExecutorTest, CreateFromOptions) {
+  MediaPipeOptions extendable_options;
+  ThreadPoolExecutorOptions* options =
+      extendable_options.MutableExtension(ThreadPoolExecutorOptions::ext);
+  options->set_num_threads(3);
+  options->set_thread_name_prefix("mediapipe_ws");
+  MP_ASSERT_OK_AND_ASSIGN(Executor * executor,
+                          ExecutorRegistry::CreateByName(
+                              "WorkStealingThreadPoolExecutor",
+                              extendable_options));
+  std::unique_ptr<Executor> executor_owner(executor);
+  EXPECT_EQ(
+      static_cast<WorkStealingThreadPoolExecutor*>(executor)->num_threads(), 3);
+
+  absl::Notification done;
+  executor->Schedule([&done] { done.Notify(); });
+  done.WaitForNotification();
+}
+
+TEST(WorkStealingThreadPoolExecutorTest, CreateRequiresPositiveNumThreads) {
+  MediaPipeOptions extendable_options;
+  EXPECT_FALSE(
+      WorkStealingThreadPoolExecutor::Create(extendable_options).ok());
+  extendable_options.MutableExtension(ThreadPoolExecutorOptions::ext)
+      ->set_num_threads(0);
+  EXPECT_FALSE(
+      WorkStealingThreadPoolExecutor::Create(extendable_options).ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
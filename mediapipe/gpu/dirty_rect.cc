@@ -0,0 +1,128 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/gpu/dirty_rect.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mediapipe {
+
+namespace {
+
+// Clip space W below which a point is considered behind the camera.
+constexpr float kMinClipW = 1e-6f;
+
+// Returns `matrix` * `v` for a column-major 4x4 `matrix`.
+void Transform(const float matrix[16], const float v[4], float result[4]) {
+  for (int row = 0; row < 4; ++row) {
+    result[row] = matrix[row] * v[0] + matrix[4 + row] * v[1] +
+                  matrix[8 + row] * v[2] + matrix[12 + row] * v[3];
+  }
+}
+
+// Converts a normalized device coordinate to a pixel coordinate.
+int ToPixel(float ndc, int size, bool round_up) {
+  const float pixel = (ndc * 0.5f + 0.5f) * size;
+  return static_cast<int>(round_up ? std::ceil(pixel) : std::floor(pixel));
+}
+
+}  // namespace
+
+DirtyRect::DirtyRect(int frame_width, int frame_height)
+    : frame_width_(frame_width),
+      frame_height_(frame_height),
+      min_x_(std::numeric_limits<float>::max()),
+      min_y_(std::numeric_limits<float>::max()),
+      max_x_(std::numeric_limits<float>::lowest()),
+      max_y_(std::numeric_limits<float>::lowest()) {}
+
+void DirtyRect::AddBox(const float projection[16], const float model[16],
+                       const float box_min[3], const float box_max[3]) {
+  for (int corner = 0; corner < 8; ++corner) {
+    const float position[4] = {
+        (corner & 1) ? box_max[0] : box_min[0],
+        (corner & 2) ? box_max[1] : box_min[1],
+        (corner & 4) ? box_max[2] : box_min[2],
+        1.0f,
+    };
+    float view[4];
+    float clip[4];
+    Transform(model, position, view);
+    Transform(projection, view, clip);
+    if (clip[3] < kMinClipW) {
+      AddFrame();
+      return;
+    }
+    const float x = clip[0] / clip[3];
+    const float y = clip[1] / clip[3];
+    min_x_ = std::min(min_x_, x);
+    min_y_ = std::min(min_y_, y);
+    max_x_ = std::max(max_x_, x);
+    max_y_ = std::max(max_y_, y);
+  }
+}
+
+void DirtyRect::AddFrame() {
+  min_x_ = std::min(min_x_, -1.0f);
+  min_y_ = std::min(min_y_, -1.0f);
+  max_x_ = std::max(max_x_, 1.0f);
+  max_y_ = std::max(max_y_, 1.0f);
+}
+
+PixelRect DirtyRect::Rect(int padding) const {
+  PixelRect rect;
+  if (min_x_ > max_x_ || min_y_ > max_y_) return rect;
+  // Clamp in normalized device coordinates first, so that far off-screen
+  // bounds do not overflow the pixel conversion.
+  const int left = std::max(
+      0, ToPixel(std::max(min_x_, -1.0f), frame_width_, false) - padding);
+  const int bottom = std::max(
+      0, ToPixel(std::max(min_y_, -1.0f), frame_height_, false) - padding);
+  const int right = std::min(
+      frame_width_, ToPixel(std::min(max_x_, 1.0f), frame_width_, true) +
+                        padding);
+  const int top = std::min(
+      frame_height_,
+      ToPixel(std::min(max_y_, 1.0f), frame_height_, true) + padding);
+  if (left >= right || bottom >= top) return rect;
+  rect.x = left;
+  rect.y = bottom;
+  rect.width = right - left;
+  rect.height = top - bottom;
+  return rect;
+}
+
+void ComputeVertexBounds(const float* positions, int num_vertices, int stride,
+                         int position_size, float box_min[3],
+                         float box_max[3]) {
+  for (int i = 0; i < 3; ++i) {
+    box_min[i] = num_vertices > 0 && i < position_size
+                     ? std::numeric_limits<float>::max()
+                     : 0.0f;
+    box_max[i] = num_vertices > 0 && i < position_size
+                     ? std::numeric_limits<float>::lowest()
+                     : 0.0f;
+  }
+  for (int v = 0; v < num_vertices; ++v) {
+    const float* position = positions + v * stride;
+    for (int i = 0; i < position_size && i < 3; ++i) {
+      box_min[i] = std::min(box_min[i], position[i]);
+      box_max[i] = std::max(box_max[i], position[i]);
+    }
+  }
+}
+
+}  // namespace mediapipe
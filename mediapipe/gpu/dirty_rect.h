@@ -0,0 +1,82 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GPU_DIRTY_RECT_H_
+#define MEDIAPIPE_GPU_DIRTY_RECT_H_
+
+namespace mediapipe {
+
+// A rectangle of framebuffer pixels, with the origin in the bottom left corner
+// as expected by glScissor.
+struct PixelRect {
+  int x = 0;
+  int y = 0;
+  int width = 0;
+  int height = 0;
+
+  bool IsEmpty() const { return width <= 0 || height <= 0; }
+};
+
+// Accumulates the framebuffer region touched by the geometry drawn in a frame,
+// so that depth clears and draw passes can be limited to it with glScissor
+// instead of covering the whole frame.
+//
+// Example:
+//   DirtyRect dirty_rect(width, height);
+//   dirty_rect.AddBox(projection, model, mesh_min, mesh_max);
+//   const PixelRect rect = dirty_rect.Rect();
+//   if (rect.IsEmpty()) return;  // Nothing is drawn.
+//   glEnable(GL_SCISSOR_TEST);
+//   glScissor(rect.x, rect.y, rect.width, rect.height);
+//   glClear(GL_DEPTH_BUFFER_BIT);
+//   ...
+//   glDisable(GL_SCISSOR_TEST);
+class DirtyRect {
+ public:
+  DirtyRect(int frame_width, int frame_height);
+
+  // Adds the screen bounds of the axis-aligned box [box_min, box_max] in
+  // object space, transformed by the column-major `projection` and `model`
+  // matrices. If the box reaches behind the camera its projection is
+  // unbounded, and the whole frame is added.
+  void AddBox(const float projection[16], const float model[16],
+              const float box_min[3], const float box_max[3]);
+
+  // Adds the whole frame.
+  void AddFrame();
+
+  // Returns the accumulated region, grown by `padding` pixels to cover
+  // rasterization rounding and clamped to the frame.
+  PixelRect Rect(int padding = 1) const;
+
+ private:
+  const int frame_width_;
+  const int frame_height_;
+  // Bounds in normalized device coordinates.
+  float min_x_;
+  float min_y_;
+  float max_x_;
+  float max_y_;
+};
+
+// Computes the axis-aligned bounds of `num_vertices` vertex positions, each
+// starting `stride` floats after the previous one. Positions with fewer than
+// 3 components (`position_size`) have a zero Z.
+void ComputeVertexBounds(const float* positions, int num_vertices, int stride,
+                         int position_size, float box_min[3],
+                         float box_max[3]);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GPU_DIRTY_RECT_H_
@@ -0,0 +1,133 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/gpu/dirty_rect.h"
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr float kIdentity[16] = {1, 0, 0, 0,  //
+                                 0, 1, 0, 0,  //
+                                 0, 0, 1, 0,  //
+                                 0, 0, 0, 1};
+
+// Perspective projection with a 90 degree vertical field of view and square
+// aspect ratio, looking down the negative Z axis.
+constexpr float kPerspective[16] = {1, 0, 0,     0,   //
+                                    0, 1, 0,     0,   //
+                                    0, 0, -1.2f, -1,  //
+                                    0, 0, -2.2f, 0};
+
+// Translates by (0, 0, -2).
+constexpr float kModel[16] = {1, 0, 0,  0,  //
+                              0, 1, 0,  0,  //
+                              0, 0, 1,  0,  //
+                              0, 0, -2, 1};
+
+TEST(DirtyRectTest, IsEmptyWithoutBoxes) {
+  DirtyRect dirty_rect(640, 480);
+  EXPECT_TRUE(dirty_rect.Rect().IsEmpty());
+}
+
+TEST(DirtyRectTest, AddsOrthographicBox) {
+  DirtyRect dirty_rect(100, 200);
+  const float box_min[3] = {-0.5f, 0.0f, 0.0f};
+  const float box_max[3] = {0.5f, 0.5f, 0.0f};
+  dirty_rect.AddBox(kIdentity, kIdentity, box_min, box_max);
+  const PixelRect rect = dirty_rect.Rect(/*padding=*/0);
+  EXPECT_EQ(rect.x, 25);
+  EXPECT_EQ(rect.y, 100);
+  EXPECT_EQ(rect.width, 50);
+  EXPECT_EQ(rect.height, 50);
+}
+
+TEST(DirtyRectTest, AddsPerspectiveBoxWithPadding) {
+  DirtyRect dirty_rect(100, 100);
+  // At a distance of 2 the box covers the center half of the frame.
+  const float box_min[3] = {-1.0f, -1.0f, 0.0f};
+  const float box_max[3] = {1.0f, 1.0f, 0.0f};
+  dirty_rect.AddBox(kPerspective, kModel, box_min, box_max);
+  const PixelRect rect = dirty_rect.Rect(/*padding=*/2);
+  EXPECT_EQ(rect.x, 23);
+  EXPECT_EQ(rect.y, 23);
+  EXPECT_EQ(rect.width, 54);
+  EXPECT_EQ(rect.height, 54);
+}
+
+TEST(DirtyRectTest, UnitesBoxes) {
+  DirtyRect dirty_rect(100, 100);
+  const float first_min[3] = {-1.0f, -1.0f, 0.0f};
+  const float first_max[3] = {-0.5f, -0.5f, 0.0f};
+  const float second_min[3] = {0.5f, 0.5f, 0.0f};
+  const float second_max[3] = {1.0f, 1.0f, 0.0f};
+  dirty_rect.AddBox(kIdentity, kIdentity, first_min, first_max);
+  dirty_rect.AddBox(kIdentity, kIdentity, second_min, second_max);
+  const PixelRect rect = dirty_rect.Rect(/*padding=*/0);
+  EXPECT_EQ(rect.x, 0);
+  EXPECT_EQ(rect.y, 0);
+  EXPECT_EQ(rect.width, 100);
+  EXPECT_EQ(rect.height, 100);
+}
+
+TEST(DirtyRectTest, ClampsToFrame) {
+  DirtyRect dirty_rect(100, 100);
+  const float box_min[3] = {0.5f, -3.0f, 0.0f};
+  const float box_max[3] = {3.0f, 0.0f, 0.0f};
+  dirty_rect.AddBox(kIdentity, kIdentity, box_min, box_max);
+  const PixelRect rect = dirty_rect.Rect();
+  EXPECT_EQ(rect.x, 74);
+  EXPECT_EQ(rect.y, 0);
+  EXPECT_EQ(rect.width, 26);
+  EXPECT_EQ(rect.height, 51);
+}
+
+TEST(DirtyRectTest, IsEmptyForBoxOutsideOfFrame) {
+  DirtyRect dirty_rect(100, 100);
+  const float box_min[3] = {2.0f, 2.0f, 0.0f};
+  const float box_max[3] = {3.0f, 3.0f, 0.0f};
+  dirty_rect.AddBox(kIdentity, kIdentity, box_min, box_max);
+  EXPECT_TRUE(dirty_rect.Rect().IsEmpty());
+}
+
+TEST(DirtyRectTest, AddsFrameForBoxBehindCamera) {
+  DirtyRect dirty_rect(100, 100);
+  // The box spans the camera plane at Z = 0.
+  const float box_min[3] = {-0.1f, -0.1f, -1.0f};
+  const float box_max[3] = {0.1f, 0.1f, 3.0f};
+  dirty_rect.AddBox(kPerspective, kModel, box_min, box_max);
+  const PixelRect rect = dirty_rect.Rect();
+  EXPECT_EQ(rect.x, 0);
+  EXPECT_EQ(rect.y, 0);
+  EXPECT_EQ(rect.width, 100);
+  EXPECT_EQ(rect.height, 100);
+}
+
+TEST(DirtyRectTest, ComputesVertexBounds) {
+  // Interleaved XYZ positions and UV texture coordinates.
+  const float vertices[] = {1, -2, 3,  0, 0,  //
+                            -1, 4, 0,  1, 1,  //
+                            0, 0, -5,  0, 1};
+  float box_min[3];
+  float box_max[3];
+  ComputeVertexBounds(vertices, /*num_vertices=*/3, /*stride=*/5,
+                      /*position_size=*/3, box_min, box_max);
+  EXPECT_THAT(box_min, testing::ElementsAre(-1, -2, -5));
+  EXPECT_THAT(box_max, testing::ElementsAre(1, 4, 3));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -14,9 +14,16 @@
 
 #include "mediapipe/gpu/gl_calculator_helper.h"
 
+#include <memory>
+#include <string>
+#include <utility>
+
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/counter_factory.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/legacy_calculator_support.h"
@@ -24,10 +31,38 @@
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/gpu/gpu_buffer.h"
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
 #include "mediapipe/gpu/gpu_service.h"
 
 namespace mediapipe {
 
+namespace {
+
+class GpuBufferConversionCounters : public GpuBufferConversionListener {
+ public:
+  GpuBufferConversionCounters(CounterFactory* counter_factory,
+                              std::string node_name)
+      : counter_factory_(counter_factory), node_name_(std::move(node_name)) {}
+
+  void OnConversion(const GpuBufferConversionInfo& info) override {
+    const std::string name =
+        absl::StrCat(node_name_, "-GpuBufferConversion ", info.from_storage,
+                     " -> ", info.to_storage);
+    counter_factory_->GetCounter(name)->Increment();
+    counter_factory_->GetCounter(absl::StrCat(name, " bytes"))
+        ->IncrementBy(static_cast<int>(info.bytes));
+    counter_factory_->GetCounter(absl::StrCat(name, " us"))
+        ->IncrementBy(
+            static_cast<int>(absl::ToInt64Microseconds(info.duration)));
+  }
+
+ private:
+  CounterFactory* counter_factory_;
+  const std::string node_name_;
+};
+
+}  // namespace
+
 GlCalculatorHelper::GlCalculatorHelper() {}
 
 GlCalculatorHelper::~GlCalculatorHelper() {}
@@ -36,6 +71,10 @@ void GlCalculatorHelper::InitializeInternal(CalculatorContext* cc,
                                             GpuResources* gpu_resources) {
   gpu_resources_ = gpu_resources;
   gl_context_ = gpu_resources_->gl_context(cc);
+  if (cc) {
+    conversion_counters_ = std::make_unique<GpuBufferConversionCounters>(
+        cc->GetCounterFactory(), cc->NodeName());
+  }
 }
 
 absl::Status GlCalculatorHelper::Open(CalculatorContext* cc) {
@@ -98,11 +137,27 @@ absl::Status GlCalculatorHelper::SetupInputSidePackets(
 absl::Status GlCalculatorHelper::RunInGlContext(
     std::function<absl::Status(void)> gl_func,
     CalculatorContext* calculator_context) {
+  // Sync tokens created by gl_func share a single flush.
+  GlCommandBatch batch(gl_context_);
+  // gl_func may run on the GL thread: report its conversions to the caller's
+  // listeners, and count them for this calculator unless an enclosing call
+  // already does.
+  const ScopedGpuBufferConversionListener* caller_scope =
+      ScopedGpuBufferConversionListener::current();
+  GpuBufferConversionListener* counters =
+      caller_scope && caller_scope->Contains(conversion_counters_.get())
+          ? nullptr
+          : conversion_counters_.get();
+  auto tracked_func = [&gl_func, caller_scope, counters]() -> absl::Status {
+    ScopedGpuBufferConversionListener scope(counters, caller_scope);
+    return gl_func();
+  };
   if (calculator_context) {
-    return gl_context_->Run(std::move(gl_func), calculator_context->NodeId(),
+    return gl_context_->Run(std::move(tracked_func),
+                            calculator_context->NodeId(),
                             calculator_context->InputTimestamp());
   } else {
-    return gl_context_->Run(std::move(gl_func));
+    return gl_context_->Run(std::move(tracked_func));
   }
 }
 
@@ -30,6 +30,7 @@
 #include "mediapipe/gpu/gl_base.h"
 #include "mediapipe/gpu/gl_context.h"
 #include "mediapipe/gpu/gpu_buffer.h"
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
 #include "mediapipe/gpu/graph_support.h"
 
 namespace mediapipe {
@@ -79,6 +80,11 @@ class GlCalculatorHelper {
   // platforms, this may be run on a different thread; however, this method
   // will still wait for the function to finish executing before returning.
   // The status result from the function is passed on to the caller.
+  //
+  // GpuBuffer conversions done by the function are counted in the graph's
+  // counters as "<node name>-GpuBufferConversion <from> -> <to>", with
+  // " bytes" and " us" variants for their size and duration, and are reported
+  // to the caller's ScopedGpuBufferConversionListener scopes.
   absl::Status RunInGlContext(std::function<absl::Status(void)> gl_func);
 
   // Convenience version of RunInGlContext for arguments with a void result
@@ -208,6 +214,10 @@ class GlCalculatorHelper {
   GLuint framebuffer_ = 0;
 
   GpuResources* gpu_resources_ = nullptr;
+
+  // Counts the GpuBuffer conversions done in RunInGlContext in the graph's
+  // counters, prefixed with the node name.
+  std::unique_ptr<GpuBufferConversionListener> conversion_counters_;
 };
 
 // Represents an OpenGL texture, and is a 'view' into the memory pool.
@@ -33,6 +33,7 @@
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/status_builder.h"
 #include "mediapipe/gpu/gl_context_internal.h"
+#include "mediapipe/gpu/gl_timer_query.h"
 #include "mediapipe/gpu/gpu_buffer_format.h"
 
 #ifndef __EMSCRIPTEN__
@@ -396,6 +397,8 @@ GlContext::~GlContext() {
     attachments_.clear();
     if (profiling_helper_) {
       profiling_helper_->LogAllTimestamps();
+      // Releases the GPU timer queries while the context is current.
+      profiling_helper_.reset();
     }
   };
 
@@ -426,7 +429,8 @@ void GlContext::SetProfilingContext(
     std::shared_ptr<mediapipe::ProfilingContext> profiling_context) {
   // Create the GlProfilingHelper if it is uninitialized.
   if (!profiling_helper_ && profiling_context) {
-    profiling_helper_ = profiling_context->CreateGlProfilingHelper();
+    profiling_helper_ = profiling_context->CreateGlProfilingHelper(
+        std::make_unique<GlTimerQuery>(*this));
   }
 }
 
@@ -597,13 +601,15 @@ class GlSyncWrapper {
   GlSyncWrapper() : sync_(nullptr) {}
   explicit GlSyncWrapper(GLsync sync) : sync_(sync) {}
 
-  void Create() {
+  // If flush is false, the caller is responsible for flushing the command
+  // stream before the sync is waited on.
+  void Create(bool flush = true) {
     Clear();
     sync_ = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     // Defer the flush for WebGL until the glClientWaitSync call as it's a
     // costly IPC call in Chrome's WebGL implementation.
 #ifndef __EMSCRIPTEN__
-    glFlush();
+    if (flush) glFlush();
 #endif
   }
 
@@ -725,7 +731,14 @@ class GlFenceSyncPoint : public GlSyncPoint {
  public:
   explicit GlFenceSyncPoint(const std::shared_ptr<GlContext>& gl_context)
       : GlSyncPoint(gl_context) {
-    gl_context_->Run([this] { sync_.Create(); });
+    gl_context_->Run([this] {
+      if (gl_context_->command_batch_depth_ > 0) {
+        sync_.Create(/*flush=*/false);
+        deferred_flush_count_ = gl_context_->DeferFlush();
+      } else {
+        sync_.Create();
+      }
+    });
   }
 
   ~GlFenceSyncPoint() {
@@ -740,6 +753,7 @@ class GlFenceSyncPoint : public GlSyncPoint {
 
   void Wait() override {
     if (!sync_) return;
+    EnsureFlushed();
     if (GlContext::IsAnyContextCurrent()) {
       sync_.Wait();
       return;
@@ -752,6 +766,9 @@ class GlFenceSyncPoint : public GlSyncPoint {
   void WaitOnGpu() override {
     if (!sync_) return;
     // TODO: do not wait if we are already on the same context?
+    // Commands on the same context are ordered, so a deferred flush only
+    // matters when waiting from another context.
+    if (!gl_context_->IsCurrent()) EnsureFlushed();
     sync_.WaitOnGpu();
   }
 
@@ -759,12 +776,25 @@ class GlFenceSyncPoint : public GlSyncPoint {
     if (!sync_) return true;
     bool ready = false;
     // TODO: we should not block on the original context if possible.
-    gl_context_->Run([this, &ready] { ready = sync_.IsReady(); });
+    gl_context_->Run([this, &ready] {
+      EnsureFlushed();
+      ready = sync_.IsReady();
+    });
     return ready;
   }
 
  private:
+  // Flushes the fence if it was created inside a command batch and the batch
+  // has not flushed it yet.
+  void EnsureFlushed() {
+    if (deferred_flush_count_ < 0) return;
+    gl_context_->FlushDeferredCommands(deferred_flush_count_);
+  }
+
   GlSyncWrapper sync_;
+  // The context's deferred flush count when the fence was created without a
+  // flush, or -1 if it was flushed right away.
+  int64_t deferred_flush_count_ = -1;
 };
 
 class GlExternalFenceSyncPoint : public GlSyncPoint {
@@ -879,6 +909,40 @@ bool GlContext::ShouldUseFenceSync() const {
              kMinVersionSyncAvaiable);
 }
 
+void GlContext::BeginCommandBatch() { ++command_batch_depth_; }
+
+void GlContext::EndCommandBatch() {
+  const int depth = --command_batch_depth_;
+  ABSL_DCHECK_GE(depth, 0);
+  if (depth > 0) return;
+  // The flush is queued behind the batched commands, so there is no need to
+  // wait for it.
+  RunWithoutWaiting([this] {
+    if (has_deferred_flush_) FlushDeferredCommands(gl_flush_count_);
+  });
+}
+
+int64_t GlContext::DeferFlush() {
+  ABSL_DCHECK(IsCurrent());
+  has_deferred_flush_ = true;
+  return gl_flush_count_;
+}
+
+void GlContext::FlushDeferredCommands(int64_t flush_count) {
+  if (gl_flush_count_ > flush_count) return;
+  auto flush = [this, flush_count] {
+    if (gl_flush_count_ > flush_count) return;
+    glFlush();
+    has_deferred_flush_ = false;
+    ++gl_flush_count_;
+  };
+  if (IsCurrent()) {
+    flush();
+  } else {
+    Run(flush);
+  }
+}
+
 std::shared_ptr<GlSyncPoint> GlContext::CreateSyncToken() {
   std::shared_ptr<GlSyncPoint> token;
 #if MEDIAPIPE_DISABLE_GL_SYNC_FOR_DEBUG
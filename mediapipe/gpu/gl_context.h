@@ -20,6 +20,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <utility>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/log/absl_check.h"
@@ -73,6 +74,7 @@ typedef std::function<absl::Status()> GlStatusFunction;
 class GlContext;
 // TODO: remove after glWaitSync crashes are resolved.
 class GlSyncWrapper;
+class GlFenceSyncPoint;
 
 // Generic interface for synchronizing access to a shared resource from a
 // different context. This is an abstract class to keep users from
@@ -195,6 +197,16 @@ class GlContext : public std::enable_shared_from_this<GlContext> {
   // Returns a synchronization token for this GlContext.
   std::shared_ptr<GlSyncPoint> CreateSyncToken();
 
+  // Opens a command batch on this context. While a batch is open, fence sync
+  // tokens created on this context do not flush the command stream each time.
+  // Instead, a single flush is issued when the outermost batch ends, or
+  // earlier if one of the tokens is waited on from the CPU or from another
+  // context. This lets several calculators sharing this context submit their
+  // work to the driver together. Batches nest and may be opened and closed
+  // from any thread; prefer the GlCommandBatch helper below.
+  void BeginCommandBatch();
+  void EndCommandBatch();
+
   // If another part of the framework calls glFinish, it should call this
   // method to let the context know that it has done so. The context can use
   // that information to avoid inserting additional glFinish calls in some
@@ -333,11 +345,20 @@ class GlContext : public std::enable_shared_from_this<GlContext> {
  private:
   // TODO: remove after glWaitSync crashes are resolved.
   friend GlSyncWrapper;
+  friend GlFenceSyncPoint;
 
   GlContext();
 
   bool ShouldUseFenceSync() const;
 
+  // Called on this context when a fence is created without flushing because
+  // a command batch is open. Returns the flush count the fence must wait for.
+  int64_t DeferFlush();
+
+  // Makes sure the commands recorded before the flush count passed
+  // flush_count have been flushed, flushing now if needed.
+  void FlushDeferredCommands(int64_t flush_count);
+
 #if defined(__EMSCRIPTEN__)
   absl::Status CreateContext(EMSCRIPTEN_WEBGL_CONTEXT_HANDLE share_context);
   absl::Status CreateContextInternal(
@@ -476,9 +497,37 @@ class GlContext : public std::enable_shared_from_this<GlContext> {
 
   std::unique_ptr<mediapipe::GlProfilingHelper> profiling_helper_ = nullptr;
 
+  // Number of open command batches.
+  std::atomic<int> command_batch_depth_ = 0;
+  // Number of deferred flushes issued on this context. Only advanced while
+  // the context is current.
+  std::atomic<int64_t> gl_flush_count_ = 0;
+  // Whether a fence was created without flushing since the last deferred
+  // flush. Only accessed while the context is current.
+  bool has_deferred_flush_ = false;
+
   bool destructing_ = false;
 };
 
+// Keeps a command batch open on a GlContext for its lifetime. See
+// GlContext::BeginCommandBatch.
+class GlCommandBatch {
+ public:
+  explicit GlCommandBatch(std::shared_ptr<GlContext> context)
+      : context_(std::move(context)) {
+    if (context_) context_->BeginCommandBatch();
+  }
+  ~GlCommandBatch() {
+    if (context_) context_->EndCommandBatch();
+  }
+
+  GlCommandBatch(const GlCommandBatch&) = delete;
+  GlCommandBatch& operator=(const GlCommandBatch&) = delete;
+
+ private:
+  std::shared_ptr<GlContext> context_;
+};
+
 // A framebuffer that the framework can use to attach textures for rendering
 // etc.
 // This could just be a member of GlContext, but it serves as a basic example
@@ -0,0 +1,212 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/gpu/gl_timer_query.h"
+
+#include <cstdint>
+
+#include "absl/types/optional.h"
+#include "mediapipe/gpu/gl_base.h"
+#include "mediapipe/gpu/gl_context.h"
+
+namespace mediapipe {
+
+#if HAS_EGL && defined(GL_EXT_disjoint_timer_query)
+#define MEDIAPIPE_GL_TIMER_QUERY_EXT 1
+#elif HAS_NSGL && CGL_VERSION_1_3
+#define MEDIAPIPE_GL_TIMER_QUERY_CORE 1
+#endif
+
+namespace {
+
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT
+// GL_EXT_disjoint_timer_query entry points, which are not exported by the
+// GLES libraries and must be looked up at runtime.
+struct TimerQueryFunctions {
+  PFNGLGENQUERIESEXTPROC gen_queries = nullptr;
+  PFNGLDELETEQUERIESEXTPROC delete_queries = nullptr;
+  PFNGLQUERYCOUNTEREXTPROC query_counter = nullptr;
+  PFNGLGETQUERYIVEXTPROC get_query_iv = nullptr;
+  PFNGLGETQUERYOBJECTIVEXTPROC get_query_object_iv = nullptr;
+  PFNGLGETQUERYOBJECTUI64VEXTPROC get_query_object_ui64v = nullptr;
+  PFNGLGETINTEGER64VEXTPROC get_integer64v = nullptr;
+
+  bool Load() {
+    gen_queries = reinterpret_cast<PFNGLGENQUERIESEXTPROC>(
+        eglGetProcAddress("glGenQueriesEXT"));
+    delete_queries = reinterpret_cast<PFNGLDELETEQUERIESEXTPROC>(
+        eglGetProcAddress("glDeleteQueriesEXT"));
+    query_counter = reinterpret_cast<PFNGLQUERYCOUNTEREXTPROC>(
+        eglGetProcAddress("glQueryCounterEXT"));
+    get_query_iv = reinterpret_cast<PFNGLGETQUERYIVEXTPROC>(
+        eglGetProcAddress("glGetQueryivEXT"));
+    get_query_object_iv = reinterpret_cast<PFNGLGETQUERYOBJECTIVEXTPROC>(
+        eglGetProcAddress("glGetQueryObjectivEXT"));
+    get_query_object_ui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(
+        eglGetProcAddress("glGetQueryObjectui64vEXT"));
+    get_integer64v = reinterpret_cast<PFNGLGETINTEGER64VEXTPROC>(
+        eglGetProcAddress("glGetInteger64vEXT"));
+    return gen_queries && delete_queries && query_counter && get_query_iv &&
+           get_query_object_iv && get_query_object_ui64v && get_integer64v;
+  }
+};
+
+TimerQueryFunctions& GlFunctions() {
+  static TimerQueryFunctions* functions = new TimerQueryFunctions();
+  return *functions;
+}
+
+void GenQuery(GLuint* query) { GlFunctions().gen_queries(1, query); }
+void DeleteQueries(GLsizei n, const GLuint* queries) {
+  GlFunctions().delete_queries(n, queries);
+}
+void QueryTimestamp(GLuint query) {
+  GlFunctions().query_counter(query, GL_TIMESTAMP_EXT);
+}
+GLint QueryAvailable(GLuint query) {
+  GLint available = 0;
+  GlFunctions().get_query_object_iv(query, GL_QUERY_RESULT_AVAILABLE_EXT,
+                                    &available);
+  return available;
+}
+GLuint64 QueryResult(GLuint query) {
+  GLuint64 result = 0;
+  GlFunctions().get_query_object_ui64v(query, GL_QUERY_RESULT_EXT, &result);
+  return result;
+}
+GLint64 CurrentTimestamp() {
+  GLint64 time = 0;
+  GlFunctions().get_integer64v(GL_TIMESTAMP_EXT, &time);
+  return time;
+}
+#elif MEDIAPIPE_GL_TIMER_QUERY_CORE
+void GenQuery(GLuint* query) { glGenQueries(1, query); }
+void DeleteQueries(GLsizei n, const GLuint* queries) {
+  glDeleteQueries(n, queries);
+}
+void QueryTimestamp(GLuint query) { glQueryCounter(query, GL_TIMESTAMP); }
+GLint QueryAvailable(GLuint query) {
+  GLint available = 0;
+  glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+  return available;
+}
+GLuint64 QueryResult(GLuint query) {
+  GLuint64 result = 0;
+  glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+  return result;
+}
+GLint64 CurrentTimestamp() {
+  GLint64 time = 0;
+  glGetInteger64v(GL_TIMESTAMP, &time);
+  return time;
+}
+#endif  // MEDIAPIPE_GL_TIMER_QUERY_EXT
+
+}  // namespace
+
+GlTimerQuery::GlTimerQuery(const GlContext& context) : context_(context) {}
+
+GlTimerQuery::~GlTimerQuery() {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT || MEDIAPIPE_GL_TIMER_QUERY_CORE
+  if (!all_queries_.empty()) {
+    DeleteQueries(all_queries_.size(), all_queries_.data());
+  }
+#endif
+}
+
+bool GlTimerQuery::Initialize() {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT
+  if (!context_.HasGlExtension("GL_EXT_disjoint_timer_query") ||
+      !GlFunctions().Load()) {
+    return false;
+  }
+  // Some implementations expose the extension without timestamp support.
+  GLint counter_bits = 0;
+  GlFunctions().get_query_iv(GL_TIMESTAMP_EXT, GL_QUERY_COUNTER_BITS_EXT,
+                             &counter_bits);
+  if (counter_bits == 0) {
+    return false;
+  }
+  // Clear a disjoint operation that happened before profiling started.
+  CheckDisjoint();
+  supported_ = true;
+#elif MEDIAPIPE_GL_TIMER_QUERY_CORE
+  supported_ = context_.gl_major_version() > 3 ||
+               (context_.gl_major_version() == 3 &&
+                context_.gl_minor_version() >= 3);
+#endif
+  return supported_;
+}
+
+absl::optional<int64_t> GlTimerQuery::GetGpuTimeNs() {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT || MEDIAPIPE_GL_TIMER_QUERY_CORE
+  if (supported_) {
+    return CurrentTimestamp();
+  }
+#endif
+  return absl::nullopt;
+}
+
+absl::optional<GpuTimer::Query> GlTimerQuery::RequestTimestamp() {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT || MEDIAPIPE_GL_TIMER_QUERY_CORE
+  if (supported_) {
+    GLuint query = 0;
+    if (!free_queries_.empty()) {
+      query = free_queries_.back();
+      free_queries_.pop_back();
+    } else {
+      GenQuery(&query);
+      if (query == 0) {
+        return absl::nullopt;
+      }
+      all_queries_.push_back(query);
+    }
+    QueryTimestamp(query);
+    return query;
+  }
+#endif
+  return absl::nullopt;
+}
+
+absl::optional<int64_t> GlTimerQuery::GetTimestamp(Query query, bool wait) {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT || MEDIAPIPE_GL_TIMER_QUERY_CORE
+  if (supported_) {
+    // Reading GL_QUERY_RESULT blocks until the query is available.
+    if (!wait && !QueryAvailable(query)) {
+      return absl::nullopt;
+    }
+    GLuint64 result = QueryResult(query);
+    ReleaseQuery(query);
+    return static_cast<int64_t>(result);
+  }
+#endif
+  return absl::nullopt;
+}
+
+void GlTimerQuery::ReleaseQuery(Query query) { free_queries_.push_back(query); }
+
+bool GlTimerQuery::CheckDisjoint() {
+#if MEDIAPIPE_GL_TIMER_QUERY_EXT
+  // Reading GL_GPU_DISJOINT_EXT also resets it.
+  GLint disjoint = 0;
+  glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+  return disjoint != 0;
+#else
+  // Desktop OpenGL timestamps are not subject to disjoint operations.
+  return false;
+#endif
+}
+
+}  // namespace mediapipe
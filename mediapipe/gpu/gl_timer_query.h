@@ -0,0 +1,57 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_GPU_GL_TIMER_QUERY_H_
+#define MEDIAPIPE_GPU_GL_TIMER_QUERY_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "mediapipe/framework/profiler/gpu_timer.h"
+#include "mediapipe/gpu/gl_base.h"
+
+namespace mediapipe {
+
+class GlContext;
+
+// GpuTimer implemented with OpenGL timer queries. On OpenGL ES this uses
+// GL_EXT_disjoint_timer_query; on desktop OpenGL 3.3+ it uses the core
+// glQueryCounter. Initialize() returns false elsewhere, including on iOS and
+// WebGL. Must be used on the thread where |context| is current.
+class GlTimerQuery : public GpuTimer {
+ public:
+  explicit GlTimerQuery(const GlContext& context);
+  ~GlTimerQuery() override;
+
+  bool Initialize() override;
+  absl::optional<int64_t> GetGpuTimeNs() override;
+  absl::optional<Query> RequestTimestamp() override;
+  absl::optional<int64_t> GetTimestamp(Query query, bool wait) override;
+  void ReleaseQuery(Query query) override;
+  bool CheckDisjoint() override;
+
+ private:
+  const GlContext& context_;
+  bool supported_ = false;
+  // Released query objects, reused before new ones are generated.
+  std::vector<GLuint> free_queries_;
+  // All generated query objects, deleted with the timer.
+  std::vector<GLuint> all_queries_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GPU_GL_TIMER_QUERY_H_
@@ -1,13 +1,19 @@
 #include "mediapipe/gpu/gpu_buffer.h"
 
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "absl/functional/bind_front.h"
 #include "absl/log/absl_check.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/port/logging.h"
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
 
 #if MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
 #include "mediapipe/objc/util.h"
@@ -24,6 +30,15 @@ struct StorageTypeFormatter {
   }
 };
 
+int64_t PixelDataSize(int width, int height, GpuBufferFormat format) {
+  const ImageFormat::Format image_format =
+      ImageFormatForGpuBufferFormat(format);
+  if (image_format == ImageFormat::UNKNOWN) return 0;
+  return static_cast<int64_t>(width) * height *
+         ImageFrame::NumberOfChannelsForFormat(image_format) *
+         ImageFrame::ChannelSizeForFormat(image_format);
+}
+
 }  // namespace
 
 std::string GpuBuffer::DebugString() const {
@@ -41,6 +56,7 @@ internal::GpuBufferStorage* GpuBuffer::StorageHolder::GetStorageForView(
     TypeId view_provider_type, bool for_writing) const {
   std::shared_ptr<internal::GpuBufferStorage> chosen_storage;
   std::function<std::shared_ptr<internal::GpuBufferStorage>()> conversion;
+  TypeId conversion_source_type = kTypeId<void>;
 
   {
     absl::MutexLock lock(&mutex_);
@@ -60,6 +76,7 @@ internal::GpuBufferStorage* GpuBuffer::StorageHolder::GetStorageForView(
                                  .StorageConverterForViewProvider(
                                      view_provider_type, s->storage_type())) {
           conversion = absl::bind_front(converter, s);
+          conversion_source_type = s->storage_type();
           break;
         }
       }
@@ -77,7 +94,20 @@ internal::GpuBufferStorage* GpuBuffer::StorageHolder::GetStorageForView(
   //    false positive in the deadlock detector.
   //    TODO: we could use Mutex::ForgetDeadlockInfo instead.
   if (conversion) {
+    const ScopedGpuBufferConversionListener* listeners =
+        ScopedGpuBufferConversionListener::current();
+    const absl::Time start = listeners ? absl::Now() : absl::InfinitePast();
     auto new_storage = conversion();
+    if (listeners && new_storage) {
+      GpuBufferConversionInfo info;
+      info.from_storage = conversion_source_type.name();
+      info.to_storage = new_storage->storage_type().name();
+      info.width = width_;
+      info.height = height_;
+      info.bytes = PixelDataSize(width_, height_, format_);
+      info.duration = absl::Now() - start;
+      listeners->Notify(info);
+    }
     absl::MutexLock lock(&mutex_);
     // Another reader might have already completed and inserted the same
     // conversion. TODO: prevent this?
@@ -0,0 +1,83 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
+
+#include "absl/base/attributes.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+
+namespace mediapipe {
+namespace {
+
+ABSL_CONST_INIT thread_local const ScopedGpuBufferConversionListener*
+    current_scope = nullptr;
+
+}  // namespace
+
+ScopedGpuBufferConversionListener::ScopedGpuBufferConversionListener(
+    GpuBufferConversionListener* listener)
+    : ScopedGpuBufferConversionListener(listener, current_scope) {}
+
+ScopedGpuBufferConversionListener::ScopedGpuBufferConversionListener(
+    GpuBufferConversionListener* listener,
+    const ScopedGpuBufferConversionListener* parent)
+    : listener_(listener), parent_(parent), saved_(current_scope) {
+  current_scope = this;
+}
+
+ScopedGpuBufferConversionListener::~ScopedGpuBufferConversionListener() {
+  current_scope = saved_;
+}
+
+const ScopedGpuBufferConversionListener*
+ScopedGpuBufferConversionListener::current() {
+  return current_scope;
+}
+
+bool ScopedGpuBufferConversionListener::Contains(
+    const GpuBufferConversionListener* listener) const {
+  for (auto* scope = this; scope; scope = scope->parent_) {
+    if (scope->listener_ == listener) return true;
+  }
+  return false;
+}
+
+void ScopedGpuBufferConversionListener::Notify(
+    const GpuBufferConversionInfo& info) const {
+  for (auto* scope = this; scope; scope = scope->parent_) {
+    if (scope->listener_) scope->listener_->OnConversion(info);
+  }
+}
+
+void GpuBufferConversionGuard::OnConversion(
+    const GpuBufferConversionInfo& info) {
+  absl::MutexLock lock(&mutex_);
+  conversions_.push_back(absl::StrCat(info.from_storage, " -> ",
+                                      info.to_storage, " (", info.width, "x",
+                                      info.height, ")"));
+}
+
+absl::Status GpuBufferConversionGuard::status() const {
+  absl::MutexLock lock(&mutex_);
+  if (conversions_.empty()) return absl::OkStatus();
+  return absl::FailedPreconditionError(
+      absl::StrCat("Unexpected GpuBuffer conversions: ",
+                   absl::StrJoin(conversions_, ", ")));
+}
+
+}  // namespace mediapipe
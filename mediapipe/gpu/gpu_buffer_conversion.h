@@ -0,0 +1,119 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GPU_GPU_BUFFER_CONVERSION_H_
+#define MEDIAPIPE_GPU_GPU_BUFFER_CONVERSION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+
+namespace mediapipe {
+
+// Describes a conversion of a GpuBuffer from one storage to another, e.g. the
+// upload of an ImageFrame storage into a GL texture.
+struct GpuBufferConversionInfo {
+  // Storage type names, as in GpuBuffer::DebugString().
+  std::string from_storage;
+  std::string to_storage;
+  int width = 0;
+  int height = 0;
+  // Size of the converted pixels, or 0 if the format has no CPU equivalent.
+  int64_t bytes = 0;
+  absl::Duration duration;
+};
+
+// Receives the GpuBuffer conversions performed on the current thread.
+class GpuBufferConversionListener {
+ public:
+  virtual ~GpuBufferConversionListener() = default;
+  virtual void OnConversion(const GpuBufferConversionInfo& info) = 0;
+};
+
+// Installs a GpuBufferConversionListener on the current thread for the
+// lifetime of this object. Scopes nest, and a conversion is reported to the
+// listeners of all enclosing scopes.
+//
+// GlCalculatorHelper::RunInGlContext carries the caller's scopes over to the
+// GL thread, so conversions in GL code are reported to them as well.
+class ScopedGpuBufferConversionListener {
+ public:
+  explicit ScopedGpuBufferConversionListener(
+      GpuBufferConversionListener* listener);
+  // Makes parent, which may belong to another thread, the enclosing scope
+  // instead of the current scope of this thread. parent must outlive this
+  // object.
+  ScopedGpuBufferConversionListener(
+      GpuBufferConversionListener* listener,
+      const ScopedGpuBufferConversionListener* parent);
+  ~ScopedGpuBufferConversionListener();
+
+  ScopedGpuBufferConversionListener(const ScopedGpuBufferConversionListener&) =
+      delete;
+  ScopedGpuBufferConversionListener& operator=(
+      const ScopedGpuBufferConversionListener&) = delete;
+
+  // The innermost scope of the current thread, or nullptr.
+  static const ScopedGpuBufferConversionListener* current();
+
+  // Returns true if listener belongs to this scope or an enclosing one.
+  bool Contains(const GpuBufferConversionListener* listener) const;
+
+  // Reports info to the listeners of this scope and all enclosing ones.
+  void Notify(const GpuBufferConversionInfo& info) const;
+
+ private:
+  GpuBufferConversionListener* listener_;
+  const ScopedGpuBufferConversionListener* parent_;
+  const ScopedGpuBufferConversionListener* saved_;
+};
+
+// Strict mode for hot paths: while a guard is alive, GpuBuffer conversions on
+// the current thread are not expected, and status() reports them as an error.
+// Returning that status from Process() fails the graph.
+//
+// Example:
+//   absl::Status MyCalculator::Process(CalculatorContext* cc) {
+//     GpuBufferConversionGuard guard;
+//     MP_RETURN_IF_ERROR(helper_.RunInGlContext([&]() -> absl::Status {
+//       auto src = helper_.CreateSourceTexture(input);  // Must not upload.
+//       ...
+//     }));
+//     return guard.status();
+//   }
+class GpuBufferConversionGuard : public GpuBufferConversionListener {
+ public:
+  GpuBufferConversionGuard() : scope_(this) {}
+
+  void OnConversion(const GpuBufferConversionInfo& info) override;
+
+  // Returns FailedPreconditionError listing the conversions that happened
+  // since the guard was created, or OkStatus if there were none.
+  absl::Status status() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  std::vector<std::string> conversions_ ABSL_GUARDED_BY(mutex_);
+  // Declared last, so that the guard is complete once it is installed.
+  ScopedGpuBufferConversionListener scope_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GPU_GPU_BUFFER_CONVERSION_H_
@@ -0,0 +1,98 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::IsNull;
+
+class RecordingListener : public GpuBufferConversionListener {
+ public:
+  void OnConversion(const GpuBufferConversionInfo& info) override {
+    conversions.push_back(info.from_storage + "->" + info.to_storage);
+  }
+  std::vector<std::string> conversions;
+};
+
+GpuBufferConversionInfo Conversion(std::string from, std::string to) {
+  GpuBufferConversionInfo info;
+  info.from_storage = std::move(from);
+  info.to_storage = std::move(to);
+  info.width = 4;
+  info.height = 2;
+  return info;
+}
+
+TEST(GpuBufferConversionTest, NestedScopesAreAllNotified) {
+  RecordingListener outer;
+  RecordingListener inner;
+  EXPECT_THAT(ScopedGpuBufferConversionListener::current(), IsNull());
+  {
+    ScopedGpuBufferConversionListener outer_scope(&outer);
+    {
+      ScopedGpuBufferConversionListener inner_scope(&inner);
+      EXPECT_TRUE(ScopedGpuBufferConversionListener::current()->Contains(&outer));
+      ScopedGpuBufferConversionListener::current()->Notify(
+          Conversion("a", "b"));
+    }
+    ScopedGpuBufferConversionListener::current()->Notify(Conversion("c", "d"));
+  }
+  EXPECT_THAT(ScopedGpuBufferConversionListener::current(), IsNull());
+
+  EXPECT_THAT(outer.conversions, ElementsAre("a->b", "c->d"));
+  EXPECT_THAT(inner.conversions, ElementsAre("a->b"));
+}
+
+TEST(GpuBufferConversionTest, ExplicitParentReplacesThreadScopes) {
+  RecordingListener parent;
+  RecordingListener unrelated;
+  RecordingListener child;
+  ScopedGpuBufferConversionListener parent_scope(&parent);
+  {
+    ScopedGpuBufferConversionListener unrelated_scope(&unrelated);
+    ScopedGpuBufferConversionListener child_scope(&child, &parent_scope);
+    ScopedGpuBufferConversionListener::current()->Notify(Conversion("a", "b"));
+  }
+
+  EXPECT_THAT(parent.conversions, ElementsAre("a->b"));
+  EXPECT_THAT(child.conversions, ElementsAre("a->b"));
+  EXPECT_TRUE(unrelated.conversions.empty());
+}
+
+TEST(GpuBufferConversionTest, GuardFailsOnConversion) {
+  GpuBufferConversionGuard guard;
+  MP_EXPECT_OK(guard.status());
+
+  ScopedGpuBufferConversionListener::current()->Notify(
+      Conversion("ImageFrame", "GlTextureBuffer"));
+
+  EXPECT_EQ(guard.status().code(), absl::StatusCode::kFailedPrecondition);
+  EXPECT_THAT(guard.status().message(),
+              HasSubstr("ImageFrame -> GlTextureBuffer (4x2)"));
+}
+
+}  // namespace
+}  // namespace mediapipe
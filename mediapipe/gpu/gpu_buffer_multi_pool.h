@@ -52,6 +52,26 @@ class GpuBufferMultiPool : public MultiPool<
       GpuBufferFormat format = GpuBufferFormat::kBGRA32) {
     return Get(internal::GpuBufferSpec(width, height, format));
   }
+
+  // Like GetBuffer, but rounds width and height up to a multiple of
+  // size_class, so that requests whose size changes slightly from frame to
+  // frame (e.g. crops following a tracked region) share one pool instead of
+  // creating and evicting a pool per size. The returned buffer can thus be
+  // larger than requested: callers must only use its top-left width x height
+  // region, e.g. by setting the viewport to it, and must pass that region
+  // along with the buffer.
+  absl::StatusOr<GpuBuffer> GetBufferWithSizeClass(
+      int width, int height, GpuBufferFormat format = GpuBufferFormat::kBGRA32,
+      int size_class = 64) {
+    return GetBuffer(RoundUpToSizeClass(width, size_class),
+                     RoundUpToSizeClass(height, size_class), format);
+  }
+
+ private:
+  static int RoundUpToSizeClass(int size, int size_class) {
+    if (size_class <= 1) return size;
+    return (size + size_class - 1) / size_class * size_class;
+  }
 };
 
 }  // namespace mediapipe
@@ -0,0 +1,242 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/gpu/gpu_buffer_storage_ahwb.h"
+
+#ifdef MEDIAPIPE_GPU_BUFFER_USE_AHWB
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <memory>
+#include <utility>
+
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+
+namespace {
+
+PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC eglGetNativeClientBufferANDROID;
+PFNEGLCREATEIMAGEKHRPROC eglCreateImageKHR;
+PFNEGLDESTROYIMAGEKHRPROC eglDestroyImageKHR;
+PFNGLEGLIMAGETARGETTEXTURE2DOESPROC glEGLImageTargetTexture2DOES;
+
+bool IsEglImageSupported() {
+  static const bool extensions_allowed = [] {
+    eglGetNativeClientBufferANDROID =
+        reinterpret_cast<PFNEGLGETNATIVECLIENTBUFFERANDROIDPROC>(
+            eglGetProcAddress("eglGetNativeClientBufferANDROID"));
+    eglCreateImageKHR = reinterpret_cast<PFNEGLCREATEIMAGEKHRPROC>(
+        eglGetProcAddress("eglCreateImageKHR"));
+    eglDestroyImageKHR = reinterpret_cast<PFNEGLDESTROYIMAGEKHRPROC>(
+        eglGetProcAddress("eglDestroyImageKHR"));
+    glEGLImageTargetTexture2DOES =
+        reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
+            eglGetProcAddress("glEGLImageTargetTexture2DOES"));
+    return eglGetNativeClientBufferANDROID && eglCreateImageKHR &&
+           eglDestroyImageKHR && glEGLImageTargetTexture2DOES;
+  }();
+  return extensions_allowed;
+}
+
+absl::StatusOr<uint32_t> AhwbFormatForGpuBufferFormat(GpuBufferFormat format) {
+  switch (format) {
+    case GpuBufferFormat::kRGBA32:
+      return HardwareBufferSpec::AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM;
+    case GpuBufferFormat::kOneComponent8:
+      return HardwareBufferSpec::AHARDWAREBUFFER_FORMAT_R8_UNORM;
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("Unsupported GpuBufferFormat for AHardwareBuffer: ",
+                       static_cast<uint32_t>(format)));
+  }
+}
+
+absl::StatusOr<GpuBufferFormat> GpuBufferFormatForAhwbFormat(
+    uint32_t ahwb_format) {
+  switch (ahwb_format) {
+    case HardwareBufferSpec::AHARDWAREBUFFER_FORMAT_R8G8B8A8_UNORM:
+      return GpuBufferFormat::kRGBA32;
+    case HardwareBufferSpec::AHARDWAREBUFFER_FORMAT_R8_UNORM:
+      return GpuBufferFormat::kOneComponent8;
+    default:
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Unsupported AHardwareBuffer format: ", ahwb_format));
+  }
+}
+
+void DestroyTexture(GlContext& gl_context, EGLImageKHR egl_image,
+                    GLuint texture) {
+  gl_context.RunWithoutWaiting(
+      [display = gl_context.egl_display(), egl_image, texture] {
+        glDeleteTextures(1, &texture);
+        eglDestroyImageKHR(display, egl_image);
+      });
+}
+
+HardwareBuffer AllocateHardwareBuffer(int width, int height,
+                                      GpuBufferFormat format) {
+  auto ahwb_format = AhwbFormatForGpuBufferFormat(format);
+  ABSL_CHECK_OK(ahwb_format);
+  HardwareBufferSpec spec = {
+      .width = static_cast<uint32_t>(width),
+      .height = static_cast<uint32_t>(height),
+      .layers = 1,
+      .format = *ahwb_format,
+      .usage = HardwareBufferSpec::AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE |
+               HardwareBufferSpec::AHARDWAREBUFFER_USAGE_GPU_FRAMEBUFFER};
+  auto hardware_buffer = HardwareBuffer::Create(spec);
+  ABSL_CHECK_OK(hardware_buffer);
+  return *std::move(hardware_buffer);
+}
+
+}  // namespace
+
+absl::StatusOr<std::shared_ptr<GpuBufferStorageAhwb>>
+GpuBufferStorageAhwb::Wrap(AHardwareBuffer* ahwb) {
+  MP_ASSIGN_OR_RETURN(HardwareBuffer hardware_buffer,
+                      HardwareBuffer::WrapAndAcquireAHardwareBuffer(ahwb));
+  MP_ASSIGN_OR_RETURN(
+      const GpuBufferFormat format,
+      GpuBufferFormatForAhwbFormat(hardware_buffer.spec().format));
+  return std::make_shared<GpuBufferStorageAhwb>(std::move(hardware_buffer),
+                                                format);
+}
+
+GpuBufferStorageAhwb::GpuBufferStorageAhwb(int width, int height,
+                                           GpuBufferFormat format)
+    : GpuBufferStorageAhwb(AllocateHardwareBuffer(width, height, format),
+                           format) {}
+
+GpuBufferStorageAhwb::GpuBufferStorageAhwb(HardwareBuffer hardware_buffer,
+                                           GpuBufferFormat format)
+    : hardware_buffer_(std::move(hardware_buffer)), format_(format) {}
+
+GpuBufferStorageAhwb::~GpuBufferStorageAhwb() {
+  absl::MutexLock lock(&mutex_);
+  if (gl_context_ && texture_) {
+    DestroyTexture(*gl_context_, egl_image_, texture_);
+  }
+}
+
+GLuint GpuBufferStorageAhwb::GetOrCreateTexture(
+    const std::shared_ptr<GlContext>& gl_context) const {
+  if (gl_context_ == gl_context && texture_) return texture_;
+  if (gl_context_ && texture_) {
+    // The buffer moved to another context; the old import is not usable
+    // there.
+    DestroyTexture(*gl_context_, egl_image_, texture_);
+    texture_ = 0;
+    egl_image_ = EGL_NO_IMAGE_KHR;
+  }
+  gl_context_ = gl_context;
+
+  ABSL_CHECK(IsEglImageSupported())
+      << "EGL extensions for importing AHardwareBuffer are not available";
+  EGLClientBuffer native_buffer = eglGetNativeClientBufferANDROID(
+      hardware_buffer_.GetAHardwareBuffer());
+  ABSL_CHECK(native_buffer) << "eglGetNativeClientBufferANDROID failed";
+  const EGLint attributes[] = {EGL_IMAGE_PRESERVED_KHR, EGL_TRUE, EGL_NONE};
+  egl_image_ = eglCreateImageKHR(gl_context->egl_display(), EGL_NO_CONTEXT,
+                                 EGL_NATIVE_BUFFER_ANDROID, native_buffer,
+                                 attributes);
+  ABSL_CHECK_NE(egl_image_, EGL_NO_IMAGE_KHR)
+      << "eglCreateImageKHR failed: " << eglGetError();
+
+  glGenTextures(1, &texture_);
+  glBindTexture(GL_TEXTURE_2D, texture_);
+  glEGLImageTargetTexture2DOES(GL_TEXTURE_2D,
+                               static_cast<GLeglImageOES>(egl_image_));
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  return texture_;
+}
+
+GlTextureView GpuBufferStorageAhwb::GetTexture(int plane,
+                                               bool for_writing) const {
+  ABSL_CHECK_EQ(plane, 0) << "AHardwareBuffer storage has a single plane";
+  auto gl_context = GlContext::GetCurrent();
+  ABSL_CHECK(gl_context);
+  GLuint texture;
+  {
+    absl::MutexLock lock(&mutex_);
+    texture = GetOrCreateTexture(gl_context);
+    if (producer_sync_) producer_sync_->WaitOnGpu();
+    if (for_writing) consumer_multi_sync_->WaitOnGpu();
+  }
+
+  GlTextureView::DetachFn detach;
+  GlTextureView::DoneWritingFn done_writing;
+  if (for_writing) {
+    done_writing = [this](const GlTextureView& view) {
+      auto sync = view.gl_context()->CreateSyncToken();
+      absl::MutexLock lock(&mutex_);
+      producer_sync_ = std::move(sync);
+      consumer_multi_sync_ = std::make_unique<GlMultiSyncPoint>();
+    };
+  } else {
+    detach = [this](GlTextureView& view) {
+      auto sync = view.gl_context()->CreateSyncToken();
+      absl::MutexLock lock(&mutex_);
+      consumer_multi_sync_->Add(std::move(sync));
+    };
+  }
+  return GlTextureView(gl_context.get(), GL_TEXTURE_2D, texture, width(),
+                       height(), plane, std::move(detach),
+                       std::move(done_writing));
+}
+
+GlTextureView GpuBufferStorageAhwb::GetReadView(internal::types<GlTextureView>,
+                                                int plane) const {
+  return GetTexture(plane, /*for_writing=*/false);
+}
+
+GlTextureView GpuBufferStorageAhwb::GetWriteView(internal::types<GlTextureView>,
+                                                 int plane) {
+  return GetTexture(plane, /*for_writing=*/true);
+}
+
+const AhwbView GpuBufferStorageAhwb::GetReadView(
+    internal::types<AhwbView>) const {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (producer_sync_) producer_sync_->Wait();
+  }
+  // AhwbView only hands out a const AHardwareBuffer.
+  return AhwbView(const_cast<HardwareBuffer*>(&hardware_buffer_));
+}
+
+AhwbView GpuBufferStorageAhwb::GetWriteView(internal::types<AhwbView>) {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (producer_sync_) producer_sync_->Wait();
+    consumer_multi_sync_->Wait();
+    // The writer is outside GL, so there is nothing left to track.
+    producer_sync_ = nullptr;
+    consumer_multi_sync_ = std::make_unique<GlMultiSyncPoint>();
+  }
+  return AhwbView(&hardware_buffer_);
+}
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GPU_BUFFER_USE_AHWB
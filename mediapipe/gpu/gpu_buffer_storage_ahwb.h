@@ -0,0 +1,112 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_GPU_GPU_BUFFER_STORAGE_AHWB_H_
+#define MEDIAPIPE_GPU_GPU_BUFFER_STORAGE_AHWB_H_
+
+#include "mediapipe/framework/port.h"
+
+#ifdef MEDIAPIPE_GPU_BUFFER_USE_AHWB
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/formats/ahwb_view.h"
+#include "mediapipe/framework/formats/hardware_buffer.h"
+#include "mediapipe/gpu/gl_base.h"
+#include "mediapipe/gpu/gl_context.h"
+#include "mediapipe/gpu/gl_texture_view.h"
+#include "mediapipe/gpu/gpu_buffer_format.h"
+#include "mediapipe/gpu/gpu_buffer_storage.h"
+
+namespace mediapipe {
+
+// GpuBuffer storage backed by an Android AHardwareBuffer.
+//
+// GL views import the buffer through an EGLImage, so a frame produced by the
+// camera (or any other AHWB producer) can be sampled by GL calculators such as
+// ImageToTensorCalculator without an intermediate copy. The EGLImage and the
+// texture bound to it are created once per GL context and kept for the
+// lifetime of the storage.
+//
+// Only single-plane formats with a GL equivalent are supported (kRGBA32 and
+// kOneComponent8); YUV camera buffers need an external OES sampler and must
+// still be converted first.
+//
+// Example:
+//   MP_ASSIGN_OR_RETURN(auto storage, GpuBufferStorageAhwb::Wrap(ahwb));
+//   GpuBuffer buffer(std::move(storage));
+class GpuBufferStorageAhwb
+    : public internal::GpuBufferStorageImpl<
+          GpuBufferStorageAhwb, internal::ViewProvider<GlTextureView>,
+          internal::ViewProvider<AhwbView>> {
+ public:
+  // Not registered with GpuBufferStorageRegistry: buffers are created through
+  // the GL texture pool as before, and this storage is used only when an AHWB
+  // is wrapped explicitly.
+  static constexpr bool kDisableGpuBufferRegistration = true;
+
+  // Wraps an existing AHWB, acquiring a reference to it. Fails if the buffer
+  // format has no GpuBufferFormat equivalent.
+  static absl::StatusOr<std::shared_ptr<GpuBufferStorageAhwb>> Wrap(
+      AHardwareBuffer* ahwb);
+
+  // Allocates a new GPU-sampleable and renderable AHWB.
+  GpuBufferStorageAhwb(int width, int height, GpuBufferFormat format);
+  GpuBufferStorageAhwb(HardwareBuffer hardware_buffer, GpuBufferFormat format);
+  ~GpuBufferStorageAhwb() override;
+
+  int width() const { return hardware_buffer_.spec().width; }
+  int height() const { return hardware_buffer_.spec().height; }
+  GpuBufferFormat format() const { return format_; }
+
+  GlTextureView GetReadView(internal::types<GlTextureView>,
+                            int plane) const override;
+  GlTextureView GetWriteView(internal::types<GlTextureView>,
+                             int plane) override;
+
+  // Waits for pending GPU writes before handing out the buffer.
+  const AhwbView GetReadView(internal::types<AhwbView>) const override;
+  // Additionally waits for pending GPU reads.
+  AhwbView GetWriteView(internal::types<AhwbView>) override;
+
+ private:
+  // Returns the texture bound to this buffer in the current GL context,
+  // importing it on first use.
+  GLuint GetOrCreateTexture(const std::shared_ptr<GlContext>& gl_context) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  GlTextureView GetTexture(int plane, bool for_writing) const;
+
+  HardwareBuffer hardware_buffer_;
+  const GpuBufferFormat format_;
+
+  mutable absl::Mutex mutex_;
+  // The texture is only valid in the context that created it.
+  mutable std::shared_ptr<GlContext> gl_context_ ABSL_GUARDED_BY(mutex_);
+  mutable EGLImageKHR egl_image_ ABSL_GUARDED_BY(mutex_) = EGL_NO_IMAGE_KHR;
+  mutable GLuint texture_ ABSL_GUARDED_BY(mutex_) = 0;
+  // Tracks the last GPU write, and the GPU reads that followed it.
+  mutable std::shared_ptr<GlSyncPoint> producer_sync_ ABSL_GUARDED_BY(mutex_);
+  mutable std::unique_ptr<GlMultiSyncPoint> consumer_multi_sync_
+      ABSL_GUARDED_BY(mutex_) = std::make_unique<GlMultiSyncPoint>();
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_GPU_BUFFER_USE_AHWB
+#endif  // MEDIAPIPE_GPU_GPU_BUFFER_STORAGE_AHWB_H_
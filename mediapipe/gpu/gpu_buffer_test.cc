@@ -22,6 +22,7 @@
 #include "mediapipe/framework/tool/test_util.h"
 #include "mediapipe/gpu/gl_texture_buffer.h"
 #include "mediapipe/gpu/gl_texture_util.h"
+#include "mediapipe/gpu/gpu_buffer_conversion.h"
 #include "mediapipe/gpu/gpu_buffer_storage_ahwb.h"
 #include "mediapipe/gpu/gpu_buffer_storage_image_frame.h"
 #include "mediapipe/gpu/gpu_test_base.h"
@@ -252,5 +253,22 @@ TEST_F(GpuBufferTest, CopiesShareConversions) {
             buffer.internal_storage<GlTextureBuffer>());
 }
 
+TEST_F(GpuBufferTest, GuardReportsConversionsInGlContext) {
+  GpuBuffer buffer(300, 200, GpuBufferFormat::kBGRA32);
+  {
+    std::shared_ptr<ImageFrame> view = buffer.GetWriteView<ImageFrame>();
+    FillImageFrameRGBA(*view, 255, 0, 0, 255);
+  }
+
+  GpuBufferConversionGuard guard;
+  MP_EXPECT_OK(guard.status());
+  RunInGlContext([&buffer] {
+    TempGlFramebuffer fb;
+    auto view = buffer.GetReadView<GlTextureView>(0);
+  });
+
+  EXPECT_EQ(guard.status().code(), absl::StatusCode::kFailedPrecondition);
+}
+
 }  // anonymous namespace
 }  // namespace mediapipe
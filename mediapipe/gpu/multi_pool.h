@@ -15,7 +15,9 @@
 #ifndef MEDIAPIPE_GPU_MULTI_POOL_H_
 #define MEDIAPIPE_GPU_MULTI_POOL_H_
 
+#include <cstdint>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -45,6 +47,19 @@ struct MultiPoolOptions {
 
 static constexpr MultiPoolOptions kDefaultMultiPoolOptions;
 
+// Cumulative counters describing how well a MultiPool is reusing items.
+struct MultiPoolStats {
+  // Number of items requested.
+  int64_t requests = 0;
+  // Requests served by a simple pool, possibly with a recycled item.
+  int64_t pool_hits = 0;
+  // Requests for a spec without a simple pool, which always allocate.
+  int64_t pool_misses = 0;
+  // Number of simple pools created and dropped.
+  int64_t pools_created = 0;
+  int64_t pools_evicted = 0;
+};
+
 // MultiPool is a generic class for vending reusable resources of type Item,
 // which are assumed to be relatively expensive to create, so that reusing them
 // is beneficial.
@@ -73,6 +88,17 @@ class MultiPool {
   // Obtains an item. May either be reused or created anew.
   absl::StatusOr<Item> Get(const Spec& spec);
 
+  // Drops the least requested simple pools until at most max_pool_count are
+  // left, releasing their available items. Items currently in use stay valid
+  // and are destroyed once released. Call with 0 under memory pressure to free
+  // everything that is not in use.
+  void Trim(int max_pool_count);
+
+  MultiPoolStats GetStats() {
+    absl::MutexLock lock(&mutex_);
+    return stats_;
+  }
+
  private:
   static std::shared_ptr<SimplePool> DefaultMakeSimplePool(
       const Spec& spec, const MultiPoolOptions& options) {
@@ -84,11 +110,20 @@ class MultiPool {
   // pool, in which case the caller should invoke CreateBufferWithoutPool.
   std::shared_ptr<SimplePool> RequestPool(const Spec& spec);
 
+  // Cache entries may not have a pool yet; only actual pools are counted.
+  void CountEvicted(const std::vector<std::shared_ptr<SimplePool>>& evicted)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    for (const auto& pool : evicted) {
+      if (pool) ++stats_.pools_evicted;
+    }
+  }
+
   absl::Mutex mutex_;
   mediapipe::ResourceCache<Spec, std::shared_ptr<SimplePool>> cache_
       ABSL_GUARDED_BY(mutex_);
   SimplePoolFactory create_simple_pool_ = DefaultMakeSimplePool;
   MultiPoolOptions options_;
+  MultiPoolStats stats_ ABSL_GUARDED_BY(mutex_);
 };
 
 template <class SimplePool, class Spec, class Item>
@@ -98,19 +133,36 @@ std::shared_ptr<SimplePool> MultiPool<SimplePool, Spec, Item>::RequestPool(
   std::vector<std::shared_ptr<SimplePool>> evicted;
   {
     absl::MutexLock lock(&mutex_);
-    pool = cache_.Lookup(spec, [this](const Spec& spec, int request_count) {
-      return (request_count >= options_.min_requests_before_pool)
-                 ? create_simple_pool_(spec, options_)
-                 : nullptr;
+    bool created = false;
+    pool = cache_.Lookup(spec, [this, &created](const Spec& spec,
+                                                int request_count) {
+      created = request_count >= options_.min_requests_before_pool;
+      return created ? create_simple_pool_(spec, options_) : nullptr;
     });
+    if (created) ++stats_.pools_created;
     evicted = cache_.Evict(options_.max_pool_count,
                            options_.request_count_scrub_interval);
+    ++stats_.requests;
+    ++(pool ? stats_.pool_hits : stats_.pool_misses);
+    CountEvicted(evicted);
   }
   // Evicted pools, and their buffers, will be released without holding the
   // lock.
   return pool;
 }
 
+template <class SimplePool, class Spec, class Item>
+void MultiPool<SimplePool, Spec, Item>::Trim(int max_pool_count) {
+  std::vector<std::shared_ptr<SimplePool>> evicted;
+  {
+    absl::MutexLock lock(&mutex_);
+    evicted = cache_.Evict(max_pool_count,
+                           /*request_count_scrub_interval=*/
+                           std::numeric_limits<int>::max());
+    CountEvicted(evicted);
+  }
+}
+
 template <class SimplePool, class Spec, class Item>
 absl::StatusOr<Item> MultiPool<SimplePool, Spec, Item>::Get(const Spec& spec) {
   std::shared_ptr<SimplePool> pool = RequestPool(spec);
@@ -1,6 +1,10 @@
 #include <webgpu/webgpu_cpp.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/gpu/webgpu/webgpu_service.h"
@@ -108,4 +112,64 @@ Tensor::WebGpuTexture2dView Tensor::GetWebGpuTexture2dWriteView(
   return {webgpu_texture2d_, std::move(lock)};
 }
 
+namespace {
+
+constexpr wgpu::BufferUsage kBufferUsage = wgpu::BufferUsage::Storage |
+                                           wgpu::BufferUsage::CopySrc |
+                                           wgpu::BufferUsage::CopyDst;
+
+wgpu::Buffer CreateWebGpuBuffer(const wgpu::Device& device, uint64_t size) {
+  // Buffer sizes used in copies and bindings must be a multiple of 4.
+  const wgpu::BufferDescriptor desc = {
+      .usage = kBufferUsage,
+      .size = (size + 3) / 4 * 4,
+  };
+  return device.CreateBuffer(&desc);
+}
+
+}  // namespace
+
+Tensor::WebGpuBufferView Tensor::GetWebGpuBufferReadView(
+    const WebGpuService& service) const {
+  ABSL_QCHECK_NE(valid_, kValidNone)
+      << "Tensor must be written prior to read from.";
+  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  if (!(valid_ & kValidWebGpuBuffer)) {
+    ABSL_QCHECK(valid_ & kValidCpu)
+        << "Cannot get a WebGPU buffer read view into a tensor that is "
+           "neither a valid CPU or WebGPU buffer tensor.";
+    const wgpu::Device& device = service.device();
+    if (!webgpu_buffer_) {
+      webgpu_buffer_ = CreateWebGpuBuffer(device, bytes());
+    }
+    // WriteBuffer sizes must be a multiple of 4.
+    const size_t padded_size = (bytes() + 3) / 4 * 4;
+    if (padded_size == bytes()) {
+      device.GetQueue().WriteBuffer(webgpu_buffer_, 0, cpu_buffer_, bytes());
+    } else {
+      std::vector<uint8_t> padded(padded_size);
+      std::memcpy(padded.data(), cpu_buffer_, bytes());
+      device.GetQueue().WriteBuffer(webgpu_buffer_, 0, padded.data(),
+                                    padded_size);
+    }
+    webgpu_device_ = device;
+    valid_ |= kValidWebGpuBuffer;
+  }
+  return {webgpu_buffer_, std::move(lock)};
+}
+
+Tensor::WebGpuBufferView Tensor::GetWebGpuBufferWriteView(
+    const WebGpuService& service) const {
+  const wgpu::Device& device = service.device();
+  ABSL_QCHECK(device)
+      << "WebGpuBufferView: a valid wgpu device must be provided.";
+  auto lock = std::make_unique<absl::MutexLock>(&view_mutex_);
+  if (!webgpu_buffer_) {
+    webgpu_device_ = device;
+    webgpu_buffer_ = CreateWebGpuBuffer(device, bytes());
+  }
+  valid_ = kValidWebGpuBuffer;
+  return {webgpu_buffer_, std::move(lock)};
+}
+
 }  // namespace mediapipe
@@ -8,7 +8,9 @@
 #endif
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -186,6 +188,37 @@ absl::Status GetTexture2dData(const wgpu::Device& device,
   return absl::OkStatus();
 }
 
+absl::Status GetBufferData(const wgpu::Device& device, const wgpu::Queue& queue,
+                           const wgpu::Buffer& buffer, uint64_t size,
+                           uint8_t* dst) {
+  if (!IsJspiAvailable()) {
+    return absl::UnimplementedError("GetBufferData requires JSPI.");
+  }
+  // Storage buffers cannot be mapped, so go through a staging buffer. Copy
+  // sizes must be a multiple of 4.
+  const uint64_t copy_size = (size + 3) / 4 * 4;
+  wgpu::BufferDescriptor buffer_descriptor = {
+      .usage = wgpu::BufferUsage::MapRead | wgpu::BufferUsage::CopyDst,
+      .size = copy_size};
+  wgpu::Buffer staging_buffer = device.CreateBuffer(&buffer_descriptor);
+
+  auto command_encoder = device.CreateCommandEncoder({});
+  command_encoder.CopyBufferToBuffer(buffer, 0, staging_buffer, 0, copy_size);
+  wgpu::CommandBuffer copy_command_buffer = command_encoder.Finish();
+  queue.Submit(1, &copy_command_buffer);
+
+  if (copy_size == size) {
+    mediapipe_map_buffer_jspi(staging_buffer.Get(), dst);
+  } else {
+    std::vector<uint8_t> padded(copy_size);
+    mediapipe_map_buffer_jspi(staging_buffer.Get(), padded.data());
+    std::memcpy(dst, padded.data(), size);
+  }
+  staging_buffer.Destroy();
+
+  return absl::OkStatus();
+}
+
 #endif  // __EMSCRIPTEN__
 
 }  // namespace mediapipe
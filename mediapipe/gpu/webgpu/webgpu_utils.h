@@ -36,6 +36,12 @@ absl::Status GetTexture2dData(const wgpu::Device& device,
                               const wgpu::Texture& texture, uint32_t width,
                               uint32_t height, uint32_t bytes_per_row,
                               uint8_t* dst);
+
+// Copies the first `size` bytes of `buffer`, which needs CopySrc usage, to
+// `dst`. Blocks until the GPU is done writing to it.
+absl::Status GetBufferData(const wgpu::Device& device, const wgpu::Queue& queue,
+                           const wgpu::Buffer& buffer, uint64_t size,
+                           uint8_t* dst);
 #endif  // __EMSCRIPTEN__
 
 }  // namespace mediapipe
@@ -26,6 +26,7 @@
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status.h"
+#include "mediapipe/gpu/dirty_rect.h"
 #include "mediapipe/gpu/gl_calculator_helper.h"
 #include "mediapipe/gpu/shader_util.h"
 #include "mediapipe/graphs/object_detection_3d/calculators/gl_animation_overlay_calculator.pb.h"
@@ -121,6 +122,10 @@ struct TriangleMesh {
   std::unique_ptr<float[]> vertices = nullptr;
   std::unique_ptr<float[]> texture_coords = nullptr;
   std::unique_ptr<int16_t[]> triangle_indices = nullptr;
+  // Object space bounds of the vertices, used to limit rendering to the
+  // screen region covered by the mesh.
+  float bounds_min[3] = {0.0f, 0.0f, 0.0f};
+  float bounds_max[3] = {0.0f, 0.0f, 0.0f};
 };
 
 typedef std::unique_ptr<float[]> ModelMatrix;
@@ -426,6 +431,9 @@ bool GlAnimationOverlayCalculator::LoadAnimationAndroid(
 
     // Set the normals for this triangle_mesh
     CalculateTriangleMeshNormals(lengths[0], &triangle_mesh);
+    ComputeVertexBounds(triangle_mesh.vertices.get(), lengths[0] / 3,
+                        /*stride=*/3, /*position_size=*/3,
+                        triangle_mesh.bounds_min, triangle_mesh.bounds_max);
 
     frame_count_++;
   }
@@ -495,6 +503,9 @@ bool GlAnimationOverlayCalculator::LoadAnimation(const std::string &filename) {
 
     // Set the normals for this triangle_mesh
     CalculateTriangleMeshNormals(lengths[0], &triangle_mesh);
+    ComputeVertexBounds(triangle_mesh.vertices.get(), lengths[0] / 3,
+                        /*stride=*/3, /*position_size=*/3,
+                        triangle_mesh.bounds_min, triangle_mesh.bounds_max);
 
     frame_count_++;
   }
@@ -708,6 +719,34 @@ absl::Status GlAnimationOverlayCalculator::Process(CalculatorContext *cc) {
     if (status != GL_FRAMEBUFFER_COMPLETE) {
       ABSL_LOG(ERROR) << "Incomplete framebuffer with status: " << status;
     }
+
+    int frame_index = GetAnimationFrameIndex(cc->InputTimestamp());
+    const TriangleMesh &current_frame = triangle_meshes_[frame_index];
+
+    // Only the screen region covered by the objects and occlusion masks is
+    // rendered; the rest of the frame is passed through untouched. Limiting
+    // the depth clear and draw passes to it avoids a full-frame depth clear
+    // on mobile GPUs, and culls all passes when no object is visible.
+    DirtyRect dirty_rect(width, height);
+    if (has_occlusion_mask_) {
+      const TriangleMesh &mask_frame = mask_meshes_.front();
+      for (const ModelMatrix &model_matrix : current_mask_model_matrices_) {
+        dirty_rect.AddBox(perspective_matrix_, model_matrix.get(),
+                          mask_frame.bounds_min, mask_frame.bounds_max);
+      }
+    }
+    if (has_model_matrix_stream_) {
+      for (const ModelMatrix &model_matrix : current_model_matrices_) {
+        dirty_rect.AddBox(perspective_matrix_, model_matrix.get(),
+                          current_frame.bounds_min, current_frame.bounds_max);
+      }
+    } else {
+      dirty_rect.AddBox(perspective_matrix_, kModelMatrix,
+                        current_frame.bounds_min, current_frame.bounds_max);
+    }
+    const PixelRect scissor = dirty_rect.Rect();
+    GLCHECK(glEnable(GL_SCISSOR_TEST));
+    GLCHECK(glScissor(scissor.x, scissor.y, scissor.width, scissor.height));
     GLCHECK(glClear(GL_DEPTH_BUFFER_BIT));
 
     if (has_occlusion_mask_) {
@@ -721,8 +760,6 @@ absl::Status GlAnimationOverlayCalculator::Process(CalculatorContext *cc) {
     }
 
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-    int frame_index = GetAnimationFrameIndex(cc->InputTimestamp());
-    const TriangleMesh &current_frame = triangle_meshes_[frame_index];
 
     // Load dynamic texture if it exists
     if (cc->Inputs().HasTag("TEXTURE")) {
@@ -747,8 +784,9 @@ absl::Status GlAnimationOverlayCalculator::Process(CalculatorContext *cc) {
     GLCHECK(glDisableVertexAttribArray(ATTRIB_TEXTURE_POSITION));
     GLCHECK(glDisableVertexAttribArray(ATTRIB_NORMAL));
 
-    // Disable depth test
+    // Disable depth and scissor tests
     GLCHECK(glDisable(GL_DEPTH_TEST));
+    GLCHECK(glDisable(GL_SCISSOR_TEST));
 
     // Unbind texture
     GLCHECK(glActiveTexture(GL_TEXTURE1));
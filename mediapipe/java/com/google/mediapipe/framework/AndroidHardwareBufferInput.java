@@ -0,0 +1,70 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.google.mediapipe.framework;
+
+import android.view.Surface;
+
+/**
+ * Feeds frames rendered to a {@link Surface} into a graph input stream without copying them.
+ *
+ * <p>The surface is backed by a native {@code AImageReader}. Every frame written to it, for example
+ * by a camera capture session, is sent to the input stream as a {@code GpuBuffer} that wraps the
+ * frame's {@code AHardwareBuffer}. GL calculators sample that buffer directly, so no texture
+ * conversion pass or Java GL thread is involved. The packet timestamp is the frame timestamp in
+ * microseconds.
+ *
+ * <p>Frames use the RGBA_8888 format and require Android API 26. At most {@code maxImages} frames
+ * can be in flight in the graph; frames produced while that many are held are dropped.
+ *
+ * <p>The input must be closed before the graph is torn down.
+ */
+public class AndroidHardwareBufferInput implements AutoCloseable {
+  private long nativeHandle;
+
+  /**
+   * Creates an input feeding {@code streamName} of {@code graph}, which should be running before
+   * frames are produced.
+   */
+  public static AndroidHardwareBufferInput create(
+      Graph graph, String streamName, int width, int height, int maxImages) {
+    return new AndroidHardwareBufferInput(
+        nativeCreate(graph.getNativeHandle(), streamName, width, height, maxImages));
+  }
+
+  private AndroidHardwareBufferInput(long nativeHandle) {
+    this.nativeHandle = nativeHandle;
+  }
+
+  /** Returns the surface that frame producers should render into. */
+  public Surface getSurface() {
+    return (Surface) nativeGetSurface(nativeHandle);
+  }
+
+  /** Stops feeding frames. Frames already in the graph remain valid. */
+  @Override
+  public void close() {
+    if (nativeHandle != 0) {
+      nativeRelease(nativeHandle);
+      nativeHandle = 0;
+    }
+  }
+
+  private static native long nativeCreate(
+      long context, String streamName, int width, int height, int maxImages);
+
+  private static native Object nativeGetSurface(long nativeHandle);
+
+  private static native void nativeRelease(long nativeHandle);
+}
@@ -0,0 +1,40 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+package com.google.mediapipe.framework;
+
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Adapts a {@link PacketListCallback} to the batched native callback, which passes the packets of
+ * all streams as one array of native packet handles instead of creating each Java {@link Packet}
+ * through JNI.
+ */
+final class BatchedPacketListCallback {
+  private final PacketListCallback callback;
+
+  BatchedPacketListCallback(PacketListCallback callback) {
+    this.callback = callback;
+  }
+
+  // Called from native code. The handles are released once this returns.
+  void process(long[] packetHandles) {
+    List<Packet> packets = new ArrayList<>(packetHandles.length);
+    for (long handle : packetHandles) {
+      packets.add(Packet.create(handle));
+    }
+    callback.process(packets);
+  }
+}
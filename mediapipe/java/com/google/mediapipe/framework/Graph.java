@@ -209,6 +209,34 @@ public class Graph {
     nativeAddMultiStreamCallback(nativeGraphHandle, streamNames, callback, observeTimestampBounds);
   }
 
+  /**
+   * Adds a {@link PacketListCallback} that is invoked with a single JNI call per timestamp.
+   *
+   * <p>Unlike {@link #addMultiStreamCallback}, the native side passes the packets of all streams as
+   * one reused array of packet handles, so the per-frame JNI overhead does not grow with the number
+   * of streams. As with the other callbacks, the packets are only valid during the call; use {@link
+   * Packet#copy} to keep one.
+   *
+   * @param streamNames The output stream names in the graph for callback.
+   * @param callback The callback for handling the call when all output streams listed in
+   *     streamNames get {@link Packet}.
+   * @param observeTimestampBounds Whether to output an empty packet when a timestamp bound change
+   *     is observed with no output data.
+   * @throws MediaPipeException for any error status.
+   */
+  public synchronized void addMultiStreamBatchCallback(
+      List<String> streamNames, PacketListCallback callback, boolean observeTimestampBounds) {
+    Preconditions.checkState(
+        nativeGraphHandle != 0, "Invalid context, tearDown() might have been called already.");
+    Preconditions.checkNotNull(streamNames);
+    Preconditions.checkNotNull(callback);
+    Preconditions.checkState(!graphRunning && !startRunningGraphCalled);
+    BatchedPacketListCallback batchedCallback = new BatchedPacketListCallback(callback);
+    callbacks.add(batchedCallback);
+    nativeAddMultiStreamBatchCallback(
+        nativeGraphHandle, streamNames, batchedCallback, observeTimestampBounds);
+  }
+
   /**
    * Adds a {@link SurfaceOutput} for a stream producing GpuBuffers.
    *
@@ -640,6 +668,12 @@ public class Graph {
       PacketListCallback callback,
       boolean observeTimestampBounds);
 
+  private native void nativeAddMultiStreamBatchCallback(
+      long context,
+      List<String> streamName,
+      BatchedPacketListCallback callback,
+      boolean observeTimestampBounds);
+
   private native long nativeAddSurfaceOutput(long context, String streamName);
 
   private native void nativeLoadBinaryGraph(long context, String path);
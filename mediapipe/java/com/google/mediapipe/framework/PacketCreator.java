@@ -18,6 +18,7 @@ import com.google.mediapipe.framework.ProtoUtil.SerializedMessage;
 import com.google.protobuf.MessageLite;
 import java.nio.ByteBuffer;
 import java.nio.FloatBuffer;
+import javax.annotation.Nullable;
 
 // TODO: use Preconditions in this file.
 /**
@@ -185,6 +186,62 @@ public class PacketCreator {
         nativeCreateFloatImageFrame(mediapipeGraph.getNativeHandle(), buffer, width, height));
   }
 
+  /**
+   * Creates a 4 channel RGBA ImageFrame packet that uses the memory of an RGBA buffer directly,
+   * without copying it.
+   *
+   * <p>Use {@link ByteBuffer#allocateDirect} when allocating the buffer. The buffer must not be
+   * modified until MediaPipe releases it, which is signaled by running {@code releaseCallback} on
+   * an arbitrary thread. Pass {@code null} if the buffer is never reused.
+   */
+  public Packet createRgbaImageFrameNoCopy(
+      ByteBuffer buffer, int width, int height, @Nullable Runnable releaseCallback) {
+    if (buffer.capacity() != width * height * 4) {
+      throw new IllegalArgumentException(
+          "The size of the buffer should be: "
+              + width * height * 4
+              + " but is "
+              + buffer.capacity());
+    }
+    return Packet.create(
+        nativeCreateRgbaImageFrameNoCopy(
+            mediapipeGraph.getNativeHandle(), buffer, width, height, releaseCallback));
+  }
+
+  /**
+   * Creates a 1 channel ImageFrame packet that uses the memory of an U8 buffer directly, without
+   * copying it. See {@link #createRgbaImageFrameNoCopy} for the buffer lifetime rules.
+   */
+  public Packet createGrayscaleImageNoCopy(
+      ByteBuffer buffer, int width, int height, @Nullable Runnable releaseCallback) {
+    if (width * height != buffer.capacity()) {
+      throw new IllegalArgumentException(
+          "The size of the buffer should be: " + width * height + " but is " + buffer.capacity());
+    }
+    return Packet.create(
+        nativeCreateGrayscaleImageNoCopy(
+            mediapipeGraph.getNativeHandle(), buffer, width, height, releaseCallback));
+  }
+
+  /**
+   * Creates a 1 channel float ImageFrame packet that uses the memory of a buffer of native-order
+   * floats directly, without copying it. See {@link #createRgbaImageFrameNoCopy} for the buffer
+   * lifetime rules.
+   */
+  public Packet createFloatImageFrameNoCopy(
+      ByteBuffer buffer, int width, int height, @Nullable Runnable releaseCallback) {
+    if (buffer.capacity() != width * height * 4) {
+      throw new IllegalArgumentException(
+          "The size of the buffer should be: "
+              + width * height * 4
+              + " but is "
+              + buffer.capacity());
+    }
+    return Packet.create(
+        nativeCreateFloatImageFrameNoCopy(
+            mediapipeGraph.getNativeHandle(), buffer, width, height, releaseCallback));
+  }
+
   public Packet createInt16(short value) {
     return Packet.create(nativeCreateInt16(mediapipeGraph.getNativeHandle(), value));
   }
@@ -421,6 +478,15 @@ public class PacketCreator {
   private native long nativeCreateFloatImageFrame(
       long context, FloatBuffer buffer, int width, int height);
 
+  private native long nativeCreateRgbaImageFrameNoCopy(
+      long context, ByteBuffer buffer, int width, int height, Runnable releaseCallback);
+
+  private native long nativeCreateGrayscaleImageNoCopy(
+      long context, ByteBuffer buffer, int width, int height, Runnable releaseCallback);
+
+  private native long nativeCreateFloatImageFrameNoCopy(
+      long context, ByteBuffer buffer, int width, int height, Runnable releaseCallback);
+
   private native long nativeCreateInt16(long context, short value);
 
   private native long nativeCreateInt32(long context, int value);
@@ -163,6 +163,16 @@ public final class PacketGetter {
     return nativeGetFloat32Vector(packet.getNativeHandle());
   }
 
+  /**
+   * Copies the float vector into a buffer of exactly 4 bytes per value, in native byte order,
+   * without allocating a Java array.
+   *
+   * <p>Use {@link ByteBuffer#allocateDirect} when allocating the buffer.
+   */
+  public static boolean getFloat32Vector(final Packet packet, ByteBuffer buffer) {
+    return nativeGetFloat32VectorDirect(packet.getNativeHandle(), buffer);
+  }
+
   public static double[] getFloat64Vector(final Packet packet) {
     return nativeGetFloat64Vector(packet.getNativeHandle());
   }
@@ -282,6 +292,16 @@ public final class PacketGetter {
     return nativeGetAudioData(packet.getNativeHandle());
   }
 
+  /**
+   * Converts the audio matrix data into 16-bit samples written to a buffer of exactly {@code 2 *
+   * channels * samples} bytes, without allocating a Java array.
+   *
+   * <p>Use {@link ByteBuffer#allocateDirect} when allocating the buffer.
+   */
+  public static boolean getAudioByteData(final Packet packet, ByteBuffer buffer) {
+    return nativeGetAudioDataDirect(packet.getNativeHandle(), buffer);
+  }
+
   /**
    * Audio data is in MediaPipe Matrix format.
    *
@@ -339,6 +359,16 @@ public final class PacketGetter {
     return nativeGetMatrixData(packet.getNativeHandle());
   }
 
+  /**
+   * Copies the column major data of the mediapipe Matrix into a buffer of exactly {@code 4 * rows *
+   * cols} bytes, in native byte order, without allocating a Java array.
+   *
+   * <p>Use {@link ByteBuffer#allocateDirect} when allocating the buffer.
+   */
+  public static boolean getMatrixData(final Packet packet, ByteBuffer buffer) {
+    return nativeGetMatrixDataDirect(packet.getNativeHandle(), buffer);
+  }
+
   public static int getMatrixRows(final Packet packet) {
     return nativeGetMatrixRows(packet.getNativeHandle());
   }
@@ -419,6 +449,9 @@ public final class PacketGetter {
 
   private static native float[] nativeGetFloat32Vector(long nativePacketHandle);
 
+  private static native boolean nativeGetFloat32VectorDirect(
+      long nativePacketHandle, ByteBuffer buffer);
+
   private static native double[] nativeGetFloat64Vector(long nativePacketHandle);
 
   private static native byte[][] nativeGetProtoVector(long nativePacketHandle);
@@ -454,9 +487,15 @@ public final class PacketGetter {
 
   // Audio data in MediaPipe current uses MediaPipe Matrix format type.
   private static native byte[] nativeGetAudioData(long nativePacketHandle);
+
+  private static native boolean nativeGetAudioDataDirect(
+      long nativePacketHandle, ByteBuffer buffer);
   // Native helper functions to access the MediaPipe Matrix data.
   private static native float[] nativeGetMatrixData(long nativePacketHandle);
 
+  private static native boolean nativeGetMatrixDataDirect(
+      long nativePacketHandle, ByteBuffer buffer);
+
   private static native int nativeGetMatrixRows(long nativePacketHandle);
 
   private static native int nativeGetMatrixCols(long nativePacketHandle);
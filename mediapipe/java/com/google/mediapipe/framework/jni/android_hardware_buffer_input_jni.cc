@@ -0,0 +1,197 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/java/com/google/mediapipe/framework/jni/android_hardware_buffer_input_jni.h"
+
+#include "mediapipe/framework/port.h"
+
+#if defined(MEDIAPIPE_GPU_BUFFER_USE_AHWB) && !MEDIAPIPE_DISABLE_GPU
+#include <android/hardware_buffer.h>
+#include <android/native_window_jni.h>
+#include <media/NdkImage.h>
+#include <media/NdkImageReader.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/log/absl_log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/timestamp.h"
+#include "mediapipe/gpu/gpu_buffer.h"
+#include "mediapipe/gpu/gpu_buffer_storage_ahwb.h"
+#include "mediapipe/java/com/google/mediapipe/framework/jni/graph.h"
+#include "mediapipe/java/com/google/mediapipe/framework/jni/jni_util.h"
+
+namespace {
+
+using mediapipe::GpuBuffer;
+using mediapipe::GpuBufferStorageAhwb;
+using mediapipe::android::Graph;
+
+// Feeds the frames written to an AImageReader surface into a graph input
+// stream. Each frame is wrapped in a GpuBuffer backed by the image's
+// AHardwareBuffer, so GL calculators sample the producer's buffer directly:
+// there is no copy into a GL texture and no hop through a Java GL thread.
+// Frames are delivered on the image reader's own callback thread.
+//
+// An image is returned to the reader once every packet referencing it is
+// released. When "max_images" images are still held downstream, newly
+// produced frames are dropped.
+class HardwareBufferInput {
+ public:
+  static absl::StatusOr<std::unique_ptr<HardwareBufferInput>> Create(
+      Graph* graph, std::string stream_name, int width, int height,
+      int max_images) {
+    AImageReader* reader = nullptr;
+    media_status_t status = AImageReader_newWithUsage(
+        width, height, AIMAGE_FORMAT_RGBA_8888,
+        AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE, max_images, &reader);
+    if (status != AMEDIA_OK) {
+      return absl::InternalError(
+          absl::StrCat("AImageReader_newWithUsage failed: ", status));
+    }
+    // Images hold a reference to the reader, so that it outlives them.
+    std::shared_ptr<AImageReader> shared_reader(reader, AImageReader_delete);
+    auto input = std::unique_ptr<HardwareBufferInput>(new HardwareBufferInput(
+        graph, std::move(stream_name), std::move(shared_reader)));
+    AImageReader_ImageListener listener{input.get(),
+                                        &HardwareBufferInput::OnImage};
+    status = AImageReader_setImageListener(reader, &listener);
+    if (status != AMEDIA_OK) {
+      return absl::InternalError(
+          absl::StrCat("AImageReader_setImageListener failed: ", status));
+    }
+    return input;
+  }
+
+  ~HardwareBufferInput() {
+    AImageReader_setImageListener(reader_.get(), nullptr);
+  }
+
+  // Returns the window that the producer renders into; owned by the reader.
+  ANativeWindow* GetWindow() {
+    ANativeWindow* window = nullptr;
+    AImageReader_getWindow(reader_.get(), &window);
+    return window;
+  }
+
+ private:
+  HardwareBufferInput(Graph* graph, std::string stream_name,
+                      std::shared_ptr<AImageReader> reader)
+      : graph_(graph),
+        stream_name_(std::move(stream_name)),
+        reader_(std::move(reader)) {}
+
+  static void OnImage(void* context, AImageReader* reader) {
+    static_cast<HardwareBufferInput*>(context)->AddLatestImage();
+  }
+
+  void AddLatestImage() {
+    AImage* image = nullptr;
+    media_status_t status =
+        AImageReader_acquireLatestImage(reader_.get(), &image);
+    if (status != AMEDIA_OK) {
+      // Typically AMEDIA_IMGREADER_MAX_IMAGES_ACQUIRED: the graph still holds
+      // "max_images" frames, so this one is dropped.
+      VLOG(2) << "Dropping frame for " << stream_name_ << ": " << status;
+      return;
+    }
+    int64_t timestamp_ns = 0;
+    AHardwareBuffer* hardware_buffer = nullptr;
+    AImage_getTimestamp(image, &timestamp_ns);
+    AImage_getHardwareBuffer(image, &hardware_buffer);
+    auto storage_or = GpuBufferStorageAhwb::Wrap(hardware_buffer);
+    if (!storage_or.ok()) {
+      ABSL_LOG(ERROR) << "Cannot wrap image for " << stream_name_ << ": "
+                      << storage_or.status();
+      AImage_delete(image);
+      return;
+    }
+    // The aliasing deleter destroys the storage, and with it any texture
+    // bound to the buffer, before handing the image back to the reader.
+    std::shared_ptr<GpuBufferStorageAhwb> storage = *std::move(storage_or);
+    GpuBufferStorageAhwb* storage_ptr = storage.get();
+    std::shared_ptr<GpuBufferStorageAhwb> image_storage(
+        storage_ptr, [storage = std::move(storage), image,
+                      reader = reader_](GpuBufferStorageAhwb*) mutable {
+          storage.reset();
+          AImage_delete(image);
+        });
+    mediapipe::Packet packet =
+        mediapipe::MakePacket<GpuBuffer>(std::move(image_storage))
+            .At(mediapipe::Timestamp(timestamp_ns / 1000));
+    absl::Status add_status =
+        graph_->AddPacketToInputStream(stream_name_, std::move(packet));
+    if (!add_status.ok()) {
+      VLOG(2) << "Dropping frame for " << stream_name_ << ": " << add_status;
+    }
+  }
+
+  Graph* const graph_;
+  const std::string stream_name_;
+  const std::shared_ptr<AImageReader> reader_;
+};
+
+}  // namespace
+
+JNIEXPORT jlong JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeCreate)(
+    JNIEnv* env, jclass clazz, jlong context, jstring stream_name, jint width,
+    jint height, jint max_images) {
+  auto input_or = HardwareBufferInput::Create(
+      reinterpret_cast<Graph*>(context),
+      mediapipe::android::JStringToStdString(env, stream_name), width, height,
+      max_images);
+  if (mediapipe::android::ThrowIfError(env, input_or.status())) return 0L;
+  return reinterpret_cast<jlong>(input_or->release());
+}
+
+JNIEXPORT jobject JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(
+    nativeGetSurface)(JNIEnv* env, jclass clazz, jlong handle) {
+  auto* input = reinterpret_cast<HardwareBufferInput*>(handle);
+  return ANativeWindow_toSurface(env, input->GetWindow());
+}
+
+JNIEXPORT void JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeRelease)(
+    JNIEnv* env, jclass clazz, jlong handle) {
+  delete reinterpret_cast<HardwareBufferInput*>(handle);
+}
+
+#else  // defined(MEDIAPIPE_GPU_BUFFER_USE_AHWB) && !MEDIAPIPE_DISABLE_GPU
+
+#include "absl/status/status.h"
+#include "mediapipe/java/com/google/mediapipe/framework/jni/jni_util.h"
+
+JNIEXPORT jlong JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeCreate)(
+    JNIEnv* env, jclass clazz, jlong context, jstring stream_name, jint width,
+    jint height, jint max_images) {
+  mediapipe::android::ThrowIfError(
+      env, absl::UnimplementedError(
+               "AHardwareBuffer input requires Android API 26 and GPU "
+               "support."));
+  return 0L;
+}
+
+JNIEXPORT jobject JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(
+    nativeGetSurface)(JNIEnv* env, jclass clazz, jlong handle) {
+  return nullptr;
+}
+
+JNIEXPORT void JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeRelease)(
+    JNIEnv* env, jclass clazz, jlong handle) {}
+
+#endif  // defined(MEDIAPIPE_GPU_BUFFER_USE_AHWB) && !MEDIAPIPE_DISABLE_GPU
@@ -0,0 +1,45 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef JAVA_COM_GOOGLE_MEDIAPIPE_FRAMEWORK_JNI_ANDROID_HARDWARE_BUFFER_INPUT_JNI_H_
+#define JAVA_COM_GOOGLE_MEDIAPIPE_FRAMEWORK_JNI_ANDROID_HARDWARE_BUFFER_INPUT_JNI_H_
+
+#include <jni.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif  // __cplusplus
+
+#define ANDROID_HARDWARE_BUFFER_INPUT_METHOD(METHOD_NAME) \
+  Java_com_google_mediapipe_framework_AndroidHardwareBufferInput_##METHOD_NAME
+
+// Creates an input that feeds the frames written to its surface into
+// "stream_name" as AHardwareBuffer-backed GpuBuffers. Returns a native handle,
+// or 0 after throwing if the input cannot be created.
+JNIEXPORT jlong JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeCreate)(
+    JNIEnv* env, jclass clazz, jlong context, jstring stream_name, jint width,
+    jint height, jint max_images);
+
+// Returns the android.view.Surface that producers such as the camera write to.
+JNIEXPORT jobject JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(
+    nativeGetSurface)(JNIEnv* env, jclass clazz, jlong handle);
+
+JNIEXPORT void JNICALL ANDROID_HARDWARE_BUFFER_INPUT_METHOD(nativeRelease)(
+    JNIEnv* env, jclass clazz, jlong handle);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif  // __cplusplus
+
+#endif  // JAVA_COM_GOOGLE_MEDIAPIPE_FRAMEWORK_JNI_ANDROID_HARDWARE_BUFFER_INPUT_JNI_H_
@@ -40,6 +40,8 @@ class ClassRegistry {
       "com/google/mediapipe/framework/AndroidAssetUtil";
   static constexpr char const* kAndroidPacketCreatorClassName =
       "com/google/mediapipe/framework/AndroidPacketCreator";
+  static constexpr char const* kBatchedPacketListCallbackClassName =
+      "com/google/mediapipe/framework/BatchedPacketListCallback";
   static constexpr char const* kCompatClassName =
       "com/google/mediapipe/framework/Compat";
   static constexpr char const* kGraphClassName =
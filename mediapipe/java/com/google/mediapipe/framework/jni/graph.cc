@@ -105,6 +105,11 @@ class CallbackHandler {
                              packets);
   }
 
+  void PacketBatchCallback(const std::vector<Packet>& packets) {
+    context_->BatchCallbackToJava(mediapipe::java::GetJNIEnv(), java_callback_,
+                                  packets, &packet_handles_, &process_method_);
+  }
+
   std::function<void(const Packet&)> CreateCallback() {
     return std::bind(&CallbackHandler::PacketCallback, this,
                      std::placeholders::_1);
@@ -115,6 +120,11 @@ class CallbackHandler {
                      std::placeholders::_1);
   }
 
+  std::function<void(const std::vector<Packet>&)> CreatePacketBatchCallback() {
+    return std::bind(&CallbackHandler::PacketBatchCallback, this,
+                     std::placeholders::_1);
+  }
+
   std::function<void(const Packet&, const Packet&)> CreateCallbackWithHeader() {
     return std::bind(&CallbackHandler::PacketWithHeaderCallback, this,
                      std::placeholders::_1, std::placeholders::_2);
@@ -126,12 +136,19 @@ class CallbackHandler {
   void ReleaseCallback(JNIEnv* env) {
     env->DeleteGlobalRef(java_callback_);
     java_callback_ = nullptr;
+    if (packet_handles_) {
+      env->DeleteGlobalRef(packet_handles_);
+      packet_handles_ = nullptr;
+    }
   }
 
  private:
   Graph* context_;
   // java callback object
   jobject java_callback_;
+  // Reused by batched callbacks, see Graph::BatchCallbackToJava.
+  jlongArray packet_handles_ = nullptr;
+  jmethodID process_method_ = nullptr;
 };
 }  // namespace internal
 
@@ -229,6 +246,22 @@ absl::Status Graph::AddMultiStreamCallbackHandler(
   return absl::OkStatus();
 }
 
+absl::Status Graph::AddMultiStreamBatchCallbackHandler(
+    std::vector<std::string> output_stream_names, jobject java_callback,
+    bool observe_timestamp_bounds) {
+  if (!graph_config()) {
+    return absl::InternalError("Graph is not loaded!");
+  }
+  auto handler =
+      absl::make_unique<internal::CallbackHandler>(this, java_callback);
+  tool::AddMultiStreamCallback(
+      output_stream_names, handler->CreatePacketBatchCallback(),
+      graph_config(), &side_packets_, observe_timestamp_bounds);
+  EnsureMinimumExecutorStackSizeForJava();
+  callback_handlers_.emplace_back(std::move(handler));
+  return absl::OkStatus();
+}
+
 int64_t Graph::AddSurfaceOutput(const std::string& output_stream_name) {
   if (!graph_config()) {
     ABSL_LOG(ERROR) << "Graph is not loaded!";
@@ -408,6 +441,43 @@ void Graph::CallbackToJava(JNIEnv* env, jobject java_callback_obj,
   VLOG(2) << "Returned from java callback.";
 }
 
+void Graph::BatchCallbackToJava(JNIEnv* env, jobject java_callback_obj,
+                                const std::vector<Packet>& packets,
+                                jlongArray* packet_handles,
+                                jmethodID* process_method) {
+  const jsize num_packets = packets.size();
+  if (*process_method == nullptr) {
+    jclass callback_cls = env->GetObjectClass(java_callback_obj);
+    const std::string process_method_name =
+        ClassRegistry::GetInstance().GetMethodName(
+            ClassRegistry::kBatchedPacketListCallbackClassName, "process");
+    *process_method =
+        env->GetMethodID(callback_cls, process_method_name.c_str(), "([J)V");
+    env->DeleteLocalRef(callback_cls);
+  }
+  if (*packet_handles == nullptr ||
+      env->GetArrayLength(*packet_handles) != num_packets) {
+    if (*packet_handles) env->DeleteGlobalRef(*packet_handles);
+    jlongArray local_handles = env->NewLongArray(num_packets);
+    *packet_handles =
+        reinterpret_cast<jlongArray>(env->NewGlobalRef(local_handles));
+    env->DeleteLocalRef(local_handles);
+  }
+
+  std::vector<jlong> handles(num_packets);
+  for (jsize i = 0; i < num_packets; ++i) {
+    handles[i] = WrapPacketIntoContext(packets[i]);
+  }
+  env->SetLongArrayRegion(*packet_handles, 0, num_packets, handles.data());
+  VLOG(2) << "Calling java batched callback.";
+  env->CallVoidMethod(java_callback_obj, *process_method, *packet_handles);
+  // release the packets after callback.
+  for (jlong packet_handle : handles) {
+    RemovePacket(packet_handle);
+  }
+  VLOG(2) << "Returned from java batched callback.";
+}
+
 void Graph::SetPacketJavaClass(JNIEnv* env) {
   if (global_java_packet_cls_ == nullptr) {
     auto& class_registry = ClassRegistry::GetInstance();
@@ -62,6 +62,11 @@ class Graph {
   absl::Status AddMultiStreamCallbackHandler(
       std::vector<std::string> output_stream_names, jobject java_callback,
       bool observe_timestamp_bounds);
+  // Adds a callback for multiple output streams that receives all packets of
+  // a timestamp in a single JNI call, see BatchCallbackToJava.
+  absl::Status AddMultiStreamBatchCallbackHandler(
+      std::vector<std::string> output_stream_names, jobject java_callback,
+      bool observe_timestamp_bounds);
 
   // Loads a binary graph from a file.
   absl::Status LoadBinaryGraph(std::string path_to_graph);
@@ -173,6 +178,15 @@ class Graph {
   void CallbackToJava(JNIEnv* env, jobject java_callback_obj,
                       const std::vector<Packet>& packets);
 
+  // Invokes a Java batched packet list callback with a single JNI call. The
+  // callback's process(long[]) receives one packet handle per stream. The
+  // handle array and the method id are created on first use, stored in
+  // "packet_handles" and "process_method", and reused afterwards.
+  void BatchCallbackToJava(JNIEnv* env, jobject java_callback_obj,
+                           const std::vector<Packet>& packets,
+                           jlongArray* packet_handles,
+                           jmethodID* process_method);
+
 #ifdef MEDIAPIPE_PROFILER_AVAILABLE
   ProfilingContext* GetProfilingContext();
 #endif
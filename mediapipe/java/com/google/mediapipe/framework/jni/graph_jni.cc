@@ -220,6 +220,33 @@ JNIEXPORT void JNICALL GRAPH_METHOD(nativeAddMultiStreamCallback)(
                         observe_timestamp_bounds));
 }
 
+JNIEXPORT void JNICALL GRAPH_METHOD(nativeAddMultiStreamBatchCallback)(
+    JNIEnv* env, jobject thiz, jlong context, jobject stream_names,
+    jobject callback, jboolean observe_timestamp_bounds) {
+  mediapipe::android::Graph* mediapipe_graph =
+      reinterpret_cast<mediapipe::android::Graph*>(context);
+  std::vector<std::string> output_stream_names =
+      JavaListToStdStringVector(env, stream_names);
+  for (const std::string& s : output_stream_names) {
+    if (s.empty()) {
+      ThrowIfError(env,
+                   absl::InternalError("streamNames is not correctly parsed or "
+                                       "it contains empty string."));
+      return;
+    }
+  }
+
+  jobject global_callback_ref = env->NewGlobalRef(callback);
+  if (!global_callback_ref) {
+    ThrowIfError(env,
+                 absl::InternalError("Failed to allocate packets callback"));
+    return;
+  }
+  ThrowIfError(env, mediapipe_graph->AddMultiStreamBatchCallbackHandler(
+                        output_stream_names, global_callback_ref,
+                        observe_timestamp_bounds));
+}
+
 JNIEXPORT jlong JNICALL GRAPH_METHOD(nativeAddSurfaceOutput)(
     JNIEnv* env, jobject thiz, jlong context, jstring stream_name) {
   mediapipe::android::Graph* mediapipe_graph =
@@ -66,6 +66,10 @@ JNIEXPORT void JNICALL GRAPH_METHOD(nativeAddMultiStreamCallback)(
     JNIEnv* env, jobject thiz, jlong context, jobject stream_names,
     jobject callback, jboolean observe_timestamp_bounds);
 
+JNIEXPORT void JNICALL GRAPH_METHOD(nativeAddMultiStreamBatchCallback)(
+    JNIEnv* env, jobject thiz, jlong context, jobject stream_names,
+    jobject callback, jboolean observe_timestamp_bounds);
+
 JNIEXPORT jlong JNICALL GRAPH_METHOD(nativeAddSurfaceOutput)(
     JNIEnv* env, jobject thiz, jlong context, jstring stream_name);
 
@@ -141,6 +141,61 @@ CreateImageFrameFromByteBuffer(JNIEnv* env, jobject byte_buffer, jint width,
   return image_frame;
 }
 
+// Returns an ImageFrame deleter that keeps a Java direct buffer reachable
+// while the frame references its memory, and then runs the optional Java
+// Runnable "release_callback" so the caller knows it may reuse the buffer.
+// The deleter may run on any thread.
+mediapipe::ImageFrame::Deleter MakeDirectBufferDeleter(
+    JNIEnv* env, jobject byte_buffer, jobject release_callback) {
+  jobject buffer_ref = env->NewGlobalRef(byte_buffer);
+  jobject callback_ref =
+      release_callback ? env->NewGlobalRef(release_callback) : nullptr;
+  return [buffer_ref, callback_ref](uint8_t*) {
+    JNIEnv* env = mediapipe::java::GetJNIEnv();
+    if (env == nullptr) {
+      LOG(ERROR) << "Cannot release a direct buffer without a JNIEnv.";
+      return;
+    }
+    if (callback_ref != nullptr) {
+      jclass callback_class = env->GetObjectClass(callback_ref);
+      jmethodID run_method = env->GetMethodID(callback_class, "run", "()V");
+      env->CallVoidMethod(callback_ref, run_method);
+      if (env->ExceptionCheck()) {
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+      }
+      env->DeleteLocalRef(callback_class);
+      env->DeleteGlobalRef(callback_ref);
+    }
+    env->DeleteGlobalRef(buffer_ref);
+  };
+}
+
+// Like CreateImageFrameFromByteBuffer, but the ImageFrame points at the
+// memory of the Java direct buffer instead of copying it.
+absl::StatusOr<std::unique_ptr<mediapipe::ImageFrame>>
+WrapImageFrameAroundByteBuffer(JNIEnv* env, jobject byte_buffer,
+                               jobject release_callback, jint width,
+                               jint height, jint width_step,
+                               mediapipe::ImageFormat::Format format) {
+  const int64_t buffer_size = env->GetDirectBufferCapacity(byte_buffer);
+  void* buffer_data = env->GetDirectBufferAddress(byte_buffer);
+  if (buffer_data == nullptr || buffer_size < 0) {
+    return absl::InvalidArgumentError(
+        "Cannot get direct access to the input buffer. It should be created "
+        "using allocateDirect.");
+  }
+
+  const int expected_buffer_size = height * width_step;
+  RET_CHECK_EQ(buffer_size, expected_buffer_size)
+      << "Input buffer size should be " << expected_buffer_size
+      << " but is: " << buffer_size;
+
+  return std::make_unique<mediapipe::ImageFrame>(
+      format, width, height, width_step, static_cast<uint8_t*>(buffer_data),
+      MakeDirectBufferDeleter(env, byte_buffer, release_callback));
+}
+
 }  // namespace
 
 JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(nativeCreateReferencePacket)(
@@ -237,6 +292,42 @@ JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(nativeCreateRgbaImageFrame)(
   return CreatePacketWithContext(context, packet);
 }
 
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateRgbaImageFrameNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                      jobject byte_buffer, jint width,
+                                      jint height, jobject release_callback) {
+  auto image_frame_or = WrapImageFrameAroundByteBuffer(
+      env, byte_buffer, release_callback, width, height, width * 4,
+      mediapipe::ImageFormat::SRGBA);
+  if (ThrowIfError(env, image_frame_or.status())) return 0L;
+  mediapipe::Packet packet = mediapipe::Adopt(image_frame_or->release());
+  return CreatePacketWithContext(context, packet);
+}
+
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateGrayscaleImageNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                      jobject byte_buffer, jint width,
+                                      jint height, jobject release_callback) {
+  auto image_frame_or = WrapImageFrameAroundByteBuffer(
+      env, byte_buffer, release_callback, width, height, width,
+      mediapipe::ImageFormat::GRAY8);
+  if (ThrowIfError(env, image_frame_or.status())) return 0L;
+  mediapipe::Packet packet = mediapipe::Adopt(image_frame_or->release());
+  return CreatePacketWithContext(context, packet);
+}
+
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateFloatImageFrameNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                       jobject byte_buffer, jint width,
+                                       jint height, jobject release_callback) {
+  auto image_frame_or = WrapImageFrameAroundByteBuffer(
+      env, byte_buffer, release_callback, width, height, width * 4,
+      mediapipe::ImageFormat::VEC32F1);
+  if (ThrowIfError(env, image_frame_or.status())) return 0L;
+  mediapipe::Packet packet = mediapipe::Adopt(image_frame_or->release());
+  return CreatePacketWithContext(context, packet);
+}
+
 static mediapipe::Packet createAudioPacket(const uint8_t* audio_sample,
                                            int num_samples, int num_channels) {
   std::unique_ptr<mediapipe::Matrix> matrix(
@@ -39,6 +39,24 @@ JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(nativeCreateRgbaImageFrame)(
     JNIEnv* env, jobject thiz, jlong context, jobject byte_buffer, jint width,
     jint height);
 
+// The NoCopy variants wrap the memory of the direct buffer instead of copying
+// it. The optional Runnable "release_callback" is run, on an arbitrary
+// thread, once MediaPipe no longer references the buffer.
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateRgbaImageFrameNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                      jobject byte_buffer, jint width,
+                                      jint height, jobject release_callback);
+
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateGrayscaleImageNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                      jobject byte_buffer, jint width,
+                                      jint height, jobject release_callback);
+
+JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(
+    nativeCreateFloatImageFrameNoCopy)(JNIEnv* env, jobject thiz, jlong context,
+                                       jobject byte_buffer, jint width,
+                                       jint height, jobject release_callback);
+
 JNIEXPORT jlong JNICALL PACKET_CREATOR_METHOD(nativeCreateRgbImageFromRgba)(
     JNIEnv* env, jobject thiz, jlong context, jobject byte_buffer, jint width,
     jint height);
@@ -14,6 +14,8 @@
 
 #include "mediapipe/java/com/google/mediapipe/framework/jni/packet_getter_jni.h"
 
+#include <cstring>
+
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -87,6 +89,27 @@ bool CopyImageDataToByteBuffer(JNIEnv* env, const mediapipe::ImageFrame& image,
   return true;
 }
 
+// Returns the address of a direct ByteBuffer holding exactly
+// "expected_buffer_size" bytes, or throws and returns nullptr.
+void* GetDirectBufferOfSize(JNIEnv* env, jobject byte_buffer,
+                            int64_t expected_buffer_size) {
+  int64_t buffer_size = env->GetDirectBufferCapacity(byte_buffer);
+  void* buffer_data = env->GetDirectBufferAddress(byte_buffer);
+  if (buffer_data == nullptr || buffer_size < 0) {
+    ThrowIfError(env, absl::InvalidArgumentError(
+                          "input buffer does not support direct access"));
+    return nullptr;
+  }
+  if (buffer_size != expected_buffer_size) {
+    ThrowIfError(env, absl::InvalidArgumentError(
+                          absl::StrCat("Expected buffer size ",
+                                       expected_buffer_size,
+                                       " got: ", buffer_size)));
+    return nullptr;
+  }
+  return buffer_data;
+}
+
 void CheckImageSizeInImageList(JNIEnv* env,
                                const std::vector<mediapipe::Image>& image_list,
                                int height, int width, int channels) {
@@ -313,6 +336,17 @@ JNIEXPORT jfloatArray JNICALL PACKET_GETTER_METHOD(nativeGetFloat32Vector)(
   return result;
 }
 
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetFloat32VectorDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer) {
+  const std::vector<float>& values =
+      GetFromNativeHandle<std::vector<float>>(packet);
+  void* buffer_data =
+      GetDirectBufferOfSize(env, byte_buffer, values.size() * sizeof(float));
+  if (buffer_data == nullptr) return false;
+  std::memcpy(buffer_data, values.data(), values.size() * sizeof(float));
+  return true;
+}
+
 JNIEXPORT jdoubleArray JNICALL PACKET_GETTER_METHOD(nativeGetFloat64Vector)(
     JNIEnv* env, jobject thiz, jlong packet) {
   const std::vector<double>& values =
@@ -559,6 +593,25 @@ JNIEXPORT jbyteArray JNICALL PACKET_GETTER_METHOD(nativeGetAudioData)(
   return byte_data;
 }
 
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetAudioDataDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer) {
+  const mediapipe::Matrix& audio_mat =
+      GetFromNativeHandle<mediapipe::Matrix>(packet);
+  int num_channels = audio_mat.rows();
+  int num_samples = audio_mat.cols();
+  void* buffer_data = GetDirectBufferOfSize(
+      env, byte_buffer, int64_t{num_channels} * num_samples * 2);
+  if (buffer_data == nullptr) return false;
+  const int kMultiplier = 1 << 15;
+  int16_t* samples = static_cast<int16_t*>(buffer_data);
+  // Matrix is column major, so this writes interleaved samples in order.
+  const float* data = audio_mat.data();
+  for (int i = 0; i < num_channels * num_samples; ++i) {
+    samples[i] = static_cast<int16_t>(data[i] * kMultiplier);
+  }
+  return true;
+}
+
 JNIEXPORT jfloatArray JNICALL PACKET_GETTER_METHOD(nativeGetMatrixData)(
     JNIEnv* env, jobject thiz, jlong packet) {
   const mediapipe::Matrix& audio_mat =
@@ -571,6 +624,17 @@ JNIEXPORT jfloatArray JNICALL PACKET_GETTER_METHOD(nativeGetMatrixData)(
   return float_data;
 }
 
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetMatrixDataDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer) {
+  const mediapipe::Matrix& matrix =
+      GetFromNativeHandle<mediapipe::Matrix>(packet);
+  const int64_t size = int64_t{matrix.rows()} * matrix.cols() * sizeof(float);
+  void* buffer_data = GetDirectBufferOfSize(env, byte_buffer, size);
+  if (buffer_data == nullptr) return false;
+  std::memcpy(buffer_data, matrix.data(), size);
+  return true;
+}
+
 JNIEXPORT jint JNICALL PACKET_GETTER_METHOD(nativeGetMatrixRows)(JNIEnv* env,
                                                                  jobject thiz,
                                                                  jlong packet) {
@@ -89,6 +89,10 @@ JNIEXPORT jlongArray JNICALL PACKET_GETTER_METHOD(nativeGetInt64Vector)(
 JNIEXPORT jfloatArray JNICALL PACKET_GETTER_METHOD(nativeGetFloat32Vector)(
     JNIEnv* env, jobject thiz, jlong packet);
 
+// Copies the values into a direct ByteBuffer of exactly 4 * size bytes.
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetFloat32VectorDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer);
+
 JNIEXPORT jdoubleArray JNICALL PACKET_GETTER_METHOD(nativeGetFloat64Vector)(
     JNIEnv* env, jobject thiz, jlong packet);
 
@@ -149,6 +153,11 @@ JNIEXPORT jint JNICALL PACKET_GETTER_METHOD(nativeGetVideoHeaderHeight)(
 JNIEXPORT jbyteArray JNICALL PACKET_GETTER_METHOD(nativeGetAudioData)(
     JNIEnv* env, jobject thiz, jlong packet);
 
+// Writes the 16-bit interleaved audio samples into a direct ByteBuffer of
+// exactly 2 * channels * samples bytes.
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetAudioDataDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer);
+
 // Gets number of channels in time series header packet.
 JNIEXPORT jint JNICALL PACKET_GETTER_METHOD(
     nativeGetTimeSeriesHeaderNumChannels)(JNIEnv* env, jobject thiz,
@@ -164,6 +173,11 @@ JNIEXPORT jdouble JNICALL PACKET_GETTER_METHOD(
 JNIEXPORT jfloatArray JNICALL PACKET_GETTER_METHOD(nativeGetMatrixData)(
     JNIEnv* env, jobject thiz, jlong packet);
 
+// Copies the column major matrix data into a direct ByteBuffer of exactly
+// 4 * rows * cols bytes.
+JNIEXPORT jboolean JNICALL PACKET_GETTER_METHOD(nativeGetMatrixDataDirect)(
+    JNIEnv* env, jobject thiz, jlong packet, jobject byte_buffer);
+
 // Returns the number of rows of the matrix.
 JNIEXPORT jint JNICALL PACKET_GETTER_METHOD(nativeGetMatrixRows)(JNIEnv* env,
                                                                  jobject thiz,
@@ -120,6 +120,15 @@ void RegisterGraphNatives(JNIEnv *env) {
   AddJNINativeMethod(&graph_methods, graph, "nativeAddMultiStreamCallback",
                      native_add_multi_stream_callback_signature.c_str(),
                      (void *)&GRAPH_METHOD(nativeAddMultiStreamCallback));
+  std::string batched_packet_list_callback_name = class_registry.GetClassName(
+      mediapipe::android::ClassRegistry::kBatchedPacketListCallbackClassName);
+  std::string native_add_multi_stream_batch_callback_signature =
+      absl::StrFormat("(JLjava/util/List;L%s;Z)V",
+                      batched_packet_list_callback_name);
+  AddJNINativeMethod(&graph_methods, graph,
+                     "nativeAddMultiStreamBatchCallback",
+                     native_add_multi_stream_batch_callback_signature.c_str(),
+                     (void *)&GRAPH_METHOD(nativeAddMultiStreamBatchCallback));
   AddJNINativeMethod(&graph_methods, graph, "nativeMovePacketToInputStream",
                      "(JLjava/lang/String;JJ)V",
                      (void *)&GRAPH_METHOD(nativeMovePacketToInputStream));
@@ -223,6 +232,21 @@ void RegisterPacketCreatorNatives(JNIEnv *env) {
       &packet_creator_methods, packet_creator, "nativeCreateFloatImageFrame",
       "(JLjava/nio/ByteBuffer;II)J",
       (void *)&PACKET_CREATOR_METHOD(nativeCreateFloatImageFrame));
+  AddJNINativeMethod(
+      &packet_creator_methods, packet_creator,
+      "nativeCreateRgbaImageFrameNoCopy",
+      "(JLjava/nio/ByteBuffer;IILjava/lang/Runnable;)J",
+      (void *)&PACKET_CREATOR_METHOD(nativeCreateRgbaImageFrameNoCopy));
+  AddJNINativeMethod(
+      &packet_creator_methods, packet_creator,
+      "nativeCreateGrayscaleImageNoCopy",
+      "(JLjava/nio/ByteBuffer;IILjava/lang/Runnable;)J",
+      (void *)&PACKET_CREATOR_METHOD(nativeCreateGrayscaleImageNoCopy));
+  AddJNINativeMethod(
+      &packet_creator_methods, packet_creator,
+      "nativeCreateFloatImageFrameNoCopy",
+      "(JLjava/nio/ByteBuffer;IILjava/lang/Runnable;)J",
+      (void *)&PACKET_CREATOR_METHOD(nativeCreateFloatImageFrameNoCopy));
   AddJNINativeMethod(&packet_creator_methods, packet_creator,
                      "nativeCreateInt32", "(JI)J",
                      (void *)&PACKET_CREATOR_METHOD(nativeCreateInt32));
@@ -278,6 +302,16 @@ void RegisterPacketGetterNatives(JNIEnv *env) {
   AddJNINativeMethod(&packet_getter_methods, packet_getter,
                      "nativeGetFloat32Vector", "(J)[F",
                      (void *)&PACKET_GETTER_METHOD(nativeGetFloat32Vector));
+  AddJNINativeMethod(
+      &packet_getter_methods, packet_getter, "nativeGetFloat32VectorDirect",
+      "(JLjava/nio/ByteBuffer;)Z",
+      (void *)&PACKET_GETTER_METHOD(nativeGetFloat32VectorDirect));
+  AddJNINativeMethod(&packet_getter_methods, packet_getter,
+                     "nativeGetMatrixDataDirect", "(JLjava/nio/ByteBuffer;)Z",
+                     (void *)&PACKET_GETTER_METHOD(nativeGetMatrixDataDirect));
+  AddJNINativeMethod(&packet_getter_methods, packet_getter,
+                     "nativeGetAudioDataDirect", "(JLjava/nio/ByteBuffer;)Z",
+                     (void *)&PACKET_GETTER_METHOD(nativeGetAudioDataDirect));
   AddJNINativeMethod(&packet_getter_methods, packet_getter,
                      "nativeGetProtoVector", "(J)[[B",
                      (void *)&PACKET_GETTER_METHOD(nativeGetProtoVector));
@@ -14,6 +14,7 @@
 
 #include "mediapipe/modules/face_geometry/libs/effect_renderer.h"
 
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <limits>
@@ -21,6 +22,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/cleanup/cleanup.h"
 #include "absl/memory/memory.h"
 #include "absl/types/optional.h"
 #include "mediapipe/framework/formats/image_format.pb.h"
@@ -30,6 +32,7 @@
 #include "mediapipe/framework/port/status.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/port/statusor.h"
+#include "mediapipe/gpu/dirty_rect.h"
 #include "mediapipe/gpu/gl_base.h"
 #include "mediapipe/gpu/shader_util.h"
 #include "mediapipe/modules/face_geometry/libs/mesh_3d_utils.h"
@@ -90,6 +93,15 @@ struct RenderableMesh3d {
           static_cast<uint16_t>(index_element));
     }
 
+    ComputeVertexBounds(renderable_mesh_3d.vertex_buffer.data() +
+                            renderable_mesh_3d.vertex_position_offset,
+                        renderable_mesh_3d.vertex_buffer.size() /
+                            renderable_mesh_3d.vertex_size,
+                        renderable_mesh_3d.vertex_size,
+                        renderable_mesh_3d.vertex_position_size,
+                        renderable_mesh_3d.bounds_min.data(),
+                        renderable_mesh_3d.bounds_max.data());
+
     return renderable_mesh_3d;
   }
 
@@ -102,6 +114,10 @@ struct RenderableMesh3d {
 
   std::vector<float> vertex_buffer;
   std::vector<uint16_t> index_buffer;
+
+  // Object space bounds of the vertex positions.
+  std::array<float, 3> bounds_min;
+  std::array<float, 3> bounds_max;
 };
 
 class Texture {
@@ -255,14 +271,15 @@ class RenderTarget {
 
   void Unbind() const { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
 
-  void Clear() const {
+  // Clears the depth buffer within the current scissor rect. The color buffer
+  // is not cleared, as the effect rendering overwrites all of it.
+  void ClearDepth() const {
     Bind();
     glEnable(GL_DEPTH_TEST);
     glDepthMask(GL_TRUE);
 
-    glClearColor(0.f, 0.f, 0.f, 0.f);
     glClearDepthf(1.f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glClear(GL_DEPTH_BUFFER_BIT);
 
     glDepthMask(GL_FALSE);
     glDisable(GL_DEPTH_TEST);
@@ -484,14 +501,13 @@ class EffectRendererImpl : public EffectRenderer {
                                      frame_width, frame_height),
         _ << "Failed to wrap the external destination texture");
 
-    // Set the destination texture as the color buffer. Then, clear both the
-    // color and the depth buffers for the render target.
+    // Set the destination texture as the color buffer.
     MP_RETURN_IF_ERROR(render_target_->SetColorbuffer(*dst_texture))
         << "Failed to set the destination texture as the colorbuffer!";
-    render_target_->Clear();
 
     // Render the source texture on top of the quad mesh (i.e. make a copy)
-    // into the render target.
+    // into the render target. This overwrites every pixel, so the color
+    // buffer does not need to be cleared.
     MP_RETURN_IF_ERROR(renderer_->Render(
         *render_target_, *src_texture, renderable_quad_mesh_3d_,
         identity_matrix_, identity_matrix_, Renderer::RenderMode::OVERDRAW))
@@ -523,24 +539,50 @@ class EffectRendererImpl : public EffectRenderer {
     std::array<float, 16> perspective_matrix = CreatePerspectiveMatrix(
         /*aspect_ratio*/ static_cast<float>(frame_width) / frame_height);
 
-    // Render a face mesh occluder for each face.
+    // For occlusion, the pose transformation is moved ~1mm away from camera
+    // in order to allow the face mesh texture to be rendered without failing
+    // the depth test.
+    std::vector<std::array<float, 16>> occlusion_face_pose_transform_matrices =
+        face_pose_transform_matrices;
+    for (std::array<float, 16>& matrix :
+         occlusion_face_pose_transform_matrices) {
+      matrix[14] -= 0.1f;  // ~ 1mm
+    }
+
+    // The face passes only touch the screen region covered by the faces and
+    // their effects, so the depth clear and draws are scissored to it, and
+    // skipped if no face is visible.
+    DirtyRect dirty_rect(frame_width, frame_height);
     for (int i = 0; i < num_faces; ++i) {
-      const std::array<float, 16>& face_pose_transform_matrix =
-          face_pose_transform_matrices[i];
       const RenderableMesh3d& renderable_face_mesh = renderable_face_meshes[i];
+      dirty_rect.AddBox(perspective_matrix.data(),
+                        occlusion_face_pose_transform_matrices[i].data(),
+                        renderable_face_mesh.bounds_min.data(),
+                        renderable_face_mesh.bounds_max.data());
+      const RenderableMesh3d& main_effect_mesh_3d =
+          renderable_effect_mesh_3d_ ? *renderable_effect_mesh_3d_
+                                     : renderable_face_mesh;
+      dirty_rect.AddBox(perspective_matrix.data(),
+                        face_pose_transform_matrices[i].data(),
+                        main_effect_mesh_3d.bounds_min.data(),
+                        main_effect_mesh_3d.bounds_max.data());
+    }
+    const PixelRect scissor = dirty_rect.Rect();
+    if (scissor.IsEmpty()) {
+      return absl::OkStatus();
+    }
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(scissor.x, scissor.y, scissor.width, scissor.height);
+    absl::Cleanup disable_scissor = [] { glDisable(GL_SCISSOR_TEST); };
+    render_target_->ClearDepth();
 
+    // Render a face mesh occluder for each face.
+    for (int i = 0; i < num_faces; ++i) {
       // Render the face mesh using the empty color texture, i.e. the face
       // mesh occluder.
-      //
-      // For occlusion, the pose transformation is moved ~1mm away from camera
-      // in order to allow the face mesh texture to be rendered without
-      // failing the depth test.
-      std::array<float, 16> occlusion_face_pose_transform_matrix =
-          face_pose_transform_matrix;
-      occlusion_face_pose_transform_matrix[14] -= 0.1f;  // ~ 1mm
       MP_RETURN_IF_ERROR(renderer_->Render(
-          *render_target_, *empty_color_texture_, renderable_face_mesh,
-          perspective_matrix, occlusion_face_pose_transform_matrix,
+          *render_target_, *empty_color_texture_, renderable_face_meshes[i],
+          perspective_matrix, occlusion_face_pose_transform_matrices[i],
           Renderer::RenderMode::OCCLUSION))
           << "Failed to render the face mesh occluder!";
     }
@@ -14,6 +14,8 @@
 
 #include "mediapipe/modules/objectron/calculators/decoder.h"
 
+#include <algorithm>
+#include <array>
 #include <limits>
 #include <vector>
 
@@ -105,7 +107,7 @@ void Decoder::DecodeByVoting(const cv::Mat& heatmap, const cv::Mat& offsetmap,
   // Votes at the center.
   const auto& center_offset = offsetmap.at<cv::Vec<float, kNumOffsetmaps>>(
       /*row*/ center_y, /*col*/ center_x);
-  std::vector<float> center_votes(kNumOffsetmaps, 0.f);
+  std::array<float, kNumOffsetmaps> center_votes;
   for (int i = 0; i < kNumOffsetmaps / 2; ++i) {
     center_votes[2 * i] = center_x + center_offset[2 * i] * offset_scale_x;
     center_votes[2 * i + 1] =
@@ -184,6 +186,13 @@ bool Decoder::IsIdentical(const BeliefBox& box_1,
 
 std::vector<cv::Point> Decoder::ExtractCenterKeypoints(
     const cv::Mat& center_heatmap) const {
+  // Most pixels are below the threshold, so only the pixels above it are
+  // compared to their max-pooled (dilated) values.
+  std::vector<cv::Point> locations;  // output, locations of peak pixels
+  cv::findNonZero(center_heatmap >= config_.heatmap_threshold(), locations);
+  if (locations.empty()) {
+    return locations;
+  }
   cv::Mat max_filtered_heatmap(center_heatmap.rows, center_heatmap.cols,
                                center_heatmap.type());
   const int kernel_size =
@@ -191,11 +200,13 @@ std::vector<cv::Point> Decoder::ExtractCenterKeypoints(
   const cv::Size morph_size(kernel_size, kernel_size);
   cv::dilate(center_heatmap, max_filtered_heatmap,
              cv::getStructuringElement(cv::MORPH_RECT, morph_size));
-  cv::Mat peak_map;
-  cv::bitwise_and((center_heatmap >= max_filtered_heatmap),
-                  (center_heatmap >= config_.heatmap_threshold()), peak_map);
-  std::vector<cv::Point> locations;  // output, locations of non-zero pixels
-  cv::findNonZero(peak_map, locations);
+  locations.erase(
+      std::remove_if(locations.begin(), locations.end(),
+                     [&](const cv::Point& location) {
+                       return center_heatmap.at<float>(location) <
+                              max_filtered_heatmap.at<float>(location);
+                     }),
+      locations.end());
   return locations;
 }
 
@@ -204,36 +215,39 @@ absl::Status Decoder::Lift2DTo3D(
     bool portrait, FrameAnnotation* estimated_box) const {
   ABSL_CHECK(estimated_box != nullptr);
 
-  for (auto& annotation : *estimated_box->mutable_annotations()) {
+  // Fill input 2D Points of all objects;
+  std::vector<EpnpPoints2D> input_points_2d(estimated_box->annotations_size());
+  for (int k = 0; k < estimated_box->annotations_size(); ++k) {
+    const auto& annotation = estimated_box->annotations(k);
     ABSL_CHECK_EQ(kNumKeypoints, annotation.keypoints_size());
-
-    // Fill input 2D Points;
-    std::vector<Vector2f> input_points_2d;
-    input_points_2d.reserve(kNumKeypoints);
-    for (const auto& keypoint : annotation.keypoints()) {
-      input_points_2d.emplace_back(keypoint.point_2d().x(),
-                                   keypoint.point_2d().y());
+    for (int i = 0; i < kNumKeypoints; ++i) {
+      const auto& point_2d = annotation.keypoints(i).point_2d();
+      input_points_2d[k].row(i) << point_2d.x(), point_2d.y();
     }
+  }
 
-    // Run EPnP.
-    std::vector<Vector3f> output_points_3d;
-    output_points_3d.reserve(kNumKeypoints);
-    auto status = SolveEpnp(projection_matrix, portrait, input_points_2d,
-                            &output_points_3d);
-    if (!status.ok()) {
-      ABSL_LOG(ERROR) << status;
-      return status;
-    }
+  // Run EPnP on all objects at once.
+  std::vector<EpnpPoints3D> output_points_3d;
+  auto status = SolveEpnp(projection_matrix, portrait, input_points_2d,
+                          &output_points_3d);
+  if (!status.ok()) {
+    ABSL_LOG(ERROR) << status;
+    return status;
+  }
 
+  std::vector<Vector3f> box_points_3d(kNumKeypoints);
+  for (int k = 0; k < estimated_box->annotations_size(); ++k) {
+    auto& annotation = *estimated_box->mutable_annotations(k);
     // Fill 3D keypoints;
     for (int i = 0; i < kNumKeypoints; ++i) {
-      SetPoint3d(output_points_3d[i],
+      box_points_3d[i] = output_points_3d[k].row(i).transpose();
+      SetPoint3d(box_points_3d[i],
                  annotation.mutable_keypoints(i)->mutable_point_3d());
     }
 
     // Fit a box to the 3D points to get box scale, rotation, translation.
     Box box("category");
-    box.Fit(output_points_3d);
+    box.Fit(box_points_3d);
     const Eigen::Matrix<float, 3, 3, Eigen::RowMajor> rotation =
         box.GetRotation();
     const Eigen::Vector3f translation = box.GetTranslation();
@@ -29,26 +29,8 @@ using Eigen::Matrix4f;
 using Eigen::Vector2f;
 using Eigen::Vector3f;
 
-}  // namespace
-
-absl::Status SolveEpnp(const float focal_x, const float focal_y,
-                       const float center_x, const float center_y,
-                       const bool portrait,
-                       const std::vector<Vector2f>& input_points_2d,
-                       std::vector<Vector3f>* output_points_3d) {
-  if (input_points_2d.size() != kNumKeypoints) {
-    return absl::InvalidArgumentError(
-        absl::StrFormat("Input must has %d 2D points.", kNumKeypoints));
-  }
-
-  if (output_points_3d == nullptr) {
-    return absl::InvalidArgumentError(
-        "Output pointer output_points_3d is Null.");
-  }
-
-  Matrix<float, (kNumKeypoints - 1) * 2, 12> m =
-      Matrix<float, (kNumKeypoints - 1) * 2, 12>::Zero();
-
+// Returns the Nx4 weight matrix from the EPnP paper.
+Matrix<float, kNumKeypoints - 1, 4> EpnpAlpha() {
   Matrix<float, kNumKeypoints - 1, 4> epnp_alpha;
   // The epnp_alpha is the Nx4 weight matrix from the EPnP paper, which is used
   // to express the N box vertices as the weighted sum of 4 control points. The
@@ -92,10 +74,22 @@ absl::Status SolveEpnp(const float focal_x, const float focal_y,
                 0.0f,  1.0f,  1.0f, -1.0f,
                -2.0f,  1.0f,  1.0f,  1.0f;
   // clang-format on
+  return epnp_alpha;
+}
+
+// Solves EPnP for one object, without any heap allocation.
+absl::Status SolveEpnpFixed(const float focal_x, const float focal_y,
+                            const float center_x, const float center_y,
+                            const bool portrait,
+                            const EpnpPoints2D& input_points_2d,
+                            EpnpPoints3D* output_points_3d) {
+  static const Matrix<float, kNumKeypoints - 1, 4> epnp_alpha = EpnpAlpha();
 
-  for (int i = 0; i < input_points_2d.size() - 1; ++i) {
+  Matrix<float, (kNumKeypoints - 1) * 2, 12> m =
+      Matrix<float, (kNumKeypoints - 1) * 2, 12>::Zero();
+  for (int i = 0; i < kNumKeypoints - 1; ++i) {
     // Skip 0th landmark which is object center.
-    const auto& point_2d = input_points_2d[i + 1];
+    const auto point_2d = input_points_2d.row(i + 1);
 
     // Convert 2d point from `pixel coordinates` to `NDC coordinates`([-1, 1])
     // following to the definitions in:
@@ -134,7 +128,7 @@ absl::Status SolveEpnp(const float focal_x, const float focal_y,
   // only! If you use other Eigen Solvers, it's not guaranteed to be in
   // increasing order. Here, we just take the eigen vector corresponding
   // to first/smallest eigen value, since we used SelfAdjointEigenSolver.
-  Eigen::VectorXf eigen_vec = eigen_solver.eigenvectors().col(0);
+  Matrix<float, 12, 1> eigen_vec = eigen_solver.eigenvectors().col(0);
   Map<Matrix<float, 4, 3, Eigen::RowMajor>> control_matrix(eigen_vec.data());
 
   // All 3D points should be in front of camera (z < 0).
@@ -144,12 +138,41 @@ absl::Status SolveEpnp(const float focal_x, const float focal_y,
   Matrix<float, kNumKeypoints - 1, 3> vertices = epnp_alpha * control_matrix;
 
   // Fill 0th 3D points.
-  output_points_3d->emplace_back(control_matrix(0, 0), control_matrix(0, 1),
-                                 control_matrix(0, 2));
+  output_points_3d->row(0) = control_matrix.row(0);
   // Fill the rest 3D points.
-  for (int i = 0; i < kNumKeypoints - 1; ++i) {
-    output_points_3d->emplace_back(vertices(i, 0), vertices(i, 1),
-                                   vertices(i, 2));
+  output_points_3d->bottomRows<kNumKeypoints - 1>() = vertices;
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status SolveEpnp(const float focal_x, const float focal_y,
+                       const float center_x, const float center_y,
+                       const bool portrait,
+                       const std::vector<Vector2f>& input_points_2d,
+                       std::vector<Vector3f>* output_points_3d) {
+  if (input_points_2d.size() != kNumKeypoints) {
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Input must has %d 2D points.", kNumKeypoints));
+  }
+
+  if (output_points_3d == nullptr) {
+    return absl::InvalidArgumentError(
+        "Output pointer output_points_3d is Null.");
+  }
+
+  EpnpPoints2D points_2d;
+  for (int i = 0; i < kNumKeypoints; ++i) {
+    points_2d.row(i) = input_points_2d[i].transpose();
+  }
+  EpnpPoints3D points_3d;
+  absl::Status status = SolveEpnpFixed(focal_x, focal_y, center_x, center_y,
+                                       portrait, points_2d, &points_3d);
+  if (!status.ok()) {
+    return status;
+  }
+  for (int i = 0; i < kNumKeypoints; ++i) {
+    output_points_3d->emplace_back(points_3d.row(i).transpose());
   }
   return absl::OkStatus();
 }
@@ -166,4 +189,28 @@ absl::Status SolveEpnp(const Eigen::Matrix4f& projection_matrix,
                    input_points_2d, output_points_3d);
 }
 
+absl::Status SolveEpnp(const Eigen::Matrix4f& projection_matrix,
+                       const bool portrait,
+                       const std::vector<EpnpPoints2D>& input_points_2d,
+                       std::vector<EpnpPoints3D>* output_points_3d) {
+  if (output_points_3d == nullptr) {
+    return absl::InvalidArgumentError(
+        "Output pointer output_points_3d is Null.");
+  }
+  const float focal_x = projection_matrix(0, 0);
+  const float focal_y = projection_matrix(1, 1);
+  const float center_x = projection_matrix(0, 2);
+  const float center_y = projection_matrix(1, 2);
+  output_points_3d->resize(input_points_2d.size());
+  for (int i = 0; i < input_points_2d.size(); ++i) {
+    absl::Status status =
+        SolveEpnpFixed(focal_x, focal_y, center_x, center_y, portrait,
+                       input_points_2d[i], &(*output_points_3d)[i]);
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace mediapipe
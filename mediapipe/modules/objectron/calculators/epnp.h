@@ -24,6 +24,10 @@
 
 namespace mediapipe {
 
+// The 2D and 3D keypoints of one box, its center followed by its 8 vertices.
+using EpnpPoints2D = Eigen::Matrix<float, 9, 2, Eigen::RowMajor>;
+using EpnpPoints3D = Eigen::Matrix<float, 9, 3, Eigen::RowMajor>;
+
 // This function performs EPnP algorithm, lifting normalized 2D points in pixel
 // space to 3D points in camera coordinate.
 //
@@ -57,6 +61,21 @@ absl::Status SolveEpnp(const Eigen::Matrix4f& projection_matrix,
                        const std::vector<Eigen::Vector2f>& input_points_2d,
                        std::vector<Eigen::Vector3f>* output_points_3d);
 
+// Same as above for the keypoints of several boxes, without allocating per
+// box.
+//
+// Inputs:
+//   projection_matrix: the projection matrix from 3D coordinate
+//     to screen coordinate.
+//   portrait: a boolen variable indicating whether our images are obtained in
+//     portrait orientation or not.
+//   input_points_2d: input 2D points of each box to be lifted to 3D.
+//   output_points_3d: ouput 3D points of each box in camera coordinate.
+absl::Status SolveEpnp(const Eigen::Matrix4f& projection_matrix,
+                       const bool portrait,
+                       const std::vector<EpnpPoints2D>& input_points_2d,
+                       std::vector<EpnpPoints3D>* output_points_3d);
+
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_MODULES_OBJECTRON_CALCULATORS_EPNP_H_
@@ -146,6 +146,35 @@ TEST_F(SolveEpnpTest, SolveEpnpProjectionMatrix) {
   VerifyOutput3dPoints(output_3d_points);
 }
 
+TEST_F(SolveEpnpTest, SolveEpnpBatch) {
+  Matrix4f projection_matrix;
+  // clang-format off
+  projection_matrix << kFocalX,    0.0f, kCenterX, 0.0f,
+                          0.0f, kFocalY, kCenterY, 0.0f,
+                          0.0f,    0.0f,    -1.0f, 0.0f,
+                          0.0f,    0.0f,    -1.0f, 0.0f;
+  // clang-format on
+
+  EpnpPoints2D points_2d;
+  for (int i = 0; i < kNumKeypoints; ++i) {
+    points_2d.row(i) = input_2d_points_[i].transpose();
+  }
+  const std::vector<EpnpPoints2D> input_2d_points = {points_2d, points_2d};
+  std::vector<EpnpPoints3D> output_3d_points;
+  MP_ASSERT_OK(SolveEpnp(projection_matrix, /*portrait*/ false,
+                         input_2d_points, &output_3d_points));
+
+  // Test output 3D points of each box.
+  ASSERT_EQ(2, output_3d_points.size());
+  for (const EpnpPoints3D& points_3d : output_3d_points) {
+    std::vector<Vector3f> box_3d_points;
+    for (int i = 0; i < kNumKeypoints; ++i) {
+      box_3d_points.emplace_back(points_3d.row(i).transpose());
+    }
+    VerifyOutput3dPoints(box_3d_points);
+  }
+}
+
 TEST_F(SolveEpnpTest, BadInput2dPoints) {
   // Generate empty input 2D points.
   std::vector<Vector2f> input_2d_points;
@@ -22,15 +22,32 @@
 
 #import "GTMDefines.h"
 #include "absl/memory/memory.h"
+#include "mediapipe/calculators/core/flow_limiter_calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/graph_service.h"
 #include "mediapipe/gpu/gl_base.h"
 #include "mediapipe/gpu/gpu_shared_data_internal.h"
+#include "mediapipe/objc/CFHolder.h"
 #import "mediapipe/objc/NSError+util_status.h"
 #include "mediapipe/objc/util.h"
 
+#if MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+#include "mediapipe/gpu/cv_pixel_buffer_pool_wrapper.h"
+#endif  // MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+
+/// Recycles the pixel buffers that the ImageFrame packets of one output stream
+/// are converted into. Only used from that stream's callback, which is never
+/// run concurrently.
+struct MPPOutputPixelBufferPool {
+#if MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+  std::shared_ptr<mediapipe::CvPixelBufferPoolWrapper> pool;
+#endif  // MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+  int width = 0;
+  int height = 0;
+};
+
 @implementation MPPGraph {
   // Graph is wrapped in a unique_ptr because it was generating 39+KB of
   // unnecessary ObjC runtime information. See
@@ -47,6 +64,11 @@
 
   /// Number of frames currently being processed by the graph.
   std::atomic<int32_t> _framesInFlight;
+  /// The in-flight limit derived from the FlowLimiterStats stream, or 0 if
+  /// there is none.
+  std::atomic<int32_t> _flowLimiterMaxFramesInFlight;
+  /// The frames_dropped count of the last FlowLimiterStats packet.
+  int64_t _flowLimiterFramesDropped;
   /// Used as a sequential timestamp for MediaPipe.
   mediapipe::Timestamp _frameTimestamp;
   int64_t _frameNumber;
@@ -94,15 +116,78 @@
   // NewPermanentCallback will still end up with a strong pointer to
   // MPPGraph*. That is why we use void* instead.
   void* wrapperVoid = (__bridge void*)self;
+  auto outputPool = std::make_shared<MPPOutputPixelBufferPool>();
   _inputSidePackets[callbackInputName] =
       mediapipe::MakePacket<std::function<void(const mediapipe::Packet&)>>(
-          [wrapperVoid, outputStreamName,
-           packetType](const mediapipe::Packet& packet) {
+          [wrapperVoid, outputStreamName, packetType,
+           outputPool](const mediapipe::Packet& packet) {
             CallFrameDelegate(wrapperVoid, outputStreamName, packetType,
-                              packet);
+                              outputPool.get(), packet);
           });
 }
 
+/// Called with each FlowLimiterStats packet. Frames dropped by the flow
+/// limiter never reach the frame outputs, so they stop counting as in flight
+/// here. One frame beyond the limiter's max_in_flight is accepted, so that the
+/// limiter always has the latest frame queued when a slot frees up.
+void UpdateFlowLimiterState(void* wrapperVoid,
+                            const mediapipe::FlowLimiterStats& stats) {
+  MPPGraph* wrapper = (__bridge MPPGraph*)wrapperVoid;
+  const int64_t newlyDropped =
+      stats.frames_dropped() - wrapper->_flowLimiterFramesDropped;
+  wrapper->_flowLimiterFramesDropped = stats.frames_dropped();
+  if (newlyDropped > 0) wrapper->_framesInFlight -= newlyDropped;
+  wrapper->_flowLimiterMaxFramesInFlight = stats.max_in_flight() + 1;
+}
+
+- (void)setFlowLimiterStatsStream:(const std::string&)streamName {
+  _GTMDevAssert(!_started, @"%@ must be called before the graph is started",
+                NSStringFromSelector(_cmd));
+  std::string callbackInputName;
+  mediapipe::tool::AddCallbackCalculator(streamName, &_config,
+                                         &callbackInputName,
+                                         /*use_std_function=*/true);
+  void* wrapperVoid = (__bridge void*)self;
+  _inputSidePackets[callbackInputName] =
+      mediapipe::MakePacket<std::function<void(const mediapipe::Packet&)>>(
+          [wrapperVoid](const mediapipe::Packet& packet) {
+            UpdateFlowLimiterState(
+                wrapperVoid, packet.Get<mediapipe::FlowLimiterStats>());
+          });
+}
+
+/// Returns a BGRA pixel buffer for an output frame, recycled through the
+/// stream's pool when pixel buffer pools are available.
+static CFHolder<CVPixelBufferRef> CreateOutputPixelBuffer(
+    MPPOutputPixelBufferPool* outputPool, int width, int height) {
+#if MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+  if (outputPool) {
+    if (!outputPool->pool || outputPool->width != width ||
+        outputPool->height != height) {
+      outputPool->pool = std::make_shared<mediapipe::CvPixelBufferPoolWrapper>(
+          width, height, mediapipe::GpuBufferFormat::kBGRA32,
+          mediapipe::kDefaultMultiPoolOptions.max_inactive_buffer_age,
+          /*texture_caches=*/nullptr);
+      outputPool->width = width;
+      outputPool->height = height;
+    }
+    auto buffer = outputPool->pool->GetBuffer();
+    if (buffer.ok()) return *std::move(buffer);
+    _GTMDevLog(@"pixel buffer pool failed: %s",
+               buffer.status().ToString().c_str());
+  }
+#endif  // MEDIAPIPE_GPU_BUFFER_USE_CV_PIXEL_BUFFER
+  CVPixelBufferRef pixelBuffer;
+  // If kCVPixelFormatType_32RGBA does not work, it returns
+  // kCVReturnInvalidPixelFormat.
+  CVReturn error = CVPixelBufferCreate(
+      NULL, width, height, kCVPixelFormatType_32BGRA,
+      GetCVPixelBufferAttributesForGlCompatibility(), &pixelBuffer);
+  _GTMDevAssert(error == kCVReturnSuccess, @"CVPixelBufferCreate failed: %d",
+                error);
+  return MakeCFHolderAdopting(pixelBuffer);
+}
+
 - (NSString*)description {
   return [NSString
       stringWithFormat:@"<%@: %p; framesInFlight = %d>", [self class], self,
@@ -113,6 +198,7 @@
 /// receives the graph's output.
 void CallFrameDelegate(void* wrapperVoid, const std::string& streamName,
                        MPPPacketType packetType,
+                       MPPOutputPixelBufferPool* outputPool,
                        const mediapipe::Packet& packet) {
   MPPGraph* wrapper = (__bridge MPPGraph*)wrapperVoid;
   @autoreleasepool {
@@ -127,15 +213,10 @@ void CallFrameDelegate(void* wrapperVoid, const std::string& streamName,
 
       if (format == mediapipe::ImageFormat::SRGBA ||
           format == mediapipe::ImageFormat::GRAY8) {
-        CVPixelBufferRef pixelBuffer;
-        // If kCVPixelFormatType_32RGBA does not work, it returns
-        // kCVReturnInvalidPixelFormat.
-        CVReturn error = CVPixelBufferCreate(
-            NULL, frame.Width(), frame.Height(), kCVPixelFormatType_32BGRA,
-            GetCVPixelBufferAttributesForGlCompatibility(), &pixelBuffer);
-        _GTMDevAssert(error == kCVReturnSuccess,
-                      @"CVPixelBufferCreate failed: %d", error);
-        error = CVPixelBufferLockBaseAddress(pixelBuffer, 0);
+        CFHolder<CVPixelBufferRef> pixelBufferHolder =
+            CreateOutputPixelBuffer(outputPool, frame.Width(), frame.Height());
+        CVPixelBufferRef pixelBuffer = *pixelBufferHolder;
+        CVReturn error = CVPixelBufferLockBaseAddress(pixelBuffer, 0);
         _GTMDevAssert(error == kCVReturnSuccess,
                       @"CVPixelBufferLockBaseAddress failed: %d", error);
 
@@ -176,7 +257,6 @@ void CallFrameDelegate(void* wrapperVoid, const std::string& streamName,
                       didOutputPixelBuffer:pixelBuffer
                                 fromStream:streamName];
         }
-        CVPixelBufferRelease(pixelBuffer);
       } else {
         _GTMDevLog(@"unsupported ImageFormat: %d", format);
       }
@@ -396,6 +476,8 @@ void CallFrameDelegate(void* wrapperVoid, const std::string& streamName,
          allowOverwrite:(BOOL)allowOverwrite
                   error:(NSError**)error {
   if (_maxFramesInFlight && _framesInFlight >= _maxFramesInFlight) return NO;
+  const int32_t flowLimit = _flowLimiterMaxFramesInFlight;
+  if (flowLimit && _framesInFlight >= flowLimit) return NO;
   mediapipe::Packet packet =
       [self packetWithPixelBuffer:imageBuffer packetType:packetType];
   BOOL success;
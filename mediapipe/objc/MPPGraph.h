@@ -91,6 +91,7 @@ typedef NS_ENUM(int, MPPPacketType) {
 ///  - sendPixelBuffer:intoStream:packetType:[timestamp:]
 ///  - addFrameOutputStream:outputPacketType:
 /// Set to 0 (the default) for no limit.
+/// See also setFlowLimiterStatsStream:, which adapts the limit to the graph.
 @property(nonatomic) int maxFramesInFlight;
 
 /// Determines whether adding a packet to an input stream whose queue is full
@@ -139,6 +140,18 @@ typedef NS_ENUM(int, MPPPacketType) {
 - (void)addFrameOutputStream:(const std::string &)outputStreamName
             outputPacketType:(MPPPacketType)packetType;
 
+/// Ties the frames accepted by sendPixelBuffer: to a FlowLimiterCalculator.
+/// streamName must carry the calculator's "STATS" output. Frames dropped by the
+/// flow limiter no longer count as in flight, and new frames are rejected up
+/// front, before being wrapped into packets, once more than the limiter's
+/// current max_in_flight plus one queued frame are in flight. With an adaptive
+/// flow limiter, the number of frames accepted therefore follows the measured
+/// graph latency instead of a fixed maxFramesInFlight, which still applies as
+/// an upper bound when set.
+/// Must be called before the graph is started.
+/// @param streamName The name of a stream of FlowLimiterStats packets.
+- (void)setFlowLimiterStatsStream:(const std::string &)streamName;
+
 /// Starts running the graph.
 /// @return YES if successful.
 - (BOOL)startWithError:(NSError **)error;
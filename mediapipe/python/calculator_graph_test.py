@@ -135,6 +135,69 @@ class GraphTest(absltest.TestCase):
     self.assertEqual(packet_getter.get_str(out[0]), 'hello world')
     self.assertEqual(packet_getter.get_str(out[1]), 'hello world')
 
+  def test_add_packets_to_input_stream(self):
+    text_config = """
+      input_stream: 'in_a'
+      input_stream: 'in_b'
+      output_stream: 'out_a'
+      output_stream: 'out_b'
+      node {
+        calculator: 'PassThroughCalculator'
+        input_stream: 'in_a'
+        input_stream: 'in_b'
+        output_stream: 'out_a'
+        output_stream: 'out_b'
+      }
+    """
+
+    out = []
+    graph = CalculatorGraph(graph_config=text_config)
+    graph.observe_output_stream('out_a', lambda _, packet: out.append(packet))
+    graph.observe_output_stream('out_b', lambda _, packet: out.append(packet))
+    graph.start_run()
+    graph.add_packets_to_input_stream(
+        [('in_a', packet_creator.create_string('a')),
+         ('in_b', packet_creator.create_string('b'))],
+        timestamp=0)
+    graph.add_packets_to_input_stream(
+        [('in_a', packet_creator.create_string('c').at(1)),
+         ('in_b', packet_creator.create_string('d').at(1))])
+    with self.assertRaisesRegex(ValueError, "can't be the timestamp"):
+      graph.add_packets_to_input_stream(
+          [('in_a', packet_creator.create_string('e'))])
+    graph.close()
+    self.assertLen(out, 4)
+    self.assertCountEqual([packet_getter.get_str(p) for p in out],
+                          ['a', 'b', 'c', 'd'])
+
+  def test_observe_output_stream_batched(self):
+    text_config = """
+      input_stream: 'in'
+      output_stream: 'out'
+      node {
+        calculator: 'PassThroughCalculator'
+        input_stream: 'in'
+        output_stream: 'out'
+      }
+    """
+
+    out = []
+    graph = CalculatorGraph(graph_config=text_config)
+    graph.observe_output_stream_batched(
+        'out', lambda stream_name, packets: out.extend(packets))
+    graph.start_run()
+    for i in range(100):
+      graph.add_packet_to_input_stream(
+          stream='in', packet=packet_creator.create_int(i), timestamp=i)
+    graph.wait_until_idle()
+    self.assertLen(out, 100)
+    graph.add_packet_to_input_stream(
+        stream='in', packet=packet_creator.create_int(100), timestamp=100)
+    graph.close()
+    self.assertFalse(graph.has_error())
+    self.assertEqual([packet_getter.get_int(p) for p in out], list(range(101)))
+    self.assertEqual([p.timestamp for p in out], list(range(101)))
+
   def test_graph_validation_and_initialization(self):
     text_config = """
       max_queue_size: 1
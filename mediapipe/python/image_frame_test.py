@@ -190,5 +190,23 @@ class ImageFrameTest(absltest.TestCase):
     self.assertEqual(sys.getrefcount(rgb_image_frame), initial_ref_count)
 
 
+  # The buffer protocol exposes the pixel data in place, also when the rows are
+  # padded, and the resulting array keeps the image frame alive.
+  def test_image_frame_buffer_protocol_with_non_contiguous_data(self):
+    w, h = 641, 481
+    mat = np.random.randint(2**8 - 1, size=(h, w, 3), dtype=np.uint8)
+    rgb_image_frame = ImageFrame(image_format=ImageFormat.SRGB, data=mat)
+    self.assertFalse(rgb_image_frame.is_contiguous())
+    initial_ref_count = sys.getrefcount(rgb_image_frame)
+    np_array = np.asarray(rgb_image_frame)
+    self.assertTrue(np.array_equal(mat, np_array))
+    self.assertFalse(np_array.flags.writeable)
+    self.assertFalse(np_array.flags.c_contiguous)
+    self.assertEqual(sys.getrefcount(rgb_image_frame), initial_ref_count + 1)
+    del np_array
+    gc.collect()
+    self.assertEqual(sys.getrefcount(rgb_image_frame), initial_ref_count)
+
+
 if __name__ == '__main__':
   absltest.main()
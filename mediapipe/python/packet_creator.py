@@ -77,7 +77,9 @@ def create_image_frame(data: Union[image_frame.ImageFrame, np.ndarray],
 
   iii) Reference mode (dangerous)
   If copy is set to False, the data will be forced to be shared. If the data is
-  mutable (data.flags.writeable is True), a warning will be raised.
+  mutable (data.flags.writeable is True), a warning will be raised. The packet
+  keeps the numpy array alive until the packet and all its copies, including
+  the ones held by a running graph, are destroyed.
 
   Args:
     data: A MediaPipe ImageFrame object or the raw pixel data that is
@@ -175,7 +177,9 @@ def create_image(data: Union[image.Image, np.ndarray],
 
   iii) Reference mode (dangerous)
   If copy is set to False, the data will be forced to be shared. If the data is
-  mutable (data.flags.writeable is True), a warning will be raised.
+  mutable (data.flags.writeable is True), a warning will be raised. The packet
+  keeps the numpy array alive until the packet and all its copies, including
+  the ones held by a running graph, are destroyed.
 
   Args:
     data: A MediaPipe Image object or the raw pixel data that is represnted as a
@@ -14,8 +14,17 @@
 
 #include "mediapipe/python/pybind/calculator_graph.h"
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_graph.h"
 #include "mediapipe/framework/packet.h"
@@ -49,6 +58,153 @@ T ParseProto(const py::object& proto_object) {
 
 namespace py = pybind11;
 
+namespace {
+
+// Delivers the packets of batched output stream observers to their Python
+// callbacks on a single dispatcher thread. Graph threads only append packets
+// to a buffer and never touch the GIL; the dispatcher thread swaps the buffer
+// out and acquires the GIL once per batch.
+class BatchedOutputDispatcher {
+ public:
+  BatchedOutputDispatcher() = default;
+  BatchedOutputDispatcher(const BatchedOutputDispatcher&) = delete;
+  BatchedOutputDispatcher& operator=(const BatchedOutputDispatcher&) = delete;
+
+  ~BatchedOutputDispatcher() { Stop(); }
+
+  // Registers the callback for a stream and returns its index, to be passed
+  // to Push(). REQUIRES: GIL held, the graph is not running.
+  int AddCallback(const std::string& stream_name, py::function callback_fn) {
+    callbacks_.emplace_back(stream_name, std::move(callback_fn));
+    if (!thread_) {
+      thread_ = std::make_unique<std::thread>([this] { Run(); });
+    }
+    return callbacks_.size() - 1;
+  }
+
+  // Queues a packet for the callback at index. Called on graph threads.
+  void Push(int index, const Packet& packet) {
+    absl::MutexLock lock(&mutex_);
+    if (stopped_) return;
+    pending_.emplace_back(index, packet);
+    ++num_pushed_;
+  }
+
+  // Blocks until all the packets pushed so far have been delivered.
+  // REQUIRES: GIL not held.
+  void Flush() {
+    absl::MutexLock lock(&mutex_);
+    const int64_t target = num_pushed_;
+    auto delivered = [this, target]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+      return stopped_ || num_delivered_ >= target;
+    };
+    mutex_.Await(absl::Condition(&delivered));
+  }
+
+  // Stops the dispatcher thread. Undelivered packets are dropped and packets
+  // pushed afterwards are ignored. REQUIRES: GIL not held.
+  void Stop() {
+    std::vector<std::pair<int, Packet>> dropped;
+    {
+      absl::MutexLock lock(&mutex_);
+      stopped_ = true;
+      dropped.swap(pending_);
+    }
+    if (thread_) {
+      thread_->join();
+      thread_.reset();
+    }
+  }
+
+ private:
+  void Run() {
+    std::vector<std::pair<int, Packet>> batch;
+    while (true) {
+      {
+        absl::MutexLock lock(&mutex_);
+        auto has_work = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+          return stopped_ || !pending_.empty();
+        };
+        mutex_.Await(absl::Condition(&has_work));
+        if (stopped_) return;
+        batch.swap(pending_);
+      }
+      const int64_t batch_size = batch.size();
+      {
+        py::gil_scoped_acquire gil_acquire;
+        Deliver(batch);
+        batch.clear();
+      }
+      absl::MutexLock lock(&mutex_);
+      num_delivered_ += batch_size;
+    }
+  }
+
+  // Calls every callback once with the list of its packets in the batch.
+  // REQUIRES: GIL held.
+  void Deliver(const std::vector<std::pair<int, Packet>>& batch) {
+    std::vector<py::list> packets(callbacks_.size());
+    for (const auto& [index, packet] : batch) {
+      packets[index].append(py::cast(packet));
+    }
+    for (size_t i = 0; i < callbacks_.size(); ++i) {
+      if (packets[i].empty()) continue;
+      try {
+        callbacks_[i].second(callbacks_[i].first, packets[i]);
+      } catch (py::error_already_set& e) {
+        // There is no Python frame to propagate the exception to.
+        e.discard_as_unraisable(callbacks_[i].second);
+      }
+    }
+  }
+
+  // Written only while the graph is not running.
+  std::vector<std::pair<std::string, py::function>> callbacks_;
+  std::unique_ptr<std::thread> thread_;
+
+  absl::Mutex mutex_;
+  std::vector<std::pair<int, Packet>> pending_ ABSL_GUARDED_BY(mutex_);
+  int64_t num_pushed_ ABSL_GUARDED_BY(mutex_) = 0;
+  int64_t num_delivered_ ABSL_GUARDED_BY(mutex_) = 0;
+  bool stopped_ ABSL_GUARDED_BY(mutex_) = false;
+};
+
+// The CalculatorGraph created by the Python bindings. It owns the dispatcher
+// of its batched output stream observers.
+class PyCalculatorGraph : public CalculatorGraph {
+ public:
+  // REQUIRES: GIL held.
+  ~PyCalculatorGraph() override {
+    if (dispatcher_) {
+      py::gil_scoped_release gil_release;
+      dispatcher_->Stop();
+    }
+  }
+
+  std::shared_ptr<BatchedOutputDispatcher> GetOrCreateDispatcher() {
+    if (!dispatcher_) {
+      dispatcher_ = std::make_shared<BatchedOutputDispatcher>();
+    }
+    return dispatcher_;
+  }
+
+  BatchedOutputDispatcher* dispatcher() { return dispatcher_.get(); }
+
+ private:
+  std::shared_ptr<BatchedOutputDispatcher> dispatcher_;
+};
+
+// Waits until the batched output observers of the graph have received all the
+// packets emitted so far. REQUIRES: GIL not held.
+void FlushBatchedOutput(CalculatorGraph* graph) {
+  auto* py_graph = dynamic_cast<PyCalculatorGraph*>(graph);
+  if (py_graph && py_graph->dispatcher()) {
+    py_graph->dispatcher()->Flush();
+  }
+}
+
+}  // namespace
+
 void CalculatorGraphSubmodule(pybind11::module* module) {
   py::module m = module->def_submodule("calculator_graph",
                                        "MediaPipe calculator graph module.");
@@ -111,9 +267,9 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
                              "\'validated_graph_config\' to initialize the "
                              "graph with a ValidatedGraphConfig object.");
         }
-        auto calculator_graph = absl::make_unique<CalculatorGraph>();
+        auto calculator_graph = absl::make_unique<PyCalculatorGraph>();
         RaisePyErrorIfNotOk(calculator_graph->Initialize(graph_config_proto));
-        return calculator_graph.release();
+        return static_cast<CalculatorGraph*>(calculator_graph.release());
       }),
       R"doc(Initialize CalculatorGraph object.
 
@@ -207,6 +363,62 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
       py::arg("stream"), py::arg("packet"),
       py::arg("timestamp") = Timestamp::Unset());
 
+  calculator_graph.def(
+      "add_packets_to_input_stream",
+      [](CalculatorGraph* self,
+         const std::vector<std::pair<std::string, Packet>>& packets,
+         const Timestamp& timestamp) {
+        std::vector<std::pair<std::string, Packet>> timestamped_packets;
+        timestamped_packets.reserve(packets.size());
+        for (const auto& [stream, packet] : packets) {
+          Timestamp packet_timestamp =
+              timestamp == Timestamp::Unset() ? packet.Timestamp() : timestamp;
+          if (!packet_timestamp.IsAllowedInStream()) {
+            throw RaisePyError(
+                PyExc_ValueError,
+                absl::StrCat(packet_timestamp.DebugString(),
+                             " can't be the timestamp of a Packet in a stream.")
+                    .c_str());
+          }
+          timestamped_packets.emplace_back(stream,
+                                           packet.At(packet_timestamp));
+        }
+        py::gil_scoped_release gil_release;
+        for (auto& [stream, packet] : timestamped_packets) {
+          RaisePyErrorIfNotOk(
+              self->AddPacketToInputStream(stream, std::move(packet)),
+              /**acquire_gil=*/true);
+        }
+      },
+      R"doc(Add a batch of packets to graph input streams.
+
+  Behaves like calling add_packet_to_input_stream() for each (stream, packet)
+  pair in order, but releases the GIL only once for the whole batch. This is
+  useful to feed several input streams at the same timestamp, or several
+  timestamps of a stream, without paying for a Python call per packet.
+  All packet timestamps are validated before any packet is added. If adding a
+  packet fails, the packets preceding it in the batch remain added.
+
+  Args:
+    packets: A list of (stream name, packet) pairs.
+    timestamp: The timestamp of all the packets. If set, the original packet
+      timestamps will be overwritten.
+
+  Raises:
+    RuntimeError: If a stream is not a graph input stream or a packet can't be
+      added into its input stream due to the limited queue size or the wrong
+      packet type.
+    ValueError: If the timestamp of a Packet is invalid to be the timestamp of
+      a Packet in a stream.
+
+  Examples:
+    graph.add_packets_to_input_stream(
+        [('in_a', packet_creator.create_string('hello')),
+         ('in_b', packet_creator.create_int(42))],
+        timestamp=1)
+)doc",
+      py::arg("packets"), py::arg("timestamp") = Timestamp::Unset());
+
   calculator_graph.def(
       "close_input_stream",
       [](CalculatorGraph* self, const std::string& stream) {
@@ -293,6 +505,7 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
       [](CalculatorGraph* self) {
         py::gil_scoped_release gil_release;
         RaisePyErrorIfNotOk(self->WaitUntilDone(), /**acquire_gil=*/true);
+        FlushBatchedOutput(self);
       },
       R"doc(Wait for the current run to finish.
 
@@ -321,6 +534,7 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
       [](CalculatorGraph* self) {
         py::gil_scoped_release gil_release;
         RaisePyErrorIfNotOk(self->WaitUntilIdle(), /**acquire_gil=*/true);
+        FlushBatchedOutput(self);
       },
       R"doc(Wait until the running graph is in the idle mode.
 
@@ -352,6 +566,7 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
         py::gil_scoped_release gil_release;
         RaisePyErrorIfNotOk(self->WaitForObservedOutput(),
                             /**acquire_gil=*/true);
+        FlushBatchedOutput(self);
       },
       R"doc(Wait until a packet is emitted on one of the observed output streams.
 
@@ -438,6 +653,59 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
     graph.observe_output_stream('out',
                                 lambda stream_name, packet: out.append(packet))
 
+)doc",
+      py::arg("stream_name"), py::arg("callback_fn"),
+      py::arg("observe_timestamp_bounds") = false);
+
+  calculator_graph.def(
+      "observe_output_stream_batched",
+      [](CalculatorGraph* self, const std::string& stream_name,
+         pybind11::function callback_fn, bool observe_timestamp_bounds) {
+        auto* py_graph = dynamic_cast<PyCalculatorGraph*>(self);
+        if (!py_graph) {
+          throw RaisePyError(PyExc_RuntimeError,
+                             "Batched output stream observers are only "
+                             "supported by graphs created in Python.");
+        }
+        std::shared_ptr<BatchedOutputDispatcher> dispatcher =
+            py_graph->GetOrCreateDispatcher();
+        const int index = dispatcher->AddCallback(stream_name, callback_fn);
+        RaisePyErrorIfNotOk(self->ObserveOutputStream(
+            stream_name,
+            [dispatcher, index](const Packet& packet) {
+              dispatcher->Push(index, packet);
+              return absl::OkStatus();
+            },
+            observe_timestamp_bounds));
+      },
+      R"doc(Observe the named output stream without blocking the graph on the GIL.
+
+  Unlike observe_output_stream(), the graph threads never acquire the GIL: they
+  queue the output packets, and a single dispatcher thread per graph invokes
+  callback_fn with all the packets the stream has emitted since the previous
+  invocation. Packets are delivered in order. close(), wait_until_done(),
+  wait_until_idle() and wait_for_observed_output() return only after the
+  packets emitted so far have been delivered. Exceptions raised by callback_fn
+  are reported as unraisable and do not stop the graph. This method can only be
+  called before start_run().
+
+  Args:
+    stream_name: The name of the output stream.
+    callback_fn: The callback function to invoke with the stream name and a
+      list of packets emitted by the output stream.
+    observe_timestamp_bounds: If true, emits an empty packet at
+      timestamp_bound -1 when timestamp bound changes.
+
+  Raises:
+    RuntimeError: If the calculator graph isn't initialized or the stream
+      doesn't exist.
+
+  Examples:
+    out = []
+    graph = mp.CalculatorGraph(graph_config=graph_config)
+    graph.observe_output_stream_batched(
+        'out', lambda stream_name, packets: out.extend(packets))
+
 )doc",
       py::arg("stream_name"), py::arg("callback_fn"),
       py::arg("observe_timestamp_bounds") = false);
@@ -448,6 +716,7 @@ void CalculatorGraphSubmodule(pybind11::module* module) {
         RaisePyErrorIfNotOk(self->CloseAllPacketSources());
         py::gil_scoped_release gil_release;
         RaisePyErrorIfNotOk(self->WaitUntilDone(), /**acquire_gil=*/true);
+        FlushBatchedOutput(self);
       },
       R"doc(Close all the input sources and shutdown the graph.)doc");
 
@@ -81,8 +81,16 @@ void ImageSubmodule(pybind11::module* module) {
   copied_ndarray = np.copy(output_ndarray)
   copied_ndarray[0,0,0] = 0
   ```
+
+  Image also implements the buffer protocol, so `np.asarray(image)` or
+  `memoryview(image)` returns an unwritable view of the pixel data without any
+  copy, even if the rows are padded. The view keeps the Image alive.
   )doc",
-      py::dynamic_attr());
+      py::dynamic_attr(), py::buffer_protocol());
+
+  image.def_buffer([](Image& self) {
+    return ImageFrameBufferInfo(*self.GetImageFrameSharedPtr());
+  });
 
   image
       .def(
@@ -111,8 +111,16 @@ void ImageFrameSubmodule(pybind11::module* module) {
     print(output_ndarray[0, 0, 0])
     copied_ndarray = np.copy(output_ndarray)
     copied_ndarray[0,0,0] = 0
+
+  ImageFrame also implements the buffer protocol, so `np.asarray(image_frame)`
+  or `memoryview(image_frame)` returns an unwritable view of the pixel data
+  without any copy, even if the rows are padded. The view keeps the ImageFrame
+  alive.
   )doc",
-      py::dynamic_attr());
+      py::dynamic_attr(), py::buffer_protocol());
+
+  image_frame.def_buffer(
+      [](ImageFrame& self) { return ImageFrameBufferInfo(self); });
 
   image_frame
       .def(
@@ -16,6 +16,7 @@
 #define MEDIAPIPE_PYTHON_PYBIND_IMAGE_FRAME_UTIL_H_
 
 #include <cstdint>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "absl/strings/str_cat.h"
@@ -51,15 +52,61 @@ std::unique_ptr<ImageFrame> CreateImageFrame(
                                ImageFrame::kGlDefaultAlignmentBoundary);
     return image_frame_copy;
   }
+  // The ImageFrame wraps the numpy buffer and keeps the array alive until the
+  // frame is destroyed, which may happen on a graph thread once the last
+  // packet holding it is released. The GIL must be held to drop the reference.
   PyObject* data_pyobject = data.ptr();
   auto image_frame = absl::make_unique<ImageFrame>(
       format, /*width=*/cols, /*height=*/rows, width_step,
-      static_cast<uint8_t*>(data.request().ptr),
-      /*deleter=*/[data_pyobject](uint8_t*) { Py_XDECREF(data_pyobject); });
+      reinterpret_cast<uint8_t*>(const_cast<T*>(data.data())),
+      /*deleter=*/[data_pyobject](uint8_t*) {
+        if (!Py_IsInitialized()) return;
+        py::gil_scoped_acquire gil_acquire;
+        Py_XDECREF(data_pyobject);
+      });
   Py_XINCREF(data_pyobject);
   return image_frame;
 }
 
+template <typename T>
+py::buffer_info ImageFrameBufferInfoHelper(const ImageFrame& image_frame) {
+  std::vector<py::ssize_t> shape{image_frame.Height(), image_frame.Width()};
+  std::vector<py::ssize_t> strides{image_frame.WidthStep(),
+                                   image_frame.NumberOfChannels() *
+                                       static_cast<py::ssize_t>(sizeof(T))};
+  if (image_frame.NumberOfChannels() > 1) {
+    shape.push_back(image_frame.NumberOfChannels());
+    strides.push_back(sizeof(T));
+  }
+  return py::buffer_info(
+      const_cast<uint8_t*>(image_frame.PixelData()), sizeof(T),
+      py::format_descriptor<T>::format(), shape.size(), shape, strides,
+      /*readonly=*/true);
+}
+
+// Describes the pixel data of an image frame for the Python buffer protocol.
+// The row padding of a non-contiguous image frame is expressed by the row
+// stride, so the buffer always refers to the pixel data in place and never
+// copies it. The buffer is read-only since the image frame is immutable once
+// it has been created.
+inline py::buffer_info ImageFrameBufferInfo(const ImageFrame& image_frame) {
+  if (image_frame.IsEmpty()) {
+    throw RaisePyError(PyExc_RuntimeError, "ImageFrame is unallocated.");
+  }
+  switch (image_frame.ChannelSize()) {
+    case sizeof(uint8_t):
+      return ImageFrameBufferInfoHelper<uint8_t>(image_frame);
+    case sizeof(uint16_t):
+      return ImageFrameBufferInfoHelper<uint16_t>(image_frame);
+    case sizeof(float):
+      return ImageFrameBufferInfoHelper<float>(image_frame);
+    default:
+      throw RaisePyError(PyExc_RuntimeError,
+                         "Unsupported image frame channel size. Data is not "
+                         "uint8, uint16, or float?");
+  }
+}
+
 template <typename T>
 py::array GenerateContiguousDataArrayHelper(const ImageFrame& image_frame,
                                             const py::object& py_object) {
@@ -0,0 +1,49 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the AudioClassifier task: cold start, audio clips latency and
+// audio stream throughput on the CPU delegate.
+
+#include <cstdint>
+
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/tasks/cc/audio/audio_classifier/audio_classifier.h"
+#include "mediapipe/tasks/cc/benchmark/audio/audio_task_benchmark.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::audio::audio_classifier::AudioClassifier;
+using ::mediapipe::tasks::audio::audio_classifier::AudioClassifierOptions;
+
+constexpr char kModel[] = "yamnet_audio_classifier_with_metadata.tflite";
+
+const bool kRegistered =
+    RegisterAudioTaskBenchmarks<AudioClassifier, AudioClassifierOptions>(
+        "AudioClassifier", kModel,
+        [](AudioClassifier& task, const Matrix& clip, double sample_rate) {
+          return task.Classify(clip, sample_rate).status();
+        },
+        [](AudioClassifier& task, const Matrix& block, double sample_rate,
+           int64_t timestamp_ms) {
+          return task.ClassifyAsync(block, sample_rate, timestamp_ms);
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,49 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the AudioEmbedder task: cold start, audio clips latency and audio
+// stream throughput on the CPU delegate.
+
+#include <cstdint>
+
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/tasks/cc/audio/audio_embedder/audio_embedder.h"
+#include "mediapipe/tasks/cc/benchmark/audio/audio_task_benchmark.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::audio::audio_embedder::AudioEmbedder;
+using ::mediapipe::tasks::audio::audio_embedder::AudioEmbedderOptions;
+
+constexpr char kModel[] = "yamnet_embedding_metadata.tflite";
+
+const bool kRegistered =
+    RegisterAudioTaskBenchmarks<AudioEmbedder, AudioEmbedderOptions>(
+        "AudioEmbedder", kModel,
+        [](AudioEmbedder& task, const Matrix& clip, double sample_rate) {
+          return task.Embed(clip, sample_rate).status();
+        },
+        [](AudioEmbedder& task, const Matrix& block, double sample_rate,
+           int64_t timestamp_ms) {
+          return task.EmbedAsync(block, sample_rate, timestamp_ms);
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
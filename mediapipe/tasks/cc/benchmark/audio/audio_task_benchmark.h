@@ -0,0 +1,139 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_BENCHMARK_AUDIO_AUDIO_TASK_BENCHMARK_H_
+#define MEDIAPIPE_TASKS_CC_BENCHMARK_AUDIO_AUDIO_TASK_BENCHMARK_H_
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/tasks/cc/audio/core/running_mode.h"
+#include "mediapipe/tasks/cc/benchmark/task_benchmark.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+
+// The directory of the default test models of the audio tasks.
+inline constexpr char kAudioTestDataDirectory[] =
+    "./mediapipe/tasks/testdata/audio/";
+
+// The sample rate of the benchmark audio, the input rate of YAMNet.
+inline constexpr double kAudioSampleRate = 16000;
+
+// The duration of the audio blocks sent in audio stream mode.
+inline constexpr int64_t kAudioBlockMs = 100;
+
+// Returns a mono 440 Hz tone of `duration_ms`. The processing time of the
+// audio tasks doesn't depend on the content of the audio.
+inline Matrix MakeBenchmarkAudio(int64_t duration_ms) {
+  const int num_samples = kAudioSampleRate * duration_ms / 1000;
+  Matrix audio(1, num_samples);
+  for (int i = 0; i < num_samples; ++i) {
+    audio(0, i) = 0.5f * std::sin(2 * M_PI * 440 * i / kAudioSampleRate);
+  }
+  return audio;
+}
+
+// Creates the audio task `Task` with the model given with --model or
+// `default_model`, in `running_mode`. `on_result` is called for each result in
+// audio stream mode.
+template <typename Task, typename Options>
+absl::StatusOr<std::unique_ptr<Task>> CreateAudioTask(
+    const std::string& default_model, audio::core::RunningMode running_mode,
+    bool enable_profiler, std::function<void()> on_result = nullptr) {
+  auto options = std::make_unique<Options>();
+  options->base_options.model_asset_path =
+      GetModelPath(absl::StrCat(kAudioTestDataDirectory, default_model));
+  options->base_options.enable_profiler = enable_profiler;
+  options->running_mode = running_mode;
+  if (on_result) {
+    options->result_callback = [on_result = std::move(on_result)](auto&&...) {
+      on_result();
+    };
+  }
+  return Task::Create(std::move(options));
+}
+
+// Registers the cold start, latency and audio stream benchmarks of the audio
+// task `Task` on the CPU delegate, named "<name>/ColdStart/CPU",
+// "<name>/Latency/CPU" and "<name>/LiveStream/CPU". `run` processes a one
+// second clip in audio clips mode, and `run_async` sends a block of an audio
+// stream with its timestamp. Returns true, so that it can initialize a static
+// variable.
+template <typename Task, typename Options>
+bool RegisterAudioTaskBenchmarks(
+    const std::string& name, const std::string& default_model,
+    std::function<absl::Status(Task&, const Matrix&, double)> run,
+    std::function<absl::Status(Task&, const Matrix&, double, int64_t)>
+        run_async) {
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/ColdStart"), {core::BaseOptions::CPU},
+      [default_model](::benchmark::State& state, core::BaseOptions::Delegate) {
+        RunColdStartBenchmark<Task>(state, [&]() {
+          return CreateAudioTask<Task, Options>(
+              default_model, audio::core::RunningMode::AUDIO_CLIPS,
+              /*enable_profiler=*/false);
+        });
+      });
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/Latency"), {core::BaseOptions::CPU},
+      [default_model, run](::benchmark::State& state,
+                           core::BaseOptions::Delegate) {
+        const Matrix clip = MakeBenchmarkAudio(/*duration_ms=*/1000);
+        RunLatencyBenchmark<Task>(
+            state,
+            [&]() {
+              return CreateAudioTask<Task, Options>(
+                  default_model, audio::core::RunningMode::AUDIO_CLIPS,
+                  /*enable_profiler=*/true);
+            },
+            [&](Task& task) { return run(task, clip, kAudioSampleRate); });
+      });
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/LiveStream"), {core::BaseOptions::CPU},
+      [default_model, run_async](::benchmark::State& state,
+                                 core::BaseOptions::Delegate) {
+        const Matrix block = MakeBenchmarkAudio(kAudioBlockMs);
+        RunLiveStreamBenchmark<Task>(
+            state,
+            [&](std::function<void()> on_result) {
+              return CreateAudioTask<Task, Options>(
+                  default_model, audio::core::RunningMode::AUDIO_STREAM,
+                  /*enable_profiler=*/false, std::move(on_result));
+            },
+            [&](Task& task, int64_t block_index) {
+              return run_async(task, block, kAudioSampleRate,
+                               /*timestamp_ms=*/block_index * kAudioBlockMs);
+            });
+      });
+  return true;
+}
+
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_BENCHMARK_AUDIO_AUDIO_TASK_BENCHMARK_H_
@@ -0,0 +1,162 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/benchmark/task_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+ABSL_FLAG(std::string, model, "",
+          "The model to benchmark, instead of the default test model of the "
+          "task.");
+ABSL_FLAG(std::string, input, "",
+          "The input to run the task on, instead of the default test input: "
+          "an image path for vision tasks, or a text for text tasks.");
+ABSL_FLAG(int, warmup_iterations, 10,
+          "The number of inferences run before measuring latency.");
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+
+namespace {
+
+// Returns the value at `percentile` of the sorted `values`, interpolating
+// linearly between the closest ranks as numpy.percentile does.
+double Percentile(const std::vector<double>& values, double percentile) {
+  if (values.empty()) return 0.0;
+  const double rank = percentile / 100.0 * (values.size() - 1);
+  const size_t lower = static_cast<size_t>(std::floor(rank));
+  const size_t upper = std::min(lower + 1, values.size() - 1);
+  return values[lower] + (rank - lower) * (values[upper] - values[lower]);
+}
+
+}  // namespace
+
+std::string GetModelPath(absl::string_view default_model_path) {
+  const std::string model = absl::GetFlag(FLAGS_model);
+  return model.empty() ? std::string(default_model_path) : model;
+}
+
+std::string GetInput(absl::string_view default_input) {
+  const std::string input = absl::GetFlag(FLAGS_input);
+  return input.empty() ? std::string(default_input) : input;
+}
+
+void LatencyRecorder::Record(absl::Duration latency) {
+  latencies_ms_.push_back(absl::ToDoubleMilliseconds(latency));
+}
+
+void LatencyRecorder::Report(::benchmark::State& state) const {
+  std::vector<double> sorted = latencies_ms_;
+  std::sort(sorted.begin(), sorted.end());
+  state.counters["p50_ms"] = Percentile(sorted, 50);
+  state.counters["p99_ms"] = Percentile(sorted, 99);
+  state.counters["mean_ms"] =
+      sorted.empty()
+          ? 0.0
+          : std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+}
+
+int64_t PeakRssBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#if defined(__APPLE__)
+  // ru_maxrss is in bytes on macOS.
+  return usage.ru_maxrss;
+#else
+  // ru_maxrss is in kilobytes on Linux.
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif  // __APPLE__
+#else
+  return -1;
+#endif  // __linux__ || __APPLE__
+}
+
+void ReportPeakRss(::benchmark::State& state) {
+  const int64_t peak_rss = PeakRssBytes();
+  if (peak_rss >= 0) {
+    state.counters["peak_rss_mb"] = peak_rss / (1024.0 * 1024.0);
+  }
+}
+
+void ReportCalculatorProfiles(const std::vector<CalculatorProfile>& profiles,
+                              ::benchmark::State& state) {
+  for (const CalculatorProfile& profile : profiles) {
+    const TimeHistogram& runtime = profile.process_runtime();
+    const int64_t count =
+        std::accumulate(runtime.count().begin(), runtime.count().end(),
+                        int64_t{0});
+    if (count == 0) continue;
+    state.counters[absl::StrCat(profile.name(), "_us")] =
+        static_cast<double>(runtime.total()) / count;
+  }
+}
+
+void RegisterDelegateBenchmarks(
+    const std::string& name,
+    const std::vector<core::BaseOptions::Delegate>& delegates,
+    std::function<void(::benchmark::State&, core::BaseOptions::Delegate)>
+        benchmark) {
+  for (core::BaseOptions::Delegate delegate : delegates) {
+    std::string delegate_name;
+    switch (delegate) {
+      case core::BaseOptions::CPU:
+        delegate_name = "CPU";
+        break;
+      case core::BaseOptions::GPU:
+#if MEDIAPIPE_DISABLE_GPU
+        continue;
+#else
+        delegate_name = "GPU";
+        break;
+#endif  // MEDIAPIPE_DISABLE_GPU
+      case core::BaseOptions::EDGETPU_NNAPI:
+        delegate_name = "EDGETPU_NNAPI";
+        break;
+    }
+    ::benchmark::RegisterBenchmark(
+        absl::StrCat(name, "/", delegate_name).c_str(),
+        [benchmark, delegate](::benchmark::State& state) {
+          benchmark(state, delegate);
+        })
+        ->UseRealTime()
+        ->Unit(::benchmark::kMillisecond);
+  }
+}
+
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,169 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_BENCHMARK_TASK_BENCHMARK_H_
+#define MEDIAPIPE_TASKS_CC_BENCHMARK_TASK_BENCHMARK_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/functional/function_ref.h"
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+
+// The model to benchmark, instead of the default test model of the task.
+ABSL_DECLARE_FLAG(std::string, model);
+// The input to run the task on, instead of the default test input: an image
+// path for vision tasks, or a text for text tasks.
+ABSL_DECLARE_FLAG(std::string, input);
+// The number of inferences run before measuring latency.
+ABSL_DECLARE_FLAG(int, warmup_iterations);
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+
+// Returns the path given with --model, or `default_model_path`.
+std::string GetModelPath(absl::string_view default_model_path);
+
+// Returns the input given with --input, or `default_input`.
+std::string GetInput(absl::string_view default_input);
+
+// Collects the latency of each benchmark iteration.
+class LatencyRecorder {
+ public:
+  void Record(absl::Duration latency);
+
+  // Reports the median, 99th percentile and mean latency as the counters
+  // "p50_ms", "p99_ms" and "mean_ms" of `state`.
+  void Report(::benchmark::State& state) const;
+
+ private:
+  std::vector<double> latencies_ms_;
+};
+
+// Returns the peak resident set size of the process in bytes, or -1 if it is
+// not available on this platform.
+int64_t PeakRssBytes();
+
+// Reports the peak resident set size as the counter "peak_rss_mb" of `state`.
+void ReportPeakRss(::benchmark::State& state);
+
+// Reports the mean Process() time of each calculator in `profiles` as the
+// counter "<calculator name>_us" of `state`.
+void ReportCalculatorProfiles(const std::vector<CalculatorProfile>& profiles,
+                              ::benchmark::State& state);
+
+// Registers `benchmark` for each delegate in `delegates` as "<name>/CPU" and
+// "<name>/GPU". The GPU delegate is skipped if GPU support is disabled.
+void RegisterDelegateBenchmarks(
+    const std::string& name,
+    const std::vector<core::BaseOptions::Delegate>& delegates,
+    std::function<void(::benchmark::State&, core::BaseOptions::Delegate)>
+        benchmark);
+
+// Measures the cold-start time of a task: creating it from its model and
+// initializing the inference engine, until it is ready to process inputs.
+template <typename Task>
+void RunColdStartBenchmark(
+    ::benchmark::State& state,
+    absl::FunctionRef<absl::StatusOr<std::unique_ptr<Task>>()> create) {
+  for (auto _ : state) {
+    absl::StatusOr<std::unique_ptr<Task>> task = create();
+    ABSL_CHECK_OK(task.status());
+    state.PauseTiming();
+    ABSL_CHECK_OK((*task)->Close());
+    task->reset();
+    state.ResumeTiming();
+  }
+  ReportPeakRss(state);
+}
+
+// Measures the latency of `run` on a warm task, created with the profiler
+// enabled, and reports the latency percentiles and the per-calculator
+// profiles.
+template <typename Task>
+void RunLatencyBenchmark(
+    ::benchmark::State& state,
+    absl::FunctionRef<absl::StatusOr<std::unique_ptr<Task>>()> create,
+    absl::FunctionRef<absl::Status(Task&)> run) {
+  absl::StatusOr<std::unique_ptr<Task>> task = create();
+  ABSL_CHECK_OK(task.status());
+  for (int i = 0; i < absl::GetFlag(FLAGS_warmup_iterations); ++i) {
+    ABSL_CHECK_OK(run(**task));
+  }
+  LatencyRecorder latencies;
+  for (auto _ : state) {
+    const absl::Time start = absl::Now();
+    ABSL_CHECK_OK(run(**task));
+    latencies.Record(absl::Now() - start);
+  }
+  latencies.Report(state);
+  absl::StatusOr<std::vector<CalculatorProfile>> profiles =
+      (*task)->GetCalculatorProfiles();
+  ABSL_CHECK_OK(profiles.status());
+  ReportCalculatorProfiles(*profiles, state);
+  ABSL_CHECK_OK((*task)->Close());
+  ReportPeakRss(state);
+}
+
+// Measures the throughput of a task in live stream mode. `create` creates the
+// task with a result callback calling its argument, and `send` sends the
+// input with the given index without waiting for the result. Inputs are sent
+// as fast as the task accepts them, so vision tasks drop the frames arriving
+// while they are busy, as with a camera outpacing the model. Reports the
+// inputs and results per second.
+template <typename Task>
+void RunLiveStreamBenchmark(
+    ::benchmark::State& state,
+    absl::FunctionRef<absl::StatusOr<std::unique_ptr<Task>>(
+        std::function<void()> on_result)>
+        create,
+    absl::FunctionRef<absl::Status(Task&, int64_t input_index)> send) {
+  std::atomic<int64_t> num_results = 0;
+  absl::StatusOr<std::unique_ptr<Task>> task = create([&num_results]() {
+    num_results.fetch_add(1, std::memory_order_relaxed);
+  });
+  ABSL_CHECK_OK(task.status());
+  int64_t num_inputs = 0;
+  const absl::Time start = absl::Now();
+  for (auto _ : state) {
+    ABSL_CHECK_OK(send(**task, num_inputs++));
+  }
+  // Close() waits for the pending inputs to be processed.
+  ABSL_CHECK_OK((*task)->Close());
+  const double seconds = absl::ToDoubleSeconds(absl::Now() - start);
+  state.counters["inputs_per_second"] = num_inputs / seconds;
+  state.counters["results_per_second"] = num_results.load() / seconds;
+  ReportPeakRss(state);
+}
+
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_BENCHMARK_TASK_BENCHMARK_H_
@@ -0,0 +1,43 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the TextClassifier task: cold start and latency on the CPU
+// delegate.
+
+#include "absl/strings/string_view.h"
+#include "mediapipe/tasks/cc/benchmark/text/text_task_benchmark.h"
+#include "mediapipe/tasks/cc/text/text_classifier/text_classifier.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::text::text_classifier::TextClassifier;
+using ::mediapipe::tasks::text::text_classifier::TextClassifierOptions;
+
+constexpr char kModel[] = "bert_text_classifier.tflite";
+
+const bool kRegistered =
+    RegisterTextTaskBenchmarks<TextClassifier, TextClassifierOptions>(
+        "TextClassifier", kModel,
+        [](TextClassifier& task, absl::string_view text) {
+          return task.Classify(text).status();
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,42 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the TextEmbedder task: cold start and latency on the CPU
+// delegate.
+
+#include "absl/strings/string_view.h"
+#include "mediapipe/tasks/cc/benchmark/text/text_task_benchmark.h"
+#include "mediapipe/tasks/cc/text/text_embedder/text_embedder.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::text::text_embedder::TextEmbedder;
+using ::mediapipe::tasks::text::text_embedder::TextEmbedderOptions;
+
+constexpr char kModel[] = "mobilebert_embedding_with_metadata.tflite";
+
+const bool kRegistered =
+    RegisterTextTaskBenchmarks<TextEmbedder, TextEmbedderOptions>(
+        "TextEmbedder", kModel, [](TextEmbedder& task, absl::string_view text) {
+          return task.Embed(text).status();
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,92 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_BENCHMARK_TEXT_TEXT_TASK_BENCHMARK_H_
+#define MEDIAPIPE_TASKS_CC_BENCHMARK_TEXT_TEXT_TASK_BENCHMARK_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/tasks/cc/benchmark/task_benchmark.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+
+// The directory of the default test models of the text tasks.
+inline constexpr char kTextTestDataDirectory[] =
+    "./mediapipe/tasks/testdata/text/";
+
+// The default input of the text tasks.
+inline constexpr char kDefaultText[] =
+    "it's a charming and often affecting journey";
+
+// Creates the text task `Task` with the model given with --model or
+// `default_model`.
+template <typename Task, typename Options>
+absl::StatusOr<std::unique_ptr<Task>> CreateTextTask(
+    const std::string& default_model, bool enable_profiler) {
+  auto options = std::make_unique<Options>();
+  options->base_options.model_asset_path =
+      GetModelPath(absl::StrCat(kTextTestDataDirectory, default_model));
+  options->base_options.enable_profiler = enable_profiler;
+  return Task::Create(std::move(options));
+}
+
+// Registers the cold start and latency benchmarks of the text task `Task` on
+// the CPU delegate, named "<name>/ColdStart/CPU" and "<name>/Latency/CPU".
+// `run` processes a text. Text tasks have no live stream mode. Returns true,
+// so that it can initialize a static variable.
+template <typename Task, typename Options>
+bool RegisterTextTaskBenchmarks(
+    const std::string& name, const std::string& default_model,
+    std::function<absl::Status(Task&, absl::string_view)> run) {
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/ColdStart"), {core::BaseOptions::CPU},
+      [default_model](::benchmark::State& state, core::BaseOptions::Delegate) {
+        RunColdStartBenchmark<Task>(state, [&]() {
+          return CreateTextTask<Task, Options>(default_model,
+                                               /*enable_profiler=*/false);
+        });
+      });
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/Latency"), {core::BaseOptions::CPU},
+      [default_model, run](::benchmark::State& state,
+                           core::BaseOptions::Delegate) {
+        const std::string text = GetInput(kDefaultText);
+        RunLatencyBenchmark<Task>(
+            state,
+            [&]() {
+              return CreateTextTask<Task, Options>(default_model,
+                                                   /*enable_profiler=*/true);
+            },
+            [&](Task& task) { return run(task, text); });
+      });
+  return true;
+}
+
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_BENCHMARK_TEXT_TEXT_TASK_BENCHMARK_H_
@@ -0,0 +1,49 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the ImageClassifier task: cold start, image mode latency and live
+// stream throughput on the CPU and GPU delegates.
+
+#include <cstdint>
+
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/tasks/cc/benchmark/vision/vision_task_benchmark.h"
+#include "mediapipe/tasks/cc/vision/image_classifier/image_classifier.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::vision::image_classifier::ImageClassifier;
+using ::mediapipe::tasks::vision::image_classifier::ImageClassifierOptions;
+
+constexpr char kModel[] = "mobilenet_v2_1.0_224.tflite";
+constexpr char kImage[] = "burger.jpg";
+
+const bool kRegistered =
+    RegisterVisionTaskBenchmarks<ImageClassifier, ImageClassifierOptions>(
+        "ImageClassifier", kModel, kImage,
+        [](ImageClassifier& task, const Image& image) {
+          return task.Classify(image).status();
+        },
+        [](ImageClassifier& task, const Image& image, int64_t timestamp_ms) {
+          return task.ClassifyAsync(image, timestamp_ms);
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,49 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Benchmarks the PoseLandmarker task: cold start, image mode latency and live
+// stream throughput on the CPU and GPU delegates.
+
+#include <cstdint>
+
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/tasks/cc/benchmark/vision/vision_task_benchmark.h"
+#include "mediapipe/tasks/cc/vision/pose_landmarker/pose_landmarker.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+namespace {
+
+using ::mediapipe::tasks::vision::pose_landmarker::PoseLandmarker;
+using ::mediapipe::tasks::vision::pose_landmarker::PoseLandmarkerOptions;
+
+constexpr char kModel[] = "pose_landmarker.task";
+constexpr char kImage[] = "pose.jpg";
+
+const bool kRegistered =
+    RegisterVisionTaskBenchmarks<PoseLandmarker, PoseLandmarkerOptions>(
+        "PoseLandmarker", kModel, kImage,
+        [](PoseLandmarker& task, const Image& image) {
+          return task.Detect(image).status();
+        },
+        [](PoseLandmarker& task, const Image& image, int64_t timestamp_ms) {
+          return task.DetectAsync(image, timestamp_ms);
+        });
+
+}  // namespace
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
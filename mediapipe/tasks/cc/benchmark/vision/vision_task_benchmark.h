@@ -0,0 +1,136 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_BENCHMARK_VISION_VISION_TASK_BENCHMARK_H_
+#define MEDIAPIPE_TASKS_CC_BENCHMARK_VISION_VISION_TASK_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/log/absl_check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/port/benchmark.h"
+#include "mediapipe/tasks/cc/benchmark/task_benchmark.h"
+#include "mediapipe/tasks/cc/core/base_options.h"
+#include "mediapipe/tasks/cc/vision/core/running_mode.h"
+#include "mediapipe/tasks/cc/vision/utils/image_utils.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace benchmarking {
+
+// The directory of the default test models and images of the vision tasks.
+inline constexpr char kVisionTestDataDirectory[] =
+    "./mediapipe/tasks/testdata/vision/";
+
+// Creates the vision task `Task` with the model given with --model or
+// `default_model`, in `running_mode`. `on_result` is called for each result in
+// live stream mode.
+template <typename Task, typename Options>
+absl::StatusOr<std::unique_ptr<Task>> CreateVisionTask(
+    const std::string& default_model, core::BaseOptions::Delegate delegate,
+    vision::core::RunningMode running_mode, bool enable_profiler,
+    std::function<void()> on_result = nullptr) {
+  auto options = std::make_unique<Options>();
+  options->base_options.model_asset_path =
+      GetModelPath(absl::StrCat(kVisionTestDataDirectory, default_model));
+  options->base_options.delegate = delegate;
+  options->base_options.enable_profiler = enable_profiler;
+  options->running_mode = running_mode;
+  if (on_result) {
+    options->result_callback = [on_result = std::move(on_result)](auto&&...) {
+      on_result();
+    };
+  }
+  return Task::Create(std::move(options));
+}
+
+// Registers the cold start, latency and live stream benchmarks of the vision
+// task `Task` for the CPU and GPU delegates, named "<name>/ColdStart/CPU",
+// "<name>/Latency/CPU", etc. `run` processes an image in image mode, and
+// `run_async` sends an image with a timestamp in live stream mode. Returns
+// true, so that it can initialize a static variable.
+template <typename Task, typename Options>
+bool RegisterVisionTaskBenchmarks(
+    const std::string& name, const std::string& default_model,
+    const std::string& default_image,
+    std::function<absl::Status(Task&, const Image&)> run,
+    std::function<absl::Status(Task&, const Image&, int64_t)> run_async) {
+  const std::vector<core::BaseOptions::Delegate> delegates = {
+      core::BaseOptions::CPU, core::BaseOptions::GPU};
+  auto load_image = [default_image]() {
+    absl::StatusOr<Image> image = vision::DecodeImageFromFile(
+        GetInput(absl::StrCat(kVisionTestDataDirectory, default_image)));
+    ABSL_CHECK_OK(image.status());
+    return *std::move(image);
+  };
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/ColdStart"), delegates,
+      [default_model](::benchmark::State& state,
+                      core::BaseOptions::Delegate delegate) {
+        RunColdStartBenchmark<Task>(state, [&]() {
+          return CreateVisionTask<Task, Options>(
+              default_model, delegate, vision::core::RunningMode::IMAGE,
+              /*enable_profiler=*/false);
+        });
+      });
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/Latency"), delegates,
+      [default_model, load_image, run](::benchmark::State& state,
+                                       core::BaseOptions::Delegate delegate) {
+        const Image image = load_image();
+        RunLatencyBenchmark<Task>(
+            state,
+            [&]() {
+              return CreateVisionTask<Task, Options>(
+                  default_model, delegate, vision::core::RunningMode::IMAGE,
+                  /*enable_profiler=*/true);
+            },
+            [&](Task& task) { return run(task, image); });
+      });
+  RegisterDelegateBenchmarks(
+      absl::StrCat(name, "/LiveStream"), delegates,
+      [default_model, load_image, run_async](
+          ::benchmark::State& state, core::BaseOptions::Delegate delegate) {
+        const Image image = load_image();
+        RunLiveStreamBenchmark<Task>(
+            state,
+            [&](std::function<void()> on_result) {
+              return CreateVisionTask<Task, Options>(
+                  default_model, delegate,
+                  vision::core::RunningMode::LIVE_STREAM,
+                  /*enable_profiler=*/false, std::move(on_result));
+            },
+            // Frames are 1 ms apart, the smallest increment of the task
+            // timestamps.
+            [&](Task& task, int64_t frame_index) {
+              return run_async(task, image, /*timestamp_ms=*/frame_index);
+            });
+      });
+  return true;
+}
+
+}  // namespace benchmarking
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_BENCHMARK_VISION_VISION_TASK_BENCHMARK_H_
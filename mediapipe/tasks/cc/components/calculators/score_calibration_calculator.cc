@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -90,7 +91,20 @@ class ScoreCalibrationCalculator : public Node {
   absl::Status Process(CalculatorContext* cc) override;
 
  private:
+  // Sigmoid parameters unpacked from the options in Open(), so that the
+  // per-score loop does not go through the proto accessors.
+  struct Sigmoid {
+    // Whether any of scale, slope and offset is missing.
+    bool is_empty;
+    float min_score;
+    float scale;
+    float slope;
+    float offset;
+  };
+
   ScoreCalibrationCalculatorOptions options_;
+  std::vector<Sigmoid> sigmoids_;
+  float default_score_;
   std::function<float(float)> score_transformation_;
 
   // Computes the calibrated score for the provided index. Does not check for
@@ -108,6 +122,8 @@ absl::Status ScoreCalibrationCalculator::Open(CalculatorContext* cc) {
                                    "Expected at least one sigmoid, found none.",
                                    MediaPipeTasksStatus::kInvalidArgumentError);
   }
+  sigmoids_.clear();
+  sigmoids_.reserve(options_.sigmoids_size());
   for (const auto& sigmoid : options_.sigmoids()) {
     if (sigmoid.has_scale() && sigmoid.scale() < 0.0) {
       return CreateStatusWithPayload(
@@ -117,7 +133,18 @@ absl::Status ScoreCalibrationCalculator::Open(CalculatorContext* cc) {
                           sigmoid.scale()),
           MediaPipeTasksStatus::kInvalidArgumentError);
     }
+    Sigmoid& params = sigmoids_.emplace_back();
+    params.is_empty =
+        !sigmoid.has_scale() || !sigmoid.has_offset() || !sigmoid.has_slope();
+    // A missing min_score never rejects a score.
+    params.min_score = sigmoid.has_min_score()
+                           ? sigmoid.min_score()
+                           : -std::numeric_limits<float>::infinity();
+    params.scale = sigmoid.scale();
+    params.slope = sigmoid.slope();
+    params.offset = sigmoid.offset();
   }
+  default_score_ = options_.default_score();
   // Set score transformation function once and for all.
   switch (options_.score_transformation()) {
     case tasks::ScoreCalibrationCalculatorOptions::IDENTITY:
@@ -203,35 +230,30 @@ absl::Status ScoreCalibrationCalculator::Process(CalculatorContext* cc) {
 
 float ScoreCalibrationCalculator::ComputeCalibratedScore(int index,
                                                          float score) {
-  const auto& sigmoid = options_.sigmoids(index);
-
-  bool is_empty =
-      !sigmoid.has_scale() || !sigmoid.has_offset() || !sigmoid.has_slope();
-  bool is_below_min_score =
-      sigmoid.has_min_score() && score < sigmoid.min_score();
-  if (is_empty || is_below_min_score) {
-    return options_.default_score();
+  const Sigmoid& sigmoid = sigmoids_[index];
+  if (sigmoid.is_empty || score < sigmoid.min_score) {
+    return default_score_;
   }
 
   float transformed_score = score_transformation_(score);
   float scale_shifted_score =
-      transformed_score * sigmoid.slope() + sigmoid.offset();
+      transformed_score * sigmoid.slope + sigmoid.offset;
   // For numerical stability use 1 / (1+exp(-x)) when scale_shifted_score >= 0
   // and exp(x) / (1+exp(x)) when scale_shifted_score < 0.
   float calibrated_score;
   if (scale_shifted_score >= 0.0) {
     calibrated_score =
-        sigmoid.scale() /
+        sigmoid.scale /
         (1.0 + std::exp(static_cast<double>(-scale_shifted_score)));
   } else {
     float score_exp = std::exp(static_cast<double>(scale_shifted_score));
-    calibrated_score = sigmoid.scale() * score_exp / (1.0 + score_exp);
+    calibrated_score = sigmoid.scale * score_exp / (1.0 + score_exp);
   }
   // Scale is non-negative (checked in SigmoidFromLabelAndLine),
   // thus calibrated_score should be in the range of [0, scale]. However, due to
   // numberical stability issue, it may fall out of the boundary. Cap the value
   // to [0, scale] instead.
-  return std::max(std::min(calibrated_score, sigmoid.scale()), 0.0f);
+  return std::max(std::min(calibrated_score, sigmoid.scale), 0.0f);
 }
 
 absl::StatusOr<float> ScoreCalibrationCalculator::SafeComputeCalibratedScore(
@@ -242,7 +264,7 @@ absl::StatusOr<float> ScoreCalibrationCalculator::SafeComputeCalibratedScore(
         absl::StrFormat("Expected positive indices, found %d.", index),
         MediaPipeTasksStatus::kInvalidArgumentError);
   }
-  if (index > options_.sigmoids_size()) {
+  if (index >= static_cast<int>(sigmoids_.size())) {
     return CreateStatusWithPayload(
         StatusCode::kInvalidArgument,
         absl::StrFormat("Unable to get score calibration parameters for index "
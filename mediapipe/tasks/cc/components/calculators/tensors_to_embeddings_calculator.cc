@@ -15,6 +15,10 @@
 #include <math.h>
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_set.h"
@@ -51,15 +55,54 @@ float GetInverseL2Norm(const float* values, int size) {
   return inv_l2_norm;
 }
 
+// Number of fractional bits of the fixed-point multipliers used to requantize
+// quantized tensors.
+constexpr int kMultiplierShift = 24;
+// Any multiplier above this saturates every non-zero value to -128 or 127.
+constexpr double kMaxMultiplier = 1 << 15;
+
+// Returns the values of a quantized tensor minus their zero point, along with
+// the sum of their squares, without dequantizing them.
+template <typename T>
+int64_t CenterQuantizedValues(const Tensor& tensor, int32_t* centered) {
+  const int size = tensor.shape().num_elements();
+  const int32_t zero_point = tensor.quantization_parameters().zero_point;
+  auto tensor_view = tensor.GetCpuReadView();
+  const T* tensor_buffer = tensor_view.buffer<T>();
+  int64_t sum_of_squares = 0;
+  for (int i = 0; i < size; ++i) {
+    centered[i] = static_cast<int32_t>(tensor_buffer[i]) - zero_point;
+    sum_of_squares += static_cast<int64_t>(centered[i]) * centered[i];
+  }
+  return sum_of_squares;
+}
+
+// Computes round(value * multiplier), rounding half away from zero like
+// roundf(), clamped to the int8 range. `multiplier` has kMultiplierShift
+// fractional bits.
+char Requantize(int32_t value, int64_t multiplier) {
+  const int64_t magnitude =
+      (std::abs(static_cast<int64_t>(value)) * multiplier +
+       (int64_t{1} << (kMultiplierShift - 1))) >>
+      kMultiplierShift;
+  const int64_t result = value < 0 ? -magnitude : magnitude;
+  return static_cast<char>(
+      std::max<int64_t>(-128, std::min<int64_t>(result, 127)));
+}
+
 }  // namespace
 
 // Converts tensors into an EmbeddingResult object, performing optional
 // L2-normalization and scalar-quantization on-the-fly if required through the
 // options.
 //
+// Quantized (kUInt8 or kInt8) tensors are read as-is using their quantization
+// parameters: with quantization enabled they are L2-normalized and
+// requantized in fixed point, without being dequantized first.
+//
 // Input:
 //   TENSORS - std::vector<Tensor>
-//     A vector of one or more Tensors of type kFloat32.
+//     A vector of one or more Tensors of type kFloat32, kUInt8 or kInt8.
 // Output:
 //   EMBEDDINGS - EmbeddingResult
 //     The contents of the input tensors converted into an EmbeddingResult
@@ -79,8 +122,20 @@ class TensorsToEmbeddingsCalculator : public Node {
   std::vector<std::string> head_names_;
   absl::flat_hash_set<std::string> ignored_head_names_;
 
+  // Scratch buffer holding the zero-point-centered values of a quantized
+  // tensor.
+  std::vector<int32_t> centered_values_;
+
   void FillFloatEmbedding(const Tensor& tensor, Embedding* embedding);
   void FillQuantizedEmbedding(const Tensor& tensor, Embedding* embedding);
+  // Same as above, for kUInt8 and kInt8 tensors.
+  void FillFloatEmbeddingFromQuantizedTensor(const Tensor& tensor,
+                                             Embedding* embedding);
+  void FillQuantizedEmbeddingFromQuantizedTensor(const Tensor& tensor,
+                                                 Embedding* embedding);
+  // Fills `centered_values_` from a kUInt8 or kInt8 tensor and returns the sum
+  // of their squares.
+  int64_t CenterQuantizedTensor(const Tensor& tensor);
 };
 
 absl::Status TensorsToEmbeddingsCalculator::Open(CalculatorContext* cc) {
@@ -111,13 +166,23 @@ absl::Status TensorsToEmbeddingsCalculator::Process(CalculatorContext* cc) {
       continue;
     }
     const auto& tensor = tensors[i];
-    RET_CHECK(tensor.element_type() == Tensor::ElementType::kFloat32);
+    const bool is_quantized_tensor =
+        tensor.element_type() == Tensor::ElementType::kUInt8 ||
+        tensor.element_type() == Tensor::ElementType::kInt8;
+    RET_CHECK(is_quantized_tensor ||
+              tensor.element_type() == Tensor::ElementType::kFloat32);
     auto* embedding = result.add_embeddings();
     embedding->set_head_index(i);
     if (!head_names_.empty()) {
       embedding->set_head_name(head_names_[i]);
     }
-    if (quantize_) {
+    if (is_quantized_tensor) {
+      if (quantize_) {
+        FillQuantizedEmbeddingFromQuantizedTensor(tensor, embedding);
+      } else {
+        FillFloatEmbeddingFromQuantizedTensor(tensor, embedding);
+      }
+    } else if (quantize_) {
       FillQuantizedEmbedding(tensor, embedding);
     } else {
       FillFloatEmbedding(tensor, embedding);
@@ -134,9 +199,11 @@ void TensorsToEmbeddingsCalculator::FillFloatEmbedding(const Tensor& tensor,
   const float* tensor_buffer = tensor_view.buffer<float>();
   float inv_l2_norm =
       l2_normalize_ ? GetInverseL2Norm(tensor_buffer, size) : 1.0f;
-  auto* float_embedding = embedding->mutable_float_embedding();
+  auto* values = embedding->mutable_float_embedding()->mutable_values();
+  values->Resize(size, 0.0f);
+  float* values_buffer = values->mutable_data();
   for (int i = 0; i < size; ++i) {
-    float_embedding->add_values(tensor_buffer[i] * inv_l2_norm);
+    values_buffer[i] = tensor_buffer[i] * inv_l2_norm;
   }
 }
 
@@ -160,6 +227,51 @@ void TensorsToEmbeddingsCalculator::FillQuantizedEmbedding(
   }
 }
 
+int64_t TensorsToEmbeddingsCalculator::CenterQuantizedTensor(
+    const Tensor& tensor) {
+  centered_values_.resize(tensor.shape().num_elements());
+  if (tensor.element_type() == Tensor::ElementType::kUInt8) {
+    return CenterQuantizedValues<uint8_t>(tensor, centered_values_.data());
+  }
+  return CenterQuantizedValues<int8_t>(tensor, centered_values_.data());
+}
+
+void TensorsToEmbeddingsCalculator::FillFloatEmbeddingFromQuantizedTensor(
+    const Tensor& tensor, Embedding* embedding) {
+  const int64_t sum_of_squares = CenterQuantizedTensor(tensor);
+  // The scale cancels out in the L2-normalization.
+  float multiplier = tensor.quantization_parameters().scale;
+  if (l2_normalize_ && sum_of_squares > 0) {
+    multiplier = 1.0f / std::sqrt(static_cast<float>(sum_of_squares));
+  }
+  auto* values = embedding->mutable_float_embedding()->mutable_values();
+  values->Resize(centered_values_.size(), 0.0f);
+  float* values_buffer = values->mutable_data();
+  for (int i = 0; i < centered_values_.size(); ++i) {
+    values_buffer[i] = centered_values_[i] * multiplier;
+  }
+}
+
+void TensorsToEmbeddingsCalculator::FillQuantizedEmbeddingFromQuantizedTensor(
+    const Tensor& tensor, Embedding* embedding) {
+  const int64_t sum_of_squares = CenterQuantizedTensor(tensor);
+  // Output values are round(128 * normalized value). The scale cancels out in
+  // the L2-normalization, so the multiplier only depends on the centered
+  // values.
+  double multiplier = 128.0 * tensor.quantization_parameters().scale;
+  if (l2_normalize_ && sum_of_squares > 0) {
+    multiplier = 128.0 / std::sqrt(static_cast<double>(sum_of_squares));
+  }
+  const int64_t fixed_point_multiplier = std::llround(
+      std::min(multiplier, kMaxMultiplier) * (int64_t{1} << kMultiplierShift));
+  std::string* values =
+      embedding->mutable_quantized_embedding()->mutable_values();
+  values->resize(centered_values_.size());
+  for (int i = 0; i < centered_values_.size(); ++i) {
+    (*values)[i] = Requantize(centered_values_[i], fixed_point_multiplier);
+  }
+}
+
 MEDIAPIPE_REGISTER_NODE(TensorsToEmbeddingsCalculator);
 
 }  // namespace api2
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -51,6 +53,31 @@ void BuildGraph(CalculatorRunner* runner,
   input_packets.push_back(Adopt(inputs.release()).At(Timestamp(0)));
 }
 
+// Builds the graph and feeds quantized inputs: a kUInt8 tensor with
+// `uint8_values` and a kInt8 tensor with `int8_values`.
+void BuildQuantizedGraph(CalculatorRunner* runner, float scale,
+                         std::vector<uint8_t> uint8_values, int uint8_zero_point,
+                         std::vector<int8_t> int8_values, int int8_zero_point) {
+  auto inputs = std::make_unique<std::vector<Tensor>>();
+  inputs->emplace_back(Tensor::ElementType::kUInt8,
+                       Tensor::Shape{1, static_cast<int>(uint8_values.size())},
+                       Tensor::QuantizationParameters(scale, uint8_zero_point));
+  {
+    auto view = inputs->back().GetCpuWriteView();
+    std::copy(uint8_values.begin(), uint8_values.end(),
+              view.buffer<uint8_t>());
+  }
+  inputs->emplace_back(Tensor::ElementType::kInt8,
+                       Tensor::Shape{1, static_cast<int>(int8_values.size())},
+                       Tensor::QuantizationParameters(scale, int8_zero_point));
+  {
+    auto view = inputs->back().GetCpuWriteView();
+    std::copy(int8_values.begin(), int8_values.end(), view.buffer<int8_t>());
+  }
+  auto& input_packets = runner->MutableInputs()->Tag("TENSORS").packets;
+  input_packets.push_back(Adopt(inputs.release()).At(Timestamp(0)));
+}
+
 TEST(TensorsToEmbeddingsCalculatorTest, FailsWithInvalidHeadNamesNumber) {
   CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
     calculator: "TensorsToEmbeddingsCalculator"
@@ -272,5 +299,101 @@ TEST(TensorsToEmbeddingsCalculatorTest,
                        })pb")));
 }
 
+TEST(TensorsToEmbeddingsCalculatorTest, SucceedsWithQuantizedTensors) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsToEmbeddingsCalculator"
+    input_stream: "TENSORS:tensors"
+    output_stream: "EMBEDDINGS:embeddings"
+    options {
+      [mediapipe.TensorsToEmbeddingsCalculatorOptions.ext] {
+        embedder_options { l2_normalize: false quantize: false }
+      }
+    }
+  )pb"));
+
+  BuildQuantizedGraph(&runner, /*scale=*/0.5, {138, 148},
+                      /*uint8_zero_point=*/128, {-2, -3},
+                      /*int8_zero_point=*/0);
+  MP_ASSERT_OK(runner.Run());
+
+  const EmbeddingResult& result =
+      runner.Outputs().Get("EMBEDDINGS", 0).packets[0].Get<EmbeddingResult>();
+  EXPECT_THAT(result, EqualsProto(ParseTextProtoOrDie<EmbeddingResult>(
+                          R"pb(embeddings {
+                                 float_embedding { values: 5 values: 10 }
+                                 head_index: 0
+                               }
+                               embeddings {
+                                 float_embedding { values: -1 values: -1.5 }
+                                 head_index: 1
+                               })pb")));
+}
+
+TEST(TensorsToEmbeddingsCalculatorTest,
+     SucceedsWithQuantizedTensorsAndQuantization) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsToEmbeddingsCalculator"
+    input_stream: "TENSORS:tensors"
+    output_stream: "EMBEDDINGS:embeddings"
+    options {
+      [mediapipe.TensorsToEmbeddingsCalculatorOptions.ext] {
+        embedder_options { l2_normalize: false quantize: true }
+      }
+    }
+  )pb"));
+
+  // Same values as in SucceedsWithQuantization.
+  BuildQuantizedGraph(&runner, /*scale=*/0.01, {138, 148},
+                      /*uint8_zero_point=*/128, {-20, -30},
+                      /*int8_zero_point=*/0);
+  MP_ASSERT_OK(runner.Run());
+
+  const EmbeddingResult& result =
+      runner.Outputs().Get("EMBEDDINGS", 0).packets[0].Get<EmbeddingResult>();
+  EXPECT_THAT(result,
+              EqualsProto(ParseTextProtoOrDie<EmbeddingResult>(
+                  R"pb(embeddings {
+                         quantized_embedding { values: "\x0d\x1a" }  # 13,26
+                         head_index: 0
+                       }
+                       embeddings {
+                         quantized_embedding { values: "\xe6\xda" }  # -26,-38
+                         head_index: 1
+                       })pb")));
+}
+
+TEST(TensorsToEmbeddingsCalculatorTest,
+     SucceedsWithQuantizedTensorsAndNormalizationAndQuantization) {
+  CalculatorRunner runner(ParseTextProtoOrDie<Node>(R"pb(
+    calculator: "TensorsToEmbeddingsCalculator"
+    input_stream: "TENSORS:tensors"
+    output_stream: "EMBEDDINGS:embeddings"
+    options {
+      [mediapipe.TensorsToEmbeddingsCalculatorOptions.ext] {
+        embedder_options { l2_normalize: true quantize: true }
+      }
+    }
+  )pb"));
+
+  // Same values as in SucceedsWithNormalizationAndQuantization.
+  BuildQuantizedGraph(&runner, /*scale=*/0.01, {138, 148},
+                      /*uint8_zero_point=*/128, {-20, -30},
+                      /*int8_zero_point=*/0);
+  MP_ASSERT_OK(runner.Run());
+
+  const EmbeddingResult& result =
+      runner.Outputs().Get("EMBEDDINGS", 0).packets[0].Get<EmbeddingResult>();
+  EXPECT_THAT(result,
+              EqualsProto(ParseTextProtoOrDie<EmbeddingResult>(
+                  R"pb(embeddings {
+                         quantized_embedding { values: "\x39\x72" }  # 57,114
+                         head_index: 0
+                       }
+                       embeddings {
+                         quantized_embedding { values: "\xb9\x95" }  # -71,-107
+                         head_index: 1
+                       })pb")));
+}
+
 }  // namespace
 }  // namespace mediapipe
@@ -864,6 +864,17 @@ absl::Status ConfigureDetectionPostprocessingGraph(
   return absl::OkStatus();
 }
 
+void ConfigureTiledDetectionsMerging(
+    const proto::DetectorOptions& detector_options,
+    mediapipe::NonMaxSuppressionCalculatorOptions& options) {
+  options.set_min_suppression_threshold(
+      detector_options.min_suppression_threshold());
+  options.set_overlap_type(
+      mediapipe::NonMaxSuppressionCalculatorOptions::MODIFIED_JACCARD);
+  options.set_algorithm(mediapipe::NonMaxSuppressionCalculatorOptions::DEFAULT);
+  options.set_max_num_detections(detector_options.max_results());
+}
+
 // A DetectionPostprocessingGraph converts raw tensors into
 // std::vector<Detection>.
 //
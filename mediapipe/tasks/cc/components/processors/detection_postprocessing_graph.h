@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include "mediapipe/calculators/util/non_max_suppression_calculator.pb.h"
 #include "mediapipe/tasks/cc/components/processors/proto/detection_postprocessing_graph_options.pb.h"
 #include "mediapipe/tasks/cc/components/processors/proto/detector_options.pb.h"
 #include "mediapipe/tasks/cc/core/model_resources.h"
@@ -54,6 +55,20 @@ absl::Status ConfigureDetectionPostprocessingGraph(
     const proto::DetectorOptions& detector_options,
     proto::DetectionPostprocessingGraphOptions& options);
 
+// Configures a NonMaxSuppressionCalculator that merges the detections found
+// by DetectionPostprocessingGraphs run on overlapping tiles of an image, once
+// projected back to the image coordinates.
+//
+// An object cut by a tile border is detected on that tile as a truncated box
+// that lies mostly inside the box found on the neighbouring tile or on the
+// whole image, while their IoU can be low. The overlap is therefore measured
+// relative to the area of the box being suppressed (MODIFIED_JACCARD), and
+// compared to the min_suppression_threshold of `detector_options`. The number
+// of merged detections is limited to its max_results.
+void ConfigureTiledDetectionsMerging(
+    const proto::DetectorOptions& detector_options,
+    mediapipe::NonMaxSuppressionCalculatorOptions& options);
+
 }  // namespace processors
 }  // namespace components
 }  // namespace tasks
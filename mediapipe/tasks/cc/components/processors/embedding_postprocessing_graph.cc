@@ -225,23 +225,14 @@ class EmbeddingPostprocessingGraph : public mediapipe::Subgraph {
       const proto::EmbeddingPostprocessingGraphOptions options,
       Source<std::vector<Tensor>> tensors_in,
       Source<std::vector<Timestamp>> timestamps_in, Graph& graph) {
-    // If output tensors are quantized, they must be dequantized first.
-    Source<std::vector<Tensor>> dequantized_tensors = tensors_in;
-    if (options.has_quantized_outputs()) {
-      GenericNode& tensors_dequantization_node =
-          graph.AddNode("TensorsDequantizationCalculator");
-      tensors_in >> tensors_dequantization_node.In(kTensorsTag);
-      dequantized_tensors = tensors_dequantization_node.Out(kTensorsTag)
-                                .Cast<std::vector<Tensor>>();
-    }
-
-    // Adds TensorsToEmbeddingsCalculator.
+    // Adds TensorsToEmbeddingsCalculator. Quantized output tensors are read
+    // as-is, without being dequantized first.
     GenericNode& tensors_to_embeddings_node =
         graph.AddNode("TensorsToEmbeddingsCalculator");
     tensors_to_embeddings_node
         .GetOptions<mediapipe::TensorsToEmbeddingsCalculatorOptions>()
         .CopyFrom(options.tensors_to_embeddings_options());
-    dequantized_tensors >> tensors_to_embeddings_node.In(kTensorsTag);
+    tensors_in >> tensors_to_embeddings_node.In(kTensorsTag);
 
     // Adds EmbeddingAggregationCalculator.
     GenericNode& aggregation_node =
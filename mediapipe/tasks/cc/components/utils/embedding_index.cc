@@ -0,0 +1,195 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/components/utils/embedding_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+namespace {
+
+using ::mediapipe::tasks::components::containers::Embedding;
+
+// Number of independent accumulators in the float dot product. Splitting the
+// sum lets the compiler keep them in one SIMD register instead of serializing
+// on a single scalar accumulator.
+constexpr int kNumFloatLanes = 8;
+
+float DotProduct(const float* u, const float* v, int n) {
+  float lanes[kNumFloatLanes] = {};
+  int i = 0;
+  for (; i + kNumFloatLanes <= n; i += kNumFloatLanes) {
+    for (int j = 0; j < kNumFloatLanes; ++j) {
+      lanes[j] += u[i + j] * v[i + j];
+    }
+  }
+  float result = 0.0f;
+  for (; i < n; ++i) {
+    result += u[i] * v[i];
+  }
+  for (int j = 0; j < kNumFloatLanes; ++j) {
+    result += lanes[j];
+  }
+  return result;
+}
+
+// Exact for embeddings of up to 2^31 / 128^2 = 131072 elements.
+int32_t DotProduct(const int8_t* u, const int8_t* v, int n) {
+  int32_t result = 0;
+  for (int i = 0; i < n; ++i) {
+    result += static_cast<int32_t>(u[i]) * static_cast<int32_t>(v[i]);
+  }
+  return result;
+}
+
+const int8_t* QuantizedData(const Embedding& embedding) {
+  return reinterpret_cast<const int8_t*>(embedding.quantized_embedding.data());
+}
+
+absl::Status InvalidArgument(const std::string& message) {
+  return CreateStatusWithPayload(absl::StatusCode::kInvalidArgument, message,
+                                 MediaPipeTasksStatus::kInvalidArgumentError);
+}
+
+}  // namespace
+
+absl::Status EmbeddingIndex::ValidateEmbedding(const Embedding& embedding,
+                                               float& inverse_norm) const {
+  const bool quantized = embedding.float_embedding.empty();
+  const int dimension = quantized ? embedding.quantized_embedding.size()
+                                  : embedding.float_embedding.size();
+  if (dimension == 0) {
+    return InvalidArgument("Cannot index or search empty embeddings");
+  }
+  if (size() > 0 && quantized != quantized_) {
+    return InvalidArgument(
+        "Cannot compare quantized and float embeddings in the same index");
+  }
+  if (size() > 0 && dimension != dimension_) {
+    return InvalidArgument(absl::StrFormat(
+        "Cannot compare embeddings of different sizes (%d vs. %d)", dimension,
+        dimension_));
+  }
+  double squared_norm = 0.0;
+  if (quantized) {
+    squared_norm = DotProduct(QuantizedData(embedding), QuantizedData(embedding),
+                              dimension);
+  } else {
+    for (float value : embedding.float_embedding) {
+      squared_norm += static_cast<double>(value) * value;
+    }
+  }
+  if (squared_norm <= 0.0) {
+    return InvalidArgument("Cannot compare embeddings with 0 norm");
+  }
+  inverse_norm = static_cast<float>(1.0 / std::sqrt(squared_norm));
+  return absl::OkStatus();
+}
+
+absl::Status EmbeddingIndex::Add(const Embedding& embedding) {
+  float inverse_norm;
+  MP_RETURN_IF_ERROR(ValidateEmbedding(embedding, inverse_norm));
+  if (size() == 0) {
+    quantized_ = embedding.float_embedding.empty();
+    dimension_ = quantized_ ? embedding.quantized_embedding.size()
+                            : embedding.float_embedding.size();
+  }
+  if (quantized_) {
+    const int8_t* data = QuantizedData(embedding);
+    quantized_embeddings_.insert(quantized_embeddings_.end(), data,
+                                 data + dimension_);
+  } else {
+    float_embeddings_.insert(float_embeddings_.end(),
+                             embedding.float_embedding.begin(),
+                             embedding.float_embedding.end());
+  }
+  inverse_norms_.push_back(inverse_norm);
+  return absl::OkStatus();
+}
+
+absl::StatusOr<std::vector<float>> EmbeddingIndex::ComputeSimilarities(
+    const Embedding& query) const {
+  float query_inverse_norm;
+  MP_RETURN_IF_ERROR(ValidateEmbedding(query, query_inverse_norm));
+  const int num_embeddings = size();
+  std::vector<float> similarities(num_embeddings);
+  if (quantized_) {
+    const int8_t* query_data = QuantizedData(query);
+    const int8_t* row = quantized_embeddings_.data();
+    for (int i = 0; i < num_embeddings; ++i, row += dimension_) {
+      similarities[i] = DotProduct(query_data, row, dimension_) *
+                        query_inverse_norm * inverse_norms_[i];
+    }
+  } else {
+    const float* query_data = query.float_embedding.data();
+    const float* row = float_embeddings_.data();
+    for (int i = 0; i < num_embeddings; ++i, row += dimension_) {
+      similarities[i] = DotProduct(query_data, row, dimension_) *
+                        query_inverse_norm * inverse_norms_[i];
+    }
+  }
+  return similarities;
+}
+
+absl::StatusOr<std::vector<EmbeddingIndexResult>> EmbeddingIndex::Search(
+    const Embedding& query, int k) const {
+  if (k <= 0) {
+    return InvalidArgument(absl::StrFormat("k must be positive, got %d", k));
+  }
+  MP_ASSIGN_OR_RETURN(std::vector<float> similarities,
+                      ComputeSimilarities(query));
+  std::vector<EmbeddingIndexResult> results(similarities.size());
+  for (int i = 0; i < results.size(); ++i) {
+    results[i] = {i, similarities[i]};
+  }
+  const auto more_similar = [](const EmbeddingIndexResult& a,
+                               const EmbeddingIndexResult& b) {
+    return a.similarity > b.similarity ||
+           (a.similarity == b.similarity && a.index < b.index);
+  };
+  const int num_results = std::min<int>(k, results.size());
+  std::partial_sort(results.begin(), results.begin() + num_results,
+                    results.end(), more_similar);
+  results.resize(num_results);
+  return results;
+}
+
+void EmbeddingIndex::Clear() {
+  quantized_ = false;
+  dimension_ = 0;
+  float_embeddings_.clear();
+  quantized_embeddings_.clear();
+  inverse_norms_.clear();
+}
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,99 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
+#define MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+
+// A nearest neighbor returned by EmbeddingIndex::Search().
+struct EmbeddingIndexResult {
+  // The position of the embedding in the index, i.e. the number of embeddings
+  // added before it.
+  int index;
+  // The cosine similarity between the query and the embedding.
+  float similarity;
+};
+
+// An in-memory flat index for cosine similarity search over embeddings, as
+// returned e.g. by TextEmbedder or ImageEmbedder.
+//
+// Embeddings are stored contiguously along with their inverse L2-norms, so a
+// query is compared against all of them in a single pass over memory with
+// kernels the compiler can vectorize. All embeddings in an index must be of the
+// same type (float or quantized) and size, which the first embedding added
+// determines. Quantized embeddings are compared with integer arithmetic.
+//
+// Example usage:
+//   EmbeddingIndex index;
+//   for (const auto& result : stored_results) {
+//     MP_RETURN_IF_ERROR(index.Add(result.embeddings[0]));
+//   }
+//   MP_ASSIGN_OR_RETURN(std::vector<EmbeddingIndexResult> neighbors,
+//                       index.Search(query_result.embeddings[0], /*k=*/10));
+class EmbeddingIndex {
+ public:
+  // Adds `embedding` to the index. Returns an InvalidArgumentError if it is
+  // empty, has an L2-norm of 0, or differs in type or size from the embeddings
+  // already in the index.
+  absl::Status Add(const containers::Embedding& embedding);
+
+  // Computes the cosine similarity between `query` and every embedding in the
+  // index, in insertion order.
+  absl::StatusOr<std::vector<float>> ComputeSimilarities(
+      const containers::Embedding& query) const;
+
+  // Returns the (at most) `k` embeddings most similar to `query`, from most to
+  // least similar. Ties are broken by insertion order.
+  absl::StatusOr<std::vector<EmbeddingIndexResult>> Search(
+      const containers::Embedding& query, int k) const;
+
+  // Returns the number of embeddings in the index.
+  int size() const { return static_cast<int>(inverse_norms_.size()); }
+
+  // Removes all embeddings, after which embeddings of any type and size may be
+  // added.
+  void Clear();
+
+ private:
+  // Checks that `embedding` matches the type and size of the index, and sets
+  // `inverse_norm` to the inverse of its L2-norm.
+  absl::Status ValidateEmbedding(const containers::Embedding& embedding,
+                                 float& inverse_norm) const;
+
+  bool quantized_ = false;
+  int dimension_ = 0;
+  // Row-major embeddings; only the one matching `quantized_` is used.
+  std::vector<float> float_embeddings_;
+  std::vector<int8_t> quantized_embeddings_;
+  std::vector<float> inverse_norms_;
+};
+
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_COMPONENTS_UTILS_EMBEDDING_INDEX_H_
@@ -0,0 +1,183 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/components/utils/embedding_index.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/components/containers/embedding_result.h"
+#include "mediapipe/tasks/cc/components/utils/cosine_similarity.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace components {
+namespace utils {
+namespace {
+
+using ::mediapipe::tasks::components::containers::Embedding;
+using ::testing::HasSubstr;
+
+constexpr float kSimilarityTolerance = 1e-5;
+
+Embedding BuildFloatEmbedding(std::vector<float> values) {
+  Embedding embedding;
+  embedding.float_embedding = values;
+  return embedding;
+}
+
+Embedding BuildQuantizedEmbedding(std::vector<int8_t> values) {
+  Embedding embedding;
+  uint8_t* data = reinterpret_cast<uint8_t*>(values.data());
+  embedding.quantized_embedding = {data, data + values.size()};
+  return embedding;
+}
+
+TEST(EmbeddingIndexTest, SimilaritiesMatchCosineSimilarity) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  // 37 is not a multiple of the number of accumulator lanes.
+  constexpr int kDimension = 37;
+  std::vector<Embedding> embeddings;
+  EmbeddingIndex index;
+  for (int i = 0; i < 100; ++i) {
+    std::vector<float> values(kDimension);
+    for (float& value : values) value = distribution(generator);
+    embeddings.push_back(BuildFloatEmbedding(values));
+    MP_ASSERT_OK(index.Add(embeddings.back()));
+  }
+  const Embedding& query = embeddings[17];
+
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<float> similarities,
+                          index.ComputeSimilarities(query));
+
+  ASSERT_EQ(similarities.size(), embeddings.size());
+  for (int i = 0; i < embeddings.size(); ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(double expected,
+                            CosineSimilarity(query, embeddings[i]));
+    EXPECT_NEAR(similarities[i], expected, kSimilarityTolerance);
+  }
+}
+
+TEST(EmbeddingIndexTest, QuantizedSimilaritiesMatchCosineSimilarity) {
+  std::vector<Embedding> embeddings = {
+      BuildQuantizedEmbedding({127, 0, 0, 0}),
+      BuildQuantizedEmbedding({-128, 3, -7, 1}),
+      BuildQuantizedEmbedding({64, 64, 64, 64}),
+  };
+  EmbeddingIndex index;
+  for (const Embedding& embedding : embeddings) {
+    MP_ASSERT_OK(index.Add(embedding));
+  }
+  const Embedding query = BuildQuantizedEmbedding({10, -20, 30, -40});
+
+  MP_ASSERT_OK_AND_ASSIGN(std::vector<float> similarities,
+                          index.ComputeSimilarities(query));
+
+  ASSERT_EQ(similarities.size(), embeddings.size());
+  for (int i = 0; i < embeddings.size(); ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(double expected,
+                            CosineSimilarity(query, embeddings[i]));
+    EXPECT_NEAR(similarities[i], expected, kSimilarityTolerance);
+  }
+}
+
+TEST(EmbeddingIndexTest, SearchReturnsMostSimilarFirst) {
+  EmbeddingIndex index;
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({0.0, 1.0})));
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({1.0, 0.0})));
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({1.0, 1.0})));
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({2.0, 0.0})));
+
+  MP_ASSERT_OK_AND_ASSIGN(auto results,
+                          index.Search(BuildFloatEmbedding({1.0, 0.1}), 3));
+
+  ASSERT_EQ(results.size(), 3);
+  // Embeddings 1 and 3 are equally similar; the first added comes first.
+  EXPECT_EQ(results[0].index, 1);
+  EXPECT_EQ(results[1].index, 3);
+  EXPECT_EQ(results[2].index, 2);
+  EXPECT_NEAR(results[0].similarity, results[1].similarity,
+              kSimilarityTolerance);
+  EXPECT_GT(results[1].similarity, results[2].similarity);
+}
+
+TEST(EmbeddingIndexTest, SearchReturnsAtMostIndexSize) {
+  EmbeddingIndex index;
+  MP_ASSERT_OK(index.Add(BuildQuantizedEmbedding({1, 2})));
+  MP_ASSERT_OK(index.Add(BuildQuantizedEmbedding({-1, -2})));
+
+  MP_ASSERT_OK_AND_ASSIGN(auto results,
+                          index.Search(BuildQuantizedEmbedding({1, 2}), 10));
+
+  ASSERT_EQ(results.size(), 2);
+  EXPECT_EQ(results[0].index, 0);
+  EXPECT_NEAR(results[0].similarity, 1.0, kSimilarityTolerance);
+  EXPECT_EQ(results[1].index, 1);
+  EXPECT_NEAR(results[1].similarity, -1.0, kSimilarityTolerance);
+}
+
+TEST(EmbeddingIndexTest, FailsWithQuantizedAndFloatEmbeddings) {
+  EmbeddingIndex index;
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({0.1, 0.2})));
+
+  auto status = index.Add(BuildQuantizedEmbedding({0, 1}));
+
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(),
+              HasSubstr("Cannot compare quantized and float embeddings"));
+}
+
+TEST(EmbeddingIndexTest, FailsWithDifferentSizes) {
+  EmbeddingIndex index;
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({0.1, 0.2})));
+
+  auto status = index.Search(BuildFloatEmbedding({0.1, 0.2, 0.3}), 1).status();
+
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(),
+              HasSubstr("Cannot compare embeddings of different sizes"));
+}
+
+TEST(EmbeddingIndexTest, FailsWithZeroNorm) {
+  EmbeddingIndex index;
+
+  auto status = index.Add(BuildFloatEmbedding({0.0, 0.0}));
+
+  EXPECT_EQ(status.code(), absl::StatusCode::kInvalidArgument);
+  EXPECT_THAT(status.message(), HasSubstr("0 norm"));
+}
+
+TEST(EmbeddingIndexTest, ClearAllowsNewEmbeddingType) {
+  EmbeddingIndex index;
+  MP_ASSERT_OK(index.Add(BuildFloatEmbedding({0.1, 0.2})));
+
+  index.Clear();
+
+  EXPECT_EQ(index.size(), 0);
+  MP_EXPECT_OK(index.Add(BuildQuantizedEmbedding({0, 1, 2})));
+  EXPECT_EQ(index.size(), 1);
+}
+
+}  // namespace
+}  // namespace utils
+}  // namespace components
+}  // namespace tasks
+}  // namespace mediapipe
@@ -20,7 +20,10 @@ limitations under the License.
 #include <variant>
 
 #include "absl/log/absl_log.h"
+#include "absl/status/status.h"
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/tasks/cc/core/gpu_cache_utils.h"
 #include "mediapipe/tasks/cc/core/proto/acceleration.pb.h"
 #include "mediapipe/tasks/cc/core/proto/base_options.pb.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
@@ -73,6 +76,56 @@ void SetDelegateOptionsOrDie(const BaseOptions* base_options,
   }
 }
 
+// Points the GPU caches of `base_options_proto` at `options.cache_dir` unless
+// they are configured explicitly, naming them after the model content.
+void ApplyGpuCacheDir(const BaseOptions::GpuOptions& options,
+                      proto::BaseOptions& base_options_proto) {
+  auto* gpu = base_options_proto.mutable_acceleration()->mutable_gpu();
+  if (!gpu->has_model_token()) {
+    const auto& model_asset = base_options_proto.model_asset();
+    if (model_asset.has_file_content()) {
+      gpu->set_model_token(ModelTokenFromContent(model_asset.file_content()));
+    } else if (model_asset.has_file_name()) {
+      std::string model_content;
+      absl::Status status =
+          file::GetContents(model_asset.file_name(), &model_content);
+      if (!status.ok()) {
+        ABSL_LOG(WARNING) << "GPU caching disabled, cannot read model: "
+                          << status;
+        return;
+      }
+      gpu->set_model_token(ModelTokenFromContent(model_content));
+    } else {
+      ABSL_LOG(WARNING) << "GPU caching disabled, it requires either "
+                           "model_token or a model path or buffer.";
+      return;
+    }
+  }
+  absl::Status status = file::RecursivelyCreateDir(options.cache_dir);
+  if (!status.ok()) {
+    ABSL_LOG(WARNING) << "GPU caching disabled, cannot create "
+                      << options.cache_dir << ": " << status;
+    return;
+  }
+  if (options.max_cache_size_bytes > 0) {
+    status = EvictGpuCacheFiles(options.cache_dir, options.max_cache_size_bytes,
+                                /*keep_prefix=*/gpu->model_token());
+    if (!status.ok()) {
+      ABSL_LOG(WARNING) << "Failed to evict GPU caches: " << status;
+    }
+  }
+  if (!gpu->has_serialized_model_dir()) {
+    gpu->set_serialized_model_dir(options.cache_dir);
+  }
+  if (!gpu->has_cached_kernel_path()) {
+    gpu->set_cached_kernel_path(options.cache_dir);
+  }
+  if (!gpu->has_cache_writing_behavior()) {
+    gpu->set_cache_writing_behavior(
+        InferenceCalculatorOptions::Delegate::Gpu::TRY_WRITE);
+  }
+}
+
 proto::BaseOptions ConvertBaseOptionsToProto(BaseOptions* base_options) {
   proto::BaseOptions base_options_proto;
   if (!base_options->model_asset_path.empty()) {
@@ -109,6 +162,13 @@ proto::BaseOptions ConvertBaseOptionsToProto(BaseOptions* base_options) {
           ->set_use_advanced_gpu_api(true);
       SetDelegateOptionsOrDie<BaseOptions::GpuOptions>(base_options,
                                                        base_options_proto);
+      if (base_options->delegate_options.has_value()) {
+        const auto* gpu_options = std::get_if<BaseOptions::GpuOptions>(
+            &*base_options->delegate_options);
+        if (gpu_options != nullptr && !gpu_options->cache_dir.empty()) {
+          ApplyGpuCacheDir(*gpu_options, base_options_proto);
+        }
+      }
       break;
     case BaseOptions::Delegate::EDGETPU_NNAPI:
       base_options_proto.mutable_acceleration()
@@ -116,6 +176,22 @@ proto::BaseOptions ConvertBaseOptionsToProto(BaseOptions* base_options) {
           ->set_accelerator_name("google-edgetpu");
       break;
   }
+  const auto& threading_options = base_options->threading_options;
+  if (!threading_options.shared_executor_name.empty()) {
+    base_options_proto.set_shared_executor_name(
+        threading_options.shared_executor_name);
+    if (threading_options.shared_executor_num_threads > 0) {
+      base_options_proto.set_shared_executor_num_threads(
+          threading_options.shared_executor_num_threads);
+    }
+  }
+  if (threading_options.process_thread_budget > 0) {
+    base_options_proto.set_process_thread_budget(
+        threading_options.process_thread_budget);
+  }
+  if (base_options->enable_profiler) {
+    base_options_proto.set_enable_profiler(true);
+  }
   return base_options_proto;
 }
 }  // namespace core
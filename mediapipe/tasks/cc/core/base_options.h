@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_CORE_BASE_OPTIONS_H_
 #define MEDIAPIPE_TASKS_CC_CORE_BASE_OPTIONS_H_
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -74,6 +75,18 @@ struct BaseOptions {
     // "serialized_model_dir". It is the caller's responsibility to ensure
     // there is no clash of the tokens.
     std::string model_token;
+
+    // A directory in which MediaPipe manages the GPU caches of the model. If
+    // set, "serialized_model_dir" and "cached_kernel_path" default to this
+    // directory, "model_token" defaults to a token derived from the model
+    // content, and failures to write the caches are ignored. Subsequent task
+    // creations with the same model then skip the GPU program compilation.
+    std::string cache_dir;
+
+    // If positive, the least recently written files in "cache_dir" are deleted
+    // on task creation until the directory holds at most this many bytes. The
+    // caches of the model being loaded are kept.
+    int64_t max_cache_size_bytes = 0;
   };
 
   // The file descriptor to a file opened with open(2), with optional additional
@@ -100,6 +113,28 @@ struct BaseOptions {
   // is used.
   std::optional<std::variant<CpuOptions, GpuOptions>> delegate_options;
 
+  // Options for sharing threads among the tasks of a process.
+  struct ThreadingOptions {
+    // The name of a process-wide thread pool shared by the graphs of all tasks
+    // created with the same name. If empty, the graph of the task creates its
+    // own default thread pool.
+    std::string shared_executor_name;
+
+    // The number of threads of the shared thread pool, if it is created for
+    // this task. Defaults to the number of CPU cores if not positive.
+    int shared_executor_num_threads = 0;
+
+    // If positive, sets the maximum number of threads of all shared thread
+    // pools and XNNPACK delegates in the process when the task is created.
+    // Each pool or delegate still gets at least one thread.
+    int process_thread_budget = 0;
+  } threading_options;
+
+  // If true, the graph of the task collects the runtime profile of each
+  // calculator, which is returned by the GetCalculatorProfiles() method of the
+  // task. Profiling adds a small overhead to every calculator invocation.
+  bool enable_profiler = false;
+
   // Disallows/disables default initialization of MediaPipe graph services. This
   // can be used to disable default OpenCL context creation so that the whole
   // pipeline can run on CPU.
@@ -6,8 +6,12 @@
 #include <variant>
 
 #include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/file_helpers.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/core/gpu_cache_utils.h"
 #include "mediapipe/tasks/cc/core/proto/acceleration.pb.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
 #include "mediapipe/tasks/cc/core/utils.h"
@@ -45,6 +49,31 @@ TEST(BaseOptionsTest, ConvertBaseOptionsToProtoWithAcceleration) {
   EXPECT_EQ(proto.acceleration().nnapi().accelerator_name(), "google-edgetpu");
 }
 
+TEST(BaseOptionsTest, ConvertBaseOptionsToProtoWithThreadingOptions) {
+  BaseOptions base_options;
+  proto::BaseOptions proto = ConvertBaseOptionsToProto(&base_options);
+  EXPECT_FALSE(proto.has_shared_executor_name());
+  EXPECT_FALSE(proto.has_process_thread_budget());
+
+  base_options.threading_options.shared_executor_name = "tasks";
+  base_options.threading_options.shared_executor_num_threads = 4;
+  base_options.threading_options.process_thread_budget = 8;
+  proto = ConvertBaseOptionsToProto(&base_options);
+  EXPECT_EQ(proto.shared_executor_name(), "tasks");
+  EXPECT_EQ(proto.shared_executor_num_threads(), 4);
+  EXPECT_EQ(proto.process_thread_budget(), 8);
+}
+
+TEST(BaseOptionsTest, ConvertBaseOptionsToProtoWithProfiler) {
+  BaseOptions base_options;
+  proto::BaseOptions proto = ConvertBaseOptionsToProto(&base_options);
+  EXPECT_FALSE(proto.enable_profiler());
+
+  base_options.enable_profiler = true;
+  proto = ConvertBaseOptionsToProto(&base_options);
+  EXPECT_TRUE(proto.enable_profiler());
+}
+
 TEST(DelegateOptionsTest, SucceedCpuOptions) {
   BaseOptions base_options;
   base_options.delegate = BaseOptions::Delegate::CPU;
@@ -71,6 +100,45 @@ TEST(DelegateOptionsTest, SucceedGpuOptions) {
   EXPECT_EQ(proto.acceleration().gpu().model_token(), kModelToken);
 }
 
+TEST(DelegateOptionsTest, GpuCacheDirDerivesCacheOptions) {
+  const std::string cache_dir =
+      file::JoinPath(::testing::TempDir(), "gpu_cache_dir");
+  BaseOptions base_options;
+  base_options.model_asset_buffer =
+      std::make_unique<std::string>(LoadBinaryContent(kTestModelBundlePath));
+  const std::string expected_token =
+      ModelTokenFromContent(*base_options.model_asset_buffer);
+  base_options.delegate = BaseOptions::Delegate::GPU;
+  BaseOptions::GpuOptions gpu_options;
+  gpu_options.cache_dir = cache_dir;
+  base_options.delegate_options = gpu_options;
+  proto::BaseOptions proto = ConvertBaseOptionsToProto(&base_options);
+  ASSERT_TRUE(proto.acceleration().has_gpu());
+  const auto& gpu = proto.acceleration().gpu();
+  EXPECT_EQ(gpu.model_token(), expected_token);
+  EXPECT_EQ(gpu.serialized_model_dir(), cache_dir);
+  EXPECT_EQ(gpu.cached_kernel_path(), cache_dir);
+  EXPECT_EQ(gpu.cache_writing_behavior(),
+            InferenceCalculatorOptions::Delegate::Gpu::TRY_WRITE);
+  MP_EXPECT_OK(file::IsDirectory(cache_dir));
+}
+
+TEST(DelegateOptionsTest, GpuCacheDirKeepsExplicitOptions) {
+  BaseOptions base_options;
+  base_options.model_asset_path = kTestModelBundlePath;
+  base_options.delegate = BaseOptions::Delegate::GPU;
+  BaseOptions::GpuOptions gpu_options;
+  gpu_options.cache_dir = file::JoinPath(::testing::TempDir(), "gpu_cache");
+  gpu_options.serialized_model_dir = kCachedModelDir;
+  gpu_options.model_token = kModelToken;
+  base_options.delegate_options = gpu_options;
+  proto::BaseOptions proto = ConvertBaseOptionsToProto(&base_options);
+  const auto& gpu = proto.acceleration().gpu();
+  EXPECT_EQ(gpu.model_token(), kModelToken);
+  EXPECT_EQ(gpu.serialized_model_dir(), kCachedModelDir);
+  EXPECT_EQ(gpu.cached_kernel_path(), gpu_options.cache_dir);
+}
+
 TEST(DelegateOptionsDeathTest, FailWrongDelegateOptionsType) {
   BaseOptions base_options;
   base_options.delegate = BaseOptions::Delegate::CPU;
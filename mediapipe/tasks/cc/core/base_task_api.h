@@ -20,6 +20,8 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/status/statusor.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
 #include "mediapipe/tasks/cc/core/task_runner.h"
 
 namespace mediapipe {
@@ -36,6 +38,12 @@ class BaseTaskApi {
   BaseTaskApi(const BaseTaskApi&) = delete;
   BaseTaskApi& operator=(const BaseTaskApi&) = delete;
 
+  // Returns the runtime profile of each calculator of the task graph, if the
+  // task was created with BaseOptions::enable_profiler.
+  absl::StatusOr<std::vector<CalculatorProfile>> GetCalculatorProfiles() {
+    return runner_->GetCalculatorProfiles();
+  }
+
  protected:
   // The task runner of the task api.
   std::unique_ptr<TaskRunner> runner_;
@@ -33,6 +33,8 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
@@ -40,6 +42,7 @@ limitations under the License.
 #include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
@@ -77,23 +80,28 @@ int64_t GetPageSizeAlignedOffset(int64_t offset) {
 #endif  // _WIN32
 }
 
+absl::Status CancelledError() {
+  return CreateStatusWithPayload(StatusCode::kCancelled,
+                                 "Loading of the external file was cancelled.");
+}
+
 }  // namespace
 
 /* static */
 absl::StatusOr<std::unique_ptr<ExternalFileHandler>>
 ExternalFileHandler::CreateFromExternalFile(
-    const proto::ExternalFile* external_file) {
+    const proto::ExternalFile* external_file, bool prefetch) {
   // Use absl::WrapUnique() to call private constructor:
   // https://abseil.io/tips/126.
   std::unique_ptr<ExternalFileHandler> handler =
       absl::WrapUnique(new ExternalFileHandler(external_file));
 
-  MP_RETURN_IF_ERROR(handler->MapExternalFile());
+  MP_RETURN_IF_ERROR(handler->MapExternalFile(prefetch));
 
   return handler;
 }
 
-absl::Status ExternalFileHandler::MapExternalFile() {
+absl::Status ExternalFileHandler::MapExternalFile(bool prefetch) {
   if (!external_file_.file_content().empty()) {
     return absl::OkStatus();
   } else if (external_file_.has_file_pointer_meta()) {
@@ -154,6 +162,12 @@ absl::Status ExternalFileHandler::MapExternalFile() {
       }
     }
     fd = owned_fd_;
+    // A file name may be combined with an offset and length to address a
+    // region of the file, e.g. a model stored in a model asset bundle.
+    if (external_file_.has_file_descriptor_meta()) {
+      buffer_offset_ = external_file_.file_descriptor_meta().offset();
+      buffer_size_ = external_file_.file_descriptor_meta().length();
+    }
   } else {
 #ifdef _WIN32
     return CreateStatusWithPayload(
@@ -213,8 +227,9 @@ absl::Status ExternalFileHandler::MapExternalFile() {
   buffer_ = malloc(file_size);
   // Return the file pointer back to the beginning of the file
   lseek(fd, 0L, SEEK_SET);
-  buffer_size_ = read(fd, buffer_, file_size);
-  if (buffer_size_ <= 0) {
+  // Keep buffer_size_ as the size of the requested region, which may be
+  // smaller than the file.
+  if (read(fd, buffer_, file_size) < buffer_offset_ + buffer_size_) {
     free(buffer_);
     buffer_ = nullptr;
   }
@@ -225,6 +240,12 @@ absl::Status ExternalFileHandler::MapExternalFile() {
   if (buffer_ == MAP_FAILED) {
     buffer_ = nullptr;
   }
+#if defined(ABSL_HAVE_MMAP) && defined(MADV_WILLNEED)
+  if (buffer_ && prefetch) {
+    // Only a hint: the mapping is usable whether or not it succeeds.
+    madvise(buffer_, buffer_aligned_size_, MADV_WILLNEED);
+  }
+#endif
 #endif  // _WIN32
   if (!buffer_) {
     return CreateStatusWithPayload(
@@ -263,6 +284,64 @@ ExternalFileHandler::~ExternalFileHandler() {
   }
 }
 
+/* static */
+std::unique_ptr<AsyncExternalFileHandler> AsyncExternalFileHandler::Start(
+    const proto::ExternalFile* external_file, bool prefetch) {
+  return Start([external_file, prefetch]() {
+    return ExternalFileHandler::CreateFromExternalFile(external_file, prefetch);
+  });
+}
+
+/* static */
+std::unique_ptr<AsyncExternalFileHandler> AsyncExternalFileHandler::Start(
+    LoadFunction load) {
+  auto handler =
+      absl::WrapUnique(new AsyncExternalFileHandler(std::move(load)));
+  handler->thread_ =
+      std::thread([handler = handler.get()]() { handler->Run(); });
+  return handler;
+}
+
+AsyncExternalFileHandler::~AsyncExternalFileHandler() {
+  Cancel();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void AsyncExternalFileHandler::Cancel() {
+  absl::MutexLock lock(&mutex_);
+  cancelled_ = true;
+}
+
+void AsyncExternalFileHandler::Run() {
+  {
+    absl::MutexLock lock(&mutex_);
+    if (cancelled_) {
+      result_ = CancelledError();
+      return;
+    }
+  }
+  result_ = load_();
+  absl::MutexLock lock(&mutex_);
+  if (cancelled_) {
+    // Unmaps the file right away rather than when this object is destroyed.
+    result_ = CancelledError();
+  }
+}
+
+absl::StatusOr<std::unique_ptr<ExternalFileHandler>>
+AsyncExternalFileHandler::Get() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  absl::MutexLock lock(&mutex_);
+  if (cancelled_) {
+    return CancelledError();
+  }
+  return std::move(result_);
+}
+
 }  // namespace core
 }  // namespace tasks
 }  // namespace mediapipe
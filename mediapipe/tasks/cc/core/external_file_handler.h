@@ -18,10 +18,15 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <thread>
+#include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
 
 namespace mediapipe {
@@ -41,10 +46,15 @@ class ExternalFileHandler {
   // caller. Returns an error if the creation failed, which may happen if the
   // provided ExternalFile can't be opened or mapped into memory.
   //
+  // If `prefetch` is true and the file is mapped into memory, the OS is asked
+  // to start reading the mapped pages in the background (madvise(WILLNEED)),
+  // so that they are likely resident by the time the content is accessed.
+  //
   // Warning: Does not take ownership of `external_file`, which must refer to a
   // valid proto that outlives this object.
   static absl::StatusOr<std::unique_ptr<ExternalFileHandler>>
-  CreateFromExternalFile(const proto::ExternalFile* external_file);
+  CreateFromExternalFile(const proto::ExternalFile* external_file,
+                         bool prefetch = false);
 
   ~ExternalFileHandler();
 
@@ -60,7 +70,7 @@ class ExternalFileHandler {
   // Opens (if provided by path) and maps (if provided by path or file
   // descriptor) the external file in memory. Does nothing otherwise, as file
   // contents are already loaded in memory.
-  absl::Status MapExternalFile();
+  absl::Status MapExternalFile(bool prefetch);
 
   // Reference to the input ExternalFile.
   const proto::ExternalFile& external_file_;
@@ -87,6 +97,58 @@ class ExternalFileHandler {
   int64_t buffer_aligned_size_{};
 };
 
+// Creates an ExternalFileHandler on a background thread, so that opening and
+// mapping or reading the file overlaps with other work of the caller, e.g.
+// building and initializing the graph of a task. Starting one per model file
+// loads the files in parallel.
+class AsyncExternalFileHandler {
+ public:
+  using LoadFunction = absl::AnyInvocable<
+      absl::StatusOr<std::unique_ptr<ExternalFileHandler>>()>;
+
+  // Starts creating an ExternalFileHandler from `external_file`, with
+  // prefetching as described in ExternalFileHandler::CreateFromExternalFile.
+  //
+  // Warning: Does not take ownership of `external_file`, which must refer to a
+  // valid proto that outlives this object and is not modified until Get()
+  // returns.
+  static std::unique_ptr<AsyncExternalFileHandler> Start(
+      const proto::ExternalFile* external_file, bool prefetch = true);
+
+  // Starts running `load` on a background thread. Use this when preparing the
+  // ExternalFile, e.g. resolving or reading a resource, is slow as well.
+  static std::unique_ptr<AsyncExternalFileHandler> Start(LoadFunction load);
+
+  // Cancels the loading and waits for the background thread to finish.
+  ~AsyncExternalFileHandler();
+
+  // Cancels the loading: if it has not started yet it is skipped, otherwise
+  // its result is released as soon as it is available. Get() then returns a
+  // kCancelled error.
+  void Cancel();
+
+  // Waits for the loading to finish and returns its result. Must be called at
+  // most once.
+  absl::StatusOr<std::unique_ptr<ExternalFileHandler>> Get();
+
+ private:
+  explicit AsyncExternalFileHandler(LoadFunction load)
+      : load_(std::move(load)) {}
+
+  // Runs on thread_ and sets result_.
+  void Run();
+
+  LoadFunction load_;
+
+  absl::Mutex mutex_;
+  bool cancelled_ ABSL_GUARDED_BY(mutex_) = false;
+
+  // Only accessed by thread_ until it is joined.
+  absl::StatusOr<std::unique_ptr<ExternalFileHandler>> result_;
+
+  std::thread thread_;
+};
+
 }  // namespace core
 }  // namespace tasks
 }  // namespace mediapipe
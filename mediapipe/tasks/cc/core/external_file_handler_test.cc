@@ -0,0 +1,108 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/core/external_file_handler.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+std::string TestFilePath(const std::string& name) {
+  return file::JoinPath(::testing::TempDir(), name);
+}
+
+TEST(ExternalFileHandlerTest, MapsFileRegionWithPrefetch) {
+  const std::string contents(10000, 'a');
+  proto::ExternalFile external_file;
+  const std::string path = TestFilePath("prefetched");
+  MP_ASSERT_OK(file::SetContents(path, contents + "bc"));
+  external_file.set_file_name(path);
+  external_file.mutable_file_descriptor_meta()->set_offset(contents.size());
+  MP_ASSERT_OK_AND_ASSIGN(auto handler,
+                          ExternalFileHandler::CreateFromExternalFile(
+                              &external_file, /*prefetch=*/true));
+  EXPECT_EQ(handler->GetFileContent(), "bc");
+}
+
+TEST(AsyncExternalFileHandlerTest, LoadsFiles) {
+  proto::ExternalFile first;
+  const std::string path = TestFilePath("first");
+  MP_ASSERT_OK(file::SetContents(path, "first contents"));
+  first.set_file_name(path);
+  proto::ExternalFile second;
+  second.set_file_content("second contents");
+  auto first_loader = AsyncExternalFileHandler::Start(&first);
+  auto second_loader = AsyncExternalFileHandler::Start(&second);
+  MP_ASSERT_OK_AND_ASSIGN(auto second_handler, second_loader->Get());
+  MP_ASSERT_OK_AND_ASSIGN(auto first_handler, first_loader->Get());
+  EXPECT_EQ(first_handler->GetFileContent(), "first contents");
+  EXPECT_EQ(second_handler->GetFileContent(), "second contents");
+}
+
+TEST(AsyncExternalFileHandlerTest, ReturnsLoadError) {
+  proto::ExternalFile external_file;
+  external_file.set_file_name(TestFilePath("i_do_not_exist"));
+  auto loader = AsyncExternalFileHandler::Start(&external_file);
+  EXPECT_EQ(loader->Get().status().code(), absl::StatusCode::kNotFound);
+}
+
+TEST(AsyncExternalFileHandlerTest, CancelDiscardsRunningLoad) {
+  proto::ExternalFile external_file;
+  external_file.set_file_content("contents");
+  absl::Notification started;
+  absl::Notification cancelled;
+  auto loader = AsyncExternalFileHandler::Start([&]() {
+    started.Notify();
+    cancelled.WaitForNotification();
+    return ExternalFileHandler::CreateFromExternalFile(&external_file);
+  });
+  started.WaitForNotification();
+  loader->Cancel();
+  cancelled.Notify();
+  EXPECT_EQ(loader->Get().status().code(), absl::StatusCode::kCancelled);
+}
+
+TEST(AsyncExternalFileHandlerTest, DestructionWaitsForLoad) {
+  proto::ExternalFile external_file;
+  external_file.set_file_content("contents");
+  bool loaded = false;
+  absl::Notification started;
+  {
+    auto loader = AsyncExternalFileHandler::Start([&]() {
+      started.Notify();
+      loaded = true;
+      return ExternalFileHandler::CreateFromExternalFile(&external_file);
+    });
+    started.WaitForNotification();
+  }
+  EXPECT_TRUE(loaded);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,119 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/core/gpu_cache_utils.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/status_macros.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+struct CacheFile {
+  std::string path;
+  int64_t size;
+  int64_t modification_time;
+};
+
+bool StatFile(const std::string& path, CacheFile* file) {
+#ifdef _WIN32
+  struct _stat64 buffer;
+  if (_stat64(path.c_str(), &buffer) != 0) return false;
+  if ((buffer.st_mode & _S_IFREG) == 0) return false;
+#else
+  struct stat buffer;
+  if (stat(path.c_str(), &buffer) != 0) return false;
+  if (!S_ISREG(buffer.st_mode)) return false;
+#endif
+  file->path = path;
+  file->size = buffer.st_size;
+  file->modification_time = buffer.st_mtime;
+  return true;
+}
+
+}  // namespace
+
+std::string ModelTokenFromContent(absl::string_view model_content) {
+  // FNV-1a over little-endian 64-bit words, then over the remaining bytes.
+  // Hashing words rather than bytes keeps this cheap for large models.
+  uint64_t hash = kFnvOffsetBasis;
+  const auto* data = reinterpret_cast<const uint8_t*>(model_content.data());
+  const size_t size = model_content.size();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    uint64_t word = 0;
+    for (int b = 7; b >= 0; --b) word = (word << 8) | data[i + b];
+    hash = (hash ^ word) * kFnvPrime;
+    hash ^= hash >> 29;
+  }
+  for (; i < size; ++i) {
+    hash = (hash ^ data[i]) * kFnvPrime;
+  }
+  return absl::StrFormat("model_%016x_%d", hash, size);
+}
+
+absl::Status EvictGpuCacheFiles(absl::string_view cache_dir,
+                                int64_t max_size_bytes,
+                                absl::string_view keep_prefix) {
+  std::vector<std::string> paths;
+  MP_RETURN_IF_ERROR(file::MatchFileTypeInDirectory(std::string(cache_dir),
+                                                    /*file_suffix=*/"", &paths));
+  std::vector<CacheFile> evictable;
+  int64_t total_size = 0;
+  for (const std::string& path : paths) {
+    CacheFile file;
+    if (!StatFile(path, &file)) continue;
+    total_size += file.size;
+    if (keep_prefix.empty() ||
+        !absl::StartsWith(file::Basename(path), keep_prefix)) {
+      evictable.push_back(std::move(file));
+    }
+  }
+  std::sort(evictable.begin(), evictable.end(),
+            [](const CacheFile& a, const CacheFile& b) {
+              return a.modification_time < b.modification_time;
+            });
+  for (const CacheFile& file : evictable) {
+    if (total_size <= max_size_bytes) break;
+    if (std::remove(file.path.c_str()) != 0) {
+      return absl::InternalError(
+          absl::StrFormat("Failed to delete GPU cache file %s.", file.path));
+    }
+    total_size -= file.size;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
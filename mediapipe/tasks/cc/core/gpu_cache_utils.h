@@ -0,0 +1,45 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_TASKS_CC_CORE_GPU_CACHE_UTILS_H_
+#define MEDIAPIPE_TASKS_CC_CORE_GPU_CACHE_UTILS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+
+// Returns a model token, as used by the GPU delegate to name its serialized
+// model and kernel cache files, derived from the model content. Identical
+// contents yield identical tokens across processes and platforms.
+std::string ModelTokenFromContent(absl::string_view model_content);
+
+// Deletes the least recently modified files directly inside `cache_dir` until
+// their total size is at most `max_size_bytes`. Files whose name starts with
+// `keep_prefix`, if not empty, are never deleted but count towards the total.
+absl::Status EvictGpuCacheFiles(absl::string_view cache_dir,
+                                int64_t max_size_bytes,
+                                absl::string_view keep_prefix = "");
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_CORE_GPU_CACHE_UTILS_H_
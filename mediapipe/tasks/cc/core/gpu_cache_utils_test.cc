@@ -0,0 +1,67 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/core/gpu_cache_utils.h"
+
+#include <string>
+
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/port/file_helpers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+TEST(ModelTokenFromContentTest, DependsOnlyOnContent) {
+  const std::string model(1000, 'a');
+  EXPECT_EQ(ModelTokenFromContent(model), ModelTokenFromContent(model));
+  EXPECT_NE(ModelTokenFromContent(model),
+            ModelTokenFromContent(std::string(1001, 'a')));
+  std::string modified = model;
+  modified[517] = 'b';
+  EXPECT_NE(ModelTokenFromContent(model), ModelTokenFromContent(modified));
+  EXPECT_EQ(ModelTokenFromContent(""), "model_cbf29ce484222325_0");
+}
+
+TEST(EvictGpuCacheFilesTest, DeletesOldestFilesAboveLimit) {
+  const std::string dir =
+      file::JoinPath(::testing::TempDir(), "gpu_cache_eviction");
+  MP_ASSERT_OK(file::RecursivelyCreateDir(dir));
+  const std::string oldest = file::JoinPath(dir, "a.ker");
+  const std::string kept = file::JoinPath(dir, "current_model.ker");
+  const std::string newest = file::JoinPath(dir, "b.ker");
+  MP_ASSERT_OK(file::SetContents(oldest, std::string(100, 'x')));
+  MP_ASSERT_OK(file::SetContents(kept, std::string(100, 'x')));
+  MP_ASSERT_OK(file::SetContents(newest, std::string(100, 'x')));
+
+  // The limit is already met.
+  MP_ASSERT_OK(EvictGpuCacheFiles(dir, 300));
+  MP_EXPECT_OK(file::Exists(oldest));
+
+  // "current_model.ker" is protected, so both other files have to go.
+  MP_ASSERT_OK(EvictGpuCacheFiles(dir, 150, "current_model"));
+  EXPECT_FALSE(file::Exists(oldest).ok());
+  EXPECT_FALSE(file::Exists(newest).ok());
+  MP_EXPECT_OK(file::Exists(kept));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
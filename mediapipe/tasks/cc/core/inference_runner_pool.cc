@@ -0,0 +1,264 @@
+/* Copyright 2024 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_io_mapper.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+
+namespace {
+
+// An InferenceRunner that leases a runner from an InferenceRunnerPool for
+// each Run call.
+class PooledInferenceRunner : public InferenceRunner {
+ public:
+  PooledInferenceRunner(InferenceRunnerPool& pool, std::string key,
+                        InputOutputTensorNames input_output_tensor_names)
+      : pool_(pool),
+        key_(std::move(key)),
+        input_output_tensor_names_(std::move(input_output_tensor_names)) {}
+
+  ~PooledInferenceRunner() override { pool_.Unregister(key_); }
+
+  absl::StatusOr<std::vector<Tensor>> Run(
+      CalculatorContext* cc, const TensorSpan& tensor_span) override {
+    MP_ASSIGN_OR_RETURN(InferenceRunnerPool::Lease lease, pool_.Acquire(key_));
+    return lease.runner().Run(cc, tensor_span);
+  }
+
+  const InputOutputTensorNames& GetInputOutputTensorNames() const override {
+    return input_output_tensor_names_;
+  }
+
+ private:
+  InferenceRunnerPool& pool_;
+  const std::string key_;
+  const InputOutputTensorNames input_output_tensor_names_;
+};
+
+}  // namespace
+
+InferenceRunnerPool::Lease::Lease(InferenceRunnerPool* pool, std::string key,
+                                  std::unique_ptr<InferenceRunner> runner)
+    : pool_(pool), key_(std::move(key)), runner_(std::move(runner)) {}
+
+InferenceRunnerPool::Lease::Lease(Lease&& other)
+    : pool_(other.pool_),
+      key_(std::move(other.key_)),
+      runner_(std::move(other.runner_)) {}
+
+InferenceRunnerPool::Lease::~Lease() {
+  if (runner_ != nullptr) {
+    pool_->Release(key_, std::move(runner_));
+  }
+}
+
+InferenceRunnerPool::InferenceRunnerPool(const Options& options)
+    : options_(options) {}
+
+// static
+std::string InferenceRunnerPool::GetRunnerKey(
+    const tflite::FlatBufferModel& model,
+    const tflite::OpResolver* op_resolver,
+    const mediapipe::InferenceCalculatorOptions::Delegate& delegate,
+    int num_threads) {
+  const absl::string_view model_content(
+      static_cast<const char*>(model.allocation()->base()),
+      model.allocation()->bytes());
+  return absl::StrCat(absl::Hash<absl::string_view>()(model_content), ":",
+                      model_content.size(), ":",
+                      op_resolver == nullptr
+                          ? "builtin"
+                          : absl::StrFormat("%p", op_resolver),
+                      ":", num_threads, ":", delegate.SerializeAsString());
+}
+
+absl::Status InferenceRunnerPool::Register(const std::string& key,
+                                           RunnerFactory factory) {
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      if (entries_.size() >= options_.max_models) {
+        return CreateStatusWithPayload(
+            absl::StatusCode::kResourceExhausted,
+            absl::Substitute("InferenceRunnerPool already holds runners for "
+                             "$0 models.",
+                             entries_.size()),
+            MediaPipeTasksStatus::kRunnerError);
+      }
+      it = entries_.emplace(key, Entry()).first;
+    }
+    Entry& entry = it->second;
+    // The user keeps the entry alive while its runner is created.
+    ++entry.num_users;
+    if (entry.num_runners + entry.num_pending_runners >=
+        options_.max_runners_per_model) {
+      return absl::OkStatus();
+    }
+    // Reserves the runner, so that concurrent registrations cannot exceed
+    // max_runners_per_model.
+    ++entry.num_pending_runners;
+  }
+
+  // Creating a runner builds an interpreter and may take a while, so it does
+  // not block the other users of the pool.
+  absl::StatusOr<std::unique_ptr<InferenceRunner>> runner = factory();
+
+  std::vector<std::unique_ptr<InferenceRunner>> unused_runners;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    Entry& entry = it->second;
+    --entry.num_pending_runners;
+    // Wakes up the users waiting in Acquire, which either get the new runner
+    // or see that no runner is coming.
+    runner_released_.SignalAll();
+    if (runner.ok()) {
+      entry.idle_runners.push_back(*std::move(runner));
+      ++entry.num_runners;
+      return absl::OkStatus();
+    }
+    if (--entry.num_users == 0) {
+      unused_runners = std::move(entry.idle_runners);
+      entries_.erase(it);
+    }
+  }
+  // The runners are destroyed outside of the lock.
+  unused_runners.clear();
+  return runner.status();
+}
+
+void InferenceRunnerPool::Unregister(const std::string& key) {
+  std::vector<std::unique_ptr<InferenceRunner>> runners;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end() || --it->second.num_users > 0) return;
+    // No runner is leased as the last user is gone.
+    runners = std::move(it->second.idle_runners);
+    entries_.erase(it);
+  }
+  // The runners are destroyed outside of the lock.
+  runners.clear();
+}
+
+absl::StatusOr<InferenceRunnerPool::Lease> InferenceRunnerPool::Acquire(
+    const std::string& key) {
+  absl::MutexLock lock(&mutex_);
+  while (true) {
+    // The entry is looked up again after each wait, since other keys may have
+    // been added to the map in the meantime.
+    auto it = entries_.find(key);
+    if (it == entries_.end() || (it->second.num_runners == 0 &&
+                                 it->second.num_pending_runners == 0)) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kFailedPrecondition,
+          absl::Substitute("No runners are registered for key \"$0\".", key),
+          MediaPipeTasksStatus::kRunnerError);
+    }
+    std::vector<std::unique_ptr<InferenceRunner>>& idle_runners =
+        it->second.idle_runners;
+    if (!idle_runners.empty()) {
+      std::unique_ptr<InferenceRunner> runner = std::move(idle_runners.back());
+      idle_runners.pop_back();
+      return Lease(this, key, std::move(runner));
+    }
+    runner_released_.Wait(&mutex_);
+  }
+}
+
+void InferenceRunnerPool::Release(const std::string& key,
+                                  std::unique_ptr<InferenceRunner> runner) {
+  absl::MutexLock lock(&mutex_);
+  entries_.at(key).idle_runners.push_back(std::move(runner));
+  runner_released_.SignalAll();
+}
+
+int InferenceRunnerPool::NumRunners(const std::string& key) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = entries_.find(key);
+  return it == entries_.end() ? 0 : it->second.num_runners;
+}
+
+absl::StatusOr<std::unique_ptr<InferenceRunner>> CreatePooledInferenceRunner(
+    InferenceRunnerPool& pool, const std::string& key,
+    InferenceRunnerPool::RunnerFactory factory) {
+  MP_RETURN_IF_ERROR(pool.Register(key, factory));
+  // All runners for a key run the same model, so any of them provides the
+  // tensor names.
+  absl::StatusOr<InferenceRunnerPool::Lease> lease = pool.Acquire(key);
+  if (!lease.ok()) {
+    pool.Unregister(key);
+    return lease.status();
+  }
+  InputOutputTensorNames input_output_tensor_names =
+      lease->runner().GetInputOutputTensorNames();
+  return std::make_unique<PooledInferenceRunner>(
+      pool, key, std::move(input_output_tensor_names));
+}
+
+absl::StatusOr<std::unique_ptr<InferenceRunner>>
+MaybeCreatePooledInferenceRunner(
+    CalculatorContext* cc, const tflite::FlatBufferModel& model,
+    const tflite::OpResolver* op_resolver,
+    const mediapipe::InferenceCalculatorOptions::Delegate& delegate,
+    int num_threads, InferenceRunnerPool::RunnerFactory factory) {
+  auto pool_service = cc->Service(kInferenceRunnerPoolService);
+  const auto& options = cc->Options<mediapipe::InferenceCalculatorOptions>();
+  // Feedback tensors are state of a runner, which cannot be shared.
+  if (pool_service.IsAvailable() &&
+      options.input_output_config().feedback_tensor_links().empty()) {
+    absl::StatusOr<std::unique_ptr<InferenceRunner>> runner =
+        CreatePooledInferenceRunner(
+            pool_service.GetObject(),
+            InferenceRunnerPool::GetRunnerKey(model, op_resolver, delegate,
+                                              num_threads),
+            factory);
+    if (!absl::IsResourceExhausted(runner.status())) {
+      return runner;
+    }
+  }
+  return factory();
+}
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
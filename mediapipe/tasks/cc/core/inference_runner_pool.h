@@ -0,0 +1,169 @@
+/* Copyright 2024 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef MEDIAPIPE_TASKS_CC_CORE_INFERENCE_RUNNER_POOL_H_
+#define MEDIAPIPE_TASKS_CC_CORE_INFERENCE_RUNNER_POOL_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/functional/function_ref.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/framework/calculator_context.h"
+#include "mediapipe/framework/graph_service.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+#include "tensorflow/lite/model_builder.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+
+// Shares InferenceRunners, and so TfLite interpreters and delegates, among the
+// InferenceCalculators of several graphs that run the same model.
+//
+// Runners are grouped by a key that identifies the model content, the op
+// resolver and the delegate options, see GetRunnerKey. Each calculator that
+// uses a key registers with the pool in Open, which creates a runner for the
+// key unless it already holds max_runners_per_model of them. Runners are
+// created outside of the pool's lock, so building an interpreter does not
+// block the inference calls of other models. The calculator then leases an
+// idle runner for each inference call, waiting while all of them are in use.
+// The runners of a key are destroyed when its last user unregisters.
+//
+// The pool is shared by setting the same instance as the
+// kInferenceRunnerPoolService object of every graph.
+class InferenceRunnerPool {
+ public:
+  struct Options {
+    // The maximum number of runners created for one key. Inference calls of
+    // the same model beyond this number wait for a runner to be released.
+    int max_runners_per_model = 1;
+
+    // The maximum number of keys with runners in the pool. Registering a new
+    // key beyond this number fails with ResourceExhaustedError, and the
+    // caller is expected to fall back to a runner of its own.
+    int max_models = 16;
+  };
+
+  using RunnerFactory =
+      absl::FunctionRef<absl::StatusOr<std::unique_ptr<InferenceRunner>>()>;
+
+  // An InferenceRunner leased from the pool for the lifetime of the Lease.
+  class Lease {
+   public:
+    Lease(Lease&& other);
+    Lease& operator=(Lease&&) = delete;
+    ~Lease();
+
+    InferenceRunner& runner() const { return *runner_; }
+
+   private:
+    friend class InferenceRunnerPool;
+    Lease(InferenceRunnerPool* pool, std::string key,
+          std::unique_ptr<InferenceRunner> runner);
+
+    InferenceRunnerPool* pool_;
+    std::string key_;
+    std::unique_ptr<InferenceRunner> runner_;
+  };
+
+  InferenceRunnerPool() : InferenceRunnerPool(Options()) {}
+  explicit InferenceRunnerPool(const Options& options);
+
+  // Returns the key of the runners of `model` with the given op resolver,
+  // delegate options and number of interpreter threads. The key is derived
+  // from the model content, so separately loaded copies of a model share
+  // runners. `op_resolver` is the resolver provided to the calculator, or
+  // nullptr for the default builtin op resolver. Resolvers are told apart by
+  // address, since their set of custom ops cannot be inspected, so only
+  // users of the same resolver object share runners. The runners keep their
+  // resolver alive, so its address is not reused while the key is in use.
+  static std::string GetRunnerKey(
+      const tflite::FlatBufferModel& model,
+      const tflite::OpResolver* op_resolver,
+      const mediapipe::InferenceCalculatorOptions::Delegate& delegate,
+      int num_threads);
+
+  // Registers a user of the runners for `key`, and creates a runner with
+  // `factory` unless the key already has max_runners_per_model runners.
+  // `factory` runs without holding the pool's lock.
+  absl::Status Register(const std::string& key, RunnerFactory factory);
+
+  // Unregisters a user of the runners for `key`. After the last user is
+  // unregistered, the runners for the key are destroyed.
+  void Unregister(const std::string& key);
+
+  // Leases an idle runner for a registered `key`, waiting until one is
+  // released or created if all of them are leased.
+  absl::StatusOr<Lease> Acquire(const std::string& key);
+
+  // Returns the number of runners created for `key`.
+  int NumRunners(const std::string& key) const;
+
+ private:
+  struct Entry {
+    int num_users = 0;
+    int num_runners = 0;
+    // The number of runners that are being created outside of the lock.
+    int num_pending_runners = 0;
+    std::vector<std::unique_ptr<InferenceRunner>> idle_runners;
+  };
+
+  void Release(const std::string& key, std::unique_ptr<InferenceRunner> runner);
+
+  const Options options_;
+  mutable absl::Mutex mutex_;
+  absl::CondVar runner_released_;
+  absl::flat_hash_map<std::string, Entry> entries_ ABSL_GUARDED_BY(mutex_);
+};
+
+// Creates an InferenceRunner that leases a runner from `pool` for each Run
+// call. Registers with the pool, creating a runner with `factory` if needed,
+// and unregisters when destroyed. `pool` must outlive the returned runner.
+absl::StatusOr<std::unique_ptr<InferenceRunner>> CreatePooledInferenceRunner(
+    InferenceRunnerPool& pool, const std::string& key,
+    InferenceRunnerPool::RunnerFactory factory);
+
+// Graph service for an InferenceRunnerPool shared among graphs. If the service
+// object is set, the CPU and XNNPACK InferenceCalculators lease their
+// interpreters from the pool.
+inline constexpr mediapipe::GraphService<InferenceRunnerPool>
+    kInferenceRunnerPoolService("mediapipe::tasks::InferenceRunnerPoolService");
+
+// Creates the InferenceRunner of an InferenceCalculator. If the graph has a
+// kInferenceRunnerPoolService object and the model has no feedback tensors,
+// returns a runner that leases from the pool, unless the pool already holds
+// the maximum number of models. Otherwise returns the runner of `factory`.
+// `op_resolver` is as in InferenceRunnerPool::GetRunnerKey.
+// The calculator must request the service with UseService(...).Optional().
+absl::StatusOr<std::unique_ptr<InferenceRunner>>
+MaybeCreatePooledInferenceRunner(
+    CalculatorContext* cc, const tflite::FlatBufferModel& model,
+    const tflite::OpResolver* op_resolver,
+    const mediapipe::InferenceCalculatorOptions::Delegate& delegate,
+    int num_threads, InferenceRunnerPool::RunnerFactory factory);
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_CORE_INFERENCE_RUNNER_POOL_H_
@@ -0,0 +1,232 @@
+/* Copyright 2024 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/notification.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_io_mapper.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "tensorflow/lite/model_builder.h"
+#include "tensorflow/lite/mutable_op_resolver.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+constexpr char kKey[] = "model";
+constexpr char kTestModelPath[] =
+    "mediapipe/tasks/testdata/core/test_model_without_custom_op.tflite";
+
+// Counts its Run calls and returns no output tensors.
+class FakeInferenceRunner : public InferenceRunner {
+ public:
+  absl::StatusOr<std::vector<Tensor>> Run(
+      CalculatorContext* cc, const TensorSpan& tensor_span) override {
+    ++num_runs;
+    return std::vector<Tensor>();
+  }
+
+  const InputOutputTensorNames& GetInputOutputTensorNames() const override {
+    return input_output_tensor_names_;
+  }
+
+  int num_runs = 0;
+
+ private:
+  InputOutputTensorNames input_output_tensor_names_;
+};
+
+absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateFakeRunner() {
+  return std::make_unique<FakeInferenceRunner>();
+}
+
+InferenceRunnerPool::Options MakeOptions(int max_runners_per_model,
+                                         int max_models) {
+  InferenceRunnerPool::Options options;
+  options.max_runners_per_model = max_runners_per_model;
+  options.max_models = max_models;
+  return options;
+}
+
+TEST(InferenceRunnerPoolTest, SharesRunnersAmongUsers) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/2,
+                                       /*max_models=*/1));
+  int num_created = 0;
+  auto factory = [&num_created]() {
+    ++num_created;
+    return CreateFakeRunner();
+  };
+  for (int i = 0; i < 5; ++i) {
+    MP_ASSERT_OK(pool.Register(kKey, factory));
+  }
+  EXPECT_EQ(num_created, 2);
+  EXPECT_EQ(pool.NumRunners(kKey), 2);
+
+  MP_ASSERT_OK_AND_ASSIGN(InferenceRunnerPool::Lease first, pool.Acquire(kKey));
+  MP_ASSERT_OK_AND_ASSIGN(InferenceRunnerPool::Lease second,
+                          pool.Acquire(kKey));
+  EXPECT_NE(&first.runner(), &second.runner());
+}
+
+TEST(InferenceRunnerPoolTest, ReusesReleasedRunner) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/1,
+                                       /*max_models=*/1));
+  MP_ASSERT_OK(pool.Register(kKey, CreateFakeRunner));
+  InferenceRunner* runner = nullptr;
+  {
+    MP_ASSERT_OK_AND_ASSIGN(InferenceRunnerPool::Lease lease,
+                            pool.Acquire(kKey));
+    runner = &lease.runner();
+  }
+  MP_ASSERT_OK_AND_ASSIGN(InferenceRunnerPool::Lease lease, pool.Acquire(kKey));
+  EXPECT_EQ(&lease.runner(), runner);
+}
+
+TEST(InferenceRunnerPoolTest, RejectsModelsBeyondLimit) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/1,
+                                       /*max_models=*/1));
+  MP_ASSERT_OK(pool.Register(kKey, CreateFakeRunner));
+  EXPECT_TRUE(absl::IsResourceExhausted(
+      pool.Register("other_model", CreateFakeRunner)));
+
+  // A model is admitted again once the last user of another one leaves.
+  pool.Unregister(kKey);
+  EXPECT_EQ(pool.NumRunners(kKey), 0);
+  MP_EXPECT_OK(pool.Register("other_model", CreateFakeRunner));
+}
+
+TEST(InferenceRunnerPoolTest, FailsToAcquireUnregisteredKey) {
+  InferenceRunnerPool pool;
+  EXPECT_EQ(pool.Acquire(kKey).status().code(),
+            absl::StatusCode::kFailedPrecondition);
+}
+
+TEST(InferenceRunnerPoolTest, PooledRunnerLeasesPerRun) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/1,
+                                       /*max_models=*/1));
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<InferenceRunner> first,
+                          CreatePooledInferenceRunner(pool, kKey,
+                                                      CreateFakeRunner));
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<InferenceRunner> second,
+                          CreatePooledInferenceRunner(pool, kKey,
+                                                      CreateFakeRunner));
+  EXPECT_EQ(pool.NumRunners(kKey), 1);
+  MP_ASSERT_OK(first->Run(/*cc=*/nullptr, TensorSpan()));
+  MP_ASSERT_OK(second->Run(/*cc=*/nullptr, TensorSpan()));
+  {
+    MP_ASSERT_OK_AND_ASSIGN(InferenceRunnerPool::Lease lease,
+                            pool.Acquire(kKey));
+    EXPECT_EQ(static_cast<FakeInferenceRunner&>(lease.runner()).num_runs, 2);
+  }
+
+  first.reset();
+  EXPECT_EQ(pool.NumRunners(kKey), 1);
+  second.reset();
+  EXPECT_EQ(pool.NumRunners(kKey), 0);
+}
+
+TEST(InferenceRunnerPoolTest, CreatesRunnersOutsideOfLock) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/1,
+                                       /*max_models=*/2));
+  MP_ASSERT_OK(pool.Register("other_model", CreateFakeRunner));
+  absl::Notification factory_started;
+  absl::Notification release_factory;
+  int num_created = 0;
+  std::thread registration([&] {
+    MP_EXPECT_OK(pool.Register(
+        kKey, [&]() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+          ++num_created;
+          factory_started.Notify();
+          release_factory.WaitForNotification();
+          return CreateFakeRunner();
+        }));
+  });
+  factory_started.WaitForNotification();
+
+  // The runners of other models remain available while the runner is created.
+  MP_EXPECT_OK(pool.Acquire("other_model"));
+  // Another user of the model does not create a second runner, and waits for
+  // the pending one when leasing.
+  MP_ASSERT_OK(pool.Register(kKey, CreateFakeRunner));
+  std::thread lookup([&] {
+    MP_EXPECT_OK(pool.Acquire(kKey));
+  });
+
+  release_factory.Notify();
+  registration.join();
+  lookup.join();
+  EXPECT_EQ(num_created, 1);
+  EXPECT_EQ(pool.NumRunners(kKey), 1);
+}
+
+TEST(InferenceRunnerPoolTest, ReturnsFactoryError) {
+  InferenceRunnerPool pool(MakeOptions(/*max_runners_per_model=*/1,
+                                       /*max_models=*/1));
+  auto failing_factory =
+      []() -> absl::StatusOr<std::unique_ptr<InferenceRunner>> {
+    return absl::InternalError("no interpreter");
+  };
+  EXPECT_EQ(pool.Register(kKey, failing_factory).code(),
+            absl::StatusCode::kInternal);
+  EXPECT_EQ(pool.NumRunners(kKey), 0);
+  EXPECT_EQ(pool.Acquire(kKey).status().code(),
+            absl::StatusCode::kFailedPrecondition);
+  // The failed model does not count against max_models.
+  MP_EXPECT_OK(pool.Register("other_model", CreateFakeRunner));
+}
+
+TEST(InferenceRunnerPoolTest, RunnerKeyDependsOnOpResolver) {
+  auto model = tflite::FlatBufferModel::BuildFromFile(kTestModelPath);
+  ASSERT_NE(model, nullptr);
+  tflite::MutableOpResolver first_resolver;
+  tflite::MutableOpResolver second_resolver;
+  const InferenceCalculatorOptions::Delegate delegate;
+
+  const std::string default_key = InferenceRunnerPool::GetRunnerKey(
+      *model, /*op_resolver=*/nullptr, delegate, /*num_threads=*/1);
+  const std::string first_key = InferenceRunnerPool::GetRunnerKey(
+      *model, &first_resolver, delegate, /*num_threads=*/1);
+  EXPECT_EQ(InferenceRunnerPool::GetRunnerKey(*model, /*op_resolver=*/nullptr,
+                                              delegate, /*num_threads=*/1),
+            default_key);
+  EXPECT_EQ(InferenceRunnerPool::GetRunnerKey(*model, &first_resolver,
+                                              delegate, /*num_threads=*/1),
+            first_key);
+  EXPECT_NE(first_key, default_key);
+  EXPECT_NE(InferenceRunnerPool::GetRunnerKey(*model, &second_resolver,
+                                              delegate, /*num_threads=*/1),
+            first_key);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
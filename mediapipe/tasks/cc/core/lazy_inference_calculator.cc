@@ -0,0 +1,149 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/tensor/inference_calculator.pb.h"
+#include "mediapipe/calculators/tensor/inference_calculator_utils.h"
+#include "mediapipe/calculators/tensor/inference_interpreter_delegate_runner.h"
+#include "mediapipe/calculators/tensor/inference_runner.h"
+#include "mediapipe/calculators/tensor/tensor_span.h"
+#include "mediapipe/calculators/tensor/tflite_delegate_ptr.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/tasks/cc/core/model_resources.h"
+#include "mediapipe/tasks/cc/core/model_resources_cache.h"
+#include "mediapipe/tasks/cc/core/proto/acceleration.pb.h"
+#include "mediapipe/tasks/cc/core/proto/inference_subgraph.pb.h"
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+
+using ::mediapipe::tasks::core::proto::Acceleration;
+using ::mediapipe::tasks::core::proto::InferenceSubgraphOptions;
+
+// A LazyInferenceCalculator runs CPU inference on a model that is registered
+// lazily in the ModelResourcesCacheService, see
+// ModelResourcesCache::AddLazyModelResources. Unlike ModelResourcesCalculator
+// followed by InferenceCalculator, which get the model resources when the
+// graph starts, it creates the model resources and the interpreter when it
+// receives its first input tensors, so that a model that never runs is never
+// built. Only the TfLite and XNNPACK delegates are supported.
+//
+// Inputs:
+//   TENSORS - std::vector<Tensor>
+//     The input tensors of the model.
+//
+// Outputs:
+//   TENSORS - std::vector<Tensor>
+//     The output tensors of the model.
+//
+// Example config:
+// node {
+//   calculator: "mediapipe.tasks.core.LazyInferenceCalculator"
+//   input_stream: "TENSORS:input_tensors"
+//   output_stream: "TENSORS:output_tensors"
+//   options {
+//     [mediapipe.tasks.core.proto.InferenceSubgraphOptions.ext] {
+//       model_resources_tag: "unique_model_resources_tag"
+//       base_options { acceleration { xnnpack {} } }
+//     }
+//   }
+// }
+class LazyInferenceCalculator : public api2::Node {
+ public:
+  static constexpr api2::Input<std::vector<Tensor>> kInTensors{"TENSORS"};
+  static constexpr api2::Output<std::vector<Tensor>> kOutTensors{"TENSORS"};
+
+  MEDIAPIPE_NODE_CONTRACT(kInTensors, kOutTensors);
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    const auto& options = cc->Options<InferenceSubgraphOptions>();
+    RET_CHECK(!options.model_resources_tag().empty())
+        << "'model_resources_tag' should not be empty.";
+    const Acceleration& acceleration = options.base_options().acceleration();
+    RET_CHECK(acceleration.has_tflite() || acceleration.has_xnnpack() ||
+              acceleration.delegate_case() == Acceleration::DELEGATE_NOT_SET)
+        << "LazyInferenceCalculator only supports the TfLite and XNNPACK "
+           "delegates.";
+    cc->UseService(kModelResourcesCacheService);
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (kInTensors(cc).IsEmpty()) {
+      return absl::OkStatus();
+    }
+    if (inference_runner_ == nullptr) {
+      MP_ASSIGN_OR_RETURN(inference_runner_, CreateInferenceRunner(cc));
+    }
+    MP_ASSIGN_OR_RETURN(
+        std::vector<Tensor> output_tensors,
+        inference_runner_->Run(cc, MakeTensorSpan(*kInTensors(cc))));
+    kOutTensors(cc).Send(std::move(output_tensors));
+    return absl::OkStatus();
+  }
+
+  absl::Status Close(CalculatorContext* cc) override {
+    inference_runner_ = nullptr;
+    return absl::OkStatus();
+  }
+
+ private:
+  absl::StatusOr<std::unique_ptr<InferenceRunner>> CreateInferenceRunner(
+      CalculatorContext* cc) {
+    const auto& options = cc->Options<InferenceSubgraphOptions>();
+    // Runs the model resources factory on first use.
+    MP_ASSIGN_OR_RETURN(const ModelResources* model_resources,
+                        cc->Service(kModelResourcesCacheService)
+                            .GetObject()
+                            .GetModelResources(options.model_resources_tag()));
+    TfLiteDelegatePtr delegate;
+    const Acceleration& acceleration = options.base_options().acceleration();
+    if (acceleration.has_xnnpack()) {
+      mediapipe::InferenceCalculatorOptions::Delegate delegate_options;
+      *delegate_options.mutable_xnnpack() = acceleration.xnnpack();
+      auto xnnpack_opts = TfLiteXNNPackDelegateOptionsDefault();
+      xnnpack_opts.num_threads = GetXnnpackNumThreads(
+          /*opts_has_delegate=*/true, delegate_options);
+      delegate = TfLiteDelegatePtr(TfLiteXNNPackDelegateCreate(&xnnpack_opts),
+                                   [](TfLiteDelegate* delegate) {
+                                     TfLiteXNNPackDelegateDelete(delegate);
+                                   });
+    }
+    return CreateInferenceInterpreterDelegateRunner(
+        model_resources->GetModelPacket(),
+        model_resources->GetOpResolverPacket(), std::move(delegate),
+        /*interpreter_num_threads=*/-1);
+  }
+
+  std::unique_ptr<InferenceRunner> inference_runner_;
+};
+
+MEDIAPIPE_REGISTER_NODE(LazyInferenceCalculator);
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,175 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/substitute.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/packet.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/sink.h"
+#include "mediapipe/tasks/cc/core/model_resources.h"
+#include "mediapipe/tasks/cc/core/model_resources_cache.h"
+#include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr char kTestModelResourcesTag[] = "test_model_resources";
+
+// A model that adds its 1x8x8x3 float input tensor to itself twice.
+constexpr char kAddModelPath[] =
+    "mediapipe/calculators/tensor/testdata/add.bin";
+
+CalculatorGraphConfig GenerateGraphConfig(const std::string& acceleration) {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(absl::Substitute(
+      R"pb(
+        input_stream: "tensors_in"
+        node {
+          calculator: "mediapipe.tasks.core.LazyInferenceCalculator"
+          input_stream: "TENSORS:tensors_in"
+          output_stream: "TENSORS:tensors_out"
+          options {
+            [mediapipe.tasks.core.proto.InferenceSubgraphOptions.ext] {
+              model_resources_tag: "$0"
+              base_options { acceleration { $1 } }
+            }
+          }
+        }
+      )pb",
+      kTestModelResourcesTag, acceleration));
+}
+
+std::vector<Tensor> CreateInputTensors(float value) {
+  std::vector<Tensor> tensors;
+  tensors.emplace_back(Tensor::ElementType::kFloat32,
+                       Tensor::Shape{1, 8, 8, 3});
+  auto view = tensors.back().GetCpuWriteView();
+  float* buffer = view.buffer<float>();
+  for (int i = 0; i < tensors.back().shape().num_elements(); ++i) {
+    buffer[i] = value;
+  }
+  return tensors;
+}
+
+// Registers the add model lazily in a new cache and counts the calls to its
+// factory in `num_factory_calls`.
+std::shared_ptr<ModelResourcesCache> CreateModelResourcesCache(
+    int* num_factory_calls) {
+  auto cache = std::make_shared<ModelResourcesCache>();
+  MP_EXPECT_OK(cache->AddLazyModelResources(
+      kTestModelResourcesTag,
+      [num_factory_calls]()
+          -> absl::StatusOr<std::unique_ptr<ModelResources>> {
+        ++*num_factory_calls;
+        auto model_file = std::make_unique<proto::ExternalFile>();
+        model_file->set_file_name(kAddModelPath);
+        return ModelResources::Create(kTestModelResourcesTag,
+                                      std::move(model_file));
+      }));
+  return cache;
+}
+
+class LazyInferenceCalculatorTest
+    : public ::testing::TestWithParam<std::string> {};
+
+TEST_P(LazyInferenceCalculatorTest, CreatesModelOnFirstInput) {
+  int num_factory_calls = 0;
+  CalculatorGraphConfig graph_config = GenerateGraphConfig(GetParam());
+  std::vector<Packet> output_packets;
+  tool::AddVectorSink("tensors_out", &graph_config, &output_packets);
+  CalculatorGraph graph;
+  MP_ASSERT_OK(
+      graph.SetServiceObject(kModelResourcesCacheService,
+                             CreateModelResourcesCache(&num_factory_calls)));
+  MP_ASSERT_OK(graph.Initialize(graph_config));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.WaitUntilIdle());
+  EXPECT_EQ(num_factory_calls, 0);
+
+  for (int i = 0; i < 2; ++i) {
+    MP_ASSERT_OK(graph.AddPacketToInputStream(
+        "tensors_in",
+        MakePacket<std::vector<Tensor>>(CreateInputTensors(i + 1))
+            .At(Timestamp(i))));
+  }
+  MP_ASSERT_OK(graph.CloseInputStream("tensors_in"));
+  MP_ASSERT_OK(graph.WaitUntilDone());
+  EXPECT_EQ(num_factory_calls, 1);
+
+  ASSERT_EQ(output_packets.size(), 2);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(output_packets[i].Timestamp(), Timestamp(i));
+    const auto& tensors = output_packets[i].Get<std::vector<Tensor>>();
+    ASSERT_EQ(tensors.size(), 1);
+    auto view = tensors[0].GetCpuReadView();
+    const float* buffer = view.buffer<float>();
+    for (int j = 0; j < tensors[0].shape().num_elements(); ++j) {
+      ASSERT_EQ(buffer[j], 3 * (i + 1));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(LazyInferenceCalculatorTests,
+                         LazyInferenceCalculatorTest,
+                         ::testing::Values("tflite {}", "xnnpack {}"));
+
+TEST(LazyInferenceCalculatorErrorTest, FailsWithGpuDelegate) {
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.SetServiceObject(kModelResourcesCacheService,
+                                      std::make_shared<ModelResourcesCache>()));
+  auto status = graph.Initialize(GenerateGraphConfig("gpu {}"));
+  ASSERT_FALSE(status.ok());
+  EXPECT_THAT(status.message(),
+              HasSubstr("only supports the TfLite and XNNPACK delegates"));
+}
+
+TEST(LazyInferenceCalculatorErrorTest, ReturnsFactoryErrorOnFirstInput) {
+  auto cache = std::make_shared<ModelResourcesCache>();
+  MP_ASSERT_OK(cache->AddLazyModelResources(
+      kTestModelResourcesTag,
+      []() -> absl::StatusOr<std::unique_ptr<ModelResources>> {
+        return absl::NotFoundError("model file is missing");
+      }));
+  CalculatorGraph graph;
+  MP_ASSERT_OK(graph.SetServiceObject(kModelResourcesCacheService, cache));
+  MP_ASSERT_OK(graph.Initialize(GenerateGraphConfig("tflite {}")));
+  MP_ASSERT_OK(graph.StartRun({}));
+  MP_ASSERT_OK(graph.AddPacketToInputStream(
+      "tensors_in",
+      MakePacket<std::vector<Tensor>>(CreateInputTensors(1)).At(Timestamp(0))));
+  MP_ASSERT_OK(graph.CloseInputStream("tensors_in"));
+  auto status = graph.WaitUntilDone();
+  ASSERT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), HasSubstr("model file is missing"));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
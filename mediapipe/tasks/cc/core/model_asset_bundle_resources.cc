@@ -41,7 +41,8 @@ ModelAssetBundleResources::ModelAssetBundleResources(
 absl::StatusOr<std::unique_ptr<ModelAssetBundleResources>>
 ModelAssetBundleResources::Create(
     const std::string& tag,
-    std::unique_ptr<proto::ExternalFile> model_asset_bundle_file) {
+    std::unique_ptr<proto::ExternalFile> model_asset_bundle_file,
+    bool prefetch) {
   if (model_asset_bundle_file == nullptr) {
     return CreateStatusWithPayload(
         StatusCode::kInvalidArgument,
@@ -51,11 +52,12 @@ ModelAssetBundleResources::Create(
   auto model_bundle_resources = absl::WrapUnique(
       new ModelAssetBundleResources(tag, std::move(model_asset_bundle_file)));
   MP_RETURN_IF_ERROR(
-      model_bundle_resources->ExtractFilesFromExternalFileProto());
+      model_bundle_resources->ExtractFilesFromExternalFileProto(prefetch));
   return model_bundle_resources;
 }
 
-absl::Status ModelAssetBundleResources::ExtractFilesFromExternalFileProto() {
+absl::Status ModelAssetBundleResources::ExtractFilesFromExternalFileProto(
+    bool prefetch) {
   if (model_asset_bundle_file_->has_file_name()) {
     // If the model asset bundle file name is a relative path, searches the file
     // in a platform-specific location and returns the absolute path on success.
@@ -66,7 +68,7 @@ absl::Status ModelAssetBundleResources::ExtractFilesFromExternalFileProto() {
   }
   MP_ASSIGN_OR_RETURN(model_asset_bundle_file_handler_,
                       ExternalFileHandler::CreateFromExternalFile(
-                          model_asset_bundle_file_.get()));
+                          model_asset_bundle_file_.get(), prefetch));
   const char* buffer_data =
       model_asset_bundle_file_handler_->GetFileContent().data();
   size_t buffer_size =
@@ -91,6 +93,29 @@ absl::StatusOr<absl::string_view> ModelAssetBundleResources::GetFile(
   return it->second;
 }
 
+absl::Status ModelAssetBundleResources::SetExternalFile(
+    const std::string& filename, proto::ExternalFile* external_file,
+    bool is_copy) const {
+  MP_ASSIGN_OR_RETURN(absl::string_view file_content, GetFile(filename));
+  if (is_copy && !file_content.empty() &&
+      model_asset_bundle_file_->has_file_name()) {
+    // Files are stored uncompressed in the bundle, so they can be mapped
+    // directly from the bundle file.
+    const int64_t offset_in_bundle =
+        file_content.data() -
+        model_asset_bundle_file_handler_->GetFileContent().data();
+    external_file->set_file_name(model_asset_bundle_file_->file_name());
+    auto* file_descriptor_meta = external_file->mutable_file_descriptor_meta();
+    file_descriptor_meta->set_offset(
+        model_asset_bundle_file_->file_descriptor_meta().offset() +
+        offset_in_bundle);
+    file_descriptor_meta->set_length(file_content.size());
+    return absl::OkStatus();
+  }
+  metadata::SetExternalFile(file_content, external_file, is_copy);
+  return absl::OkStatus();
+}
+
 std::vector<std::string> ModelAssetBundleResources::ListFiles() const {
   std::vector<std::string> file_names;
   for (const auto& [file_name, _] : files_) {
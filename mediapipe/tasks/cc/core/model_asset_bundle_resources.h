@@ -37,10 +37,13 @@ class ModelAssetBundleResources {
   // Takes the ownership of the provided ExternalFile proto and creates
   // ModelAssetBundleResources from the proto. A non-empty tag
   // must be set if the ModelAssetBundleResources will be used through
-  // ModelResourcesCacheService.
+  // ModelResourcesCacheService. If `prefetch` is true and the bundle is mapped
+  // from a file, the OS is asked to start reading all of it in the background,
+  // so that the bundled files load while the task graph is being built.
   static absl::StatusOr<std::unique_ptr<ModelAssetBundleResources>> Create(
       const std::string& tag,
-      std::unique_ptr<proto::ExternalFile> model_asset_bundle_file);
+      std::unique_ptr<proto::ExternalFile> model_asset_bundle_file,
+      bool prefetch = false);
 
   // ModelResources is neither copyable nor movable.
   ModelAssetBundleResources(const ModelAssetBundleResources&) = delete;
@@ -55,6 +58,16 @@ class ModelAssetBundleResources {
   // there is no such model file.
   absl::StatusOr<absl::string_view> GetFile(const std::string& filename) const;
 
+  // Sets `external_file` to refer to the bundled file with the provided name.
+  // By default the file is referenced by pointer and is only valid while this
+  // object is alive. If `is_copy` is true, the reference must outlive this
+  // object: when the bundle was loaded from a file name, the bundled file is
+  // referenced by that file name and its offset in the file so that it can be
+  // memory-mapped again without a copy; otherwise its contents are copied.
+  absl::Status SetExternalFile(const std::string& filename,
+                               proto::ExternalFile* external_file,
+                               bool is_copy = false) const;
+
   // Lists all the file names in the model asset model.
   std::vector<std::string> ListFiles() const;
 
@@ -66,7 +79,7 @@ class ModelAssetBundleResources {
 
   // Extracts the model files (either tflite model file, resource file or model
   // bundle file) from the external file proto.
-  absl::Status ExtractFilesFromExternalFileProto();
+  absl::Status ExtractFilesFromExternalFileProto(bool prefetch);
 
   // The model asset bundle resources tag.
   const std::string tag_;
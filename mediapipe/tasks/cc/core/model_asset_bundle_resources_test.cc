@@ -188,6 +188,33 @@ TEST(ModelAssetBundleResourcesTest, ExtractValidTFLiteModelFile) {
   EXPECT_TRUE(model_packet.Get<ModelResources::ModelPtr>()->initialized());
 }
 
+TEST(ModelAssetBundleResourcesTest, SetExternalFileReferencesBundleFile) {
+  auto model_file = std::make_unique<proto::ExternalFile>();
+  model_file->set_file_name(kTestModelBundlePath);
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto model_bundle_resources,
+      ModelAssetBundleResources::Create(kTestModelBundleResourcesTag,
+                                        std::move(model_file)));
+  auto hand_landmaker_model_file = std::make_unique<proto::ExternalFile>();
+  MP_ASSERT_OK(model_bundle_resources->SetExternalFile(
+      "dummy_hand_landmarker.task", hand_landmaker_model_file.get(),
+      /*is_copy=*/true));
+  EXPECT_TRUE(hand_landmaker_model_file->has_file_name());
+  EXPECT_FALSE(hand_landmaker_model_file->has_file_content());
+  EXPECT_GT(hand_landmaker_model_file->file_descriptor_meta().offset(), 0);
+
+  // The nested bundle is mapped from the bundle file, so it stays valid after
+  // the top-level resources are destroyed.
+  model_bundle_resources.reset();
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto hand_landmaker_model_bundle_resources,
+      ModelAssetBundleResources::Create(kTestModelBundleResourcesTag,
+                                        std::move(hand_landmaker_model_file)));
+  MP_EXPECT_OK(hand_landmaker_model_bundle_resources
+                   ->GetFile("dummy_hand_detector.tflite")
+                   .status());
+}
+
 TEST(ModelAssetBundleResourcesTest, ExtractInvalidModelFile) {
   // Creates top-level model asset bundle resources.
   auto model_file = std::make_unique<proto::ExternalFile>();
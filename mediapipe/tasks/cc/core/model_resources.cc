@@ -90,6 +90,39 @@ absl::StatusOr<std::unique_ptr<ModelResources>> ModelResources::Create(
   return model_resources;
 }
 
+/* static */
+ModelResources::Factory ModelResources::CreateAsync(
+    const std::string& tag, std::unique_ptr<proto::ExternalFile> model_file,
+    Packet<tflite::OpResolver> op_resolver_packet) {
+  if (model_file == nullptr || op_resolver_packet.IsEmpty()) {
+    // Leaves reporting the invalid argument to Create().
+    return [tag, model_file = std::move(model_file),
+            op_resolver_packet]() mutable {
+      return Create(tag, std::move(model_file), op_resolver_packet);
+    };
+  }
+  struct PendingModelResources {
+    std::unique_ptr<ModelResources> model_resources;
+    // Declared last so that it is cancelled and joined before the model file
+    // it reads is destroyed.
+    std::unique_ptr<AsyncExternalFileHandler> model_file_loader;
+  };
+  PendingModelResources pending;
+  pending.model_resources = absl::WrapUnique(
+      new ModelResources(tag, std::move(model_file), op_resolver_packet));
+  pending.model_file_loader = AsyncExternalFileHandler::Start(
+      [model_file = pending.model_resources->model_file_.get()]() {
+        return LoadModelFile(model_file, /*prefetch=*/true);
+      });
+  return [pending = std::move(pending)]() mutable
+         -> absl::StatusOr<std::unique_ptr<ModelResources>> {
+    MP_ASSIGN_OR_RETURN(pending.model_resources->model_file_handler_,
+                        pending.model_file_loader->Get());
+    MP_RETURN_IF_ERROR(pending.model_resources->BuildModelFromFileHandler());
+    return std::move(pending.model_resources);
+  };
+}
+
 const tflite::Model* ModelResources::GetTfLiteModel() const {
 #if !TFLITE_IN_GMSCORE
   return model_packet_.Get()->GetModel();
@@ -99,25 +132,34 @@ const tflite::Model* ModelResources::GetTfLiteModel() const {
 }
 
 absl::Status ModelResources::BuildModelFromExternalFileProto() {
-  if (model_file_->has_file_name()) {
+  MP_ASSIGN_OR_RETURN(model_file_handler_,
+                      LoadModelFile(model_file_.get(), /*prefetch=*/false));
+  return BuildModelFromFileHandler();
+}
+
+/* static */
+absl::StatusOr<std::unique_ptr<ExternalFileHandler>>
+ModelResources::LoadModelFile(proto::ExternalFile* model_file, bool prefetch) {
+  if (model_file->has_file_name()) {
     if (HasCustomGlobalResourceProvider()) {
       // If the model contents are provided via a custom ResourceProviderFn, the
       // open() method may not work. Thus, loads the model content from the
       // model file path in advance with the help of GetResourceContents.
       MP_RETURN_IF_ERROR(GetResourceContents(
-          model_file_->file_name(), model_file_->mutable_file_content()));
-      model_file_->clear_file_name();
+          model_file->file_name(), model_file->mutable_file_content()));
+      model_file->clear_file_name();
     } else {
       // If the model file name is a relative path, searches the file in a
       // platform-specific location and returns the absolute path on success.
       MP_ASSIGN_OR_RETURN(std::string path_to_resource,
-                          PathToResourceAsFile(model_file_->file_name()));
-      model_file_->set_file_name(path_to_resource);
+                          PathToResourceAsFile(model_file->file_name()));
+      model_file->set_file_name(path_to_resource);
     }
   }
-  MP_ASSIGN_OR_RETURN(
-      model_file_handler_,
-      ExternalFileHandler::CreateFromExternalFile(model_file_.get()));
+  return ExternalFileHandler::CreateFromExternalFile(model_file, prefetch);
+}
+
+absl::Status ModelResources::BuildModelFromFileHandler() {
   const char* buffer_data = model_file_handler_->GetFileContent().data();
   size_t buffer_size = model_file_handler_->GetFileContent().size();
   // Verifies that the supplied buffer refers to a valid flatbuffer model,
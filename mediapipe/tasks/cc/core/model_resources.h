@@ -21,6 +21,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 
+#include "absl/functional/any_invocable.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -54,6 +55,10 @@ class ModelResources {
       std::unique_ptr<tflite::FlatBufferModel,
                       std::function<void(tflite::FlatBufferModel*)>>;
 
+  // Finishes creating a ModelResources started by CreateAsync().
+  using Factory =
+      absl::AnyInvocable<absl::StatusOr<std::unique_ptr<ModelResources>>()>;
+
   // Takes the ownership of the provided ExternalFile proto and creates
   // ModelResources from the proto and an op resolver object. A non-empty tag
   // must be set if the ModelResources will be used through
@@ -73,6 +78,17 @@ class ModelResources {
       const std::string& tag, std::unique_ptr<proto::ExternalFile> model_file,
       api2::Packet<tflite::OpResolver> op_resolver_packet);
 
+  // Like Create, but opens and maps or reads the model file on a background
+  // thread, asking the OS to prefetch its pages, and returns right away. The
+  // returned factory waits for the file and then builds the model, so that the
+  // files of several models load in parallel and while the graph is being
+  // initialized. Destroying the factory without calling it cancels the load.
+  // The factory can be registered with
+  // ModelResourcesCache::AddLazyModelResources.
+  static Factory CreateAsync(
+      const std::string& tag, std::unique_ptr<proto::ExternalFile> model_file,
+      api2::Packet<tflite::OpResolver> op_resolver_packet);
+
   // ModelResources is neither copyable nor movable.
   ModelResources(const ModelResources&) = delete;
   ModelResources& operator=(const ModelResources&) = delete;
@@ -122,6 +138,15 @@ class ModelResources {
   // Builds the TFLite model from the ExternalFile proto.
   absl::Status BuildModelFromExternalFileProto();
 
+  // Resolves the file name of `model_file`, if any, and creates the
+  // ExternalFileHandler for it.
+  static absl::StatusOr<std::unique_ptr<ExternalFileHandler>> LoadModelFile(
+      proto::ExternalFile* model_file, bool prefetch);
+
+  // Builds the TFLite model and the metadata extractor from the content of
+  // model_file_handler_.
+  absl::Status BuildModelFromFileHandler();
+
   // The model resources tag.
   const std::string tag_;
   // The model file.
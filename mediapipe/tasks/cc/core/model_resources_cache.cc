@@ -24,7 +24,9 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/core/model_asset_bundle_resources.h"
 #include "mediapipe/tasks/cc/core/model_resources.h"
@@ -42,8 +44,20 @@ ModelResourcesCache::ModelResourcesCache(
   }
 }
 
+ModelResourcesCache::ModelResourcesCache(
+    api2::Packet<tflite::OpResolver> graph_op_resolver_packet)
+    : graph_op_resolver_packet_(std::move(graph_op_resolver_packet)) {}
+
 bool ModelResourcesCache::Exists(const std::string& tag) const {
-  return model_resources_collection_.contains(tag);
+  absl::MutexLock lock(&mutex_);
+  return ExistsLocked(tag);
+}
+
+bool ModelResourcesCache::ExistsLocked(const std::string& tag) const {
+  return model_resources_collection_.contains(tag) ||
+         lazy_model_resources_.contains(tag) ||
+         lazy_model_resources_in_flight_.contains(tag) ||
+         lazy_model_resources_errors_.contains(tag);
 }
 
 bool ModelResourcesCache::ModelAssetBundleExists(const std::string& tag) const {
@@ -64,7 +78,8 @@ absl::Status ModelResourcesCache::AddModelResources(
         "ModelResources must have a non-empty tag.",
         MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
   }
-  if (Exists(tag)) {
+  absl::MutexLock lock(&mutex_);
+  if (ExistsLocked(tag)) {
     return CreateStatusWithPayload(
         absl::StatusCode::kInvalidArgument,
         absl::Substitute("ModelResources with tag \"$0\" already exists.", tag),
@@ -74,6 +89,25 @@ absl::Status ModelResourcesCache::AddModelResources(
   return absl::OkStatus();
 }
 
+absl::Status ModelResourcesCache::AddLazyModelResources(
+    const std::string& tag, ModelResourcesFactory factory) {
+  if (tag.empty()) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "ModelResources must have a non-empty tag.",
+        MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
+  }
+  absl::MutexLock lock(&mutex_);
+  if (ExistsLocked(tag)) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::Substitute("ModelResources with tag \"$0\" already exists.", tag),
+        MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
+  }
+  lazy_model_resources_.emplace(tag, std::move(factory));
+  return absl::OkStatus();
+}
+
 absl::Status ModelResourcesCache::AddModelResourcesCollection(
     std::vector<std::unique_ptr<ModelResources>>& model_resources_collection) {
   for (auto& model_resources : model_resources_collection) {
@@ -90,13 +124,54 @@ absl::StatusOr<const ModelResources*> ModelResourcesCache::GetModelResources(
         "ModelResources must be retrieved with a non-empty tag.",
         MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
   }
-  if (!Exists(tag)) {
-    return CreateStatusWithPayload(
-        absl::StatusCode::kInvalidArgument,
-        absl::Substitute("ModelResources with tag \"$0\" does not exist.", tag),
+  ModelResourcesFactory factory;
+  {
+    absl::MutexLock lock(&mutex_);
+    while (lazy_model_resources_in_flight_.contains(tag)) {
+      lazy_model_resources_created_.Wait(&mutex_);
+    }
+    if (auto it = model_resources_collection_.find(tag);
+        it != model_resources_collection_.end()) {
+      return it->second.get();
+    }
+    if (auto it = lazy_model_resources_errors_.find(tag);
+        it != lazy_model_resources_errors_.end()) {
+      return it->second;
+    }
+    auto lazy_it = lazy_model_resources_.find(tag);
+    if (lazy_it == lazy_model_resources_.end()) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          absl::Substitute("ModelResources with tag \"$0\" does not exist.",
+                           tag),
+          MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
+    }
+    factory = std::move(lazy_it->second);
+    lazy_model_resources_.erase(lazy_it);
+    lazy_model_resources_in_flight_.insert(tag);
+  }
+
+  absl::StatusOr<std::unique_ptr<ModelResources>> model_resources = factory();
+  if (model_resources.ok() && (*model_resources == nullptr ||
+                               (*model_resources)->GetTag() != tag)) {
+    model_resources = CreateStatusWithPayload(
+        absl::StatusCode::kInternal,
+        absl::Substitute("Lazy ModelResources for tag \"$0\" were not "
+                         "created with that tag.",
+                         tag),
         MediaPipeTasksStatus::kRunnerModelResourcesCacheServiceError);
   }
-  return model_resources_collection_.at(tag).get();
+
+  absl::MutexLock lock(&mutex_);
+  lazy_model_resources_in_flight_.erase(tag);
+  lazy_model_resources_created_.SignalAll();
+  if (!model_resources.ok()) {
+    lazy_model_resources_errors_.emplace(tag, model_resources.status());
+    return model_resources.status();
+  }
+  const ModelResources* result = model_resources->get();
+  model_resources_collection_.emplace(tag, *std::move(model_resources));
+  return result;
 }
 
 absl::Status ModelResourcesCache::AddModelAssetBundleResources(
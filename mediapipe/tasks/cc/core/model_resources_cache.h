@@ -20,10 +20,14 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/api2/packet.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/tasks/cc/core/model_asset_bundle_resources.h"
@@ -41,9 +45,18 @@ namespace core {
 // model.
 class ModelResourcesCache {
  public:
+  // Creates a ModelResources object on first use.
+  using ModelResourcesFactory =
+      absl::AnyInvocable<absl::StatusOr<std::unique_ptr<ModelResources>>()>;
+
   explicit ModelResourcesCache(
       std::unique_ptr<tflite::OpResolver> graph_op_resolver = nullptr);
 
+  // Creates the cache with a graph op resolver that may be shared with other
+  // caches, so that the models of several graphs use the same resolver.
+  explicit ModelResourcesCache(
+      api2::Packet<tflite::OpResolver> graph_op_resolver_packet);
+
   // Returns whether the tag exists in the model resources cache.
   bool Exists(const std::string& tag) const;
 
@@ -63,7 +76,18 @@ class ModelResourcesCache {
   absl::Status AddModelResourcesCollection(
       std::vector<std::unique_ptr<ModelResources>>& model_resources_collection);
 
-  // Retrieves a const ModelResources pointer by the unique tag.
+  // Registers a factory for the ModelResources with the given unique tag. The
+  // factory runs the first time the tag is retrieved through
+  // GetModelResources, so that models which are never reached, e.g. behind a
+  // gate, are not loaded. The created ModelResources must have the same tag.
+  absl::Status AddLazyModelResources(const std::string& tag,
+                                     ModelResourcesFactory factory);
+
+  // Retrieves a const ModelResources pointer by the unique tag, creating it
+  // first if it was registered with AddLazyModelResources. The factory runs
+  // without holding the cache lock, so that other lookups are not blocked by
+  // a slow model load; concurrent lookups of the same tag wait for it. If the
+  // factory fails, its error is returned for every lookup of the tag.
   absl::StatusOr<const ModelResources*> GetModelResources(
       const std::string& tag) const;
 
@@ -92,9 +116,31 @@ class ModelResourcesCache {
   // The packet stores all TFLite op resolvers for the models in the graph.
   api2::Packet<tflite::OpResolver> graph_op_resolver_packet_;
 
+  bool ExistsLocked(const std::string& tag) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Guards the model resources, which may be created lazily by calculators
+  // opening concurrently.
+  mutable absl::Mutex mutex_;
+
+  // Signaled when the creation of lazy model resources completes.
+  mutable absl::CondVar lazy_model_resources_created_;
+
   // A collection of ModelResources objects for the models in the graph.
-  absl::flat_hash_map<std::string, std::unique_ptr<ModelResources>>
-      model_resources_collection_;
+  mutable absl::flat_hash_map<std::string, std::unique_ptr<ModelResources>>
+      model_resources_collection_ ABSL_GUARDED_BY(mutex_);
+
+  // Factories for the ModelResources that have not been created yet.
+  mutable absl::flat_hash_map<std::string, ModelResourcesFactory>
+      lazy_model_resources_ ABSL_GUARDED_BY(mutex_);
+
+  // The tags of the lazy ModelResources whose factory is running.
+  mutable absl::flat_hash_set<std::string> lazy_model_resources_in_flight_
+      ABSL_GUARDED_BY(mutex_);
+
+  // The errors of the lazy ModelResources whose factory failed.
+  mutable absl::flat_hash_map<std::string, absl::Status>
+      lazy_model_resources_errors_ ABSL_GUARDED_BY(mutex_);
 
   // A collection of ModelAssetBundleResources objects for the model bundles in
   // the graph.
@@ -0,0 +1,166 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "mediapipe/tasks/cc/core/model_resources_cache.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/notification.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/core/model_resources.h"
+#include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
+#include "mediapipe/tasks/cc/core/utils.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr char kTestModelPath[] =
+    "mediapipe/tasks/testdata/core/"
+    "test_model_without_custom_op.tflite";
+
+absl::StatusOr<std::unique_ptr<ModelResources>> CreateTestModelResources(
+    const std::string& tag) {
+  auto model_file = std::make_unique<proto::ExternalFile>();
+  model_file->set_file_content(LoadBinaryContent(kTestModelPath));
+  return ModelResources::Create(tag, std::move(model_file));
+}
+
+// Returns a factory of test model resources with the given tag that counts
+// its invocations.
+ModelResourcesCache::ModelResourcesFactory CountingFactory(
+    const std::string& tag, std::atomic<int>* num_calls) {
+  return [tag, num_calls]() {
+    ++*num_calls;
+    return CreateTestModelResources(tag);
+  };
+}
+
+TEST(ModelResourcesCacheTest, CreatesLazyModelResourcesOnFirstUse) {
+  ModelResourcesCache cache;
+  std::atomic<int> num_calls = 0;
+  MP_ASSERT_OK(
+      cache.AddLazyModelResources("lazy", CountingFactory("lazy", &num_calls)));
+  EXPECT_TRUE(cache.Exists("lazy"));
+  EXPECT_EQ(num_calls, 0);
+
+  MP_ASSERT_OK_AND_ASSIGN(const ModelResources* model_resources,
+                          cache.GetModelResources("lazy"));
+  EXPECT_EQ(model_resources->GetTag(), "lazy");
+  EXPECT_FALSE(model_resources->GetModelPacket().IsEmpty());
+  EXPECT_EQ(num_calls, 1);
+}
+
+TEST(ModelResourcesCacheTest, ReusesLazyModelResources) {
+  ModelResourcesCache cache;
+  std::atomic<int> num_calls = 0;
+  MP_ASSERT_OK(
+      cache.AddLazyModelResources("lazy", CountingFactory("lazy", &num_calls)));
+
+  MP_ASSERT_OK_AND_ASSIGN(const ModelResources* first,
+                          cache.GetModelResources("lazy"));
+  MP_ASSERT_OK_AND_ASSIGN(const ModelResources* second,
+                          cache.GetModelResources("lazy"));
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(num_calls, 1);
+}
+
+TEST(ModelResourcesCacheTest, ReturnsFactoryErrorForEveryLookup) {
+  ModelResourcesCache cache;
+  int num_calls = 0;
+  MP_ASSERT_OK(cache.AddLazyModelResources(
+      "lazy", [&]() -> absl::StatusOr<std::unique_ptr<ModelResources>> {
+        ++num_calls;
+        return absl::NotFoundError("model file is missing");
+      }));
+
+  EXPECT_THAT(cache.GetModelResources("lazy").status(),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("model file is missing")));
+  EXPECT_THAT(cache.GetModelResources("lazy").status(),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("model file is missing")));
+  EXPECT_EQ(num_calls, 1);
+  // The failed tag cannot be registered again.
+  std::atomic<int> num_retries = 0;
+  EXPECT_FALSE(
+      cache.AddLazyModelResources("lazy", CountingFactory("lazy", &num_retries))
+          .ok());
+  EXPECT_EQ(num_retries, 0);
+}
+
+TEST(ModelResourcesCacheTest, RejectsLazyModelResourcesWithAnotherTag) {
+  ModelResourcesCache cache;
+  std::atomic<int> num_calls = 0;
+  MP_ASSERT_OK(cache.AddLazyModelResources(
+      "lazy", CountingFactory("another_tag", &num_calls)));
+
+  EXPECT_THAT(cache.GetModelResources("lazy").status(),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("were not created with that tag")));
+}
+
+TEST(ModelResourcesCacheTest, CreatesLazyModelResourcesOutsideOfLock) {
+  ModelResourcesCache cache;
+  MP_ASSERT_OK_AND_ASSIGN(auto eager, CreateTestModelResources("eager"));
+  MP_ASSERT_OK(cache.AddModelResources(std::move(eager)));
+  absl::Notification factory_started;
+  absl::Notification release_factory;
+  std::atomic<int> num_calls = 0;
+  MP_ASSERT_OK(cache.AddLazyModelResources(
+      "lazy", [&]() -> absl::StatusOr<std::unique_ptr<ModelResources>> {
+        ++num_calls;
+        factory_started.Notify();
+        release_factory.WaitForNotification();
+        return CreateTestModelResources("lazy");
+      }));
+
+  const ModelResources* first = nullptr;
+  const ModelResources* second = nullptr;
+  std::thread first_lookup([&] {
+    MP_ASSERT_OK_AND_ASSIGN(first, cache.GetModelResources("lazy"));
+  });
+  factory_started.WaitForNotification();
+  // A concurrent lookup of the same tag waits for the running factory.
+  std::thread second_lookup([&] {
+    MP_ASSERT_OK_AND_ASSIGN(second, cache.GetModelResources("lazy"));
+  });
+  // Lookups of other tags are not blocked by the running factory.
+  MP_EXPECT_OK(cache.GetModelResources("eager"));
+  EXPECT_TRUE(cache.Exists("lazy"));
+
+  release_factory.Notify();
+  first_lookup.join();
+  second_lookup.join();
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(num_calls, 1);
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
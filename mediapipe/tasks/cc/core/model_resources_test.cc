@@ -163,6 +163,34 @@ TEST_F(ModelResourcesTest, CreateFromInvalidFile) {
       MediaPipeTasksStatus::kFileNotFoundError);
 }
 
+TEST_F(ModelResourcesTest, CreateAsyncFromFile) {
+  auto model_file = std::make_unique<proto::ExternalFile>();
+  model_file->set_file_name(kTestModelPath);
+  auto factory = ModelResources::CreateAsync(
+      kTestModelResourcesTag, std::move(model_file),
+      api2::PacketAdopting<tflite::OpResolver>(
+          absl::make_unique<tflite::ops::builtin::BuiltinOpResolver>()));
+  MP_ASSERT_OK_AND_ASSIGN(auto model_resources, factory());
+  EXPECT_EQ(kTestModelResourcesTag, model_resources->GetTag());
+  CheckModelResourcesPackets(model_resources.get());
+}
+
+TEST_F(ModelResourcesTest, CreateAsyncFromInvalidFile) {
+  auto model_file = std::make_unique<proto::ExternalFile>();
+  model_file->set_file_name(kInvalidTestModelPath);
+  auto factory = ModelResources::CreateAsync(
+      kTestModelResourcesTag, std::move(model_file),
+      api2::PacketAdopting<tflite::OpResolver>(
+          absl::make_unique<tflite::ops::builtin::BuiltinOpResolver>()));
+  auto status_or_model_resources = factory();
+
+  EXPECT_EQ(status_or_model_resources.status().code(),
+            absl::StatusCode::kNotFound);
+  AssertStatusHasMediaPipeTasksStatusCode(
+      status_or_model_resources.status(),
+      MediaPipeTasksStatus::kFileNotFoundError);
+}
+
 TEST_F(ModelResourcesTest, CreateFromInvalidFileDescriptor) {
   const int model_file_descriptor = open(kInvalidTestModelPath, O_RDONLY);
   auto model_file = std::make_unique<proto::ExternalFile>();
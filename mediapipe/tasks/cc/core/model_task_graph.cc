@@ -228,9 +228,10 @@ ModelTaskGraph::CreateModelAssetBundleResources(
   }
   const std::string tag = absl::StrCat(
       CreateModelAssetBundleResourcesTag(sc->OriginalNode()), tag_suffix);
-  MP_ASSIGN_OR_RETURN(
-      auto model_bundle_resources,
-      ModelAssetBundleResources::Create(tag, std::move(external_file)));
+  // The files of a bundle are read while its subtasks build their graphs.
+  MP_ASSIGN_OR_RETURN(auto model_bundle_resources,
+                      ModelAssetBundleResources::Create(
+                          tag, std::move(external_file), /*prefetch=*/true));
   MP_RETURN_IF_ERROR(
       model_resources_cache_service.GetObject().AddModelAssetBundleResources(
           std::move(model_bundle_resources)));
@@ -263,6 +264,52 @@ GenericNode& ModelTaskGraph::AddInference(
   return inference_subgraph;
 }
 
+absl::StatusOr<GenericNode*> ModelTaskGraph::AddLazyInference(
+    SubgraphContext* sc, std::unique_ptr<proto::ExternalFile> external_file,
+    const proto::Acceleration& acceleration, Graph& graph,
+    std::string tag_suffix, bool prefetch) {
+  auto model_resources_cache_service = sc->Service(kModelResourcesCacheService);
+  // The GPU and NNAPI delegates are only run by the InferenceCalculator, which
+  // gets its model resources when the graph starts.
+  const bool run_on_first_use = model_resources_cache_service.IsAvailable() &&
+                                !acceleration.has_gpu() &&
+                                !acceleration.has_nnapi();
+  auto& inference_node =
+      graph.AddNode(run_on_first_use
+                        ? "mediapipe.tasks.core.LazyInferenceCalculator"
+                        : "mediapipe.tasks.core.InferenceSubgraph");
+  auto& inference_opts = inference_node.GetOptions<InferenceSubgraphOptions>();
+  inference_opts.mutable_base_options()->mutable_acceleration()->CopyFrom(
+      acceleration);
+  if (!model_resources_cache_service.IsAvailable()) {
+    inference_opts.mutable_base_options()
+        ->mutable_model_asset()
+        ->Swap(external_file.get());
+    return &inference_node;
+  }
+  MP_ASSIGN_OR_RETURN(
+      auto op_resolver_packet,
+      model_resources_cache_service.GetObject().GetGraphOpResolverPacket());
+  const std::string tag =
+      absl::StrCat(CreateModelResourcesTag(sc->OriginalNode()), tag_suffix);
+  ModelResourcesCache::ModelResourcesFactory factory;
+  if (prefetch) {
+    factory = ModelResources::CreateAsync(tag, std::move(external_file),
+                                          op_resolver_packet);
+  } else {
+    factory = [tag, external_file = std::move(external_file),
+               op_resolver_packet]() mutable {
+      return ModelResources::Create(tag, std::move(external_file),
+                                    op_resolver_packet);
+    };
+  }
+  MP_RETURN_IF_ERROR(
+      model_resources_cache_service.GetObject().AddLazyModelResources(
+          tag, std::move(factory)));
+  inference_opts.set_model_resources_tag(tag);
+  return &inference_node;
+}
+
 }  // namespace core
 }  // namespace tasks
 }  // namespace mediapipe
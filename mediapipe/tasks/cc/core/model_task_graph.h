@@ -150,6 +150,26 @@ class ModelTaskGraph : public Subgraph {
       const proto::Acceleration& acceleration,
       api2::builder::Graph& graph) const;
 
+  // Like AddInference, but the model resources are not created during graph
+  // construction. Use this for models whose metadata is not needed to build
+  // the graph and which may never run, e.g. second-stage models behind a gate.
+  // If the model resources graph service is available, the model resources
+  // are registered lazily in it under a generated tag with the given
+  // tag_suffix, and for CPU inference a LazyInferenceCalculator creates them
+  // and the interpreter when the first input tensors arrive; with the GPU or
+  // NNAPI delegate they are created when the inference node is opened.
+  // Otherwise the ModelResourcesCalculator creates them from the external file
+  // in Open(). The returned node has the "TENSORS" input and output streams of
+  // AddInference, but no "METADATA_EXTRACTOR" output side packet.
+  // If `prefetch` is true and the service is available, the model file is
+  // loaded right away in the background, see ModelResources::CreateAsync, and
+  // only building the model is deferred. Use it for models that are expected
+  // to run, so that their files load in parallel with graph initialization.
+  absl::StatusOr<api2::builder::GenericNode*> AddLazyInference(
+      SubgraphContext* sc, std::unique_ptr<proto::ExternalFile> external_file,
+      const proto::Acceleration& acceleration, api2::builder::Graph& graph,
+      std::string tag_suffix = "", bool prefetch = false);
+
  private:
   std::vector<std::unique_ptr<ModelResources>> local_model_resources_;
 
@@ -0,0 +1,234 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/core/multi_stream_task_runner.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/thread_pool_executor.h"
+#include "mediapipe/tasks/cc/common.h"
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
+#include "mediapipe/tasks/cc/core/task_runner.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+
+#if !MEDIAPIPE_DISABLE_GPU
+#include "mediapipe/gpu/gpu_shared_data_internal.h"
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+// Creates the op resolver shared by the graphs of all streams, or returns an
+// empty packet if the options provide none.
+api2::Packet<tflite::OpResolver> CreateOpResolverPacket(
+    const MultiStreamTaskRunner::Options& options) {
+  if (!options.op_resolver_factory) {
+    return {};
+  }
+  std::unique_ptr<tflite::OpResolver> op_resolver =
+      options.op_resolver_factory();
+  if (op_resolver == nullptr) {
+    return {};
+  }
+  return api2::PacketAdopting<tflite::OpResolver>(std::move(op_resolver));
+}
+
+}  // namespace
+
+/* static */
+absl::StatusOr<std::unique_ptr<MultiStreamTaskRunner>>
+MultiStreamTaskRunner::Create(CalculatorGraphConfig config,
+                              MultiStreamPacketsCallback packets_callback,
+                              const Options& options,
+                              std::shared_ptr<Executor> default_executor,
+                              std::optional<PacketMap> input_side_packets) {
+  if (!packets_callback) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "The multi-stream task runner requires a packets callback.",
+        MediaPipeTasksStatus::kRunnerInitializationError);
+  }
+  if (options.max_streams <= 0) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("max_streams must be positive, got ",
+                     options.max_streams),
+        MediaPipeTasksStatus::kRunnerInitializationError);
+  }
+  if (!default_executor) {
+    if (options.num_threads <= 0) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("num_threads must be positive, got ",
+                       options.num_threads),
+          MediaPipeTasksStatus::kRunnerInitializationError);
+    }
+    default_executor =
+        std::make_shared<ThreadPoolExecutor>(options.num_threads);
+  }
+  return absl::WrapUnique(new MultiStreamTaskRunner(
+      std::move(config), std::move(packets_callback), options,
+      std::move(default_executor), std::move(input_side_packets)));
+}
+
+MultiStreamTaskRunner::MultiStreamTaskRunner(
+    CalculatorGraphConfig config, MultiStreamPacketsCallback packets_callback,
+    const Options& options, std::shared_ptr<Executor> default_executor,
+    std::optional<PacketMap> input_side_packets)
+    : config_(std::move(config)),
+      packets_callback_(std::move(packets_callback)),
+      options_(options),
+      default_executor_(std::move(default_executor)),
+      input_side_packets_(std::move(input_side_packets)),
+      inference_runner_pool_(std::make_shared<InferenceRunnerPool>(
+          options.inference_runner_pool_options)),
+      op_resolver_packet_(CreateOpResolverPacket(options)) {}
+
+MultiStreamTaskRunner::~MultiStreamTaskRunner() {
+  absl::Status status = Close();
+  if (!status.ok()) {
+    ABSL_LOG(ERROR) << "Failed to close the multi-stream task runner: "
+                    << status;
+  }
+}
+
+absl::Status MultiStreamTaskRunner::AddStream(const std::string& stream_id) {
+  auto check_can_add = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    if (streams_.contains(stream_id)) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kAlreadyExists,
+          absl::StrCat("Stream is already open: ", stream_id),
+          MediaPipeTasksStatus::kRunnerInitializationError);
+    }
+    if (streams_.size() >= static_cast<size_t>(options_.max_streams)) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kResourceExhausted,
+          absl::StrCat("Cannot open more than ", options_.max_streams,
+                       " streams."),
+          MediaPipeTasksStatus::kRunnerInitializationError);
+    }
+    return absl::OkStatus();
+  };
+  {
+    absl::MutexLock lock(&mutex_);
+    MP_RETURN_IF_ERROR(check_can_add());
+  }
+
+  // Starting a graph may take a while, so other streams are not blocked on
+  // it.
+  std::shared_ptr<TaskRunner> runner(new TaskRunner(
+      [callback = packets_callback_,
+       stream_id](absl::StatusOr<PacketMap> status_or_packets) {
+        callback(stream_id, std::move(status_or_packets));
+      }));
+  MP_RETURN_IF_ERROR(AddPayload(
+      runner->graph_.SetServiceObject(kInferenceRunnerPoolService,
+                                      inference_runner_pool_),
+      "InferenceRunnerPoolService is not set up successfully.",
+      MediaPipeTasksStatus::kRunnerInitializationError));
+  MP_RETURN_IF_ERROR(runner->Initialize(
+      config_, op_resolver_packet_, default_executor_, input_side_packets_));
+#if !MEDIAPIPE_DISABLE_GPU
+  if (options_.gpu_resources) {
+    MP_RETURN_IF_ERROR(runner->graph_.SetGpuResources(options_.gpu_resources));
+  }
+#endif  // !MEDIAPIPE_DISABLE_GPU
+  MP_RETURN_IF_ERROR(runner->Start());
+
+  absl::Status status;
+  {
+    absl::MutexLock lock(&mutex_);
+    status = check_can_add();
+    if (status.ok()) streams_[stream_id] = runner;
+  }
+  if (!status.ok()) {
+    // Another call opened the stream, or the last free slot, meanwhile.
+    runner->Close().IgnoreError();
+  }
+  return status;
+}
+
+absl::StatusOr<std::shared_ptr<TaskRunner>> MultiStreamTaskRunner::GetStream(
+    const std::string& stream_id) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = streams_.find(stream_id);
+  if (it == streams_.end()) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        absl::StrCat("Stream is not open: ", stream_id),
+        MediaPipeTasksStatus::kRunnerNotStartedError);
+  }
+  return it->second;
+}
+
+absl::Status MultiStreamTaskRunner::Send(const std::string& stream_id,
+                                         PacketMap inputs) {
+  MP_ASSIGN_OR_RETURN(auto runner, GetStream(stream_id));
+  return runner->Send(std::move(inputs));
+}
+
+absl::Status MultiStreamTaskRunner::CloseStream(const std::string& stream_id) {
+  std::shared_ptr<TaskRunner> runner;
+  {
+    absl::MutexLock lock(&mutex_);
+    auto it = streams_.find(stream_id);
+    if (it == streams_.end()) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          absl::StrCat("Stream is not open: ", stream_id),
+          MediaPipeTasksStatus::kRunnerNotStartedError);
+    }
+    runner = std::move(it->second);
+    streams_.erase(it);
+  }
+  return runner->Close();
+}
+
+absl::Status MultiStreamTaskRunner::Close() {
+  absl::flat_hash_map<std::string, std::shared_ptr<TaskRunner>> streams;
+  {
+    absl::MutexLock lock(&mutex_);
+    streams.swap(streams_);
+  }
+  absl::Status status;
+  for (auto& [stream_id, runner] : streams) {
+    status.Update(runner->Close());
+  }
+  return status;
+}
+
+int MultiStreamTaskRunner::NumStreams() const {
+  absl::MutexLock lock(&mutex_);
+  return streams_.size();
+}
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
@@ -0,0 +1,156 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_TASKS_CC_CORE_MULTI_STREAM_TASK_RUNNER_H_
+#define MEDIAPIPE_TASKS_CC_CORE_MULTI_STREAM_TASK_RUNNER_H_
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/api2/packet.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/tasks/cc/core/inference_runner_pool.h"
+#include "mediapipe/tasks/cc/core/task_runner.h"
+#include "tensorflow/lite/core/api/op_resolver.h"
+
+namespace mediapipe {
+
+#if !MEDIAPIPE_DISABLE_GPU
+class GpuResources;
+#endif  // !MEDIAPIPE_DISABLE_GPU
+
+namespace tasks {
+namespace core {
+
+// A callback method to get the output packets of a stream from the multi-stream
+// task runner.
+using MultiStreamPacketsCallback = std::function<void(
+    const std::string& stream_id, absl::StatusOr<PacketMap>)>;
+
+// Runs one task graph config in live stream mode for several input streams,
+// such as the cameras of a multi-camera app.
+//
+// Each stream gets its own TaskRunner, so that the stateful calculators of the
+// task (e.g. trackers and previous-result loopbacks) see a single monotonic
+// timestamp sequence per stream, and the timestamps of different streams are
+// independent. The runners share the costly parts of a graph instead:
+//   - one default executor, so that the thread count does not grow with the
+//     number of streams;
+//   - one InferenceRunnerPool, so that the inference calls of all streams run
+//     on the same TfLite interpreters of each model;
+//   - optionally one GpuResources object.
+// The output packets of each stream are routed to the
+// MultiStreamPacketsCallback together with the id of the stream.
+//
+// AddStream, Send, CloseStream and Close are thread-safe. Send calls for the
+// same stream must still be serialized by the caller.
+class MultiStreamTaskRunner {
+ public:
+  struct Options {
+    // The number of threads of the default executor shared by all streams.
+    // Ignored if a default executor is provided to Create.
+    int num_threads = 4;
+
+    // The maximum number of streams open at the same time.
+    int max_streams = 16;
+
+    // The options of the InferenceRunnerPool shared by all streams.
+    InferenceRunnerPool::Options inference_runner_pool_options;
+
+    // Creates the op resolver shared by the graphs of all streams. It is
+    // called once, so that the streams share the TfLite interpreters of each
+    // model, see InferenceRunnerPool::GetRunnerKey. If not set, the default
+    // op resolver of the ModelResourcesCache is used.
+    std::function<std::unique_ptr<tflite::OpResolver>()> op_resolver_factory;
+
+#if !MEDIAPIPE_DISABLE_GPU
+    // The GpuResources shared by all streams. If not set, each stream's graph
+    // creates its own GpuResources when needed.
+    std::shared_ptr<::mediapipe::GpuResources> gpu_resources;
+#endif  // !MEDIAPIPE_DISABLE_GPU
+  };
+
+  // Creates the multi-stream task runner with a CalculatorGraphConfig proto.
+  // No stream is open until AddStream is called.
+  static absl::StatusOr<std::unique_ptr<MultiStreamTaskRunner>> Create(
+      CalculatorGraphConfig config, MultiStreamPacketsCallback packets_callback,
+      const Options& options,
+      std::shared_ptr<Executor> default_executor = nullptr,
+      std::optional<PacketMap> input_side_packets = std::nullopt);
+
+  // MultiStreamTaskRunner is neither copyable nor movable.
+  MultiStreamTaskRunner(const MultiStreamTaskRunner&) = delete;
+  MultiStreamTaskRunner& operator=(const MultiStreamTaskRunner&) = delete;
+
+  ~MultiStreamTaskRunner();
+
+  // Starts a graph for a new stream with the given id.
+  absl::Status AddStream(const std::string& stream_id);
+
+  // Sends the input packets of a stream, see TaskRunner::Send. The input
+  // packet timestamps must be monotonically increasing within the stream.
+  absl::Status Send(const std::string& stream_id, PacketMap inputs);
+
+  // Closes the graph of a stream after it has processed the sent packets.
+  absl::Status CloseStream(const std::string& stream_id);
+
+  // Closes the graphs of all open streams.
+  absl::Status Close();
+
+  // Returns the number of open streams.
+  int NumStreams() const;
+
+  // Returns the InferenceRunnerPool shared by all streams.
+  InferenceRunnerPool& inference_runner_pool() const {
+    return *inference_runner_pool_;
+  }
+
+ private:
+  MultiStreamTaskRunner(CalculatorGraphConfig config,
+                        MultiStreamPacketsCallback packets_callback,
+                        const Options& options,
+                        std::shared_ptr<Executor> default_executor,
+                        std::optional<PacketMap> input_side_packets);
+
+  // Returns the runner of an open stream.
+  absl::StatusOr<std::shared_ptr<TaskRunner>> GetStream(
+      const std::string& stream_id) const;
+
+  const CalculatorGraphConfig config_;
+  const MultiStreamPacketsCallback packets_callback_;
+  const Options options_;
+  const std::shared_ptr<Executor> default_executor_;
+  const std::optional<PacketMap> input_side_packets_;
+  const std::shared_ptr<InferenceRunnerPool> inference_runner_pool_;
+  const api2::Packet<tflite::OpResolver> op_resolver_packet_;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::shared_ptr<TaskRunner>> streams_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_TASKS_CC_CORE_MULTI_STREAM_TASK_RUNNER_H_
@@ -0,0 +1,176 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/core/multi_stream_task_runner.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "tensorflow/lite/mutable_op_resolver.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace core {
+namespace {
+
+using ::testing::ElementsAre;
+
+CalculatorGraphConfig GetPassThroughGraphConfig() {
+  return ParseTextProtoOrDie<CalculatorGraphConfig>(
+      R"pb(
+        input_stream: "in"
+        output_stream: "out"
+        node {
+          calculator: "PassThroughCalculator"
+          input_stream: "in"
+          output_stream: "out"
+        })pb");
+}
+
+// Collects the output values of each stream.
+class OutputCollector {
+ public:
+  MultiStreamPacketsCallback Callback() {
+    return [this](const std::string& stream_id,
+                  absl::StatusOr<PacketMap> status_or_packets) {
+      ASSERT_TRUE(status_or_packets.ok());
+      absl::MutexLock lock(&mutex_);
+      outputs_[stream_id].push_back(
+          status_or_packets.value()["out"].Get<int>());
+    };
+  }
+
+  std::vector<int> Outputs(const std::string& stream_id) {
+    absl::MutexLock lock(&mutex_);
+    return outputs_[stream_id];
+  }
+
+ private:
+  absl::Mutex mutex_;
+  absl::flat_hash_map<std::string, std::vector<int>> outputs_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+TEST(MultiStreamTaskRunnerTest, RoutesOutputsPerStream) {
+  OutputCollector collector;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      MultiStreamTaskRunner::Create(GetPassThroughGraphConfig(),
+                                    collector.Callback(), {}));
+  MP_ASSERT_OK(runner->AddStream("front"));
+  MP_ASSERT_OK(runner->AddStream("back"));
+  EXPECT_EQ(runner->NumStreams(), 2);
+
+  // The timestamps of different streams are independent.
+  for (int i = 0; i < 3; ++i) {
+    MP_ASSERT_OK(
+        runner->Send("front", {{"in", MakePacket<int>(i).At(Timestamp(i))}}));
+    MP_ASSERT_OK(runner->Send(
+        "back", {{"in", MakePacket<int>(100 + i).At(Timestamp(i))}}));
+  }
+  MP_ASSERT_OK(runner->Close());
+  EXPECT_EQ(runner->NumStreams(), 0);
+
+  EXPECT_THAT(collector.Outputs("front"), ElementsAre(0, 1, 2));
+  EXPECT_THAT(collector.Outputs("back"), ElementsAre(100, 101, 102));
+}
+
+TEST(MultiStreamTaskRunnerTest, RequiresMonotonicTimestampsPerStream) {
+  OutputCollector collector;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      MultiStreamTaskRunner::Create(GetPassThroughGraphConfig(),
+                                    collector.Callback(), {}));
+  MP_ASSERT_OK(runner->AddStream("front"));
+  MP_ASSERT_OK(
+      runner->Send("front", {{"in", MakePacket<int>(1).At(Timestamp(1))}}));
+  EXPECT_THAT(
+      runner->Send("front", {{"in", MakePacket<int>(0).At(Timestamp(0))}}),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               testing::HasSubstr("monotonically increasing")));
+  MP_ASSERT_OK(runner->Close());
+}
+
+TEST(MultiStreamTaskRunnerTest, AddsAndClosesStreams) {
+  OutputCollector collector;
+  MultiStreamTaskRunner::Options options;
+  options.max_streams = 1;
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      MultiStreamTaskRunner::Create(GetPassThroughGraphConfig(),
+                                    collector.Callback(), options));
+  MP_ASSERT_OK(runner->AddStream("front"));
+  EXPECT_THAT(runner->AddStream("front"),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  EXPECT_THAT(runner->AddStream("back"),
+              StatusIs(absl::StatusCode::kResourceExhausted));
+
+  MP_ASSERT_OK(runner->CloseStream("front"));
+  EXPECT_THAT(
+      runner->Send("front", {{"in", MakePacket<int>(0).At(Timestamp(0))}}),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               testing::HasSubstr("not open")));
+  EXPECT_THAT(runner->CloseStream("front"),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+
+  // A stream can be reopened with a new timestamp sequence.
+  MP_ASSERT_OK(runner->AddStream("back"));
+  MP_ASSERT_OK(
+      runner->Send("back", {{"in", MakePacket<int>(7).At(Timestamp(0))}}));
+  MP_ASSERT_OK(runner->CloseStream("back"));
+  EXPECT_THAT(collector.Outputs("back"), ElementsAre(7));
+}
+
+TEST(MultiStreamTaskRunnerTest, SharesOpResolverAmongStreams) {
+  OutputCollector collector;
+  MultiStreamTaskRunner::Options options;
+  int num_op_resolvers = 0;
+  options.op_resolver_factory = [&num_op_resolvers]() {
+    ++num_op_resolvers;
+    return std::make_unique<tflite::MutableOpResolver>();
+  };
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto runner,
+      MultiStreamTaskRunner::Create(GetPassThroughGraphConfig(),
+                                    collector.Callback(), options));
+  MP_ASSERT_OK(runner->AddStream("front"));
+  MP_ASSERT_OK(runner->AddStream("back"));
+  MP_ASSERT_OK(runner->CloseStream("back"));
+  MP_ASSERT_OK(runner->AddStream("back"));
+  // The streams share interpreters only if they use the same op resolver.
+  EXPECT_EQ(num_op_resolvers, 1);
+  MP_ASSERT_OK(runner->Close());
+}
+
+TEST(MultiStreamTaskRunnerTest, RequiresPacketsCallback) {
+  EXPECT_THAT(MultiStreamTaskRunner::Create(GetPassThroughGraphConfig(),
+                                            nullptr, {}),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace tasks
+}  // namespace mediapipe
@@ -29,6 +29,7 @@ limitations under the License.
 #include "mediapipe/framework/executor.h"
 #include "mediapipe/framework/port/requires.h"
 #include "mediapipe/framework/port/status_macros.h"
+#include "mediapipe/framework/shared_executor_registry.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/core/base_task_api.h"
 #include "mediapipe/tasks/cc/core/proto/base_options.pb.h"
@@ -60,6 +61,7 @@ class TaskApiFactory {
       std::optional<PacketMap> input_side_packets = std::nullopt,
       std::optional<ErrorFn> error_fn = std::nullopt) {
     bool found_task_subgraph = false;
+    bool enable_profiler = false;
     // This for-loop ensures there's only one subgraph besides
     // FlowLimiterCalculator.
     for (const auto& node : graph_config.node()) {
@@ -74,8 +76,19 @@ class TaskApiFactory {
       } else {
         MP_RETURN_IF_ERROR(CheckHasValidOptions<Options>(node));
         found_task_subgraph = true;
+        std::optional<proto::BaseOptions> base_options =
+            GetBaseOptions<Options>(node);
+        if (base_options.has_value()) {
+          if (!default_executor) {
+            default_executor = GetSharedExecutor(*base_options);
+          }
+          enable_profiler = base_options->enable_profiler();
+        }
       }
     }
+    if (enable_profiler) {
+      graph_config.mutable_profiler_config()->set_enable_profiler(true);
+    }
     MP_ASSIGN_OR_RETURN(
         auto runner,
 #if !MEDIAPIPE_DISABLE_GPU
@@ -93,6 +106,54 @@ class TaskApiFactory {
     return std::make_unique<T>(std::move(runner));
   }
 
+  // Returns the base options of the task subgraph node, if its options have
+  // any.
+  template <typename Options>
+  static std::optional<proto::BaseOptions> GetBaseOptions(
+      const CalculatorGraphConfig::Node& node) {
+    Options options;
+    if constexpr (mediapipe::Requires<Options>(
+                      [](auto&& o) -> decltype(o.ext) {})) {
+      if (!node.options().HasExtension(Options::ext)) return std::nullopt;
+      options = node.options().GetExtension(Options::ext);
+    } else {
+#ifndef MEDIAPIPE_PROTO_LITE
+      bool found_options = false;
+      for (const auto& option : node.node_options()) {
+        if (absl::StrContains(option.type_url(),
+                              Options::descriptor()->full_name())) {
+          found_options = option.UnpackTo(&options);
+          break;
+        }
+      }
+      if (!found_options) return std::nullopt;
+#else   // MEDIAPIPE_PROTO_LITE
+      return std::nullopt;
+#endif  // MEDIAPIPE_PROTO_LITE
+    }
+    if constexpr (mediapipe::Requires<Options>(
+                      [](auto&& o) -> decltype(o.base_options()) {})) {
+      return options.base_options();
+    }
+    return std::nullopt;
+  }
+
+  // Applies the threading options in `base_options`, and returns the shared
+  // executor they name, if any.
+  static std::shared_ptr<Executor> GetSharedExecutor(
+      const proto::BaseOptions& base_options) {
+    SharedExecutorRegistry& registry = SharedExecutorRegistry::Get();
+    if (base_options.process_thread_budget() > 0) {
+      registry.SetThreadBudget(base_options.process_thread_budget());
+    }
+    if (base_options.has_shared_executor_name()) {
+      return registry.GetOrCreateExecutor(
+          base_options.shared_executor_name(),
+          base_options.shared_executor_num_threads());
+    }
+    return nullptr;
+  }
+
   template <typename Options>
   static absl::Status CheckHasValidOptions(
       const CalculatorGraphConfig::Node& node) {
@@ -32,6 +32,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/api2/packet.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/executor.h"
@@ -113,10 +114,15 @@ absl::StatusOr<std::unique_ptr<TaskRunner>> TaskRunner::Create(
     std::optional<ErrorFn> error_fn, bool disable_default_service) {
 #endif  // !MEDIAPIPE_DISABLE_GPU
   auto task_runner = absl::WrapUnique(new TaskRunner(packets_callback));
+  api2::Packet<tflite::OpResolver> op_resolver_packet;
+  if (op_resolver) {
+    op_resolver_packet =
+        api2::PacketAdopting<tflite::OpResolver>(std::move(op_resolver));
+  }
   MP_RETURN_IF_ERROR(task_runner->Initialize(
-      std::move(config), std::move(op_resolver), std::move(default_executor),
-      std::move(input_side_packets), std::move(error_fn),
-      disable_default_service));
+      std::move(config), std::move(op_resolver_packet),
+      std::move(default_executor), std::move(input_side_packets),
+      std::move(error_fn), disable_default_service));
 
 #if !MEDIAPIPE_DISABLE_GPU
   if (resources) {
@@ -131,7 +137,7 @@ absl::StatusOr<std::unique_ptr<TaskRunner>> TaskRunner::Create(
 
 absl::Status TaskRunner::Initialize(
     CalculatorGraphConfig config,
-    std::unique_ptr<tflite::OpResolver> op_resolver,
+    api2::Packet<tflite::OpResolver> op_resolver_packet,
     std::shared_ptr<Executor> default_executor,
     std::optional<PacketMap> input_side_packets,
     std::optional<ErrorFn> error_fn, bool disable_default_service) {
@@ -193,7 +199,7 @@ absl::Status TaskRunner::Initialize(
     MP_RETURN_IF_ERROR(graph_.DisallowServiceDefaultInitialization());
   }
   auto model_resources_cache =
-      std::make_shared<ModelResourcesCache>(std::move(op_resolver));
+      std::make_shared<ModelResourcesCache>(std::move(op_resolver_packet));
   MP_RETURN_IF_ERROR(
       AddPayload(graph_.SetServiceObject(kModelResourcesCacheService,
                                          model_resources_cache),
@@ -364,6 +370,13 @@ absl::Status TaskRunner::Restart() {
   return Start();
 }
 
+absl::StatusOr<std::vector<CalculatorProfile>>
+TaskRunner::GetCalculatorProfiles() {
+  std::vector<CalculatorProfile> profiles;
+  MP_RETURN_IF_ERROR(graph_.profiler()->GetCalculatorProfiles(&profiles));
+  return profiles;
+}
+
 }  // namespace core
 }  // namespace tasks
 }  // namespace mediapipe
@@ -32,8 +32,10 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/api2/packet.h"
 #include "mediapipe/framework/calculator.pb.h"
 #include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_profile.pb.h"
 #include "mediapipe/framework/executor.h"
 #include "tensorflow/lite/core/api/op_resolver.h"
 
@@ -134,7 +136,14 @@ class TaskRunner {
   // Returns the canonicalized CalculatorGraphConfig of the underlying graph.
   const CalculatorGraphConfig& GetGraphConfig() { return graph_.Config(); }
 
+  // Returns the runtime profile of each calculator of the underlying graph.
+  // The profiles are empty unless the graph config enables the profiler.
+  absl::StatusOr<std::vector<CalculatorProfile>> GetCalculatorProfiles();
+
  private:
+  // Creates and starts the runners of the streams.
+  friend class MultiStreamTaskRunner;
+
   // Constructor.
   // Creates a TaskRunner instance with an optional PacketsCallback method.
   explicit TaskRunner(PacketsCallback packets_callback = nullptr)
@@ -143,10 +152,12 @@ class TaskRunner {
   // Initializes the task runner. Returns an ok status to indicate that the
   // runner is ready to start. Otherwise, returns an error status to indicate
   // that the runner isn't initialized successfully. A task runner should
-  // be only initialized once.
+  // be only initialized once. If `op_resolver_packet` is not empty, it is the
+  // global op resolver for all models running within this task, and may be
+  // shared with other task runners.
   absl::Status Initialize(
       CalculatorGraphConfig config,
-      std::unique_ptr<tflite::OpResolver> op_resolver = nullptr,
+      api2::Packet<tflite::OpResolver> op_resolver_packet = {},
       std::shared_ptr<Executor> default_executor = nullptr,
       std::optional<PacketMap> input_side_packets = std::nullopt,
       std::optional<ErrorFn> error_fn = std::nullopt,
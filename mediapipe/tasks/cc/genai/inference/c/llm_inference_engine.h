@@ -101,6 +101,12 @@ typedef struct {
   // initialization may finish before weights have finished uploading which
   // might push some of the weight upload time into input processing.
   bool wait_for_weight_uploads;
+
+  // Memory budget in bytes for copies of the KV caches of prefilled prompts,
+  // which let later sessions skip prefilling a prompt prefix they share, e.g.
+  // a system prompt. Used by CPU only. Setting this value to 0 disables the
+  // cache.
+  size_t prompt_cache_size_bytes;
 } LlmModelSettings;
 
 // LlmSessionConfig configures how to execute the model.
@@ -14,26 +14,31 @@
 
 #include <pthread.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/port/file_helpers.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/llm_params.pb.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/transformer_params.pb.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/incremental_detokenizer.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/memory_mapped_file.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/metadata_utils.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/model_data.h"
@@ -50,6 +55,19 @@ namespace {
 
 constexpr int kCheckLastKChars = 10;
 
+// Minimum number of new tokens for a prefilled prompt to be cached.
+constexpr size_t kMinCachedPromptTokens = 64;
+
+using ::mediapipe::tasks::genai::xnn_utils::Llm;
+
+struct LlmInferenceEngineCpu_Session;
+
+// All sessions of an engine share one Llm, which can only run one context at
+// a time. A single scheduler thread therefore owns the Llm: sessions that
+// start predicting join the schedule, every round runs one decode step for
+// each active session on its own context (KV cache), and finished sessions
+// leave between rounds. Concurrent chats are interleaved token by token
+// instead of racing on the shared model state.
 struct LlmInferenceEngineCpu_Engine {
   sentencepiece::SentencePieceProcessor* tokenizer;
   sentencepiece::normalizer::Normalizer* normalizer;
@@ -57,7 +75,40 @@ struct LlmInferenceEngineCpu_Engine {
   int start_token_id;
   std::vector<std::string> stop_tokens;
   size_t max_num_tokens;
+  // Whether token pieces are spelled in the byte-to-unicode alphabet of BPE
+  // models.
+  bool bytes_to_unicode_mapping = false;
+
+  // Held by the scheduler while it runs the Llm, and by Session_Clone while it
+  // reads a context.
+  absl::Mutex llm_mutex;
+  // Copies of the contexts of recently prefilled prompts, oldest first. A
+  // session starts from the one sharing the longest prefix with its prompt,
+  // so that e.g. a system prompt shared by many sessions is prefilled once.
+  // Their KV caches take at most prompt_cache_size_bytes in total. Guarded by
+  // llm_mutex.
+  std::deque<std::unique_ptr<const Llm::Context>> cached_prompts;
+  size_t cached_prompts_bytes = 0;
+  size_t prompt_cache_size_bytes = 0;
+  absl::Mutex mutex;
+  // Sessions waiting to join the schedule.
+  std::deque<LlmInferenceEngineCpu_Session*> pending_sessions
+      ABSL_GUARDED_BY(mutex);
+  bool shutting_down ABSL_GUARDED_BY(mutex) = false;
+  pthread_t scheduler_id = 0;
+
+  bool HasWork() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+    return shutting_down || !pending_sessions.empty();
+  }
+
   ~LlmInferenceEngineCpu_Engine() {
+    if (scheduler_id != 0) {
+      {
+        absl::MutexLock lock(&mutex);
+        shutting_down = true;
+      }
+      pthread_join(scheduler_id, nullptr);
+    }
     delete tokenizer;
     if (normalizer != nullptr) {
       delete normalizer;
@@ -67,99 +118,242 @@ struct LlmInferenceEngineCpu_Engine {
 };
 
 struct LlmInferenceEngineCpu_Session {
-  const LlmInferenceEngineCpu_Engine* engine;
+  LlmInferenceEngineCpu_Engine* engine;
+  std::shared_ptr<mediapipe::tasks::genai::xnn_utils::Llm::Context> context;
   std::string prompt;
   int max_num_output_tokens;
   int response_count;
   std::string last_10_char;
   std::string final_output;
+  mediapipe::tasks::genai::llm_utils::IncrementalDetokenizer detokenizer;
   std::function<void(std::string)> cpu_callback;
   bool early_stop;
-  pthread_t work_id;
-  ~LlmInferenceEngineCpu_Session() { pthread_join(work_id, nullptr); };
+  // Set while the session is scheduled, guarded by engine->mutex.
+  bool in_flight = false;
+  ~LlmInferenceEngineCpu_Session() { WaitUntilDone(); };
+
+  void WaitUntilDone() {
+    absl::MutexLock lock(&engine->mutex);
+    engine->mutex.Await(absl::Condition(
+        +[](bool* scheduled) { return !*scheduled; }, &in_flight));
+  }
 };
 
-void* next_token_function(void* args) {
-  struct LlmInferenceEngineCpu_Session* cpu_session =
-      (struct LlmInferenceEngineCpu_Session*)args;
-  if (cpu_session->response_count++ < cpu_session->max_num_output_tokens) {
-    if (cpu_session->early_stop) {
-      return nullptr;
-    }
-
-    auto token_ids_per_step = std::vector<int>();
-    auto status = cpu_session->engine->llm->GetNextToken(&token_ids_per_step);
-    if (!status.ok()) {
-      ABSL_LOG(FATAL) << "Failed to generate output: " << status;
-    }
+// Appends a generated token to the session's output. Returns true once the
+// session has produced its last token.
+bool process_token(LlmInferenceEngineCpu_Session* cpu_session, int token_id) {
+  if (++cpu_session->response_count == cpu_session->max_num_output_tokens) {
+    cpu_session->early_stop = true;
+  }
 
-    // For future multithreading support.
-    if (cpu_session->early_stop) {
-      return nullptr;
-    }
+  // Only the new token is detokenized; bytes of a character that is split
+  // across tokens wait for the rest of it.
+  const auto* tokenizer = cpu_session->engine->tokenizer;
+  std::string token = cpu_session->detokenizer.Append(
+      tokenizer->IdToPiece(token_id), tokenizer->IsByte(token_id));
+  if (cpu_session->early_stop) {
+    token.append(cpu_session->detokenizer.Flush());
+  }
+  if (cpu_session->engine->normalizer != nullptr) {
+    token = cpu_session->engine->normalizer->Normalize(token);
+  }
+  cpu_session->last_10_char.append(token);
 
-    if (cpu_session->response_count == cpu_session->max_num_output_tokens) {
+  int stop_index;
+  for (const auto& stop_token : cpu_session->engine->stop_tokens) {
+    stop_index = cpu_session->last_10_char.find(stop_token);
+    if (stop_index != std::string::npos) {
       cpu_session->early_stop = true;
+      cpu_session->last_10_char =
+          cpu_session->last_10_char.substr(0, stop_index);
+      break;
     }
+  }
 
-    std::string token =
-        cpu_session->engine->tokenizer->IdToPiece(token_ids_per_step[0]);
-    if (cpu_session->engine->normalizer != nullptr) {
-      token = cpu_session->engine->normalizer->Normalize(token);
-    }
-    cpu_session->last_10_char.append(token);
-
-    int stop_index;
-    for (const auto& stop_token : cpu_session->engine->stop_tokens) {
-      stop_index = cpu_session->last_10_char.find(stop_token);
-      if (stop_index != std::string::npos) {
-        cpu_session->early_stop = true;
-        cpu_session->last_10_char =
-            cpu_session->last_10_char.substr(0, stop_index);
-        break;
-      }
-    }
+  std::string ready_char = "";
+  if (cpu_session->early_stop) {
+    ready_char = cpu_session->last_10_char;
+  } else if (cpu_session->last_10_char.size() > kCheckLastKChars) {
+    // Never split a UTF-8 character between the emitted text and the tail
+    // kept for stop token matching.
+    const size_t ready_size =
+        mediapipe::tasks::genai::llm_utils::Utf8CompletePrefixLength(
+            absl::string_view(cpu_session->last_10_char)
+                .substr(0, cpu_session->last_10_char.size() -
+                               kCheckLastKChars));
+    ready_char = cpu_session->last_10_char.substr(0, ready_size);
+    cpu_session->last_10_char = cpu_session->last_10_char.substr(ready_size);
+  }
+  cpu_session->final_output.append(ready_char);
 
-    std::string ready_char = "";
-    if (cpu_session->early_stop) {
-      ready_char = cpu_session->last_10_char;
-    } else if (cpu_session->last_10_char.size() > kCheckLastKChars) {
-      ready_char = cpu_session->last_10_char.substr(
-          0, cpu_session->last_10_char.size() - kCheckLastKChars);
-      cpu_session->last_10_char = cpu_session->last_10_char.substr(
-          cpu_session->last_10_char.size() - kCheckLastKChars);
-    }
-    cpu_session->final_output.append(ready_char);
+  cpu_session->cpu_callback(ready_char);
 
-    cpu_session->cpu_callback(ready_char);
+  return cpu_session->early_stop;
+}
 
-    next_token_function(args);
+// Runs one decode step for the session whose context is loaded. With
+// speculative decoding a step can produce several tokens. Returns true once
+// the session has produced its last token.
+bool next_token_function(LlmInferenceEngineCpu_Session* cpu_session) {
+  if (cpu_session->response_count >= cpu_session->max_num_output_tokens ||
+      cpu_session->early_stop) {
+    return true;
   }
-  return nullptr;
+
+  auto token_ids_per_step = std::vector<int>();
+  auto status = cpu_session->engine->llm->GetNextTokens(&token_ids_per_step);
+  if (!status.ok()) {
+    ABSL_LOG(FATAL) << "Failed to generate output: " << status;
+  }
+
+  for (int token_id : token_ids_per_step) {
+    if (process_token(cpu_session, token_id)) return true;
+  }
+  return false;
 };
 
-void* start_llm_function(void* args) {
-  struct LlmInferenceEngineCpu_Session* cpu_session =
-      (struct LlmInferenceEngineCpu_Session*)args;
+// Returns the number of leading tokens `prev_ids` and `ids` have in common.
+size_t CommonPrefixLength(const std::vector<int>& prev_ids,
+                          const std::vector<int>& ids) {
+  return std::mismatch(prev_ids.begin(),
+                       prev_ids.begin() + std::min(prev_ids.size(), ids.size()),
+                       ids.begin())
+             .first -
+         prev_ids.begin();
+}
+
+// Returns the memory taken by the KV cache of `context`.
+size_t ContextBytes(const Llm::Context& context) {
+  size_t bytes = 0;
+  for (const auto& kv : context.kv_cache) {
+    for (const auto* cache : {kv.k_cache.get(), kv.v_cache.get()}) {
+      if (cache != nullptr) {
+        bytes += cache->ElementSize(cache->num_elements);
+      }
+    }
+  }
+  return bytes;
+}
 
+// Prefills the session's context with the prompt. Requires engine->llm_mutex.
+void start_llm_function(LlmInferenceEngineCpu_Session* cpu_session) {
+  auto* engine = cpu_session->engine;
   std::vector<int> prompt_ids = {};
 
-  auto status =
-      cpu_session->engine->tokenizer->Encode(cpu_session->prompt, &prompt_ids);
+  auto status = engine->tokenizer->Encode(cpu_session->prompt, &prompt_ids);
 
   if (!status.ok()) {
     ABSL_LOG(FATAL) << "Failed to encode input: " << status;
   }
-  prompt_ids.insert(prompt_ids.begin(), cpu_session->engine->start_token_id);
+  prompt_ids.insert(prompt_ids.begin(), engine->start_token_id);
+
+  // Keys and values of a position only depend on the tokens up to it, so the
+  // part of the cache that matches the start of the new prompt, e.g. a shared
+  // system prompt or the history of a cloned session, is kept.
+  size_t num_reused =
+      CommonPrefixLength(cpu_session->context->batch_prev_ids[0], prompt_ids);
+  const Llm::Context* best_cached_prompt = nullptr;
+  for (const auto& cached_prompt : engine->cached_prompts) {
+    const size_t num_cached =
+        CommonPrefixLength(cached_prompt->batch_prev_ids[0], prompt_ids);
+    if (num_cached > num_reused) {
+      num_reused = num_cached;
+      best_cached_prompt = cached_prompt.get();
+    }
+  }
+  const size_t num_shared = num_reused;
+  if (best_cached_prompt != nullptr) {
+    auto context = engine->llm->CloneContext(*best_cached_prompt);
+    ABSL_CHECK_OK(context);
+    cpu_session->context = std::make_shared<Llm::Context>(*std::move(context));
+  }
+  // At least one token is run to produce logits.
+  num_reused = std::min(num_reused, prompt_ids.size() - 1);
 
-  ABSL_CHECK_OK(cpu_session->engine->llm->SeekTimeStep(0));
-  ABSL_CHECK_OK(cpu_session->engine->llm->AddInputTokens({prompt_ids}));
+  ABSL_CHECK_OK(engine->llm->LoadContext(cpu_session->context));
+  ABSL_CHECK_OK(engine->llm->SeekTimeStep(num_reused));
+  ABSL_CHECK_OK(engine->llm->AddInputTokens(
+      {std::vector<int>(prompt_ids.begin() + num_reused, prompt_ids.end())}));
 
   cpu_session->max_num_output_tokens =
-      cpu_session->engine->max_num_tokens - prompt_ids.size();
+      engine->max_num_tokens - prompt_ids.size();
+
+  // A clone has a KV cache of the same size.
+  const size_t context_bytes = ContextBytes(*cpu_session->context);
+  if (prompt_ids.size() >= num_shared + kMinCachedPromptTokens &&
+      context_bytes <= engine->prompt_cache_size_bytes) {
+    auto context = engine->llm->CloneContext(*cpu_session->context);
+    if (!context.ok()) {
+      ABSL_LOG(WARNING) << "Failed to cache prompt: " << context.status();
+      return;
+    }
+    // Drop the cached prompts that are prefixes of this one, then the oldest
+    // ones until the new one fits.
+    auto& cached_prompts = engine->cached_prompts;
+    for (auto it = cached_prompts.begin(); it != cached_prompts.end();) {
+      const auto& cached_ids = (*it)->batch_prev_ids[0];
+      if (CommonPrefixLength(cached_ids, prompt_ids) == cached_ids.size()) {
+        engine->cached_prompts_bytes -= ContextBytes(**it);
+        it = cached_prompts.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    while (engine->cached_prompts_bytes + context_bytes >
+           engine->prompt_cache_size_bytes) {
+      engine->cached_prompts_bytes -= ContextBytes(*cached_prompts.front());
+      cached_prompts.pop_front();
+    }
+    engine->cached_prompts_bytes += context_bytes;
+    cached_prompts.push_back(
+        std::make_unique<const Llm::Context>(*std::move(context)));
+  }
+}
+
+void* scheduler_function(void* args) {
+  auto* engine = static_cast<LlmInferenceEngineCpu_Engine*>(args);
+  // Only touched by this thread.
+  std::vector<LlmInferenceEngineCpu_Session*> active_sessions;
+  while (true) {
+    std::deque<LlmInferenceEngineCpu_Session*> joining_sessions;
+    {
+      absl::MutexLock lock(&engine->mutex);
+      if (active_sessions.empty()) {
+        engine->mutex.Await(
+            absl::Condition(engine, &LlmInferenceEngineCpu_Engine::HasWork));
+      }
+      if (engine->shutting_down && engine->pending_sessions.empty() &&
+          active_sessions.empty()) {
+        break;
+      }
+      joining_sessions.swap(engine->pending_sessions);
+    }
+
+    std::vector<LlmInferenceEngineCpu_Session*> finished_sessions;
+    {
+      absl::MutexLock lock(&engine->llm_mutex);
+      for (auto* cpu_session : joining_sessions) {
+        start_llm_function(cpu_session);
+        active_sessions.push_back(cpu_session);
+      }
 
-  next_token_function(args);
+      // One decode step per active session.
+      for (auto* cpu_session : active_sessions) {
+        ABSL_CHECK_OK(engine->llm->LoadContext(cpu_session->context));
+        if (next_token_function(cpu_session)) {
+          finished_sessions.push_back(cpu_session);
+        }
+      }
+    }
+    if (finished_sessions.empty()) continue;
 
+    absl::MutexLock lock(&engine->mutex);
+    for (auto* cpu_session : finished_sessions) {
+      active_sessions.erase(std::find(active_sessions.begin(),
+                                      active_sessions.end(), cpu_session));
+      cpu_session->in_flight = false;
+    }
+  }
   return nullptr;
 }
 
@@ -203,6 +397,9 @@ LlmInferenceEngine_CreateEngine_Helper(const LlmModelSettings* model_settings) {
   model_data.reset();
 
   llm_params.seq_size_T = model_settings->max_num_tokens;
+  if (model_settings->num_draft_tokens > 0) {
+    llm_params.draft_size_G = model_settings->num_draft_tokens;
+  }
   llm_params.cache_dir = model_settings->cache_dir;
 
   auto weight_loader = std::make_unique<
@@ -234,27 +431,38 @@ LlmInferenceEngine_CreateEngine_Helper(const LlmModelSettings* model_settings) {
         tokenizer->model_proto().denormalizer_spec());
   }
 
-  std::unique_ptr<LlmInferenceEngineCpu_Engine> engine(
-      new LlmInferenceEngineCpu_Engine{
-          .tokenizer = tokenizer.release(),
-          .normalizer = normalizer.release(),
-          .llm = llm.release(),
-          .start_token_id = llm_params_proto.start_token_id(),
-          .stop_tokens =
-              std::vector<std::string>(llm_params_proto.stop_tokens().begin(),
-                                       llm_params_proto.stop_tokens().end()),
-          .max_num_tokens = model_settings->max_num_tokens,
-      });
+  auto engine = std::make_unique<LlmInferenceEngineCpu_Engine>();
+  engine->tokenizer = tokenizer.release();
+  engine->normalizer = normalizer.release();
+  engine->llm = llm.release();
+  engine->start_token_id = llm_params_proto.start_token_id();
+  engine->stop_tokens =
+      std::vector<std::string>(llm_params_proto.stop_tokens().begin(),
+                               llm_params_proto.stop_tokens().end());
+  engine->max_num_tokens = model_settings->max_num_tokens;
+  engine->prompt_cache_size_bytes = model_settings->prompt_cache_size_bytes;
+  engine->bytes_to_unicode_mapping =
+      mediapipe::tasks::genai::llm_utils::RequireBytesToUnicodeMapping(
+          *model_type);
+  RET_CHECK_EQ(pthread_create(&engine->scheduler_id, nullptr,
+                              scheduler_function, engine.get()),
+               0)
+      << "Failed to start the decode scheduler.";
 
   return engine.release();
 }
 
 absl::StatusOr<LlmInferenceEngine_Session*>
 LlmInferenceEngine_CreateSession_Helper(
-    const LlmInferenceEngineCpu_Engine* engine,
+    LlmInferenceEngineCpu_Engine* engine,
     const LlmSessionConfig* session_config) {
   std::unique_ptr<LlmInferenceEngineCpu_Session> session(
       new LlmInferenceEngineCpu_Session{.engine = engine});
+  // Each session keeps its own KV cache so that sessions can be interleaved.
+  MP_ASSIGN_OR_RETURN(auto context, engine->llm->NewContext());
+  session->context =
+      std::make_shared<mediapipe::tasks::genai::xnn_utils::Llm::Context>(
+          std::move(context));
 
   return session.release();
 }
@@ -328,8 +536,7 @@ LlmResponseContext LlmInferenceEngine_Session_PredictSync(
       [](void* callback_context, LlmResponseContext* response_context) {});
 
   auto cpu_session = reinterpret_cast<LlmInferenceEngineCpu_Session*>(session);
-  pthread_join(cpu_session->work_id, nullptr);
-  cpu_session->work_id = 0;
+  cpu_session->WaitUntilDone();
   auto final_output = cpu_session->final_output;
 
   char** result = (char**)malloc(sizeof(char*) * 1);
@@ -380,19 +587,45 @@ void LlmInferenceEngine_Session_PredictAsync(
 
   cpu_session->final_output = "";
   cpu_session->last_10_char = "";
+  cpu_session->detokenizer =
+      mediapipe::tasks::genai::llm_utils::IncrementalDetokenizer(
+          cpu_session->engine->bytes_to_unicode_mapping);
   cpu_session->early_stop = false;
+  cpu_session->response_count = 0;
 
-  pthread_t work_id = 0;
-  cpu_session->work_id = work_id;
-  pthread_create(&cpu_session->work_id, nullptr, start_llm_function,
-                 cpu_session);
+  auto* engine = cpu_session->engine;
+  absl::MutexLock lock(&engine->mutex);
+  cpu_session->in_flight = true;
+  engine->pending_sessions.push_back(cpu_session);
 }
 
 int LlmInferenceEngine_Session_Clone(
     LlmInferenceEngine_Session* session,
     LlmInferenceEngine_Session** cloned_session, char** error_msg) {
-  *error_msg = strdup("Not implemented");
-  return 12;
+  auto cpu_session = reinterpret_cast<LlmInferenceEngineCpu_Session*>(session);
+  // The scheduler must not be decoding into the context while it is copied.
+  cpu_session->WaitUntilDone();
+  absl::StatusOr<mediapipe::tasks::genai::xnn_utils::Llm::Context> context;
+  {
+    absl::MutexLock lock(&cpu_session->engine->llm_mutex);
+    context = cpu_session->engine->llm->CloneContext(*cpu_session->context);
+  }
+  if (!context.ok()) {
+    if (error_msg) {
+      *error_msg = strdup(absl::StrCat("Failed to clone session: ",
+                                       context.status().ToString())
+                              .c_str());
+    }
+    return static_cast<int>(context.status().code());
+  }
+  *cloned_session = new LlmInferenceEngineCpu_Session{
+      .engine = cpu_session->engine,
+      .context =
+          std::make_shared<mediapipe::tasks::genai::xnn_utils::Llm::Context>(
+              *std::move(context)),
+      .prompt = cpu_session->prompt,
+  };
+  return 0;
 }
 
 int LlmInferenceEngine_Session_SizeInTokens(LlmInferenceEngine_Session* session,
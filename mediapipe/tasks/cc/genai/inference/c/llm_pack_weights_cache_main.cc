@@ -0,0 +1,87 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Builds the packed weights cache of an LLM ahead of time.
+//
+// The first time a model is loaded, XNNPack packs its weights and the packed
+// weights are serialized next to the model (or into --cache_dir). Later loads
+// map that file and use the packed weights in place. Running this binary, e.g.
+// at install time, moves the packing cost out of the first app start.
+//
+// The cache depends on the model and on the XNNPack build only, so
+// --max_tokens does not need to match the value used at inference time.
+
+#include <cstdlib>
+#include <optional>
+#include <string>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "glog/logging.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/tasks/cc/genai/inference/c/llm_inference_engine.h"
+
+ABSL_FLAG(std::optional<std::string>, model_path, std::nullopt,
+          "Path to the tflite model file.");
+
+ABSL_FLAG(std::optional<std::string>, cache_dir, std::nullopt,
+          "Path to the cache directory. Defaults to the model directory.");
+
+ABSL_FLAG(int, max_tokens, 512,
+          "Maximum number of input and output tokens of the engine that is "
+          "created to pack the weights.");
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  absl::ParseCommandLine(argc, argv);
+
+  ABSL_QCHECK(absl::GetFlag(FLAGS_model_path).has_value())
+      << "--model_path is required.";
+  const std::string model_path = absl::GetFlag(FLAGS_model_path).value();
+  std::string cache_dir;
+  if (absl::GetFlag(FLAGS_cache_dir).has_value()) {
+    cache_dir = absl::GetFlag(FLAGS_cache_dir).value();
+  } else {
+    cache_dir = std::string(mediapipe::file::Dirname(model_path));
+  }
+
+  const LlmModelSettings model_settings = {
+      .model_path = model_path.c_str(),
+      .cache_dir = cache_dir.c_str(),
+      .max_num_tokens = static_cast<size_t>(absl::GetFlag(FLAGS_max_tokens)),
+  };
+
+  // Creating the engine loads the weights, which packs them into the cache if
+  // it does not exist yet.
+  const absl::Time start = absl::Now();
+  void* llm_engine = nullptr;
+  char* error_msg = nullptr;
+  int error_code =
+      LlmInferenceEngine_CreateEngine(&model_settings, &llm_engine, &error_msg);
+  if (error_code) {
+    ABSL_LOG(ERROR) << "Failed to create engine: " << std::string(error_msg);
+    free(error_msg);
+    return EXIT_FAILURE;
+  }
+  LlmInferenceEngine_Engine_Delete(llm_engine);
+
+  ABSL_LOG(INFO) << "Weights cache for " << model_path << " is ready in "
+                 << cache_dir << " (" << absl::Now() - start << ").";
+  return EXIT_SUCCESS;
+}
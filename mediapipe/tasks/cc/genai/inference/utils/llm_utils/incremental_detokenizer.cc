@@ -0,0 +1,166 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/incremental_detokenizer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "absl/strings/ascii.h"
+#include "absl/strings/string_view.h"
+
+namespace mediapipe::tasks::genai::llm_utils {
+
+namespace {
+
+// Returns whether GPT-2's bytes_to_unicode() maps `byte` to itself.
+bool IsPrintableByte(int byte) {
+  return (byte >= '!' && byte <= '~') || (byte >= 0xA1 && byte <= 0xAC) ||
+         (byte >= 0xAE && byte <= 0xFF);
+}
+
+// Inverse of bytes_to_unicode() for the code points it maps non-printable
+// bytes to, i.e. 256 + n for the n-th non-printable byte.
+const std::array<uint8_t, 68>& ShiftedCodePointToByte() {
+  static const std::array<uint8_t, 68> kTable = [] {
+    std::array<uint8_t, 68> table{};
+    int n = 0;
+    for (int byte = 0; byte < 256; ++byte) {
+      if (!IsPrintableByte(byte)) table[n++] = byte;
+    }
+    return table;
+  }();
+  return kTable;
+}
+
+// Decodes the UTF-8 character at the start of `text` into `code_point`.
+// Returns its length, or 0 if `text` does not start with a valid character.
+size_t DecodeUtf8(absl::string_view text, uint32_t& code_point) {
+  const uint8_t lead = text[0];
+  size_t length;
+  if (lead < 0x80) {
+    code_point = lead;
+    return 1;
+  } else if ((lead & 0xE0) == 0xC0) {
+    length = 2;
+    code_point = lead & 0x1F;
+  } else if ((lead & 0xF0) == 0xE0) {
+    length = 3;
+    code_point = lead & 0x0F;
+  } else if ((lead & 0xF8) == 0xF0) {
+    length = 4;
+    code_point = lead & 0x07;
+  } else {
+    return 0;
+  }
+  if (text.size() < length) return 0;
+  for (size_t i = 1; i < length; ++i) {
+    const uint8_t byte = text[i];
+    if ((byte & 0xC0) != 0x80) return 0;
+    code_point = (code_point << 6) | (byte & 0x3F);
+  }
+  return length;
+}
+
+// Maps a piece from the byte-to-unicode alphabet back to raw bytes. Code
+// points outside of the alphabet are kept as is.
+void AppendUnicodeMappedBytes(absl::string_view piece, std::string& output) {
+  const auto& shifted_to_byte = ShiftedCodePointToByte();
+  while (!piece.empty()) {
+    uint32_t code_point;
+    const size_t length = DecodeUtf8(piece, code_point);
+    if (length == 0) {
+      output.push_back(piece[0]);
+      piece.remove_prefix(1);
+      continue;
+    }
+    if (code_point < 256 && IsPrintableByte(code_point)) {
+      output.push_back(static_cast<char>(code_point));
+    } else if (code_point >= 256 &&
+               code_point < 256 + shifted_to_byte.size()) {
+      output.push_back(static_cast<char>(shifted_to_byte[code_point - 256]));
+    } else {
+      output.append(piece.data(), length);
+    }
+    piece.remove_prefix(length);
+  }
+}
+
+// Parses a byte-fallback piece, i.e. "<0xXX>".
+bool ParseBytePiece(absl::string_view piece, char& byte) {
+  if (piece.size() != 6 || piece.substr(0, 3) != "<0x" || piece[5] != '>' ||
+      !absl::ascii_isxdigit(piece[3]) || !absl::ascii_isxdigit(piece[4])) {
+    return false;
+  }
+  auto hex_value = [](char c) {
+    return absl::ascii_isdigit(c) ? c - '0' : absl::ascii_tolower(c) - 'a' + 10;
+  };
+  byte = static_cast<char>(hex_value(piece[3]) * 16 + hex_value(piece[4]));
+  return true;
+}
+
+}  // namespace
+
+std::string IncrementalDetokenizer::Append(absl::string_view piece,
+                                           bool is_byte) {
+  char byte;
+  if (is_byte && ParseBytePiece(piece, byte)) {
+    pending_.push_back(byte);
+  } else if (bytes_to_unicode_mapping_) {
+    AppendUnicodeMappedBytes(piece, pending_);
+  } else {
+    pending_.append(piece.data(), piece.size());
+  }
+
+  const size_t complete = Utf8CompletePrefixLength(pending_);
+  std::string text = pending_.substr(0, complete);
+  pending_.erase(0, complete);
+  return text;
+}
+
+std::string IncrementalDetokenizer::Flush() {
+  return std::exchange(pending_, std::string());
+}
+
+size_t Utf8CompletePrefixLength(absl::string_view text) {
+  // Walk back over at most three continuation bytes to the lead byte of the
+  // last character.
+  size_t lead = text.size();
+  size_t continuations = 0;
+  while (lead > 0 && continuations < 3 &&
+         (static_cast<uint8_t>(text[lead - 1]) & 0xC0) == 0x80) {
+    --lead;
+    ++continuations;
+  }
+  if (lead == 0) return text.size();
+  const uint8_t lead_byte = text[lead - 1];
+  size_t length;
+  if ((lead_byte & 0xE0) == 0xC0) {
+    length = 2;
+  } else if ((lead_byte & 0xF0) == 0xE0) {
+    length = 3;
+  } else if ((lead_byte & 0xF8) == 0xF0) {
+    length = 4;
+  } else {
+    // ASCII, or bytes that are not valid UTF-8 anyway: nothing to wait for.
+    return text.size();
+  }
+  return continuations + 1 < length ? lead - 1 : text.size();
+}
+
+}  // namespace mediapipe::tasks::genai::llm_utils
@@ -0,0 +1,60 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_LLM_UTILS_INCREMENTAL_DETOKENIZER_H_
+#define MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_LLM_UTILS_INCREMENTAL_DETOKENIZER_H_
+
+#include <cstddef>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace mediapipe::tasks::genai::llm_utils {
+
+// Turns the pieces of generated tokens into text one token at a time, with
+// constant work per token instead of decoding the growing id sequence.
+//
+// * SentencePiece byte-fallback pieces, e.g. "<0xE2>", become the raw byte.
+// * With `bytes_to_unicode_mapping`, pieces are mapped back from the GPT-2
+//   style byte-to-unicode alphabet used by BPE models (see
+//   RequireBytesToUnicodeMapping()).
+// * Bytes of a UTF-8 character that is split across tokens are held back
+//   until the character is complete, so every returned chunk is valid UTF-8
+//   on its own.
+class IncrementalDetokenizer {
+ public:
+  explicit IncrementalDetokenizer(bool bytes_to_unicode_mapping = false)
+      : bytes_to_unicode_mapping_(bytes_to_unicode_mapping) {}
+
+  // Appends the piece of the next token, and returns the text it completes.
+  // `is_byte` tells whether the piece is a byte-fallback piece.
+  std::string Append(absl::string_view piece, bool is_byte = false);
+
+  // Returns the bytes that are still held back, e.g. once generation ends.
+  std::string Flush();
+
+ private:
+  bool bytes_to_unicode_mapping_;
+  // Trailing bytes of an incomplete UTF-8 character.
+  std::string pending_;
+};
+
+// Returns the length of the longest prefix of `text` that does not end inside
+// a UTF-8 character. Only the last few bytes of `text` are inspected.
+size_t Utf8CompletePrefixLength(absl::string_view text);
+
+}  // namespace mediapipe::tasks::genai::llm_utils
+
+#endif  // MEDIAPIPE_TASKS_GENAI_INFERENCE_UTILS_LLM_UTILS_INCREMENTAL_DETOKENIZER_H_
@@ -0,0 +1,79 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/incremental_detokenizer.h"
+
+#include <string>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe::tasks::genai::llm_utils {
+namespace {
+
+TEST(IncrementalDetokenizerTest, PassesThroughCompleteText) {
+  IncrementalDetokenizer detokenizer;
+  EXPECT_EQ(detokenizer.Append("Hello"), "Hello");
+  EXPECT_EQ(detokenizer.Append(" world"), " world");
+  EXPECT_EQ(detokenizer.Flush(), "");
+}
+
+TEST(IncrementalDetokenizerTest, HoldsBackSplitCharacterFromByteFallback) {
+  IncrementalDetokenizer detokenizer;
+  // "€" is E2 82 AC.
+  EXPECT_EQ(detokenizer.Append("<0xE2>", /*is_byte=*/true), "");
+  EXPECT_EQ(detokenizer.Append("<0x82>", /*is_byte=*/true), "");
+  EXPECT_EQ(detokenizer.Append("<0xAC>", /*is_byte=*/true), "\xE2\x82\xAC");
+  EXPECT_EQ(detokenizer.Append("<0x41>", /*is_byte=*/true), "A");
+}
+
+TEST(IncrementalDetokenizerTest, KeepsPiecesThatAreNotBytes) {
+  IncrementalDetokenizer detokenizer;
+  EXPECT_EQ(detokenizer.Append("<0x41>"), "<0x41>");
+  EXPECT_EQ(detokenizer.Append("<0xZZ>", /*is_byte=*/true), "<0xZZ>");
+}
+
+TEST(IncrementalDetokenizerTest, MapsBytesToUnicodeAlphabetBack) {
+  IncrementalDetokenizer detokenizer(/*bytes_to_unicode_mapping=*/true);
+  // "Ġ" (U+0120) stands for a space, "Ċ" (U+010A) for a newline.
+  EXPECT_EQ(detokenizer.Append("\xC4\xA0hi"), " hi");
+  EXPECT_EQ(detokenizer.Append("\xC4\x8A"), "\n");
+  // "é" is C3 A9, which the alphabet spells "Ã" (U+00C3) and "©" (U+00A9).
+  EXPECT_EQ(detokenizer.Append("\xC3\x83"), "");
+  EXPECT_EQ(detokenizer.Append("\xC2\xA9"), "\xC3\xA9");
+}
+
+TEST(IncrementalDetokenizerTest, FlushReturnsIncompleteBytes) {
+  IncrementalDetokenizer detokenizer;
+  EXPECT_EQ(detokenizer.Append("a\xE2\x82"), "a");
+  EXPECT_EQ(detokenizer.Flush(), "\xE2\x82");
+  EXPECT_EQ(detokenizer.Flush(), "");
+}
+
+TEST(Utf8CompletePrefixLengthTest, StopsBeforeIncompleteCharacter) {
+  EXPECT_EQ(Utf8CompletePrefixLength(""), 0);
+  EXPECT_EQ(Utf8CompletePrefixLength("abc"), 3);
+  EXPECT_EQ(Utf8CompletePrefixLength("ab\xE2"), 2);
+  EXPECT_EQ(Utf8CompletePrefixLength("ab\xE2\x82"), 2);
+  EXPECT_EQ(Utf8CompletePrefixLength("ab\xE2\x82\xAC"), 5);
+  EXPECT_EQ(Utf8CompletePrefixLength("\xF0\x9F\x98"), 0);
+  EXPECT_EQ(Utf8CompletePrefixLength("\xF0\x9F\x98\x80"), 4);
+  // Invalid bytes are not held back.
+  EXPECT_EQ(Utf8CompletePrefixLength("a\x80"), 2);
+  EXPECT_EQ(Utf8CompletePrefixLength("a\xFF"), 2);
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::genai::llm_utils
@@ -19,6 +19,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/scoped_file.h"
@@ -29,12 +30,28 @@ namespace mediapipe::tasks::genai::llm_utils {
 // object exists and will be cleaned up when it is destroyed.
 class MemoryMappedFile {
  public:
+  // Expected access pattern of a range of the mapping, see Advise().
+  enum class Advice {
+    // No special treatment.
+    kNormal,
+    // Accessed in order: read ahead aggressively and free pages soon after
+    // they were accessed.
+    kSequential,
+    // Accessed soon: start paging in the range.
+    kWillNeed,
+    // Not accessed soon: release resident pages, which are paged in from the
+    // file again on access. Only applies to read-only mappings, since pages
+    // written through a private mapping would be lost.
+    kDontNeed,
+  };
+
   // Gets the required alignment for a file offset passed to Create().
   static size_t GetOffsetAlignment();
 
-  // Creates a read-only MemoryMappedFile object.
+  // Creates a read-only MemoryMappedFile object. Unless `prefetch` is false,
+  // the whole file starts being paged in right away.
   static absl::StatusOr<std::unique_ptr<MemoryMappedFile>> Create(
-      absl::string_view path);
+      absl::string_view path, bool prefetch = true);
   // Creates a MemoryMappedFile object from the platform file handle. This does
   // not take ownership of the passed handle. The `key` passed here is an
   // optimization when mapping the same file with different offsets.
@@ -54,6 +71,15 @@ class MemoryMappedFile {
 
   // Returns a pointer to the file data.
   virtual void* data() = 0;
+
+  // Hints the expected access of `length` bytes starting at `offset` (until the
+  // end of the mapping if `length` is 0), so the OS can page data in ahead of
+  // access and bound resident memory to what is actually used. This is a no-op
+  // on platforms without support, and for kDontNeed on writable mappings.
+  virtual absl::Status Advise(Advice advice, uint64_t offset = 0,
+                              uint64_t length = 0) {
+    return absl::OkStatus();
+  }
 };
 
 }  // namespace mediapipe::tasks::genai::llm_utils
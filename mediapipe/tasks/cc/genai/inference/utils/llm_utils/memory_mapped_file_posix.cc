@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "absl/cleanup/cleanup.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/framework/port/ret_check.h"
@@ -35,37 +36,61 @@ namespace {
 
 class MemoryMappedFilePosix : public MemoryMappedFile {
  public:
-  MemoryMappedFilePosix(uint64_t length, void* data)
-      : length_(length), data_(data) {}
+  MemoryMappedFilePosix(uint64_t length, void* data, bool read_only)
+      : length_(length), data_(data), read_only_(read_only) {}
   ~MemoryMappedFilePosix() override { munmap(data_, length_); }
 
   uint64_t length() override { return length_; }
 
   void* data() override { return data_; }
 
+  absl::Status Advise(Advice advice, uint64_t offset,
+                      uint64_t length) override {
+    RET_CHECK_LE(offset, length_);
+    if (length == 0 || length > length_ - offset) {
+      length = length_ - offset;
+    }
+    if (length == 0) return absl::OkStatus();
+    // Dropping pages of a writable private mapping discards what was written
+    // to them, so only read-only mappings are released.
+    if (advice == Advice::kDontNeed && !read_only_) return absl::OkStatus();
+    // madvise requires a page aligned start.
+    const uint64_t aligned_offset = offset - offset % getpagesize();
+    int posix_advice = MADV_NORMAL;
+    switch (advice) {
+      case Advice::kNormal:
+        posix_advice = MADV_NORMAL;
+        break;
+      case Advice::kSequential:
+        posix_advice = MADV_SEQUENTIAL;
+        break;
+      case Advice::kWillNeed:
+        posix_advice = MADV_WILLNEED;
+        break;
+      case Advice::kDontNeed:
+        posix_advice = MADV_DONTNEED;
+        break;
+    }
+    RET_CHECK_EQ(madvise(static_cast<char*>(data_) + aligned_offset,
+                         length + offset - aligned_offset, posix_advice),
+                 0)
+        << "madvise failed, error: " << strerror(errno);
+    return absl::OkStatus();
+  }
+
  private:
   uint64_t length_;
   void* data_;
+  bool read_only_;
 };
 
-}  // namespace
-
-// static
-size_t MemoryMappedFile::GetOffsetAlignment() { return getpagesize(); }
-
-// static
-absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
-    absl::string_view path) {
-  MP_ASSIGN_OR_RETURN(auto scoped_file, ScopedFile::Open(path));
-  return Create(scoped_file.file());
-}
-
-// static
-absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
-    int file, uint64_t offset, uint64_t length, absl::string_view key) {
-  RET_CHECK_EQ(offset % GetOffsetAlignment(), 0)
+absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MapFile(int file,
+                                                          uint64_t offset,
+                                                          uint64_t length,
+                                                          bool prefetch) {
+  RET_CHECK_EQ(offset % MemoryMappedFile::GetOffsetAlignment(), 0)
       << "Offset must be a multiple of page size : " << offset << ", "
-      << GetOffsetAlignment();
+      << MemoryMappedFile::GetOffsetAlignment();
 
   size_t file_size = lseek(file, 0, SEEK_END);
   RET_CHECK_GE(file_size, length + offset) << "Length and offset too large.";
@@ -78,16 +103,38 @@ absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
   // memory doesn't require it to be writable, so it's fine to just use
   // PROT_READ here.
 #if defined(__APPLE__)
+  constexpr bool kReadOnly = true;
   void* data = mmap(nullptr, length, PROT_READ, MAP_SHARED, file, offset);
 #else
+  constexpr bool kReadOnly = false;
   void* data =
       mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, offset);
 #endif
   RET_CHECK_NE(data, MAP_FAILED) << "Failed to map, error: " << strerror(errno);
   RET_CHECK_NE(data, nullptr) << "Failed to map.";
-  RET_CHECK_EQ(madvise(data, length, MADV_WILLNEED), 0) << "madvise failed.";
+  if (prefetch) {
+    RET_CHECK_EQ(madvise(data, length, MADV_WILLNEED), 0) << "madvise failed.";
+  }
 
-  return std::make_unique<MemoryMappedFilePosix>(length, data);
+  return std::make_unique<MemoryMappedFilePosix>(length, data, kReadOnly);
+}
+
+}  // namespace
+
+// static
+size_t MemoryMappedFile::GetOffsetAlignment() { return getpagesize(); }
+
+// static
+absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
+    absl::string_view path, bool prefetch) {
+  MP_ASSIGN_OR_RETURN(auto scoped_file, ScopedFile::Open(path));
+  return MapFile(scoped_file.file(), 0, 0, prefetch);
+}
+
+// static
+absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
+    int file, uint64_t offset, uint64_t length, absl::string_view key) {
+  return MapFile(file, offset, length, /*prefetch=*/true);
 }
 
 absl::StatusOr<std::unique_ptr<MemoryMappedFile>>
@@ -104,7 +151,8 @@ MemoryMappedFile::CreateMutable(absl::string_view path) {
       << "Failed to map " << path << ", error: " << strerror(errno);
   RET_CHECK_NE(data, nullptr) << "Failed to map: " << path;
 
-  return std::make_unique<MemoryMappedFilePosix>(length, data);
+  return std::make_unique<MemoryMappedFilePosix>(length, data,
+                                                 /*read_only=*/false);
 }
 
 }  // namespace mediapipe::tasks::genai::llm_utils
@@ -95,7 +95,7 @@ size_t MemoryMappedFile::GetOffsetAlignment() {
 
 // static
 absl::StatusOr<std::unique_ptr<MemoryMappedFile>> MemoryMappedFile::Create(
-    absl::string_view path) {
+    absl::string_view path, bool prefetch) {
   MP_ASSIGN_OR_RETURN(auto scoped_file, ScopedFile::Open(path));
   return CreateImpl(scoped_file.file(), 0, 0, nullptr, false);
 }
@@ -234,7 +234,11 @@ absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::IntermediateTensor(
     Tensor::DimsType dims, xnn_datatype data_type, absl::string_view tag) {
   auto t = std::make_shared<Tensor>(std::move(dims), data_type);
   t->tag = tag;
+  return IntermediateTensor(std::move(t));
+}
 
+absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::IntermediateTensor(
+    std::shared_ptr<Tensor> t) {
   build_steps_.push_back([this, t](xnn_subgraph_t subgraph) -> absl::Status {
     // Could be moved to output tensors, thus need check.
     if (interm_tensors_.contains(t)) {
@@ -783,6 +787,44 @@ absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::ElementDiv(
   return output;
 }
 
+absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::QuantizeInt8(
+    std::shared_ptr<Tensor> input, float scale) {
+  RET_CHECK_EQ(input->datatype, xnn_datatype_fp32);
+  auto output = std::make_shared<QTensor>(input->dims, scale);
+  output->tag = "quantize_int8_output";
+  MP_RETURN_IF_ERROR(IntermediateTensor(output).status());
+
+  build_steps_.push_back([input,
+                          output](xnn_subgraph_t subgraph) -> absl::Status {
+    RET_CHECK_EQ(xnn_status_success,
+                 xnn_define_convert(subgraph, input->tensor_id(subgraph),
+                                    output->tensor_id(subgraph),
+                                    /*flags=*/0));
+    return absl::OkStatus();
+  });
+
+  return output;
+}
+
+absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::Dequantize(
+    std::shared_ptr<Tensor> input) {
+  RET_CHECK_EQ(input->datatype, xnn_datatype_qint8);
+  MP_ASSIGN_OR_RETURN(auto output, IntermediateTensor(input->dims,
+                                                      xnn_datatype_fp32,
+                                                      "dequantize_output"));
+
+  build_steps_.push_back([input,
+                          output](xnn_subgraph_t subgraph) -> absl::Status {
+    RET_CHECK_EQ(xnn_status_success,
+                 xnn_define_convert(subgraph, input->tensor_id(subgraph),
+                                    output->tensor_id(subgraph),
+                                    /*flags=*/0));
+    return absl::OkStatus();
+  });
+
+  return output;
+}
+
 absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::PerDimScale(
     std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> per_dim_scale) {
   // input: B T N H
@@ -862,12 +904,12 @@ absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::BatchMatMul(
   const auto& lhs_dim = input->dims;
   const auto& rhs_dim = weight->dims;
 
-  // [B, N, T, S] . [B, N', H, S]
+  // [B, N, T, S] . [B, N', H, S], leading dimensions are broadcast if one
+  // side is 1, e.g. for grouped-query attention [B, N', G, T, S] .
+  // [B, N', 1, H, S].
   RET_CHECK_GE(lhs_dim.size(), 3);
   RET_CHECK_GE(rhs_dim.size(), 3);
   uint32_t flags = 0;
-  const size_t N =
-      std::max(lhs_dim[lhs_dim.size() - 3], rhs_dim[rhs_dim.size() - 3]);
   const size_t T = lhs_dim[lhs_dim.size() - 2];
   size_t H;
   if (!params.transpose) {
@@ -879,14 +921,18 @@ absl::StatusOr<std::shared_ptr<Tensor>> XnnGraphBuilder::BatchMatMul(
     H = rhs_dim[rhs_dim.size() - 1];
   }
 
-  size_t batch_size = lhs_dim.size() == 3 ? 1 : lhs_dim[0];
   NewWeight(weight);
   std::vector<size_t> dims(std::max(lhs_dim.size(), rhs_dim.size()));
   dims[dims.size() - 1] = H;
   dims[dims.size() - 2] = T;
-  dims[dims.size() - 3] = N;
-  if (dims.size() > 3) {
-    dims[0] = batch_size;
+  for (size_t i = 3; i <= dims.size(); ++i) {
+    const size_t lhs_batch =
+        i <= lhs_dim.size() ? lhs_dim[lhs_dim.size() - i] : 1;
+    const size_t rhs_batch =
+        i <= rhs_dim.size() ? rhs_dim[rhs_dim.size() - i] : 1;
+    RET_CHECK(lhs_batch == rhs_batch || lhs_batch == 1 || rhs_batch == 1)
+        << "lhs " << lhs_dim << " rhs " << rhs_dim;
+    dims[dims.size() - i] = std::max(lhs_batch, rhs_batch);
   }
   MP_ASSIGN_OR_RETURN(auto output,
                       IntermediateTensor(dims, "batch_mat_mul_output"));
@@ -281,6 +281,15 @@ class XnnGraphBuilder {
       std::shared_ptr<Tensor> lhs, float rhs,
       ClampParams params = ClampParams());
 
+  // Quantizes float `input` to int8 with a single `scale`, i.e. to
+  // round(input / scale) saturated to [-128, 127].
+  absl::StatusOr<std::shared_ptr<Tensor>> QuantizeInt8(
+      std::shared_ptr<Tensor> input, float scale = 1.0f);
+
+  // Converts an `input` quantized by QuantizeInt8 back to float.
+  absl::StatusOr<std::shared_ptr<Tensor>> Dequantize(
+      std::shared_ptr<Tensor> input);
+
   absl::StatusOr<std::shared_ptr<Tensor>> Rope(
       std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> segment_pos);
 
@@ -314,6 +323,9 @@ class XnnGraphBuilder {
   absl::StatusOr<std::shared_ptr<Tensor>> IntermediateTensor(
       Tensor::DimsType dims, xnn_datatype data_type,
       absl::string_view tag = "");
+  // Adds the already constructed `t`, e.g. of a Tensor subclass.
+  absl::StatusOr<std::shared_ptr<Tensor>> IntermediateTensor(
+      std::shared_ptr<Tensor> t);
 
   std::unique_ptr<RuntimeConfigs> runtime_configs_;
   const xnn_datatype data_type_;
@@ -77,8 +77,29 @@ absl::StatusOr<std::unique_ptr<Llm>> Llm::CreateLlm(
   RET_CHECK_EQ(llm_params.enable_kv_cache, llm_params.enable_dynamic_shape)
           .SetCode(absl::StatusCode::kInvalidArgument)
       << "Dynamic shape should be enabled together with KV cache.";
+  // Unless the caller manages its own cache, let XNNPack pack weights into the
+  // loader's cache, so that later runs map the packed weights in place rather
+  // than packing them again.
+  std::shared_ptr<XnnWeightsCache> loader_weights_cache;
+  if (!builder->runtime_configs_->weights_cache) {
+    loader_weights_cache = weight_loader->GetXnnWeightsCache();
+    builder->runtime_configs_->weights_cache = loader_weights_cache;
+  }
   MP_ASSIGN_OR_RETURN(auto weights, weight_loader->LoadWeights());
-  return CreatePrefixDecodeLlm(std::move(weights), std::move(builder));
+  MP_ASSIGN_OR_RETURN(
+      auto llm, CreatePrefixDecodeLlm(std::move(weights), std::move(builder)));
+  if (loader_weights_cache) {
+    MP_RETURN_IF_ERROR(loader_weights_cache->Finalize());
+  }
+  // XNNPack runs on its packed copies of the weights now. The original weights
+  // stay mapped for the few tensors used in place, e.g. the token embedding,
+  // but their pages touched by packing need not stay resident.
+  absl::Status release_status = weight_loader->ReleaseResidentMemory();
+  if (!release_status.ok()) {
+    ABSL_LOG(WARNING) << "Failed to release weights memory: "
+                      << release_status;
+  }
+  return llm;
 }
 
 absl::StatusOr<std::unique_ptr<Llm>> Llm::CreatePrefixDecodeLlm(
@@ -247,6 +268,23 @@ absl::StatusOr<Llm::Context> Llm::NewContext() const {
               kv.v_slice = std::make_shared<Tensor>(
                   current_kv.v_slice->dims, current_kv.v_slice->datatype);
               kv.v_slice->Borrow(kv.v_cache->Slice(0, 0));
+              if (!current_kv.k_scale_cache) continue;
+              kv.k_scale_cache =
+                  std::make_shared<Tensor>(current_kv.k_scale_cache->dims,
+                                           current_kv.k_scale_cache->datatype);
+              kv.k_scale_cache->LoadFromVec({}).IgnoreError();
+              kv.v_scale_cache =
+                  std::make_shared<Tensor>(current_kv.v_scale_cache->dims,
+                                           current_kv.v_scale_cache->datatype);
+              kv.v_scale_cache->LoadFromVec({}).IgnoreError();
+              kv.k_scale_slice =
+                  std::make_shared<Tensor>(current_kv.k_scale_slice->dims,
+                                           current_kv.k_scale_slice->datatype);
+              kv.k_scale_slice->Borrow(kv.k_scale_cache->Slice(0, 0));
+              kv.v_scale_slice =
+                  std::make_shared<Tensor>(current_kv.v_scale_slice->dims,
+                                           current_kv.v_scale_slice->datatype);
+              kv.v_scale_slice->Borrow(kv.v_scale_cache->Slice(0, 0));
             }
             return kvs;
           }(),
@@ -258,21 +296,93 @@ absl::Status Llm::LoadContext(
   if (!context || (context_ == context)) return absl::OkStatus();
   // There are some metadata we'd like to keep with existing context, also we'd
   // like to use pointer address to distinguish context. So the following logic
-  // is: 1) let existing context point to the buffer from new context; 2) move
-  // tensors from existing context to new context; 3) store new context.
+  // is: 1) give the existing context tensors of its own that keep its buffers,
+  // so that it can be loaded again later; 2) let the graph tensors point to
+  // the buffer from new context; 3) move the graph tensors to new context;
+  // 4) store new context.
   {
+    auto detach = [](const std::shared_ptr<Tensor>& graph_tensor) {
+      auto tensor = std::make_shared<Tensor>(graph_tensor->dims,
+                                             graph_tensor->datatype);
+      tensor->Borrow(graph_tensor);
+      return tensor;
+    };
+    std::vector<KVCache> existing_kv_cache(kv_cache().size());
+    for (size_t i = 0; i < kv_cache().size(); ++i) {
+      existing_kv_cache[i].k_cache = detach(kv_cache()[i].k_cache);
+      existing_kv_cache[i].v_cache = detach(kv_cache()[i].v_cache);
+      existing_kv_cache[i].k_slice = detach(kv_cache()[i].k_slice);
+      existing_kv_cache[i].v_slice = detach(kv_cache()[i].v_slice);
+      if (!kv_cache()[i].k_scale_cache) continue;
+      existing_kv_cache[i].k_scale_cache = detach(kv_cache()[i].k_scale_cache);
+      existing_kv_cache[i].v_scale_cache = detach(kv_cache()[i].v_scale_cache);
+      existing_kv_cache[i].k_scale_slice = detach(kv_cache()[i].k_scale_slice);
+      existing_kv_cache[i].v_scale_slice = detach(kv_cache()[i].v_scale_slice);
+    }
     for (size_t i = 0; i < kv_cache().size(); ++i) {
       kv_cache()[i].k_cache->Borrow(context->kv_cache[i].k_cache);
       kv_cache()[i].v_cache->Borrow(context->kv_cache[i].v_cache);
       kv_cache()[i].k_slice->Borrow(context->kv_cache[i].k_slice);
       kv_cache()[i].v_slice->Borrow(context->kv_cache[i].v_slice);
+      if (!kv_cache()[i].k_scale_cache) continue;
+      kv_cache()[i].k_scale_cache->Borrow(context->kv_cache[i].k_scale_cache);
+      kv_cache()[i].v_scale_cache->Borrow(context->kv_cache[i].v_scale_cache);
+      kv_cache()[i].k_scale_slice->Borrow(context->kv_cache[i].k_scale_slice);
+      kv_cache()[i].v_scale_slice->Borrow(context->kv_cache[i].v_scale_slice);
     }
     context->kv_cache = std::move(kv_cache());
+    context_->kv_cache = std::move(existing_kv_cache);
   }
   context_ = std::move(context);
   return absl::OkStatus();
 }
 
+absl::StatusOr<Llm::Context> Llm::CloneContext(const Context& context) const {
+  size_t num_rows = 0;
+  for (const auto& prev_ids : context.batch_prev_ids) {
+    num_rows = std::max(num_rows, prev_ids.size());
+  }
+  // Caches are laid out as [T, B, N, H]; only the first `num_rows` time steps
+  // hold data that the clone can attend to.
+  auto clone_cache = [num_rows](const std::shared_ptr<Tensor>& cache)
+      -> absl::StatusOr<std::shared_ptr<Tensor>> {
+    auto tensor = std::make_shared<Tensor>(cache->dims, cache->datatype);
+    tensor->AllocateBufferIfNeeded();
+    const size_t rows = std::min<size_t>(num_rows, cache->dims[0]);
+    if (rows > 0) {
+      auto used = cache->Slice(0, /*start=*/0, /*end=*/rows);
+      MP_RETURN_IF_ERROR(tensor->Slice(0, /*start=*/0, /*end=*/rows)
+                             ->LoadFromBuffer(used->Data()));
+    }
+    return tensor;
+  };
+  Context result{.batch_prev_ids = context.batch_prev_ids};
+  result.kv_cache.resize(context.kv_cache.size());
+  for (size_t i = 0; i < result.kv_cache.size(); ++i) {
+    const auto& source = context.kv_cache[i];
+    auto& kv = result.kv_cache[i];
+    RET_CHECK(source.k_cache && source.v_cache);
+    MP_ASSIGN_OR_RETURN(kv.k_cache, clone_cache(source.k_cache));
+    MP_ASSIGN_OR_RETURN(kv.v_cache, clone_cache(source.v_cache));
+    kv.k_slice = std::make_shared<Tensor>(source.k_slice->dims,
+                                          source.k_slice->datatype);
+    kv.k_slice->Borrow(kv.k_cache->Slice(0, 0));
+    kv.v_slice = std::make_shared<Tensor>(source.v_slice->dims,
+                                          source.v_slice->datatype);
+    kv.v_slice->Borrow(kv.v_cache->Slice(0, 0));
+    if (!source.k_scale_cache) continue;
+    MP_ASSIGN_OR_RETURN(kv.k_scale_cache, clone_cache(source.k_scale_cache));
+    MP_ASSIGN_OR_RETURN(kv.v_scale_cache, clone_cache(source.v_scale_cache));
+    kv.k_scale_slice = std::make_shared<Tensor>(source.k_scale_slice->dims,
+                                                source.k_scale_slice->datatype);
+    kv.k_scale_slice->Borrow(kv.k_scale_cache->Slice(0, 0));
+    kv.v_scale_slice = std::make_shared<Tensor>(source.v_scale_slice->dims,
+                                                source.v_scale_slice->datatype);
+    kv.v_scale_slice->Borrow(kv.v_scale_cache->Slice(0, 0));
+  }
+  return result;
+}
+
 absl::Status Llm::ReduceContextPrevIds(std::shared_ptr<Context> context,
                                        std::vector<int> batch_num_tokens) {
   ABSL_CHECK_EQ(batch_num_tokens.size(), context->batch_prev_ids.size());
@@ -312,6 +422,23 @@ absl::Status Llm::AddInputTokens(
     RET_CHECK_EQ(it->size(), input_seq_len);
   }
 
+  const size_t chunk_size = llm_params_.prefill_chunk_size;
+  if (llm_params_.enable_kv_cache && chunk_size > 0 &&
+      input_seq_len > chunk_size) {
+    // Each chunk appends to the KV cache, so the later chunks attend to all
+    // tokens of the earlier ones.
+    std::vector<std::vector<int>> batch_chunk_ids(batch_input_ids.size());
+    for (size_t start = 0; start < input_seq_len; start += chunk_size) {
+      const size_t end = std::min(start + chunk_size, input_seq_len);
+      for (size_t batch = 0; batch < batch_input_ids.size(); ++batch) {
+        batch_chunk_ids[batch].assign(batch_input_ids[batch].begin() + start,
+                                      batch_input_ids[batch].begin() + end);
+      }
+      MP_RETURN_IF_ERROR(AddInputTokens(batch_chunk_ids));
+    }
+    return absl::OkStatus();
+  }
+
   RET_CHECK(!batch_prev_ids().empty());
   const size_t current_seq_len = TotalTokenSize();
 
@@ -371,6 +498,17 @@ absl::Status Llm::AddInputTokens(
                    xnn_reshape_external_value(
                        runtime_.get(), value->tensor_id(owned_subgraph_.get()),
                        value->dims.size(), value->dims.data()));
+      if (!kv_cache.k_scale_cache) continue;
+      for (const auto& scale :
+           {kv_cache.k_scale_cache, kv_cache.v_scale_cache}) {
+        scale->Resize({current_seq_len + input_seq_len,
+                       llm_params_.batch_size_B, llm_params_.num_kv_heads, 1});
+        RET_CHECK_EQ(
+            xnn_status_success,
+            xnn_reshape_external_value(
+                runtime_.get(), scale->tensor_id(owned_subgraph_.get()),
+                scale->dims.size(), scale->dims.data()));
+      }
     }
     RET_CHECK_EQ(xnn_status_success, xnn_reshape_runtime(runtime_.get()));
   }
@@ -382,6 +520,11 @@ absl::Status Llm::AddInputTokens(
         0, /*start=*/current_seq_len, /*end=*/current_seq_len + input_seq_len));
     kv_cache.v_slice->Borrow(kv_cache.v_cache->Slice(
         0, /*start=*/current_seq_len, /*end=*/current_seq_len + input_seq_len));
+    if (!kv_cache.k_scale_cache) continue;
+    kv_cache.k_scale_slice->Borrow(kv_cache.k_scale_cache->Slice(
+        0, /*start=*/current_seq_len, /*end=*/current_seq_len + input_seq_len));
+    kv_cache.v_scale_slice->Borrow(kv_cache.v_scale_cache->Slice(
+        0, /*start=*/current_seq_len, /*end=*/current_seq_len + input_seq_len));
   }
 
   MP_RETURN_IF_ERROR(GetInputTokenEmbeddings(batch_input_ids));
@@ -425,6 +568,76 @@ absl::Status Llm::GetNextToken(std::vector<int>* output_ids) {
   return AddInputTokens(next_token_ids);
 }
 
+std::vector<int> Llm::DraftByPromptLookup(absl::Span<const int> ids,
+                                          size_t num_draft_tokens,
+                                          size_t max_ngram_size) {
+  for (size_t ngram_size = std::min(max_ngram_size, ids.size() - 1);
+       ids.size() > 1 && ngram_size > 0; --ngram_size) {
+    const auto suffix = ids.subspan(ids.size() - ngram_size);
+    // Search backwards, excluding the suffix itself.
+    for (size_t start = ids.size() - ngram_size; start-- > 0;) {
+      if (!std::equal(suffix.begin(), suffix.end(), ids.begin() + start)) {
+        continue;
+      }
+      const size_t draft_start = start + ngram_size;
+      const size_t draft_end =
+          std::min(ids.size(), draft_start + num_draft_tokens);
+      return std::vector<int>(ids.begin() + draft_start,
+                              ids.begin() + draft_end);
+    }
+  }
+  return {};
+}
+
+absl::Status Llm::GetNextTokens(std::vector<int>* output_ids) {
+  if (llm_params_.draft_size_G == 0) {
+    return GetNextToken(output_ids);
+  }
+  RET_CHECK_EQ(llm_params_.batch_size_B, 1)
+      << "Speculative decoding only supports batch size 1.";
+
+  MP_ASSIGN_OR_RETURN(auto logits, ComputeLogits());
+  MP_ASSIGN_OR_RETURN(std::vector<std::vector<int>> tokens,
+                      builder_->Sample(*logits));
+  const int first_token = tokens[0][0];
+
+  // Drafts must leave room in the KV cache for the verification pass.
+  const size_t time_step = TotalTokenSize();
+  const size_t reserved = time_step + 1 + llm_params_.draft_size_G;
+  const size_t max_drafts =
+      reserved < llm_params_.seq_size_T
+          ? std::min(llm_params_.draft_size_G,
+                     llm_params_.seq_size_T - reserved - 1)
+          : 0;
+  std::vector<int> context_ids = batch_prev_ids()[0];
+  context_ids.push_back(first_token);
+  std::vector<int> drafts = DraftByPromptLookup(context_ids, max_drafts);
+
+  std::vector<int> input_ids = {first_token};
+  input_ids.insert(input_ids.end(), drafts.begin(), drafts.end());
+  MP_RETURN_IF_ERROR(AddInputTokens({input_ids}));
+  *output_ids = {first_token};
+  if (drafts.empty()) return absl::OkStatus();
+
+  // Position i holds the prediction following input_ids[i].
+  MP_ASSIGN_OR_RETURN(logits, ComputeLogits(input_ids.size()));
+  MP_ASSIGN_OR_RETURN(tokens, builder_->Sample(*logits));
+  const std::vector<int>& predictions = tokens[0];
+  size_t num_accepted = 0;
+  while (num_accepted < drafts.size() &&
+         predictions[num_accepted] == drafts[num_accepted]) {
+    output_ids->push_back(drafts[num_accepted++]);
+  }
+  if (num_accepted == drafts.size()) return absl::OkStatus();
+
+  // Drop the rejected drafts and feed the model's own token in their place,
+  // so that ComputeLogits() continues from the last accepted position.
+  MP_RETURN_IF_ERROR(SeekTimeStep(time_step + 1 + num_accepted));
+  const int correction = predictions[num_accepted];
+  output_ids->push_back(correction);
+  return AddInputTokens({{correction}});
+}
+
 absl::StatusOr<std::shared_ptr<Tensor>> Llm::ComputeLogits(
     size_t expected_seq_len) {
   const size_t decode_step = TotalTokenSize();
@@ -860,6 +1073,15 @@ absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::DotAttention(
   MP_ASSIGN_OR_RETURN(std::shared_ptr<Tensor> query_after_scale,
                       ScaleQuery(query_proj, sa_weights));
 
+  RET_CHECK_EQ(query_after_scale->dims.size(), 4);
+  RET_CHECK_EQ(key_proj->dims.size(), 4);
+  const size_t N = query_after_scale->dims[2];
+  const size_t KV = key_proj->dims[2];
+  if (KV != N) {
+    return GroupedDotAttention(query_after_scale, key_proj, value_proj,
+                               atten_mask);
+  }
+
   // Dot similarity
   // BTNH -> BNTH
   MP_ASSIGN_OR_RETURN(auto query_permuted,
@@ -888,6 +1110,62 @@ absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::DotAttention(
   return Permute(outcome_before_permute, {0, 2, 1, 3});
 }
 
+absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::GroupedDotAttention(
+    std::shared_ptr<Tensor> query_after_scale, std::shared_ptr<Tensor> key_proj,
+    std::shared_ptr<Tensor> value_proj, std::shared_ptr<Tensor> atten_mask) {
+  const size_t B = query_after_scale->dims[0];
+  const size_t N = query_after_scale->dims[2];
+  const size_t KV = key_proj->dims[2];
+  const size_t H = llm_params_.head_dim_H;
+  RET_CHECK_GT(KV, 0);
+  RET_CHECK_EQ(N % KV, 0) << "Query heads must be a multiple of kv heads.";
+  RET_CHECK_EQ(value_proj->dims[2], KV);
+  // The mask is broadcast over all heads, per head masks would need to be
+  // grouped as well.
+  RET_CHECK_LE(atten_mask->dims.size(), 2)
+      << "Per head attention masks require num_kv_heads == n_heads_N.";
+  // Number of query heads sharing one kv head (N = KV * G).
+  const size_t G = N / KV;
+
+  // Query heads of the same group are adjacent, i.e. query head n attends to
+  // kv head n / G. Splitting N into [KV, G] and adding a unit axis to the
+  // key/value lets BatchMatMul broadcast each kv head over its group, without
+  // repeating key/value G times.
+  // BTNH -> BNTH -> [B, KV, G, T, H]
+  MP_ASSIGN_OR_RETURN(auto query_permuted,
+                      Permute(query_after_scale, {0, 2, 1, 3}));
+  MP_ASSIGN_OR_RETURN(auto query_grouped,
+                      Reshape(query_permuted, {B, KV, G, 0, H}));
+  // BSN'H -> BN'SH -> [B, KV, 1, S, H]
+  MP_ASSIGN_OR_RETURN(auto key_permuted, Permute(key_proj, {0, 2, 1, 3}));
+  MP_ASSIGN_OR_RETURN(auto key_grouped,
+                      Reshape(key_permuted, {B, KV, 1, 0, H}));
+  // einsum(BKGTH.BK1SH -> BKGTS)
+  MP_ASSIGN_OR_RETURN(auto logits,
+                      QKVAttention(query_grouped, key_grouped, {0, H}));
+
+  // Cap, mask
+  if (llm_params_.sa_params.soft_cap_value > 0.0f) {
+    MP_ASSIGN_OR_RETURN(logits,
+                        CapTanh(logits, llm_params_.sa_params.soft_cap_value));
+  }
+  MP_ASSIGN_OR_RETURN(auto padded_logits, ElementAdd(atten_mask, logits));
+  MP_ASSIGN_OR_RETURN(auto probs, Softmax(padded_logits));
+  // BSN'H -> BN'HS -> [B, KV, 1, H, S]
+  MP_ASSIGN_OR_RETURN(auto value_permuted, Permute(value_proj, {0, 2, 3, 1}));
+  MP_ASSIGN_OR_RETURN(auto value_grouped,
+                      Reshape(value_permuted, {B, KV, 1, H, 0}));
+
+  // Outcome
+  // einsum(BKGTS.BK1HS) -> BKGTH
+  MP_ASSIGN_OR_RETURN(auto outcome_grouped,
+                      QKVAttention(probs, value_grouped, {H, 0}));
+  // [B, KV, G, T, H] -> BNTH -> BTNH
+  MP_ASSIGN_OR_RETURN(auto outcome_before_permute,
+                      Reshape(outcome_grouped, {B, N, 0, H}));
+  return Permute(outcome_before_permute, {0, 2, 1, 3});
+}
+
 absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::ApplyNorm(
     std::shared_ptr<Tensor> input,
     std::optional<LlmWeights::NormWeights> weights, LlmParams::Norm norm_type) {
@@ -944,35 +1222,88 @@ absl::Status LlmBuilder::BuildKVCache(std::shared_ptr<Tensor>& key,
                           Permute(value, {1, 0, 2, 3}));
     }
 
-    MP_ASSIGN_OR_RETURN(
-        resource.cache->k_cache,
-        NewInput(resource.cache->k_slice->dims, "prefix_k_cache"));
-    MP_ASSIGN_OR_RETURN(
-        resource.cache->v_cache,
-        NewInput(resource.cache->v_slice->dims, "prefix_v_cache"));
-    (resource.cache->k_slice = key)->MarkOutput().tag = "prefix_k_slice";
-    (resource.cache->v_slice = value)->MarkOutput().tag = "prefix_v_slice";
+    std::shared_ptr<Tensor> k_cache, v_cache;
+    if (llm_params_.quantize_kv_cache) {
+      auto& cache = *resource.cache;
+      MP_ASSIGN_OR_RETURN(cache.k_scale_slice, QuantizeKVSlice(cache.k_slice));
+      MP_ASSIGN_OR_RETURN(cache.v_scale_slice, QuantizeKVSlice(cache.v_slice));
+      cache.k_cache = std::make_shared<QTensor>(cache.k_slice->dims);
+      cache.k_cache->AllocateBufferIfNeeded();
+      cache.k_cache->tag = "prefix_k_cache";
+      MP_RETURN_IF_ERROR(MarkInput(cache.k_cache));
+      cache.v_cache = std::make_shared<QTensor>(cache.v_slice->dims);
+      cache.v_cache->AllocateBufferIfNeeded();
+      cache.v_cache->tag = "prefix_v_cache";
+      MP_RETURN_IF_ERROR(MarkInput(cache.v_cache));
+      MP_ASSIGN_OR_RETURN(
+          cache.k_scale_cache,
+          NewInput(cache.k_scale_slice->dims, "prefix_k_scale_cache"));
+      MP_ASSIGN_OR_RETURN(
+          cache.v_scale_cache,
+          NewInput(cache.v_scale_slice->dims, "prefix_v_scale_cache"));
+      cache.k_slice->MarkOutput().tag = "prefix_k_slice";
+      cache.v_slice->MarkOutput().tag = "prefix_v_slice";
+      cache.k_scale_slice->MarkOutput().tag = "prefix_k_scale_slice";
+      cache.v_scale_slice->MarkOutput().tag = "prefix_v_scale_slice";
+
+      MP_ASSIGN_OR_RETURN(k_cache, Dequantize(cache.k_cache));
+      MP_ASSIGN_OR_RETURN(k_cache, ElementMul(k_cache, cache.k_scale_cache));
+      MP_ASSIGN_OR_RETURN(v_cache, Dequantize(cache.v_cache));
+      MP_ASSIGN_OR_RETURN(v_cache, ElementMul(v_cache, cache.v_scale_cache));
+    } else {
+      MP_ASSIGN_OR_RETURN(
+          resource.cache->k_cache,
+          NewInput(resource.cache->k_slice->dims, "prefix_k_cache"));
+      MP_ASSIGN_OR_RETURN(
+          resource.cache->v_cache,
+          NewInput(resource.cache->v_slice->dims, "prefix_v_cache"));
+      (resource.cache->k_slice = key)->MarkOutput().tag = "prefix_k_slice";
+      (resource.cache->v_slice = value)->MarkOutput().tag = "prefix_v_slice";
+      k_cache = resource.cache->k_cache;
+      v_cache = resource.cache->v_cache;
+    }
 
     // TBNH -> BTNH
     if (quick_reshape) {
       MP_ASSIGN_OR_RETURN(
-          key, Reshape(resource.cache->k_cache,
-                       {llm_params_.batch_size_B, 0, llm_params_.num_kv_heads,
-                        llm_params_.head_dim_H}));
+          key, Reshape(k_cache, {llm_params_.batch_size_B, 0,
+                                 llm_params_.num_kv_heads,
+                                 llm_params_.head_dim_H}));
       MP_ASSIGN_OR_RETURN(
-          value, Reshape(resource.cache->v_cache,
-                         {llm_params_.batch_size_B, 0, llm_params_.num_kv_heads,
-                          llm_params_.head_dim_H}));
+          value, Reshape(v_cache, {llm_params_.batch_size_B, 0,
+                                   llm_params_.num_kv_heads,
+                                   llm_params_.head_dim_H}));
     } else {
       // TODO - b/329445989: Consolidate this permute with DotAttention.
-      MP_ASSIGN_OR_RETURN(key, Permute(resource.cache->k_cache, {1, 0, 2, 3}));
-      MP_ASSIGN_OR_RETURN(value,
-                          Permute(resource.cache->v_cache, {1, 0, 2, 3}));
+      MP_ASSIGN_OR_RETURN(key, Permute(k_cache, {1, 0, 2, 3}));
+      MP_ASSIGN_OR_RETURN(value, Permute(v_cache, {1, 0, 2, 3}));
     }
   }
 
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::shared_ptr<Tensor>> LlmBuilder::QuantizeKVSlice(
+    std::shared_ptr<Tensor>& slice) {
+  // XNNPack has no max reduction to get the absmax of each head, use the L4
+  // norm instead: it bounds the absmax, and is at most H^(1/4) times larger
+  // than it, which is a lot tighter than the L2 norm.
+  MP_ASSIGN_OR_RETURN(auto square, Square(slice));
+  MP_ASSIGN_OR_RETURN(auto quartic, Square(square));
+  MP_ASSIGN_OR_RETURN(auto mean, AvgLastDim(quartic));
+  MP_ASSIGN_OR_RETURN(auto root, SquareRoot(mean));
+  MP_ASSIGN_OR_RETURN(auto root_mean_quartic, SquareRoot(root));
+  const float to_scale =
+      std::pow(static_cast<float>(llm_params_.head_dim_H), 0.25f) / 127.0f;
+  // Clamp so that all-zero heads don't divide by zero.
+  MP_ASSIGN_OR_RETURN(
+      auto scale,
+      ElementMul(root_mean_quartic, to_scale,
+                 {.out_min = std::numeric_limits<float>::min()}));
+  MP_ASSIGN_OR_RETURN(auto normalized, ElementDiv(slice, scale));
+  MP_ASSIGN_OR_RETURN(slice, QuantizeInt8(normalized));
+  return scale;
+}
+
 }  // namespace xnn_utils
 }  // namespace mediapipe::tasks::genai
@@ -63,6 +63,12 @@ class Llm : protected xnn_utils::XnnGraph {
     std::shared_ptr<Tensor> v_cache;
     std::shared_ptr<Tensor> k_slice;
     std::shared_ptr<Tensor> v_slice;
+    // Enable if quantize_kv_cache. The caches above are int8, these hold one
+    // float scale per token and head, laid out as [S, B, N, 1].
+    std::shared_ptr<Tensor> k_scale_cache;
+    std::shared_ptr<Tensor> v_scale_cache;
+    std::shared_ptr<Tensor> k_scale_slice;
+    std::shared_ptr<Tensor> v_scale_slice;
   };
 
   // An aggregation of all the data that can represent the context of the
@@ -108,7 +114,14 @@ class Llm : protected xnn_utils::XnnGraph {
       std::unique_ptr<LlmWeightsLoader> weight_loader,
       std::unique_ptr<LlmBuilder> builder);
 
-  // Add input token ids at the end of all previously added tokens.
+  // Add input token ids at the end of all previously added tokens. If
+  // `llm_params.prefill_chunk_size` is set, long inputs are run in chunks, and
+  // ComputeLogits() afterwards covers the tokens of the last chunk only.
+  //
+  // Callers that want to interleave a long prefill with the work of other
+  // contexts can instead pass the input in slices of their own, calling
+  // LoadContext() before each slice; the KV cache of a context carries over
+  // from one call to the next.
   virtual absl::Status AddInputTokens(
       absl::Span<const std::vector<int>> batch_input_ids);
 
@@ -122,6 +135,22 @@ class Llm : protected xnn_utils::XnnGraph {
   ABSL_DEPRECATED("Use ComputeLogits() and do your own sampling.")
   virtual absl::Status GetNextToken(std::vector<int>* output_ids);
 
+  // Speculative variant of GetNextToken() for batch size 1, enabled by
+  // `llm_params.draft_size_G` > 0. Up to draft_size_G tokens are drafted by
+  // prompt lookup, i.e. by copying what followed the most recent earlier
+  // occurrence of the last few tokens, and verified in a single forward pass.
+  // Drafts are accepted while they match the token sampled at their position,
+  // which keeps the output distribution of the sampler unchanged. Returns the
+  // accepted ids, at least one, which are also added as input tokens.
+  virtual absl::Status GetNextTokens(std::vector<int>* output_ids);
+
+  // Returns up to `num_draft_tokens` ids that followed the most recent earlier
+  // occurrence of the longest suffix of `ids`, trying suffixes of at most
+  // `max_ngram_size` ids.
+  static std::vector<int> DraftByPromptLookup(absl::Span<const int> ids,
+                                              size_t num_draft_tokens,
+                                              size_t max_ngram_size = 3);
+
   // Computes logits with all previously added tokens. Output is in shape of
   // [batch_B, expected_seq_len, vacab_size_V] representing the last
   // `expected_seq_len` along the sequence dimension.
@@ -140,8 +169,14 @@ class Llm : protected xnn_utils::XnnGraph {
   // context will have proper batch size, sequence length, etc.
   virtual absl::StatusOr<Context> NewContext() const;
 
+  // Create a context that continues from `context`, e.g. to branch a
+  // conversation. Only the time steps in use are copied from the KV cache, and
+  // `context` may be the one currently loaded.
+  virtual absl::StatusOr<Context> CloneContext(const Context& context) const;
+
   // If `context` is non-null, and different from existing context_, load the
-  // context into the model.
+  // context into the model. The previously loaded context keeps its KV cache
+  // and can be loaded again.
   virtual absl::Status LoadContext(
       absl::Nullable<std::shared_ptr<Context>> context);
 
@@ -352,6 +387,15 @@ class LlmBuilder : protected XnnGraphBuilder {
       std::shared_ptr<Tensor> value_proj, std::shared_ptr<Tensor> atten_mask,
       const LlmWeights::SelfAttentionWeights& sa_weights);
 
+  // DotAttention for multi-query and grouped-query attention, i.e. for key and
+  // value projections with fewer heads than the query. Each kv head is
+  // broadcast to the query heads of its group inside the attention matmuls.
+  // Expects the scaled query projection.
+  absl::StatusOr<std::shared_ptr<Tensor>> GroupedDotAttention(
+      std::shared_ptr<Tensor> query_after_scale,
+      std::shared_ptr<Tensor> key_proj, std::shared_ptr<Tensor> value_proj,
+      std::shared_ptr<Tensor> atten_mask);
+
   virtual absl::StatusOr<std::shared_ptr<Tensor>> SelfAttentionExcludeNorm(
       std::shared_ptr<Tensor> input, InputResource resource,
       const LlmWeights::SelfAttentionWeights& sa_weights);
@@ -364,6 +408,11 @@ class LlmBuilder : protected XnnGraphBuilder {
                             std::shared_ptr<Tensor>& value,
                             InputResource& resource);
 
+  // Quantizes `slice` [S, B, N, H] to int8 with one scale per token and head.
+  // Returns the scales [S, B, N, 1], `slice` is replaced by the int8 tensor.
+  absl::StatusOr<std::shared_ptr<Tensor>> QuantizeKVSlice(
+      std::shared_ptr<Tensor>& slice);
+
   LlmParams llm_params_;
   Llm::InternalLlmParams internal_llm_params_;
 
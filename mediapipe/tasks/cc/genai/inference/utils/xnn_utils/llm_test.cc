@@ -15,6 +15,7 @@
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/llm.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -37,6 +38,7 @@
 #include "mediapipe/framework/port/benchmark.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/framework/port/status_matchers.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/llm_params.pb.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/well_known_models.h"
@@ -59,6 +61,9 @@ ABSL_FLAG(std::string, model_type, "GEMMA_2B",
 
 ABSL_FLAG(int, num_threads, 4, "The number of threads to use");
 
+ABSL_FLAG(int, prefill_chunk_size, 0,
+          "If non-zero, the maximum number of prompt tokens per prefill run.");
+
 namespace mediapipe::tasks::genai::xnn_utils {
 namespace {
 
@@ -87,6 +92,7 @@ GetLlmBuilderAndParamsForBenchmark(size_t seq_size) {
     params.seq_size_T = seq_size;
     params.enable_kv_cache = true;
     params.enable_dynamic_shape = true;
+    params.prefill_chunk_size = absl::GetFlag(FLAGS_prefill_chunk_size);
     return {std::make_unique<FalconRW1BBuilder>(
                 params, GetRunTimeConfigsForBenchmark()),
             params};
@@ -96,6 +102,7 @@ GetLlmBuilderAndParamsForBenchmark(size_t seq_size) {
     params.seq_size_T = seq_size;
     params.enable_kv_cache = true;
     params.enable_dynamic_shape = true;
+    params.prefill_chunk_size = absl::GetFlag(FLAGS_prefill_chunk_size);
     return {
         std::make_unique<LlmBuilder>(params, GetRunTimeConfigsForBenchmark()),
         params};
@@ -105,6 +112,7 @@ GetLlmBuilderAndParamsForBenchmark(size_t seq_size) {
     params.seq_size_T = seq_size;
     params.enable_kv_cache = true;
     params.enable_dynamic_shape = true;
+    params.prefill_chunk_size = absl::GetFlag(FLAGS_prefill_chunk_size);
     return {std::make_unique<Stablelm4E1T3BBuilder>(
                 params, GetRunTimeConfigsForBenchmark()),
             params};
@@ -114,6 +122,7 @@ GetLlmBuilderAndParamsForBenchmark(size_t seq_size) {
     params.seq_size_T = seq_size;
     params.enable_kv_cache = true;
     params.enable_dynamic_shape = true;
+    params.prefill_chunk_size = absl::GetFlag(FLAGS_prefill_chunk_size);
     return {
         std::make_unique<Phi2Builder>(params, GetRunTimeConfigsForBenchmark()),
         params};
@@ -216,6 +225,421 @@ class BenchmarkLlmMixedInt48WeightsLoader : public LlmWeightsLoader {
   }
 };
 
+// Returns the parameters of a small model for tests.
+LlmParams SmallLlmParamsForTest(size_t prefill_chunk_size = 0) {
+  LlmParams params;
+  params.num_transformer_M = 2;
+  params.batch_size_B = 1;
+  params.seq_size_T = 64;
+  params.model_dim_D = 32;
+  params.hidden_dim_HD = 64;
+  params.head_dim_H = 8;
+  params.n_heads_N = 4;
+  params.num_kv_heads = 4;
+  params.voc_size_V = 128;
+  params.skip_absolute_positional_embeddings = true;
+  params.sa_params.attention_scale_type =
+      LlmParams::AttentionScaleType::INV_SQRT_HEAD_DIM;
+  params.ff_params.activation = LlmParams::Activation::GELU;
+  params.enable_kv_cache = true;
+  params.enable_dynamic_shape = true;
+  params.prefill_chunk_size = prefill_chunk_size;
+  return params;
+}
+
+// Returns a small fp32 model with random but fixed weights, so that models
+// created by separate calls compute the same function.
+std::unique_ptr<Llm> CreateSmallLlmForTest(size_t prefill_chunk_size = 0) {
+  const LlmParams params = SmallLlmParamsForTest(prefill_chunk_size);
+  auto llm = Llm::CreateLlm(
+      std::make_unique<BenchmarkLlmWeightsLoader>(params, xnn_datatype_fp32,
+                                                  /*seed=*/0),
+      std::make_unique<LlmBuilder>(params, std::make_unique<RuntimeConfigs>()));
+  ABSL_CHECK_OK(llm);
+  return *std::move(llm);
+}
+
+std::vector<int> TokenIdsForTest(size_t size, int offset) {
+  std::vector<int> ids(size);
+  for (size_t i = 0; i < size; ++i) {
+    ids[i] = (offset + 37 * i) % 128;
+  }
+  return ids;
+}
+
+std::vector<float> ToFloatVector(const Tensor& tensor) {
+  const float* data = tensor.DataAs<float>();
+  return std::vector<float>(data, data + tensor.num_elements);
+}
+
+// The ids picked by greedy decoding, and the logits they were picked from.
+struct GreedyDecoding {
+  std::vector<int> ids;
+  std::vector<std::vector<float>> logits;
+};
+
+// Decodes `num_steps` tokens greedily from the loaded context.
+absl::StatusOr<GreedyDecoding> DecodeGreedily(Llm& llm, size_t num_steps) {
+  GreedyDecoding decoding;
+  for (size_t step = 0; step < num_steps; ++step) {
+    MP_ASSIGN_OR_RETURN(std::shared_ptr<Tensor> logits, llm.ComputeLogits());
+    decoding.logits.push_back(ToFloatVector(*logits));
+    const std::vector<float>& last = decoding.logits.back();
+    decoding.ids.push_back(static_cast<int>(
+        std::max_element(last.begin(), last.end()) - last.begin()));
+    MP_RETURN_IF_ERROR(llm.AddInputTokens({{decoding.ids.back()}}));
+  }
+  return decoding;
+}
+
+void ExpectSameDecoding(const GreedyDecoding& actual,
+                        const GreedyDecoding& expected) {
+  EXPECT_EQ(actual.ids, expected.ids);
+  ASSERT_EQ(actual.logits.size(), expected.logits.size());
+  for (size_t step = 0; step < actual.logits.size(); ++step) {
+    EXPECT_THAT(actual.logits[step],
+                ::testing::Pointwise(::testing::FloatNear(1e-4),
+                                     expected.logits[step]))
+        << "step " << step;
+  }
+}
+
+// The CPU inference engine starts a session from a copy of the context of an
+// earlier prompt sharing a prefix with it, and prefills only the rest.
+TEST(LlmTest, PrefillAfterCachedPrefixMatchesFullPrefill) {
+  std::unique_ptr<Llm> llm = CreateSmallLlmForTest();
+  constexpr size_t kNumSharedTokens = 10;
+  const std::vector<int> shared_ids = TokenIdsForTest(kNumSharedTokens, 1);
+  std::vector<int> cached_prompt = shared_ids;
+  for (int id : TokenIdsForTest(5, 2)) cached_prompt.push_back(id);
+  std::vector<int> prompt = shared_ids;
+  for (int id : TokenIdsForTest(7, 3)) prompt.push_back(id);
+
+  MP_ASSERT_OK_AND_ASSIGN(Llm::Context context, llm->NewContext());
+  auto uncached = std::make_shared<Llm::Context>(std::move(context));
+  MP_ASSERT_OK(llm->LoadContext(uncached));
+  MP_ASSERT_OK(llm->AddInputTokens({prompt}));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding expected,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+
+  MP_ASSERT_OK_AND_ASSIGN(context, llm->NewContext());
+  auto earlier = std::make_shared<Llm::Context>(std::move(context));
+  MP_ASSERT_OK(llm->LoadContext(earlier));
+  MP_ASSERT_OK(llm->AddInputTokens({cached_prompt}));
+  MP_ASSERT_OK_AND_ASSIGN(Llm::Context cache, llm->CloneContext(*earlier));
+
+  MP_ASSERT_OK_AND_ASSIGN(context, llm->CloneContext(cache));
+  auto cached = std::make_shared<Llm::Context>(std::move(context));
+  MP_ASSERT_OK(llm->LoadContext(cached));
+  MP_ASSERT_OK(llm->SeekTimeStep(kNumSharedTokens));
+  MP_ASSERT_OK(llm->AddInputTokens({std::vector<int>(
+      prompt.begin() + kNumSharedTokens, prompt.end())}));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding actual,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+
+  ExpectSameDecoding(actual, expected);
+  EXPECT_EQ(cached->batch_prev_ids, uncached->batch_prev_ids);
+}
+
+// Prefills a new context with `prompt`, loads it and returns it.
+absl::StatusOr<std::shared_ptr<Llm::Context>> PrefillNewContext(
+    Llm& llm, const std::vector<int>& prompt) {
+  MP_ASSIGN_OR_RETURN(Llm::Context context, llm.NewContext());
+  auto shared_context = std::make_shared<Llm::Context>(std::move(context));
+  MP_RETURN_IF_ERROR(llm.LoadContext(shared_context));
+  MP_RETURN_IF_ERROR(llm.AddInputTokens({prompt}));
+  return shared_context;
+}
+
+// Cloned sessions continue from a copy of the context. Each branch then
+// decodes as if the other did not exist, also when they take turns.
+TEST(LlmTest, ClonedContextBranchesIndependently) {
+  std::unique_ptr<Llm> llm = CreateSmallLlmForTest();
+  const std::vector<int> prompt = TokenIdsForTest(9, 1);
+  const std::vector<int> branch_ids = TokenIdsForTest(3, 5);
+  std::vector<int> branched_prompt = prompt;
+  for (int id : branch_ids) branched_prompt.push_back(id);
+
+  MP_ASSERT_OK(PrefillNewContext(*llm, prompt).status());
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding expected,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+  MP_ASSERT_OK(PrefillNewContext(*llm, branched_prompt).status());
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding expected_branch,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+
+  MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Llm::Context> original,
+                          PrefillNewContext(*llm, prompt));
+  MP_ASSERT_OK_AND_ASSIGN(Llm::Context context, llm->CloneContext(*original));
+  auto branch = std::make_shared<Llm::Context>(std::move(context));
+  EXPECT_EQ(branch->batch_prev_ids, original->batch_prev_ids);
+
+  MP_ASSERT_OK(llm->LoadContext(branch));
+  MP_ASSERT_OK(llm->AddInputTokens({branch_ids}));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding branch_start,
+                          DecodeGreedily(*llm, /*num_steps=*/2));
+  MP_ASSERT_OK(llm->LoadContext(original));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding actual,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+  MP_ASSERT_OK(llm->LoadContext(branch));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding branch_end,
+                          DecodeGreedily(*llm, /*num_steps=*/2));
+
+  ExpectSameDecoding(actual, expected);
+  GreedyDecoding actual_branch = branch_start;
+  for (size_t step = 0; step < branch_end.ids.size(); ++step) {
+    actual_branch.ids.push_back(branch_end.ids[step]);
+    actual_branch.logits.push_back(branch_end.logits[step]);
+  }
+  ExpectSameDecoding(actual_branch, expected_branch);
+}
+
+// Loads the random weights of a model with `num_kv_heads` shared K/V heads for
+// a model with one K/V head per query head. Each shared head is repeated for
+// the group of query heads that attend with it.
+class RepeatedKvHeadsWeightAccessor : public BenchmarkWeightAccessor {
+ public:
+  RepeatedKvHeadsWeightAccessor(const LlmParams& params, size_t num_kv_heads,
+                                int seed)
+      : BenchmarkWeightAccessor(xnn_datatype_fp32, seed),
+        num_heads_(params.n_heads_N),
+        num_kv_heads_(num_kv_heads),
+        head_dim_(params.head_dim_H) {}
+
+  using BenchmarkWeightAccessor::LoadWeight;
+  absl::StatusOr<std::shared_ptr<Tensor>> LoadWeight(
+      absl::string_view prefix, Tensor::DimsType dims,
+      size_t dim_scale_if_any) const override {
+    if (!absl::EndsWith(prefix, ".k.w") && !absl::EndsWith(prefix, ".v.w")) {
+      return BenchmarkWeightAccessor::LoadWeight(prefix, dims,
+                                                 dim_scale_if_any);
+    }
+    // Projections are loaded transposed, as [N * H, D].
+    const size_t head_size = head_dim_ * dims[1];
+    MP_ASSIGN_OR_RETURN(std::shared_ptr<Tensor> shared,
+                        BenchmarkWeightAccessor::LoadWeight(
+                            prefix, {num_kv_heads_ * head_dim_, dims[1]},
+                            dim_scale_if_any));
+    const float* shared_data = shared->DataAs<float>();
+    std::vector<float> data(num_heads_ * head_size);
+    const size_t group_size = num_heads_ / num_kv_heads_;
+    for (size_t n = 0; n < num_heads_; ++n) {
+      std::copy_n(shared_data + (n / group_size) * head_size, head_size,
+                  data.data() + n * head_size);
+    }
+    auto result = std::make_shared<Tensor>(dims, xnn_datatype_fp32);
+    MP_RETURN_IF_ERROR(result->LoadFromBuffer(data.data()));
+    return result;
+  }
+
+ private:
+  size_t num_heads_;
+  size_t num_kv_heads_;
+  size_t head_dim_;
+};
+
+TEST(LlmTest, SharedKvHeadsMatchRepeatedKvHeads) {
+  const std::vector<int> prompt = TokenIdsForTest(11, 1);
+  // Grouped-query attention, and multi-query attention with a single head.
+  for (const size_t num_kv_heads : {2, 1}) {
+    SCOPED_TRACE(::testing::Message() << "kv heads " << num_kv_heads);
+    LlmParams params = SmallLlmParamsForTest();
+    params.sa_params.qkv_no_bias = true;
+    LlmParams shared_params = params;
+    shared_params.num_kv_heads = num_kv_heads;
+
+    MP_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<Llm> shared_llm,
+        Llm::CreateLlm(
+            std::make_unique<BenchmarkLlmWeightsLoader>(
+                shared_params, xnn_datatype_fp32, /*seed=*/0),
+            std::make_unique<LlmBuilder>(shared_params,
+                                         std::make_unique<RuntimeConfigs>())));
+    MP_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<Llm> repeated_llm,
+        Llm::CreateLlm(
+            std::make_unique<LlmWeightsLoader>(
+                std::make_unique<RepeatedKvHeadsWeightAccessor>(
+                    params, num_kv_heads, /*seed=*/0),
+                params),
+            std::make_unique<LlmBuilder>(params,
+                                         std::make_unique<RuntimeConfigs>())));
+
+    MP_ASSERT_OK(shared_llm->SeekTimeStep(0));
+    MP_ASSERT_OK(shared_llm->AddInputTokens({prompt}));
+    MP_ASSERT_OK(repeated_llm->SeekTimeStep(0));
+    MP_ASSERT_OK(repeated_llm->AddInputTokens({prompt}));
+    // The cache holds only the shared heads, laid out as [T, B, N', H].
+    ASSERT_FALSE(shared_llm->kv_cache().empty());
+    EXPECT_EQ(shared_llm->kv_cache()[0].k_cache->dims[2], num_kv_heads);
+    EXPECT_EQ(shared_llm->kv_cache()[0].v_cache->dims[2], num_kv_heads);
+
+    MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding expected,
+                            DecodeGreedily(*repeated_llm, /*num_steps=*/4));
+    MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding actual,
+                            DecodeGreedily(*shared_llm, /*num_steps=*/4));
+    ExpectSameDecoding(actual, expected);
+  }
+}
+
+// Returns the first `num_tokens` time steps of the keys and values cached by
+// each layer, which are laid out as [T, B, N, H].
+std::vector<std::vector<float>> CachedKeysAndValues(const Llm& llm,
+                                                    size_t num_tokens) {
+  std::vector<std::vector<float>> caches;
+  for (const Llm::KVCache& kv : llm.kv_cache()) {
+    for (const Tensor* cache : {kv.k_cache.get(), kv.v_cache.get()}) {
+      const size_t num_elements =
+          num_tokens * cache->num_elements / cache->dims[0];
+      const float* data = cache->DataAs<float>();
+      caches.emplace_back(data, data + num_elements);
+    }
+  }
+  return caches;
+}
+
+TEST(LlmTest, ChunkedPrefillMatchesSinglePrefill) {
+  // 13 tokens run in chunks of 5, 5 and 3.
+  const std::vector<int> prompt = TokenIdsForTest(13, 1);
+  std::unique_ptr<Llm> llm = CreateSmallLlmForTest();
+  std::unique_ptr<Llm> chunked_llm =
+      CreateSmallLlmForTest(/*prefill_chunk_size=*/5);
+
+  MP_ASSERT_OK(llm->SeekTimeStep(0));
+  MP_ASSERT_OK(llm->AddInputTokens({prompt}));
+  MP_ASSERT_OK(chunked_llm->SeekTimeStep(0));
+  MP_ASSERT_OK(chunked_llm->AddInputTokens({prompt}));
+
+  EXPECT_EQ(chunked_llm->TotalTokenSize(), prompt.size());
+  const std::vector<std::vector<float>> expected_caches =
+      CachedKeysAndValues(*llm, prompt.size());
+  const std::vector<std::vector<float>> caches =
+      CachedKeysAndValues(*chunked_llm, prompt.size());
+  ASSERT_EQ(caches.size(), expected_caches.size());
+  for (size_t i = 0; i < caches.size(); ++i) {
+    EXPECT_THAT(caches[i], ::testing::Pointwise(::testing::FloatNear(1e-4),
+                                                expected_caches[i]))
+        << "cache " << i;
+  }
+
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding expected,
+                          DecodeGreedily(*llm, /*num_steps=*/4));
+  MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding actual,
+                          DecodeGreedily(*chunked_llm, /*num_steps=*/4));
+  ExpectSameDecoding(actual, expected);
+}
+
+// Returns the L2 norm of `actual - expected` relative to that of `expected`.
+float RelativeL2Error(const std::vector<float>& actual,
+                      const std::vector<float>& expected) {
+  ABSL_CHECK_EQ(actual.size(), expected.size());
+  double error = 0, norm = 0;
+  for (size_t i = 0; i < expected.size(); ++i) {
+    error += (actual[i] - expected[i]) * (actual[i] - expected[i]);
+    norm += expected[i] * expected[i];
+  }
+  return std::sqrt(error / norm);
+}
+
+TEST(LlmTest, QuantizedKvCacheIsCloseToFloatCache) {
+  const LlmParams params = SmallLlmParamsForTest();
+  LlmParams quantized_params = params;
+  quantized_params.quantize_kv_cache = true;
+  auto create_llm = [](const LlmParams& params) {
+    auto llm = Llm::CreateLlm(
+        std::make_unique<BenchmarkLlmWeightsLoader>(params, xnn_datatype_fp32,
+                                                    /*seed=*/0),
+        std::make_unique<LlmBuilder>(params,
+                                     std::make_unique<RuntimeConfigs>()));
+    ABSL_CHECK_OK(llm);
+    return *std::move(llm);
+  };
+  std::unique_ptr<Llm> llm = create_llm(params);
+  std::unique_ptr<Llm> quantized_llm = create_llm(quantized_params);
+
+  for (const Llm::KVCache& kv : quantized_llm->kv_cache()) {
+    EXPECT_EQ(kv.k_cache->datatype, xnn_datatype_qint8);
+    EXPECT_EQ(kv.v_cache->datatype, xnn_datatype_qint8);
+    EXPECT_NE(kv.k_scale_cache, nullptr);
+    EXPECT_NE(kv.v_scale_cache, nullptr);
+  }
+
+  // An odd prompt length, so the prefill is not a multiple of a vector width.
+  const std::vector<int> prompt = TokenIdsForTest(11, 1);
+  MP_ASSERT_OK(llm->SeekTimeStep(0));
+  MP_ASSERT_OK(llm->AddInputTokens({prompt}));
+  MP_ASSERT_OK(quantized_llm->SeekTimeStep(0));
+  MP_ASSERT_OK(quantized_llm->AddInputTokens({prompt}));
+
+  // Both models are fed the ids the fp32 model picks, so that a near tie
+  // flipped by the quantization error does not make the inputs diverge.
+  for (int step = 0; step < 6; ++step) {
+    MP_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Tensor> logits,
+                            llm->ComputeLogits());
+    const std::vector<float> expected = ToFloatVector(*logits);
+    MP_ASSERT_OK_AND_ASSIGN(logits, quantized_llm->ComputeLogits());
+    const std::vector<float> actual = ToFloatVector(*logits);
+    EXPECT_LT(RelativeL2Error(actual, expected), 0.05f) << "step " << step;
+
+    const int id = static_cast<int>(
+        std::max_element(expected.begin(), expected.end()) - expected.begin());
+    MP_ASSERT_OK(llm->AddInputTokens({{id}}));
+    MP_ASSERT_OK(quantized_llm->AddInputTokens({{id}}));
+  }
+}
+
+// The CPU inference engine decodes its active sessions in rounds of one step
+// each, loading each session's context before its step. Sessions are
+// prefilled when they join between rounds and leave when they are done.
+TEST(LlmTest, InterleavedContextsMatchSequentialDecoding) {
+  std::unique_ptr<Llm> llm = CreateSmallLlmForTest();
+  const std::vector<int> prompts[] = {TokenIdsForTest(7, 1),
+                                      TokenIdsForTest(12, 2)};
+  // The second session joins while the first is decoding, and leaves first.
+  constexpr size_t kJoinRound[] = {0, 2};
+  constexpr size_t kNumSteps[] = {6, 3};
+  constexpr size_t kNumRounds = 6;
+
+  std::vector<GreedyDecoding> expected;
+  for (int i = 0; i < 2; ++i) {
+    MP_ASSERT_OK_AND_ASSIGN(Llm::Context context, llm->NewContext());
+    MP_ASSERT_OK(
+        llm->LoadContext(std::make_shared<Llm::Context>(std::move(context))));
+    MP_ASSERT_OK(llm->AddInputTokens({prompts[i]}));
+    MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding decoding,
+                            DecodeGreedily(*llm, kNumSteps[i]));
+    expected.push_back(std::move(decoding));
+  }
+
+  std::vector<std::shared_ptr<Llm::Context>> contexts(2);
+  std::vector<GreedyDecoding> actual(2);
+  for (size_t round = 0; round < kNumRounds; ++round) {
+    for (int i = 0; i < 2; ++i) {
+      if (round != kJoinRound[i]) continue;
+      MP_ASSERT_OK_AND_ASSIGN(Llm::Context context, llm->NewContext());
+      contexts[i] = std::make_shared<Llm::Context>(std::move(context));
+      MP_ASSERT_OK(llm->LoadContext(contexts[i]));
+      MP_ASSERT_OK(llm->AddInputTokens({prompts[i]}));
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (round < kJoinRound[i] || round >= kJoinRound[i] + kNumSteps[i]) {
+        continue;
+      }
+      MP_ASSERT_OK(llm->LoadContext(contexts[i]));
+      MP_ASSERT_OK_AND_ASSIGN(GreedyDecoding step,
+                              DecodeGreedily(*llm, /*num_steps=*/1));
+      actual[i].ids.push_back(step.ids[0]);
+      actual[i].logits.push_back(std::move(step.logits[0]));
+    }
+  }
+
+  for (int i = 0; i < 2; ++i) {
+    SCOPED_TRACE(::testing::Message() << "session " << i);
+    ExpectSameDecoding(actual[i], expected[i]);
+    EXPECT_EQ(contexts[i]->batch_prev_ids[0].size(),
+              prompts[i].size() + kNumSteps[i]);
+  }
+}
+
 }  // namespace
 
 // Benchmark LLM model specified by --model_type flag (QC8 weights, all
@@ -25,6 +25,7 @@
 
 #include "absl/base/attributes.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/tasks/cc/genai/inference/proto/llm_params.pb.h"
@@ -142,6 +143,19 @@ struct LlmParams {
   bool enable_dynamic_shape ABSL_DEPRECATED(
       "This is always enabled if enable_kv_cache is true.") = false;
 
+  // If non-zero and `enable_kv_cache` is true, Llm::AddInputTokens() splits
+  // inputs longer than this into chunks of at most this many tokens and runs
+  // them one after the other, each chunk attending to the KV cache written by
+  // the previous ones. This bounds the activation memory of the prefix graph
+  // for long prompts.
+  size_t prefill_chunk_size = 0;
+
+  // If true and `enable_kv_cache` is true, keys and values are stored in the
+  // KV cache as int8 with one float scale per token and head, and dequantized
+  // before attention. This cuts the cache memory by close to 4x, at the cost of
+  // a small quantization error.
+  bool quantize_kv_cache = false;
+
   // If provided, the runtime will prepare cache at the provided directory.
   // Otherwise, cache will be prepared besides the original model.
   std::string cache_dir;
@@ -234,6 +248,13 @@ class LlmWeightsLoader {
 
   virtual absl::StatusOr<LlmWeights> LoadWeights();
 
+  // Hints that the loaded weights were packed by XNNPack and are not accessed
+  // soon, see WeightAccessor::ReleaseResidentMemory().
+  absl::Status ReleaseResidentMemory() {
+    if (!weight_accessor_) return absl::OkStatus();
+    return weight_accessor_->ReleaseResidentMemory();
+  }
+
   LlmParams& llm_params() { return params_; }
   const LlmParams& llm_params() const { return params_; }
 
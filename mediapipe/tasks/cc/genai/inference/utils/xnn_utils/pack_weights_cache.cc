@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
@@ -29,9 +30,11 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "flatbuffers/buffer.h"
 #include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/verifier.h"
 #include "mediapipe/framework/port/file_helpers.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
@@ -53,7 +56,8 @@ bool operator==(const xnn_weights_cache_look_up_key& lhs,
 }  // namespace
 
 PackWeightsCache::PackWeightsCache(absl::string_view cache_path)
-    : cache_path_(cache_path) {
+    : cache_path_(cache_path),
+      building_path_(absl::StrCat(cache_path, ".tmp")) {
   xnn_weights_cache = &cache_provider_;
 }
 
@@ -61,9 +65,16 @@ PackWeightsCache::~PackWeightsCache() { xnn_weights_cache = nullptr; }
 
 absl::Status PackWeightsCache::Initialize() {
   mmap_file_ = GetMmapFile(cache_path_);
+  if (mmap_file_ && !IsValidCache(*mmap_file_)) {
+    ABSL_LOG(WARNING) << "Discarding invalid weights cache " << cache_path_;
+    mmap_file_.reset();
+  }
   if (mmap_file_) {
     MP_RETURN_IF_ERROR(InitializeFromCache(mmap_file_));
   } else {
+    // Drop whatever an interrupted build left behind, since packed weights
+    // are appended to it.
+    MP_RETURN_IF_ERROR(Remove(building_path_));
     builder_ = std::make_unique<flatbuffers::FlatBufferBuilder>();
   }
 
@@ -131,6 +142,7 @@ absl::Status PackWeightsCache::Finalize() {
   }
 
   MP_RETURN_IF_ERROR(Prepend(serialized));
+  MP_RETURN_IF_ERROR(Rename(building_path_, cache_path_));
   builder_.reset();
 
   mmap_file_ = GetMmapFile(cache_path_);
@@ -177,10 +189,39 @@ absl::Status PackWeightsCache::InitializeFromCache(
     name_to_offset_size_[name] =
         std::make_pair(buffer->offset(), buffer->size());
   }
+  // Packed weights are stored in graph order, which every run traverses layer
+  // by layer. Let the OS read ahead into the next layers and reclaim the
+  // consumed ones first rather than keeping all layers resident.
+  absl::Status advise_status =
+      mmap_cache->Advise(llm_utils::MemoryMappedFile::Advice::kSequential);
+  if (!advise_status.ok()) {
+    ABSL_LOG(WARNING) << "Failed to advise packed weights access: "
+                      << advise_status;
+  }
   is_finalized_ = true;
   return absl::OkStatus();
 }
 
+bool PackWeightsCache::IsValidCache(
+    llm_utils::MemoryMappedFile& mmap_cache) {
+  const auto* data = static_cast<const uint8_t*>(mmap_cache.data());
+  const size_t length = mmap_cache.length();
+  if (!data || length == 0) return false;
+  flatbuffers::Verifier verifier(data, length);
+  if (!VerifyNamedBuffersBuffer(verifier)) return false;
+  const NamedBuffers* named_buffers = GetNamedBuffers(data);
+  if (!named_buffers->buffers() || named_buffers->flatbuffer_size() > length) {
+    return false;
+  }
+  for (const Buffer* buffer : *named_buffers->buffers()) {
+    if (!buffer->name()) return false;
+    // Packed weights are used in place, so they must lie within the file.
+    const uint64_t begin = named_buffers->flatbuffer_size() + buffer->offset();
+    if (begin > length || buffer->size() > length - begin) return false;
+  }
+  return true;
+}
+
 absl::Status PackWeightsCache::Append(absl::string_view filename,
                                       absl::string_view data) {
   return mediapipe::file::AppendStringToFile(filename, data);
@@ -205,12 +246,27 @@ absl::Status PackWeightsCache::Prepend(absl::string_view filename,
   return absl::OkStatus();
 }
 
+absl::Status PackWeightsCache::Rename(absl::string_view from,
+                                      absl::string_view to) {
+  RET_CHECK_EQ(std::rename(std::string(from).c_str(), std::string(to).c_str()),
+               0)
+      << from << " -> " << to;
+  return absl::OkStatus();
+}
+
+absl::Status PackWeightsCache::Remove(absl::string_view filename) {
+  if (mediapipe::file::Exists(filename).ok()) {
+    RET_CHECK_EQ(std::remove(std::string(filename).c_str()), 0) << filename;
+  }
+  return absl::OkStatus();
+}
+
 absl::Status PackWeightsCache::Append(absl::string_view data) {
-  return Append(cache_path_, data);
+  return Append(building_path_, data);
 }
 
 absl::Status PackWeightsCache::Prepend(absl::string_view data) {
-  return Prepend(cache_path_, data);
+  return Prepend(building_path_, data);
 }
 
 size_t PackWeightsCache::look_up(
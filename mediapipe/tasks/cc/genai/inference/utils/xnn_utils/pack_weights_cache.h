@@ -39,12 +39,16 @@ namespace mediapipe::tasks::genai::xnn_utils {
 // either the cache is fully built already, or will be built from scratch.
 class PackWeightsCache : public XnnWeightsCache {
  public:
-  // `cache_path` is used in Initialize() and Finalize().
+  // `cache_path` is used in Initialize() and Finalize(). While the cache is
+  // being built, data is written to `cache_path` + ".tmp", which is renamed to
+  // `cache_path` only once Finalize() succeeds. So an interrupted build never
+  // leaves a partial cache behind.
   explicit PackWeightsCache(absl::string_view cache_path);
   ~PackWeightsCache() override;
 
   // Initializes the cache. The default implementation loads the serialized
-  // cache from the `cache_path`.
+  // cache from the `cache_path`. A cache that fails verification is discarded
+  // and rebuilt.
   virtual absl::Status Initialize();
 
   // Adds an unpacked weight. Across different processes, the same `weight` may
@@ -80,6 +84,14 @@ class PackWeightsCache : public XnnWeightsCache {
   virtual absl::Status Prepend(absl::string_view filename,
                                absl::string_view data);
 
+  // Moves `from` to `to`, replacing `to` if it exists. Inheritance classes can
+  // overwrite this function e.g. if there's no filesystem.
+  virtual absl::Status Rename(absl::string_view from, absl::string_view to);
+
+  // Deletes `filename` if it exists. Inheritance classes can overwrite this
+  // function e.g. if there's no filesystem.
+  virtual absl::Status Remove(absl::string_view filename);
+
  private:
   absl::Status Append(absl::string_view data);
   absl::Status Prepend(absl::string_view data);
@@ -87,6 +99,9 @@ class PackWeightsCache : public XnnWeightsCache {
   absl::Status InitializeFromCache(
       std::shared_ptr<llm_utils::MemoryMappedFile> mmap_cache);
 
+  // Returns true if `mmap_cache` holds a complete, well-formed cache.
+  static bool IsValidCache(llm_utils::MemoryMappedFile& mmap_cache);
+
   // A series of functions for `xnn_weights_cache_provider`. They need to be
   // static such that we can assign function pointers. They need to be class
   // static functions such that they can access non-public members.
@@ -112,6 +127,8 @@ class PackWeightsCache : public XnnWeightsCache {
   xnn_weights_cache_provider cache_provider_;
 
   std::string cache_path_;
+  // Where the cache is written to before Finalize().
+  std::string building_path_;
   std::shared_ptr<llm_utils::MemoryMappedFile> mmap_file_;
   // Immutable flatbuffer.
   std::shared_ptr<const NamedBuffers> named_buffers_;
@@ -151,6 +168,10 @@ class WeightAccessorCompositeWithCache : public WeightAccessor {
       absl::string_view tensor_name, Tensor::DimsType expected_dims,
       size_t dim_scale_if_any) const override;
 
+  absl::Status ReleaseResidentMemory() override {
+    return accessor_->ReleaseResidentMemory();
+  }
+
  private:
   std::shared_ptr<WeightAccessor> accessor_;
   PackWeightsCache* const weights_cache_;
@@ -31,6 +31,36 @@
 
 namespace mediapipe::tasks::genai::xnn_utils {
 
+namespace {
+
+// Logits are scanned in blocks of this size. A block whose maximum does not
+// beat the current k-th largest logit is skipped, so for most of the
+// vocabulary the only work is a max reduction, which compilers vectorize.
+constexpr size_t kBlockSize = 16;
+
+// Top-p sampling over the whole vocabulary starts with this many candidates,
+// and grows them until they hold enough probability mass.
+constexpr int kInitialTopPCandidates = 64;
+
+// Above this many candidates, heap updates cost more than a linear-time
+// selection over the whole vocabulary.
+constexpr int kMaxHeapCandidates = 256;
+
+bool GreaterLogit(const std::pair<float, int>& a,
+                  const std::pair<float, int>& b) {
+  return a.first > b.first;
+}
+
+float MaxLogit(const float* data, size_t size) {
+  float max_logit = data[0];
+  for (size_t i = 1; i < size; ++i) {
+    max_logit = data[i] > max_logit ? data[i] : max_logit;
+  }
+  return max_logit;
+}
+
+}  // namespace
+
 absl::StatusOr<std::unique_ptr<Sampler>> Sampler::Create(Type type, int top_k,
                                                          float top_p,
                                                          float temperature,
@@ -126,16 +156,11 @@ absl::StatusOr<std::vector<std::vector<int>>> Sampler::SampleTopK(
       // the index of the first logit for a single token
       int token_index =
           (batch * draft_size * vocab_size) + (draft * vocab_size);
-      std::vector<std::pair<float, int>> logits_ids;
-      logits_ids.reserve(vocab_size);
-      for (int v = 0; v < vocab_size; ++v) {
-        float logit = flat_data[token_index + v];
-        logits_ids.push_back(std::make_pair(logit, v));
-      }
-      MP_RETURN_IF_ERROR(SelectTopK(logits_ids, top_k_));
+      MP_RETURN_IF_ERROR(
+          SelectTopK(flat_data + token_index, vocab_size, top_k_));
       // No need to normalize logits here, sampler takes care of that.
-      MP_RETURN_IF_ERROR(ScaledSoftmax(logits_ids, /*normalize=*/false));
-      MP_ASSIGN_OR_RETURN(int sample_idx, DoSampling(logits_ids));
+      MP_RETURN_IF_ERROR(ScaledSoftmax(/*normalize=*/false));
+      MP_ASSIGN_OR_RETURN(int sample_idx, DoSampling());
       outputs[batch].push_back(sample_idx);
     }
   }
@@ -159,43 +184,94 @@ absl::StatusOr<std::vector<std::vector<int>>> Sampler::SampleTopP(
       // the index of the first logit for a single token
       int token_index =
           (batch * draft_size * vocab_size) + (draft * vocab_size);
-      std::vector<std::pair<float, int>> logits_ids;
-      logits_ids.reserve(vocab_size);
-      for (int v = 0; v < vocab_size; ++v) {
-        float logit = flat_data[token_index + v];
-        logits_ids.push_back(std::make_pair(logit, v));
+      const float* row = flat_data + token_index;
+      if (k == vocab_size) {
+        MP_RETURN_IF_ERROR(SelectTopPFromVocab(row, vocab_size, top_p_));
+      } else {
+        MP_RETURN_IF_ERROR(SelectTopK(row, vocab_size, k));
+        MP_RETURN_IF_ERROR(ScaledSoftmax(/*normalize=*/true));
+        MP_RETURN_IF_ERROR(SelectTopP(top_p_));
       }
-      MP_RETURN_IF_ERROR(SelectTopK(logits_ids, k));
-      MP_RETURN_IF_ERROR(ScaledSoftmax(logits_ids, /*normalize=*/true));
-      MP_RETURN_IF_ERROR(SelectTopP(logits_ids, top_p_));
-      MP_ASSIGN_OR_RETURN(int sample_idx, DoSampling(logits_ids));
+      MP_ASSIGN_OR_RETURN(int sample_idx, DoSampling());
       outputs[batch].push_back(sample_idx);
     }
   }
   return outputs;
 }
 
-absl::Status Sampler::SelectTopK(std::vector<std::pair<float, int>>& logits_ids,
-                                 int k) {
-  if (k > logits_ids.size()) {
+absl::Status Sampler::SelectTopK(const float* row, size_t vocab_size, int k) {
+  if (k > vocab_size) {
     return absl::InvalidArgumentError(
         "Top k value must be smaller than the number of logits.");
   }
-  std::partial_sort(
-      logits_ids.begin(), logits_ids.begin() + k, logits_ids.end(),
-      [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
-        // reverse order.
-        return a.first > b.first;
-      });
-  logits_ids.resize(k);
+  RET_CHECK_GT(k, 0);
+  candidates_.clear();
+  if (k > kMaxHeapCandidates) {
+    candidates_.reserve(vocab_size);
+    for (int v = 0; v < vocab_size; ++v) {
+      candidates_.push_back(std::make_pair(row[v], v));
+    }
+    std::nth_element(candidates_.begin(), candidates_.begin() + (k - 1),
+                     candidates_.end(), GreaterLogit);
+    candidates_.resize(k);
+    std::sort(candidates_.begin(), candidates_.end(), GreaterLogit);
+    return absl::OkStatus();
+  }
+  for (int v = 0; v < k; ++v) {
+    candidates_.push_back(std::make_pair(row[v], v));
+  }
+  // A min-heap of the k largest logits seen so far, so that front() is the
+  // logit a new candidate has to beat.
+  std::make_heap(candidates_.begin(), candidates_.end(), GreaterLogit);
+  float threshold = candidates_.front().first;
+  for (size_t begin = k; begin < vocab_size; begin += kBlockSize) {
+    const size_t end = std::min(begin + kBlockSize, vocab_size);
+    if (MaxLogit(row + begin, end - begin) <= threshold) continue;
+    for (size_t v = begin; v < end; ++v) {
+      if (row[v] <= threshold) continue;
+      std::pop_heap(candidates_.begin(), candidates_.end(), GreaterLogit);
+      candidates_.back() = std::make_pair(row[v], static_cast<int>(v));
+      std::push_heap(candidates_.begin(), candidates_.end(), GreaterLogit);
+      threshold = candidates_.front().first;
+    }
+  }
+  // Sorts in descending order, as the heap is ordered by GreaterLogit.
+  std::sort_heap(candidates_.begin(), candidates_.end(), GreaterLogit);
   return absl::OkStatus();
 }
 
-absl::Status Sampler::SelectTopP(std::vector<std::pair<float, int>>& logits_ids,
-                                 float p) {
+absl::Status Sampler::SelectTopPFromVocab(const float* row, size_t vocab_size,
+                                          float p) {
+  RET_CHECK_GT(vocab_size, 0);
+  const float scale = 1 / (temperature_ ? temperature_ : 1.0);
+  // The softmax denominator needs the whole vocabulary, but it is a single
+  // pass that keeps nothing but the running sum.
+  const float max_logit = MaxLogit(row, vocab_size);
+  double sum = 0.0;
+  for (size_t v = 0; v < vocab_size; ++v) {
+    sum += expf(scale * (row[v] - max_logit));
+  }
+
+  // Probabilities are usually concentrated on a few tokens, so select a small
+  // top-k first and only grow it while it lacks probability mass.
+  size_t k = std::min<size_t>(kInitialTopPCandidates, vocab_size);
+  while (true) {
+    MP_RETURN_IF_ERROR(SelectTopK(row, vocab_size, k));
+    double prob_sum = 0.0;
+    for (auto& [logit, _] : candidates_) {
+      logit = expf(scale * (logit - max_logit)) / sum;
+      prob_sum += logit;
+    }
+    if (prob_sum >= p || k == vocab_size) break;
+    k = std::min(k * 4, vocab_size);
+  }
+  return SelectTopP(p);
+}
+
+absl::Status Sampler::SelectTopP(float p) {
   int included = 0;
   float prob_sum = 0.0;
-  for (const auto& [logit, _] : logits_ids) {
+  for (const auto& [logit, _] : candidates_) {
     ++included;
     prob_sum += logit;
     if (prob_sum >= p) {
@@ -205,40 +281,37 @@ absl::Status Sampler::SelectTopP(std::vector<std::pair<float, int>>& logits_ids,
   if (included == 0) {
     return absl::InternalError("Bad top_p value.");
   }
-  logits_ids.resize(included);
+  candidates_.resize(included);
   return absl::OkStatus();
 }
 
-absl::Status Sampler::ScaledSoftmax(
-    std::vector<std::pair<float, int>>& logits_ids, bool normalize) {
+absl::Status Sampler::ScaledSoftmax(bool normalize) {
   float scale = 1 / (temperature_ ? temperature_ : 1.0);
   double sum = 0.0;
-  float max_logit = logits_ids[0].first;
-  for (int i = 0; i < logits_ids.size(); ++i) {
-    const float logit = logits_ids[i].first;
+  float max_logit = candidates_[0].first;
+  for (int i = 0; i < candidates_.size(); ++i) {
+    const float logit = candidates_[i].first;
     const float p = expf(scale * (logit - max_logit));
     sum += p;
-    logits_ids[i].first = p;
+    candidates_[i].first = p;
   }
   if (normalize) {
-    for (int i = 0; i < logits_ids.size(); ++i) {
-      logits_ids[i].first /= sum;
+    for (int i = 0; i < candidates_.size(); ++i) {
+      candidates_[i].first /= sum;
     }
   }
   return absl::OkStatus();
 }
 
-absl::StatusOr<int> Sampler::DoSampling(
-    std::vector<std::pair<float, int>>& logits_ids) {
-  std::vector<float> probs;
-  probs.reserve(logits_ids.size());
-  for (const auto& [logit, _] : logits_ids) {
-    probs.push_back(logit);
+absl::StatusOr<int> Sampler::DoSampling() {
+  probs_.clear();
+  for (const auto& [logit, _] : candidates_) {
+    probs_.push_back(logit);
   }
   // Probabilities are normalized by `discrete_distribution`.
-  std::discrete_distribution<> dist(probs.begin(), probs.end());
+  std::discrete_distribution<> dist(probs_.begin(), probs_.end());
   int sample_idx = dist(*generator_);
-  return logits_ids[sample_idx].second;
+  return candidates_[sample_idx].second;
 }
 
 }  // namespace mediapipe::tasks::genai::xnn_utils
@@ -17,6 +17,7 @@
 
 #include <sys/stat.h>
 
+#include <cstddef>
 #include <memory>
 #include <random>
 #include <utility>
@@ -63,22 +64,30 @@ class Sampler {
       const Tensor& logits);
   absl::StatusOr<std::vector<std::vector<int>>> SampleTopP(
       const Tensor& logits);
-  absl::Status SelectTopK(std::vector<std::pair<float, int>>& logits_ids,
-                          int k);
-  // `logits_ids` must be sorted and normalized.
-  absl::Status SelectTopP(std::vector<std::pair<float, int>>& logits_ids,
-                          float p);
-  // `logits_ids` must be sorted.
-  absl::Status ScaledSoftmax(std::vector<std::pair<float, int>>& logits_ids,
-                             bool normalize);
-  absl::StatusOr<int> DoSampling(
-      std::vector<std::pair<float, int>>& logits_ids);
+  // Sets `candidates_` to the `k` largest logits of `row` and their ids,
+  // sorted in descending order. Runs in O(vocab_size) for small `k`.
+  absl::Status SelectTopK(const float* row, size_t vocab_size, int k);
+  // Sets `candidates_` to the fewest most likely tokens of `row` whose
+  // probabilities add up to at least `p`, along with their probabilities.
+  // Unlike SelectTopK() followed by SelectTopP(), this neither sorts nor
+  // exponentiates into a vocabulary-sized buffer.
+  absl::Status SelectTopPFromVocab(const float* row, size_t vocab_size,
+                                   float p);
+  // `candidates_` must be sorted and normalized.
+  absl::Status SelectTopP(float p);
+  // `candidates_` must be sorted.
+  absl::Status ScaledSoftmax(bool normalize);
+  absl::StatusOr<int> DoSampling();
 
   Type type_;
   int top_k_;
   float top_p_;
   float temperature_;
   std::unique_ptr<std::mt19937> generator_;
+
+  // Scratch buffers reused across rows and calls.
+  std::vector<std::pair<float, int>> candidates_;
+  std::vector<float> probs_;
 };
 
 }  // namespace mediapipe::tasks::genai::xnn_utils
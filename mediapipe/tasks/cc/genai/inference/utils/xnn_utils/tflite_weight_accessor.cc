@@ -43,15 +43,20 @@ TfLiteWeightAccessor::TfLiteWeightAccessor(
 }
 
 TfLiteWeightAccessor::TfLiteWeightAccessor(absl::string_view filename) {
-  std::shared_ptr<llm_utils::MemoryMappedFile> mmap_file =
-      llm_utils::MemoryMappedFile::Create(filename).value_or(nullptr);
-  if (mmap_file) {
+  mmap_file_ = llm_utils::MemoryMappedFile::Create(filename, /*prefetch=*/false)
+                   .value_or(nullptr);
+  if (mmap_file_) {
     tflite_model_ = std::shared_ptr<const ::tflite::Model>(
-        mmap_file, ::tflite::GetModel(mmap_file->data()));
-    BuildWeightsMapFromTfliteModel(static_cast<char*>(mmap_file->data()));
+        mmap_file_, ::tflite::GetModel(mmap_file_->data()));
+    BuildWeightsMapFromTfliteModel(static_cast<char*>(mmap_file_->data()));
   }
 }
 
+absl::Status TfLiteWeightAccessor::ReleaseResidentMemory() {
+  if (!mmap_file_) return absl::OkStatus();
+  return mmap_file_->Advise(llm_utils::MemoryMappedFile::Advice::kDontNeed);
+}
+
 void TfLiteWeightAccessor::BuildWeightsMapFromTfliteModel(char* data) {
   if (!tflite_model_) return;
   const flatbuffers::Vector<flatbuffers::Offset<::tflite::Buffer>>& buffers =
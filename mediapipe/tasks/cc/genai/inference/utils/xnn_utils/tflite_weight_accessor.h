@@ -19,8 +19,10 @@
 #include <memory>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "mediapipe/tasks/cc/genai/inference/utils/llm_utils/memory_mapped_file.h"
 #include "mediapipe/tasks/cc/genai/inference/utils/xnn_utils/xnn_tensor.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
@@ -35,6 +37,8 @@ class TfLiteWeightAccessor : public WeightAccessor {
   // `tflite_model` alive, and assumes `data` outlives `tflite_model`.
   TfLiteWeightAccessor(std::shared_ptr<const tflite::Model> tflite_model,
                        char* data);
+  // Memory maps `filename`. Weights are referenced in place and only paged in
+  // when accessed.
   explicit TfLiteWeightAccessor(absl::string_view filename);
   ~TfLiteWeightAccessor() override = default;
 
@@ -50,9 +54,16 @@ class TfLiteWeightAccessor : public WeightAccessor {
       absl::string_view tensor_name, Tensor::DimsType expected_dims,
       size_t dim_scale_if_any) const override;
 
+  // Releases the resident pages of the memory mapped file, if any. This has no
+  // effect where the file is mapped writable, since weights may have been
+  // modified in place.
+  absl::Status ReleaseResidentMemory() override;
+
  private:
   void BuildWeightsMapFromTfliteModel(char* data);
 
+  // Only set if the model was mapped by this accessor.
+  std::shared_ptr<llm_utils::MemoryMappedFile> mmap_file_;
   std::shared_ptr<const tflite::Model> tflite_model_;
   absl::flat_hash_map<absl::string_view /*tensor_name*/,
                       std::shared_ptr<Tensor>>
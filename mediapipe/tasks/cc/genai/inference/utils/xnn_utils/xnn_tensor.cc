@@ -634,5 +634,22 @@ std::shared_ptr<Tensor> QCTensor::Slice(size_t index, size_t offset) {
   return result;
 }
 
+absl::Status QTensor::DefineInSubgraph(xnn_subgraph& subgraph, uint32_t flags) {
+  uint32_t id;
+  RET_CHECK_EQ(xnn_status_success,
+               xnn_define_quantized_tensor_value(
+                   &subgraph, datatype, zero_point, scale, dims.size(),
+                   dims.data(), /*data=*/nullptr,
+                   /*external_id=*/tensor_id(&subgraph), flags, &id))
+      << dims;
+  if (tensor_id(&subgraph) == XNN_INVALID_VALUE_ID) {
+    RET_CHECK_NE(id, XNN_INVALID_VALUE_ID);
+    map_subgraph_to_tensor_id[&subgraph] = id;
+  } else {
+    RET_CHECK_EQ(id, tensor_id(&subgraph));
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace xnn_utils
 }  // namespace mediapipe::tasks::genai
@@ -191,7 +191,8 @@ struct Tensor {
   virtual absl::Status DefineInSubgraph(xnn_subgraph& subgraph, uint32_t flags);
 
   virtual size_t ElementSize(size_t num_elements) const {
-    return num_elements * 4;
+    // Slices of a QTensor are plain Tensors, they need the int8 size too.
+    return datatype == xnn_datatype_qint8 ? num_elements : num_elements * 4;
   }
 
   DimsType internal_dims;
@@ -270,6 +271,26 @@ struct QCTensor : public Tensor {
 
 std::ostream& operator<<(std::ostream& os, const QCTensor& tensor);
 
+// Per-tensor quantized, with a single scale and zero point. Used for
+// activations, e.g. the int8 KV cache, the scale is not stored with the data.
+struct QTensor : public Tensor {
+  explicit QTensor(DimsType in_dims, float scale_ = 1.0f,
+                   int32_t zero_point_ = 0,
+                   xnn_datatype datatype_ = xnn_datatype_qint8)
+      : Tensor(std::move(in_dims), datatype_),
+        scale(scale_),
+        zero_point(zero_point_) {
+    ABSL_CHECK_EQ(datatype, xnn_datatype_qint8);
+  }
+
+  float scale;
+  int32_t zero_point;
+
+ protected:
+  absl::Status DefineInSubgraph(xnn_subgraph& subgraph,
+                                uint32_t flags) override;
+};
+
 // Interface to access weights. The interface allows e.g. benchmark test to
 // return random-initialized weights content, without preparing real weights.
 class WeightAccessor {
@@ -288,6 +309,11 @@ class WeightAccessor {
   // Load weight, then transpose before return.
   virtual absl::StatusOr<std::shared_ptr<Tensor>> LoadTransposedWeight(
       absl::string_view, Tensor::DimsType, size_t dim_scale_if_any) const = 0;
+
+  // Hints that the loaded weights are not accessed soon, e.g. because XNNPack
+  // packed them into its own buffers. Weights stay valid, but the accessor may
+  // release their resident memory.
+  virtual absl::Status ReleaseResidentMemory() { return absl::OkStatus(); }
 };
 
 // May be attached to an LLM graph as a side input to override how weights are
@@ -16,6 +16,7 @@ limitations under the License.
 #include "mediapipe/tasks/cc/metadata/metadata_extractor.h"
 
 #include <string>
+#include <utility>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/memory/memory.h"
@@ -187,27 +188,28 @@ absl::Status ModelMetadataExtractor::InitFromModelBuffer(
 
 absl::Status ModelMetadataExtractor::ExtractAssociatedFiles(
     const char* buffer_data, size_t buffer_size) {
-  auto status =
-      ExtractFilesfromZipFile(buffer_data, buffer_size, &associated_files_);
-  if (!status.ok() &&
-      absl::StrContains(status.message(), "Unable to open zip archive.")) {
+  auto index =
+      ZipFileIndex::Create(absl::string_view(buffer_data, buffer_size));
+  if (!index.ok() && absl::StrContains(index.status().message(),
+                                       "Unable to open zip archive.")) {
     // It's OK if it fails: this means there are no associated files with this
     // model.
     return absl::OkStatus();
   }
-  return status;
+  MP_RETURN_IF_ERROR(index.status());
+  associated_files_ = std::move(index).value();
+  return absl::OkStatus();
 }
 
 absl::StatusOr<absl::string_view> ModelMetadataExtractor::GetAssociatedFile(
     const std::string& filename) const {
-  auto it = associated_files_.find(filename);
-  if (it == associated_files_.end()) {
+  if (associated_files_ == nullptr || !associated_files_->Contains(filename)) {
     return CreateStatusWithPayload(
         StatusCode::kNotFound,
         absl::StrFormat("No associated file with name: %s", filename),
         MediaPipeTasksStatus::kMetadataAssociatedFileNotFoundError);
   }
-  return it->second;
+  return associated_files_->GetFile(filename);
 }
 
 absl::StatusOr<std::string> ModelMetadataExtractor::GetModelVersion() const {
@@ -15,10 +15,13 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_METADATA_METADATA_EXTRACTOR_H_
 #define MEDIAPIPE_TASKS_CC_METADATA_METADATA_EXTRACTOR_H_
 
-#include "absl/container/flat_hash_map.h"
+#include <memory>
+#include <string>
+
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
 #include "tensorflow/lite/schema/schema_generated.h"
 
@@ -75,7 +78,8 @@ class ModelMetadataExtractor {
 
   // Gets the contents of the associated file with the provided name packed into
   // the model metadata. An error is returned if there is no such associated
-  // file.
+  // file. Files stored uncompressed are returned as views into the model
+  // buffer; compressed files are inflated on their first access.
   absl::StatusOr<absl::string_view> GetAssociatedFile(
       const std::string& filename) const;
 
@@ -163,10 +167,10 @@ class ModelMetadataExtractor {
   const tflite::Model* model_{nullptr};
   // Pointer to the extracted ModelMetadata, if any.
   const tflite::ModelMetadata* model_metadata_{nullptr};
-  // The files associated with the ModelMetadata, as a map with the filename
-  // (corresponding to a basename, e.g. "labels.txt") as key and a pointer to
-  // the file contents as value.
-  absl::flat_hash_map<std::string, absl::string_view> associated_files_;
+  // The files associated with the ModelMetadata, indexed by filename
+  // (corresponding to a basename, e.g. "labels.txt"), or nullptr if there are
+  // none.
+  std::unique_ptr<ZipFileIndex> associated_files_;
 };
 
 }  // namespace metadata
@@ -0,0 +1,143 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "contrib/minizip/ioapi.h"
+#include "contrib/minizip/zip.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/tasks/cc/metadata/utils/zip_writable_mem_file.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace metadata {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::UnorderedElementsAre;
+
+constexpr char kPrefix[] = "model flatbuffer data";
+constexpr char kLabels[] = "cat\ndog\n";
+
+struct FileToZip {
+  std::string name;
+  std::string contents;
+  int method;  // 0 for stored, Z_DEFLATED for deflated.
+};
+
+// Appends a zip archive with `files` to `prefix`, as the metadata populator
+// does for model files.
+std::string CreateZipArchive(absl::string_view prefix,
+                             const std::vector<FileToZip>& files) {
+  ZipWritableMemFile mem_file(prefix.data(), prefix.size());
+  zipFile zf =
+      zipOpen2_64(/*pathname=*/nullptr, APPEND_STATUS_CREATEAFTER,
+                  /*globalcomment=*/nullptr, &mem_file.GetFileFunc64Def());
+  EXPECT_NE(zf, nullptr);
+  for (const FileToZip& file : files) {
+    EXPECT_EQ(zipOpenNewFileInZip64(zf, file.name.c_str(), /*zipfi=*/nullptr,
+                                    /*extrafield_local=*/nullptr,
+                                    /*size_extrafield_local=*/0,
+                                    /*extrafield_global=*/nullptr,
+                                    /*size_extrafield_global=*/0,
+                                    /*comment=*/nullptr, file.method,
+                                    Z_DEFAULT_COMPRESSION, /*zip64=*/0),
+              ZIP_OK);
+    EXPECT_EQ(zipWriteInFileInZip(zf, file.contents.data(),
+                                  file.contents.size()),
+              ZIP_OK);
+    EXPECT_EQ(zipCloseFileInZip(zf), ZIP_OK);
+  }
+  EXPECT_EQ(zipClose(zf, /*global_comment=*/nullptr), ZIP_OK);
+  return std::string(mem_file.GetFileContent());
+}
+
+std::string Vocabulary() {
+  std::string vocabulary;
+  for (int i = 0; i < 1000; ++i) vocabulary += "token\n";
+  return vocabulary;
+}
+
+TEST(ZipFileIndexTest, ReturnsStoredFilesAsViewsIntoTheBuffer) {
+  const std::string archive =
+      CreateZipArchive(kPrefix, {{"labels.txt", kLabels, 0}});
+  MP_ASSERT_OK_AND_ASSIGN(auto index, ZipFileIndex::Create(archive));
+  EXPECT_THAT(index->FileNames(), UnorderedElementsAre("labels.txt"));
+  EXPECT_TRUE(index->IsStored("labels.txt"));
+  MP_ASSERT_OK_AND_ASSIGN(absl::string_view labels,
+                          index->GetFile("labels.txt"));
+  EXPECT_EQ(labels, kLabels);
+  EXPECT_GE(labels.data(), archive.data());
+  EXPECT_LE(labels.data() + labels.size(), archive.data() + archive.size());
+}
+
+TEST(ZipFileIndexTest, InflatesDeflatedFilesOnce) {
+  const std::string vocabulary = Vocabulary();
+  const std::string archive =
+      CreateZipArchive(kPrefix, {{"labels.txt", kLabels, 0},
+                                 {"vocab.txt", vocabulary, Z_DEFLATED}});
+  MP_ASSERT_OK_AND_ASSIGN(auto index, ZipFileIndex::Create(archive));
+  EXPECT_FALSE(index->IsStored("vocab.txt"));
+  MP_ASSERT_OK_AND_ASSIGN(absl::string_view first,
+                          index->GetFile("vocab.txt"));
+  EXPECT_EQ(first, vocabulary);
+  MP_ASSERT_OK_AND_ASSIGN(absl::string_view second,
+                          index->GetFile("vocab.txt"));
+  EXPECT_EQ(second.data(), first.data());
+}
+
+TEST(ZipFileIndexTest, FailsOnMissingFile) {
+  const std::string archive =
+      CreateZipArchive(kPrefix, {{"labels.txt", kLabels, 0}});
+  MP_ASSERT_OK_AND_ASSIGN(auto index, ZipFileIndex::Create(archive));
+  EXPECT_FALSE(index->Contains("vocab.txt"));
+  EXPECT_EQ(index->GetFile("vocab.txt").status().code(),
+            absl::StatusCode::kNotFound);
+}
+
+TEST(ZipFileIndexTest, FailsWithoutArchive) {
+  auto index = ZipFileIndex::Create(kPrefix);
+  EXPECT_THAT(index.status().message(),
+              HasSubstr("Unable to open zip archive."));
+}
+
+TEST(ExtractFilesfromZipFileTest, RejectsDeflatedFiles) {
+  const std::string stored =
+      CreateZipArchive(kPrefix, {{"labels.txt", kLabels, 0}});
+  absl::flat_hash_map<std::string, absl::string_view> files;
+  MP_ASSERT_OK(ExtractFilesfromZipFile(stored.data(), stored.size(), &files));
+  ASSERT_EQ(files.size(), 1);
+  EXPECT_EQ(files["labels.txt"], kLabels);
+
+  const std::string deflated =
+      CreateZipArchive(kPrefix, {{"vocab.txt", Vocabulary(), Z_DEFLATED}});
+  files.clear();
+  EXPECT_THAT(
+      ExtractFilesfromZipFile(deflated.data(), deflated.size(), &files)
+          .message(),
+      HasSubstr("Expected uncompressed zip archive."));
+}
+
+}  // namespace
+}  // namespace metadata
+}  // namespace tasks
+}  // namespace mediapipe
@@ -15,18 +15,23 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 
+#include <climits>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
-#include "absl/cleanup/cleanup.h"
 #include "absl/container/flat_hash_map.h"
-#include "absl/log/absl_log.h"
+#include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
-#include "contrib/minizip/ioapi.h"
-#include "contrib/minizip/unzip.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/common.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_readonly_mem_file.h"
+#include "zlib.h"
 
 namespace mediapipe {
 namespace tasks {
@@ -36,131 +41,243 @@ namespace {
 
 using ::absl::StatusCode;
 
-// Wrapper function around calls to unzip to avoid repeating conversion logic
-// from error code to Status.
-absl::Status UnzipErrorToStatus(int error) {
-  if (error != UNZ_OK) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Unable to read the file in zip archive.",
-                                   MediaPipeTasksStatus::kFileZipError);
+// Signatures and sizes of the zip records read below. See section 4.3 of
+// https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT.
+constexpr uint32_t kEndOfCentralDirectorySignature = 0x06054b50;
+constexpr uint64_t kEndOfCentralDirectorySize = 22;
+constexpr uint64_t kMaxCommentSize = 0xffff;
+constexpr uint32_t kZip64EndOfCentralDirectoryLocatorSignature = 0x07064b50;
+constexpr uint64_t kZip64EndOfCentralDirectoryLocatorSize = 20;
+constexpr uint32_t kZip64EndOfCentralDirectorySignature = 0x06064b50;
+constexpr uint64_t kZip64EndOfCentralDirectorySize = 56;
+constexpr uint32_t kCentralDirectoryHeaderSignature = 0x02014b50;
+constexpr uint64_t kCentralDirectoryHeaderSize = 46;
+constexpr uint32_t kLocalFileHeaderSignature = 0x04034b50;
+constexpr uint64_t kLocalFileHeaderSize = 30;
+constexpr uint16_t kZip64ExtraFieldId = 0x0001;
+constexpr uint32_t kZip64Marker = 0xffffffff;
+constexpr int kStoredMethod = 0;
+constexpr int kDeflatedMethod = 8;
+
+absl::Status ZipError(absl::string_view message) {
+  return CreateStatusWithPayload(StatusCode::kUnknown, message,
+                                 MediaPipeTasksStatus::kFileZipError);
+}
+
+// Returns whether [offset, offset + size) lies within `buffer`.
+bool InBounds(absl::string_view buffer, uint64_t offset, uint64_t size) {
+  return offset <= buffer.size() && size <= buffer.size() - offset;
+}
+
+// Reads a little-endian integer at `offset`, which must be in bounds.
+template <typename T>
+T Read(absl::string_view buffer, uint64_t offset) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    value |= static_cast<T>(static_cast<uint8_t>(buffer[offset + i]))
+             << (8 * i);
   }
-  return absl::OkStatus();
+  return value;
 }
 
-// Stores a file name, position in zip buffer and size.
-struct ZipFileInfo {
-  std::string name;
-  ZPOS64_T position;
-  ZPOS64_T size;
-};
-
-// Returns the ZipFileInfo corresponding to the current file in the provided
-// unzFile object.
-absl::StatusOr<ZipFileInfo> GetCurrentZipFileInfo(const unzFile& zf) {
-  // Open file in raw mode, as data is expected to be uncompressed.
-  int method;
-  MP_RETURN_IF_ERROR(UnzipErrorToStatus(
-      unzOpenCurrentFile2(zf, &method, /*level=*/nullptr, /*raw=*/1)));
-  absl::Cleanup unzipper_closer = [zf]() {
-    auto status = UnzipErrorToStatus(unzCloseCurrentFile(zf));
-    if (!status.ok()) {
-      ABSL_LOG(ERROR) << "Failed to close the current zip file: " << status;
+// Returns the offset of the end of central directory record, searching
+// backwards from the end of `buffer` past a possible archive comment.
+absl::StatusOr<uint64_t> FindEndOfCentralDirectory(absl::string_view buffer) {
+  if (buffer.size() >= kEndOfCentralDirectorySize) {
+    const uint64_t last = buffer.size() - kEndOfCentralDirectorySize;
+    const uint64_t first = last > kMaxCommentSize ? last - kMaxCommentSize : 0;
+    for (uint64_t offset = last + 1; offset-- > first;) {
+      if (Read<uint32_t>(buffer, offset) == kEndOfCentralDirectorySignature &&
+          Read<uint16_t>(buffer, offset + 20) <= last - offset) {
+        return offset;
+      }
     }
-  };
-  if (method != Z_NO_COMPRESSION) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Expected uncompressed zip archive.",
-                                   MediaPipeTasksStatus::kFileZipError);
   }
+  return ZipError("Unable to open zip archive.");
+}
 
-  // Get file info a first time to get filename size.
-  unz_file_info64 file_info;
-  MP_RETURN_IF_ERROR(UnzipErrorToStatus(unzGetCurrentFileInfo64(
-      zf, &file_info, /*szFileName=*/nullptr, /*szFileNameBufferSize=*/0,
-      /*extraField=*/nullptr, /*extraFieldBufferSize=*/0,
-      /*szComment=*/nullptr, /*szCommentBufferSize=*/0)));
-
-  // Second call to get file name.
-  auto file_name_size = file_info.size_filename;
-  char* c_file_name = (char*)malloc(file_name_size);
-  MP_RETURN_IF_ERROR(UnzipErrorToStatus(unzGetCurrentFileInfo64(
-      zf, &file_info, c_file_name, file_name_size,
-      /*extraField=*/nullptr, /*extraFieldBufferSize=*/0,
-      /*szComment=*/nullptr, /*szCommentBufferSize=*/0)));
-  std::string file_name = std::string(c_file_name, file_name_size);
-  free(c_file_name);
-
-  // Get position in file.
-  auto position = unzGetCurrentFileZStreamPos64(zf);
-  if (position == 0) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Unable to read file in zip archive.",
-                                   MediaPipeTasksStatus::kFileZipError);
+// Inflates raw deflate `data` of `size` bytes once inflated.
+absl::StatusOr<std::unique_ptr<std::string>> Inflate(absl::string_view data,
+                                                     uint64_t size) {
+  if (data.size() > UINT_MAX || size > UINT_MAX) {
+    return ZipError("Compressed file in zip archive is too large.");
   }
-
-  // Perform the cleanup manually for error propagation.
-  std::move(unzipper_closer).Cancel();
-  // Close file and return.
-  MP_RETURN_IF_ERROR(UnzipErrorToStatus(unzCloseCurrentFile(zf)));
-
-  ZipFileInfo result{};
-  result.name = file_name;
-  result.position = position;
-  result.size = file_info.uncompressed_size;
-  return result;
+  auto output = std::make_unique<std::string>(size, '\0');
+  z_stream stream = {};
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+    return ZipError("Unable to inflate file in zip archive.");
+  }
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef*>(output->data());
+  stream.avail_out = size;
+  const int result = inflate(&stream, Z_FINISH);
+  inflateEnd(&stream);
+  if (result != Z_STREAM_END || stream.total_out != size) {
+    return ZipError("Unable to inflate file in zip archive.");
+  }
+  return output;
 }
 
 }  // namespace
 
-absl::Status ExtractFilesfromZipFile(
-    const char* buffer_data, const size_t buffer_size,
-    absl::flat_hash_map<std::string, absl::string_view>* files) {
-  // Create in-memory read-only zip file.
-  ZipReadOnlyMemFile mem_file = ZipReadOnlyMemFile(buffer_data, buffer_size);
-  // Open zip.
-  unzFile zf = unzOpen2_64(/*path=*/nullptr, &mem_file.GetFileFunc64Def());
-  if (zf == nullptr) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Unable to open zip archive.",
-                                   MediaPipeTasksStatus::kFileZipError);
-  }
-  absl::Cleanup unzipper_closer = [zf]() {
-    if (unzClose(zf) != UNZ_OK) {
-      ABSL_LOG(ERROR) << "Unable to close zip archive.";
+absl::StatusOr<std::unique_ptr<ZipFileIndex>> ZipFileIndex::Create(
+    absl::string_view buffer) {
+  MP_ASSIGN_OR_RETURN(const uint64_t end_record,
+                      FindEndOfCentralDirectory(buffer));
+  uint64_t num_entries = Read<uint16_t>(buffer, end_record + 10);
+  uint64_t directory_size = Read<uint32_t>(buffer, end_record + 12);
+  uint64_t directory_offset = Read<uint32_t>(buffer, end_record + 16);
+  // The offset of the record that follows the central directory.
+  uint64_t directory_end = end_record;
+  if (num_entries == 0xffff || directory_size == kZip64Marker ||
+      directory_offset == kZip64Marker) {
+    // Zip64 archive: the actual values are in the zip64 end of central
+    // directory record, which directly precedes its locator.
+    if (end_record < kZip64EndOfCentralDirectoryLocatorSize +
+                         kZip64EndOfCentralDirectorySize) {
+      return ZipError("Invalid zip64 archive.");
     }
-  };
-  // Get number of files.
-  unz_global_info global_info;
-  if (unzGetGlobalInfo(zf, &global_info) != UNZ_OK) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Unable to get zip archive info.",
-                                   MediaPipeTasksStatus::kFileZipError);
+    const uint64_t locator =
+        end_record - kZip64EndOfCentralDirectoryLocatorSize;
+    const uint64_t record = locator - kZip64EndOfCentralDirectorySize;
+    if (Read<uint32_t>(buffer, locator) !=
+            kZip64EndOfCentralDirectoryLocatorSignature ||
+        Read<uint32_t>(buffer, record) !=
+            kZip64EndOfCentralDirectorySignature) {
+      return ZipError("Invalid zip64 archive.");
+    }
+    num_entries = Read<uint64_t>(buffer, record + 32);
+    directory_size = Read<uint64_t>(buffer, record + 40);
+    directory_offset = Read<uint64_t>(buffer, record + 48);
+    directory_end = record;
+  }
+  if (directory_size > directory_end ||
+      directory_offset > directory_end - directory_size) {
+    return ZipError("Invalid zip archive central directory.");
   }
+  // The archive may follow other data in the buffer, e.g. a model FlatBuffer,
+  // which shifts all the offsets recorded in the archive.
+  const uint64_t archive_start =
+      directory_end - directory_size - directory_offset;
 
-  // Browse through files in archive.
-  if (global_info.number_entry > 0) {
-    int error = unzGoToFirstFile(zf);
-    while (error == UNZ_OK) {
-      MP_ASSIGN_OR_RETURN(auto zip_file_info, GetCurrentZipFileInfo(zf));
-      // Store result in map.
-      (*files)[zip_file_info.name] = absl::string_view(
-          buffer_data + zip_file_info.position, zip_file_info.size);
-      error = unzGoToNextFile(zf);
+  auto index = absl::WrapUnique(new ZipFileIndex());
+  uint64_t header = directory_end - directory_size;
+  for (uint64_t i = 0; i < num_entries; ++i) {
+    if (!InBounds(buffer, header, kCentralDirectoryHeaderSize) ||
+        Read<uint32_t>(buffer, header) != kCentralDirectoryHeaderSignature) {
+      return ZipError("Invalid zip archive central directory.");
     }
-    if (error != UNZ_END_OF_LIST_OF_FILE) {
-      return CreateStatusWithPayload(
-          StatusCode::kUnknown,
-          "Unable to read associated file in zip archive.",
-          MediaPipeTasksStatus::kFileZipError);
+    const int method = Read<uint16_t>(buffer, header + 10);
+    uint64_t compressed_size = Read<uint32_t>(buffer, header + 20);
+    uint64_t uncompressed_size = Read<uint32_t>(buffer, header + 24);
+    const uint64_t name_size = Read<uint16_t>(buffer, header + 28);
+    const uint64_t extra_size = Read<uint16_t>(buffer, header + 30);
+    const uint64_t comment_size = Read<uint16_t>(buffer, header + 32);
+    uint64_t local_header = Read<uint32_t>(buffer, header + 42);
+    const uint64_t name_offset = header + kCentralDirectoryHeaderSize;
+    if (!InBounds(buffer, name_offset, name_size + extra_size + comment_size)) {
+      return ZipError("Invalid zip archive central directory.");
     }
+    std::string name(buffer.substr(name_offset, name_size));
+
+    // Sizes and offsets that do not fit in 32 bits are in the zip64 extra
+    // field, in this order.
+    uint64_t extra = name_offset + name_size;
+    const uint64_t extra_end = extra + extra_size;
+    while (extra + 4 <= extra_end) {
+      const uint16_t id = Read<uint16_t>(buffer, extra);
+      const uint64_t size = Read<uint16_t>(buffer, extra + 2);
+      if (size > extra_end - extra - 4) break;
+      if (id == kZip64ExtraFieldId) {
+        uint64_t field = extra + 4;
+        const uint64_t field_end = field + size;
+        for (uint64_t* value :
+             {&uncompressed_size, &compressed_size, &local_header}) {
+          if (*value == kZip64Marker && field + 8 <= field_end) {
+            *value = Read<uint64_t>(buffer, field);
+            field += 8;
+          }
+        }
+      }
+      extra += 4 + size;
+    }
+    header = extra_end + comment_size;
+
+    local_header += archive_start;
+    if (!InBounds(buffer, local_header, kLocalFileHeaderSize) ||
+        Read<uint32_t>(buffer, local_header) != kLocalFileHeaderSignature) {
+      return ZipError(
+          absl::StrFormat("Invalid zip archive entry for file %s.", name));
+    }
+    const uint64_t data = local_header + kLocalFileHeaderSize +
+                          Read<uint16_t>(buffer, local_header + 26) +
+                          Read<uint16_t>(buffer, local_header + 28);
+    if (!InBounds(buffer, data, compressed_size) ||
+        (method == kStoredMethod && compressed_size != uncompressed_size)) {
+      return ZipError(
+          absl::StrFormat("Invalid zip archive entry for file %s.", name));
+    }
+    index->entries_[std::move(name)] = Entry{
+        buffer.substr(data, compressed_size), method, uncompressed_size};
+  }
+  return index;
+}
+
+bool ZipFileIndex::IsStored(absl::string_view name) const {
+  auto it = entries_.find(name);
+  return it != entries_.end() && it->second.method == kStoredMethod;
+}
+
+std::vector<std::string> ZipFileIndex::FileNames() const {
+  std::vector<std::string> names;
+  names.reserve(entries_.size());
+  for (const auto& [name, entry] : entries_) {
+    names.push_back(name);
+  }
+  return names;
+}
+
+absl::StatusOr<absl::string_view> ZipFileIndex::GetFile(
+    absl::string_view name) const {
+  auto it = entries_.find(name);
+  if (it == entries_.end()) {
+    return CreateStatusWithPayload(
+        StatusCode::kNotFound,
+        absl::StrFormat("No file with name %s in zip archive.", name),
+        MediaPipeTasksStatus::kFileZipError);
   }
-  // Perform the cleanup manually for error propagation.
-  std::move(unzipper_closer).Cancel();
-  // Close zip.
-  if (unzClose(zf) != UNZ_OK) {
-    return CreateStatusWithPayload(StatusCode::kUnknown,
-                                   "Unable to close zip archive.",
-                                   MediaPipeTasksStatus::kFileZipError);
+  const Entry& entry = it->second;
+  if (entry.method == kStoredMethod) {
+    return entry.data;
+  }
+  if (entry.method != kDeflatedMethod) {
+    return ZipError(absl::StrFormat(
+        "Unsupported compression method %d for file %s in zip archive.",
+        entry.method, name));
+  }
+  absl::MutexLock lock(&mutex_);
+  auto inflated = inflated_.find(name);
+  if (inflated == inflated_.end()) {
+    MP_ASSIGN_OR_RETURN(auto contents,
+                        Inflate(entry.data, entry.uncompressed_size));
+    inflated = inflated_.emplace(name, std::move(contents)).first;
+  }
+  return absl::string_view(*inflated->second);
+}
+
+absl::Status ExtractFilesfromZipFile(
+    const char* buffer_data, const size_t buffer_size,
+    absl::flat_hash_map<std::string, absl::string_view>* files) {
+  MP_ASSIGN_OR_RETURN(
+      auto index,
+      ZipFileIndex::Create(absl::string_view(buffer_data, buffer_size)));
+  for (std::string& name : index->FileNames()) {
+    if (!index->IsStored(name)) {
+      return ZipError("Expected uncompressed zip archive.");
+    }
+    MP_ASSIGN_OR_RETURN(absl::string_view contents, index->GetFile(name));
+    (*files)[std::move(name)] = contents;
   }
   return absl::OkStatus();
 }
@@ -16,21 +16,74 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_METADATA_UTILS_ZIP_UTILS_H_
 #define MEDIAPIPE_TASKS_CC_METADATA_UTILS_ZIP_UTILS_H_
 
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
 
 namespace mediapipe {
 namespace tasks {
 namespace metadata {
 
+// An index of the files in a zip archive held in memory, e.g. the associated
+// files packed at the end of a model FlatBuffer. The index is read from the
+// central directory of the archive and copies no file: stored (uncompressed)
+// files are returned as views into the archive buffer, and deflated files are
+// only inflated, once, the first time they are requested. The archive buffer
+// must outlive the index. This class is thread-safe.
+class ZipFileIndex {
+ public:
+  // Indexes the zip archive that ends at the end of `buffer`.
+  static absl::StatusOr<std::unique_ptr<ZipFileIndex>> Create(
+      absl::string_view buffer);
+
+  int size() const { return entries_.size(); }
+  bool Contains(absl::string_view name) const {
+    return entries_.contains(name);
+  }
+  // Returns whether file `name` is stored uncompressed in the archive, so that
+  // GetFile returns a view into the archive buffer.
+  bool IsStored(absl::string_view name) const;
+
+  // Returns the contents of file `name`. The view stays valid as long as the
+  // index and the archive buffer.
+  absl::StatusOr<absl::string_view> GetFile(absl::string_view name) const;
+
+  // Returns the names of the files of the archive, in no particular order.
+  std::vector<std::string> FileNames() const;
+
+ private:
+  struct Entry {
+    // The data of the file as found in the archive.
+    absl::string_view data;
+    // The zip compression method, 0 for stored or 8 for deflated.
+    int method;
+    uint64_t uncompressed_size;
+  };
+
+  ZipFileIndex() = default;
+
+  absl::flat_hash_map<std::string, Entry> entries_;
+  mutable absl::Mutex mutex_;
+  // Deflated files inflated so far.
+  mutable absl::flat_hash_map<std::string, std::unique_ptr<std::string>>
+      inflated_ ABSL_GUARDED_BY(mutex_);
+};
+
 // Extract files from the zip file.
 // Input: Pointer and length of the zip file in memory.
 // Outputs: A map with the filename as key and a pointer to the file contents
 // as value. The file contents returned by this function are only guaranteed to
-// stay valid while buffer_data is alive.
+// stay valid while buffer_data is alive. All files must be stored
+// uncompressed; use ZipFileIndex for archives with deflated files.
 absl::Status ExtractFilesfromZipFile(
     const char* buffer_data, const size_t buffer_size,
     absl::flat_hash_map<std::string, absl::string_view>* files);
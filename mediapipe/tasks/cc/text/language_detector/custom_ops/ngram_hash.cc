@@ -20,7 +20,6 @@ limitations under the License.
 #include <vector>
 
 #include "flatbuffers/flexbuffers.h"
-#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 #include "tensorflow/lite/string_util.h"
@@ -34,12 +33,12 @@ namespace {
 using ::flexbuffers::GetRoot;
 using ::flexbuffers::Map;
 using ::flexbuffers::TypedVector;
+using ::mediapipe::tasks::text::language_detector::custom_ops::
+    ComputeNGramHashIndices;
 using ::mediapipe::tasks::text::language_detector::custom_ops::
     LowercaseUnicodeStr;
 using ::mediapipe::tasks::text::language_detector::custom_ops::Tokenize;
 using ::mediapipe::tasks::text::language_detector::custom_ops::TokenizedOutput;
-using ::mediapipe::tasks::text::language_detector::custom_ops::hash::
-    MurmurHash64WithSeed;
 using ::tflite::GetString;
 using ::tflite::StringRef;
 
@@ -131,9 +130,9 @@ class NGramHashParams {
 
   int GetNumNGrams() const { return ngram_lengths_.size(); }
 
-  std::vector<int> GetNGramLengths() const { return ngram_lengths_; }
+  const std::vector<int>& GetNGramLengths() const { return ngram_lengths_; }
 
-  std::vector<int> GetVocabSizes() const { return vocab_sizes_; }
+  const std::vector<int>& GetVocabSizes() const { return vocab_sizes_; }
 
   const TokenizedOutput& GetTokenizedOutput() const {
     return tokenized_output_;
@@ -158,40 +157,6 @@ std::vector<int> GetIntVector(TypedVector typed_vec) {
   return vec;
 }
 
-void GetNGramHashIndices(NGramHashParams* params, int32_t* data) {
-  const int max_unicode_length = params->GetNumTokens();
-  const auto ngram_lengths = params->GetNGramLengths();
-  const auto vocab_sizes = params->GetVocabSizes();
-  const auto& tokenized_output = params->GetTokenizedOutput();
-  const auto seed = params->GetSeed();
-
-  // Compute for each ngram.
-  for (int ngram = 0; ngram < ngram_lengths.size(); ngram++) {
-    const int vocab_size = vocab_sizes[ngram];
-    const int ngram_length = ngram_lengths[ngram];
-
-    // Compute for each token within the input.
-    for (int start = 0; start < tokenized_output.tokens.size(); start++) {
-      // Compute the number of bytes for the ngram starting at the given
-      // token.
-      int num_bytes = 0;
-      for (int i = start;
-           i < tokenized_output.tokens.size() && i < (start + ngram_length);
-           i++) {
-        num_bytes += tokenized_output.tokens[i].second;
-      }
-
-      // Compute the hash for the ngram starting at the token.
-      const auto str_hash = MurmurHash64WithSeed(
-          tokenized_output.str.c_str() + tokenized_output.tokens[start].first,
-          num_bytes, seed);
-
-      // Map the hash to an index in the vocab.
-      data[ngram * max_unicode_length + start] = (str_hash % vocab_size) + 1;
-    }
-  }
-}
-
 }  // namespace
 
 void* Init(TfLiteContext* context, const char* buffer, size_t length) {
@@ -244,7 +209,9 @@ TfLiteStatus Eval(TfLiteContext* context, TfLiteNode* node) {
   }
 
   if (output->type == kTfLiteInt32) {
-    GetNGramHashIndices(params, output->data.i32);
+    ComputeNGramHashIndices(params->GetTokenizedOutput(), params->GetSeed(),
+                            params->GetNGramLengths(), params->GetVocabSizes(),
+                            output->data.i32);
   } else {
     context->ReportError(context, "Output type must be Int32.");
     return kTfLiteError;
@@ -15,10 +15,13 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/utf/utf.h"
 
 namespace mediapipe::tasks::text::language_detector::custom_ops {
@@ -93,4 +96,32 @@ void LowercaseUnicodeStr(const char* input_str, int len,
   }
 }
 
+void ComputeNGramHashIndices(const TokenizedOutput& tokenized, uint64_t seed,
+                             const std::vector<int>& ngram_lengths,
+                             const std::vector<int>& vocab_sizes,
+                             int32_t* output) {
+  const int num_tokens = tokenized.tokens.size();
+  // Byte offsets of the token boundaries in the token byte counts, so that
+  // the size of any n-gram is a single difference instead of a sum over its
+  // tokens.
+  std::vector<size_t> token_ends(num_tokens + 1, 0);
+  for (int i = 0; i < num_tokens; ++i) {
+    token_ends[i + 1] = token_ends[i] + tokenized.tokens[i].second;
+  }
+
+  const char* str = tokenized.str.data();
+  for (int ngram = 0; ngram < ngram_lengths.size(); ++ngram) {
+    const uint64_t vocab_size = vocab_sizes[ngram];
+    const int ngram_length = ngram_lengths[ngram];
+    int32_t* ngram_output = output + ngram * num_tokens;
+    for (int start = 0; start < num_tokens; ++start) {
+      const int end = std::min(num_tokens, start + ngram_length);
+      const size_t num_bytes = token_ends[end] - token_ends[start];
+      const uint64_t str_hash = hash::MurmurHash64WithSeed(
+          str + tokenized.tokens[start].first, num_bytes, seed);
+      ngram_output[start] = (str_hash % vocab_size) + 1;
+    }
+  }
+}
+
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops
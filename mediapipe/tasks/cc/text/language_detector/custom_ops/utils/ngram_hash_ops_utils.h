@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_TEXT_LANGUAGE_DETECTOR_CUSTOM_OPS_UTILS_NGRAM_HASH_OPS_UTILS_H_
 #define MEDIAPIPE_TASKS_CC_TEXT_LANGUAGE_DETECTOR_CUSTOM_OPS_UTILS_NGRAM_HASH_OPS_UTILS_H_
 
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -51,6 +52,19 @@ TokenizedOutput Tokenize(const char* input_str, int len, int max_tokens,
 void LowercaseUnicodeStr(const char* input_str, int len,
                          std::string* output_str);
 
+// Hashes the character n-grams of `tokenized` into vocabulary indices.
+//
+// For each n-gram length `ngram_lengths[k]` and each token `t`, the bytes of
+// tokens [t, t + ngram_lengths[k]) are hashed with `seed`, and the index
+// `hash % vocab_sizes[k] + 1` is written to
+// `output[k * tokenized.tokens.size() + t]`. N-grams are truncated at the end
+// of the string. `output` must have room for
+// `ngram_lengths.size() * tokenized.tokens.size()` values.
+void ComputeNGramHashIndices(const TokenizedOutput& tokenized, uint64_t seed,
+                             const std::vector<int>& ngram_lengths,
+                             const std::vector<int>& vocab_sizes,
+                             int32_t* output);
+
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops
 
 #endif  // MEDIAPIPE_TASKS_CC_TEXT_LANGUAGE_DETECTOR_CUSTOM_OPS_UTILS_NGRAM_HASH_OPS_UTILS_H_
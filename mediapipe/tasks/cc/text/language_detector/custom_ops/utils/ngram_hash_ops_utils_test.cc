@@ -15,15 +15,21 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/ngram_hash_ops_utils.h"
 
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/tasks/cc/text/language_detector/custom_ops/utils/hash/murmur.h"
 
 namespace mediapipe::tasks::text::language_detector::custom_ops {
 
 namespace {
 
+using ::mediapipe::tasks::text::language_detector::custom_ops::hash::
+    MurmurHash64WithSeed;
+using ::testing::ElementsAre;
 using ::testing::Values;
 
 std::string ReconstructStringFromTokens(TokenizedOutput output) {
@@ -131,5 +137,29 @@ TEST(LowercaseUnicodeTest, TestLowercaseUnicode) {
   }
 }
 
+TEST(ComputeNGramHashIndicesTest, HashesTruncatedNGrams) {
+  constexpr uint64_t kSeed = 123;
+  const TokenizedOutput output =
+      Tokenize("hi", /*len=*/2, /*max_tokens=*/10,
+               /*exclude_nonalphaspace_tokens=*/true);
+  ASSERT_EQ(output.str, "^hi$");
+  const std::vector<int> ngram_lengths = {1, 3};
+  const std::vector<int> vocab_sizes = {100, 1000};
+  std::vector<int32_t> indices(ngram_lengths.size() * output.tokens.size());
+  ComputeNGramHashIndices(output, kSeed, ngram_lengths, vocab_sizes,
+                          indices.data());
+
+  auto index = [&](const std::string& ngram, uint64_t vocab_size) {
+    return static_cast<int32_t>(
+        MurmurHash64WithSeed(ngram.c_str(), ngram.size(), kSeed) % vocab_size +
+        1);
+  };
+  EXPECT_THAT(indices,
+              ElementsAre(index("^", 100), index("h", 100), index("i", 100),
+                          index("$", 100), index("^hi", 1000),
+                          index("hi$", 1000), index("i$", 1000),
+                          index("$", 1000)));
+}
+
 }  // namespace
 }  // namespace mediapipe::tasks::text::language_detector::custom_ops
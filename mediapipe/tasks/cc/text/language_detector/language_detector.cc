@@ -16,7 +16,9 @@ limitations under the License.
 #include "mediapipe/tasks/cc/text/language_detector/language_detector.h"
 
 #include <memory>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -39,22 +41,32 @@ using ClassificationResultProto =
 using ::mediapipe::tasks::text::text_classifier::proto::
     TextClassifierGraphOptions;
 
-constexpr char kTextStreamName[] = "text_in";
+constexpr char kTextsStreamName[] = "texts_in";
+constexpr char kTextsTag[] = "TEXTS";
 constexpr char kTextTag[] = "TEXT";
 constexpr char kClassificationsStreamName[] = "classifications_out";
 constexpr char kClassificationsTag[] = "CLASSIFICATIONS";
 constexpr char kSubgraphTypeName[] =
     "mediapipe.tasks.text.text_classifier.TextClassifierGraph";
 
-// Creates a MediaPipe graph config that only contains a single subgraph node of
-// type "TextClassifierGraph".
+// Creates a MediaPipe graph config that runs a "TextClassifierGraph" subgraph
+// node on each text of the input vector, so that a batch of texts is
+// classified with a single call to the task runner.
 CalculatorGraphConfig CreateGraphConfig(
     std::unique_ptr<TextClassifierGraphOptions> options) {
   api2::builder::Graph graph;
+  auto& begin_loop = graph.AddNode("BeginLoopStringCalculator");
+  graph.In(kTextsTag).SetName(kTextsStreamName) >> begin_loop.In("ITERABLE");
+
   auto& subgraph = graph.AddNode(kSubgraphTypeName);
   subgraph.GetOptions<TextClassifierGraphOptions>().Swap(options.get());
-  graph.In(kTextTag).SetName(kTextStreamName) >> subgraph.In(kTextTag);
-  subgraph.Out(kClassificationsTag).SetName(kClassificationsStreamName) >>
+  begin_loop.Out("ITEM") >> subgraph.In(kTextTag);
+
+  auto& end_loop =
+      graph.AddNode("mediapipe.tasks.EndLoopClassificationResultCalculator");
+  begin_loop.Out("BATCH_END") >> end_loop.In("BATCH_END");
+  subgraph.Out(kClassificationsTag) >> end_loop.In("ITEM");
+  end_loop.Out("ITERABLE").SetName(kClassificationsStreamName) >>
       graph.Out(kClassificationsTag);
   return graph.GetConfig();
 }
@@ -112,15 +124,39 @@ absl::StatusOr<std::unique_ptr<LanguageDetector>> LanguageDetector::Create(
 
 absl::StatusOr<LanguageDetectorResult> LanguageDetector::Detect(
     absl::string_view text) {
+  MP_ASSIGN_OR_RETURN(std::vector<LanguageDetectorResult> results,
+                      DetectBatch({std::string(text)}));
+  if (results.size() != 1) {
+    return absl::InternalError(
+        "LanguageDetector returned an unexpected number of results.");
+  }
+  return std::move(results[0]);
+}
+
+absl::StatusOr<std::vector<LanguageDetectorResult>>
+LanguageDetector::DetectBatch(const std::vector<std::string>& texts) {
   MP_ASSIGN_OR_RETURN(
       auto output_packets,
       runner_->Process(
-          {{kTextStreamName, MakePacket<std::string>(std::string(text))}}));
-  ClassificationResult classification_result =
-      ConvertToClassificationResult(output_packets[kClassificationsStreamName]
-                                        .Get<ClassificationResultProto>());
-  return ExtractLanguageDetectorResultFromClassificationResult(
-      classification_result);
+          {{kTextsStreamName, MakePacket<std::vector<std::string>>(texts)}}));
+  const auto& classification_result_protos =
+      output_packets[kClassificationsStreamName]
+          .Get<std::vector<ClassificationResultProto>>();
+  if (classification_result_protos.size() != texts.size()) {
+    return absl::InternalError(
+        "LanguageDetector returned an unexpected number of results.");
+  }
+  std::vector<LanguageDetectorResult> results;
+  results.reserve(texts.size());
+  for (const auto& classification_result_proto :
+       classification_result_protos) {
+    MP_ASSIGN_OR_RETURN(
+        LanguageDetectorResult result,
+        ExtractLanguageDetectorResultFromClassificationResult(
+            ConvertToClassificationResult(classification_result_proto)));
+    results.push_back(std::move(result));
+  }
+  return results;
 }
 
 }  // namespace mediapipe::tasks::text::language_detector
@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
@@ -119,6 +120,33 @@ TEST_F(LanguageDetectorTest, TestL2CModel) {
       kTolerance));
 }
 
+TEST_F(LanguageDetectorTest, TestDetectBatch) {
+  auto options = std::make_unique<LanguageDetectorOptions>();
+  options->base_options.model_asset_path = GetFullPath(kLanguageDetector);
+  options->classifier_options.score_threshold = 0.3;
+  MP_ASSERT_OK_AND_ASSIGN(std::unique_ptr<LanguageDetector> language_detector,
+                          LanguageDetector::Create(std::move(options)));
+  MP_ASSERT_OK_AND_ASSIGN(
+      std::vector<LanguageDetectorResult> results,
+      language_detector->DetectBatch(
+          {"To be, or not to be, that is the question",
+           "это какой-то английский язык", "分久必合合久必分"}));
+  ASSERT_EQ(results.size(), 3);
+  MP_EXPECT_OK(MatchesLanguageDetectorResult(
+      {{.language_code = "en", .probability = 0.999856}}, results[0],
+      kTolerance));
+  MP_EXPECT_OK(MatchesLanguageDetectorResult(
+      {{.language_code = "ru", .probability = 0.993362}}, results[1],
+      kTolerance));
+  MP_EXPECT_OK(MatchesLanguageDetectorResult(
+      {{.language_code = "zh", .probability = 0.505424},
+       {.language_code = "ja", .probability = 0.481617}},
+      results[2], kTolerance));
+
+  MP_ASSERT_OK_AND_ASSIGN(results, language_detector->DetectBatch({}));
+  EXPECT_TRUE(results.empty());
+}
+
 TEST_F(LanguageDetectorTest, TestMultiplePredictions) {
   auto options = std::make_unique<LanguageDetectorOptions>();
   options->base_options.model_asset_path = GetFullPath(kLanguageDetector);
@@ -15,8 +15,15 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "tensorflow_text/core/kernels/regex_split.h"
 
 namespace mediapipe {
@@ -24,37 +31,88 @@ namespace tasks {
 namespace text {
 namespace tokenizers {
 
-FlatHashMapBackedWordpiece::FlatHashMapBackedWordpiece(
-    const std::vector<std::string>& vocab)
-    : vocab_{vocab} {
-  for (int i = 0; i < vocab_.size(); ++i) {
-    index_map_[vocab_[i]] = i;
+namespace {
+
+// How kDefaultDelimRe and kDefaultIncludeDelimRe treat ASCII characters.
+enum class AsciiClass : uint8_t {
+  // Part of a token.
+  kWord,
+  // \s, which separates tokens and is dropped.
+  kSpace,
+  // [!-/], [:-@], [\[-`] and [{-~], which become tokens of their own. They
+  // include all ASCII characters in \p{P}.
+  kPunctuation,
+};
+
+constexpr std::array<AsciiClass, 128> MakeAsciiClasses() {
+  std::array<AsciiClass, 128> classes{};
+  for (int c = 0; c < 128; ++c) {
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\f' || c == '\r') {
+      classes[c] = AsciiClass::kSpace;
+    } else if ((c >= '!' && c <= '/') || (c >= ':' && c <= '@') ||
+               (c >= '[' && c <= '`') || (c >= '{' && c <= '~')) {
+      classes[c] = AsciiClass::kPunctuation;
+    } else {
+      classes[c] = AsciiClass::kWord;
+    }
   }
+  return classes;
 }
 
+constexpr std::array<AsciiClass, 128> kAsciiClasses = MakeAsciiClasses();
+
+// Written as a branch-free reduction, so that compilers vectorize it.
+bool IsAscii(absl::string_view text) {
+  uint8_t bits = 0;
+  for (char c : text) bits |= static_cast<uint8_t>(c);
+  return bits < 0x80;
+}
+
+bool IsUtf8Continuation(char c) {
+  return (static_cast<uint8_t>(c) & 0xC0) == 0x80;
+}
+
+// Returns the start of the UTF-8 character that ends at `end`.
+size_t PreviousCharBoundary(absl::string_view text, size_t end) {
+  do {
+    --end;
+  } while (end > 0 && IsUtf8Continuation(text[end]));
+  return end;
+}
+
+// Returns the end of the UTF-8 character that starts at `start`.
+size_t NextCharBoundary(absl::string_view text, size_t start) {
+  do {
+    ++start;
+  } while (start < text.size() && IsUtf8Continuation(text[start]));
+  return start;
+}
+
+size_t NumChars(absl::string_view text) {
+  return std::count_if(text.begin(), text.end(),
+                       [](char c) { return !IsUtf8Continuation(c); });
+}
+
+}  // namespace
+
+FlatHashMapBackedWordpiece::FlatHashMapBackedWordpiece(
+    const std::vector<std::string>& vocab)
+    : vocab_{FlatVocab::FromWords(vocab)} {}
+
 tensorflow::text::LookupStatus FlatHashMapBackedWordpiece::Contains(
     absl::string_view key, bool* value) const {
-  *value = index_map_.contains(key);
+  *value = vocab_.Contains(key);
   return tensorflow::text::LookupStatus();
 }
 
 bool FlatHashMapBackedWordpiece::LookupId(const absl::string_view key,
                                           int* result) const {
-  auto it = index_map_.find(key);
-  if (it == index_map_.end()) {
-    return false;
-  }
-  *result = it->second;
-  return true;
+  return vocab_.LookupId(key, result);
 }
 
 bool FlatHashMapBackedWordpiece::LookupWord(int vocab_id,
                                             absl::string_view* result) const {
-  if (vocab_id >= vocab_.size() || vocab_id < 0) {
-    return false;
-  }
-  *result = vocab_[vocab_id];
-  return true;
+  return vocab_.LookupWord(vocab_id, result);
 }
 
 TokenizerResult BertTokenizer::Tokenize(const std::string& input) {
@@ -104,6 +162,122 @@ WordpieceTokenizerResult BertTokenizer::TokenizeWordpiece(
   return result;
 }
 
+void BertTokenizer::TokenizeToIds(absl::string_view input,
+                                  std::vector<int>& ids) const {
+  std::string lookup;
+  if (default_delimiters_ && IsAscii(input)) {
+    size_t token_start = 0;
+    for (size_t i = 0; i < input.size(); ++i) {
+      const AsciiClass ascii_class = kAsciiClasses[static_cast<uint8_t>(input[i])];
+      if (ascii_class == AsciiClass::kWord) continue;
+      if (i > token_start) {
+        AppendWordpieceIds(input.substr(token_start, i - token_start), lookup,
+                           ids);
+      }
+      if (ascii_class == AsciiClass::kPunctuation) {
+        AppendWordpieceIds(input.substr(i, 1), lookup, ids);
+      }
+      token_start = i + 1;
+    }
+    if (token_start < input.size()) {
+      AppendWordpieceIds(input.substr(token_start), lookup, ids);
+    }
+    return;
+  }
+
+  std::vector<absl::string_view> tokens;
+  std::vector<long long> begin_offsets;
+  std::vector<long long> end_offsets;
+  tensorflow::text::RegexSplit(input, delim_re_, true, include_delim_re_,
+                               &tokens, &begin_offsets, &end_offsets);
+  for (absl::string_view token : tokens) {
+    AppendWordpieceIds(token, lookup, ids);
+  }
+}
+
+// Mirrors tensorflow::text::WordpieceTokenize(): greedy longest-match-first
+// from the left, with whole-token fallbacks for tokens that are too long or
+// cannot be covered by the vocabulary.
+void BertTokenizer::AppendWordpieceIds(absl::string_view token,
+                                       std::string& lookup,
+                                       std::vector<int>& ids) const {
+  auto lookup_id = [this](absl::string_view key) {
+    int id;
+    return vocab_.LookupId(key, &id) ? id : -1;
+  };
+  auto unknown_id = [&](absl::string_view piece) {
+    return lookup_id(options_.use_unknown_token ? options_.unknown_token
+                                                : piece);
+  };
+
+  if (token.size() > options_.max_bytes_per_token) {
+    ids.push_back(unknown_id(token));
+    return;
+  }
+
+  const size_t num_ids = ids.size();
+  size_t start = 0;
+  while (start < token.size()) {
+    int id = -1;
+    size_t end = token.size();
+    for (; end > start; end = PreviousCharBoundary(token, end)) {
+      const absl::string_view piece = token.substr(start, end - start);
+      if (options_.max_chars_per_subtoken > 0 &&
+          NumChars(piece) > options_.max_chars_per_subtoken) {
+        continue;
+      }
+      absl::string_view key = piece;
+      if (start > 0) {
+        lookup.assign(options_.suffix_indicator);
+        lookup.append(piece.data(), piece.size());
+        key = lookup;
+      }
+      id = lookup_id(key);
+      if (id >= 0) break;
+    }
+
+    if (end > start) {
+      ids.push_back(id);
+    } else if (options_.split_unknown_chars) {
+      end = NextCharBoundary(token, start);
+      ids.push_back(unknown_id(token.substr(start, end - start)));
+    } else {
+      // The whole token becomes a single unknown wordpiece.
+      ids.resize(num_ids);
+      ids.push_back(unknown_id(token));
+      return;
+    }
+    start = end;
+  }
+}
+
+void BertTokenizer::TokenizeBatch(absl::Span<const absl::string_view> inputs,
+                                  int cls_id, int sep_id, int max_seq_len,
+                                  int32_t* ids, int32_t* segment_ids,
+                                  int32_t* masks) const {
+  std::vector<int> wordpiece_ids;
+  for (size_t row = 0; row < inputs.size(); ++row) {
+    wordpiece_ids.clear();
+    TokenizeToIds(inputs[row], wordpiece_ids);
+    const int num_wordpieces =
+        std::min<int>(wordpiece_ids.size(), max_seq_len - 2);
+    const int num_tokens = num_wordpieces + 2;
+
+    int32_t* row_ids = ids + row * max_seq_len;
+    row_ids[0] = cls_id;
+    for (int i = 0; i < num_wordpieces; ++i) {
+      row_ids[i + 1] = std::max(wordpiece_ids[i], 0);
+    }
+    row_ids[num_wordpieces + 1] = sep_id;
+    std::fill(row_ids + num_tokens, row_ids + max_seq_len, 0);
+
+    int32_t* row_masks = masks + row * max_seq_len;
+    std::fill(row_masks, row_masks + num_tokens, 1);
+    std::fill(row_masks + num_tokens, row_masks + max_seq_len, 0);
+  }
+  std::fill(segment_ids, segment_ids + inputs.size() * max_seq_len, 0);
+}
+
 }  // namespace tokenizers
 }  // namespace text
 }  // namespace tasks
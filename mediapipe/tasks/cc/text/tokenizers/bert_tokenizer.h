@@ -17,12 +17,14 @@ limitations under the License.
 #define MEDIAPIPE_TASKS_CC_TEXT_TOKENIZERS_BERT_TOKENIZER_H_
 
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
 #include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
 #include "re2/re2.h"
@@ -73,6 +75,8 @@ struct BertTokenizerOptions {
 class FlatHashMapBackedWordpiece : public tensorflow::text::WordpieceVocab {
  public:
   explicit FlatHashMapBackedWordpiece(const std::vector<std::string>& vocab);
+  explicit FlatHashMapBackedWordpiece(FlatVocab vocab)
+      : vocab_{std::move(vocab)} {}
 
   tensorflow::text::LookupStatus Contains(absl::string_view key,
                                           bool* value) const override;
@@ -82,8 +86,7 @@ class FlatHashMapBackedWordpiece : public tensorflow::text::WordpieceVocab {
 
  private:
   // All words indexed position in vocabulary file.
-  std::vector<std::string> vocab_;
-  absl::flat_hash_map<absl::string_view, int> index_map_;
+  FlatVocab vocab_;
 };
 
 // Wordpiece tokenizer for bert models. Initialized with a vocab file or vector.
@@ -92,23 +95,30 @@ class BertTokenizer : public mediapipe::tasks::text::tokenizers::Tokenizer {
   // Initialize the tokenizer from vocab vector and tokenizer configs.
   explicit BertTokenizer(const std::vector<std::string>& vocab,
                          const BertTokenizerOptions& options = {})
-      : vocab_{FlatHashMapBackedWordpiece(vocab)},
+      : BertTokenizer(FlatVocab::FromWords(vocab), options) {}
+
+  // Initialize the tokenizer from a loaded vocab and tokenizer configs.
+  explicit BertTokenizer(FlatVocab vocab,
+                         const BertTokenizerOptions& options = {})
+      : vocab_{std::move(vocab)},
         options_{options},
         delim_re_{options.delim_str},
-        include_delim_re_{options.include_delim_str} {}
+        include_delim_re_{options.include_delim_str},
+        default_delimiters_{options.delim_str == kDefaultDelimRe &&
+                            options.include_delim_str ==
+                                kDefaultIncludeDelimRe} {}
 
   // Initialize the tokenizer from file path to vocab and tokenizer configs.
   explicit BertTokenizer(const std::string& path_to_vocab,
                          const BertTokenizerOptions& options = {})
-      : BertTokenizer(mediapipe::tasks::text::LoadVocabFromFile(path_to_vocab),
-                      options) {}
+      : BertTokenizer(FlatVocab::FromFile(path_to_vocab), options) {}
 
   // Initialize the tokenizer from buffer and size of vocab and tokenizer
   // configs.
   BertTokenizer(const char* vocab_buffer_data, size_t vocab_buffer_size,
                 const BertTokenizerOptions& options = {})
-      : BertTokenizer(mediapipe::tasks::text::LoadVocabFromBuffer(
-                          vocab_buffer_data, vocab_buffer_size),
+      : BertTokenizer(FlatVocab::FromBuffer(absl::string_view(
+                          vocab_buffer_data, vocab_buffer_size)),
                       options) {}
 
   // Perform tokenization, return tokenized results containing the subwords.
@@ -118,6 +128,26 @@ class BertTokenizer : public mediapipe::tasks::text::tokenizers::Tokenizer {
   // subwords and offsets
   WordpieceTokenizerResult TokenizeWordpiece(const std::string& input) const;
 
+  // Appends the vocabulary ids of the wordpieces of `input` to `ids`. This is
+  // equivalent to looking up the subwords of TokenizeWordpiece(), but creates
+  // no string per token or wordpiece. ASCII input split by the default
+  // delimiters skips the regular expressions too. Wordpieces that are not in
+  // the vocabulary, which only occur with use_unknown_token = false, get id -1.
+  void TokenizeToIds(absl::string_view input, std::vector<int>& ids) const;
+
+  // Tokenizes a batch of inputs straight into the row-major
+  // [inputs.size(), max_seq_len] int32 input buffers of a BERT model:
+  //
+  //   ids          [CLS] w1  w2 ... wn [SEP]  0  0 ... 0
+  //   segment_ids    0    0   0 ...  0   0    0  0 ... 0
+  //   masks          1    1   1 ...  1   1    0  0 ... 0
+  //
+  // Wordpieces are truncated to fit into `max_seq_len`, which must be at least
+  // 2. Wordpieces that are not in the vocabulary are written as 0.
+  void TokenizeBatch(absl::Span<const absl::string_view> inputs, int cls_id,
+                     int sep_id, int max_seq_len, int32_t* ids,
+                     int32_t* segment_ids, int32_t* masks) const;
+
   // Check if a certain key is included in the vocab.
   tensorflow::text::LookupStatus Contains(const absl::string_view key,
                                           bool* value) const {
@@ -137,10 +167,17 @@ class BertTokenizer : public mediapipe::tasks::text::tokenizers::Tokenizer {
   int VocabularySize() const { return vocab_.VocabularySize(); }
 
  private:
+  // Appends the ids of the wordpieces of a single pre-tokenized `token`.
+  // `lookup` is scratch space for suffixed wordpieces.
+  void AppendWordpieceIds(absl::string_view token, std::string& lookup,
+                          std::vector<int>& ids) const;
+
   mediapipe::tasks::text::tokenizers::FlatHashMapBackedWordpiece vocab_;
   BertTokenizerOptions options_;
   RE2 delim_re_;
   RE2 include_delim_re_;
+  // Whether the delimiters are kDefaultDelimRe and kDefaultIncludeDelimRe.
+  bool default_delimiters_;
 };
 
 }  // namespace tokenizers
@@ -15,6 +15,11 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/tokenizers/bert_tokenizer.h"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/tasks/cc/core/utils.h"
@@ -106,6 +111,78 @@ TEST(TokenizerTest, TestTokenizerUnknownTokens) {
   EXPECT_THAT(results.row_lengths, ElementsAre(1, 1, 1, 1));
 }
 
+// TokenizeToIds() must agree with looking up the subwords of
+// TokenizeWordpiece(), for both the ASCII fast path and the regex path.
+TEST(TokenizerTest, TestTokenizeToIdsMatchesTokenizeWordpiece) {
+#ifdef _WIN32
+  // TODO: Investigate why these tests are failing
+  GTEST_SKIP("Unexpected result on Windows");
+#endif  // _WIN32
+  auto tokenizer = absl::make_unique<BertTokenizer>(kTestVocabPath);
+
+  const std::vector<std::string> inputs = {
+      "i'm questionansweraskask",
+      "  hello,\tworld!!  ",
+      "",
+      "it costs $5.99 (roughly)",
+      // Non-ASCII input takes the regex path.
+      "caf\xc3\xa9 na\xc3\xafve \xe4\xbd\xa0\xe5\xa5\xbd",
+      // Exceeds max_bytes_per_token.
+      std::string(150, 'a') + " zzzzqx",
+  };
+  for (const std::string& input : inputs) {
+    std::vector<int> expected_ids;
+    for (const std::string& subword :
+         tokenizer->TokenizeWordpiece(input).subwords) {
+      int id = -1;
+      tokenizer->LookupId(subword, &id);
+      expected_ids.push_back(id);
+    }
+    std::vector<int> ids;
+    tokenizer->TokenizeToIds(input, ids);
+    EXPECT_EQ(ids, expected_ids) << input;
+  }
+}
+
+TEST(TokenizerTest, TestTokenizeToIdsUnknownTokens) {
+  std::vector<std::string> vocab;
+  vocab.emplace_back("i");
+  vocab.emplace_back("'");
+  vocab.emplace_back("m");
+  vocab.emplace_back("question");
+  vocab.emplace_back(kDefaultUnknownToken);
+  vocab.emplace_back("##ans");
+  auto tokenizer = absl::make_unique<BertTokenizer>(vocab);
+
+  std::vector<int> ids;
+  tokenizer->TokenizeToIds("i'm questionansweraskask questionans", ids);
+
+  EXPECT_THAT(ids, ElementsAre(0, 1, 2, 4, 3, 5));
+}
+
+TEST(TokenizerTest, TestTokenizeBatch) {
+  std::vector<std::string> vocab;
+  vocab.emplace_back("[CLS]");
+  vocab.emplace_back("[SEP]");
+  vocab.emplace_back("i");
+  vocab.emplace_back("'");
+  vocab.emplace_back("m");
+  vocab.emplace_back("question");
+  auto tokenizer = absl::make_unique<BertTokenizer>(vocab);
+
+  constexpr int kMaxSeqLen = 5;
+  std::vector<int32_t> ids(2 * kMaxSeqLen, -1);
+  std::vector<int32_t> segment_ids(2 * kMaxSeqLen, -1);
+  std::vector<int32_t> masks(2 * kMaxSeqLen, -1);
+  const std::vector<absl::string_view> inputs = {"question", "i'm question"};
+  tokenizer->TokenizeBatch(inputs, /*cls_id=*/0, /*sep_id=*/1, kMaxSeqLen,
+                           ids.data(), segment_ids.data(), masks.data());
+
+  EXPECT_THAT(ids, ElementsAre(0, 5, 1, 0, 0, 0, 2, 3, 4, 1));
+  EXPECT_THAT(segment_ids, ElementsAre(0, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+  EXPECT_THAT(masks, ElementsAre(1, 1, 1, 0, 0, 1, 1, 1, 1, 1));
+}
+
 TEST(TokenizerTest, TestLookupId) {
   std::vector<std::string> vocab;
   vocab.emplace_back("i");
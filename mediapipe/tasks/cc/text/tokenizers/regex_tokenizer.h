@@ -19,9 +19,9 @@ limitations under the License.
 #include <cstddef>
 #include <string>
 
-#include "absl/container/node_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "mediapipe/tasks/cc/text/tokenizers/tokenizer.h"
+#include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
 #include "re2/re2.h"
 
 namespace mediapipe {
@@ -51,8 +51,7 @@ class RegexTokenizer : public Tokenizer {
 
  private:
   RE2 delim_re_;
-  absl::node_hash_map<std::string, int> token_index_map_;
-  absl::node_hash_map<int, absl::string_view> index_token_map_;
+  FlatVocab vocab_;
 };
 
 }  // namespace tokenizers
@@ -16,8 +16,16 @@ limitations under the License.
 #include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
 
 #include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/port/file_helpers.h"
 #include "mediapipe/util/resource_util.h"
 
 namespace mediapipe {
@@ -65,6 +73,34 @@ std::vector<std::string> ReadIStreamByLine(std::istream* istream) {
   return vocab_from_file;
 }
 
+// Calls `line_processor` on each non-empty line of `text` like
+// ReadIStreamLineByLine, but without copying the lines.
+template <typename LineProcessor>
+void ForEachLine(absl::string_view text, LineProcessor line_processor) {
+  size_t start = 0;
+  while (start < text.size()) {
+    size_t end = text.find('\n', start);
+    if (end == absl::string_view::npos) {
+      end = text.size();
+    }
+    absl::string_view line = text.substr(start, end - start);
+    if (!line.empty()) {
+      if (line.back() == '\r') {  // Remove \r on Windows
+        line.remove_suffix(1);
+      }
+      line_processor(line);
+    }
+    start = end + 1;
+  }
+}
+
+std::string ReadResource(const std::string& path) {
+  std::string contents;
+  // Like the Load*FromFile functions, a missing file gives an empty vocab.
+  file::GetContents(*PathToResourceAsFile(path), &contents).IgnoreError();
+  return contents;
+}
+
 }  // namespace
 
 std::vector<std::string> LoadVocabFromFile(const std::string& path_to_vocab) {
@@ -99,6 +135,87 @@ absl::node_hash_map<std::string, int> LoadVocabAndIndexFromBuffer(
   return ReadIStreamLineSplits(&in);
 }
 
+FlatVocab FlatVocab::FromBuffer(absl::string_view buffer) {
+  return FromText(std::string(buffer), /*indexed=*/false);
+}
+
+FlatVocab FlatVocab::FromFile(const std::string& path_to_vocab) {
+  return FromText(ReadResource(path_to_vocab), /*indexed=*/false);
+}
+
+FlatVocab FlatVocab::FromIndexedBuffer(absl::string_view buffer) {
+  return FromText(std::string(buffer), /*indexed=*/true);
+}
+
+FlatVocab FlatVocab::FromIndexedFile(const std::string& path_to_vocab) {
+  return FromText(ReadResource(path_to_vocab), /*indexed=*/true);
+}
+
+FlatVocab FlatVocab::FromText(std::string text, bool indexed) {
+  FlatVocab vocab;
+  vocab.indexed_ = indexed;
+  vocab.text_ = std::make_unique<std::string>(std::move(text));
+  ForEachLine(*vocab.text_, [&vocab](absl::string_view line) {
+    if (!vocab.indexed_) {
+      vocab.Add(line, vocab.size_);
+      return;
+    }
+    std::vector<absl::string_view> fields = absl::StrSplit(line, ' ');
+    int id;
+    if (fields.size() >= 2 && absl::SimpleAtoi(fields[1], &id)) {
+      vocab.Add(fields[0], id);
+    }
+  });
+  return vocab;
+}
+
+FlatVocab FlatVocab::FromWords(const std::vector<std::string>& words) {
+  FlatVocab vocab;
+  vocab.text_ = std::make_unique<std::string>(absl::StrJoin(words, ""));
+  absl::string_view text = *vocab.text_;
+  size_t offset = 0;
+  for (const std::string& word : words) {
+    vocab.Add(text.substr(offset, word.size()), vocab.size_);
+    offset += word.size();
+  }
+  return vocab;
+}
+
+void FlatVocab::Add(absl::string_view word, int id) {
+  ids_.insert_or_assign(word, id);
+  if (indexed_) {
+    indexed_words_.insert_or_assign(id, word);
+  } else {
+    words_.push_back(word);
+  }
+  ++size_;
+}
+
+bool FlatVocab::LookupId(absl::string_view word, int* id) const {
+  auto it = ids_.find(word);
+  if (it == ids_.end()) {
+    return false;
+  }
+  *id = it->second;
+  return true;
+}
+
+bool FlatVocab::LookupWord(int id, absl::string_view* word) const {
+  if (indexed_) {
+    auto it = indexed_words_.find(id);
+    if (it == indexed_words_.end()) {
+      return false;
+    }
+    *word = it->second;
+    return true;
+  }
+  if (id < 0 || id >= words_.size()) {
+    return false;
+  }
+  *word = words_[id];
+  return true;
+}
+
 }  // namespace text
 }  // namespace tasks
 }  // namespace mediapipe
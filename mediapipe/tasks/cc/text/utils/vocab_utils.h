@@ -16,10 +16,13 @@ limitations under the License.
 #ifndef MEDIAPIPE_TASKS_CC_TEXT_UTILS_VOCAB_UTILS_H_
 #define MEDIAPIPE_TASKS_CC_TEXT_UTILS_VOCAB_UTILS_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
+#include "absl/strings/string_view.h"
 
 namespace mediapipe {
 namespace tasks {
@@ -43,6 +46,59 @@ absl::node_hash_map<std::string, int> LoadVocabAndIndexFromFile(
 absl::node_hash_map<std::string, int> LoadVocabAndIndexFromBuffer(
     const char* vocab_buffer_data, const size_t vocab_buffer_size);
 
+// A vocabulary that keeps a single copy of its source text and refers to the
+// words as string_views into it. Loading makes one allocation for the text
+// and one per lookup table, instead of one std::string per word and per hash
+// map node as the Load* functions above, which matters for vocabularies with
+// hundreds of thousands of words.
+class FlatVocab {
+ public:
+  // Creates a vocabulary from a buffer with one word on each line. The id of
+  // a word is its position among the non-empty lines, as in
+  // LoadVocabFromBuffer(). If a word appears several times, it is looked up
+  // by its last id.
+  static FlatVocab FromBuffer(absl::string_view buffer);
+  static FlatVocab FromFile(const std::string& path_to_vocab);
+
+  // Creates a vocabulary from a buffer with one word and its id separated by
+  // a space on each line, as in LoadVocabAndIndexFromBuffer(). Lines without
+  // a valid id are skipped.
+  static FlatVocab FromIndexedBuffer(absl::string_view buffer);
+  static FlatVocab FromIndexedFile(const std::string& path_to_vocab);
+
+  // Creates a vocabulary in which the id of each of `words` is its position.
+  static FlatVocab FromWords(const std::vector<std::string>& words);
+
+  FlatVocab(FlatVocab&&) = default;
+  FlatVocab& operator=(FlatVocab&&) = default;
+
+  bool Contains(absl::string_view word) const { return ids_.contains(word); }
+  bool LookupId(absl::string_view word, int* id) const;
+  bool LookupWord(int id, absl::string_view* word) const;
+
+  // The number of words that were loaded, duplicates included.
+  int size() const { return size_; }
+
+ private:
+  FlatVocab() = default;
+
+  // Creates a vocabulary owning `text`, in one of the formats above.
+  static FlatVocab FromText(std::string text, bool indexed);
+
+  // Adds `word`, which must point into text_, with `id`.
+  void Add(absl::string_view word, int id);
+
+  // Heap allocated, so that the string_views stay valid when moved.
+  std::unique_ptr<std::string> text_;
+  int size_ = 0;
+  absl::flat_hash_map<absl::string_view, int> ids_;
+  // Words by id when the ids are the positions of the words.
+  std::vector<absl::string_view> words_;
+  // Words by id otherwise.
+  absl::flat_hash_map<int, absl::string_view> indexed_words_;
+  bool indexed_ = false;
+};
+
 }  // namespace text
 }  // namespace tasks
 }  // namespace mediapipe
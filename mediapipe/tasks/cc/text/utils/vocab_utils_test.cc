@@ -15,7 +15,12 @@ limitations under the License.
 
 #include "mediapipe/tasks/cc/text/utils/vocab_utils.h"
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "absl/container/node_hash_map.h"
+#include "absl/strings/string_view.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/tasks/cc/core/utils.h"
@@ -66,6 +71,73 @@ TEST(CommonUtilsTest, TestLoadVocabAndIndexFromBuffer) {
                                           Pair("token3", 2)));
 }
 
+TEST(FlatVocabTest, LoadsPositionalVocabFromFile) {
+  FlatVocab vocab = FlatVocab::FromFile(kVocabPath);
+
+  EXPECT_EQ(vocab.size(), 3);
+  EXPECT_TRUE(vocab.Contains("token2"));
+  EXPECT_FALSE(vocab.Contains("token4"));
+  int id;
+  ASSERT_TRUE(vocab.LookupId("token3", &id));
+  EXPECT_EQ(id, 2);
+  absl::string_view word;
+  ASSERT_TRUE(vocab.LookupWord(0, &word));
+  EXPECT_EQ(word, "token1");
+  EXPECT_FALSE(vocab.LookupWord(3, &word));
+  EXPECT_FALSE(vocab.LookupWord(-1, &word));
+}
+
+TEST(FlatVocabTest, LoadsIndexedVocabFromBuffer) {
+  FlatVocab vocab = FlatVocab::FromIndexedBuffer(
+      LoadBinaryContent(kVocabAndIndexPath));
+
+  EXPECT_EQ(vocab.size(), 3);
+  int id;
+  ASSERT_TRUE(vocab.LookupId("token2", &id));
+  EXPECT_EQ(id, 1);
+  absl::string_view word;
+  ASSERT_TRUE(vocab.LookupWord(2, &word));
+  EXPECT_EQ(word, "token3");
+}
+
+TEST(FlatVocabTest, MatchesLineHandlingOfLoadFunctions) {
+  constexpr char kBuffer[] = "a\r\n\nb\nc\r\na\n";
+  FlatVocab vocab = FlatVocab::FromBuffer(kBuffer);
+  std::vector<std::string> words =
+      LoadVocabFromBuffer(kBuffer, sizeof(kBuffer) - 1);
+
+  ASSERT_EQ(vocab.size(), words.size());
+  for (int i = 0; i < words.size(); ++i) {
+    absl::string_view word;
+    ASSERT_TRUE(vocab.LookupWord(i, &word));
+    EXPECT_EQ(word, words[i]);
+  }
+  // The last duplicate wins, as when filling a map from the vector.
+  int id;
+  ASSERT_TRUE(vocab.LookupId("a", &id));
+  EXPECT_EQ(id, 3);
+}
+
+TEST(FlatVocabTest, SkipsIndexedLinesWithoutId) {
+  FlatVocab vocab = FlatVocab::FromIndexedBuffer("a 3\nb\nc x\nd 7\n");
+
+  EXPECT_EQ(vocab.size(), 2);
+  EXPECT_FALSE(vocab.Contains("b"));
+  EXPECT_FALSE(vocab.Contains("c"));
+  absl::string_view word;
+  ASSERT_TRUE(vocab.LookupWord(7, &word));
+  EXPECT_EQ(word, "d");
+}
+
+TEST(FlatVocabTest, OutlivesMovedFromWords) {
+  FlatVocab vocab = FlatVocab::FromWords({"x", "y"});
+  FlatVocab moved = std::move(vocab);
+
+  int id;
+  ASSERT_TRUE(moved.LookupId("y", &id));
+  EXPECT_EQ(id, 1);
+}
+
 }  // namespace text
 }  // namespace tasks
 }  // namespace mediapipe
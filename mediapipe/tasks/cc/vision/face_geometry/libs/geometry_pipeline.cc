@@ -40,6 +40,15 @@
 namespace mediapipe::tasks::vision::face_geometry {
 namespace {
 
+// Face meshes with up to this many vertices are processed in fixed-capacity
+// landmark matrices that live on the stack, so that estimating the geometry
+// doesn't allocate per face. This covers both the 468-vertex canonical face
+// mesh and the 478-vertex one with irises.
+constexpr int kMaxStackLandmarks = 478;
+
+using StackMatrix3Xf = Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor,
+                                     3, kMaxStackLandmarks>;
+
 struct PerspectiveCameraFrustum {
   // NOTE: all arguments must be validated prior to calling this constructor.
   PerspectiveCameraFrustum(const proto::PerspectiveCamera& perspective_camera,
@@ -83,8 +92,12 @@ class ScreenToMetricSpaceConverter {
         landmark_weights_(std::move(landmark_weights)),
         procrustes_solver_(std::move(procrustes_solver)) {}
 
-  // Converts `screen_landmark_list` into `metric_landmark_list` and estimates
-  // the `pose_transform_mat`.
+  // Converts `screen_landmark_list` into `metric_landmarks` and estimates the
+  // `pose_transform_mat`.
+  //
+  // `screen_landmarks` is used as a scratch buffer. Both matrices are resized
+  // as needed, so callers can reuse them across faces to avoid reallocating.
+  // `Matrix3X` is either `Eigen::Matrix3Xf` or `StackMatrix3Xf`.
   //
   // Here's the algorithm summary:
   //
@@ -120,27 +133,32 @@ class ScreenToMetricSpaceConverter {
   //
   //       To keep the logic correct, the landmark set handedness is changed any
   //       time the screen-to-metric semantic barrier is passed.
+  template <typename Matrix3X>
   absl::Status Convert(
       const mediapipe::NormalizedLandmarkList& screen_landmark_list,  //
       const PerspectiveCameraFrustum& pcf,                            //
-      mediapipe::LandmarkList& metric_landmark_list,                  //
+      Matrix3X& screen_landmarks,                                     //
+      Matrix3X& metric_landmarks,                                     //
       Eigen::Matrix4f& pose_transform_mat) const {
     RET_CHECK_EQ(screen_landmark_list.landmark_size(),
                  canonical_metric_landmarks_.cols())
         << "The number of landmarks doesn't match the number passed upon "
            "initialization!";
 
-    Eigen::Matrix3Xf screen_landmarks;
     ConvertLandmarkListToEigenMatrix(screen_landmark_list, screen_landmarks);
 
     ProjectXY(pcf, screen_landmarks);
     const float depth_offset = screen_landmarks.row(2).mean();
 
+    // `metric_landmarks` holds the intermediate landmarks until the final
+    // estimation below.
+    Matrix3X& intermediate_landmarks = metric_landmarks;
+
     // 1st iteration: don't unproject XY because it's unsafe to do so due to
     //                the relative nature of the Z coordinate. Instead, run the
     //                first estimation on the projected XY and use that scale to
     //                unproject for the 2nd iteration.
-    Eigen::Matrix3Xf intermediate_landmarks(screen_landmarks);
+    intermediate_landmarks = screen_landmarks;
     ChangeHandedness(intermediate_landmarks);
 
     MP_ASSIGN_OR_RETURN(const float first_iteration_scale,
@@ -163,10 +181,8 @@ class ScreenToMetricSpaceConverter {
           landmark_weights_, intermediate_pose_transform_mat))
           << "Failed to estimate pose transform matrix!";
 
-      intermediate_landmarks.row(2) =
-          (intermediate_pose_transform_mat *
-           canonical_metric_landmarks_.colwise().homogeneous())
-              .row(2);
+      SetZFromCanonicalLandmarks(intermediate_pose_transform_mat,
+                                 intermediate_landmarks);
     }
     MP_ASSIGN_OR_RETURN(const float second_iteration_scale,
                         EstimateScale(intermediate_landmarks),
@@ -178,43 +194,44 @@ class ScreenToMetricSpaceConverter {
     UnprojectXY(pcf, screen_landmarks);
     ChangeHandedness(screen_landmarks);
 
-    // At this point, screen landmarks are converted into metric landmarks.
-    Eigen::Matrix3Xf& metric_landmarks = screen_landmarks;
+    // At this point, screen landmarks are converted into metric landmarks that
+    // are not yet aligned with the canonical ones.
+    Matrix3X& unaligned_metric_landmarks = screen_landmarks;
 
     MP_RETURN_IF_ERROR(procrustes_solver_->SolveWeightedOrthogonalProblem(
-        canonical_metric_landmarks_, metric_landmarks, landmark_weights_,
-        pose_transform_mat))
+        canonical_metric_landmarks_, unaligned_metric_landmarks,
+        landmark_weights_, pose_transform_mat))
         << "Failed to estimate pose transform matrix!";
 
     // For face detection input landmarks, re-write Z-coord from the canonical
     // landmarks and run the pose transform estimation again.
     if (input_source_ == proto::InputSource::FACE_DETECTION_PIPELINE) {
-      metric_landmarks.row(2) =
-          (pose_transform_mat *
-           canonical_metric_landmarks_.colwise().homogeneous())
-              .row(2);
+      SetZFromCanonicalLandmarks(pose_transform_mat,
+                                 unaligned_metric_landmarks);
 
       MP_RETURN_IF_ERROR(procrustes_solver_->SolveWeightedOrthogonalProblem(
-          canonical_metric_landmarks_, metric_landmarks, landmark_weights_,
-          pose_transform_mat))
+          canonical_metric_landmarks_, unaligned_metric_landmarks,
+          landmark_weights_, pose_transform_mat))
           << "Failed to estimate pose transform matrix!";
     }
 
     // Multiply each of the metric landmarks by the inverse pose
     // transformation matrix to align the runtime metric face landmarks with
     // the canonical metric face landmarks.
-    metric_landmarks = (pose_transform_mat.inverse() *
-                        metric_landmarks.colwise().homogeneous())
-                           .topRows(3);
-
-    ConvertEigenMatrixToLandmarkList(metric_landmarks, metric_landmark_list);
+    const Eigen::Matrix4f inverse_pose_transform_mat =
+        pose_transform_mat.inverse();
+    metric_landmarks.noalias() =
+        inverse_pose_transform_mat.topLeftCorner<3, 3>().lazyProduct(
+            unaligned_metric_landmarks);
+    metric_landmarks.colwise() +=
+        inverse_pose_transform_mat.topRightCorner<3, 1>();
 
     return absl::OkStatus();
   }
 
  private:
   void ProjectXY(const PerspectiveCameraFrustum& pcf,
-                 Eigen::Matrix3Xf& landmarks) const {
+                 Eigen::Ref<Eigen::Matrix3Xf> landmarks) const {
     float x_scale = pcf.right - pcf.left;
     float y_scale = pcf.top - pcf.bottom;
     float x_translation = pcf.left;
@@ -229,7 +246,8 @@ class ScreenToMetricSpaceConverter {
     landmarks.colwise() += Eigen::Vector3f(x_translation, y_translation, 0.f);
   }
 
-  absl::StatusOr<float> EstimateScale(Eigen::Matrix3Xf& landmarks) const {
+  absl::StatusOr<float> EstimateScale(
+      const Eigen::Ref<const Eigen::Matrix3Xf>& landmarks) const {
     Eigen::Matrix4f transform_mat;
     MP_RETURN_IF_ERROR(procrustes_solver_->SolveWeightedOrthogonalProblem(
         canonical_metric_landmarks_, landmarks, landmark_weights_,
@@ -239,29 +257,42 @@ class ScreenToMetricSpaceConverter {
     return transform_mat.col(0).norm();
   }
 
+  // Overwrites the Z coordinates of `landmarks` with those of the canonical
+  // landmarks transformed by `transform_mat`.
+  void SetZFromCanonicalLandmarks(
+      const Eigen::Matrix4f& transform_mat,
+      Eigen::Ref<Eigen::Matrix3Xf> landmarks) const {
+    landmarks.row(2) =
+        (transform_mat.block<1, 3>(2, 0).lazyProduct(
+             canonical_metric_landmarks_))
+            .array() +
+        transform_mat(2, 3);
+  }
+
   static void MoveAndRescaleZ(const PerspectiveCameraFrustum& pcf,
                               float depth_offset, float scale,
-                              Eigen::Matrix3Xf& landmarks) {
+                              Eigen::Ref<Eigen::Matrix3Xf> landmarks) {
     landmarks.row(2) =
         (landmarks.array().row(2) - depth_offset + pcf.near) / scale;
   }
 
   static void UnprojectXY(const PerspectiveCameraFrustum& pcf,
-                          Eigen::Matrix3Xf& landmarks) {
+                          Eigen::Ref<Eigen::Matrix3Xf> landmarks) {
     landmarks.row(0) =
         landmarks.row(0).cwiseProduct(landmarks.row(2)) / pcf.near;
     landmarks.row(1) =
         landmarks.row(1).cwiseProduct(landmarks.row(2)) / pcf.near;
   }
 
-  static void ChangeHandedness(Eigen::Matrix3Xf& landmarks) {
+  static void ChangeHandedness(Eigen::Ref<Eigen::Matrix3Xf> landmarks) {
     landmarks.row(2) *= -1.f;
   }
 
+  template <typename Matrix3X>
   static void ConvertLandmarkListToEigenMatrix(
       const mediapipe::NormalizedLandmarkList& landmark_list,
-      Eigen::Matrix3Xf& eigen_matrix) {
-    eigen_matrix = Eigen::Matrix3Xf(3, landmark_list.landmark_size());
+      Matrix3X& eigen_matrix) {
+    eigen_matrix.resize(3, landmark_list.landmark_size());
     for (int i = 0; i < landmark_list.landmark_size(); ++i) {
       const auto& landmark = landmark_list.landmark(i);
       eigen_matrix(0, i) = landmark.x();
@@ -270,19 +301,6 @@ class ScreenToMetricSpaceConverter {
     }
   }
 
-  static void ConvertEigenMatrixToLandmarkList(
-      const Eigen::Matrix3Xf& eigen_matrix,
-      mediapipe::LandmarkList& landmark_list) {
-    landmark_list.Clear();
-
-    for (int i = 0; i < eigen_matrix.cols(); ++i) {
-      auto& landmark = *landmark_list.add_landmark();
-      landmark.set_x(eigen_matrix(0, i));
-      landmark.set_y(eigen_matrix(1, i));
-      landmark.set_z(eigen_matrix(2, i));
-    }
-  }
-
   const proto::OriginPointLocation origin_point_location_;
   const proto::InputSource input_source_;
   Eigen::Matrix3Xf canonical_metric_landmarks_;
@@ -320,7 +338,28 @@ class GeometryPipelineImpl : public GeometryPipeline {
     PerspectiveCameraFrustum pcf(perspective_camera_, frame_width,
                                  frame_height);
 
+    if (canonical_mesh_num_vertices_ <= kMaxStackLandmarks) {
+      return EstimateMultiFaceGeometry<StackMatrix3Xf>(multi_face_landmarks,
+                                                       pcf);
+    }
+    return EstimateMultiFaceGeometry<Eigen::Matrix3Xf>(multi_face_landmarks,
+                                                       pcf);
+  }
+
+ private:
+  // Estimates geometry for all faces of a frame. The landmark matrices are
+  // shared by all faces, and with `StackMatrix3Xf` they don't allocate at
+  // all.
+  template <typename Matrix3X>
+  absl::StatusOr<std::vector<proto::FaceGeometry>> EstimateMultiFaceGeometry(
+      const std::vector<mediapipe::NormalizedLandmarkList>&
+          multi_face_landmarks,
+      const PerspectiveCameraFrustum& pcf) const {
+    Matrix3X screen_landmarks;
+    Matrix3X metric_landmarks;
+
     std::vector<proto::FaceGeometry> multi_face_geometry;
+    multi_face_geometry.reserve(multi_face_landmarks.size());
 
     // From this point, the meaning of "face landmarks" is clarified further as
     // "screen face landmarks". This is done do distinguish from "metric face
@@ -335,41 +374,35 @@ class GeometryPipelineImpl : public GeometryPipeline {
 
       // Convert the screen landmarks into the metric landmarks and get the pose
       // transformation matrix.
-      mediapipe::LandmarkList metric_face_landmarks;
       Eigen::Matrix4f pose_transform_mat;
-      MP_RETURN_IF_ERROR(space_converter_->Convert(screen_face_landmarks, pcf,
-                                                   metric_face_landmarks,
-                                                   pose_transform_mat))
+      MP_RETURN_IF_ERROR(space_converter_->Convert(
+          screen_face_landmarks, pcf, screen_landmarks, metric_landmarks,
+          pose_transform_mat))
           << "Failed to convert landmarks from the screen to the metric space!";
 
       // Pack geometry data for this face.
-      proto::FaceGeometry face_geometry;
+      proto::FaceGeometry& face_geometry = multi_face_geometry.emplace_back();
       proto::Mesh3d* mutable_mesh = face_geometry.mutable_mesh();
       // Copy the canonical face mesh as the face geometry mesh.
       mutable_mesh->CopyFrom(canonical_mesh_);
-      // Replace XYZ vertex mesh coordinates with the metric landmark positions.
-      for (int i = 0; i < canonical_mesh_num_vertices_; ++i) {
-        uint32_t vertex_buffer_offset = canonical_mesh_vertex_size_ * i +
-                                        canonical_mesh_vertex_position_offset_;
-
-        mutable_mesh->set_vertex_buffer(vertex_buffer_offset,
-                                        metric_face_landmarks.landmark(i).x());
-        mutable_mesh->set_vertex_buffer(vertex_buffer_offset + 1,
-                                        metric_face_landmarks.landmark(i).y());
-        mutable_mesh->set_vertex_buffer(vertex_buffer_offset + 2,
-                                        metric_face_landmarks.landmark(i).z());
-      }
+      // Replace XYZ vertex mesh coordinates with the metric landmark positions,
+      // viewing the interleaved vertex buffer as a strided 3xN matrix.
+      float* vertex_positions_data =
+          mutable_mesh->mutable_vertex_buffer()->mutable_data() +
+          canonical_mesh_vertex_position_offset_;
+      Eigen::Map<Eigen::Matrix3Xf, Eigen::Unaligned, Eigen::OuterStride<>>
+          vertex_positions(vertex_positions_data, 3,
+                           canonical_mesh_num_vertices_,
+                           Eigen::OuterStride<>(canonical_mesh_vertex_size_));
+      vertex_positions = metric_landmarks;
       // Populate the face pose transformation matrix.
       mediapipe::MatrixDataProtoFromMatrix(
           pose_transform_mat, face_geometry.mutable_pose_transform_matrix());
-
-      multi_face_geometry.push_back(face_geometry);
     }
 
     return multi_face_geometry;
   }
 
- private:
   static bool IsScreenLandmarkListTooCompact(
       const mediapipe::NormalizedLandmarkList& screen_landmarks) {
     float mean_x = 0.f;
@@ -32,9 +32,9 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
   FloatPrecisionProcrustesSolver() = default;
 
   absl::Status SolveWeightedOrthogonalProblem(
-      const Eigen::Matrix3Xf& source_points,  //
-      const Eigen::Matrix3Xf& target_points,  //
-      const Eigen::VectorXf& point_weights,
+      const Eigen::Ref<const Eigen::Matrix3Xf>& source_points,  //
+      const Eigen::Ref<const Eigen::Matrix3Xf>& target_points,  //
+      const Eigen::Ref<const Eigen::VectorXf>& point_weights,
       Eigen::Matrix4f& transform_mat) const override {
     // Validate inputs.
     MP_RETURN_IF_ERROR(ValidateInputPoints(source_points, target_points))
@@ -43,12 +43,9 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
         ValidatePointWeights(source_points.cols(), point_weights))
         << "Failed to validate weighted orthogonal problem point weights!";
 
-    // Extract square root from the point weights.
-    Eigen::VectorXf sqrt_weights = ExtractSquareRoot(point_weights);
-
     // Try to solve the WEOP problem.
     MP_RETURN_IF_ERROR(InternalSolveWeightedOrthogonalProblem(
-        source_points, target_points, sqrt_weights, transform_mat))
+        source_points, target_points, point_weights, transform_mat))
         << "Failed to solve the WEOP problem!";
 
     return absl::OkStatus();
@@ -58,8 +55,8 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
   static constexpr float kAbsoluteErrorEps = 1e-9f;
 
   static absl::Status ValidateInputPoints(
-      const Eigen::Matrix3Xf& source_points,
-      const Eigen::Matrix3Xf& target_points) {
+      const Eigen::Ref<const Eigen::Matrix3Xf>& source_points,
+      const Eigen::Ref<const Eigen::Matrix3Xf>& target_points) {
     RET_CHECK_GT(source_points.cols(), 0)
         << "The number of source points must be positive!";
 
@@ -70,7 +67,7 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
   }
 
   static absl::Status ValidatePointWeights(
-      int num_points, const Eigen::VectorXf& point_weights) {
+      int num_points, const Eigen::Ref<const Eigen::VectorXf>& point_weights) {
     RET_CHECK_GT(point_weights.size(), 0)
         << "The number of point weights must be positive!";
 
@@ -91,16 +88,6 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
     return absl::OkStatus();
   }
 
-  static Eigen::VectorXf ExtractSquareRoot(
-      const Eigen::VectorXf& point_weights) {
-    Eigen::VectorXf sqrt_weights(point_weights);
-    for (int i = 0; i < sqrt_weights.size(); ++i) {
-      sqrt_weights(i) = std::sqrt(sqrt_weights(i));
-    }
-
-    return sqrt_weights;
-  }
-
   // Combines a 3x3 rotation-and-scale matrix and a 3x1 translation vector into
   // a single 4x4 transformation matrix.
   static Eigen::Matrix4f CombineTransformMatrix(const Eigen::Matrix3f& r_and_s,
@@ -135,21 +122,22 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
   //
   //     Most of the derivations are therefore transposed.
   //
+  //   * Every k x n product in the paper is only ever reduced to a k x k or
+  //     k x 1 quantity, so the weighted point clouds tranposed(A_w) and
+  //     tranposed(B_w) are never materialized. Instead, the reductions are
+  //     accumulated point by point with the weights w_i = sqrt_weights_i^2
+  //     applied directly, which keeps the solver free of heap allocations.
+  //
   // Note: the output `transform_mat` argument is used instead of `StatusOr<>`
   // return type in order to avoid Eigen memory alignment issues. Details:
   // https://eigen.tuxfamily.org/dox/group__TopicStructHavingEigenMembers.html
   static absl::Status InternalSolveWeightedOrthogonalProblem(
-      const Eigen::Matrix3Xf& sources, const Eigen::Matrix3Xf& targets,
-      const Eigen::VectorXf& sqrt_weights, Eigen::Matrix4f& transform_mat) {
-    // tranposed(A_w).
-    Eigen::Matrix3Xf weighted_sources =
-        sources.array().rowwise() * sqrt_weights.array().transpose();
-    // tranposed(B_w).
-    Eigen::Matrix3Xf weighted_targets =
-        targets.array().rowwise() * sqrt_weights.array().transpose();
-
+      const Eigen::Ref<const Eigen::Matrix3Xf>& sources,
+      const Eigen::Ref<const Eigen::Matrix3Xf>& targets,
+      const Eigen::Ref<const Eigen::VectorXf>& weights,
+      Eigen::Matrix4f& transform_mat) {
     // w = tranposed(j_w) j_w.
-    float total_weight = sqrt_weights.cwiseProduct(sqrt_weights).sum();
+    const float total_weight = weights.sum();
 
     // Let C = (j_w tranposed(j_w)) / (tranposed(j_w) j_w).
     // Note that C = tranposed(C), hence (I - C) = tranposed(I - C).
@@ -158,39 +146,44 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
     // (tranposed(A_w) j_w) tranposed(j_w) / w = c_w tranposed(j_w),
     //
     // where c_w = tranposed(A_w) j_w / w is a k x 1 vector calculated here:
-    Eigen::Matrix3Xf twice_weighted_sources =
-        weighted_sources.array().rowwise() * sqrt_weights.array().transpose();
-    Eigen::Vector3f source_center_of_mass =
-        twice_weighted_sources.rowwise().sum() / total_weight;
-    // tranposed((I - C) A_w) = tranposed(A_w) (I - C) =
-    // tranposed(A_w) - tranposed(A_w) C = tranposed(A_w) - c_w tranposed(j_w).
-    Eigen::Matrix3Xf centered_weighted_sources =
-        weighted_sources - source_center_of_mass * sqrt_weights.transpose();
+    const Eigen::Vector3f source_center_of_mass =
+        (sources * weights) / total_weight;
+    // tranposed(B_w) j_w / w, used for the translation below.
+    const Eigen::Vector3f target_center_of_mass =
+        (targets * weights) / total_weight;
+
+    // Column i of tranposed((I - C) A_w) = tranposed(A_w) - c_w tranposed(j_w)
+    // is sqrt_weights_i (a_i - c_w). Accumulate the design matrix
+    // tranposed(B_w) (I - C) A_w and the scale denominator
+    // trace(tranposed(A_w) (I - C) A_w) from those columns.
+    Eigen::Matrix3f design_matrix = Eigen::Matrix3f::Zero();
+    float scale_denominator = 0.f;
+    for (int i = 0; i < sources.cols(); ++i) {
+      const Eigen::Vector3f weighted_centered_source =
+          weights(i) * (sources.col(i) - source_center_of_mass);
+      design_matrix.noalias() +=
+          targets.col(i) * weighted_centered_source.transpose();
+      scale_denominator += weighted_centered_source.dot(sources.col(i));
+    }
 
     Eigen::Matrix3f rotation;
-    MP_RETURN_IF_ERROR(ComputeOptimalRotation(
-        weighted_targets * centered_weighted_sources.transpose(), rotation))
+    MP_RETURN_IF_ERROR(ComputeOptimalRotation(design_matrix, rotation))
         << "Failed to compute the optimal rotation!";
     MP_ASSIGN_OR_RETURN(
         float scale,
-        ComputeOptimalScale(centered_weighted_sources, weighted_sources,
-                            weighted_targets, rotation),
+        ComputeOptimalScale(design_matrix, scale_denominator, rotation),
         _ << "Failed to compute the optimal scale!");
 
     // R = c tranposed(T).
     Eigen::Matrix3f rotation_and_scale = scale * rotation;
 
     // Compute optimal translation for the weighted problem.
-
-    // tranposed(B_w - c A_w T) = tranposed(B_w) - R tranposed(A_w) in (54).
-    const auto pointwise_diffs =
-        weighted_targets - rotation_and_scale * weighted_sources;
-    // Multiplication by j_w is a respectively weighted column sum.
-    // (54) from the paper.
-    const auto weighted_pointwise_diffs =
-        pointwise_diffs.array().rowwise() * sqrt_weights.array().transpose();
+    //
+    // (54) from the paper: the weighted column sum of
+    // tranposed(B_w - c A_w T) = tranposed(B_w) - R tranposed(A_w), divided by
+    // w, which is the difference of the weighted centers of mass.
     Eigen::Vector3f translation =
-        weighted_pointwise_diffs.rowwise().sum() / total_weight;
+        target_center_of_mass - rotation_and_scale * source_center_of_mass;
 
     transform_mat = CombineTransformMatrix(rotation_and_scale, translation);
 
@@ -230,21 +223,16 @@ class FloatPrecisionProcrustesSolver : public ProcrustesSolver {
     return absl::OkStatus();
   }
 
+  // `design_matrix` and `denominator` are the reductions accumulated in
+  // InternalSolveWeightedOrthogonalProblem.
   static absl::StatusOr<float> ComputeOptimalScale(
-      const Eigen::Matrix3Xf& centered_weighted_sources,
-      const Eigen::Matrix3Xf& weighted_sources,
-      const Eigen::Matrix3Xf& weighted_targets,
+      const Eigen::Matrix3f& design_matrix, float denominator,
       const Eigen::Matrix3f& rotation) {
-    // tranposed(T) tranposed(A_w) (I - C).
-    const auto rotated_centered_weighted_sources =
-        rotation * centered_weighted_sources;
-    // Use the identity trace(A B) = sum(A * B^T)
-    // to avoid building large intermediate matrices (* is Hadamard product).
+    // trace(tranposed(T) tranposed(A_w) (I - C) B_w) equals the Frobenius
+    // inner product of the rotation and the design matrix, by the identity
+    // trace(A B) = sum(A * B^T) (* is Hadamard product).
     // (53) from the paper.
-    float numerator =
-        rotated_centered_weighted_sources.cwiseProduct(weighted_targets).sum();
-    float denominator =
-        centered_weighted_sources.cwiseProduct(weighted_sources).sum();
+    float numerator = rotation.cwiseProduct(design_matrix).sum();
 
     RET_CHECK_GT(denominator, kAbsoluteErrorEps)
         << "Scale expression denominator is too small!";
@@ -53,13 +53,17 @@ class ProcrustesSolver {
   // Small point coordinate deviation for either of the point cloud will likely
   // result in a failure as it will make the solution very unstable if possible.
   //
+  // The point clouds are taken by `Eigen::Ref` so that both heap-allocated
+  // and fixed-capacity matrices can be passed without a copy. The solver
+  // itself does not allocate.
+  //
   // Note: the output `transform_mat` argument is used instead of `StatusOr<>`
   // return type in order to avoid Eigen memory alignment issues. Details:
   // https://eigen.tuxfamily.org/dox/group__TopicStructHavingEigenMembers.html
   virtual absl::Status SolveWeightedOrthogonalProblem(
-      const Eigen::Matrix3Xf& source_points,  //
-      const Eigen::Matrix3Xf& target_points,  //
-      const Eigen::VectorXf& point_weights,   //
+      const Eigen::Ref<const Eigen::Matrix3Xf>& source_points,  //
+      const Eigen::Ref<const Eigen::Matrix3Xf>& target_points,  //
+      const Eigen::Ref<const Eigen::VectorXf>& point_weights,   //
       Eigen::Matrix4f& transform_mat) const = 0;
 };
 
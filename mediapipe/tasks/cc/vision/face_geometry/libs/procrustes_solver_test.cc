@@ -0,0 +1,168 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/tasks/cc/vision/face_geometry/libs/procrustes_solver.h"
+
+#include <memory>
+#include <random>
+
+#include "Eigen/Dense"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe::tasks::vision::face_geometry {
+namespace {
+
+// Point counts including a triangle, odd counts, the face mesh landmark
+// counts and one more than the fixed-capacity landmark buffer.
+constexpr int kNumPoints[] = {3, 7, 468, 478, 479};
+
+// The solve the solver used before it stopped materializing the weighted
+// point clouds, kept as the reference. Inputs are assumed valid.
+Eigen::Matrix4f ReferenceSolve(const Eigen::Matrix3Xf& sources,
+                               const Eigen::Matrix3Xf& targets,
+                               const Eigen::VectorXf& weights) {
+  const Eigen::VectorXf sqrt_weights = weights.cwiseSqrt();
+  const float total_weight = sqrt_weights.cwiseProduct(sqrt_weights).sum();
+
+  const Eigen::Matrix3Xf weighted_sources =
+      sources.array().rowwise() * sqrt_weights.array().transpose();
+  const Eigen::Matrix3Xf weighted_targets =
+      targets.array().rowwise() * sqrt_weights.array().transpose();
+
+  const Eigen::Vector3f source_center_of_mass =
+      weighted_sources * sqrt_weights / total_weight;
+  const Eigen::Matrix3Xf centered_weighted_sources =
+      weighted_sources - source_center_of_mass * sqrt_weights.transpose();
+  const Eigen::Matrix3f design_matrix =
+      weighted_targets * centered_weighted_sources.transpose();
+
+  Eigen::JacobiSVD<Eigen::Matrix3f> svd(
+      design_matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
+  Eigen::Matrix3f postrotation = svd.matrixU();
+  const Eigen::Matrix3f prerotation = svd.matrixV().transpose();
+  if (postrotation.determinant() * prerotation.determinant() < 0.f) {
+    postrotation.col(2) *= -1.f;
+  }
+  const Eigen::Matrix3f rotation = postrotation * prerotation;
+
+  const Eigen::Matrix3Xf rotated_centered_weighted_sources =
+      rotation * centered_weighted_sources;
+  const float numerator =
+      rotated_centered_weighted_sources.cwiseProduct(weighted_targets).sum();
+  const float denominator =
+      centered_weighted_sources.cwiseProduct(weighted_sources).sum();
+  const Eigen::Matrix3f rotation_and_scale =
+      (numerator / denominator) * rotation;
+
+  const Eigen::Matrix3Xf pointwise_diffs =
+      weighted_targets - rotation_and_scale * weighted_sources;
+  const Eigen::Vector3f translation =
+      pointwise_diffs * sqrt_weights / total_weight;
+
+  Eigen::Matrix4f transform_mat = Eigen::Matrix4f::Identity();
+  transform_mat.topLeftCorner<3, 3>() = rotation_and_scale;
+  transform_mat.topRightCorner<3, 1>() = translation;
+  return transform_mat;
+}
+
+struct Problem {
+  Eigen::Matrix3Xf sources;
+  Eigen::Matrix3Xf targets;
+  Eigen::VectorXf weights;
+};
+
+// Creates a noisy similarity transform of a random point cloud. About a
+// fifth of the weights are zero, as for landmarks outside the procrustes
+// landmark basis.
+Problem CreateProblem(int num_points, std::mt19937* rng) {
+  std::uniform_real_distribution<float> coordinate(-10.f, 10.f);
+  std::normal_distribution<float> noise(0.f, 0.05f);
+  std::uniform_real_distribution<float> weight(0.f, 1.f);
+
+  Problem problem;
+  problem.sources.resize(3, num_points);
+  problem.weights.resize(num_points);
+  for (int i = 0; i < num_points; ++i) {
+    problem.sources.col(i) << coordinate(*rng), coordinate(*rng),
+        coordinate(*rng);
+    const float w = weight(*rng);
+    problem.weights(i) = w < 0.2f ? 0.f : w;
+  }
+  // Keeps the three points of the smallest problem non-degenerate.
+  problem.weights.head(3).setOnes();
+
+  const Eigen::Matrix3f rotation =
+      Eigen::AngleAxisf(0.3f + coordinate(*rng) * 0.1f,
+                        Eigen::Vector3f(coordinate(*rng), coordinate(*rng),
+                                        coordinate(*rng))
+                            .normalized())
+          .toRotationMatrix();
+  const float scale = 0.5f + weight(*rng);
+  const Eigen::Vector3f translation(coordinate(*rng), coordinate(*rng),
+                                    coordinate(*rng));
+  problem.targets =
+      (scale * rotation * problem.sources).colwise() + translation;
+  for (int i = 0; i < num_points; ++i) {
+    problem.targets.col(i) +=
+        Eigen::Vector3f(noise(*rng), noise(*rng), noise(*rng));
+  }
+  return problem;
+}
+
+TEST(ProcrustesSolverTest, MatchesPreviousImplementation) {
+  std::unique_ptr<ProcrustesSolver> solver =
+      CreateFloatPrecisionProcrustesSolver();
+  std::mt19937 rng(0);
+  for (const int num_points : kNumPoints) {
+    for (int trial = 0; trial < 5; ++trial) {
+      const Problem problem = CreateProblem(num_points, &rng);
+      Eigen::Matrix4f transform_mat;
+      MP_ASSERT_OK(solver->SolveWeightedOrthogonalProblem(
+          problem.sources, problem.targets, problem.weights, transform_mat));
+
+      const Eigen::Matrix4f expected =
+          ReferenceSolve(problem.sources, problem.targets, problem.weights);
+      EXPECT_TRUE(transform_mat.isApprox(expected, 1e-4f))
+          << "points " << num_points << ", trial " << trial << "\nexpected\n"
+          << expected << "\nactual\n"
+          << transform_mat;
+    }
+  }
+}
+
+TEST(ProcrustesSolverTest, AcceptsFixedCapacityAndMappedInputs) {
+  std::unique_ptr<ProcrustesSolver> solver =
+      CreateFloatPrecisionProcrustesSolver();
+  std::mt19937 rng(1);
+  const Problem problem = CreateProblem(/*num_points=*/468, &rng);
+
+  Eigen::Matrix4f expected;
+  MP_ASSERT_OK(solver->SolveWeightedOrthogonalProblem(
+      problem.sources, problem.targets, problem.weights, expected));
+
+  // The geometry pipeline passes the landmarks as fixed-capacity targets.
+  const Eigen::Matrix<float, 3, Eigen::Dynamic, Eigen::ColMajor, 3, 478>
+      fixed_targets = problem.targets;
+  // Mapped buffers bind to the `Eigen::Ref` arguments without a copy too.
+  const Eigen::Map<const Eigen::Matrix3Xf> mapped_sources(
+      problem.sources.data(), 3, problem.sources.cols());
+  Eigen::Matrix4f actual;
+  MP_ASSERT_OK(solver->SolveWeightedOrthogonalProblem(
+      mapped_sources, fixed_targets, problem.weights, actual));
+  EXPECT_EQ(actual, expected);
+}
+
+}  // namespace
+}  // namespace mediapipe::tasks::vision::face_geometry
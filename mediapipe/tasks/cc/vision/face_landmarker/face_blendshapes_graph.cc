@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -27,6 +28,7 @@ limitations under the License.
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
+#include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
 #include "mediapipe/tasks/cc/vision/face_landmarker/proto/face_blendshapes_graph_options.pb.h"
 
 namespace mediapipe {
@@ -264,14 +266,11 @@ Stream<ClassificationList> ConvertTensorToBlendshapes(
 class FaceBlendshapesGraph : public core::ModelTaskGraph {
  public:
   absl::StatusOr<CalculatorGraphConfig> GetConfig(SubgraphContext* sc) {
-    MP_ASSIGN_OR_RETURN(const auto* model_resources,
-                        CreateModelResources<FaceBlendshapesGraphOptions>(sc));
     Graph graph;
     MP_ASSIGN_OR_RETURN(
         auto face_blendshapes_outs,
         BuildFaceBlendshapesSubgraph(
-            sc->Options<FaceBlendshapesGraphOptions>(), *model_resources,
-            graph[Input<NormalizedLandmarkList>(kLandmarksTag)],
+            sc, graph[Input<NormalizedLandmarkList>(kLandmarksTag)],
             graph[Input<std::pair<int, int>>(kImageSizeTag)], graph));
     face_blendshapes_outs.blendshapes >>
         graph[Output<ClassificationList>(kBlendshapesTag)];
@@ -283,17 +282,18 @@ class FaceBlendshapesGraph : public core::ModelTaskGraph {
   // Updates graph to predict face blendshapes from landmarks. Returns list of
   // blendsahpes.
   //
-  // subgraph_options: the mediapipe tasks module FaceBlendshapesGraphOptions.
-  // model_resources: the ModelSources object initialized from a face
-  // blendshapes model file with model metadata.
+  // The blendshapes model is only built when the first face landmarks
+  // arrive, see AddLazyInference, as it does not run until a face is found.
+  //
+  // sc: the subgraph context with the mediapipe tasks module
+  // FaceBlendshapesGraphOptions.
   // landmarks: 478 normalized face landmarks
   // img_size: Image size to denormalize landmarks.
   // graph: the mediapipe builder::Graph instance to be updated.
   absl::StatusOr<FaceBlendshapesOuts> BuildFaceBlendshapesSubgraph(
-      const FaceBlendshapesGraphOptions& subgraph_options,
-      const core::ModelResources& model_resources,
-      Stream<NormalizedLandmarkList> landmarks,
+      SubgraphContext* sc, Stream<NormalizedLandmarkList> landmarks,
       Stream<std::pair<int, int>> img_size, Graph& graph) {
+    const auto& subgraph_options = sc->Options<FaceBlendshapesGraphOptions>();
     // Take required subset of landmarks.
     landmarks = GetLandmarksSubset(landmarks, kLandmarksSubsetIdxs, graph);
 
@@ -301,10 +301,15 @@ class FaceBlendshapesGraph : public core::ModelTaskGraph {
     auto tensor_in = ConvertLandmarksToTensor(landmarks, img_size, graph);
 
     // Run Blendshapes model.
-    auto& inference = AddInference(
-        model_resources, subgraph_options.base_options().acceleration(), graph);
-    tensor_in >> inference.In("TENSORS");
-    auto tensors_out = inference.Out("TENSORS").Cast<std::vector<Tensor>>();
+    MP_ASSIGN_OR_RETURN(
+        auto* inference,
+        AddLazyInference(sc,
+                         std::make_unique<core::proto::ExternalFile>(
+                             subgraph_options.base_options().model_asset()),
+                         subgraph_options.base_options().acceleration(),
+                         graph));
+    tensor_in >> inference->In("TENSORS");
+    auto tensors_out = inference->Out("TENSORS").Cast<std::vector<Tensor>>();
 
     // Take output tensor with blendshapes and wrap it in vector.
     auto blendshapes_tensor = GetTensorWithBlendshapes(tensors_out, graph);
@@ -27,6 +27,7 @@ limitations under the License.
 #include "mediapipe/calculators/core/get_vector_item_calculator.pb.h"
 #include "mediapipe/calculators/util/association_calculator.pb.h"
 #include "mediapipe/calculators/util/collection_has_min_size_calculator.pb.h"
+#include "mediapipe/calculators/util/detection_scheduler_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/formats/classification.pb.h"
@@ -122,12 +123,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
   auto* face_detector_graph_options =
       options->mutable_face_detector_graph_options();
   if (!face_detector_graph_options->base_options().has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto face_detector_file,
-                        resources.GetFile(kFaceDetectorTFLiteName));
-    SetExternalFile(face_detector_file,
-                    face_detector_graph_options->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceDetectorTFLiteName,
+        face_detector_graph_options->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
   }
   face_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -141,13 +141,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       options->mutable_face_landmarks_detector_graph_options();
   if (!face_landmarks_detector_graph_options->base_options()
            .has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto face_landmarks_detector_file,
-                        resources.GetFile(kFaceLandmarksDetectorTFLiteName));
-    SetExternalFile(
-        face_landmarks_detector_file,
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceLandmarksDetectorTFLiteName,
         face_landmarks_detector_graph_options->mutable_base_options()
             ->mutable_model_asset(),
-        is_copy);
+        is_copy));
   }
   face_landmarks_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -160,12 +158,13 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
   absl::StatusOr<absl::string_view> face_blendshape_model =
       resources.GetFile(kFaceBlendshapeTFLiteName);
   if (face_blendshape_model.ok()) {
-    SetExternalFile(*face_blendshape_model,
-                    face_landmarks_detector_graph_options
-                        ->mutable_face_blendshapes_graph_options()
-                        ->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceBlendshapeTFLiteName,
+        face_landmarks_detector_graph_options
+            ->mutable_face_blendshapes_graph_options()
+            ->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
     face_landmarks_detector_graph_options
         ->mutable_face_blendshapes_graph_options()
         ->mutable_base_options()
@@ -177,6 +176,31 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
 
   return absl::OkStatus();
 }
+
+// Returns a stream of bools telling whether the face detector can be skipped
+// on the current frame, given the face rects tracked from the previous frame.
+Source<bool> SkipFaceDetection(
+    const FaceLandmarkerGraphOptions& tasks_options, Source<Image> image_in,
+    Source<std::vector<NormalizedRect>> prev_face_rects, Graph& graph) {
+  const int max_num_faces =
+      tasks_options.face_detector_graph_options().num_faces();
+  if (tasks_options.has_detection_scheduler_options()) {
+    auto& scheduler = graph.AddNode("DetectionSchedulerCalculator");
+    auto& scheduler_options =
+        scheduler.GetOptions<DetectionSchedulerCalculatorOptions>();
+    scheduler_options.CopyFrom(tasks_options.detection_scheduler_options());
+    scheduler_options.set_max_num_objects(max_num_faces);
+    image_in >> scheduler.In("TICK");
+    prev_face_rects >> scheduler.In("TRACKED_RECTS");
+    return scheduler.Out("SKIP_DETECTION").Cast<bool>();
+  }
+  auto& min_size_node =
+      graph.AddNode("NormalizedRectVectorHasMinSizeCalculator");
+  prev_face_rects >> min_size_node.In(kIterableTag);
+  min_size_node.GetOptions<CollectionHasMinSizeCalculatorOptions>()
+      .set_min_size(max_num_faces);
+  return min_size_node.Out("").Cast<bool>();
+}
 }  // namespace
 
 // A "mediapipe.tasks.vision.face_landmarker.FaceLandmarkerGraph" performs face
@@ -465,22 +489,19 @@ class FaceLandmarkerGraph : public core::ModelTaskGraph {
       auto prev_face_rects_from_landmarks =
           previous_loopback[Output<std::vector<NormalizedRect>>(kPrevLoopTag)];
 
-      auto& min_size_node =
-          graph.AddNode("NormalizedRectVectorHasMinSizeCalculator");
-      prev_face_rects_from_landmarks >> min_size_node.In(kIterableTag);
-      min_size_node.GetOptions<CollectionHasMinSizeCalculatorOptions>()
-          .set_min_size(max_num_faces);
-      auto has_enough_faces = min_size_node.Out("").Cast<bool>();
+      auto skip_face_detection = SkipFaceDetection(
+          tasks_options, image_in, prev_face_rects_from_landmarks, graph);
 
       // While in stream mode, skip face detector graph when we successfully
-      // track the faces from the last frame.
+      // track the faces from the last frame, as decided by the detection
+      // scheduler if one is configured.
       auto image_for_face_detector =
-          DisallowIf(image_in, has_enough_faces, graph);
+          DisallowIf(image_in, skip_face_detection, graph);
       image_for_face_detector >> face_detector.In(kImageTag);
       std::optional<Source<NormalizedRect>> norm_rect_in_for_face_detector;
       if (norm_rect_in) {
         norm_rect_in_for_face_detector =
-            DisallowIf(norm_rect_in.value(), has_enough_faces, graph);
+            DisallowIf(norm_rect_in.value(), skip_face_detection, graph);
       }
       if (norm_rect_in_for_face_detector) {
         *norm_rect_in_for_face_detector >> face_detector.In("NORM_RECT");
@@ -87,6 +87,15 @@ ConvertFaceStylizerOptionsToProto(FaceStylizerOptions* options) {
   auto base_options_proto = std::make_unique<tasks::core::proto::BaseOptions>(
       tasks::core::ConvertBaseOptionsToProto(&(options->base_options)));
   options_proto->mutable_base_options()->Swap(base_options_proto.get());
+  if (options->preview_options.has_value()) {
+    auto* preview_options = options_proto->mutable_preview_options();
+    if (options->preview_options->output_width > 0 &&
+        options->preview_options->output_height > 0) {
+      preview_options->set_output_width(options->preview_options->output_width);
+      preview_options->set_output_height(
+          options->preview_options->output_height);
+    }
+  }
   return options_proto;
 }
 
@@ -41,6 +41,20 @@ struct FaceStylizerOptions {
   // file with metadata, accelerator options, op resolver, etc.
   tasks::core::BaseOptions base_options;
 
+  // Options for the interactive preview mode.
+  struct PreviewOptions {
+    // The size the stylized image is upsampled to on GPU, preserving its
+    // aspect ratio. If zero, the model output size is kept.
+    int output_width = 0;
+    int output_height = 0;
+  };
+
+  // If set, the stylized image stays on GPU, avoiding the GPU to CPU readback
+  // on every call, and is resized there to the preview size. This requires the
+  // GPU delegate. Use a second FaceStylizer without preview options for the
+  // full quality capture pass, which returns a CPU image.
+  std::optional<PreviewOptions> preview_options;
+
   // The user-defined result callback for processing live stream data.
   // The result callback should only be specified when the running mode is set
   // to RunningMode::LIVE_STREAM.
@@ -75,7 +89,8 @@ class FaceStylizer : tasks::vision::core::BaseVisionTaskApi {
   // The input image can be of any size with format RGB or RGBA.
   // When no face is detected on the input image, the method returns a
   // std::nullopt. Otherwise, returns the stylized image of the most visible
-  // face. The stylized output image size is the same as the model output size.
+  // face. The stylized output image size is the same as the model output size,
+  // or the preview size if preview options are set.
   absl::StatusOr<std::optional<mediapipe::Image>> Stylize(
       mediapipe::Image image,
       std::optional<core::ImageProcessingOptions> image_processing_options =
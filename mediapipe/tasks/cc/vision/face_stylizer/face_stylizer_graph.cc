@@ -20,6 +20,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "mediapipe/calculators/core/split_vector_calculator.pb.h"
 #include "mediapipe/calculators/image/image_clone_calculator.pb.h"
+#include "mediapipe/calculators/image/image_transformation_calculator.pb.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_calculator.pb.h"
 #include "mediapipe/calculators/util/landmarks_to_detection_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
@@ -30,12 +31,12 @@ limitations under the License.
 #include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/gpu/gpu_origin.pb.h"
+#include "mediapipe/gpu/scale_mode.pb.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/components/processors/image_preprocessing_graph.h"
 #include "mediapipe/tasks/cc/core/model_resources_cache.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/face_detector/proto/face_detector_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/face_landmarker/proto/face_landmarker_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/face_landmarker/proto/face_landmarks_detector_graph_options.pb.h"
@@ -58,7 +59,6 @@ using ::mediapipe::tasks::TensorsToImageCalculatorOptions;
 using ::mediapipe::tasks::core::ModelAssetBundleResources;
 using ::mediapipe::tasks::core::ModelResources;
 using ::mediapipe::tasks::core::proto::ExternalFile;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 using ::mediapipe::tasks::vision::face_landmarker::proto::
     FaceLandmarkerGraphOptions;
 using ::mediapipe::tasks::vision::face_stylizer::proto::
@@ -70,6 +70,7 @@ constexpr char kFaceDetectorTFLiteName[] = "face_detector.tflite";
 constexpr char kFaceLandmarksDetectorTFLiteName[] =
     "face_landmarks_detector.tflite";
 constexpr char kFaceStylizerTFLiteName[] = "face_stylizer.tflite";
+constexpr char kImageGpuTag[] = "IMAGE_GPU";
 constexpr char kImageTag[] = "IMAGE";
 constexpr char kImageSizeTag[] = "IMAGE_SIZE";
 constexpr char kMatrixTag[] = "MATRIX";
@@ -98,12 +99,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       options->mutable_face_landmarker_graph_options()
           ->mutable_face_detector_graph_options();
   if (!face_detector_graph_options->base_options().has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto face_detector_file,
-                        resources.GetFile(kFaceDetectorTFLiteName));
-    SetExternalFile(face_detector_file,
-                    face_detector_graph_options->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceDetectorTFLiteName,
+        face_detector_graph_options->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
   }
   face_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -113,13 +113,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
           ->mutable_face_landmarks_detector_graph_options();
   if (!face_landmarks_detector_graph_options->base_options()
            .has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto face_landmarks_detector_file,
-                        resources.GetFile(kFaceLandmarksDetectorTFLiteName));
-    SetExternalFile(
-        face_landmarks_detector_file,
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceLandmarksDetectorTFLiteName,
         face_landmarks_detector_graph_options->mutable_base_options()
             ->mutable_model_asset(),
-        is_copy);
+        is_copy));
   }
   face_landmarks_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -128,9 +126,8 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       ->set_use_stream_mode(options->base_options().use_stream_mode());
 
   if (face_stylizer_external_file) {
-    MP_ASSIGN_OR_RETURN(const auto face_stylizer_file,
-                        resources.GetFile(kFaceStylizerTFLiteName));
-    SetExternalFile(face_stylizer_file, face_stylizer_external_file, is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kFaceStylizerTFLiteName, face_stylizer_external_file, is_copy));
   }
   return absl::OkStatus();
 }
@@ -193,7 +190,8 @@ void ConfigureTensorsToImageCalculator(
 //
 // Outputs:
 //   STYLIZED_IMAGE - mediapipe::Image
-//     The face stylization output image.
+//     The face stylization output image. It is stored on CPU, unless
+//     `preview_options` is set in which case it stays on GPU.
 //   FACE_ALIGNMENT - mediapipe::Image
 //     The aligned face image that is fed to the face stylization model to
 //     perform stylization. Also useful for preparing face stylization training
@@ -426,11 +424,22 @@ class FaceStylizerGraph : public core::ModelTaskGraph {
     model_output_tensors >> tensors_to_image.In(kTensorsTag);
     auto tensor_image = tensors_to_image.Out(kImageTag);
 
-    auto& image_converter = graph.AddNode("ImageCloneCalculator");
-    image_converter.GetOptions<mediapipe::ImageCloneCalculatorOptions>()
-        .set_output_on_gpu(false);
-    tensor_image >> image_converter.In("");
-    stylized = image_converter.Out("").Cast<Image>();
+    if (task_options.has_preview_options()) {
+      if (!use_gpu) {
+        return CreateStatusWithPayload(
+            absl::StatusCode::kInvalidArgument,
+            "Face stylizer preview mode requires the GPU delegate.",
+            MediaPipeTasksStatus::kInvalidArgumentError);
+      }
+      stylized = BuildPreviewImage(task_options.preview_options(),
+                                   tensor_image.Cast<Image>(), graph);
+    } else {
+      auto& image_converter = graph.AddNode("ImageCloneCalculator");
+      image_converter.GetOptions<mediapipe::ImageCloneCalculatorOptions>()
+          .set_output_on_gpu(false);
+      tensor_image >> image_converter.In("");
+      stylized = image_converter.Out("").Cast<Image>();
+    }
 
     if (output_alignment) {
       auto& tensors_to_image =
@@ -448,6 +457,40 @@ class FaceStylizerGraph : public core::ModelTaskGraph {
              preprocessing.Out(kMatrixTag).Cast<std::array<float, 16>>(),
              /*original_image=*/preprocessing.Out(kImageTag).Cast<Image>()}};
   }
+
+  // Keeps the stylized image on GPU and, if a preview size is set, resizes it
+  // there with bilinear filtering. This avoids the GPU to CPU readback and any
+  // CPU resampling on the live preview path.
+  Source<Image> BuildPreviewImage(
+      const FaceStylizerGraphOptions::PreviewOptions& preview_options,
+      Source<Image> stylized_image, Graph& graph) {
+    auto& image_on_gpu = graph.AddNode("ImageCloneCalculator");
+    image_on_gpu.GetOptions<mediapipe::ImageCloneCalculatorOptions>()
+        .set_output_on_gpu(true);
+    stylized_image >> image_on_gpu.In("");
+    if (!preview_options.has_output_width() ||
+        !preview_options.has_output_height()) {
+      return image_on_gpu.Out("").Cast<Image>();
+    }
+
+    auto& from_image = graph.AddNode("FromImageCalculator");
+    image_on_gpu.Out("") >> from_image.In(kImageTag);
+
+    auto& image_transformation = graph.AddNode("ImageTransformationCalculator");
+    auto& image_transformation_options =
+        image_transformation
+            .GetOptions<mediapipe::ImageTransformationCalculatorOptions>();
+    image_transformation_options.set_output_width(
+        preview_options.output_width());
+    image_transformation_options.set_output_height(
+        preview_options.output_height());
+    image_transformation_options.set_scale_mode(mediapipe::ScaleMode::FIT);
+    from_image.Out(kImageGpuTag) >> image_transformation.In(kImageGpuTag);
+
+    auto& to_image = graph.AddNode("ToImageCalculator");
+    image_transformation.Out(kImageGpuTag) >> to_image.In(kImageGpuTag);
+    return to_image.Out(kImageTag).Cast<Image>();
+  }
 };
 
 // clang-format off
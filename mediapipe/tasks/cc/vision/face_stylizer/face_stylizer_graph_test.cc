@@ -0,0 +1,191 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <string>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "mediapipe/calculators/image/image_clone_calculator.pb.h"
+#include "mediapipe/calculators/image/image_transformation_calculator.pb.h"
+#include "mediapipe/framework/api2/builder.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator.pb.h"
+#include "mediapipe/framework/deps/file_path.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/status_matchers.h"
+#include "mediapipe/framework/tool/name_util.h"
+#include "mediapipe/framework/tool/subgraph_expansion.h"
+#include "mediapipe/gpu/scale_mode.pb.h"
+#include "mediapipe/tasks/cc/vision/face_stylizer/proto/face_stylizer_graph_options.pb.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace vision {
+namespace face_stylizer {
+namespace {
+
+using ::mediapipe::api2::Input;
+using ::mediapipe::api2::Output;
+using ::mediapipe::api2::builder::Graph;
+using ::mediapipe::file::JoinPath;
+using ::mediapipe::tasks::vision::face_stylizer::proto::
+    FaceStylizerGraphOptions;
+using ::testing::HasSubstr;
+using ::testing::NotNull;
+
+constexpr char kTestDataDirectory[] = "/mediapipe/tasks/testdata/vision/";
+constexpr char kFaceStylizerBundle[] = "face_stylizer_color_ink.task";
+
+constexpr char kImageTag[] = "IMAGE";
+constexpr char kImageName[] = "image_in";
+constexpr char kImageGpuTag[] = "IMAGE_GPU";
+constexpr char kStylizedImageTag[] = "STYLIZED_IMAGE";
+constexpr char kStylizedImageName[] = "stylized_image";
+
+FaceStylizerGraphOptions CreateOptions(bool use_gpu) {
+  FaceStylizerGraphOptions options;
+  options.mutable_base_options()->mutable_model_asset()->set_file_name(
+      JoinPath("./", kTestDataDirectory, kFaceStylizerBundle));
+  if (use_gpu) {
+    options.mutable_base_options()->mutable_acceleration()->mutable_gpu();
+  }
+  return options;
+}
+
+// Returns the config of a FaceStylizerGraph with the given options, with all
+// its subgraphs expanded.
+absl::StatusOr<CalculatorGraphConfig> ExpandConfig(
+    const FaceStylizerGraphOptions& options) {
+  Graph graph;
+  auto& face_stylizer =
+      graph.AddNode("mediapipe.tasks.vision.face_stylizer.FaceStylizerGraph");
+  face_stylizer.GetOptions<FaceStylizerGraphOptions>() = options;
+  graph[Input<Image>(kImageTag)].SetName(kImageName) >>
+      face_stylizer.In(kImageTag);
+  face_stylizer.Out(kStylizedImageTag).SetName(kStylizedImageName) >>
+      graph[Output<Image>(kStylizedImageTag)];
+  CalculatorGraphConfig config = graph.GetConfig();
+  MP_RETURN_IF_ERROR(tool::ExpandSubgraphs(&config));
+  return config;
+}
+
+// Returns the node that outputs `stream_name`, or nullptr if there is none.
+const CalculatorGraphConfig::Node* FindNodeWithOutput(
+    const CalculatorGraphConfig& config, const std::string& stream_name) {
+  for (const auto& node : config.node()) {
+    for (const auto& output_stream : node.output_stream()) {
+      if (tool::ParseNameFromStream(output_stream) == stream_name) {
+        return &node;
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Returns the node that outputs the input stream of `node` with `tag`, or
+// nullptr if there is none.
+const CalculatorGraphConfig::Node* FindInputNode(
+    const CalculatorGraphConfig& config,
+    const CalculatorGraphConfig::Node& node, const std::string& tag) {
+  for (const auto& input_stream : node.input_stream()) {
+    if (tool::ParseTagIndexFromStream(input_stream).first == tag) {
+      return FindNodeWithOutput(config,
+                                tool::ParseNameFromStream(input_stream));
+    }
+  }
+  return nullptr;
+}
+
+TEST(FaceStylizerGraphTest, PreviewImageIsResizedOnGpu) {
+  FaceStylizerGraphOptions options = CreateOptions(/*use_gpu=*/true);
+  options.mutable_preview_options()->set_output_width(512);
+  options.mutable_preview_options()->set_output_height(384);
+  MP_ASSERT_OK_AND_ASSIGN(CalculatorGraphConfig config, ExpandConfig(options));
+
+  const auto* to_image = FindNodeWithOutput(config, kStylizedImageName);
+  ASSERT_THAT(to_image, NotNull());
+  EXPECT_EQ(to_image->calculator(), "ToImageCalculator");
+
+  const auto* image_transformation =
+      FindInputNode(config, *to_image, kImageGpuTag);
+  ASSERT_THAT(image_transformation, NotNull());
+  EXPECT_EQ(image_transformation->calculator(),
+            "ImageTransformationCalculator");
+  const auto& image_transformation_options =
+      image_transformation->options().GetExtension(
+          ImageTransformationCalculatorOptions::ext);
+  EXPECT_EQ(image_transformation_options.output_width(), 512);
+  EXPECT_EQ(image_transformation_options.output_height(), 384);
+  EXPECT_EQ(image_transformation_options.scale_mode(), ScaleMode::FIT);
+
+  const auto* from_image =
+      FindInputNode(config, *image_transformation, kImageGpuTag);
+  ASSERT_THAT(from_image, NotNull());
+  EXPECT_EQ(from_image->calculator(), "FromImageCalculator");
+
+  const auto* image_clone = FindInputNode(config, *from_image, kImageTag);
+  ASSERT_THAT(image_clone, NotNull());
+  EXPECT_EQ(image_clone->calculator(), "ImageCloneCalculator");
+  EXPECT_TRUE(
+      image_clone->options().GetExtension(ImageCloneCalculatorOptions::ext)
+          .output_on_gpu());
+}
+
+TEST(FaceStylizerGraphTest, PreviewImageWithoutSizeKeepsModelOutputSize) {
+  FaceStylizerGraphOptions options = CreateOptions(/*use_gpu=*/true);
+  options.mutable_preview_options();
+  MP_ASSERT_OK_AND_ASSIGN(CalculatorGraphConfig config, ExpandConfig(options));
+
+  const auto* image_clone = FindNodeWithOutput(config, kStylizedImageName);
+  ASSERT_THAT(image_clone, NotNull());
+  EXPECT_EQ(image_clone->calculator(), "ImageCloneCalculator");
+  EXPECT_TRUE(
+      image_clone->options().GetExtension(ImageCloneCalculatorOptions::ext)
+          .output_on_gpu());
+  const auto* tensors_to_image = FindInputNode(config, *image_clone, "");
+  ASSERT_THAT(tensors_to_image, NotNull());
+  EXPECT_EQ(tensors_to_image->calculator(),
+            "mediapipe.tasks.TensorsToImageCalculator");
+}
+
+TEST(FaceStylizerGraphTest, CaptureImageIsOnCpu) {
+  MP_ASSERT_OK_AND_ASSIGN(CalculatorGraphConfig config,
+                          ExpandConfig(CreateOptions(/*use_gpu=*/true)));
+
+  const auto* image_clone = FindNodeWithOutput(config, kStylizedImageName);
+  ASSERT_THAT(image_clone, NotNull());
+  EXPECT_EQ(image_clone->calculator(), "ImageCloneCalculator");
+  EXPECT_FALSE(
+      image_clone->options().GetExtension(ImageCloneCalculatorOptions::ext)
+          .output_on_gpu());
+}
+
+TEST(FaceStylizerGraphTest, PreviewRequiresGpuDelegate) {
+  FaceStylizerGraphOptions options = CreateOptions(/*use_gpu=*/false);
+  options.mutable_preview_options()->set_output_width(512);
+  options.mutable_preview_options()->set_output_height(384);
+
+  EXPECT_THAT(ExpandConfig(options).status(),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("preview mode requires the GPU delegate")));
+}
+
+}  // namespace
+}  // namespace face_stylizer
+}  // namespace vision
+}  // namespace tasks
+}  // namespace mediapipe
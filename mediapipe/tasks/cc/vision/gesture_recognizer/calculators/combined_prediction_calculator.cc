@@ -28,6 +28,7 @@ limitations under the License.
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/collection.h"
 #include "mediapipe/framework/formats/classification.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/calculators/combined_prediction_calculator.pb.h"
 
 namespace mediapipe {
@@ -110,10 +111,21 @@ std::unique_ptr<ClassificationList> GetWinningPrediction(
 // non-background winning class, the output contains the winning prediction from
 // the ClassificationList with the highest priority. Priority is in decreasing
 // order of input streams to the graph node using this calculator.
+//
+// In batched mode each input stream carries the ClassificationList of every
+// hand (or other object) of one classifier, and the combination above is
+// applied to each batch item independently.
+//
 // Input:
 //   At least one stream with ClassificationList.
+//   BATCHED_CLASSIFICATIONS - Used in place of the untagged streams in batched
+//     mode. At least one stream with std::vector<ClassificationList>, all of
+//     the same size.
 // Output:
 //  PREDICTION - A ClassificationList with the winning label as the only item.
+//  BATCHED_PREDICTIONS - Used in place of PREDICTION in batched mode. A
+//     std::vector<ClassificationList> with the winning prediction of each
+//     batch item, or an empty ClassificationList for items without one.
 //
 // Usage example:
 // node {
@@ -137,8 +149,23 @@ class CombinedPredictionCalculator : public Node {
  public:
   static constexpr Input<ClassificationList>::Multiple kClassificationListIn{
       ""};
-  static constexpr Output<ClassificationList> kPredictionOut{"PREDICTION"};
-  MEDIAPIPE_NODE_CONTRACT(kClassificationListIn, kPredictionOut);
+  static constexpr Input<std::vector<ClassificationList>>::Multiple
+      kBatchedClassificationListsIn{"BATCHED_CLASSIFICATIONS"};
+  static constexpr Output<ClassificationList>::Optional kPredictionOut{
+      "PREDICTION"};
+  static constexpr Output<std::vector<ClassificationList>>::Optional
+      kBatchedPredictionsOut{"BATCHED_PREDICTIONS"};
+  MEDIAPIPE_NODE_CONTRACT(kClassificationListIn, kBatchedClassificationListsIn,
+                          kPredictionOut, kBatchedPredictionsOut);
+
+  static absl::Status UpdateContract(CalculatorContract* cc) {
+    const bool batched = kBatchedClassificationListsIn(cc).Count() > 0;
+    RET_CHECK(batched ^ (kClassificationListIn(cc).Count() > 0))
+        << "Use either untagged or BATCHED_CLASSIFICATIONS input streams.";
+    RET_CHECK(batched ? kBatchedPredictionsOut(cc).IsConnected()
+                      : kPredictionOut(cc).IsConnected());
+    return absl::OkStatus();
+  }
 
   absl::Status Open(CalculatorContext* cc) override {
     options_ = cc->Options<CombinedPredictionCalculatorOptions>();
@@ -150,32 +177,78 @@ class CombinedPredictionCalculator : public Node {
   }
 
   absl::Status Process(CalculatorContext* cc) override {
-    // After loop, if have winning prediction return. Otherwise empty packet.
+    if (kBatchedClassificationListsIn(cc).Count() > 0) {
+      return ProcessBatched(cc);
+    }
+    std::vector<const ClassificationList*> classification_lists;
+    for (const auto& input : kClassificationListIn(cc)) {
+      if (!input.IsEmpty()) {
+        classification_lists.push_back(&input.Get());
+      }
+    }
+    auto prediction = CombinePredictions(classification_lists);
+    if (prediction != nullptr) {
+      kPredictionOut(cc).Send(std::move(prediction));
+    }
+    return absl::OkStatus();
+  }
+
+ private:
+  absl::Status ProcessBatched(CalculatorContext* cc) {
+    std::vector<const std::vector<ClassificationList>*> batched_inputs;
+    for (const auto& input : kBatchedClassificationListsIn(cc)) {
+      if (input.IsEmpty()) {
+        continue;
+      }
+      if (!batched_inputs.empty()) {
+        RET_CHECK_EQ(input.Get().size(), batched_inputs[0]->size())
+            << "All batched inputs must have the same batch size.";
+      }
+      batched_inputs.push_back(&input.Get());
+    }
+    if (batched_inputs.empty()) {
+      return absl::OkStatus();
+    }
+    const int batch_size = batched_inputs[0]->size();
+    auto predictions = std::make_unique<std::vector<ClassificationList>>();
+    predictions->reserve(batch_size);
+    std::vector<const ClassificationList*> classification_lists(
+        batched_inputs.size());
+    for (int i = 0; i < batch_size; ++i) {
+      for (int j = 0; j < batched_inputs.size(); ++j) {
+        classification_lists[j] = &(*batched_inputs[j])[i];
+      }
+      auto prediction = CombinePredictions(classification_lists);
+      predictions->push_back(prediction != nullptr ? std::move(*prediction)
+                                                   : ClassificationList());
+    }
+    kBatchedPredictionsOut(cc).Send(std::move(predictions));
+    return absl::OkStatus();
+  }
+
+  // Returns the winning prediction of the classifiers in decreasing priority
+  // order, or nullptr if none of them has classifications.
+  std::unique_ptr<ClassificationList> CombinePredictions(
+      const std::vector<const ClassificationList*>& classification_lists) {
     std::unique_ptr<ClassificationList> first_winning_prediction = nullptr;
-    auto collection = kClassificationListIn(cc);
-    for (const auto& input : collection) {
-      if (input.IsEmpty() || input.Get().classification_size() == 0) {
+    for (const ClassificationList* input : classification_lists) {
+      if (input->classification_size() == 0) {
         continue;
       }
       auto prediction = GetWinningPrediction(
-          input.Get(), classwise_thresholds_, options_.background_label(),
+          *input, classwise_thresholds_, options_.background_label(),
           options_.default_global_threshold());
       if (prediction->classification(0).label() !=
           options_.background_label()) {
-        kPredictionOut(cc).Send(std::move(prediction));
-        return absl::OkStatus();
+        return prediction;
       }
       if (first_winning_prediction == nullptr) {
         first_winning_prediction = std::move(prediction);
       }
     }
-    if (first_winning_prediction != nullptr) {
-      kPredictionOut(cc).Send(std::move(first_winning_prediction));
-    }
-    return absl::OkStatus();
+    return first_winning_prediction;
   }
 
- private:
   CombinedPredictionCalculatorOptions options_;
   absl::btree_map<std::string, float> classwise_thresholds_;
 };
@@ -315,6 +315,60 @@ INSTANTIATE_TEST_CASE_P(
       return info.param.test_name;
     });
 
+TEST(CombinedPredictionCalculatorPacketTest,
+     Batched_CombinesPredictionsOfEachItem) {
+  constexpr char kCalculatorProto[] = R"pb(
+    calculator: "CombinedPredictionCalculator"
+    input_stream: "BATCHED_CLASSIFICATIONS:0:custom_softmax_scores"
+    input_stream: "BATCHED_CLASSIFICATIONS:1:canned_softmax_scores"
+    output_stream: "BATCHED_PREDICTIONS:predictions"
+    options {
+      [mediapipe.CombinedPredictionCalculatorOptions.ext] {
+        class { label: "CustomDrama" score_threshold: 0.5 }
+        class { label: "CannedJoy" score_threshold: 0.5 }
+        background_label: "Negative"
+      }
+    }
+  )pb";
+  CalculatorRunner runner(kCalculatorProto);
+  auto custom_scores = std::make_unique<std::vector<ClassificationList>>();
+  custom_scores->push_back(*BuildCustomScoreInput(
+      /*negative_score=*/0.1, /*drama_score=*/0.8, /*llama_score=*/0.1));
+  custom_scores->push_back(*BuildCustomScoreInput(
+      /*negative_score=*/0.8, /*drama_score=*/0.1, /*llama_score=*/0.1));
+  custom_scores->push_back(*BuildCustomScoreInput(
+      /*negative_score=*/0.8, /*drama_score=*/0.1, /*llama_score=*/0.1));
+  auto canned_scores = std::make_unique<std::vector<ClassificationList>>();
+  canned_scores->push_back(*BuildCannedScoreInput(
+      /*negative_score=*/0.1, /*bazinga_score=*/0.1, /*joy_score=*/0.7,
+      /*peace_score=*/0.1));
+  canned_scores->push_back(*BuildCannedScoreInput(
+      /*negative_score=*/0.1, /*bazinga_score=*/0.1, /*joy_score=*/0.7,
+      /*peace_score=*/0.1));
+  canned_scores->push_back(*BuildCannedScoreInput(
+      /*negative_score=*/0.7, /*bazinga_score=*/0.1, /*joy_score=*/0.1,
+      /*peace_score=*/0.1));
+  runner.MutableInputs()
+      ->Get("BATCHED_CLASSIFICATIONS", 0)
+      .packets.push_back(Adopt(custom_scores.release()).At(Timestamp(1)));
+  runner.MutableInputs()
+      ->Get("BATCHED_CLASSIFICATIONS", 1)
+      .packets.push_back(Adopt(canned_scores.release()).At(Timestamp(1)));
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+
+  auto output_packets = runner.Outputs().Tag("BATCHED_PREDICTIONS").packets;
+  ASSERT_EQ(output_packets.size(), 1);
+  const auto& predictions =
+      output_packets[0].Get<std::vector<ClassificationList>>();
+  ASSERT_EQ(predictions.size(), 3);
+  // The custom classifier has priority over the canned classifier.
+  EXPECT_EQ(predictions[0].classification(0).label(), "CustomDrama");
+  EXPECT_EQ(predictions[1].classification(0).label(), "CannedJoy");
+  // Neither classifier has a winner, so the custom background is used.
+  EXPECT_EQ(predictions[2].classification(0).label(), "Negative");
+  EXPECT_NEAR(predictions[2].classification(0).score(), 0.8, 1e-4);
+}
+
 }  // namespace
 
 }  // namespace mediapipe
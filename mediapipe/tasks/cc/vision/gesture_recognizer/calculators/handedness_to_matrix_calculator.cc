@@ -25,6 +25,7 @@ limitations under the License.
 #include "mediapipe/framework/calculator_framework.h"
 #include "mediapipe/framework/formats/classification.pb.h"
 #include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/handedness_util.h"
 
@@ -38,6 +39,8 @@ using ::mediapipe::tasks::vision::gesture_recognizer::GetRightHandScore;
 
 constexpr char kHandednessTag[] = "HANDEDNESS";
 constexpr char kHandednessMatrixTag[] = "HANDEDNESS_MATRIX";
+constexpr char kHandednessVectorTag[] = "HANDEDNESS_VECTOR";
+constexpr char kTensorsTag[] = "TENSORS";
 
 absl::StatusOr<std::unique_ptr<Matrix>> HandednessToMatrix(
     const mediapipe::ClassificationList& classification_list) {
@@ -50,14 +53,34 @@ absl::StatusOr<std::unique_ptr<Matrix>> HandednessToMatrix(
   return result;
 }
 
+// Returns a float tensor of shape [num_hands, 1] with the right hand score of
+// each hand.
+absl::StatusOr<Tensor> HandednessVectorToTensor(
+    const std::vector<mediapipe::ClassificationList>& handedness_vector) {
+  const int num_hands = handedness_vector.size();
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape({num_hands, 1}, /*is_dynamic=*/true));
+  auto view = tensor.GetCpuWriteView();
+  float* buffer = view.buffer<float>();
+  for (int i = 0; i < num_hands; ++i) {
+    MP_ASSIGN_OR_RETURN(buffer[i], GetRightHandScore(handedness_vector[i]));
+  }
+  return tensor;
+}
+
 }  // namespace
 
 // Convert single hand handedness into a matrix.
 //
 // Input:
 //   HANDEDNESS - Single hand handedness.
+//   HANDEDNESS_VECTOR - Handedness of several hands. Used in place of
+//     HANDEDNESS to convert all hands in one batch.
 // Output:
-//   HANDEDNESS_MATRIX - Matrix for handedness.
+//   HANDEDNESS_MATRIX - Matrix for handedness. Only with HANDEDNESS.
+//   TENSORS - A vector with one float tensor of shape [num_hands, 1] holding
+//     the handedness of all hands, for batched inference. Only with
+//     HANDEDNESS_VECTOR. Nothing is output if the input vector is empty.
 //
 // Usage example:
 // node {
@@ -68,8 +91,16 @@ absl::StatusOr<std::unique_ptr<Matrix>> HandednessToMatrix(
 class HandednessToMatrixCalculator : public CalculatorBase {
  public:
   static absl::Status GetContract(CalculatorContract* cc) {
-    cc->Inputs().Tag(kHandednessTag).Set<mediapipe::ClassificationList>();
-    cc->Outputs().Tag(kHandednessMatrixTag).Set<Matrix>();
+    cc->Inputs()
+        .Tag(kHandednessTag)
+        .Set<mediapipe::ClassificationList>()
+        .Optional();
+    cc->Inputs()
+        .Tag(kHandednessVectorTag)
+        .Set<std::vector<mediapipe::ClassificationList>>()
+        .Optional();
+    cc->Outputs().Tag(kHandednessMatrixTag).Set<Matrix>().Optional();
+    cc->Outputs().Tag(kTensorsTag).Set<std::vector<Tensor>>().Optional();
     return absl::OkStatus();
   }
 
@@ -77,6 +108,11 @@ class HandednessToMatrixCalculator : public CalculatorBase {
   // to 0 is the default in API2
   absl::Status Open(CalculatorContext* cc) override {
     cc->SetOffset(TimestampDiff(0));
+    RET_CHECK(cc->Inputs().HasTag(kHandednessTag) ^
+              cc->Inputs().HasTag(kHandednessVectorTag));
+    RET_CHECK(cc->Inputs().HasTag(kHandednessTag)
+                  ? cc->Outputs().HasTag(kHandednessMatrixTag)
+                  : cc->Outputs().HasTag(kTensorsTag));
     return absl::OkStatus();
   }
 
@@ -86,6 +122,24 @@ class HandednessToMatrixCalculator : public CalculatorBase {
 REGISTER_CALCULATOR(HandednessToMatrixCalculator);
 
 absl::Status HandednessToMatrixCalculator::Process(CalculatorContext* cc) {
+  if (cc->Inputs().HasTag(kHandednessVectorTag)) {
+    if (cc->Inputs().Tag(kHandednessVectorTag).IsEmpty()) {
+      return absl::OkStatus();
+    }
+    const auto& handedness_vector =
+        cc->Inputs()
+            .Tag(kHandednessVectorTag)
+            .Get<std::vector<mediapipe::ClassificationList>>();
+    if (handedness_vector.empty()) {
+      return absl::OkStatus();
+    }
+    MP_ASSIGN_OR_RETURN(Tensor tensor,
+                        HandednessVectorToTensor(handedness_vector));
+    auto tensors = std::make_unique<std::vector<Tensor>>();
+    tensors->push_back(std::move(tensor));
+    cc->Outputs().Tag(kTensorsTag).Add(tensors.release(), cc->InputTimestamp());
+    return absl::OkStatus();
+  }
   if (cc->Inputs().Tag(kHandednessTag).IsEmpty()) {
     return absl::OkStatus();
   }
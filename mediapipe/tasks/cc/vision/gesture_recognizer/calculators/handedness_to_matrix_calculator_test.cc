@@ -23,6 +23,7 @@ limitations under the License.
 #include "mediapipe/framework/calculator_runner.h"
 #include "mediapipe/framework/formats/classification.pb.h"
 #include "mediapipe/framework/formats/matrix.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
@@ -33,6 +34,8 @@ namespace {
 
 constexpr char kHandednessTag[] = "HANDEDNESS";
 constexpr char kHandednessMatrixTag[] = "HANDEDNESS_MATRIX";
+constexpr char kHandednessVectorTag[] = "HANDEDNESS_VECTOR";
+constexpr char kTensorsTag[] = "TENSORS";
 
 mediapipe::ClassificationList ClassificationForHandedness(float handedness) {
   mediapipe::ClassificationList result;
@@ -91,6 +94,34 @@ INSTANTIATE_TEST_CASE_P(
       return info.param.test_name;
     });
 
+TEST(HandednessToMatrixCalculatorTest, BatchesHandednessVectorIntoTensor) {
+  auto node_config = ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      R"pb(
+        calculator: "HandednessToMatrixCalculator"
+        input_stream: "HANDEDNESS_VECTOR:handedness"
+        output_stream: "TENSORS:tensors"
+      )pb");
+  CalculatorRunner runner(node_config);
+
+  auto input_handedness =
+      std::make_unique<std::vector<mediapipe::ClassificationList>>();
+  input_handedness->push_back(ClassificationForHandedness(0.01f));
+  input_handedness->push_back(ClassificationForHandedness(0.99f));
+  runner.MutableInputs()
+      ->Tag(kHandednessVectorTag)
+      .packets.push_back(Adopt(input_handedness.release()).At(Timestamp(0)));
+
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+
+  const auto& tensors =
+      runner.Outputs().Tag(kTensorsTag).packets[0].Get<std::vector<Tensor>>();
+  ASSERT_EQ(tensors.size(), 1);
+  EXPECT_EQ(tensors[0].shape().dims, std::vector<int>({2, 1}));
+  auto view = tensors[0].GetCpuReadView();
+  EXPECT_NEAR(view.buffer<float>()[0], 0.01f, .001f);
+  EXPECT_NEAR(view.buffer<float>()[1], 0.99f, .001f);
+}
+
 }  // namespace
 
 }  // namespace mediapipe
@@ -20,6 +20,7 @@ limitations under the License.
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -28,6 +29,7 @@ limitations under the License.
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/calculators/landmarks_to_matrix_calculator.pb.h"
 
@@ -44,6 +46,9 @@ constexpr char kWorldLandmarksTag[] = "WORLD_LANDMARKS";
 constexpr char kImageSizeTag[] = "IMAGE_SIZE";
 constexpr char kNormRectTag[] = "NORM_RECT";
 constexpr char kLandmarksMatrixTag[] = "LANDMARKS_MATRIX";
+constexpr char kLandmarksVectorTag[] = "LANDMARKS_VECTOR";
+constexpr char kWorldLandmarksVectorTag[] = "WORLD_LANDMARKS_VECTOR";
+constexpr char kTensorsTag[] = "TENSORS";
 constexpr int kFeaturesPerLandmark = 3;
 
 template <class LandmarkListT>
@@ -148,7 +153,8 @@ bool IsNormalized() {
 }
 
 template <class LandmarkListT>
-absl::Status ProcessLandmarks(LandmarkListT landmarks, CalculatorContext* cc) {
+absl::StatusOr<Matrix> PreprocessLandmarks(LandmarkListT landmarks,
+                                           CalculatorContext* cc) {
   if (IsNormalized<LandmarkListT>()) {
     RET_CHECK(cc->Inputs().HasTag(kImageSizeTag) &&
               !cc->Inputs().Tag(kImageSizeTag).IsEmpty());
@@ -173,11 +179,49 @@ absl::Status ProcessLandmarks(LandmarkListT landmarks, CalculatorContext* cc) {
                         options.object_normalization_origin_offset()));
   }
 
-  auto landmarks_matrix = std::make_unique<Matrix>();
-  *landmarks_matrix = LandmarksToMatrix(landmarks);
+  return LandmarksToMatrix(landmarks);
+}
+
+template <class LandmarkListT>
+absl::Status ProcessLandmarks(LandmarkListT landmarks, CalculatorContext* cc) {
+  MP_ASSIGN_OR_RETURN(Matrix matrix, PreprocessLandmarks(landmarks, cc));
   cc->Outputs()
       .Tag(kLandmarksMatrixTag)
-      .Add(landmarks_matrix.release(), cc->InputTimestamp());
+      .Add(new Matrix(std::move(matrix)), cc->InputTimestamp());
+  return absl::OkStatus();
+}
+
+// Stacks the preprocessed landmarks of all objects into one float tensor of
+// shape [num_objects, num_landmarks, 3].
+template <class LandmarkListT>
+absl::Status ProcessLandmarksVector(
+    const std::vector<LandmarkListT>& landmarks_vector,
+    CalculatorContext* cc) {
+  if (landmarks_vector.empty()) {
+    return absl::OkStatus();
+  }
+  const int num_landmarks = landmarks_vector[0].landmark_size();
+  const int num_objects = landmarks_vector.size();
+  Tensor tensor(Tensor::ElementType::kFloat32,
+                Tensor::Shape({num_objects, num_landmarks,
+                               kFeaturesPerLandmark},
+                              /*is_dynamic=*/true));
+  {
+    auto view = tensor.GetCpuWriteView();
+    float* buffer = view.buffer<float>();
+    for (const auto& landmarks : landmarks_vector) {
+      RET_CHECK_EQ(landmarks.landmark_size(), num_landmarks)
+          << "All objects must have the same number of landmarks.";
+      MP_ASSIGN_OR_RETURN(Matrix matrix, PreprocessLandmarks(landmarks, cc));
+      // The column-major matrix stores the landmarks as consecutive
+      // (x, y, z) triples.
+      std::copy_n(matrix.data(), matrix.size(), buffer);
+      buffer += matrix.size();
+    }
+  }
+  auto tensors = std::make_unique<std::vector<Tensor>>();
+  tensors->push_back(std::move(tensor));
+  cc->Outputs().Tag(kTensorsTag).Add(tensors.release(), cc->InputTimestamp());
   return absl::OkStatus();
 }
 
@@ -196,8 +240,18 @@ absl::Status ProcessLandmarks(LandmarkListT landmarks, CalculatorContext* cc) {
 //   IMAGE_SIZE - (width, height) of the image
 //   NORM_RECT - Optional NormalizedRect object whose 'rotation' field is used
 //               to rotate the landmarks.
+//   LANDMARKS_VECTOR - Landmarks of several objects. Used in place of
+//               LANDMARKS to convert all objects in one batch.
+//   WORLD_LANDMARKS_VECTOR - World 3d landmarks of several objects. Used in
+//               place of WORLD_LANDMARKS to convert all objects in one batch.
 // Output:
-//   LANDMARKS_MATRIX - Matrix for the landmarks.
+//   LANDMARKS_MATRIX - Matrix for the landmarks. Only with LANDMARKS or
+//               WORLD_LANDMARKS.
+//   TENSORS - A vector with one float tensor of shape
+//               [num_objects, num_landmarks, 3] holding the preprocessed
+//               landmarks of all objects, for batched inference. Only with
+//               LANDMARKS_VECTOR or WORLD_LANDMARKS_VECTOR. Nothing is output
+//               if the input vector is empty.
 //
 // Usage example:
 // node {
@@ -219,14 +273,31 @@ class LandmarksToMatrixCalculator : public CalculatorBase {
     cc->Inputs().Tag(kWorldLandmarksTag).Set<LandmarkList>().Optional();
     cc->Inputs().Tag(kImageSizeTag).Set<std::pair<int, int>>().Optional();
     cc->Inputs().Tag(kNormRectTag).Set<NormalizedRect>().Optional();
-    cc->Outputs().Tag(kLandmarksMatrixTag).Set<Matrix>();
+    cc->Inputs()
+        .Tag(kLandmarksVectorTag)
+        .Set<std::vector<NormalizedLandmarkList>>()
+        .Optional();
+    cc->Inputs()
+        .Tag(kWorldLandmarksVectorTag)
+        .Set<std::vector<LandmarkList>>()
+        .Optional();
+    cc->Outputs().Tag(kLandmarksMatrixTag).Set<Matrix>().Optional();
+    cc->Outputs().Tag(kTensorsTag).Set<std::vector<Tensor>>().Optional();
     return absl::OkStatus();
   }
 
   absl::Status Open(CalculatorContext* cc) override {
     cc->SetOffset(TimestampDiff(0));
-    RET_CHECK(cc->Inputs().HasTag(kLandmarksTag) ^
-              cc->Inputs().HasTag(kWorldLandmarksTag));
+    const int num_landmark_inputs =
+        cc->Inputs().HasTag(kLandmarksTag) +
+        cc->Inputs().HasTag(kWorldLandmarksTag) +
+        cc->Inputs().HasTag(kLandmarksVectorTag) +
+        cc->Inputs().HasTag(kWorldLandmarksVectorTag);
+    RET_CHECK_EQ(num_landmark_inputs, 1);
+    const bool batched = cc->Inputs().HasTag(kLandmarksVectorTag) ||
+                         cc->Inputs().HasTag(kWorldLandmarksVectorTag);
+    RET_CHECK(batched ? cc->Outputs().HasTag(kTensorsTag)
+                      : cc->Outputs().HasTag(kLandmarksMatrixTag));
     const auto& options = cc->Options<LandmarksToMatrixCalculatorOptions>();
     RET_CHECK(options.has_object_normalization());
     return absl::OkStatus();
@@ -249,6 +320,22 @@ absl::Status LandmarksToMatrixCalculator::Process(CalculatorContext* cc) {
       auto landmarks = cc->Inputs().Tag(kWorldLandmarksTag).Get<LandmarkList>();
       return ProcessLandmarks(landmarks, cc);
     }
+  } else if (cc->Inputs().HasTag(kLandmarksVectorTag)) {
+    if (!cc->Inputs().Tag(kLandmarksVectorTag).IsEmpty()) {
+      return ProcessLandmarksVector(
+          cc->Inputs()
+              .Tag(kLandmarksVectorTag)
+              .Get<std::vector<NormalizedLandmarkList>>(),
+          cc);
+    }
+  } else if (cc->Inputs().HasTag(kWorldLandmarksVectorTag)) {
+    if (!cc->Inputs().Tag(kWorldLandmarksVectorTag).IsEmpty()) {
+      return ProcessLandmarksVector(
+          cc->Inputs()
+              .Tag(kWorldLandmarksVectorTag)
+              .Get<std::vector<LandmarkList>>(),
+          cc);
+    }
   }
   return absl::OkStatus();
 }
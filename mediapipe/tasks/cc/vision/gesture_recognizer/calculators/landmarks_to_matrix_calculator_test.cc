@@ -25,6 +25,7 @@ limitations under the License.
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/parse_text_proto.h"
 #include "mediapipe/framework/port/status_matchers.h"
@@ -40,6 +41,8 @@ constexpr char kWorldLandmarksTag[] = "WORLD_LANDMARKS";
 constexpr char kImageSizeTag[] = "IMAGE_SIZE";
 constexpr char kLandmarksMatrixTag[] = "LANDMARKS_MATRIX";
 constexpr char kNormRectTag[] = "NORM_RECT";
+constexpr char kWorldLandmarksVectorTag[] = "WORLD_LANDMARKS_VECTOR";
+constexpr char kTensorsTag[] = "TENSORS";
 
 template <class LandmarkListT>
 LandmarkListT BuildPseudoLandmarks(int num_landmarks, int offset = 0) {
@@ -232,6 +235,50 @@ INSTANTIATE_TEST_CASE_P(
       return info.param.test_name;
     });
 
+TEST(LandmarksToMatrixCalculatorTest, BatchesLandmarksVectorIntoTensor) {
+  auto node_config = ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      R"pb(
+        calculator: "LandmarksToMatrixCalculator"
+        input_stream: "WORLD_LANDMARKS_VECTOR:landmarks"
+        input_stream: "IMAGE_SIZE:image_size"
+        output_stream: "TENSORS:tensors"
+        options {
+          [mediapipe.LandmarksToMatrixCalculatorOptions.ext] {
+            object_normalization: true
+            object_normalization_origin_offset: 0
+          }
+        }
+      )pb");
+  CalculatorRunner runner(node_config);
+
+  auto landmarks = std::make_unique<std::vector<LandmarkList>>();
+  landmarks->push_back(BuildPseudoLandmarks<LandmarkList>(21, 0));
+  landmarks->push_back(BuildPseudoLandmarks<LandmarkList>(21, 21));
+  runner.MutableInputs()
+      ->Tag(kWorldLandmarksVectorTag)
+      .packets.push_back(Adopt(landmarks.release()).At(Timestamp(0)));
+  auto image_size = std::make_unique<std::pair<int, int>>(640, 480);
+  runner.MutableInputs()
+      ->Tag(kImageSizeTag)
+      .packets.push_back(Adopt(image_size.release()).At(Timestamp(0)));
+
+  MP_ASSERT_OK(runner.Run()) << "Calculator execution failed.";
+
+  const auto& tensors =
+      runner.Outputs().Tag(kTensorsTag).packets[0].Get<std::vector<Tensor>>();
+  ASSERT_EQ(tensors.size(), 1);
+  EXPECT_EQ(tensors[0].shape().dims, std::vector<int>({2, 21, 3}));
+  EXPECT_TRUE(tensors[0].shape().is_dynamic);
+  auto view = tensors[0].GetCpuReadView();
+  const float* buffer = view.buffer<float>();
+  for (int hand = 0; hand < 2; ++hand) {
+    const float* landmarks_of_hand = buffer + hand * 21 * 3;
+    // x of landmark 2 and y of landmark 5, as in the matrix tests above.
+    EXPECT_NEAR(landmarks_of_hand[2 * 3 + 0], 0.1f, 1e-4f);
+    EXPECT_NEAR(landmarks_of_hand[5 * 3 + 1], 0.25f, 1e-4f);
+  }
+}
+
 }  // namespace
 
 }  // namespace mediapipe
@@ -33,7 +33,6 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/model_resources_cache.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/utils.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/proto/gesture_recognizer_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/proto/hand_gesture_recognizer_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/hand_detector/proto/hand_detector_graph_options.pb.h"
@@ -54,7 +53,6 @@ using ::mediapipe::api2::Output;
 using ::mediapipe::api2::builder::Graph;
 using ::mediapipe::api2::builder::Source;
 using ::mediapipe::tasks::core::ModelAssetBundleResources;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 using ::mediapipe::tasks::vision::gesture_recognizer::proto::
     GestureRecognizerGraphOptions;
 using ::mediapipe::tasks::vision::gesture_recognizer::proto::
@@ -92,28 +90,26 @@ struct GestureRecognizerOutputs {
 absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
                                    GestureRecognizerGraphOptions* options,
                                    bool is_copy) {
-  MP_ASSIGN_OR_RETURN(const auto hand_landmarker_file,
-                      resources.GetFile(kHandLandmarkerBundleAssetName));
   auto* hand_landmarker_graph_options =
       options->mutable_hand_landmarker_graph_options();
-  SetExternalFile(hand_landmarker_file,
-                  hand_landmarker_graph_options->mutable_base_options()
-                      ->mutable_model_asset(),
-                  is_copy);
+  MP_RETURN_IF_ERROR(resources.SetExternalFile(
+      kHandLandmarkerBundleAssetName,
+      hand_landmarker_graph_options->mutable_base_options()
+          ->mutable_model_asset(),
+      is_copy));
   hand_landmarker_graph_options->mutable_base_options()
       ->mutable_acceleration()
       ->CopyFrom(options->base_options().acceleration());
   hand_landmarker_graph_options->mutable_base_options()->set_use_stream_mode(
       options->base_options().use_stream_mode());
 
-  MP_ASSIGN_OR_RETURN(const auto hand_gesture_recognizer_file,
-                      resources.GetFile(kHandGestureRecognizerBundleAssetName));
   auto* hand_gesture_recognizer_graph_options =
       options->mutable_hand_gesture_recognizer_graph_options();
-  SetExternalFile(hand_gesture_recognizer_file,
-                  hand_gesture_recognizer_graph_options->mutable_base_options()
-                      ->mutable_model_asset(),
-                  is_copy);
+  MP_RETURN_IF_ERROR(resources.SetExternalFile(
+      kHandGestureRecognizerBundleAssetName,
+      hand_gesture_recognizer_graph_options->mutable_base_options()
+          ->mutable_model_asset(),
+      is_copy));
   hand_gesture_recognizer_graph_options->mutable_base_options()
       ->mutable_acceleration()
       ->CopyFrom(options->base_options().acceleration());
@@ -38,7 +38,6 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
 #include "mediapipe/tasks/cc/core/proto/inference_subgraph.pb.h"
 #include "mediapipe/tasks/cc/core/utils.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/calculators/combined_prediction_calculator.pb.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/calculators/landmarks_to_matrix_calculator.pb.h"
 #include "mediapipe/tasks/cc/vision/gesture_recognizer/proto/gesture_classifier_graph_options.pb.h"
@@ -56,13 +55,13 @@ namespace {
 using ::mediapipe::NormalizedRect;
 using ::mediapipe::api2::Input;
 using ::mediapipe::api2::Output;
+using ::mediapipe::api2::builder::GenericNode;
 using ::mediapipe::api2::builder::Graph;
 using ::mediapipe::api2::builder::Source;
 using ::mediapipe::tasks::components::processors::
     ConfigureTensorsToClassificationCalculator;
 using ::mediapipe::tasks::core::ModelAssetBundleResources;
 using ::mediapipe::tasks::core::proto::BaseOptions;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 using ::mediapipe::tasks::vision::gesture_recognizer::proto::
     HandGestureRecognizerGraphOptions;
 
@@ -83,6 +82,12 @@ constexpr char kIndexTag[] = "INDEX";
 constexpr char kIterableTag[] = "ITERABLE";
 constexpr char kBatchEndTag[] = "BATCH_END";
 constexpr char kPredictionTag[] = "PREDICTION";
+constexpr char kBatchedPredictionsTag[] = "BATCHED_PREDICTIONS";
+constexpr char kClassificationsTag[] = "CLASSIFICATIONS";
+constexpr char kBatchedClassificationsTag[] = "BATCHED_CLASSIFICATIONS";
+constexpr char kLandmarksVectorTag[] = "LANDMARKS_VECTOR";
+constexpr char kWorldLandmarksVectorTag[] = "WORLD_LANDMARKS_VECTOR";
+constexpr char kHandednessVectorTag[] = "HANDEDNESS_VECTOR";
 constexpr char kBackgroundLabel[] = "None";
 constexpr char kGestureEmbedderTFLiteName[] = "gesture_embedder.tflite";
 constexpr char kCannedGestureClassifierTFLiteName[] =
@@ -122,54 +127,14 @@ void PopulateAccelerationAndUseStreamMode(
 
 }  // namespace
 
-// A
-// "mediapipe.tasks.vision.gesture_recognizer.SingleHandGestureRecognizerGraph"
-// performs single hand gesture recognition. This graph is used as a building
-// block for mediapipe.tasks.vision.GestureRecognizerGraph.
-//
-// Inputs:
-//   HANDEDNESS - ClassificationList
-//     Classification of handedness.
-//   LANDMARKS - NormalizedLandmarkList
-//     Detected hand landmarks in normalized image coordinates.
-//   WORLD_LANDMARKS - LandmarkList
-//     Detected hand landmarks in world coordinates.
-//   IMAGE_SIZE - std::pair<int, int>
-//     The size of image from which the landmarks detected from.
-//   NORM_RECT - NormalizedRect
-//     NormalizedRect whose 'rotation' field is used to rotate the
-//     landmarks before processing them.
-//
-// Outputs:
-//   HAND_GESTURES - ClassificationList
-//     Recognized hand gestures with sorted order such that the winning label is
-//     the first item in the list.
-//
-//
-// Example:
-// node {
-//   calculator: "mediapipe.tasks.vision.SingleHandGestureRecognizerGraph"
-//   input_stream: "HANDEDNESS:handedness"
-//   input_stream: "LANDMARKS:landmarks"
-//   input_stream: "WORLD_LANDMARKS:world_landmarks"
-//   input_stream: "IMAGE_SIZE:image_size"
-//   input_stream: "NORM_RECT:norm_rect"
-//   output_stream: "HAND_GESTURES:hand_gestures"
-//   options {
-//     [mediapipe.tasks.vision.gesture_recognizer.proto.HandGestureRecognizerGraphOptions.ext]
-//     {
-//       base_options {
-//         model_asset {
-//           file_name: "hand_gesture.tflite"
-//         }
-//       }
-//     }
-//   }
-// }
-class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
- public:
-  absl::StatusOr<CalculatorGraphConfig> GetConfig(
-      SubgraphContext* sc) override {
+// Base class of the hand gesture recognizer graphs, which loads the gesture
+// embedder and classifier models and adds their inference to the graph.
+class HandGestureRecognizerGraphBase : public core::ModelTaskGraph {
+ protected:
+  // Fills in the base options of the sub tasks from the model asset bundle, if
+  // any, and creates their model resources.
+  absl::StatusOr<SubTaskModelResources> LoadSubTaskModelResources(
+      SubgraphContext* sc) {
     if (sc->Options<HandGestureRecognizerGraphOptions>()
             .base_options()
             .has_model_asset()) {
@@ -186,20 +151,62 @@ class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
           !sc->Service(::mediapipe::tasks::core::kModelResourcesCacheService)
                .IsAvailable()));
     }
-    MP_ASSIGN_OR_RETURN(const auto sub_task_model_resources,
-                        CreateSubTaskModelResources(sc));
-    Graph graph;
-    MP_ASSIGN_OR_RETURN(auto hand_gestures,
-                        BuildGestureRecognizerGraph(
-                            sc->Options<HandGestureRecognizerGraphOptions>(),
-                            sub_task_model_resources,
-                            graph[Input<ClassificationList>(kHandednessTag)],
-                            graph[Input<NormalizedLandmarkList>(kLandmarksTag)],
-                            graph[Input<LandmarkList>(kWorldLandmarksTag)],
-                            graph[Input<std::pair<int, int>>(kImageSizeTag)],
-                            graph[Input<NormalizedRect>(kNormRectTag)], graph));
-    hand_gestures >> graph[Output<ClassificationList>(kHandGesturesTag)];
-    return graph.GetConfig();
+    return CreateSubTaskModelResources(sc);
+  }
+
+  // Runs the gesture embedder on the concatenated hand feature tensors and
+  // each gesture classifier on the embedding, and combines the classifier
+  // results in a CombinedPredictionCalculator, which is returned. In batched
+  // mode the tensors hold the features of all hands along their batch
+  // dimension and the calculator outputs BATCHED_PREDICTIONS, otherwise it
+  // outputs the PREDICTION of a single hand.
+  absl::StatusOr<GenericNode*> AddGestureClassification(
+      const HandGestureRecognizerGraphOptions& graph_options,
+      const SubTaskModelResources& sub_task_model_resources,
+      Source<std::vector<Tensor>> feature_tensors, bool batched,
+      Graph& graph) {
+    // Inference for gesture embedder.
+    auto& gesture_embedder_inference =
+        AddInference(*sub_task_model_resources.gesture_embedder_model_resource,
+                     graph_options.gesture_embedder_graph_options()
+                         .base_options()
+                         .acceleration(),
+                     graph);
+    feature_tensors >> gesture_embedder_inference.In(kTensorsTag);
+    auto embedding_tensors =
+        gesture_embedder_inference[Output<std::vector<Tensor>>(kTensorsTag)];
+
+    auto& combine_predictions = graph.AddNode("CombinedPredictionCalculator");
+    MP_RETURN_IF_ERROR(ConfigureCombinedPredictionCalculator(
+        &combine_predictions
+             .GetOptions<CombinedPredictionCalculatorOptions>()));
+    const char* classifications_tag =
+        batched ? kBatchedClassificationsTag : kClassificationsTag;
+    const char* combine_input_tag = batched ? kBatchedClassificationsTag : "";
+
+    int classifier_nums = 0;
+    // Inference for custom gesture classifier if it exists.
+    if (has_custom_gesture_classifier) {
+      MP_ASSIGN_OR_RETURN(
+          auto* tensors_to_classification,
+          AddGestureClassifier(
+              sub_task_model_resources.custom_gesture_classifier_model_resource,
+              graph_options.custom_gesture_classifier_graph_options(),
+              embedding_tensors, graph));
+      tensors_to_classification->Out(classifications_tag) >>
+          combine_predictions.In(combine_input_tag)[classifier_nums++];
+    }
+
+    // Inference for canned gesture classifier.
+    MP_ASSIGN_OR_RETURN(
+        auto* tensors_to_classification,
+        AddGestureClassifier(
+            sub_task_model_resources.canned_gesture_classifier_model_resource,
+            graph_options.canned_gesture_classifier_graph_options(),
+            embedding_tensors, graph));
+    tensors_to_classification->Out(classifications_tag) >>
+        combine_predictions.In(combine_input_tag)[classifier_nums++];
+    return &combine_predictions;
   }
 
  private:
@@ -207,27 +214,24 @@ class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
   absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
                                      HandGestureRecognizerGraphOptions* options,
                                      bool is_copy) {
-    MP_ASSIGN_OR_RETURN(const auto gesture_embedder_file,
-                        resources.GetFile(kGestureEmbedderTFLiteName));
     auto* gesture_embedder_graph_options =
         options->mutable_gesture_embedder_graph_options();
-    SetExternalFile(gesture_embedder_file,
-                    gesture_embedder_graph_options->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kGestureEmbedderTFLiteName,
+        gesture_embedder_graph_options->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
     PopulateAccelerationAndUseStreamMode(
         options->base_options(),
         gesture_embedder_graph_options->mutable_base_options());
 
-    MP_ASSIGN_OR_RETURN(const auto canned_gesture_classifier_file,
-                        resources.GetFile(kCannedGestureClassifierTFLiteName));
     auto* canned_gesture_classifier_graph_options =
         options->mutable_canned_gesture_classifier_graph_options();
-    SetExternalFile(
-        canned_gesture_classifier_file,
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kCannedGestureClassifierTFLiteName,
         canned_gesture_classifier_graph_options->mutable_base_options()
             ->mutable_model_asset(),
-        is_copy);
+        is_copy));
     PopulateAccelerationAndUseStreamMode(
         options->base_options(),
         canned_gesture_classifier_graph_options->mutable_base_options());
@@ -238,11 +242,11 @@ class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
       has_custom_gesture_classifier = true;
       auto* custom_gesture_classifier_graph_options =
           options->mutable_custom_gesture_classifier_graph_options();
-      SetExternalFile(
-          custom_gesture_classifier_file.value(),
+      MP_RETURN_IF_ERROR(resources.SetExternalFile(
+          kCustomGestureClassifierTFLiteName,
           custom_gesture_classifier_graph_options->mutable_base_options()
               ->mutable_model_asset(),
-          is_copy);
+          is_copy));
       PopulateAccelerationAndUseStreamMode(
           options->base_options(),
           custom_gesture_classifier_graph_options->mutable_base_options());
@@ -293,6 +297,97 @@ class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
     return sub_task_model_resources;
   }
 
+  // Adds the inference of one gesture classifier on the gesture embedding,
+  // followed by the TensorsToClassificationCalculator that is returned.
+  absl::StatusOr<GenericNode*> AddGestureClassifier(
+      const core::ModelResources* model_resources,
+      const proto::GestureClassifierGraphOptions& options,
+      Source<std::vector<Tensor>> embedding_tensors, Graph& graph) {
+    auto& gesture_classifier_inference = AddInference(
+        *model_resources, options.base_options().acceleration(), graph);
+    embedding_tensors >> gesture_classifier_inference.In(kTensorsTag);
+    auto gesture_inference_out_tensors =
+        gesture_classifier_inference.Out(kTensorsTag);
+    auto& tensors_to_classification =
+        graph.AddNode("TensorsToClassificationCalculator");
+    MP_RETURN_IF_ERROR(ConfigureTensorsToClassificationCalculator(
+        options.classifier_options(), *model_resources->GetMetadataExtractor(),
+        0,
+        &tensors_to_classification.GetOptions<
+            mediapipe::TensorsToClassificationCalculatorOptions>()));
+    gesture_inference_out_tensors >> tensors_to_classification.In(kTensorsTag);
+    return &tensors_to_classification;
+  }
+
+  bool has_custom_gesture_classifier = false;
+};
+
+// A
+// "mediapipe.tasks.vision.gesture_recognizer.SingleHandGestureRecognizerGraph"
+// performs single hand gesture recognition. This graph is used as a building
+// block for mediapipe.tasks.vision.GestureRecognizerGraph.
+//
+// Inputs:
+//   HANDEDNESS - ClassificationList
+//     Classification of handedness.
+//   LANDMARKS - NormalizedLandmarkList
+//     Detected hand landmarks in normalized image coordinates.
+//   WORLD_LANDMARKS - LandmarkList
+//     Detected hand landmarks in world coordinates.
+//   IMAGE_SIZE - std::pair<int, int>
+//     The size of image from which the landmarks detected from.
+//   NORM_RECT - NormalizedRect
+//     NormalizedRect whose 'rotation' field is used to rotate the
+//     landmarks before processing them.
+//
+// Outputs:
+//   HAND_GESTURES - ClassificationList
+//     Recognized hand gestures with sorted order such that the winning label is
+//     the first item in the list.
+//
+//
+// Example:
+// node {
+//   calculator: "mediapipe.tasks.vision.SingleHandGestureRecognizerGraph"
+//   input_stream: "HANDEDNESS:handedness"
+//   input_stream: "LANDMARKS:landmarks"
+//   input_stream: "WORLD_LANDMARKS:world_landmarks"
+//   input_stream: "IMAGE_SIZE:image_size"
+//   input_stream: "NORM_RECT:norm_rect"
+//   output_stream: "HAND_GESTURES:hand_gestures"
+//   options {
+//     [mediapipe.tasks.vision.gesture_recognizer.proto.HandGestureRecognizerGraphOptions.ext]
+//     {
+//       base_options {
+//         model_asset {
+//           file_name: "hand_gesture.tflite"
+//         }
+//       }
+//     }
+//   }
+// }
+class SingleHandGestureRecognizerGraph
+    : public HandGestureRecognizerGraphBase {
+ public:
+  absl::StatusOr<CalculatorGraphConfig> GetConfig(
+      SubgraphContext* sc) override {
+    MP_ASSIGN_OR_RETURN(const auto sub_task_model_resources,
+                        LoadSubTaskModelResources(sc));
+    Graph graph;
+    MP_ASSIGN_OR_RETURN(auto hand_gestures,
+                        BuildGestureRecognizerGraph(
+                            sc->Options<HandGestureRecognizerGraphOptions>(),
+                            sub_task_model_resources,
+                            graph[Input<ClassificationList>(kHandednessTag)],
+                            graph[Input<NormalizedLandmarkList>(kLandmarksTag)],
+                            graph[Input<LandmarkList>(kWorldLandmarksTag)],
+                            graph[Input<std::pair<int, int>>(kImageSizeTag)],
+                            graph[Input<NormalizedRect>(kNormRectTag)], graph));
+    hand_gestures >> graph[Output<ClassificationList>(kHandGesturesTag)];
+    return graph.GetConfig();
+  }
+
+ private:
   absl::StatusOr<Source<ClassificationList>> BuildGestureRecognizerGraph(
       const HandGestureRecognizerGraphOptions& graph_options,
       const SubTaskModelResources& sub_task_model_resources,
@@ -355,71 +450,14 @@ class SingleHandGestureRecognizerGraph : public core::ModelTaskGraph {
     hand_world_landmarks_tensor >> concatenate_tensor_vector.In(2);
     auto concatenated_tensors = concatenate_tensor_vector.Out("");
 
-    // Inference for gesture embedder.
-    auto& gesture_embedder_inference =
-        AddInference(*sub_task_model_resources.gesture_embedder_model_resource,
-                     graph_options.gesture_embedder_graph_options()
-                         .base_options()
-                         .acceleration(),
-                     graph);
-    concatenated_tensors >> gesture_embedder_inference.In(kTensorsTag);
-    auto embedding_tensors =
-        gesture_embedder_inference.Out(kTensorsTag).Cast<Tensor>();
-
-    auto& combine_predictions = graph.AddNode("CombinedPredictionCalculator");
-    MP_RETURN_IF_ERROR(ConfigureCombinedPredictionCalculator(
-        &combine_predictions
-             .GetOptions<CombinedPredictionCalculatorOptions>()));
-
-    int classifier_nums = 0;
-    // Inference for custom gesture classifier if it exists.
-    if (has_custom_gesture_classifier) {
-      MP_ASSIGN_OR_RETURN(
-          auto gesture_classification_list,
-          GetGestureClassificationList(
-              sub_task_model_resources.custom_gesture_classifier_model_resource,
-              graph_options.custom_gesture_classifier_graph_options(),
-              embedding_tensors, graph));
-      gesture_classification_list >> combine_predictions.In(classifier_nums++);
-    }
-
-    // Inference for canned gesture classifier.
     MP_ASSIGN_OR_RETURN(
-        auto gesture_classification_list,
-        GetGestureClassificationList(
-            sub_task_model_resources.canned_gesture_classifier_model_resource,
-            graph_options.canned_gesture_classifier_graph_options(),
-            embedding_tensors, graph));
-    gesture_classification_list >> combine_predictions.In(classifier_nums++);
-
-    auto combined_classification_list =
-        combine_predictions.Out(kPredictionTag).Cast<ClassificationList>();
-
-    return combined_classification_list;
+        auto* combine_predictions,
+        AddGestureClassification(
+            graph_options, sub_task_model_resources,
+            concatenated_tensors.Cast<std::vector<Tensor>>(),
+            /*batched=*/false, graph));
+    return combine_predictions->Out(kPredictionTag).Cast<ClassificationList>();
   }
-
-  absl::StatusOr<Source<ClassificationList>> GetGestureClassificationList(
-      const core::ModelResources* model_resources,
-      const proto::GestureClassifierGraphOptions& options,
-      Source<Tensor>& embedding_tensors, Graph& graph) {
-    auto& gesture_classifier_inference = AddInference(
-        *model_resources, options.base_options().acceleration(), graph);
-    embedding_tensors >> gesture_classifier_inference.In(kTensorsTag);
-    auto gesture_inference_out_tensors =
-        gesture_classifier_inference.Out(kTensorsTag);
-    auto& tensors_to_classification =
-        graph.AddNode("TensorsToClassificationCalculator");
-    MP_RETURN_IF_ERROR(ConfigureTensorsToClassificationCalculator(
-        options.classifier_options(), *model_resources->GetMetadataExtractor(),
-        0,
-        &tensors_to_classification.GetOptions<
-            mediapipe::TensorsToClassificationCalculatorOptions>()));
-    gesture_inference_out_tensors >> tensors_to_classification.In(kTensorsTag);
-    return tensors_to_classification.Out("CLASSIFICATIONS")
-        .Cast<ClassificationList>();
-  }
-
-  bool has_custom_gesture_classifier = false;
 };
 
 // clang-format off
@@ -453,6 +491,10 @@ REGISTER_MEDIAPIPE_GRAPH(
 //     A vector of recognized hand gestures. Each vector element is the
 //     ClassificationList of the hand in input vector.
 //
+// With `batch_hands` enabled in the options, the features of all hands are
+// converted into batched tensors and the gesture models run once per frame
+// for all hands, instead of running SingleHandGestureRecognizerGraph for
+// each hand.
 //
 // Example:
 // node {
@@ -476,10 +518,29 @@ REGISTER_MEDIAPIPE_GRAPH(
 //     }
 //   }
 // }
-class MultipleHandGestureRecognizerGraph : public core::ModelTaskGraph {
+class MultipleHandGestureRecognizerGraph
+    : public HandGestureRecognizerGraphBase {
  public:
   absl::StatusOr<CalculatorGraphConfig> GetConfig(
       SubgraphContext* sc) override {
+    if (sc->Options<HandGestureRecognizerGraphOptions>().batch_hands()) {
+      MP_ASSIGN_OR_RETURN(const auto sub_task_model_resources,
+                          LoadSubTaskModelResources(sc));
+      Graph graph;
+      MP_ASSIGN_OR_RETURN(
+          auto multi_hand_gestures,
+          BuildBatchedGestureRecognizerGraph(
+              sc->Options<HandGestureRecognizerGraphOptions>(),
+              sub_task_model_resources,
+              graph[Input<std::vector<ClassificationList>>(kHandednessTag)],
+              graph[Input<std::vector<NormalizedLandmarkList>>(kLandmarksTag)],
+              graph[Input<std::vector<LandmarkList>>(kWorldLandmarksTag)],
+              graph[Input<std::pair<int, int>>(kImageSizeTag)],
+              graph[Input<NormalizedRect>(kNormRectTag)], graph));
+      multi_hand_gestures >>
+          graph[Output<std::vector<ClassificationList>>(kHandGesturesTag)];
+      return graph.GetConfig();
+    }
     Graph graph;
     MP_ASSIGN_OR_RETURN(
         auto multi_hand_gestures,
@@ -497,6 +558,65 @@ class MultipleHandGestureRecognizerGraph : public core::ModelTaskGraph {
   }
 
  private:
+  // Converts the features of all hands into batched tensors, so that the
+  // gesture models run once for all hands. The hands are in the order of the
+  // input vectors, which is the order of their tracking ids.
+  absl::StatusOr<Source<std::vector<ClassificationList>>>
+  BuildBatchedGestureRecognizerGraph(
+      const HandGestureRecognizerGraphOptions& graph_options,
+      const SubTaskModelResources& sub_task_model_resources,
+      Source<std::vector<ClassificationList>> multi_handedness,
+      Source<std::vector<NormalizedLandmarkList>> multi_hand_landmarks,
+      Source<std::vector<LandmarkList>> multi_hand_world_landmarks,
+      Source<std::pair<int, int>> image_size, Source<NormalizedRect> norm_rect,
+      Graph& graph) {
+    auto& handedness_to_tensors = graph.AddNode("HandednessToMatrixCalculator");
+    multi_handedness >> handedness_to_tensors.In(kHandednessVectorTag);
+    auto handedness_tensors =
+        handedness_to_tensors[Output<std::vector<Tensor>>(kTensorsTag)];
+
+    LandmarksToMatrixCalculatorOptions landmarks_options;
+    landmarks_options.set_object_normalization(true);
+    landmarks_options.set_object_normalization_origin_offset(0);
+    auto& hand_landmarks_to_tensors =
+        graph.AddNode("LandmarksToMatrixCalculator");
+    hand_landmarks_to_tensors.GetOptions<LandmarksToMatrixCalculatorOptions>() =
+        landmarks_options;
+    multi_hand_landmarks >> hand_landmarks_to_tensors.In(kLandmarksVectorTag);
+    image_size >> hand_landmarks_to_tensors.In(kImageSizeTag);
+    norm_rect >> hand_landmarks_to_tensors.In(kNormRectTag);
+    auto hand_landmarks_tensors =
+        hand_landmarks_to_tensors[Output<std::vector<Tensor>>(kTensorsTag)];
+
+    auto& hand_world_landmarks_to_tensors =
+        graph.AddNode("LandmarksToMatrixCalculator");
+    hand_world_landmarks_to_tensors
+        .GetOptions<LandmarksToMatrixCalculatorOptions>() = landmarks_options;
+    multi_hand_world_landmarks >>
+        hand_world_landmarks_to_tensors.In(kWorldLandmarksVectorTag);
+    image_size >> hand_world_landmarks_to_tensors.In(kImageSizeTag);
+    norm_rect >> hand_world_landmarks_to_tensors.In(kNormRectTag);
+    auto hand_world_landmarks_tensors =
+        hand_world_landmarks_to_tensors[Output<std::vector<Tensor>>(
+            kTensorsTag)];
+
+    auto& concatenate_tensor_vector =
+        graph.AddNode("ConcatenateTensorVectorCalculator");
+    hand_landmarks_tensors >> concatenate_tensor_vector.In(0);
+    handedness_tensors >> concatenate_tensor_vector.In(1);
+    hand_world_landmarks_tensors >> concatenate_tensor_vector.In(2);
+    auto concatenated_tensors = concatenate_tensor_vector.Out("");
+
+    MP_ASSIGN_OR_RETURN(
+        auto* combine_predictions,
+        AddGestureClassification(
+            graph_options, sub_task_model_resources,
+            concatenated_tensors.Cast<std::vector<Tensor>>(),
+            /*batched=*/true, graph));
+    return combine_predictions->Out(kBatchedPredictionsTag)
+        .Cast<std::vector<ClassificationList>>();
+  }
+
   absl::StatusOr<Source<std::vector<ClassificationList>>>
   BuildMultiGestureRecognizerSubraph(
       const HandGestureRecognizerGraphOptions& graph_options,
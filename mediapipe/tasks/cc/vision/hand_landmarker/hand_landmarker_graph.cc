@@ -22,6 +22,7 @@ limitations under the License.
 #include "mediapipe/calculators/core/clip_vector_size_calculator.pb.h"
 #include "mediapipe/calculators/core/gate_calculator.pb.h"
 #include "mediapipe/calculators/util/collection_has_min_size_calculator.pb.h"
+#include "mediapipe/calculators/util/detection_scheduler_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/formats/classification.pb.h"
@@ -37,7 +38,6 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/model_resources_cache.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/utils.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/hand_detector/proto/hand_detector_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/hand_landmarker/calculators/hand_association_calculator.pb.h"
 #include "mediapipe/tasks/cc/vision/hand_landmarker/proto/hand_landmarker_graph_options.pb.h"
@@ -58,7 +58,6 @@ using ::mediapipe::api2::builder::Graph;
 using ::mediapipe::api2::builder::Stream;
 using ::mediapipe::tasks::components::utils::DisallowIf;
 using ::mediapipe::tasks::core::ModelAssetBundleResources;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 using ::mediapipe::tasks::vision::hand_detector::proto::
     HandDetectorGraphOptions;
 using ::mediapipe::tasks::vision::hand_landmarker::proto::
@@ -96,12 +95,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
   auto* hand_detector_graph_options =
       options->mutable_hand_detector_graph_options();
   if (!hand_detector_graph_options->base_options().has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto hand_detector_file,
-                        resources.GetFile(kHandDetectorTFLiteName));
-    SetExternalFile(hand_detector_file,
-                    hand_detector_graph_options->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kHandDetectorTFLiteName,
+        hand_detector_graph_options->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
   }
   hand_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -112,13 +110,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       options->mutable_hand_landmarks_detector_graph_options();
   if (!hand_landmarks_detector_graph_options->base_options()
            .has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto hand_landmarks_detector_file,
-                        resources.GetFile(kHandLandmarksDetectorTFLiteName));
-    SetExternalFile(
-        hand_landmarks_detector_file,
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kHandLandmarksDetectorTFLiteName,
         hand_landmarks_detector_graph_options->mutable_base_options()
             ->mutable_model_asset(),
-        is_copy);
+        is_copy));
   }
   hand_landmarks_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -132,6 +128,31 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       options->base_options().gpu_origin());
   return absl::OkStatus();
 }
+
+// Returns a stream of bools telling whether the hand detector can be skipped
+// on the current frame, given the hand rects tracked from the previous frame.
+Stream<bool> SkipHandDetection(
+    const HandLandmarkerGraphOptions& tasks_options, Stream<Image> image_in,
+    Stream<std::vector<NormalizedRect>> prev_hand_rects, Graph& graph) {
+  const int max_num_hands =
+      tasks_options.hand_detector_graph_options().num_hands();
+  if (tasks_options.has_detection_scheduler_options()) {
+    auto& scheduler = graph.AddNode("DetectionSchedulerCalculator");
+    auto& scheduler_options =
+        scheduler.GetOptions<DetectionSchedulerCalculatorOptions>();
+    scheduler_options.CopyFrom(tasks_options.detection_scheduler_options());
+    scheduler_options.set_max_num_objects(max_num_hands);
+    image_in >> scheduler.In("TICK");
+    prev_hand_rects >> scheduler.In("TRACKED_RECTS");
+    return scheduler.Out("SKIP_DETECTION").Cast<bool>();
+  }
+  auto& min_size_node =
+      graph.AddNode("NormalizedRectVectorHasMinSizeCalculator");
+  prev_hand_rects >> min_size_node.In("ITERABLE");
+  min_size_node.GetOptions<CollectionHasMinSizeCalculatorOptions>()
+      .set_min_size(max_num_hands);
+  return min_size_node.Out("").Cast<bool>();
+}
 }  // namespace
 
 // A "mediapipe.tasks.vision.hand_landmarker.HandLandmarkerGraph" performs hand
@@ -277,12 +298,8 @@ class HandLandmarkerGraph : public core::ModelTaskGraph {
     auto prev_hand_rects_from_landmarks =
         previous_loopback[Output<std::vector<NormalizedRect>>("PREV_LOOP")];
 
-    auto& min_size_node =
-        graph.AddNode("NormalizedRectVectorHasMinSizeCalculator");
-    prev_hand_rects_from_landmarks >> min_size_node.In("ITERABLE");
-    min_size_node.GetOptions<CollectionHasMinSizeCalculatorOptions>()
-        .set_min_size(max_num_hands);
-    auto has_enough_hands = min_size_node.Out("").Cast<bool>();
+    auto skip_hand_detection = SkipHandDetection(
+        tasks_options, image_in, prev_hand_rects_from_landmarks, graph);
 
     auto& hand_detector =
         graph.AddNode("mediapipe.tasks.vision.hand_detector.HandDetectorGraph");
@@ -295,13 +312,14 @@ class HandLandmarkerGraph : public core::ModelTaskGraph {
 
     if (tasks_options.base_options().use_stream_mode()) {
       // While in stream mode, skip hand detector graph when we successfully
-      // track the hands from the last frame.
+      // track the hands from the last frame, as decided by the detection
+      // scheduler if one is configured.
       auto image_for_hand_detector =
-          DisallowIf(image_in, has_enough_hands, graph);
+          DisallowIf(image_in, skip_hand_detection, graph);
       std::optional<Stream<NormalizedRect>> norm_rect_in_for_hand_detector;
       if (norm_rect_in) {
         norm_rect_in_for_hand_detector =
-            DisallowIf(norm_rect_in.value(), has_enough_hands, graph);
+            DisallowIf(norm_rect_in.value(), skip_hand_detection, graph);
       }
       image_for_hand_detector >> hand_detector.In("IMAGE");
       if (norm_rect_in_for_hand_detector) {
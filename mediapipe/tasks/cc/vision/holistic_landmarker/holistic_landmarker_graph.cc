@@ -14,6 +14,7 @@ limitations under the License.
 ==============================================================================*/
 
 #include <string>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -31,7 +32,6 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/model_resources_cache.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/utils.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/face_detector/proto/face_detector_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/face_landmarker/proto/face_blendshapes_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/face_landmarker/proto/face_landmarks_detector_graph_options.pb.h"
@@ -55,7 +55,6 @@ namespace {
 using ::mediapipe::api2::Output;
 using ::mediapipe::api2::builder::Graph;
 using ::mediapipe::api2::builder::Stream;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 
 constexpr absl::string_view kHandLandmarksDetectorModelName =
     "hand_landmarks_detector.tflite";
@@ -112,12 +111,10 @@ absl::Status SetSubTaskBaseOptions(
     proto::HolisticLandmarkerGraphOptions* options, T* sub_task_options,
     absl::string_view model_name, bool is_copy) {
   if (!sub_task_options->base_options().has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto model_file_content,
-                        resources->GetFile(std::string(model_name)));
-    SetExternalFile(
-        model_file_content,
+    MP_RETURN_IF_ERROR(resources->SetExternalFile(
+        std::string(model_name),
         sub_task_options->mutable_base_options()->mutable_model_asset(),
-        is_copy);
+        is_copy));
   }
   sub_task_options->mutable_base_options()->mutable_acceleration()->CopyFrom(
       options->base_options().acceleration());
@@ -181,6 +178,23 @@ void SetGraphFaceOutputs(const CalculatorGraphConfig::Node& node,
   }
 }
 
+// Range of nodes added to the graph by one of the tracking branches.
+struct BranchNodes {
+  int begin;
+  int end;
+  std::string executor;
+};
+
+// Runs the nodes of `branch` on its executor, if one is specified. Subgraph
+// nodes pass the executor on to the nodes they expand into.
+void SetBranchExecutor(const BranchNodes& branch,
+                       CalculatorGraphConfig& config) {
+  if (branch.executor.empty()) return;
+  for (int i = branch.begin; i < branch.end; ++i) {
+    config.mutable_node(i)->set_executor(branch.executor);
+  }
+}
+
 }  // namespace
 
 // Tracks pose and detects hands and face.
@@ -420,6 +434,10 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
     MP_RETURN_IF_ERROR(
         SetGraphPoseOutputs(pose_request, holistic_node, pose_output, graph));
 
+    // Face and hand tracking only depend on the image and the pose, so each of
+    // them can run on its own executor.
+    std::vector<BranchNodes> branches;
+
     // Detect and track hand.
     if (hands_requested) {
       if (is_left_hand_requested || is_left_hand_world_requested) {
@@ -434,6 +452,7 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
             /*.index_idx = */
             static_cast<int>(pose_landmarker::PoseLandmarkName::kLeftIndex1),
         };
+        const int first_hand_node = graph.NumNodes();
         HolisticHandTrackingRequest hand_request = {
             /*.landmarks = */ is_left_hand_requested,
             /*.world_landmarks = */ is_left_hand_world_requested,
@@ -449,6 +468,9 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
                 ));
         SetGraphHandOutputs(/*is_left=*/true, holistic_node, hand_output,
                             graph);
+        branches.push_back(
+            {first_hand_node, graph.NumNodes(),
+             holistic_options->left_hand_tracking_executor()});
       }
 
       if (is_right_hand_requested || is_right_hand_world_requested) {
@@ -463,6 +485,7 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
             /*.index_idx = */
             static_cast<int>(pose_landmarker::PoseLandmarkName::kRightIndex1),
         };
+        const int first_hand_node = graph.NumNodes();
         HolisticHandTrackingRequest hand_request = {
             /*.landmarks = */ is_right_hand_requested,
             /*.world_landmarks = */ is_right_hand_world_requested,
@@ -478,6 +501,9 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
                 ));
         SetGraphHandOutputs(/*is_left=*/false, holistic_node, hand_output,
                             graph);
+        branches.push_back(
+            {first_hand_node, graph.NumNodes(),
+             holistic_options->right_hand_tracking_executor()});
       }
     }
 
@@ -485,6 +511,7 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
     if (face_requested) {
       RET_CHECK(pose_output.landmarks.has_value());
 
+      const int first_face_node = graph.NumNodes();
       Stream<mediapipe::NormalizedLandmarkList> face_landmarks_from_pose =
           api2::builder::SplitToRanges(*pose_output.landmarks, {{0, 11}},
                                        graph)[0];
@@ -500,6 +527,8 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
               holistic_options->face_landmarks_detector_graph_options(),
               face_request, graph));
       SetGraphFaceOutputs(holistic_node, face_output, graph);
+      branches.push_back({first_face_node, graph.NumNodes(),
+                          holistic_options->face_tracking_executor()});
     }
 
     auto& pass_through = graph.AddNode("PassThroughCalculator");
@@ -507,6 +536,9 @@ class HolisticLandmarkerGraph : public core::ModelTaskGraph {
     pass_through.Out("") >> graph.Out("IMAGE");
 
     auto config = graph.GetConfig();
+    for (const BranchNodes& branch : branches) {
+      SetBranchExecutor(branch, config);
+    }
     core::FixGraphBackEdges(config);
     return config;
   }
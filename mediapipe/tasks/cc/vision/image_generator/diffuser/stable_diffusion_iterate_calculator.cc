@@ -18,13 +18,18 @@ limitations under the License.
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/log/absl_log.h"
 #include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/api2/node.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator_context.h"
@@ -32,6 +37,7 @@ limitations under the License.
 #include "mediapipe/framework/deps/file_helpers.h"
 #include "mediapipe/framework/formats/image_frame.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/port/threadpool.h"
 #include "mediapipe/tasks/cc/vision/image_generator/diffuser/diffuser_gpu.h"
 #include "mediapipe/tasks/cc/vision/image_generator/diffuser/stable_diffusion_iterate_calculator.pb.h"
 
@@ -62,6 +68,32 @@ DiffuserModelType ToDiffuserModelType(
   return kDiffuserModelTypeSd1;
 }
 
+// Box-filters an SRGB `image` down by an integer `factor`.
+ImageFrame DownscaleImage(const ImageFrame& image, int factor) {
+  constexpr int kChannels = 3;
+  ImageFrame result(ImageFormat::SRGB, image.Width() / factor,
+                    image.Height() / factor);
+  const int area = factor * factor;
+  for (int y = 0; y < result.Height(); ++y) {
+    uint8_t* out = result.MutablePixelData() + y * result.WidthStep();
+    for (int x = 0; x < result.Width(); ++x) {
+      int sums[kChannels] = {0, 0, 0};
+      for (int dy = 0; dy < factor; ++dy) {
+        const uint8_t* in = image.PixelData() +
+                            (y * factor + dy) * image.WidthStep() +
+                            x * factor * kChannels;
+        for (int i = 0; i < factor * kChannels; ++i) {
+          sums[i % kChannels] += in[i];
+        }
+      }
+      for (int c = 0; c < kChannels; ++c) {
+        out[x * kChannels + c] = static_cast<uint8_t>(sums[c] / area);
+      }
+    }
+  }
+  return result;
+}
+
 }  // namespace
 
 // Runs diffusion models including, but not limited to, Stable Diffusion & gLDM.
@@ -81,6 +113,10 @@ DiffuserModelType ToDiffuserModelType(
 //     Whether to show the diffusion result at the current step, regardless
 //     of what show_every_n_iteration is set to.
 //
+// With pipeline_iterations, the steps fed through ITERATION run on a worker
+// thread, and the calculator only waits for them before decoding an image.
+// Intermediate images can be downscaled with preview_downscale_factor.
+//
 // Outputs:
 //   IMAGE - mediapipe::ImageFrame
 //     The image generated by the Stable Diffusion model from the input prompt.
@@ -117,6 +153,8 @@ class StableDiffusionIterateCalculator : public Node {
                           kOptionsIn, kImageOut);
 
   ~StableDiffusionIterateCalculator() {
+    // Finishes the queued iterations before the diffuser is deleted.
+    worker_.reset();
     if (context_) DiffuserDelete();
     if (handle_) dlclose(handle_);
   }
@@ -177,6 +215,39 @@ class StableDiffusionIterateCalculator : public Node {
   bool DiffuserDecode(uint8_t* a) { return (*decode_ptr_)(context_, a); }
   void DiffuserDelete() { (*delete_ptr_)(context_); }
 
+  // Queues a UNet step on `worker_`. Failures are reported by the next
+  // WaitForIterations() or IterationStatus().
+  void ScheduleIterate(int steps, int iteration) {
+    {
+      absl::MutexLock lock(&mutex_);
+      ++pending_iterations_;
+    }
+    worker_->Schedule([this, steps, iteration] {
+      const bool ok = DiffuserIterate(steps, iteration);
+      absl::MutexLock lock(&mutex_);
+      if (!ok && iteration_status_.ok()) {
+        iteration_status_ = absl::InternalError(
+            absl::StrCat("DiffuserIterate failed at iteration ", iteration));
+      }
+      --pending_iterations_;
+    });
+  }
+
+  // Waits until all queued steps have run. The diffuser may then be used from
+  // the calling thread until the next ScheduleIterate().
+  absl::Status WaitForIterations() {
+    absl::MutexLock lock(&mutex_);
+    mutex_.Await(absl::Condition(
+        +[](int* pending) { return *pending == 0; }, &pending_iterations_));
+    return iteration_status_;
+  }
+
+  // Returns the first failure among the steps that have run so far.
+  absl::Status IterationStatus() {
+    absl::MutexLock lock(&mutex_);
+    return iteration_status_;
+  }
+
   void* handle_ = nullptr;
   DiffuserContext* context_ = nullptr;
   DiffuserContext* (*create_ptr_)(const DiffuserConfig*);
@@ -188,6 +259,13 @@ class StableDiffusionIterateCalculator : public Node {
 
   int show_every_n_iteration_;
   bool emit_empty_packet_;
+  int preview_downscale_factor_;
+
+  // Runs the diffuser steps when pipelining iterations, otherwise null.
+  std::unique_ptr<ThreadPool> worker_;
+  absl::Mutex mutex_;
+  int pending_iterations_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::Status iteration_status_ ABSL_GUARDED_BY(mutex_);
 };
 
 absl::Status StableDiffusionIterateCalculator::UpdateContract(
@@ -204,6 +282,9 @@ absl::Status StableDiffusionIterateCalculator::Open(CalculatorContext* cc) {
   }
   show_every_n_iteration_ = options.show_every_n_iteration();
   emit_empty_packet_ = options.emit_empty_packet();
+  preview_downscale_factor_ = options.preview_downscale_factor();
+  RET_CHECK_GE(preview_downscale_factor_, 1)
+      << "preview_downscale_factor must be at least 1.";
 
   MP_RETURN_IF_ERROR(LoadDiffuser());
 
@@ -251,6 +332,10 @@ absl::Status StableDiffusionIterateCalculator::Open(CalculatorContext* cc) {
       << "The value of plugins_strength must be in the range of [0, 1].";
   context_ = DiffuserCreate(&config);
   RET_CHECK(context_);
+  if (options.pipeline_iterations()) {
+    worker_ = std::make_unique<ThreadPool>("diffuser", /*num_threads=*/1);
+    worker_->StartWorkers();
+  }
   return absl::OkStatus();
 }
 
@@ -283,24 +368,36 @@ absl::Status StableDiffusionIterateCalculator::Process(CalculatorContext* cc) {
 
     // Extract text embedding on first iteration.
     if (iteration == 0) {
+      // Steps still queued from a previous run must not overlap the reset.
+      if (worker_) MP_RETURN_IF_ERROR(WaitForIterations());
       const auto plugin_tensors = GetPluginTensors(cc);
       RET_CHECK(DiffuserReset(prompt.c_str(), steps, rand_seed,
                               plugins_strength, &plugin_tensors));
     }
 
-    RET_CHECK(DiffuserIterate(steps, iteration));
-
     bool force_show_result = kShowResultIn(cc).IsConnected() &&
                              !kShowResultIn(cc).IsEmpty() &&
                              kShowResultIn(cc).Get();
     bool show_result = force_show_result ||
                        (iteration + 1) % show_every_n_iteration_ == 0 ||
                        iteration == steps - 1;
+
+    if (worker_) {
+      ScheduleIterate(steps, iteration);
+      // Only sync with the queued steps when the image is needed.
+      MP_RETURN_IF_ERROR(show_result ? WaitForIterations() : IterationStatus());
+    } else {
+      RET_CHECK(DiffuserIterate(steps, iteration));
+    }
+
     // Decode the output and send out the image for visualization.
     if (show_result) {
       ImageFrame image_out(ImageFormat::SRGB, options.output_image_width(),
                            options.output_image_height());
       RET_CHECK(DiffuserDecode(image_out.MutablePixelData()));
+      if (preview_downscale_factor_ > 1 && iteration != steps - 1) {
+        image_out = DownscaleImage(image_out, preview_downscale_factor_);
+      }
       kImageOut(cc).Send(std::move(image_out));
     } else if (emit_empty_packet_) {
       kImageOut(cc).Send(Packet<mediapipe::ImageFrame>());
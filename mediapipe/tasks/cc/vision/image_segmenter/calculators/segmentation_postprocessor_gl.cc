@@ -47,6 +47,8 @@ const GLchar* attr_name[NUM_ATTRIBUTES] = {
 // MRT easily.
 static constexpr char kEs30RequirementHeader[] = "#version 300 es\n";
 
+// Used as the fragment shader of the split program, so that the activation is
+// applied while splitting, without a separate full-size pass.
 static constexpr char kActivationFragmentShader[] = R"(
 DEFAULT_PRECISION(mediump, float)
 in vec2 sample_coordinate;
@@ -61,16 +63,6 @@ void main() {
   gl_FragColor = out_value;
 })";
 
-// Trivial passthrough fragment shader; do splitting in a custom vertex shader.
-static constexpr char kPassthroughShader[] = R"(
-DEFAULT_PRECISION(mediump, float)
-in vec2 sample_coordinate;
-uniform sampler2D input_texture;
-
-void main() {
-  gl_FragColor = texture2D(input_texture, sample_coordinate);
-})";
-
 // Vertex shader for splitting; kLayoutAligned means we just move across x-axis.
 static constexpr char kSplitVertexShader[] = R"(
 DEFAULT_PRECISION(highp, float)
@@ -305,6 +297,75 @@ void main() {
     gl_FragColor = chunk_pixel / sum_pixel;
 })";
 
+// Fused output shader: in a single pass over one chunk, writes the chunk's
+// (up to 4) confidence masks to color attachments 0-3 and advances the argmax
+// used for the category mask in color attachment 4. Attachments for outputs
+// that weren't requested are disabled through glDrawBuffers.
+//
+// For the last chunk, the category mask itself is written instead of the
+// intermediate (max value, argmax) state, so no final channel-select pass is
+// needed. The one-class fg/bg cutoff matches kArgmaxOneClassShader.
+static constexpr char kFusedOutputShader[] = R"(
+DEFAULT_PRECISION(highp, float)
+in vec2 sample_coordinate;
+uniform sampler2D current_chunk;     // activated chunk, used for argmax
+uniform sampler2D confidence_chunk;  // chunk with the final confidence values
+uniform sampler2D prev_max_texture;  // prev_max_value, prev_max_arg, 0, 1
+uniform int num_channels;  // how many channels from current chunk to use (1-4)
+uniform int argmax_offset;  // index of first class in current chunk
+uniform int num_classes;  // total number of classes
+
+layout(location = 0) out vec4 confidence_mask_0;
+layout(location = 1) out vec4 confidence_mask_1;
+layout(location = 2) out vec4 confidence_mask_2;
+layout(location = 3) out vec4 confidence_mask_3;
+layout(location = 4) out vec4 category_out;
+
+void main() {
+  vec4 confidence = texture(confidence_chunk, sample_coordinate);
+  confidence_mask_0 = vec4(confidence.r);
+  confidence_mask_1 = vec4(confidence.g);
+  confidence_mask_2 = vec4(confidence.b);
+  confidence_mask_3 = vec4(confidence.a);
+
+  vec4 chunk_pixel = texture(current_chunk, sample_coordinate);
+  if (num_classes == 1) {
+    float category = clamp(floor(1.5 - chunk_pixel.x), 0.0, 1.0);
+    category_out = vec4(category, 0.0, 0.0, 1.0);
+    return;
+  }
+
+  float max_value = chunk_pixel.x;
+  int argmax = 0;
+  for (int c = 1; c < 4; ++c) {
+    if (c < num_channels && chunk_pixel[c] > max_value) {
+      max_value = chunk_pixel[c];
+      argmax = c;
+    }
+  }
+  argmax += argmax_offset;
+
+  // The first chunk has no previous state to compare against.
+  if (argmax_offset > 0) {
+    vec2 prev_pixel = texture(prev_max_texture, sample_coordinate).xy;
+    if (prev_pixel.x >= max_value) {
+      max_value = prev_pixel.x;
+      argmax = int(prev_pixel.y * 255.0 + 0.5);
+    }
+  }
+
+  // Argmax is encoded as a float from 0.0 to 1.0 in steps of 1/255.0.
+  float encoded_argmax = float(argmax) / 255.0;
+  if (argmax_offset + num_channels >= num_classes) {
+    category_out = vec4(encoded_argmax, 0.0, 0.0, 1.0);
+  } else {
+    category_out = vec4(max_value, encoded_argmax, 0.0, 1.0);
+  }
+})";
+
+// Number of color attachments written by kFusedOutputShader.
+constexpr int kFusedOutputNumAttachments = 5;
+
 }  // namespace
 
 // static
@@ -390,16 +451,13 @@ absl::Status SegmentationPostprocessorGl::GlInit(
 
     const std::string split_fragment_shader_source =
         absl::StrCat(std::string(mediapipe::kMediaPipeFragmentShaderPreamble),
-                     std::string(kPassthroughShader));
+                     activation_shader_source);
     const std::string split_vertex_shader_source =
         absl::StrCat(std::string(mediapipe::kMediaPipeVertexShaderPreamble),
                      std::string(kSplitVertexShader));
 
     // Compile all our shader programs and grab uniforms.
-    // Simple shaders (Activation and Channel-select)
-    MP_RETURN_IF_ERROR(CreateBasicFragmentShaderProgram(
-        "activation", activation_shader_source, {"input_texture"},
-        &activation_shader_));
+    // Simple shaders (Channel-select)
     MP_RETURN_IF_ERROR(CreateBasicFragmentShaderProgram(
         "channel select", kChannelSelectShader,
         {"input_texture", "channel_select"}, &channel_select_shader_));
@@ -425,6 +483,24 @@ absl::Status SegmentationPostprocessorGl::GlInit(
         "one-class argmax", kArgmaxOneClassShader, {"input_texture"},
         &argmax_one_class_shader_));
 
+    // Fused output shader, if the GPU can write all of its outputs at once.
+    GLint max_draw_buffers = 0;
+    GLint max_color_attachments = 0;
+    glGetIntegerv(GL_MAX_DRAW_BUFFERS, &max_draw_buffers);
+    glGetIntegerv(GL_MAX_COLOR_ATTACHMENTS, &max_color_attachments);
+    use_fused_output_ = max_draw_buffers >= kFusedOutputNumAttachments &&
+                        max_color_attachments >= kFusedOutputNumAttachments;
+    if (use_fused_output_) {
+      MP_RETURN_IF_ERROR(CreateBasicFragmentShaderProgram(
+          "fused output", kFusedOutputShader,
+          {"current_chunk", "confidence_chunk", "prev_max_texture",
+           "num_channels", "argmax_offset", "num_classes"},
+          &fused_output_shader_, true /* is_es30_only */));
+    } else {
+      ABSL_LOG(INFO) << "GPU supports only " << max_draw_buffers
+                     << " draw buffers; using multi-pass mask extraction.";
+    }
+
     // Split shader. This is created separately since it uses a custom vertex
     // shader. TODO: Refactor so this shares common init code as well.
     mediapipe::GlhCreateProgram(split_vertex_shader_source.c_str(),
@@ -473,6 +549,103 @@ bool SegmentationPostprocessorGl::HasGlExtension(std::string const& extension) {
 #endif  // __EMSCRIPTEN__
 }
 
+void SegmentationPostprocessorGl::RenderFusedOutputs(
+    const std::vector<GlTexture>& chunks,
+    const std::vector<GlTexture>& confidence_chunks, int num_outputs,
+    int mask_width, int mask_height, GpuBufferFormat chunk_format,
+    GpuBufferFormat output_format, bool produce_confidence_masks,
+    bool produce_category_mask, std::vector<GlTexture>& outputs) {
+  const int num_chunks = static_cast<int>(chunks.size());
+  const int first_output = static_cast<int>(outputs.size());
+  if (produce_confidence_masks) {
+    for (int i = 0; i < num_outputs; ++i) {
+      outputs.push_back(helper_.CreateDestinationTexture(
+          mask_width, mask_height, output_format));
+    }
+  }
+  GlTexture category_mask;
+  GlTexture max_texture;
+  GlTexture next_max_texture;
+  if (produce_category_mask) {
+    category_mask = helper_.CreateDestinationTexture(mask_width, mask_height,
+                                                     output_format);
+    if (num_chunks > 1) {
+      max_texture = helper_.CreateDestinationTexture(mask_width, mask_height,
+                                                     chunk_format);
+      next_max_texture = helper_.CreateDestinationTexture(
+          mask_width, mask_height, chunk_format);
+    }
+  }
+
+  glUseProgram(fused_output_shader_.program);
+  glUniform1i(fused_output_shader_.uniforms["current_chunk"], 1);
+  glUniform1i(fused_output_shader_.uniforms["confidence_chunk"], 2);
+  glUniform1i(fused_output_shader_.uniforms["prev_max_texture"], 3);
+  glUniform1i(fused_output_shader_.uniforms["num_classes"], num_outputs);
+
+  // Binds the shared framebuffer and sets the viewport to the mask size. The
+  // attachments are replaced for every chunk below.
+  helper_.BindFramebuffer(produce_category_mask ? category_mask
+                                                : outputs[first_output]);
+
+  GLenum draw_buffers[kFusedOutputNumAttachments];
+  for (int i = 0; i < num_chunks; ++i) {
+    int num_channels = 4;
+    if ((i + 1) * 4 > num_outputs) num_channels = num_outputs % 4;
+    const bool is_last_chunk = i == num_chunks - 1;
+
+    for (int c = 0; c < kFusedOutputNumAttachments; ++c) {
+      GLuint texture = 0;
+      if (c < 4) {
+        if (produce_confidence_masks && c < num_channels) {
+          texture = outputs[first_output + i * 4 + c].name();
+        }
+      } else if (produce_category_mask) {
+        texture = is_last_chunk ? category_mask.name()
+                                : next_max_texture.name();
+      }
+      glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + c,
+                             GL_TEXTURE_2D, texture, 0);
+      draw_buffers[c] = texture ? GL_COLOR_ATTACHMENT0 + c : GL_NONE;
+    }
+    glDrawBuffers(kFusedOutputNumAttachments, draw_buffers);
+
+    glUniform1i(fused_output_shader_.uniforms["num_channels"], num_channels);
+    glUniform1i(fused_output_shader_.uniforms["argmax_offset"], i * 4);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D,
+                  produce_category_mask && i > 0 ? max_texture.name() : 0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, confidence_chunks[i].name());
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, chunks[i].name());
+
+    // Every pixel is covered by the quad, so there's no need to clear.
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+
+    if (produce_category_mask && !is_last_chunk) {
+      std::swap(max_texture, next_max_texture);
+    }
+  }
+
+  // Restore the shared framebuffer to a single color attachment.
+  for (int c = 1; c < kFusedOutputNumAttachments; ++c) {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + c,
+                           GL_TEXTURE_2D, 0, 0);
+  }
+  draw_buffers[0] = GL_COLOR_ATTACHMENT0;
+  glDrawBuffers(1, draw_buffers);
+  glActiveTexture(GL_TEXTURE3);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE2);
+  glBindTexture(GL_TEXTURE_2D, 0);
+  glActiveTexture(GL_TEXTURE1);
+
+  if (produce_category_mask) {
+    outputs.push_back(std::move(category_mask));
+  }
+}
+
 std::vector<std::unique_ptr<Image>>
 SegmentationPostprocessorGl::GetSegmentationResultGpu(
     const Shape& input_shape, const Shape& output_shape, const Tensor& tensor,
@@ -487,8 +660,14 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
     const int height = input_shape.height;         // Slice height from chape
     const int num_outputs = input_shape.channels;  // One output per channel
     const int num_chunks = (input_shape.channels + 3) / 4;  // ceil(channels/4)
-    const int output_width = output_shape.width;    // Final output width
-    const int output_height = output_shape.height;  // Final output height
+    // Final output size. Masks may be kept at the tensor resolution, in which
+    // case consumers upscale them on demand when sampling.
+    const bool keep_tensor_resolution =
+        options_.gpu_output_at_tensor_resolution();
+    const int output_width =
+        keep_tensor_resolution ? width : output_shape.width;
+    const int output_height =
+        keep_tensor_resolution ? height : output_shape.height;
     int input_width, input_height;
 
     if (!tensor.ready_on_gpu()) {
@@ -537,9 +716,6 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
         << "Segmentation postprocessing error: GPU does not fully support "
         << "4-channel float32 or float16 formats.";
 
-    const GpuBufferFormat activation_output_format =
-        can_use_f32 ? GpuBufferFormat::kRGBAFloat128
-                    : GpuBufferFormat::kRGBAHalf64;
     const GpuBufferFormat chunk_output_format =
         can_use_f32 ? GpuBufferFormat::kRGBAFloat128
                     : GpuBufferFormat::kRGBAHalf64;
@@ -563,29 +739,19 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
     glVertexAttribPointer(ATTRIB_TEXTURE_POSITION, 2, GL_FLOAT, 0, 0, nullptr);
     glEnableVertexAttribArray(ATTRIB_TEXTURE_POSITION);
 
-    // Step 1: apply activation pass
-    glUseProgram(activation_shader_.program);
-    glUniform1i(activation_shader_.uniforms["input_texture"], 1);
-    GlTexture activated_texture = helper_.CreateDestinationTexture(
-        input_width, input_height, activation_output_format);
-    helper_.BindFramebuffer(activated_texture);
-
     // All our input source textures will be just simple GL_TEXTURE_2D types.
     glActiveTexture(GL_TEXTURE1);
 
 #ifdef TASK_SEGMENTATION_USE_GLES_31_POSTPROCESSING
-    glBindTexture(GL_TEXTURE_2D, ssbo_tex_id);
+    const GLuint input_texture = ssbo_tex_id;
 #else
     const Tensor::OpenGlTexture2dView read_view =
         tensor.GetOpenGlTexture2dReadView();
-    glBindTexture(GL_TEXTURE_2D, read_view.name());
+    const GLuint input_texture = read_view.name();
 #endif  // TASK_SEGMENTATION_USE_GLES_31_POSTPROCESSING
 
-    // Render
-    glClear(GL_COLOR_BUFFER_BIT);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-    // Step 2: split megatexture into 4-chunks (assume kLayoutAligned for now).
+    // Step 1: split megatexture into 4-chunks (assume kLayoutAligned for now),
+    // applying the activation function along the way.
     std::vector<GlTexture> chunks;
     // # chunks: offset in pixels at which taps must be made
     // 1 chunk: 0
@@ -604,7 +770,7 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
       glUniform1f(split_x_offset_uniform_,
                   ((float)i + tex_offset) / (float)(input_width));
       // Technically duplicated, but fine for now; we want this after the bind
-      glBindTexture(GL_TEXTURE_2D, activated_texture.name());
+      glBindTexture(GL_TEXTURE_2D, input_texture);
       // Disable hardware GPU interpolation
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -615,7 +781,7 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
 
     std::vector<GlTexture> softmax_chunks;
     if (is_softmax) {
-      // Step 2.5: For SOFTMAX, apply softmax shaders (max, transformAndSum, and
+      // Step 2: For SOFTMAX, apply softmax shaders (max, transformAndSum, and
       // normalization) to create softmax-transformed chunks before channel
       // extraction.
       // NOTE: exp(x-C) / sum_over_x(exp(x-C)) = exp(x) / sum_over_x(exp(x)). So
@@ -738,7 +904,16 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
     }
 
     std::vector<GlTexture> outputs;
-    if (produce_confidence_masks) {
+    if (use_fused_output_) {
+      // Step 3 (fused): render all requested masks with one pass per chunk.
+      RenderFusedOutputs(chunks, is_softmax ? softmax_chunks : chunks,
+                         num_outputs, output_width, output_height,
+                         chunk_output_format, final_output_format,
+                         produce_confidence_masks, produce_category_mask,
+                         outputs);
+    }
+
+    if (produce_confidence_masks && !use_fused_output_) {
       // Step 3: For CONFIDENCE, apply channel-select repeatedly to extract
       // final textures.
       glUseProgram(channel_select_shader_.program);
@@ -762,7 +937,7 @@ SegmentationPostprocessorGl::GetSegmentationResultGpu(
       }
     }
 
-    if (produce_category_mask) {
+    if (produce_category_mask && !use_fused_output_) {
       // Step 4, N = 1: For CATEGORY with 1 class, use special FG/BG argmax
       // shader instead of our usual N-class system.
       if (num_outputs == 1) {
@@ -871,13 +1046,13 @@ SegmentationPostprocessorGl::~SegmentationPostprocessorGl() {
     square_vertices_ = 0;
     texture_vertices_ = 0;
 
-    glDeleteProgram(activation_shader_.program);
     glDeleteProgram(argmax_shader_.program);
     glDeleteProgram(argmax_one_class_shader_.program);
     glDeleteProgram(channel_select_shader_.program);
     glDeleteProgram(softmax_max_shader_.program);
     glDeleteProgram(softmax_transform_and_sum_shader_.program);
     glDeleteProgram(softmax_normalization_shader_.program);
+    glDeleteProgram(fused_output_shader_.program);
 
 #ifdef TASK_SEGMENTATION_USE_GLES_31_POSTPROCESSING
     ssbo_to_texture_converter_.Close();
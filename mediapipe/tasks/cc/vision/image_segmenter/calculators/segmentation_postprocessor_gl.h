@@ -53,6 +53,16 @@ class SegmentationPostprocessorGl {
   };
 
   absl::Status GlInit(const bool produce_confidence_masks);
+  // Renders all requested masks from the (activated, and possibly softmaxed)
+  // chunks with one MRT pass per chunk. Only used if `use_fused_output_`.
+  void RenderFusedOutputs(const std::vector<GlTexture>& chunks,
+                          const std::vector<GlTexture>& confidence_chunks,
+                          int num_outputs, int mask_width, int mask_height,
+                          GpuBufferFormat chunk_format,
+                          GpuBufferFormat output_format,
+                          bool produce_confidence_masks,
+                          bool produce_category_mask,
+                          std::vector<GlTexture>& outputs);
   bool HasGlExtension(std::string const& extension);
   absl::Status CreateBasicFragmentShaderProgram(
       std::string const& program_name,
@@ -64,20 +74,25 @@ class SegmentationPostprocessorGl {
   GlCalculatorHelper helper_;
 
   // GL references (programs, buffers, uniforms)
-  // Split program is special because it uses a custom vertex shader.
+  // Split program is special because it uses a custom vertex shader. It also
+  // applies the activation function while splitting.
   GLuint split_program_ = 0;
   GLuint square_vertices_ = 0;
   GLuint texture_vertices_ = 0;
   GLint split_texture_uniform_;
   GLint split_x_offset_uniform_;
 
-  GlShader activation_shader_;
   GlShader argmax_shader_;
   GlShader argmax_one_class_shader_;
   GlShader channel_select_shader_;
   GlShader softmax_max_shader_;
   GlShader softmax_transform_and_sum_shader_;
   GlShader softmax_normalization_shader_;
+  GlShader fused_output_shader_;
+
+  // Whether the GPU has enough draw buffers to write four confidence masks and
+  // the category mask state in a single pass.
+  bool use_fused_output_ = false;
 
 #ifdef TASK_SEGMENTATION_USE_GLES_31_POSTPROCESSING
   SsboToTextureConverter ssbo_to_texture_converter_;
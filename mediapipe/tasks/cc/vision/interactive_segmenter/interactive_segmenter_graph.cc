@@ -18,6 +18,7 @@ limitations under the License.
 
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "mediapipe/calculators/image/image_transformation_calculator.pb.h"
 #include "mediapipe/calculators/util/flat_color_image_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/api2/node.h"
@@ -81,6 +82,40 @@ MEDIAPIPE_REGISTER_NODE(
 // clang-format on
 // NOLINTEND
 
+// A calculator that forwards the input image only when it differs from the
+// previously received one, so that image-level preprocessing downstream runs
+// once per image rather than once per region of interest. Images are compared
+// by identity of their underlying buffer; the last image is held so that its
+// buffer cannot be reused for a different image while it is still cached.
+class DropRepeatedImageCalculator : public api2::Node {
+ public:
+  static constexpr api2::Input<Image> kImageIn{"IMAGE"};
+  static constexpr api2::Output<Image> kImageOut{"IMAGE"};
+
+  MEDIAPIPE_NODE_CONTRACT(kImageIn, kImageOut);
+
+  absl::Status Process(CalculatorContext* cc) final {
+    const Image& image = kImageIn(cc).Get();
+    if (last_image_ != nullptr && image == last_image_) {
+      return absl::OkStatus();
+    }
+    last_image_ = image;
+    kImageOut(cc).Send(kImageIn(cc).packet());
+    return absl::OkStatus();
+  }
+
+ private:
+  Image last_image_;
+};
+
+// NOLINTBEGIN: Node registration doesn't work when part of calculator name is
+// moved to next line.
+// clang-format off
+MEDIAPIPE_REGISTER_NODE(
+    ::mediapipe::tasks::vision::interactive_segmenter::internal::DropRepeatedImageCalculator);
+// clang-format on
+// NOLINTEND
+
 }  // namespace internal
 
 namespace {
@@ -107,6 +142,9 @@ constexpr absl::string_view kNormRectTag{"NORM_RECT"};
 constexpr absl::string_view kRoiTag{"ROI"};
 constexpr absl::string_view kQualityScoresTag{"QUALITY_SCORES"};
 constexpr absl::string_view kRenderDataTag{"RENDER_DATA"};
+constexpr absl::string_view kTickTag{"TICK"};
+constexpr absl::string_view kSizeTag{"SIZE"};
+constexpr absl::string_view kOutputSizeTag{"OUTPUT_SIZE"};
 
 // Updates the graph to return `roi` stream which has same dimension as
 // `image`, and rendered with `roi`. If `use_gpu` is true, returned `Source` is
@@ -177,7 +215,7 @@ Source<> RoiToAlpha(Source<Image> image, Source<RenderData> roi, bool use_gpu,
 //   CATEGORY_MASK - mediapipe::Image @Optional
 //     Optional Category mask.
 //   IMAGE - mediapipe::Image
-//     The image that image segmenter runs on.
+//     The image that interactive segmenter runs on.
 //
 // Example:
 // node {
@@ -216,28 +254,67 @@ class InteractiveSegmenterGraph : public core::ModelTaskGraph {
     const absl::string_view alpha_tag_with_suffix =
         use_gpu ? kAlphaGpuTag : kAlphaTag;
 
+    // Image-level preprocessing only depends on the image, so it is done once
+    // per image and the result is reused for every region of interest on it.
+    auto& drop_repeated_image = graph.AddNode(
+        "mediapipe::tasks::vision::interactive_segmenter::internal::"
+        "DropRepeatedImageCalculator");
+    image >> drop_repeated_image.In(kImageTag);
+    auto new_image = drop_repeated_image.Out(kImageTag);
+
     auto& from_mp_image = graph.AddNode("FromImageCalculator");
-    image >> from_mp_image.In(kImageTag);
-    auto image_in_cpu_or_gpu = from_mp_image.Out(image_tag_with_suffix);
+    new_image >> from_mp_image.In(kImageTag);
+    auto new_image_in_cpu_or_gpu = from_mp_image.Out(image_tag_with_suffix);
+
+    // Downscales the image to the model input size, so that the per-ROI work
+    // below runs at model resolution rather than at the input resolution.
+    auto& image_transformation = graph.AddNode("ImageTransformationCalculator");
+    auto& image_transformation_options =
+        image_transformation
+            .GetOptions<mediapipe::ImageTransformationCalculatorOptions>();
+    image_transformation_options.set_output_width(
+        internal::AddThicknessToRenderDataCalculator::kModelInputTensorWidth);
+    image_transformation_options.set_output_height(
+        internal::AddThicknessToRenderDataCalculator::kModelInputTensorHeight);
+    const absl::string_view image_or_image_gpu_tag =
+        use_gpu ? kImageGpuTag : kImageTag;
+    new_image_in_cpu_or_gpu >> image_transformation.In(image_or_image_gpu_tag);
+    auto resized_new_image = image_transformation.Out(image_or_image_gpu_tag);
+
+    // Replays the cached downscaled image for every region of interest.
+    auto& packet_cloner = graph.AddNode("PacketClonerCalculator");
+    resized_new_image >> packet_cloner.In("");
+    roi >> packet_cloner.In(kTickTag);
+    auto image_in_cpu_or_gpu = packet_cloner.Out("");
+
+    auto& to_resized_mp_image = graph.AddNode("ToImageCalculator");
+    image_in_cpu_or_gpu >> to_resized_mp_image.In(image_tag_with_suffix);
+    auto resized_image = to_resized_mp_image.Out(kImageTag).Cast<Image>();
 
     // Creates an RGBA image with model input tensor size.
-    auto alpha_in_cpu_or_gpu = RoiToAlpha(image, roi, use_gpu, graph);
+    auto alpha_in_cpu_or_gpu = RoiToAlpha(resized_image, roi, use_gpu, graph);
 
     auto& set_alpha = graph.AddNode("SetAlphaCalculator");
-    image_in_cpu_or_gpu >> set_alpha.In(use_gpu ? kImageGpuTag : kImageTag);
+    image_in_cpu_or_gpu >> set_alpha.In(image_or_image_gpu_tag);
     alpha_in_cpu_or_gpu >> set_alpha.In(alpha_tag_with_suffix);
     auto image_in_cpu_or_gpu_with_set_alpha =
-        set_alpha.Out(use_gpu ? kImageGpuTag : kImageTag);
+        set_alpha.Out(image_or_image_gpu_tag);
 
     auto& to_mp_image = graph.AddNode("ToImageCalculator");
     image_in_cpu_or_gpu_with_set_alpha >> to_mp_image.In(image_tag_with_suffix);
     auto image_with_set_alpha = to_mp_image.Out(kImageTag);
 
+    // The masks are still produced at the input image resolution.
+    auto& image_properties = graph.AddNode("ImagePropertiesCalculator");
+    image >> image_properties.In(kImageTag);
+    auto image_size = image_properties.Out(kSizeTag);
+
     auto& image_segmenter = graph.AddNode(
         "mediapipe.tasks.vision.image_segmenter.ImageSegmenterGraph");
     image_segmenter.GetOptions<ImageSegmenterGraphOptions>() = task_options;
     image_with_set_alpha >> image_segmenter.In(kImageTag);
     norm_rect >> image_segmenter.In(kNormRectTag);
+    image_size >> image_segmenter.In(kOutputSizeTag);
 
     // TODO: remove deprecated output type support.
     if (task_options.segmenter_options().has_output_type()) {
@@ -261,7 +338,7 @@ class InteractiveSegmenterGraph : public core::ModelTaskGraph {
     }
     image_segmenter.Out(kQualityScoresTag) >>
         graph[Output<std::vector<float>>::Optional(kQualityScoresTag)];
-    image_segmenter.Out(kImageTag) >> graph[Output<Image>(kImageTag)];
+    image >> graph[Output<Image>(kImageTag)];
 
     return graph.GetConfig();
   }
@@ -0,0 +1,157 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/tasks/cc/vision/object_detector/calculators/detection_tiles_calculator.pb.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace {
+
+using ::mediapipe::api2::Input;
+using ::mediapipe::api2::Node;
+using ::mediapipe::api2::Output;
+
+// Returns the normalized rect of the tile at `row` and `column` of the
+// region of interest `roi` of an image of size `image_width` x
+// `image_height`. Tiles are laid out in the frame of `roi` and share its
+// rotation.
+NormalizedRect GetTileRect(const DetectionTilesCalculatorOptions& options,
+                           const NormalizedRect& roi, int row, int column,
+                           int image_width, int image_height) {
+  const float overlap = options.overlap();
+  // Fractions of the region of interest covered by a tile, such that
+  // consecutive tiles overlap by `overlap` and the last ones end on the
+  // border of the region.
+  const float tile_width =
+      1.0f / (options.num_columns() - (options.num_columns() - 1) * overlap);
+  const float tile_height =
+      1.0f / (options.num_rows() - (options.num_rows() - 1) * overlap);
+  const float center_x = tile_width * (0.5f + column * (1.0f - overlap));
+  const float center_y = tile_height * (0.5f + row * (1.0f - overlap));
+
+  // Offset of the tile center from the region center, rotated in pixels like
+  // in RectTransformationCalculator.
+  const float offset_x = (center_x - 0.5f) * roi.width() * image_width;
+  const float offset_y = (center_y - 0.5f) * roi.height() * image_height;
+  const float rotation = roi.rotation();
+  NormalizedRect tile;
+  tile.set_x_center(roi.x_center() + (offset_x * std::cos(rotation) -
+                                      offset_y * std::sin(rotation)) /
+                                         image_width);
+  tile.set_y_center(roi.y_center() + (offset_x * std::sin(rotation) +
+                                      offset_y * std::cos(rotation)) /
+                                         image_height);
+  tile.set_width(tile_width * roi.width());
+  tile.set_height(tile_height * roi.height());
+  tile.set_rotation(rotation);
+  return tile;
+}
+
+}  // namespace
+
+// Splits the region of interest of an image into overlapping tiles, so that
+// object detection can run on each of them at the resolution of the model
+// input instead of on the whole downscaled image.
+//
+// Inputs:
+//   IMAGE - Image
+//     The image to split. Only its size is used.
+//   NORM_RECT - NormalizedRect @Optional
+//     The region of interest to split. The whole image if not specified.
+//
+// Outputs:
+//   TILES - std::vector<NormalizedRect>
+//     The tiles, row by row, preceded by the region of interest itself if
+//     include_full_image is set.
+//
+// Example:
+// node {
+//   calculator: "mediapipe.tasks.DetectionTilesCalculator"
+//   input_stream: "IMAGE:image"
+//   input_stream: "NORM_RECT:norm_rect"
+//   output_stream: "TILES:tiles"
+//   options {
+//     [mediapipe.tasks.DetectionTilesCalculatorOptions.ext] {
+//       num_rows: 2
+//       num_columns: 3
+//       overlap: 0.25
+//     }
+//   }
+// }
+class DetectionTilesCalculator : public Node {
+ public:
+  static constexpr Input<Image> kInImage{"IMAGE"};
+  static constexpr Input<NormalizedRect>::Optional kInNormRect{"NORM_RECT"};
+  static constexpr Output<std::vector<NormalizedRect>> kOutTiles{"TILES"};
+  MEDIAPIPE_NODE_CONTRACT(kInImage, kInNormRect, kOutTiles);
+
+  absl::Status Open(CalculatorContext* cc) override {
+    options_ = cc->Options<DetectionTilesCalculatorOptions>();
+    RET_CHECK_GE(options_.num_rows(), 1);
+    RET_CHECK_GE(options_.num_columns(), 1);
+    RET_CHECK(options_.overlap() >= 0.0f && options_.overlap() < 1.0f)
+        << "overlap must be in [0, 1), got " << options_.overlap();
+    return absl::OkStatus();
+  }
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (kInImage(cc).IsEmpty()) {
+      return absl::OkStatus();
+    }
+    const Image& image = *kInImage(cc);
+    NormalizedRect roi;
+    if (!kInNormRect(cc).IsEmpty()) {
+      roi = *kInNormRect(cc);
+    } else {
+      roi.set_x_center(0.5f);
+      roi.set_y_center(0.5f);
+      roi.set_width(1.0f);
+      roi.set_height(1.0f);
+    }
+
+    std::vector<NormalizedRect> tiles;
+    tiles.reserve(options_.num_rows() * options_.num_columns() + 1);
+    if (options_.include_full_image()) {
+      tiles.push_back(roi);
+    }
+    for (int row = 0; row < options_.num_rows(); ++row) {
+      for (int column = 0; column < options_.num_columns(); ++column) {
+        tiles.push_back(GetTileRect(options_, roi, row, column, image.width(),
+                                    image.height()));
+      }
+    }
+    kOutTiles(cc).Send(std::move(tiles));
+    return absl::OkStatus();
+  }
+
+ private:
+  DetectionTilesCalculatorOptions options_;
+};
+
+MEDIAPIPE_REGISTER_NODE(::mediapipe::tasks::DetectionTilesCalculator);
+
+}  // namespace tasks
+}  // namespace mediapipe
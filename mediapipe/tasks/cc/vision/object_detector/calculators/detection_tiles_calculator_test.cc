@@ -0,0 +1,180 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/calculator_runner.h"
+#include "mediapipe/framework/formats/image.h"
+#include "mediapipe/framework/formats/image_frame.h"
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/framework/port/status_matchers.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::Not;
+
+constexpr char kNodeConfig[] = R"pb(
+  calculator: "mediapipe.tasks.DetectionTilesCalculator"
+  input_stream: "IMAGE:image"
+  input_stream: "NORM_RECT:norm_rect"
+  output_stream: "TILES:tiles"
+  options {
+    [mediapipe.tasks.DetectionTilesCalculatorOptions.ext] {
+      num_rows: 2
+      num_columns: 3
+      overlap: 0.25
+      include_full_image: true
+    }
+  }
+)pb";
+
+Image MakeImage(int width, int height) {
+  return Image(std::make_shared<ImageFrame>(ImageFormat::SRGB, width, height));
+}
+
+NormalizedRect MakeRect(float x_center, float y_center, float width,
+                        float height, float rotation) {
+  NormalizedRect rect;
+  rect.set_x_center(x_center);
+  rect.set_y_center(y_center);
+  rect.set_width(width);
+  rect.set_height(height);
+  rect.set_rotation(rotation);
+  return rect;
+}
+
+std::vector<NormalizedRect> RunCalculator(
+    CalculatorRunner& runner, const Image& image,
+    const NormalizedRect* norm_rect) {
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      MakePacket<Image>(image).At(Timestamp(0)));
+  if (norm_rect != nullptr) {
+    runner.MutableInputs()->Tag("NORM_RECT").packets.push_back(
+        MakePacket<NormalizedRect>(*norm_rect).At(Timestamp(0)));
+  }
+  MP_EXPECT_OK(runner.Run());
+  const auto& packets = runner.Outputs().Tag("TILES").packets;
+  EXPECT_EQ(packets.size(), 1);
+  return packets.empty() ? std::vector<NormalizedRect>()
+                         : packets[0].Get<std::vector<NormalizedRect>>();
+}
+
+void ExpectRectNear(const NormalizedRect& actual,
+                    const NormalizedRect& expected) {
+  constexpr float kTolerance = 1e-5f;
+  EXPECT_NEAR(actual.x_center(), expected.x_center(), kTolerance);
+  EXPECT_NEAR(actual.y_center(), expected.y_center(), kTolerance);
+  EXPECT_NEAR(actual.width(), expected.width(), kTolerance);
+  EXPECT_NEAR(actual.height(), expected.height(), kTolerance);
+  EXPECT_NEAR(actual.rotation(), expected.rotation(), kTolerance);
+}
+
+TEST(DetectionTilesCalculatorTest, SplitsWholeImageIntoOverlappingTiles) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      R"pb(
+        calculator: "mediapipe.tasks.DetectionTilesCalculator"
+        input_stream: "IMAGE:image"
+        output_stream: "TILES:tiles"
+        options {
+          [mediapipe.tasks.DetectionTilesCalculatorOptions.ext] {
+            num_rows: 1
+            num_columns: 3
+            overlap: 0.25
+            include_full_image: false
+          }
+        }
+      )pb"));
+  std::vector<NormalizedRect> tiles =
+      RunCalculator(runner, MakeImage(400, 100), nullptr);
+
+  // Tiles of width 1 / (3 - 2 * 0.25) = 0.4, starting every 0.3.
+  ASSERT_EQ(tiles.size(), 3);
+  ExpectRectNear(tiles[0], MakeRect(0.2f, 0.5f, 0.4f, 1.0f, 0.0f));
+  ExpectRectNear(tiles[1], MakeRect(0.5f, 0.5f, 0.4f, 1.0f, 0.0f));
+  ExpectRectNear(tiles[2], MakeRect(0.8f, 0.5f, 0.4f, 1.0f, 0.0f));
+}
+
+TEST(DetectionTilesCalculatorTest, SplitsRegionOfInterest) {
+  CalculatorRunner runner(
+      ParseTextProtoOrDie<CalculatorGraphConfig::Node>(kNodeConfig));
+  const NormalizedRect roi = MakeRect(0.5f, 0.4f, 0.5f, 0.6f, 0.0f);
+  std::vector<NormalizedRect> tiles =
+      RunCalculator(runner, MakeImage(400, 100), &roi);
+
+  // The region of interest itself, then 2 rows of 3 tiles.
+  ASSERT_EQ(tiles.size(), 7);
+  ExpectRectNear(tiles[0], roi);
+  const float tile_width = 0.4f * 0.5f;
+  const float tile_height = 0.6f / 1.75f;
+  ExpectRectNear(tiles[1], MakeRect(0.25f + 0.1f, 0.1f + tile_height / 2,
+                                    tile_width, tile_height, 0.0f));
+  ExpectRectNear(tiles[6], MakeRect(0.75f - 0.1f, 0.7f - tile_height / 2,
+                                    tile_width, tile_height, 0.0f));
+}
+
+TEST(DetectionTilesCalculatorTest, RotatesTilesWithRegionOfInterest) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      R"pb(
+        calculator: "mediapipe.tasks.DetectionTilesCalculator"
+        input_stream: "IMAGE:image"
+        input_stream: "NORM_RECT:norm_rect"
+        output_stream: "TILES:tiles"
+        options {
+          [mediapipe.tasks.DetectionTilesCalculatorOptions.ext] {
+            num_rows: 1
+            num_columns: 2
+            overlap: 0
+            include_full_image: false
+          }
+        }
+      )pb"));
+  // A 200x100 pixels region rotated by 90 degrees in a 400x200 image: its
+  // columns are stacked vertically in the image.
+  const NormalizedRect roi = MakeRect(0.5f, 0.5f, 0.5f, 0.5f, M_PI / 2);
+  std::vector<NormalizedRect> tiles =
+      RunCalculator(runner, MakeImage(400, 200), &roi);
+
+  ASSERT_EQ(tiles.size(), 2);
+  ExpectRectNear(tiles[0], MakeRect(0.5f, 0.25f, 0.25f, 0.5f, M_PI / 2));
+  ExpectRectNear(tiles[1], MakeRect(0.5f, 0.75f, 0.25f, 0.5f, M_PI / 2));
+}
+
+TEST(DetectionTilesCalculatorTest, FailsWithInvalidOverlap) {
+  CalculatorRunner runner(ParseTextProtoOrDie<CalculatorGraphConfig::Node>(
+      R"pb(
+        calculator: "mediapipe.tasks.DetectionTilesCalculator"
+        input_stream: "IMAGE:image"
+        output_stream: "TILES:tiles"
+        options {
+          [mediapipe.tasks.DetectionTilesCalculatorOptions.ext] {
+            num_columns: 2
+            overlap: 1
+          }
+        }
+      )pb"));
+  runner.MutableInputs()->Tag("IMAGE").packets.push_back(
+      MakePacket<Image>(MakeImage(10, 10)).At(Timestamp(0)));
+  EXPECT_THAT(runner.Run(), Not(IsOk()));
+}
+
+}  // namespace
+}  // namespace mediapipe
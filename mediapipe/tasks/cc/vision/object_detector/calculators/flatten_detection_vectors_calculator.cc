@@ -0,0 +1,69 @@
+/* Copyright 2026 The MediaPipe Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "mediapipe/framework/api2/node.h"
+#include "mediapipe/framework/api2/port.h"
+#include "mediapipe/framework/calculator_framework.h"
+#include "mediapipe/framework/formats/detection.pb.h"
+
+namespace mediapipe {
+namespace tasks {
+namespace {
+using ::mediapipe::api2::Input;
+using ::mediapipe::api2::Node;
+using ::mediapipe::api2::Output;
+}  // namespace
+
+// Concatenates the detections collected by an EndLoopDetectionVectorCalculator,
+// e.g. the detections found on each tile of an image, into a single vector.
+//
+// Inputs:
+//   No tag - std::vector<std::vector<Detection>>
+//
+// Outputs:
+//   No tag - std::vector<Detection>
+class FlattenDetectionVectorsCalculator : public Node {
+ public:
+  static constexpr Input<std::vector<std::vector<Detection>>> kIn{""};
+  static constexpr Output<std::vector<Detection>> kOut{""};
+  MEDIAPIPE_NODE_CONTRACT(kIn, kOut);
+
+  absl::Status Process(CalculatorContext* cc) override {
+    if (kIn(cc).IsEmpty()) {
+      return absl::OkStatus();
+    }
+    const auto& detection_vectors = *kIn(cc);
+    int size = 0;
+    for (const auto& detections : detection_vectors) {
+      size += detections.size();
+    }
+    std::vector<Detection> flattened;
+    flattened.reserve(size);
+    for (const auto& detections : detection_vectors) {
+      flattened.insert(flattened.end(), detections.begin(), detections.end());
+    }
+    kOut(cc).Send(std::move(flattened));
+    return absl::OkStatus();
+  }
+};
+
+MEDIAPIPE_REGISTER_NODE(::mediapipe::tasks::FlattenDetectionVectorsCalculator);
+
+}  // namespace tasks
+}  // namespace mediapipe
@@ -107,6 +107,12 @@ std::unique_ptr<ObjectDetectorOptionsProto> ConvertObjectDetectorOptionsToProto(
   for (const std::string& category : options->category_denylist) {
     options_proto->add_category_denylist(category);
   }
+  auto* tiling_options = options_proto->mutable_tiling_options();
+  tiling_options->set_num_rows(options->tiling_options.num_rows);
+  tiling_options->set_num_columns(options->tiling_options.num_columns);
+  tiling_options->set_overlap(options->tiling_options.overlap);
+  tiling_options->set_include_full_image(
+      options->tiling_options.include_full_image);
   return options_proto;
 }
 
@@ -81,6 +81,26 @@ struct ObjectDetectorOptions {
   // category names are ignored. Mutually exclusive with category_allowlist.
   std::vector<std::string> category_denylist = {};
 
+  // Options to run detection on overlapping tiles of the image, or of the
+  // region of interest set in ImageProcessingOptions, instead of on the whole
+  // image downscaled to the model input size. Small objects in
+  // high-resolution images can then be detected, at the cost of one inference
+  // per tile.
+  struct TilingOptions {
+    // Number of rows and columns of tiles. Tiling is disabled if both are 1.
+    int num_rows = 1;
+    int num_columns = 1;
+
+    // Fraction of the width (resp. height) of a tile that overlaps with the
+    // next tile in the row (resp. column). Must be in [0, 1).
+    float overlap = 0.2f;
+
+    // Whether detection also runs on the whole image, to detect the objects
+    // that are too large to fit in a single tile.
+    bool include_full_image = true;
+  };
+  TilingOptions tiling_options;
+
   // The user-defined result callback for processing live stream data.
   // The result callback should only be specified when the running mode is set
   // to RunningMode::LIVE_STREAM.
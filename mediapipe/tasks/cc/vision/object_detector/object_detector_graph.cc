@@ -13,10 +13,13 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "mediapipe/calculators/util/non_max_suppression_calculator.pb.h"
 #include "mediapipe/framework/api2/builder.h"
 #include "mediapipe/framework/api2/port.h"
 #include "mediapipe/framework/calculator.pb.h"
@@ -24,6 +27,7 @@ limitations under the License.
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/formats/tensor.h"
+#include "mediapipe/framework/timestamp.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/components/processors/detection_postprocessing_graph.h"
 #include "mediapipe/tasks/cc/components/processors/image_preprocessing_graph.h"
@@ -32,6 +36,7 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/model_resources.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/proto/inference_subgraph.pb.h"
+#include "mediapipe/tasks/cc/vision/object_detector/calculators/detection_tiles_calculator.pb.h"
 #include "mediapipe/tasks/cc/vision/object_detector/proto/object_detector_options.pb.h"
 #include "mediapipe/tasks/metadata/metadata_schema_generated.h"
 
@@ -51,14 +56,20 @@ using ObjectDetectorOptionsProto =
 using TensorsSource =
     mediapipe::api2::builder::Source<std::vector<mediapipe::Tensor>>;
 
+constexpr char kBatchEndTag[] = "BATCH_END";
+constexpr char kCloneTag[] = "CLONE";
 constexpr char kDetectionsTag[] = "DETECTIONS";
 constexpr char kImageSizeTag[] = "IMAGE_SIZE";
 constexpr char kImageTag[] = "IMAGE";
+constexpr char kItemTag[] = "ITEM";
+constexpr char kIterableTag[] = "ITERABLE";
 constexpr char kMatrixTag[] = "MATRIX";
 constexpr char kNormRectTag[] = "NORM_RECT";
 constexpr char kPixelDetectionsTag[] = "PIXEL_DETECTIONS";
 constexpr char kProjectionMatrixTag[] = "PROJECTION_MATRIX";
+constexpr char kSizeTag[] = "SIZE";
 constexpr char kTensorTag[] = "TENSORS";
+constexpr char kTilesTag[] = "TILES";
 
 // Struct holding the different output streams produced by the object detection
 // subgraph.
@@ -82,9 +93,28 @@ absl::Status SanityCheckOptions(const ObjectDetectorOptionsProto& options) {
         "exclusive options.",
         MediaPipeTasksStatus::kInvalidArgumentError);
   }
+  const auto& tiling_options = options.tiling_options();
+  if (tiling_options.num_rows() < 1 || tiling_options.num_columns() < 1) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "Invalid `tiling_options`: `num_rows` and `num_columns` must be >= 1",
+        MediaPipeTasksStatus::kInvalidArgumentError);
+  }
+  if (tiling_options.overlap() < 0.0f || tiling_options.overlap() >= 1.0f) {
+    return CreateStatusWithPayload(
+        absl::StatusCode::kInvalidArgument,
+        "Invalid `tiling_options`: `overlap` must be in [0, 1)",
+        MediaPipeTasksStatus::kInvalidArgumentError);
+  }
   return absl::OkStatus();
 }
 
+bool UsesTiling(const ObjectDetectorOptionsProto& options) {
+  return options.tiling_options().num_rows() *
+             options.tiling_options().num_columns() >
+         1;
+}
+
 }  // namespace
 
 // A "mediapipe.tasks.vision.ObjectDetectorGraph" performs object detection.
@@ -106,6 +136,12 @@ absl::Status SanityCheckOptions(const ObjectDetectorOptionsProto& options) {
 // All returned coordinates are in the unrotated and uncropped input image
 // coordinates system.
 //
+// If tiling_options split the image in several tiles, the region of interest
+// is split into overlapping tiles, which go one after the other through the
+// same preprocessing, inference and postprocessing nodes. The detections of
+// all tiles are then projected back to the image and merged with a
+// non-maximum suppression configured by ConfigureTiledDetectionsMerging().
+//
 // Example:
 // node {
 //   calculator: "mediapipe.tasks.vision.ObjectDetectorGraph"
@@ -184,6 +220,31 @@ class ObjectDetectorGraph : public core::ModelTaskGraph {
           MediaPipeTasksStatus::kMetadataNotFoundError);
     }
 
+    // Splits the region of interest into tiles, and iterates over them with
+    // the input image.
+    Source<Image> detection_image_in = image_in;
+    Source<NormalizedRect> detection_rect_in = norm_rect_in;
+    std::optional<Source<Timestamp>> batch_end;
+    if (UsesTiling(task_options)) {
+      const auto& tiling_options = task_options.tiling_options();
+      auto& tiles = graph.AddNode("mediapipe.tasks.DetectionTilesCalculator");
+      auto& tiles_options = tiles.GetOptions<DetectionTilesCalculatorOptions>();
+      tiles_options.set_num_rows(tiling_options.num_rows());
+      tiles_options.set_num_columns(tiling_options.num_columns());
+      tiles_options.set_overlap(tiling_options.overlap());
+      tiles_options.set_include_full_image(
+          tiling_options.include_full_image());
+      image_in >> tiles.In(kImageTag);
+      norm_rect_in >> tiles.In(kNormRectTag);
+
+      auto& begin_loop = graph.AddNode("BeginLoopNormalizedRectCalculator");
+      tiles.Out(kTilesTag) >> begin_loop.In(kIterableTag);
+      image_in >> begin_loop.In(kCloneTag);
+      detection_image_in = begin_loop.Out(kCloneTag).Cast<Image>();
+      detection_rect_in = begin_loop.Out(kItemTag).Cast<NormalizedRect>();
+      batch_end = begin_loop.Out(kBatchEndTag).Cast<Timestamp>();
+    }
+
     // Adds preprocessing calculators and connects them to the graph input image
     // stream.
     auto& preprocessing = graph.AddNode(
@@ -195,8 +256,8 @@ class ObjectDetectorGraph : public core::ModelTaskGraph {
         model_resources, use_gpu, task_options.base_options().gpu_origin(),
         &preprocessing.GetOptions<tasks::components::processors::proto::
                                       ImagePreprocessingGraphOptions>()));
-    image_in >> preprocessing.In(kImageTag);
-    norm_rect_in >> preprocessing.In(kNormRectTag);
+    detection_image_in >> preprocessing.In(kImageTag);
+    detection_rect_in >> preprocessing.In(kNormRectTag);
 
     // Adds inference subgraph and connects its input stream to the output
     // tensors produced by the ImageToTensorCalculator.
@@ -235,15 +296,42 @@ class ObjectDetectorGraph : public core::ModelTaskGraph {
     detections >> detection_projection.In(kDetectionsTag);
     preprocessing.Out(kMatrixTag) >>
         detection_projection.In(kProjectionMatrixTag);
+    Source<std::vector<Detection>> projected_detections =
+        detection_projection.Out(kDetectionsTag).Cast<std::vector<Detection>>();
+    Source<std::pair<int, int>> image_size =
+        preprocessing.Out(kImageSizeTag).Cast<std::pair<int, int>>();
+    Source<Image> image_out = preprocessing[Output<Image>(kImageTag)];
+
+    if (batch_end.has_value()) {
+      // Collects the detections of all tiles, now in the image coordinates,
+      // and merges the ones found on several tiles.
+      auto& end_loop = graph.AddNode("EndLoopDetectionVectorCalculator");
+      *batch_end >> end_loop.In(kBatchEndTag);
+      projected_detections >> end_loop.In(kItemTag);
+      auto& flatten =
+          graph.AddNode("mediapipe.tasks.FlattenDetectionVectorsCalculator");
+      end_loop.Out(kIterableTag) >> flatten.In("");
+      auto& merging = graph.AddNode("NonMaxSuppressionCalculator");
+      components::processors::ConfigureTiledDetectionsMerging(
+          detector_options,
+          merging.GetOptions<mediapipe::NonMaxSuppressionCalculatorOptions>());
+      flatten.Out("") >> merging.In("");
+      projected_detections = merging.Out("").Cast<std::vector<Detection>>();
+
+      // The per-tile image outputs of the preprocessing are replaced by the
+      // input image and its size.
+      auto& image_properties = graph.AddNode("ImagePropertiesCalculator");
+      image_in >> image_properties.In(kImageTag);
+      image_size = image_properties.Out(kSizeTag).Cast<std::pair<int, int>>();
+      image_out = image_in;
+    }
 
     // Calculator to convert relative detection bounding boxes to pixel
     // detection bounding boxes.
     auto& detection_transformation =
         graph.AddNode("DetectionTransformationCalculator");
-    detection_projection.Out(kDetectionsTag) >>
-        detection_transformation.In(kDetectionsTag);
-    preprocessing.Out(kImageSizeTag) >>
-        detection_transformation.In(kImageSizeTag);
+    projected_detections >> detection_transformation.In(kDetectionsTag);
+    image_size >> detection_transformation.In(kImageSizeTag);
     auto detections_in_pixel =
         detection_transformation.Out(kPixelDetectionsTag);
 
@@ -257,7 +345,7 @@ class ObjectDetectorGraph : public core::ModelTaskGraph {
     return {{
         /* detections= */
         detections_deduplicate[Output<std::vector<Detection>>("")],
-        /* image= */ preprocessing[Output<Image>(kImageTag)],
+        /* image= */ image_out,
     }};
   }
 };
@@ -32,7 +32,6 @@ limitations under the License.
 #include "mediapipe/tasks/cc/core/model_resources_cache.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/core/utils.h"
-#include "mediapipe/tasks/cc/metadata/utils/zip_utils.h"
 #include "mediapipe/tasks/cc/vision/pose_detector/proto/pose_detector_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/pose_landmarker/proto/pose_landmarker_graph_options.pb.h"
 #include "mediapipe/tasks/cc/vision/pose_landmarker/proto/pose_landmarks_detector_graph_options.pb.h"
@@ -53,7 +52,6 @@ using ::mediapipe::api2::builder::SidePacket;
 using ::mediapipe::api2::builder::Source;
 using ::mediapipe::tasks::components::utils::DisallowIf;
 using ::mediapipe::tasks::core::ModelAssetBundleResources;
-using ::mediapipe::tasks::metadata::SetExternalFile;
 using ::mediapipe::tasks::vision::pose_detector::proto::
     PoseDetectorGraphOptions;
 using ::mediapipe::tasks::vision::pose_landmarker::proto::
@@ -96,12 +94,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
   auto* pose_detector_graph_options =
       options->mutable_pose_detector_graph_options();
   if (!pose_detector_graph_options->base_options().has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto pose_detector_file,
-                        resources.GetFile(kPoseDetectorTFLiteName));
-    SetExternalFile(pose_detector_file,
-                    pose_detector_graph_options->mutable_base_options()
-                        ->mutable_model_asset(),
-                    is_copy);
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kPoseDetectorTFLiteName,
+        pose_detector_graph_options->mutable_base_options()
+            ->mutable_model_asset(),
+        is_copy));
   }
   if (options->base_options().acceleration().has_gpu()) {
     core::proto::Acceleration gpu_accel;
@@ -121,13 +118,11 @@ absl::Status SetSubTaskBaseOptions(const ModelAssetBundleResources& resources,
       options->mutable_pose_landmarks_detector_graph_options();
   if (!pose_landmarks_detector_graph_options->base_options()
            .has_model_asset()) {
-    MP_ASSIGN_OR_RETURN(const auto pose_landmarks_detector_file,
-                        resources.GetFile(kPoseLandmarksDetectorTFLiteName));
-    SetExternalFile(
-        pose_landmarks_detector_file,
+    MP_RETURN_IF_ERROR(resources.SetExternalFile(
+        kPoseLandmarksDetectorTFLiteName,
         pose_landmarks_detector_graph_options->mutable_base_options()
             ->mutable_model_asset(),
-        is_copy);
+        is_copy));
   }
   pose_landmarks_detector_graph_options->mutable_base_options()
       ->mutable_acceleration()
@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <array>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -20,6 +21,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "mediapipe/calculators/core/constant_side_packet_calculator.pb.h"
 #include "mediapipe/calculators/core/split_vector_calculator.pb.h"
+#include "mediapipe/calculators/image/image_clone_calculator.pb.h"
 #include "mediapipe/calculators/image/warp_affine_calculator.pb.h"
 #include "mediapipe/calculators/tensor/image_to_tensor_calculator.pb.h"
 #include "mediapipe/calculators/tensor/tensors_to_landmarks_calculator.pb.h"
@@ -37,10 +39,12 @@ limitations under the License.
 #include "mediapipe/framework/formats/image.h"
 #include "mediapipe/framework/formats/landmark.pb.h"
 #include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/formats/tensor.h"
 #include "mediapipe/framework/subgraph.h"
 #include "mediapipe/gpu/gpu_origin.pb.h"
 #include "mediapipe/tasks/cc/common.h"
 #include "mediapipe/tasks/cc/components/processors/image_preprocessing_graph.h"
+#include "mediapipe/tasks/cc/components/processors/proto/image_preprocessing_graph_options.pb.h"
 #include "mediapipe/tasks/cc/core/model_resources.h"
 #include "mediapipe/tasks/cc/core/model_task_graph.h"
 #include "mediapipe/tasks/cc/vision/pose_landmarker/proto/pose_landmarks_detector_graph_options.pb.h"
@@ -67,6 +71,7 @@ using ::mediapipe::tasks::vision::pose_landmarker::proto::
 
 constexpr char kImageTag[] = "IMAGE";
 constexpr char kNormRectTag[] = "NORM_RECT";
+constexpr char kNormRectsTag[] = "NORM_RECTS";
 constexpr char kLandmarksTag[] = "LANDMARKS";
 constexpr char kNormLandmarksTag[] = "NORM_LANDMARKS";
 constexpr char kWorldLandmarksTag[] = "WORLD_LANDMARKS";
@@ -88,7 +93,9 @@ constexpr char kBatchEndTag[] = "BATCH_END";
 constexpr char kItemTag[] = "ITEM";
 constexpr char kIterableTag[] = "ITERABLE";
 constexpr char kLetterboxPaddingTag[] = "LETTERBOX_PADDING";
+constexpr char kLetterboxPaddingsTag[] = "LETTERBOX_PADDINGS";
 constexpr char kMatrixTag[] = "MATRIX";
+constexpr char kMatricesTag[] = "MATRICES";
 constexpr char kOutputSizeTag[] = "OUTPUT_SIZE";
 
 constexpr int kModelOutputTensorSplitNum = 5;
@@ -241,6 +248,250 @@ Stream<int> CreateIntConstantStream(Stream<TickT> tick_stream, int constant_int,
   return side_packet_to_stream.Out("AT_TICK").Cast<int>();
 }
 
+// Decodes the landmarks model output tensors of a single pose. `pose_rect`,
+// `matrix` and `letterbox_padding` describe how the pose RoI was cropped into
+// the model input, and `image_size` is the size of the input image.
+SinglePoseLandmarkerOutputs BuildPoseLandmarksPostprocessing(
+    const PoseLandmarksDetectorGraphOptions& subgraph_options,
+    const ImageTensorSpecs& image_tensor_specs,
+    Source<std::vector<Tensor>> tensors, Source<NormalizedRect> pose_rect,
+    Source<std::array<float, 16>> matrix,
+    Source<std::array<float, 4>> letterbox_padding,
+    Source<std::pair<int, int>> image_size, Graph& graph,
+    bool output_segmentation_mask) {
+  // Split model output tensors to multiple streams.
+  auto& split_tensors_vector = graph.AddNode("SplitTensorVectorCalculator");
+  ConfigureSplitTensorVectorCalculator(
+      &split_tensors_vector
+           .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
+  tensors >> split_tensors_vector.In("");
+  auto landmark_tensors = split_tensors_vector.Out(0);
+  auto pose_flag_tensors = split_tensors_vector.Out(1);
+  auto segmentation_tensors = split_tensors_vector.Out(2);
+  auto heatmap_tensors = split_tensors_vector.Out(3);
+  auto world_landmark_tensors = split_tensors_vector.Out(4);
+
+  // With GPU inference, starts reading back the tensors that are decoded on
+  // the CPU as soon as inference is done. The transfer then overlaps with the
+  // remaining GPU work (segmentation, the next frame's preprocessing) instead
+  // of blocking the first CPU consumer. The segmentation tensor stays on GPU.
+  if (subgraph_options.base_options().acceleration().has_gpu()) {
+    auto start_readback = [&graph](Source<> tensors) -> Source<> {
+      auto& readback = graph.AddNode("TensorsReadbackCalculator");
+      tensors >> readback.In(kTensorsTag);
+      return readback.Out(kTensorsTag)[0];
+    };
+    landmark_tensors = start_readback(landmark_tensors);
+    pose_flag_tensors = start_readback(pose_flag_tensors);
+    heatmap_tensors = start_readback(heatmap_tensors);
+    world_landmark_tensors = start_readback(world_landmark_tensors);
+  }
+
+  // Converts the pose-flag tensor into a float that represents the confidence
+  // score of pose presence.
+  auto& tensors_to_pose_presence = graph.AddNode("TensorsToFloatsCalculator");
+  pose_flag_tensors >> tensors_to_pose_presence.In(kTensorsTag);
+  auto pose_presence_score = tensors_to_pose_presence[Output<float>(kFloatTag)];
+
+  // Applies a threshold to the confidence score to determine whether a
+  // pose is present.
+  auto& pose_presence_thresholding = graph.AddNode("ThresholdingCalculator");
+  pose_presence_thresholding
+      .GetOptions<mediapipe::ThresholdingCalculatorOptions>()
+      .set_threshold(subgraph_options.min_detection_confidence());
+  pose_presence_score >> pose_presence_thresholding.In(kFloatTag);
+  auto pose_presence = pose_presence_thresholding[Output<bool>(kFlagTag)];
+
+  // GateCalculator for tensors.
+  auto& tensors_gate = graph.AddNode("GateCalculator");
+  landmark_tensors >> tensors_gate.In("")[0];
+  segmentation_tensors >> tensors_gate.In("")[1];
+  heatmap_tensors >> tensors_gate.In("")[2];
+  world_landmark_tensors >> tensors_gate.In("")[3];
+  pose_presence >> tensors_gate.In("ALLOW");
+  auto ensured_landmarks_tensors = tensors_gate.Out(0);
+  auto ensured_segmentation_tensors = tensors_gate.Out(1);
+  auto ensured_heatmap_tensors = tensors_gate.Out(2);
+  auto ensured_world_landmark_tensors = tensors_gate.Out(3);
+
+  // Decodes the landmark tensors into a list of landmarks, where the landmark
+  // coordinates are normalized by the size of the input image to the model.
+  auto& tensors_to_landmarks = graph.AddNode("TensorsToLandmarksCalculator");
+  ConfigureTensorsToLandmarksCalculator(
+      image_tensor_specs, /* normalize = */ false,
+      /*sigmoid_activation= */ true,
+      &tensors_to_landmarks
+           .GetOptions<mediapipe::TensorsToLandmarksCalculatorOptions>());
+  ensured_landmarks_tensors >> tensors_to_landmarks.In(kTensorsTag);
+
+  auto raw_landmarks =
+      tensors_to_landmarks[Output<NormalizedLandmarkList>(kNormLandmarksTag)];
+
+  // Refines landmarks with the heatmap tensor.
+  auto& refine_landmarks_from_heatmap =
+      graph.AddNode("RefineLandmarksFromHeatmapCalculator");
+  ConfigureRefineLandmarksFromHeatmapCalculator(
+      &refine_landmarks_from_heatmap.GetOptions<
+          mediapipe::RefineLandmarksFromHeatmapCalculatorOptions>());
+  ensured_heatmap_tensors >> refine_landmarks_from_heatmap.In(kTensorsTag);
+  raw_landmarks >> refine_landmarks_from_heatmap.In(kNormLandmarksTag);
+  auto landmarks_from_heatmap =
+      refine_landmarks_from_heatmap[Output<NormalizedLandmarkList>(
+          kNormLandmarksTag)];
+
+  // Splits the landmarks into two sets: the actual pose landmarks and the
+  // auxiliary landmarks.
+  auto& split_normalized_landmark_list =
+      graph.AddNode("SplitNormalizedLandmarkListCalculator");
+  ConfigureSplitNormalizedLandmarkListCalculator(
+      &split_normalized_landmark_list
+           .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
+  landmarks_from_heatmap >> split_normalized_landmark_list.In("");
+  auto landmarks = split_normalized_landmark_list.Out("")[0]
+                       .Cast<NormalizedLandmarkList>();
+  auto auxiliary_landmarks = split_normalized_landmark_list.Out("")[1]
+                                 .Cast<NormalizedLandmarkList>();
+
+  // Decodes the world-landmark tensors into a vector of world landmarks.
+  auto& tensors_to_world_landmarks =
+      graph.AddNode("TensorsToLandmarksCalculator");
+  ConfigureTensorsToLandmarksCalculator(
+      image_tensor_specs, /* normalize = */ false,
+      /* sigmoid_activation= */ false,
+      &tensors_to_world_landmarks
+           .GetOptions<mediapipe::TensorsToLandmarksCalculatorOptions>());
+  ensured_world_landmark_tensors >> tensors_to_world_landmarks.In(kTensorsTag);
+  auto raw_world_landmarks =
+      tensors_to_world_landmarks[Output<LandmarkList>(kLandmarksTag)];
+
+  // Keeps only the actual world landmarks.
+  auto& split_landmark_list = graph.AddNode("SplitLandmarkListCalculator");
+  ConfigureSplitLandmarkListCalculator(
+      &split_landmark_list
+           .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
+  raw_world_landmarks >> split_landmark_list.In("");
+  auto split_landmarks = split_landmark_list.Out(0);
+
+  // Reuses the visibility and presence field in pose landmarks for the world
+  // landmarks.
+  auto& visibility_copy = graph.AddNode("VisibilityCopyCalculator");
+  ConfigureVisibilityCopyCalculator(
+      &visibility_copy
+           .GetOptions<mediapipe::VisibilityCopyCalculatorOptions>());
+  split_landmarks >> visibility_copy.In(kLandmarksToTag);
+  landmarks >> visibility_copy.In(kNormLandmarksFromTag);
+  auto world_landmarks = visibility_copy[Output<LandmarkList>(kLandmarksToTag)];
+
+  // Each raw landmark needs to pass through LandmarkLetterboxRemoval +
+  // LandmarkProjection.
+
+  // Landmark letterbox removal for landmarks.
+  auto& landmark_letterbox_removal =
+      graph.AddNode("LandmarkLetterboxRemovalCalculator");
+  letterbox_padding >> landmark_letterbox_removal.In(kLetterboxPaddingTag);
+  landmarks >> landmark_letterbox_removal.In(kLandmarksTag);
+  auto adjusted_landmarks = landmark_letterbox_removal.Out(kLandmarksTag);
+
+  // Projects the landmarks.
+  auto& landmarks_projection = graph.AddNode("LandmarkProjectionCalculator");
+  adjusted_landmarks >> landmarks_projection.In(kNormLandmarksTag);
+  pose_rect >> landmarks_projection.In(kNormRectTag);
+  auto projected_landmarks = landmarks_projection.Out(kNormLandmarksTag)
+                                 .Cast<NormalizedLandmarkList>();
+
+  // Landmark letterbox removal for auxiliary landmarks.
+  auto& auxiliary_landmark_letterbox_removal =
+      graph.AddNode("LandmarkLetterboxRemovalCalculator");
+  letterbox_padding >>
+      auxiliary_landmark_letterbox_removal.In(kLetterboxPaddingTag);
+  auxiliary_landmarks >> auxiliary_landmark_letterbox_removal.In(kLandmarksTag);
+  auto auxiliary_adjusted_landmarks =
+      auxiliary_landmark_letterbox_removal.Out(kLandmarksTag);
+
+  // Projects the auxiliary landmarks.
+  auto& auxiliary_landmarks_projection =
+      graph.AddNode("LandmarkProjectionCalculator");
+  auxiliary_adjusted_landmarks >>
+      auxiliary_landmarks_projection.In(kNormLandmarksTag);
+  pose_rect >> auxiliary_landmarks_projection.In(kNormRectTag);
+  auto auxiliary_projected_landmarks =
+      auxiliary_landmarks_projection.Out(kNormLandmarksTag)
+          .Cast<NormalizedLandmarkList>();
+
+  // Project world landmarks.
+  auto& world_landmarks_projection =
+      graph.AddNode("WorldLandmarkProjectionCalculator");
+  world_landmarks >> world_landmarks_projection.In(kLandmarksTag);
+  pose_rect >> world_landmarks_projection.In(kNormRectTag);
+  auto world_projected_landmarks =
+      world_landmarks_projection.Out(kLandmarksTag).Cast<LandmarkList>();
+
+  std::optional<Stream<Image>> segmentation_mask;
+  if (output_segmentation_mask) {
+    //  Decodes the segmentation tensor into a mask image with pixel values in
+    //  [0, 1] (1 for person and 0 for background).
+    auto& tensors_to_segmentation =
+        graph.AddNode("TensorsToSegmentationCalculator");
+    ConfigureTensorsToSegmentationCalculator(
+        &tensors_to_segmentation.GetOptions<
+            mediapipe::TensorsToSegmentationCalculatorOptions>());
+    ensured_segmentation_tensors >> tensors_to_segmentation.In(kTensorsTag);
+    auto raw_segmentation_mask =
+        tensors_to_segmentation[Output<Image>(kMaskTag)];
+
+    // Calculates the inverse transformation matrix.
+    auto& inverse_matrix = graph.AddNode("InverseMatrixCalculator");
+    matrix >> inverse_matrix.In(kMatrixTag);
+    auto inverted_matrix = inverse_matrix.Out(kMatrixTag);
+
+    // Projects the segmentation mask from the letterboxed ROI back to the
+    // full image.
+    auto& warp_affine = graph.AddNode("WarpAffineCalculator");
+    ConfigureWarpAffineCalculator(
+        &warp_affine.GetOptions<mediapipe::WarpAffineCalculatorOptions>());
+    image_size >> warp_affine.In(kOutputSizeTag);
+    inverted_matrix >> warp_affine.In(kMatrixTag);
+    raw_segmentation_mask >> warp_affine.In(kImageTag);
+    segmentation_mask = warp_affine.Out(kImageTag).Cast<Image>();
+  }
+
+  // Calculate region of interest based on auxiliary landmarks, to be used
+  // in the next frame. Consists of LandmarksToDetection +
+  // AlignmentPointsRects + RectTransformation.
+
+  auto& auxiliary_landmarks_to_detection =
+      graph.AddNode("LandmarksToDetectionCalculator");
+  auxiliary_projected_landmarks >>
+      auxiliary_landmarks_to_detection.In(kNormLandmarksTag);
+  auto detection = auxiliary_landmarks_to_detection.Out(kDetectionTag);
+
+  auto& detection_to_rect = graph.AddNode("AlignmentPointsRectsCalculator");
+  ConfigureAlignmentPointsRectsCalculator(
+      &detection_to_rect
+           .GetOptions<mediapipe::DetectionsToRectsCalculatorOptions>());
+  detection >> detection_to_rect.In(kDetectionTag);
+  image_size >> detection_to_rect.In(kImageSizeTag);
+  auto raw_pose_rects = detection_to_rect.Out(kNormRectTag);
+
+  auto& rect_transformation = graph.AddNode("RectTransformationCalculator");
+  ConfigureRectTransformationCalculator(
+      &rect_transformation
+           .GetOptions<mediapipe::RectTransformationCalculatorOptions>());
+  image_size >> rect_transformation.In(kImageSizeTag);
+  raw_pose_rects >> rect_transformation.In("NORM_RECT");
+  auto pose_rect_next_frame = rect_transformation[Output<NormalizedRect>("")];
+
+  return {
+      /* pose_landmarks= */ projected_landmarks,
+      /* world_pose_landmarks= */ world_projected_landmarks,
+      /* auxiliary_pose_landmarks= */ auxiliary_projected_landmarks,
+      /* pose_rect_next_frame= */ pose_rect_next_frame,
+      /* pose_presence= */ pose_presence,
+      /* pose_presence_score= */ pose_presence_score,
+      /* segmentation_mask= */ segmentation_mask,
+  };
+}
+
 // A "mediapipe.tasks.vision.pose_landmarker.SinglePoseLandmarksDetectorGraph"
 // performs pose landmarks detection.
 // - Accepts CPU input images and outputs Landmark on CPU.
@@ -353,8 +604,9 @@ class SinglePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
     image_in >> preprocessing.In(kImageTag);
     pose_rect >> preprocessing.In(kNormRectTag);
     auto image_size = preprocessing[Output<std::pair<int, int>>(kImageSizeTag)];
-    auto matrix = preprocessing[Output<std::vector<float>>(kMatrixTag)];
-    auto letterbox_padding = preprocessing.Out(kLetterboxPaddingTag);
+    auto matrix = preprocessing[Output<std::array<float, 16>>(kMatrixTag)];
+    auto letterbox_padding =
+        preprocessing[Output<std::array<float, 4>>(kLetterboxPaddingTag)];
 
     MP_ASSIGN_OR_RETURN(auto image_tensor_specs,
                         BuildInputImageTensorSpecs(model_resources));
@@ -363,225 +615,10 @@ class SinglePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
         model_resources, subgraph_options.base_options().acceleration(), graph);
     preprocessing.Out(kTensorsTag) >> inference.In(kTensorsTag);
 
-    // Split model output tensors to multiple streams.
-    auto& split_tensors_vector = graph.AddNode("SplitTensorVectorCalculator");
-    ConfigureSplitTensorVectorCalculator(
-        &split_tensors_vector
-             .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
-    inference.Out(kTensorsTag) >> split_tensors_vector.In("");
-    auto landmark_tensors = split_tensors_vector.Out(0);
-    auto pose_flag_tensors = split_tensors_vector.Out(1);
-    auto segmentation_tensors = split_tensors_vector.Out(2);
-    auto heatmap_tensors = split_tensors_vector.Out(3);
-    auto world_landmark_tensors = split_tensors_vector.Out(4);
-
-    // Converts the pose-flag tensor into a float that represents the confidence
-    // score of pose presence.
-    auto& tensors_to_pose_presence = graph.AddNode("TensorsToFloatsCalculator");
-    pose_flag_tensors >> tensors_to_pose_presence.In(kTensorsTag);
-    auto pose_presence_score =
-        tensors_to_pose_presence[Output<float>(kFloatTag)];
-
-    // Applies a threshold to the confidence score to determine whether a
-    // pose is present.
-    auto& pose_presence_thresholding = graph.AddNode("ThresholdingCalculator");
-    pose_presence_thresholding
-        .GetOptions<mediapipe::ThresholdingCalculatorOptions>()
-        .set_threshold(subgraph_options.min_detection_confidence());
-    pose_presence_score >> pose_presence_thresholding.In(kFloatTag);
-    auto pose_presence = pose_presence_thresholding[Output<bool>(kFlagTag)];
-
-    // GateCalculator for tensors.
-    auto& tensors_gate = graph.AddNode("GateCalculator");
-    landmark_tensors >> tensors_gate.In("")[0];
-    segmentation_tensors >> tensors_gate.In("")[1];
-    heatmap_tensors >> tensors_gate.In("")[2];
-    world_landmark_tensors >> tensors_gate.In("")[3];
-    pose_presence >> tensors_gate.In("ALLOW");
-    auto ensured_landmarks_tensors = tensors_gate.Out(0);
-    auto ensured_segmentation_tensors = tensors_gate.Out(1);
-    auto ensured_heatmap_tensors = tensors_gate.Out(2);
-    auto ensured_world_landmark_tensors = tensors_gate.Out(3);
-
-    // Decodes the landmark tensors into a list of landmarks, where the landmark
-    // coordinates are normalized by the size of the input image to the model.
-    auto& tensors_to_landmarks = graph.AddNode("TensorsToLandmarksCalculator");
-    ConfigureTensorsToLandmarksCalculator(
-        image_tensor_specs, /* normalize = */ false,
-        /*sigmoid_activation= */ true,
-        &tensors_to_landmarks
-             .GetOptions<mediapipe::TensorsToLandmarksCalculatorOptions>());
-    ensured_landmarks_tensors >> tensors_to_landmarks.In(kTensorsTag);
-
-    auto raw_landmarks =
-        tensors_to_landmarks[Output<NormalizedLandmarkList>(kNormLandmarksTag)];
-
-    // Refines landmarks with the heatmap tensor.
-    auto& refine_landmarks_from_heatmap =
-        graph.AddNode("RefineLandmarksFromHeatmapCalculator");
-    ConfigureRefineLandmarksFromHeatmapCalculator(
-        &refine_landmarks_from_heatmap.GetOptions<
-            mediapipe::RefineLandmarksFromHeatmapCalculatorOptions>());
-    ensured_heatmap_tensors >> refine_landmarks_from_heatmap.In(kTensorsTag);
-    raw_landmarks >> refine_landmarks_from_heatmap.In(kNormLandmarksTag);
-    auto landmarks_from_heatmap =
-        refine_landmarks_from_heatmap[Output<NormalizedLandmarkList>(
-            kNormLandmarksTag)];
-
-    // Splits the landmarks into two sets: the actual pose landmarks and the
-    // auxiliary landmarks.
-    auto& split_normalized_landmark_list =
-        graph.AddNode("SplitNormalizedLandmarkListCalculator");
-    ConfigureSplitNormalizedLandmarkListCalculator(
-        &split_normalized_landmark_list
-             .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
-    landmarks_from_heatmap >> split_normalized_landmark_list.In("");
-    auto landmarks = split_normalized_landmark_list.Out("")[0]
-                         .Cast<NormalizedLandmarkList>();
-    auto auxiliary_landmarks = split_normalized_landmark_list.Out("")[1]
-                                   .Cast<NormalizedLandmarkList>();
-
-    // Decodes the world-landmark tensors into a vector of world landmarks.
-    auto& tensors_to_world_landmarks =
-        graph.AddNode("TensorsToLandmarksCalculator");
-    ConfigureTensorsToLandmarksCalculator(
-        image_tensor_specs, /* normalize = */ false,
-        /* sigmoid_activation= */ false,
-        &tensors_to_world_landmarks
-             .GetOptions<mediapipe::TensorsToLandmarksCalculatorOptions>());
-    ensured_world_landmark_tensors >>
-        tensors_to_world_landmarks.In(kTensorsTag);
-    auto raw_world_landmarks =
-        tensors_to_world_landmarks[Output<LandmarkList>(kLandmarksTag)];
-
-    // Keeps only the actual world landmarks.
-    auto& split_landmark_list = graph.AddNode("SplitLandmarkListCalculator");
-    ConfigureSplitLandmarkListCalculator(
-        &split_landmark_list
-             .GetOptions<mediapipe::SplitVectorCalculatorOptions>());
-    raw_world_landmarks >> split_landmark_list.In("");
-    auto split_landmarks = split_landmark_list.Out(0);
-
-    // Reuses the visibility and presence field in pose landmarks for the world
-    // landmarks.
-    auto& visibility_copy = graph.AddNode("VisibilityCopyCalculator");
-    ConfigureVisibilityCopyCalculator(
-        &visibility_copy
-             .GetOptions<mediapipe::VisibilityCopyCalculatorOptions>());
-    split_landmarks >> visibility_copy.In(kLandmarksToTag);
-    landmarks >> visibility_copy.In(kNormLandmarksFromTag);
-    auto world_landmarks =
-        visibility_copy[Output<LandmarkList>(kLandmarksToTag)];
-
-    // Each raw landmark needs to pass through LandmarkLetterboxRemoval +
-    // LandmarkProjection.
-
-    // Landmark letterbox removal for landmarks.
-    auto& landmark_letterbox_removal =
-        graph.AddNode("LandmarkLetterboxRemovalCalculator");
-    letterbox_padding >> landmark_letterbox_removal.In(kLetterboxPaddingTag);
-    landmarks >> landmark_letterbox_removal.In(kLandmarksTag);
-    auto adjusted_landmarks = landmark_letterbox_removal.Out(kLandmarksTag);
-
-    // Projects the landmarks.
-    auto& landmarks_projection = graph.AddNode("LandmarkProjectionCalculator");
-    adjusted_landmarks >> landmarks_projection.In(kNormLandmarksTag);
-    pose_rect >> landmarks_projection.In(kNormRectTag);
-    auto projected_landmarks = landmarks_projection.Out(kNormLandmarksTag)
-                                   .Cast<NormalizedLandmarkList>();
-
-    // Landmark letterbox removal for auxiliary landmarks.
-    auto& auxiliary_landmark_letterbox_removal =
-        graph.AddNode("LandmarkLetterboxRemovalCalculator");
-    letterbox_padding >>
-        auxiliary_landmark_letterbox_removal.In(kLetterboxPaddingTag);
-    auxiliary_landmarks >>
-        auxiliary_landmark_letterbox_removal.In(kLandmarksTag);
-    auto auxiliary_adjusted_landmarks =
-        auxiliary_landmark_letterbox_removal.Out(kLandmarksTag);
-
-    // Projects the auxiliary landmarks.
-    auto& auxiliary_landmarks_projection =
-        graph.AddNode("LandmarkProjectionCalculator");
-    auxiliary_adjusted_landmarks >>
-        auxiliary_landmarks_projection.In(kNormLandmarksTag);
-    pose_rect >> auxiliary_landmarks_projection.In(kNormRectTag);
-    auto auxiliary_projected_landmarks =
-        auxiliary_landmarks_projection.Out(kNormLandmarksTag)
-            .Cast<NormalizedLandmarkList>();
-
-    // Project world landmarks.
-    auto& world_landmarks_projection =
-        graph.AddNode("WorldLandmarkProjectionCalculator");
-    world_landmarks >> world_landmarks_projection.In(kLandmarksTag);
-    pose_rect >> world_landmarks_projection.In(kNormRectTag);
-    auto world_projected_landmarks =
-        world_landmarks_projection.Out(kLandmarksTag).Cast<LandmarkList>();
-
-    std::optional<Stream<Image>> segmentation_mask;
-    if (output_segmentation_mask) {
-      //  Decodes the segmentation tensor into a mask image with pixel values in
-      //  [0, 1] (1 for person and 0 for background).
-      auto& tensors_to_segmentation =
-          graph.AddNode("TensorsToSegmentationCalculator");
-      ConfigureTensorsToSegmentationCalculator(
-          &tensors_to_segmentation.GetOptions<
-              mediapipe::TensorsToSegmentationCalculatorOptions>());
-      ensured_segmentation_tensors >> tensors_to_segmentation.In(kTensorsTag);
-      auto raw_segmentation_mask =
-          tensors_to_segmentation[Output<Image>(kMaskTag)];
-
-      // Calculates the inverse transformation matrix.
-      auto& inverse_matrix = graph.AddNode("InverseMatrixCalculator");
-      matrix >> inverse_matrix.In(kMatrixTag);
-      auto inverted_matrix = inverse_matrix.Out(kMatrixTag);
-
-      // Projects the segmentation mask from the letterboxed ROI back to the
-      // full image.
-      auto& warp_affine = graph.AddNode("WarpAffineCalculator");
-      ConfigureWarpAffineCalculator(
-          &warp_affine.GetOptions<mediapipe::WarpAffineCalculatorOptions>());
-      image_size >> warp_affine.In(kOutputSizeTag);
-      inverted_matrix >> warp_affine.In(kMatrixTag);
-      raw_segmentation_mask >> warp_affine.In(kImageTag);
-      segmentation_mask = warp_affine.Out(kImageTag).Cast<Image>();
-    }
-
-    // Calculate region of interest based on auxiliary landmarks, to be used
-    // in the next frame. Consists of LandmarksToDetection +
-    // AlignmentPointsRects + RectTransformation.
-
-    auto& auxiliary_landmarks_to_detection =
-        graph.AddNode("LandmarksToDetectionCalculator");
-    auxiliary_projected_landmarks >>
-        auxiliary_landmarks_to_detection.In(kNormLandmarksTag);
-    auto detection = auxiliary_landmarks_to_detection.Out(kDetectionTag);
-
-    auto& detection_to_rect = graph.AddNode("AlignmentPointsRectsCalculator");
-    ConfigureAlignmentPointsRectsCalculator(
-        &detection_to_rect
-             .GetOptions<mediapipe::DetectionsToRectsCalculatorOptions>());
-    detection >> detection_to_rect.In(kDetectionTag);
-    image_size >> detection_to_rect.In(kImageSizeTag);
-    auto raw_pose_rects = detection_to_rect.Out(kNormRectTag);
-
-    auto& rect_transformation = graph.AddNode("RectTransformationCalculator");
-    ConfigureRectTransformationCalculator(
-        &rect_transformation
-             .GetOptions<mediapipe::RectTransformationCalculatorOptions>());
-    image_size >> rect_transformation.In(kImageSizeTag);
-    raw_pose_rects >> rect_transformation.In("NORM_RECT");
-    auto pose_rect_next_frame = rect_transformation[Output<NormalizedRect>("")];
-
-    return {{
-        /* pose_landmarks= */ projected_landmarks,
-        /* world_pose_landmarks= */ world_projected_landmarks,
-        /* auxiliary_pose_landmarks= */ auxiliary_projected_landmarks,
-        /* pose_rect_next_frame= */ pose_rect_next_frame,
-        /* pose_presence= */ pose_presence,
-        /* pose_presence_score= */ pose_presence_score,
-        /* segmentation_mask= */ segmentation_mask,
-    }};
+    return BuildPoseLandmarksPostprocessing(
+        subgraph_options, image_tensor_specs,
+        inference[Output<std::vector<Tensor>>(kTensorsTag)], pose_rect, matrix,
+        letterbox_padding, image_size, graph, output_segmentation_mask);
   }
 };
 
@@ -622,6 +659,10 @@ REGISTER_MEDIAPIPE_GRAPH(
 //   SEGMENTATION_MASK - std::vector<Image>
 //     Vector of segmentation masks.
 //
+// With `batch_poses` enabled in the options, the RoIs of all poses are cropped
+// into one batched tensor and the landmarks model runs once per frame for all
+// poses, instead of running SinglePoseLandmarksDetectorGraph for each pose.
+//
 // Example:
 // node {
 //   calculator:
@@ -654,27 +695,44 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
     Graph graph;
     bool output_segmentation_masks =
         HasOutput(sc->OriginalNode(), kSegmentationMaskTag);
-    MP_ASSIGN_OR_RETURN(
-        auto pose_landmark_detection_outputs,
-        BuildPoseLandmarksDetectorGraph(
-            sc->Options<PoseLandmarksDetectorGraphOptions>(),
-            graph[Input<Image>(kImageTag)],
-            graph[Input<std::vector<NormalizedRect>>(kNormRectTag)], graph,
-            output_segmentation_masks));
-    pose_landmark_detection_outputs.landmark_lists >>
+    const auto& subgraph_options =
+        sc->Options<PoseLandmarksDetectorGraphOptions>();
+    Source<Image> image_in = graph[Input<Image>(kImageTag)];
+    Source<std::vector<NormalizedRect>> multi_pose_rects =
+        graph[Input<std::vector<NormalizedRect>>(kNormRectTag)];
+    std::optional<PoseLandmarkerOutputs> pose_landmark_detection_outputs;
+    if (subgraph_options.batch_poses()) {
+      MP_ASSIGN_OR_RETURN(
+          const auto* model_resources,
+          CreateModelResources<PoseLandmarksDetectorGraphOptions>(sc));
+      MP_ASSIGN_OR_RETURN(
+          pose_landmark_detection_outputs,
+          BuildBatchedPoseLandmarksDetectorGraph(
+              subgraph_options, *model_resources, image_in, multi_pose_rects,
+              graph, output_segmentation_masks));
+    } else {
+      pose_landmark_detection_outputs = BuildPoseLandmarksDetectorGraph(
+          subgraph_options, image_in, multi_pose_rects, graph,
+          output_segmentation_masks);
+    }
+    if (subgraph_options.smooth_landmarks()) {
+      SmoothFirstPoseLandmarks(image_in, *pose_landmark_detection_outputs,
+                               graph);
+    }
+    pose_landmark_detection_outputs->landmark_lists >>
         graph[Output<std::vector<NormalizedLandmarkList>>(kLandmarksTag)];
-    pose_landmark_detection_outputs.world_landmark_lists >>
+    pose_landmark_detection_outputs->world_landmark_lists >>
         graph[Output<std::vector<LandmarkList>>(kWorldLandmarksTag)];
-    pose_landmark_detection_outputs.auxiliary_landmark_lists >>
+    pose_landmark_detection_outputs->auxiliary_landmark_lists >>
         graph[Output<std::vector<NormalizedLandmarkList>>(kAuxLandmarksTag)];
-    pose_landmark_detection_outputs.pose_rects_next_frame >>
+    pose_landmark_detection_outputs->pose_rects_next_frame >>
         graph[Output<std::vector<NormalizedRect>>(kPoseRectsNextFrameTag)];
-    pose_landmark_detection_outputs.presences >>
+    pose_landmark_detection_outputs->presences >>
         graph[Output<std::vector<bool>>(kPresenceTag)];
-    pose_landmark_detection_outputs.presence_scores >>
+    pose_landmark_detection_outputs->presence_scores >>
         graph[Output<std::vector<float>>(kPresenceScoreTag)];
-    if (pose_landmark_detection_outputs.segmentation_masks) {
-      *pose_landmark_detection_outputs.segmentation_masks >>
+    if (pose_landmark_detection_outputs->segmentation_masks) {
+      *pose_landmark_detection_outputs->segmentation_masks >>
           graph[Output<std::vector<Image>>(kSegmentationMaskTag)];
     }
 
@@ -682,7 +740,8 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
   }
 
  private:
-  absl::StatusOr<PoseLandmarkerOutputs> BuildPoseLandmarksDetectorGraph(
+  // Runs SinglePoseLandmarksDetectorGraph on each pose RoI.
+  PoseLandmarkerOutputs BuildPoseLandmarksDetectorGraph(
       const PoseLandmarksDetectorGraphOptions& subgraph_options,
       Source<Image> image_in,
       Source<std::vector<NormalizedRect>> multi_pose_rects, Graph& graph,
@@ -702,18 +761,101 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
         subgraph_options;
     image >> pose_landmark_subgraph.In(kImageTag);
     pose_rect >> pose_landmark_subgraph.In(kNormRectTag);
-    auto landmarks = pose_landmark_subgraph.Out(kLandmarksTag);
-    auto world_landmarks = pose_landmark_subgraph.Out(kWorldLandmarksTag);
-    auto auxiliary_landmarks = pose_landmark_subgraph.Out(kAuxLandmarksTag);
-    auto pose_rect_next_frame =
-        pose_landmark_subgraph.Out(kPoseRectNextFrameTag);
-    auto presence = pose_landmark_subgraph.Out(kPresenceTag);
-    auto presence_score = pose_landmark_subgraph.Out(kPresenceScoreTag);
+    std::optional<Source<Image>> segmentation_mask;
+    if (output_segmentation_masks) {
+      segmentation_mask =
+          pose_landmark_subgraph[Output<Image>(kSegmentationMaskTag)];
+    }
+    return GatherPoseLandmarkerOutputs(
+        {
+            /* pose_landmarks= */ pose_landmark_subgraph
+                [Output<NormalizedLandmarkList>(kLandmarksTag)],
+            /* world_pose_landmarks= */ pose_landmark_subgraph
+                [Output<LandmarkList>(kWorldLandmarksTag)],
+            /* auxiliary_pose_landmarks= */ pose_landmark_subgraph
+                [Output<NormalizedLandmarkList>(kAuxLandmarksTag)],
+            /* pose_rect_next_frame= */ pose_landmark_subgraph
+                [Output<NormalizedRect>(kPoseRectNextFrameTag)],
+            /* pose_presence= */ pose_landmark_subgraph
+                [Output<bool>(kPresenceTag)],
+            /* pose_presence_score= */ pose_landmark_subgraph
+                [Output<float>(kPresenceScoreTag)],
+            /* segmentation_mask= */ segmentation_mask,
+        },
+        batch_end, graph);
+  }
 
+  // Crops all pose RoIs into one batched tensor and runs the landmarks model
+  // once on it. The output tensors are then split per pose and decoded as in
+  // SinglePoseLandmarksDetectorGraph.
+  absl::StatusOr<PoseLandmarkerOutputs> BuildBatchedPoseLandmarksDetectorGraph(
+      const PoseLandmarksDetectorGraphOptions& subgraph_options,
+      const ModelResources& model_resources, Source<Image> image_in,
+      Source<std::vector<NormalizedRect>> multi_pose_rects, Graph& graph,
+      bool output_segmentation_masks) {
+    MP_RETURN_IF_ERROR(SanityCheckOptions(subgraph_options));
+    if (components::processors::DetermineImagePreprocessingGpuBackend(
+            subgraph_options.base_options().acceleration())) {
+      return CreateStatusWithPayload(
+          absl::StatusCode::kInvalidArgument,
+          "`batch_poses` is only supported with CPU inference",
+          MediaPipeTasksStatus::kInvalidArgumentError);
+    }
+
+    // Configures ImageToTensorCalculator as ImagePreprocessingGraph does, but
+    // feeds it all pose RoIs at once.
+    components::processors::proto::ImagePreprocessingGraphOptions
+        preprocessing_options;
+    MP_RETURN_IF_ERROR(components::processors::ConfigureImagePreprocessingGraph(
+        model_resources, /*use_gpu=*/false,
+        subgraph_options.base_options().gpu_origin(), &preprocessing_options));
+    auto& image_to_cpu = graph.AddNode("ImageCloneCalculator");
+    image_to_cpu.GetOptions<mediapipe::ImageCloneCalculatorOptions>()
+        .set_output_on_gpu(false);
+    image_in >> image_to_cpu.In("");
+    auto& image_to_tensor = graph.AddNode("ImageToTensorCalculator");
+    image_to_tensor.GetOptions<mediapipe::ImageToTensorCalculatorOptions>() =
+        preprocessing_options.image_to_tensor_options();
+    image_to_cpu.Out("") >> image_to_tensor.In(kImageTag);
+    multi_pose_rects >> image_to_tensor.In(kNormRectsTag);
+
+    MP_ASSIGN_OR_RETURN(auto image_tensor_specs,
+                        BuildInputImageTensorSpecs(model_resources));
+
+    auto& inference = AddInference(
+        model_resources, subgraph_options.base_options().acceleration(), graph);
+    image_to_tensor.Out(kTensorsTag) >> inference.In(kTensorsTag);
+
+    // Sends the output tensors of each pose at its own loop timestamp, along
+    // with its RoI and crop transforms.
+    auto& begin_loop_batch = graph.AddNode("BeginTensorBatchLoopCalculator");
+    inference.Out(kTensorsTag) >> begin_loop_batch.In(kTensorsTag);
+    multi_pose_rects >> begin_loop_batch.In(kNormRectsTag);
+    image_to_tensor.Out(kMatricesTag) >> begin_loop_batch.In(kMatricesTag);
+    image_to_tensor.Out(kLetterboxPaddingsTag) >>
+        begin_loop_batch.In(kLetterboxPaddingsTag);
+    GetImageSize(image_in, graph) >> begin_loop_batch.In("CLONE");
+    auto batch_end = begin_loop_batch.Out(kBatchEndTag);
+
+    SinglePoseLandmarkerOutputs pose_outputs = BuildPoseLandmarksPostprocessing(
+        subgraph_options, image_tensor_specs,
+        begin_loop_batch[Output<std::vector<Tensor>>(kTensorsTag)],
+        begin_loop_batch[Output<NormalizedRect>(kNormRectTag)],
+        begin_loop_batch[Output<std::array<float, 16>>(kMatrixTag)],
+        begin_loop_batch[Output<std::array<float, 4>>(kLetterboxPaddingTag)],
+        begin_loop_batch[Output<std::pair<int, int>>("CLONE")], graph,
+        output_segmentation_masks);
+    return GatherPoseLandmarkerOutputs(pose_outputs, batch_end, graph);
+  }
+
+  // Collects the per-pose outputs of a loop into vectors.
+  PoseLandmarkerOutputs GatherPoseLandmarkerOutputs(
+      SinglePoseLandmarkerOutputs pose_outputs, Source<> batch_end,
+      Graph& graph) {
     auto& end_loop_landmarks =
         graph.AddNode("EndLoopNormalizedLandmarkListVectorCalculator");
     batch_end >> end_loop_landmarks.In(kBatchEndTag);
-    landmarks >> end_loop_landmarks.In(kItemTag);
+    pose_outputs.pose_landmarks >> end_loop_landmarks.In(kItemTag);
     auto landmark_lists =
         end_loop_landmarks[Output<std::vector<NormalizedLandmarkList>>(
             kIterableTag)];
@@ -721,7 +863,7 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
     auto& end_loop_world_landmarks =
         graph.AddNode("EndLoopLandmarkListVectorCalculator");
     batch_end >> end_loop_world_landmarks.In(kBatchEndTag);
-    world_landmarks >> end_loop_world_landmarks.In(kItemTag);
+    pose_outputs.world_pose_landmarks >> end_loop_world_landmarks.In(kItemTag);
     auto world_landmark_lists =
         end_loop_world_landmarks[Output<std::vector<LandmarkList>>(
             kIterableTag)];
@@ -729,105 +871,42 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
     auto& end_loop_auxiliary_landmarks =
         graph.AddNode("EndLoopNormalizedLandmarkListVectorCalculator");
     batch_end >> end_loop_auxiliary_landmarks.In(kBatchEndTag);
-    auxiliary_landmarks >> end_loop_auxiliary_landmarks.In(kItemTag);
+    pose_outputs.auxiliary_pose_landmarks >>
+        end_loop_auxiliary_landmarks.In(kItemTag);
     auto auxiliary_landmark_lists = end_loop_auxiliary_landmarks
         [Output<std::vector<NormalizedLandmarkList>>(kIterableTag)];
 
     auto& end_loop_rects_next_frame =
         graph.AddNode("EndLoopNormalizedRectCalculator");
     batch_end >> end_loop_rects_next_frame.In(kBatchEndTag);
-    pose_rect_next_frame >> end_loop_rects_next_frame.In(kItemTag);
+    pose_outputs.pose_rect_next_frame >> end_loop_rects_next_frame.In(kItemTag);
     auto pose_rects_next_frame =
         end_loop_rects_next_frame[Output<std::vector<NormalizedRect>>(
             kIterableTag)];
 
     auto& end_loop_presence = graph.AddNode("EndLoopBooleanCalculator");
     batch_end >> end_loop_presence.In(kBatchEndTag);
-    presence >> end_loop_presence.In(kItemTag);
+    pose_outputs.pose_presence >> end_loop_presence.In(kItemTag);
     auto presences = end_loop_presence[Output<std::vector<bool>>(kIterableTag)];
 
     auto& end_loop_presence_score = graph.AddNode("EndLoopFloatCalculator");
     batch_end >> end_loop_presence_score.In(kBatchEndTag);
-    presence_score >> end_loop_presence_score.In(kItemTag);
+    pose_outputs.pose_presence_score >> end_loop_presence_score.In(kItemTag);
     auto presence_scores =
         end_loop_presence_score[Output<std::vector<float>>(kIterableTag)];
 
     std::optional<Stream<std::vector<Image>>> segmentation_masks_vector;
-    if (output_segmentation_masks) {
-      auto segmentation_mask = pose_landmark_subgraph.Out(kSegmentationMaskTag);
+    if (pose_outputs.segmentation_mask) {
       auto& end_loop_segmentation_mask =
           graph.AddNode("EndLoopImageCalculator");
       batch_end >> end_loop_segmentation_mask.In(kBatchEndTag);
-      segmentation_mask >> end_loop_segmentation_mask.In(kItemTag);
+      *pose_outputs.segmentation_mask >>
+          end_loop_segmentation_mask.In(kItemTag);
       segmentation_masks_vector =
           end_loop_segmentation_mask[Output<std::vector<Image>>(kIterableTag)];
     }
 
-    // Apply smoothing filter only on the single pose landmarks, because
-    // landmarks smoothing calculator doesn't support multiple landmarks yet.
-    // Notice the landmarks smoothing calculator cannot be put inside the for
-    // loop calculator, because the smoothing calculator utilize the timestamp
-    // to smoote landmarks across frames but the for loop calculator makes fake
-    // timestamps for the streams.
-    if (subgraph_options.smooth_landmarks()) {
-      Stream<std::pair<int, int>> image_size = GetImageSize(image_in, graph);
-      Stream<int> zero_index =
-          CreateIntConstantStream(landmark_lists, 0, graph);
-      Stream<NormalizedLandmarkList> landmarks =
-          GetItem(landmark_lists, zero_index, graph);
-      Stream<LandmarkList> world_landmarks =
-          GetItem(world_landmark_lists, zero_index, graph);
-      Stream<NormalizedRect> roi =
-          GetItem(pose_rects_next_frame, zero_index, graph);
-
-      // Apply smoothing filter on pose landmarks.
-      landmarks = SmoothLandmarksVisibility(
-          landmarks, /*low_pass_filter_alpha=*/0.1f, graph);
-      landmarks = SmoothLandmarks(
-          landmarks, image_size, roi,
-          {// Min cutoff 0.05 results into ~0.01 alpha in landmark EMA filter
-           // when landmark is static.
-           /*min_cutoff=*/0.05f,
-           // Beta 80.0 in combination with min_cutoff 0.05 results into ~0.94
-           // alpha in landmark EMA filter when landmark is moving fast.
-           /*beta=*/80.0f,
-           // Derivative cutoff 1.0 results into ~0.17 alpha in landmark
-           // velocity EMA filter.
-           /*derivate_cutoff=*/1.0f},
-          graph);
-
-      // Apply smoothing filter on pose world landmarks.
-      world_landmarks = SmoothLandmarksVisibility(
-          world_landmarks, /*low_pass_filter_alpha=*/0.1f, graph);
-      world_landmarks = SmoothLandmarks(
-          world_landmarks,
-          /*scale_roi=*/std::nullopt,
-          {// Min cutoff 0.1 results into ~ 0.02 alpha in landmark EMA filter
-           // when landmark is static.
-           /*min_cutoff=*/0.1f,
-           // Beta 40.0 in combination with min_cutoff 0.1 results into ~0.8
-           // alpha in landmark EMA filter when landmark is moving fast.
-           /*beta=*/40.0f,
-           // Derivative cutoff 1.0 results into ~0.17 alpha in landmark
-           // velocity EMA filter.
-           /*derivate_cutoff=*/1.0f},
-          graph);
-
-      // Wrap the single pose landmarks into a vector of landmarks.
-      auto& concat_landmarks =
-          graph.AddNode("ConcatenateNormalizedLandmarkListVectorCalculator");
-      landmarks >> concat_landmarks.In("");
-      landmark_lists =
-          concat_landmarks.Out("").Cast<std::vector<NormalizedLandmarkList>>();
-
-      auto& concat_world_landmarks =
-          graph.AddNode("ConcatenateLandmarkListVectorCalculator");
-      world_landmarks >> concat_world_landmarks.In("");
-      world_landmark_lists =
-          concat_world_landmarks.Out("").Cast<std::vector<LandmarkList>>();
-    }
-
-    return {{
+    return {
         /* landmark_lists= */ landmark_lists,
         /* world_landmark_lists= */ world_landmark_lists,
         /* auxiliary_landmark_lists= */ auxiliary_landmark_lists,
@@ -835,7 +914,72 @@ class MultiplePoseLandmarksDetectorGraph : public core::ModelTaskGraph {
         /* presences= */ presences,
         /* presence_scores= */ presence_scores,
         /* segmentation_masks= */ segmentation_masks_vector,
-    }};
+    };
+  }
+
+  // Apply smoothing filter only on the single pose landmarks, because
+  // landmarks smoothing calculator doesn't support multiple landmarks yet.
+  // Notice the landmarks smoothing calculator cannot be put inside the for
+  // loop calculator, because the smoothing calculator utilize the timestamp
+  // to smoote landmarks across frames but the for loop calculator makes fake
+  // timestamps for the streams.
+  void SmoothFirstPoseLandmarks(Source<Image> image_in,
+                                PoseLandmarkerOutputs& outputs, Graph& graph) {
+    Stream<std::pair<int, int>> image_size = GetImageSize(image_in, graph);
+    Stream<int> zero_index =
+        CreateIntConstantStream(outputs.landmark_lists, 0, graph);
+    Stream<NormalizedLandmarkList> landmarks =
+        GetItem(outputs.landmark_lists, zero_index, graph);
+    Stream<LandmarkList> world_landmarks =
+        GetItem(outputs.world_landmark_lists, zero_index, graph);
+    Stream<NormalizedRect> roi =
+        GetItem(outputs.pose_rects_next_frame, zero_index, graph);
+
+    // Apply smoothing filter on pose landmarks.
+    landmarks = SmoothLandmarksVisibility(
+        landmarks, /*low_pass_filter_alpha=*/0.1f, graph);
+    landmarks = SmoothLandmarks(
+        landmarks, image_size, roi,
+        {// Min cutoff 0.05 results into ~0.01 alpha in landmark EMA filter
+         // when landmark is static.
+         /*min_cutoff=*/0.05f,
+         // Beta 80.0 in combination with min_cutoff 0.05 results into ~0.94
+         // alpha in landmark EMA filter when landmark is moving fast.
+         /*beta=*/80.0f,
+         // Derivative cutoff 1.0 results into ~0.17 alpha in landmark
+         // velocity EMA filter.
+         /*derivate_cutoff=*/1.0f},
+        graph);
+
+    // Apply smoothing filter on pose world landmarks.
+    world_landmarks = SmoothLandmarksVisibility(
+        world_landmarks, /*low_pass_filter_alpha=*/0.1f, graph);
+    world_landmarks = SmoothLandmarks(
+        world_landmarks,
+        /*scale_roi=*/std::nullopt,
+        {// Min cutoff 0.1 results into ~ 0.02 alpha in landmark EMA filter
+         // when landmark is static.
+         /*min_cutoff=*/0.1f,
+         // Beta 40.0 in combination with min_cutoff 0.1 results into ~0.8
+         // alpha in landmark EMA filter when landmark is moving fast.
+         /*beta=*/40.0f,
+         // Derivative cutoff 1.0 results into ~0.17 alpha in landmark
+         // velocity EMA filter.
+         /*derivate_cutoff=*/1.0f},
+        graph);
+
+    // Wrap the single pose landmarks into a vector of landmarks.
+    auto& concat_landmarks =
+        graph.AddNode("ConcatenateNormalizedLandmarkListVectorCalculator");
+    landmarks >> concat_landmarks.In("");
+    outputs.landmark_lists =
+        concat_landmarks.Out("").Cast<std::vector<NormalizedLandmarkList>>();
+
+    auto& concat_world_landmarks =
+        graph.AddNode("ConcatenateLandmarkListVectorCalculator");
+    world_landmarks >> concat_world_landmarks.In("");
+    outputs.world_landmark_lists =
+        concat_world_landmarks.Out("").Cast<std::vector<LandmarkList>>();
   }
 };
 
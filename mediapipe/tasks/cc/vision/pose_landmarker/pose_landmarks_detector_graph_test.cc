@@ -17,6 +17,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/status/statusor.h"
@@ -34,6 +35,8 @@ limitations under the License.
 #include "mediapipe/framework/port/file_helpers.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/tool/name_util.h"
+#include "mediapipe/framework/tool/subgraph_expansion.h"
 #include "mediapipe/tasks/cc/core/model_resources.h"
 #include "mediapipe/tasks/cc/core/proto/base_options.pb.h"
 #include "mediapipe/tasks/cc/core/proto/external_file.pb.h"
@@ -59,8 +62,10 @@ using ::mediapipe::tasks::core::TaskRunner;
 using ::mediapipe::tasks::vision::DecodeImageFromFile;
 using ::mediapipe::tasks::vision::pose_landmarker::proto::
     PoseLandmarksDetectorGraphOptions;
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 using ::testing::EqualsProto;
+using ::testing::NotNull;
 using ::testing::Pointwise;
 using ::testing::TestParamInfo;
 using ::testing::TestWithParam;
@@ -148,7 +153,7 @@ absl::StatusOr<std::unique_ptr<TaskRunner>> CreateSinglePoseTaskRunner(
 
 // Helper function to create a Multi Pose Landmark TaskRunner.
 absl::StatusOr<std::unique_ptr<TaskRunner>> CreateMultiPoseTaskRunner(
-    absl::string_view model_name) {
+    absl::string_view model_name, bool batch_poses = false) {
   Graph graph;
 
   auto& multi_pose_landmark_detection = graph.AddNode(
@@ -158,6 +163,7 @@ absl::StatusOr<std::unique_ptr<TaskRunner>> CreateMultiPoseTaskRunner(
   auto options = std::make_unique<PoseLandmarksDetectorGraphOptions>();
   options->mutable_base_options()->mutable_model_asset()->set_file_name(
       JoinPath("./", kTestDataDirectory, model_name));
+  options->set_batch_poses(batch_poses);
   multi_pose_landmark_detection.GetOptions<PoseLandmarksDetectorGraphOptions>()
       .Swap(options.get());
 
@@ -318,6 +324,43 @@ TEST_P(MultiPoseLandmarkerTest, Succeeds) {
                               /*fraction=*/GetParam().landmarks_diff_threshold),
                 GetParam().expected_landmark_lists));
 }
+TEST_P(MultiPoseLandmarkerTest, BatchPosesMatchesPerPoseInference) {
+  std::vector<core::PacketMap> outputs;
+  for (bool batch_poses : {false, true}) {
+    MP_ASSERT_OK_AND_ASSIGN(
+        Image image, DecodeImageFromFile(JoinPath("./", kTestDataDirectory,
+                                                  GetParam().test_image_name)));
+    MP_ASSERT_OK_AND_ASSIGN(
+        auto task_runner,
+        CreateMultiPoseTaskRunner(GetParam().input_model_name, batch_poses));
+    auto output_packets = task_runner->Process(
+        {{kImageName, MakePacket<Image>(std::move(image))},
+         {kPoseRectName,
+          MakePacket<std::vector<NormalizedRect>>(GetParam().pose_rects)}});
+    MP_ASSERT_OK(output_packets);
+    outputs.push_back(*std::move(output_packets));
+  }
+  const core::PacketMap& per_pose = outputs[0];
+  const core::PacketMap& batched = outputs[1];
+
+  EXPECT_THAT(batched.at(kPresenceName).Get<std::vector<bool>>(),
+              ElementsAreArray(GetParam().expected_presences));
+  EXPECT_THAT(
+      batched.at(kLandmarksName).Get<std::vector<NormalizedLandmarkList>>(),
+      Pointwise(Approximately(Partially(EqualsProto()),
+                              /*margin=*/kAbsMargin,
+                              /*fraction=*/GetParam().landmarks_diff_threshold),
+                per_pose.at(kLandmarksName)
+                    .Get<std::vector<NormalizedLandmarkList>>()));
+  EXPECT_THAT(
+      batched.at(kWorldLandmarksName).Get<std::vector<LandmarkList>>(),
+      Pointwise(Approximately(Partially(EqualsProto()),
+                              /*margin=*/kAbsMargin,
+                              /*fraction=*/GetParam().landmarks_diff_threshold),
+                per_pose.at(kWorldLandmarksName)
+                    .Get<std::vector<LandmarkList>>()));
+}
+
 // TODO: Add additional tests for MP Tasks Pose Graphs.
 // PoseRects below are based on result from PoseDetectorGraph,
 // mediapipe/tasks/testdata/vision/pose_expected_expanded_rect.pbtxt.
@@ -349,21 +392,131 @@ INSTANTIATE_TEST_SUITE_P(
 
 INSTANTIATE_TEST_SUITE_P(
     MultiPoseLandmarkerTest, MultiPoseLandmarkerTest,
-    Values(MultiPoseTestParams{
-        .test_name = "MultiPoseLandmarkerLiteModel",
-        .input_model_name = kPoseLandmarkerLiteModel,
-        .test_image_name = kPoseImage,
-        .pose_rects = {MakePoseRect(0.49192297, 0.7013345, 0.6317167, 0.9471016,
-                                    -0.029253244)},
-        .expected_presences = {true},
-        .expected_landmark_lists = {GetExpectedLandmarkList(
-            kExpectedPoseLandmarksFilename)},
-        .landmarks_diff_threshold = kLiteModelFractionDiff,
-    }),
+    Values(
+        MultiPoseTestParams{
+            .test_name = "MultiPoseLandmarkerLiteModel",
+            .input_model_name = kPoseLandmarkerLiteModel,
+            .test_image_name = kPoseImage,
+            .pose_rects = {MakePoseRect(0.49192297, 0.7013345, 0.6317167,
+                                        0.9471016, -0.029253244)},
+            .expected_presences = {true},
+            .expected_landmark_lists = {GetExpectedLandmarkList(
+                kExpectedPoseLandmarksFilename)},
+            .landmarks_diff_threshold = kLiteModelFractionDiff,
+        },
+        MultiPoseTestParams{
+            .test_name = "MultiPoseLandmarkerLiteModelTwoPoses",
+            .input_model_name = kPoseLandmarkerLiteModel,
+            .test_image_name = kPoseImage,
+            .pose_rects = {MakePoseRect(0.49192297, 0.7013345, 0.6317167,
+                                        0.9471016, -0.029253244),
+                           MakePoseRect(0.49192297, 0.7013345, 0.6317167,
+                                        0.9471016, -0.029253244)},
+            .expected_presences = {true, true},
+            .expected_landmark_lists =
+                {GetExpectedLandmarkList(kExpectedPoseLandmarksFilename),
+                 GetExpectedLandmarkList(kExpectedPoseLandmarksFilename)},
+            .landmarks_diff_threshold = kLiteModelFractionDiff,
+        }),
     [](const TestParamInfo<MultiPoseLandmarkerTest::ParamType>& info) {
       return info.param.test_name;
     });
 
+// Returns the config of a SinglePoseLandmarksDetectorGraph with all its
+// subgraphs expanded.
+absl::StatusOr<CalculatorGraphConfig> ExpandSinglePoseConfig(bool use_gpu) {
+  Graph graph;
+  auto& pose_landmark_detection = graph.AddNode(
+      "mediapipe.tasks.vision.pose_landmarker."
+      "SinglePoseLandmarksDetectorGraph");
+  auto& options =
+      pose_landmark_detection.GetOptions<PoseLandmarksDetectorGraphOptions>();
+  options.mutable_base_options()->mutable_model_asset()->set_file_name(
+      JoinPath("./", kTestDataDirectory, kPoseLandmarkerLiteModel));
+  if (use_gpu) {
+    options.mutable_base_options()->mutable_acceleration()->mutable_gpu();
+  }
+  graph[Input<Image>(kImageTag)].SetName(kImageName) >>
+      pose_landmark_detection.In(kImageTag);
+  graph[Input<NormalizedRect>(kNormRectTag)].SetName(kPoseRectName) >>
+      pose_landmark_detection.In(kNormRectTag);
+  pose_landmark_detection.Out(kLandmarksTag).SetName(kLandmarksName) >>
+      graph[Output<NormalizedLandmarkList>(kLandmarksTag)];
+  pose_landmark_detection.Out(kSegmentationMaskTag)
+          .SetName(kSegmentationMaskName) >>
+      graph[Output<Image>(kSegmentationMaskTag)];
+  CalculatorGraphConfig config = graph.GetConfig();
+  MP_RETURN_IF_ERROR(tool::ExpandSubgraphs(&config));
+  return config;
+}
+
+// Returns the first node running `calculator`, or nullptr if there is none.
+const CalculatorGraphConfig::Node* FindNode(const CalculatorGraphConfig& config,
+                                            const std::string& calculator) {
+  for (const auto& node : config.node()) {
+    if (node.calculator() == calculator) return &node;
+  }
+  return nullptr;
+}
+
+// Returns the calculators of the nodes producing the input streams of `node`
+// with `tag`, in stream order.
+std::vector<std::string> GetInputCalculators(
+    const CalculatorGraphConfig& config,
+    const CalculatorGraphConfig::Node& node, const std::string& tag) {
+  std::vector<std::string> calculators;
+  for (const auto& input_stream : node.input_stream()) {
+    if (tool::ParseTagIndexFromStream(input_stream).first != tag) continue;
+    const std::string name = tool::ParseNameFromStream(input_stream);
+    for (const auto& other : config.node()) {
+      for (const auto& output_stream : other.output_stream()) {
+        if (tool::ParseNameFromStream(output_stream) == name) {
+          calculators.push_back(other.calculator());
+        }
+      }
+    }
+  }
+  return calculators;
+}
+
+TEST(PoseLandmarksDetectorGraphTest, GpuReadsBackCpuDecodedTensorsEarly) {
+  MP_ASSERT_OK_AND_ASSIGN(CalculatorGraphConfig config,
+                          ExpandSinglePoseConfig(/*use_gpu=*/true));
+
+  const auto* tensors_to_presence =
+      FindNode(config, "TensorsToFloatsCalculator");
+  ASSERT_THAT(tensors_to_presence, NotNull());
+  EXPECT_THAT(GetInputCalculators(config, *tensors_to_presence, "TENSORS"),
+              ElementsAre("TensorsReadbackCalculator"));
+  // Landmark, segmentation, heatmap and world landmark tensors, in that order.
+  // Only the segmentation tensor, decoded on the GPU, is not read back.
+  const auto* tensors_gate = FindNode(config, "GateCalculator");
+  ASSERT_THAT(tensors_gate, NotNull());
+  EXPECT_THAT(GetInputCalculators(config, *tensors_gate, ""),
+              ElementsAre("TensorsReadbackCalculator",
+                          "SplitTensorVectorCalculator",
+                          "TensorsReadbackCalculator",
+                          "TensorsReadbackCalculator"));
+  for (const auto& node : config.node()) {
+    if (node.calculator() != "TensorsReadbackCalculator") continue;
+    EXPECT_THAT(GetInputCalculators(config, node, "TENSORS"),
+                ElementsAre("SplitTensorVectorCalculator"));
+  }
+}
+
+TEST(PoseLandmarksDetectorGraphTest, CpuDecodesInferenceTensorsDirectly) {
+  MP_ASSERT_OK_AND_ASSIGN(CalculatorGraphConfig config,
+                          ExpandSinglePoseConfig(/*use_gpu=*/false));
+
+  EXPECT_THAT(FindNode(config, "TensorsReadbackCalculator"),
+              testing::IsNull());
+  const auto* tensors_to_presence =
+      FindNode(config, "TensorsToFloatsCalculator");
+  ASSERT_THAT(tensors_to_presence, NotNull());
+  EXPECT_THAT(GetInputCalculators(config, *tensors_to_presence, "TENSORS"),
+              ElementsAre("SplitTensorVectorCalculator"));
+}
+
 }  // namespace
 }  // namespace pose_landmarker
 }  // namespace vision
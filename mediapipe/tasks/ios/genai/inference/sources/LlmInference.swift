@@ -74,7 +74,8 @@ import MediaPipeTasksGenAIC
             max_top_k: options.maxTopk,
             llm_activation_data_type: kLlmActivationDataTypeDefault,
             num_draft_tokens: 0,
-            wait_for_weight_uploads: options.waitForWeightUploads)
+            wait_for_weight_uploads: options.waitForWeightUploads,
+            prompt_cache_size_bytes: 0)
           return try LlmTaskRunner(modelSettings: modelSetting)
         }
       }
@@ -160,36 +160,29 @@ export abstract class TaskRunner {
       if (baseOptions.modelAssetPath) {
         // We don't use `await` here since we want to apply most settings
         // synchronously.
-        return fetch(baseOptions.modelAssetPath.toString())
-          .then((response) => {
-            if (!response.ok) {
-              throw new Error(
-                `Failed to fetch model: ${baseOptions.modelAssetPath} (${response.status})`,
-              );
-            } else {
-              return response.arrayBuffer();
-            }
-          })
-          .then((buffer) => {
-            try {
-              // Try to delete file as we cannot overwrite an existing file
-              // using our current API.
-              this.graphRunner.wasmModule.FS_unlink('/model.dat');
-            } catch {}
-            // TODO: Consider passing the model to the graph as an
-            // input side packet as this might reduce copies.
-            this.graphRunner.wasmModule.FS_createDataFile(
-              '/',
-              'model.dat',
-              new Uint8Array(buffer),
-              /* canRead= */ true,
-              /* canWrite= */ false,
-              /* canOwn= */ false,
-            );
-            this.setExternalFile('/model.dat');
-            this.refreshGraph();
-            this.onGraphRefreshed();
-          });
+        return fetchModelAsset(
+          baseOptions.modelAssetPath.toString(),
+          baseOptions.modelAssetCacheName,
+        ).then((buffer) => {
+          try {
+            // Try to delete file as we cannot overwrite an existing file
+            // using our current API.
+            this.graphRunner.wasmModule.FS_unlink('/model.dat');
+          } catch {}
+          // TODO: Consider passing the model to the graph as an
+          // input side packet as this might reduce copies.
+          this.graphRunner.wasmModule.FS_createDataFile(
+            '/',
+            'model.dat',
+            new Uint8Array(buffer),
+            /* canRead= */ true,
+            /* canWrite= */ false,
+            /* canOwn= */ false,
+          );
+          this.setExternalFile('/model.dat');
+          this.refreshGraph();
+          this.onGraphRefreshed();
+        });
       } else if (baseOptions.modelAssetBuffer instanceof Uint8Array) {
         this.setExternalFile(baseOptions.modelAssetBuffer);
       } else if (baseOptions.modelAssetBuffer) {
@@ -417,3 +410,48 @@ async function streamToUint8Array(
 }
 
 
+
+/**
+ * Opens the Cache Storage bucket `cacheName`. Returns `undefined` if no name is
+ * given or the Cache Storage API is unavailable (e.g. in insecure contexts).
+ */
+async function openModelAssetCache(
+  cacheName?: string,
+): Promise<Cache | undefined> {
+  if (!cacheName || typeof caches === 'undefined') {
+    return undefined;
+  }
+  try {
+    return await caches.open(cacheName);
+  } catch {
+    return undefined;
+  }
+}
+
+/**
+ * Downloads the model asset at `url`. If `cacheName` is provided, the model is
+ * served from that Cache Storage bucket when present and added to it after a
+ * download. Cache failures fall back to (or only skip storing after) the
+ * download.
+ */
+async function fetchModelAsset(
+  url: string,
+  cacheName?: string,
+): Promise<ArrayBuffer> {
+  const cache = await openModelAssetCache(cacheName);
+  const cachedResponse = await cache?.match(url).catch(() => undefined);
+  if (cachedResponse) {
+    return cachedResponse.arrayBuffer();
+  }
+
+  const response = await fetch(url);
+  if (!response.ok) {
+    throw new Error(`Failed to fetch model: ${url} (${response.status})`);
+  }
+  if (cache) {
+    try {
+      await cache.put(url, response.clone());
+    } catch {}
+  }
+  return response.arrayBuffer();
+}
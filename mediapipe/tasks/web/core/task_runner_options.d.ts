@@ -30,6 +30,15 @@ export declare interface BaseOptions {
    */
   modelAssetBuffer?: Uint8Array | ReadableStreamDefaultReader | undefined;
 
+  /**
+   * The name of a Cache Storage bucket to keep the model asset in. If set, the
+   * model referenced by `modelAssetPath` is read from this cache when present
+   * and stored in it after it has been downloaded, so that repeat page loads
+   * skip the download. Ignored for `modelAssetBuffer` and if the Cache Storage
+   * API is unavailable.
+   */
+  modelAssetCacheName?: string | undefined;
+
   /** Overrides the default backend to use for the provided model. */
   delegate?: 'CPU' | 'GPU' | undefined;
 }
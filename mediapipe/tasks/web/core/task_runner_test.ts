@@ -400,6 +400,47 @@ describe('TaskRunner', () => {
     return resolvedPromise;
   });
 
+  it('reads model from the cache once it has been downloaded', async () => {
+    const cachedResponses = new Map<string, Response>();
+    const cache = {
+      match: jasmine
+        .createSpy()
+        .and.callFake(async (url: string) => cachedResponses.get(url)),
+      put: jasmine
+        .createSpy()
+        .and.callFake(async (url: string, response: Response) => {
+          cachedResponses.set(url, response);
+        }),
+    };
+    fetchSpy.and.callFake(async () => {
+      const response = {
+        arrayBuffer: () => mockBytes.buffer,
+        ok: true,
+        status: 200,
+        clone: () => response,
+      };
+      return response as unknown as Response;
+    });
+    const oldCaches = global.caches;
+    global.caches = {
+      open: jasmine.createSpy().and.resolveTo(cache),
+    } as unknown as CacheStorage;
+
+    try {
+      const baseOptions = {modelAssetPath: `foo`, modelAssetCacheName: `bar`};
+      await taskRunner.setOptions({baseOptions});
+      await taskRunner.setOptions({baseOptions});
+
+      expect(global.caches.open).toHaveBeenCalledWith('bar');
+      expect(cache.put).toHaveBeenCalledTimes(1);
+      expect(fetchSpy).toHaveBeenCalledTimes(1);
+      expect(taskRunner.wasmModule.FS_createDataFile).toHaveBeenCalledTimes(2);
+      expect(taskRunner.baseOptions.toObject()).toEqual(mockFileResult);
+    } finally {
+      global.caches = oldCaches;
+    }
+  });
+
   it('returns custom error if model download failed', () => {
     fetchStatus = 404;
     return expectAsync(
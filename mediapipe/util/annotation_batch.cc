@@ -0,0 +1,319 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/annotation_batch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "mediapipe/util/color.pb.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+// Number of segments an oval outline is approximated with.
+constexpr int kOvalSegments = 48;
+
+// Same proportion as in AnnotationRenderer::DrawArrow.
+constexpr float kArrowTipLengthProportion = 0.2f;
+
+float ClampThickness(float thickness) {
+  constexpr float kMaxThickness = 32767;  // OpenCV MAX_THICKNESS
+  return std::clamp(std::round(thickness), 1.0f, kMaxThickness);
+}
+
+}  // namespace
+
+void AnnotationBatch::Reset(int image_width, int image_height) {
+  image_width_ = image_width;
+  image_height_ = image_height;
+  vertices_.clear();
+}
+
+bool AnnotationBatch::IsSupported(const RenderAnnotation& annotation) {
+  switch (annotation.data_case()) {
+    case RenderAnnotation::kRectangle:
+    case RenderAnnotation::kFilledRectangle:
+    case RenderAnnotation::kOval:
+    case RenderAnnotation::kFilledOval:
+    case RenderAnnotation::kPoint:
+    case RenderAnnotation::kLine:
+    case RenderAnnotation::kGradientLine:
+    case RenderAnnotation::kArrow:
+    case RenderAnnotation::kScribble:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool AnnotationBatch::Append(const RenderData& render_data) {
+  for (const auto& annotation : render_data.render_annotations()) {
+    if (!IsSupported(annotation)) return false;
+  }
+  for (const auto& annotation : render_data.render_annotations()) {
+    AddAnnotation(annotation);
+  }
+  return true;
+}
+
+void AnnotationBatch::AddAnnotation(const RenderAnnotation& annotation) {
+  const Rgb color = {annotation.color().r() / 255.0f,
+                     annotation.color().g() / 255.0f,
+                     annotation.color().b() / 255.0f};
+  const float thickness = ClampThickness(annotation.thickness());
+  switch (annotation.data_case()) {
+    case RenderAnnotation::kRectangle:
+      AddRectangle(annotation.rectangle(), color, thickness);
+      break;
+    case RenderAnnotation::kFilledRectangle:
+      AddFilledRectangle(annotation.filled_rectangle().rectangle(), color);
+      break;
+    case RenderAnnotation::kOval:
+      AddOval(annotation.oval().rectangle(), color, thickness);
+      break;
+    case RenderAnnotation::kFilledOval:
+      AddFilledOval(annotation.filled_oval().oval().rectangle(), color);
+      break;
+    case RenderAnnotation::kPoint: {
+      const auto& point = annotation.point();
+      AddDisc(ToPixel(point.x(), point.y(), point.normalized()), thickness,
+              thickness, 0.0f, color);
+      break;
+    }
+    case RenderAnnotation::kScribble:
+      for (const auto& point : annotation.scribble().point()) {
+        AddDisc(ToPixel(point.x(), point.y(), point.normalized()), thickness,
+                thickness, 0.0f, color);
+      }
+      break;
+    case RenderAnnotation::kLine: {
+      const auto& line = annotation.line();
+      AddRoundCappedSegment(
+          ToPixel(line.x_start(), line.y_start(), line.normalized()),
+          ToPixel(line.x_end(), line.y_end(), line.normalized()), thickness,
+          color);
+      break;
+    }
+    case RenderAnnotation::kGradientLine: {
+      const auto& line = annotation.gradient_line();
+      const Rgb color1 = {line.color1().r() / 255.0f,
+                          line.color1().g() / 255.0f,
+                          line.color1().b() / 255.0f};
+      const Rgb color2 = {line.color2().r() / 255.0f,
+                          line.color2().g() / 255.0f,
+                          line.color2().b() / 255.0f};
+      AddSegment(ToPixel(line.x_start(), line.y_start(), line.normalized()),
+                 ToPixel(line.x_end(), line.y_end(), line.normalized()),
+                 thickness, /*extend=*/0.0f, color1, color2);
+      break;
+    }
+    case RenderAnnotation::kArrow:
+      AddArrow(annotation.arrow(), color, thickness);
+      break;
+    default:
+      break;
+  }
+}
+
+void AnnotationBatch::AddRectangle(const RenderAnnotation::Rectangle& rectangle,
+                                   Rgb color, float thickness) {
+  Point2 top_left, bottom_right;
+  ToPixelRect(rectangle, &top_left, &bottom_right);
+  const Point2 center = {(top_left.x + bottom_right.x) / 2,
+                         (top_left.y + bottom_right.y) / 2};
+  const float half_width = (bottom_right.x - top_left.x) / 2;
+  const float half_height = (bottom_right.y - top_left.y) / 2;
+  const float cos_r = std::cos(rectangle.rotation());
+  const float sin_r = std::sin(rectangle.rotation());
+  // Corners in the order of cv::RotatedRect::points(): bottom-left, top-left,
+  // top-right, bottom-right.
+  const float offsets[4][2] = {{-half_width, half_height},
+                               {-half_width, -half_height},
+                               {half_width, -half_height},
+                               {half_width, half_height}};
+  Point2 corners[4];
+  for (int i = 0; i < 4; ++i) {
+    corners[i] = {center.x + cos_r * offsets[i][0] - sin_r * offsets[i][1],
+                  center.y + sin_r * offsets[i][0] + cos_r * offsets[i][1]};
+  }
+  // Lengthen the edges by half the thickness so that the corners are square.
+  for (int i = 0; i < 4; ++i) {
+    AddSegment(corners[i], corners[(i + 1) % 4], thickness, thickness / 2,
+               color, color);
+  }
+  if (rectangle.has_top_left_thickness()) {
+    const float radius = ClampThickness(rectangle.top_left_thickness());
+    AddDisc(corners[1], radius, radius, 0.0f, color);
+  }
+}
+
+void AnnotationBatch::AddFilledRectangle(
+    const RenderAnnotation::Rectangle& rectangle, Rgb color) {
+  Point2 top_left, bottom_right;
+  ToPixelRect(rectangle, &top_left, &bottom_right);
+  const Point2 center = {(top_left.x + bottom_right.x) / 2,
+                         (top_left.y + bottom_right.y) / 2};
+  const float half_width = (bottom_right.x - top_left.x) / 2;
+  const float half_height = (bottom_right.y - top_left.y) / 2;
+  const float cos_r = std::cos(rectangle.rotation());
+  const float sin_r = std::sin(rectangle.rotation());
+  const float offsets[4][2] = {{-half_width, -half_height},
+                               {half_width, -half_height},
+                               {half_width, half_height},
+                               {-half_width, half_height}};
+  Point2 corners[4];
+  for (int i = 0; i < 4; ++i) {
+    corners[i] = {center.x + cos_r * offsets[i][0] - sin_r * offsets[i][1],
+                  center.y + sin_r * offsets[i][0] + cos_r * offsets[i][1]};
+  }
+  const Rgb colors[4] = {color, color, color, color};
+  AddQuad(corners, colors, /*disc=*/false);
+}
+
+void AnnotationBatch::AddOval(const RenderAnnotation::Rectangle& rectangle,
+                              Rgb color, float thickness) {
+  Point2 top_left, bottom_right;
+  ToPixelRect(rectangle, &top_left, &bottom_right);
+  const Point2 center = {(top_left.x + bottom_right.x) / 2,
+                         (top_left.y + bottom_right.y) / 2};
+  const float rx = (bottom_right.x - top_left.x) / 2;
+  const float ry = (bottom_right.y - top_left.y) / 2;
+  const float cos_r = std::cos(rectangle.rotation());
+  const float sin_r = std::sin(rectangle.rotation());
+  Point2 previous;
+  for (int i = 0; i <= kOvalSegments; ++i) {
+    const float angle = 2.0f * static_cast<float>(M_PI) * i / kOvalSegments;
+    const float x = rx * std::cos(angle);
+    const float y = ry * std::sin(angle);
+    const Point2 current = {center.x + cos_r * x - sin_r * y,
+                            center.y + sin_r * x + cos_r * y};
+    if (i > 0) {
+      // Overlap consecutive segments slightly to avoid cracks at the joints.
+      AddSegment(previous, current, thickness, thickness / 4, color, color);
+    }
+    previous = current;
+  }
+}
+
+void AnnotationBatch::AddFilledOval(
+    const RenderAnnotation::Rectangle& rectangle, Rgb color) {
+  Point2 top_left, bottom_right;
+  ToPixelRect(rectangle, &top_left, &bottom_right);
+  const Point2 center = {(top_left.x + bottom_right.x) / 2,
+                         (top_left.y + bottom_right.y) / 2};
+  AddDisc(center, std::max(0.0f, (bottom_right.x - top_left.x) / 2),
+          std::max(0.0f, (bottom_right.y - top_left.y) / 2),
+          rectangle.rotation(), color);
+}
+
+void AnnotationBatch::AddArrow(const RenderAnnotation::Arrow& arrow, Rgb color,
+                               float thickness) {
+  const Point2 start =
+      ToPixel(arrow.x_start(), arrow.y_start(), arrow.normalized());
+  const Point2 end = ToPixel(arrow.x_end(), arrow.y_end(), arrow.normalized());
+  AddRoundCappedSegment(start, end, thickness, color);
+
+  const float dx = end.x - start.x;
+  const float dy = end.y - start.y;
+  const float length = std::sqrt(dx * dx + dy * dy);
+  if (length == 0.0f) return;
+  // U is the unit direction of the arrow and V = U.Ortho(), as in
+  // AnnotationRenderer::DrawArrow.
+  const float ux = dx / length;
+  const float uy = dy / length;
+  const float vx = -uy;
+  const float vy = ux;
+  const float tip = kArrowTipLengthProportion * length;
+  const Point2 tip_left = {end.x - tip * ux + tip * vx,
+                           end.y - tip * uy + tip * vy};
+  const Point2 tip_right = {end.x - tip * ux - tip * vx,
+                            end.y - tip * uy - tip * vy};
+  AddRoundCappedSegment(tip_left, end, thickness, color);
+  AddRoundCappedSegment(tip_right, end, thickness, color);
+}
+
+void AnnotationBatch::AddSegment(Point2 p0, Point2 p1, float width,
+                                 float extend, Rgb c0, Rgb c1) {
+  const float dx = p1.x - p0.x;
+  const float dy = p1.y - p0.y;
+  const float length = std::sqrt(dx * dx + dy * dy);
+  if (length == 0.0f) return;
+  const float ux = dx / length;
+  const float uy = dy / length;
+  const float nx = -uy * width / 2;
+  const float ny = ux * width / 2;
+  p0 = {p0.x - ux * extend, p0.y - uy * extend};
+  p1 = {p1.x + ux * extend, p1.y + uy * extend};
+  const Point2 corners[4] = {{p0.x + nx, p0.y + ny},
+                             {p0.x - nx, p0.y - ny},
+                             {p1.x - nx, p1.y - ny},
+                             {p1.x + nx, p1.y + ny}};
+  const Rgb colors[4] = {c0, c0, c1, c1};
+  AddQuad(corners, colors, /*disc=*/false);
+}
+
+void AnnotationBatch::AddRoundCappedSegment(Point2 p0, Point2 p1, float width,
+                                            Rgb color) {
+  AddSegment(p0, p1, width, /*extend=*/0.0f, color, color);
+  if (width > 1.0f) {
+    AddDisc(p0, width / 2, width / 2, 0.0f, color);
+    AddDisc(p1, width / 2, width / 2, 0.0f, color);
+  }
+}
+
+void AnnotationBatch::AddDisc(Point2 center, float rx, float ry,
+                              float rotation, Rgb color) {
+  const float cos_r = std::cos(rotation);
+  const float sin_r = std::sin(rotation);
+  const float offsets[4][2] = {{-rx, -ry}, {rx, -ry}, {rx, ry}, {-rx, ry}};
+  Point2 corners[4];
+  for (int i = 0; i < 4; ++i) {
+    corners[i] = {center.x + cos_r * offsets[i][0] - sin_r * offsets[i][1],
+                  center.y + sin_r * offsets[i][0] + cos_r * offsets[i][1]};
+  }
+  const Rgb colors[4] = {color, color, color, color};
+  AddQuad(corners, colors, /*disc=*/true);
+}
+
+void AnnotationBatch::AddQuad(const Point2 p[4], const Rgb c[4], bool disc) {
+  // Corners of the unit square in the same winding as p.
+  static constexpr float kDiscCoordinates[4][2] = {
+      {-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+  static constexpr int kIndices[6] = {0, 1, 2, 0, 2, 3};
+  for (int index : kIndices) {
+    const float u = disc ? kDiscCoordinates[index][0] : 0.0f;
+    const float v = disc ? kDiscCoordinates[index][1] : 0.0f;
+    vertices_.push_back({p[index].x, p[index].y, c[index].r, c[index].g,
+                         c[index].b, u, v});
+  }
+}
+
+AnnotationBatch::Point2 AnnotationBatch::ToPixel(float x, float y,
+                                                 bool normalized) const {
+  if (normalized) return {x * image_width_, y * image_height_};
+  return {x, y};
+}
+
+void AnnotationBatch::ToPixelRect(const RenderAnnotation::Rectangle& rectangle,
+                                  Point2* top_left,
+                                  Point2* bottom_right) const {
+  *top_left =
+      ToPixel(rectangle.left(), rectangle.top(), rectangle.normalized());
+  *bottom_right =
+      ToPixel(rectangle.right(), rectangle.bottom(), rectangle.normalized());
+}
+
+}  // namespace mediapipe
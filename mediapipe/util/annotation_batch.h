@@ -0,0 +1,119 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_ANNOTATION_BATCH_H_
+#define MEDIAPIPE_UTIL_ANNOTATION_BATCH_H_
+
+#include <vector>
+
+#include "mediapipe/util/color.pb.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+
+// A vertex of the triangle list produced by AnnotationBatch.
+//
+// x, y: position in pixels, with the origin at the top-left image corner.
+// r, g, b: color in [0, 1].
+// u, v: position within the shape. Fragments with u * u + v * v > 1 are to be
+//   discarded, which turns a quad into a disc. Solid shapes use (0, 0).
+struct AnnotationVertex {
+  float x;
+  float y;
+  float r;
+  float g;
+  float b;
+  float u;
+  float v;
+};
+
+// Converts RenderData into a single triangle list, so that all the annotations
+// of a frame can be drawn on the GPU with one draw call, in order.
+//
+// Points, scribbles, lines, gradient lines, arrows, rectangles, filled
+// rectangles, ovals and filled ovals are supported, and follow the geometry of
+// AnnotationRenderer. Text and rounded rectangles are not: Append() rejects
+// RenderData containing them, and the caller is expected to fall back to
+// AnnotationRenderer.
+//
+// Example usage:
+//
+// AnnotationBatch batch;
+// batch.Reset(image_width, image_height);
+// if (batch.Append(render_data)) {
+//   <UPLOAD batch.vertices() AND DRAW THEM AS GL_TRIANGLES>
+// }
+class AnnotationBatch {
+ public:
+  // Clears the batch and sets the image size in pixels, which is used to
+  // convert normalized coordinates.
+  void Reset(int image_width, int image_height);
+
+  // Returns whether the annotation can be added to the batch.
+  static bool IsSupported(const RenderAnnotation& annotation);
+
+  // Appends the triangles of all annotations in render_data. Returns false and
+  // leaves the batch unchanged if any annotation is not supported.
+  bool Append(const RenderData& render_data);
+
+  const std::vector<AnnotationVertex>& vertices() const { return vertices_; }
+  bool empty() const { return vertices_.empty(); }
+
+ private:
+  struct Point2 {
+    float x;
+    float y;
+  };
+  struct Rgb {
+    float r;
+    float g;
+    float b;
+  };
+
+  void AddAnnotation(const RenderAnnotation& annotation);
+  void AddRectangle(const RenderAnnotation::Rectangle& rectangle, Rgb color,
+                    float thickness);
+  void AddFilledRectangle(const RenderAnnotation::Rectangle& rectangle,
+                          Rgb color);
+  void AddOval(const RenderAnnotation::Rectangle& rectangle, Rgb color,
+               float thickness);
+  void AddFilledOval(const RenderAnnotation::Rectangle& rectangle, Rgb color);
+  void AddArrow(const RenderAnnotation::Arrow& arrow, Rgb color,
+                float thickness);
+
+  // Adds a segment of the given width from p0 to p1, lengthened by extend on
+  // both ends. The color is interpolated from c0 to c1.
+  void AddSegment(Point2 p0, Point2 p1, float width, float extend, Rgb c0,
+                  Rgb c1);
+  // Adds a segment with round caps, like cv::line.
+  void AddRoundCappedSegment(Point2 p0, Point2 p1, float width, Rgb color);
+  // Adds a disc, or an ellipse with radii rx and ry rotated by rotation
+  // radians.
+  void AddDisc(Point2 center, float rx, float ry, float rotation, Rgb color);
+  // Adds the quad p0-p1-p2-p3 as two triangles. If disc is true, the quad is
+  // cut to its inscribed ellipse.
+  void AddQuad(const Point2 p[4], const Rgb c[4], bool disc);
+
+  Point2 ToPixel(float x, float y, bool normalized) const;
+  void ToPixelRect(const RenderAnnotation::Rectangle& rectangle,
+                   Point2* top_left, Point2* bottom_right) const;
+
+  int image_width_ = 0;
+  int image_height_ = 0;
+  std::vector<AnnotationVertex> vertices_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_ANNOTATION_BATCH_H_
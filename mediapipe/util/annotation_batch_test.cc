@@ -0,0 +1,120 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/annotation_batch.h"
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/parse_text_proto.h"
+#include "mediapipe/util/render_data.pb.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::FloatEq;
+using ::testing::SizeIs;
+
+constexpr int kVerticesPerQuad = 6;
+
+TEST(AnnotationBatchTest, PointIsDiscOfThicknessRadius) {
+  const RenderData render_data = ParseTextProtoOrDie<RenderData>(R"pb(
+    render_annotations {
+      thickness: 3
+      color { r: 255 g: 0 b: 51 }
+      point { x: 0.5 y: 0.25 normalized: true }
+    }
+  )pb");
+  AnnotationBatch batch;
+  batch.Reset(/*image_width=*/200, /*image_height=*/100);
+  ASSERT_TRUE(batch.Append(render_data));
+
+  ASSERT_THAT(batch.vertices(), SizeIs(kVerticesPerQuad));
+  const AnnotationVertex& top_left = batch.vertices()[0];
+  EXPECT_THAT(top_left.x, FloatEq(97.0f));
+  EXPECT_THAT(top_left.y, FloatEq(22.0f));
+  EXPECT_THAT(top_left.u, FloatEq(-1.0f));
+  EXPECT_THAT(top_left.v, FloatEq(-1.0f));
+  EXPECT_THAT(top_left.r, FloatEq(1.0f));
+  EXPECT_THAT(top_left.g, FloatEq(0.0f));
+  EXPECT_THAT(top_left.b, FloatEq(0.2f));
+  const AnnotationVertex& bottom_right = batch.vertices()[2];
+  EXPECT_THAT(bottom_right.x, FloatEq(103.0f));
+  EXPECT_THAT(bottom_right.y, FloatEq(28.0f));
+}
+
+TEST(AnnotationBatchTest, FilledRectangleIsSolidQuad) {
+  const RenderData render_data = ParseTextProtoOrDie<RenderData>(R"pb(
+    render_annotations {
+      filled_rectangle {
+        rectangle { left: 10 top: 20 right: 30 bottom: 60 }
+      }
+    }
+  )pb");
+  AnnotationBatch batch;
+  batch.Reset(/*image_width=*/200, /*image_height=*/100);
+  ASSERT_TRUE(batch.Append(render_data));
+
+  ASSERT_THAT(batch.vertices(), SizeIs(kVerticesPerQuad));
+  for (const AnnotationVertex& vertex : batch.vertices()) {
+    EXPECT_THAT(vertex.u, FloatEq(0.0f));
+    EXPECT_THAT(vertex.v, FloatEq(0.0f));
+  }
+  EXPECT_THAT(batch.vertices()[0].x, FloatEq(10.0f));
+  EXPECT_THAT(batch.vertices()[0].y, FloatEq(20.0f));
+  EXPECT_THAT(batch.vertices()[2].x, FloatEq(30.0f));
+  EXPECT_THAT(batch.vertices()[2].y, FloatEq(60.0f));
+}
+
+TEST(AnnotationBatchTest, ThinLineIsSingleQuad) {
+  const RenderData render_data = ParseTextProtoOrDie<RenderData>(R"pb(
+    render_annotations {
+      thickness: 1
+      line { x_start: 0 y_start: 10 x_end: 50 y_end: 10 }
+    }
+    render_annotations {
+      thickness: 4
+      line { x_start: 0 y_start: 10 x_end: 50 y_end: 10 }
+    }
+  )pb");
+  AnnotationBatch batch;
+  batch.Reset(/*image_width=*/200, /*image_height=*/100);
+  ASSERT_TRUE(batch.Append(render_data));
+
+  // The thick line gets round caps.
+  EXPECT_THAT(batch.vertices(), SizeIs(4 * kVerticesPerQuad));
+  EXPECT_THAT(batch.vertices()[0].y, FloatEq(10.5f));
+  EXPECT_THAT(batch.vertices()[1].y, FloatEq(9.5f));
+}
+
+TEST(AnnotationBatchTest, RejectsTextAndKeepsBatch) {
+  const RenderData points = ParseTextProtoOrDie<RenderData>(R"pb(
+    render_annotations { point { x: 1 y: 1 } }
+  )pb");
+  const RenderData text = ParseTextProtoOrDie<RenderData>(R"pb(
+    render_annotations { point { x: 1 y: 1 } }
+    render_annotations { text { display_text: "label" } }
+  )pb");
+  AnnotationBatch batch;
+  batch.Reset(/*image_width=*/200, /*image_height=*/100);
+  ASSERT_TRUE(batch.Append(points));
+
+  EXPECT_FALSE(batch.Append(text));
+  EXPECT_THAT(batch.vertices(), SizeIs(kVerticesPerQuad));
+
+  batch.Reset(/*image_width=*/200, /*image_height=*/100);
+  EXPECT_TRUE(batch.empty());
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -15,6 +15,7 @@
 #include "mediapipe/util/audio_decoder.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstdint>  // required by avutil.h
 #include <cstdlib>
 #include <memory>
@@ -27,7 +28,9 @@
 #include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "audio/dsp/resampler_q.h"
 #include "mediapipe/framework/deps/cleanup.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/port/map_util.h"
@@ -60,6 +63,9 @@ const int64_t kMpegPtsEpoch = 1LL << 33;
 // the MPEG PTS has rolled over. Unit is PTS ticks.
 const int64_t kMpegPtsMaxDelta = kMpegPtsEpoch / 2;
 
+// Maximum number of released Matrix buffers kept by a MatrixPool.
+const int kMaxPooledMatrices = 16;
+
 // BasePacketProcessor
 namespace {
 
@@ -319,6 +325,35 @@ int64_t BasePacketProcessor::CorrectPtsForRollover(int64_t media_pts) {
   return rollover_corrected_last_pts_;
 }
 
+// MatrixPool
+std::unique_ptr<Matrix> MatrixPool::Acquire(int rows, int cols) {
+  std::unique_ptr<Matrix> matrix;
+  {
+    absl::MutexLock lock(&mutex_);
+    if (!released_.empty()) {
+      matrix = std::move(released_.back());
+      released_.pop_back();
+    }
+  }
+  if (!matrix) {
+    return absl::make_unique<Matrix>(rows, cols);
+  }
+  // Keeps the allocation if the size didn't change.
+  matrix->resize(rows, cols);
+  return matrix;
+}
+
+Packet MatrixPool::MakePacket(std::unique_ptr<Matrix> matrix) {
+  const Matrix* data = matrix.get();
+  return PointToForeign(
+      data, [pool = shared_from_this(), matrix = std::move(matrix)]() mutable {
+        absl::MutexLock lock(&pool->mutex_);
+        if (pool->released_.size() < kMaxPooledMatrices) {
+          pool->released_.push_back(std::move(matrix));
+        }
+      });
+}
+
 // AudioPacketProcessor
 namespace {
 
@@ -372,6 +407,21 @@ absl::Status AudioPacketProcessor::Open(int id, AVStream* stream) {
 
   sample_time_base_ = {1, static_cast<int>(sample_rate_)};
 
+  output_num_channels_ = options_.downmix_to_mono() ? 1 : num_channels_;
+  output_sample_rate_ = sample_rate_;
+  if (options_.has_target_sample_rate() &&
+      options_.target_sample_rate() != sample_rate_) {
+    resampler_ = absl::make_unique<audio_dsp::QResampler<float>>(
+        sample_rate_, options_.target_sample_rate(), output_num_channels_);
+    RET_CHECK(resampler_->Valid())
+        << "Failed to resample from " << sample_rate_ << " to "
+        << options_.target_sample_rate();
+    output_sample_rate_ = options_.target_sample_rate();
+  }
+  if (options_.reuse_output_buffers()) {
+    pool_ = std::make_shared<MatrixPool>();
+  }
+
   VLOG(0) << absl::Substitute(
       "Opened audio stream (id: $0, channels: $1, sample rate: $2, time base: "
       "$3/$4).",
@@ -493,7 +543,16 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
       buf_size_bytes / bytes_per_sample_ / num_channels_;
   VLOG(3) << "Adding " << num_samples << " audio samples in " << num_channels_
           << " channels to output.";
-  auto current_frame = absl::make_unique<Matrix>(num_channels_, num_samples);
+  // Samples that are downmixed or resampled are decoded into a scratch
+  // buffer first, the others directly into the output frame.
+  std::unique_ptr<Matrix> current_frame;
+  Matrix* samples = &decoded_audio_;
+  if (options_.downmix_to_mono() || resampler_) {
+    decoded_audio_.resize(num_channels_, num_samples);
+  } else {
+    current_frame = NewOutputMatrix(num_channels_, num_samples);
+    samples = current_frame.get();
+  }
 
   const char* sample_ptr = nullptr;
   switch (avcodec_ctx_->sample_fmt) {
@@ -502,7 +561,7 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
       for (int64_t sample_index = 0; sample_index < num_samples;
            ++sample_index) {
         for (int channel = 0; channel < num_channels_; ++channel) {
-          (*current_frame)(channel, sample_index) =
+          (*samples)(channel, sample_index) =
               PcmEncodedSampleToFloat(sample_ptr);
           sample_ptr += bytes_per_sample_;
         }
@@ -513,7 +572,7 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
       for (int64_t sample_index = 0; sample_index < num_samples;
            ++sample_index) {
         for (int channel = 0; channel < num_channels_; ++channel) {
-          (*current_frame)(channel, sample_index) =
+          (*samples)(channel, sample_index) =
               PcmEncodedSampleInt32ToFloat(sample_ptr);
           sample_ptr += bytes_per_sample_;
         }
@@ -524,7 +583,7 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
       for (int64_t sample_index = 0; sample_index < num_samples;
            ++sample_index) {
         for (int channel = 0; channel < num_channels_; ++channel) {
-          (*current_frame)(channel, sample_index) =
+          (*samples)(channel, sample_index) =
               Uint32ToFloat(absl::little_endian::Load32(sample_ptr));
           sample_ptr += bytes_per_sample_;
         }
@@ -535,7 +594,7 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
         sample_ptr = reinterpret_cast<const char*>(raw_audio[channel]);
         for (int64_t sample_index = 0; sample_index < num_samples;
              ++sample_index) {
-          (*current_frame)(channel, sample_index) =
+          (*samples)(channel, sample_index) =
               PcmEncodedSampleToFloat(sample_ptr);
           sample_ptr += bytes_per_sample_;
         }
@@ -546,7 +605,7 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
         sample_ptr = reinterpret_cast<const char*>(raw_audio[channel]);
         for (int64_t sample_index = 0; sample_index < num_samples;
              ++sample_index) {
-          (*current_frame)(channel, sample_index) =
+          (*samples)(channel, sample_index) =
               Uint32ToFloat(absl::little_endian::Load32(sample_ptr));
           sample_ptr += bytes_per_sample_;
         }
@@ -557,10 +616,67 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
              << "sample_fmt = " << avcodec_ctx_->sample_fmt;
   }
 
+  Timestamp frame_timestamp = output_timestamp;
+  if (!current_frame) {
+    current_frame =
+        ConvertDecodedAudio(/*flush_resampler=*/false, &frame_timestamp);
+  }
+  AppendToBuffer(frame_timestamp, std::move(current_frame));
+  expected_sample_number_ += num_samples;
+
+  return absl::OkStatus();
+}
+
+std::unique_ptr<Matrix> AudioPacketProcessor::NewOutputMatrix(int rows,
+                                                              int cols) {
+  if (pool_) {
+    return pool_->Acquire(rows, cols);
+  }
+  return absl::make_unique<Matrix>(rows, cols);
+}
+
+std::unique_ptr<Matrix> AudioPacketProcessor::ConvertDecodedAudio(
+    bool flush_resampler, Timestamp* output_timestamp) {
+  if (!resampler_) {
+    auto frame = NewOutputMatrix(1, decoded_audio_.cols());
+    *frame = decoded_audio_.colwise().mean();
+    return frame;
+  }
+
+  auto frame = NewOutputMatrix(output_num_channels_, 0);
+  if (flush_resampler) {
+    resampler_->Flush(frame.get());
+  } else if (options_.downmix_to_mono()) {
+    downmixed_audio_ = decoded_audio_.colwise().mean();
+    resampler_->ProcessSamples(downmixed_audio_, frame.get());
+  } else {
+    resampler_->ProcessSamples(decoded_audio_, frame.get());
+  }
+  // The resampler delays samples across frames, so the timestamps follow the
+  // number of resampled samples rather than the source frames.
+  if (first_resampled_timestamp_ == Timestamp::Unset()) {
+    first_resampled_timestamp_ = *output_timestamp;
+  }
+  *output_timestamp =
+      first_resampled_timestamp_ +
+      TimestampDiff(std::llround(num_resampled_samples_ / output_sample_rate_ *
+                                 Timestamp::kTimestampUnitsPerSecond));
+  num_resampled_samples_ += frame->cols();
+  return frame;
+}
+
+void AudioPacketProcessor::AppendToBuffer(Timestamp output_timestamp,
+                                          std::unique_ptr<Matrix> frame) {
+  // The resampler may not output any samples for short frames.
+  if (resampler_ && frame->cols() == 0) {
+    return;
+  }
   if (options_.output_regressing_timestamps() ||
       last_timestamp_ == Timestamp::Unset() ||
       output_timestamp > last_timestamp_) {
-    buffer_.push_back(Adopt(current_frame.release()).At(output_timestamp));
+    buffer_.push_back(
+        (pool_ ? pool_->MakePacket(std::move(frame)) : Adopt(frame.release()))
+            .At(output_timestamp));
     last_timestamp_ = output_timestamp;
     if (last_frame_time_regression_detected_) {
       last_frame_time_regression_detected_ = false;
@@ -574,15 +690,23 @@ absl::Status AudioPacketProcessor::AddAudioDataToBuffer(
                        "regressed.  Was "
                     << last_timestamp_ << " but got " << output_timestamp;
   }
-  expected_sample_number_ += num_samples;
+}
 
+absl::Status AudioPacketProcessor::Flush() {
+  MP_RETURN_IF_ERROR(BasePacketProcessor::Flush());
+  if (resampler_ && first_resampled_timestamp_ != Timestamp::Unset()) {
+    Timestamp output_timestamp = first_resampled_timestamp_;
+    auto frame =
+        ConvertDecodedAudio(/*flush_resampler=*/true, &output_timestamp);
+    AppendToBuffer(output_timestamp, std::move(frame));
+  }
   return absl::OkStatus();
 }
 
 absl::Status AudioPacketProcessor::FillHeader(TimeSeriesHeader* header) const {
   ABSL_CHECK(header);
-  header->set_sample_rate(sample_rate_);
-  header->set_num_channels(num_channels_);
+  header->set_sample_rate(output_sample_rate_);
+  header->set_num_channels(output_num_channels_);
   return absl::OkStatus();
 }
 
@@ -17,11 +17,15 @@
 
 #include <cstdint>  // required by avutil.h
 #include <deque>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "absl/flags/flag.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "audio/dsp/resampler_q.h"
+#include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/formats/time_series_header.pb.h"
 #include "mediapipe/framework/packet.h"
 #include "mediapipe/framework/port/status.h"
@@ -64,7 +68,7 @@ class BasePacketProcessor {
 
   // Once no more AVPackets are available in the file, each stream must
   // be flushed to get any remaining frames which the codec is buffering.
-  absl::Status Flush();
+  virtual absl::Status Flush();
 
   // Closes the Processor, this does not close the file.  You may not
   // call ProcessPacket() after calling Close().  Close() may be called
@@ -126,6 +130,22 @@ class BasePacketProcessor {
   std::deque<Packet> buffer_;
 };
 
+// Pool of the output Matrix buffers of an AudioPacketProcessor. A Matrix
+// returns to the pool once the last packet referring to it is released.
+class MatrixPool : public std::enable_shared_from_this<MatrixPool> {
+ public:
+  // Returns a Matrix of the given size, reusing a released one if available.
+  std::unique_ptr<Matrix> Acquire(int rows, int cols);
+
+  // Returns a packet which holds `matrix` and returns it to the pool once the
+  // packet is released.
+  Packet MakePacket(std::unique_ptr<Matrix> matrix);
+
+ private:
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<Matrix>> released_ ABSL_GUARDED_BY(mutex_);
+};
+
 // Class which decodes packets from a single audio stream.
 class AudioPacketProcessor : public BasePacketProcessor {
  public:
@@ -135,6 +155,9 @@ class AudioPacketProcessor : public BasePacketProcessor {
 
   absl::Status ProcessPacket(AVPacket* packet) override;
 
+  // Also flushes the samples buffered by the resampler, if any.
+  absl::Status Flush() override;
+
   absl::Status FillHeader(TimeSeriesHeader* header) const;
 
  private:
@@ -143,6 +166,20 @@ class AudioPacketProcessor : public BasePacketProcessor {
                                     uint8_t* const* raw_audio,
                                     int buf_size_bytes);
 
+  // Downmixes and resamples decoded_audio_ as requested by the options, or
+  // only flushes the resampler. Updates `output_timestamp` for resampled
+  // audio.
+  std::unique_ptr<Matrix> ConvertDecodedAudio(bool flush_resampler,
+                                              Timestamp* output_timestamp);
+
+  // Appends a frame to the output buffer (buffer_), unless its timestamp
+  // regressed.
+  void AppendToBuffer(Timestamp output_timestamp,
+                      std::unique_ptr<Matrix> frame);
+
+  // Returns a new output Matrix, from pool_ if buffers are reused.
+  std::unique_ptr<Matrix> NewOutputMatrix(int rows, int cols);
+
   // Converts a number of samples into an approximate stream timestamp value.
   int64_t SampleNumberToTimestamp(const int64_t sample_number);
   int64_t TimestampToSampleNumber(const int64_t timestamp);
@@ -183,6 +220,24 @@ class AudioPacketProcessor : public BasePacketProcessor {
 
   // Options for the processor.
   AudioStreamOptions options_;
+
+  // Number of channels and sample rate after downmixing and resampling.
+  int output_num_channels_ = -1;
+  double output_sample_rate_ = -1;
+
+  // The samples of the last decoded frame, reused across frames.
+  Matrix decoded_audio_;
+  // The downmixed samples of the last decoded frame, if downmixing.
+  Matrix downmixed_audio_;
+
+  // Null unless resampling.
+  std::unique_ptr<audio_dsp::QResampler<float>> resampler_;
+  // Resampled output timestamps are counted from the first resampled frame.
+  Timestamp first_resampled_timestamp_ = Timestamp::Unset();
+  int64_t num_resampled_samples_ = 0;
+
+  // Null unless reusing output buffers.
+  std::shared_ptr<MatrixPool> pool_;
 };
 
 // Decode the audio streams of a media file.  The AudioDecoder is responsible
@@ -24,11 +24,18 @@
 #else
 #include <unistd.h>
 #endif
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <sys/syscall.h>
+#endif
 #include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
 #include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "mediapipe/framework/port/canonical_errors.h"
@@ -104,6 +111,34 @@ std::set<int> InferLowerOrHigherCoreIds(bool lower) {
     return inferred_cores;
   }
 }
+
+// Reads a sysfs list such as "0-3,8-11". Returns an empty set if the file
+// cannot be read or parsed.
+std::set<int> ReadSysfsList(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  if (!file.is_open() || !std::getline(file, line)) {
+    return {};
+  }
+  std::set<int> ids;
+  for (absl::string_view range :
+       absl::StrSplit(line, ',', absl::SkipWhitespace())) {
+    std::pair<absl::string_view, absl::string_view> bounds =
+        absl::StrSplit(range, absl::MaxSplits('-', 1));
+    int first, last;
+    if (!absl::SimpleAtoi(bounds.first, &first)) {
+      return {};
+    }
+    last = first;
+    if (!bounds.second.empty() && !absl::SimpleAtoi(bounds.second, &last)) {
+      return {};
+    }
+    for (int id = first; id <= last; ++id) {
+      ids.insert(id);
+    }
+  }
+  return ids;
+}
 }  // namespace
 
 int NumCPUCores() {
@@ -126,4 +161,28 @@ std::set<int> InferHigherCoreIds() {
   return InferLowerOrHigherCoreIds(/* lower= */ false);
 }
 
+int NumNumaNodes() {
+  static const int num_numa_nodes = [] {
+    std::set<int> nodes = ReadSysfsList("/sys/devices/system/node/possible");
+    return nodes.empty() ? 1 : *nodes.rbegin() + 1;
+  }();
+  return num_numa_nodes;
+}
+
+std::set<int> NumaNodeCpuIds(int numa_node) {
+  return ReadSysfsList(
+      absl::Substitute("/sys/devices/system/node/node$0/cpulist", numa_node));
+}
+
+int CurrentNumaNode() {
+#if defined(__linux__) && !defined(__ANDROID__) && defined(SYS_getcpu)
+  unsigned cpu = 0;
+  unsigned node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node);
+  }
+#endif
+  return 0;
+}
+
 }  // namespace mediapipe.
@@ -24,6 +24,15 @@ int NumCPUCores();
 std::set<int> InferLowerCoreIds();
 // Returns a set of inferred CPU ids of higher cores.
 std::set<int> InferHigherCoreIds();
+// Returns the number of NUMA nodes. Returns 1 if the system does not report
+// its NUMA topology.
+int NumNumaNodes();
+// Returns the CPU ids of the given NUMA node, or an empty set if they are
+// unknown.
+std::set<int> NumaNodeCpuIds(int numa_node);
+// Returns the NUMA node of the CPU the calling thread runs on, or 0 if it is
+// unknown.
+int CurrentNumaNode();
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_UTIL_CPU_UTIL_H_
@@ -0,0 +1,181 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/filtering/one_euro_filter_bank.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+
+namespace mediapipe {
+
+namespace {
+
+constexpr double kEpsilon = 0.000001;
+constexpr int kUninitializedTimestamp = -1;
+
+bool IsValidAlpha(float alpha) { return alpha >= 0.0f && alpha <= 1.0f; }
+
+}  // namespace
+
+OneEuroFilterBank::OneEuroFilterBank(size_t size, double frequency,
+                                     double min_cutoff, double beta,
+                                     double derivate_cutoff)
+    : x_raw_values_(size),
+      x_stored_values_(size),
+      x_alphas_(size),
+      dx_stored_values_(size) {
+  SetFrequency(frequency);
+  initial_frequency_ = frequency_;
+  SetMinCutoff(min_cutoff);
+  SetBeta(beta);
+  SetDerivateCutoff(derivate_cutoff);
+  const float x_alpha = GetAlpha(min_cutoff);
+  if (!IsValidAlpha(x_alpha)) {
+    ABSL_LOG(ERROR) << "alpha: " << x_alpha << " should be in [0.0, 1.0] range";
+  }
+  x_alphas_.assign(size, x_alpha);
+  dx_alpha_ = GetAlpha(derivate_cutoff);
+  last_time_ = kUninitializedTimestamp;
+}
+
+void OneEuroFilterBank::Reset() {
+  frequency_ = initial_frequency_;
+  // The other values are set from the first values given to Apply().
+  dx_alpha_ = GetAlpha(derivate_cutoff_);
+  last_time_ = kUninitializedTimestamp;
+  initialized_ = false;
+}
+
+void OneEuroFilterBank::Apply(absl::Duration timestamp, double value_scale,
+                              absl::Span<float> values) {
+  ABSL_DCHECK_EQ(values.size(), size());
+  const int64_t new_timestamp = absl::ToInt64Nanoseconds(timestamp);
+  if (last_time_ >= new_timestamp) {
+    // Results are unpredictable in this case, so nothing to do but
+    // return same values
+    ABSL_LOG(WARNING) << "New timestamp is equal or less than the last one.";
+    return;
+  }
+
+  // update the sampling frequency based on timestamps
+  if (last_time_ != 0 && new_timestamp != 0) {
+    static constexpr double kNanoSecondsToSecond = 1e-9;
+    frequency_ = 1.0 / ((new_timestamp - last_time_) * kNanoSecondsToSecond);
+  }
+  last_time_ = new_timestamp;
+
+  const float dx_alpha = GetAlpha(derivate_cutoff_);
+  if (IsValidAlpha(dx_alpha)) {
+    dx_alpha_ = dx_alpha;
+  } else {
+    ABSL_LOG(ERROR) << "alpha: " << dx_alpha
+                    << " should be in [0.0, 1.0] range";
+  }
+
+  const size_t n = values.size();
+  float* x_raw = x_raw_values_.data();
+  float* x_stored = x_stored_values_.data();
+  float* x_alphas = x_alphas_.data();
+  float* dx_stored = dx_stored_values_.data();
+
+  if (!initialized_) {
+    // The first values pass through unchanged and estimate no variation, so
+    // the cutoff is min_cutoff_ for all of them.
+    const float x_alpha = GetAlpha(min_cutoff_);
+    if (IsValidAlpha(x_alpha)) {
+      x_alphas_.assign(n, x_alpha);
+    } else {
+      ABSL_LOG(ERROR) << "alpha: " << x_alpha
+                      << " should be in [0.0, 1.0] range";
+    }
+    for (size_t i = 0; i < n; ++i) {
+      dx_stored[i] = 0.0f;
+      x_raw[i] = values[i];
+      x_stored[i] = values[i];
+    }
+    initialized_ = true;
+    return;
+  }
+
+  // Keep the arithmetic of OneEuroFilter and LowPassFilter, including their
+  // float/double conversions, so that results match exactly.
+  const double te = 1.0 / frequency_;
+  for (size_t i = 0; i < n; ++i) {
+    const double value = values[i];
+    // estimate the current variation per second
+    const float dvalue = (value - x_raw[i]) * value_scale * frequency_;
+    const float edvalue =
+        dx_alpha_ * dvalue + (1.0 - dx_alpha_) * dx_stored[i];
+    dx_stored[i] = edvalue;
+    // use it to update the cutoff frequency
+    const double cutoff = min_cutoff_ + beta_ * std::fabs(edvalue);
+    const double tau = 1.0 / (2 * M_PI * cutoff);
+    const float x_alpha = 1.0 / (1.0 + tau / te);
+    if (IsValidAlpha(x_alpha)) {
+      x_alphas[i] = x_alpha;
+    } else {
+      ABSL_LOG(ERROR) << "alpha: " << x_alpha
+                      << " should be in [0.0, 1.0] range";
+    }
+  }
+  // filter the given values
+  for (size_t i = 0; i < n; ++i) {
+    const float value = values[i];
+    const float alpha = x_alphas[i];
+    const float result = alpha * value + (1.0 - alpha) * x_stored[i];
+    x_raw[i] = value;
+    x_stored[i] = result;
+    values[i] = result;
+  }
+}
+
+double OneEuroFilterBank::GetAlpha(double cutoff) const {
+  double te = 1.0 / frequency_;
+  double tau = 1.0 / (2 * M_PI * cutoff);
+  return 1.0 / (1.0 + tau / te);
+}
+
+void OneEuroFilterBank::SetFrequency(double frequency) {
+  if (frequency <= kEpsilon) {
+    ABSL_LOG(ERROR) << "frequency should be > 0";
+    return;
+  }
+  frequency_ = frequency;
+}
+
+void OneEuroFilterBank::SetMinCutoff(double min_cutoff) {
+  if (min_cutoff <= kEpsilon) {
+    ABSL_LOG(ERROR) << "min_cutoff should be > 0";
+    return;
+  }
+  min_cutoff_ = min_cutoff;
+}
+
+void OneEuroFilterBank::SetBeta(double beta) { beta_ = beta; }
+
+void OneEuroFilterBank::SetDerivateCutoff(double derivate_cutoff) {
+  if (derivate_cutoff <= kEpsilon) {
+    ABSL_LOG(ERROR) << "derivate_cutoff should be > 0";
+    return;
+  }
+  derivate_cutoff_ = derivate_cutoff;
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,107 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/filtering/one_euro_filter_bank.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/filtering/one_euro_filter.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kNumValues = 9;
+
+// Returns a deterministic, noisy trajectory for value `i` at frame `frame`.
+float GetValue(int i, int frame) {
+  return 100.0f * i + 20.0f * std::sin(0.3f * frame + i) +
+         ((frame * 7919 + i * 104729) % 13) * 0.37f;
+}
+
+TEST(OneEuroFilterBankTest, MatchesOneEuroFilters) {
+  constexpr double kFrequency = 30.0;
+  constexpr double kMinCutoff = 0.05;
+  constexpr double kBeta = 80.0;
+  constexpr double kDerivateCutoff = 1.0;
+  OneEuroFilterBank bank(kNumValues, kFrequency, kMinCutoff, kBeta,
+                         kDerivateCutoff);
+  std::vector<OneEuroFilter> filters;
+  for (int i = 0; i < kNumValues; ++i) {
+    filters.emplace_back(kFrequency, kMinCutoff, kBeta, kDerivateCutoff);
+  }
+
+  // Irregular frame durations, including a repeated timestamp.
+  const std::vector<int64_t> durations_ms = {0,  33, 34, 33, 0,  100,
+                                             16, 33, 50, 33, 33, 500};
+  int64_t timestamp_ms = 10;
+  for (int frame = 0; frame < durations_ms.size(); ++frame) {
+    timestamp_ms += durations_ms[frame];
+    const absl::Duration timestamp = absl::Milliseconds(timestamp_ms);
+    const double value_scale = 1.0 / (1.0 + 0.1 * frame);
+
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame);
+    std::vector<float> expected(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) {
+      expected[i] = filters[i].Apply(timestamp, value_scale, values[i]);
+    }
+
+    bank.Apply(timestamp, value_scale, absl::MakeSpan(values));
+    for (int i = 0; i < kNumValues; ++i) {
+      EXPECT_EQ(values[i], expected[i]) << "frame " << frame << " value " << i;
+    }
+  }
+}
+
+TEST(OneEuroFilterBankTest, FirstValuesPassThrough) {
+  OneEuroFilterBank bank(/*size=*/2, /*frequency=*/30.0, /*min_cutoff=*/1.0,
+                         /*beta=*/0.0, /*derivate_cutoff=*/1.0);
+  std::vector<float> values = {1.5f, -2.5f};
+  bank.Apply(absl::Milliseconds(1), 1.0, absl::MakeSpan(values));
+  EXPECT_EQ(values, std::vector<float>({1.5f, -2.5f}));
+}
+
+TEST(OneEuroFilterBankTest, ResetMatchesNewBank) {
+  OneEuroFilterBank reset_bank(kNumValues, /*frequency=*/30.0,
+                               /*min_cutoff=*/0.05, /*beta=*/80.0,
+                               /*derivate_cutoff=*/1.0);
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame);
+    reset_bank.Apply(absl::Milliseconds(100 + 50 * frame), 2.0,
+                     absl::MakeSpan(values));
+  }
+  reset_bank.Reset();
+  OneEuroFilterBank new_bank(kNumValues, /*frequency=*/30.0,
+                             /*min_cutoff=*/0.05, /*beta=*/80.0,
+                             /*derivate_cutoff=*/1.0);
+
+  // Timestamps restart before the ones seen before Reset().
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame + 7);
+    std::vector<float> expected = values;
+    const absl::Duration timestamp = absl::Milliseconds(10 + 33 * frame);
+    new_bank.Apply(timestamp, 1.0, absl::MakeSpan(expected));
+    reset_bank.Apply(timestamp, 1.0, absl::MakeSpan(values));
+    EXPECT_EQ(values, expected) << "frame " << frame;
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -0,0 +1,169 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/filtering/relative_velocity_filter_bank.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/log/absl_check.h"
+#include "absl/log/absl_log.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+
+namespace mediapipe {
+
+RelativeVelocityFilterBank::RelativeVelocityFilterBank(
+    size_t size, size_t window_size, float velocity_scale,
+    DistanceEstimationMode distance_mode)
+    : max_window_size_{window_size},
+      window_durations_(window_size),
+      window_distances_(window_size * size),
+      window_length_{window_size},
+      last_values_(size, 0.0f),
+      stored_values_(size),
+      alphas_(size, 1.0f),
+      distances_(size),
+      cumulative_distances_(size),
+      velocity_scale_{velocity_scale},
+      distance_mode_{distance_mode} {}
+
+void RelativeVelocityFilterBank::Reset() {
+  last_value_scale_ = 1.0f;
+  last_timestamp_ = -1;
+  std::fill(window_durations_.begin(), window_durations_.end(), 0);
+  std::fill(window_distances_.begin(), window_distances_.end(), 0.0f);
+  window_start_ = 0;
+  window_length_ = max_window_size_;
+  std::fill(last_values_.begin(), last_values_.end(), 0.0f);
+  std::fill(stored_values_.begin(), stored_values_.end(), 0.0f);
+  std::fill(alphas_.begin(), alphas_.end(), 1.0f);
+  low_pass_initialized_ = false;
+}
+
+void RelativeVelocityFilterBank::Apply(absl::Duration timestamp,
+                                       float value_scale,
+                                       absl::Span<float> values) {
+  ABSL_DCHECK_EQ(values.size(), size());
+  const int64_t new_timestamp = absl::ToInt64Nanoseconds(timestamp);
+  if (last_timestamp_ >= new_timestamp) {
+    // Results are unpredictable in this case, so nothing to do but
+    // return same values
+    ABSL_LOG(WARNING) << "New timestamp is equal or less than the last one.";
+    return;
+  }
+
+  // Keep the arithmetic of RelativeVelocityFilter and LowPassFilter, including
+  // their float/double conversions, so that results match exactly.
+  const size_t n = values.size();
+  float* alphas = alphas_.data();
+  if (last_timestamp_ == -1) {
+    for (size_t i = 0; i < n; ++i) alphas[i] = 1.0f;
+  } else {
+    ABSL_DCHECK(distance_mode_ == DistanceEstimationMode::kLegacyTransition ||
+                distance_mode_ == DistanceEstimationMode::kForceCurrentScale);
+    float* distances = distances_.data();
+    const float* last_values = last_values_.data();
+    if (distance_mode_ == DistanceEstimationMode::kLegacyTransition) {
+      const float last_value_scale = last_value_scale_;
+      for (size_t i = 0; i < n; ++i) {
+        distances[i] =
+            values[i] * value_scale - last_values[i] * last_value_scale;
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        distances[i] = value_scale * (values[i] - last_values[i]);
+      }
+    }
+
+    const int64_t duration = new_timestamp - last_timestamp_;
+
+    // The window elements used only depend on durations, which are shared by
+    // all values.
+    // Define max cumulative duration assuming
+    // 30 frames per second is a good frame rate, so assuming 30 values
+    // per second or 1 / 30 of a second is a good duration per window element
+    constexpr int64_t kAssumedMaxDuration = 1000000000 / 30;
+    const int64_t max_cumulative_duration =
+        (1 + window_length_) * kAssumedMaxDuration;
+    int64_t cumulative_duration = duration;
+    size_t num_used = 0;
+    for (; num_used < window_length_; ++num_used) {
+      const int64_t element_duration =
+          window_durations_[(window_start_ + num_used) % max_window_size_];
+      if (cumulative_duration + element_duration > max_cumulative_duration) {
+        // This helps in cases when durations are large and outdated
+        // window elements have bad impact on filtering results
+        break;
+      }
+      cumulative_duration += element_duration;
+    }
+
+    float* cumulative_distances = cumulative_distances_.data();
+    for (size_t i = 0; i < n; ++i) cumulative_distances[i] = distances[i];
+    for (size_t j = 0; j < num_used; ++j) {
+      const float* row =
+          window_distances_.data() +
+          ((window_start_ + j) % max_window_size_) * n;
+      for (size_t i = 0; i < n; ++i) cumulative_distances[i] += row[i];
+    }
+
+    constexpr double kNanoSecondsToSecond = 1e-9;
+    const double cumulative_seconds =
+        cumulative_duration * kNanoSecondsToSecond;
+    for (size_t i = 0; i < n; ++i) {
+      const float velocity = cumulative_distances[i] / cumulative_seconds;
+      const float alpha =
+          1.0f - 1.0f / (1.0f + velocity_scale_ * std::abs(velocity));
+      if (alpha >= 0.0f && alpha <= 1.0f) {
+        alphas[i] = alpha;
+      } else {
+        ABSL_LOG(ERROR) << "alpha: " << alpha
+                        << " should be in [0.0, 1.0] range";
+      }
+    }
+
+    // Push the new element in front of the window, dropping the oldest one
+    // if the window is full.
+    if (max_window_size_ > 0) {
+      window_start_ = (window_start_ + max_window_size_ - 1) % max_window_size_;
+      window_durations_[window_start_] = duration;
+      float* row = window_distances_.data() + window_start_ * n;
+      for (size_t i = 0; i < n; ++i) row[i] = distances[i];
+      if (window_length_ < max_window_size_) ++window_length_;
+    }
+  }
+
+  float* last_values = last_values_.data();
+  for (size_t i = 0; i < n; ++i) last_values[i] = values[i];
+  last_value_scale_ = value_scale;
+  last_timestamp_ = new_timestamp;
+
+  float* stored_values = stored_values_.data();
+  if (!low_pass_initialized_) {
+    for (size_t i = 0; i < n; ++i) stored_values[i] = values[i];
+    low_pass_initialized_ = true;
+    return;
+  }
+  for (size_t i = 0; i < n; ++i) {
+    const float alpha = alphas[i];
+    const float result = alpha * values[i] + (1.0 - alpha) * stored_values[i];
+    stored_values[i] = result;
+    values[i] = result;
+  }
+}
+
+}  // namespace mediapipe
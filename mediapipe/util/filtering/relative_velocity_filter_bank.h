@@ -0,0 +1,86 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_FILTERING_RELATIVE_VELOCITY_FILTER_BANK_H_
+#define MEDIAPIPE_UTIL_FILTERING_RELATIVE_VELOCITY_FILTER_BANK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "mediapipe/util/filtering/relative_velocity_filter.h"
+
+namespace mediapipe {
+
+// A bank of RelativeVelocityFilters that are always applied together with the
+// same timestamp and value scale, e.g. one per coordinate of every landmark of
+// an object.
+//
+// The filter state is kept as structure of arrays: the window durations are
+// shared by all values, and the window distances are stored in a single ring
+// buffer instead of one std::deque per value. All values are updated in one
+// call. Results are identical to applying a separate RelativeVelocityFilter to
+// every value.
+class RelativeVelocityFilterBank {
+ public:
+  using DistanceEstimationMode = RelativeVelocityFilter::DistanceEstimationMode;
+
+  RelativeVelocityFilterBank(size_t size, size_t window_size,
+                             float velocity_scale,
+                             DistanceEstimationMode distance_mode =
+                                 DistanceEstimationMode::kDefault);
+
+  // Filters @values in place. @values.size() must be equal to size(). See
+  // RelativeVelocityFilter::Apply for the meaning of the arguments.
+  void Apply(absl::Duration timestamp, float value_scale,
+             absl::Span<float> values);
+
+  size_t size() const { return last_values_.size(); }
+
+  // Restores the state of a newly constructed bank, keeping its buffers, so
+  // that it can be reused for a new sequence of values of the same size.
+  void Reset();
+
+ private:
+  float last_value_scale_{1.0};
+  int64_t last_timestamp_{-1};
+
+  size_t max_window_size_;
+  // Ring buffer of the window, newest element at window_start_. Distances are
+  // stored as max_window_size_ rows of size() values. Like in
+  // RelativeVelocityFilter, the window starts filled with zero elements.
+  std::vector<int64_t> window_durations_;
+  std::vector<float> window_distances_;
+  size_t window_start_ = 0;
+  size_t window_length_;
+
+  std::vector<float> last_values_;
+  // Low pass filter state of the values.
+  std::vector<float> stored_values_;
+  std::vector<float> alphas_;
+  bool low_pass_initialized_ = false;
+
+  // Scratch space reused across calls.
+  std::vector<float> distances_;
+  std::vector<float> cumulative_distances_;
+
+  float velocity_scale_;
+  DistanceEstimationMode distance_mode_;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_FILTERING_RELATIVE_VELOCITY_FILTER_BANK_H_
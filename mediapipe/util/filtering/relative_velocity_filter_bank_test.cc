@@ -0,0 +1,115 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/filtering/relative_velocity_filter_bank.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/filtering/relative_velocity_filter.h"
+
+namespace mediapipe {
+namespace {
+
+using DistanceEstimationMode =
+    mediapipe::RelativeVelocityFilter::DistanceEstimationMode;
+
+constexpr int kNumValues = 9;
+
+// Returns a deterministic, noisy trajectory for value `i` at frame `frame`.
+float GetValue(int i, int frame) {
+  return 100.0f * i + 20.0f * std::sin(0.3f * frame + i) +
+         ((frame * 7919 + i * 104729) % 13) * 0.37f;
+}
+
+void ExpectMatchesRelativeVelocityFilters(
+    size_t window_size, DistanceEstimationMode distance_mode) {
+  constexpr float kVelocityScale = 10.0f;
+  RelativeVelocityFilterBank bank(kNumValues, window_size, kVelocityScale,
+                                  distance_mode);
+  std::vector<RelativeVelocityFilter> filters(
+      kNumValues,
+      RelativeVelocityFilter(window_size, kVelocityScale, distance_mode));
+
+  // Irregular frame durations, including a repeated timestamp and gaps long
+  // enough to drop outdated window elements.
+  const std::vector<int64_t> durations_ms = {0,  33, 34, 33, 0,  100, 16, 33,
+                                             50, 33, 33, 500, 33, 33, 33, 16};
+  int64_t timestamp_ms = 10;
+  for (int frame = 0; frame < durations_ms.size(); ++frame) {
+    timestamp_ms += durations_ms[frame];
+    const absl::Duration timestamp = absl::Milliseconds(timestamp_ms);
+    const float value_scale = 1.0f / (1.0f + 0.1f * frame);
+
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame);
+    std::vector<float> expected(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) {
+      expected[i] = filters[i].Apply(timestamp, value_scale, values[i]);
+    }
+
+    bank.Apply(timestamp, value_scale, absl::MakeSpan(values));
+    for (int i = 0; i < kNumValues; ++i) {
+      EXPECT_EQ(values[i], expected[i])
+          << "window " << window_size << " frame " << frame << " value " << i;
+    }
+  }
+}
+
+TEST(RelativeVelocityFilterBankTest, MatchesRelativeVelocityFilters) {
+  for (size_t window_size : {0, 1, 5}) {
+    ExpectMatchesRelativeVelocityFilters(
+        window_size, DistanceEstimationMode::kLegacyTransition);
+  }
+}
+
+TEST(RelativeVelocityFilterBankTest,
+     MatchesRelativeVelocityFiltersForceCurrentScale) {
+  for (size_t window_size : {0, 1, 5}) {
+    ExpectMatchesRelativeVelocityFilters(
+        window_size, DistanceEstimationMode::kForceCurrentScale);
+  }
+}
+
+TEST(RelativeVelocityFilterBankTest, ResetMatchesNewBank) {
+  constexpr size_t kWindowSize = 3;
+  constexpr float kVelocityScale = 10.0f;
+  RelativeVelocityFilterBank reset_bank(kNumValues, kWindowSize,
+                                        kVelocityScale);
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame);
+    reset_bank.Apply(absl::Milliseconds(100 + 50 * frame), 2.0f,
+                     absl::MakeSpan(values));
+  }
+  reset_bank.Reset();
+  RelativeVelocityFilterBank new_bank(kNumValues, kWindowSize, kVelocityScale);
+
+  // Timestamps restart before the ones seen before Reset().
+  for (int frame = 0; frame < 5; ++frame) {
+    std::vector<float> values(kNumValues);
+    for (int i = 0; i < kNumValues; ++i) values[i] = GetValue(i, frame + 7);
+    std::vector<float> expected = values;
+    const absl::Duration timestamp = absl::Milliseconds(10 + 33 * frame);
+    new_bank.Apply(timestamp, 1.0f, absl::MakeSpan(expected));
+    reset_bank.Apply(timestamp, 1.0f, absl::MakeSpan(values));
+    EXPECT_EQ(values, expected) << "frame " << frame;
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
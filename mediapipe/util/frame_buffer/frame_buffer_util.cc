@@ -234,8 +234,16 @@ absl::Status ValidateConvertFormats(FrameBuffer::Format from_format,
   }
 }
 
-absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
-                                       const Tensor& tensor) {
+// Returns the number of channels of the float tensor converted from the given
+// buffer. YUV buffers are converted to RGB.
+absl::StatusOr<int> NumberOfFloatTensorChannels(const FrameBuffer& buffer) {
+  if (IsSupportedYuvBuffer(buffer)) {
+    return kRgbChannels;
+  }
+  return NumberOfChannels(buffer);
+}
+
+absl::Status ValidateFloatTensorType(const Tensor& tensor) {
   if (tensor.element_type() != Tensor::ElementType::kFloat32) {
     return absl::InvalidArgumentError(absl::StrFormat(
         "Tensor type %i is not supported.", tensor.element_type()));
@@ -244,7 +252,14 @@ absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
   if (shape.dims.size() != 4 || shape.dims[0] != 1) {
     return absl::InvalidArgumentError("Expected tensor with batch size of 1.");
   }
-  MP_ASSIGN_OR_RETURN(int channels, NumberOfChannels(buffer));
+  return absl::OkStatus();
+}
+
+absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
+                                       const Tensor& tensor) {
+  MP_RETURN_IF_ERROR(ValidateFloatTensorType(tensor));
+  const auto& shape = tensor.shape();
+  MP_ASSIGN_OR_RETURN(int channels, NumberOfFloatTensorChannels(buffer));
   if (shape.dims[2] != buffer.dimension().width ||
       shape.dims[1] != buffer.dimension().height || shape.dims[3] != channels) {
     return absl::InvalidArgumentError(
@@ -253,6 +268,25 @@ absl::Status ValidateFloatTensorInputs(const FrameBuffer& buffer,
   return absl::OkStatus();
 }
 
+absl::Status ValidateCropResizeFloatTensorInputs(const FrameBuffer& buffer,
+                                                 int x0, int y0, int x1, int y1,
+                                                 const Tensor& tensor) {
+  MP_RETURN_IF_ERROR(ValidateFloatTensorType(tensor));
+  MP_ASSIGN_OR_RETURN(int channels, NumberOfFloatTensorChannels(buffer));
+  if (tensor.shape().dims[3] != channels) {
+    return absl::InvalidArgumentError(
+        "Input buffer and output tensor must have the same number of "
+        "channels.");
+  }
+  bool is_buffer_size_valid =
+      ((x1 < buffer.dimension().width) && y1 < buffer.dimension().height);
+  bool are_points_valid = (x0 >= 0) && (y0 >= 0) && (x1 >= x0) && (y1 >= y0);
+  if (!is_buffer_size_valid || !are_points_valid) {
+    return absl::InvalidArgumentError("Invalid crop coordinates.");
+  }
+  return absl::OkStatus();
+}
+
 // Construct buffer helper functions.
 //------------------------------------------------------------------------------
 
@@ -430,9 +464,45 @@ absl::Status ToFloatTensorRgb(const FrameBuffer& buffer, float scale,
              : absl::UnknownError("Halide rgb[a] to float conversion failed.");
 }
 
+absl::Status CropResizeToFloatTensorRgb(const FrameBuffer& buffer, int x0,
+                                        int y0, int x1, int y1, float scale,
+                                        float offset, Tensor& tensor) {
+  MP_ASSIGN_OR_RETURN(auto input, CreateRgbBuffer(buffer));
+  if (!input.Crop(x0, y0, x1, y1)) {
+    return absl::UnknownError("Halide rgb[a] crop operation failed.");
+  }
+  const int width = tensor.shape().dims[2];
+  const int height = tensor.shape().dims[1];
+  // There is no fused RGB kernel; resize into an intermediate buffer first.
+  RgbBuffer resized(width, height, /*alpha=*/false);
+  if (!input.Resize(&resized)) {
+    return absl::UnknownError("Halide rgb[a] resize operation failed.");
+  }
+  auto view = tensor.GetCpuWriteView();
+  FloatBuffer output(view.buffer<float>(), width, height, kRgbChannels);
+  return resized.ToFloat(scale, offset, &output)
+             ? absl::OkStatus()
+             : absl::UnknownError("Halide rgb[a] to float conversion failed.");
+}
+
 // Yuv transformation functions.
 //------------------------------------------------------------------------------
 
+absl::Status CropResizeToFloatTensorYuv(const FrameBuffer& buffer, int x0,
+                                        int y0, int x1, int y1, float scale,
+                                        float offset, Tensor& tensor) {
+  MP_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
+  if (!input.Crop(x0, y0, x1, y1)) {
+    return absl::UnknownError("Halide YUV crop operation failed.");
+  }
+  auto view = tensor.GetCpuWriteView();
+  FloatBuffer output(view.buffer<float>(), tensor.shape().dims[2],
+                     tensor.shape().dims[1], kRgbChannels);
+  return input.ToFloat(scale, offset, &output)
+             ? absl::OkStatus()
+             : absl::UnknownError("Halide YUV to float conversion failed.");
+}
+
 absl::Status CropYuv(const FrameBuffer& buffer, int x0, int y0, int x1, int y1,
                      FrameBuffer* output_buffer) {
   MP_ASSIGN_OR_RETURN(auto input, CreateYuvBuffer(buffer));
@@ -773,6 +843,34 @@ absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
   switch (buffer.format()) {
     case FrameBuffer::Format::kRGB:
       return ToFloatTensorRgb(buffer, scale, offset, tensor);
+    case FrameBuffer::Format::kNV12:
+    case FrameBuffer::Format::kNV21:
+    case FrameBuffer::Format::kYV12:
+    case FrameBuffer::Format::kYV21:
+      return CropResizeToFloatTensorYuv(
+          buffer, 0, 0, buffer.dimension().width - 1,
+          buffer.dimension().height - 1, scale, offset, tensor);
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrFormat("Format %i is not supported.", buffer.format()));
+  }
+}
+
+absl::Status CropResizeToFloatTensor(const FrameBuffer& buffer, int x0, int y0,
+                                     int x1, int y1, float scale, float offset,
+                                     Tensor& tensor) {
+  MP_RETURN_IF_ERROR(
+      ValidateCropResizeFloatTensorInputs(buffer, x0, y0, x1, y1, tensor));
+  switch (buffer.format()) {
+    case FrameBuffer::Format::kRGB:
+      return CropResizeToFloatTensorRgb(buffer, x0, y0, x1, y1, scale, offset,
+                                        tensor);
+    case FrameBuffer::Format::kNV12:
+    case FrameBuffer::Format::kNV21:
+    case FrameBuffer::Format::kYV12:
+    case FrameBuffer::Format::kYV21:
+      return CropResizeToFloatTensorYuv(buffer, x0, y0, x1, y1, scale, offset,
+                                        tensor);
     default:
       return absl::InvalidArgumentError(
           absl::StrFormat("Format %i is not supported.", buffer.format()));
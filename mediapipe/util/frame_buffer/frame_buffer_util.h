@@ -103,10 +103,24 @@ absl::Status Convert(const FrameBuffer& buffer, FrameBuffer* output_buffer);
 // a float using:
 //   output = input * scale + offset
 //
-// Note that only interleaved single-planar formats support this operation.
+// RGB and YUV formats support this operation. YUV buffers are converted to RGB
+// in the same pass, without an intermediate RGB buffer.
 absl::Status ToFloatTensor(const FrameBuffer& buffer, float scale, float offset,
                            Tensor& tensor);
 
+// Crops `buffer` to the specified points, resizes the crop to the dimensions
+// of the provided float Tensor using bilinear interpolation and converts it to
+// RGB floats using:
+//   output = rgb * scale + offset
+//
+// (x0, y0) represents the top-left point of the crop and (x1, y1) its
+// bottom-right point. For YUV formats, x0 and y0 must be even, and all three
+// steps run as a single fused pass, so camera frames go to model input without
+// intermediate buffers. RGB is also supported, with an intermediate buffer.
+absl::Status CropResizeToFloatTensor(const FrameBuffer& buffer, int x0, int y0,
+                                     int x1, int y1, float scale, float offset,
+                                     Tensor& tensor);
+
 // Miscellaneous Methods
 // -----------------------------------------------------------------
 
@@ -1062,6 +1062,50 @@ TEST(FrameBufferUtil, NV21ConvertRgb) {
   EXPECT_EQ(output->plane(0).buffer()[1], 122);
 }
 
+TEST(FrameBufferUtil, NV21CropResizeToFloatTensorMatchesUnfused) {
+  constexpr FrameBuffer::Dimension kBufferDimension = {.width = 64,
+                                                       .height = 16};
+  constexpr FrameBuffer::Dimension kCropDimension = {.width = 32, .height = 8};
+  constexpr int kX0 = 16, kY0 = 4, kX1 = 47, kY1 = 11;
+  constexpr float kScale = 1.0f / 255.0f, kOffset = -0.5f;
+  const int kInputSize =
+      GetFrameBufferByteSize(kBufferDimension, FrameBuffer::Format::kNV21);
+  std::vector<uint8_t> input_data(kInputSize);
+  for (int i = 0; i < kInputSize; ++i) {
+    input_data[i] = (i * 7) % 256;
+  }
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto input, CreateFromRawBuffer(input_data.data(), kBufferDimension,
+                                      FrameBuffer::Format::kNV21));
+  const Tensor::Shape shape{1, kCropDimension.height, kCropDimension.width, 3};
+
+  // Unfused: crop, convert to RGB, then to float.
+  std::vector<uint8_t> cropped_data(
+      GetFrameBufferByteSize(kCropDimension, FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK_AND_ASSIGN(
+      auto cropped, CreateFromRawBuffer(cropped_data.data(), kCropDimension,
+                                        FrameBuffer::Format::kNV21));
+  MP_ASSERT_OK(Crop(*input, kX0, kY0, kX1, kY1, cropped.get()));
+  std::vector<uint8_t> rgb_data(
+      GetFrameBufferByteSize(kCropDimension, FrameBuffer::Format::kRGB));
+  auto rgb = CreateFromRgbRawBuffer(rgb_data.data(), kCropDimension);
+  MP_ASSERT_OK(Convert(*cropped, rgb.get()));
+  Tensor expected(Tensor::ElementType::kFloat32, shape);
+  MP_ASSERT_OK(ToFloatTensor(*rgb, kScale, kOffset, expected));
+
+  Tensor output(Tensor::ElementType::kFloat32, shape);
+  MP_ASSERT_OK(CropResizeToFloatTensor(*input, kX0, kY0, kX1, kY1, kScale,
+                                       kOffset, output));
+
+  auto expected_view = expected.GetCpuReadView();
+  auto output_view = output.GetCpuReadView();
+  const float* expected_data = expected_view.buffer<float>();
+  const float* output_data = output_view.buffer<float>();
+  for (int i = 0; i < shape.num_elements(); ++i) {
+    EXPECT_NEAR(output_data[i], expected_data[i], 1e-6f) << "at " << i;
+  }
+}
+
 TEST(FrameBufferUtil, NV21ConvertHalfRgb) {
   constexpr FrameBuffer::Dimension kBufferDimension = {.width = 64,
                                                        .height = 16},
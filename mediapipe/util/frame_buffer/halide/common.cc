@@ -69,6 +69,17 @@ void resize_bilinear_int(Halide::Func input, Halide::Func result,
   result(x, y, _) = lerp(y0, y1, yr);
 }
 
+Halide::Tuple yuv_to_rgb(Halide::Expr y, Halide::Expr u, Halide::Expr v) {
+  y = Halide::cast<int32_t>(y);
+  u = Halide::cast<int32_t>(u) - 128;
+  v = Halide::cast<int32_t>(v) - 128;
+  return {
+      y + ((91881 * v + 32768) >> 16),
+      y - ((22544 * u + 46802 * v + 32768) >> 16),
+      y + ((116130 * u + 32768) >> 16),
+  };
+}
+
 void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
             Halide::Expr height, Halide::Expr angle) {
   Halide::Var x{"x"}, y{"y"};
@@ -48,6 +48,16 @@ void resize_bilinear(Halide::Func input, Halide::Func result, Halide::Expr fx,
 void resize_bilinear_int(Halide::Func input, Halide::Func result,
                          Halide::Expr fx, Halide::Expr fy);
 
+// Converts full-range YUV to RGB with integer math versions of the JFIF
+// coefficients:
+//   R = Y' + 1.40200*(V-128)
+//   G = Y' - 0.34414*(U-128) - 0.71414*(V-128)
+//   B = Y' + 1.77200*(U-128)
+// See https://www.w3.org/Graphics/JPEG/jfif3.pdf. These coefficients are
+// similar to, but not identical, to those used in Android. The returned int32
+// values are not clamped to [0, 255].
+Halide::Tuple yuv_to_rgb(Halide::Expr y, Halide::Expr u, Halide::Expr v);
+
 // Note: width and height are the source image dimensions; angle must be one
 // of [0, 90, 180, 270] or the result is undefined.
 void rotate(Halide::Func input, Halide::Func result, Halide::Expr width,
@@ -0,0 +1,103 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Halide.h"
+#include "mediapipe/util/frame_buffer/halide/common.h"
+
+namespace {
+
+using ::Halide::BoundaryConditions::repeat_edge;
+using ::mediapipe::frame_buffer::halide::common::resize_bilinear_int;
+using ::mediapipe::frame_buffer::halide::common::yuv_to_rgb;
+
+// Resizes a YUV image and converts it to normalized RGB floats in a single
+// pass, without materializing the intermediate YUV or RGB images:
+//   dst_float = rgb(resize(src)) * scale + offset
+//
+// Cropping is done by the caller through the source buffer dimensions.
+// The result matches YuvResize followed by YuvRgb and RgbFloat.
+class YuvFloat : public Halide::Generator<YuvFloat> {
+ public:
+  Var x{"x"}, y{"y"}, c{"c"};
+
+  Input<Buffer<uint8_t, 2>> src_y{"src_y"};
+  Input<Buffer<uint8_t, 3>> src_uv{"src_uv"};
+  Input<float> scale_x{"scale_x", 1.0f, 0.0f, 1024.0f};
+  Input<float> scale_y{"scale_y", 1.0f, 0.0f, 1024.0f};
+  Input<float> scale{"scale"};
+  Input<float> offset{"offset"};
+
+  Output<Buffer<float, 3>> dst_float{"dst_float"};
+
+  void generate();
+  void schedule();
+
+ private:
+  Halide::Func resized_y_{"resized_y"};
+  Halide::Func resized_uv_{"resized_uv"};
+};
+
+void YuvFloat::generate() {
+  // Resize each of the YUV planes independently, exactly like YuvResize.
+  resize_bilinear_int(repeat_edge(src_y), resized_y_, scale_x, scale_y);
+  resize_bilinear_int(repeat_edge(src_uv), resized_uv_, scale_x, scale_y);
+
+  // Convert like YuvRgb; uv channel indices assume NV21 (VU order).
+  Halide::Tuple rgb = yuv_to_rgb(resized_y_(x, y), resized_uv_(x / 2, y / 2, 1),
+                                 resized_uv_(x / 2, y / 2, 0));
+  Halide::Expr value = select(c == 0, rgb[0], c == 1, rgb[1], rgb[2]);
+  dst_float(x, y, c) =
+      Halide::cast<float>(Halide::saturating_cast<uint8_t>(value)) * scale +
+      offset;
+}
+
+void YuvFloat::schedule() {
+  // Y plane dimensions start at zero.
+  src_y.dim(0).set_min(0);
+  src_y.dim(1).set_min(0);
+
+  // UV plane has two channels and is half the size of the Y plane in X/Y.
+  // Remove default memory layout constraints on the UV source so that we
+  // accept generic UV (including semi-planar and planar).
+  src_uv.dim(0).set_bounds(0, (src_y.dim(0).extent() + 1) / 2);
+  src_uv.dim(1).set_bounds(0, (src_y.dim(1).extent() + 1) / 2);
+  src_uv.dim(2).set_bounds(0, 2);
+  src_uv.dim(0).set_stride(Expr());
+
+  // The destination buffer starts at zero in every dimension, has exactly
+  // three channels and requires an interleaved format.
+  dst_float.dim(0).set_min(0);
+  dst_float.dim(1).set_min(0);
+  dst_float.dim(2).set_bounds(0, 3);
+  dst_float.dim(0).set_stride(3);
+  dst_float.dim(2).set_stride(1);
+
+  // Every row of the subsampled UV plane feeds two rows of output, so compute
+  // it once per pair of output rows instead of once per output pixel.
+  Halide::Func dst_func = dst_float;
+  Halide::Var yo{"yo"}, yi{"yi"};
+  dst_func.split(y, yo, yi, 2, Halide::TailStrategy::GuardWithIf)
+      .reorder(c, x, yi, yo)
+      .unroll(c);
+  resized_uv_.compute_at(dst_func, yo);
+
+  const int vector_size = natural_vector_size<float>();
+  Halide::Expr min_y_width =
+      Halide::min(src_y.dim(0).extent(), dst_float.dim(0).extent());
+  dst_func.specialize(min_y_width >= vector_size).vectorize(x, vector_size);
+}
+
+}  // namespace
+
+HALIDE_REGISTER_GENERATOR(YuvFloat, yuv_float_generator)
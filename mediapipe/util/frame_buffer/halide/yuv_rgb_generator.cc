@@ -13,9 +13,12 @@
 // limitations under the License.
 
 #include "Halide.h"
+#include "mediapipe/util/frame_buffer/halide/common.h"
 
 namespace {
 
+using ::mediapipe::frame_buffer::halide::common::yuv_to_rgb;
+
 class YuvRgb : public Halide::Generator<YuvRgb> {
  public:
   Var x{"x"}, y{"y"}, c{"c"};
@@ -35,23 +38,6 @@ Halide::Expr demux(Halide::Expr c, Halide::Tuple values) {
   return select(c == 0, values[0], c == 1, values[1], c == 2, values[2], 255);
 }
 
-// Integer math versions of the full-range JFIF YUV-RGB coefficients.
-//   R = Y' + 1.40200*(V-128)
-//   G = Y' - 0.34414*(U-128) - 0.71414*(V-128)
-//   B = Y' + 1.77200*(U-128)
-// See https://www.w3.org/Graphics/JPEG/jfif3.pdf. These coefficients are
-// similar to, but not identical, to those used in Android.
-Halide::Tuple yuvrgb(Halide::Expr y, Halide::Expr u, Halide::Expr v) {
-  y = Halide::cast<int32_t>(y);
-  u = Halide::cast<int32_t>(u) - 128;
-  v = Halide::cast<int32_t>(v) - 128;
-  return {
-      y + ((91881 * v + 32768) >> 16),
-      y - ((22544 * u + 46802 * v + 32768) >> 16),
-      y + ((116130 * u + 32768) >> 16),
-  };
-}
-
 void YuvRgb::generate() {
   // Each 2x2 block of Y pixels shares the same UV values, so UV-coordinates
   // advance half as slowly as Y-coordinates. When taking advantage of the
@@ -59,8 +45,9 @@ void YuvRgb::generate() {
   Halide::Expr yx = select(halve, 2 * x, x), yy = select(halve, 2 * y, y);
   Halide::Expr uvx = select(halve, x, x / 2), uvy = select(halve, y, y / 2);
 
-  rgb(x, y, c) = Halide::saturating_cast<uint8_t>(demux(
-      c, yuvrgb(src_y(yx, yy), src_uv(uvx, uvy, 1), src_uv(uvx, uvy, 0))));
+  rgb(x, y, c) = Halide::saturating_cast<uint8_t>(
+      demux(c, yuv_to_rgb(src_y(yx, yy), src_uv(uvx, uvy, 1),
+                          src_uv(uvx, uvy, 0))));
   // NOTE: uv channel indices above assume NV21; this can be abstracted out
   // by twiddling strides in calling code.
 }
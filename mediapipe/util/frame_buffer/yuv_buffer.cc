@@ -17,7 +17,9 @@
 #include <utility>
 
 #include "mediapipe/util/frame_buffer/buffer_common.h"
+#include "mediapipe/util/frame_buffer/float_buffer.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_flip_halide.h"
+#include "mediapipe/util/frame_buffer/halide/yuv_float_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_resize_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_rgb_halide.h"
 #include "mediapipe/util/frame_buffer/halide/yuv_rotate_halide.h"
@@ -148,5 +150,13 @@ bool YuvBuffer::Convert(bool halve, RgbBuffer* output) {
   return result == 0;
 }
 
+bool YuvBuffer::ToFloat(float scale, float offset, FloatBuffer* output) {
+  const int result = yuv_float_halide(
+      y_buffer(), uv_buffer(), static_cast<float>(width()) / output->width(),
+      static_cast<float>(height()) / output->height(), scale, offset,
+      output->buffer());
+  return result == 0;
+}
+
 }  // namespace frame_buffer
 }  // namespace mediapipe
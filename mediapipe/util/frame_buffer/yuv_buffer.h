@@ -22,6 +22,7 @@
 
 namespace mediapipe {
 namespace frame_buffer {
+class FloatBuffer;
 class RgbBuffer;
 
 // YuvBuffer represents a view over a YUV 4:2:0 image.
@@ -120,6 +121,14 @@ class YuvBuffer {
   // two by discarding three of four luminance values in every 2x2 block.
   bool Convert(bool halve, RgbBuffer* output);
 
+  // Resizes this image to match the dimensions of the given output FloatBuffer
+  // and converts it to RGB floats in a single pass, using:
+  //   output = rgb * scale + offset
+  // The result is the same as Resize(), Convert() and RgbBuffer::ToFloat() in
+  // sequence, but without intermediate buffers. The output must have 3
+  // channels.
+  bool ToFloat(float scale, float offset, FloatBuffer* output);
+
   // Release ownership of the owned backing buffer.
   uint8_t* Release() { return owned_buffer_.release(); }
 
@@ -0,0 +1,99 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/log_linear_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "absl/log/absl_check.h"
+#include "absl/numeric/bits.h"
+
+namespace mediapipe {
+
+LogLinearHistogram::LogLinearHistogram(int precision_bits)
+    : precision_bits_(precision_bits) {
+  ABSL_CHECK_GE(precision_bits, 1);
+  ABSL_CHECK_LE(precision_bits, 20);
+}
+
+// Values below 2^p, with p = precision_bits_, have one bucket each. Above,
+// every power of two range [2^m, 2^(m+1)) is split into 2^(p-1) buckets of
+// 2^(m-p+1) values.
+int LogLinearHistogram::BucketIndex(int64_t value) const {
+  const int64_t num_linear = int64_t{1} << precision_bits_;
+  if (value < num_linear) {
+    return static_cast<int>(value);
+  }
+  const int shift =
+      absl::bit_width(static_cast<uint64_t>(value)) - precision_bits_;
+  const int64_t half = num_linear / 2;
+  return static_cast<int>(num_linear + (shift - 1) * half +
+                          ((value >> shift) - half));
+}
+
+int64_t LogLinearHistogram::BucketUpperBound(int index) const {
+  const int64_t num_linear = int64_t{1} << precision_bits_;
+  if (index < num_linear) {
+    return index;
+  }
+  const int64_t half = num_linear / 2;
+  const int shift = static_cast<int>((index - num_linear) / half) + 1;
+  const uint64_t sub_bucket = (index - num_linear) % half + half;
+  return static_cast<int64_t>(
+      std::min<uint64_t>(((sub_bucket + 1) << shift) - 1,
+                         std::numeric_limits<int64_t>::max()));
+}
+
+void LogLinearHistogram::Add(int64_t value) {
+  const int index = BucketIndex(std::max<int64_t>(value, 0));
+  if (index >= counts_.size()) {
+    counts_.resize(index + 1, 0);
+  }
+  ++counts_[index];
+  ++count_;
+}
+
+void LogLinearHistogram::Remove(int64_t value) {
+  const int index = BucketIndex(std::max<int64_t>(value, 0));
+  ABSL_CHECK_LT(index, counts_.size());
+  ABSL_CHECK_GT(counts_[index], 0);
+  --counts_[index];
+  --count_;
+}
+
+void LogLinearHistogram::Clear() {
+  counts_.clear();
+  count_ = 0;
+}
+
+int64_t LogLinearHistogram::Quantile(double q) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const int64_t rank = std::clamp<int64_t>(
+      static_cast<int64_t>(std::ceil(q * count_)), 1, count_);
+  int64_t seen = 0;
+  for (int i = 0; i < counts_.size(); ++i) {
+    seen += counts_[i];
+    if (seen >= rank) {
+      return BucketUpperBound(i);
+    }
+  }
+  return BucketUpperBound(static_cast<int>(counts_.size()) - 1);
+}
+
+}  // namespace mediapipe
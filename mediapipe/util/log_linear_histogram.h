@@ -0,0 +1,67 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_LOG_LINEAR_HISTOGRAM_H_
+#define MEDIAPIPE_UTIL_LOG_LINEAR_HISTOGRAM_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace mediapipe {
+
+// A histogram of non-negative integer values, such as latencies in
+// microseconds, that answers quantile queries with a bounded relative error.
+//
+// As in HdrHistogram, values below 2^precision_bits each get their own bucket
+// and larger values share buckets that are 2^-(precision_bits - 1) as wide as
+// the values they hold. The memory used only depends on the largest value
+// recorded: a few kilobytes cover latencies up to hours at the default
+// precision, however many values are recorded.
+//
+// Values can also be removed, which is how a sliding window of the recent
+// values is kept: see LatencySloMonitorCalculator.
+class LogLinearHistogram {
+ public:
+  explicit LogLinearHistogram(int precision_bits = 7);
+
+  // Records `value`. Negative values are recorded as 0.
+  void Add(int64_t value);
+
+  // Removes one record of `value`, which must have been added before.
+  void Remove(int64_t value);
+
+  // Removes all the values.
+  void Clear();
+
+  // The number of values recorded.
+  int64_t count() const { return count_; }
+
+  // Returns an upper bound of the q-quantile of the recorded values: the
+  // largest value equivalent, at the histogram precision, to the smallest
+  // recorded value such that at least q * count() values are not greater.
+  // Returns 0 if no value is recorded.
+  int64_t Quantile(double q) const;
+
+ private:
+  int BucketIndex(int64_t value) const;
+  int64_t BucketUpperBound(int index) const;
+
+  int precision_bits_;
+  std::vector<int64_t> counts_;
+  int64_t count_ = 0;
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_LOG_LINEAR_HISTOGRAM_H_
@@ -0,0 +1,78 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/log_linear_histogram.h"
+
+#include <cstdint>
+
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+TEST(LogLinearHistogramTest, EmptyHistogramHasZeroQuantiles) {
+  LogLinearHistogram histogram;
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.Quantile(0.5), 0);
+}
+
+TEST(LogLinearHistogramTest, SmallValuesAreExact) {
+  LogLinearHistogram histogram(/*precision_bits=*/4);
+  for (int64_t value = 1; value <= 10; ++value) {
+    histogram.Add(value);
+  }
+  EXPECT_EQ(histogram.count(), 10);
+  EXPECT_EQ(histogram.Quantile(0.0), 1);
+  EXPECT_EQ(histogram.Quantile(0.5), 5);
+  EXPECT_EQ(histogram.Quantile(0.95), 10);
+  EXPECT_EQ(histogram.Quantile(1.0), 10);
+}
+
+TEST(LogLinearHistogramTest, LargeValuesHaveBoundedRelativeError) {
+  constexpr int kPrecisionBits = 7;
+  LogLinearHistogram histogram(kPrecisionBits);
+  for (int64_t value = 1; value <= 100000; ++value) {
+    histogram.Add(value * 37);
+  }
+  const double max_error = 1.0 / (1 << (kPrecisionBits - 1));
+  for (double q : {0.5, 0.95, 0.99}) {
+    const double exact = q * 100000 * 37;
+    EXPECT_GE(histogram.Quantile(q), exact);
+    EXPECT_LE(histogram.Quantile(q), exact * (1 + max_error));
+  }
+}
+
+TEST(LogLinearHistogramTest, RemoveUndoesAdd) {
+  LogLinearHistogram histogram;
+  histogram.Add(100);
+  histogram.Add(5000);
+  histogram.Add(200);
+  histogram.Remove(5000);
+  EXPECT_EQ(histogram.count(), 2);
+  EXPECT_EQ(histogram.Quantile(1.0), histogram.Quantile(0.99));
+  EXPECT_LT(histogram.Quantile(1.0), 300);
+
+  histogram.Clear();
+  EXPECT_EQ(histogram.count(), 0);
+  EXPECT_EQ(histogram.Quantile(1.0), 0);
+}
+
+TEST(LogLinearHistogramTest, NegativeValuesAreRecordedAsZero) {
+  LogLinearHistogram histogram;
+  histogram.Add(-10);
+  EXPECT_EQ(histogram.Quantile(1.0), 0);
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -14,6 +14,8 @@
 
 #include "mediapipe/util/rectangle_util.h"
 
+#include <algorithm>
+
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/framework/port/rectangle.h"
 #include "mediapipe/framework/port/ret_check.h"
@@ -70,4 +72,30 @@ float CalculateIou(const Rectangle_f& rect1, const Rectangle_f& rect2) {
   return normalization > 0.0f ? intersection_area / normalization : 0.0f;
 }
 
+void CalculateIous(const RectangleArrays& rects, int index,
+                   const RectangleArrays& others, absl::Span<float> ious) {
+  const float xmin = rects.xmin[index];
+  const float ymin = rects.ymin[index];
+  const float xmax = rects.xmax[index];
+  const float ymax = rects.ymax[index];
+  const float area = (xmax - xmin) * (ymax - ymin);
+  const float* other_xmin = others.xmin.data();
+  const float* other_ymin = others.ymin.data();
+  const float* other_xmax = others.xmax.data();
+  const float* other_ymax = others.ymax.data();
+  const int n = others.size();
+  for (int i = 0; i < n; ++i) {
+    // Empty and disjoint rectangles have no intersection, as in CalculateIou.
+    const float width = std::max(
+        0.0f, std::min(xmax, other_xmax[i]) - std::max(xmin, other_xmin[i]));
+    const float height = std::max(
+        0.0f, std::min(ymax, other_ymax[i]) - std::max(ymin, other_ymin[i]));
+    const float intersection_area = width * height;
+    const float other_area =
+        (other_xmax[i] - other_xmin[i]) * (other_ymax[i] - other_ymin[i]);
+    const float normalization = area + other_area - intersection_area;
+    ious[i] = normalization > 0.0f ? intersection_area / normalization : 0.0f;
+  }
+}
+
 }  // namespace mediapipe
@@ -15,6 +15,8 @@
 #ifndef MEDIAPIPE_RECTANGLE_UTIL_H_
 #define MEDIAPIPE_RECTANGLE_UTIL_H_
 
+#include <vector>
+
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "mediapipe/framework/formats/rect.pb.h"
@@ -35,6 +37,29 @@ absl::StatusOr<bool> DoesRectOverlap(
 // Computes the Intersection over Union (IoU) between two rectangles.
 float CalculateIou(const Rectangle_f& rect1, const Rectangle_f& rect2);
 
+// Rectangles stored as one array per coordinate, so that the IoUs of one
+// rectangle against many can be computed in a loop the compiler vectorizes.
+struct RectangleArrays {
+  void Add(const Rectangle_f& rect) {
+    xmin.push_back(rect.xmin());
+    ymin.push_back(rect.ymin());
+    xmax.push_back(rect.xmax());
+    ymax.push_back(rect.ymax());
+  }
+  int size() const { return xmin.size(); }
+
+  std::vector<float> xmin;
+  std::vector<float> ymin;
+  std::vector<float> xmax;
+  std::vector<float> ymax;
+};
+
+// Computes the IoU of rects[index] with every rectangle of |others| into
+// |ious|, which must have others.size() elements. The values are the same as
+// CalculateIou returns.
+void CalculateIous(const RectangleArrays& rects, int index,
+                   const RectangleArrays& others, absl::Span<float> ious);
+
 }  // namespace mediapipe
 
 #endif  // MEDIAPIPE_RECTANGLE_UTIL_H_
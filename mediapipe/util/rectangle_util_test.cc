@@ -14,6 +14,8 @@
 
 #include "mediapipe/util/rectangle_util.h"
 
+#include <vector>
+
 #include "mediapipe/framework/port/gtest.h"
 #include "mediapipe/framework/port/status_matchers.h"
 
@@ -156,6 +158,24 @@ TEST_F(RectangleUtilTest, OverlapSimilarityNotOverlapping) {
               FloatNear(kExpectedIou, kMaxAbsoluteError));
 }
 
+TEST_F(RectangleUtilTest, BatchedIousMatchCalculateIou) {
+  std::vector<Rectangle_f> rects;
+  RectangleArrays arrays;
+  for (const auto& nr : {nr_0, nr_1, nr_2, nr_3, nr_4, nr_5}) {
+    MP_ASSERT_OK_AND_ASSIGN(Rectangle_f rect, ToRectangle(nr));
+    rects.push_back(rect);
+    arrays.Add(rect);
+  }
+  std::vector<float> ious(arrays.size());
+  for (int i = 0; i < rects.size(); ++i) {
+    CalculateIous(arrays, i, arrays, absl::MakeSpan(ious));
+    for (int j = 0; j < rects.size(); ++j) {
+      EXPECT_FLOAT_EQ(ious[j], CalculateIou(rects[i], rects[j]))
+          << i << ", " << j;
+    }
+  }
+}
+
 TEST_F(RectangleUtilTest, NormRectToRectangleSuccess) {
   const Rectangle_f kExpectedRect(/*xmin=*/0.1, /*ymin=*/0.1,
                                   /*width=*/0.2, /*height=*/0.2);
@@ -15,12 +15,21 @@
 #include "mediapipe/util/sequence/media_sequence.h"
 
 #include <cmath>
+#include <cstdint>
+#include <istream>
 #include <limits>
+#include <string>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/absl_check.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "google/protobuf/io/zero_copy_stream_impl.h"
+#include "google/protobuf/util/delimited_message_util.h"
+#include "mediapipe/framework/port/advanced_proto_lite_inc.h"
 #include "mediapipe/framework/port/opencv_imgcodecs_inc.h"
 #include "mediapipe/framework/port/ret_check.h"
+#include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/util/sequence/media_sequence_util.h"
 
 namespace mediapipe {
@@ -398,6 +407,76 @@ absl::Status ReconcileMetadataRegionAnnotations(
   }
   return absl::OkStatus();
 }
+// Field numbers shared by the messages walked in ParseSequenceExampleFeatures:
+// SequenceExample.context and SequenceExample.feature_lists, the map fields
+// Features.feature and FeatureLists.feature_list, and the key and value of
+// their map entries.
+constexpr int kContextFieldNumber = 1;
+constexpr int kFeatureListsFieldNumber = 2;
+constexpr int kMapFieldNumber = 1;
+constexpr int kMapKeyFieldNumber = 1;
+constexpr int kMapValueFieldNumber = 2;
+
+using ::mediapipe::proto_ns::internal::WireFormatLite;
+using ::mediapipe::proto_ns::io::CodedInputStream;
+
+// Reads the payload of a length-delimited field as a view into buffer, the
+// array that "in" reads from.
+bool ReadDelimitedView(CodedInputStream* in, absl::string_view buffer,
+                       absl::string_view* view) {
+  uint32_t length;
+  if (!in->ReadVarint32(&length)) return false;
+  const int position = in->CurrentPosition();
+  if (length > buffer.size() - position) return false;
+  *view = buffer.substr(position, length);
+  return in->Skip(length);
+}
+
+bool IsDelimitedField(uint32_t tag, int field_number) {
+  return WireFormatLite::GetTagFieldNumber(tag) == field_number &&
+         WireFormatLite::GetTagWireType(tag) ==
+             WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+}
+
+// Parses the entries of the map field kMapFieldNumber of message whose key is
+// in keys into map. The values of the other entries are never decoded.
+template <typename MapT>
+absl::Status ParseSelectedMapEntries(
+    absl::string_view message, const absl::flat_hash_set<std::string>& keys,
+    MapT* map) {
+  CodedInputStream in(reinterpret_cast<const uint8_t*>(message.data()),
+                      message.size());
+  uint32_t tag;
+  while ((tag = in.ReadTag()) != 0) {
+    if (!IsDelimitedField(tag, kMapFieldNumber)) {
+      RET_CHECK(WireFormatLite::SkipField(&in, tag));
+      continue;
+    }
+    absl::string_view entry;
+    RET_CHECK(ReadDelimitedView(&in, message, &entry));
+    CodedInputStream entry_in(reinterpret_cast<const uint8_t*>(entry.data()),
+                              entry.size());
+    absl::string_view key;
+    absl::string_view value;
+    uint32_t entry_tag;
+    while ((entry_tag = entry_in.ReadTag()) != 0) {
+      if (IsDelimitedField(entry_tag, kMapKeyFieldNumber)) {
+        RET_CHECK(ReadDelimitedView(&entry_in, entry, &key));
+      } else if (IsDelimitedField(entry_tag, kMapValueFieldNumber)) {
+        RET_CHECK(ReadDelimitedView(&entry_in, entry, &value));
+      } else {
+        RET_CHECK(WireFormatLite::SkipField(&entry_in, entry_tag));
+      }
+    }
+    if (!keys.contains(key)) continue;
+    RET_CHECK((*map)[std::string(key)].ParseFromArray(value.data(),
+                                                      value.size()))
+        << "Failed to parse feature " << key;
+  }
+  RET_CHECK(in.ConsumedEntireMessage());
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 int GetBBoxSize(const std::string& prefix,
@@ -574,5 +653,67 @@ absl::Status ReconcileMetadata(bool reconcile_bbox_annotations,
   return absl::OkStatus();
 }
 
+absl::Status ParseSequenceExampleFeatures(
+    absl::string_view serialized,
+    const absl::flat_hash_set<std::string>& context_keys,
+    const absl::flat_hash_set<std::string>& feature_list_keys,
+    tensorflow::SequenceExample* sequence) {
+  sequence->Clear();
+  CodedInputStream in(reinterpret_cast<const uint8_t*>(serialized.data()),
+                      serialized.size());
+  uint32_t tag;
+  while ((tag = in.ReadTag()) != 0) {
+    absl::string_view message;
+    if (IsDelimitedField(tag, kContextFieldNumber)) {
+      RET_CHECK(ReadDelimitedView(&in, serialized, &message));
+      if (context_keys.empty()) continue;
+      MP_RETURN_IF_ERROR(ParseSelectedMapEntries(
+          message, context_keys,
+          sequence->mutable_context()->mutable_feature()));
+    } else if (IsDelimitedField(tag, kFeatureListsFieldNumber)) {
+      RET_CHECK(ReadDelimitedView(&in, serialized, &message));
+      if (feature_list_keys.empty()) continue;
+      MP_RETURN_IF_ERROR(ParseSelectedMapEntries(
+          message, feature_list_keys,
+          sequence->mutable_feature_lists()->mutable_feature_list()));
+    } else {
+      RET_CHECK(WireFormatLite::SkipField(&in, tag));
+    }
+  }
+  RET_CHECK(in.ConsumedEntireMessage())
+      << "Failed to parse tensorflow::SequenceExample.";
+  return absl::OkStatus();
+}
+
+void AppendSequenceExampleChunk(const tensorflow::SequenceExample& chunk,
+                                tensorflow::SequenceExample* sequence) {
+  for (const auto& [key, feature] : chunk.context().feature()) {
+    (*sequence->mutable_context()->mutable_feature())[key] = feature;
+  }
+  for (const auto& [key, feature_list] :
+       chunk.feature_lists().feature_list()) {
+    MutableFeatureList(key, sequence)
+        ->mutable_feature()
+        ->MergeFrom(feature_list.feature());
+  }
+}
+
+absl::Status ReadSequenceExampleChunks(std::istream* input,
+                                       tensorflow::SequenceExample* sequence) {
+  sequence->Clear();
+  proto_ns::io::IstreamInputStream stream(input);
+  tensorflow::SequenceExample chunk;
+  bool clean_eof = false;
+  while (true) {
+    chunk.Clear();
+    if (!proto_ns::util::ParseDelimitedFromZeroCopyStream(&chunk, &stream,
+                                                          &clean_eof)) {
+      RET_CHECK(clean_eof) << "Failed to parse a sequence example chunk.";
+      return absl::OkStatus();
+    }
+    AppendSequenceExampleChunk(chunk, sequence);
+  }
+}
+
 }  // namespace mediasequence
 }  // namespace mediapipe
@@ -158,10 +158,13 @@
 #ifndef MEDIAPIPE_TENSORFLOW_SEQUENCE_MEDIA_SEQUENCE_H_
 #define MEDIAPIPE_TENSORFLOW_SEQUENCE_MEDIA_SEQUENCE_H_
 
+#include <istream>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
 #include "mediapipe/framework/formats/location.h"
 #include "mediapipe/framework/formats/matrix.h"
 #include "mediapipe/framework/port/proto_ns.h"
@@ -752,6 +755,36 @@ PREFIXED_FLOAT_CONTEXT_FEATURE(FeatureAudioSampleRate,
 absl::Status ReconcileMetadata(bool reconcile_bbox_annotations,
                                bool reconcile_region_annotations,
                                tensorflow::SequenceExample* sequence);
+
+// Parses a serialized tensorflow::SequenceExample, keeping only the context
+// features in context_keys and the feature lists in feature_list_keys. The
+// other entries are skipped without being decoded, which is much cheaper than
+// a full parse when a graph only consumes a few of the features stored in a
+// sequence, e.g. the timestamps but not the encoded images. Keys include their
+// prefix, e.g. merge_prefix("LEFT", kImageEncodedKey).
+// Example:
+//   tensorflow::SequenceExample sequence;
+//   MP_RETURN_IF_ERROR(ParseSequenceExampleFeatures(
+//       serialized, {kClipDataPathKey},
+//       {kImageTimestampKey, kImageEncodedKey}, &sequence));
+absl::Status ParseSequenceExampleFeatures(
+    absl::string_view serialized,
+    const absl::flat_hash_set<std::string>& context_keys,
+    const absl::flat_hash_set<std::string>& feature_list_keys,
+    tensorflow::SequenceExample* sequence);
+
+// Appends a chunk of a sequence to sequence: the features of each of its
+// feature lists are appended to the feature list with the same key, and its
+// context features replace those with the same key.
+void AppendSequenceExampleChunk(const tensorflow::SequenceExample& chunk,
+                                tensorflow::SequenceExample* sequence);
+
+// Reassembles a sequence written in chunks, e.g. by PackMediaSequenceCalculator
+// with an OUTPUT_FILE_PATH, from a stream of length-delimited serialized
+// SequenceExamples. Metadata is not reconciled across chunks while writing,
+// so callers typically call ReconcileMetadata on the result.
+absl::Status ReadSequenceExampleChunks(std::istream* input,
+                                       tensorflow::SequenceExample* sequence);
 }  // namespace mediasequence
 }  // namespace mediapipe
 
@@ -15,9 +15,11 @@
 #include "mediapipe/util/sequence/media_sequence.h"
 
 #include <algorithm>
+#include <sstream>
 #include <string>
 #include <vector>
 
+#include "google/protobuf/util/delimited_message_util.h"
 #include "mediapipe/framework/formats/location.h"
 #include "mediapipe/framework/port/gmock.h"
 #include "mediapipe/framework/port/gtest.h"
@@ -1259,6 +1261,108 @@ TEST(MediaSequenceTest, ReconcileMetadataRegionAnnotations) {
   ASSERT_EQ(GetUnmodifiedBBoxTimestampAt("PREFIX", sequence, 0), 9);
   ASSERT_EQ(GetUnmodifiedBBoxTimestampAt("PREFIX", sequence, 1), 22);
 }
+
+TEST(MediaSequenceTest, ParseSequenceExampleFeaturesKeepsSelectedKeys) {
+  tensorflow::SequenceExample sequence;
+  SetClipDataPath("test/here", &sequence);
+  SetClipMediaId("media", &sequence);
+  AddImageTimestamp(1000, &sequence);
+  AddImageTimestamp(2000, &sequence);
+  AddImageEncoded("image_1", &sequence);
+  AddImageEncoded("image_2", &sequence);
+  AddImageTimestamp("LEFT", 3000, &sequence);
+  std::string serialized;
+  ASSERT_TRUE(sequence.SerializeToString(&serialized));
+
+  tensorflow::SequenceExample parsed;
+  MP_ASSERT_OK(ParseSequenceExampleFeatures(
+      serialized, {kClipDataPathKey},
+      {kImageTimestampKey, merge_prefix("LEFT", kImageTimestampKey)},
+      &parsed));
+
+  EXPECT_EQ(GetClipDataPath(parsed), "test/here");
+  EXPECT_FALSE(HasClipMediaId(parsed));
+  EXPECT_EQ(GetImageTimestampSize(parsed), 2);
+  EXPECT_EQ(GetImageTimestampAt(parsed, 1), 2000);
+  EXPECT_EQ(GetImageTimestampSize("LEFT", parsed), 1);
+  EXPECT_EQ(GetImageEncodedSize(parsed), 0);
+  EXPECT_EQ(parsed.context().feature_size(), 1);
+  EXPECT_EQ(parsed.feature_lists().feature_list_size(), 2);
+}
+
+TEST(MediaSequenceTest, ParseSequenceExampleFeaturesKeepsAllSelectedValues) {
+  tensorflow::SequenceExample sequence;
+  SetClipDataPath("test/here", &sequence);
+  AddImageTimestamp(1000, &sequence);
+  AddImageEncoded("image_1", &sequence);
+  std::string serialized;
+  ASSERT_TRUE(sequence.SerializeToString(&serialized));
+
+  tensorflow::SequenceExample parsed;
+  MP_ASSERT_OK(ParseSequenceExampleFeatures(
+      serialized, {kClipDataPathKey}, {kImageTimestampKey, kImageEncodedKey},
+      &parsed));
+
+  EXPECT_EQ(GetClipDataPath(parsed), "test/here");
+  ASSERT_EQ(GetImageTimestampSize(parsed), 1);
+  EXPECT_EQ(GetImageTimestampAt(parsed, 0), 1000);
+  ASSERT_EQ(GetImageEncodedSize(parsed), 1);
+  EXPECT_EQ(GetImageEncodedAt(parsed, 0), "image_1");
+}
+
+TEST(MediaSequenceTest, ParseSequenceExampleFeaturesFailsOnCorruptInput) {
+  tensorflow::SequenceExample sequence;
+  SetClipDataPath("test/here", &sequence);
+  std::string serialized;
+  ASSERT_TRUE(sequence.SerializeToString(&serialized));
+  serialized.resize(serialized.size() - 2);
+
+  tensorflow::SequenceExample parsed;
+  EXPECT_FALSE(ParseSequenceExampleFeatures(serialized, {kClipDataPathKey}, {},
+                                            &parsed)
+                   .ok());
+}
+
+TEST(MediaSequenceTest, ReadSequenceExampleChunksReassemblesSequence) {
+  std::stringstream stream;
+  tensorflow::SequenceExample first_chunk;
+  AddImageTimestamp(1000, &first_chunk);
+  AddImageEncoded("image_1", &first_chunk);
+  ASSERT_TRUE(proto_ns::util::SerializeDelimitedToOstream(first_chunk, &stream));
+  tensorflow::SequenceExample second_chunk;
+  AddImageTimestamp(2000, &second_chunk);
+  AddImageEncoded("image_2", &second_chunk);
+  AddFeatureFloats("FEATURE", {1.0f, 2.0f}, &second_chunk);
+  ASSERT_TRUE(
+      proto_ns::util::SerializeDelimitedToOstream(second_chunk, &stream));
+  tensorflow::SequenceExample context_chunk;
+  SetClipDataPath("test/here", &context_chunk);
+  ASSERT_TRUE(
+      proto_ns::util::SerializeDelimitedToOstream(context_chunk, &stream));
+
+  tensorflow::SequenceExample sequence;
+  MP_ASSERT_OK(ReadSequenceExampleChunks(&stream, &sequence));
+
+  EXPECT_EQ(GetClipDataPath(sequence), "test/here");
+  ASSERT_EQ(GetImageTimestampSize(sequence), 2);
+  EXPECT_EQ(GetImageTimestampAt(sequence, 0), 1000);
+  EXPECT_EQ(GetImageTimestampAt(sequence, 1), 2000);
+  ASSERT_EQ(GetImageEncodedSize(sequence), 2);
+  EXPECT_EQ(GetImageEncodedAt(sequence, 1), "image_2");
+  EXPECT_EQ(GetFeatureFloatsSize("FEATURE", sequence), 1);
+}
+
+TEST(MediaSequenceTest, ReadSequenceExampleChunksFailsOnTruncatedChunk) {
+  tensorflow::SequenceExample chunk;
+  SetClipDataPath("test/here", &chunk);
+  std::stringstream stream;
+  ASSERT_TRUE(proto_ns::util::SerializeDelimitedToOstream(chunk, &stream));
+  std::string serialized = stream.str();
+  std::stringstream truncated(serialized.substr(0, serialized.size() - 2));
+
+  tensorflow::SequenceExample sequence;
+  EXPECT_FALSE(ReadSequenceExampleChunks(&truncated, &sequence).ok());
+}
 }  // namespace
 }  // namespace mediasequence
 }  // namespace mediapipe
@@ -0,0 +1,252 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/shared_memory_ring.h"
+
+#if !defined(_WIN32) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // !defined(_WIN32) && !defined(__ANDROID__)
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_cat.h"
+#include "mediapipe/framework/port/ret_check.h"
+
+namespace mediapipe {
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "SharedMemoryRing requires lock-free 64 bit atomics");
+
+// The first bytes of the mapping. The counters are written by different
+// processes, so they are kept on separate cache lines.
+struct SharedMemoryRing::Control {
+  static constexpr char kMagic[8] = "MPSHMRG";
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t num_slots;
+  uint64_t slot_size;
+  uint64_t slot_stride;
+  // Set by the producer once the fields above are initialized.
+  std::atomic<uint32_t> ready;
+  // The number of records written by the producer.
+  alignas(64) std::atomic<uint64_t> write_count;
+  // The number of records released by the consumer, oldest first.
+  alignas(64) std::atomic<uint64_t> release_count;
+};
+
+namespace {
+
+constexpr size_t kCacheLineSize = 64;
+
+size_t RoundUp(size_t size, size_t alignment) {
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+// The offset of the first slot in the mapping.
+constexpr size_t kSlotsOffset = 256;
+// The offset of the payload in a slot, leaving room for the header while
+// keeping the payload aligned for ImageFrame and SIMD access.
+constexpr size_t kPayloadOffset = 128;
+
+}  // namespace
+
+static_assert(sizeof(SharedMemoryRecordHeader) <= kPayloadOffset,
+              "The record header overlaps the payload");
+
+#if defined(_WIN32) || defined(__ANDROID__)
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRing>> SharedMemoryRing::Create(
+    const std::string& name, int num_slots, size_t slot_size) {
+  return absl::UnimplementedError("Shared memory rings require shm_open.");
+}
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRing>> SharedMemoryRing::Open(
+    const std::string& name, absl::Duration timeout) {
+  return absl::UnimplementedError("Shared memory rings require shm_open.");
+}
+
+SharedMemoryRing::~SharedMemoryRing() {}
+
+#else
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRing>> SharedMemoryRing::Create(
+    const std::string& name, int num_slots, size_t slot_size) {
+  RET_CHECK(!name.empty() && name[0] == '/')
+      << "Shared memory names start with '/', got " << name;
+  RET_CHECK_GT(num_slots, 0);
+  RET_CHECK_GT(slot_size, 0);
+  // A stale object may be left behind by a producer that crashed.
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    return absl::ErrnoToStatus(errno, absl::StrCat("Cannot create ", name));
+  }
+  const size_t slot_stride =
+      RoundUp(kPayloadOffset + slot_size, kCacheLineSize);
+  const size_t mapping_size = kSlotsOffset + num_slots * slot_stride;
+  if (ftruncate(fd, mapping_size) != 0) {
+    absl::Status status =
+        absl::ErrnoToStatus(errno, absl::StrCat("Cannot resize ", name));
+    close(fd);
+    shm_unlink(name.c_str());
+    return status;
+  }
+  void* mapping =
+      mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (mapping == MAP_FAILED) {
+    absl::Status status =
+        absl::ErrnoToStatus(errno, absl::StrCat("Cannot map ", name));
+    close(fd);
+    shm_unlink(name.c_str());
+    return status;
+  }
+  Control* control = new (mapping) Control();
+  std::memcpy(control->magic, Control::kMagic, sizeof(control->magic));
+  control->version = Control::kVersion;
+  control->num_slots = num_slots;
+  control->slot_size = slot_size;
+  control->slot_stride = slot_stride;
+  control->write_count.store(0, std::memory_order_relaxed);
+  control->release_count.store(0, std::memory_order_relaxed);
+  control->ready.store(1, std::memory_order_release);
+  return absl::WrapUnique(new SharedMemoryRing(name, /*is_producer=*/true, fd,
+                                               mapping, mapping_size));
+}
+
+absl::StatusOr<std::unique_ptr<SharedMemoryRing>> SharedMemoryRing::Open(
+    const std::string& name, absl::Duration timeout) {
+  const absl::Time deadline = absl::Now() + timeout;
+  while (true) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd >= 0) {
+      struct stat file_stat;
+      if (fstat(fd, &file_stat) == 0 &&
+          file_stat.st_size > static_cast<off_t>(kSlotsOffset)) {
+        const size_t mapping_size = file_stat.st_size;
+        void* mapping = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+          const Control* control = static_cast<const Control*>(mapping);
+          if (control->ready.load(std::memory_order_acquire) == 1) {
+            if (std::memcmp(control->magic, Control::kMagic,
+                            sizeof(control->magic)) != 0 ||
+                control->version != Control::kVersion) {
+              munmap(mapping, mapping_size);
+              close(fd);
+              return absl::FailedPreconditionError(
+                  absl::StrCat(name, " is not a shared memory ring."));
+            }
+            return absl::WrapUnique(new SharedMemoryRing(
+                name, /*is_producer=*/false, fd, mapping, mapping_size));
+          }
+          munmap(mapping, mapping_size);
+        }
+      }
+      close(fd);
+    } else if (errno != ENOENT) {
+      return absl::ErrnoToStatus(errno, absl::StrCat("Cannot open ", name));
+    }
+    if (absl::Now() > deadline) {
+      return absl::DeadlineExceededError(
+          absl::StrCat("Timed out waiting for ", name, " to be created."));
+    }
+    absl::SleepFor(absl::Milliseconds(1));
+  }
+}
+
+SharedMemoryRing::~SharedMemoryRing() {
+  munmap(mapping_, mapping_size_);
+  close(fd_);
+  if (is_producer_) {
+    shm_unlink(name_.c_str());
+  }
+}
+
+#endif  // defined(_WIN32) || defined(__ANDROID__)
+
+SharedMemoryRing::SharedMemoryRing(std::string name, bool is_producer, int fd,
+                                   void* mapping, size_t mapping_size)
+    : name_(std::move(name)),
+      is_producer_(is_producer),
+      fd_(fd),
+      mapping_(mapping),
+      mapping_size_(mapping_size),
+      control_(static_cast<Control*>(mapping)),
+      num_slots_(control_->num_slots),
+      slot_size_(control_->slot_size),
+      slot_stride_(control_->slot_stride),
+      write_index_(control_->write_count.load(std::memory_order_acquire)),
+      read_index_(control_->release_count.load(std::memory_order_acquire)),
+      released_(num_slots_, false) {
+  static_assert(sizeof(Control) <= kSlotsOffset,
+                "The control block overlaps the slots");
+}
+
+SharedMemoryRing::Slot SharedMemoryRing::GetSlot(uint64_t index) const {
+  uint8_t* slot = static_cast<uint8_t*>(mapping_) + kSlotsOffset +
+                  (index % num_slots_) * slot_stride_;
+  return {index, reinterpret_cast<SharedMemoryRecordHeader*>(slot),
+          slot + kPayloadOffset};
+}
+
+std::optional<SharedMemoryRing::Slot> SharedMemoryRing::BeginWrite() {
+  const uint64_t release_count =
+      control_->release_count.load(std::memory_order_acquire);
+  if (write_index_ - release_count >= static_cast<uint64_t>(num_slots_)) {
+    return std::nullopt;
+  }
+  return GetSlot(write_index_);
+}
+
+void SharedMemoryRing::EndWrite() {
+  ++write_index_;
+  // The consumer sees the record before the count that covers it.
+  control_->write_count.store(write_index_, std::memory_order_release);
+}
+
+std::optional<SharedMemoryRing::Slot> SharedMemoryRing::BeginRead() {
+  if (read_index_ >= control_->write_count.load(std::memory_order_acquire)) {
+    return std::nullopt;
+  }
+  return GetSlot(read_index_++);
+}
+
+void SharedMemoryRing::EndRead(uint64_t index) {
+  absl::MutexLock lock(&mutex_);
+  released_[index % num_slots_] = true;
+  // Only the consumer writes the release count.
+  uint64_t release_count =
+      control_->release_count.load(std::memory_order_relaxed);
+  const uint64_t old_release_count = release_count;
+  while (released_[release_count % num_slots_]) {
+    released_[release_count % num_slots_] = false;
+    ++release_count;
+  }
+  if (release_count != old_release_count) {
+    // The producer overwrites a slot only after the consumer is done with it.
+    control_->release_count.store(release_count, std::memory_order_release);
+  }
+}
+
+}  // namespace mediapipe
@@ -0,0 +1,149 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef MEDIAPIPE_UTIL_SHARED_MEMORY_RING_H_
+#define MEDIAPIPE_UTIL_SHARED_MEMORY_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+
+namespace mediapipe {
+
+// The metadata of one record in a SharedMemoryRing. Its meaning beyond `type`
+// and `timestamp` is up to the producer and the consumer.
+struct SharedMemoryRecordHeader {
+  enum Type : uint32_t {
+    // A payload, e.g. a packet, at `timestamp`.
+    kPayload = 0,
+    // No payload, the producer's timestamp bound moved to `timestamp`.
+    kTimestampBound = 1,
+    // No payload, the producer closed the ring.
+    kClose = 2,
+  };
+  static constexpr int kMaxDims = 8;
+
+  int64_t timestamp;
+  uint32_t type;
+  // E.g. the type of the payload.
+  uint32_t payload_kind;
+  // E.g. the image format or the tensor element type.
+  int32_t format;
+  int32_t num_dims;
+  int32_t dims[kMaxDims];
+  // E.g. the image width step.
+  int32_t stride;
+  // E.g. the quantization of a tensor.
+  float scale;
+  int32_t zero_point;
+  int32_t reserved;
+  uint64_t payload_size;
+};
+static_assert(sizeof(SharedMemoryRecordHeader) == 80,
+              "SharedMemoryRecordHeader must be packed");
+
+// A single-producer single-consumer ring of fixed-size records in a named
+// POSIX shared memory object, for passing packets between processes without
+// serialization or sockets.
+//
+// The producer and the consumer only synchronize through two atomic counters
+// in the shared mapping, so neither takes a lock or makes a system call per
+// record. The consumer may release records out of order, e.g. when they back
+// packets held downstream; a slot is reused once it and all older slots are
+// released.
+//
+// Not supported on Windows and Android, where Create() and Open() fail.
+class SharedMemoryRing {
+ public:
+  // A record in the mapping.
+  struct Slot {
+    // The index of the record since the ring was created.
+    uint64_t index;
+    SharedMemoryRecordHeader* header;
+    // Points to slot_size() bytes.
+    uint8_t* payload;
+  };
+
+  // Creates the shared memory object `name` (which starts with '/') with
+  // `num_slots` records of up to `slot_size` payload bytes, replacing any
+  // stale object of that name.
+  static absl::StatusOr<std::unique_ptr<SharedMemoryRing>> Create(
+      const std::string& name, int num_slots, size_t slot_size);
+
+  // Opens the shared memory object `name` created by a producer, waiting up to
+  // `timeout` for it to be created.
+  static absl::StatusOr<std::unique_ptr<SharedMemoryRing>> Open(
+      const std::string& name, absl::Duration timeout);
+
+  // Unmaps the ring. The producer also unlinks its name, the consumer and
+  // records it still holds are not affected.
+  ~SharedMemoryRing();
+  SharedMemoryRing(const SharedMemoryRing&) = delete;
+  SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+  // Producer: returns the next free slot, or nullopt if all slots hold
+  // records which were not released yet. The record becomes visible to the
+  // consumer with EndWrite().
+  std::optional<Slot> BeginWrite();
+  void EndWrite();
+
+  // Consumer: returns the next unread record, or nullopt if there is none.
+  // Each returned record must be released with EndRead(), in any order and
+  // from any thread.
+  std::optional<Slot> BeginRead();
+  void EndRead(uint64_t index) ABSL_LOCKS_EXCLUDED(mutex_);
+
+  int num_slots() const { return num_slots_; }
+  size_t slot_size() const { return slot_size_; }
+
+ private:
+  struct Control;
+
+  SharedMemoryRing(std::string name, bool is_producer, int fd, void* mapping,
+                   size_t mapping_size);
+
+  Slot GetSlot(uint64_t index) const;
+
+  const std::string name_;
+  const bool is_producer_;
+  const int fd_;
+  void* const mapping_;
+  const size_t mapping_size_;
+  Control* const control_;
+  int num_slots_ = 0;
+  size_t slot_size_ = 0;
+  size_t slot_stride_ = 0;
+
+  // Producer: the index of the next record to write.
+  uint64_t write_index_ = 0;
+  // Consumer: the index of the next record to read.
+  uint64_t read_index_ = 0;
+
+  // Consumer: which of the records after the release count were released.
+  absl::Mutex mutex_;
+  std::vector<bool> released_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_SHARED_MEMORY_RING_H_
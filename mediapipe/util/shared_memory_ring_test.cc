@@ -0,0 +1,118 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/shared_memory_ring.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+
+namespace mediapipe {
+namespace {
+
+std::string TestRingName(const std::string& test_name) {
+  return absl::StrCat("/mediapipe_shared_memory_ring_test_", test_name);
+}
+
+void WriteRecord(SharedMemoryRing& ring, int64_t timestamp,
+                 const std::string& payload) {
+  std::optional<SharedMemoryRing::Slot> slot = ring.BeginWrite();
+  ASSERT_TRUE(slot.has_value());
+  slot->header->timestamp = timestamp;
+  slot->header->type = SharedMemoryRecordHeader::kPayload;
+  slot->header->payload_size = payload.size();
+  std::memcpy(slot->payload, payload.data(), payload.size());
+  ring.EndWrite();
+}
+
+std::string PayloadOf(const SharedMemoryRing::Slot& slot) {
+  return std::string(reinterpret_cast<const char*>(slot.payload),
+                     slot.header->payload_size);
+}
+
+TEST(SharedMemoryRingTest, PassesRecordsInOrder) {
+  const std::string name = TestRingName("in_order");
+  auto producer = SharedMemoryRing::Create(name, /*num_slots=*/2,
+                                           /*slot_size=*/16);
+  if (producer.status().code() == absl::StatusCode::kUnimplemented) {
+    GTEST_SKIP() << producer.status();
+  }
+  ASSERT_TRUE(producer.ok()) << producer.status();
+  auto consumer = SharedMemoryRing::Open(name, absl::Seconds(1));
+  ASSERT_TRUE(consumer.ok()) << consumer.status();
+  EXPECT_EQ(2, (*consumer)->num_slots());
+  EXPECT_EQ(16, (*consumer)->slot_size());
+  EXPECT_FALSE((*consumer)->BeginRead().has_value());
+
+  WriteRecord(**producer, 10, "first");
+  WriteRecord(**producer, 20, "second");
+  // Both slots are in use until the consumer releases them.
+  EXPECT_FALSE((*producer)->BeginWrite().has_value());
+
+  std::optional<SharedMemoryRing::Slot> first = (*consumer)->BeginRead();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(10, first->header->timestamp);
+  EXPECT_EQ("first", PayloadOf(*first));
+  (*consumer)->EndRead(first->index);
+
+  WriteRecord(**producer, 30, "third");
+  std::optional<SharedMemoryRing::Slot> second = (*consumer)->BeginRead();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ("second", PayloadOf(*second));
+  std::optional<SharedMemoryRing::Slot> third = (*consumer)->BeginRead();
+  ASSERT_TRUE(third.has_value());
+  EXPECT_EQ(30, third->header->timestamp);
+  EXPECT_EQ("third", PayloadOf(*third));
+  EXPECT_FALSE((*consumer)->BeginRead().has_value());
+}
+
+TEST(SharedMemoryRingTest, ReusesSlotsOnlyAfterOlderSlotsAreReleased) {
+  const std::string name = TestRingName("out_of_order");
+  auto producer = SharedMemoryRing::Create(name, /*num_slots=*/2,
+                                           /*slot_size=*/16);
+  if (producer.status().code() == absl::StatusCode::kUnimplemented) {
+    GTEST_SKIP() << producer.status();
+  }
+  ASSERT_TRUE(producer.ok()) << producer.status();
+  auto consumer = SharedMemoryRing::Open(name, absl::Seconds(1));
+  ASSERT_TRUE(consumer.ok()) << consumer.status();
+
+  WriteRecord(**producer, 10, "first");
+  WriteRecord(**producer, 20, "second");
+  std::optional<SharedMemoryRing::Slot> first = (*consumer)->BeginRead();
+  std::optional<SharedMemoryRing::Slot> second = (*consumer)->BeginRead();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+
+  (*consumer)->EndRead(second->index);
+  EXPECT_FALSE((*producer)->BeginWrite().has_value());
+  (*consumer)->EndRead(first->index);
+  EXPECT_TRUE((*producer)->BeginWrite().has_value());
+}
+
+TEST(SharedMemoryRingTest, OpenTimesOutWithoutProducer) {
+  auto consumer =
+      SharedMemoryRing::Open(TestRingName("missing"), absl::Milliseconds(10));
+  EXPECT_FALSE(consumer.ok());
+}
+
+}  // namespace
+}  // namespace mediapipe
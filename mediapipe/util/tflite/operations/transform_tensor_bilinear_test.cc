@@ -0,0 +1,188 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tflite/operations/transform_tensor_bilinear.h"
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "flatbuffers/flexbuffers.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "tensorflow/lite/kernels/test_util.h"
+
+namespace mediapipe::tflite_operations {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::tflite::ArrayFloatNear;
+
+struct Size {
+  int height;
+  int width;
+};
+
+class TransformTensorBilinearModel : public tflite::SingleOpModel {
+ public:
+  TransformTensorBilinearModel(
+      std::function<TfLiteRegistration*()> registration, Size input_size,
+      Size output_size, int channels) {
+    input_ = AddInput({tflite::TensorType_FLOAT32,
+                       {1, input_size.height, input_size.width, channels}});
+    matrix_ = AddInput({tflite::TensorType_FLOAT32, {1, 1, 4, 4}});
+    output_ = AddOutput({tflite::TensorType_FLOAT32,
+                         {1, output_size.height, output_size.width, channels}});
+
+    flexbuffers::Builder fbb;
+    fbb.Map([&]() {
+      fbb.TypedVector("output_size", [&]() {
+        fbb.Int(output_size.height);
+        fbb.Int(output_size.width);
+      });
+    });
+    fbb.Finish();
+    SetCustomOp("TransformTensorBilinear", fbb.GetBuffer(), registration);
+    BuildInterpreter({GetShape(input_), GetShape(matrix_)});
+  }
+
+  void SetInput(const std::vector<float>& input) {
+    PopulateTensor(input_, input);
+  }
+  void SetMatrix(const std::vector<float>& matrix) {
+    PopulateTensor(matrix_, matrix);
+  }
+
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+
+ private:
+  int input_;
+  int matrix_;
+  int output_;
+};
+
+// The per channel loop the op used before sampling was shared across
+// channels, kept as the reference. `align_corners` selects the V2 correction.
+std::vector<float> ReferenceTransformTensor(const std::vector<float>& input,
+                                            Size input_size,
+                                            const std::vector<float>& matrix,
+                                            Size output_size, int channels,
+                                            bool align_corners) {
+  float x_transform[4] = {matrix[0], matrix[1], matrix[2], matrix[3]};
+  float y_transform[4] = {matrix[4], matrix[5], matrix[6], matrix[7]};
+  if (align_corners) {
+    x_transform[3] += x_transform[0] * 0.5 + x_transform[1] * 0.5 - 0.5;
+    y_transform[3] += y_transform[0] * 0.5 + y_transform[1] * 0.5 - 0.5;
+  }
+
+  std::vector<float> output;
+  output.reserve(output_size.height * output_size.width * channels);
+  for (int out_y = 0; out_y < output_size.height; ++out_y) {
+    for (int out_x = 0; out_x < output_size.width; ++out_x) {
+      const float tc_x =
+          x_transform[0] * out_x + x_transform[1] * out_y + x_transform[3];
+      const float tc_y =
+          y_transform[0] * out_x + y_transform[1] * out_y + y_transform[3];
+      const bool out_of_bound = tc_x < 0.0 || tc_x > input_size.width - 1 ||
+                                tc_y < 0.0 || tc_y > input_size.height - 1;
+      for (int z = 0; z < channels; ++z) {
+        float result = 0;
+        if (!out_of_bound) {
+          auto read_value = [&](int h, int w) -> float {
+            return h < 0 || w < 0 || h >= input_size.height ||
+                           w >= input_size.width
+                       ? 0
+                       : input[(h * input_size.width + w) * channels + z];
+          };
+          const float q_11 = read_value(floor(tc_y), floor(tc_x));
+          const float q_21 = read_value(floor(tc_y), floor(tc_x) + 1);
+          const float q_12 = read_value(floor(tc_y) + 1, floor(tc_x));
+          const float q_22 = read_value(floor(tc_y) + 1, floor(tc_x) + 1);
+
+          const float right_contrib = tc_x - floor(tc_x);
+          const float lower_contrib = tc_y - floor(tc_y);
+
+          const float upper =
+              (1.0 - right_contrib) * q_11 + right_contrib * q_21;
+          const float lower =
+              (1.0 - right_contrib) * q_12 + right_contrib * q_22;
+
+          result = lower_contrib * lower + (1.0 - lower_contrib) * upper;
+        }
+        output.push_back(result);
+      }
+    }
+  }
+  return output;
+}
+
+// Row-major 4x4 matrices with the first two rows mapping output to input
+// coordinates.
+std::vector<std::vector<float>> TestMatrices() {
+  const float angle = 0.3f;
+  return {
+      // Identity: samples land exactly on the last row and column, whose
+      // right and lower neighbors are past the input.
+      {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1},
+      // Upscaling with a fractional shift.
+      {0.45f, 0, 0, 0.3f, 0, 0.55f, 0, 0.2f, 0, 0, 1, 0, 0, 0, 0, 1},
+      // Rotation, partially out of bounds.
+      {std::cos(angle), -std::sin(angle), 0, 1.5f, std::sin(angle),
+       std::cos(angle), 0, -0.5f, 0, 0, 1, 0, 0, 0, 0, 1},
+      // Fully out of bounds.
+      {1, 0, 0, -100, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1},
+  };
+}
+
+void ExpectMatchesReference(std::function<TfLiteRegistration*()> registration,
+                            bool align_corners) {
+  // Odd sizes and channel counts, including a single channel and counts that
+  // leave a tail after a vector width.
+  const Size input_size = {7, 9};
+  const Size output_size = {6, 11};
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  for (const int channels : {1, 3, 5, 17}) {
+    std::vector<float> input(input_size.height * input_size.width * channels);
+    for (float& value : input) value = distribution(rng);
+    for (const std::vector<float>& matrix : TestMatrices()) {
+      TransformTensorBilinearModel model(registration, input_size, output_size,
+                                         channels);
+      model.SetInput(input);
+      model.SetMatrix(matrix);
+      ASSERT_EQ(model.Invoke(), kTfLiteOk);
+
+      const std::vector<float> expected = ReferenceTransformTensor(
+          input, input_size, matrix, output_size, channels, align_corners);
+      EXPECT_THAT(model.GetOutput(),
+                  ElementsAreArray(ArrayFloatNear(expected, 1e-5)))
+          << "channels: " << channels;
+    }
+  }
+}
+
+TEST(TransformTensorBilinearTest, V1MatchesReference) {
+  ExpectMatchesReference(RegisterTransformTensorBilinearV1,
+                         /*align_corners=*/false);
+}
+
+TEST(TransformTensorBilinearTest, V2MatchesReference) {
+  ExpectMatchesReference(RegisterTransformTensorBilinearV2,
+                         /*align_corners=*/true);
+}
+
+}  // namespace
+}  // namespace mediapipe::tflite_operations
@@ -0,0 +1,255 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tflite/operations/transpose_conv_bias.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/kernels/test_util.h"
+
+namespace mediapipe::tflite_operations {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::tflite::ArrayFloatNear;
+
+struct ConvShape {
+  int batches;
+  int input_height;
+  int input_width;
+  int input_depth;
+  int output_depth;
+  int filter_height;
+  int filter_width;
+  int stride_height;
+  int stride_width;
+  TfLitePadding padding;
+};
+
+std::vector<uint8_t> CreateOptions(const ConvShape& shape) {
+  TfLiteTransposeConvParams params = {};
+  params.padding = shape.padding;
+  params.stride_width = shape.stride_width;
+  params.stride_height = shape.stride_height;
+  std::vector<uint8_t> options(sizeof(params));
+  std::memcpy(options.data(), &params, sizeof(params));
+  return options;
+}
+
+class TransposeConvBiasModel : public tflite::SingleOpModel {
+ public:
+  // Creates the op with non-constant weights if `const_weights` is empty.
+  TransposeConvBiasModel(const ConvShape& shape,
+                         std::initializer_list<float> const_weights = {}) {
+    const std::vector<int> weights_shape = {
+        shape.output_depth, shape.filter_height, shape.filter_width,
+        shape.input_depth};
+    if (const_weights.size() == 0) {
+      weights_ = AddInput({tflite::TensorType_FLOAT32, weights_shape});
+    } else {
+      weights_ = AddConstInput({tflite::TensorType_FLOAT32, weights_shape},
+                               const_weights);
+    }
+    input_ = AddInput(
+        {tflite::TensorType_FLOAT32,
+         {shape.batches, shape.input_height, shape.input_width,
+          shape.input_depth}});
+    bias_ = AddInput({tflite::TensorType_FLOAT32, {shape.output_depth}});
+    output_ = AddOutput({tflite::TensorType_FLOAT32, {}});
+    SetCustomOp("Convolution2DTransposeBias", CreateOptions(shape),
+                RegisterConvolution2DTransposeBias);
+    BuildInterpreter({GetShape(weights_), GetShape(input_), GetShape(bias_)});
+  }
+
+  void SetWeights(const std::vector<float>& weights) {
+    PopulateTensor(weights_, weights);
+  }
+  void SetInput(const std::vector<float>& input) {
+    PopulateTensor(input_, input);
+  }
+  void SetBias(const std::vector<float>& bias) { PopulateTensor(bias_, bias); }
+
+  std::vector<float> GetOutput() { return ExtractVector<float>(output_); }
+  std::vector<int> GetOutputShape() { return GetTensorShape(output_); }
+
+ private:
+  int weights_;
+  int input_;
+  int bias_;
+  int output_;
+};
+
+// The scalar loop the op used before its weights were repacked, kept as the
+// reference. Weights are in OHWI order.
+std::vector<float> ReferenceTransposeConvBias(
+    const ConvShape& shape, const std::vector<float>& input,
+    const std::vector<float>& weights, const std::vector<float>& bias,
+    const std::vector<int>& output_shape) {
+  const tflite::RuntimeShape input_shape(
+      {shape.batches, shape.input_height, shape.input_width,
+       shape.input_depth});
+  const tflite::RuntimeShape filter_shape(
+      {shape.output_depth, shape.filter_height, shape.filter_width,
+       shape.input_depth});
+  const tflite::RuntimeShape out_shape(4, output_shape.data());
+  const int output_height = output_shape[1];
+  const int output_width = output_shape[2];
+
+  int pad_height = 0;
+  int pad_width = 0;
+  if (shape.padding == kTfLitePaddingSame) {
+    const int input_tail_y = (shape.input_height - 1) % shape.stride_height;
+    const int input_tail_x = (shape.input_width - 1) % shape.stride_width;
+    pad_height = std::max(0, shape.filter_height - input_tail_y - 1) / 2;
+    pad_width = std::max(0, shape.filter_width - input_tail_x - 1) / 2;
+  }
+
+  std::vector<float> output(out_shape.FlatSize());
+  for (int batch = 0; batch < shape.batches; ++batch) {
+    for (int out_y = 0; out_y < output_height; ++out_y) {
+      for (int out_x = 0; out_x < output_width; ++out_x) {
+        for (int out_channel = 0; out_channel < shape.output_depth;
+             ++out_channel) {
+          output[Offset(out_shape, batch, out_y, out_x, out_channel)] =
+              bias[out_channel];
+        }
+      }
+    }
+    for (int in_y = 0; in_y < shape.input_height; ++in_y) {
+      for (int in_x = 0; in_x < shape.input_width; ++in_x) {
+        for (int in_channel = 0; in_channel < shape.input_depth;
+             ++in_channel) {
+          const int out_x_origin = in_x * shape.stride_width - pad_width;
+          const int out_y_origin = in_y * shape.stride_height - pad_height;
+          for (int filter_y = 0; filter_y < shape.filter_height; ++filter_y) {
+            for (int filter_x = 0; filter_x < shape.filter_width;
+                 ++filter_x) {
+              for (int out_channel = 0; out_channel < shape.output_depth;
+                   ++out_channel) {
+                const int out_x = out_x_origin + filter_x;
+                const int out_y = out_y_origin + filter_y;
+                if (out_x >= 0 && out_x < output_width && out_y >= 0 &&
+                    out_y < output_height) {
+                  output[Offset(out_shape, batch, out_y, out_x,
+                                out_channel)] +=
+                      input[Offset(input_shape, batch, in_y, in_x,
+                                   in_channel)] *
+                      weights[Offset(filter_shape, out_channel, filter_y,
+                                     filter_x, in_channel)];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  return output;
+}
+
+std::vector<float> RandomVector(int size, std::mt19937& rng) {
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  std::vector<float> result(size);
+  for (float& value : result) value = distribution(rng);
+  return result;
+}
+
+TEST(TransposeConvBiasTest, MatchesReferenceOnOddShapes) {
+  // Odd sizes, strides that do and do not divide the filter, and filters
+  // wider than the stride so that output borders are clipped.
+  const std::vector<ConvShape> shapes = {
+      {1, 1, 1, 1, 1, 1, 1, 1, 1, kTfLitePaddingValid},
+      {1, 3, 5, 3, 5, 3, 3, 2, 2, kTfLitePaddingSame},
+      {1, 3, 5, 3, 5, 3, 3, 2, 2, kTfLitePaddingValid},
+      {2, 7, 4, 5, 7, 4, 2, 2, 1, kTfLitePaddingSame},
+      {1, 5, 9, 1, 17, 5, 5, 3, 3, kTfLitePaddingSame},
+      {1, 4, 6, 6, 3, 2, 3, 1, 3, kTfLitePaddingValid},
+  };
+  std::mt19937 rng(0);
+  for (const ConvShape& shape : shapes) {
+    TransposeConvBiasModel model(shape);
+    const std::vector<float> weights =
+        RandomVector(shape.output_depth * shape.filter_height *
+                         shape.filter_width * shape.input_depth,
+                     rng);
+    const std::vector<float> input =
+        RandomVector(shape.batches * shape.input_height * shape.input_width *
+                         shape.input_depth,
+                     rng);
+    const std::vector<float> bias = RandomVector(shape.output_depth, rng);
+    model.SetWeights(weights);
+    model.SetInput(input);
+    model.SetBias(bias);
+    ASSERT_EQ(model.Invoke(), kTfLiteOk);
+
+    const std::vector<float> expected = ReferenceTransposeConvBias(
+        shape, input, weights, bias, model.GetOutputShape());
+    EXPECT_THAT(model.GetOutput(),
+                ElementsAreArray(ArrayFloatNear(expected, 1e-5)));
+  }
+}
+
+TEST(TransposeConvBiasTest, RepacksNonConstantWeights) {
+  const ConvShape shape = {1, 3, 3, 2, 3, 3, 3, 2, 2, kTfLitePaddingSame};
+  TransposeConvBiasModel model(shape);
+  std::mt19937 rng(0);
+  const std::vector<float> input = RandomVector(3 * 3 * 2, rng);
+  const std::vector<float> bias = RandomVector(3, rng);
+  model.SetInput(input);
+  model.SetBias(bias);
+  for (int i = 0; i < 2; ++i) {
+    const std::vector<float> weights = RandomVector(3 * 3 * 3 * 2, rng);
+    model.SetWeights(weights);
+    ASSERT_EQ(model.Invoke(), kTfLiteOk);
+
+    const std::vector<float> expected = ReferenceTransposeConvBias(
+        shape, input, weights, bias, model.GetOutputShape());
+    EXPECT_THAT(model.GetOutput(),
+                ElementsAreArray(ArrayFloatNear(expected, 1e-5)));
+  }
+}
+
+TEST(TransposeConvBiasTest, PacksConstantWeightsOnce) {
+  const ConvShape shape = {1, 2, 3, 2, 3, 2, 2, 2, 2, kTfLitePaddingValid};
+  const std::initializer_list<float> weights = {
+      0.1f,  -0.2f, 0.3f,  0.4f,  -0.5f, 0.6f,  0.7f,  -0.8f,
+      0.9f,  1.0f,  -1.1f, 1.2f,  1.3f,  -1.4f, 1.5f,  1.6f,
+      -1.7f, 1.8f,  1.9f,  -2.0f, 2.1f,  2.2f,  -2.3f, 2.4f};
+  TransposeConvBiasModel model(shape, weights);
+  std::mt19937 rng(0);
+  const std::vector<float> bias = RandomVector(3, rng);
+  model.SetBias(bias);
+  // The second invocation runs on the weights packed by the first one.
+  for (int i = 0; i < 2; ++i) {
+    const std::vector<float> input = RandomVector(2 * 3 * 2, rng);
+    model.SetInput(input);
+    ASSERT_EQ(model.Invoke(), kTfLiteOk);
+
+    const std::vector<float> expected = ReferenceTransposeConvBias(
+        shape, input, weights, bias, model.GetOutputShape());
+    EXPECT_THAT(model.GetOutput(),
+                ElementsAreArray(ArrayFloatNear(expected, 1e-5)));
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe::tflite_operations
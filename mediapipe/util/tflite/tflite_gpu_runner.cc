@@ -27,6 +27,7 @@
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/framework/port/status_macros.h"
 #include "mediapipe/gpu/gl_base.h"
+#include "mediapipe/gpu/gl_context.h"
 #include "tensorflow/lite/core/api/op_resolver.h"
 #include "tensorflow/lite/core/interpreter_builder.h"
 #include "tensorflow/lite/delegates/gpu/api.h"
@@ -216,6 +217,17 @@ absl::Status TFLiteGPURunner::BindSSBOToOutputTensor(GLuint ssbo_id,
 
 absl::Status TFLiteGPURunner::Invoke() { return runner_->Run(); }
 
+absl::StatusOr<mediapipe::GlSyncToken> TFLiteGPURunner::InvokeAsync() {
+  MP_RETURN_IF_ERROR(runner_->Run());
+  // Both backends order the inference before any later command on the
+  // current context (OpenCL through its GL interop fence), so a fence inserted
+  // now is signaled once the inference is complete.
+  std::shared_ptr<mediapipe::GlContext> gl_context =
+      mediapipe::GlContext::GetCurrent();
+  RET_CHECK(gl_context) << "InvokeAsync() requires a current GlContext.";
+  return gl_context->CreateSyncToken();
+}
+
 absl::Status TFLiteGPURunner::InitializeOpenGL(
     std::unique_ptr<InferenceBuilder>* builder) {
   gl::InferenceEnvironmentOptions env_options;
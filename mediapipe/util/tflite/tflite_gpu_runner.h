@@ -24,6 +24,7 @@
 #include "mediapipe/framework/port.h"
 #include "mediapipe/framework/port/ret_check.h"
 #include "mediapipe/gpu/gl_base.h"
+#include "mediapipe/gpu/gl_context.h"
 #include "tensorflow/lite/core/api/op_resolver.h"
 #include "tensorflow/lite/delegates/gpu/api.h"
 #include "tensorflow/lite/delegates/gpu/common/model.h"
@@ -50,6 +51,11 @@ namespace gpu {
 // 4. Invoke() executes the inference, where inputs and outputs are those which
 // were specified earlier. Invoke() may be called in the loop.
 //
+// To keep several inferences in flight, bind a different set of input/output
+// SSBOs before each call to InvokeAsync() and wait on the returned sync token
+// before reusing or reading back that set. Buffers are bound per call, so the
+// caller's ring of buffer sets can be of any size.
+//
 // Note: All of these need to happen inside MediaPipe's RunInGlContext to make
 // sure that all steps from inference construction to execution are made using
 // same OpenGL context.
@@ -79,6 +85,10 @@ class TFLiteGPURunner {
 
   absl::Status Build();
   absl::Status Invoke();
+  // Submits the inference with the currently bound buffers and returns a sync
+  // point reached once the GPU has finished it. Must be called with the same
+  // OpenGL context current as Build().
+  absl::StatusOr<mediapipe::GlSyncToken> InvokeAsync();
 
   std::vector<BHWC> GetInputShapes() { return input_shapes_; }
   std::vector<BHWC> GetOutputShapes() { return output_shapes_; }
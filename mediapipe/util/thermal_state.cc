@@ -0,0 +1,38 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/thermal_state.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace mediapipe {
+namespace {
+
+std::atomic<int>& ThermalState() {
+  static std::atomic<int> state{0};
+  return state;
+}
+
+}  // namespace
+
+int GetThermalState() {
+  return ThermalState().load(std::memory_order_relaxed);
+}
+
+void SetThermalState(int state) {
+  ThermalState().store(std::max(state, 0), std::memory_order_relaxed);
+}
+
+}  // namespace mediapipe
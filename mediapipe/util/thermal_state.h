@@ -0,0 +1,40 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The thermal state of the device, shared by the whole process.
+//
+// MediaPipe cannot observe the thermal state portably, so the application
+// reports it, e.g. from an Android PowerManager.OnThermalStatusChangedListener
+// (THERMAL_STATUS_NONE = 0 to THERMAL_STATUS_SHUTDOWN = 6) or from the iOS
+// NSProcessInfoThermalStateDidChangeNotification (nominal = 0 to
+// critical = 3). Higher values mean hotter states; 0 means not throttled.
+//
+// Executors configured with max_running_tasks_for_thermal_state read it each
+// time they schedule a task.
+
+#ifndef MEDIAPIPE_UTIL_THERMAL_STATE_H_
+#define MEDIAPIPE_UTIL_THERMAL_STATE_H_
+
+namespace mediapipe {
+
+// Returns the last thermal state set by SetThermalState, or 0 if it was never
+// set.
+int GetThermalState();
+
+// Sets the thermal state of the device. Negative states are set as 0.
+void SetThermalState(int state);
+
+}  // namespace mediapipe
+
+#endif  // MEDIAPIPE_UTIL_THERMAL_STATE_H_
@@ -14,6 +14,9 @@
 
 #include "mediapipe/util/tracking/box_detector.h"
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
 #include <vector>
 
 #include "absl/log/absl_check.h"
@@ -94,10 +97,42 @@ class BoxDetectorOpencvBfImpl : public BoxDetectorInterface {
   cv::BFMatcher bf_matcher_;
 };
 
+// Quantizes the descriptors of all boxes with a k-means codebook into an
+// inverted file, and matches each frame against all boxes at once by comparing
+// the frame features only with the indexed features of their closest centers.
+// Matches are cross checked like in BoxDetectorOpencvBfImpl, but only among
+// the candidate matches found.
+class BoxDetectorQuantizedIvfImpl : public BoxDetectorInterface {
+ public:
+  explicit BoxDetectorQuantizedIvfImpl(const BoxDetectorOptions &options);
+
+ private:
+  std::vector<FeatureCorrespondence> MatchFeatureDescriptors(
+      const std::vector<Vector2_f> &features, const cv::Mat &descriptors,
+      int box_idx) override;
+  void PrepareFeatureMatching(const std::vector<Vector2_f> &features,
+                              const cv::Mat &descriptors) override;
+  void OnIndexChanged() override { index_built_ = false; }
+
+  // Builds the codebook and inverted file from the features of all boxes.
+  void BuildIndex();
+
+  bool index_built_ = false;
+  // Codebook with one CV_32F center per row.
+  cv::Mat centers_;
+  // Indexed features quantized to each center, as (box_idx, feature index
+  // within the box).
+  std::vector<std::vector<std::pair<int, int>>> inverted_lists_;
+  // Matches of the current frame, per box.
+  std::vector<std::vector<cv::DMatch>> frame_matches_;
+};
+
 std::unique_ptr<BoxDetectorInterface> BoxDetectorInterface::Create(
     const BoxDetectorOptions &options) {
   if (options.index_type() == BoxDetectorOptions::OPENCV_BF) {
     return absl::make_unique<BoxDetectorOpencvBfImpl>(options);
+  } else if (options.index_type() == BoxDetectorOptions::QUANTIZED_IVF) {
+    return absl::make_unique<BoxDetectorQuantizedIvfImpl>(options);
   } else {
     ABSL_LOG(FATAL) << "index type undefined.";
   }
@@ -155,11 +190,16 @@ void BoxDetectorInterface::DetectAndAddBoxFromFeatures(
     }
   }
 
+  bool matching_prepared = false;
   for (int idx = 0; idx < size_before_add; ++idx) {
     if ((options_.detect_every_n_frame() > 0 &&
          cnt_detect_called_ % options_.detect_every_n_frame() == 0) ||
         !tracked[idx] ||
         (options_.detect_out_of_fov() && has_been_out_of_fov_[idx])) {
+      if (!matching_prepared) {
+        PrepareFeatureMatching(features, descriptors);
+        matching_prepared = true;
+      }
       TimedBoxProtoList det = DetectBox(features, descriptors, idx);
       if (det.box_size() > 0) {
         det.mutable_box(0)->set_time_msec(timestamp_msec);
@@ -622,6 +662,7 @@ void BoxDetectorInterface::AddBoxFeaturesToIndex(
     for (int j = 0; j < insider_idx.size(); ++j) {
       feature_to_frame_[box_idx].push_back(frame_id);
     }
+    OnIndexChanged();
   }
 }
 
@@ -643,6 +684,7 @@ void BoxDetectorInterface::CancelBoxDetection(int box_id) {
     for (int j = erase_idx; j < box_idx_to_id_.size(); ++j) {
       box_id_to_idx_[box_idx_to_id_[j]] = j;
     }
+    OnIndexChanged();
   }
 }
 
@@ -732,21 +774,157 @@ BoxDetectorOpencvBfImpl::MatchFeatureDescriptors(
   // Hamming distance threshold for best match distance. This max distance
   // filtering rejects some of false matches which has not been rejected by
   // cross match validation. And the value is determined emprically.
+  std::vector<cv::DMatch> best_matches;
   for (const auto &match_pair : matches) {
     if (match_pair.size() < knn) continue;
     const cv::DMatch &best_match = match_pair[0];
     if (best_match.distance > options_.max_match_distance()) continue;
+    best_matches.push_back(best_match);
+  }
+
+  return GetCorrespondencesFromMatches(features, best_matches, box_idx);
+}
 
-    int match_idx = feature_to_frame_[box_idx][best_match.trainIdx];
+std::vector<FeatureCorrespondence>
+BoxDetectorInterface::GetCorrespondencesFromMatches(
+    const std::vector<Vector2_f> &features,
+    const std::vector<cv::DMatch> &matches, int box_idx) const {
+  std::vector<FeatureCorrespondence> correspondence_result(
+      frame_box_[box_idx].size());
+  for (const cv::DMatch &match : matches) {
+    int match_idx = feature_to_frame_[box_idx][match.trainIdx];
 
     correspondence_result[match_idx].points_frame.push_back(cv::Point2f(
-        features[best_match.queryIdx].x(), features[best_match.queryIdx].y()));
+        features[match.queryIdx].x(), features[match.queryIdx].y()));
     correspondence_result[match_idx].points_index.push_back(
-        cv::Point2f(feature_keypoints_[box_idx][best_match.trainIdx].x(),
-                    feature_keypoints_[box_idx][best_match.trainIdx].y()));
+        cv::Point2f(feature_keypoints_[box_idx][match.trainIdx].x(),
+                    feature_keypoints_[box_idx][match.trainIdx].y()));
   }
-
   return correspondence_result;
 }
 
+BoxDetectorQuantizedIvfImpl::BoxDetectorQuantizedIvfImpl(
+    const BoxDetectorOptions &options)
+    : BoxDetectorInterface(options) {}
+
+void BoxDetectorQuantizedIvfImpl::BuildIndex() {
+  index_built_ = true;
+  centers_.release();
+  inverted_lists_.clear();
+
+  std::vector<std::pair<int, int>> feature_ids;
+  cv::Mat all_descriptors;
+  for (int box_idx = 0; box_idx < feature_descriptors_.size(); ++box_idx) {
+    const cv::Mat &box_descriptors = feature_descriptors_[box_idx];
+    for (int k = 0; k < box_descriptors.rows; ++k) {
+      feature_ids.emplace_back(box_idx, k);
+    }
+    if (box_descriptors.rows > 0) {
+      all_descriptors.push_back(box_descriptors);
+    }
+  }
+  if (feature_ids.empty()) return;
+  ABSL_CHECK_EQ(all_descriptors.type(), CV_32F);
+
+  const int num_features = feature_ids.size();
+  const auto &settings = options_.quantized_index_settings();
+  int num_centers = settings.num_centers() > 0
+                        ? settings.num_centers()
+                        : std::lround(std::sqrt(num_features));
+  num_centers = std::clamp(num_centers, 1, num_features);
+
+  cv::Mat labels;
+  cv::kmeans(all_descriptors, num_centers, labels,
+             cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS,
+                              10, 1e-3),
+             /*attempts=*/1, cv::KMEANS_PP_CENTERS, centers_);
+  inverted_lists_.resize(num_centers);
+  for (int j = 0; j < num_features; ++j) {
+    inverted_lists_[labels.at<int>(j)].push_back(feature_ids[j]);
+  }
+}
+
+void BoxDetectorQuantizedIvfImpl::PrepareFeatureMatching(
+    const std::vector<Vector2_f> &features, const cv::Mat &descriptors) {
+  if (!index_built_) {
+    BuildIndex();
+  }
+  frame_matches_.assign(feature_descriptors_.size(), {});
+  if (centers_.empty() || descriptors.rows == 0 || descriptors.cols == 0) {
+    return;
+  }
+
+  cv::Mat query_descriptors;
+  descriptors.convertTo(query_descriptors, CV_32F);
+  ABSL_CHECK_EQ(query_descriptors.cols, centers_.cols);
+
+  // Distances from each frame feature to each center.
+  cv::Mat center_distances;
+  cv::batchDistance(query_descriptors, centers_, center_distances, CV_32F,
+                    cv::noArray(), cv::NORM_L2);
+
+  const int num_probes = std::clamp(
+      options_.quantized_index_settings().num_probes(), 1, centers_.rows);
+  const float max_distance = options_.max_match_distance();
+  std::vector<int> probe_order(centers_.rows);
+  // Best match per box for the current frame feature.
+  std::vector<cv::DMatch> best_match(feature_descriptors_.size());
+  std::vector<int> matched_boxes;
+  for (int q = 0; q < query_descriptors.rows; ++q) {
+    const float *distances = center_distances.ptr<float>(q);
+    for (int c = 0; c < probe_order.size(); ++c) probe_order[c] = c;
+    std::partial_sort(
+        probe_order.begin(), probe_order.begin() + num_probes,
+        probe_order.end(),
+        [distances](int a, int b) { return distances[a] < distances[b]; });
+
+    const cv::Mat query = query_descriptors.row(q);
+    matched_boxes.clear();
+    for (int p = 0; p < num_probes; ++p) {
+      for (const auto &[box_idx, k] : inverted_lists_[probe_order[p]]) {
+        const float distance = static_cast<float>(cv::norm(
+            query, feature_descriptors_[box_idx].row(k), cv::NORM_L2));
+        if (distance > max_distance) continue;
+        cv::DMatch &match = best_match[box_idx];
+        if (match.queryIdx != q) {
+          match = cv::DMatch(q, k, distance);
+          matched_boxes.push_back(box_idx);
+        } else if (distance < match.distance) {
+          match = cv::DMatch(q, k, distance);
+        }
+      }
+    }
+    for (int box_idx : matched_boxes) {
+      frame_matches_[box_idx].push_back(best_match[box_idx]);
+    }
+  }
+
+  // Cross checks: keeps only the best frame feature for each box feature.
+  for (auto &box_matches : frame_matches_) {
+    std::sort(box_matches.begin(), box_matches.end(),
+              [](const cv::DMatch &a, const cv::DMatch &b) {
+                return a.trainIdx != b.trainIdx ? a.trainIdx < b.trainIdx
+                                                : a.distance < b.distance;
+              });
+    box_matches.erase(
+        std::unique(box_matches.begin(), box_matches.end(),
+                    [](const cv::DMatch &a, const cv::DMatch &b) {
+                      return a.trainIdx == b.trainIdx;
+                    }),
+        box_matches.end());
+  }
+}
+
+std::vector<FeatureCorrespondence>
+BoxDetectorQuantizedIvfImpl::MatchFeatureDescriptors(
+    const std::vector<Vector2_f> &features, const cv::Mat &descriptors,
+    int box_idx) {
+  ABSL_CHECK_EQ(features.size(), descriptors.rows);
+  if (box_idx >= frame_matches_.size()) {
+    return std::vector<FeatureCorrespondence>(frame_box_[box_idx].size());
+  }
+  return GetCorrespondencesFromMatches(features, frame_matches_[box_idx],
+                                       box_idx);
+}
+
 }  // namespace mediapipe
@@ -138,6 +138,22 @@ class BoxDetectorInterface {
       const std::vector<Vector2_f> &features, const cv::Mat &descriptors,
       int box_idx) = 0;
 
+  // Called once per frame before the first MatchFeatureDescriptors() call for
+  // `features` and `descriptors`, so that an index can match the frame against
+  // all boxes at once.
+  virtual void PrepareFeatureMatching(const std::vector<Vector2_f> &features,
+                                      const cv::Mat &descriptors) {}
+
+  // Called when features are added to or removed from the index.
+  virtual void OnIndexChanged() {}
+
+  // Converts descriptor `matches` between the frame `features` (query) and the
+  // features of the box with `box_idx` (train) into correspondences per
+  // appearance of the box.
+  std::vector<FeatureCorrespondence> GetCorrespondencesFromMatches(
+      const std::vector<Vector2_f> &features,
+      const std::vector<cv::DMatch> &matches, int box_idx) const;
+
   // Specifies which box the correspondences come from with `box_id`, so that we
   // can figure out the transformation accordingly.
   TimedBoxProtoList FindBoxesFromFeatureCorrespondence(
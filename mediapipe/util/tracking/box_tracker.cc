@@ -27,6 +27,7 @@
 #include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "mediapipe/framework/port/logging.h"
+#include "mediapipe/util/tracking/flow_packager.h"
 #include "mediapipe/util/tracking/measure_time.h"
 #include "mediapipe/util/tracking/tracking.pb.h"
 
@@ -582,7 +583,8 @@ bool BoxTracker::IsTrackingOngoingMutexHeld() {
 }
 
 BoxTracker::AugmentedChunkPtr BoxTracker::ReadChunk(int id, int checkpoint,
-                                                    int chunk_idx) {
+                                                    int chunk_idx,
+                                                    int64_t frame_msec) {
   VLOG(1) << __FUNCTION__ << " id=" << id << " chunk_idx=" << chunk_idx;
   if (cache_dir_.empty() && !tracking_data_.empty()) {
     if (chunk_idx < tracking_data_.size()) {
@@ -593,13 +595,13 @@ BoxTracker::AugmentedChunkPtr BoxTracker::ReadChunk(int id, int checkpoint,
     }
   } else {
     std::unique_ptr<TrackingDataChunk> chunk_data(
-        ReadChunkFromCache(id, checkpoint, chunk_idx));
+        ReadChunkFromCache(id, checkpoint, chunk_idx, frame_msec));
     return std::make_pair(chunk_data.release(), true);
   }
 }
 
 std::unique_ptr<TrackingDataChunk> BoxTracker::ReadChunkFromCache(
-    int id, int checkpoint, int chunk_idx) {
+    int id, int checkpoint, int chunk_idx, int64_t frame_msec) {
   VLOG(1) << __FUNCTION__ << " id=" << id << " chunk_idx=" << chunk_idx;
 
   auto format_runtime =
@@ -631,14 +633,50 @@ std::unique_ptr<TrackingDataChunk> BoxTracker::ReadChunkFromCache(
     return nullptr;
   }
 
-  std::string data;
-  in.seekg(0, std::ios::end);
-  data.resize(in.tellg());
-  in.seekg(0, std::ios::beg);
+  // Chunks written in binary format start with an index of their items.
+  std::string data(12, 0);
   in.read(&data[0], data.size());
-  in.close();
-
-  chunk_data->ParseFromString(data);
+  const int index_size =
+      in ? FlowPackager::BinaryTrackingDataChunkIndexSize(data) : -1;
+  in.clear();
+
+  const FlowPackager flow_packager((FlowPackagerOptions()));
+  if (index_size >= 0 && frame_msec >= 0) {
+    // Only read and decode the item closest to frame_msec.
+    data.resize(12 + index_size);
+    in.read(&data[12], index_size);
+    TrackingDataChunkIndex index;
+    flow_packager.DecodeTrackingDataChunkIndex(data, &index);
+
+    TrackingDataChunk timestamps;
+    for (const auto& index_item : index.item()) {
+      timestamps.add_item()->set_timestamp_usec(index_item.timestamp_usec());
+    }
+    const TrackingDataChunkIndex::Item& index_item =
+        index.item(ClosestFrameIndex(frame_msec, timestamps));
+
+    data.resize(index_item.size());
+    in.seekg(12 + index_size + index_item.stream_offset(), std::ios::beg);
+    in.read(&data[0], data.size());
+    in.close();
+
+    flow_packager.DecodeTrackingDataChunkItem(index_item, data,
+                                              chunk_data->add_item());
+    chunk_data->set_first_chunk(index.first_chunk());
+    chunk_data->set_last_chunk(index.last_chunk());
+  } else {
+    in.seekg(0, std::ios::end);
+    data.resize(in.tellg());
+    in.seekg(0, std::ios::beg);
+    in.read(&data[0], data.size());
+    in.close();
+
+    if (index_size >= 0) {
+      flow_packager.DecodeTrackingDataChunk(data, chunk_data.get());
+    } else {
+      chunk_data->ParseFromString(data);
+    }
+  }
 
   VLOG(1) << "Read success";
   return chunk_data;
@@ -1038,7 +1076,8 @@ bool BoxTracker::GetTrackingData(int id, int64_t request_time_msec,
 
   int chunk_idx = ChunkIdxFromTime(request_time_msec);
 
-  AugmentedChunkPtr tracking_chunk(ReadChunk(id, kInitCheckpoint, chunk_idx));
+  AugmentedChunkPtr tracking_chunk(
+      ReadChunk(id, kInitCheckpoint, chunk_idx, request_time_msec));
   if (!tracking_chunk.first) {
     absl::MutexLock lock(&status_mutex_);
     --track_status_[id][kInitCheckpoint].tracks_ongoing;
@@ -236,13 +236,16 @@ class BoxTracker {
   // Important: 2nd part of return value indicates if returned tracking data
   // will be owned by the caller (if true). In that case caller is responsible
   // for releasing the returned chunk.
-  AugmentedChunkPtr ReadChunk(int id, int checkpoint, int chunk_idx);
+  // If frame_msec is set, chunks in binary format read from the cache only
+  // hold the item closest to frame_msec.
+  AugmentedChunkPtr ReadChunk(int id, int checkpoint, int chunk_idx,
+                              int64_t frame_msec = -1);
 
   // Attempts to read specified chunk from caching directory. Blocks and waits
   // until chunk is available or internal time out is reached.
   // Returns nullptr if data could not be read.
-  std::unique_ptr<TrackingDataChunk> ReadChunkFromCache(int id, int checkpoint,
-                                                        int chunk_idx);
+  std::unique_ptr<TrackingDataChunk> ReadChunkFromCache(
+      int id, int checkpoint, int chunk_idx, int64_t frame_msec = -1);
 
   // Waits with timeout for chunkfile to become available. Returns true on
   // success, false if waited till timeout or when canceled.
@@ -18,7 +18,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
@@ -924,7 +927,7 @@ void FlowPackager::InitializeMetaData(int num_frames,
 }
 
 void FlowPackager::AddContainerToString(const TrackingContainer& container,
-                                        std::string* binary_data) {
+                                        std::string* binary_data) const {
   ABSL_CHECK(binary_data != nullptr);
   std::string header_string(container.header());
   ABSL_CHECK_EQ(4, header_string.size());
@@ -937,7 +940,7 @@ void FlowPackager::AddContainerToString(const TrackingContainer& container,
 }
 
 std::string FlowPackager::SplitContainerFromString(
-    absl::string_view* binary_data, TrackingContainer* container) {
+    absl::string_view* binary_data, TrackingContainer* container) const {
   ABSL_CHECK(binary_data != nullptr);
   ABSL_CHECK(container != nullptr);
   ABSL_CHECK_GE(binary_data->size(), 12) << "Data does not contain "
@@ -995,6 +998,220 @@ void FlowPackager::TrackingContainerFormatFromBinary(
                             &data, container_format->mutable_term_data()));
 }
 
+namespace {
+
+// Appends value to data as zig-zag encoded varint.
+void AppendZigZagVarint(int64_t value, std::string* data) {
+  uint64_t zig_zag =
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+  while (zig_zag >= 0x80) {
+    data->push_back(static_cast<char>((zig_zag & 0x7F) | 0x80));
+    zig_zag >>= 7;
+  }
+  data->push_back(static_cast<char>(zig_zag));
+}
+
+// Removes zig-zag encoded varint from data. Returns false if data is
+// truncated.
+bool PopZigZagVarint(absl::string_view* data, int64_t* value) {
+  uint64_t zig_zag = 0;
+  for (int shift = 0; shift < 64 && !data->empty(); shift += 7) {
+    const uint8_t byte = data->front();
+    data->remove_prefix(1);
+    zig_zag |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *value = static_cast<int64_t>(zig_zag >> 1) ^
+               -static_cast<int64_t>(zig_zag & 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns track ids in the order of the vectors decoded from the binary encode
+// of motion_data. In high profile, EncodeTrackingData duplicates the vector
+// for each multiple of INDEX_MASK in a row delta; duplicates are assigned -1.
+std::vector<int> TrackIdsForBinaryEncode(
+    const TrackingData::MotionData& motion_data, bool high_profile) {
+  const int kIndexMask = FlowPackagerOptions::INDEX_MASK;
+  std::vector<int> track_ids;
+  track_ids.reserve(motion_data.track_id_size());
+  for (int c = 0; c < motion_data.col_starts_size() - 1; ++c) {
+    const int r_start = motion_data.col_starts(c);
+    const int r_end = motion_data.col_starts(c + 1);
+    for (int r = r_start; r < r_end; ++r) {
+      if (high_profile) {
+        const int delta_row =
+            motion_data.row_indices(r) -
+            (r == r_start ? 0 : motion_data.row_indices(r - 1));
+        for (int d = delta_row; d > kIndexMask; d -= kIndexMask) {
+          track_ids.push_back(-1);
+        }
+      }
+      track_ids.push_back(motion_data.track_id(r));
+    }
+  }
+  return track_ids;
+}
+
+}  // namespace.
+
+void FlowPackager::EncodeTrackingDataChunk(const TrackingDataChunk& chunk,
+                                           std::string* binary) const {
+  ABSL_CHECK(binary != nullptr);
+  binary->clear();
+
+  TrackingDataChunkIndex index;
+  index.set_first_chunk(chunk.first_chunk());
+  index.set_last_chunk(chunk.last_chunk());
+
+  std::string item_data;
+  for (const auto& item : chunk.item()) {
+    const TrackingData& tracking_data = item.tracking_data();
+    TrackingDataChunkIndex::Item* index_item = index.add_item();
+    index_item->set_frame_idx(item.frame_idx());
+    index_item->set_timestamp_usec(item.timestamp_usec());
+    if (item.has_prev_timestamp_usec()) {
+      index_item->set_prev_timestamp_usec(item.prev_timestamp_usec());
+    }
+    index_item->set_frame_flags(tracking_data.frame_flags());
+    if (tracking_data.has_global_feature_count()) {
+      index_item->set_global_feature_count(
+          tracking_data.global_feature_count());
+    }
+    if (tracking_data.has_average_motion_magnitude()) {
+      index_item->set_average_motion_magnitude(
+          tracking_data.average_motion_magnitude());
+    }
+    index_item->set_stream_offset(item_data.size());
+
+    BinaryTrackingData binary_data;
+    EncodeTrackingData(tracking_data, &binary_data);
+    TrackingContainer container;
+    BinaryTrackingDataToContainer(binary_data, &container);
+    AddContainerToString(container, &item_data);
+
+    const TrackingData::MotionData& motion_data = tracking_data.motion_data();
+    if (motion_data.track_id_size() > 0) {
+      ABSL_CHECK_EQ(motion_data.num_elements(), motion_data.track_id_size());
+      TrackingContainer track_ids;
+      track_ids.set_header("TRID");
+      int64_t prev_track_id = 0;
+      for (const int track_id :
+           TrackIdsForBinaryEncode(motion_data, options_.use_high_profile())) {
+        AppendZigZagVarint(track_id - prev_track_id, track_ids.mutable_data());
+        prev_track_id = track_id;
+      }
+      track_ids.set_size(track_ids.data().size());
+      AddContainerToString(track_ids, &item_data);
+    }
+
+    index_item->set_size(item_data.size() - index_item->stream_offset());
+  }
+
+  TrackingContainer index_container;
+  index_container.set_header("CIDX");
+  index.SerializeToString(index_container.mutable_data());
+  index_container.set_size(index_container.data().size());
+  AddContainerToString(index_container, binary);
+
+  absl::StrAppend(binary, item_data);
+
+  TrackingContainer term;
+  term.set_header("TERM");
+  term.set_size(0);
+  AddContainerToString(term, binary);
+}
+
+void FlowPackager::DecodeTrackingDataChunk(absl::string_view binary,
+                                           TrackingDataChunk* chunk) const {
+  ABSL_CHECK(chunk != nullptr);
+  chunk->Clear();
+
+  const int index_size = BinaryTrackingDataChunkIndexSize(binary);
+  ABSL_CHECK_GE(index_size, 0) << "Data is not a binary TrackingDataChunk.";
+  TrackingDataChunkIndex index;
+  DecodeTrackingDataChunkIndex(binary.substr(0, 12 + index_size), &index);
+
+  const absl::string_view item_data = binary.substr(12 + index_size);
+  for (const auto& index_item : index.item()) {
+    ABSL_CHECK_LE(index_item.stream_offset() + index_item.size(),
+                  item_data.size());
+    DecodeTrackingDataChunkItem(
+        index_item, item_data.substr(index_item.stream_offset(),
+                                     index_item.size()),
+        chunk->add_item());
+  }
+
+  chunk->set_first_chunk(index.first_chunk());
+  chunk->set_last_chunk(index.last_chunk());
+}
+
+int FlowPackager::BinaryTrackingDataChunkIndexSize(absl::string_view binary) {
+  if (binary.size() < 12 || binary.substr(0, 4) != "CIDX") {
+    return -1;
+  }
+  int32_t size;
+  DecodeFromStringView(binary.substr(8, 4), &size);
+  return size;
+}
+
+void FlowPackager::DecodeTrackingDataChunkIndex(
+    absl::string_view binary, TrackingDataChunkIndex* index) const {
+  ABSL_CHECK(index != nullptr);
+  TrackingContainer container;
+  ABSL_CHECK_EQ("CIDX", SplitContainerFromString(&binary, &container));
+  ABSL_CHECK_EQ(1, container.version()) << "Unsupported version.";
+  ABSL_CHECK(index->ParseFromString(container.data()))
+      << "Could not parse TrackingDataChunkIndex.";
+}
+
+void FlowPackager::DecodeTrackingDataChunkItem(
+    const TrackingDataChunkIndex::Item& index, absl::string_view item_data,
+    TrackingDataChunk::Item* item) const {
+  ABSL_CHECK(item != nullptr);
+  ABSL_CHECK_EQ(index.size(), item_data.size());
+  item->Clear();
+  item->set_frame_idx(index.frame_idx());
+  item->set_timestamp_usec(index.timestamp_usec());
+  if (index.has_prev_timestamp_usec()) {
+    item->set_prev_timestamp_usec(index.prev_timestamp_usec());
+  }
+
+  TrackingContainer container;
+  ABSL_CHECK_EQ("TRAK", SplitContainerFromString(&item_data, &container));
+  BinaryTrackingData binary_data;
+  BinaryTrackingDataFromContainer(container, &binary_data);
+
+  TrackingData* tracking_data = item->mutable_tracking_data();
+  DecodeTrackingData(binary_data, tracking_data);
+  tracking_data->set_frame_flags(index.frame_flags());
+  if (index.has_global_feature_count()) {
+    tracking_data->set_global_feature_count(index.global_feature_count());
+  }
+  if (index.has_average_motion_magnitude()) {
+    tracking_data->set_average_motion_magnitude(
+        index.average_motion_magnitude());
+  }
+
+  if (!item_data.empty()) {
+    TrackingContainer track_id_container;
+    ABSL_CHECK_EQ("TRID",
+                  SplitContainerFromString(&item_data, &track_id_container));
+    absl::string_view track_id_data(track_id_container.data());
+    TrackingData::MotionData* motion_data =
+        tracking_data->mutable_motion_data();
+    int64_t track_id = 0;
+    for (int k = 0; k < motion_data->num_elements(); ++k) {
+      int64_t delta;
+      ABSL_CHECK(PopZigZagVarint(&track_id_data, &delta))
+          << "Truncated track ids.";
+      track_id += delta;
+      motion_data->add_track_id(track_id);
+    }
+  }
+}
+
 void FlowPackager::SortRegionFlowFeatureList(
     float scale_x, float scale_y, RegionFlowFeatureList* feature_list) const {
   ABSL_CHECK(feature_list != nullptr);
@@ -146,7 +146,32 @@ class FlowPackager {
   // Removes binary encoded container from string and parses it to container.
   // Returns header string of the parsed container. Useful for random seek.
   std::string SplitContainerFromString(absl::string_view* binary_data,
-                                       TrackingContainer* container);
+                                       TrackingContainer* container) const;
+
+  // Encodes a TrackingDataChunk to the compressed binary chunk format
+  // described by TrackingDataChunkIndex in flow_packager.proto.
+  void EncodeTrackingDataChunk(const TrackingDataChunk& chunk,
+                               std::string* binary) const;
+
+  // Decodes a whole binary chunk.
+  void DecodeTrackingDataChunk(absl::string_view binary,
+                               TrackingDataChunk* chunk) const;
+
+  // Random access decode, reading only the parts of a binary chunk needed:
+  // Returns the size of the index container's data from the first 12 bytes of
+  // a binary chunk, or -1 if the data is not a binary chunk.
+  static int BinaryTrackingDataChunkIndexSize(absl::string_view binary);
+
+  // Decodes the index from the first 12 + BinaryTrackingDataChunkIndexSize()
+  // bytes of a binary chunk.
+  void DecodeTrackingDataChunkIndex(absl::string_view binary,
+                                    TrackingDataChunkIndex* index) const;
+
+  // Decodes a single item from its index entry and the index.size() bytes
+  // located index.stream_offset() bytes after the index container.
+  void DecodeTrackingDataChunkItem(const TrackingDataChunkIndex::Item& index,
+                                   absl::string_view item_data,
+                                   TrackingDataChunk::Item* item) const;
 
  private:
   // Sets meta data for a set
@@ -156,7 +181,7 @@ class FlowPackager {
 
   // Serializes container to binary string and adds it to binary_data.
   void AddContainerToString(const TrackingContainer& container,
-                            std::string* binary_data);
+                            std::string* binary_data) const;
 
  private:
   FlowPackagerOptions options_;
@@ -0,0 +1,189 @@
+// Copyright 2019 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tracking/flow_packager.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/tracking/flow_packager.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kDomainWidth = 16;
+constexpr int kDomainHeight = 160;
+
+// Returns tracking data with one vector per (column, row) pair in positions,
+// which need to be sorted by column and row.
+TrackingData MakeTrackingData(const std::vector<std::pair<int, int>>& positions,
+                              int first_track_id) {
+  TrackingData tracking_data;
+  tracking_data.set_frame_flags(TrackingData::FLAG_CHUNK_BOUNDARY);
+  tracking_data.set_domain_width(kDomainWidth);
+  tracking_data.set_domain_height(kDomainHeight);
+  tracking_data.set_frame_aspect(1.5f);
+  tracking_data.set_global_feature_count(positions.size());
+  tracking_data.set_average_motion_magnitude(0.75f);
+
+  TrackingData::MotionData* motion_data = tracking_data.mutable_motion_data();
+  motion_data->set_num_elements(positions.size());
+  int k = 0;
+  for (int c = 0; c <= kDomainWidth; ++c) {
+    while (k < positions.size() && positions[k].first < c) {
+      motion_data->add_vector_data(0.25f * k);
+      motion_data->add_vector_data(-0.5f * k);
+      motion_data->add_row_indices(positions[k].second);
+      motion_data->add_track_id(first_track_id + 7 * k);
+      ++k;
+    }
+    motion_data->add_col_starts(k);
+  }
+  return tracking_data;
+}
+
+TrackingDataChunk MakeChunk() {
+  TrackingDataChunk chunk;
+  chunk.set_first_chunk(true);
+  const std::vector<std::pair<int, int>> positions = {
+      {0, 1}, {0, 100}, {3, 4}, {3, 5}, {9, 150}, {15, 0}};
+  for (int f = 0; f < 3; ++f) {
+    TrackingDataChunk::Item* item = chunk.add_item();
+    item->set_frame_idx(f);
+    item->set_timestamp_usec(33333 * f);
+    if (f > 0) {
+      item->set_prev_timestamp_usec(33333 * (f - 1));
+    }
+    *item->mutable_tracking_data() = MakeTrackingData(positions, 10 * f);
+  }
+  return chunk;
+}
+
+void ExpectItemNear(const TrackingDataChunk::Item& expected,
+                    const TrackingDataChunk::Item& actual) {
+  EXPECT_EQ(expected.frame_idx(), actual.frame_idx());
+  EXPECT_EQ(expected.timestamp_usec(), actual.timestamp_usec());
+  EXPECT_EQ(expected.has_prev_timestamp_usec(),
+            actual.has_prev_timestamp_usec());
+  EXPECT_EQ(expected.prev_timestamp_usec(), actual.prev_timestamp_usec());
+
+  const TrackingData& expected_data = expected.tracking_data();
+  const TrackingData& actual_data = actual.tracking_data();
+  EXPECT_EQ(expected_data.frame_flags(), actual_data.frame_flags());
+  EXPECT_EQ(expected_data.domain_width(), actual_data.domain_width());
+  EXPECT_EQ(expected_data.domain_height(), actual_data.domain_height());
+  EXPECT_FLOAT_EQ(expected_data.frame_aspect(), actual_data.frame_aspect());
+  EXPECT_EQ(expected_data.global_feature_count(),
+            actual_data.global_feature_count());
+  EXPECT_FLOAT_EQ(expected_data.average_motion_magnitude(),
+                  actual_data.average_motion_magnitude());
+
+  const TrackingData::MotionData& expected_motion = expected_data.motion_data();
+  const TrackingData::MotionData& actual_motion = actual_data.motion_data();
+  ASSERT_EQ(expected_motion.num_elements(), actual_motion.num_elements());
+  for (int k = 0; k < expected_motion.num_elements(); ++k) {
+    EXPECT_EQ(expected_motion.row_indices(k), actual_motion.row_indices(k));
+    EXPECT_EQ(expected_motion.track_id(k), actual_motion.track_id(k));
+    EXPECT_NEAR(expected_motion.vector_data(2 * k),
+                actual_motion.vector_data(2 * k), 1e-2f);
+    EXPECT_NEAR(expected_motion.vector_data(2 * k + 1),
+                actual_motion.vector_data(2 * k + 1), 1e-2f);
+  }
+  EXPECT_EQ(expected_motion.col_starts_size(), actual_motion.col_starts_size());
+}
+
+TEST(FlowPackagerTest, BinaryTrackingDataChunkRoundTrip) {
+  const FlowPackager flow_packager((FlowPackagerOptions()));
+  const TrackingDataChunk chunk = MakeChunk();
+
+  std::string binary;
+  flow_packager.EncodeTrackingDataChunk(chunk, &binary);
+
+  TrackingDataChunk decoded;
+  flow_packager.DecodeTrackingDataChunk(binary, &decoded);
+  EXPECT_TRUE(decoded.first_chunk());
+  EXPECT_FALSE(decoded.last_chunk());
+  ASSERT_EQ(chunk.item_size(), decoded.item_size());
+  for (int f = 0; f < chunk.item_size(); ++f) {
+    ExpectItemNear(chunk.item(f), decoded.item(f));
+  }
+}
+
+TEST(FlowPackagerTest, BinaryTrackingDataChunkRandomAccess) {
+  const FlowPackager flow_packager((FlowPackagerOptions()));
+  const TrackingDataChunk chunk = MakeChunk();
+
+  std::string binary;
+  flow_packager.EncodeTrackingDataChunk(chunk, &binary);
+  EXPECT_EQ(-1, FlowPackager::BinaryTrackingDataChunkIndexSize(
+                    chunk.SerializeAsString()));
+
+  const int index_size = FlowPackager::BinaryTrackingDataChunkIndexSize(
+      absl::string_view(binary).substr(0, 12));
+  ASSERT_GE(index_size, 0);
+  TrackingDataChunkIndex index;
+  flow_packager.DecodeTrackingDataChunkIndex(
+      absl::string_view(binary).substr(0, 12 + index_size), &index);
+  ASSERT_EQ(chunk.item_size(), index.item_size());
+
+  // Decode the last item only.
+  const TrackingDataChunkIndex::Item& index_item = index.item(2);
+  TrackingDataChunk::Item item;
+  flow_packager.DecodeTrackingDataChunkItem(
+      index_item,
+      absl::string_view(binary).substr(
+          12 + index_size + index_item.stream_offset(), index_item.size()),
+      &item);
+  ExpectItemNear(chunk.item(2), item);
+}
+
+TEST(FlowPackagerTest, BinaryTrackingDataChunkHighProfileTrackIds) {
+  FlowPackagerOptions options;
+  options.set_use_high_profile(true);
+  const FlowPackager flow_packager(options);
+  const TrackingDataChunk chunk = MakeChunk();
+
+  std::string binary;
+  flow_packager.EncodeTrackingDataChunk(chunk, &binary);
+  TrackingDataChunk decoded;
+  flow_packager.DecodeTrackingDataChunk(binary, &decoded);
+  ASSERT_EQ(chunk.item_size(), decoded.item_size());
+
+  for (int f = 0; f < chunk.item_size(); ++f) {
+    const TrackingData::MotionData& expected =
+        chunk.item(f).tracking_data().motion_data();
+    const TrackingData::MotionData& actual =
+        decoded.item(f).tracking_data().motion_data();
+    // Row deltas above 63 duplicate vectors, duplicates have track id -1.
+    ASSERT_EQ(actual.num_elements(), actual.track_id_size());
+    EXPECT_GT(actual.num_elements(), expected.num_elements());
+    std::vector<int> track_ids;
+    for (int k = 0; k < actual.num_elements(); ++k) {
+      if (actual.track_id(k) >= 0) {
+        track_ids.push_back(actual.track_id(k));
+        EXPECT_EQ(expected.row_indices(track_ids.size() - 1),
+                  actual.row_indices(k));
+      }
+    }
+    EXPECT_EQ(std::vector<int>(expected.track_id().begin(),
+                               expected.track_id().end()),
+              track_ids);
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -214,6 +214,7 @@ void MotionAnalysis::InitPolicyOptions() {
       flow_options->set_verify_long_feature_trigger_ratio(0.1);
 
       motion_options->set_use_exact_homography_estimation(false);
+      motion_options->set_use_exact_mixture_homography_estimation(false);
       motion_options->set_use_highest_accuracy_for_normal_equations(false);
 
       break;
@@ -256,6 +257,7 @@ void MotionAnalysis::InitPolicyOptions() {
       flow_options->set_verify_long_features(false);
 
       motion_options->set_use_exact_homography_estimation(false);
+      motion_options->set_use_exact_mixture_homography_estimation(false);
       motion_options->set_use_highest_accuracy_for_normal_equations(false);
 
       // Low latency.
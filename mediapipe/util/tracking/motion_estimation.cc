@@ -4056,10 +4056,105 @@ float PatchDescriptorIRLSWeight(const RegionFlowFeature& feature) {
   return weight;
 }
 
+// Accumulates the normal equations A^T * A and A^T * b of the system A * x = b
+// for blocks of rows of A, one block per iteration. Each block is written to
+// its own entry of the outputs, so blocks can run in parallel without locking.
+// Accumulation is in double, as squaring the condition number of the mixture
+// system exceeds float precision and shifts mixture translations by pixels.
+class MixtureNormalEquationInvoker {
+ public:
+  using Matrix = Eigen::MatrixXd;
+  using Vector = Eigen::VectorXd;
+
+  MixtureNormalEquationInvoker(const Eigen::MatrixXf* matrix,
+                               const Eigen::VectorXf* rhs, int rows_per_block,
+                               std::vector<Matrix>* block_matrices,
+                               std::vector<Vector>* block_rhs)
+      : matrix_(matrix),
+        rhs_(rhs),
+        rows_per_block_(rows_per_block),
+        block_matrices_(block_matrices),
+        block_rhs_(block_rhs) {}
+
+  void operator()(const BlockedRange& range) const {
+    const int num_dof = matrix_->cols();
+    for (int block = range.begin(); block != range.end(); ++block) {
+      const int start = block * rows_per_block_;
+      const int num_rows = std::min<int>(rows_per_block_,
+                                         matrix_->rows() - start);
+      const Matrix rows = matrix_->middleRows(start, num_rows).cast<double>();
+      // Vectorized symmetric rank update, only the lower triangle is set.
+      Matrix& block_matrix = (*block_matrices_)[block];
+      block_matrix.setZero(num_dof, num_dof);
+      block_matrix.selfadjointView<Eigen::Lower>().rankUpdate(
+          rows.transpose());
+      (*block_rhs_)[block].noalias() =
+          rows.transpose() * rhs_->segment(start, num_rows).cast<double>();
+    }
+  }
+
+ private:
+  const Eigen::MatrixXf* matrix_;
+  const Eigen::VectorXf* rhs_;
+  const int rows_per_block_;
+  std::vector<Matrix>* block_matrices_;
+  std::vector<Vector>* block_rhs_;
+};
+
+// Solves the mixture system matrix * solution = rhs in the least squares
+// sense via its normal equations. The normal equations are accumulated in
+// blocks of rows on the ParallelFor executor, if any, and solved by LDLT
+// decomposition.
+bool MixtureL2NormalEquationSolve(const Eigen::MatrixXf& matrix,
+                                  const Eigen::VectorXf& rhs,
+                                  Eigen::MatrixXf* solution) {
+  using Invoker = MixtureNormalEquationInvoker;
+  // 128 features per block.
+  constexpr int kRowsPerBlock = 256;
+  const int num_blocks = (matrix.rows() + kRowsPerBlock - 1) / kRowsPerBlock;
+  std::vector<Invoker::Matrix> block_matrices(num_blocks);
+  std::vector<Invoker::Vector> block_rhs(num_blocks);
+  // Runs serially unless a calculator provided an executor, as this is
+  // usually nested in the ParallelFor across frames.
+  ParallelFor(ParallelInvokerExecutor(), 0, num_blocks, 1,
+              Invoker(&matrix, &rhs, kRowsPerBlock, &block_matrices,
+                      &block_rhs));
+
+  Invoker::Matrix normal_matrix =
+      Invoker::Matrix::Zero(matrix.cols(), matrix.cols());
+  Invoker::Vector normal_rhs = Invoker::Vector::Zero(matrix.cols());
+  for (int block = 0; block < num_blocks; ++block) {
+    normal_matrix += block_matrices[block];
+    normal_rhs += block_rhs[block];
+  }
+
+  const Eigen::LDLT<Invoker::Matrix, Eigen::Lower> ldlt(normal_matrix);
+  if (ldlt.info() != Eigen::Success) {
+    return false;
+  }
+  *solution = ldlt.solve(normal_rhs).cast<float>();
+  return (matrix * (*solution)).isApprox(rhs, kPrecision);
+}
+
+// Solves the mixture system matrix * solution = rhs in the least squares
+// sense, either exactly via QR decomposition or via normal equations, as
+// selected by options.
+bool MixtureL2Solve(const MotionEstimationOptions& options,
+                    const Eigen::MatrixXf& matrix, const Eigen::VectorXf& rhs,
+                    Eigen::MatrixXf* solution) {
+  if (options.use_exact_mixture_homography_estimation()) {
+    // TODO: Consider a faster function?
+    *solution = matrix.colPivHouseholderQr().solve(rhs);
+    return (matrix * (*solution)).isApprox(rhs, kPrecision);
+  }
+  return MixtureL2NormalEquationSolve(matrix, rhs, solution);
+}
+
 // Extension of above function to evenly spaced row-mixture models.
 bool MixtureHomographyL2DLTSolve(
     const RegionFlowFeatureList& feature_list, int num_models,
     const MixtureRowWeights& row_weights, float regularizer_lambda,
+    const MotionEstimationOptions& options,
     Eigen::MatrixXf* matrix,  // least squares matrix
     Eigen::MatrixXf* solution) {
   ABSL_CHECK(matrix);
@@ -4145,9 +4240,7 @@ bool MixtureHomographyL2DLTSolve(
     }
   }
 
-  // TODO: Consider a faster function?
-  *solution = matrix->colPivHouseholderQr().solve(rhs);
-  return ((*matrix) * (*solution)).isApprox(rhs, kPrecision);
+  return MixtureL2Solve(options, *matrix, rhs, solution);
 }
 
 // Constraint mixture homography model.
@@ -4157,6 +4250,7 @@ bool MixtureHomographyL2DLTSolve(
 bool TransMixtureHomographyL2DLTSolve(
     const RegionFlowFeatureList& feature_list, int num_models,
     const MixtureRowWeights& row_weights, float regularizer_lambda,
+    const MotionEstimationOptions& options,
     Eigen::MatrixXf* matrix,  // least squares matrix
     Eigen::MatrixXf* solution) {
   ABSL_CHECK(matrix);
@@ -4245,9 +4339,7 @@ bool TransMixtureHomographyL2DLTSolve(
     }
   }
 
-  // TODO: Consider a faster function
-  *solution = matrix->colPivHouseholderQr().solve(rhs);
-  return ((*matrix) * (*solution)).isApprox(rhs, kPrecision);
+  return MixtureL2Solve(options, *matrix, rhs, solution);
 }
 
 // Constraint mixture homography model.
@@ -4257,6 +4349,7 @@ bool TransMixtureHomographyL2DLTSolve(
 bool SkewRotMixtureHomographyL2DLTSolve(
     const RegionFlowFeatureList& feature_list, int num_models,
     const MixtureRowWeights& row_weights, float regularizer_lambda,
+    const MotionEstimationOptions& options,
     Eigen::MatrixXf* matrix,  // least squares matrix
     Eigen::MatrixXf* solution) {
   ABSL_CHECK(matrix);
@@ -4348,9 +4441,7 @@ bool SkewRotMixtureHomographyL2DLTSolve(
     }
   }
 
-  // TODO: Consider a faster function?
-  *solution = matrix->colPivHouseholderQr().solve(rhs);
-  return ((*matrix) * (*solution)).isApprox(rhs, kPrecision);
+  return MixtureL2Solve(options, *matrix, rhs, solution);
 }
 
 }  // namespace.
@@ -5153,8 +5244,8 @@ bool MotionEstimation::MixtureHomographyFromFeature(
     switch (mixture_mode) {
       case MotionEstimationOptions::FULL_MIXTURE:
         if (!MixtureHomographyL2DLTSolve(*feature_list, num_mixtures,
-                                         *row_weights_, regularizer, &matrix,
-                                         &solution)) {
+                                         *row_weights_, regularizer, options_,
+                                         &matrix, &solution)) {
           return false;
         }
         // No need to unpack solution.
@@ -5164,7 +5255,7 @@ bool MotionEstimation::MixtureHomographyFromFeature(
       case MotionEstimationOptions::TRANSLATION_MIXTURE:
         if (!TransMixtureHomographyL2DLTSolve(*feature_list, num_mixtures,
                                               *row_weights_, regularizer,
-                                              &matrix, &solution)) {
+                                              options_, &matrix, &solution)) {
           return false;
         }
         {
@@ -5184,9 +5275,9 @@ bool MotionEstimation::MixtureHomographyFromFeature(
         break;
 
       case MotionEstimationOptions::SKEW_ROTATION_MIXTURE:
-        if (!SkewRotMixtureHomographyL2DLTSolve(*feature_list, num_mixtures,
-                                                *row_weights_, regularizer,
-                                                &matrix, &solution)) {
+        if (!SkewRotMixtureHomographyL2DLTSolve(
+                *feature_list, num_mixtures, *row_weights_, regularizer,
+                options_, &matrix, &solution)) {
           return false;
         }
         {
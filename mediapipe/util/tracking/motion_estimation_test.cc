@@ -0,0 +1,128 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tracking/motion_estimation.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/tracking/camera_motion.pb.h"
+#include "mediapipe/util/tracking/motion_estimation.pb.h"
+#include "mediapipe/util/tracking/motion_models.pb.h"
+#include "mediapipe/util/tracking/region_flow.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kFrameWidth = 641;
+constexpr int kFrameHeight = 359;
+
+// Creates `num_features` features with the flow of a frame whose rows are
+// captured at slightly different times, as with a rolling shutter.
+RegionFlowFeatureList CreateRollingShutterFeatures(int num_features,
+                                                   int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> x_dist(0, kFrameWidth - 1);
+  std::uniform_real_distribution<float> y_dist(0, kFrameHeight - 1);
+  std::normal_distribution<float> noise(0, 0.2f);
+  std::uniform_real_distribution<float> color_dist(0, 255);
+  RegionFlowFeatureList feature_list;
+  feature_list.set_frame_width(kFrameWidth);
+  feature_list.set_frame_height(kFrameHeight);
+  for (int i = 0; i < num_features; ++i) {
+    const float x = x_dist(rng);
+    const float y = y_dist(rng);
+    const float row = y / kFrameHeight;
+    RegionFlowFeature* feature = feature_list.add_feature();
+    feature->set_x(x);
+    feature->set_y(y);
+    feature->set_dx(0.01f * x - 0.005f * y + 4.0f +
+                    3.0f * std::sin(3.0f * row) + noise(rng));
+    feature->set_dy(0.004f * x + 0.01f * y - 2.0f + 1.5f * row * row +
+                    noise(rng));
+    // Color means followed by the upper triangle of the color covariance,
+    // as computed by ComputeRegionFlowFeatureDescriptors.
+    PatchDescriptor* descriptor = feature->mutable_feature_descriptor();
+    for (int c = 0; c < 3; ++c) descriptor->add_data(color_dist(rng));
+    for (int c = 0; c < 6; ++c) descriptor->add_data(color_dist(rng));
+  }
+  return feature_list;
+}
+
+CameraMotion EstimateMixture(const MotionEstimationOptions& options,
+                             const RegionFlowFeatureList& features) {
+  RegionFlowFeatureList feature_list = features;
+  std::vector<RegionFlowFeatureList*> feature_lists = {&feature_list};
+  std::vector<CameraMotion> camera_motions;
+  MotionEstimation motion_estimation(options, kFrameWidth, kFrameHeight);
+  motion_estimation.EstimateMotionsParallel(
+      /*post_irls_weight_smoothing=*/false, &feature_lists, &camera_motions);
+  return camera_motions[0];
+}
+
+void ExpectMixturesNear(const MixtureHomography& expected,
+                        const MixtureHomography& actual, float tolerance) {
+  ASSERT_EQ(expected.model_size(), actual.model_size());
+  for (int i = 0; i < expected.model_size(); ++i) {
+    const Homography& e = expected.model(i);
+    const Homography& a = actual.model(i);
+    EXPECT_NEAR(e.h_00(), a.h_00(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_01(), a.h_01(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_02(), a.h_02(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_10(), a.h_10(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_11(), a.h_11(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_12(), a.h_12(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_20(), a.h_20(), tolerance) << "model " << i;
+    EXPECT_NEAR(e.h_21(), a.h_21(), tolerance) << "model " << i;
+  }
+}
+
+TEST(MotionEstimationTest, MixtureNormalEquationsMatchExactSolve) {
+  // Feature counts below one block of the normal equations, exactly one
+  // block, and counts that leave a partial last block.
+  for (const int num_features : {37, 128, 1001}) {
+    const RegionFlowFeatureList features =
+        CreateRollingShutterFeatures(num_features, /*seed=*/num_features);
+    for (const int num_mixtures : {7, 10}) {
+      MotionEstimationOptions options;
+      options.set_mix_homography_estimation(
+          MotionEstimationOptions::ESTIMATION_HOMOG_MIX_IRLS);
+      options.set_num_mixtures(num_mixtures);
+      // Later IRLS rounds reweight features by their residuals, which
+      // amplifies the rounding differences between the solvers.
+      options.set_irls_rounds(1);
+      const CameraMotion exact = EstimateMixture(options, features);
+      ASSERT_EQ(exact.type(), CameraMotion::VALID);
+
+      options.set_use_exact_mixture_homography_estimation(false);
+      // Mixtures accumulate in double either way, as float accumulation
+      // shifts their translations by several pixels.
+      for (const bool use_double : {true, false}) {
+        options.set_use_highest_accuracy_for_normal_equations(use_double);
+        const CameraMotion normal = EstimateMixture(options, features);
+        SCOPED_TRACE(testing::Message()
+                     << "features " << num_features << ", mixtures "
+                     << num_mixtures << ", double " << use_double);
+        EXPECT_EQ(normal.type(), CameraMotion::VALID);
+        ExpectMixturesNear(exact.mixture_homography(),
+                           normal.mixture_homography(), 1e-2f);
+      }
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -37,7 +37,32 @@ MotionSaliency::MotionSaliency(const MotionSaliencyOptions& options,
                                int frame_width, int frame_height)
     : options_(options),
       frame_width_(frame_width),
-      frame_height_(frame_height) {}
+      frame_height_(frame_height) {
+  // Scale band_width to image domain.
+  band_width_ = hypot(frame_width_, frame_height_) * options_.mode_band_width();
+
+  // Guarantee at least 1.5 sigmas in each direction are captured with
+  // tap 3 filtering (86 % of the data).
+  grid_resolution_ = 1.5f * band_width_;
+
+  // Setup Gaussian LUT for smoothing in space, using 2^10 discretization bins.
+  // Only depends on frame size and options, therefore computed once.
+  const int lut_bins = 1 << 10;
+  space_lut_.resize(lut_bins);
+
+  // Using 3 tap smoothing, max distance is 2 bin diagonals.
+  // We use maximum of 2 * sqrt(2) * bin_radius plus 1% room in case maximum
+  // value is attained.
+  const float max_space_diff = sqrt(2.0) * 2.f * grid_resolution_ * 1.01f;
+
+  const float space_bin_size = max_space_diff / lut_bins;
+  space_scale_ = 1.0f / space_bin_size;
+  const float space_coeff = -0.5f / (band_width_ * band_width_);
+  for (int i = 0; i < lut_bins; ++i) {
+    const float value = i * space_bin_size;
+    space_lut_[i] = std::exp(value * value * space_coeff);
+  }
+}
 
 MotionSaliency::~MotionSaliency() {}
 
@@ -85,7 +110,7 @@ void MotionSaliency::SaliencyFromFeatures(
   int feat_idx = 0;
 
   // Create SalientLocation's from input feature_list.
-  std::vector<SalientLocation> features;
+  locations_.clear();
   for (const auto& src_feature : feature_list.feature()) {
     const float weight =
         irls_weights ? (*irls_weights)[feat_idx] : src_feature.irls_weight();
@@ -96,10 +121,11 @@ void MotionSaliency::SaliencyFromFeatures(
       continue;
     }
 
-    features.push_back(SalientLocation(FeatureLocation(src_feature), weight));
+    locations_.push_back(
+        SalientLocation(FeatureLocation(src_feature), weight));
   }
 
-  DetermineSalientFrame(features, salient_frame);
+  DetermineSalientFrame(&locations_, salient_frame);
 }
 
 void MotionSaliency::SaliencyFromPoints(const std::vector<Vector2_f>* points,
@@ -120,7 +146,7 @@ void MotionSaliency::SaliencyFromPoints(const std::vector<Vector2_f>* points,
   const float weight_cutoff = max_weight * 1e-2f;
 
   // Create SalientLocation's from input points.
-  std::vector<SalientLocation> features;
+  locations_.clear();
   for (int point_idx = 0; point_idx < points->size(); ++point_idx) {
     const float weight = (*weights)[point_idx];
     // Discard all features with small measure or zero weight from mode finding.
@@ -128,10 +154,10 @@ void MotionSaliency::SaliencyFromPoints(const std::vector<Vector2_f>* points,
       continue;
     }
 
-    features.push_back(SalientLocation((*points)[point_idx], weight));
+    locations_.push_back(SalientLocation((*points)[point_idx], weight));
   }
 
-  DetermineSalientFrame(features, salient_frame);
+  DetermineSalientFrame(&locations_, salient_frame);
 }
 
 // We only keep those salient points that have neighbors along the temporal
@@ -446,9 +472,7 @@ void MotionSaliency::SalientModeFinding(std::vector<SalientLocation>* locations,
     return;
   }
 
-  // Scale band_width to image domain.
-  const float band_width =
-      hypot(frame_width_, frame_height_) * options_.mode_band_width();
+  const float band_width = band_width_;
 
   // Select all salient locations with non-zero weight.
   FeatureFrame<SalientLocation> salient_features;
@@ -468,9 +492,7 @@ void MotionSaliency::SalientModeFinding(std::vector<SalientLocation>* locations,
   std::vector<FeatureGrid<SalientLocation>> feature_grids;
   std::vector<std::vector<int>> feature_taps;
 
-  // Guarantee at least 1.5 sigmas in each direction are captured with
-  // tap 3 filtering (86 % of the data).
-  const float grid_resolution = 1.5f * band_width;
+  const float grid_resolution = grid_resolution_;
   Vector2_i grid_dims;
   BuildFeatureGrid(
       frame_width_, frame_height_, grid_resolution, {salient_features},
@@ -481,30 +503,13 @@ void MotionSaliency::SalientModeFinding(std::vector<SalientLocation>* locations,
   ABSL_CHECK_EQ(1, feature_grids.size());
   const auto& feature_grid = feature_grids[0];
 
-  // Setup Gaussian LUT for smoothing in space, using 2^10 discretization bins.
-  const int lut_bins = 1 << 10;
-  std::vector<float> space_lut(lut_bins);
-
-  // Using 3 tap smoothing, max distance is 2 bin diagonals.
-  // We use maximum of 2 * sqrt(2) * bin_radius plus 1% room in case maximum
-  // value is attained.
-  const float max_space_diff = sqrt(2.0) * 2.f * grid_resolution * 1.01f;
-
-  const float space_bin_size = max_space_diff / lut_bins;
-  const float space_scale = 1.0f / space_bin_size;
-  const float space_coeff = -0.5f / (band_width * band_width);
-  for (int i = 0; i < lut_bins; ++i) {
-    const float value = i * space_bin_size;
-    space_lut[i] = std::exp(value * value * space_coeff);
-  }
-
   // Store modes for each grid bin (to be averaged later).
   std::vector<std::list<FeatureMode>> mode_grid(grid_dims.x() * grid_dims.y());
   std::vector<FeatureMode*> mode_ptrs;
 
   DetermineFeatureModes(salient_features, grid_resolution, grid_dims,
-                        band_width, feature_grid, feature_taps, space_lut,
-                        space_scale, &mode_grid, &mode_ptrs);
+                        band_width, feature_grid, feature_taps, space_lut_,
+                        space_scale_, &mode_grid, &mode_ptrs);
 
   // Read out modes, ordered by decreasing weight.
   struct FeatureModeComparator {
@@ -548,7 +553,7 @@ void MotionSaliency::SalientModeFinding(std::vector<SalientLocation>* locations,
             const Vector2_f test_loc =
                 salient_features[test_mode.feature_idx]->pt;
             const float weight =
-                space_lut[static_cast<int>(dist * space_scale)] *
+                space_lut_[static_cast<int>(dist * space_scale_)] *
                 test_mode.irls_weight;
 
             sum_weight += weight;
@@ -622,13 +627,14 @@ void MotionSaliency::SalientModeFinding(std::vector<SalientLocation>* locations,
 // Determines the salient frame for a list of SalientLocations by performing
 // mode finding and scales each point based on frame size.
 void MotionSaliency::DetermineSalientFrame(
-    std::vector<SalientLocation> locations, SalientPointFrame* salient_frame) {
+    std::vector<SalientLocation>* locations, SalientPointFrame* salient_frame) {
+  ABSL_CHECK(locations);
   ABSL_CHECK(salient_frame);
 
   std::vector<SalientMode> modes;
   {
     MEASURE_TIME << "Mode finding";
-    SalientModeFinding(&locations, &modes);
+    SalientModeFinding(locations, &modes);
   }
 
   const float denom_x = 1.0f / frame_width_;
@@ -113,12 +113,23 @@ class MotionSaliency {
 
   // Determines the salient frame for a list of SalientLocations by performing
   // mode finding and scaling each point based on frame size.
-  void DetermineSalientFrame(std::vector<SalientLocation> locations,
+  void DetermineSalientFrame(std::vector<SalientLocation>* locations,
                              SalientPointFrame* salient_frame);
 
   MotionSaliencyOptions options_;
   int frame_width_;
   int frame_height_;
+
+  // Mode finding bandwidth and grid resolution in the image domain.
+  float band_width_ = 0;
+  float grid_resolution_ = 0;
+
+  // Gaussian LUT for spatial weights, indexed by distance * space_scale_.
+  std::vector<float> space_lut_;
+  float space_scale_ = 0;
+
+  // Salient locations of the current frame, reused across frames.
+  std::vector<SalientLocation> locations_;
 };
 
 // Returns foregroundness weights in [0, 1] for each feature, by mapping irls
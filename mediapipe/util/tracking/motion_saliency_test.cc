@@ -0,0 +1,105 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tracking/motion_saliency.h"
+
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/vector.h"
+#include "mediapipe/util/tracking/motion_saliency.pb.h"
+#include "mediapipe/util/tracking/region_flow.pb.h"
+
+namespace mediapipe {
+namespace {
+
+constexpr int kFrameWidth = 641;
+constexpr int kFrameHeight = 359;
+
+// Creates points scattered around a few cluster centers that move with
+// `frame`, plus uniformly distributed background points.
+void CreateClusteredPoints(int frame, std::vector<Vector2_f>* points,
+                           std::vector<float>* weights) {
+  std::mt19937 rng(frame);
+  std::normal_distribution<float> spread(0, 15);
+  std::uniform_real_distribution<float> x(0, kFrameWidth - 1);
+  std::uniform_real_distribution<float> y(0, kFrameHeight - 1);
+  std::uniform_real_distribution<float> weight(0.1f, 1.0f);
+  const Vector2_f centers[] = {Vector2_f(100 + 5 * frame, 80),
+                               Vector2_f(420, 250 - 3 * frame),
+                               Vector2_f(300 + 7 * frame, 150)};
+  points->clear();
+  weights->clear();
+  for (const Vector2_f& center : centers) {
+    for (int i = 0; i < 40 + 10 * frame; ++i) {
+      points->push_back(center + Vector2_f(spread(rng), spread(rng)));
+      weights->push_back(weight(rng));
+    }
+  }
+  for (int i = 0; i < 25; ++i) {
+    points->push_back(Vector2_f(x(rng), y(rng)));
+    weights->push_back(weight(rng));
+  }
+}
+
+TEST(MotionSaliencyTest, ReusedInstanceMatchesFreshInstance) {
+  const MotionSaliencyOptions options;
+  MotionSaliency reused_saliency(options, kFrameWidth, kFrameHeight);
+  std::vector<Vector2_f> points;
+  std::vector<float> weights;
+  // Point counts grow and shrink across frames, so buffers are reused at
+  // different sizes.
+  for (const int frame : {0, 3, 1, 2}) {
+    CreateClusteredPoints(frame, &points, &weights);
+
+    SalientPointFrame expected;
+    MotionSaliency(options, kFrameWidth, kFrameHeight)
+        .SaliencyFromPoints(&points, &weights, &expected);
+    ASSERT_GT(expected.point_size(), 0);
+
+    SalientPointFrame actual;
+    reused_saliency.SaliencyFromPoints(&points, &weights, &actual);
+    EXPECT_THAT(actual, EqualsProto(expected)) << "frame " << frame;
+  }
+}
+
+TEST(MotionSaliencyTest, FeaturesMatchPoints) {
+  const MotionSaliencyOptions options;
+  MotionSaliency saliency(options, kFrameWidth, kFrameHeight);
+  std::vector<Vector2_f> points;
+  std::vector<float> weights;
+  CreateClusteredPoints(/*frame=*/0, &points, &weights);
+
+  RegionFlowFeatureList feature_list;
+  feature_list.set_frame_width(kFrameWidth);
+  feature_list.set_frame_height(kFrameHeight);
+  for (int i = 0; i < points.size(); ++i) {
+    RegionFlowFeature* feature = feature_list.add_feature();
+    feature->set_x(points[i].x());
+    feature->set_y(points[i].y());
+    feature->set_irls_weight(weights[i]);
+  }
+
+  SalientPointFrame from_points;
+  saliency.SaliencyFromPoints(&points, &weights, &from_points);
+  SalientPointFrame from_features;
+  saliency.SaliencyFromFeatures(feature_list, /*irls_weights=*/nullptr,
+                                &from_features);
+  EXPECT_THAT(from_features, EqualsProto(from_points));
+}
+
+}  // namespace
+}  // namespace mediapipe
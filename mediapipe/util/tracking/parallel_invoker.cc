@@ -21,6 +21,24 @@ int flags_parallel_invoker_max_threads = 4;
 
 namespace mediapipe {
 
+namespace {
+
+thread_local Executor* parallel_invoker_executor = nullptr;
+
+}  // namespace
+
+Executor* ParallelInvokerExecutor() { return parallel_invoker_executor; }
+
+ScopedParallelInvokerExecutor::ScopedParallelInvokerExecutor(
+    Executor* executor)
+    : previous_executor_(parallel_invoker_executor) {
+  parallel_invoker_executor = executor;
+}
+
+ScopedParallelInvokerExecutor::~ScopedParallelInvokerExecutor() {
+  parallel_invoker_executor = previous_executor_;
+}
+
 #if defined(PARALLEL_INVOKER_ACTIVE)
 ThreadPool* ParallelInvokerThreadPool() {
   static ThreadPool* pool = []() -> ThreadPool* {
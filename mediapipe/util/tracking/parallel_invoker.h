@@ -74,6 +74,8 @@
 #include "absl/log/absl_check.h"
 #include "absl/log/absl_log.h"
 #include "absl/synchronization/mutex.h"
+#include "mediapipe/framework/executor.h"
+#include "mediapipe/framework/executor_parallel_for.h"
 
 #ifdef PARALLEL_INVOKER_ACTIVE
 #include "mediapipe/framework/port/threadpool.h"
@@ -136,6 +138,32 @@ class BlockedRange2D {
   BlockedRange cols_;
 };
 
+// Returns the executor that ParallelFor and ParallelFor2D calls on the current
+// thread run on, or null if they use the mode selected by
+// flags_parallel_invoker_mode.
+Executor* ParallelInvokerExecutor();
+
+// Makes ParallelFor and ParallelFor2D calls on the current thread, including
+// nested calls made by their invokers, run on executor instead of the
+// parallel invoker's own thread pool, OpenMP or GCD. Calculators use it to
+// keep tracking work on the graph's threads:
+//
+//   ScopedParallelInvokerExecutor scoped_executor(cc->GetExecutor());
+//   motion_analysis_->AddFrame(...);
+//
+// A null executor restores the default behavior inside the scope.
+class ScopedParallelInvokerExecutor {
+ public:
+  explicit ScopedParallelInvokerExecutor(Executor* executor);
+  ~ScopedParallelInvokerExecutor();
+  ScopedParallelInvokerExecutor(const ScopedParallelInvokerExecutor&) = delete;
+  ScopedParallelInvokerExecutor& operator=(
+      const ScopedParallelInvokerExecutor&) = delete;
+
+ private:
+  Executor* previous_executor_;
+};
+
 #ifdef PARALLEL_INVOKER_ACTIVE
 
 // Singleton ThreadPool for parallel invoker.
@@ -291,6 +319,20 @@ inline void CheckAndSetInvokerOptions() {
       << "Invalid invoker mode specified.";
 }
 
+// Same as below ParallelFor, but runs on executor. Chunks of grain_size
+// iterations are spread over the calling thread and executor's threads, see
+// ExecutorParallelFor(). If executor is null, the chunks run serially.
+template <class Invoker>
+void ParallelFor(Executor* executor, size_t start, size_t end,
+                 size_t grain_size, const Invoker& invoker) {
+  ExecutorParallelFor(executor, start, end, grain_size,
+                      [executor, &invoker](int chunk_start, int chunk_end) {
+                        ScopedParallelInvokerExecutor scoped_executor(executor);
+                        Invoker local_invoker(invoker);
+                        local_invoker(BlockedRange(chunk_start, chunk_end, 1));
+                      });
+}
+
 // Performs parallel iteration from [start to end), scheduling grain_size
 // iterations per thread. For each iteration
 // invoker(BlockedRange(thread_local_start, thread_local_end))
@@ -299,6 +341,10 @@ inline void CheckAndSetInvokerOptions() {
 template <class Invoker>
 void ParallelFor(size_t start, size_t end, size_t grain_size,
                  const Invoker& invoker) {
+  if (Executor* executor = ParallelInvokerExecutor()) {
+    ParallelFor(executor, start, end, grain_size, invoker);
+    return;
+  }
 #ifdef PARALLEL_INVOKER_ACTIVE
   CheckAndSetInvokerOptions();
   switch (flags_parallel_invoker_mode) {
@@ -406,10 +452,31 @@ void SerialFor2D(size_t start_row, size_t end_row, size_t start_col,
                          BlockedRange(start_col, end_col, 1)));
 }
 
+// Same as above ParallelFor with an executor for 2D iteration. Rows are
+// split into chunks of grain_size.
+template <class Invoker>
+void ParallelFor2D(Executor* executor, size_t start_row, size_t end_row,
+                   size_t start_col, size_t end_col, size_t grain_size,
+                   const Invoker& invoker) {
+  ExecutorParallelFor(
+      executor, start_row, end_row, grain_size,
+      [executor, start_col, end_col, &invoker](int chunk_start, int chunk_end) {
+        ScopedParallelInvokerExecutor scoped_executor(executor);
+        Invoker local_invoker(invoker);
+        local_invoker(BlockedRange2D(BlockedRange(chunk_start, chunk_end, 1),
+                                     BlockedRange(start_col, end_col, 1)));
+      });
+}
+
 // Same as above ParallelFor for 2D iteration.
 template <class Invoker>
 void ParallelFor2D(size_t start_row, size_t end_row, size_t start_col,
                    size_t end_col, size_t grain_size, const Invoker& invoker) {
+  if (Executor* executor = ParallelInvokerExecutor()) {
+    ParallelFor2D(executor, start_row, end_row, start_col, end_col, grain_size,
+                  invoker);
+    return;
+  }
 #ifdef PARALLEL_INVOKER_ACTIVE
   CheckAndSetInvokerOptions();
   switch (flags_parallel_invoker_mode) {
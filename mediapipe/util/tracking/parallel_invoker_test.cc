@@ -16,9 +16,12 @@
 
 #include <algorithm>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 #include "absl/synchronization/mutex.h"
 #include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/thread_pool_executor.h"
 
 namespace mediapipe {
 namespace {
@@ -56,5 +59,35 @@ TEST(ParallelInvokerTest, ThreadPoolTest) {
   RunParallelTest();
 }
 
+TEST(ParallelInvokerTest, ExecutorTest) {
+  flags_parallel_invoker_mode = PARALLEL_INVOKER_NONE;
+  ThreadPoolExecutor executor(4);
+  ScopedParallelInvokerExecutor scoped_executor(&executor);
+
+  RunParallelTest();
+}
+
+TEST(ParallelInvokerTest, NestedExecutorTest) {
+  ThreadPoolExecutor executor(2);
+  absl::Mutex cells_mutex;
+  std::vector<std::pair<int, int>> cells;
+  ParallelFor(&executor, 0, 8, 1,
+              [&cells_mutex, &cells](const BlockedRange& rows) {
+                // Runs on the executor, since the scope is propagated.
+                ParallelFor2D(rows.begin(), rows.end(), 0, 8, 1,
+                              [&cells_mutex, &cells](const BlockedRange2D& b) {
+                                for (int y = b.rows().begin();
+                                     y != b.rows().end(); ++y) {
+                                  for (int x = b.cols().begin();
+                                       x != b.cols().end(); ++x) {
+                                    absl::MutexLock lock(&cells_mutex);
+                                    cells.emplace_back(y, x);
+                                  }
+                                }
+                              });
+              });
+  EXPECT_EQ(cells.size(), 64);
+}
+
 }  // namespace
 }  // namespace mediapipe
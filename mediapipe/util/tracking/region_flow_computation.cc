@@ -1453,6 +1453,39 @@ void RegionFlowComputation::Reset() {
 
 namespace {
 
+// Grid of cells used for adaptive feature extraction at the finest level, see
+// TrackingOptions::adaptive_features_block_size.
+struct FeatureExtractionGrid {
+  FeatureExtractionGrid(float block_size, int frame_width, int frame_height) {
+    ABSL_CHECK_GT(block_size, 0) << "Need positive block size";
+    cell_width = block_size < 1 ? block_size * frame_width : block_size;
+    cell_height = block_size < 1 ? block_size * frame_height : block_size;
+    // Ensure valid cell width and height regardless of settings.
+    cell_width = std::max(1, cell_width);
+    cell_height = std::max(1, cell_height);
+    cells_per_row = std::ceil(static_cast<float>(frame_width) / cell_width);
+    cells_per_column =
+        std::ceil(static_cast<float>(frame_height) / cell_height);
+  }
+
+  int num_cells() const { return cells_per_row * cells_per_column; }
+
+  // Returns index of the cell containing location (x, y), clamped to the
+  // grid.
+  int CellIndex(float x, float y) const {
+    const int cell_x =
+        std::clamp(static_cast<int>(x) / cell_width, 0, cells_per_row - 1);
+    const int cell_y =
+        std::clamp(static_cast<int>(y) / cell_height, 0, cells_per_column - 1);
+    return cell_y * cells_per_row + cell_x;
+  }
+
+  int cell_width;
+  int cell_height;
+  int cells_per_row;
+  int cells_per_column;
+};
+
 struct FloatPointerComparator {
   bool operator()(const float* lhs, const float* rhs) const {
     return *lhs > *rhs;
@@ -1613,7 +1646,8 @@ inline void SetMaskNeighborhood(int mask_x, int mask_y, cv::Mat* mask) {
 
 void RegionFlowComputation::AdaptiveGoodFeaturesToTrack(
     const std::vector<cv::Mat>& extraction_pyramid, int max_features,
-    float mask_scale, cv::Mat* mask, FrameTrackingData* data) {
+    float mask_scale, const std::vector<bool>* cells_to_extract, cv::Mat* mask,
+    FrameTrackingData* data) {
   ABSL_CHECK(data != nullptr);
   ABSL_CHECK(feature_tmp_image_1_.get() != nullptr);
   ABSL_CHECK(feature_tmp_image_2_.get() != nullptr);
@@ -1624,15 +1658,18 @@ void RegionFlowComputation::AdaptiveGoodFeaturesToTrack(
   const auto& tracking_options = options_.tracking_options();
 
   // Setup grid information.
-  const float block_size = tracking_options.adaptive_features_block_size();
-  ABSL_CHECK_GT(block_size, 0) << "Need positive block size";
-
-  int block_width = block_size < 1 ? block_size * frame_width_ : block_size;
-  int block_height = block_size < 1 ? block_size * frame_height_ : block_size;
-
-  // Ensure valid block width and height regardless of settings.
-  block_width = max(1, block_width);
-  block_height = max(1, block_height);
+  const FeatureExtractionGrid grid(
+      tracking_options.adaptive_features_block_size(), frame_width_,
+      frame_height_);
+  const int block_width = grid.cell_width;
+  const int block_height = grid.cell_height;
+  if (cells_to_extract != nullptr) {
+    ABSL_CHECK_EQ(cells_to_extract->size(), grid.num_cells());
+  }
+  auto in_cell_to_extract = [cells_to_extract, &grid](int x, int y) {
+    return cells_to_extract == nullptr ||
+           (*cells_to_extract)[grid.CellIndex(x, y)];
+  };
 
   bool use_harris = tracking_options.corner_extraction_method() ==
                     TrackingOptions::EXTRACTION_HARRIS;
@@ -1682,6 +1719,35 @@ void RegionFlowComputation::AdaptiveGoodFeaturesToTrack(
 
       if (use_fast) {
         fast_detector->detect(image, fast_keypoints);
+      } else if (cells_to_extract != nullptr) {
+        // Only compute the corner response within cells to extract. Each cell
+        // is padded so that the response matches the one over the full image.
+        eig_image->setTo(0);
+        const cv::Rect image_rect(0, 0, cols, rows);
+        cv::Mat cell_response;
+        for (int k = 0; k < grid.num_cells(); ++k) {
+          if (!(*cells_to_extract)[k]) {
+            continue;
+          }
+          const cv::Rect cell =
+              cv::Rect(k % grid.cells_per_row * block_width,
+                       k / grid.cells_per_row * block_height, block_width,
+                       block_height) &
+              image_rect;
+          constexpr int kPadding = kBlockSize;
+          const cv::Rect padded_cell =
+              cv::Rect(cell.x - kPadding, cell.y - kPadding,
+                       cell.width + 2 * kPadding, cell.height + 2 * kPadding) &
+              image_rect;
+          if (use_harris) {
+            cv::cornerHarris(image(padded_cell), cell_response, kBlockSize,
+                             kBlockSize, kHarrisK);
+          } else {
+            cv::cornerMinEigenVal(image(padded_cell), cell_response,
+                                  kBlockSize);
+          }
+          cell_response(cell - padded_cell.tl()).copyTo((*eig_image)(cell));
+        }
       } else if (use_harris) {
         cv::cornerHarris(image, *eig_image, kBlockSize, kBlockSize, kHarrisK);
       } else {
@@ -1734,6 +1800,10 @@ void RegionFlowComputation::AdaptiveGoodFeaturesToTrack(
       for (int j = 0; j < fast_keypoints.size(); ++j) {
         const int corner_y = fast_keypoints[j].pt.y;
         const int corner_x = fast_keypoints[j].pt.x;
+        if (!in_cell_to_extract(corner_x, corner_y)) {
+          continue;
+        }
+
         const int mask_x = corner_x * mask_scale;
         const int mask_y = corner_y * mask_scale;
 
@@ -1816,6 +1886,10 @@ void RegionFlowComputation::AdaptiveGoodFeaturesToTrack(
               continue;
             }
 
+            if (!in_cell_to_extract(corner_x, corner_y)) {
+              continue;
+            }
+
             const int mask_x = corner_x * mask_scale;
             const int mask_y = corner_y * mask_scale;
 
@@ -2394,10 +2468,38 @@ void RegionFlowComputation::ExtractFeatures(
     }
   }
 
+  // When tracking long features, only extract new features in grid cells that
+  // lost too many of them.
+  std::vector<bool> cells_to_extract;
+  bool extract_features = true;
+  const int min_features_per_cell =
+      options_.tracking_options().long_tracks_min_features_per_cell();
+  if (prev_result && min_features_per_cell > 0) {
+    const FeatureExtractionGrid grid(
+        options_.tracking_options().adaptive_features_block_size(),
+        frame_width_, frame_height_);
+    std::vector<int> features_per_cell(grid.num_cells(), 0);
+    for (const auto& feature : data->features) {
+      ++features_per_cell[grid.CellIndex(feature.x, feature.y)];
+    }
+    cells_to_extract.resize(grid.num_cells());
+    extract_features = false;
+    for (int k = 0; k < grid.num_cells(); ++k) {
+      cells_to_extract[k] = features_per_cell[k] < min_features_per_cell;
+      extract_features |= cells_to_extract[k];
+    }
+    if (!extract_features) {
+      VLOG(1) << "All cells hold enough tracked features, skipping extraction";
+    }
+  }
+
   // Extracts additional features in regions excluding the mask and adds them to
   // data.
-  AdaptiveGoodFeaturesToTrack(data->extraction_pyramid, max_features_,
-                              mask_scale, &mask, data);
+  if (extract_features) {
+    AdaptiveGoodFeaturesToTrack(
+        data->extraction_pyramid, max_features_, mask_scale,
+        cells_to_extract.empty() ? nullptr : &cells_to_extract, &mask, data);
+  }
 
   const int num_features = data->features.size();
   ABSL_CHECK_EQ(num_features, data->octaves.size());
@@ -233,9 +233,13 @@ class RegionFlowComputation {
   // that are too close to each other.
   // Features and corner responses are added to the corresponding vectors in
   // data, i.e. passed data is not cleared and expected to be initialized.
+  // If cells_to_extract is not null, it holds for each cell of the level 0
+  // extraction grid whether features may be extracted in it; corner responses
+  // at the finest extraction level are then only computed in those cells.
   virtual void AdaptiveGoodFeaturesToTrack(
       const std::vector<cv::Mat>& extraction_pyramid, int max_features,
-      float mask_scale, cv::Mat* mask, FrameTrackingData* data);
+      float mask_scale, const std::vector<bool>* cells_to_extract,
+      cv::Mat* mask, FrameTrackingData* data);
 
   // Uses prev_result to remove all features that are not present in data.
   // Uses track_ids, i.e. only works with long feature processing.
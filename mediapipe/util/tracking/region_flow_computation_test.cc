@@ -301,5 +301,74 @@ TEST_P(RegionFlowComputationTest, ResolutionTests) {
   }
 }
 
+TEST_P(RegionFlowComputationTest, LongTracksExtractionInAllCellsMatchesFull) {
+  std::vector<cv::Mat> movie;
+  std::vector<Vector2_f> positions;
+  const int num_frames = 10;
+  MakeMovie(num_frames, RegionFlowComputationOptions::FORMAT_GRAYSCALE, &movie,
+            &positions);
+
+  RegionFlowComputationOptions options = base_options_;
+  options.set_image_format(RegionFlowComputationOptions::FORMAT_GRAYSCALE);
+  auto* tracking_options = options.mutable_tracking_options();
+  tracking_options->set_internal_tracking_direction(TrackingOptions::FORWARD);
+  tracking_options->set_tracking_policy(TrackingOptions::POLICY_LONG_TRACKS);
+  // Cells that do not evenly divide the frame, so that border cells are cut.
+  tracking_options->set_adaptive_features_block_size(37);
+
+  // Crops to odd sizes, so that the last cells of each row and column are
+  // partial.
+  for (const cv::Size crop_size :
+       {movie[0].size(), cv::Size(movie[0].cols - 3, movie[0].rows - 5)}) {
+    for (const auto method : {TrackingOptions::EXTRACTION_MIN_EIG_VAL,
+                              TrackingOptions::EXTRACTION_HARRIS}) {
+      tracking_options->set_corner_extraction_method(method);
+      // With a threshold no cell can reach, features are extracted in every
+      // cell, which must match extraction over the full frame.
+      RegionFlowComputationOptions cell_options = options;
+      cell_options.mutable_tracking_options()
+          ->set_long_tracks_min_features_per_cell(1 << 20);
+      RegionFlowComputation full_computation(options, crop_size.width,
+                                             crop_size.height);
+      RegionFlowComputation cell_computation(cell_options, crop_size.width,
+                                             crop_size.height);
+
+      for (int i = 0; i < num_frames; ++i) {
+        const cv::Mat frame =
+            movie[i](cv::Rect(cv::Point(0, 0), crop_size)).clone();
+        full_computation.AddImage(frame, 0);
+        cell_computation.AddImage(frame, 0);
+        if (i == 0) {
+          continue;
+        }
+
+        std::unique_ptr<RegionFlowFrame> full_flow(
+            full_computation.RetrieveRegionFlow());
+        std::unique_ptr<RegionFlowFrame> cell_flow(
+            cell_computation.RetrieveRegionFlow());
+        ASSERT_EQ(full_flow->num_total_features(),
+                  cell_flow->num_total_features())
+            << "frame " << i << ", size " << crop_size << ", method "
+            << method;
+        ASSERT_EQ(full_flow->region_flow_size(), cell_flow->region_flow_size());
+        for (int r = 0; r < full_flow->region_flow_size(); ++r) {
+          const auto& full_region = full_flow->region_flow(r);
+          const auto& cell_region = cell_flow->region_flow(r);
+          ASSERT_EQ(full_region.feature_size(), cell_region.feature_size());
+          for (int f = 0; f < full_region.feature_size(); ++f) {
+            const auto& full_feature = full_region.feature(f);
+            const auto& cell_feature = cell_region.feature(f);
+            EXPECT_FLOAT_EQ(full_feature.x(), cell_feature.x());
+            EXPECT_FLOAT_EQ(full_feature.y(), cell_feature.y());
+            EXPECT_FLOAT_EQ(full_feature.dx(), cell_feature.dx());
+            EXPECT_FLOAT_EQ(full_feature.dy(), cell_feature.dy());
+            EXPECT_EQ(full_feature.track_id(), cell_feature.track_id());
+          }
+        }
+      }
+    }
+  }
+}
+
 }  // namespace
 }  // namespace mediapipe
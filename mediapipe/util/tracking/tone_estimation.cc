@@ -111,23 +111,22 @@ void ToneEstimation::EstimateToneChange(
   ABSL_CHECK_EQ(frame_height_, curr_frame.rows);
   ABSL_CHECK_EQ(frame_width_, curr_frame.cols);
 
-  ClipMask<3> curr_clip;
-  ComputeClipMask<3>(options_.clip_mask_options(), curr_frame, &curr_clip);
+  ComputeClipMask<3>(options_.clip_mask_options(), curr_frame, &curr_clip_);
 
   // Compute tone statistics.
-  tone_change->set_frac_clipped(cv::sum(curr_clip.mask)[0] /
-                                (frame_height_ * frame_width_));
+  tone_change->set_frac_clipped(
+      static_cast<float>(curr_clip_.NumClipped(0, 0, frame_width_,
+                                               frame_height_)) /
+      (frame_height_ * frame_width_));
 
-  IntensityPercentiles(curr_frame, curr_clip.mask,
+  IntensityPercentiles(curr_frame, curr_clip_.mask,
                        options_.tone_match_options().log_domain(), tone_change);
 
   ColorToneMatches color_tone_matches;
-  // TODO: Buffer clip mask.
   if (prev_frame) {
-    ClipMask<3> prev_clip;
-    ComputeClipMask<3>(options_.clip_mask_options(), *prev_frame, &prev_clip);
+    ComputeClipMask<3>(options_.clip_mask_options(), *prev_frame, &prev_clip_);
     ComputeToneMatches<3>(options_.tone_match_options(), feature_list,
-                          curr_frame, *prev_frame, curr_clip, prev_clip,
+                          curr_frame, *prev_frame, curr_clip_, prev_clip_,
                           &color_tone_matches, debug_output);
 
     EstimateGainBiasModel(options_.irls_iterations(), &color_tone_matches,
@@ -149,22 +148,20 @@ void ToneEstimation::EstimateToneChange(
 void ToneEstimation::IntensityPercentiles(const cv::Mat& frame,
                                           const cv::Mat& clip_mask,
                                           bool log_domain,
-                                          ToneChange* tone_change) const {
-  cv::Mat intensity(frame.rows, frame.cols, CV_8UC1);
-  cv::cvtColor(frame, intensity, cv::COLOR_RGB2GRAY);
-
-  std::vector<float> histogram(256, 0.0f);
-
-  for (int i = 0; i < intensity.rows; ++i) {
-    const uint8_t* intensity_ptr = intensity.ptr<uint8_t>(i);
-    const uint8_t* clip_ptr = clip_mask.ptr<uint8_t>(i);
-
-    for (int j = 0; j < intensity.cols; ++j) {
-      if (!clip_ptr[j]) {
-        ++histogram[intensity_ptr[j]];
-      }
-    }
-  }
+                                          ToneChange* tone_change) {
+  cv::cvtColor(frame, intensity_, cv::COLOR_RGB2GRAY);
+
+  // Histogram of unclipped intensities.
+  cv::compare(clip_mask, cv::Scalar(0), unclipped_, cv::CMP_EQ);
+  const int channel = 0;
+  const int num_bins = 256;
+  const float bin_range[] = {0.0f, 256.0f};
+  const float* bin_ranges = bin_range;
+  cv::Mat histogram_mat;
+  cv::calcHist(&intensity_, 1, &channel, unclipped_, histogram_mat, 1,
+               &num_bins, &bin_ranges);
+  std::vector<float> histogram(histogram_mat.begin<float>(),
+                               histogram_mat.end<float>());
 
   // Construct cumulative histogram.
   std::partial_sum(histogram.begin(), histogram.end(), histogram.begin());
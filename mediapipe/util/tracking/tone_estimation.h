@@ -54,7 +54,23 @@ struct ClipMask {
     max_exposure_threshold.resize(C);
   }
 
+  // Returns the number of clipped pixels within [x_start, x_end) x
+  // [y_start, y_end). Uses the integral of the mask if present.
+  int NumClipped(int x_start, int y_start, int x_end, int y_end) const {
+    if (mask_integral.empty()) {
+      return static_cast<int>(cv::sum(cv::Mat(mask, cv::Range(y_start, y_end),
+                                              cv::Range(x_start, x_end)))[0]);
+    }
+    return mask_integral.at<int>(y_end, x_end) -
+           mask_integral.at<int>(y_start, x_end) -
+           mask_integral.at<int>(y_end, x_start) +
+           mask_integral.at<int>(y_start, x_start);
+  }
+
   cv::Mat mask;
+  // Integral image of mask (CV_32S), set by ToneEstimation::ComputeClipMask.
+  // Needs to be cleared if mask is modified afterwards.
+  cv::Mat mask_integral;
   std::vector<float> min_exposure_threshold;
   std::vector<float> max_exposure_threshold;
 };
@@ -129,7 +145,7 @@ class ToneEstimation {
  private:
   // Computes normalized intensity percentiles.
   void IntensityPercentiles(const cv::Mat& frame, const cv::Mat& clip_mask,
-                            bool log_domain, ToneChange* tone_change) const;
+                            bool log_domain, ToneChange* tone_change);
 
  private:
   ToneEstimationOptions options_;
@@ -144,6 +160,12 @@ class ToneEstimation {
 
   std::unique_ptr<cv::Mat> resized_input_;
   std::unique_ptr<cv::Mat> prev_resized_input_;
+
+  // Scratch buffers reused across frames.
+  ClipMask<3> curr_clip_;
+  ClipMask<3> prev_clip_;
+  cv::Mat intensity_;
+  cv::Mat unclipped_;
 };
 
 // Template implementation functions.
@@ -156,49 +178,39 @@ void ToneEstimation::ComputeClipMask(const ClipMaskOptions& options,
 
   // Over / Underexposure handling.
   // Masks pixels affected by clipping.
-  clip_mask->mask.create(frame.rows, frame.cols, CV_8U);
-
   const float min_exposure_thresh = options.min_exposure() * 255.0f;
   const float max_exposure_thresh = options.max_exposure() * 255.0f;
   const int max_clipped_channels = options.max_clipped_channels();
 
-  std::vector<cv::Mat> planes;
-  cv::split(frame, planes);
-  ABSL_CHECK_EQ(C, planes.size());
-  float min_exposure[C];
-  float max_exposure[C];
   for (int c = 0; c < C; ++c) {
-    min_exposure[c] = min_exposure_thresh;
-    max_exposure[c] = max_exposure_thresh;
+    clip_mask->min_exposure_threshold[c] = min_exposure_thresh;
+    clip_mask->max_exposure_threshold[c] = max_exposure_thresh;
   }
 
-  for (int c = 0; c < C; ++c) {
-    clip_mask->min_exposure_threshold[c] = min_exposure[c];
-    clip_mask->max_exposure_threshold[c] = max_exposure[c];
+  std::vector<cv::Mat> planes(1, frame);
+  if (C > 1) {
+    cv::split(frame, planes);
   }
+  ABSL_CHECK_EQ(C, planes.size());
 
-  for (int i = 0; i < frame.rows; ++i) {
-    const uint8_t* img_ptr = frame.ptr<uint8_t>(i);
-    uint8_t* clip_ptr = clip_mask->mask.template ptr<uint8_t>(i);
-
-    for (int j = 0; j < frame.cols; ++j) {
-      const int idx = C * j;
-      int clipped_channels = 0;  // Count clipped channels.
-
-      for (int p = 0; p < C; ++p) {
-        clipped_channels +=
-            static_cast<int>(img_ptr[idx + p] < min_exposure[p] ||
-                             img_ptr[idx + p] > max_exposure[p]);
-      }
-
-      if (clipped_channels > max_clipped_channels) {
-        clip_ptr[j] = 1;
-      } else {
-        clip_ptr[j] = 0;
-      }
-    }
+  // Count the channels within exposure range for each pixel. Intensities are
+  // integer, a value is in range iff it lies within the rounded thresholds.
+  cv::Mat num_in_range = cv::Mat::zeros(frame.rows, frame.cols, CV_8U);
+  cv::Mat in_range;
+  for (int c = 0; c < C; ++c) {
+    cv::inRange(planes[c],
+                cv::Scalar(std::ceil(clip_mask->min_exposure_threshold[c])),
+                cv::Scalar(std::floor(clip_mask->max_exposure_threshold[c])),
+                in_range);
+    cv::bitwise_and(in_range, cv::Scalar(1), in_range);
+    cv::add(num_in_range, in_range, num_in_range);
   }
 
+  // Clipped if more than max_clipped_channels are out of range.
+  cv::compare(num_in_range, cv::Scalar(C - max_clipped_channels),
+              clip_mask->mask, cv::CMP_LT);
+  cv::bitwise_and(clip_mask->mask, cv::Scalar(1), clip_mask->mask);
+
   // Dilate to address blooming.
   const int dilate_diam = options.clip_mask_diameter();
   const int dilate_rad = ceil(dilate_diam * 0.5);
@@ -215,6 +227,9 @@ void ToneEstimation::ComputeClipMask(const ClipMaskOptions& options,
     kernel.setTo(1.0);
     cv::dilate(dilate_domain, dilate_domain, kernel);
   }
+
+  // Integral image for constant time patch sums in ComputeToneMatches.
+  cv::integral(clip_mask->mask, clip_mask->mask_integral, CV_32S);
 }
 
 template <int C>
@@ -291,19 +306,14 @@ void ToneEstimation::ComputeToneMatches(
       continue;  // Ignore border patches.
     }
 
-    // TODO: Instead of summing masks, perform box filter over mask
-    // and just grab element at feature location.
-    cv::Mat curr_patch_mask(curr_clip_mask.mask,
-                            cv::Range(curr_start.y(), curr_end.y()),
-                            cv::Range(curr_start.x(), curr_end.x()));
-    cv::Mat prev_patch_mask(prev_clip_mask.mask,
-                            cv::Range(prev_start.y(), prev_end.y()),
-                            cv::Range(prev_start.x(), prev_end.x()));
-
     // Skip patch if too many clipped pixels.
-    if (cv::sum(curr_patch_mask)[0] * patch_denom >
+    if (curr_clip_mask.NumClipped(curr_start.x(), curr_start.y(),
+                                  curr_end.x(), curr_end.y()) *
+                patch_denom >
             options.max_frac_clipped() ||
-        cv::sum(prev_patch_mask)[0] * patch_denom >
+        prev_clip_mask.NumClipped(prev_start.x(), prev_start.y(),
+                                  prev_end.x(), prev_end.y()) *
+                patch_denom >
             options.max_frac_clipped()) {
       continue;
     }
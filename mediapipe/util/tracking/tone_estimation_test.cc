@@ -0,0 +1,223 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "mediapipe/util/tracking/tone_estimation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/framework/port/opencv_core_inc.h"
+#include "mediapipe/framework/port/opencv_imgproc_inc.h"
+#include "mediapipe/util/tracking/region_flow.pb.h"
+#include "mediapipe/util/tracking/tone_estimation.pb.h"
+
+namespace mediapipe {
+namespace {
+
+// Frame sizes, including a single pixel and widths that leave a tail after a
+// vector width.
+const cv::Size kFrameSizes[] = {{1, 1}, {37, 23}, {64, 17}, {3, 41}};
+
+// Returns a random frame in which about a third of the values are at or close
+// to the exposure bounds.
+cv::Mat CreateFrame(cv::Size size, int type, std::mt19937* rng) {
+  cv::Mat frame(size, type);
+  std::uniform_int_distribution<int> value(0, 255);
+  std::uniform_int_distribution<int> extreme(0, 5);
+  uint8_t* data = frame.ptr<uint8_t>(0);
+  const int num_values = frame.total() * frame.channels();
+  for (int i = 0; i < num_values; ++i) {
+    switch (extreme(*rng)) {
+      case 0:
+        data[i] = value(*rng) % 8;
+        break;
+      case 1:
+        data[i] = 255 - value(*rng) % 8;
+        break;
+      default:
+        data[i] = value(*rng);
+    }
+  }
+  return frame;
+}
+
+// The per pixel loop ComputeClipMask used before it was vectorized, kept as
+// the reference. Dilation is unchanged.
+template <int C>
+cv::Mat ReferenceClipMask(const ClipMaskOptions& options,
+                          const cv::Mat& frame) {
+  cv::Mat mask(frame.rows, frame.cols, CV_8U);
+  const float min_exposure = options.min_exposure() * 255.0f;
+  const float max_exposure = options.max_exposure() * 255.0f;
+  for (int i = 0; i < frame.rows; ++i) {
+    const uint8_t* img_ptr = frame.ptr<uint8_t>(i);
+    uint8_t* clip_ptr = mask.ptr<uint8_t>(i);
+    for (int j = 0; j < frame.cols; ++j) {
+      const int idx = C * j;
+      int clipped_channels = 0;
+      for (int p = 0; p < C; ++p) {
+        clipped_channels += static_cast<int>(img_ptr[idx + p] < min_exposure ||
+                                             img_ptr[idx + p] > max_exposure);
+      }
+      clip_ptr[j] = clipped_channels > options.max_clipped_channels() ? 1 : 0;
+    }
+  }
+
+  const int dilate_diam = options.clip_mask_diameter();
+  const int dilate_rad = ceil(dilate_diam * 0.5);
+  if (mask.rows > 2 * dilate_rad && mask.cols > 2 * dilate_rad) {
+    cv::Mat dilate_domain =
+        cv::Mat(mask, cv::Range(dilate_rad, mask.rows - dilate_rad),
+                cv::Range(dilate_rad, mask.cols - dilate_rad));
+    cv::Mat kernel(dilate_diam, dilate_diam, CV_8U);
+    kernel.setTo(1.0);
+    cv::dilate(dilate_domain, dilate_domain, kernel);
+  }
+  return mask;
+}
+
+void ExpectMasksEqual(const cv::Mat& expected, const cv::Mat& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_EQ(expected.type(), actual.type());
+  EXPECT_EQ(cv::countNonZero(expected != actual), 0);
+}
+
+std::vector<ClipMaskOptions> TestClipMaskOptions() {
+  std::vector<ClipMaskOptions> all_options;
+  for (const int max_clipped_channels : {0, 1, 2}) {
+    for (const int clip_mask_diameter : {1, 5}) {
+      ClipMaskOptions options;
+      // Thresholds on integer intensities, and between them.
+      const bool integer_thresholds = max_clipped_channels == 1;
+      options.set_min_exposure(integer_thresholds ? 4.0f / 255 : 0.0107f);
+      options.set_max_exposure(integer_thresholds ? 251.0f / 255 : 0.9813f);
+      options.set_max_clipped_channels(max_clipped_channels);
+      options.set_clip_mask_diameter(clip_mask_diameter);
+      all_options.push_back(options);
+    }
+  }
+  return all_options;
+}
+
+TEST(ToneEstimationTest, ClipMaskMatchesReference) {
+  std::mt19937 rng(0);
+  for (const cv::Size& size : kFrameSizes) {
+    const cv::Mat color_frame = CreateFrame(size, CV_8UC3, &rng);
+    const cv::Mat gray_frame = CreateFrame(size, CV_8UC1, &rng);
+    for (const ClipMaskOptions& options : TestClipMaskOptions()) {
+      SCOPED_TRACE(testing::Message()
+                   << "size " << size << ", options "
+                   << options.ShortDebugString());
+      ClipMask<3> color_mask;
+      ToneEstimation::ComputeClipMask<3>(options, color_frame, &color_mask);
+      ExpectMasksEqual(ReferenceClipMask<3>(options, color_frame),
+                       color_mask.mask);
+
+      ClipMask<1> gray_mask;
+      ToneEstimation::ComputeClipMask<1>(options, gray_frame, &gray_mask);
+      ExpectMasksEqual(ReferenceClipMask<1>(options, gray_frame),
+                       gray_mask.mask);
+    }
+  }
+}
+
+TEST(ToneEstimationTest, NumClippedMatchesMaskSum) {
+  std::mt19937 rng(0);
+  const cv::Mat frame = CreateFrame(cv::Size(37, 23), CV_8UC3, &rng);
+  ClipMask<3> clip_mask;
+  ToneEstimation::ComputeClipMask<3>(ClipMaskOptions(), frame, &clip_mask);
+  ASSERT_FALSE(clip_mask.mask_integral.empty());
+
+  std::uniform_int_distribution<int> x(0, frame.cols);
+  std::uniform_int_distribution<int> y(0, frame.rows);
+  for (int i = 0; i < 100; ++i) {
+    int x_start = x(rng);
+    int x_end = x(rng);
+    int y_start = y(rng);
+    int y_end = y(rng);
+    if (x_start > x_end) std::swap(x_start, x_end);
+    if (y_start > y_end) std::swap(y_start, y_end);
+    const cv::Mat patch(clip_mask.mask, cv::Range(y_start, y_end),
+                        cv::Range(x_start, x_end));
+    EXPECT_EQ(clip_mask.NumClipped(x_start, y_start, x_end, y_end),
+              cv::sum(patch)[0])
+        << "[" << x_start << ", " << x_end << ") x [" << y_start << ", "
+        << y_end << ")";
+  }
+  // Whole frame, including the last row and column of the integral.
+  EXPECT_EQ(clip_mask.NumClipped(0, 0, frame.cols, frame.rows),
+            cv::sum(clip_mask.mask)[0]);
+}
+
+TEST(ToneEstimationTest, ToneStatisticsMatchReference) {
+  std::mt19937 rng(0);
+  for (const cv::Size& size : kFrameSizes) {
+    const cv::Mat frame = CreateFrame(size, CV_8UC3, &rng);
+    ToneEstimationOptions options;
+    ToneEstimation tone_estimation(options, size.width, size.height);
+    ToneChange tone_change;
+    // Called twice, the second call runs on the reused buffers.
+    for (int i = 0; i < 2; ++i) {
+      tone_change.Clear();
+      tone_estimation.EstimateToneChange(RegionFlowFeatureList(), frame,
+                                         /*prev_frame=*/nullptr,
+                                         &tone_change);
+    }
+
+    // The per pixel loops the statistics used before they were vectorized.
+    const cv::Mat clip_mask =
+        ReferenceClipMask<3>(options.clip_mask_options(), frame);
+    cv::Mat intensity;
+    cv::cvtColor(frame, intensity, cv::COLOR_RGB2GRAY);
+    std::vector<float> histogram(256, 0.0f);
+    for (int i = 0; i < intensity.rows; ++i) {
+      for (int j = 0; j < intensity.cols; ++j) {
+        if (!clip_mask.at<uint8_t>(i, j)) {
+          ++histogram[intensity.at<uint8_t>(i, j)];
+        }
+      }
+    }
+
+    SCOPED_TRACE(testing::Message() << "size " << size);
+    EXPECT_FLOAT_EQ(tone_change.frac_clipped(),
+                    cv::sum(clip_mask)[0] / (size.width * size.height));
+    std::partial_sum(histogram.begin(), histogram.end(), histogram.begin());
+    if (histogram.back() == 0) {
+      EXPECT_FALSE(tone_change.has_mid_percentile());
+      continue;
+    }
+    const float histogram_sum = histogram.back();
+    for (float& entry : histogram) entry /= histogram_sum;
+    const float percentiles[] = {options.stats_low_percentile(),
+                                 options.stats_mid_percentile(),
+                                 options.stats_high_percentile()};
+    const float values[] = {tone_change.low_percentile(),
+                            tone_change.mid_percentile(),
+                            tone_change.high_percentile()};
+    for (int k = 0; k < 3; ++k) {
+      const int bin = std::lower_bound(histogram.begin(), histogram.end(),
+                                       percentiles[k]) -
+                      histogram.begin();
+      EXPECT_FLOAT_EQ(values[k], bin / 255.0f) << "percentile " << k;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -14,6 +14,7 @@
 
 #include "mediapipe/util/tracking/tracked_detection_manager.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "mediapipe/framework/formats/rect.pb.h"
@@ -39,10 +40,96 @@ bool AreCornersOutOfView(const TrackedDetection& object) {
   }
   return true;
 }
+
+// Number of grid cells along each axis of the normalized image.
+constexpr int kGridSize = 16;
+
+// Returns the cell of normalized coordinate |value|, clamped to the grid.
+int GetCellIndex(float value) {
+  const float scaled = value * kGridSize;
+  // Also catches NaN.
+  if (!(scaled > 0.0f)) return 0;
+  if (scaled >= kGridSize - 1) return kGridSize - 1;
+  return static_cast<int>(scaled);
+}
 }  // namespace
 
 namespace mediapipe {
 
+TrackedDetectionManager::DetectionGrid::DetectionGrid()
+    : cells_(kGridSize * kGridSize) {}
+
+TrackedDetectionManager::DetectionGrid::CellRange
+TrackedDetectionManager::DetectionGrid::GetCellRange(
+    const TrackedDetection& detection) {
+  return {GetCellIndex(detection.left()), GetCellIndex(detection.top()),
+          GetCellIndex(detection.right()), GetCellIndex(detection.bottom())};
+}
+
+void TrackedDetectionManager::DetectionGrid::Insert(
+    const TrackedDetection& detection) {
+  const int id = detection.unique_id();
+  Remove(id);
+  const CellRange range = GetCellRange(detection);
+  for (int y = range.min_y; y <= range.max_y; ++y) {
+    for (int x = range.min_x; x <= range.max_x; ++x) {
+      cells_[y * kGridSize + x].push_back(id);
+    }
+  }
+  cell_ranges_[id] = range;
+}
+
+void TrackedDetectionManager::DetectionGrid::Remove(int id) {
+  auto range_it = cell_ranges_.find(id);
+  if (range_it == cell_ranges_.end()) {
+    return;
+  }
+  const CellRange& range = range_it->second;
+  for (int y = range.min_y; y <= range.max_y; ++y) {
+    for (int x = range.min_x; x <= range.max_x; ++x) {
+      auto& cell = cells_[y * kGridSize + x];
+      cell.erase(std::find(cell.begin(), cell.end(), id));
+    }
+  }
+  cell_ranges_.erase(range_it);
+}
+
+std::vector<int> TrackedDetectionManager::DetectionGrid::GetCandidates(
+    const TrackedDetection& detection) const {
+  std::vector<int> ids;
+  const CellRange range = GetCellRange(detection);
+  for (int y = range.min_y; y <= range.max_y; ++y) {
+    for (int x = range.min_x; x <= range.max_x; ++x) {
+      const auto& cell = cells_[y * kGridSize + x];
+      ids.insert(ids.end(), cell.begin(), cell.end());
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  return ids;
+}
+
+std::vector<int> TrackedDetectionManager::GetDuplicateCandidates(
+    const TrackedDetection& detection) const {
+  // Boxes that don't overlap can only be the same with a negative overlap
+  // ratio threshold, in which case every detection is a candidate.
+  if (config_.is_same_detection_min_overlap_ratio() < 0.0f) {
+    std::vector<int> ids;
+    ids.reserve(detections_.size());
+    for (const auto& existing_detection : detections_) {
+      ids.push_back(existing_detection.first);
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  }
+  return grid_.GetCandidates(detection);
+}
+
+void TrackedDetectionManager::EraseDetection(int id) {
+  grid_.Remove(id);
+  detections_.erase(id);
+}
+
 std::vector<int> TrackedDetectionManager::AddDetection(
     std::unique_ptr<TrackedDetection> detection) {
   std::vector<int> ids_to_remove;
@@ -51,8 +138,8 @@ std::vector<int> TrackedDetectionManager::AddDetection(
   // TODO: All detections should be fastforwarded to the current
   // timestamp before adding the detection manager. E.g. only check they are the
   // same if the timestamp are the same.
-  for (auto& existing_detection_ptr : detections_) {
-    const auto& existing_detection = *existing_detection_ptr.second;
+  for (int existing_id : GetDuplicateCandidates(*detection)) {
+    const auto& existing_detection = *detections_.at(existing_id);
     if (detection->IsSameAs(existing_detection,
                             config_.is_same_detection_max_area_ratio(),
                             config_.is_same_detection_min_overlap_ratio())) {
@@ -72,14 +159,15 @@ std::vector<int> TrackedDetectionManager::AddDetection(
           detection->set_previous_id(existing_detection.previous_id());
         }
       }
-      ids_to_remove.push_back(existing_detection_ptr.first);
+      ids_to_remove.push_back(existing_id);
     }
   }
   // Erase old detections.
   for (auto id : ids_to_remove) {
-    detections_.erase(id);
+    EraseDetection(id);
   }
   const int id = detection->unique_id();
+  grid_.Insert(*detection);
   detections_[id] = std::move(detection);
   return ids_to_remove;
 }
@@ -94,6 +182,7 @@ std::vector<int> TrackedDetectionManager::UpdateDetectionLocation(
   auto& detection = *detection_ptr->second;
   detection.set_bounding_box(bounding_box);
   detection.set_last_updated_timestamp(timestamp);
+  grid_.Insert(detection);
 
   // It's required to do this here in addition to in AddDetection because during
   // fast motion, two or more detections of the same object could coexist since
@@ -111,7 +200,7 @@ std::vector<int> TrackedDetectionManager::RemoveObsoleteDetections(
     }
   }
   for (auto idx : ids_to_remove) {
-    detections_.erase(idx);
+    EraseDetection(idx);
   }
   return ids_to_remove;
 }
@@ -124,7 +213,7 @@ std::vector<int> TrackedDetectionManager::RemoveOutOfViewDetections() {
     }
   }
   for (auto idx : ids_to_remove) {
-    detections_.erase(idx);
+    EraseDetection(idx);
   }
   return ids_to_remove;
 }
@@ -143,8 +232,9 @@ std::vector<int> TrackedDetectionManager::RemoveDuplicatedDetections(int id) {
   // are multiple duplicated detections at the same timestamp, we will use the
   // one that has the second latest initial timestamp
   const TrackedDetection* previous_detection = nullptr;
-  for (auto& existing_detection : detections_) {
-    auto other = *(existing_detection.second);
+  for (int existing_id : GetDuplicateCandidates(detection)) {
+    auto* existing_detection = detections_.at(existing_id).get();
+    const auto& other = *existing_detection;
     if (detection.unique_id() != other.unique_id()) {
       // Only check if they are updated at the same timestamp. Comparing
       // locations of detections at different timestamp is not correct.
@@ -158,13 +248,13 @@ std::vector<int> TrackedDetectionManager::RemoveDuplicatedDetections(int id) {
               other.initial_timestamp()) {
             // Removes the earlier one.
             ids_to_remove.push_back(other.unique_id());
-            detection_to_remove = existing_detection.second.get();
+            detection_to_remove = existing_detection;
             latest_detection->MergeLabelScore(other);
           } else {
             ids_to_remove.push_back(latest_detection->unique_id());
             detection_to_remove = latest_detection;
-            existing_detection.second->MergeLabelScore(*latest_detection);
-            latest_detection = existing_detection.second.get();
+            existing_detection->MergeLabelScore(*latest_detection);
+            latest_detection = existing_detection;
           }
           if (!previous_detection ||
               previous_detection->initial_timestamp() <
@@ -187,7 +277,7 @@ std::vector<int> TrackedDetectionManager::RemoveDuplicatedDetections(int id) {
   }
 
   for (auto idx : ids_to_remove) {
-    detections_.erase(idx);
+    EraseDetection(idx);
   }
   return ids_to_remove;
 }
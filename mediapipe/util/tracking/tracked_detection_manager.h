@@ -16,7 +16,10 @@
 #define MEDIAPIPE_UTIL_TRACKING_DETECTION_MANAGER_H_
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/node_hash_map.h"
 #include "mediapipe/framework/formats/rect.pb.h"
 #include "mediapipe/util/tracking/tracked_detection.h"
@@ -77,12 +80,50 @@ class TrackedDetectionManager {
   }
 
  private:
+  // Uniform grid over the normalized image, used to find the detections whose
+  // bounding boxes may overlap a given one without comparing against every
+  // tracked detection. Boxes are indexed by their axis-aligned bounds, which
+  // is also what TrackedDetection::IsSameAs measures the overlap of. Boxes
+  // outside of the image are clamped to the border cells.
+  class DetectionGrid {
+   public:
+    DetectionGrid();
+
+    void Insert(const TrackedDetection& detection);
+    void Remove(int id);
+
+    // Returns the sorted IDs of the indexed detections sharing at least one
+    // cell with |detection|.
+    std::vector<int> GetCandidates(const TrackedDetection& detection) const;
+
+   private:
+    struct CellRange {
+      int min_x, min_y, max_x, max_y;
+    };
+
+    static CellRange GetCellRange(const TrackedDetection& detection);
+
+    // Detection IDs in each cell, row-major.
+    std::vector<std::vector<int>> cells_;
+    absl::flat_hash_map<int, CellRange> cell_ranges_;
+  };
+
+  // Returns the sorted IDs of the detections that may be the same as
+  // |detection| according to IsSameAs, |detection| itself included if it is
+  // managed.
+  std::vector<int> GetDuplicateCandidates(
+      const TrackedDetection& detection) const;
+
+  // Removes the detection of |id| from both detections_ and the grid.
+  void EraseDetection(int id);
+
   // Finds all detections that are duplicated with the one of |id| and remove
   // all detections except the one that is added most recently. Returns the IDs
   // of the detections that are removed.
   std::vector<int> RemoveDuplicatedDetections(int id);
 
   absl::node_hash_map<int, std::unique_ptr<TrackedDetection>> detections_;
+  DetectionGrid grid_;
 
   mediapipe::TrackedDetectionManagerConfig config_;
 };
@@ -0,0 +1,111 @@
+// Copyright 2026 The MediaPipe Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "mediapipe/util/tracking/tracked_detection_manager.h"
+
+#include <memory>
+#include <vector>
+
+#include "mediapipe/framework/formats/rect.pb.h"
+#include "mediapipe/framework/port/gmock.h"
+#include "mediapipe/framework/port/gtest.h"
+#include "mediapipe/util/tracking/tracked_detection.h"
+
+namespace mediapipe {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+NormalizedRect MakeBox(float x_center, float y_center, float size) {
+  NormalizedRect box;
+  box.set_x_center(x_center);
+  box.set_y_center(y_center);
+  box.set_width(size);
+  box.set_height(size);
+  return box;
+}
+
+std::unique_ptr<TrackedDetection> MakeDetection(int id, int64_t timestamp,
+                                                const NormalizedRect& box) {
+  return std::make_unique<TrackedDetection>(id, timestamp, box);
+}
+
+TEST(TrackedDetectionManagerTest, AddDetectionRemovesOverlappingDuplicates) {
+  TrackedDetectionManager manager;
+  EXPECT_THAT(manager.AddDetection(MakeDetection(0, 1, MakeBox(0.2, 0.2, 0.1))),
+              IsEmpty());
+  EXPECT_THAT(manager.AddDetection(MakeDetection(1, 1, MakeBox(0.8, 0.8, 0.1))),
+              IsEmpty());
+  EXPECT_THAT(
+      manager.AddDetection(MakeDetection(2, 2, MakeBox(0.21, 0.2, 0.1))),
+      ElementsAre(0));
+  EXPECT_EQ(manager.GetNumDetections(), 2);
+  EXPECT_EQ(manager.GetTrackedDetection(2)->previous_id(), 0);
+}
+
+TEST(TrackedDetectionManagerTest, FindsDuplicatesOutsideOfTheImage) {
+  TrackedDetectionManager manager;
+  manager.AddDetection(MakeDetection(0, 0, MakeBox(-0.5, 1.5, 0.2)));
+  manager.AddDetection(MakeDetection(1, 0, MakeBox(-0.9, 1.5, 0.2)));
+  EXPECT_THAT(
+      manager.AddDetection(MakeDetection(2, 1, MakeBox(-0.52, 1.5, 0.2))),
+      ElementsAre(0));
+}
+
+TEST(TrackedDetectionManagerTest, UpdatedLocationIsUsedForDuplicates) {
+  TrackedDetectionManager manager;
+  manager.AddDetection(MakeDetection(0, 0, MakeBox(0.1, 0.1, 0.1)));
+  manager.AddDetection(MakeDetection(1, 1, MakeBox(0.9, 0.9, 0.1)));
+  // Moving the first detection onto the second one removes the older one.
+  EXPECT_THAT(manager.UpdateDetectionLocation(0, MakeBox(0.9, 0.9, 0.1), 1),
+              ElementsAre(0));
+  EXPECT_EQ(manager.GetTrackedDetection(1)->previous_id(), 0);
+  // The removed detection doesn't match anything anymore.
+  EXPECT_THAT(manager.AddDetection(MakeDetection(2, 2, MakeBox(0.1, 0.1, 0.1))),
+              IsEmpty());
+}
+
+TEST(TrackedDetectionManagerTest, ManyDetections) {
+  TrackedDetectionManager manager;
+  constexpr int kNumPerRow = 20;
+  for (int i = 0; i < kNumPerRow * kNumPerRow; ++i) {
+    const float x = (i % kNumPerRow + 0.5f) / kNumPerRow;
+    const float y = (i / kNumPerRow + 0.5f) / kNumPerRow;
+    ASSERT_THAT(manager.AddDetection(MakeDetection(i, 0, MakeBox(x, y, 0.04))),
+                IsEmpty());
+  }
+  EXPECT_EQ(manager.GetNumDetections(), kNumPerRow * kNumPerRow);
+  // A box covering four neighbouring detections at their shared corner only
+  // overlaps each of them by a quarter.
+  const float corner = 10.0f / kNumPerRow;
+  EXPECT_THAT(manager.AddDetection(
+                  MakeDetection(1000, 1, MakeBox(corner, corner, 0.05))),
+              IsEmpty());
+  EXPECT_THAT(manager.AddDetection(MakeDetection(
+                  1001, 1, MakeBox(corner + 0.025, corner + 0.025, 0.04))),
+              ElementsAre(210));
+}
+
+TEST(TrackedDetectionManagerTest, NegativeOverlapRatioMatchesDisjointBoxes) {
+  TrackedDetectionManager manager;
+  TrackedDetectionManagerConfig config;
+  config.set_is_same_detection_min_overlap_ratio(-1.0f);
+  manager.SetConfig(config);
+  manager.AddDetection(MakeDetection(0, 0, MakeBox(0.1, 0.1, 0.1)));
+  EXPECT_THAT(manager.AddDetection(MakeDetection(1, 1, MakeBox(0.9, 0.9, 0.1))),
+              ElementsAre(0));
+}
+
+}  // namespace
+}  // namespace mediapipe
@@ -16,10 +16,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <memory>
 #include <numeric>
 #include <random>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Eigen/Core"
 #include "Eigen/Dense"
@@ -35,6 +38,7 @@
 #include "mediapipe/util/tracking/flow_packager.pb.h"
 #include "mediapipe/util/tracking/measure_time.h"
 #include "mediapipe/util/tracking/motion_models.h"
+#include "mediapipe/util/tracking/parallel_invoker.h"
 
 namespace mediapipe {
 
@@ -1128,6 +1132,44 @@ bool MotionBox::TrackStep(int from_frame,
   }
 }
 
+std::vector<int> MotionBox::TrackStepBatch(
+    int from_frame, const MotionVectorFrame& motion_vectors, bool forward,
+    const std::vector<MotionBox*>& boxes) {
+  const int num_boxes = boxes.size();
+  std::vector<std::pair<float, int>> order;
+  order.reserve(num_boxes);
+  for (int k = 0; k < num_boxes; ++k) {
+    const MotionBox& box = *boxes[k];
+    const bool known_frame =
+        from_frame >= box.queue_start_ &&
+        from_frame < box.queue_start_ + static_cast<int>(box.states_.size());
+    order.emplace_back(
+        known_frame ? box.states_[from_frame - box.queue_start_].pos_x() : 0.0f,
+        k);
+  }
+  std::sort(order.begin(), order.end());
+
+  // One flag per box, as different threads write to neighboring flags.
+  std::vector<uint8_t> tracked(num_boxes, 0);
+  ParallelFor(0, num_boxes, 1,
+              [from_frame, forward, &motion_vectors, &boxes, &order,
+               &tracked](const BlockedRange& range) {
+                for (int k = range.begin(); k < range.end(); ++k) {
+                  const int box_idx = order[k].second;
+                  tracked[box_idx] = boxes[box_idx]->TrackStep(
+                      from_frame, motion_vectors, forward);
+                }
+              });
+
+  std::vector<int> failed_boxes;
+  for (int k = 0; k < num_boxes; ++k) {
+    if (!tracked[k]) {
+      failed_boxes.push_back(k);
+    }
+  }
+  return failed_boxes;
+}
+
 namespace {
 
 Vector2_f SpatialPriorPosition(const Vector2_f& location,
@@ -1626,6 +1668,12 @@ bool MotionBox::GetVectorsAndWeights(
   // Approx. 2 pix at SD resolution.
   constexpr float kSqProximity = 2e-3 * 2e-3;
 
+  // Rotated and perspective boxes also need the test against box_lines.
+  const bool test_box_lines =
+      std::abs(box_state.rotation()) > 0.01f ||
+      options_.tracking_degrees() ==
+          TrackStepOptions::TRACKING_DEGREE_OBJECT_PERSPECTIVE;
+
   for (int k = start_idx; k < end_idx; ++k) {
     // x is within bound due to sorting.
     const MotionVector& test_vector = motion_vectors[k];
@@ -1635,9 +1683,7 @@ bool MotionBox::GetVectorsAndWeights(
       continue;
     }
 
-    if (std::abs(box_state.rotation()) > 0.01f ||
-        options_.tracking_degrees() ==
-            TrackStepOptions::TRACKING_DEGREE_OBJECT_PERSPECTIVE) {
+    if (test_box_lines) {
       // Test also if vector is within transformed convex area.
       bool accepted = true;
       for (const Vector3_f& line : box_lines) {
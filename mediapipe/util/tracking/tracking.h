@@ -313,6 +313,17 @@ class MotionBox {
   bool TrackStep(int from_frame, const MotionVectorFrame& motion_vectors,
                  bool forward);
 
+  // Tracks all boxes from from_frame by one frame, with the same result as
+  // calling TrackStep on each of them. Use it when many boxes are tracked
+  // through the same MotionVectorFrame: boxes are processed in order of their
+  // left edge, so that boxes tracked one after another read neighboring
+  // motion vectors, and are distributed over threads via ParallelFor.
+  // Returns the indices into boxes of the boxes that failed to track, in
+  // increasing order.
+  static std::vector<int> TrackStepBatch(
+      int from_frame, const MotionVectorFrame& motion_vectors, bool forward,
+      const std::vector<MotionBox*>& boxes);
+
   MotionBoxState StateAtFrame(int frame) const {
     if (frame < queue_start_ ||
         frame >= queue_start_ + static_cast<int>(states_.size())) {
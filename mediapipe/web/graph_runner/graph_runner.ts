@@ -84,6 +84,12 @@ export class GraphRunner implements GraphRunnerApi {
   //   should be somewhat fixed when we create our .d.ts files.
   readonly wasmModule: WasmModule;
   readonly hasMultiStreamSupport: boolean;
+  /**
+   * Whether the Wasm module is a pthreads-enabled build. Its heap is then
+   * backed by a `SharedArrayBuffer` and the graph scheduler can run
+   * calculators on worker threads.
+   */
+  readonly isMultiThreaded: boolean;
   autoResizeCanvas = true;
   audioPtr: number|null;
   audioSize: number;
@@ -105,6 +111,8 @@ export class GraphRunner implements GraphRunnerApi {
     this.audioSize = 0;
     this.hasMultiStreamSupport =
         (typeof this.wasmModule._addIntToInputStream === 'function');
+    this.isMultiThreaded = typeof SharedArrayBuffer !== 'undefined' &&
+        this.wasmModule.HEAPU8.buffer instanceof SharedArrayBuffer;
 
     if (glCanvas !== undefined) {
       this.wasmModule.canvas = glCanvas;
@@ -10,6 +10,10 @@ import {WasmModule} from './wasm_module';
  */
 export declare interface FileLocator {
   locateFile: (filename: string) => string;
+  /**
+   * The URL of the Wasm loader script. Required by pthreads-enabled Wasm
+   * builds, which load it again in each of their worker threads.
+   */
   mainScriptUrlOrBlob?: string;
 }
 
@@ -15,7 +15,7 @@
  */
 import 'jasmine';
 
-import {isWebKit} from '../../web/graph_runner/platform_utils';
+import {isWebKit, supportsSharedArrayBuffer} from '../../web/graph_runner/platform_utils';
 
 
 const DESKTOP_FIREFOX =
@@ -65,3 +65,16 @@ describe('isWebKit()', () => {
     expect(isWebKit(navigator as Navigator)).toBeTrue();
   });
 });
+
+describe('supportsSharedArrayBuffer()', () => {
+  it('returns false if the context is not cross-origin isolated', () => {
+    expect(supportsSharedArrayBuffer({crossOriginIsolated: false}))
+        .toBeFalse();
+    expect(supportsSharedArrayBuffer({})).toBeFalse();
+  });
+
+  it('returns true if the context is cross-origin isolated', () => {
+    expect(supportsSharedArrayBuffer({crossOriginIsolated: true}))
+        .toBe(typeof SharedArrayBuffer !== 'undefined');
+  });
+});
@@ -61,3 +61,14 @@ export function supportsOffscreenCanvas(browser = navigator) {
   }
   return true;
 }
+
+/**
+ * Returns whether the current context can share memory between threads, which
+ * is required to run a pthreads-enabled (multi-threaded) Wasm build. This
+ * requires `SharedArrayBuffer` and a cross-origin isolated page or worker.
+ */
+export function supportsSharedArrayBuffer(
+    scope: {crossOriginIsolated?: boolean} = self) {
+  return typeof SharedArrayBuffer !== 'undefined' &&
+      scope.crossOriginIsolated === true;
+}